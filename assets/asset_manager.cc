@@ -9,7 +9,25 @@
 
 namespace flutter {
 
-AssetManager::AssetManager() = default;
+namespace {
+
+constexpr size_t kDefaultPrefetchCacheLimit = 32 * 1024 * 1024;
+constexpr size_t kPageSize = 4096;
+
+// Reads a byte of every page, so that the pages of a mapped file are resident
+// by the time the asset is used.
+void TouchPages(const fml::Mapping& mapping) {
+  const uint8_t* data = mapping.GetMapping();
+  volatile uint8_t sink = 0;
+  for (size_t offset = 0; offset < mapping.GetSize(); offset += kPageSize) {
+    sink = sink ^ data[offset];
+  }
+}
+
+}  // namespace
+
+AssetManager::AssetManager()
+    : prefetch_cache_limit_(kDefaultPrefetchCacheLimit) {}
 
 AssetManager::~AssetManager() = default;
 
@@ -19,6 +37,8 @@ bool AssetManager::PushFront(std::unique_ptr<AssetResolver> resolver) {
   }
 
   resolvers_.push_front(std::move(resolver));
+  // The new resolver may shadow assets that were prefetched from others.
+  ClearPrefetchCache();
   return true;
 }
 
@@ -53,12 +73,70 @@ void AssetManager::UpdateResolverByType(
     new_resolvers.push_back(std::move(updated_asset_resolver));
   }
   resolvers_.swap(new_resolvers);
+  ClearPrefetchCache();
 }
 
 std::deque<std::unique_ptr<AssetResolver>> AssetManager::TakeResolvers() {
+  ClearPrefetchCache();
   return std::move(resolvers_);
 }
 
+bool AssetManager::Prefetch(const std::string& asset_name) {
+  if (asset_name.empty()) {
+    return false;
+  }
+  TRACE_EVENT1("flutter", "AssetManager::Prefetch", "name",
+               asset_name.c_str());
+  {
+    std::scoped_lock lock(prefetch_mutex_);
+    if (prefetch_cache_index_.count(asset_name) > 0) {
+      return true;
+    }
+  }
+
+  std::shared_ptr<fml::Mapping> mapping = FindAsMapping(asset_name);
+  if (mapping == nullptr) {
+    return false;
+  }
+  TouchPages(*mapping);
+
+  std::scoped_lock lock(prefetch_mutex_);
+  if (mapping->GetSize() > prefetch_cache_limit_ ||
+      prefetch_cache_index_.count(asset_name) > 0) {
+    return true;
+  }
+  EvictPrefetchedAssets(prefetch_cache_limit_ - mapping->GetSize());
+  prefetch_stats_.cached_bytes += mapping->GetSize();
+  prefetch_cache_.emplace_front(asset_name, std::move(mapping));
+  prefetch_cache_index_[asset_name] = prefetch_cache_.begin();
+  return true;
+}
+
+void AssetManager::SetPrefetchCacheLimit(size_t bytes) {
+  std::scoped_lock lock(prefetch_mutex_);
+  prefetch_cache_limit_ = bytes;
+  EvictPrefetchedAssets(bytes);
+}
+
+AssetManager::PrefetchStats AssetManager::GetPrefetchStats() const {
+  std::scoped_lock lock(prefetch_mutex_);
+  return prefetch_stats_;
+}
+
+void AssetManager::EvictPrefetchedAssets(size_t limit) {
+  while (prefetch_stats_.cached_bytes > limit) {
+    const auto& [name, mapping] = prefetch_cache_.back();
+    prefetch_stats_.cached_bytes -= mapping->GetSize();
+    prefetch_cache_index_.erase(name);
+    prefetch_cache_.pop_back();
+  }
+}
+
+void AssetManager::ClearPrefetchCache() {
+  std::scoped_lock lock(prefetch_mutex_);
+  EvictPrefetchedAssets(0);
+}
+
 // |AssetResolver|
 std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
     const std::string& asset_name) const {
@@ -67,6 +145,27 @@ std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
   }
   TRACE_EVENT1("flutter", "AssetManager::GetAsMapping", "name",
                asset_name.c_str());
+  {
+    std::scoped_lock lock(prefetch_mutex_);
+    auto found = prefetch_cache_index_.find(asset_name);
+    if (found != prefetch_cache_index_.end()) {
+      prefetch_stats_.hits++;
+      prefetch_cache_.splice(prefetch_cache_.begin(), prefetch_cache_,
+                             found->second);
+      std::shared_ptr<fml::Mapping> mapping = found->second->second;
+      const uint8_t* data = mapping->GetMapping();
+      const size_t size = mapping->GetSize();
+      return std::make_unique<fml::NonOwnedMapping>(
+          data, size,
+          [mapping = std::move(mapping)](const uint8_t*, size_t) {});
+    }
+    prefetch_stats_.misses++;
+  }
+  return FindAsMapping(asset_name);
+}
+
+std::unique_ptr<fml::Mapping> AssetManager::FindAsMapping(
+    const std::string& asset_name) const {
   for (const auto& resolver : resolvers_) {
     auto mapping = resolver->GetAsMapping(asset_name);
     if (mapping != nullptr) {
@@ -6,8 +6,11 @@
 #define FLUTTER_ASSETS_ASSET_MANAGER_H_
 
 #include <deque>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include <optional>
 #include "flutter/assets/asset_resolver.h"
@@ -70,6 +73,42 @@ class AssetManager final : public AssetResolver {
 
   std::deque<std::unique_ptr<AssetResolver>> TakeResolvers();
 
+  //--------------------------------------------------------------------------
+  /// @brief      Loads an asset ahead of its use, so that a later call to
+  ///             |GetAsMapping| for it does not wait for storage.
+  ///
+  ///             The pages of the asset are read, which brings mapped files
+  ///             into the page cache, and the asset is kept in a cache of at
+  ///             most |SetPrefetchCacheLimit| bytes that evicts the least
+  ///             recently used assets first. Assets larger than the limit are
+  ///             read but not kept.
+  ///
+  ///             This blocks on storage, so it is meant to be called on a
+  ///             worker thread. It may be called on several threads at once.
+  ///
+  /// @param[in]  asset_name  The name of the asset to load.
+  ///
+  /// @return     Returns whether the asset was found.
+  ///
+  bool Prefetch(const std::string& asset_name);
+
+  //--------------------------------------------------------------------------
+  /// @brief      Sets the number of bytes of prefetched assets that are kept,
+  ///             and evicts assets that no longer fit.
+  ///
+  void SetPrefetchCacheLimit(size_t bytes);
+
+  struct PrefetchStats {
+    /// The number of |GetAsMapping| calls answered by the prefetch cache.
+    size_t hits = 0;
+    /// The number of |GetAsMapping| calls that went to the resolvers.
+    size_t misses = 0;
+    /// The number of bytes of assets in the prefetch cache.
+    size_t cached_bytes = 0;
+  };
+
+  PrefetchStats GetPrefetchStats() const;
+
   // |AssetResolver|
   bool IsValid() const override;
 
@@ -89,8 +128,27 @@ class AssetManager final : public AssetResolver {
       const std::optional<std::string>& subdir) const override;
 
  private:
+  using PrefetchCacheList =
+      std::list<std::pair<std::string, std::shared_ptr<fml::Mapping>>>;
+
   std::deque<std::unique_ptr<AssetResolver>> resolvers_;
 
+  mutable std::mutex prefetch_mutex_;
+  // Most recently used first.
+  mutable PrefetchCacheList prefetch_cache_;
+  mutable std::unordered_map<std::string, PrefetchCacheList::iterator>
+      prefetch_cache_index_;
+  size_t prefetch_cache_limit_;
+  mutable PrefetchStats prefetch_stats_;
+
+  std::unique_ptr<fml::Mapping> FindAsMapping(
+      const std::string& asset_name) const;
+
+  // Must be called with |prefetch_mutex_| held.
+  void EvictPrefetchedAssets(size_t limit);
+
+  void ClearPrefetchCache();
+
   FML_DISALLOW_COPY_AND_ASSIGN(AssetManager);
 };
 
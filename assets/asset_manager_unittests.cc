@@ -0,0 +1,114 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/asset_manager.h"
+
+#include <map>
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class FakeAssetResolver : public AssetResolver {
+ public:
+  explicit FakeAssetResolver(std::map<std::string, std::string> assets)
+      : assets_(std::move(assets)) {}
+
+  bool IsValid() const override { return true; }
+
+  bool IsValidAfterAssetManagerChange() const override { return false; }
+
+  AssetResolverType GetType() const override {
+    return AssetResolverType::kDirectoryAssetBundle;
+  }
+
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override {
+    lookups_++;
+    auto found = assets_.find(asset_name);
+    if (found == assets_.end()) {
+      return nullptr;
+    }
+    return std::make_unique<fml::DataMapping>(found->second);
+  }
+
+  size_t lookups() const { return lookups_; }
+
+ private:
+  const std::map<std::string, std::string> assets_;
+  mutable size_t lookups_ = 0;
+};
+
+}  // namespace
+
+TEST(AssetManagerTest, PrefetchedAssetsAreServedFromTheCache) {
+  AssetManager manager;
+  auto resolver = std::make_unique<FakeAssetResolver>(
+      std::map<std::string, std::string>{{"a", "first"}, {"b", "second"}});
+  const FakeAssetResolver* fake_resolver = resolver.get();
+  manager.PushBack(std::move(resolver));
+
+  EXPECT_TRUE(manager.Prefetch("a"));
+  EXPECT_FALSE(manager.Prefetch("missing"));
+  EXPECT_EQ(fake_resolver->lookups(), 2u);
+
+  auto mapping = manager.GetAsMapping("a");
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                        mapping->GetSize()),
+            "first");
+  EXPECT_EQ(fake_resolver->lookups(), 2u);
+  EXPECT_NE(manager.GetAsMapping("b"), nullptr);
+
+  AssetManager::PrefetchStats stats = manager.GetPrefetchStats();
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_EQ(stats.misses, 1u);
+  EXPECT_EQ(stats.cached_bytes, 5u);
+}
+
+TEST(AssetManagerTest, PrefetchCacheEvictsLeastRecentlyUsedAssets) {
+  AssetManager manager;
+  manager.PushBack(std::make_unique<FakeAssetResolver>(
+      std::map<std::string, std::string>{
+          {"a", "1234"}, {"b", "5678"}, {"c", "9012"}, {"big", "123456789"}}));
+  manager.SetPrefetchCacheLimit(8);
+
+  EXPECT_TRUE(manager.Prefetch("a"));
+  EXPECT_TRUE(manager.Prefetch("b"));
+  EXPECT_NE(manager.GetAsMapping("a"), nullptr);
+  EXPECT_TRUE(manager.Prefetch("c"));
+  EXPECT_TRUE(manager.Prefetch("big"));
+  EXPECT_EQ(manager.GetPrefetchStats().cached_bytes, 8u);
+
+  // "b" was the least recently used asset when "c" was added, and "big" does
+  // not fit at all.
+  EXPECT_NE(manager.GetAsMapping("a"), nullptr);
+  EXPECT_NE(manager.GetAsMapping("b"), nullptr);
+  EXPECT_NE(manager.GetAsMapping("big"), nullptr);
+  EXPECT_EQ(manager.GetPrefetchStats().hits, 2u);
+  EXPECT_EQ(manager.GetPrefetchStats().misses, 2u);
+}
+
+TEST(AssetManagerTest, ChangingResolversClearsThePrefetchCache) {
+  AssetManager manager;
+  manager.PushBack(std::make_unique<FakeAssetResolver>(
+      std::map<std::string, std::string>{{"a", "old"}}));
+  EXPECT_TRUE(manager.Prefetch("a"));
+
+  manager.PushFront(std::make_unique<FakeAssetResolver>(
+      std::map<std::string, std::string>{{"a", "new"}}));
+  EXPECT_EQ(manager.GetPrefetchStats().cached_bytes, 0u);
+
+  auto mapping = manager.GetAsMapping("a");
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                        mapping->GetSize()),
+            "new");
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -14,6 +14,20 @@
 
 namespace flutter {
 
+namespace {
+
+// Assets are usually read in full right after they are mapped. Files smaller
+// than this fit in the readahead window of the kernel anyway.
+constexpr size_t kPrefetchThreshold = 64 * 1024;
+
+void PrefetchIfLarge(const fml::FileMapping& mapping) {
+  if (mapping.GetSize() >= kPrefetchThreshold) {
+    mapping.Prefetch(0, mapping.GetSize());
+  }
+}
+
+}  // namespace
+
 DirectoryAssetBundle::DirectoryAssetBundle(
     fml::UniqueFD descriptor,
     bool is_valid_after_asset_manager_change)
@@ -57,6 +71,7 @@ std::unique_ptr<fml::Mapping> DirectoryAssetBundle::GetAsMapping(
     return nullptr;
   }
 
+  PrefetchIfLarge(*mapping);
   return mapping;
 }
 
@@ -87,6 +102,7 @@ std::vector<std::unique_ptr<fml::Mapping>> DirectoryAssetBundle::GetAsMappings(
       auto mapping = std::make_unique<fml::FileMapping>(fd);
 
       if (mapping && mapping->IsValid()) {
+        PrefetchIfLarge(*mapping);
         mappings.push_back(std::move(mapping));
       } else {
         FML_LOG(ERROR) << "Mapping " << filename << " failed";
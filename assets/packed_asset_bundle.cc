@@ -0,0 +1,528 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/packed_asset_bundle.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <regex>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/zlib/zlib.h"
+
+namespace flutter {
+
+namespace {
+
+// A bundle is laid out as follows, with integers in the byte order of the
+// host, which is little endian on all supported targets:
+//
+//   Header
+//   int32_t displacements[entry_count]
+//   IndexEntry entries[entry_count]
+//   char names[]
+//   the dictionary, if any
+//   the contents of the compressed assets
+//   padding up to kPageSize
+//   the contents of the stored assets, each starting at a multiple of kPageSize
+//
+// The entries form a hash table with one slot per asset, built with the hash,
+// displace and compress algorithm. Every name falls into the bucket given by
+// hashing it with seed 0. A negative displacement d means that the bucket has
+// a single name, in slot -d - 1. Otherwise, the slot of each name in the
+// bucket is given by hashing it with seed d.
+//
+// Compressed assets are zlib streams. Those that were compressed with the
+// dictionary of the bundle have the FDICT flag set.
+constexpr char kMagic[8] = {'F', 'L', 'T', 'P', 'A', 'C', 'K', '\0'};
+constexpr uint32_t kVersion = 2;
+constexpr size_t kPageSize = 4096;
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t entry_count;
+  uint64_t dictionary_offset;
+  uint64_t dictionary_size;
+};
+static_assert(sizeof(Header) == 32);
+
+enum class StoredCompression : uint32_t {
+  kNone = 0,
+  kDeflate = 1,
+};
+
+struct IndexEntry {
+  uint64_t data_offset;
+  uint64_t data_size;
+  uint64_t uncompressed_size;
+  uint32_t name_offset;
+  uint32_t name_size;
+  StoredCompression compression;
+  uint32_t reserved;
+};
+static_assert(sizeof(IndexEntry) == 40);
+
+// Same as in DirectoryAssetBundle.
+constexpr size_t kPrefetchThreshold = 64 * 1024;
+
+// FNV-1a over the seed followed by the name, with the finalizer of
+// MurmurHash3 so that the low bits, which pick the slot, depend on all bytes.
+uint32_t Hash(std::string_view name, uint32_t seed) {
+  uint32_t hash = 0x811C9DC5u;
+  auto add = [&hash](uint8_t byte) {
+    hash ^= byte;
+    hash *= 0x01000193u;
+  };
+  for (size_t i = 0; i < sizeof(seed); i++) {
+    add(static_cast<uint8_t>(seed >> (i * 8)));
+  }
+  for (char c : name) {
+    add(static_cast<uint8_t>(c));
+  }
+  hash ^= hash >> 16;
+  hash *= 0x85EBCA6Bu;
+  hash ^= hash >> 13;
+  hash *= 0xC2B2AE35u;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+size_t AlignToPage(size_t offset) {
+  return (offset + kPageSize - 1) / kPageSize * kPageSize;
+}
+
+// Returns the zlib stream for |contents|, or nullopt if compressing it does not
+// make it smaller.
+std::optional<std::vector<uint8_t>> Deflate(const fml::Mapping& contents,
+                                            const fml::Mapping* dictionary) {
+  z_stream stream = {};
+  if (deflateInit(&stream, Z_BEST_COMPRESSION) != Z_OK) {
+    return std::nullopt;
+  }
+  if (dictionary != nullptr &&
+      deflateSetDictionary(&stream, dictionary->GetMapping(),
+                           dictionary->GetSize()) != Z_OK) {
+    deflateEnd(&stream);
+    return std::nullopt;
+  }
+  std::vector<uint8_t> output(deflateBound(&stream, contents.GetSize()));
+  stream.next_in = const_cast<Bytef*>(contents.GetMapping());
+  stream.avail_in = contents.GetSize();
+  stream.next_out = output.data();
+  stream.avail_out = output.size();
+  const int result = deflate(&stream, Z_FINISH);
+  deflateEnd(&stream);
+  if (result != Z_STREAM_END || stream.total_out >= contents.GetSize()) {
+    return std::nullopt;
+  }
+  output.resize(stream.total_out);
+  return output;
+}
+
+}  // namespace
+
+PackedAssetBundle::PackedAssetBundle(const fml::UniqueFD& descriptor,
+                                     bool is_valid_after_asset_manager_change)
+    : is_valid_after_asset_manager_change_(
+          is_valid_after_asset_manager_change) {
+  auto file_mapping = std::make_shared<fml::FileMapping>(descriptor);
+  file_mapping_ = file_mapping.get();
+  mapping_ = std::move(file_mapping);
+  is_valid_ = ReadIndex();
+}
+
+PackedAssetBundle::PackedAssetBundle(
+    std::shared_ptr<const fml::Mapping> mapping,
+    bool is_valid_after_asset_manager_change)
+    : mapping_(std::move(mapping)),
+      is_valid_after_asset_manager_change_(
+          is_valid_after_asset_manager_change) {
+  is_valid_ = ReadIndex();
+}
+
+PackedAssetBundle::~PackedAssetBundle() = default;
+
+bool PackedAssetBundle::ReadIndex() {
+  TRACE_EVENT0("flutter", "PackedAssetBundle::ReadIndex");
+  const uint8_t* base = mapping_ ? mapping_->GetMapping() : nullptr;
+  const uint64_t size = mapping_ ? mapping_->GetSize() : 0;
+  if (base == nullptr || size < sizeof(Header)) {
+    return false;
+  }
+
+  Header header;
+  std::memcpy(&header, base, sizeof(Header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion) {
+    FML_LOG(ERROR) << "Asset bundle has an unknown format.";
+    return false;
+  }
+
+  if (header.dictionary_offset > size ||
+      header.dictionary_size > size - header.dictionary_offset) {
+    FML_LOG(ERROR) << "Asset bundle dictionary is truncated.";
+    return false;
+  }
+  if (header.dictionary_size > 0) {
+    dictionary_ = base + header.dictionary_offset;
+    dictionary_size_ = header.dictionary_size;
+  }
+
+  const uint64_t count = header.entry_count;
+  if (count == 0) {
+    return true;
+  }
+  const uint8_t* cursor = base + sizeof(Header);
+  if (sizeof(Header) + count * (sizeof(int32_t) + sizeof(IndexEntry)) >
+      size) {
+    FML_LOG(ERROR) << "Asset bundle index is truncated.";
+    return false;
+  }
+
+  displacements_.resize(count);
+  std::memcpy(displacements_.data(), cursor, count * sizeof(int32_t));
+  cursor += count * sizeof(int32_t);
+  for (int32_t displacement : displacements_) {
+    if (displacement < 0 &&
+        static_cast<uint64_t>(-(displacement + 1)) >= count) {
+      FML_LOG(ERROR) << "Asset bundle index is corrupt.";
+      return false;
+    }
+  }
+
+  entries_.resize(count);
+  for (Entry& entry : entries_) {
+    IndexEntry index_entry;
+    std::memcpy(&index_entry, cursor, sizeof(IndexEntry));
+    cursor += sizeof(IndexEntry);
+    if (uint64_t{index_entry.name_offset} + index_entry.name_size > size ||
+        index_entry.data_offset > size ||
+        index_entry.data_size > size - index_entry.data_offset ||
+        (index_entry.compression != StoredCompression::kNone &&
+         index_entry.compression != StoredCompression::kDeflate)) {
+      FML_LOG(ERROR) << "Asset bundle index is corrupt.";
+      return false;
+    }
+    entry.name = {
+        reinterpret_cast<const char*>(base + index_entry.name_offset),
+        index_entry.name_size};
+    entry.data = base + index_entry.data_offset;
+    entry.size = index_entry.data_size;
+    entry.is_compressed =
+        index_entry.compression == StoredCompression::kDeflate;
+    entry.uncompressed_size =
+        entry.is_compressed ? index_entry.uncompressed_size : entry.size;
+  }
+  return true;
+}
+
+const PackedAssetBundle::Entry* PackedAssetBundle::FindEntry(
+    std::string_view name) const {
+  if (entries_.empty()) {
+    return nullptr;
+  }
+  const size_t count = entries_.size();
+  const int32_t displacement = displacements_[Hash(name, 0) % count];
+  const size_t slot = displacement < 0 ? -(displacement + 1)
+                                       : Hash(name, displacement) % count;
+  const Entry& entry = entries_[slot];
+  return entry.name == name ? &entry : nullptr;
+}
+
+std::unique_ptr<fml::Mapping> PackedAssetBundle::MappingForEntry(
+    const Entry& entry) const {
+  if (entry.is_compressed) {
+    return Inflate(entry);
+  }
+  if (file_mapping_ && entry.size >= kPrefetchThreshold) {
+    file_mapping_->Prefetch(entry.data - file_mapping_->GetMapping(),
+                            entry.size);
+  }
+  // The asset points into the mapping of the bundle, which it keeps alive.
+  return std::make_unique<fml::NonOwnedMapping>(
+      entry.data, entry.size,
+      [mapping = mapping_](const uint8_t* data, size_t size) {});
+}
+
+std::unique_ptr<fml::Mapping> PackedAssetBundle::Inflate(
+    const Entry& entry) const {
+  TRACE_EVENT1("flutter", "PackedAssetBundle::Inflate", "name",
+               std::string(entry.name).c_str());
+  // The size of the asset is known up front, so it is inflated in one pass
+  // straight into its final buffer.
+  uint8_t* buffer = static_cast<uint8_t*>(
+      ::malloc(std::max<size_t>(entry.uncompressed_size, 1)));
+  if (buffer == nullptr) {
+    return nullptr;
+  }
+  fml::MallocMapping mapping(buffer, entry.uncompressed_size);
+
+  z_stream stream = {};
+  if (inflateInit(&stream) != Z_OK) {
+    return nullptr;
+  }
+  stream.next_in = const_cast<Bytef*>(entry.data);
+  stream.avail_in = entry.size;
+  stream.next_out = buffer;
+  stream.avail_out = entry.uncompressed_size;
+  int result = inflate(&stream, Z_FINISH);
+  if (result == Z_NEED_DICT && dictionary_ != nullptr) {
+    result = inflateSetDictionary(&stream, dictionary_, dictionary_size_);
+    if (result == Z_OK) {
+      result = inflate(&stream, Z_FINISH);
+    }
+  }
+  inflateEnd(&stream);
+  if (result != Z_STREAM_END || stream.total_out != entry.uncompressed_size) {
+    FML_LOG(ERROR) << "Could not inflate asset " << entry.name << ".";
+    return nullptr;
+  }
+  return std::make_unique<fml::MallocMapping>(std::move(mapping));
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::IsValid() const {
+  return is_valid_;
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::IsValidAfterAssetManagerChange() const {
+  return is_valid_after_asset_manager_change_;
+}
+
+// |AssetResolver|
+AssetResolver::AssetResolverType PackedAssetBundle::GetType() const {
+  return AssetResolver::AssetResolverType::kPackedAssetBundle;
+}
+
+// |AssetResolver|
+std::unique_ptr<fml::Mapping> PackedAssetBundle::GetAsMapping(
+    const std::string& asset_name) const {
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Asset bundle was not valid.";
+    return nullptr;
+  }
+
+  const Entry* entry = FindEntry(asset_name);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  return MappingForEntry(*entry);
+}
+
+// |AssetResolver|
+std::vector<std::unique_ptr<fml::Mapping>> PackedAssetBundle::GetAsMappings(
+    const std::string& asset_pattern,
+    const std::optional<std::string>& subdir) const {
+  std::vector<std::unique_ptr<fml::Mapping>> mappings;
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Asset bundle was not valid.";
+    return mappings;
+  }
+
+  // Matches the behavior of DirectoryAssetBundle: the pattern applies to file
+  // names, and a subdirectory limits the search to the assets directly in it.
+  std::regex asset_regex(asset_pattern);
+  for (const Entry& entry : entries_) {
+    const size_t separator = entry.name.rfind('/');
+    std::string_view directory;
+    std::string_view file_name = entry.name;
+    if (separator != std::string_view::npos) {
+      directory = entry.name.substr(0, separator);
+      file_name = entry.name.substr(separator + 1);
+    }
+    if (subdir.has_value() && directory != subdir.value()) {
+      continue;
+    }
+    if (std::regex_match(file_name.begin(), file_name.end(), asset_regex)) {
+      mappings.push_back(MappingForEntry(entry));
+    }
+  }
+  return mappings;
+}
+
+PackedAssetBundleBuilder::PackedAssetBundleBuilder() = default;
+
+PackedAssetBundleBuilder::~PackedAssetBundleBuilder() = default;
+
+void PackedAssetBundleBuilder::AddAsset(const std::string& name,
+                                        std::unique_ptr<fml::Mapping> contents,
+                                        Compression compression) {
+  FML_DCHECK(contents);
+  assets_[name] = {std::move(contents), compression};
+}
+
+void PackedAssetBundleBuilder::SetDictionary(
+    std::unique_ptr<fml::Mapping> dictionary) {
+  dictionary_ = std::move(dictionary);
+}
+
+std::vector<uint8_t> PackedAssetBundleBuilder::Build() const {
+  const uint32_t count = assets_.size();
+  Header header = {};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.entry_count = count;
+  if (count == 0) {
+    std::vector<uint8_t> bundle(sizeof(Header));
+    std::memcpy(bundle.data(), &header, sizeof(Header));
+    return bundle;
+  }
+
+  std::vector<std::string_view> names;
+  names.reserve(count);
+  for (const auto& asset : assets_) {
+    names.push_back(asset.first);
+  }
+
+  // Place the largest buckets first, while most slots are still free.
+  std::vector<std::vector<uint32_t>> buckets(count);
+  for (uint32_t i = 0; i < count; i++) {
+    buckets[Hash(names[i], 0) % count].push_back(i);
+  }
+  std::vector<uint32_t> bucket_order(count);
+  std::iota(bucket_order.begin(), bucket_order.end(), 0);
+  std::stable_sort(bucket_order.begin(), bucket_order.end(),
+                   [&buckets](uint32_t a, uint32_t b) {
+                     return buckets[a].size() > buckets[b].size();
+                   });
+
+  std::vector<int32_t> displacements(count, 0);
+  std::vector<uint32_t> slots(count);
+  std::vector<bool> occupied(count, false);
+  uint32_t next_free_slot = 0;
+  for (uint32_t bucket_index : bucket_order) {
+    const std::vector<uint32_t>& bucket = buckets[bucket_index];
+    if (bucket.empty()) {
+      break;
+    }
+    if (bucket.size() == 1) {
+      // Single names need no hashing and take the remaining slots in order.
+      while (occupied[next_free_slot]) {
+        next_free_slot++;
+      }
+      occupied[next_free_slot] = true;
+      slots[bucket[0]] = next_free_slot;
+      displacements[bucket_index] = -static_cast<int32_t>(next_free_slot) - 1;
+      continue;
+    }
+    for (uint32_t seed = 1;; seed++) {
+      std::vector<uint32_t> bucket_slots;
+      for (uint32_t name_index : bucket) {
+        const uint32_t slot = Hash(names[name_index], seed) % count;
+        if (occupied[slot] || std::find(bucket_slots.begin(),
+                                        bucket_slots.end(),
+                                        slot) != bucket_slots.end()) {
+          break;
+        }
+        bucket_slots.push_back(slot);
+      }
+      if (bucket_slots.size() == bucket.size()) {
+        for (size_t i = 0; i < bucket.size(); i++) {
+          occupied[bucket_slots[i]] = true;
+          slots[bucket[i]] = bucket_slots[i];
+        }
+        displacements[bucket_index] = seed;
+        break;
+      }
+    }
+  }
+
+  const size_t names_offset =
+      sizeof(Header) + count * (sizeof(int32_t) + sizeof(IndexEntry));
+  size_t names_size = 0;
+  for (std::string_view name : names) {
+    names_size += name.size();
+  }
+  FML_CHECK(names_offset + names_size <= UINT32_MAX);
+
+  // Compressed assets are inflated into memory anyway, so they are packed
+  // tightly after the names. Stored assets follow, page aligned.
+  std::vector<std::optional<std::vector<uint8_t>>> compressed;
+  compressed.reserve(count);
+  for (const auto& [name, asset] : assets_) {
+    if (asset.compression == Compression::kNone) {
+      compressed.emplace_back(std::nullopt);
+      continue;
+    }
+    const bool use_dictionary =
+        asset.compression == Compression::kDeflateWithDictionary &&
+        dictionary_ != nullptr;
+    compressed.push_back(
+        Deflate(*asset.contents, use_dictionary ? dictionary_.get() : nullptr));
+  }
+
+  size_t offset = names_offset + names_size;
+  if (dictionary_ != nullptr) {
+    header.dictionary_offset = offset;
+    header.dictionary_size = dictionary_->GetSize();
+    offset += dictionary_->GetSize();
+  }
+
+  std::vector<IndexEntry> entries(count);
+  size_t name_offset = names_offset;
+  uint32_t name_index = 0;
+  for (const auto& [name, asset] : assets_) {
+    IndexEntry& entry = entries[slots[name_index]];
+    entry.name_offset = name_offset;
+    entry.name_size = name.size();
+    name_offset += name.size();
+    entry.uncompressed_size = asset.contents->GetSize();
+    if (compressed[name_index].has_value()) {
+      entry.compression = StoredCompression::kDeflate;
+      entry.data_offset = offset;
+      entry.data_size = compressed[name_index]->size();
+      offset += entry.data_size;
+    }
+    name_index++;
+  }
+
+  size_t bundle_size = offset;
+  offset = AlignToPage(offset);
+  name_index = 0;
+  for (const auto& [name, asset] : assets_) {
+    IndexEntry& entry = entries[slots[name_index]];
+    if (!compressed[name_index].has_value()) {
+      entry.compression = StoredCompression::kNone;
+      entry.data_offset = offset;
+      entry.data_size = asset.contents->GetSize();
+      bundle_size = offset + entry.data_size;
+      offset = AlignToPage(bundle_size);
+    }
+    name_index++;
+  }
+
+  std::vector<uint8_t> bundle(bundle_size, 0);
+  uint8_t* cursor = bundle.data();
+  std::memcpy(cursor, &header, sizeof(Header));
+  cursor += sizeof(Header);
+  std::memcpy(cursor, displacements.data(), count * sizeof(int32_t));
+  cursor += count * sizeof(int32_t);
+  std::memcpy(cursor, entries.data(), count * sizeof(IndexEntry));
+  if (header.dictionary_size > 0) {
+    std::memcpy(bundle.data() + header.dictionary_offset,
+                dictionary_->GetMapping(), header.dictionary_size);
+  }
+
+  name_index = 0;
+  for (const auto& [name, asset] : assets_) {
+    const IndexEntry& entry = entries[slots[name_index]];
+    std::memcpy(bundle.data() + entry.name_offset, name.data(), name.size());
+    const uint8_t* data = compressed[name_index].has_value()
+                              ? compressed[name_index]->data()
+                              : asset.contents->GetMapping();
+    if (entry.data_size > 0) {
+      std::memcpy(bundle.data() + entry.data_offset, data, entry.data_size);
+    }
+    name_index++;
+  }
+  return bundle;
+}
+
+}  // namespace flutter
@@ -0,0 +1,163 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+#define FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flutter/assets/asset_resolver.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      An asset resolver for a bundle that packs all assets into a
+///             single file.
+///
+///             The file is mapped once. It starts with an index that is a
+///             minimal perfect hash table over the asset names, so that looking
+///             up an asset neither opens a file nor makes a system call. The
+///             contents of stored assets are page aligned, so that each of
+///             them can be prefetched without reading its neighbors.
+///
+///             Assets may also be compressed with deflate, optionally with a
+///             dictionary shared by the whole bundle. Those are inflated into
+///             memory on the thread that requests them, which is usually a
+///             worker thread.
+///
+///             Bundles are written by |PackedAssetBundleBuilder|.
+///
+class PackedAssetBundle : public AssetResolver {
+ public:
+  /// The name of the bundle file in an assets directory. When it exists, it
+  /// is consulted before the other files of the directory.
+  static constexpr const char* kFileName = "assets.pack";
+
+  PackedAssetBundle(const fml::UniqueFD& descriptor,
+                    bool is_valid_after_asset_manager_change);
+
+  PackedAssetBundle(std::shared_ptr<const fml::Mapping> mapping,
+                    bool is_valid_after_asset_manager_change);
+
+  ~PackedAssetBundle() override;
+
+ private:
+  struct Entry {
+    std::string_view name;
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    bool is_compressed = false;
+    size_t uncompressed_size = 0;
+  };
+
+  std::shared_ptr<const fml::Mapping> mapping_;
+  // Set when the bundle was mapped from a file, to prefetch large assets.
+  const fml::FileMapping* file_mapping_ = nullptr;
+  std::vector<int32_t> displacements_;
+  std::vector<Entry> entries_;
+  const uint8_t* dictionary_ = nullptr;
+  size_t dictionary_size_ = 0;
+  bool is_valid_ = false;
+  bool is_valid_after_asset_manager_change_ = false;
+
+  bool ReadIndex();
+
+  const Entry* FindEntry(std::string_view name) const;
+
+  std::unique_ptr<fml::Mapping> MappingForEntry(const Entry& entry) const;
+
+  std::unique_ptr<fml::Mapping> Inflate(const Entry& entry) const;
+
+  // |AssetResolver|
+  bool IsValid() const override;
+
+  // |AssetResolver|
+  bool IsValidAfterAssetManagerChange() const override;
+
+  // |AssetResolver|
+  AssetResolver::AssetResolverType GetType() const override;
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override;
+
+  // |AssetResolver|
+  std::vector<std::unique_ptr<fml::Mapping>> GetAsMappings(
+      const std::string& asset_pattern,
+      const std::optional<std::string>& subdir) const override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PackedAssetBundle);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Writes assets in the format read by |PackedAssetBundle|.
+///
+class PackedAssetBundleBuilder {
+ public:
+  enum class Compression {
+    /// The asset is stored as is, and mapped without copies when read.
+    kNone,
+    /// The asset is compressed with deflate, and inflated when read.
+    kDeflate,
+    /// Same as |kDeflate|, with the dictionary given to |SetDictionary|. This
+    /// suits many small assets with common content, such as JSON files.
+    kDeflateWithDictionary,
+  };
+
+  PackedAssetBundleBuilder();
+
+  ~PackedAssetBundleBuilder();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds an asset to the bundle, replacing any asset that was
+  ///             added before under the same name.
+  ///
+  ///             Compressed assets that do not get smaller are stored as is.
+  ///
+  /// @param[in]  name         The name of the asset, relative to the root of
+  ///                          the assets directory, with '/' separated
+  ///                          components.
+  /// @param[in]  contents     The contents of the asset.
+  /// @param[in]  compression  How to store the asset.
+  ///
+  void AddAsset(const std::string& name,
+                std::unique_ptr<fml::Mapping> contents,
+                Compression compression = Compression::kNone);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the preset dictionary for assets that are added with
+  ///             |Compression::kDeflateWithDictionary|. It should hold strings
+  ///             that are common in those assets, most common last.
+  ///
+  void SetDictionary(std::unique_ptr<fml::Mapping> dictionary);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the contents of a bundle file with all the assets
+  ///             added so far.
+  ///
+  std::vector<uint8_t> Build() const;
+
+ private:
+  struct Asset {
+    std::unique_ptr<fml::Mapping> contents;
+    Compression compression = Compression::kNone;
+  };
+
+  std::map<std::string, Asset> assets_;
+  std::unique_ptr<fml::Mapping> dictionary_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PackedAssetBundleBuilder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
@@ -0,0 +1,177 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/packed_asset_bundle.h"
+
+#include <string>
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+std::unique_ptr<fml::Mapping> MakeContents(const std::string& contents) {
+  return std::make_unique<fml::DataMapping>(contents);
+}
+
+std::string ToString(const std::unique_ptr<fml::Mapping>& mapping) {
+  return {reinterpret_cast<const char*>(mapping->GetMapping()),
+          mapping->GetSize()};
+}
+
+std::unique_ptr<AssetResolver> MakeBundle(
+    const PackedAssetBundleBuilder& builder) {
+  return std::make_unique<PackedAssetBundle>(
+      std::make_shared<fml::DataMapping>(builder.Build()), true);
+}
+
+bool IsValidBundle(std::vector<uint8_t> contents) {
+  std::unique_ptr<AssetResolver> bundle = std::make_unique<PackedAssetBundle>(
+      std::make_shared<fml::DataMapping>(std::move(contents)), true);
+  return bundle->IsValid();
+}
+
+}  // namespace
+
+TEST(PackedAssetBundleTest, FindsEveryAsset) {
+  PackedAssetBundleBuilder builder;
+  for (int i = 0; i < 500; i++) {
+    builder.AddAsset("assets/image_" + std::to_string(i) + ".png",
+                     MakeContents("contents " + std::to_string(i)));
+  }
+  auto bundle = MakeBundle(builder);
+  ASSERT_TRUE(bundle->IsValid());
+  EXPECT_EQ(bundle->GetType(),
+            AssetResolver::AssetResolverType::kPackedAssetBundle);
+
+  for (int i = 0; i < 500; i++) {
+    auto mapping =
+        bundle->GetAsMapping("assets/image_" + std::to_string(i) + ".png");
+    ASSERT_NE(mapping, nullptr);
+    EXPECT_EQ(ToString(mapping), "contents " + std::to_string(i));
+  }
+  EXPECT_EQ(bundle->GetAsMapping("assets/image_500.png"), nullptr);
+  EXPECT_EQ(bundle->GetAsMapping(""), nullptr);
+}
+
+TEST(PackedAssetBundleTest, AlignsContentsToPages) {
+  PackedAssetBundleBuilder builder;
+  builder.AddAsset("a", MakeContents("first"));
+  builder.AddAsset("b", MakeContents(""));
+  builder.AddAsset("c", MakeContents("third"));
+  auto contents = std::make_shared<fml::DataMapping>(builder.Build());
+  PackedAssetBundle packed_bundle(contents, true);
+  AssetResolver& bundle = packed_bundle;
+
+  for (const char* name : {"a", "b", "c"}) {
+    auto mapping = bundle.GetAsMapping(name);
+    ASSERT_NE(mapping, nullptr);
+    EXPECT_EQ((mapping->GetMapping() - contents->GetMapping()) % 4096, 0);
+  }
+  EXPECT_EQ(bundle.GetAsMapping("b")->GetSize(), 0u);
+}
+
+TEST(PackedAssetBundleTest, MappingsOutliveTheBundle) {
+  PackedAssetBundleBuilder builder;
+  builder.AddAsset("fonts/Roboto.ttf", MakeContents("font"));
+  auto bundle = MakeBundle(builder);
+  auto mapping = bundle->GetAsMapping("fonts/Roboto.ttf");
+  bundle.reset();
+  EXPECT_EQ(ToString(mapping), "font");
+}
+
+TEST(PackedAssetBundleTest, GetAsMappingsMatchesFileNames) {
+  PackedAssetBundleBuilder builder;
+  builder.AddAsset("shaders/a.frag", MakeContents("a"));
+  builder.AddAsset("shaders/b.frag", MakeContents("b"));
+  builder.AddAsset("shaders/b.vert", MakeContents("c"));
+  builder.AddAsset("shaders/nested/c.frag", MakeContents("d"));
+  auto bundle = MakeBundle(builder);
+
+  EXPECT_EQ(bundle->GetAsMappings(".*\\.frag", std::nullopt).size(), 3u);
+  EXPECT_EQ(bundle->GetAsMappings(".*\\.frag", "shaders").size(), 2u);
+  EXPECT_EQ(bundle->GetAsMappings(".*", "shaders/nested").size(), 1u);
+  EXPECT_TRUE(bundle->GetAsMappings(".*", "fonts").empty());
+}
+
+TEST(PackedAssetBundleTest, RejectsCorruptBundles) {
+  PackedAssetBundleBuilder builder;
+  builder.AddAsset("a", MakeContents("contents"));
+  std::vector<uint8_t> contents = builder.Build();
+
+  std::vector<uint8_t> bad_magic = contents;
+  bad_magic[0] = 'X';
+  EXPECT_FALSE(IsValidBundle(std::move(bad_magic)));
+
+  std::vector<uint8_t> truncated(contents.begin(), contents.begin() + 20);
+  EXPECT_FALSE(IsValidBundle(std::move(truncated)));
+
+  std::unique_ptr<AssetResolver> missing =
+      std::make_unique<PackedAssetBundle>(
+          std::shared_ptr<const fml::Mapping>(), true);
+  EXPECT_FALSE(missing->IsValid());
+}
+
+TEST(PackedAssetBundleTest, InflatesCompressedAssets) {
+  const std::string json = R"({"name": "flutter", "version": 1, "tags": [)"
+                           R"("a", "a", "a", "a", "a", "a", "a", "a"]})";
+  PackedAssetBundleBuilder stored_builder;
+  stored_builder.AddAsset("data.json", MakeContents(json));
+  PackedAssetBundleBuilder builder;
+  builder.AddAsset("data.json", MakeContents(json),
+                   PackedAssetBundleBuilder::Compression::kDeflate);
+  EXPECT_LT(builder.Build().size(), stored_builder.Build().size());
+
+  auto bundle = MakeBundle(builder);
+  ASSERT_TRUE(bundle->IsValid());
+  auto mapping = bundle->GetAsMapping("data.json");
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_EQ(ToString(mapping), json);
+}
+
+TEST(PackedAssetBundleTest, InflatesAssetsCompressedWithTheDictionary) {
+  PackedAssetBundleBuilder builder;
+  builder.SetDictionary(MakeContents(R"({"locale": "", "messages": {}})"));
+  for (int i = 0; i < 10; i++) {
+    builder.AddAsset(
+        "l10n/" + std::to_string(i) + ".json",
+        MakeContents(R"({"locale": ")" + std::to_string(i) +
+                     R"(", "messages": {}})"),
+        PackedAssetBundleBuilder::Compression::kDeflateWithDictionary);
+  }
+  auto bundle = MakeBundle(builder);
+  ASSERT_TRUE(bundle->IsValid());
+
+  auto mapping = bundle->GetAsMapping("l10n/7.json");
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_EQ(ToString(mapping), R"({"locale": "7", "messages": {}})");
+  EXPECT_EQ(bundle->GetAsMappings(".*\\.json", "l10n").size(), 10u);
+}
+
+TEST(PackedAssetBundleTest, StoresAssetsThatDoNotCompress) {
+  PackedAssetBundleBuilder builder;
+  builder.AddAsset("a", MakeContents("x"),
+                   PackedAssetBundleBuilder::Compression::kDeflate);
+  auto contents = std::make_shared<fml::DataMapping>(builder.Build());
+  PackedAssetBundle packed_bundle(contents, true);
+  AssetResolver& bundle = packed_bundle;
+
+  auto mapping = bundle.GetAsMapping("a");
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_EQ(ToString(mapping), "x");
+  EXPECT_EQ(mapping->GetMapping() - contents->GetMapping(), 4096);
+}
+
+TEST(PackedAssetBundleTest, EmptyBundleIsValid) {
+  PackedAssetBundleBuilder builder;
+  auto bundle = MakeBundle(builder);
+  ASSERT_TRUE(bundle->IsValid());
+  EXPECT_EQ(bundle->GetAsMapping("a"), nullptr);
+  EXPECT_TRUE(bundle->GetAsMappings(".*", std::nullopt).empty());
+}
+
+}  // namespace testing
+}  // namespace flutter
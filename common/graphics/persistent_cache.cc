@@ -423,6 +423,25 @@ void PersistentCache::store(const SkData& key, const SkData& data) {
                        std::move(file_name), std::move(mapping));
 }
 
+void PersistentCache::StoreData(const SkData& key, const SkData& data) {
+  if (is_read_only_ || !IsValid()) {
+    return;
+  }
+
+  auto file_name = SkKeyToFilePath(key);
+  if (file_name.empty()) {
+    return;
+  }
+
+  std::unique_ptr<fml::MallocMapping> mapping = BuildCacheObject(key, data);
+  if (!mapping) {
+    return;
+  }
+
+  PersistentCacheStore(GetWorkerTaskRunner(), cache_directory_,
+                       std::move(file_name), std::move(mapping));
+}
+
 void PersistentCache::DumpSkp(const SkData& data) {
   if (is_read_only_ || !IsValid()) {
     FML_LOG(ERROR) << "Could not dump SKP from read-only or invalid persistent "
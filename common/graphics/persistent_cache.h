@@ -90,6 +90,10 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   // |GrContextOptions::PersistentCache|
   sk_sp<SkData> load(const SkData& key) override;
 
+  // Stores data other than shaders under |key|, where |load| finds it. Unlike
+  // |store|, this does not count as storing a new shader.
+  void StoreData(const SkData& key, const SkData& data);
+
   struct SkSLCache {
     sk_sp<SkData> key;
     sk_sp<SkData> value;
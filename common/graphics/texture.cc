@@ -4,16 +4,33 @@
 
 #include "flutter/common/graphics/texture.h"
 
+#include <atomic>
+
 namespace flutter {
 
+namespace {
+
+// Textures are created on both the UI and the raster thread.
+uint64_t NextFrameSequence() {
+  static std::atomic<uint64_t> next_frame_sequence = 1u;
+  return next_frame_sequence.fetch_add(1u, std::memory_order_relaxed);
+}
+
+}  // namespace
+
 ContextListener::ContextListener() = default;
 
 ContextListener::~ContextListener() = default;
 
-Texture::Texture(int64_t id) : id_(id) {}
+Texture::Texture(int64_t id) : id_(id), frame_sequence_(NextFrameSequence()) {}
 
 Texture::~Texture() = default;
 
+void Texture::MarkFrameAvailable() {
+  frame_sequence_ = NextFrameSequence();
+  MarkNewFrameAvailable();
+}
+
 TextureRegistry::TextureRegistry() = default;
 
 void TextureRegistry::RegisterTexture(const std::shared_ptr<Texture>& texture) {
@@ -90,7 +107,7 @@ void TextureRegistry::OnGrContextDestroyed() {
   }
 }
 
-std::shared_ptr<Texture> TextureRegistry::GetTexture(int64_t id) {
+std::shared_ptr<Texture> TextureRegistry::GetTexture(int64_t id) const {
   auto it = mapping_.find(id);
   return it != mapping_.end() ? it->second : nullptr;
 }
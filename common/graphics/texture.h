@@ -60,10 +60,21 @@ class Texture : public ContextListener {
   // Called on raster thread.
   virtual void OnTextureUnregistered() = 0;
 
+  // Called on raster thread. Advances the frame sequence of the texture and
+  // then calls |MarkNewFrameAvailable|.
+  void MarkFrameAvailable();
+
+  // Called on raster thread. Identifies the latest frame of the texture. The
+  // sequence only changes when a new frame is marked available, and no two
+  // textures share a sequence, so layers can compare it across frames to tell
+  // whether the content they show changed.
+  uint64_t GetFrameSequence() const { return frame_sequence_; }
+
   int64_t Id() { return id_; }
 
  private:
   int64_t id_;
+  uint64_t frame_sequence_;
   FML_DISALLOW_COPY_AND_ASSIGN(Texture);
 };
 
@@ -85,7 +96,7 @@ class TextureRegistry {
   void UnregisterContextListener(uintptr_t id);
 
   // Called from raster thread.
-  std::shared_ptr<Texture> GetTexture(int64_t id);
+  std::shared_ptr<Texture> GetTexture(int64_t id) const;
 
   // Called from raster thread.
   void OnGrContextCreated();
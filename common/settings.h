@@ -17,6 +17,7 @@
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/closure.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/thread_scheduling.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/unique_fd.h"
 
@@ -38,7 +39,12 @@ class FrameTiming {
       kVsyncStart,  kBuildStart,   kBuildFinish,
       kRasterStart, kRasterFinish, kRasterFinishWallTime};
 
-  static constexpr int kStatisticsCount = kCount + 5;
+  static constexpr int kStatisticsCount = kCount + 6;
+
+  /// The index of the GPU duration of a frame in its reported statistics. The
+  /// GPU duration is known only after the GPU finishes the frame, so the
+  /// shell fills it in after the frame has been rasterized.
+  static constexpr int kGpuDurationIndex = kCount + 4;
 
   fml::TimePoint Get(Phase phase) const { return data_[phase]; }
   fml::TimePoint Set(Phase phase, fml::TimePoint value) {
@@ -88,6 +94,11 @@ using MappingsCallback = std::function<Mappings(void)>;
 
 using FrameRasterizedCallback = std::function<void(const FrameTiming&)>;
 
+// Receives the trace ring buffer, in the JSON trace event format, as it was
+// when the frame with the given number janked.
+using JankTraceCallback =
+    std::function<void(int64_t frame_number, const std::string& trace)>;
+
 class DartIsolate;
 
 // TODO(https://github.com/flutter/flutter/issues/138750): Re-order fields to
@@ -135,6 +146,11 @@ struct Settings {
   // the VM service isolate.
   std::vector<std::string> vmservice_snapshot_library_path;
 
+  // Path to a profile of the snapshot ranges that the application touches
+  // while starting. See `StartupPageProfile` for the format. When set, those
+  // ranges are prefetched in the background as the VM is launched.
+  std::string startup_page_profile_path;
+
   std::string application_kernel_asset;       // deprecated
   std::string application_kernel_list_asset;  // deprecated
   MappingsCallback application_kernels;
@@ -150,6 +166,24 @@ struct Settings {
   bool trace_startup = false;
   bool trace_systrace = false;
   std::string trace_to_file;
+  // The number of trace events recorded per thread into the trace ring
+  // buffer, or 0 to leave it disabled. See flutter/fml/trace_ring_buffer.h.
+  size_t trace_ring_buffer_size = 0;
+  // The directory the trace ring buffer is written to whenever a frame misses
+  // its deadline. Nothing is written if this is empty.
+  std::string trace_ring_buffer_dump_directory;
+  // A frame is considered janky, and the trace ring buffer is snapshotted,
+  // when it takes longer than this many frame budgets from vsync to the end
+  // of rasterization. The latest snapshot is available through the
+  // _flutter.getJankTrace service extension.
+  double trace_ring_buffer_jank_threshold = 1.0;
+  // Called on the IO thread with every snapshot of the trace ring buffer taken
+  // for a janky frame.
+  JankTraceCallback jank_trace_callback;
+  // The directory a report of the wall time of every startup stage is written
+  // to once the first frame is rasterized. Only the first shell in the process
+  // writes a report. Nothing is recorded if this is empty.
+  std::string startup_report_directory;
   bool enable_timeline_event_handler = true;
   bool dump_skp_on_shader_compilation = false;
   bool cache_sksl = false;
@@ -213,6 +247,10 @@ struct Settings {
   // Enable the rendering of colors outside of the sRGB gamut.
   bool enable_wide_gamut = false;
 
+  // Record the common Canvas commands into a buffer in Dart and send them to
+  // the engine in batches, rather than with a native call per command.
+  bool batch_canvas_commands = false;
+
   // Enable the Impeller renderer on supported platforms. Ignored if Impeller is
   // not supported on the platform.
 #if FML_OS_IOS || FML_OS_IOS_SIMULATOR
@@ -224,14 +262,67 @@ struct Settings {
   // Requests a particular backend to be used (ex "opengles" or "vulkan")
   std::optional<std::string> impeller_backend;
 
+  // Metal binary archives, relative to the assets directory, that Impeller
+  // looks up pipelines in before compiling them.
+  std::vector<std::string> impeller_pipeline_archives;
+
+  // If set, Impeller records the pipelines it creates on Metal to a binary
+  // archive at this path. Archives harvested in warmup runs can be shipped
+  // as |impeller_pipeline_archives|.
+  std::string impeller_pipeline_archive_harvest_path;
+
   // Enable Vulkan validation on backends that support it. The validation layers
   // must be available to the application.
   bool enable_vulkan_validation = false;
 
+  // Requests a Vulkan swapchain present mode (ex "fifo", "fifo-relaxed",
+  // "mailbox" or "immediate"). Unsupported modes fall back to "fifo".
+  std::optional<std::string> vulkan_present_mode;
+
+  // The number of Vulkan swapchain images to request, or 0 to use one more
+  // than the minimum the surface requires.
+  uint32_t vulkan_swapchain_image_count = 0;
+
   // Enable GPU tracing in GLES backends.
   // Some devices claim to support the required APIs but crash on their usage.
   bool enable_opengl_gpu_tracing = false;
 
+  // Keep rasterizing on the raster thread when there are platform views, and
+  // only arrange the platform views on the platform thread. Android only.
+  bool async_platform_view_composition = false;
+
+  // The number of frames the UI thread may produce ahead of the raster
+  // thread, or 0 for the platform default of 1 or 2.
+  uint32_t frame_pipeline_depth = 0;
+
+  // Whether the animator picks when to start building each frame from the
+  // durations of recent frames, instead of always starting at vsync. It may
+  // delay the build to reduce latency, or target a later vsync when frames
+  // take longer than the frame interval.
+  bool predictive_frame_scheduling = false;
+
+  // Whether the frame rate is halved, and stale frames are dropped by the
+  // rasterizer, while rasterization is continuously slower than the frame
+  // budget. The frame rate recovers once the rasterizer catches up.
+  bool raster_overload_throttling = false;
+
+  // Whether pointer packets received while a dispatch is in progress are
+  // batched and dispatched to the framework once per vsync, instead of
+  // waking the UI thread for every packet of a high rate input device.
+  bool coalesce_pointer_events = false;
+
+  // Whether consecutive moves of a pointer batched by
+  // |coalesce_pointer_events| are merged into the latest one.
+  bool merge_coalesced_pointer_moves = false;
+
+  // OS scheduling settings applied to the engine threads once the shell is
+  // created. Empty policies leave the threads as the embedder created them.
+  fml::ThreadSchedulingPolicy platform_thread_policy;
+  fml::ThreadSchedulingPolicy ui_thread_policy;
+  fml::ThreadSchedulingPolicy raster_thread_policy;
+  fml::ThreadSchedulingPolicy io_thread_policy;
+  fml::ThreadSchedulingPolicy worker_thread_policy;
+
   // Data set by platform-specific embedders for use in font initialization.
   uint32_t font_initialization_data = 0;
 
@@ -253,6 +344,27 @@ struct Settings {
   // https://github.com/flutter/flutter/issues/96843
   bool leak_vm = true;
 
+  // Path to a DisplayList complexity table, see
+  // |DisplayListComplexityTable|. If empty the built-in complexity
+  // calculators are used.
+  std::string complexity_table_path;
+
+  // Rasterize new DisplayList raster cache entries on the IO thread, see
+  // |RasterCache::SetAsyncFillTaskRunner|.
+  bool enable_async_raster_cache = false;
+
+  // Pack small raster cache images into shared atlas pages, see
+  // |RasterCacheAtlas|.
+  bool enable_raster_cache_atlas = false;
+
+  // Decide which sibling DisplayList layers are worth caching on the
+  // concurrent workers during Preroll, see |Layer::PrepareForPreroll|.
+  bool enable_concurrent_preroll = false;
+
+  // Keep the filtered backdrop of each BackdropFilterLayer between frames
+  // and reuse it while the content behind the layer is unchanged.
+  bool enable_backdrop_filter_cache = false;
+
   // Engine settings
   TaskObserverAdd task_observer_add;
   TaskObserverRemove task_observer_remove;
@@ -320,6 +432,12 @@ struct Settings {
   // Due to this, the buffer must be as small as possible.
   std::shared_ptr<const fml::Mapping> persistent_isolate_data;
 
+  // The number of worker isolates to create in the isolate group of the root
+  // isolate when it is launched, each on its own thread. The embedder can
+  // invoke functions of the root library on them without waiting for an
+  // isolate to be spawned. See |WorkerIsolatePool|.
+  size_t worker_isolate_count = 0;
+
   /// Max size of old gen heap size in MB, or 0 for unlimited, -1 for default
   /// value.
   ///
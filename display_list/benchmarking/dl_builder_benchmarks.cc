@@ -4,6 +4,7 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/fml/memory/allocation_counter.h"
 
 namespace flutter {
 
@@ -62,11 +63,14 @@ bool NeedPrepareRTree(DisplayListBuilderBenchmarkType type) {
 static void BM_DisplayListBuilderDefault(benchmark::State& state,
                                          DisplayListBuilderBenchmarkType type) {
   bool prepare_rtree = NeedPrepareRTree(type);
+  fml::ScopedAllocationCounter allocations(fml::AllocationTag::kDisplayList);
   while (state.KeepRunning()) {
     DisplayListBuilder builder(prepare_rtree);
     InvokeAllRenderingOps(builder);
     Complete(builder, type);
   }
+  state.counters["AllocsPerIteration"] = benchmark::Counter(
+      allocations.GetCount().allocations, benchmark::Counter::kAvgIterations);
 }
 
 static void BM_DisplayListBuilderWithScaleAndTranslate(
@@ -149,6 +153,49 @@ static void BM_DisplayListBuilderWithSaveLayerAndImageFilter(
   }
 }
 
+// Simulates a frame of a scrolling feed that records many small pictures,
+// each of which is retired before the next frame records its replacement.
+// With an arena, steady-state frames should not allocate any op storage
+// from the heap, which is reported through the "HeapAllocs" counter.
+static void BM_DisplayListBuilderWithArena(benchmark::State& state,
+                                           bool use_arena) {
+  constexpr int kPicturesPerFrame = 100;
+  auto arena = use_arena ? DisplayListStorageArena::Create() : nullptr;
+  std::vector<sk_sp<DisplayList>> frame;
+  frame.reserve(kPicturesPerFrame);
+  size_t warm_heap_allocations = 0;
+  bool warmed_up = false;
+  fml::ScopedAllocationCounter allocations(fml::AllocationTag::kDisplayList);
+  while (state.KeepRunning()) {
+    frame.clear();
+    for (int i = 0; i < kPicturesPerFrame; i++) {
+      DisplayListBuilder builder(DisplayListBuilder::kMaxCullRect,
+                                 /*prepare_rtree=*/true, arena);
+      DlOpReceiver& receiver = DisplayListBuilderBenchmarkAccessor(builder);
+      for (int j = 0; j < 4; j++) {
+        allRenderingOps[i % allRenderingOps.size()].variants[0].Invoke(
+            receiver);
+      }
+      frame.push_back(builder.Build());
+    }
+    if (arena && !warmed_up) {
+      warmed_up = true;
+      warm_heap_allocations = arena->GetStats().heap_allocations;
+    }
+  }
+  if (arena) {
+    state.counters["HeapAllocs"] = benchmark::Counter(
+        arena->GetStats().heap_allocations - warm_heap_allocations);
+  }
+  state.counters["AllocsPerIteration"] = benchmark::Counter(
+      allocations.GetCount().allocations, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_CAPTURE(BM_DisplayListBuilderWithArena, kHeap, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListBuilderWithArena, kArena, true)
+    ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_CAPTURE(BM_DisplayListBuilderDefault,
                   kDefault,
                   DisplayListBuilderBenchmarkType::kDefault)
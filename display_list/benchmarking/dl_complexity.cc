@@ -5,6 +5,7 @@
 #include "flutter/display_list/benchmarking/dl_complexity.h"
 #include "flutter/display_list/benchmarking/dl_complexity_gl.h"
 #include "flutter/display_list/benchmarking/dl_complexity_metal.h"
+#include "flutter/display_list/benchmarking/dl_complexity_table.h"
 #include "flutter/display_list/display_list.h"
 
 namespace flutter {
@@ -22,6 +23,13 @@ DisplayListNaiveComplexityCalculator::GetInstance() {
 
 DisplayListComplexityCalculator* DisplayListComplexityCalculator::GetForBackend(
     GrBackendApi backend) {
+  if (backend != GrBackendApi::kMock) {
+    DisplayListComplexityCalculator* calibrated =
+        DisplayListTableComplexityCalculator::GetInstalled();
+    if (calibrated != nullptr) {
+      return calibrated;
+    }
+  }
   switch (backend) {
     case GrBackendApi::kMetal:
       return DisplayListMetalComplexityCalculator::GetInstance();
@@ -0,0 +1,443 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the raster cost of each kind of op on the device this runs on
+// and writes a |DisplayListComplexityTable| that can be handed to the
+// engine with --complexity-table-path so that raster cache admission is
+// based on the GPU the app is actually deployed on.
+//
+//   display_list_complexity_calibration --backend=opengl \
+//       --output=/data/local/tmp/complexity_table.txt
+//
+// Every entry is measured by rasterizing a DisplayList of |kOpsPerSample|
+// ops at several sizes and fitting a straight line through the time per
+// op against the units of the entry, see dl_complexity_table.h.
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+#include "flutter/display_list/benchmarking/dl_complexity_table.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/skia/dl_sk_canvas.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/display_list/testing/dl_test_surface_provider.h"
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/time/time_point.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/GrRecordingContext.h"
+
+namespace flutter {
+namespace testing {
+namespace {
+
+using Entry = DisplayListComplexityTable::Entry;
+using BackendType = DlSurfaceProvider::BackendType;
+
+constexpr size_t kOpsPerSample = 100;
+constexpr size_t kRepetitions = 5;
+constexpr size_t kCanvasSize = 2048;
+constexpr int kSizes[] = {16, 32, 64, 128, 256, 512, 1024};
+
+// A score of 200000 is roughly 1ms, see dl_complexity_table.h.
+constexpr double kScorePerNanosecond = 0.2;
+
+struct Probe {
+  Entry entry;
+  // Records |kOpsPerSample| ops of the entry's kind at the given size into
+  // |builder| and returns the units of each op.
+  std::function<float(DisplayListBuilder& builder, int size)> record;
+};
+
+void FlushSubmitCpuSync(const sk_sp<SkSurface>& surface) {
+  if (GrDirectContext* context =
+          GrAsDirectContext(surface->recordingContext())) {
+    context->flushAndSubmit(surface.get(), GrSyncCpu::kYes);
+  }
+}
+
+class Calibrator {
+ public:
+  explicit Calibrator(std::unique_ptr<DlSurfaceProvider> provider)
+      : provider_(std::move(provider)) {
+    provider_->InitializeSurface(kCanvasSize, kCanvasSize);
+    surface_ = provider_->GetPrimarySurface()->sk_surface();
+  }
+
+  // The median time in nanoseconds taken to rasterize one op of
+  // |display_list|.
+  double MeasureNanosecondsPerOp(const sk_sp<DisplayList>& display_list) {
+    DlSkCanvasAdapter canvas(surface_->getCanvas());
+    // Warm up caches and pipelines before measuring.
+    canvas.DrawDisplayList(display_list);
+    FlushSubmitCpuSync(surface_);
+    std::vector<double> samples;
+    for (size_t i = 0; i < kRepetitions; i++) {
+      fml::TimePoint start = fml::TimePoint::Now();
+      canvas.DrawDisplayList(display_list);
+      FlushSubmitCpuSync(surface_);
+      samples.push_back((fml::TimePoint::Now() - start).ToNanosecondsF());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2] / kOpsPerSample;
+  }
+
+  // Fits cost = fixed + per_unit * units by least squares over the sizes.
+  DisplayListComplexityTable::Coefficients Measure(const Probe& probe,
+                                                   bool anti_alias) {
+    std::vector<std::pair<double, double>> points;
+    for (int size : kSizes) {
+      DisplayListBuilder builder;
+      builder.Clear(DlColor::kTransparent());
+      anti_alias_ = anti_alias;
+      float units = probe.record(builder, size);
+      double cost = MeasureNanosecondsPerOp(builder.Build()) *
+                    kScorePerNanosecond;
+      points.emplace_back(units, cost);
+    }
+    return FitLine(points);
+  }
+
+  sk_sp<SkSurface> surface() const { return surface_; }
+  DlSurfaceProvider* provider() const { return provider_.get(); }
+  bool anti_alias() const { return anti_alias_; }
+
+ private:
+  static DisplayListComplexityTable::Coefficients FitLine(
+      const std::vector<std::pair<double, double>>& points) {
+    double n = points.size();
+    double sum_x = 0, sum_y = 0, sum_xx = 0, sum_xy = 0;
+    for (auto& [x, y] : points) {
+      sum_x += x;
+      sum_y += y;
+      sum_xx += x * x;
+      sum_xy += x * y;
+    }
+    double denominator = n * sum_xx - sum_x * sum_x;
+    if (denominator == 0) {
+      // All samples have the same units, the cost is fixed.
+      return {static_cast<float>(sum_y / n), 0.0f};
+    }
+    double per_unit = (n * sum_xy - sum_x * sum_y) / denominator;
+    double fixed = (sum_y - per_unit * sum_x) / n;
+    // Negative costs are measurement noise.
+    return {static_cast<float>(std::max(fixed, 0.0)),
+            static_cast<float>(std::max(per_unit, 0.0))};
+  }
+
+  std::unique_ptr<DlSurfaceProvider> provider_;
+  sk_sp<SkSurface> surface_;
+  bool anti_alias_ = false;
+};
+
+std::vector<Probe> MakeProbes(Calibrator& calibrator) {
+  auto paint = [&calibrator](DlDrawStyle style) {
+    DlPaint paint(DlColor::kBlue());
+    paint.setDrawStyle(style);
+    paint.setAntiAlias(calibrator.anti_alias());
+    return paint;
+  };
+  auto image = [&calibrator](int size) {
+    auto offscreen = calibrator.provider()->MakeOffscreenSurface(size, size);
+    offscreen->sk_surface()->getCanvas()->clear(SK_ColorRED);
+    return DlImage::Make(offscreen->sk_surface()->makeImageSnapshot());
+  };
+  auto rect = [](size_t i, int size) {
+    // Offset each op so that they do not all hit the same pixels.
+    SkScalar offset = (i % 16) * 0.5f;
+    return SkRect::MakeXYWH(offset, offset, size, size);
+  };
+  const DlPaint fill = paint(DlDrawStyle::kFill);
+
+  return {
+      {Entry::kSaveLayer,
+       [=](DisplayListBuilder& builder, int size) {
+         for (size_t i = 0; i < kOpsPerSample; i++) {
+           builder.SaveLayer(nullptr, nullptr);
+           builder.DrawRect(rect(i, 16), fill);
+           builder.Restore();
+         }
+         return 0.0f;
+       }},
+      {Entry::kDrawColor,
+       [=](DisplayListBuilder& builder, int size) {
+         for (size_t i = 0; i < kOpsPerSample; i++) {
+           builder.DrawColor(DlColor::kBlue(), DlBlendMode::kSrcOver);
+         }
+         return 0.0f;
+       }},
+      {Entry::kDrawPaint,
+       [=](DisplayListBuilder& builder, int size) {
+         for (size_t i = 0; i < kOpsPerSample; i++) {
+           builder.DrawPaint(fill);
+         }
+         return 0.0f;
+       }},
+      {Entry::kDrawLine,
+       [=](DisplayListBuilder& builder, int size) {
+         DlPaint stroke = paint(DlDrawStyle::kStroke);
+         for (size_t i = 0; i < kOpsPerSample; i++) {
+           SkRect r = rect(i, size);
+           builder.DrawLine({r.fLeft, r.fTop}, {r.fRight, r.fTop}, stroke);
+         }
+         return static_cast<float>(size);
+       }},
+      {Entry::kFillRect,
+       [=](DisplayListBuilder& builder, int size) {
+         DlPaint p = paint(DlDrawStyle::kFill);
+         for (size_t i = 0; i < kOpsPerSample; i++) {
+           builder.DrawRect(rect(i, size), p);
+         }
+         return static_cast<float>(size) * size;
+       }},
+      {Entry::kStrokeRect,
+       [=](DisplayListBuilder& builder, int size) {
+         DlPaint p = paint(DlDrawStyle::kStroke);
+         for (size_t i = 0; i < kOpsPerSample; i++) {
+           builder.DrawRect(rect(i, size), p);
+         }
+         return static_cast<float>(size);
+       }},
+      {Entry::kFillOval,
+       [=](DisplayListBuilder& builder, int size) {
+         DlPaint p = paint(DlDrawStyle::kFill);
+         for (size_t i = 0; i < kOpsPerSample; i++) {
+           builder.DrawOval(rect(i, size), p);
+         }
+         return static_cast<float>(size) * size;
+       }},
+      {Entry::kStrokeOval,
+       [=](DisplayListBuilder& builder, int size) {
+         DlPaint p = paint(DlDrawStyle::kStroke);
+         for (size_t i = 0; i < kOpsPerSample; i++) {
+           builder.DrawOval(rect(i, size), p);
+         }
+         return static_cast<float>(size);
+       }},
+      {Entry::kFillRRect,
+       [=](DisplayListBuilder& builder, int size) {
+         DlPaint p = paint(DlDrawStyle::kFill);
+         for (size_t i = 0; i < kOpsPerSample; i++) {
+           builder.DrawRRect(
+               SkRRect::MakeRectXY(rect(i, size), size / 4.0f, size / 4.0f),
+               p);
+         }
+         return static_cast<float>(size) * size;
+       }},
+      {Entry::kStrokeRRect,
+       [=](DisplayListBuilder& builder, int size) {
+         DlPaint p = paint(DlDrawStyle::kStroke);
+         for (size_t i = 0; i < kOpsPerSample; i++) {
+           builder.DrawRRect(
+               SkRRect::MakeRectXY(rect(i, size), size / 4.0f, size / 4.0f),
+               p);
+         }
+         return static_cast<float>(size);
+       }},
+      {Entry::kDrawDRRect,
+       [=](DisplayListBuilder& builder, int size) {
+         DlPaint p = paint(DlDrawStyle::kFill);
+         for (size_t i = 0; i < kOpsPerSample; i++) {
+           SkRect outer = rect(i, size);
+           SkRect inner = outer.makeInset(size / 4.0f, size / 4.0f);
+           builder.DrawDRRect(SkRRect::MakeRectXY(outer, 4, 4),
+                              SkRRect::MakeRectXY(inner, 4, 4), p);
+         }
+         return static_cast<float>(size) * size;
+       }},
+      {Entry::kDrawArc,
+       [=](DisplayListBuilder& builder, int size) {
+         DlPaint p = paint(DlDrawStyle::kFill);
+         for (size_t i = 0; i < kOpsPerSample; i++) {
+           builder.DrawArc(rect(i, size), 0, 270, true, p);
+         }
+         return static_cast<float>(size) * size;
+       }},
+      {Entry::kDrawPath,
+       [=](DisplayListBuilder& builder, int size) {
+         DlPaint p = paint(DlDrawStyle::kStroke);
+         // A zig-zag of |size| / 8 cubics across a |size| square.
+         SkPath path;
+         path.moveTo(0, 0);
+         int verbs = std::max(size / 8, 1);
+         for (int v = 0; v < verbs; v++) {
+           SkScalar x = (v + 1) * size / static_cast<SkScalar>(verbs);
+           path.cubicTo(x - 4, 0, x - 4, size, x, (v % 2) ? 0 : size);
+         }
+         for (size_t i = 0; i < kOpsPerSample; i++) {
+           builder.DrawPath(path, p);
+         }
+         return static_cast<float>(path.countVerbs());
+       }},
+      {Entry::kDrawPoints,
+       [=](DisplayListBuilder& builder, int size) {
+         DlPaint p = paint(DlDrawStyle::kStroke);
+         std::vector<SkPoint> points;
+         for (int v = 0; v < size; v++) {
+           points.push_back(SkPoint::Make(v % 64 * 4, v / 64 * 4));
+         }
+         for (size_t i = 0; i < kOpsPerSample; i++) {
+           builder.DrawPoints(DlCanvas::PointMode::kPoints, points.size(),
+                              points.data(), p);
+         }
+         return static_cast<float>(size);
+       }},
+      {Entry::kDrawVertices,
+       [=](DisplayListBuilder& builder, int size) {
+         std::vector<SkPoint> vertices;
+         for (int v = 0; v < size; v++) {
+           vertices.push_back(SkPoint::Make(v % 3 * 16 + v, v % 2 * 16));
+         }
+         auto dl_vertices =
+             DlVertices::Make(DlVertexMode::kTriangles, vertices.size(),
+                              vertices.data(), nullptr, nullptr);
+         for (size_t i = 0; i < kOpsPerSample; i++) {
+           builder.DrawVertices(dl_vertices, DlBlendMode::kSrcOver, fill);
+         }
+         return static_cast<float>(size);
+       }},
+      {Entry::kDrawImage,
+       [=](DisplayListBuilder& builder, int size) {
+         auto dl_image = image(size);
+         for (size_t i = 0; i < kOpsPerSample; i++) {
+           SkRect r = rect(i, size);
+           builder.DrawImage(dl_image, {r.fLeft, r.fTop},
+                             DlImageSampling::kLinear, &fill);
+         }
+         return static_cast<float>(size) * size;
+       }},
+      {Entry::kDrawImageRect,
+       [=](DisplayListBuilder& builder, int size) {
+         auto dl_image = image(size);
+         for (size_t i = 0; i < kOpsPerSample; i++) {
+           builder.DrawImageRect(dl_image, SkRect::MakeWH(size, size),
+                                 rect(i, size), DlImageSampling::kLinear,
+                                 &fill);
+         }
+         return static_cast<float>(size) * size;
+       }},
+      {Entry::kDrawImageNine,
+       [=](DisplayListBuilder& builder, int size) {
+         auto dl_image = image(64);
+         for (size_t i = 0; i < kOpsPerSample; i++) {
+           builder.DrawImageNine(dl_image, SkIRect::MakeLTRB(16, 16, 48, 48),
+                                 rect(i, size), DlFilterMode::kLinear, &fill);
+         }
+         return static_cast<float>(size) * size;
+       }},
+      {Entry::kDrawTextBlob,
+       [=](DisplayListBuilder& builder, int size) {
+         auto blob =
+             SkTextBlob::MakeFromString("Calibrate", CreateTestFontOfSize(20));
+         for (size_t i = 0; i < kOpsPerSample; i++) {
+           SkRect r = rect(i, 30);
+           builder.DrawTextBlob(blob, r.fLeft, r.fBottom, fill);
+         }
+         return 0.0f;
+       }},
+      {Entry::kDrawShadow,
+       [=](DisplayListBuilder& builder, int size) {
+         for (size_t i = 0; i < kOpsPerSample; i++) {
+           builder.DrawShadow(SkPath::Rect(rect(i, size)), DlColor::kBlack(),
+                              8, false, 1);
+         }
+         return static_cast<float>(size) * size;
+       }},
+  };
+}
+
+BackendType BackendForName(const std::string& name) {
+  if (name == "opengl") {
+    return BackendType::kOpenGlBackend;
+  }
+  if (name == "metal") {
+    return BackendType::kMetalBackend;
+  }
+  return BackendType::kSoftwareBackend;
+}
+
+int Main(const fml::CommandLine& command_line) {
+  std::string backend_name =
+      command_line.GetOptionValueWithDefault("backend", "software");
+  std::string output_path;
+  if (!command_line.GetOptionValue("output", &output_path)) {
+    std::cerr << "Usage: display_list_complexity_calibration "
+                 "[--backend=software|opengl|metal] --output=<path>"
+              << std::endl;
+    return 1;
+  }
+
+  auto provider = DlSurfaceProvider::Create(BackendForName(backend_name));
+  if (!provider) {
+    std::cerr << "Backend " << backend_name << " is not available."
+              << std::endl;
+    return 1;
+  }
+  Calibrator calibrator(std::move(provider));
+  std::vector<Probe> probes = MakeProbes(calibrator);
+
+  DisplayListComplexityTable table;
+  for (const Probe& probe : probes) {
+    table.set_coefficients(probe.entry, calibrator.Measure(probe, false));
+    std::cout << DisplayListComplexityTable::EntryName(probe.entry)
+              << " measured" << std::endl;
+  }
+
+  // The anti-alias factor is the average ratio of anti-aliased to aliased
+  // cost over the geometry entries that are affected by anti-aliasing.
+  const Entry kAntiAliasedEntries[] = {Entry::kStrokeRect, Entry::kFillOval,
+                                       Entry::kStrokeOval, Entry::kDrawPath};
+  double ratio_sum = 0;
+  int ratio_count = 0;
+  for (const Probe& probe : probes) {
+    if (std::find(std::begin(kAntiAliasedEntries),
+                  std::end(kAntiAliasedEntries),
+                  probe.entry) == std::end(kAntiAliasedEntries)) {
+      continue;
+    }
+    const auto& aliased = table.coefficients(probe.entry);
+    auto anti_aliased = calibrator.Measure(probe, true);
+    // Compare the costs at a typical size.
+    float units = 128.0f * 128.0f;
+    if (probe.entry == Entry::kDrawPath) {
+      units = 16.0f;
+    } else if (probe.entry != Entry::kFillOval) {
+      units = 128.0f;
+    }
+    double aliased_cost = aliased.fixed + aliased.per_unit * units;
+    if (aliased_cost > 0) {
+      ratio_sum += (anti_aliased.fixed + anti_aliased.per_unit * units) /
+                   aliased_cost;
+      ratio_count++;
+    }
+  }
+  if (ratio_count > 0) {
+    table.set_anti_alias_factor(std::max(ratio_sum / ratio_count, 1.0));
+  }
+
+  std::string contents = "# Measured on the " + backend_name +
+                         " backend by display_list_complexity_calibration\n" +
+                         table.ToString();
+  fml::DataMapping data(contents);
+  if (!fml::WriteAtomically(fml::OpenDirectory(".", false,
+                                               fml::FilePermission::kRead),
+                            output_path.c_str(), data)) {
+    std::cerr << "Could not write " << output_path << std::endl;
+    return 1;
+  }
+  std::cout << contents;
+  return 0;
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace flutter
+
+int main(int argc, char** argv) {
+  return flutter::testing::Main(fml::CommandLineFromArgcArgv(argc, argv));
+}
@@ -0,0 +1,375 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/benchmarking/dl_complexity_table.h"
+
+#include <atomic>
+#include <iomanip>
+#include <sstream>
+
+#include "flutter/display_list/dl_vertices.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+namespace {
+
+using Entry = DisplayListComplexityTable::Entry;
+
+constexpr const char* kCacheThresholdKey = "cache_threshold";
+constexpr const char* kAntiAliasFactorKey = "anti_alias_factor";
+
+std::optional<Entry> EntryForName(const std::string& name) {
+#define DL_COMPLEXITY_TABLE_LOOKUP(entry_name) \
+  if (name == #entry_name) {                   \
+    return Entry::k##entry_name;               \
+  }
+
+  FOR_EACH_COMPLEXITY_TABLE_ENTRY(DL_COMPLEXITY_TABLE_LOOKUP)
+
+#undef DL_COMPLEXITY_TABLE_LOOKUP
+  return std::nullopt;
+}
+
+// Calculators installed by |InstallForGpuBackends| are never deleted since
+// raster threads may still be using a previously installed calculator.
+std::atomic<DisplayListComplexityCalculator*> installed_calculator = nullptr;
+
+}  // namespace
+
+const char* DisplayListComplexityTable::EntryName(Entry entry) {
+  switch (entry) {
+#define DL_COMPLEXITY_TABLE_NAME(entry_name) \
+  case Entry::k##entry_name:                 \
+    return #entry_name;
+
+    FOR_EACH_COMPLEXITY_TABLE_ENTRY(DL_COMPLEXITY_TABLE_NAME)
+
+#undef DL_COMPLEXITY_TABLE_NAME
+  }
+}
+
+std::optional<DisplayListComplexityTable> DisplayListComplexityTable::Parse(
+    std::string_view text) {
+  DisplayListComplexityTable table;
+  std::istringstream lines{std::string(text)};
+  std::string line;
+  while (std::getline(lines, line)) {
+    std::istringstream fields(line);
+    std::string key;
+    if (!(fields >> key) || key[0] == '#') {
+      continue;
+    }
+    if (key == kCacheThresholdKey) {
+      if (!(fields >> table.cache_threshold_)) {
+        return std::nullopt;
+      }
+    } else if (key == kAntiAliasFactorKey) {
+      if (!(fields >> table.anti_alias_factor_)) {
+        return std::nullopt;
+      }
+    } else {
+      Coefficients coefficients;
+      if (!(fields >> coefficients.fixed >> coefficients.per_unit)) {
+        return std::nullopt;
+      }
+      std::optional<Entry> entry = EntryForName(key);
+      if (entry.has_value()) {
+        table.set_coefficients(entry.value(), coefficients);
+      }
+    }
+    std::string extra;
+    if (fields >> extra) {
+      return std::nullopt;
+    }
+  }
+  return table;
+}
+
+std::optional<DisplayListComplexityTable>
+DisplayListComplexityTable::LoadFromFile(const std::string& path) {
+  std::unique_ptr<fml::FileMapping> mapping =
+      fml::FileMapping::CreateReadOnly(path);
+  if (!mapping) {
+    FML_LOG(ERROR) << "Could not open complexity table " << path;
+    return std::nullopt;
+  }
+  std::string_view text(reinterpret_cast<const char*>(mapping->GetMapping()),
+                        mapping->GetSize());
+  std::optional<DisplayListComplexityTable> table = Parse(text);
+  if (!table.has_value()) {
+    FML_LOG(ERROR) << "Malformed complexity table " << path;
+  }
+  return table;
+}
+
+std::string DisplayListComplexityTable::ToString() const {
+  std::ostringstream out;
+  out << std::setprecision(9);
+  out << kCacheThresholdKey << " " << cache_threshold_ << "\n";
+  out << kAntiAliasFactorKey << " " << anti_alias_factor_ << "\n";
+  for (size_t i = 0; i < kEntryCount; i++) {
+    Entry entry = static_cast<Entry>(i);
+    const Coefficients& entry_coefficients = coefficients(entry);
+    out << EntryName(entry) << " " << entry_coefficients.fixed << " "
+        << entry_coefficients.per_unit << "\n";
+  }
+  return out.str();
+}
+
+void DisplayListTableComplexityCalculator::InstallForGpuBackends(
+    std::optional<DisplayListComplexityTable> table) {
+  installed_calculator.store(
+      table.has_value()
+          ? new DisplayListTableComplexityCalculator(table.value())
+          : nullptr);
+}
+
+DisplayListComplexityCalculator*
+DisplayListTableComplexityCalculator::GetInstalled() {
+  return installed_calculator.load();
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::Accumulate(
+    Entry entry,
+    float units,
+    bool uses_anti_alias) {
+  const DisplayListComplexityTable::Coefficients& coefficients =
+      table_.coefficients(entry);
+  float cost = coefficients.fixed + coefficients.per_unit * units;
+  if (uses_anti_alias && IsAntiAliased()) {
+    cost *= table_.anti_alias_factor();
+  }
+  if (!(cost > 0.0f)) {
+    return;
+  }
+  // Anything at or above the ceiling marks the DisplayList as complex.
+  AccumulateComplexity(cost < static_cast<float>(Ceiling())
+                           ? static_cast<unsigned int>(cost)
+                           : Ceiling());
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::AccumulateStyled(
+    Entry fill_entry,
+    Entry stroke_entry,
+    const SkRect& bounds) {
+  if (DrawStyle() == DlDrawStyle::kFill) {
+    Accumulate(fill_entry, bounds.width() * bounds.height(), true);
+  } else {
+    Accumulate(stroke_entry, (bounds.width() + bounds.height()) / 2, true);
+  }
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::saveLayer(
+    const SkRect* bounds,
+    const SaveLayerOptions options,
+    const DlImageFilter* backdrop) {
+  if (IsComplex()) {
+    return;
+  }
+  if (backdrop) {
+    // As with the other calculators, backdrop filters are only used by
+    // frame-wide builders which are not evaluated for complexity.
+    AccumulateComplexity(Ceiling());
+  }
+  Accumulate(Entry::kSaveLayer, 0, false);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawColor(
+    DlColor color,
+    DlBlendMode mode) {
+  if (IsComplex()) {
+    return;
+  }
+  Accumulate(Entry::kDrawColor, 0, false);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawPaint() {
+  if (IsComplex()) {
+    return;
+  }
+  Accumulate(Entry::kDrawPaint, 0, false);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawLine(
+    const SkPoint& p0,
+    const SkPoint& p1) {
+  if (IsComplex()) {
+    return;
+  }
+  // Use an approximation for the distance to avoid a sqrt() call.
+  SkScalar distance = abs(p0.x() - p1.x()) + abs(p0.y() - p1.y());
+  Accumulate(Entry::kDrawLine, distance, true);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawRect(
+    const SkRect& rect) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateStyled(Entry::kFillRect, Entry::kStrokeRect, rect);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawOval(
+    const SkRect& bounds) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateStyled(Entry::kFillOval, Entry::kStrokeOval, bounds);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawCircle(
+    const SkPoint& center,
+    SkScalar radius) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateStyled(Entry::kFillOval, Entry::kStrokeOval,
+                   SkRect::MakeLTRB(center.x() - radius, center.y() - radius,
+                                    center.x() + radius, center.y() + radius));
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawRRect(
+    const SkRRect& rrect) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateStyled(Entry::kFillRRect, Entry::kStrokeRRect, rrect.getBounds());
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawDRRect(
+    const SkRRect& outer,
+    const SkRRect& inner) {
+  if (IsComplex()) {
+    return;
+  }
+  const SkRect& bounds = outer.getBounds();
+  Accumulate(Entry::kDrawDRRect, bounds.width() * bounds.height(), true);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawPath(
+    const SkPath& path) {
+  if (IsComplex()) {
+    return;
+  }
+  Accumulate(Entry::kDrawPath, path.countVerbs(), true);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawArc(
+    const SkRect& oval_bounds,
+    SkScalar start_degrees,
+    SkScalar sweep_degrees,
+    bool use_center) {
+  if (IsComplex()) {
+    return;
+  }
+  Accumulate(Entry::kDrawArc, oval_bounds.width() * oval_bounds.height(),
+             true);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawPoints(
+    DlCanvas::PointMode mode,
+    uint32_t count,
+    const SkPoint points[]) {
+  if (IsComplex()) {
+    return;
+  }
+  Accumulate(Entry::kDrawPoints, count, true);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawVertices(
+    const DlVertices* vertices,
+    DlBlendMode mode) {
+  if (IsComplex()) {
+    return;
+  }
+  Accumulate(Entry::kDrawVertices, vertices->vertex_count(), false);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawImage(
+    const sk_sp<DlImage> image,
+    const SkPoint point,
+    DlImageSampling sampling,
+    bool render_with_attributes) {
+  if (IsComplex()) {
+    return;
+  }
+  SkISize dimensions = image->dimensions();
+  Accumulate(Entry::kDrawImage,
+             static_cast<float>(dimensions.width()) * dimensions.height(),
+             false);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::ImageRect(
+    const SkISize& size,
+    bool texture_backed,
+    bool render_with_attributes,
+    bool enforce_src_edges) {
+  if (IsComplex()) {
+    return;
+  }
+  Accumulate(Entry::kDrawImageRect,
+             static_cast<float>(size.width()) * size.height(), false);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawImageNine(
+    const sk_sp<DlImage> image,
+    const SkIRect& center,
+    const SkRect& dst,
+    DlFilterMode filter,
+    bool render_with_attributes) {
+  if (IsComplex()) {
+    return;
+  }
+  Accumulate(Entry::kDrawImageNine, dst.width() * dst.height(), false);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawDisplayList(
+    const sk_sp<DisplayList> display_list,
+    SkScalar opacity) {
+  if (IsComplex()) {
+    return;
+  }
+  TableHelper helper(table_, Ceiling() - CurrentComplexityScore());
+  if (opacity < SK_Scalar1 && !display_list->can_apply_group_opacity()) {
+    helper.saveLayer(nullptr, SaveLayerOptions::kWithAttributes, nullptr);
+  }
+  display_list->Dispatch(helper);
+  AccumulateComplexity(helper.ComplexityScore());
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawTextBlob(
+    const sk_sp<SkTextBlob> blob,
+    SkScalar x,
+    SkScalar y) {
+  if (IsComplex()) {
+    return;
+  }
+  Accumulate(Entry::kDrawTextBlob, 0, false);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawTextFrame(
+    const std::shared_ptr<impeller::TextFrame>& text_frame,
+    SkScalar x,
+    SkScalar y) {
+  if (IsComplex()) {
+    return;
+  }
+  Accumulate(Entry::kDrawTextFrame, 0, false);
+}
+
+void DisplayListTableComplexityCalculator::TableHelper::drawShadow(
+    const SkPath& path,
+    const DlColor color,
+    const SkScalar elevation,
+    bool transparent_occluder,
+    SkScalar dpr) {
+  if (IsComplex()) {
+    return;
+  }
+  const SkRect& bounds = path.getBounds();
+  Accumulate(Entry::kDrawShadow, bounds.width() * bounds.height(), false);
+}
+
+}  // namespace flutter
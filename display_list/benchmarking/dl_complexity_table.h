@@ -0,0 +1,244 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_BENCHMARKING_DL_COMPLEXITY_TABLE_H_
+#define FLUTTER_DISPLAY_LIST_BENCHMARKING_DL_COMPLEXITY_TABLE_H_
+
+#include <array>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "flutter/display_list/benchmarking/dl_complexity_helper.h"
+
+namespace flutter {
+
+// The entries of a |DisplayListComplexityTable|. The cost of an op is
+// modelled as |fixed| + |per_unit| * units, where the units are:
+//
+//   SaveLayer, DrawColor, DrawPaint, DrawTextBlob, DrawTextFrame:
+//       none, the cost is fixed
+//   DrawLine:                            the length of the line
+//   StrokeRect, StrokeOval, StrokeRRect: the average of width and height
+//   FillRect, FillOval, FillRRect, DrawDRRect, DrawArc, DrawShadow:
+//       the area of the (outer) bounds
+//   DrawPath:                            the number of verbs
+//   DrawPoints:                          the number of points
+//   DrawVertices:                        the number of vertices
+//   DrawImage, DrawImageRect:            the area of the image
+//   DrawImageNine:                       the area of the destination
+//
+// Circles use the oval entries.
+#define FOR_EACH_COMPLEXITY_TABLE_ENTRY(V) \
+  V(SaveLayer)                             \
+  V(DrawColor)                             \
+  V(DrawPaint)                             \
+  V(DrawLine)                              \
+  V(FillRect)                              \
+  V(StrokeRect)                            \
+  V(FillOval)                              \
+  V(StrokeOval)                            \
+  V(FillRRect)                             \
+  V(StrokeRRect)                           \
+  V(DrawDRRect)                            \
+  V(DrawArc)                               \
+  V(DrawPath)                              \
+  V(DrawPoints)                            \
+  V(DrawVertices)                          \
+  V(DrawImage)                             \
+  V(DrawImageRect)                         \
+  V(DrawImageNine)                         \
+  V(DrawTextBlob)                          \
+  V(DrawTextFrame)                         \
+  V(DrawShadow)
+
+//------------------------------------------------------------------------------
+/// @brief      A per-op cost model measured on a particular device, see
+///             the display_list_complexity_calibration tool.
+///
+/// Costs are in the units of the other complexity calculators, where a
+/// score of 200000 corresponds to roughly 1ms of raster time.
+///
+/// Tables are stored as text with one entry per line, for example:
+///
+///   # Comment
+///   cache_threshold 200000
+///   anti_alias_factor 1.5
+///   FillRect 120 0.0114
+///
+/// Entries that are not listed cost nothing.
+class DisplayListComplexityTable {
+ public:
+  enum class Entry {
+#define DL_COMPLEXITY_TABLE_ENTRY(name) k##name,
+    FOR_EACH_COMPLEXITY_TABLE_ENTRY(DL_COMPLEXITY_TABLE_ENTRY)
+#undef DL_COMPLEXITY_TABLE_ENTRY
+  };
+
+#define DL_COMPLEXITY_TABLE_COUNT(name) +1
+  static constexpr size_t kEntryCount =
+      0 FOR_EACH_COMPLEXITY_TABLE_ENTRY(DL_COMPLEXITY_TABLE_COUNT);
+#undef DL_COMPLEXITY_TABLE_COUNT
+
+  struct Coefficients {
+    float fixed = 0.0f;
+    float per_unit = 0.0f;
+
+    bool operator==(const Coefficients& other) const {
+      return fixed == other.fixed && per_unit == other.per_unit;
+    }
+  };
+
+  static const char* EntryName(Entry entry);
+
+  /// Parses a table in the text format written by |ToString|, returning
+  /// nullopt if any line is malformed. Unknown entry names are ignored
+  /// so that tables written by newer tools can still be read.
+  static std::optional<DisplayListComplexityTable> Parse(
+      std::string_view text);
+
+  /// Reads and parses the table file at |path|.
+  static std::optional<DisplayListComplexityTable> LoadFromFile(
+      const std::string& path);
+
+  std::string ToString() const;
+
+  const Coefficients& coefficients(Entry entry) const {
+    return coefficients_[static_cast<size_t>(entry)];
+  }
+  void set_coefficients(Entry entry, Coefficients coefficients) {
+    coefficients_[static_cast<size_t>(entry)] = coefficients;
+  }
+
+  /// The cost multiplier for geometry drawn with anti-aliasing.
+  float anti_alias_factor() const { return anti_alias_factor_; }
+  void set_anti_alias_factor(float factor) { anti_alias_factor_ = factor; }
+
+  /// Scores above this value are worth caching.
+  unsigned int cache_threshold() const { return cache_threshold_; }
+  void set_cache_threshold(unsigned int threshold) {
+    cache_threshold_ = threshold;
+  }
+
+ private:
+  std::array<Coefficients, kEntryCount> coefficients_ = {};
+  float anti_alias_factor_ = 1.0f;
+  unsigned int cache_threshold_ = 200000u;
+};
+
+class DisplayListTableComplexityCalculator
+    : public DisplayListComplexityCalculator {
+ public:
+  explicit DisplayListTableComplexityCalculator(
+      DisplayListComplexityTable table)
+      : table_(table), ceiling_(std::numeric_limits<unsigned int>::max()) {}
+
+  /// Makes |DisplayListComplexityCalculator::GetForBackend| return a
+  /// calculator for |table| for every GPU backend, or restores the
+  /// built-in calculators if |table| is nullopt. Intended to be called
+  /// once at startup with the table measured on the device.
+  static void InstallForGpuBackends(
+      std::optional<DisplayListComplexityTable> table);
+
+  /// The calculator installed by |InstallForGpuBackends|, if any.
+  static DisplayListComplexityCalculator* GetInstalled();
+
+  const DisplayListComplexityTable& table() const { return table_; }
+
+  unsigned int Compute(const DisplayList* display_list) override {
+    TableHelper helper(table_, ceiling_);
+    display_list->Dispatch(helper);
+    return helper.ComplexityScore();
+  }
+
+  bool ShouldBeCached(unsigned int complexity_score) override {
+    return complexity_score > table_.cache_threshold();
+  }
+
+  void SetComplexityCeiling(unsigned int ceiling) override {
+    ceiling_ = ceiling;
+  }
+
+ private:
+  class TableHelper : public ComplexityCalculatorHelper {
+   public:
+    TableHelper(const DisplayListComplexityTable& table, unsigned int ceiling)
+        : ComplexityCalculatorHelper(ceiling), table_(table) {}
+
+    void saveLayer(const SkRect* bounds,
+                   const SaveLayerOptions options,
+                   const DlImageFilter* backdrop) override;
+
+    void drawColor(DlColor color, DlBlendMode mode) override;
+    void drawPaint() override;
+    void drawLine(const SkPoint& p0, const SkPoint& p1) override;
+    void drawRect(const SkRect& rect) override;
+    void drawOval(const SkRect& bounds) override;
+    void drawCircle(const SkPoint& center, SkScalar radius) override;
+    void drawRRect(const SkRRect& rrect) override;
+    void drawDRRect(const SkRRect& outer, const SkRRect& inner) override;
+    void drawPath(const SkPath& path) override;
+    void drawArc(const SkRect& oval_bounds,
+                 SkScalar start_degrees,
+                 SkScalar sweep_degrees,
+                 bool use_center) override;
+    void drawPoints(DlCanvas::PointMode mode,
+                    uint32_t count,
+                    const SkPoint points[]) override;
+    void drawVertices(const DlVertices* vertices, DlBlendMode mode) override;
+    void drawImage(const sk_sp<DlImage> image,
+                   const SkPoint point,
+                   DlImageSampling sampling,
+                   bool render_with_attributes) override;
+    void drawImageNine(const sk_sp<DlImage> image,
+                       const SkIRect& center,
+                       const SkRect& dst,
+                       DlFilterMode filter,
+                       bool render_with_attributes) override;
+    void drawDisplayList(const sk_sp<DisplayList> display_list,
+                         SkScalar opacity) override;
+    void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                      SkScalar x,
+                      SkScalar y) override;
+    void drawTextFrame(const std::shared_ptr<impeller::TextFrame>& text_frame,
+                       SkScalar x,
+                       SkScalar y) override;
+    void drawShadow(const SkPath& path,
+                    const DlColor color,
+                    const SkScalar elevation,
+                    bool transparent_occluder,
+                    SkScalar dpr) override;
+
+   protected:
+    void ImageRect(const SkISize& size,
+                   bool texture_backed,
+                   bool render_with_attributes,
+                   bool enforce_src_edges) override;
+
+    // Every entry of the table is a per-op cost.
+    unsigned int BatchedComplexity() override { return 0; }
+
+   private:
+    using Entry = DisplayListComplexityTable::Entry;
+
+    // Accumulates the cost of an op of the given |entry| and |units|,
+    // scaled by the anti-alias factor if |uses_anti_alias| and the
+    // current attributes have anti-aliasing enabled.
+    void Accumulate(Entry entry, float units, bool uses_anti_alias);
+
+    void AccumulateStyled(Entry fill_entry,
+                          Entry stroke_entry,
+                          const SkRect& bounds);
+
+    const DisplayListComplexityTable& table_;
+  };
+
+  const DisplayListComplexityTable table_;
+  unsigned int ceiling_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_BENCHMARKING_DL_COMPLEXITY_TABLE_H_
@@ -5,6 +5,7 @@
 #include "flutter/display_list/benchmarking/dl_complexity.h"
 #include "flutter/display_list/benchmarking/dl_complexity_gl.h"
 #include "flutter/display_list/benchmarking/dl_complexity_metal.h"
+#include "flutter/display_list/benchmarking/dl_complexity_table.h"
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_builder.h"
 #include "flutter/display_list/dl_sampling_options.h"
@@ -440,5 +441,96 @@ TEST(DisplayListComplexity, DrawAtlas) {
   }
 }
 
+TEST(DisplayListComplexityTable, ParseRoundTrip) {
+  DisplayListComplexityTable table;
+  table.set_cache_threshold(12345u);
+  table.set_anti_alias_factor(1.5f);
+  table.set_coefficients(DisplayListComplexityTable::Entry::kFillRect,
+                         {120.0f, 0.0114f});
+  table.set_coefficients(DisplayListComplexityTable::Entry::kDrawShadow,
+                         {9000.0f, 2.5f});
+
+  auto parsed = DisplayListComplexityTable::Parse(table.ToString());
+  ASSERT_TRUE(parsed.has_value());
+  EXPECT_EQ(parsed->cache_threshold(), 12345u);
+  EXPECT_EQ(parsed->anti_alias_factor(), 1.5f);
+  for (size_t i = 0; i < DisplayListComplexityTable::kEntryCount; i++) {
+    auto entry = static_cast<DisplayListComplexityTable::Entry>(i);
+    EXPECT_EQ(parsed->coefficients(entry), table.coefficients(entry))
+        << DisplayListComplexityTable::EntryName(entry);
+  }
+}
+
+TEST(DisplayListComplexityTable, ParseIgnoresCommentsAndUnknownEntries) {
+  auto table = DisplayListComplexityTable::Parse(
+      "# A comment\n"
+      "\n"
+      "FillRect 10 0.5\n"
+      "DrawSomethingNew 1 2\n");
+  ASSERT_TRUE(table.has_value());
+  EXPECT_EQ(table->coefficients(DisplayListComplexityTable::Entry::kFillRect),
+            DisplayListComplexityTable::Coefficients({10.0f, 0.5f}));
+  EXPECT_EQ(table->cache_threshold(), 200000u);
+  EXPECT_EQ(table->anti_alias_factor(), 1.0f);
+}
+
+TEST(DisplayListComplexityTable, ParseRejectsMalformedLines) {
+  EXPECT_FALSE(DisplayListComplexityTable::Parse("FillRect 10\n"));
+  EXPECT_FALSE(DisplayListComplexityTable::Parse("FillRect ten 1\n"));
+  EXPECT_FALSE(DisplayListComplexityTable::Parse("FillRect 10 1 2\n"));
+  EXPECT_FALSE(DisplayListComplexityTable::Parse("cache_threshold\n"));
+  EXPECT_FALSE(DisplayListComplexityTable::Parse("anti_alias_factor x\n"));
+}
+
+TEST(DisplayListComplexityTable, CalculatorUsesCoefficients) {
+  DisplayListComplexityTable table;
+  table.set_coefficients(DisplayListComplexityTable::Entry::kFillRect,
+                         {100.0f, 2.0f});
+  table.set_anti_alias_factor(3.0f);
+  table.set_cache_threshold(500u);
+  DisplayListTableComplexityCalculator calculator(table);
+
+  DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeWH(10, 10), DlPaint());
+  auto display_list = builder.Build();
+  // 100 + 2 * (10 * 10)
+  EXPECT_EQ(calculator.Compute(display_list.get()), 300u);
+  EXPECT_FALSE(calculator.ShouldBeCached(300u));
+
+  DisplayListBuilder builder_aa;
+  builder_aa.DrawRect(SkRect::MakeWH(10, 10), DlPaint().setAntiAlias(true));
+  auto display_list_aa = builder_aa.Build();
+  EXPECT_EQ(calculator.Compute(display_list_aa.get()), 900u);
+  EXPECT_TRUE(calculator.ShouldBeCached(900u));
+
+  // Ops without coefficients cost nothing.
+  DisplayListBuilder builder_oval;
+  builder_oval.DrawOval(SkRect::MakeWH(10, 10), DlPaint());
+  auto display_list_oval = builder_oval.Build();
+  EXPECT_EQ(calculator.Compute(display_list_oval.get()), 0u);
+}
+
+TEST(DisplayListComplexityTable, InstallForGpuBackends) {
+  ASSERT_EQ(DisplayListTableComplexityCalculator::GetInstalled(), nullptr);
+  DisplayListComplexityTable table;
+  table.set_cache_threshold(42u);
+  DisplayListTableComplexityCalculator::InstallForGpuBackends(table);
+
+  auto installed = DisplayListTableComplexityCalculator::GetInstalled();
+  ASSERT_NE(installed, nullptr);
+  for (auto backend :
+       {GrBackendApi::kOpenGL, GrBackendApi::kVulkan, GrBackendApi::kMetal}) {
+    EXPECT_EQ(DisplayListComplexityCalculator::GetForBackend(backend),
+              installed);
+  }
+  EXPECT_NE(DisplayListComplexityCalculator::GetForSoftware(), installed);
+
+  DisplayListTableComplexityCalculator::InstallForGpuBackends(std::nullopt);
+  EXPECT_EQ(DisplayListTableComplexityCalculator::GetInstalled(), nullptr);
+  EXPECT_EQ(
+      DisplayListComplexityCalculator::GetForBackend(GrBackendApi::kOpenGL),
+      DisplayListGLComplexityCalculator::GetInstance());
+}
+
 }  // namespace testing
 }  // namespace flutter
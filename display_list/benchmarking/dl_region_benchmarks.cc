@@ -5,6 +5,7 @@
 #include "flutter/benchmarking/benchmarking.h"
 
 #include "flutter/display_list/geometry/dl_region.h"
+#include "flutter/display_list/geometry/dl_region_simd.h"
 #include "flutter/fml/logging.h"
 #include "third_party/skia/include/core/SkRegion.h"
 
@@ -253,10 +254,84 @@ void RunIntersectsSingleRectBenchmark(benchmark::State& state, int maxSize) {
   }
 }
 
+enum class SpanImpl { kScalar, kSimd };
+
+std::vector<SkIRect> MakeBoundsRects(size_t count) {
+  std::seed_seq seed{2, 1, 3};
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution pos(0, 4000);
+  std::uniform_int_distribution size(1, 100);
+  std::vector<SkIRect> rects;
+  for (size_t i = 0; i < count; ++i) {
+    rects.push_back(
+        SkIRect::MakeXYWH(pos(rng), pos(rng), size(rng), size(rng)));
+  }
+  return rects;
+}
+
+void RunComputeBoundsBenchmark(benchmark::State& state,
+                               SpanImpl impl,
+                               size_t count) {
+  auto rects = MakeBoundsRects(count);
+  auto ltrb = reinterpret_cast<const int32_t*>(rects.data());
+  int32_t bounds[4];
+  while (state.KeepRunning()) {
+    bool result =
+        impl == SpanImpl::kSimd
+            ? flutter::dl_region_simd::ComputeBounds(ltrb, count, bounds)
+            : flutter::dl_region_simd::ComputeBoundsScalar(ltrb, count, bounds);
+    benchmark::DoNotOptimize(result);
+    benchmark::DoNotOptimize(bounds);
+  }
+  state.SetLabel(impl == SpanImpl::kSimd
+                     ? flutter::dl_region_simd::ImplementationName()
+                     : "scalar");
+}
+
+void RunSpansIntersectBenchmark(benchmark::State& state,
+                                SpanImpl impl,
+                                size_t count) {
+  // A single long span line, probed at positions spread along its length.
+  std::vector<int32_t> spans;
+  for (size_t i = 0; i < count; ++i) {
+    spans.push_back(i * 10);
+    spans.push_back(i * 10 + 5);
+  }
+  std::vector<int32_t> probes;
+  for (size_t i = 0; i < 64; ++i) {
+    probes.push_back((i * count * 10) / 64 + 6);
+  }
+  while (state.KeepRunning()) {
+    for (int32_t left : probes) {
+      bool result = impl == SpanImpl::kSimd
+                        ? flutter::dl_region_simd::SpansIntersectRange(
+                              spans.data(), count, left, left + 3)
+                        : flutter::dl_region_simd::SpansIntersectRangeScalar(
+                              spans.data(), count, left, left + 3);
+      benchmark::DoNotOptimize(result);
+    }
+  }
+  state.SetLabel(impl == SpanImpl::kSimd
+                     ? flutter::dl_region_simd::ImplementationName()
+                     : "scalar");
+}
+
 }  // namespace
 
 namespace flutter {
 
+static void BM_DlRegion_ComputeBounds(benchmark::State& state,
+                                      SpanImpl impl,
+                                      size_t count) {
+  RunComputeBoundsBenchmark(state, impl, count);
+}
+
+static void BM_DlRegion_SpansIntersect(benchmark::State& state,
+                                       SpanImpl impl,
+                                       size_t count) {
+  RunSpansIntersectBenchmark(state, impl, count);
+}
+
 static void BM_DlRegion_FromRects(benchmark::State& state, int maxSize) {
   RunFromRectsBenchmark<DlRegionAdapter>(state, maxSize);
 }
@@ -315,6 +390,15 @@ static void BM_SkRegion_IntersectsSingleRect(benchmark::State& state,
 
 const double kSizeFactorSmall = 0.3;
 
+BENCHMARK_CAPTURE(BM_DlRegion_ComputeBounds, Scalar, SpanImpl::kScalar, 1000)
+    ->Unit(benchmark::kNanosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_ComputeBounds, Simd, SpanImpl::kSimd, 1000)
+    ->Unit(benchmark::kNanosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_SpansIntersect, Scalar, SpanImpl::kScalar, 256)
+    ->Unit(benchmark::kNanosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_SpansIntersect, Simd, SpanImpl::kSimd, 256)
+    ->Unit(benchmark::kNanosecond);
+
 BENCHMARK_CAPTURE(BM_DlRegion_IntersectsSingleRect, Tiny, 30)
     ->Unit(benchmark::kNanosecond);
 BENCHMARK_CAPTURE(BM_SkRegion_IntersectsSingleRect, Tiny, 30)
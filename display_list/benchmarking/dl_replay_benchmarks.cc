@@ -0,0 +1,218 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Replays recorded frames and reports percentiles of their raster times.
+//
+// Each frame is the root DisplayList of a layer tree, written with
+// |DisplayListSerialization::Serialize| to its own file. The frames are read
+// from the directory named by the FLUTTER_DL_REPLAY_FRAMES environment
+// variable and replayed in the order of their file names, so a capture of a
+// janky interaction can be checked in and compared across engine revisions.
+//
+// Run with --benchmark_format=json to compare the counters of the backends.
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/dl_serialization.h"
+#include "flutter/display_list/skia/dl_sk_canvas.h"
+#include "flutter/display_list/testing/dl_test_surface_provider.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/time/time_point.h"
+
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/GrRecordingContext.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+using BackendType = DlSurfaceProvider::BackendType;
+
+constexpr const char* kFramesDirectoryVariable = "FLUTTER_DL_REPLAY_FRAMES";
+
+struct RecordedFrames {
+  std::vector<sk_sp<DisplayList>> frames;
+  SkIRect bounds = SkIRect::MakeEmpty();
+};
+
+RecordedFrames LoadRecordedFrames(const char* path) {
+  RecordedFrames result;
+  auto directory = fml::OpenDirectory(path, false, fml::FilePermission::kRead);
+  if (!directory.is_valid()) {
+    return result;
+  }
+
+  std::vector<std::string> file_names;
+  fml::VisitFiles(directory, [&file_names](const fml::UniqueFD& directory,
+                                           const std::string& file_name) {
+    file_names.push_back(file_name);
+    return true;
+  });
+  std::sort(file_names.begin(), file_names.end());
+
+  for (const auto& file_name : file_names) {
+    std::shared_ptr<const fml::Mapping> mapping =
+        fml::FileMapping::CreateReadOnly(directory, file_name);
+    auto frame =
+        mapping ? DisplayListSerialization::Deserialize(mapping) : nullptr;
+    if (!frame) {
+      FML_LOG(ERROR) << "Skipping " << file_name
+                     << ", which is not a serialized DisplayList.";
+      continue;
+    }
+    result.bounds.join(frame->bounds().roundOut());
+    result.frames.push_back(std::move(frame));
+  }
+  return result;
+}
+
+const RecordedFrames& GetRecordedFrames() {
+  static const RecordedFrames frames = [] {
+    const char* path = std::getenv(kFramesDirectoryVariable);
+    return path ? LoadRecordedFrames(path) : RecordedFrames{};
+  }();
+  return frames;
+}
+
+void FlushSubmitCpuSync(const sk_sp<SkSurface>& surface) {
+  if (GrDirectContext* dContext =
+          GrAsDirectContext(surface->recordingContext())) {
+    dContext->flushAndSubmit(surface.get(), GrSyncCpu::kYes);
+  }
+}
+
+// Returns the |percentile| of the sorted |durations| in milliseconds.
+double PercentileMillis(const std::vector<fml::TimeDelta>& durations,
+                        double percentile) {
+  size_t index = static_cast<size_t>(percentile * (durations.size() - 1));
+  return durations[index].ToMillisecondsF();
+}
+
+void ReportFrameTimes(benchmark::State& state,
+                      std::vector<fml::TimeDelta> durations) {
+  std::sort(durations.begin(), durations.end());
+  state.counters["Frames"] = GetRecordedFrames().frames.size();
+  state.counters["P50Ms"] = PercentileMillis(durations, 0.5);
+  state.counters["P90Ms"] = PercentileMillis(durations, 0.9);
+  state.counters["P99Ms"] = PercentileMillis(durations, 0.99);
+  state.counters["WorstMs"] = durations.back().ToMillisecondsF();
+}
+
+}  // namespace
+
+// Rasterizes every recorded frame once per iteration and reports the
+// distribution of the per-frame raster times, as a frame timeline would.
+void BM_ReplayRecordedFrames(benchmark::State& state,
+                             BackendType backend_type) {
+  const RecordedFrames& recorded = GetRecordedFrames();
+  if (recorded.frames.empty()) {
+    state.SkipWithError(
+        "No frames to replay. Set FLUTTER_DL_REPLAY_FRAMES to a directory "
+        "of serialized DisplayLists.");
+    return;
+  }
+
+  auto surface_provider = DlSurfaceProvider::Create(backend_type);
+  if (!surface_provider ||
+      !surface_provider->InitializeSurface(
+          std::max(recorded.bounds.right(), 1),
+          std::max(recorded.bounds.bottom(), 1))) {
+    state.SkipWithError("Could not create the surface.");
+    return;
+  }
+  auto surface = surface_provider->GetPrimarySurface()->sk_surface();
+  DlSkCanvasAdapter canvas(surface->getCanvas());
+
+  std::vector<fml::TimeDelta> durations;
+  durations.reserve(recorded.frames.size() * 16);
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto& frame : recorded.frames) {
+      auto start = fml::TimePoint::Now();
+      canvas.Clear(DlColor::kTransparent());
+      canvas.DrawDisplayList(frame);
+      FlushSubmitCpuSync(surface);
+      durations.push_back(fml::TimePoint::Now() - start);
+    }
+  }
+
+  ReportFrameTimes(state, std::move(durations));
+}
+
+// Like |BM_ReplayRecordedFrames|, but renders the frames with Impeller. The
+// frame times include reading back the frame, so the GPU time per frame is
+// also reported when the backend measures it.
+void BM_ReplayRecordedFramesImpeller(benchmark::State& state,
+                                     BackendType backend_type) {
+  const RecordedFrames& recorded = GetRecordedFrames();
+  if (recorded.frames.empty()) {
+    state.SkipWithError(
+        "No frames to replay. Set FLUTTER_DL_REPLAY_FRAMES to a directory "
+        "of serialized DisplayLists.");
+    return;
+  }
+
+  auto surface_provider = DlSurfaceProvider::Create(backend_type);
+  if (!surface_provider || !surface_provider->supports_impeller()) {
+    state.SkipWithError("The backend does not support Impeller.");
+    return;
+  }
+  int width = std::max(recorded.bounds.right(), 1);
+  int height = std::max(recorded.bounds.bottom(), 1);
+
+  std::vector<fml::TimeDelta> durations;
+  durations.reserve(recorded.frames.size() * 16);
+  auto gpu_time_before = surface_provider->GetImpellerGPUTime();
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto& frame : recorded.frames) {
+      auto start = fml::TimePoint::Now();
+      surface_provider->ImpellerSnapshot(frame, width, height);
+      durations.push_back(fml::TimePoint::Now() - start);
+    }
+  }
+  auto gpu_time_after = surface_provider->GetImpellerGPUTime();
+
+  if (gpu_time_after.has_value()) {
+    auto gpu_time = gpu_time_after.value() -
+                    gpu_time_before.value_or(fml::TimeDelta::Zero());
+    state.counters["GPUMsPerFrame"] =
+        gpu_time.ToMillisecondsF() / durations.size();
+  }
+  ReportFrameTimes(state, std::move(durations));
+}
+
+#ifdef ENABLE_SOFTWARE_BENCHMARKS
+BENCHMARK_CAPTURE(BM_ReplayRecordedFrames,
+                  Software,
+                  BackendType::kSoftwareBackend)
+    ->Unit(benchmark::kMillisecond);
+#endif
+
+#ifdef ENABLE_OPENGL_BENCHMARKS
+BENCHMARK_CAPTURE(BM_ReplayRecordedFrames,
+                  OpenGL,
+                  BackendType::kOpenGlBackend)
+    ->Unit(benchmark::kMillisecond);
+#endif
+
+#ifdef ENABLE_METAL_BENCHMARKS
+BENCHMARK_CAPTURE(BM_ReplayRecordedFrames,
+                  Metal,
+                  BackendType::kMetalBackend)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ReplayRecordedFramesImpeller,
+                  Metal,
+                  BackendType::kMetalBackend)
+    ->Unit(benchmark::kMillisecond);
+#endif
+
+}  // namespace testing
+}  // namespace flutter
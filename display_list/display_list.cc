@@ -2,10 +2,15 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cstdlib>
+#include <cstring>
 #include <type_traits>
 
 #include "flutter/display_list/display_list.h"
+#include "flutter/display_list/dl_builder.h"
 #include "flutter/display_list/dl_op_records.h"
+#include "flutter/fml/memory/allocation_counter.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -14,15 +19,90 @@ const SaveLayerOptions SaveLayerOptions::kNoAttributes = SaveLayerOptions();
 const SaveLayerOptions SaveLayerOptions::kWithAttributes =
     kNoAttributes.with_renders_with_attributes();
 
+DisplayListStorage::DisplayListStorage(
+    std::shared_ptr<const fml::Mapping> mapping,
+    size_t offset,
+    size_t size)
+    : mapping_(std::move(mapping)) {
+  FML_CHECK(mapping_ && offset + size <= mapping_->GetSize());
+  // The ops are only ever read from mapped storage, see |realloc|.
+  ptr_ = const_cast<uint8_t*>(mapping_->GetMapping() + offset);
+  capacity_ = size;
+}
+
+DisplayListStorage::DisplayListStorage(DisplayListStorage&& other)
+    : ptr_(other.ptr_),
+      capacity_(other.capacity_),
+      arena_(std::move(other.arena_)),
+      mapping_(std::move(other.mapping_)) {
+  other.ptr_ = nullptr;
+  other.capacity_ = 0;
+}
+
+DisplayListStorage& DisplayListStorage::operator=(DisplayListStorage&& other) {
+  if (this != &other) {
+    reset();
+    ptr_ = other.ptr_;
+    capacity_ = other.capacity_;
+    arena_ = std::move(other.arena_);
+    mapping_ = std::move(other.mapping_);
+    other.ptr_ = nullptr;
+    other.capacity_ = 0;
+  }
+  return *this;
+}
+
+DisplayListStorage::~DisplayListStorage() {
+  reset();
+}
+
+void DisplayListStorage::reset() {
+  if (mapping_) {
+    mapping_.reset();
+  } else if (arena_) {
+    arena_->Release(ptr_, capacity_);
+  } else {
+    std::free(ptr_);
+  }
+  ptr_ = nullptr;
+  capacity_ = 0;
+}
+
+void DisplayListStorage::realloc(size_t count) {
+  FML_CHECK(!mapping_) << "Mapped DisplayListStorage is read-only";
+  if (!arena_) {
+    ptr_ = static_cast<uint8_t*>(std::realloc(ptr_, count));
+    FML_CHECK(ptr_);
+    fml::RecordAllocation(fml::AllocationTag::kDisplayList, count);
+    capacity_ = count;
+    return;
+  }
+  if (ptr_ && count <= capacity_) {
+    return;
+  }
+  uint8_t* slab = arena_->Acquire(count);
+  fml::RecordAllocation(fml::AllocationTag::kDisplayList, count);
+  if (ptr_) {
+    memcpy(slab, ptr_, capacity_);
+    arena_->Release(ptr_, capacity_);
+  }
+  ptr_ = slab;
+  capacity_ = DisplayListStorageArena::SlabSizeFor(count);
+}
+
 DisplayList::DisplayList()
     : byte_count_(0),
       op_count_(0),
       nested_byte_count_(0),
       nested_op_count_(0),
+      compacted_op_count_(0),
       unique_id_(0),
+      content_hash_(std::nullopt),
       bounds_({0, 0, 0, 0}),
+      has_deferred_bounds_(false),
       can_apply_group_opacity_(true),
       is_ui_thread_safe_(true),
+      has_images_(false),
       modifies_transparent_black_(false) {}
 
 DisplayList::DisplayList(DisplayListStorage&& storage,
@@ -30,28 +110,49 @@ DisplayList::DisplayList(DisplayListStorage&& storage,
                          unsigned int op_count,
                          size_t nested_byte_count,
                          unsigned int nested_op_count,
+                         unsigned int compacted_op_count,
+                         std::optional<uint64_t> content_hash,
                          const SkRect& bounds,
+                         bool has_deferred_bounds,
                          bool can_apply_group_opacity,
                          bool is_ui_thread_safe,
+                         bool has_images,
                          bool modifies_transparent_black,
-                         sk_sp<const DlRTree> rtree)
+                         sk_sp<const DlRTree> rtree,
+                         std::vector<DlTextFrameUsage> text_frames)
     : storage_(std::move(storage)),
       byte_count_(byte_count),
       op_count_(op_count),
       nested_byte_count_(nested_byte_count),
       nested_op_count_(nested_op_count),
+      compacted_op_count_(compacted_op_count),
       unique_id_(next_unique_id()),
+      content_hash_(content_hash),
       bounds_(bounds),
+      has_deferred_bounds_(has_deferred_bounds),
       can_apply_group_opacity_(can_apply_group_opacity),
       is_ui_thread_safe_(is_ui_thread_safe),
+      has_images_(has_images),
       modifies_transparent_black_(modifies_transparent_black),
-      rtree_(std::move(rtree)) {}
+      rtree_(std::move(rtree)),
+      text_frames_(std::move(text_frames)) {}
 
 DisplayList::~DisplayList() {
   uint8_t* ptr = storage_.get();
   DisposeOps(ptr, ptr + byte_count_);
 }
 
+void DisplayList::ResolveDeferredBounds() const {
+  std::call_once(deferred_bounds_once_, [this]() {
+    TRACE_EVENT0("flutter", "DisplayList::ResolveDeferredBounds");
+    // Replaying the ops into a builder that was given the same cull rect
+    // computes the same bounds that the original builder would have.
+    DisplayListBuilder builder(bounds_);
+    Dispatch(builder.asReceiver());
+    bounds_ = builder.bounds();
+  });
+}
+
 uint32_t DisplayList::next_unique_id() {
   static std::atomic<uint32_t> next_id{1};
   uint32_t id;
@@ -166,6 +267,77 @@ void DisplayList::Dispatch(DlOpReceiver& receiver,
   Dispatch(receiver, ptr, ptr + byte_count_, culler);
 }
 
+std::vector<SkRect> DisplayList::ComputeDispatchTiles(const SkRect& cull_rect,
+                                                      int columns,
+                                                      int rows) {
+  std::vector<SkRect> tiles;
+  if (cull_rect.isEmpty() || columns <= 0 || rows <= 0) {
+    return tiles;
+  }
+  tiles.reserve(columns * rows);
+  SkScalar tile_width = cull_rect.width() / columns;
+  SkScalar tile_height = cull_rect.height() / rows;
+  for (int y = 0; y < rows; y++) {
+    SkScalar top = cull_rect.fTop + y * tile_height;
+    // The last row and column snap to the cull rect so that rounding
+    // never leaves a sliver of the cull rect uncovered.
+    SkScalar bottom = (y == rows - 1) ? cull_rect.fBottom : top + tile_height;
+    for (int x = 0; x < columns; x++) {
+      SkScalar left = cull_rect.fLeft + x * tile_width;
+      SkScalar right =
+          (x == columns - 1) ? cull_rect.fRight : left + tile_width;
+      tiles.push_back(SkRect::MakeLTRB(left, top, right, bottom));
+    }
+  }
+  return tiles;
+}
+
+void DisplayList::DispatchTiled(const SkRect& cull_rect,
+                                int columns,
+                                int rows,
+                                const TileReceiverProvider& receiver_for_tile,
+                                fml::BasicTaskRunner* task_runner) const {
+  TRACE_EVENT0("flutter", "DisplayList::DispatchTiled");
+  std::vector<SkRect> tiles = ComputeDispatchTiles(cull_rect, columns, rows);
+  if (tiles.empty()) {
+    return;
+  }
+
+  // Pair each tile with its receiver on the calling thread and drop the
+  // tiles outside of our bounds before spinning up any workers. The
+  // remaining tiles are culled by the RTree in |Dispatch|.
+  std::vector<std::pair<DlOpReceiver*, SkRect>> work;
+  work.reserve(tiles.size());
+  for (size_t i = 0; i < tiles.size(); i++) {
+    DlOpReceiver* receiver = &receiver_for_tile(i, tiles[i]);
+    if (!tiles[i].intersects(bounds())) {
+      continue;
+    }
+    work.emplace_back(receiver, tiles[i]);
+  }
+  if (work.empty()) {
+    return;
+  }
+
+  if (!task_runner || work.size() == 1) {
+    for (auto& [receiver, tile] : work) {
+      Dispatch(*receiver, tile);
+    }
+    return;
+  }
+
+  fml::CountDownLatch latch(work.size() - 1);
+  for (size_t i = 1; i < work.size(); i++) {
+    task_runner->PostTask([this, &latch, &tile_work = work[i]]() {
+      TRACE_EVENT0("flutter", "DisplayList::DispatchTile");
+      Dispatch(*tile_work.first, tile_work.second);
+      latch.CountDown();
+    });
+  }
+  Dispatch(*work[0].first, work[0].second);
+  latch.Wait();
+}
+
 void DisplayList::Dispatch(DlOpReceiver& receiver,
                            uint8_t* ptr,
                            uint8_t* end,
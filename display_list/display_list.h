@@ -5,12 +5,19 @@
 #ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_H_
 #define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_H_
 
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <vector>
 
 #include "flutter/display_list/dl_sampling_options.h"
+#include "flutter/display_list/dl_storage_arena.h"
 #include "flutter/display_list/geometry/dl_rtree.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/task_runner.h"
 
 // The Flutter DisplayList mechanism encapsulates a persistent sequence of
 // rendering operations.
@@ -24,6 +31,10 @@
 // DisplayListBuilder: a class for constructing a DisplayList from DlCanvas
 //                     method calls and which can act as a DlOpReceiver as well
 //
+namespace impeller {
+class TextFrame;
+}  // namespace impeller
+
 // Other files include various class definitions for dealing with display
 // lists, such as:
 // skia/dl_sk_*.h: classes to interact between SkCanvas and DisplayList
@@ -203,28 +214,58 @@ class SaveLayerOptions {
   };
 };
 
-// Manages a buffer allocated with malloc.
+// Manages a buffer allocated with malloc, or drawn from a
+// |DisplayListStorageArena| if one was supplied at construction, or
+// a read-only view into an |fml::Mapping| holding serialized ops.
 class DisplayListStorage {
  public:
   DisplayListStorage() = default;
-  DisplayListStorage(DisplayListStorage&&) = default;
-
-  uint8_t* get() const { return ptr_.get(); }
-
-  void realloc(size_t count) {
-    ptr_.reset(static_cast<uint8_t*>(std::realloc(ptr_.release(), count)));
-    FML_CHECK(ptr_);
+  explicit DisplayListStorage(std::shared_ptr<DisplayListStorageArena> arena)
+      : arena_(std::move(arena)) {}
+  // Storage that refers to the |size| bytes at |offset| in |mapping|
+  // without copying them. Such storage can not be reallocated.
+  DisplayListStorage(std::shared_ptr<const fml::Mapping> mapping,
+                     size_t offset,
+                     size_t size);
+  DisplayListStorage(DisplayListStorage&& other);
+  DisplayListStorage& operator=(DisplayListStorage&& other);
+  ~DisplayListStorage();
+
+  uint8_t* get() const { return ptr_; }
+
+  // Ensures the buffer holds at least |count| bytes, preserving the
+  // existing contents. Arena backed storage only ever grows (to the
+  // next slab size class) so that its slab can be recycled intact.
+  void realloc(size_t count);
+
+  // The number of usable bytes in the buffer, which may be larger than
+  // the last size passed to |realloc| for arena backed storage.
+  size_t capacity() const { return capacity_; }
+
+  const std::shared_ptr<DisplayListStorageArena>& arena() const {
+    return arena_;
   }
 
  private:
-  struct FreeDeleter {
-    void operator()(uint8_t* p) { std::free(p); }
-  };
-  std::unique_ptr<uint8_t, FreeDeleter> ptr_;
+  void reset();
+
+  uint8_t* ptr_ = nullptr;
+  size_t capacity_ = 0;
+  std::shared_ptr<DisplayListStorageArena> arena_;
+  std::shared_ptr<const fml::Mapping> mapping_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListStorage);
 };
 
 class Culler;
 
+/// A text frame drawn by a DisplayList along with the largest scale of the
+/// transform it is drawn with, relative to the DisplayList.
+struct DlTextFrameUsage {
+  std::shared_ptr<impeller::TextFrame> text_frame;
+  SkScalar scale;
+};
+
 // The base class that contains a sequence of rendering operations
 // for dispatch to a DlOpReceiver. These objects must be instantiated
 // through an instance of DisplayListBuilder::build().
@@ -238,6 +279,32 @@ class DisplayList : public SkRefCnt {
   void Dispatch(DlOpReceiver& ctx, const SkRect& cull_rect) const;
   void Dispatch(DlOpReceiver& ctx, const SkIRect& cull_rect) const;
 
+  /// @brief     Splits |cull_rect| into a grid of |columns| x |rows| tiles
+  ///            of equal size, returned in row-major order.
+  static std::vector<SkRect> ComputeDispatchTiles(const SkRect& cull_rect,
+                                                  int columns,
+                                                  int rows);
+
+  /// The callback used by |DispatchTiled| to obtain the receiver for one
+  /// tile. It is always invoked on the thread calling |DispatchTiled|.
+  using TileReceiverProvider =
+      std::function<DlOpReceiver&(size_t tile_index, const SkRect& tile)>;
+
+  /// @brief     Dispatches the ops that intersect each tile of |cull_rect|
+  ///            (see |ComputeDispatchTiles|) to a separate receiver, one
+  ///            per tile, using the RTree to cull the ops for each tile.
+  ///
+  /// If a |task_runner| is supplied, the tiles are dispatched concurrently
+  /// on it with the calling thread dispatching one of the tiles itself.
+  /// The call does not return until every tile has been dispatched. The
+  /// receivers must therefore be independent of each other. Tiles that
+  /// no op intersects are skipped, but their receiver is still created.
+  void DispatchTiled(const SkRect& cull_rect,
+                     int columns,
+                     int rows,
+                     const TileReceiverProvider& receiver_for_tile,
+                     fml::BasicTaskRunner* task_runner = nullptr) const;
+
   // From historical behavior, SkPicture always included nested bytes,
   // but nested ops are only included if requested. The defaults used
   // here for these accessors follow that pattern.
@@ -250,13 +317,46 @@ class DisplayList : public SkRefCnt {
     return op_count_ + (nested ? nested_op_count_ : 0);
   }
 
+  /// The number of records that were removed from the op stream by the
+  /// compaction pass of |DisplayListBuilder::Build|, including attribute
+  /// records which are not counted by |op_count|.
+  unsigned int compacted_op_count() const { return compacted_op_count_; }
+
   uint32_t unique_id() const { return unique_id_; }
 
-  const SkRect& bounds() const { return bounds_; }
+  /// A hash of the recorded ops and bounds that is the same for any two
+  /// DisplayLists that render identically, even when they were recorded
+  /// separately, for example by rebuilding the same widget on a later
+  /// frame. Unlike |unique_id| it can be used to recognize content that
+  /// was cached on a previous frame.
+  ///
+  /// Ops that refer to images, filters, color sources, vertices and other
+  /// objects without a stable content identity can not be hashed safely,
+  /// so DisplayLists containing any of them have no content hash.
+  std::optional<uint64_t> content_hash() const { return content_hash_; }
+
+  /// The bounds of the rendering operations. For DisplayLists built
+  /// with |DisplayListBuilder::SetDeferBounds| these are computed on the
+  /// first call, which may then take as long as dispatching the ops.
+  const SkRect& bounds() const {
+    if (has_deferred_bounds_) {
+      ResolveDeferredBounds();
+    }
+    return bounds_;
+  }
 
   bool has_rtree() const { return rtree_ != nullptr; }
   sk_sp<const DlRTree> rtree() const { return rtree_; }
 
+  /// The text frames drawn by this DisplayList and the DisplayLists nested
+  /// in it, collected while recording. Renderers can use them to prepare
+  /// glyph atlases before the ops are dispatched. Text frames that are
+  /// culled when recording are not included, but text frames of ops that
+  /// are culled when dispatching may be.
+  const std::vector<DlTextFrameUsage>& text_frames() const {
+    return text_frames_;
+  }
+
   bool Equals(const DisplayList* other) const;
   bool Equals(const DisplayList& other) const { return Equals(&other); }
   bool Equals(const sk_sp<const DisplayList>& other) const {
@@ -266,6 +366,16 @@ class DisplayList : public SkRefCnt {
   bool can_apply_group_opacity() const { return can_apply_group_opacity_; }
   bool isUIThreadSafe() const { return is_ui_thread_safe_; }
 
+  /// @brief     Indicates if any of the operations of this DisplayList, or
+  ///            of the DisplayLists nested in it, draw an image or set a
+  ///            color source that may sample one.
+  ///
+  /// Such images may be textures owned by the raster thread, or deferred
+  /// images whose state is only valid there, so a DisplayList that has
+  /// images must not be rendered into a CPU surface on another thread even
+  /// if it |isUIThreadSafe|.
+  bool has_images() const { return has_images_; }
+
   /// @brief     Indicates if there are any rendering operations in this
   ///            DisplayList that will modify a surface of transparent black
   ///            pixels.
@@ -285,14 +395,21 @@ class DisplayList : public SkRefCnt {
               unsigned int op_count,
               size_t nested_byte_count,
               unsigned int nested_op_count,
+              unsigned int compacted_op_count,
+              std::optional<uint64_t> content_hash,
               const SkRect& bounds,
+              bool has_deferred_bounds,
               bool can_apply_group_opacity,
               bool is_ui_thread_safe,
+              bool has_images,
               bool modifies_transparent_black,
-              sk_sp<const DlRTree> rtree);
+              sk_sp<const DlRTree> rtree,
+              std::vector<DlTextFrameUsage> text_frames);
 
   static uint32_t next_unique_id();
 
+  void ResolveDeferredBounds() const;
+
   static void DisposeOps(uint8_t* ptr, uint8_t* end);
 
   const DisplayListStorage storage_;
@@ -301,15 +418,24 @@ class DisplayList : public SkRefCnt {
 
   const size_t nested_byte_count_;
   const unsigned int nested_op_count_;
+  const unsigned int compacted_op_count_;
 
   const uint32_t unique_id_;
-  const SkRect bounds_;
+  const std::optional<uint64_t> content_hash_;
+
+  // If |has_deferred_bounds_| is true then |bounds_| holds the cull rect
+  // of the builder until |ResolveDeferredBounds| replaces it.
+  mutable SkRect bounds_;
+  const bool has_deferred_bounds_;
+  mutable std::once_flag deferred_bounds_once_;
 
   const bool can_apply_group_opacity_;
   const bool is_ui_thread_safe_;
+  const bool has_images_;
   const bool modifies_transparent_black_;
 
   const sk_sp<const DlRTree> rtree_;
+  const std::vector<DlTextFrameUsage> text_frames_;
 
   void Dispatch(DlOpReceiver& ctx,
                 uint8_t* ptr,
@@ -317,6 +443,7 @@ class DisplayList : public SkRefCnt {
                 Culler& culler) const;
 
   friend class DisplayListBuilder;
+  friend class DisplayListSerialization;
 };
 
 }  // namespace flutter
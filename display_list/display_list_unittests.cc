@@ -16,6 +16,7 @@
 #include "flutter/display_list/skia/dl_sk_dispatcher.h"
 #include "flutter/display_list/testing/dl_test_snippets.h"
 #include "flutter/display_list/utils/dl_receiver_utils.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/math.h"
 #include "flutter/testing/display_list_testing.h"
@@ -3015,6 +3016,352 @@ TEST_F(DisplayListTest, RTreeRenderCulling) {
   }
 }
 
+TEST_F(DisplayListTest, ComputeDispatchTilesCoversCullRect) {
+  auto tiles = DisplayList::ComputeDispatchTiles({0, 0, 100, 50}, 3, 2);
+  ASSERT_EQ(tiles.size(), 6u);
+  SkRect covered = SkRect::MakeEmpty();
+  for (auto& tile : tiles) {
+    EXPECT_FALSE(tile.isEmpty());
+    covered.join(tile);
+  }
+  EXPECT_EQ(covered, SkRect::MakeLTRB(0, 0, 100, 50));
+  EXPECT_EQ(tiles[0].fTop, 0);
+  EXPECT_EQ(tiles[5].fRight, 100);
+  EXPECT_EQ(tiles[5].fBottom, 50);
+
+  EXPECT_TRUE(DisplayList::ComputeDispatchTiles({0, 0, 100, 50}, 0, 2).empty());
+  EXPECT_TRUE(DisplayList::ComputeDispatchTiles(SkRect::MakeEmpty(), 2, 2)
+                  .empty());
+}
+
+TEST_F(DisplayListTest, TiledDispatchMatchesCulledDispatch) {
+  DisplayListBuilder main_builder(true);
+  DlOpReceiver& main_receiver = ToReceiver(main_builder);
+  main_receiver.drawRect({0, 0, 10, 10});
+  main_receiver.drawRect({20, 0, 30, 10});
+  main_receiver.drawRect({0, 20, 10, 30});
+  main_receiver.drawRect({20, 20, 30, 30});
+  auto main = main_builder.Build();
+  SkRect cull_rect = SkRect::MakeLTRB(0, 0, 30, 30);
+
+  auto test = [&main, &cull_rect](fml::BasicTaskRunner* task_runner) {
+    std::vector<std::unique_ptr<DisplayListBuilder>> builders;
+    main->DispatchTiled(
+        cull_rect, 2, 2,
+        [&builders](size_t index, const SkRect& tile) -> DlOpReceiver& {
+          EXPECT_EQ(index, builders.size());
+          builders.push_back(std::make_unique<DisplayListBuilder>());
+          return ToReceiver(*builders.back());
+        },
+        task_runner);
+    auto tiles = DisplayList::ComputeDispatchTiles(cull_rect, 2, 2);
+    ASSERT_EQ(builders.size(), tiles.size());
+    for (size_t i = 0; i < tiles.size(); i++) {
+      DisplayListBuilder expected_builder;
+      main->Dispatch(ToReceiver(expected_builder), tiles[i]);
+      auto expected = expected_builder.Build();
+      EXPECT_EQ(expected->op_count(), 1u);
+      EXPECT_TRUE(DisplayListsEQ_Verbose(builders[i]->Build(), expected));
+    }
+  };
+
+  test(nullptr);
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  test(loop->GetTaskRunner().get());
+}
+
+TEST_F(DisplayListTest, CompactionDropsOverriddenAttributes) {
+  DisplayListBuilder builder;
+  DlOpReceiver& receiver = ToReceiver(builder);
+  receiver.setColor(DlColor::kRed());
+  receiver.setStrokeWidth(5.0f);
+  receiver.setColor(DlColor::kBlue());
+  receiver.setStrokeWidth(2.0f);
+  receiver.drawRect({0, 0, 10, 10});
+  // Never read by any op
+  receiver.setColor(DlColor::kGreen());
+  auto compacted = builder.Build(/*compact_ops=*/true);
+
+  DisplayListBuilder expected_builder;
+  DlOpReceiver& expected_receiver = ToReceiver(expected_builder);
+  expected_receiver.setColor(DlColor::kBlue());
+  expected_receiver.setStrokeWidth(2.0f);
+  expected_receiver.drawRect({0, 0, 10, 10});
+  auto expected = expected_builder.Build();
+
+  EXPECT_EQ(compacted->compacted_op_count(), 3u);
+  EXPECT_EQ(compacted->op_count(), expected->op_count());
+  EXPECT_EQ(compacted->bytes(), expected->bytes());
+  EXPECT_TRUE(DisplayListsEQ_Verbose(compacted, expected));
+  EXPECT_EQ(expected->compacted_op_count(), 0u);
+}
+
+TEST_F(DisplayListTest, CompactionKeepsAttributesReadByDraws) {
+  DisplayListBuilder builder;
+  DlOpReceiver& receiver = ToReceiver(builder);
+  receiver.setColor(DlColor::kRed());
+  receiver.drawRect({0, 0, 10, 10});
+  receiver.setColor(DlColor::kBlue());
+  receiver.save();
+  receiver.clipRect({0, 0, 5, 5}, ClipOp::kIntersect, false);
+  receiver.drawRect({0, 0, 10, 10});
+  receiver.restore();
+  auto compacted = builder.Build(/*compact_ops=*/true);
+
+  EXPECT_EQ(compacted->compacted_op_count(), 0u);
+  EXPECT_EQ(compacted->op_count(), 5u);
+}
+
+TEST_F(DisplayListTest, CompactionMergesConsecutiveTranslatesAndScales) {
+  DisplayListBuilder builder;
+  builder.Translate(10, 20);
+  builder.Translate(5, 5);
+  builder.Scale(2, 3);
+  builder.Scale(4, 0.5);
+  builder.DrawRect({0, 0, 10, 10}, DlPaint());
+  auto compacted = builder.Build(/*compact_ops=*/true);
+
+  DisplayListBuilder expected_builder;
+  expected_builder.Translate(15, 25);
+  expected_builder.Scale(8, 1.5);
+  expected_builder.DrawRect({0, 0, 10, 10}, DlPaint());
+  auto expected = expected_builder.Build();
+
+  EXPECT_EQ(compacted->compacted_op_count(), 2u);
+  EXPECT_EQ(compacted->op_count(), 3u);
+  EXPECT_EQ(compacted->bounds(), expected->bounds());
+  EXPECT_TRUE(DisplayListsEQ_Verbose(compacted, expected));
+}
+
+TEST_F(DisplayListTest, CompactionPreservesRTreeCulling) {
+  auto record = [](DisplayListBuilder& builder) {
+    DlOpReceiver& receiver = ToReceiver(builder);
+    receiver.setColor(DlColor::kRed());
+    receiver.setColor(DlColor::kBlue());
+    receiver.drawRect({0, 0, 10, 10});
+    receiver.save();
+    receiver.translate(5, 5);
+    receiver.translate(15, 15);
+    receiver.setColor(DlColor::kGreen());
+    receiver.setColor(DlColor::kYellow());
+    receiver.drawRect({0, 0, 10, 10});
+    receiver.restore();
+    receiver.setStrokeWidth(3);
+    receiver.setStrokeWidth(4);
+    receiver.drawRect({40, 40, 50, 50});
+  };
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  record(builder);
+  auto original = builder.Build();
+  DisplayListBuilder compacting_builder(/*prepare_rtree=*/true);
+  record(compacting_builder);
+  auto compacted = compacting_builder.Build(/*compact_ops=*/true);
+  EXPECT_EQ(compacted->compacted_op_count(), 4u);
+  EXPECT_EQ(compacted->bounds(), original->bounds());
+
+  std::vector<SkRect> cull_rects = {
+      {0, 0, 10, 10},    // first rect only
+      {20, 20, 30, 30},  // translated rect only
+      {40, 40, 50, 50},  // last rect only
+      {12, 12, 18, 18},  // nothing
+      {0, 0, 50, 50},    // everything
+  };
+  for (auto& cull_rect : cull_rects) {
+    DisplayListBuilder original_culled;
+    original->Dispatch(ToReceiver(original_culled), cull_rect);
+    DisplayListBuilder compacted_culled;
+    compacted->Dispatch(ToReceiver(compacted_culled), cull_rect);
+    auto expected = original_culled.Build(/*compact_ops=*/true);
+    auto actual = compacted_culled.Build(/*compact_ops=*/true);
+    EXPECT_EQ(actual->op_count(), expected->op_count());
+    EXPECT_EQ(actual->bounds(), expected->bounds());
+  }
+}
+
+TEST_F(DisplayListTest, RTreeHintProducesSameRTree) {
+  auto record = [](DisplayListBuilder& builder, SkScalar offset) {
+    DlOpReceiver& receiver = ToReceiver(builder);
+    for (int i = 0; i < 100; i++) {
+      SkScalar x = (i % 10) * 20;
+      SkScalar y = (i / 10) * 20;
+      if (i == 50) {
+        x += offset;
+      }
+      receiver.drawRect(SkRect::MakeXYWH(x, y, 10, 10));
+    }
+  };
+  DisplayListBuilder previous_builder(/*prepare_rtree=*/true);
+  record(previous_builder, 0);
+  auto previous = previous_builder.Build();
+
+  DisplayListBuilder fresh_builder(/*prepare_rtree=*/true);
+  record(fresh_builder, 5);
+  auto fresh = fresh_builder.Build();
+
+  DisplayListBuilder hinted_builder(/*prepare_rtree=*/true);
+  hinted_builder.SetRTreeHint(previous);
+  record(hinted_builder, 5);
+  auto hinted = hinted_builder.Build();
+
+  ASSERT_TRUE(hinted->has_rtree());
+  EXPECT_GT(hinted->rtree()->reused_node_count(), 0);
+  EXPECT_EQ(hinted->rtree()->node_count(), fresh->rtree()->node_count());
+  EXPECT_EQ(hinted->rtree()->bounds(), fresh->rtree()->bounds());
+  EXPECT_TRUE(DisplayListsEQ_Verbose(hinted, fresh));
+  for (int i = 0; i < 10; i++) {
+    SkRect query = SkRect::MakeXYWH(i * 20 + 3, i * 20 + 3, 10, 10);
+    std::vector<int> expected;
+    std::vector<int> actual;
+    fresh->rtree()->search(query, &expected);
+    hinted->rtree()->search(query, &actual);
+    EXPECT_EQ(actual, expected);
+  }
+
+  // The hint only applies to a single Build.
+  record(hinted_builder, 5);
+  EXPECT_EQ(hinted_builder.Build()->rtree()->reused_node_count(), 0);
+}
+
+TEST_F(DisplayListTest, ContentHashMatchesForIdenticalRecordings) {
+  auto record = [](DlColor color) {
+    DisplayListBuilder builder;
+    builder.DrawRect({0, 0, 10, 10}, DlPaint(color));
+    builder.Save();
+    builder.Translate(5, 5);
+    SkPoint points[] = {{0, 0}, {10, 10}, {20, 0}};
+    builder.DrawPoints(DlCanvas::PointMode::kPolygon, 3, points, DlPaint());
+    builder.DrawPath(kTestPath1, DlPaint());
+    builder.Restore();
+    return builder.Build();
+  };
+  auto display_list_1 = record(DlColor::kRed());
+  auto display_list_2 = record(DlColor::kRed());
+  auto display_list_3 = record(DlColor::kBlue());
+
+  ASSERT_TRUE(display_list_1->content_hash().has_value());
+  ASSERT_TRUE(display_list_3->content_hash().has_value());
+  EXPECT_NE(display_list_1->unique_id(), display_list_2->unique_id());
+  EXPECT_EQ(display_list_1->content_hash(), display_list_2->content_hash());
+  EXPECT_NE(display_list_1->content_hash(), display_list_3->content_hash());
+
+  // Nested DisplayLists contribute their own content hash.
+  DisplayListBuilder outer_builder_1;
+  outer_builder_1.DrawDisplayList(display_list_1);
+  DisplayListBuilder outer_builder_2;
+  outer_builder_2.DrawDisplayList(display_list_2);
+  EXPECT_EQ(outer_builder_1.Build()->content_hash(),
+            outer_builder_2.Build()->content_hash());
+}
+
+TEST_F(DisplayListTest, CollectsTextFramesWithTheirScale) {
+  std::vector<impeller::TextRun> runs;
+  auto frame = std::make_shared<impeller::TextFrame>(
+      runs, impeller::Rect::MakeLTRB(0, 0, 10, 10), false);
+
+  DisplayListBuilder inner_builder;
+  inner_builder.DrawTextFrame(frame, 0, 0, DlPaint());
+  inner_builder.Scale(2, 3);
+  inner_builder.DrawTextFrame(frame, 0, 0, DlPaint());
+  // Text that is culled is not collected.
+  inner_builder.ClipRect({100, 100, 110, 110});
+  inner_builder.DrawTextFrame(frame, 0, 0, DlPaint());
+  auto inner = inner_builder.Build();
+  ASSERT_EQ(inner->text_frames().size(), 2u);
+  EXPECT_EQ(inner->text_frames()[0].text_frame, frame);
+  EXPECT_EQ(inner->text_frames()[0].scale, 1.0f);
+  EXPECT_EQ(inner->text_frames()[1].scale, 3.0f);
+
+  DisplayListBuilder outer_builder;
+  outer_builder.Scale(2, 2);
+  outer_builder.DrawDisplayList(inner);
+  auto outer = outer_builder.Build();
+  ASSERT_EQ(outer->text_frames().size(), 2u);
+  EXPECT_EQ(outer->text_frames()[0].scale, 2.0f);
+  EXPECT_EQ(outer->text_frames()[1].scale, 6.0f);
+
+  // The builder starts over after building.
+  EXPECT_TRUE(outer_builder.Build()->text_frames().empty());
+}
+
+TEST_F(DisplayListTest, ContentHashDependsOnBounds) {
+  DisplayListBuilder builder_1(SkRect::MakeWH(100, 100));
+  builder_1.DrawPaint(DlPaint());
+  DisplayListBuilder builder_2(SkRect::MakeWH(50, 50));
+  builder_2.DrawPaint(DlPaint());
+  EXPECT_NE(builder_1.Build()->content_hash(),
+            builder_2.Build()->content_hash());
+}
+
+TEST_F(DisplayListTest, NoContentHashWithImages) {
+  DisplayListBuilder builder;
+  builder.DrawRect({0, 0, 10, 10}, DlPaint());
+  builder.DrawImage(TestImage1, {0, 0}, kLinearSampling);
+  auto display_list = builder.Build();
+  EXPECT_FALSE(display_list->content_hash().has_value());
+
+  // Nor for DisplayLists that contain one which has no hash.
+  DisplayListBuilder outer_builder;
+  outer_builder.DrawDisplayList(display_list);
+  EXPECT_FALSE(outer_builder.Build()->content_hash().has_value());
+
+  // The builder starts over with a hashable stream after Build.
+  builder.DrawRect({0, 0, 10, 10}, DlPaint());
+  EXPECT_TRUE(builder.Build()->content_hash().has_value());
+}
+
+TEST_F(DisplayListTest, DeferredBoundsMatchEagerBounds) {
+  auto record = [](DisplayListBuilder& builder) {
+    DlPaint stroke_paint;
+    stroke_paint.setDrawStyle(DlDrawStyle::kStroke);
+    stroke_paint.setStrokeWidth(4);
+    builder.DrawRect({10, 10, 20, 20}, DlPaint());
+    builder.Save();
+    builder.Translate(30, 30);
+    builder.Scale(2, 2);
+    builder.DrawOval({0, 0, 10, 10}, stroke_paint);
+    builder.Restore();
+    auto filter = DlBlurImageFilter(3.0, 3.0, DlTileMode::kDecal);
+    DlPaint filter_paint = DlPaint().setImageFilter(&filter);
+    builder.SaveLayer(nullptr, &filter_paint);
+    builder.DrawCircle({60, 20}, 5, DlPaint());
+    builder.Restore();
+    // Entirely outside of the cull rect.
+    builder.DrawRect({500, 500, 510, 510}, DlPaint());
+    builder.DrawPath(kTestPath1, stroke_paint);
+  };
+  SkRect cull_rect = SkRect::MakeWH(100, 100);
+  DisplayListBuilder eager_builder(cull_rect);
+  record(eager_builder);
+  auto eager = eager_builder.Build();
+
+  DisplayListBuilder deferred_builder(cull_rect);
+  deferred_builder.SetDeferBounds(true);
+  record(deferred_builder);
+  auto deferred = deferred_builder.Build();
+
+  // The culled rect is still recorded by the deferred builder.
+  EXPECT_GT(deferred->op_count(), eager->op_count());
+  EXPECT_EQ(deferred->bounds(), eager->bounds());
+  EXPECT_EQ(deferred->can_apply_group_opacity(),
+            eager->can_apply_group_opacity());
+
+  // The setting applies to every subsequent Build.
+  record(deferred_builder);
+  EXPECT_EQ(deferred_builder.Build()->bounds(), eager->bounds());
+}
+
+TEST_F(DisplayListTest, DeferredBoundsAreIgnoredWithRTree) {
+  DisplayListBuilder builder(SkRect::MakeWH(100, 100), /*prepare_rtree=*/true);
+  builder.SetDeferBounds(true);
+  builder.DrawRect({10, 10, 20, 20}, DlPaint());
+  builder.DrawRect({500, 500, 510, 510}, DlPaint());
+  auto display_list = builder.Build();
+  ASSERT_TRUE(display_list->has_rtree());
+  EXPECT_EQ(display_list->op_count(), 1u);
+  EXPECT_EQ(display_list->bounds(), SkRect::MakeLTRB(10, 10, 20, 20));
+}
+
 TEST_F(DisplayListTest, DrawSaveDrawCannotInheritOpacity) {
   DisplayListBuilder builder;
   builder.DrawCircle({10, 10}, 5, DlPaint());
@@ -3239,5 +3586,30 @@ TEST_F(DisplayListTest, NopOperationsOmittedFromRecords) {
             });
 }
 
+TEST_F(DisplayListTest, HasImagesIsTrackedThroughNestedDisplayLists) {
+  DisplayListBuilder rect_builder;
+  rect_builder.DrawRect({0, 0, 10, 10}, DlPaint());
+  auto rect_display_list = rect_builder.Build();
+  EXPECT_FALSE(rect_display_list->has_images());
+
+  DisplayListBuilder image_builder;
+  image_builder.DrawImage(TestImage1, {0, 0}, kLinearSampling);
+  auto image_display_list = image_builder.Build();
+  EXPECT_TRUE(image_display_list->has_images());
+
+  DlImageColorSource image_source(TestImage1, DlTileMode::kClamp,
+                                  DlTileMode::kClamp, kLinearSampling);
+  DisplayListBuilder shader_builder;
+  shader_builder.DrawRect({0, 0, 10, 10},
+                          DlPaint().setColorSource(&image_source));
+  EXPECT_TRUE(shader_builder.Build()->has_images());
+
+  DisplayListBuilder outer_builder;
+  outer_builder.DrawDisplayList(rect_display_list);
+  EXPECT_FALSE(outer_builder.Build()->has_images());
+  outer_builder.DrawDisplayList(image_display_list);
+  EXPECT_TRUE(outer_builder.Build()->has_images());
+}
+
 }  // namespace testing
 }  // namespace flutter
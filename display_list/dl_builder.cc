@@ -4,6 +4,13 @@
 
 #include "flutter/display_list/dl_builder.h"
 
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_blend_mode.h"
 #include "flutter/display_list/dl_op_flags.h"
@@ -39,6 +46,133 @@ static constexpr inline bool is_power_of_two(int value) {
   return (value & (value - 1)) == 0;
 }
 
+// The content hash is a 64-bit multiply-rotate hash over the 8-byte words
+// of each op record (in the style of the MurmurHash3 body), finalized with
+// the MurmurHash3 avalanche step.
+static constexpr uint64_t kContentHashSeed = 0x9e3779b97f4a7c15ull;
+
+static inline uint64_t RotateLeft(uint64_t value, int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+static inline uint64_t MixContentHash(uint64_t hash, uint64_t value) {
+  value *= 0x87c37b91114253d5ull;
+  value = RotateLeft(value, 31);
+  value *= 0x4cf5ad432745937full;
+  hash ^= value;
+  return RotateLeft(hash, 27) * 5 + 0x52dce729;
+}
+
+static inline uint64_t FinalizeContentHash(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdull;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ull;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+static uint64_t MixContentHashBytes(uint64_t hash,
+                                    const uint8_t* bytes,
+                                    size_t size) {
+  // Records are pointer aligned and padded with zeroes, see Push.
+  FML_DCHECK((size & 3) == 0);
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, bytes + i, sizeof(word));
+    hash = MixContentHash(hash, word);
+  }
+  if (i < size) {
+    uint32_t word;
+    memcpy(&word, bytes + i, sizeof(word));
+    hash = MixContentHash(hash, word);
+  }
+  return hash;
+}
+
+static uint64_t MixContentHashPath(uint64_t hash, const SkPath& path) {
+  // Generation IDs are unique across the process for the lifetime of the
+  // process and change with every modification other than the fill type.
+  hash = MixContentHash(hash, path.getGenerationID());
+  return MixContentHash(hash, static_cast<uint64_t>(path.getFillType()));
+}
+
+// Computes a hash of the records between |ptr| and |end| and the |bounds|
+// of the DisplayList that is equal for two DisplayLists only if they render
+// identically, or returns nullopt if any record refers to an object with no
+// stable content identity. If |deferred_bounds| is true then |bounds| is
+// the cull rect the bounds will later be computed from.
+static std::optional<uint64_t> ComputeContentHash(const uint8_t* ptr,
+                                                  const uint8_t* end,
+                                                  const SkRect& bounds,
+                                                  bool deferred_bounds) {
+  uint64_t hash = kContentHashSeed;
+  while (ptr < end) {
+    auto op = reinterpret_cast<const DLOp*>(ptr);
+    hash = MixContentHash(hash, static_cast<uint64_t>(op->type) << 32 |
+                                    static_cast<uint64_t>(op->size));
+    switch (op->type) {
+#define DL_OP_HASH_BYTES(name)                       \
+  case DisplayListOpType::k##name:                   \
+    hash = MixContentHashBytes(hash, ptr, op->size); \
+    break;
+
+      FOR_EACH_PLAIN_DATA_DISPLAY_LIST_OP(DL_OP_HASH_BYTES)
+
+#undef DL_OP_HASH_BYTES
+
+      case DisplayListOpType::kDrawPath:
+        hash =
+            MixContentHashPath(hash, static_cast<const DrawPathOp*>(op)->path);
+        break;
+      case DisplayListOpType::kClipIntersectPath: {
+        auto clip_op = static_cast<const ClipIntersectPathOp*>(op);
+        hash = MixContentHashPath(hash, clip_op->path);
+        hash = MixContentHash(hash, clip_op->is_aa);
+        break;
+      }
+      case DisplayListOpType::kClipDifferencePath: {
+        auto clip_op = static_cast<const ClipDifferencePathOp*>(op);
+        hash = MixContentHashPath(hash, clip_op->path);
+        hash = MixContentHash(hash, clip_op->is_aa);
+        break;
+      }
+      case DisplayListOpType::kDrawTextBlob: {
+        // Text blob unique IDs are never reused within a process.
+        auto text_op = static_cast<const DrawTextBlobOp*>(op);
+        hash = MixContentHash(hash, text_op->blob->uniqueID());
+        hash = MixContentHashBytes(
+            hash, reinterpret_cast<const uint8_t*>(&text_op->x),
+            sizeof(SkScalar) * 2);
+        break;
+      }
+      case DisplayListOpType::kDrawDisplayList: {
+        auto nested_op = static_cast<const DrawDisplayListOp*>(op);
+        std::optional<uint64_t> nested_hash =
+            nested_op->display_list->content_hash();
+        if (!nested_hash.has_value()) {
+          return std::nullopt;
+        }
+        hash = MixContentHash(hash, nested_hash.value());
+        hash = MixContentHashBytes(
+            hash, reinterpret_cast<const uint8_t*>(&nested_op->opacity),
+            sizeof(SkScalar));
+        break;
+      }
+      default:
+        // The remaining records refer to images, filters, color sources,
+        // vertices or other objects that have no stable content identity.
+        return std::nullopt;
+    }
+    ptr += op->size;
+  }
+  hash = MixContentHashBytes(hash, reinterpret_cast<const uint8_t*>(&bounds),
+                             sizeof(bounds));
+  hash = MixContentHash(hash, deferred_bounds);
+  return FinalizeContentHash(hash);
+}
+
 template <typename T, typename... Args>
 void* DisplayListBuilder::Push(size_t pod, int render_op_inc, Args&&... args) {
   size_t size = SkAlignPtr(sizeof(T) + pod);
@@ -50,6 +184,8 @@ void* DisplayListBuilder::Push(size_t pod, int render_op_inc, Args&&... args) {
     allocated_ = (used_ + size + DL_BUILDER_PAGE) & ~(DL_BUILDER_PAGE - 1);
     storage_.realloc(allocated_);
     FML_DCHECK(storage_.get());
+    // Arena backed storage rounds up to a full slab, use all of it.
+    allocated_ = storage_.capacity();
     memset(storage_.get() + used_, 0, allocated_ - used_);
   }
   FML_DCHECK(used_ + size <= allocated_);
@@ -63,36 +199,270 @@ void* DisplayListBuilder::Push(size_t pod, int render_op_inc, Args&&... args) {
   return op + 1;
 }
 
-sk_sp<DisplayList> DisplayListBuilder::Build() {
+// Identifies which attribute of the rendering state an op sets so that
+// the compaction pass can tell when one attribute op overrides another.
+// Returns -1 for ops which do not set any attributes.
+static int AttributeSlot(DisplayListOpType type) {
+  switch (type) {
+    case DisplayListOpType::kSetAntiAlias:
+      return 0;
+    case DisplayListOpType::kSetInvertColors:
+      return 1;
+    case DisplayListOpType::kSetStrokeCap:
+      return 2;
+    case DisplayListOpType::kSetStrokeJoin:
+      return 3;
+    case DisplayListOpType::kSetStyle:
+      return 4;
+    case DisplayListOpType::kSetStrokeWidth:
+      return 5;
+    case DisplayListOpType::kSetStrokeMiter:
+      return 6;
+    case DisplayListOpType::kSetColor:
+      return 7;
+    case DisplayListOpType::kSetBlendMode:
+      return 8;
+    case DisplayListOpType::kSetPodPathEffect:
+    case DisplayListOpType::kClearPathEffect:
+      return 9;
+    case DisplayListOpType::kClearColorFilter:
+    case DisplayListOpType::kSetPodColorFilter:
+      return 10;
+    case DisplayListOpType::kClearColorSource:
+    case DisplayListOpType::kSetPodColorSource:
+    case DisplayListOpType::kSetImageColorSource:
+    case DisplayListOpType::kSetRuntimeEffectColorSource:
+#ifdef IMPELLER_ENABLE_3D
+    case DisplayListOpType::kSetSceneColorSource:
+#endif  // IMPELLER_ENABLE_3D
+      return 11;
+    case DisplayListOpType::kClearImageFilter:
+    case DisplayListOpType::kSetPodImageFilter:
+    case DisplayListOpType::kSetSharedImageFilter:
+      return 12;
+    case DisplayListOpType::kClearMaskFilter:
+    case DisplayListOpType::kSetPodMaskFilter:
+      return 13;
+    default:
+      return -1;
+  }
+}
+static constexpr int kAttributeSlotCount = 14;
+
+// Transform, clip, save and restore ops never read the attributes, every
+// other non-attribute op is conservatively treated as consuming them.
+static bool ConsumesAttributes(DisplayListOpType type) {
+  switch (type) {
+    case DisplayListOpType::kSave:
+    case DisplayListOpType::kRestore:
+    case DisplayListOpType::kTranslate:
+    case DisplayListOpType::kScale:
+    case DisplayListOpType::kRotate:
+    case DisplayListOpType::kSkew:
+    case DisplayListOpType::kTransform2DAffine:
+    case DisplayListOpType::kTransformFullPerspective:
+    case DisplayListOpType::kTransformReset:
+    case DisplayListOpType::kClipIntersectRect:
+    case DisplayListOpType::kClipIntersectRRect:
+    case DisplayListOpType::kClipIntersectPath:
+    case DisplayListOpType::kClipDifferenceRect:
+    case DisplayListOpType::kClipDifferenceRRect:
+    case DisplayListOpType::kClipDifferencePath:
+      return false;
+    default:
+      return AttributeSlot(type) < 0;
+  }
+}
+
+static bool IsSaveOp(DisplayListOpType type) {
+  switch (type) {
+    case DisplayListOpType::kSave:
+    case DisplayListOpType::kSaveLayer:
+    case DisplayListOpType::kSaveLayerBounds:
+    case DisplayListOpType::kSaveLayerBackdrop:
+    case DisplayListOpType::kSaveLayerBackdropBounds:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Replaces a (trivially destructible) op record in place, keeping its size.
+template <typename T, typename... Args>
+static void ReplaceOp(T* op, Args&&... args) {
+  static_assert(std::is_trivially_destructible_v<T>);
+  uint32_t size = op->size;
+  new (op) T{std::forward<Args>(args)...};
+  op->type = T::kType;
+  op->size = size;
+}
+
+void DisplayListBuilder::CompactOps() {
+  uint8_t* const start = storage_.get();
+  uint8_t* const end = start + used_;
+  const int op_count = op_index_;
+  if (op_count == 0) {
+    return;
+  }
+
+  // Pass 1: find the attribute ops that are overridden before anything
+  // reads them (or that are never read at all) and fold runs of
+  // translates or scales into their first op.
+  std::vector<bool> dead(op_count, false);
+  int pending[kAttributeSlotCount];
+  std::fill(std::begin(pending), std::end(pending), -1);
+  DLOp* previous = nullptr;
+  int index = 0;
+  for (uint8_t* ptr = start; ptr < end; index++) {
+    auto op = reinterpret_cast<DLOp*>(ptr);
+    ptr += op->size;
+    int slot = AttributeSlot(op->type);
+    if (slot >= 0) {
+      if (pending[slot] >= 0) {
+        dead[pending[slot]] = true;
+      }
+      pending[slot] = index;
+      continue;
+    }
+    if (ConsumesAttributes(op->type)) {
+      std::fill(std::begin(pending), std::end(pending), -1);
+    }
+    if (previous && previous->type == op->type) {
+      if (op->type == DisplayListOpType::kTranslate) {
+        auto prev = static_cast<TranslateOp*>(previous);
+        auto cur = static_cast<TranslateOp*>(op);
+        ReplaceOp(prev, prev->tx + cur->tx, prev->ty + cur->ty);
+        dead[index] = true;
+        render_op_count_--;
+        continue;
+      }
+      if (op->type == DisplayListOpType::kScale) {
+        auto prev = static_cast<ScaleOp*>(previous);
+        auto cur = static_cast<ScaleOp*>(op);
+        ReplaceOp(prev, prev->sx * cur->sx, prev->sy * cur->sy);
+        dead[index] = true;
+        render_op_count_--;
+        continue;
+      }
+    }
+    previous = op;
+  }
+  // Attributes still pending at the end of the list are never read.
+  for (int dead_index : pending) {
+    if (dead_index >= 0) {
+      dead[dead_index] = true;
+    }
+  }
+
+  // Map each original op index to its index in the compacted stream.
+  // Removed ops map to the index of the next surviving op, which keeps
+  // the culling comparisons against restore and RTree indices intact.
+  std::vector<int> remap(op_count + 1);
+  int kept = 0;
+  for (int i = 0; i < op_count; i++) {
+    remap[i] = kept;
+    if (!dead[i]) {
+      kept++;
+    }
+  }
+  remap[op_count] = kept;
+  if (kept == op_count) {
+    return;
+  }
+
+  // Pass 2: slide the surviving records down over the removed ones.
+  // Records are relocatable by memmove in the same way that growing the
+  // storage with realloc relocates them.
+  uint8_t* write = start;
+  index = 0;
+  for (uint8_t* ptr = start; ptr < end; index++) {
+    auto op = reinterpret_cast<DLOp*>(ptr);
+    size_t size = op->size;
+    if (dead[index]) {
+      DisplayList::DisposeOps(ptr, ptr + size);
+    } else {
+      if (write != ptr) {
+        memmove(write, ptr, size);
+      }
+      auto moved = reinterpret_cast<DLOp*>(write);
+      if (IsSaveOp(moved->type)) {
+        auto save_op = static_cast<SaveOpBase*>(moved);
+        save_op->restore_index = remap[save_op->restore_index];
+      }
+      write += size;
+    }
+    ptr += size;
+  }
+
+  compacted_op_count_ += op_count - kept;
+  op_index_ = kept;
+  used_ = write - start;
+  if (accumulator_->type() == BoundsAccumulatorType::kRTree) {
+    static_cast<RTreeBoundsAccumulator*>(accumulator_.get())
+        ->RemapIndices(remap);
+  }
+}
+
+sk_sp<DisplayList> DisplayListBuilder::Build(bool compact_ops) {
   while (layer_stack_.size() > 1) {
     restore();
   }
+  if (compact_ops) {
+    CompactOps();
+  }
 
   size_t bytes = used_;
   int count = render_op_count_;
   size_t nested_bytes = nested_bytes_;
   int nested_count = nested_op_count_;
+  int compacted_count = compacted_op_count_;
   bool compatible = current_layer_->is_group_opacity_compatible();
   bool is_safe = is_ui_thread_safe_;
+  bool has_images = has_images_;
+  std::vector<DlTextFrameUsage> text_frames = std::move(text_frames_);
+  text_frames_.clear();
   bool affects_transparency = current_layer_->affects_transparent_layer();
+  // Deferred bounds are computed later from the ops and the cull rect,
+  // which then stands in for the bounds in the content hash.
+  bool defer_bounds = defer_bounds_;
+  SkRect bounds = defer_bounds ? tracker_.base_device_cull_rect()  //
+                               : this->bounds();
+  // The hash is taken over the final records rather than as each op is
+  // pushed, since save records are patched when their restore is recorded
+  // and CompactOps drops and moves records. This costs one more pass over
+  // the op buffer.
+  std::optional<uint64_t> content_hash = ComputeContentHash(
+      storage_.get(), storage_.get() + used_, bounds, defer_bounds);
 
   used_ = allocated_ = render_op_count_ = op_index_ = 0;
-  nested_bytes_ = nested_op_count_ = 0;
+  nested_bytes_ = nested_op_count_ = compacted_op_count_ = 0;
   is_ui_thread_safe_ = true;
+  has_images_ = false;
   storage_.realloc(bytes);
+  DisplayListStorage storage = std::move(storage_);
+  // DisplayLists built from an arena return their slab to it when they
+  // are disposed, the next recording draws from the same arena.
+  storage_ = DisplayListStorage(storage.arena());
   layer_stack_.pop_back();
   layer_stack_.emplace_back();
   tracker_.reset();
   current_ = DlPaint();
 
+  sk_sp<DlRTree> built_rtree = rtree();
+  rtree_hint_.reset();
+
   return sk_sp<DisplayList>(new DisplayList(
-      std::move(storage_), bytes, count, nested_bytes, nested_count, bounds(),
-      compatible, is_safe, affects_transparency, rtree()));
+      std::move(storage), bytes, count, nested_bytes, nested_count,
+      compacted_count, content_hash, bounds, defer_bounds, compatible,
+      is_safe, has_images, affects_transparency, std::move(built_rtree),
+      std::move(text_frames)));
 }
 
-DisplayListBuilder::DisplayListBuilder(const SkRect& cull_rect,
-                                       bool prepare_rtree)
-    : tracker_(cull_rect, SkMatrix::I()) {
+DisplayListBuilder::DisplayListBuilder(
+    const SkRect& cull_rect,
+    bool prepare_rtree,
+    std::shared_ptr<DisplayListStorageArena> arena)
+    : storage_(std::move(arena)), tracker_(cull_rect, SkMatrix::I()) {
   if (prepare_rtree) {
     accumulator_ = std::make_unique<RTreeBoundsAccumulator>();
   } else {
@@ -176,6 +546,7 @@ void DisplayListBuilder::onSetColorSource(const DlColorSource* source) {
         const DlImageColorSource* image_source = source->asImage();
         FML_DCHECK(image_source);
         Push<SetImageColorSourceOp>(0, 0, image_source);
+        has_images_ = true;
         break;
       }
       case DlColorSourceType::kLinearGradient: {
@@ -211,6 +582,8 @@ void DisplayListBuilder::onSetColorSource(const DlColorSource* source) {
         const DlRuntimeEffectColorSource* effect = source->asRuntimeEffect();
         FML_DCHECK(effect);
         Push<SetRuntimeEffectColorSourceOp>(0, 0, effect);
+        // The samplers of the effect may be images.
+        has_images_ = true;
         break;
       }
 #ifdef IMPELLER_ENABLE_3D
@@ -218,6 +591,7 @@ void DisplayListBuilder::onSetColorSource(const DlColorSource* source) {
         const DlSceneColorSource* scene = source->asScene();
         FML_DCHECK(scene);
         Push<SetSceneColorSourceOp>(0, 0, scene);
+        has_images_ = true;
         break;
       }
 #endif  // IMPELLER_ENABLE_3D
@@ -1043,6 +1417,7 @@ void DisplayListBuilder::drawImage(const sk_sp<DlImage> image,
     CheckLayerOpacityCompatibility(render_with_attributes);
     UpdateLayerResult(result);
     is_ui_thread_safe_ = is_ui_thread_safe_ && image->isUIThreadSafe();
+    has_images_ = true;
   }
 }
 void DisplayListBuilder::DrawImage(const sk_sp<DlImage>& image,
@@ -1073,6 +1448,7 @@ void DisplayListBuilder::drawImageRect(const sk_sp<DlImage> image,
     CheckLayerOpacityCompatibility(render_with_attributes);
     UpdateLayerResult(result);
     is_ui_thread_safe_ = is_ui_thread_safe_ && image->isUIThreadSafe();
+    has_images_ = true;
   }
 }
 void DisplayListBuilder::DrawImageRect(const sk_sp<DlImage>& image,
@@ -1105,6 +1481,7 @@ void DisplayListBuilder::drawImageNine(const sk_sp<DlImage> image,
     CheckLayerOpacityCompatibility(render_with_attributes);
     UpdateLayerResult(result);
     is_ui_thread_safe_ = is_ui_thread_safe_ && image->isUIThreadSafe();
+    has_images_ = true;
   }
 }
 void DisplayListBuilder::DrawImageNine(const sk_sp<DlImage>& image,
@@ -1180,6 +1557,7 @@ void DisplayListBuilder::drawAtlas(const sk_sp<DlImage> atlas,
   UpdateLayerOpacityCompatibility(false);
   UpdateLayerResult(result);
   is_ui_thread_safe_ = is_ui_thread_safe_ && atlas->isUIThreadSafe();
+  has_images_ = true;
 }
 void DisplayListBuilder::DrawAtlas(const sk_sp<DlImage>& atlas,
                                    const SkRSXform xform[],
@@ -1240,6 +1618,13 @@ void DisplayListBuilder::DrawDisplayList(const sk_sp<DisplayList> display_list,
   Push<DrawDisplayListOp>(0, 1, display_list,
                           opacity < SK_Scalar1 ? opacity : SK_Scalar1);
   is_ui_thread_safe_ = is_ui_thread_safe_ && display_list->isUIThreadSafe();
+  has_images_ = has_images_ || display_list->has_images();
+  if (!display_list->text_frames().empty()) {
+    SkScalar scale = GetTextScale();
+    for (const DlTextFrameUsage& usage : display_list->text_frames()) {
+      text_frames_.push_back({usage.text_frame, usage.scale * scale});
+    }
+  }
   // Not really necessary if the developer is interacting with us via
   // our attribute-state-less DlCanvas methods, but this avoids surprises
   // for those who may have been using the stateful Dispatcher methods.
@@ -1318,6 +1703,7 @@ void DisplayListBuilder::drawTextFrame(
 #endif  // OS_FUCHSIA
   if (unclipped) {
     Push<DrawTextFrameOp>(0, 1, text_frame, x, y);
+    text_frames_.push_back({text_frame, GetTextScale()});
     // There is no way to query if the glyphs of a text blob overlap and
     // there are no current guarantees from either Skia or Impeller that
     // they will protect overlapping glyphs from the effects of overdraw
@@ -1328,6 +1714,13 @@ void DisplayListBuilder::drawTextFrame(
   }
 }
 
+SkScalar DisplayListBuilder::GetTextScale() const {
+  // The same scale as impeller::Entity::DeriveTextScale.
+  SkMatrix matrix = GetTransform();
+  return std::max(SkPoint::Length(matrix.getScaleX(), matrix.getSkewY()),
+                  SkPoint::Length(matrix.getSkewX(), matrix.getScaleY()));
+}
+
 void DisplayListBuilder::DrawTextFrame(
     const std::shared_ptr<impeller::TextFrame>& text_frame,
     SkScalar x,
@@ -1425,6 +1818,9 @@ bool DisplayListBuilder::AdjustBoundsForPaint(SkRect& bounds,
 }
 
 bool DisplayListBuilder::AccumulateUnbounded() {
+  if (defer_bounds_) {
+    return true;
+  }
   SkRect clip = tracker_.device_cull_rect();
   if (clip.isEmpty()) {
     return false;
@@ -1435,6 +1831,9 @@ bool DisplayListBuilder::AccumulateUnbounded() {
 
 bool DisplayListBuilder::AccumulateOpBounds(SkRect& bounds,
                                             DisplayListAttributeFlags flags) {
+  if (defer_bounds_) {
+    return true;
+  }
   if (AdjustBoundsForPaint(bounds, flags)) {
     return AccumulateBounds(bounds);
   } else {
@@ -1442,6 +1841,9 @@ bool DisplayListBuilder::AccumulateOpBounds(SkRect& bounds,
   }
 }
 bool DisplayListBuilder::AccumulateBounds(SkRect& bounds) {
+  if (defer_bounds_) {
+    return true;
+  }
   if (!bounds.isEmpty()) {
     tracker_.mapRect(&bounds);
     if (bounds.intersect(tracker_.device_cull_rect())) {
@@ -35,8 +35,12 @@ class DisplayListBuilder final : public virtual DlCanvas,
   explicit DisplayListBuilder(bool prepare_rtree)
       : DisplayListBuilder(kMaxCullRect, prepare_rtree) {}
 
-  explicit DisplayListBuilder(const SkRect& cull_rect = kMaxCullRect,
-                              bool prepare_rtree = false);
+  // If an |arena| is supplied, the op buffer for this builder and for
+  // the DisplayLists it builds is drawn from (and returned to) that arena.
+  explicit DisplayListBuilder(
+      const SkRect& cull_rect = kMaxCullRect,
+      bool prepare_rtree = false,
+      std::shared_ptr<DisplayListStorageArena> arena = nullptr);
 
   ~DisplayListBuilder();
 
@@ -244,7 +248,36 @@ class DisplayListBuilder final : public virtual DlCanvas,
   // |DlCanvas|
   void Flush() override {}
 
-  sk_sp<DisplayList> Build();
+  // If |compact_ops| is true, attribute ops which are overridden before
+  // any op reads them are dropped and runs of consecutive translate or
+  // scale ops are folded into a single op before the list is built. The
+  // number of records removed is reported by
+  // |DisplayList::compacted_op_count|.
+  sk_sp<DisplayList> Build(bool compact_ops = false);
+
+  // Supplies the DisplayList built for the same content on the previous
+  // frame. If this builder prepares an RTree, the next |Build| reuses the
+  // nodes of |previous|'s RTree that cover an unchanged prefix or suffix
+  // of its ops rather than recomputing them. The hint only applies to the
+  // next |Build| and has no effect on the resulting DisplayList other
+  // than the time taken to produce it.
+  void SetRTreeHint(sk_sp<const DisplayList> previous) {
+    rtree_hint_ = std::move(previous);
+  }
+
+  // If |defer| is true, the builder skips computing the bounds of each op
+  // as it is recorded and the DisplayLists it builds compute their bounds
+  // the first time |DisplayList::bounds| is called instead. This saves
+  // time on the recording thread for content whose bounds are never
+  // needed, but ops outside of the cull rect are then kept rather than
+  // dropped. Builders that prepare an RTree always compute bounds as they
+  // record since the RTree is indexed by op. Must be called before any
+  // ops are recorded and applies to every subsequent |Build|.
+  void SetDeferBounds(bool defer) {
+    FML_DCHECK(used_ == 0);
+    defer_bounds_ =
+        defer && accumulator_->type() != BoundsAccumulatorType::kRTree;
+  }
 
  private:
   // This method exposes the internal stateful DlOpReceiver implementation
@@ -260,6 +293,10 @@ class DisplayListBuilder final : public virtual DlCanvas,
   friend DlPaint DisplayListBuilderTestingAttributes(
       DisplayListBuilder& builder);
 
+  // DisplayLists with deferred bounds replay their ops into a builder
+  // to compute them.
+  friend class DisplayList;
+
   void SetAttributesFromPaint(const DlPaint& paint,
                               const DisplayListAttributeFlags flags);
 
@@ -485,6 +522,11 @@ class DisplayListBuilder final : public virtual DlCanvas,
 
   void checkForDeferredSave();
 
+  // The scale that Impeller rasterizes text at for the current transform.
+  SkScalar GetTextScale() const;
+
+  void CompactOps();
+
   DisplayListStorage storage_;
   size_t used_ = 0;
   size_t allocated_ = 0;
@@ -495,7 +537,14 @@ class DisplayListBuilder final : public virtual DlCanvas,
   size_t nested_bytes_ = 0;
   int nested_op_count_ = 0;
 
+  // records removed by |CompactOps|
+  int compacted_op_count_ = 0;
+
   bool is_ui_thread_safe_ = true;
+  bool has_images_ = false;
+
+  // text frames drawn directly or by nested DisplayLists
+  std::vector<DlTextFrameUsage> text_frames_;
 
   template <typename T, typename... Args>
   void* Push(size_t extra, int op_inc, Args&&... args);
@@ -610,6 +659,8 @@ class DisplayListBuilder final : public virtual DlCanvas,
   DisplayListMatrixClipTracker tracker_;
   std::unique_ptr<BoundsAccumulator> accumulator_;
   BoundsAccumulator* accumulator() { return accumulator_.get(); }
+  sk_sp<const DisplayList> rtree_hint_;
+  bool defer_bounds_ = false;
 
   // This flag indicates whether or not the current rendering attributes
   // are compatible with rendering ops applying an inherited opacity.
@@ -710,6 +761,11 @@ class DisplayListBuilder final : public virtual DlCanvas,
       FML_LOG(INFO) << "returning partial rtree for unbounded DisplayList";
     }
 
+    if (rtree_hint_ && rtree_hint_->rtree() &&
+        accumulator_->type() == BoundsAccumulatorType::kRTree) {
+      return static_cast<RTreeBoundsAccumulator*>(accumulator_.get())
+          ->rtree(rtree_hint_->rtree().get());
+    }
     return accumulator_->rtree();
   }
 
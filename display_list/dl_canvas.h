@@ -57,6 +57,14 @@ class DlCanvas {
   virtual SkISize GetBaseLayerSize() const = 0;
   virtual SkImageInfo GetImageInfo() const = 0;
 
+  /// Returns a copy of the pixels already drawn to the surface behind this
+  /// canvas within |device_bounds|, or nullptr if this canvas can not read
+  /// back its surface. Content drawn into save layers that are still open is
+  /// not part of the copy.
+  virtual sk_sp<DlImage> SnapshotSurface(const SkIRect& device_bounds) {
+    return nullptr;
+  }
+
   virtual void Save() = 0;
   virtual void SaveLayer(const SkRect* bounds,
                          const DlPaint* paint = nullptr,
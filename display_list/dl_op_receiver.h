@@ -21,6 +21,7 @@
 namespace flutter {
 
 class DisplayList;
+class DlBatchedGeometryReceiver;
 
 //------------------------------------------------------------------------------
 /// @brief      Internal API for rendering recorded display lists to backends.
@@ -49,6 +50,14 @@ class DlOpReceiver {
   // MaxDrawPointsCount * sizeof(SkPoint) must be less than 1 << 32
   static constexpr int kMaxDrawPointsCount = ((1 << 29) - 1);
 
+  // Returns this receiver as a |DlBatchedGeometryReceiver| if it can
+  // render a run of rects or rrects with a single call, or nullptr if
+  // it only supports the individual draw calls below.
+  // @see DlBatchingOpReceiver
+  virtual DlBatchedGeometryReceiver* asBatchedGeometryReceiver() {
+    return nullptr;
+  }
+
   // The following methods are nearly 1:1 with the methods on DlPaint and
   // carry the same meanings. Each method sets a persistent value for the
   // attribute for the rest of the display list or until it is reset by
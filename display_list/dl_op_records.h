@@ -80,6 +80,56 @@ enum class DisplayListCompare {
   kEqual,
 };
 
+// The ops whose records hold only plain numeric data, with no pointers or
+// references to other objects, so that two records of these types render
+// identically exactly when their bytes are identical.
+#define FOR_EACH_PLAIN_DATA_DISPLAY_LIST_OP(V) \
+  V(SetAntiAlias)                              \
+  V(SetInvertColors)                           \
+  V(SetStrokeCap)                              \
+  V(SetStrokeJoin)                             \
+  V(SetStyle)                                  \
+  V(SetStrokeWidth)                            \
+  V(SetStrokeMiter)                            \
+  V(SetColor)                                  \
+  V(SetBlendMode)                              \
+  V(ClearPathEffect)                           \
+  V(ClearColorFilter)                          \
+  V(ClearColorSource)                          \
+  V(ClearImageFilter)                          \
+  V(ClearMaskFilter)                           \
+                                               \
+  V(Save)                                      \
+  V(SaveLayer)                                 \
+  V(SaveLayerBounds)                           \
+  V(Restore)                                   \
+                                               \
+  V(Translate)                                 \
+  V(Scale)                                     \
+  V(Rotate)                                    \
+  V(Skew)                                      \
+  V(Transform2DAffine)                         \
+  V(TransformFullPerspective)                  \
+  V(TransformReset)                            \
+                                               \
+  V(ClipIntersectRect)                         \
+  V(ClipIntersectRRect)                        \
+  V(ClipDifferenceRect)                        \
+  V(ClipDifferenceRRect)                       \
+                                               \
+  V(DrawPaint)                                 \
+  V(DrawColor)                                 \
+  V(DrawLine)                                  \
+  V(DrawRect)                                  \
+  V(DrawOval)                                  \
+  V(DrawCircle)                                \
+  V(DrawRRect)                                 \
+  V(DrawDRRect)                                \
+  V(DrawArc)                                   \
+  V(DrawPoints)                                \
+  V(DrawLines)                                 \
+  V(DrawPolygon)
+
 // "DLOpPackLabel" is just a label for the pack pragma so it can be popped
 // later.
 #pragma pack(push, DLOpPackLabel, 8)
@@ -0,0 +1,244 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_serialization.h"
+
+#include <cstring>
+#include <vector>
+
+#include "flutter/display_list/dl_op_records.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+struct SerializedHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint8_t pointer_size;
+  uint8_t is_little_endian;
+  uint16_t flags;
+  uint32_t op_count;
+  uint64_t byte_count;
+  uint32_t rtree_leaf_count;
+  uint32_t ops_offset;
+  float bounds[4];
+};
+static_assert(sizeof(SerializedHeader) == 48);
+
+enum HeaderFlags : uint16_t {
+  kHasRTree = 1 << 0,
+  kCanApplyGroupOpacity = 1 << 1,
+  kModifiesTransparentBlack = 1 << 2,
+};
+
+}  // namespace
+
+static bool IsLittleEndian() {
+  const uint16_t value = 1;
+  uint8_t first_byte;
+  memcpy(&first_byte, &value, 1);
+  return first_byte == 1;
+}
+
+static size_t AlignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Returns the minimum record size of a serializable op type, or 0 if
+// records of the type can not be serialized. Only ops whose records hold
+// plain data can be written out and dispatched from a mapping in another
+// process.
+static size_t SerializableRecordSize(DisplayListOpType type) {
+  switch (type) {
+#define DL_OP_RECORD_SIZE(name)    \
+  case DisplayListOpType::k##name: \
+    return sizeof(name##Op);
+
+    FOR_EACH_PLAIN_DATA_DISPLAY_LIST_OP(DL_OP_RECORD_SIZE)
+
+#undef DL_OP_RECORD_SIZE
+    default:
+      return 0;
+  }
+}
+
+// Checks that the records between |ptr| and |end| are all serializable
+// and well formed, so that a corrupt or hostile file can not cause
+// Dispatch to read outside of the mapping. Every save must also be
+// balanced by a restore, as in the lists built by DisplayListBuilder,
+// since dispatching a restore pops the state pushed by its save.
+static bool ValidateOps(const uint8_t* ptr, const uint8_t* end) {
+  size_t save_depth = 0;
+  while (ptr < end) {
+    if (static_cast<size_t>(end - ptr) < sizeof(DLOp)) {
+      return false;
+    }
+    auto op = reinterpret_cast<const DLOp*>(ptr);
+    size_t min_size = SerializableRecordSize(op->type);
+    if (min_size == 0 || op->size < min_size ||
+        op->size > static_cast<size_t>(end - ptr) ||
+        (op->size & (alignof(void*) - 1)) != 0) {
+      return false;
+    }
+    switch (op->type) {
+      case DisplayListOpType::kSave:
+      case DisplayListOpType::kSaveLayer:
+      case DisplayListOpType::kSaveLayerBounds:
+        save_depth++;
+        break;
+      case DisplayListOpType::kRestore:
+        if (save_depth == 0) {
+          return false;
+        }
+        save_depth--;
+        break;
+      case DisplayListOpType::kDrawPoints:
+      case DisplayListOpType::kDrawLines:
+      case DisplayListOpType::kDrawPolygon: {
+        // Same layout for all three point modes.
+        auto points_op = static_cast<const DrawPointsOp*>(op);
+        if ((op->size - sizeof(DrawPointsOp)) / sizeof(SkPoint) <
+            points_op->count) {
+          return false;
+        }
+        break;
+      }
+      default:
+        break;
+    }
+    ptr += op->size;
+  }
+  return save_depth == 0;
+}
+
+bool DisplayListSerialization::CanSerialize(const DisplayList& display_list) {
+  const uint8_t* ptr = display_list.storage_.get();
+  const uint8_t* end = ptr + display_list.byte_count_;
+  while (ptr < end) {
+    auto op = reinterpret_cast<const DLOp*>(ptr);
+    if (SerializableRecordSize(op->type) == 0) {
+      return false;
+    }
+    ptr += op->size;
+  }
+  return true;
+}
+
+std::unique_ptr<fml::Mapping> DisplayListSerialization::Serialize(
+    const DisplayList& display_list) {
+  TRACE_EVENT0("flutter", "DisplayListSerialization::Serialize");
+  if (!CanSerialize(display_list)) {
+    return nullptr;
+  }
+
+  const DlRTree* rtree = display_list.rtree_.get();
+  uint32_t leaf_count = rtree ? rtree->leaf_count() : 0;
+  size_t rtree_offset = sizeof(SerializedHeader);
+  size_t ops_offset =
+      AlignUp(rtree_offset + leaf_count * (sizeof(SkRect) + sizeof(int32_t)),
+              kOpAlignment);
+  std::vector<uint8_t> data(ops_offset + display_list.byte_count_, 0);
+
+  SerializedHeader header = {};
+  header.magic = kMagic;
+  header.version = kVersion;
+  header.pointer_size = sizeof(void*);
+  header.is_little_endian = IsLittleEndian();
+  header.flags = (rtree ? kHasRTree : 0) |
+                 (display_list.can_apply_group_opacity_
+                      ? kCanApplyGroupOpacity
+                      : 0) |
+                 (display_list.modifies_transparent_black_
+                      ? kModifiesTransparentBlack
+                      : 0);
+  header.op_count = display_list.op_count_;
+  header.byte_count = display_list.byte_count_;
+  header.rtree_leaf_count = leaf_count;
+  header.ops_offset = ops_offset;
+  const SkRect& bounds = display_list.bounds();
+  header.bounds[0] = bounds.fLeft;
+  header.bounds[1] = bounds.fTop;
+  header.bounds[2] = bounds.fRight;
+  header.bounds[3] = bounds.fBottom;
+  memcpy(data.data(), &header, sizeof(header));
+
+  if (leaf_count > 0) {
+    auto rects = reinterpret_cast<SkRect*>(data.data() + rtree_offset);
+    auto ids = reinterpret_cast<int32_t*>(rects + leaf_count);
+    for (uint32_t i = 0; i < leaf_count; i++) {
+      rects[i] = rtree->bounds(i);
+      ids[i] = rtree->id(i);
+    }
+  }
+
+  memcpy(data.data() + ops_offset, display_list.storage_.get(),
+         display_list.byte_count_);
+  return std::make_unique<fml::DataMapping>(std::move(data));
+}
+
+sk_sp<DisplayList> DisplayListSerialization::Deserialize(
+    std::shared_ptr<const fml::Mapping> mapping) {
+  TRACE_EVENT0("flutter", "DisplayListSerialization::Deserialize");
+  if (!mapping || mapping->GetMapping() == nullptr ||
+      mapping->GetSize() < sizeof(SerializedHeader)) {
+    return nullptr;
+  }
+  const uint8_t* base = mapping->GetMapping();
+  if ((reinterpret_cast<uintptr_t>(base) & (kOpAlignment - 1)) != 0) {
+    FML_LOG(ERROR) << "Serialized DisplayList mapping is not aligned.";
+    return nullptr;
+  }
+
+  SerializedHeader header;
+  memcpy(&header, base, sizeof(header));
+  if (header.magic != kMagic || header.version != kVersion ||
+      header.pointer_size != sizeof(void*) ||
+      header.is_little_endian != IsLittleEndian()) {
+    FML_LOG(ERROR) << "Serialized DisplayList is not compatible with this "
+                      "version of the engine.";
+    return nullptr;
+  }
+  size_t leaf_count = header.rtree_leaf_count;
+  size_t rtree_bytes = leaf_count * (sizeof(SkRect) + sizeof(int32_t));
+  if (header.ops_offset < sizeof(SerializedHeader) + rtree_bytes ||
+      (header.ops_offset & (kOpAlignment - 1)) != 0 ||
+      header.ops_offset > mapping->GetSize() ||
+      header.byte_count > mapping->GetSize() - header.ops_offset) {
+    return nullptr;
+  }
+  const uint8_t* ops = base + header.ops_offset;
+  if (!ValidateOps(ops, ops + header.byte_count)) {
+    FML_LOG(ERROR) << "Serialized DisplayList contains invalid ops.";
+    return nullptr;
+  }
+
+  // The RTree is small compared to the ops and is rebuilt rather than
+  // mapped, the op records themselves are used in place.
+  sk_sp<DlRTree> rtree;
+  if (header.flags & kHasRTree) {
+    auto rects =
+        reinterpret_cast<const SkRect*>(base + sizeof(SerializedHeader));
+    auto ids = reinterpret_cast<const int32_t*>(rects + leaf_count);
+    rtree = sk_make_sp<DlRTree>(rects, leaf_count, ids);
+  }
+
+  SkRect bounds = SkRect::MakeLTRB(header.bounds[0], header.bounds[1],
+                                   header.bounds[2], header.bounds[3]);
+  size_t byte_count = header.byte_count;
+  DisplayListStorage storage(std::move(mapping), header.ops_offset,
+                             byte_count);
+  return sk_sp<DisplayList>(new DisplayList(
+      std::move(storage), byte_count, header.op_count,
+      /*nested_byte_count=*/0, /*nested_op_count=*/0,
+      /*compacted_op_count=*/0, /*content_hash=*/std::nullopt, bounds,
+      /*has_deferred_bounds=*/false,
+      (header.flags & kCanApplyGroupOpacity) != 0,
+      /*is_ui_thread_safe=*/true, /*has_images=*/false,
+      (header.flags & kModifiesTransparentBlack) != 0, std::move(rtree),
+      /*text_frames=*/{}));
+}
+
+}  // namespace flutter
@@ -0,0 +1,63 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_SERIALIZATION_H_
+#define FLUTTER_DISPLAY_LIST_DL_SERIALIZATION_H_
+
+#include <memory>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+// Converts a DisplayList to and from a versioned binary form that can be
+// written to disk and later loaded, typically through an
+// |fml::FileMapping|, and dispatched directly from the mapped bytes
+// without deserializing the individual ops.
+//
+// The op records are stored exactly as they are laid out in memory, so
+// only DisplayLists consisting entirely of position-independent records
+// (those holding no pointers to images, paths, text, vertices, shared
+// filters or other reference counted objects) can be serialized; see
+// |CanSerialize|. The format also encodes the pointer size and byte order
+// of the process that wrote it and files written by an incompatible
+// process, or by a different |kVersion|, are rejected at load time.
+//
+// The layout is:
+//   SerializedHeader
+//   SkRect[rtree_leaf_count]   (leaf rects of the RTree, if any)
+//   int32_t[rtree_leaf_count]  (op indices of the RTree leaves)
+//   padding to |kOpAlignment|
+//   op records                 (|byte_count| bytes)
+class DisplayListSerialization {
+ public:
+  static constexpr uint32_t kMagic = 0x53544c44;  // 'DLTS' little endian
+  static constexpr uint32_t kVersion = 1;
+  static constexpr size_t kOpAlignment = 16;
+
+  // Whether every op in the |display_list| can be serialized.
+  static bool CanSerialize(const DisplayList& display_list);
+
+  // Returns the serialized form of the |display_list| or nullptr if it
+  // contains ops that can not be serialized.
+  static std::unique_ptr<fml::Mapping> Serialize(
+      const DisplayList& display_list);
+
+  // Creates a DisplayList which dispatches directly from the bytes of the
+  // |mapping|, which it keeps alive. The mapping must start at an address
+  // aligned to |kOpAlignment| (as mmap'ed files and heap buffers do).
+  //
+  // Returns nullptr if the |mapping| is not a valid serialized DisplayList
+  // for this version of the format and process.
+  static sk_sp<DisplayList> Deserialize(
+      std::shared_ptr<const fml::Mapping> mapping);
+
+ private:
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(DisplayListSerialization);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_SERIALIZATION_H_
@@ -0,0 +1,204 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_serialization.h"
+
+#include <cstring>
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_op_records.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/fml/file.h"
+#include "flutter/testing/display_list_testing.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+
+DlOpReceiver& DisplayListBuilderTestingAccessor(DisplayListBuilder& builder);
+
+namespace testing {
+
+static sk_sp<DisplayList> MakeSerializableDisplayList(bool prepare_rtree) {
+  DisplayListBuilder builder(prepare_rtree);
+  DlPaint paint(DlColor::kRed());
+  builder.DrawRect({0, 0, 10, 10}, paint);
+  builder.Save();
+  builder.Translate(20, 20);
+  builder.ClipRRect(SkRRect::MakeRectXY({0, 0, 10, 10}, 2, 2),
+                    DlCanvas::ClipOp::kIntersect, true);
+  paint.setColor(DlColor::kBlue());
+  paint.setDrawStyle(DlDrawStyle::kStroke);
+  paint.setStrokeWidth(3);
+  builder.DrawCircle({5, 5}, 5, paint);
+  builder.Restore();
+  SkPoint points[] = {{40, 40}, {50, 50}, {40, 50}};
+  builder.DrawPoints(DlCanvas::PointMode::kPolygon, 3, points, paint);
+  return builder.Build();
+}
+
+// Changes the type of the first op of type |from| in the serialized bytes
+// of a display list to |to|, keeping the size of its record.
+static void RetypeSerializedOp(std::vector<uint8_t>& bytes,
+                               DisplayListOpType from,
+                               DisplayListOpType to) {
+  // The offset of the ops is stored 28 bytes into the header.
+  uint32_t ops_offset;
+  memcpy(&ops_offset, bytes.data() + 28, sizeof(ops_offset));
+  uint8_t* ptr = bytes.data() + ops_offset;
+  uint8_t* end = bytes.data() + bytes.size();
+  while (ptr < end) {
+    auto op = reinterpret_cast<DLOp*>(ptr);
+    if (op->type == from) {
+      op->type = to;
+      return;
+    }
+    ptr += op->size;
+  }
+  ADD_FAILURE() << "No op of the given type.";
+}
+
+TEST(DisplayListSerialization, RoundTripIsEqual) {
+  auto display_list = MakeSerializableDisplayList(false);
+  ASSERT_TRUE(DisplayListSerialization::CanSerialize(*display_list));
+  std::shared_ptr<fml::Mapping> serialized =
+      DisplayListSerialization::Serialize(*display_list);
+  ASSERT_NE(serialized, nullptr);
+
+  auto loaded = DisplayListSerialization::Deserialize(serialized);
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_TRUE(DisplayListsEQ_Verbose(loaded, display_list));
+  EXPECT_EQ(loaded->op_count(), display_list->op_count());
+  EXPECT_EQ(loaded->bounds(), display_list->bounds());
+  EXPECT_EQ(loaded->can_apply_group_opacity(),
+            display_list->can_apply_group_opacity());
+  EXPECT_FALSE(loaded->has_rtree());
+}
+
+TEST(DisplayListSerialization, DispatchesWithoutCopyingOps) {
+  auto display_list = MakeSerializableDisplayList(false);
+  std::shared_ptr<fml::Mapping> serialized =
+      DisplayListSerialization::Serialize(*display_list);
+  auto loaded = DisplayListSerialization::Deserialize(serialized);
+  ASSERT_NE(loaded, nullptr);
+  // The loaded list keeps the mapping alive and reads from it directly.
+  EXPECT_GT(serialized.use_count(), 1);
+
+  DisplayListBuilder builder;
+  loaded->Dispatch(DisplayListBuilderTestingAccessor(builder));
+  EXPECT_TRUE(DisplayListsEQ_Verbose(builder.Build(), display_list));
+}
+
+TEST(DisplayListSerialization, RTreeCullingSurvivesRoundTrip) {
+  auto display_list = MakeSerializableDisplayList(true);
+  auto loaded = DisplayListSerialization::Deserialize(
+      DisplayListSerialization::Serialize(*display_list));
+  ASSERT_NE(loaded, nullptr);
+  ASSERT_TRUE(loaded->has_rtree());
+
+  SkRect cull_rect = SkRect::MakeLTRB(0, 0, 10, 10);
+  DisplayListBuilder expected_builder;
+  display_list->Dispatch(DisplayListBuilderTestingAccessor(expected_builder),
+                         cull_rect);
+  DisplayListBuilder loaded_builder;
+  loaded->Dispatch(DisplayListBuilderTestingAccessor(loaded_builder),
+                   cull_rect);
+  EXPECT_TRUE(
+      DisplayListsEQ_Verbose(loaded_builder.Build(), expected_builder.Build()));
+}
+
+TEST(DisplayListSerialization, RejectsNonPositionIndependentOps) {
+  DisplayListBuilder builder;
+  builder.DrawPath(kTestPath1, DlPaint());
+  auto display_list = builder.Build();
+  EXPECT_FALSE(DisplayListSerialization::CanSerialize(*display_list));
+  EXPECT_EQ(DisplayListSerialization::Serialize(*display_list), nullptr);
+}
+
+TEST(DisplayListSerialization, RejectsCorruptData) {
+  auto display_list = MakeSerializableDisplayList(false);
+  auto serialized = DisplayListSerialization::Serialize(*display_list);
+  ASSERT_NE(serialized, nullptr);
+  std::vector<uint8_t> bytes(serialized->GetMapping(),
+                             serialized->GetMapping() + serialized->GetSize());
+
+  {  // Bad magic
+    auto copy = bytes;
+    copy[0] ^= 0xff;
+    EXPECT_EQ(DisplayListSerialization::Deserialize(
+                  std::make_shared<fml::DataMapping>(std::move(copy))),
+              nullptr);
+  }
+  {  // Bad version
+    auto copy = bytes;
+    copy[4] ^= 0xff;
+    EXPECT_EQ(DisplayListSerialization::Deserialize(
+                  std::make_shared<fml::DataMapping>(std::move(copy))),
+              nullptr);
+  }
+  {  // Truncated ops
+    auto copy = bytes;
+    copy.resize(copy.size() - 8);
+    EXPECT_EQ(DisplayListSerialization::Deserialize(
+                  std::make_shared<fml::DataMapping>(std::move(copy))),
+              nullptr);
+  }
+  {  // Too short for a header
+    std::vector<uint8_t> copy(bytes.begin(), bytes.begin() + 8);
+    EXPECT_EQ(DisplayListSerialization::Deserialize(
+                  std::make_shared<fml::DataMapping>(std::move(copy))),
+              nullptr);
+  }
+}
+
+TEST(DisplayListSerialization, RejectsRestoreWithoutSave) {
+  auto display_list = MakeSerializableDisplayList(false);
+  auto serialized = DisplayListSerialization::Serialize(*display_list);
+  ASSERT_NE(serialized, nullptr);
+  std::vector<uint8_t> bytes(serialized->GetMapping(),
+                             serialized->GetMapping() + serialized->GetSize());
+
+  // The save becomes a restore at a depth of 0.
+  RetypeSerializedOp(bytes, DisplayListOpType::kSave,
+                     DisplayListOpType::kRestore);
+  EXPECT_EQ(DisplayListSerialization::Deserialize(
+                std::make_shared<fml::DataMapping>(std::move(bytes))),
+            nullptr);
+}
+
+TEST(DisplayListSerialization, RejectsUnbalancedSave) {
+  auto display_list = MakeSerializableDisplayList(false);
+  auto serialized = DisplayListSerialization::Serialize(*display_list);
+  ASSERT_NE(serialized, nullptr);
+  std::vector<uint8_t> bytes(serialized->GetMapping(),
+                             serialized->GetMapping() + serialized->GetSize());
+
+  // The restore becomes an op of the same size that leaves the save open.
+  RetypeSerializedOp(bytes, DisplayListOpType::kRestore,
+                     DisplayListOpType::kClearColorFilter);
+  EXPECT_EQ(DisplayListSerialization::Deserialize(
+                std::make_shared<fml::DataMapping>(std::move(bytes))),
+            nullptr);
+}
+
+TEST(DisplayListSerialization, LoadsFromFileMapping) {
+  auto display_list = MakeSerializableDisplayList(true);
+  auto serialized = DisplayListSerialization::Serialize(*display_list);
+  ASSERT_NE(serialized, nullptr);
+
+  fml::ScopedTemporaryDirectory temp_dir;
+  ASSERT_TRUE(fml::WriteAtomically(temp_dir.fd(), "picture.dlt", *serialized));
+  std::shared_ptr<fml::Mapping> mapping =
+      fml::FileMapping::CreateReadOnly(temp_dir.fd(), "picture.dlt");
+  ASSERT_NE(mapping, nullptr);
+
+  auto loaded = DisplayListSerialization::Deserialize(mapping);
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_TRUE(DisplayListsEQ_Verbose(loaded, display_list));
+  loaded = nullptr;
+  EXPECT_EQ(mapping.use_count(), 1);
+}
+
+}  // namespace testing
+}  // namespace flutter
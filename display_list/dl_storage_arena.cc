@@ -0,0 +1,120 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_storage_arena.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+// The free lists never grow beyond the capacity reserved up front so that
+// returning a slab never allocates.
+static constexpr size_t kMaxSlabsPerSizeClass = 64;
+
+std::shared_ptr<DisplayListStorageArena> DisplayListStorageArena::Create(
+    size_t max_retained_bytes) {
+  return std::shared_ptr<DisplayListStorageArena>(
+      new DisplayListStorageArena(max_retained_bytes));
+}
+
+DisplayListStorageArena::DisplayListStorageArena(size_t max_retained_bytes)
+    : max_retained_bytes_(max_retained_bytes) {
+  size_t slab_size = kMinSlabSize;
+  for (auto& free_list : free_lists_) {
+    free_list.reserve(std::min(kMaxSlabsPerSizeClass,
+                               std::max<size_t>(1, max_retained_bytes_ /
+                                                       slab_size)));
+    slab_size <<= 1;
+  }
+}
+
+DisplayListStorageArena::~DisplayListStorageArena() {
+  Purge();
+}
+
+size_t DisplayListStorageArena::SlabSizeFor(size_t size) {
+  if (size > kMaxSlabSize) {
+    // Oversized buffers are rounded to the builder page size and bypass
+    // the free lists entirely.
+    return (size + kMinSlabSize - 1) & ~(kMinSlabSize - 1);
+  }
+  size_t slab_size = kMinSlabSize;
+  while (slab_size < size) {
+    slab_size <<= 1;
+  }
+  return slab_size;
+}
+
+size_t DisplayListStorageArena::SizeClassIndex(size_t slab_size) {
+  FML_DCHECK(slab_size >= kMinSlabSize && slab_size <= kMaxSlabSize);
+  size_t index = 0;
+  while ((kMinSlabSize << index) < slab_size) {
+    index++;
+  }
+  return index;
+}
+
+uint8_t* DisplayListStorageArena::Acquire(size_t size) {
+  size_t slab_size = SlabSizeFor(size);
+  if (slab_size <= kMaxSlabSize) {
+    std::scoped_lock lock(mutex_);
+    auto& free_list = free_lists_[SizeClassIndex(slab_size)];
+    if (!free_list.empty()) {
+      uint8_t* slab = free_list.back();
+      free_list.pop_back();
+      stats_.retained_bytes -= slab_size;
+      stats_.reused_slabs++;
+      return slab;
+    }
+    stats_.heap_allocations++;
+  } else {
+    std::scoped_lock lock(mutex_);
+    stats_.heap_allocations++;
+  }
+  auto slab = static_cast<uint8_t*>(std::malloc(slab_size));
+  FML_CHECK(slab);
+  return slab;
+}
+
+void DisplayListStorageArena::Release(uint8_t* slab, size_t slab_size) {
+  if (!slab) {
+    return;
+  }
+  {
+    std::scoped_lock lock(mutex_);
+    if (slab_size <= kMaxSlabSize &&
+        stats_.retained_bytes + slab_size <= max_retained_bytes_) {
+      auto& free_list = free_lists_[SizeClassIndex(slab_size)];
+      if (free_list.size() < free_list.capacity()) {
+        free_list.push_back(slab);
+        stats_.retained_bytes += slab_size;
+        return;
+      }
+    }
+    stats_.heap_frees++;
+  }
+  std::free(slab);
+}
+
+void DisplayListStorageArena::Purge() {
+  std::scoped_lock lock(mutex_);
+  for (auto& free_list : free_lists_) {
+    for (uint8_t* slab : free_list) {
+      std::free(slab);
+      stats_.heap_frees++;
+    }
+    free_list.clear();
+  }
+  stats_.retained_bytes = 0;
+}
+
+DisplayListStorageArena::Stats DisplayListStorageArena::GetStats() const {
+  std::scoped_lock lock(mutex_);
+  return stats_;
+}
+
+}  // namespace flutter
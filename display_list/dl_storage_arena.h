@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_STORAGE_ARENA_H_
+#define FLUTTER_DISPLAY_LIST_DL_STORAGE_ARENA_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+// A pool of power-of-two sized slabs that |DisplayListStorage| can draw
+// from instead of going to the heap for every |DisplayListBuilder|.
+//
+// A builder that is handed an arena acquires its op buffer from the arena
+// and grows it by moving to the next size class. The buffer travels with
+// the |DisplayList| produced by |DisplayListBuilder::Build()| and is
+// returned to the arena's free list when that |DisplayList| is destroyed,
+// so that steady-state frames which record similarly sized pictures never
+// call into malloc or free.
+//
+// DisplayLists are frequently released on a different thread than the one
+// that built them (e.g. the raster thread), so the free lists are guarded
+// by a mutex. The arena is kept alive by every storage buffer that came
+// from it.
+class DisplayListStorageArena
+    : public std::enable_shared_from_this<DisplayListStorageArena> {
+ public:
+  // The smallest slab handed out, matches the page size used by the
+  // |DisplayListBuilder| when it grows its buffer.
+  static constexpr size_t kMinSlabSize = 4096;
+
+  // Buffers larger than this are allocated (and freed) directly on the
+  // heap and never retained by the arena.
+  static constexpr size_t kMaxSlabSize = 4 * 1024 * 1024;
+
+  // The default cap on the number of bytes kept on the free lists.
+  static constexpr size_t kDefaultMaxRetainedBytes = 8 * 1024 * 1024;
+
+  static std::shared_ptr<DisplayListStorageArena> Create(
+      size_t max_retained_bytes = kDefaultMaxRetainedBytes);
+
+  ~DisplayListStorageArena();
+
+  // Statistics, primarily for tests and benchmarks.
+  struct Stats {
+    // Number of slabs obtained from the heap.
+    size_t heap_allocations = 0;
+    // Number of slabs returned to the heap (over the retain limit or
+    // larger than |kMaxSlabSize|).
+    size_t heap_frees = 0;
+    // Number of acquisitions satisfied from a free list.
+    size_t reused_slabs = 0;
+    // Bytes currently sitting on the free lists.
+    size_t retained_bytes = 0;
+  };
+  Stats GetStats() const;
+
+  // Returns all retained slabs to the heap.
+  void Purge();
+
+  // Returns the size of the slab that would be handed out for a request
+  // of |size| bytes.
+  static size_t SlabSizeFor(size_t size);
+
+ private:
+  explicit DisplayListStorageArena(size_t max_retained_bytes);
+
+  // Returns a slab of exactly |SlabSizeFor(size)| bytes.
+  uint8_t* Acquire(size_t size);
+
+  // Returns a slab previously obtained from |Acquire| with the given
+  // |slab_size| to the free list (or the heap).
+  void Release(uint8_t* slab, size_t slab_size);
+
+  static size_t SizeClassIndex(size_t slab_size);
+
+  // Log2(kMaxSlabSize / kMinSlabSize) + 1 size classes.
+  static constexpr size_t kSizeClassCount = 11;
+  static_assert((kMinSlabSize << (kSizeClassCount - 1)) == kMaxSlabSize);
+
+  const size_t max_retained_bytes_;
+
+  mutable std::mutex mutex_;
+  std::array<std::vector<uint8_t*>, kSizeClassCount> free_lists_;
+  Stats stats_;
+
+  friend class DisplayListStorage;
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(DisplayListStorageArena);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_STORAGE_ARENA_H_
@@ -0,0 +1,112 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_storage_arena.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_paint.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(DisplayListStorageArena, SlabSizesArePowersOfTwo) {
+  EXPECT_EQ(DisplayListStorageArena::SlabSizeFor(0), 4096u);
+  EXPECT_EQ(DisplayListStorageArena::SlabSizeFor(1), 4096u);
+  EXPECT_EQ(DisplayListStorageArena::SlabSizeFor(4096), 4096u);
+  EXPECT_EQ(DisplayListStorageArena::SlabSizeFor(4097), 8192u);
+  EXPECT_EQ(DisplayListStorageArena::SlabSizeFor(100000), 131072u);
+  // Oversized requests are only rounded to the page size.
+  size_t huge = DisplayListStorageArena::kMaxSlabSize + 1;
+  EXPECT_EQ(DisplayListStorageArena::SlabSizeFor(huge),
+            DisplayListStorageArena::kMaxSlabSize + 4096u);
+}
+
+TEST(DisplayListStorageArena, StorageGrowsAndPreservesContents) {
+  auto arena = DisplayListStorageArena::Create();
+  DisplayListStorage storage(arena);
+  storage.realloc(16);
+  ASSERT_NE(storage.get(), nullptr);
+  EXPECT_EQ(storage.capacity(), 4096u);
+  for (int i = 0; i < 16; i++) {
+    storage.get()[i] = static_cast<uint8_t>(i);
+  }
+  storage.realloc(10000);
+  EXPECT_EQ(storage.capacity(), 16384u);
+  for (int i = 0; i < 16; i++) {
+    EXPECT_EQ(storage.get()[i], static_cast<uint8_t>(i));
+  }
+  // The slab that was outgrown went back to the arena.
+  EXPECT_EQ(arena->GetStats().retained_bytes, 4096u);
+  // Shrinking is a no-op for arena storage.
+  storage.realloc(100);
+  EXPECT_EQ(storage.capacity(), 16384u);
+}
+
+TEST(DisplayListStorageArena, RetiredDisplayListsRecycleSlabs) {
+  auto arena = DisplayListStorageArena::Create();
+  auto build = [&arena]() {
+    DisplayListBuilder builder(DisplayListBuilder::kMaxCullRect, false, arena);
+    for (int i = 0; i < 10; i++) {
+      builder.DrawRect(SkRect::MakeXYWH(i, i, 10, 10), DlPaint());
+    }
+    return builder.Build();
+  };
+
+  auto display_list = build();
+  EXPECT_EQ(display_list->op_count(), 10u);
+  EXPECT_EQ(arena->GetStats().heap_allocations, 1u);
+  display_list = nullptr;
+  EXPECT_EQ(arena->GetStats().retained_bytes, 4096u);
+
+  for (int frame = 0; frame < 10; frame++) {
+    display_list = build();
+    EXPECT_EQ(display_list->op_count(), 10u);
+    display_list = nullptr;
+  }
+  auto stats = arena->GetStats();
+  EXPECT_EQ(stats.heap_allocations, 1u);
+  EXPECT_EQ(stats.heap_frees, 0u);
+  EXPECT_EQ(stats.reused_slabs, 10u);
+}
+
+TEST(DisplayListStorageArena, BuiltListsMatchHeapBuiltLists) {
+  auto arena = DisplayListStorageArena::Create();
+  auto build = [](DisplayListBuilder& builder) {
+    builder.Translate(5, 5);
+    builder.DrawCircle({10, 10}, 5, DlPaint(DlColor::kBlue()));
+    builder.DrawRect({0, 0, 20, 20}, DlPaint(DlColor::kRed()));
+    return builder.Build();
+  };
+  DisplayListBuilder arena_builder(DisplayListBuilder::kMaxCullRect, false,
+                                   arena);
+  DisplayListBuilder heap_builder;
+  auto arena_list = build(arena_builder);
+  auto heap_list = build(heap_builder);
+  EXPECT_TRUE(arena_list->Equals(heap_list));
+
+  // The builder stays attached to the arena after Build().
+  auto second_list = build(arena_builder);
+  EXPECT_TRUE(second_list->Equals(heap_list));
+  EXPECT_EQ(arena->GetStats().heap_allocations, 2u);
+}
+
+TEST(DisplayListStorageArena, RetainLimitIsRespected) {
+  auto arena = DisplayListStorageArena::Create(8192);
+  {
+    DisplayListStorage a(arena);
+    DisplayListStorage b(arena);
+    DisplayListStorage c(arena);
+    a.realloc(1);
+    b.realloc(1);
+    c.realloc(1);
+  }
+  auto stats = arena->GetStats();
+  EXPECT_EQ(stats.retained_bytes, 8192u);
+  EXPECT_EQ(stats.heap_frees, 1u);
+  arena->Purge();
+  EXPECT_EQ(arena->GetStats().retained_bytes, 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,6 +4,7 @@
 
 #include "flutter/display_list/geometry/dl_region.h"
 
+#include "flutter/display_list/geometry/dl_region_simd.h"
 #include "flutter/fml/logging.h"
 
 namespace flutter {
@@ -12,6 +13,10 @@ namespace flutter {
 // search.
 const int kBinarySearchThreshold = 10;
 
+// The vectorized helpers in dl_region_simd.h operate on raw int32_t
+// arrays with these layouts.
+static_assert(sizeof(SkIRect) == 4 * sizeof(int32_t));
+
 DlRegion::SpanBuffer::SpanBuffer(DlRegion::SpanBuffer&& m)
     : capacity_(m.capacity_), size_(m.size_), spans_(m.spans_) {
   m.size_ = 0;
@@ -256,7 +261,12 @@ void DlRegion::setRects(const std::vector<SkIRect>& unsorted_rects) {
   std::vector<const SkIRect*> rects(count);
   for (size_t i = 0; i < count; i++) {
     rects[i] = &unsorted_rects[i];
-    bounds_.join(unsorted_rects[i]);
+  }
+  int32_t bounds[4];
+  if (dl_region_simd::ComputeBounds(
+          reinterpret_cast<const int32_t*>(unsorted_rects.data()), count,
+          bounds)) {
+    bounds_.join(SkIRect::MakeLTRB(bounds[0], bounds[1], bounds[2], bounds[3]));
   }
   std::sort(rects.begin(), rects.end(), [](const SkIRect* a, const SkIRect* b) {
     if (a->top() < b->top()) {
@@ -646,11 +656,11 @@ bool DlRegion::intersects(const SkIRect& rect) const {
     FML_DCHECK(rect.fTop < it->bottom && it->top < rect.fBottom);
     const Span *begin, *end;
     span_buffer_.getSpans(it->chunk_handle, begin, end);
-    while (begin != end && begin->left < rect.fRight) {
-      if (begin->right > rect.fLeft) {
-        return true;
-      }
-      ++begin;
+    static_assert(sizeof(Span) == 2 * sizeof(int32_t));
+    if (dl_region_simd::SpansIntersectRange(
+            reinterpret_cast<const int32_t*>(begin), end - begin, rect.fLeft,
+            rect.fRight)) {
+      return true;
     }
     ++it;
   }
@@ -0,0 +1,218 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/geometry/dl_region_simd.h"
+
+#include <algorithm>
+#include <limits>
+
+#if DL_REGION_SIMD_NEON
+#include <arm_neon.h>
+#elif DL_REGION_SIMD_SSE4_1
+#include <smmintrin.h>
+#elif DL_REGION_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace flutter {
+namespace dl_region_simd {
+
+const char* ImplementationName() {
+#if DL_REGION_SIMD_NEON
+  return "neon";
+#elif DL_REGION_SIMD_SSE4_1
+  return "sse4.1";
+#elif DL_REGION_SIMD_SSE2
+  return "sse2";
+#else
+  return "scalar";
+#endif
+}
+
+bool ComputeBoundsScalar(const int32_t* ltrb, size_t count, int32_t bounds[4]) {
+  int32_t left = std::numeric_limits<int32_t>::max();
+  int32_t top = std::numeric_limits<int32_t>::max();
+  int32_t right = std::numeric_limits<int32_t>::min();
+  int32_t bottom = std::numeric_limits<int32_t>::min();
+  bool any = false;
+  for (size_t i = 0; i < count; i++, ltrb += 4) {
+    if (ltrb[0] >= ltrb[2] || ltrb[1] >= ltrb[3]) {
+      continue;
+    }
+    any = true;
+    left = std::min(left, ltrb[0]);
+    top = std::min(top, ltrb[1]);
+    right = std::max(right, ltrb[2]);
+    bottom = std::max(bottom, ltrb[3]);
+  }
+  if (any) {
+    bounds[0] = left;
+    bounds[1] = top;
+    bounds[2] = right;
+    bounds[3] = bottom;
+  }
+  return any;
+}
+
+bool SpansIntersectRangeScalar(const int32_t* spans,
+                               size_t count,
+                               int32_t left,
+                               int32_t right) {
+  for (size_t i = 0; i < count; i++, spans += 2) {
+    if (spans[0] >= right) {
+      // Spans are sorted, none of the remaining ones can intersect.
+      return false;
+    }
+    if (spans[1] > left) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// The vector versions of ComputeBounds process one rect per iteration.
+// Right and bottom are negated so that a single packed minimum tracks
+// all four edges, and empty rects are replaced by a vector of INT_MAX
+// so that they never win the minimum.
+
+#if DL_REGION_SIMD_SSE4_1 || DL_REGION_SIMD_SSE2
+
+static inline __m128i Min32(__m128i a, __m128i b) {
+#if DL_REGION_SIMD_SSE4_1
+  return _mm_min_epi32(a, b);
+#else
+  __m128i a_greater = _mm_cmpgt_epi32(a, b);
+  return _mm_or_si128(_mm_and_si128(a_greater, b),
+                      _mm_andnot_si128(a_greater, a));
+#endif
+}
+
+bool ComputeBounds(const int32_t* ltrb, size_t count, int32_t bounds[4]) {
+  const __m128i kMax = _mm_set1_epi32(std::numeric_limits<int32_t>::max());
+  // (x ^ m) - m negates the lanes where m is all ones.
+  const __m128i kNegateRB = _mm_setr_epi32(0, 0, -1, -1);
+  __m128i acc = kMax;
+  for (size_t i = 0; i < count; i++, ltrb += 4) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ltrb));
+    // (R, B, L, T)
+    __m128i swapped = _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+    // lane 0: L < R, lane 1: T < B
+    __m128i lt = _mm_cmplt_epi32(v, swapped);
+    __m128i non_empty =
+        _mm_and_si128(_mm_shuffle_epi32(lt, _MM_SHUFFLE(0, 0, 0, 0)),
+                      _mm_shuffle_epi32(lt, _MM_SHUFFLE(1, 1, 1, 1)));
+    __m128i edges = _mm_sub_epi32(_mm_xor_si128(v, kNegateRB), kNegateRB);
+    __m128i candidate = _mm_or_si128(_mm_and_si128(non_empty, edges),
+                                     _mm_andnot_si128(non_empty, kMax));
+    acc = Min32(acc, candidate);
+  }
+  alignas(16) int32_t result[4];
+  _mm_store_si128(reinterpret_cast<__m128i*>(result), acc);
+  if (result[0] == std::numeric_limits<int32_t>::max()) {
+    return false;
+  }
+  bounds[0] = result[0];
+  bounds[1] = result[1];
+  bounds[2] = -result[2];
+  bounds[3] = -result[3];
+  return true;
+}
+
+bool SpansIntersectRange(const int32_t* spans,
+                         size_t count,
+                         int32_t left,
+                         int32_t right) {
+  // Two spans (l0, r0, l1, r1) per iteration compared against
+  // (right, left, right, left).
+  const __m128i limits = _mm_setr_epi32(right, left, right, left);
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2, spans += 4) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(spans));
+    // lanes 0 and 2: span.left < right
+    __m128i starts_before = _mm_cmplt_epi32(v, limits);
+    // lanes 1 and 3: span.right > left, shifted down into lanes 0 and 2
+    __m128i ends_after = _mm_srli_si128(_mm_cmpgt_epi32(v, limits), 4);
+    __m128i hit = _mm_and_si128(starts_before, ends_after);
+    if (_mm_movemask_epi8(hit) & 0x0f0f) {
+      return true;
+    }
+    if (spans[2] >= right) {
+      return false;
+    }
+  }
+  return SpansIntersectRangeScalar(spans, count - i, left, right);
+}
+
+#elif DL_REGION_SIMD_NEON
+
+bool ComputeBounds(const int32_t* ltrb, size_t count, int32_t bounds[4]) {
+  const int32x4_t kMax = vdupq_n_s32(std::numeric_limits<int32_t>::max());
+  int32x4_t acc = kMax;
+  for (size_t i = 0; i < count; i++, ltrb += 4) {
+    int32x4_t v = vld1q_s32(ltrb);
+    int32x2_t lt = vget_low_s32(v);
+    int32x2_t rb = vget_high_s32(v);
+    // lane 0: L < R, lane 1: T < B
+    uint32x2_t less = vclt_s32(lt, rb);
+    uint32x2_t both = vand_u32(less, vrev64_u32(less));
+    uint32x4_t non_empty = vcombine_u32(both, both);
+    int32x4_t edges = vcombine_s32(lt, vneg_s32(rb));
+    acc = vminq_s32(acc, vbslq_s32(non_empty, edges, kMax));
+  }
+  int32_t result[4];
+  vst1q_s32(result, acc);
+  if (result[0] == std::numeric_limits<int32_t>::max()) {
+    return false;
+  }
+  bounds[0] = result[0];
+  bounds[1] = result[1];
+  bounds[2] = -result[2];
+  bounds[3] = -result[3];
+  return true;
+}
+
+bool SpansIntersectRange(const int32_t* spans,
+                         size_t count,
+                         int32_t left,
+                         int32_t right) {
+  // Two spans (l0, r0, l1, r1) per iteration compared against
+  // (right, left, right, left).
+  const int32_t limit_values[4] = {right, left, right, left};
+  const int32x4_t limits = vld1q_s32(limit_values);
+  const uint32x4_t zero = vdupq_n_u32(0);
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2, spans += 4) {
+    int32x4_t v = vld1q_s32(spans);
+    // lanes 0 and 2: span.left < right
+    uint32x4_t starts_before = vcltq_s32(v, limits);
+    // lanes 1 and 3: span.right > left, shifted down into lanes 0 and 2
+    uint32x4_t ends_after = vextq_u32(vcgtq_s32(v, limits), zero, 1);
+    uint32x4_t hit = vandq_u32(starts_before, ends_after);
+    if (vgetq_lane_u32(hit, 0) | vgetq_lane_u32(hit, 2)) {
+      return true;
+    }
+    if (spans[2] >= right) {
+      return false;
+    }
+  }
+  return SpansIntersectRangeScalar(spans, count - i, left, right);
+}
+
+#else
+
+bool ComputeBounds(const int32_t* ltrb, size_t count, int32_t bounds[4]) {
+  return ComputeBoundsScalar(ltrb, count, bounds);
+}
+
+bool SpansIntersectRange(const int32_t* spans,
+                         size_t count,
+                         int32_t left,
+                         int32_t right) {
+  return SpansIntersectRangeScalar(spans, count, left, right);
+}
+
+#endif
+
+}  // namespace dl_region_simd
+}  // namespace flutter
@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_GEOMETRY_DL_REGION_SIMD_H_
+#define FLUTTER_DISPLAY_LIST_GEOMETRY_DL_REGION_SIMD_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// Selects the vector instruction set used for the |DlRegion| span and
+// bounds routines. NEON is always used where it is available, on x86 the
+// SSE4.1 variant is used when the compiler targets it and the (baseline)
+// SSE2 variant otherwise. Defining DL_REGION_DISABLE_SIMD forces the
+// scalar implementations.
+#if !defined(DL_REGION_DISABLE_SIMD)
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define DL_REGION_SIMD_NEON 1
+#elif defined(__SSE4_1__)
+#define DL_REGION_SIMD_SSE4_1 1
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DL_REGION_SIMD_SSE2 1
+#endif
+#endif  // !defined(DL_REGION_DISABLE_SIMD)
+
+namespace flutter {
+namespace dl_region_simd {
+
+/// The name of the vector implementation in use: "neon", "sse4.1",
+/// "sse2" or "scalar".
+const char* ImplementationName();
+
+/// Computes the bounds of the |count| rectangles stored in |ltrb| as
+/// consecutive (left, top, right, bottom) quadruples, ignoring empty
+/// rectangles in the same way as SkIRect::join. The result is written to
+/// |bounds| (in the same layout) and false is returned if every rectangle
+/// was empty, in which case |bounds| is left untouched.
+bool ComputeBounds(const int32_t* ltrb, size_t count, int32_t bounds[4]);
+
+/// The scalar implementation of |ComputeBounds|, always available.
+bool ComputeBoundsScalar(const int32_t* ltrb, size_t count, int32_t bounds[4]);
+
+/// Returns whether any of the |count| spans stored in |spans| as
+/// consecutive (left, right) pairs overlaps the horizontal range
+/// [left, right). The spans must be sorted and non-overlapping, as they
+/// are in a |DlRegion| span line.
+bool SpansIntersectRange(const int32_t* spans,
+                         size_t count,
+                         int32_t left,
+                         int32_t right);
+
+/// The scalar implementation of |SpansIntersectRange|, always available.
+bool SpansIntersectRangeScalar(const int32_t* spans,
+                               size_t count,
+                               int32_t left,
+                               int32_t right);
+
+}  // namespace dl_region_simd
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_GEOMETRY_DL_REGION_SIMD_H_
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "flutter/display_list/geometry/dl_region.h"
+#include "flutter/display_list/geometry/dl_region_simd.h"
 #include "gtest/gtest.h"
 
 #include "third_party/skia/include/core/SkRegion.h"
@@ -429,5 +430,82 @@ TEST(DisplayListRegion, TestAgainstSkRegion) {
   }
 }
 
+TEST(DisplayListRegion, SimdBoundsMatchScalar) {
+  std::seed_seq seed{::testing::UnitTest::GetInstance()->random_seed()};
+  std::mt19937 rng(seed);
+  // Small coordinate range so that empty and inverted rects are common.
+  std::uniform_int_distribution coord(-50, 50);
+  std::uniform_int_distribution count(0, 17);
+
+  for (int i = 0; i < 1000; ++i) {
+    std::vector<SkIRect> rects(count(rng));
+    for (auto& rect : rects) {
+      rect.setLTRB(coord(rng), coord(rng), coord(rng), coord(rng));
+    }
+    auto ltrb = reinterpret_cast<const int32_t*>(rects.data());
+    int32_t simd_bounds[4] = {};
+    int32_t scalar_bounds[4] = {};
+    bool simd_result =
+        dl_region_simd::ComputeBounds(ltrb, rects.size(), simd_bounds);
+    bool scalar_result =
+        dl_region_simd::ComputeBoundsScalar(ltrb, rects.size(), scalar_bounds);
+    ASSERT_EQ(simd_result, scalar_result);
+
+    SkIRect expected = SkIRect::MakeEmpty();
+    for (const auto& rect : rects) {
+      expected.join(rect);
+    }
+    EXPECT_EQ(scalar_result, !expected.isEmpty());
+    if (scalar_result) {
+      EXPECT_EQ(SkIRect::MakeLTRB(simd_bounds[0], simd_bounds[1],
+                                  simd_bounds[2], simd_bounds[3]),
+                expected)
+          << dl_region_simd::ImplementationName();
+      EXPECT_EQ(SkIRect::MakeLTRB(scalar_bounds[0], scalar_bounds[1],
+                                  scalar_bounds[2], scalar_bounds[3]),
+                expected);
+    }
+  }
+}
+
+TEST(DisplayListRegion, SimdSpansIntersectMatchScalar) {
+  std::seed_seq seed{::testing::UnitTest::GetInstance()->random_seed()};
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution gap(0, 20);
+  std::uniform_int_distribution width(1, 20);
+  std::uniform_int_distribution count(0, 13);
+  std::uniform_int_distribution pos(-20, 300);
+
+  for (int i = 0; i < 1000; ++i) {
+    // Sorted, non-overlapping spans as stored in a span line.
+    std::vector<int32_t> spans;
+    int32_t x = 0;
+    for (int j = count(rng); j > 0; --j) {
+      x += gap(rng);
+      spans.push_back(x);
+      x += width(rng);
+      spans.push_back(x);
+    }
+    size_t span_count = spans.size() / 2;
+    for (int j = 0; j < 10; ++j) {
+      int32_t left = pos(rng);
+      int32_t right = left + width(rng);
+      bool expected = false;
+      for (size_t k = 0; k < span_count; ++k) {
+        if (spans[k * 2] < right && spans[k * 2 + 1] > left) {
+          expected = true;
+        }
+      }
+      EXPECT_EQ(dl_region_simd::SpansIntersectRangeScalar(
+                    spans.data(), span_count, left, right),
+                expected);
+      EXPECT_EQ(dl_region_simd::SpansIntersectRange(spans.data(), span_count,
+                                                    left, right),
+                expected)
+          << dl_region_simd::ImplementationName();
+    }
+  }
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -3,6 +3,9 @@
 // found in the LICENSE file.
 
 #include "flutter/display_list/geometry/dl_rtree.h"
+
+#include <algorithm>
+
 #include "flutter/display_list/geometry/dl_region.h"
 
 #include "flutter/fml/logging.h"
@@ -13,7 +16,8 @@ DlRTree::DlRTree(const SkRect rects[],
                  int N,
                  const int ids[],
                  bool p(int),
-                 int invalid_id)
+                 int invalid_id,
+                 const DlRTree* previous)
     : invalid_id_(invalid_id) {
   if (N <= 0) {
     FML_DCHECK(N >= 0);
@@ -61,6 +65,29 @@ DlRTree::DlRTree(const SkRect rects[],
   }
   FML_DCHECK(leaf_index == leaf_count);
 
+  // The node layout only depends on the leaf count so, if it matches the
+  // |previous| tree, any internal node whose children all lie outside of
+  // the range of changed nodes [dirty_start, dirty_end) has the same
+  // bounds as the node at the same index in |previous|. Without a usable
+  // hint every node is treated as changed.
+  bool reuse = previous != nullptr && previous->leaf_count_ == leaf_count &&
+               previous->nodes_.size() == total_node_count;
+  uint32_t dirty_start = 0;
+  uint32_t dirty_end = total_node_count;
+  if (reuse) {
+    auto same_leaf = [this, previous](uint32_t i) {
+      return nodes_[i].id == previous->nodes_[i].id &&
+             nodes_[i].bounds == previous->nodes_[i].bounds;
+    };
+    dirty_end = leaf_count;
+    while (dirty_start < dirty_end && same_leaf(dirty_start)) {
+      dirty_start++;
+    }
+    while (dirty_end > dirty_start && same_leaf(dirty_end - 1)) {
+      dirty_end--;
+    }
+  }
+
   // --- Implementation note ---
   // Many R-Tree algorithms attempt to consolidate nearby rectangles
   // into branches of the tree in order to maximize the benefit of
@@ -122,17 +149,40 @@ DlRTree::DlRTree(const SkRect rects[],
         D -= gen_count;
         FML_DCHECK(parent_index < gen_end + family_count);
         parent = &nodes_[parent_index++];
-        parent->bounds.setEmpty();
         parent->child.index = sibling_index;
         parent->child.count = 0;
       }
       FML_DCHECK(parent != nullptr);
-      parent->bounds.join(nodes_[sibling_index++].bounds);
+      sibling_index++;
       parent->child.count++;
     }
     FML_DCHECK(D == 0);
     FML_DCHECK(sibling_index == gen_end);
     FML_DCHECK(parent_index == gen_end + family_count);
+
+    // Now fill in the bounds of the new generation, tracking the range of
+    // its nodes that differ from |previous| for use by the next one.
+    uint32_t next_dirty_start = parent_index;
+    uint32_t next_dirty_end = gen_end;
+    for (uint32_t i = gen_end; i < parent_index; i++) {
+      Node& node = nodes_[i];
+      uint32_t first_child = node.child.index;
+      uint32_t end_child = first_child + node.child.count;
+      if (reuse && (dirty_start >= dirty_end || end_child <= dirty_start ||
+                    first_child >= dirty_end)) {
+        node.bounds = previous->nodes_[i].bounds;
+        reused_node_count_++;
+      } else {
+        node.bounds.setEmpty();
+        for (uint32_t child = first_child; child < end_child; child++) {
+          node.bounds.join(nodes_[child].bounds);
+        }
+        next_dirty_start = std::min(next_dirty_start, i);
+        next_dirty_end = i + 1;
+      }
+    }
+    dirty_start = next_dirty_start;
+    dirty_end = next_dirty_end;
     gen_start = gen_end;
     gen_count = family_count;
   }
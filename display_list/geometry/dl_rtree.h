@@ -61,12 +61,22 @@ class DlRTree : public SkRefCnt {
   /// Duplicate rectangles and IDs are allowed and not processed in any
   /// way except to eliminate invalid rectangles and IDs that are rejected
   /// by the optional predicate function.
+  ///
+  /// If a |previous| R-Tree is provided, typically the one built for the
+  /// same content on the prior frame, and it stores the same number of
+  /// leaf rectangles, then the bounds of every internal node that only
+  /// covers leaves that are unchanged from |previous| (same rectangle and
+  /// same ID) are copied from it rather than recomputed. In practice this
+  /// means that the nodes over an unchanged prefix and suffix of the list
+  /// are reused and only the nodes above the changed range are rebuilt.
+  /// The resulting tree is identical to one built without the hint.
   DlRTree(
       const SkRect rects[],
       int N,
       const int ids[] = nullptr,
       bool predicate(int id) = [](int) { return true; },
-      int invalid_id = -1);
+      int invalid_id = -1,
+      const DlRTree* previous = nullptr);
 
   /// Search the rectangles and return a vector of leaf node indices for
   /// rectangles that intersect the query.
@@ -114,6 +124,10 @@ class DlRTree : public SkRefCnt {
   /// and internal consolidation nodes.
   int node_count() const { return nodes_.size(); }
 
+  /// Returns the number of internal nodes whose bounds were copied from
+  /// the |previous| R-Tree supplied to the constructor.
+  int reused_node_count() const { return reused_node_count_; }
+
   /// Finds the rects in the tree that intersect with the query rect.
   ///
   /// The returned list of rectangles will be non-overlapping.
@@ -145,6 +159,7 @@ class DlRTree : public SkRefCnt {
 
   std::vector<Node> nodes_;
   int leaf_count_ = 0;
+  int reused_node_count_ = 0;
   int invalid_id_;
   mutable std::optional<DlRegion> region_;
 };
@@ -319,5 +319,57 @@ TEST(DisplayListRTree, Region) {
   EXPECT_EQ(rects.size(), expected_rects.size());
 }
 
+TEST(DisplayListRTree, ReusesUnchangedNodesOfPrevious) {
+  // 500 rects give 3 levels of internal nodes above the leaves.
+  const int kN = 500;
+  std::vector<SkRect> rects(kN);
+  std::vector<int> ids(kN);
+  for (int i = 0; i < kN; i++) {
+    rects[i].setXYWH((i % 25) * 20, (i / 25) * 20, 10, 10);
+    ids[i] = i;
+  }
+  DlRTree previous(rects.data(), kN, ids.data());
+  EXPECT_EQ(previous.reused_node_count(), 0);
+  int internal_node_count = previous.node_count() - previous.leaf_count();
+
+  // Identical content reuses every internal node.
+  DlRTree identical(rects.data(), kN, ids.data(), [](int) { return true; }, -1,
+                    &previous);
+  EXPECT_EQ(identical.node_count(), previous.node_count());
+  EXPECT_EQ(identical.reused_node_count(), internal_node_count);
+
+  // Moving one rect in the middle only rebuilds the nodes above it.
+  std::vector<SkRect> changed_rects = rects;
+  changed_rects[250].offset(5, 5);
+  DlRTree changed(changed_rects.data(), kN, ids.data(),
+                  [](int) { return true; }, -1, &previous);
+  DlRTree fresh(changed_rects.data(), kN, ids.data());
+  EXPECT_GT(changed.reused_node_count(), 0);
+  EXPECT_LT(changed.reused_node_count(), internal_node_count);
+  EXPECT_EQ(changed.bounds(), fresh.bounds());
+
+  // A different leaf count can not reuse anything.
+  DlRTree shorter(rects.data(), kN - 1, ids.data(), [](int) { return true; },
+                  -1, &previous);
+  EXPECT_EQ(shorter.reused_node_count(), 0);
+
+  for (int y = 0; y < 400; y += 7) {
+    for (int x = 0; x < 500; x += 7) {
+      SkRect query = SkRect::MakeXYWH(x, y, 12, 12);
+      std::vector<int> expected;
+      std::vector<int> actual;
+      fresh.search(query, &expected);
+      changed.search(query, &actual);
+      EXPECT_EQ(actual, expected) << "query " << x << ", " << y;
+
+      expected.clear();
+      actual.clear();
+      previous.search(query, &expected);
+      identical.search(query, &actual);
+      EXPECT_EQ(actual, expected) << "query " << x << ", " << y;
+    }
+  }
+}
+
 }  // namespace testing
 }  // namespace flutter
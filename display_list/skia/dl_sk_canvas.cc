@@ -9,6 +9,7 @@
 #include "flutter/fml/trace_event.h"
 
 #include "third_party/skia/include/core/SkColorFilter.h"
+#include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "third_party/skia/include/gpu/GrRecordingContext.h"
 
@@ -45,6 +46,16 @@ SkImageInfo DlSkCanvasAdapter::GetImageInfo() const {
   return delegate_->imageInfo();
 }
 
+sk_sp<DlImage> DlSkCanvasAdapter::SnapshotSurface(
+    const SkIRect& device_bounds) {
+  SkSurface* surface = delegate_->getSurface();
+  if (!surface) {
+    return nullptr;
+  }
+  sk_sp<SkImage> image = surface->makeImageSnapshot(device_bounds);
+  return image ? DlImage::Make(std::move(image)) : nullptr;
+}
+
 void DlSkCanvasAdapter::Save() {
   delegate_->save();
 }
@@ -315,6 +326,7 @@ void DlSkCanvasAdapter::DrawDisplayList(const sk_sp<DisplayList> display_list,
   } else {
     display_list->Dispatch(dispatcher);
   }
+  dispatcher.FlushImageRects();
 
   delegate_->restoreToCount(restore_count);
 }
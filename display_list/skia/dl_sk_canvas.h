@@ -26,6 +26,7 @@ class DlSkCanvasAdapter final : public virtual DlCanvas {
 
   SkISize GetBaseLayerSize() const override;
   SkImageInfo GetImageInfo() const override;
+  sk_sp<DlImage> SnapshotSurface(const SkIRect& device_bounds) override;
 
   void Save() override;
   void SaveLayer(const SkRect* bounds,
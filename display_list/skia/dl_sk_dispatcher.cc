@@ -13,6 +13,10 @@
 
 namespace flutter {
 
+DlSkCanvasDispatcher::~DlSkCanvasDispatcher() {
+  FlushImageRects();
+}
+
 const SkPaint* DlSkCanvasDispatcher::safe_paint(bool use_attributes) {
   if (use_attributes) {
     // The accumulated SkPaint object will already have incorporated
@@ -30,6 +34,7 @@ const SkPaint* DlSkCanvasDispatcher::safe_paint(bool use_attributes) {
 }
 
 void DlSkCanvasDispatcher::save() {
+  FlushImageRects();
   canvas_->save();
   // save has no impact on attributes, but it needs to register a record
   // on the restore stack so that the eventual call to restore() will
@@ -40,12 +45,14 @@ void DlSkCanvasDispatcher::save() {
   save_opacity(opacity());
 }
 void DlSkCanvasDispatcher::restore() {
+  FlushImageRects();
   canvas_->restore();
   restore_opacity();
 }
 void DlSkCanvasDispatcher::saveLayer(const SkRect* bounds,
                                      const SaveLayerOptions options,
                                      const DlImageFilter* backdrop) {
+  FlushImageRects();
   if (bounds == nullptr && options.can_distribute_opacity() &&
       backdrop == nullptr) {
     // We know that:
@@ -76,15 +83,19 @@ void DlSkCanvasDispatcher::saveLayer(const SkRect* bounds,
 }
 
 void DlSkCanvasDispatcher::translate(SkScalar tx, SkScalar ty) {
+  FlushImageRects();
   canvas_->translate(tx, ty);
 }
 void DlSkCanvasDispatcher::scale(SkScalar sx, SkScalar sy) {
+  FlushImageRects();
   canvas_->scale(sx, sy);
 }
 void DlSkCanvasDispatcher::rotate(SkScalar degrees) {
+  FlushImageRects();
   canvas_->rotate(degrees);
 }
 void DlSkCanvasDispatcher::skew(SkScalar sx, SkScalar sy) {
+  FlushImageRects();
   canvas_->skew(sx, sy);
 }
 // clang-format off
@@ -92,6 +103,7 @@ void DlSkCanvasDispatcher::skew(SkScalar sx, SkScalar sy) {
 void DlSkCanvasDispatcher::transform2DAffine(
     SkScalar mxx, SkScalar mxy, SkScalar mxt,
     SkScalar myx, SkScalar myy, SkScalar myt) {
+  FlushImageRects();
   // Internally concat(SkMatrix) gets redirected to concat(SkM44)
   // so we just jump directly to the SkM44 version
   canvas_->concat(SkM44(mxx, mxy, 0, mxt,
@@ -105,6 +117,7 @@ void DlSkCanvasDispatcher::transformFullPerspective(
     SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
     SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
     SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) {
+  FlushImageRects();
   canvas_->concat(SkM44(mxx, mxy, mxz, mxt,
                         myx, myy, myz, myt,
                         mzx, mzy, mzz, mzt,
@@ -112,26 +125,31 @@ void DlSkCanvasDispatcher::transformFullPerspective(
 }
 // clang-format on
 void DlSkCanvasDispatcher::transformReset() {
+  FlushImageRects();
   canvas_->setMatrix(original_transform_);
 }
 
 void DlSkCanvasDispatcher::clipRect(const SkRect& rect,
                                     ClipOp clip_op,
                                     bool is_aa) {
+  FlushImageRects();
   canvas_->clipRect(rect, ToSk(clip_op), is_aa);
 }
 void DlSkCanvasDispatcher::clipRRect(const SkRRect& rrect,
                                      ClipOp clip_op,
                                      bool is_aa) {
+  FlushImageRects();
   canvas_->clipRRect(rrect, ToSk(clip_op), is_aa);
 }
 void DlSkCanvasDispatcher::clipPath(const SkPath& path,
                                     ClipOp clip_op,
                                     bool is_aa) {
+  FlushImageRects();
   canvas_->clipPath(path, ToSk(clip_op), is_aa);
 }
 
 void DlSkCanvasDispatcher::drawPaint() {
+  FlushImageRects();
   const SkPaint& sk_paint = paint();
   SkImageFilter* filter = sk_paint.getImageFilter();
   if (filter && !filter->asColorFilter(nullptr)) {
@@ -142,6 +160,7 @@ void DlSkCanvasDispatcher::drawPaint() {
   canvas_->drawPaint(sk_paint);
 }
 void DlSkCanvasDispatcher::drawColor(DlColor color, DlBlendMode mode) {
+  FlushImageRects();
   // SkCanvas::drawColor(SkColor) does the following conversion anyway
   // We do it here manually to increase precision on applying opacity
   SkColor4f color4f = SkColor4f::FromColor(ToSk(color));
@@ -149,46 +168,57 @@ void DlSkCanvasDispatcher::drawColor(DlColor color, DlBlendMode mode) {
   canvas_->drawColor(color4f, ToSk(mode));
 }
 void DlSkCanvasDispatcher::drawLine(const SkPoint& p0, const SkPoint& p1) {
+  FlushImageRects();
   canvas_->drawLine(p0, p1, paint());
 }
 void DlSkCanvasDispatcher::drawRect(const SkRect& rect) {
+  FlushImageRects();
   canvas_->drawRect(rect, paint());
 }
 void DlSkCanvasDispatcher::drawOval(const SkRect& bounds) {
+  FlushImageRects();
   canvas_->drawOval(bounds, paint());
 }
 void DlSkCanvasDispatcher::drawCircle(const SkPoint& center, SkScalar radius) {
+  FlushImageRects();
   canvas_->drawCircle(center, radius, paint());
 }
 void DlSkCanvasDispatcher::drawRRect(const SkRRect& rrect) {
+  FlushImageRects();
   canvas_->drawRRect(rrect, paint());
 }
 void DlSkCanvasDispatcher::drawDRRect(const SkRRect& outer,
                                       const SkRRect& inner) {
+  FlushImageRects();
   canvas_->drawDRRect(outer, inner, paint());
 }
 void DlSkCanvasDispatcher::drawPath(const SkPath& path) {
+  FlushImageRects();
   canvas_->drawPath(path, paint());
 }
 void DlSkCanvasDispatcher::drawArc(const SkRect& bounds,
                                    SkScalar start,
                                    SkScalar sweep,
                                    bool useCenter) {
+  FlushImageRects();
   canvas_->drawArc(bounds, start, sweep, useCenter, paint());
 }
 void DlSkCanvasDispatcher::drawPoints(PointMode mode,
                                       uint32_t count,
                                       const SkPoint pts[]) {
+  FlushImageRects();
   canvas_->drawPoints(ToSk(mode), count, pts, paint());
 }
 void DlSkCanvasDispatcher::drawVertices(const DlVertices* vertices,
                                         DlBlendMode mode) {
+  FlushImageRects();
   canvas_->drawVertices(ToSk(vertices), ToSk(mode), paint());
 }
 void DlSkCanvasDispatcher::drawImage(const sk_sp<DlImage> image,
                                      const SkPoint point,
                                      DlImageSampling sampling,
                                      bool render_with_attributes) {
+  FlushImageRects();
   canvas_->drawImage(image ? image->skia_image() : nullptr, point.fX, point.fY,
                      ToSk(sampling), safe_paint(render_with_attributes));
 }
@@ -198,15 +228,100 @@ void DlSkCanvasDispatcher::drawImageRect(const sk_sp<DlImage> image,
                                          DlImageSampling sampling,
                                          bool render_with_attributes,
                                          SrcRectConstraint constraint) {
-  canvas_->drawImageRect(image ? image->skia_image() : nullptr, src, dst,
-                         ToSk(sampling), safe_paint(render_with_attributes),
-                         ToSk(constraint));
+  sk_sp<SkImage> skia_image = image ? image->skia_image() : nullptr;
+  const SkPaint* sk_paint = safe_paint(render_with_attributes);
+  if (!skia_image || !CanDrawAsSprite(src, dst, sk_paint, constraint)) {
+    FlushImageRects();
+    canvas_->drawImageRect(skia_image, src, dst, ToSk(sampling), sk_paint,
+                           ToSk(constraint));
+    return;
+  }
+  const bool same_run =
+      image_rects_.image == skia_image &&
+      image_rects_.sampling == ToSk(sampling) &&
+      (sk_paint ? image_rects_.paint == *sk_paint
+                : !image_rects_.paint.has_value());
+  if (!same_run) {
+    FlushImageRects();
+    image_rects_.image = std::move(skia_image);
+    image_rects_.sampling = ToSk(sampling);
+    if (sk_paint) {
+      image_rects_.paint = *sk_paint;
+    }
+  }
+  image_rects_.src.push_back(src);
+  image_rects_.dst.push_back(dst);
+}
+bool DlSkCanvasDispatcher::CanDrawAsSprite(const SkRect& src,
+                                           const SkRect& dst,
+                                           const SkPaint* paint,
+                                           SrcRectConstraint constraint) const {
+  // Sprites are scaled uniformly and the atlas draw neither restricts
+  // sampling to the source rect nor applies filters to each sprite.
+  if (constraint != SrcRectConstraint::kFast || !src.isSorted() ||
+      src.isEmpty() || !dst.isSorted() ||
+      !SkScalarNearlyEqual(dst.width() * src.height(),
+                           dst.height() * src.width())) {
+    return false;
+  }
+  if (paint && (paint->getImageFilter() || paint->getMaskFilter() ||
+                paint->getShader())) {
+    return false;
+  }
+  // Sprite edges are not anti-aliased, which only makes no difference when
+  // they fall on pixel boundaries.
+  if (paint && paint->isAntiAlias()) {
+    const SkMatrix& ctm = canvas_->getTotalMatrix();
+    if (!ctm.isScaleTranslate()) {
+      return false;
+    }
+    SkRect device_dst = ctm.mapRect(dst);
+    SkRect rounded = SkRect::Make(device_dst.round());
+    return SkScalarNearlyEqual(device_dst.fLeft, rounded.fLeft) &&
+           SkScalarNearlyEqual(device_dst.fTop, rounded.fTop) &&
+           SkScalarNearlyEqual(device_dst.fRight, rounded.fRight) &&
+           SkScalarNearlyEqual(device_dst.fBottom, rounded.fBottom);
+  }
+  return true;
+}
+void DlSkCanvasDispatcher::FlushImageRects() {
+  const size_t count = image_rects_.dst.size();
+  if (count == 0u) {
+    return;
+  }
+  const SkPaint* paint =
+      image_rects_.paint.has_value() ? &image_rects_.paint.value() : nullptr;
+  if (count == 1u) {
+    canvas_->drawImageRect(image_rects_.image, image_rects_.src[0],
+                           image_rects_.dst[0], image_rects_.sampling, paint,
+                           SkCanvas::kFast_SrcRectConstraint);
+  } else {
+    std::vector<SkRSXform> xforms;
+    xforms.reserve(count);
+    SkRect bounds = SkRect::MakeEmpty();
+    for (size_t i = 0; i < count; i++) {
+      const SkRect& src = image_rects_.src[i];
+      const SkRect& dst = image_rects_.dst[i];
+      xforms.push_back(SkRSXform::Make(dst.width() / src.width(), 0.0f,
+                                       dst.fLeft, dst.fTop));
+      bounds.join(dst);
+    }
+    canvas_->drawAtlas(image_rects_.image.get(), xforms.data(),
+                       image_rects_.src.data(), nullptr,
+                       static_cast<int>(count), SkBlendMode::kModulate,
+                       image_rects_.sampling, &bounds, paint);
+  }
+  image_rects_.image.reset();
+  image_rects_.paint.reset();
+  image_rects_.src.clear();
+  image_rects_.dst.clear();
 }
 void DlSkCanvasDispatcher::drawImageNine(const sk_sp<DlImage> image,
                                          const SkIRect& center,
                                          const SkRect& dst,
                                          DlFilterMode filter,
                                          bool render_with_attributes) {
+  FlushImageRects();
   if (!image) {
     return;
   }
@@ -226,6 +341,7 @@ void DlSkCanvasDispatcher::drawAtlas(const sk_sp<DlImage> atlas,
                                      DlImageSampling sampling,
                                      const SkRect* cullRect,
                                      bool render_with_attributes) {
+  FlushImageRects();
   if (!atlas) {
     return;
   }
@@ -241,6 +357,7 @@ void DlSkCanvasDispatcher::drawAtlas(const sk_sp<DlImage> atlas,
 void DlSkCanvasDispatcher::drawDisplayList(
     const sk_sp<DisplayList> display_list,
     SkScalar opacity) {
+  FlushImageRects();
   const int restore_count = canvas_->getSaveCount();
 
   // Compute combined opacity and figure out whether we can apply it
@@ -263,6 +380,7 @@ void DlSkCanvasDispatcher::drawDisplayList(
   } else {
     display_list->Dispatch(dispatcher);
   }
+  dispatcher.FlushImageRects();
 
   // Restore canvas state to what it was before dispatching.
   canvas_->restoreToCount(restore_count);
@@ -270,6 +388,7 @@ void DlSkCanvasDispatcher::drawDisplayList(
 void DlSkCanvasDispatcher::drawTextBlob(const sk_sp<SkTextBlob> blob,
                                         SkScalar x,
                                         SkScalar y) {
+  FlushImageRects();
   canvas_->drawTextBlob(blob, x, y, paint());
 }
 
@@ -277,6 +396,7 @@ void DlSkCanvasDispatcher::drawTextFrame(
     const std::shared_ptr<impeller::TextFrame>& text_frame,
     SkScalar x,
     SkScalar y) {
+  FlushImageRects();
   FML_CHECK(false);
 }
 
@@ -311,6 +431,7 @@ void DlSkCanvasDispatcher::drawShadow(const SkPath& path,
                                       const SkScalar elevation,
                                       bool transparent_occluder,
                                       SkScalar dpr) {
+  FlushImageRects();
   DrawShadow(canvas_, path, color, elevation, transparent_occluder, dpr);
 }
 
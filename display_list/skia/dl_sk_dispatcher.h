@@ -5,6 +5,9 @@
 #ifndef FLUTTER_DISPLAY_LIST_SKIA_DL_SK_DISPATCHER_H_
 #define FLUTTER_DISPLAY_LIST_SKIA_DL_SK_DISPATCHER_H_
 
+#include <optional>
+#include <vector>
+
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_op_receiver.h"
 #include "flutter/display_list/skia/dl_sk_paint_dispatcher.h"
@@ -16,6 +19,11 @@ namespace flutter {
 //------------------------------------------------------------------------------
 /// @brief      Backend implementation of |DlOpReceiver| for |SkCanvas|.
 ///
+///             Runs of image rects that share an image and paint are drawn
+///             with a single |SkCanvas::drawAtlas| call. A run is drawn when
+///             any other op arrives, when |FlushImageRects| is called, or
+///             when the dispatcher is destroyed.
+///
 /// @see       DlOpReceiver
 class DlSkCanvasDispatcher : public virtual DlOpReceiver,
                              public DlSkPaintDispatchHelper {
@@ -25,8 +33,13 @@ class DlSkCanvasDispatcher : public virtual DlOpReceiver,
         canvas_(canvas),
         original_transform_(canvas->getLocalToDevice()) {}
 
+  ~DlSkCanvasDispatcher();
+
   const SkPaint* safe_paint(bool use_attributes);
 
+  /// Draws the image rects that are waiting to be drawn together.
+  void FlushImageRects();
+
   void save() override;
   void restore() override;
   void saveLayer(const SkRect* bounds,
@@ -115,9 +128,24 @@ class DlSkCanvasDispatcher : public virtual DlOpReceiver,
                          SkScalar dpr);
 
  private:
+  // Consecutive image rects that are drawn with the same image and paint.
+  struct ImageRectRun {
+    sk_sp<SkImage> image;
+    SkSamplingOptions sampling;
+    std::optional<SkPaint> paint;
+    std::vector<SkRect> src;
+    std::vector<SkRect> dst;
+  };
+
   SkCanvas* canvas_;
   const SkM44 original_transform_;
   SkPaint temp_paint_;
+  ImageRectRun image_rects_;
+
+  bool CanDrawAsSprite(const SkRect& src,
+                       const SkRect& dst,
+                       const SkPaint* paint,
+                       SrcRectConstraint constraint) const;
 };
 
 }  // namespace flutter
@@ -79,13 +79,16 @@ void DlSkPaintDispatchHelper::setColorSource(const DlColorSource* source) {
   // source is a gradient here and let the |paint()| method figure out
   // the rest (i.e. whether the color source will be used).
   color_source_gradient_ = source && source->isGradient();
-  paint_.setShader(ToSk(source));
+  paint_.setShader(
+      shader_cache_.Get(source, [source]() { return ToSk(source); }));
 }
 void DlSkPaintDispatchHelper::setImageFilter(const DlImageFilter* filter) {
-  paint_.setImageFilter(ToSk(filter));
+  paint_.setImageFilter(
+      image_filter_cache_.Get(filter, [filter]() { return ToSk(filter); }));
 }
 void DlSkPaintDispatchHelper::setColorFilter(const DlColorFilter* filter) {
-  sk_color_filter_ = ToSk(filter);
+  sk_color_filter_ =
+      color_filter_cache_.Get(filter, [filter]() { return ToSk(filter); });
   paint_.setColorFilter(makeColorFilter());
 }
 void DlSkPaintDispatchHelper::setPathEffect(const DlPathEffect* effect) {
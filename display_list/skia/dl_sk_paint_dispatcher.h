@@ -5,6 +5,10 @@
 #ifndef FLUTTER_DISPLAY_LIST_SKIA_DL_SK_PAINT_DISPATCHER_H_
 #define FLUTTER_DISPLAY_LIST_SKIA_DL_SK_PAINT_DISPATCHER_H_
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 #include "flutter/display_list/dl_op_receiver.h"
 #include "flutter/display_list/skia/dl_sk_types.h"
 
@@ -71,10 +75,50 @@ class DlSkPaintDispatchHelper : public virtual DlOpReceiver {
   void restore_opacity();
 
  private:
+  // Remembers the Skia objects converted from the most recently used
+  // attributes of one kind, so that display lists that switch back and forth
+  // between a few gradients or filters do not convert them again. Attributes
+  // are compared by content, since the same attribute is usually recorded
+  // separately for each use.
+  template <typename D, typename S>
+  class ConversionCache {
+   public:
+    static constexpr size_t kMaxEntries = 4u;
+
+    template <typename Convert>
+    sk_sp<S> Get(const D* attribute, const Convert& convert) {
+      if (!attribute) {
+        return nullptr;
+      }
+      for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        if (*it->attribute == *attribute) {
+          std::rotate(entries_.begin(), it, it + 1);
+          return entries_.front().sk_object;
+        }
+      }
+      if (entries_.size() == kMaxEntries) {
+        entries_.pop_back();
+      }
+      entries_.insert(entries_.begin(), {attribute->shared(), convert()});
+      return entries_.front().sk_object;
+    }
+
+   private:
+    struct Entry {
+      std::shared_ptr<D> attribute;
+      sk_sp<S> sk_object;
+    };
+    // Most recently used first.
+    std::vector<Entry> entries_;
+  };
+
   SkPaint paint_;
   bool color_source_gradient_ = false;
   bool invert_colors_ = false;
   sk_sp<SkColorFilter> sk_color_filter_;
+  ConversionCache<DlColorSource, SkShader> shader_cache_;
+  ConversionCache<DlColorFilter, SkColorFilter> color_filter_cache_;
+  ConversionCache<DlImageFilter, SkImageFilter> image_filter_cache_;
 
   sk_sp<SkColorFilter> makeColorFilter() const;
 
@@ -9,6 +9,7 @@
 #include "flutter/display_list/testing/dl_test_snippets.h"
 #include "flutter/display_list/utils/dl_receiver_utils.h"
 #include "gtest/gtest.h"
+#include "third_party/skia/include/utils/SkNoDrawCanvas.h"
 
 namespace flutter {
 namespace testing {
@@ -112,5 +113,83 @@ TEST(DisplayListUtils, SkDispatcherSetColorSourceDoesNotDitherIfNotGradient) {
   // Calling safe_paint(false) returns a nullptr
 }
 
+TEST(DisplayListUtils, SkPaintDispatcherReusesConvertedAttributes) {
+  MockDispatchHelper helper;
+  auto other_gradient = DlColorSource::MakeLinear(
+      SkPoint::Make(0.0f, 0.0f), SkPoint::Make(50.0f, 50.0f), 2, kTestColors,
+      kTestStops, DlTileMode::kClamp, nullptr);
+
+  helper.setColorSource(kTestLinearGradient.get());
+  SkShader* shader = helper.paint().getShader();
+  ASSERT_NE(shader, nullptr);
+  helper.setColorSource(other_gradient.get());
+  EXPECT_NE(helper.paint().getShader(), shader);
+
+  // An equal gradient that was recorded separately gets the same shader.
+  auto same_gradient = kTestLinearGradient->shared();
+  helper.setColorSource(same_gradient.get());
+  EXPECT_EQ(helper.paint().getShader(), shader);
+}
+
+class DrawCountingCanvas final : public SkNoDrawCanvas {
+ public:
+  DrawCountingCanvas() : SkNoDrawCanvas(100, 100) {}
+
+  int image_rect_count = 0;
+  int atlas_count = 0;
+  int atlas_sprite_count = 0;
+
+ protected:
+  void onDrawImageRect2(const SkImage*,
+                        const SkRect&,
+                        const SkRect&,
+                        const SkSamplingOptions&,
+                        const SkPaint*,
+                        SrcRectConstraint) override {
+    image_rect_count++;
+  }
+
+  void onDrawAtlas2(const SkImage*,
+                    const SkRSXform[],
+                    const SkRect[],
+                    const SkColor[],
+                    int count,
+                    SkBlendMode,
+                    const SkSamplingOptions&,
+                    const SkRect*,
+                    const SkPaint*) override {
+    atlas_count++;
+    atlas_sprite_count += count;
+  }
+};
+
+TEST(DisplayListUtils, SkDispatcherDrawsImageRectRunsAsAtlas) {
+  DrawCountingCanvas canvas;
+  DlSkCanvasDispatcher dispatcher(&canvas);
+  dispatcher.setAntiAlias(true);
+  auto sampling = DlImageSampling::kNearestNeighbor;
+  auto draw = [&](const sk_sp<DlImage>& image, const SkRect& dst) {
+    dispatcher.drawImageRect(image, SkRect::MakeWH(10, 10), dst, sampling,
+                             true, DlCanvas::SrcRectConstraint::kFast);
+  };
+
+  draw(TestImage1, SkRect::MakeXYWH(0, 0, 10, 10));
+  draw(TestImage1, SkRect::MakeXYWH(10, 0, 20, 20));
+  draw(TestImage1, SkRect::MakeXYWH(30, 0, 10, 10));
+  // Another image starts a new run and the single rect is drawn as is.
+  draw(TestImage2, SkRect::MakeXYWH(0, 10, 10, 10));
+  dispatcher.drawRect(SkRect::MakeWH(5, 5));
+  EXPECT_EQ(canvas.atlas_count, 1);
+  EXPECT_EQ(canvas.atlas_sprite_count, 3);
+  EXPECT_EQ(canvas.image_rect_count, 1);
+
+  // Non-uniform scales and fractional anti-aliased edges are not sprites.
+  draw(TestImage1, SkRect::MakeXYWH(0, 0, 20, 10));
+  draw(TestImage1, SkRect::MakeXYWH(0.5, 0, 10, 10));
+  dispatcher.FlushImageRects();
+  EXPECT_EQ(canvas.atlas_count, 1);
+  EXPECT_EQ(canvas.image_rect_count, 3);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -114,6 +114,16 @@ sk_sp<DlImage> DlMetalSurfaceProvider::MakeImpellerImage(
   return impeller::DlImageImpeller::Make(texture);
 }
 
+std::optional<fml::TimeDelta> DlMetalSurfaceProvider::GetImpellerGPUTime()
+    const {
+  InitScreenShotter();
+  fml::TimeDelta gpu_time = snapshotter_->GetTotalGPUTime();
+  if (gpu_time == fml::TimeDelta::Zero()) {
+    return std::nullopt;
+  }
+  return gpu_time;
+}
+
 void DlMetalSurfaceProvider::InitScreenShotter() const {
   if (!snapshotter_) {
     snapshotter_.reset(new MetalScreenshotter());
@@ -40,6 +40,7 @@ class DlMetalSurfaceProvider : public DlSurfaceProvider {
   virtual sk_sp<DlImage> MakeImpellerImage(const sk_sp<DisplayList>& list,
                                            int width,
                                            int height) const override;
+  std::optional<fml::TimeDelta> GetImpellerGPUTime() const override;
 
  private:
   // This must be placed before any other members that may use the
@@ -5,11 +5,13 @@
 #ifndef FLUTTER_DISPLAY_LIST_TESTING_DL_TEST_SURFACE_PROVIDER_H_
 #define FLUTTER_DISPLAY_LIST_TESTING_DL_TEST_SURFACE_PROVIDER_H_
 
+#include <optional>
 #include <utility>
 
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/image/dl_image.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/testing/testing.h"
 
 #include "third_party/skia/include/core/SkSurface.h"
@@ -94,6 +96,11 @@ class DlSurfaceProvider {
                                            int height) const {
     return nullptr;
   }
+  // The GPU time of everything rendered with Impeller so far, if the backend
+  // measures it.
+  virtual std::optional<fml::TimeDelta> GetImpellerGPUTime() const {
+    return std::nullopt;
+  }
 
  protected:
   DlSurfaceProvider() = default;
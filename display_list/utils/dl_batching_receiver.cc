@@ -0,0 +1,356 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/utils/dl_batching_receiver.h"
+
+#include <algorithm>
+
+namespace flutter {
+
+DlBatchingOpReceiver::DlBatchingOpReceiver(DlOpReceiver& receiver,
+                                           uint32_t min_batch_size)
+    : receiver_(receiver),
+      batch_receiver_(receiver.asBatchedGeometryReceiver()),
+      min_batch_size_(std::max(min_batch_size, 1u)) {}
+
+DlBatchingOpReceiver::~DlBatchingOpReceiver() {
+  Flush();
+}
+
+void DlBatchingOpReceiver::Flush() {
+  if (!pending_rects_.empty()) {
+    uint32_t count = pending_rects_.size();
+    if (count >= min_batch_size_) {
+      batch_receiver_->drawRects(pending_rects_.data(), count);
+      batch_count_++;
+      batched_element_count_ += count;
+    } else {
+      for (const SkRect& rect : pending_rects_) {
+        receiver_.drawRect(rect);
+      }
+    }
+    pending_rects_.clear();
+  }
+  if (!pending_rrects_.empty()) {
+    uint32_t count = pending_rrects_.size();
+    if (count >= min_batch_size_) {
+      batch_receiver_->drawRRects(pending_rrects_.data(), count);
+      batch_count_++;
+      batched_element_count_ += count;
+    } else {
+      for (const SkRRect& rrect : pending_rrects_) {
+        receiver_.drawRRect(rrect);
+      }
+    }
+    pending_rrects_.clear();
+  }
+}
+
+void DlBatchingOpReceiver::setAntiAlias(bool aa) {
+  Flush();
+  receiver_.setAntiAlias(aa);
+}
+
+void DlBatchingOpReceiver::setDrawStyle(DlDrawStyle style) {
+  Flush();
+  receiver_.setDrawStyle(style);
+}
+
+void DlBatchingOpReceiver::setColor(DlColor color) {
+  Flush();
+  receiver_.setColor(color);
+}
+
+void DlBatchingOpReceiver::setStrokeWidth(float width) {
+  Flush();
+  receiver_.setStrokeWidth(width);
+}
+
+void DlBatchingOpReceiver::setStrokeMiter(float limit) {
+  Flush();
+  receiver_.setStrokeMiter(limit);
+}
+
+void DlBatchingOpReceiver::setStrokeCap(DlStrokeCap cap) {
+  Flush();
+  receiver_.setStrokeCap(cap);
+}
+
+void DlBatchingOpReceiver::setStrokeJoin(DlStrokeJoin join) {
+  Flush();
+  receiver_.setStrokeJoin(join);
+}
+
+void DlBatchingOpReceiver::setColorSource(const DlColorSource* source) {
+  Flush();
+  receiver_.setColorSource(source);
+}
+
+void DlBatchingOpReceiver::setColorFilter(const DlColorFilter* filter) {
+  Flush();
+  receiver_.setColorFilter(filter);
+}
+
+void DlBatchingOpReceiver::setInvertColors(bool invert) {
+  Flush();
+  receiver_.setInvertColors(invert);
+}
+
+void DlBatchingOpReceiver::setBlendMode(DlBlendMode mode) {
+  Flush();
+  receiver_.setBlendMode(mode);
+}
+
+void DlBatchingOpReceiver::setPathEffect(const DlPathEffect* effect) {
+  Flush();
+  receiver_.setPathEffect(effect);
+}
+
+void DlBatchingOpReceiver::setMaskFilter(const DlMaskFilter* filter) {
+  Flush();
+  receiver_.setMaskFilter(filter);
+}
+
+void DlBatchingOpReceiver::setImageFilter(const DlImageFilter* filter) {
+  Flush();
+  receiver_.setImageFilter(filter);
+}
+
+void DlBatchingOpReceiver::save() {
+  Flush();
+  receiver_.save();
+}
+
+void DlBatchingOpReceiver::saveLayer(const SkRect* bounds,
+                                     const SaveLayerOptions options,
+                                     const DlImageFilter* backdrop) {
+  Flush();
+  receiver_.saveLayer(bounds, options, backdrop);
+}
+
+void DlBatchingOpReceiver::restore() {
+  Flush();
+  receiver_.restore();
+}
+
+void DlBatchingOpReceiver::translate(SkScalar tx, SkScalar ty) {
+  Flush();
+  receiver_.translate(tx, ty);
+}
+
+void DlBatchingOpReceiver::scale(SkScalar sx, SkScalar sy) {
+  Flush();
+  receiver_.scale(sx, sy);
+}
+
+void DlBatchingOpReceiver::rotate(SkScalar degrees) {
+  Flush();
+  receiver_.rotate(degrees);
+}
+
+void DlBatchingOpReceiver::skew(SkScalar sx, SkScalar sy) {
+  Flush();
+  receiver_.skew(sx, sy);
+}
+
+// clang-format off
+void DlBatchingOpReceiver::transform2DAffine(
+    SkScalar mxx, SkScalar mxy, SkScalar mxt,
+    SkScalar myx, SkScalar myy, SkScalar myt) {
+  Flush();
+  receiver_.transform2DAffine(mxx, mxy, mxt,
+                              myx, myy, myt);
+}
+void DlBatchingOpReceiver::transformFullPerspective(
+    SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+    SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+    SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+    SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) {
+  Flush();
+  receiver_.transformFullPerspective(mxx, mxy, mxz, mxt,
+                                     myx, myy, myz, myt,
+                                     mzx, mzy, mzz, mzt,
+                                     mwx, mwy, mwz, mwt);
+}
+// clang-format on
+
+void DlBatchingOpReceiver::transformReset() {
+  Flush();
+  receiver_.transformReset();
+}
+
+void DlBatchingOpReceiver::clipRect(const SkRect& rect,
+                                    ClipOp clip_op,
+                                    bool is_aa) {
+  Flush();
+  receiver_.clipRect(rect, clip_op, is_aa);
+}
+
+void DlBatchingOpReceiver::clipRRect(const SkRRect& rrect,
+                                     ClipOp clip_op,
+                                     bool is_aa) {
+  Flush();
+  receiver_.clipRRect(rrect, clip_op, is_aa);
+}
+
+void DlBatchingOpReceiver::clipPath(const SkPath& path,
+                                    ClipOp clip_op,
+                                    bool is_aa) {
+  Flush();
+  receiver_.clipPath(path, clip_op, is_aa);
+}
+
+void DlBatchingOpReceiver::drawColor(DlColor color, DlBlendMode mode) {
+  Flush();
+  receiver_.drawColor(color, mode);
+}
+
+void DlBatchingOpReceiver::drawPaint() {
+  Flush();
+  receiver_.drawPaint();
+}
+
+void DlBatchingOpReceiver::drawLine(const SkPoint& p0, const SkPoint& p1) {
+  Flush();
+  receiver_.drawLine(p0, p1);
+}
+
+void DlBatchingOpReceiver::drawRect(const SkRect& rect) {
+  if (!batch_receiver_) {
+    receiver_.drawRect(rect);
+    return;
+  }
+  if (!pending_rrects_.empty() || pending_rects_.size() >= kMaxBatchSize) {
+    Flush();
+  }
+  pending_rects_.push_back(rect);
+}
+
+void DlBatchingOpReceiver::drawOval(const SkRect& bounds) {
+  Flush();
+  receiver_.drawOval(bounds);
+}
+
+void DlBatchingOpReceiver::drawCircle(const SkPoint& center, SkScalar radius) {
+  Flush();
+  receiver_.drawCircle(center, radius);
+}
+
+void DlBatchingOpReceiver::drawRRect(const SkRRect& rrect) {
+  if (!batch_receiver_) {
+    receiver_.drawRRect(rrect);
+    return;
+  }
+  if (!pending_rects_.empty() || pending_rrects_.size() >= kMaxBatchSize) {
+    Flush();
+  }
+  pending_rrects_.push_back(rrect);
+}
+
+void DlBatchingOpReceiver::drawDRRect(const SkRRect& outer,
+                                      const SkRRect& inner) {
+  Flush();
+  receiver_.drawDRRect(outer, inner);
+}
+
+void DlBatchingOpReceiver::drawPath(const SkPath& path) {
+  Flush();
+  receiver_.drawPath(path);
+}
+
+void DlBatchingOpReceiver::drawArc(const SkRect& oval_bounds,
+                                   SkScalar start_degrees,
+                                   SkScalar sweep_degrees,
+                                   bool use_center) {
+  Flush();
+  receiver_.drawArc(oval_bounds, start_degrees, sweep_degrees, use_center);
+}
+
+void DlBatchingOpReceiver::drawPoints(PointMode mode,
+                                      uint32_t count,
+                                      const SkPoint points[]) {
+  Flush();
+  receiver_.drawPoints(mode, count, points);
+}
+
+void DlBatchingOpReceiver::drawVertices(const DlVertices* vertices,
+                                        DlBlendMode mode) {
+  Flush();
+  receiver_.drawVertices(vertices, mode);
+}
+
+void DlBatchingOpReceiver::drawImage(const sk_sp<DlImage> image,
+                                     const SkPoint point,
+                                     DlImageSampling sampling,
+                                     bool render_with_attributes) {
+  Flush();
+  receiver_.drawImage(image, point, sampling, render_with_attributes);
+}
+
+void DlBatchingOpReceiver::drawImageRect(const sk_sp<DlImage> image,
+                                         const SkRect& src,
+                                         const SkRect& dst,
+                                         DlImageSampling sampling,
+                                         bool render_with_attributes,
+                                         SrcRectConstraint constraint) {
+  Flush();
+  receiver_.drawImageRect(image, src, dst, sampling, render_with_attributes,
+                          constraint);
+}
+
+void DlBatchingOpReceiver::drawImageNine(const sk_sp<DlImage> image,
+                                         const SkIRect& center,
+                                         const SkRect& dst,
+                                         DlFilterMode filter,
+                                         bool render_with_attributes) {
+  Flush();
+  receiver_.drawImageNine(image, center, dst, filter, render_with_attributes);
+}
+
+void DlBatchingOpReceiver::drawAtlas(const sk_sp<DlImage> atlas,
+                                     const SkRSXform xform[],
+                                     const SkRect tex[],
+                                     const DlColor colors[],
+                                     int count,
+                                     DlBlendMode mode,
+                                     DlImageSampling sampling,
+                                     const SkRect* cull_rect,
+                                     bool render_with_attributes) {
+  Flush();
+  receiver_.drawAtlas(atlas, xform, tex, colors, count, mode, sampling,
+                      cull_rect, render_with_attributes);
+}
+
+void DlBatchingOpReceiver::drawDisplayList(
+    const sk_sp<DisplayList> display_list,
+    SkScalar opacity) {
+  Flush();
+  receiver_.drawDisplayList(display_list, opacity);
+}
+
+void DlBatchingOpReceiver::drawTextBlob(const sk_sp<SkTextBlob> blob,
+                                        SkScalar x,
+                                        SkScalar y) {
+  Flush();
+  receiver_.drawTextBlob(blob, x, y);
+}
+
+void DlBatchingOpReceiver::drawTextFrame(
+    const std::shared_ptr<impeller::TextFrame>& text_frame,
+    SkScalar x,
+    SkScalar y) {
+  Flush();
+  receiver_.drawTextFrame(text_frame, x, y);
+}
+
+void DlBatchingOpReceiver::drawShadow(const SkPath& path,
+                                      const DlColor color,
+                                      const SkScalar elevation,
+                                      bool transparent_occluder,
+                                      SkScalar dpr) {
+  Flush();
+  receiver_.drawShadow(path, color, elevation, transparent_occluder, dpr);
+}
+
+}  // namespace flutter
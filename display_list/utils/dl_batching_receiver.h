@@ -0,0 +1,190 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_UTILS_DL_BATCHING_RECEIVER_H_
+#define FLUTTER_DISPLAY_LIST_UTILS_DL_BATCHING_RECEIVER_H_
+
+#include <vector>
+
+#include "flutter/display_list/dl_op_receiver.h"
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      An optional extension of |DlOpReceiver| for backends that
+///             can render a run of identical-looking geometry with a single
+///             call, for example as an instanced draw.
+///
+/// Each method must produce the same output as the equivalent sequence of
+/// individual draw calls, in order, using the current attributes, transform
+/// and clip. In particular overlapping geometry must blend as though the
+/// elements were drawn one at a time.
+///
+/// Receivers advertise support by returning themselves from
+/// |DlOpReceiver::asBatchedGeometryReceiver|.
+class DlBatchedGeometryReceiver {
+ public:
+  virtual void drawRects(const SkRect rects[], uint32_t count) = 0;
+  virtual void drawRRects(const SkRRect rrects[], uint32_t count) = 0;
+
+ protected:
+  ~DlBatchedGeometryReceiver() = default;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      A |DlOpReceiver| that forwards all calls to another receiver
+///             while coalescing consecutive |drawRect| (or |drawRRect|)
+///             calls into a single |DlBatchedGeometryReceiver| call.
+///
+/// A run is only extended while no other method is called on the receiver,
+/// so all of the elements in a batch share the same attributes, transform
+/// and clip. Any other call flushes the pending run first and is then
+/// forwarded unchanged. Runs shorter than |min_batch_size| are forwarded
+/// as individual draw calls.
+///
+/// If the wrapped receiver does not advertise batching support then every
+/// call is forwarded directly.
+///
+/// Since a |DlOpReceiver| is never told that a dispatch has finished, the
+/// caller must call |Flush| (or destroy this object) after dispatching to it.
+///
+///   DlBatchingOpReceiver batching(dispatcher);
+///   display_list->Dispatch(batching);
+///   batching.Flush();
+class DlBatchingOpReceiver final : public virtual DlOpReceiver {
+ public:
+  // Upper limit on the number of elements in a single batch so that the
+  // pending storage stays bounded for very long runs.
+  static constexpr uint32_t kMaxBatchSize = 4096;
+
+  explicit DlBatchingOpReceiver(DlOpReceiver& receiver,
+                                uint32_t min_batch_size = 2);
+
+  ~DlBatchingOpReceiver();
+
+  /// Emits any pending run to the wrapped receiver.
+  void Flush();
+
+  /// Whether the wrapped receiver accepts batched draws.
+  bool is_batching() const { return batch_receiver_ != nullptr; }
+
+  /// The number of batched calls issued and the total number of elements
+  /// they contained.
+  uint32_t batch_count() const { return batch_count_; }
+  uint32_t batched_element_count() const { return batched_element_count_; }
+
+  void setAntiAlias(bool aa) override;
+  void setDrawStyle(DlDrawStyle style) override;
+  void setColor(DlColor color) override;
+  void setStrokeWidth(float width) override;
+  void setStrokeMiter(float limit) override;
+  void setStrokeCap(DlStrokeCap cap) override;
+  void setStrokeJoin(DlStrokeJoin join) override;
+  void setColorSource(const DlColorSource* source) override;
+  void setColorFilter(const DlColorFilter* filter) override;
+  void setInvertColors(bool invert) override;
+  void setBlendMode(DlBlendMode mode) override;
+  void setPathEffect(const DlPathEffect* effect) override;
+  void setMaskFilter(const DlMaskFilter* filter) override;
+  void setImageFilter(const DlImageFilter* filter) override;
+
+  void save() override;
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override;
+  void restore() override;
+
+  void translate(SkScalar tx, SkScalar ty) override;
+  void scale(SkScalar sx, SkScalar sy) override;
+  void rotate(SkScalar degrees) override;
+  void skew(SkScalar sx, SkScalar sy) override;
+  // clang-format off
+  void transform2DAffine(SkScalar mxx, SkScalar mxy, SkScalar mxt,
+                         SkScalar myx, SkScalar myy, SkScalar myt) override;
+  void transformFullPerspective(
+      SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+      SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+      SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+      SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) override;
+  // clang-format on
+  void transformReset() override;
+
+  void clipRect(const SkRect& rect, ClipOp clip_op, bool is_aa) override;
+  void clipRRect(const SkRRect& rrect, ClipOp clip_op, bool is_aa) override;
+  void clipPath(const SkPath& path, ClipOp clip_op, bool is_aa) override;
+
+  void drawColor(DlColor color, DlBlendMode mode) override;
+  void drawPaint() override;
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override;
+  void drawRect(const SkRect& rect) override;
+  void drawOval(const SkRect& bounds) override;
+  void drawCircle(const SkPoint& center, SkScalar radius) override;
+  void drawRRect(const SkRRect& rrect) override;
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override;
+  void drawPath(const SkPath& path) override;
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override;
+  void drawPoints(PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override;
+  void drawVertices(const DlVertices* vertices, DlBlendMode mode) override;
+  void drawImage(const sk_sp<DlImage> image,
+                 const SkPoint point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override;
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SrcRectConstraint constraint) override;
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override;
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override;
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       SkScalar opacity) override;
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override;
+  void drawTextFrame(const std::shared_ptr<impeller::TextFrame>& text_frame,
+                     SkScalar x,
+                     SkScalar y) override;
+  void drawShadow(const SkPath& path,
+                  const DlColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override;
+
+ private:
+  DlOpReceiver& receiver_;
+  DlBatchedGeometryReceiver* batch_receiver_;
+  const uint32_t min_batch_size_;
+
+  // Only one of these is non-empty at any time.
+  std::vector<SkRect> pending_rects_;
+  std::vector<SkRRect> pending_rrects_;
+
+  uint32_t batch_count_ = 0;
+  uint32_t batched_element_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DlBatchingOpReceiver);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_UTILS_DL_BATCHING_RECEIVER_H_
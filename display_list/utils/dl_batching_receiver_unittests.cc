@@ -0,0 +1,195 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/utils/dl_batching_receiver.h"
+
+#include <string>
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Records a short description of every call it receives.
+class RecordingReceiver : public IgnoreAttributeDispatchHelper,
+                          public IgnoreClipDispatchHelper,
+                          public IgnoreTransformDispatchHelper,
+                          public IgnoreDrawDispatchHelper,
+                          public DlBatchedGeometryReceiver {
+ public:
+  explicit RecordingReceiver(bool supports_batching)
+      : supports_batching_(supports_batching) {}
+
+  DlBatchedGeometryReceiver* asBatchedGeometryReceiver() override {
+    return supports_batching_ ? this : nullptr;
+  }
+
+  void setColor(DlColor color) override { calls.push_back("setColor"); }
+  void translate(SkScalar tx, SkScalar ty) override {
+    calls.push_back("translate");
+  }
+  void save() override { calls.push_back("save"); }
+  void restore() override { calls.push_back("restore"); }
+  void drawRect(const SkRect& rect) override {
+    calls.push_back("drawRect");
+    rects.push_back(rect);
+  }
+  void drawRRect(const SkRRect& rrect) override {
+    calls.push_back("drawRRect");
+  }
+  void drawOval(const SkRect& bounds) override { calls.push_back("drawOval"); }
+
+  void drawRects(const SkRect r[], uint32_t count) override {
+    calls.push_back("drawRects(" + std::to_string(count) + ")");
+    rects.insert(rects.end(), r, r + count);
+  }
+  void drawRRects(const SkRRect rrects[], uint32_t count) override {
+    calls.push_back("drawRRects(" + std::to_string(count) + ")");
+  }
+
+  std::vector<std::string> calls;
+  std::vector<SkRect> rects;
+
+ private:
+  const bool supports_batching_;
+};
+
+std::vector<std::string> Dispatch(const sk_sp<DisplayList>& display_list,
+                                  bool supports_batching,
+                                  uint32_t min_batch_size = 2) {
+  RecordingReceiver receiver(supports_batching);
+  DlBatchingOpReceiver batching(receiver, min_batch_size);
+  EXPECT_EQ(batching.is_batching(), supports_batching);
+  display_list->Dispatch(batching);
+  batching.Flush();
+  return receiver.calls;
+}
+
+}  // namespace
+
+TEST(DisplayListBatchingReceiver, CoalescesSamePaintRects) {
+  DisplayListBuilder builder;
+  DlPaint paint(DlColor::kBlue());
+  for (int i = 0; i < 5; i++) {
+    builder.DrawRect(SkRect::MakeXYWH(i * 10, 0, 5, 5), paint);
+  }
+  auto display_list = builder.Build();
+
+  RecordingReceiver receiver(true);
+  DlBatchingOpReceiver batching(receiver);
+  display_list->Dispatch(batching);
+  // Nothing is emitted for the run until it is flushed.
+  EXPECT_EQ(receiver.calls, std::vector<std::string>({"setColor"}));
+  batching.Flush();
+  EXPECT_EQ(receiver.calls,
+            std::vector<std::string>({"setColor", "drawRects(5)"}));
+  ASSERT_EQ(receiver.rects.size(), 5u);
+  for (int i = 0; i < 5; i++) {
+    EXPECT_EQ(receiver.rects[i], SkRect::MakeXYWH(i * 10, 0, 5, 5));
+  }
+  EXPECT_EQ(batching.batch_count(), 1u);
+  EXPECT_EQ(batching.batched_element_count(), 5u);
+}
+
+TEST(DisplayListBatchingReceiver, StateChangesSplitRuns) {
+  DisplayListBuilder builder;
+  DlPaint blue(DlColor::kBlue());
+  DlPaint red(DlColor::kRed());
+  builder.DrawRect({0, 0, 5, 5}, blue);
+  builder.DrawRect({10, 0, 15, 5}, blue);
+  builder.DrawRect({20, 0, 25, 5}, red);
+  builder.DrawRect({30, 0, 35, 5}, red);
+  builder.Save();
+  builder.Translate(5, 5);
+  builder.DrawRect({0, 0, 5, 5}, red);
+  builder.DrawRect({10, 0, 15, 5}, red);
+  builder.DrawRect({20, 0, 25, 5}, red);
+  builder.Restore();
+  auto display_list = builder.Build();
+
+  EXPECT_EQ(Dispatch(display_list, true),
+            std::vector<std::string>({"setColor", "drawRects(2)", "setColor",
+                                      "drawRects(2)", "save", "translate",
+                                      "drawRects(3)", "restore"}));
+}
+
+TEST(DisplayListBatchingReceiver, OtherDrawsSplitRuns) {
+  DisplayListBuilder builder;
+  DlPaint paint(DlColor::kBlue());
+  SkRRect rrect = SkRRect::MakeRectXY({0, 0, 10, 10}, 2, 2);
+  builder.DrawRect({0, 0, 5, 5}, paint);
+  builder.DrawRect({10, 0, 15, 5}, paint);
+  builder.DrawRRect(rrect, paint);
+  builder.DrawRRect(rrect, paint);
+  builder.DrawRRect(rrect, paint);
+  builder.DrawOval({0, 0, 5, 5}, paint);
+  builder.DrawRect({0, 0, 5, 5}, paint);
+  auto display_list = builder.Build();
+
+  EXPECT_EQ(Dispatch(display_list, true),
+            std::vector<std::string>({"setColor", "drawRects(2)",
+                                      "drawRRects(3)", "drawOval",
+                                      "drawRect"}));
+}
+
+TEST(DisplayListBatchingReceiver, ShortRunsAreForwardedIndividually) {
+  DisplayListBuilder builder;
+  DlPaint paint(DlColor::kBlue());
+  builder.DrawRect({0, 0, 5, 5}, paint);
+  builder.DrawRect({10, 0, 15, 5}, paint);
+  builder.DrawOval({0, 0, 5, 5}, paint);
+  builder.DrawRect({0, 0, 5, 5}, paint);
+  builder.DrawRect({10, 0, 15, 5}, paint);
+  builder.DrawRect({20, 0, 25, 5}, paint);
+  auto display_list = builder.Build();
+
+  EXPECT_EQ(Dispatch(display_list, true, /*min_batch_size=*/3),
+            std::vector<std::string>({"setColor", "drawRect", "drawRect",
+                                      "drawOval", "drawRects(3)"}));
+}
+
+TEST(DisplayListBatchingReceiver, UnsupportedReceiverIsPassedThrough) {
+  DisplayListBuilder builder;
+  DlPaint paint(DlColor::kBlue());
+  builder.DrawRect({0, 0, 5, 5}, paint);
+  builder.DrawRect({10, 0, 15, 5}, paint);
+  builder.DrawRect({20, 0, 25, 5}, paint);
+  auto display_list = builder.Build();
+
+  EXPECT_EQ(Dispatch(display_list, false),
+            std::vector<std::string>(
+                {"setColor", "drawRect", "drawRect", "drawRect"}));
+}
+
+TEST(DisplayListBatchingReceiver, LongRunsAreSplitAtMaxBatchSize) {
+  DisplayListBuilder builder;
+  DlPaint paint(DlColor::kBlue());
+  uint32_t count = DlBatchingOpReceiver::kMaxBatchSize + 10;
+  for (uint32_t i = 0; i < count; i++) {
+    builder.DrawRect(SkRect::MakeXYWH(i, 0, 1, 1), paint);
+  }
+  auto display_list = builder.Build();
+
+  RecordingReceiver receiver(true);
+  {
+    DlBatchingOpReceiver batching(receiver);
+    display_list->Dispatch(batching);
+    // Destruction flushes the final run.
+  }
+  EXPECT_EQ(receiver.calls,
+            std::vector<std::string>(
+                {"setColor",
+                 "drawRects(" +
+                     std::to_string(DlBatchingOpReceiver::kMaxBatchSize) + ")",
+                 "drawRects(10)"}));
+  EXPECT_EQ(receiver.rects.size(), count);
+}
+
+}  // namespace testing
+}  // namespace flutter
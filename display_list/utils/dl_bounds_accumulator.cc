@@ -116,6 +116,16 @@ bool RTreeBoundsAccumulator::restore(
   return success;
 }
 
+void RTreeBoundsAccumulator::RemapIndices(const std::vector<int>& new_indices) {
+  for (int& index : rect_indices_) {
+    // Negative indices are filtered out of the RTree and stay as they are.
+    if (index >= 0) {
+      FML_DCHECK(static_cast<size_t>(index) < new_indices.size());
+      index = new_indices[index];
+    }
+  }
+}
+
 SkRect RTreeBoundsAccumulator::bounds() const {
   FML_DCHECK(saved_offsets_.empty());
   RectBoundsAccumulator accumulator;
@@ -126,9 +136,14 @@ SkRect RTreeBoundsAccumulator::bounds() const {
 }
 
 sk_sp<DlRTree> RTreeBoundsAccumulator::rtree() const {
+  return rtree(nullptr);
+}
+
+sk_sp<DlRTree> RTreeBoundsAccumulator::rtree(const DlRTree* previous) const {
   FML_DCHECK(saved_offsets_.empty());
-  return sk_make_sp<DlRTree>(rects_.data(), rects_.size(), rect_indices_.data(),
-                             [](int id) { return id >= 0; });
+  return sk_make_sp<DlRTree>(
+      rects_.data(), rects_.size(), rect_indices_.data(),
+      [](int id) { return id >= 0; }, -1, previous);
 }
 
 }  // namespace flutter
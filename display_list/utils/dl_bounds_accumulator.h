@@ -157,6 +157,14 @@ class RTreeBoundsAccumulator final : public virtual BoundsAccumulator {
     return BoundsAccumulatorType::kRTree;
   }
 
+  // Replaces every accumulated op index |i| with |new_indices[i]|, used
+  // when the op stream is compacted after the rects were accumulated.
+  void RemapIndices(const std::vector<int>& new_indices);
+
+  // Builds the RTree reusing the unchanged nodes of |previous|, see the
+  // |DlRTree| constructor.
+  sk_sp<DlRTree> rtree(const DlRTree* previous) const;
+
  private:
   std::vector<SkRect> rects_;
   std::vector<int> rect_indices_;
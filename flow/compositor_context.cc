@@ -20,7 +20,7 @@ std::optional<SkRect> FrameDamage::ComputeClipRect(
     DiffContext context(layer_tree.frame_size(), layer_tree.paint_region_map(),
                         prev_layer_tree_ ? prev_layer_tree_->paint_region_map()
                                          : empty_paint_region_map,
-                        has_raster_cache, impeller_enabled);
+                        has_raster_cache, impeller_enabled, texture_registry_);
     context.PushCullRect(SkRect::MakeIWH(layer_tree.frame_size().width(),
                                          layer_tree.frame_size().height()));
     {
@@ -40,7 +40,7 @@ std::optional<SkRect> FrameDamage::ComputeClipRect(
 
     damage_ =
         context.ComputeDamage(additional_damage_, horizontal_clip_alignment_,
-                              vertical_clip_alignment_);
+                              vertical_clip_alignment_, max_damage_rect_count_);
     return SkRect::Make(damage_->buffer_damage);
   }
   return std::nullopt;
@@ -122,6 +122,7 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
 
   std::optional<SkRect> clip_rect;
   if (frame_damage) {
+    frame_damage->SetTextureRegistry(context_.texture_registry().get());
     clip_rect = frame_damage->ComputeClipRect(layer_tree, !ignore_raster_cache,
                                               !gr_context_);
 
@@ -154,6 +155,7 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
     PaintLayerTreeSkia(layer_tree, clip_rect, needs_save_layer,
                        ignore_raster_cache);
   }
+  context_.layer_cost_profiler().FrameFinished();
   return RasterStatus::kSuccess;
 }
 
@@ -11,9 +11,11 @@
 #include "flutter/common/graphics/texture.h"
 #include "flutter/flow/diff_context.h"
 #include "flutter/flow/embedded_views.h"
+#include "flutter/flow/layer_cost_profiler.h"
 #include "flutter/flow/layer_snapshot_store.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/stopwatch.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/raster_thread_merger.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -55,6 +57,12 @@ class FrameDamage {
     prev_layer_tree_ = prev_layer_tree;
   }
 
+  // Sets the registry of the textures that the layer tree paints. Without it,
+  // texture layers are assumed to change on every frame.
+  void SetTextureRegistry(const TextureRegistry* texture_registry) {
+    texture_registry_ = texture_registry;
+  }
+
   // Adds additional damage (accumulated for double / triple buffering).
   // This is area that will be repainted alongside any changed part.
   void AddAdditionalDamage(const SkIRect& damage) {
@@ -67,6 +75,10 @@ class FrameDamage {
     vertical_clip_alignment_ = vertical;
   }
 
+  // Specifies how many rects the damage regions may consist of. The
+  // rendering itself is always clipped to the bounds of the damage.
+  void SetMaxDamageRectCount(size_t count) { max_damage_rect_count_ = count; }
+
   // Calculates clip rect for current rasterization. This is diff of layer tree
   // and previous layer tree + any additional provided damage.
   // If previous layer tree is not specified, clip rect will be nullopt,
@@ -88,6 +100,19 @@ class FrameDamage {
                : std::nullopt;
   }
 
+  // See Damage::frame_damage_region.
+  std::optional<DlRegion> GetFrameDamageRegion() const {
+    return damage_ ? std::make_optional(damage_->frame_damage_region)
+                   : std::nullopt;
+  }
+
+  // See Damage::buffer_damage_region.
+  std::optional<DlRegion> GetBufferDamageRegion() const {
+    return (damage_ && !ignore_damage_)
+               ? std::make_optional(damage_->buffer_damage_region)
+               : std::nullopt;
+  }
+
   // Remove reported buffer_damage to inform clients that a partial repaint
   // should not be performed on this frame.
   // frame_damage is required to correctly track accumulated damage for
@@ -98,8 +123,10 @@ class FrameDamage {
   SkIRect additional_damage_ = SkIRect::MakeEmpty();
   std::optional<Damage> damage_;
   const LayerTree* prev_layer_tree_ = nullptr;
+  const TextureRegistry* texture_registry_ = nullptr;
   int vertical_clip_alignment_ = 1;
   int horizontal_clip_alignment_ = 1;
+  size_t max_damage_rect_count_ = 1;
   bool ignore_damage_ = false;
 };
 
@@ -190,16 +217,45 @@ class CompositorContext {
 
   const Stopwatch& raster_time() const { return raster_time_; }
 
+  // Lets |LayerTree::Preroll| spread work over the workers of
+  // |task_runner|. Passing nullptr prerolls on the raster thread only.
+  void SetConcurrentTaskRunner(
+      std::shared_ptr<fml::ConcurrentTaskRunner> task_runner) {
+    concurrent_task_runner_ = std::move(task_runner);
+  }
+
+  const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner()
+      const {
+    return concurrent_task_runner_;
+  }
+
+  // Lets |BackdropFilterLayer|s reuse their filtered backdrop from the
+  // previous frame while the content behind them is unchanged.
+  void SetBackdropFilterCacheEnabled(bool enabled) {
+    backdrop_filter_cache_enabled_ = enabled;
+  }
+
+  bool backdrop_filter_cache_enabled() const {
+    return backdrop_filter_cache_enabled_;
+  }
+
   Stopwatch& ui_time() { return ui_time_; }
 
   LayerSnapshotStore& snapshot_store() { return layer_snapshot_store_; }
 
+  // Collects the per-layer costs of the frames requested through
+  // |LayerCostProfiler::StartSampling|.
+  LayerCostProfiler& layer_cost_profiler() { return layer_cost_profiler_; }
+
  private:
   RasterCache raster_cache_;
   std::shared_ptr<TextureRegistry> texture_registry_;
   Stopwatch raster_time_;
   Stopwatch ui_time_;
   LayerSnapshotStore layer_snapshot_store_;
+  LayerCostProfiler layer_cost_profiler_;
+  std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
+  bool backdrop_filter_cache_enabled_ = false;
 
   /// Only used by default constructor of `CompositorContext`.
   FixedRefreshRateUpdater fixed_refresh_rate_updater_;
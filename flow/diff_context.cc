@@ -3,6 +3,11 @@
 // found in the LICENSE file.
 
 #include "flutter/flow/diff_context.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "flutter/common/graphics/texture.h"
 #include "flutter/flow/layers/layer.h"
 
 namespace flutter {
@@ -11,14 +16,16 @@ DiffContext::DiffContext(SkISize frame_size,
                          PaintRegionMap& this_frame_paint_region_map,
                          const PaintRegionMap& last_frame_paint_region_map,
                          bool has_raster_cache,
-                         bool impeller_enabled)
+                         bool impeller_enabled,
+                         const TextureRegistry* texture_registry)
     : clip_tracker_(DisplayListMatrixClipTracker(kGiantRect, SkMatrix::I())),
       rects_(std::make_shared<std::vector<SkRect>>()),
       frame_size_(frame_size),
       this_frame_paint_region_map_(this_frame_paint_region_map),
       last_frame_paint_region_map_(last_frame_paint_region_map),
       has_raster_cache_(has_raster_cache),
-      impeller_enabled_(impeller_enabled) {}
+      impeller_enabled_(impeller_enabled),
+      texture_registry_(texture_registry) {}
 
 void DiffContext::BeginSubtree() {
   state_stack_.push_back(state_);
@@ -109,12 +116,77 @@ void DiffContext::AlignRect(SkIRect& rect,
   rect = SkIRect::MakeLTRB(left, top, right, bottom);
 }
 
+// Beyond this many rects the damage region is reduced to its bounds rather
+// than merging rects pairwise.
+static constexpr size_t kMaxDamageRectsToMerge = 64;
+
+static int64_t RectArea(const SkIRect& rect) {
+  return static_cast<int64_t>(rect.width()) * rect.height();
+}
+
+DlRegion DiffContext::ComputeDamageRegion(const std::vector<SkRect>& rects,
+                                          int horizontal_clip_alignment,
+                                          int vertical_clip_alignment,
+                                          size_t max_damage_rect_count) const {
+  SkIRect frame_clip = SkIRect::MakeSize(frame_size_);
+  std::vector<SkIRect> damage_rects;
+  damage_rects.reserve(rects.size());
+  for (const SkRect& rect : rects) {
+    SkIRect damage_rect = rect.roundOut();
+    if (!damage_rect.intersect(frame_clip)) {
+      continue;
+    }
+    if (horizontal_clip_alignment > 1 || vertical_clip_alignment > 1) {
+      AlignRect(damage_rect, horizontal_clip_alignment,
+                vertical_clip_alignment);
+    }
+    damage_rects.push_back(damage_rect);
+  }
+
+  DlRegion region(damage_rects);
+  // Merging two rects may split others when the region is rebuilt, so the
+  // number of rounds is bounded as well.
+  for (size_t round = 0; round < kMaxDamageRectsToMerge; round++) {
+    damage_rects = region.getRects(true);
+    if (damage_rects.size() <= max_damage_rect_count) {
+      return region;
+    }
+    if (damage_rects.size() > kMaxDamageRectsToMerge) {
+      break;
+    }
+    while (damage_rects.size() > max_damage_rect_count) {
+      size_t best_i = 0;
+      size_t best_j = 1;
+      int64_t best_cost = std::numeric_limits<int64_t>::max();
+      for (size_t i = 0; i < damage_rects.size(); i++) {
+        for (size_t j = i + 1; j < damage_rects.size(); j++) {
+          SkIRect merged = damage_rects[i];
+          merged.join(damage_rects[j]);
+          int64_t cost = RectArea(merged) - RectArea(damage_rects[i]) -
+                         RectArea(damage_rects[j]);
+          if (cost < best_cost) {
+            best_cost = cost;
+            best_i = i;
+            best_j = j;
+          }
+        }
+      }
+      damage_rects[best_i].join(damage_rects[best_j]);
+      damage_rects.erase(damage_rects.begin() + best_j);
+    }
+    region = DlRegion(damage_rects);
+  }
+  return DlRegion(region.bounds());
+}
+
 Damage DiffContext::ComputeDamage(const SkIRect& accumulated_buffer_damage,
                                   int horizontal_clip_alignment,
-                                  int vertical_clip_alignment) const {
+                                  int vertical_clip_alignment,
+                                  size_t max_damage_rect_count) const {
   SkRect buffer_damage = SkRect::Make(accumulated_buffer_damage);
   buffer_damage.join(damage_);
   SkRect frame_damage(damage_);
+  std::vector<SkRect> readback_damage_rects;
 
   for (const auto& r : readbacks_) {
     SkRect paint_rect = SkRect::Make(r.paint_rect);
@@ -127,6 +199,8 @@ Damage DiffContext::ComputeDamage(const SkIRect& accumulated_buffer_damage,
       frame_damage.join(paint_rect);
       buffer_damage.join(readback_rect);
       buffer_damage.join(paint_rect);
+      readback_damage_rects.push_back(readback_rect);
+      readback_damage_rects.push_back(paint_rect);
     }
   }
 
@@ -144,6 +218,24 @@ Damage DiffContext::ComputeDamage(const SkIRect& accumulated_buffer_damage,
     AlignRect(res.frame_damage, horizontal_clip_alignment,
               vertical_clip_alignment);
   }
+
+  if (max_damage_rect_count > 1) {
+    std::vector<SkRect> frame_damage_rects(damage_rects_);
+    frame_damage_rects.insert(frame_damage_rects.end(),
+                              readback_damage_rects.begin(),
+                              readback_damage_rects.end());
+    std::vector<SkRect> buffer_damage_rects(frame_damage_rects);
+    buffer_damage_rects.push_back(SkRect::Make(accumulated_buffer_damage));
+    res.frame_damage_region =
+        ComputeDamageRegion(frame_damage_rects, horizontal_clip_alignment,
+                            vertical_clip_alignment, max_damage_rect_count);
+    res.buffer_damage_region =
+        ComputeDamageRegion(buffer_damage_rects, horizontal_clip_alignment,
+                            vertical_clip_alignment, max_damage_rect_count);
+  } else {
+    res.frame_damage_region = DlRegion(res.frame_damage);
+    res.buffer_damage_region = DlRegion(res.buffer_damage);
+  }
   return res;
 }
 
@@ -209,6 +301,18 @@ void DiffContext::MarkSubtreeHasTextureLayer() {
   state_.has_texture = true;
 }
 
+std::optional<uint64_t> DiffContext::GetTextureFrameSequence(
+    int64_t texture_id) const {
+  if (!texture_registry_) {
+    return std::nullopt;
+  }
+  auto texture = texture_registry_->GetTexture(texture_id);
+  if (!texture) {
+    return std::nullopt;
+  }
+  return texture->GetFrameSequence();
+}
+
 void DiffContext::AddExistingPaintRegion(const PaintRegion& region) {
   // Adding paint region for retained layer implies that current subtree is not
   // dirty, so we know, for example, that the inherited transforms must match
@@ -229,6 +333,23 @@ void DiffContext::AddReadbackRegion(const SkIRect& paint_rect,
   readbacks_.push_back(readback);
 }
 
+bool DiffContext::IsDamaged(const SkIRect& rect) const {
+  std::vector<SkRect> damage = damage_rects_;
+  auto intersects_damage = [&damage](const SkIRect& device_rect) {
+    const SkRect bounds = SkRect::Make(device_rect);
+    return std::any_of(
+        damage.begin(), damage.end(),
+        [&bounds](const SkRect& r) { return r.intersects(bounds); });
+  };
+  // Filters that read back damaged content change everywhere they paint.
+  for (const Readback& readback : readbacks_) {
+    if (intersects_damage(readback.readback_rect)) {
+      damage.push_back(SkRect::Make(readback.paint_rect));
+    }
+  }
+  return intersects_damage(rect);
+}
+
 PaintRegion DiffContext::CurrentSubtreeRegion() const {
   bool has_readback = std::any_of(
       readbacks_.begin(), readbacks_.end(),
@@ -240,12 +361,15 @@ PaintRegion DiffContext::CurrentSubtreeRegion() const {
 void DiffContext::AddDamage(const PaintRegion& damage) {
   FML_DCHECK(damage.is_valid());
   for (const auto& r : damage) {
-    damage_.join(r);
+    AddDamage(r);
   }
 }
 
 void DiffContext::AddDamage(const SkRect& rect) {
   damage_.join(rect);
+  if (!rect.isEmpty()) {
+    damage_rects_.push_back(rect);
+  }
 }
 
 void DiffContext::SetLayerPaintRegion(const Layer* layer,
@@ -9,6 +9,7 @@
 #include <map>
 #include <optional>
 #include <vector>
+#include "display_list/geometry/dl_region.h"
 #include "display_list/utils/dl_matrix_clip_tracker.h"
 #include "flutter/flow/paint_region.h"
 #include "flutter/fml/macros.h"
@@ -19,6 +20,7 @@
 namespace flutter {
 
 class Layer;
+class TextureRegistry;
 
 // Represents area that needs to be updated in front buffer (frame_damage) and
 // area that is going to be painted to in back buffer (buffer_damage).
@@ -35,6 +37,12 @@ struct Damage {
   // upfront may be useful for tile based GPUs.
   // Corresponds to "buffer damage" from EGL_KHR_partial_update.
   SkIRect buffer_damage;
+
+  // The same areas as |frame_damage| and |buffer_damage|, covered more
+  // tightly by a limited number of rects, see |DiffContext::ComputeDamage|.
+  // When limited to a single rect these are the rects above.
+  DlRegion frame_damage_region;
+  DlRegion buffer_damage_region;
 };
 
 // Layer Unique Id to PaintRegion
@@ -47,7 +55,8 @@ class DiffContext {
                        PaintRegionMap& this_frame_paint_region_map,
                        const PaintRegionMap& last_frame_paint_region_map,
                        bool has_raster_cache,
-                       bool impeller_enabled);
+                       bool impeller_enabled,
+                       const TextureRegistry* texture_registry = nullptr);
 
   // Starts a new subtree.
   void BeginSubtree();
@@ -111,6 +120,10 @@ class DiffContext {
   // ensure that we'll Diff the TextureLayer even if inside retained layer.
   void MarkSubtreeHasTextureLayer();
 
+  // Returns the frame sequence of the texture with |texture_id|, see
+  // |Texture::GetFrameSequence|, or std::nullopt if the texture is unknown.
+  std::optional<uint64_t> GetTextureFrameSequence(int64_t texture_id) const;
+
   // Add layer bounds to current paint region; rect is in "local" (layer)
   // coordinates.
   void AddLayerBounds(const SkRect& rect);
@@ -130,6 +143,13 @@ class DiffContext {
   void AddReadbackRegion(const SkIRect& paint_rect,
                          const SkIRect& readback_rect);
 
+  // Returns whether any damage added so far intersects |rect| (in screen
+  // coordinates), including the paint rects of the readback regions added so
+  // far that read back damaged content. Layers are diffed in paint order, so
+  // for a layer that reads back the content behind it this tells whether that
+  // content changed within |rect| since the previous frame.
+  bool IsDamaged(const SkIRect& rect) const;
+
   // Returns the paint region for current subtree; Each rect in paint region is
   // in screen coordinates; Once a layer accumulates the paint regions of its
   // children, this PaintRegion value can be associated with the current layer
@@ -143,9 +163,14 @@ class DiffContext {
   //
   // clip_alignment controls the alignment of resulting frame and surface
   // damage.
+  //
+  // max_damage_rect_count limits the number of rects in the damage regions.
+  // Separate changes are merged into fewer rects as needed, always merging
+  // the two rects that result in the least additional damage.
   Damage ComputeDamage(const SkIRect& additional_damage,
                        int horizontal_clip_alignment = 0,
-                       int vertical_clip_alignment = 0) const;
+                       int vertical_clip_alignment = 0,
+                       size_t max_damage_rect_count = 1) const;
 
   // Adds the region to current damage. Used for removed layers, where instead
   // of diffing the layer its paint region is direcly added to damage.
@@ -249,10 +274,14 @@ class DiffContext {
 
   SkRect damage_ = SkRect::MakeEmpty();
 
+  // The individual rects joined into damage_.
+  std::vector<SkRect> damage_rects_;
+
   PaintRegionMap& this_frame_paint_region_map_;
   const PaintRegionMap& last_frame_paint_region_map_;
   bool has_raster_cache_;
   bool impeller_enabled_;
+  const TextureRegistry* texture_registry_;
 
   void AddDamage(const SkRect& rect);
 
@@ -260,6 +289,11 @@ class DiffContext {
                  int horizontal_alignment,
                  int vertical_clip_alignment) const;
 
+  DlRegion ComputeDamageRegion(const std::vector<SkRect>& rects,
+                               int horizontal_clip_alignment,
+                               int vertical_clip_alignment,
+                               size_t max_damage_rect_count) const;
+
   struct Readback {
     // Index of rects_ entry that this readback belongs to. Used to
     // determine if subtree has any readback
@@ -32,5 +32,63 @@ TEST_F(DiffContextTest, ClipAlignment) {
   EXPECT_EQ(damage.buffer_damage, SkIRect::MakeLTRB(16, 16, 64, 64));
 }
 
+TEST_F(DiffContextTest, IsDamaged) {
+  PaintRegionMap this_frame_paint_region_map;
+  PaintRegionMap last_frame_paint_region_map;
+  DiffContext context(SkISize::Make(100, 100), this_frame_paint_region_map,
+                      last_frame_paint_region_map, false, false);
+  EXPECT_FALSE(context.IsDamaged(SkIRect::MakeWH(100, 100)));
+
+  {
+    DiffContext::AutoSubtreeRestore subtree(&context);
+    context.MarkSubtreeDirty(SkRect::MakeLTRB(0, 0, 10, 10));
+  }
+  EXPECT_TRUE(context.IsDamaged(SkIRect::MakeLTRB(5, 5, 20, 20)));
+  EXPECT_FALSE(context.IsDamaged(SkIRect::MakeLTRB(20, 20, 30, 30)));
+
+  // A filter that reads back damaged content damages all of its paint rect.
+  context.AddReadbackRegion(SkIRect::MakeLTRB(20, 20, 30, 30),
+                            SkIRect::MakeLTRB(0, 0, 30, 30));
+  EXPECT_TRUE(context.IsDamaged(SkIRect::MakeLTRB(25, 25, 40, 40)));
+  EXPECT_FALSE(context.IsDamaged(SkIRect::MakeLTRB(40, 40, 50, 50)));
+}
+
+TEST_F(DiffContextTest, DamageRegion) {
+  MockLayerTree t1;
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(0, 0, 10, 10))));
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(90, 90, 100, 100))));
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(12, 0, 20, 10))));
+  const SkIRect additional_damage = SkIRect::MakeLTRB(50, 0, 60, 10);
+
+  auto damage = DiffLayerTree(t1, MockLayerTree(), additional_damage);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 100, 100));
+  EXPECT_EQ(damage.frame_damage_region.getRects(),
+            std::vector<SkIRect>{damage.frame_damage});
+  EXPECT_EQ(damage.buffer_damage_region.getRects(),
+            std::vector<SkIRect>{damage.buffer_damage});
+
+  // The two close rects are merged first.
+  damage = DiffLayerTree(t1, MockLayerTree(), additional_damage, 0, 0, true,
+                         false, 2);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 100, 100));
+  EXPECT_EQ(damage.frame_damage_region.getRects(),
+            (std::vector<SkIRect>{SkIRect::MakeLTRB(0, 0, 20, 10),
+                                  SkIRect::MakeLTRB(90, 90, 100, 100)}));
+  EXPECT_EQ(damage.buffer_damage_region.getRects(),
+            (std::vector<SkIRect>{SkIRect::MakeLTRB(0, 0, 60, 10),
+                                  SkIRect::MakeLTRB(90, 90, 100, 100)}));
+
+  damage = DiffLayerTree(t1, MockLayerTree(), additional_damage, 0, 0, true,
+                         false, 4);
+  EXPECT_EQ(damage.frame_damage_region.getRects(),
+            (std::vector<SkIRect>{SkIRect::MakeLTRB(0, 0, 10, 10),
+                                  SkIRect::MakeLTRB(12, 0, 20, 10),
+                                  SkIRect::MakeLTRB(90, 90, 100, 100)}));
+  EXPECT_EQ(damage.buffer_damage_region.getRects().size(), 4u);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -6,10 +6,15 @@
 
 namespace flutter {
 
-DisplayListEmbedderViewSlice::DisplayListEmbedderViewSlice(SkRect view_bounds) {
+DisplayListEmbedderViewSlice::DisplayListEmbedderViewSlice(
+    SkRect view_bounds,
+    const DisplayListEmbedderViewSlice* previous) {
   builder_ = std::make_unique<DisplayListBuilder>(
       /*bounds=*/view_bounds,
       /*prepare_rtree=*/true);
+  if (previous && previous->display_list_) {
+    builder_->SetRTreeHint(previous->display_list_);
+  }
 }
 
 DlCanvas* DisplayListEmbedderViewSlice::canvas() {
@@ -53,6 +58,10 @@ bool ExternalViewEmbedder::SupportsDynamicThreadMerging() {
   return false;
 }
 
+bool ExternalViewEmbedder::SupportsFrameDamage() {
+  return false;
+}
+
 void ExternalViewEmbedder::Teardown() {}
 
 void MutatorsStack::PushClipRect(const SkRect& rect) {
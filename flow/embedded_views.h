@@ -348,7 +348,12 @@ class EmbedderViewSlice {
 
 class DisplayListEmbedderViewSlice : public EmbedderViewSlice {
  public:
-  explicit DisplayListEmbedderViewSlice(SkRect view_bounds);
+  // If the |previous| slice recorded for the same view on the last frame
+  // is supplied, its RTree is used as a hint to speed up building the
+  // RTree for this slice, see |DisplayListBuilder::SetRTreeHint|.
+  explicit DisplayListEmbedderViewSlice(
+      SkRect view_bounds,
+      const DisplayListEmbedderViewSlice* previous = nullptr);
   ~DisplayListEmbedderViewSlice() override = default;
 
   DlCanvas* canvas() override;
@@ -471,6 +476,15 @@ class ExternalViewEmbedder {
   // |RasterThreadMerger| instance.
   virtual bool SupportsDynamicThreadMerging();
 
+  // Whether the embedder uses the damage of the frame passed to
+  // |SubmitFlutterView| even though it repaints the frame entirely.
+  //
+  // Returning `true` results in the rasterizer diffing every frame against the
+  // previous one and reporting the result in the frame's
+  // |SurfaceFrame::SubmitInfo::frame_damage_region|, without clipping the
+  // rendering to it.
+  virtual bool SupportsFrameDamage();
+
   // Called when the rasterizer is being torn down.
   // This method provides a way to release resources associated with the current
   // embedder.
@@ -0,0 +1,39 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layer_cost_profiler.h"
+
+namespace flutter {
+
+void LayerCostProfiler::StartSampling(size_t frame_count) {
+  report_.clear();
+  sampled_frames_ = 0;
+  requested_frames_ = frame_count;
+}
+
+void LayerCostProfiler::FrameFinished() {
+  if (is_sampling()) {
+    sampled_frames_++;
+  }
+}
+
+void LayerCostProfiler::AddPreroll(uint64_t layer_unique_id,
+                                   fml::TimeDelta duration) {
+  LayerCost& cost = report_[layer_unique_id];
+  cost.preroll_time = cost.preroll_time + duration;
+  cost.preroll_count++;
+}
+
+void LayerCostProfiler::AddPaint(uint64_t layer_unique_id,
+                                 fml::TimeDelta duration,
+                                 size_t raster_cache_hits,
+                                 size_t offscreen_count) {
+  LayerCost& cost = report_[layer_unique_id];
+  cost.paint_time = cost.paint_time + duration;
+  cost.paint_count++;
+  cost.raster_cache_hits += raster_cache_hits;
+  cost.offscreen_count += offscreen_count;
+}
+
+}  // namespace flutter
@@ -0,0 +1,74 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYER_COST_PROFILER_H_
+#define FLUTTER_FLOW_LAYER_COST_PROFILER_H_
+
+#include <cstdint>
+#include <map>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+/// Accumulates the raster thread cost of each layer, keyed by the layer's
+/// unique id, over a requested number of frames.
+///
+/// The times recorded for a layer include the time spent in its children, so
+/// the cost of a subtree can be read off its root without walking the tree.
+/// All methods must be called on the raster thread.
+class LayerCostProfiler {
+ public:
+  struct LayerCost {
+    fml::TimeDelta preroll_time;
+    fml::TimeDelta paint_time;
+    size_t preroll_count = 0;
+    size_t paint_count = 0;
+    /// The number of raster cache images drawn by the layer and its children.
+    size_t raster_cache_hits = 0;
+    /// The number of offscreen layers pushed by the layer and its children.
+    size_t offscreen_count = 0;
+  };
+
+  typedef std::map<uint64_t, LayerCost> Report;
+
+  LayerCostProfiler() = default;
+
+  ~LayerCostProfiler() = default;
+
+  /// Discards the previous report and samples the next `frame_count` frames.
+  /// A `frame_count` of zero stops sampling.
+  void StartSampling(size_t frame_count);
+
+  /// Whether the current frame should be measured.
+  bool is_sampling() const { return sampled_frames_ < requested_frames_; }
+
+  /// Marks the end of a measured frame.
+  void FrameFinished();
+
+  void AddPreroll(uint64_t layer_unique_id, fml::TimeDelta duration);
+
+  void AddPaint(uint64_t layer_unique_id,
+                fml::TimeDelta duration,
+                size_t raster_cache_hits,
+                size_t offscreen_count);
+
+  const Report& report() const { return report_; }
+
+  size_t sampled_frames() const { return sampled_frames_; }
+
+  size_t requested_frames() const { return requested_frames_; }
+
+ private:
+  Report report_;
+  size_t sampled_frames_ = 0;
+  size_t requested_frames_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerCostProfiler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYER_COST_PROFILER_H_
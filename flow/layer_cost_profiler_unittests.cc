@@ -0,0 +1,73 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layer_cost_profiler.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(LayerCostProfiler, IsNotSamplingByDefault) {
+  LayerCostProfiler profiler;
+  EXPECT_FALSE(profiler.is_sampling());
+  EXPECT_EQ(profiler.requested_frames(), 0u);
+  EXPECT_EQ(profiler.sampled_frames(), 0u);
+  EXPECT_TRUE(profiler.report().empty());
+}
+
+TEST(LayerCostProfiler, SamplesRequestedFrameCount) {
+  LayerCostProfiler profiler;
+  profiler.StartSampling(2);
+  EXPECT_TRUE(profiler.is_sampling());
+  profiler.FrameFinished();
+  EXPECT_TRUE(profiler.is_sampling());
+  profiler.FrameFinished();
+  EXPECT_FALSE(profiler.is_sampling());
+  profiler.FrameFinished();
+  EXPECT_EQ(profiler.sampled_frames(), 2u);
+  EXPECT_EQ(profiler.requested_frames(), 2u);
+}
+
+TEST(LayerCostProfiler, AccumulatesCostsPerLayer) {
+  LayerCostProfiler profiler;
+  profiler.StartSampling(2);
+  profiler.AddPreroll(1, fml::TimeDelta::FromMicroseconds(10));
+  profiler.AddPaint(1, fml::TimeDelta::FromMicroseconds(20), 1, 0);
+  profiler.AddPreroll(2, fml::TimeDelta::FromMicroseconds(5));
+  profiler.FrameFinished();
+  profiler.AddPreroll(1, fml::TimeDelta::FromMicroseconds(30));
+  profiler.AddPaint(1, fml::TimeDelta::FromMicroseconds(40), 2, 3);
+  profiler.FrameFinished();
+
+  const LayerCostProfiler::Report& report = profiler.report();
+  ASSERT_EQ(report.size(), 2u);
+  const LayerCostProfiler::LayerCost& cost1 = report.at(1);
+  EXPECT_EQ(cost1.preroll_time, fml::TimeDelta::FromMicroseconds(40));
+  EXPECT_EQ(cost1.paint_time, fml::TimeDelta::FromMicroseconds(60));
+  EXPECT_EQ(cost1.preroll_count, 2u);
+  EXPECT_EQ(cost1.paint_count, 2u);
+  EXPECT_EQ(cost1.raster_cache_hits, 3u);
+  EXPECT_EQ(cost1.offscreen_count, 3u);
+  const LayerCostProfiler::LayerCost& cost2 = report.at(2);
+  EXPECT_EQ(cost2.preroll_time, fml::TimeDelta::FromMicroseconds(5));
+  EXPECT_EQ(cost2.paint_count, 0u);
+}
+
+TEST(LayerCostProfiler, StartSamplingDiscardsPreviousReport) {
+  LayerCostProfiler profiler;
+  profiler.StartSampling(1);
+  profiler.AddPreroll(1, fml::TimeDelta::FromMicroseconds(10));
+  profiler.FrameFinished();
+  profiler.StartSampling(3);
+  EXPECT_TRUE(profiler.report().empty());
+  EXPECT_EQ(profiler.sampled_frames(), 0u);
+  EXPECT_EQ(profiler.requested_frames(), 3u);
+
+  profiler.StartSampling(0);
+  EXPECT_FALSE(profiler.is_sampling());
+}
+
+}  // namespace testing
+}  // namespace flutter
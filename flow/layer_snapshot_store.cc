@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layer_snapshot_store.h"
 
+#include <algorithm>
+
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 
@@ -18,12 +20,40 @@ LayerSnapshotData::LayerSnapshotData(int64_t layer_unique_id,
       snapshot_(snapshot),
       bounds_(bounds) {}
 
+static size_t GetSnapshotBytes(const LayerSnapshotData& data) {
+  sk_sp<SkData> snapshot = data.GetSnapshot();
+  return snapshot ? snapshot->size() : 0;
+}
+
 void LayerSnapshotStore::Clear() {
   layer_snapshots_.clear();
+  snapshot_bytes_ = 0;
+}
+
+void LayerSnapshotStore::SetBudget(size_t max_snapshots, size_t max_bytes) {
+  max_snapshots_ = max_snapshots;
+  max_bytes_ = max_bytes;
+  while (IsOverBudget()) {
+    auto cheapest = std::min_element(
+        layer_snapshots_.begin(), layer_snapshots_.end(),
+        [](const LayerSnapshotData& a, const LayerSnapshotData& b) {
+          return a.GetDuration() < b.GetDuration();
+        });
+    snapshot_bytes_ -= GetSnapshotBytes(*cheapest);
+    layer_snapshots_.erase(cheapest);
+  }
 }
 
 void LayerSnapshotStore::Add(const LayerSnapshotData& data) {
+  const size_t bytes = GetSnapshotBytes(data);
+  if (bytes > max_bytes_) {
+    return;
+  }
   layer_snapshots_.push_back(data);
+  snapshot_bytes_ += bytes;
+  if (IsOverBudget()) {
+    SetBudget(max_snapshots_, max_bytes_);
+  }
 }
 
 }  // namespace flutter
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FLOW_LAYER_SNAPSHOT_STORE_H_
 #define FLUTTER_FLOW_LAYER_SNAPSHOT_STORE_H_
 
+#include <limits>
 #include <vector>
 
 #include "flutter/fml/logging.h"
@@ -36,37 +37,60 @@ class LayerSnapshotData {
   SkRect GetBounds() const { return bounds_; }
 
  private:
-  const int64_t layer_unique_id_;
-  const fml::TimeDelta duration_;
-  const sk_sp<SkData> snapshot_;
-  const SkRect bounds_;
+  int64_t layer_unique_id_;
+  fml::TimeDelta duration_;
+  sk_sp<SkData> snapshot_;
+  SkRect bounds_;
 };
 
 /// Collects snapshots of layers during frame rasterization.
+///
+/// By default every snapshot is kept. With a budget set through `SetBudget`
+/// the store only keeps the snapshots of the layers that took the longest to
+/// rasterize, as many as fit the budget.
 class LayerSnapshotStore {
  public:
   typedef std::vector<LayerSnapshotData> Snapshots;
 
+  static constexpr size_t kUnlimited = std::numeric_limits<size_t>::max();
+
   LayerSnapshotStore() = default;
 
   ~LayerSnapshotStore() = default;
 
-  /// Clears all the stored snapshots.
+  /// Clears all the stored snapshots. The budget is kept.
   void Clear();
 
+  /// Limits the store to `max_snapshots` snapshots whose encoded images take
+  /// at most `max_bytes` in total, dropping the cheapest snapshots to fit.
+  void SetBudget(size_t max_snapshots, size_t max_bytes);
+
   /// Adds snapshots for a given layer. `duration` marks the time taken to
-  /// rasterize this one layer.
+  /// rasterize this one layer. If the store is over its budget afterwards,
+  /// the snapshots with the shortest durations are dropped, which may be
+  /// this one. Snapshots larger than the whole byte budget are ignored.
   void Add(const LayerSnapshotData& data);
 
   // Returns the number of snapshots collected.
   size_t Size() const { return layer_snapshots_.size(); }
 
+  // Returns the size of the encoded images of the snapshots collected.
+  size_t SnapshotBytes() const { return snapshot_bytes_; }
+
   // make this class iterable
   Snapshots::iterator begin() { return layer_snapshots_.begin(); }
   Snapshots::iterator end() { return layer_snapshots_.end(); }
 
  private:
+  bool IsOverBudget() const {
+    return layer_snapshots_.size() > max_snapshots_ ||
+           snapshot_bytes_ > max_bytes_;
+  }
+
   Snapshots layer_snapshots_;
+  size_t snapshot_bytes_ = 0;
+  size_t max_snapshots_ = kUnlimited;
+  size_t max_bytes_ = kUnlimited;
 
   FML_DISALLOW_COPY_AND_ASSIGN(LayerSnapshotStore);
 };
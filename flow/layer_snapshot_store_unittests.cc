@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layer_snapshot_store.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static LayerSnapshotData MakeSnapshot(int64_t id,
+                                      int64_t duration_micros,
+                                      size_t bytes) {
+  return LayerSnapshotData(
+      id, fml::TimeDelta::FromMicroseconds(duration_micros),
+      SkData::MakeUninitialized(bytes), SkRect::MakeWH(10, 10));
+}
+
+static std::vector<int64_t> StoredIds(LayerSnapshotStore& store) {
+  std::vector<int64_t> ids;
+  for (const LayerSnapshotData& data : store) {
+    ids.push_back(data.GetLayerUniqueId());
+  }
+  return ids;
+}
+
+TEST(LayerSnapshotStore, KeepsEverySnapshotWithoutBudget) {
+  LayerSnapshotStore store;
+  store.Add(MakeSnapshot(1, 30, 100));
+  store.Add(MakeSnapshot(2, 10, 100));
+  store.Add(MakeSnapshot(3, 20, 100));
+  EXPECT_EQ(StoredIds(store), (std::vector<int64_t>{1, 2, 3}));
+  EXPECT_EQ(store.SnapshotBytes(), 300u);
+
+  store.Clear();
+  EXPECT_EQ(store.Size(), 0u);
+  EXPECT_EQ(store.SnapshotBytes(), 0u);
+}
+
+TEST(LayerSnapshotStore, KeepsMostExpensiveSnapshotsWithinCount) {
+  LayerSnapshotStore store;
+  store.SetBudget(2, LayerSnapshotStore::kUnlimited);
+  store.Add(MakeSnapshot(1, 30, 100));
+  store.Add(MakeSnapshot(2, 10, 100));
+  store.Add(MakeSnapshot(3, 20, 100));
+  EXPECT_EQ(StoredIds(store), (std::vector<int64_t>{1, 3}));
+
+  // A cheaper snapshot than every stored one is dropped right away.
+  store.Add(MakeSnapshot(4, 5, 100));
+  EXPECT_EQ(StoredIds(store), (std::vector<int64_t>{1, 3}));
+  EXPECT_EQ(store.SnapshotBytes(), 200u);
+}
+
+TEST(LayerSnapshotStore, KeepsMostExpensiveSnapshotsWithinBytes) {
+  LayerSnapshotStore store;
+  store.SetBudget(LayerSnapshotStore::kUnlimited, 250);
+  store.Add(MakeSnapshot(1, 30, 100));
+  store.Add(MakeSnapshot(2, 10, 100));
+  store.Add(MakeSnapshot(3, 20, 100));
+  EXPECT_EQ(StoredIds(store), (std::vector<int64_t>{1, 3}));
+  EXPECT_EQ(store.SnapshotBytes(), 200u);
+
+  // Snapshots larger than the whole budget are never kept.
+  store.Add(MakeSnapshot(4, 50, 300));
+  EXPECT_EQ(StoredIds(store), (std::vector<int64_t>{1, 3}));
+}
+
+TEST(LayerSnapshotStore, SetBudgetTrimsStoredSnapshots) {
+  LayerSnapshotStore store;
+  store.Add(MakeSnapshot(1, 30, 100));
+  store.Add(MakeSnapshot(2, 10, 100));
+  store.Add(MakeSnapshot(3, 20, 100));
+  store.SetBudget(1, LayerSnapshotStore::kUnlimited);
+  EXPECT_EQ(StoredIds(store), (std::vector<int64_t>{1}));
+
+  // Clearing keeps the budget.
+  store.Clear();
+  store.Add(MakeSnapshot(2, 10, 100));
+  store.Add(MakeSnapshot(3, 20, 100));
+  EXPECT_EQ(StoredIds(store), (std::vector<int64_t>{3}));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,6 +4,11 @@
 
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 
+#include "flutter/display_list/skia/dl_sk_canvas.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/ganesh/SkSurfaceGanesh.h"
+
 namespace flutter {
 
 BackdropFilterLayer::BackdropFilterLayer(
@@ -25,6 +30,7 @@ void BackdropFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
   auto paint_bounds = context->GetCullRect();
   context->AddLayerBounds(paint_bounds);
 
+  backdrop_is_unchanged_ = false;
   if (filter_) {
     paint_bounds = context->MapRect(paint_bounds);
     auto filter_target_bounds = paint_bounds.roundOut();
@@ -32,6 +38,13 @@ void BackdropFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
     filter_->get_input_device_bounds(
         filter_target_bounds, context->GetTransform3x3(), filter_input_bounds);
     context->AddReadbackRegion(filter_target_bounds, filter_input_bounds);
+
+    // Everything behind this layer has been diffed by now.
+    backdrop_is_unchanged_ = prev && !context->IsSubtreeDirty() &&
+                             !context->IsDamaged(filter_input_bounds);
+  }
+  if (prev && prev != this) {
+    cached_backdrop_ = prev->cached_backdrop_;
   }
 
   DiffChildren(context, prev);
@@ -46,6 +59,9 @@ void BackdropFilterLayer::Preroll(PrerollContext* context) {
     context->view_embedder->PushFilterToVisitedPlatformViews(
         filter_, context->state_stack.device_cull_rect());
   }
+  // Frames that are not diffed can not tell whether the backdrop changed.
+  can_reuse_cached_backdrop_ = backdrop_is_unchanged_;
+  backdrop_is_unchanged_ = false;
   SkRect child_paint_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, &child_paint_bounds);
   child_paint_bounds.join(context->state_stack.local_cull_rect());
@@ -57,9 +73,105 @@ void BackdropFilterLayer::Paint(PaintContext& context) const {
   FML_DCHECK(needs_painting(context));
 
   auto mutator = context.state_stack.save();
-  mutator.applyBackdropFilter(paint_bounds(), filter_, blend_mode_);
+  // Reading back and filtering into an offscreen surface costs more than
+  // filtering directly, so only a backdrop that |Diff| found unchanged since
+  // the previous frame is worth caching.
+  if (!can_reuse_cached_backdrop_) {
+    cached_backdrop_.reset();
+  }
+  if (!can_reuse_cached_backdrop_ || !context.backdrop_filter_cache_enabled ||
+      !filter_ || context.rendering_above_platform_view ||
+      !ApplyCachedBackdrop(context, mutator)) {
+    mutator.applyBackdropFilter(paint_bounds(), filter_, blend_mode_);
+  }
 
   PaintChildren(context);
 }
 
+bool BackdropFilterLayer::ApplyCachedBackdrop(
+    PaintContext& context,
+    LayerStateStack::MutatorContext& mutator) const {
+  // Content inside open offscreen layers has not reached the surface yet.
+  if (context.state_stack.has_open_offscreen_layer()) {
+    return false;
+  }
+  SkRect device_rect =
+      context.state_stack.transform_3x3().mapRect(paint_bounds());
+  if (!device_rect.intersect(context.state_stack.device_cull_rect())) {
+    return false;
+  }
+  const SkIRect device_bounds = device_rect.roundOut();
+
+  if (!cached_backdrop_ || !cached_backdrop_->image ||
+      cached_backdrop_->device_bounds != device_bounds ||
+      cached_backdrop_->gr_context != context.gr_context ||
+      (context.gr_context && context.gr_context->abandoned())) {
+    if (!cached_backdrop_) {
+      cached_backdrop_ = std::make_shared<CachedBackdrop>();
+    }
+    cached_backdrop_->image = FilterBackdrop(context, device_bounds);
+    cached_backdrop_->device_bounds = device_bounds;
+    cached_backdrop_->gr_context = context.gr_context;
+    if (!cached_backdrop_->image) {
+      return false;
+    }
+  }
+
+  // Without a filter the layer starts out empty, and the filtered backdrop
+  // is drawn into it instead.
+  mutator.applyBackdropFilter(paint_bounds(), nullptr, blend_mode_);
+  DlAutoCanvasRestore restore(context.canvas, true);
+  context.canvas->TransformReset();
+  context.canvas->DrawImage(
+      cached_backdrop_->image,
+      SkPoint::Make(device_bounds.left(), device_bounds.top()),
+      DlImageSampling::kNearestNeighbor);
+  return true;
+}
+
+sk_sp<DlImage> BackdropFilterLayer::FilterBackdrop(
+    const PaintContext& context,
+    const SkIRect& device_bounds) const {
+  TRACE_EVENT0("flutter", "BackdropFilterLayer::FilterBackdrop");
+  const SkMatrix matrix = context.state_stack.transform_3x3();
+  SkIRect input_bounds;
+  if (!filter_->get_input_device_bounds(device_bounds, matrix, input_bounds) ||
+      !input_bounds.intersect(
+          SkIRect::MakeSize(context.canvas->GetBaseLayerSize()))) {
+    return nullptr;
+  }
+  sk_sp<DlImage> backdrop = context.canvas->SnapshotSurface(input_bounds);
+  if (!backdrop) {
+    return nullptr;
+  }
+
+  const SkImageInfo image_info = SkImageInfo::MakeN32Premul(
+      input_bounds.width(), input_bounds.height(), context.dst_color_space);
+  sk_sp<SkSurface> surface =
+      context.gr_context
+          ? SkSurfaces::RenderTarget(context.gr_context, skgpu::Budgeted::kYes,
+                                     image_info)
+          : SkSurfaces::Raster(image_info);
+  if (!surface) {
+    return nullptr;
+  }
+
+  // Apply the filter the same way |Paint| would, replacing the unfiltered
+  // pixels with the result.
+  DlSkCanvasAdapter canvas(surface->getCanvas());
+  canvas.Clear(DlColor::kTransparent());
+  canvas.DrawImage(backdrop, SkPoint::Make(0, 0),
+                   DlImageSampling::kNearestNeighbor);
+  canvas.Translate(-input_bounds.left(), -input_bounds.top());
+  canvas.Transform(matrix);
+  DlPaint paint;
+  paint.setBlendMode(DlBlendMode::kSrc);
+  canvas.SaveLayer(&paint_bounds(), &paint, filter_.get());
+  canvas.Restore();
+
+  sk_sp<SkImage> filtered = surface->makeImageSnapshot(
+      device_bounds.makeOffset(-input_bounds.left(), -input_bounds.top()));
+  return filtered ? DlImage::Make(std::move(filtered)) : nullptr;
+}
+
 }  // namespace flutter
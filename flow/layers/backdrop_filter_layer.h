@@ -5,6 +5,8 @@
 #ifndef FLUTTER_FLOW_LAYERS_BACKDROP_FILTER_LAYER_H_
 #define FLUTTER_FLOW_LAYERS_BACKDROP_FILTER_LAYER_H_
 
+#include <memory>
+
 #include "flutter/flow/layers/container_layer.h"
 #include "third_party/skia/include/core/SkImageFilter.h"
 
@@ -22,9 +24,37 @@ class BackdropFilterLayer : public ContainerLayer {
   void Paint(PaintContext& context) const override;
 
  private:
+  // The filtered backdrop of an earlier frame, see
+  // |PaintContext::backdrop_filter_cache_enabled|.
+  struct CachedBackdrop {
+    sk_sp<DlImage> image;
+    // The rect covered by |image|, in screen coordinates.
+    SkIRect device_bounds;
+    GrDirectContext* gr_context = nullptr;
+  };
+
+  // Applies the filtered backdrop from |cached_backdrop_|, filtering the
+  // backdrop into it first unless the cached one matches this frame. Only
+  // called when |Diff| found the backdrop unchanged. Returns false if the
+  // backdrop can not be cached, in which case nothing was applied.
+  bool ApplyCachedBackdrop(PaintContext& context,
+                           LayerStateStack::MutatorContext& mutator) const;
+
+  // Reads back and filters the content behind this layer within
+  // |device_bounds|, which must be inside the device cull rect.
+  sk_sp<DlImage> FilterBackdrop(const PaintContext& context,
+                                const SkIRect& device_bounds) const;
+
   std::shared_ptr<const DlImageFilter> filter_;
   DlBlendMode blend_mode_;
 
+  // Set by |Diff| when neither the filter nor the content it reads changed
+  // since the previous frame, and handed on to |Paint| by |Preroll|.
+  bool backdrop_is_unchanged_ = false;
+  bool can_reuse_cached_backdrop_ = false;
+  // Shared with the layer that replaces this one in the next frame.
+  mutable std::shared_ptr<CachedBackdrop> cached_backdrop_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(BackdropFilterLayer);
 };
 
@@ -5,12 +5,15 @@
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 #include "flutter/flow/layers/clip_rect_layer.h"
 
+#include "flutter/display_list/skia/dl_sk_canvas.h"
 #include "flutter/flow/layers/clip_rect_layer.h"
 #include "flutter/flow/layers/transform_layer.h"
 #include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
 #include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 namespace testing {
@@ -143,6 +146,50 @@ TEST_F(BackdropFilterLayerTest, SimpleFilter) {
   EXPECT_TRUE(DisplayListsEQ_Verbose(display_list(), expected_builder.Build()));
 }
 
+TEST_F(BackdropFilterLayerTest, CachedBackdropNeedsReadableSurface) {
+  const SkRect child_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
+  const SkPath child_path = SkPath().addRect(child_bounds);
+  const DlPaint child_paint = DlPaint(DlColor::kYellow());
+  auto layer_filter =
+      std::make_shared<DlBlurImageFilter>(2.5, 3.2, DlTileMode::kClamp);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  auto layer = std::make_shared<BackdropFilterLayer>(layer_filter,
+                                                     DlBlendMode::kSrcOver);
+  layer->Add(mock_layer);
+  auto parent = std::make_shared<ClipRectLayer>(child_bounds, Clip::kHardEdge);
+  parent->Add(layer);
+
+  parent->Preroll(preroll_context());
+
+  // A DisplayList can not be read back, so the filter is recorded as usual.
+  display_list_paint_context().backdrop_filter_cache_enabled = true;
+  parent->Paint(display_list_paint_context());
+  DisplayListBuilder expected_builder;
+  /* (ClipRect)parent::Paint */ {
+    expected_builder.Save();
+    {
+      expected_builder.ClipRect(child_bounds, DlCanvas::ClipOp::kIntersect,
+                                false);
+      /* (BackdropFilter)layer::Paint */ {
+        expected_builder.Save();
+        {
+          expected_builder.SaveLayer(&child_bounds, nullptr,
+                                     layer_filter.get());
+          {
+            /* mock_layer::Paint */ {
+              expected_builder.DrawPath(child_path, child_paint);
+            }
+          }
+          expected_builder.Restore();
+        }
+        expected_builder.Restore();
+      }
+    }
+    expected_builder.Restore();
+  }
+  EXPECT_TRUE(DisplayListsEQ_Verbose(display_list(), expected_builder.Build()));
+}
+
 TEST_F(BackdropFilterLayerTest, NonSrcOverBlend) {
   const SkMatrix initial_transform = SkMatrix::Translate(0.5f, 1.0f);
   const SkRect child_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
@@ -532,5 +579,82 @@ TEST_F(BackdropLayerDiffTest, BackdropLayerInvalidTransform) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeWH(100, 100));
 }
 
+TEST_F(BackdropLayerDiffTest, CachedBackdropIsOnlyUsedWhileUnchanged) {
+  const SkRect clip_bounds = SkRect::MakeLTRB(10, 10, 30, 30);
+  // The filtered backdrop is blue wherever the backdrop is opaque, so a frame
+  // that clears its backdrop shows whether the cached backdrop was drawn.
+  auto layer_filter = DlColorFilterImageFilter::Make(
+      DlBlendColorFilter::Make(DlColor::kBlue(), DlBlendMode::kSrcIn));
+  auto layer = std::make_shared<BackdropFilterLayer>(layer_filter,
+                                                     DlBlendMode::kSrcOver);
+  layer->Add(
+      std::make_shared<MockLayer>(SkPath().addRect(0, 0, 5, 5), DlPaint()));
+  auto clip = std::make_shared<ClipRectLayer>(clip_bounds, Clip::kHardEdge);
+  clip->Add(layer);
+
+  sk_sp<SkSurface> surface =
+      SkSurfaces::Raster(SkImageInfo::MakeN32Premul(100, 100));
+  DlSkCanvasAdapter canvas(surface->getCanvas());
+  auto paint_frame = [&](MockLayerTree& tree, DlColor backdrop) {
+    tree.root()->Preroll(preroll_context());
+    canvas.Clear(backdrop);
+    LayerStateStack state_stack;
+    state_stack.set_delegate(&canvas);
+    PaintContext context{
+        // clang-format off
+        .state_stack                   = state_stack,
+        .canvas                        = &canvas,
+        .gr_context                    = nullptr,
+        .dst_color_space               = nullptr,
+        .view_embedder                 = nullptr,
+        .raster_time                   = paint_context().raster_time,
+        .ui_time                       = paint_context().ui_time,
+        .texture_registry              = nullptr,
+        .raster_cache                  = nullptr,
+        .backdrop_filter_cache_enabled = true,
+        // clang-format on
+    };
+    tree.root()->Paint(context);
+    SkPixmap pixmap;
+    EXPECT_TRUE(surface->peekPixels(&pixmap));
+    EXPECT_EQ(pixmap.getColor(35, 35), backdrop.argb());
+    return pixmap.getColor(20, 20);
+  };
+
+  // The first frame has nothing to compare the backdrop with.
+  MockLayerTree l1(SkISize::Make(100, 100));
+  l1.root()->Add(clip);
+  DiffLayerTree(l1, MockLayerTree(SkISize::Make(100, 100)));
+  EXPECT_EQ(paint_frame(l1, DlColor::kRed()), SK_ColorBLUE);
+
+  // The unchanged backdrop is filtered from the surface and cached.
+  MockLayerTree l2(SkISize::Make(100, 100));
+  l2.root()->Add(clip);
+  DiffLayerTree(l2, l1);
+  EXPECT_EQ(paint_frame(l2, DlColor::kRed()), SK_ColorBLUE);
+
+  // While the backdrop stays unchanged the cached one is drawn.
+  MockLayerTree l3(SkISize::Make(100, 100));
+  l3.root()->Add(clip);
+  DiffLayerTree(l3, l2);
+  EXPECT_EQ(paint_frame(l3, DlColor::kTransparent()), SK_ColorBLUE);
+
+  // A frame that is not diffed filters the backdrop directly.
+  EXPECT_EQ(paint_frame(l3, DlColor::kTransparent()), SK_ColorTRANSPARENT);
+
+  MockLayerTree l4(SkISize::Make(100, 100));
+  l4.root()->Add(clip);
+  DiffLayerTree(l4, l3);
+  EXPECT_EQ(paint_frame(l4, DlColor::kRed()), SK_ColorBLUE);
+
+  // So does a frame that damages the backdrop.
+  MockLayerTree l5(SkISize::Make(100, 100));
+  l5.root()->Add(std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeLTRB(12, 12, 18, 18))));
+  l5.root()->Add(clip);
+  DiffLayerTree(l5, l4);
+  EXPECT_EQ(paint_frame(l5, DlColor::kTransparent()), SK_ColorTRANSPARENT);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -6,6 +6,10 @@
 
 #include <optional>
 
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/time/time_point.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+
 namespace flutter {
 
 ContainerLayer::ContainerLayer() : child_paint_bounds_(SkRect::MakeEmpty()) {}
@@ -28,6 +32,7 @@ void ContainerLayer::DiffChildren(DiffContext* context,
                                   const ContainerLayer* old_layer) {
   if (context->IsSubtreeDirty()) {
     for (auto& layer : layers_) {
+      layer->set_preroll_is_reusable(false);
       layer->Diff(context, nullptr);
     }
     return;
@@ -91,13 +96,16 @@ void ContainerLayer::DiffChildren(DiffContext* context,
         // associate their paint region with current layer tree so that we can
         // retrieve it in next frame diff
         layer->PreservePaintRegion(context);
+        layer->set_preroll_is_reusable(true);
       } else {
+        layer->set_preroll_is_reusable(false);
         layer->Diff(context, prev_layer.get());
       }
     } else {
       DiffContext::AutoSubtreeRestore subtree(context);
       context->MarkSubtreeDirty();
       auto layer = layers_[i];
+      layer->set_preroll_is_reusable(false);
       layer->Diff(context, nullptr);
     }
   }
@@ -107,6 +115,13 @@ void ContainerLayer::Add(std::shared_ptr<Layer> layer) {
   layers_.emplace_back(std::move(layer));
 }
 
+void ContainerLayer::PrepareForPreroll(
+    DisplayListComplexityCalculator* complexity_calculator) {
+  for (auto& layer : layers_) {
+    layer->PrepareForPreroll(complexity_calculator);
+  }
+}
+
 void ContainerLayer::Preroll(PrerollContext* context) {
   SkRect child_paint_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, &child_paint_bounds);
@@ -119,6 +134,32 @@ void ContainerLayer::Paint(PaintContext& context) const {
   PaintChildren(context);
 }
 
+void ContainerLayer::PrepareChildrenConcurrently(PrerollContext* context) {
+  TRACE_EVENT0("flutter", "ContainerLayer::PrepareChildrenConcurrently");
+  DisplayListComplexityCalculator* complexity_calculator =
+      context->gr_context ? DisplayListComplexityCalculator::GetForBackend(
+                                context->gr_context->backend())
+                          : DisplayListComplexityCalculator::GetForSoftware();
+
+  size_t task_count = (layers_.size() + kChildrenPerConcurrentTask - 1) /
+                      kChildrenPerConcurrentTask;
+  fml::CountDownLatch latch(task_count);
+  for (size_t start = 0; start < layers_.size();
+       start += kChildrenPerConcurrentTask) {
+    size_t end = std::min(start + kChildrenPerConcurrentTask, layers_.size());
+    // The tasks only borrow the layers, which outlive the wait below.
+    context->concurrent_task_runner->PostTask(
+        [this, start, end, complexity_calculator, &latch]() {
+          for (size_t i = start; i < end; i++) {
+            layers_[i]->PrepareForPreroll(complexity_calculator);
+          }
+          latch.CountDown();
+        },
+        fml::ConcurrentTaskPriority::kFrameCritical);
+  }
+  latch.Wait();
+}
+
 static bool safe_intersection_test(const SkRect* rect1, const SkRect& rect2) {
   if (rect1->isEmpty() || rect2.isEmpty()) {
     return false;
@@ -126,6 +167,50 @@ static bool safe_intersection_test(const SkRect* rect1, const SkRect& rect2) {
   return rect1->intersects(rect2);
 }
 
+// Whether the results of the last |Preroll| of |layer| can be used instead
+// of prerolling it again. The layer must be unchanged since then and must
+// not be painted this frame. Subtrees with platform views or raster cache
+// items are always prerolled since the embedder and the raster cache expect
+// to see them every frame.
+static bool CanSkipPreroll(const Layer* layer, PrerollContext* context) {
+  return layer->preroll_is_reusable() && !layer->subtree_has_platform_view() &&
+         !layer->subtree_has_raster_cache_items() &&
+         context->state_stack.content_culled(layer->paint_bounds());
+}
+
+// Prerolls |layer|, adding the time it takes to the cost report if one is
+// being sampled.
+static void PrerollChild(Layer* layer, PrerollContext* context) {
+  if (!context->layer_cost_profiler) {
+    layer->Preroll(context);
+    return;
+  }
+  const auto start = fml::TimePoint::Now();
+  layer->Preroll(context);
+  context->layer_cost_profiler->AddPreroll(layer->unique_id(),
+                                           fml::TimePoint::Now() - start);
+}
+
+// Paints |layer|, adding the time it takes, the raster cache images it draws
+// and the offscreen layers it pushes to the cost report if one is being
+// sampled.
+static void PaintChild(const Layer* layer, PaintContext& context) {
+  if (!context.layer_cost_profiler) {
+    layer->Paint(context);
+    return;
+  }
+  const RasterCache* cache = context.raster_cache;
+  const size_t hits_before = cache ? cache->draw_hit_count() : 0;
+  const size_t offscreen_before = context.state_stack.offscreen_layer_count();
+  const auto start = fml::TimePoint::Now();
+  layer->Paint(context);
+  const auto duration = fml::TimePoint::Now() - start;
+  context.layer_cost_profiler->AddPaint(
+      layer->unique_id(), duration,
+      cache ? cache->draw_hit_count() - hits_before : 0,
+      context.state_stack.offscreen_layer_count() - offscreen_before);
+}
+
 void ContainerLayer::PrerollChildren(PrerollContext* context,
                                      SkRect* child_paint_bounds) {
   // Platform views have no children, so context->has_platform_view should
@@ -133,9 +218,19 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   FML_DCHECK(!context->has_platform_view);
   FML_DCHECK(!context->has_texture_layer);
 
+  // Only the first container that is wide enough fans out. Its whole
+  // subtree has been prepared by the time its children are prerolled.
+  std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner;
+  if (context->concurrent_task_runner &&
+      layers_.size() > kChildrenPerConcurrentTask) {
+    PrepareChildrenConcurrently(context);
+    concurrent_task_runner = std::move(context->concurrent_task_runner);
+  }
+
   bool child_has_platform_view = false;
   bool child_has_texture_layer = false;
   bool all_renderable_state_flags = LayerStateStack::kCallerCanApplyAnything;
+  bool children_are_disjoint = true;
 
   for (auto& layer : layers_) {
     // Reset context->has_platform_view and context->has_texture_layer to false
@@ -144,11 +239,27 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
     context->has_platform_view = false;
     context->has_texture_layer = false;
 
-    // Initialize the renderable state flags to false to force the layer to
-    // opt-in to applying state attributes during its |Preroll|
-    context->renderable_state_flags = 0;
-
-    layer->Preroll(context);
+    if (CanSkipPreroll(layer.get(), context)) {
+      context->renderable_state_flags =
+          layer->prerolled_renderable_state_flags();
+      context->has_texture_layer = layer->prerolled_has_texture_layer();
+      context->surface_needs_readback = context->surface_needs_readback ||
+                                        layer->prerolled_needs_readback();
+    } else {
+      // Initialize the renderable state flags to false to force the layer to
+      // opt-in to applying state attributes during its |Preroll|
+      context->renderable_state_flags = 0;
+
+      auto* cached_entries = context->raster_cached_entries;
+      size_t entries_before = cached_entries ? cached_entries->size() : 0;
+      bool needed_readback = context->surface_needs_readback;
+      PrerollChild(layer.get(), context);
+      layer->set_preroll_results(
+          context->renderable_state_flags, context->has_texture_layer,
+          context->surface_needs_readback && !needed_readback,
+          cached_entries && cached_entries->size() > entries_before);
+    }
+    layer->set_preroll_is_reusable(false);
 
     all_renderable_state_flags &= context->renderable_state_flags;
     if (safe_intersection_test(child_paint_bounds, layer->paint_bounds())) {
@@ -156,6 +267,7 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
       // children, but will fail with a grid or other arbitrary 2D layout.
       // See https://github.com/flutter/flutter/issues/93899
       all_renderable_state_flags = 0;
+      children_are_disjoint = false;
     }
     child_paint_bounds->join(layer->paint_bounds());
 
@@ -165,11 +277,15 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
         child_has_texture_layer || context->has_texture_layer;
   }
 
+  if (concurrent_task_runner) {
+    context->concurrent_task_runner = std::move(concurrent_task_runner);
+  }
   context->has_platform_view = child_has_platform_view;
   context->has_texture_layer = child_has_texture_layer;
   context->renderable_state_flags = all_renderable_state_flags;
   set_subtree_has_platform_view(child_has_platform_view);
   set_children_renderable_state_flags(all_renderable_state_flags);
+  children_are_disjoint_ = children_are_disjoint;
   set_child_paint_bounds(*child_paint_bounds);
 }
 
@@ -180,6 +296,24 @@ void ContainerLayer::PaintChildren(PaintContext& context) const {
   // layer calls PaintChildren(), though, it may have modified the
   // PaintContext so the test doesn't work in this "context".
 
+  if (children_are_disjoint_ &&
+      (children_renderable_state_flags() &
+       LayerStateStack::kCallerCanApplyOpacity) == 0 &&
+      !context.state_stack.outstanding_color_filter() &&
+      !context.state_stack.outstanding_image_filter()) {
+    // The opacity of children that do not overlap can be applied to each of
+    // them separately. Only the children that cannot apply it themselves
+    // then need a saveLayer, and only over their own bounds.
+    for (auto& layer : layers_) {
+      if (layer->needs_painting(context)) {
+        auto restore = context.state_stack.applyState(
+            layer->paint_bounds(), layer->prerolled_renderable_state_flags());
+        PaintChild(layer.get(), context);
+      }
+    }
+    return;
+  }
+
   // Apply any outstanding state that the children cannot individually
   // and collectively handle.
   auto restore = context.state_stack.applyState(
@@ -189,7 +323,7 @@ void ContainerLayer::PaintChildren(PaintContext& context) const {
   // and the trace event on this common function has a small overhead.
   for (auto& layer : layers_) {
     if (layer->needs_painting(context)) {
-      layer->Paint(context);
+      PaintChild(layer.get(), context);
     }
   }
 }
@@ -13,6 +13,11 @@ namespace flutter {
 
 class ContainerLayer : public Layer {
  public:
+  // The number of children the work of |PrepareForPreroll| is split into
+  // tasks for when |PrerollContext::concurrent_task_runner| is set. Fewer
+  // children are prepared on the raster thread as part of |Preroll|.
+  static constexpr size_t kChildrenPerConcurrentTask = 4;
+
   ContainerLayer();
 
   void Diff(DiffContext* context, const Layer* old_layer) override;
@@ -20,6 +25,11 @@ class ContainerLayer : public Layer {
 
   virtual void Add(std::shared_ptr<Layer> layer);
 
+  // Reserves room for |count| children before they are added.
+  void ReserveLayers(size_t count) { layers_.reserve(count); }
+
+  void PrepareForPreroll(
+      DisplayListComplexityCalculator* complexity_calculator) override;
   void Preroll(PrerollContext* context) override;
   void Paint(PaintContext& context) const override;
 
@@ -44,13 +54,20 @@ class ContainerLayer : public Layer {
     children_renderable_state_flags_ = flags;
   }
 
+  // Whether the paint bounds of the children do not overlap, in which case
+  // an outstanding opacity can be applied to each child separately.
+  bool children_are_disjoint() const { return children_are_disjoint_; }
+
  protected:
   void PrerollChildren(PrerollContext* context, SkRect* child_paint_bounds);
 
  private:
+  void PrepareChildrenConcurrently(PrerollContext* context);
+
   std::vector<std::shared_ptr<Layer>> layers_;
   SkRect child_paint_bounds_;
   int children_renderable_state_flags_ = 0;
+  bool children_are_disjoint_ = true;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContainerLayer);
 };
@@ -4,11 +4,13 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include "flutter/flow/layers/display_list_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "gtest/gtest.h"
 #include "include/core/SkMatrix.h"
@@ -560,6 +562,137 @@ TEST_F(ContainerLayerTest, CollectionCacheableLayer) {
             static_cast<const unsigned long>(2));
 }
 
+TEST_F(ContainerLayerTest, SkipsPrerollOfReusableLayersOutsideCullRect) {
+  auto path1 = SkPath().addRect(SkRect::MakeLTRB(0, 0, 50, 50));
+  auto path2 = SkPath().addRect(SkRect::MakeLTRB(100, 0, 150, 50));
+  auto mock_layer1 = std::make_shared<MockLayer>(path1);
+  auto mock_layer2 = std::make_shared<MockLayer>(path2);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer2->parent_cull_rect(), kGiantRect);
+
+  // Both children are unchanged, but only the first one is repainted.
+  mock_layer1->set_preroll_is_reusable(true);
+  mock_layer2->set_preroll_is_reusable(true);
+  const SkRect cull_rect = SkRect::MakeLTRB(0, 0, 60, 60);
+  preroll_context()->state_stack.set_preroll_delegate(cull_rect,
+                                                      SkMatrix::I());
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer1->parent_cull_rect(), cull_rect);
+  EXPECT_EQ(mock_layer2->parent_cull_rect(), kGiantRect);
+  EXPECT_EQ(layer->paint_bounds(), SkRect::MakeLTRB(0, 0, 150, 50));
+  EXPECT_FALSE(mock_layer1->preroll_is_reusable());
+  EXPECT_FALSE(mock_layer2->preroll_is_reusable());
+
+  // Without the diff marking it as reusable the layer is prerolled again.
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer2->parent_cull_rect(), cull_rect);
+}
+
+TEST_F(ContainerLayerTest, SkippedPrerollsReplayTheirContextResults) {
+  auto path1 = SkPath().addRect(SkRect::MakeLTRB(0, 0, 50, 50));
+  auto path2 = SkPath().addRect(SkRect::MakeLTRB(100, 0, 150, 50));
+  auto mock_layer1 = std::make_shared<MockLayer>(path1);
+  auto texture_layer = std::make_shared<MockLayer>(path2);
+  texture_layer->set_fake_has_texture_layer(true);
+  texture_layer->set_fake_reads_surface(true);
+  auto skipped_layer = std::make_shared<ContainerLayer>();
+  skipped_layer->Add(texture_layer);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer1);
+  layer->Add(skipped_layer);
+
+  layer->Preroll(preroll_context());
+  EXPECT_TRUE(preroll_context()->has_texture_layer);
+  EXPECT_TRUE(preroll_context()->surface_needs_readback);
+
+  // The container of the texture is not repainted, so it is not prerolled.
+  skipped_layer->set_preroll_is_reusable(true);
+  const SkRect cull_rect = SkRect::MakeLTRB(0, 0, 60, 60);
+  preroll_context()->state_stack.set_preroll_delegate(cull_rect,
+                                                      SkMatrix::I());
+  preroll_context()->has_texture_layer = false;
+  preroll_context()->surface_needs_readback = false;
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(texture_layer->parent_cull_rect(), kGiantRect);
+  EXPECT_TRUE(preroll_context()->has_texture_layer);
+  EXPECT_TRUE(preroll_context()->surface_needs_readback);
+}
+
+TEST_F(ContainerLayerTest, RecordsChildCostsWhileSampling) {
+  auto path1 = SkPath().addRect(SkRect::MakeLTRB(0, 0, 50, 50));
+  auto path2 = SkPath().addRect(SkRect::MakeLTRB(100, 0, 150, 50));
+  auto mock_layer1 = std::make_shared<MockLayer>(path1);
+  auto mock_layer2 = std::make_shared<MockLayer>(path2);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+
+  // Nothing is recorded unless the contexts carry a profiler.
+  LayerCostProfiler profiler;
+  profiler.StartSampling(1);
+  layer->Preroll(preroll_context());
+  layer->Paint(display_list_paint_context());
+  EXPECT_TRUE(profiler.report().empty());
+
+  preroll_context()->layer_cost_profiler = &profiler;
+  display_list_paint_context().layer_cost_profiler = &profiler;
+  layer->Preroll(preroll_context());
+  layer->Paint(display_list_paint_context());
+  profiler.FrameFinished();
+
+  const LayerCostProfiler::Report& report = profiler.report();
+  ASSERT_EQ(report.size(), 2u);
+  for (auto& child : {mock_layer1, mock_layer2}) {
+    auto cost = report.find(child->unique_id());
+    ASSERT_NE(cost, report.end());
+    EXPECT_EQ(cost->second.preroll_count, 1u);
+    EXPECT_EQ(cost->second.paint_count, 1u);
+    EXPECT_EQ(cost->second.raster_cache_hits, 0u);
+    EXPECT_EQ(cost->second.offscreen_count, 0u);
+  }
+  EXPECT_FALSE(profiler.is_sampling());
+}
+
+TEST_F(ContainerLayerTest, ConcurrentPrerollMatchesSerialPreroll) {
+  const size_t child_count = 3 * ContainerLayer::kChildrenPerConcurrentTask;
+  auto make_tree = [child_count]() {
+    auto root = std::make_shared<ContainerLayer>();
+    auto nested = std::make_shared<ContainerLayer>();
+    for (size_t i = 0; i < child_count; i++) {
+      DisplayListBuilder builder;
+      builder.DrawRect(SkRect::MakeXYWH(i * 10.0f, 0, 5, 5), DlPaint());
+      // Only the layers marked as complex are worth caching.
+      auto layer = std::make_shared<DisplayListLayer>(
+          SkPoint::Make(0, 0), builder.Build(), i % 2 == 0, false);
+      (i % 3 == 0 ? nested : root)->Add(layer);
+    }
+    root->Add(nested);
+    return root;
+  };
+  auto serial_tree = make_tree();
+  auto concurrent_tree = make_tree();
+  use_mock_raster_cache();
+
+  serial_tree->Preroll(preroll_context());
+  size_t serial_entries = preroll_context()->raster_cached_entries->size();
+  EXPECT_EQ(serial_entries, child_count / 2);
+
+  preroll_context()->raster_cached_entries->clear();
+  auto loop = fml::ConcurrentMessageLoop::Create(2);
+  auto task_runner = loop->GetTaskRunner();
+  preroll_context()->concurrent_task_runner = task_runner;
+  concurrent_tree->Preroll(preroll_context());
+  EXPECT_EQ(preroll_context()->raster_cached_entries->size(), serial_entries);
+  // The runner is handed back once the children have been prerolled.
+  EXPECT_EQ(preroll_context()->concurrent_task_runner, task_runner);
+  EXPECT_EQ(concurrent_tree->paint_bounds(), serial_tree->paint_bounds());
+  preroll_context()->concurrent_task_runner = nullptr;
+}
+
 using ContainerLayerDiffTest = DiffContextTest;
 
 // Insert PictureLayer amongst container layers
@@ -763,6 +896,30 @@ TEST_F(ContainerLayerDiffTest, ReplaceLayer) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(200, 0, 250, 150));
 }
 
+TEST_F(ContainerLayerDiffTest, RetainedLayersHaveReusablePreroll) {
+  auto path1 = SkPath().addRect(SkRect::MakeLTRB(0, 0, 50, 50));
+  auto path2 = SkPath().addRect(SkRect::MakeLTRB(100, 0, 150, 50));
+  auto path2a = SkPath().addRect(SkRect::MakeLTRB(100, 100, 150, 150));
+
+  auto c1 = CreateContainerLayer(std::make_shared<MockLayer>(path1));
+  auto c2 = CreateContainerLayer(std::make_shared<MockLayer>(path2));
+
+  MockLayerTree t1;
+  t1.root()->Add(c1);
+  t1.root()->Add(c2);
+  DiffLayerTree(t1, MockLayerTree());
+  EXPECT_FALSE(c1->preroll_is_reusable());
+  EXPECT_FALSE(c2->preroll_is_reusable());
+
+  auto c2a = CreateContainerLayer(std::make_shared<MockLayer>(path2a));
+  MockLayerTree t2;
+  t2.root()->Add(c1);
+  t2.root()->Add(c2a);
+  DiffLayerTree(t2, t1);
+  EXPECT_TRUE(c1->preroll_is_reusable());
+  EXPECT_FALSE(c2a->preroll_is_reusable());
+}
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -92,6 +92,13 @@ bool DisplayListLayer::Compare(DiffContext::Statistics& statistics,
   return res;
 }
 
+void DisplayListLayer::PrepareForPreroll(
+    DisplayListComplexityCalculator* complexity_calculator) {
+  if (display_list_raster_cache_item_) {
+    display_list_raster_cache_item_->PrepareForPreroll(complexity_calculator);
+  }
+}
+
 void DisplayListLayer::Preroll(PrerollContext* context) {
   DisplayList* disp_list = display_list();
 
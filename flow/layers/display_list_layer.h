@@ -33,6 +33,9 @@ class DisplayListLayer : public Layer {
     return this;
   }
 
+  void PrepareForPreroll(
+      DisplayListComplexityCalculator* complexity_calculator) override;
+
   void Preroll(PrerollContext* frame) override;
 
   void Paint(PaintContext& context) const override;
@@ -42,8 +45,7 @@ class DisplayListLayer : public Layer {
   }
 
   RasterCacheKeyID caching_key_id() const override {
-    return RasterCacheKeyID(display_list()->unique_id(),
-                            RasterCacheKeyType::kDisplayList);
+    return RasterCacheKeyID::ForDisplayList(*display_list());
   }
 
  private:
@@ -51,8 +51,7 @@ DisplayListRasterCacheItem::DisplayListRasterCacheItem(
     const SkPoint& offset,
     bool is_complex,
     bool will_change)
-    : RasterCacheItem(RasterCacheKeyID(display_list->unique_id(),
-                                       RasterCacheKeyType::kDisplayList),
+    : RasterCacheItem(RasterCacheKeyID::ForDisplayList(*display_list),
                       CacheState::kCurrent),
       display_list_(display_list),
       offset_(offset),
@@ -68,6 +67,16 @@ std::unique_ptr<DisplayListRasterCacheItem> DisplayListRasterCacheItem::Make(
                                                       is_complex, will_change);
 }
 
+void DisplayListRasterCacheItem::PrepareForPreroll(
+    DisplayListComplexityCalculator* complexity_calculator) {
+  if (worth_rasterizing_calculator_ == complexity_calculator) {
+    return;
+  }
+  worth_rasterizing_ = IsDisplayListWorthRasterizing(
+      display_list(), will_change_, is_complex_, complexity_calculator);
+  worth_rasterizing_calculator_ = complexity_calculator;
+}
+
 void DisplayListRasterCacheItem::PrerollSetup(PrerollContext* context,
                                               const SkMatrix& matrix) {
   cache_state_ = CacheState::kNone;
@@ -76,8 +85,8 @@ void DisplayListRasterCacheItem::PrerollSetup(PrerollContext* context,
                                 context->gr_context->backend())
                           : DisplayListComplexityCalculator::GetForSoftware();
 
-  if (!IsDisplayListWorthRasterizing(display_list(), will_change_, is_complex_,
-                                     complexity_calculator)) {
+  PrepareForPreroll(complexity_calculator);
+  if (!worth_rasterizing_) {
     // We only deal with display lists that are worthy of rasterization.
     return;
   }
@@ -166,11 +175,7 @@ bool DisplayListRasterCacheItem::TryToPrepareRasterCache(
       .flow_type          = flow_type,
       // clang-format on
   };
-  return context.raster_cache->UpdateCacheEntry(
-      id.value(), r_context,
-      [display_list = display_list_](DlCanvas* canvas) {
-        canvas->DrawDisplayList(display_list);
-      },
-      display_list_->rtree());
+  return context.raster_cache->UpdateDisplayListCacheEntry(
+      id.value(), r_context, display_list_);
 }
 }  // namespace flutter
@@ -8,6 +8,7 @@
 #include <memory>
 #include <optional>
 
+#include "flutter/display_list/benchmarking/dl_complexity.h"
 #include "flutter/display_list/display_list.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/raster_cache_item.h"
@@ -29,6 +30,13 @@ class DisplayListRasterCacheItem : public RasterCacheItem {
       bool is_complex,
       bool will_change);
 
+  // Decides whether the display list is worth rasterizing according to
+  // |complexity_calculator| and remembers the answer for the next
+  // |PrerollSetup| that uses the same calculator. This may be called on any
+  // thread, but not concurrently with any other method of this item.
+  void PrepareForPreroll(
+      DisplayListComplexityCalculator* complexity_calculator);
+
   void PrerollSetup(PrerollContext* context, const SkMatrix& matrix) override;
 
   void PrerollFinalize(PrerollContext* context,
@@ -55,6 +63,8 @@ class DisplayListRasterCacheItem : public RasterCacheItem {
   SkPoint offset_;
   bool is_complex_;
   bool will_change_;
+  DisplayListComplexityCalculator* worth_rasterizing_calculator_ = nullptr;
+  bool worth_rasterizing_ = false;
 };
 
 }  // namespace flutter
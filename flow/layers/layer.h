@@ -7,25 +7,30 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <unordered_set>
 #include <vector>
 
 #include "flutter/common/graphics/texture.h"
+#include "flutter/display_list/benchmarking/dl_complexity.h"
 #include "flutter/display_list/dl_canvas.h"
 #include "flutter/flow/diff_context.h"
 #include "flutter/flow/embedded_views.h"
+#include "flutter/flow/layer_cost_profiler.h"
 #include "flutter/flow/layer_snapshot_store.h"
 #include "flutter/flow/layers/layer_state_stack.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/stopwatch.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/compiler_specific.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColor.h"
 #include "third_party/skia/include/core/SkColorFilter.h"
+#include "third_party/skia/include/core/SkM44.h"
 #include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkPath.h"
 #include "third_party/skia/include/core/SkRRect.h"
@@ -43,6 +48,7 @@ class MockLayer;
 class ContainerLayer;
 class DisplayListLayer;
 class PerformanceOverlayLayer;
+class PlatformViewLayer;
 class TextureLayer;
 class RasterCacheItem;
 
@@ -82,6 +88,15 @@ struct PrerollContext {
   int renderable_state_flags = 0;
 
   std::vector<RasterCacheItem*>* raster_cached_entries;
+
+  // When set, |ContainerLayer| uses it to run the parts of the |Preroll| of
+  // its children that do not touch this context on worker threads, see
+  // |Layer::PrepareForPreroll|.
+  std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner;
+
+  // Non-null only while a per-layer cost report is being sampled, in which
+  // case |ContainerLayer| records the time each child spends in |Preroll|.
+  LayerCostProfiler* layer_cost_profiler = nullptr;
 };
 
 struct PaintContext {
@@ -119,6 +134,23 @@ struct PaintContext {
   bool enable_leaf_layer_tracing = false;
   bool impeller_enabled = false;
   impeller::AiksContext* aiks_context;
+
+  // Non-null only while a per-layer cost report is being sampled, in which
+  // case |ContainerLayer| records the time each child spends in |Paint|.
+  LayerCostProfiler* layer_cost_profiler = nullptr;
+
+  // Whether |BackdropFilterLayer| may read back |canvas| to keep its filtered
+  // backdrop for later frames. Only set when the frame renders directly into
+  // a surface that supports reading back its pixels.
+  bool backdrop_filter_cache_enabled = false;
+};
+
+// New values for the animatable properties of a retained layer, which the
+// rasterizer applies to the last layer tree it drew without waiting for the
+// UI thread to build a new one.
+struct RetainedLayerUpdate {
+  std::optional<SkAlpha> alpha;
+  std::optional<SkM44> transform;
 };
 
 // Represents a single composited layer. Created on the UI thread but then
@@ -156,6 +188,12 @@ class Layer {
   // Performs diff with given layer
   virtual void Diff(DiffContext* context, const Layer* old_layer) {}
 
+  // Applies the properties of |update| that this layer has. Returns false if
+  // the layer has none of them, in which case it is left as it was.
+  virtual bool ApplyRetainedUpdate(const RetainedLayerUpdate& update) {
+    return false;
+  }
+
   // Used when diffing retained layer; In case the layer is identical, it
   // doesn't need to be diffed, but the paint region needs to be stored in diff
   // context so that it can be used in next frame
@@ -167,6 +205,13 @@ class Layer {
 
   virtual void Preroll(PrerollContext* context) = 0;
 
+  // Does the work of |Preroll| that only depends on the layer itself, such
+  // as deciding whether its contents are worth caching, ahead of |Preroll|.
+  // This is called on a worker thread and must not touch any state shared
+  // with other layers. The default implementation does nothing.
+  virtual void PrepareForPreroll(
+      DisplayListComplexityCalculator* complexity_calculator) {}
+
   // Used during Preroll by layers that employ a saveLayer to manage the
   // PrerollContext settings with values affected by the saveLayer mechanism.
   // This object must be created before calling Preroll on the children to
@@ -202,6 +247,38 @@ class Layer {
     subtree_has_platform_view_ = value;
   }
 
+  // Set by |ContainerLayer::DiffChildren| when this retained layer renders
+  // identically to the previous frame, so that the results of its last
+  // |Preroll| are still valid. |ContainerLayer::PrerollChildren| then skips
+  // prerolling it if it also lies outside of the area being repainted.
+  bool preroll_is_reusable() const { return preroll_is_reusable_; }
+  void set_preroll_is_reusable(bool value) { preroll_is_reusable_ = value; }
+
+  // The results of the last |Preroll| of this layer that are not stored
+  // elsewhere in the layer, recorded by |ContainerLayer::PrerollChildren|.
+  // The ones that went into the |PrerollContext| are replayed into it when
+  // the |Preroll| is skipped.
+  int prerolled_renderable_state_flags() const {
+    return prerolled_renderable_state_flags_;
+  }
+  bool prerolled_has_texture_layer() const {
+    return prerolled_has_texture_layer_;
+  }
+  // Whether the |Preroll| turned |PrerollContext::surface_needs_readback| on.
+  bool prerolled_needs_readback() const { return prerolled_needs_readback_; }
+  bool subtree_has_raster_cache_items() const {
+    return subtree_has_raster_cache_items_;
+  }
+  void set_preroll_results(int renderable_state_flags,
+                           bool has_texture_layer,
+                           bool needs_readback,
+                           bool has_raster_cache_items) {
+    prerolled_renderable_state_flags_ = renderable_state_flags;
+    prerolled_has_texture_layer_ = has_texture_layer;
+    prerolled_needs_readback_ = needs_readback;
+    subtree_has_raster_cache_items_ = has_raster_cache_items;
+  }
+
   // Returns the paint bounds in the layer's local coordinate system
   // as determined during Preroll().  The bounds should include any
   // transform, clip or distortions performed by the layer itself,
@@ -257,6 +334,9 @@ class Layer {
     return nullptr;
   }
   virtual const TextureLayer* as_texture_layer() const { return nullptr; }
+  virtual const PlatformViewLayer* as_platform_view_layer() const {
+    return nullptr;
+  }
   virtual const PerformanceOverlayLayer* as_performance_overlay_layer() const {
     return nullptr;
   }
@@ -267,6 +347,11 @@ class Layer {
   uint64_t unique_id_;
   uint64_t original_layer_id_;
   bool subtree_has_platform_view_ = false;
+  bool preroll_is_reusable_ = false;
+  int prerolled_renderable_state_flags_ = 0;
+  bool prerolled_has_texture_layer_ = false;
+  bool prerolled_needs_readback_ = false;
+  bool subtree_has_raster_cache_items_ = false;
 
   static uint64_t NextUniqueID();
 
@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/layer_state_stack.h"
 
+#include <algorithm>
+
 #include "flutter/display_list/utils/dl_matrix_clip_tracker.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
@@ -230,6 +232,7 @@ class SaveLayerEntry : public LayerStateStack::StateEntry {
     stack->delegate_->restore();
     stack->outstanding_ = old_attributes_;
   }
+  bool is_offscreen_layer() const override { return true; }
 
  protected:
   const SkRect bounds_;
@@ -706,6 +709,7 @@ void LayerStateStack::push_backdrop(
   state_stack_.emplace_back(std::make_unique<BackdropFilterEntry>(
       bounds, filter, blend_mode, outstanding_));
   apply_last_entry();
+  offscreen_layer_count_++;
 }
 
 void LayerStateStack::push_translate(SkScalar tx, SkScalar ty) {
@@ -743,6 +747,13 @@ void LayerStateStack::push_clip_path(const SkPath& path, bool is_aa) {
   apply_last_entry();
 }
 
+bool LayerStateStack::has_open_offscreen_layer() const {
+  return std::any_of(state_stack_.begin(), state_stack_.end(),
+                     [](const std::unique_ptr<StateEntry>& entry) {
+                       return entry->is_offscreen_layer();
+                     });
+}
+
 bool LayerStateStack::needs_save_layer(int flags) const {
   if (outstanding_.opacity < SK_Scalar1 &&
       (flags & LayerStateStack::kCallerCanApplyOpacity) == 0) {
@@ -768,6 +779,7 @@ void LayerStateStack::save_layer(const SkRect& bounds) {
   state_stack_.emplace_back(std::make_unique<SaveLayerEntry>(
       bounds, DlBlendMode::kSrcOver, outstanding_));
   apply_last_entry();
+  offscreen_layer_count_++;
 }
 
 void LayerStateStack::maybe_save_layer_for_transform(bool save_needed) {
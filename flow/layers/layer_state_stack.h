@@ -323,6 +323,15 @@ class LayerStateStack {
   // its initial state.
   bool is_empty() const { return state_stack_.empty(); }
 
+  // Returns the number of offscreen layers (saveLayer and backdrop filter
+  // layers) this state stack has pushed since it was created.
+  size_t offscreen_layer_count() const { return offscreen_layer_count_; }
+
+  // Returns true if an offscreen layer pushed by this state stack has not
+  // been restored yet, in which case the content drawn so far has not all
+  // reached the surface behind the canvas.
+  bool has_open_offscreen_layer() const;
+
  private:
   size_t stack_count() const { return state_stack_.size(); }
   void restore_to_count(size_t restore_count);
@@ -405,6 +414,7 @@ class LayerStateStack {
     virtual void reapply(LayerStateStack* stack) const { apply(stack); }
     virtual void restore(LayerStateStack* stack) const {}
     virtual void update_mutators(MutatorsStack* mutators_stack) const {}
+    virtual bool is_offscreen_layer() const { return false; }
 
    protected:
     StateEntry() = default;
@@ -476,6 +486,7 @@ class LayerStateStack {
   std::shared_ptr<Delegate> delegate_;
   RenderingAttributes outstanding_;
   CheckerboardFunc checkerboard_func_ = nullptr;
+  size_t offscreen_layer_count_ = 0;
 
   friend class SaveLayerEntry;
 };
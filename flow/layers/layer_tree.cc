@@ -8,6 +8,7 @@
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/frame_timings.h"
 #include "flutter/flow/layer_snapshot_store.h"
+#include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
 #include "flutter/flow/raster_cache.h"
@@ -26,6 +27,29 @@ LayerTree::LayerTree(const Config& config, const SkISize& frame_size)
           config.checkerboard_raster_cache_images),
       checkerboard_offscreen_layers_(config.checkerboard_offscreen_layers) {}
 
+static Layer* FindRetainedLayer(Layer* layer, uint64_t original_layer_id) {
+  if (layer->original_layer_id() == original_layer_id) {
+    return layer;
+  }
+  if (const ContainerLayer* container = layer->as_container_layer()) {
+    for (const auto& child : container->layers()) {
+      if (Layer* found = FindRetainedLayer(child.get(), original_layer_id)) {
+        return found;
+      }
+    }
+  }
+  return nullptr;
+}
+
+bool LayerTree::ApplyRetainedUpdate(uint64_t original_layer_id,
+                                    const RetainedLayerUpdate& update) {
+  if (!root_layer_) {
+    return false;
+  }
+  Layer* layer = FindRetainedLayer(root_layer_.get(), original_layer_id);
+  return layer && layer->ApplyRetainedUpdate(update);
+}
+
 inline SkColorSpace* GetColorSpace(DlCanvas* canvas) {
   return canvas ? canvas->GetImageInfo().colorSpace() : nullptr;
 }
@@ -49,6 +73,7 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
   RasterCache* cache =
       ignore_raster_cache ? nullptr : &frame.context().raster_cache();
   raster_cache_items_.clear();
+  LayerCostProfiler* profiler = &frame.context().layer_cost_profiler();
 
   PrerollContext context = {
       // clang-format off
@@ -62,6 +87,13 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       .ui_time                       = frame.context().ui_time(),
       .texture_registry              = frame.context().texture_registry(),
       .raster_cached_entries         = &raster_cache_items_,
+      // The concurrent work only decides what is worth caching.
+      .concurrent_task_runner        = cache != nullptr
+                                           ? frame.context()
+                                                 .concurrent_task_runner()
+                                           : nullptr,
+      .layer_cost_profiler           = profiler->is_sampling() ? profiler
+                                                               : nullptr,
       // clang-format on
   };
 
@@ -127,6 +159,7 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
   SkColorSpace* color_space = GetColorSpace(frame.canvas());
   RasterCache* cache =
       ignore_raster_cache ? nullptr : &frame.context().raster_cache();
+  LayerCostProfiler* profiler = &frame.context().layer_cost_profiler();
   PaintContext context = {
       // clang-format off
       .state_stack                   = state_stack,
@@ -142,6 +175,11 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
       .enable_leaf_layer_tracing     = enable_leaf_layer_tracing_,
       .impeller_enabled              = !!frame.aiks_context(),
       .aiks_context                  = frame.aiks_context(),
+      .layer_cost_profiler           = profiler->is_sampling() ? profiler
+                                                               : nullptr,
+      .backdrop_filter_cache_enabled =
+          frame.context().backdrop_filter_cache_enabled() &&
+          frame.surface_supports_readback() && !frame.aiks_context(),
       // clang-format on
   };
 
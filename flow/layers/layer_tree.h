@@ -54,6 +54,14 @@ class LayerTree {
       const std::shared_ptr<TextureRegistry>& texture_registry = nullptr,
       GrDirectContext* gr_context = nullptr);
 
+  // Applies |update| to the layer of this tree that was built from, or
+  // retains, the layer with |original_layer_id|. Returns whether such a
+  // layer was found and updated.
+  //
+  // The tree must not be in use by a frame on another thread.
+  bool ApplyRetainedUpdate(uint64_t original_layer_id,
+                           const RetainedLayerUpdate& update);
+
   Layer* root_layer() const { return root_layer_.get(); }
   const SkISize& frame_size() const { return frame_size_; }
 
@@ -7,6 +7,8 @@
 
 #include "flutter/flow/compositor_context.h"
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/testing/mock_layer.h"
 #include "flutter/fml/macros.h"
@@ -246,6 +248,40 @@ TEST_F(LayerTreeTest, PrerollContextInitialization) {
   expect_defaults(context);
 }
 
+TEST_F(LayerTreeTest, AppliesRetainedUpdatesToTheLayerThatRetainsTheId) {
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(10.0f, 10.0f));
+  auto old_opacity_layer =
+      std::make_shared<OpacityLayer>(SK_AlphaOPAQUE, SkPoint::Make(0, 0));
+  auto opacity_layer =
+      std::make_shared<OpacityLayer>(SK_AlphaOPAQUE, SkPoint::Make(0, 0));
+  opacity_layer->AssignOldLayer(old_opacity_layer.get());
+  opacity_layer->Add(std::make_shared<MockLayer>(child_path));
+  auto transform_layer = std::make_shared<TransformLayer>(SkMatrix::I());
+  transform_layer->Add(opacity_layer);
+  auto layer_tree = BuildLayerTree(LayerTree::Config{
+      .root_layer = transform_layer,
+  });
+
+  EXPECT_TRUE(layer_tree->ApplyRetainedUpdate(
+      old_opacity_layer->original_layer_id(), {.alpha = 0x80}));
+  EXPECT_EQ(opacity_layer->opacity(), 0x80 * 1.0f / SK_AlphaOPAQUE);
+
+  // The layer has none of the properties of the update.
+  EXPECT_FALSE(layer_tree->ApplyRetainedUpdate(
+      opacity_layer->original_layer_id(),
+      {.transform = SkM44::Translate(5.0f, 5.0f)}));
+
+  EXPECT_TRUE(layer_tree->ApplyRetainedUpdate(
+      transform_layer->original_layer_id(),
+      {.transform = SkM44::Translate(5.0f, 5.0f)}));
+  layer_tree->Preroll(frame());
+  EXPECT_EQ(transform_layer->paint_bounds(),
+            SkRect::MakeXYWH(5.0f, 5.0f, 10.0f, 10.0f));
+
+  // 0 is never the id of a layer.
+  EXPECT_FALSE(layer_tree->ApplyRetainedUpdate(0u, {.alpha = 0x40}));
+}
+
 TEST_F(LayerTreeTest, PaintContextInitialization) {
   LayerStateStack state_stack;
   FixedRefreshRateStopwatch mock_raster_time;
@@ -34,6 +34,16 @@ void OpacityLayer::Diff(DiffContext* context, const Layer* old_layer) {
   context->SetLayerPaintRegion(this, context->CurrentSubtreeRegion());
 }
 
+bool OpacityLayer::ApplyRetainedUpdate(const RetainedLayerUpdate& update) {
+  if (!update.alpha.has_value()) {
+    return false;
+  }
+  // The raster cache entry of the children does not depend on the alpha, so
+  // the children keep being drawn from it.
+  alpha_ = update.alpha.value();
+  return true;
+}
+
 void OpacityLayer::Preroll(PrerollContext* context) {
   auto mutator = context->state_stack.save();
   mutator.translate(offset_);
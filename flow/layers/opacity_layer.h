@@ -35,6 +35,8 @@ class OpacityLayer : public CacheableContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  bool ApplyRetainedUpdate(const RetainedLayerUpdate& update) override;
+
   // Returns whether the children are capable of inheriting an opacity value
   // and modifying their rendering accordingly. This value is only guaranteed
   // to be valid after the local |Preroll| method is called.
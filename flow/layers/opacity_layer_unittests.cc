@@ -647,6 +647,67 @@ TEST_F(OpacityLayerTest, OpacityInheritanceNestedWithIncompatibleChild) {
   EXPECT_TRUE(DisplayListsEQ_Verbose(expected_builder.Build(), display_list()));
 }
 
+TEST_F(OpacityLayerTest, OpacityDistributedOverDisjointChildren) {
+  SkPoint offset = SkPoint::Make(10, 20);
+  SkPath path1 = SkPath::Rect({10, 10, 20, 20});
+  SkPath path2 = SkPath::Rect({30, 10, 40, 20});
+  SkPath path3 = SkPath::Rect({50, 10, 60, 20});
+  auto opacity_layer = std::make_shared<OpacityLayer>(128, offset);
+  auto mock_layer1 = MockLayer::Make(path1);
+  auto mock_layer2 = MockLayer::MakeOpacityCompatible(path2);
+  auto mock_layer3 = MockLayer::Make(path3);
+  opacity_layer->Add(mock_layer1);
+  opacity_layer->Add(mock_layer2);
+  opacity_layer->Add(mock_layer3);
+
+  PrerollContext* context = preroll_context();
+  opacity_layer->Preroll(context);
+  EXPECT_FALSE(opacity_layer->children_can_accept_opacity());
+  EXPECT_TRUE(opacity_layer->children_are_disjoint());
+
+  SkScalar opacity = 128 * 1.0 / SK_AlphaOPAQUE;
+  DlPaint savelayer_paint = DlPaint().setOpacity(opacity);
+
+  DisplayListBuilder expected_builder;
+  /* opacity_layer::Paint */ {
+    expected_builder.Save();
+    {
+      expected_builder.Translate(offset.fX, offset.fY);
+      expected_builder.SaveLayer(&mock_layer1->paint_bounds(),
+                                 &savelayer_paint);
+      /* mock_layer1::Paint */ {
+        expected_builder.DrawPath(path1, DlPaint());
+      }
+      expected_builder.Restore();
+      /* mock_layer2::Paint */ {
+        expected_builder.DrawPath(path2, DlPaint().setOpacity(opacity));
+      }
+      expected_builder.SaveLayer(&mock_layer3->paint_bounds(),
+                                 &savelayer_paint);
+      /* mock_layer3::Paint */ {
+        expected_builder.DrawPath(path3, DlPaint());
+      }
+      expected_builder.Restore();
+    }
+    expected_builder.Restore();
+  }
+
+  opacity_layer->Paint(display_list_paint_context());
+  EXPECT_TRUE(DisplayListsEQ_Verbose(expected_builder.Build(), display_list()));
+}
+
+TEST_F(OpacityLayerTest, OpacityNotDistributedOverOverlappingChildren) {
+  SkPath path1 = SkPath::Rect({10, 10, 20, 20});
+  SkPath path2 = SkPath::Rect({15, 10, 25, 20});
+  auto opacity_layer = std::make_shared<OpacityLayer>(128, SkPoint());
+  opacity_layer->Add(MockLayer::Make(path1));
+  opacity_layer->Add(MockLayer::MakeOpacityCompatible(path2));
+
+  opacity_layer->Preroll(preroll_context());
+  EXPECT_FALSE(opacity_layer->children_can_accept_opacity());
+  EXPECT_FALSE(opacity_layer->children_are_disjoint());
+}
+
 using OpacityLayerDiffTest = DiffContextTest;
 
 TEST_F(OpacityLayerDiffTest, FractionalTranslation) {
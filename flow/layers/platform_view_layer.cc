@@ -13,6 +13,24 @@ PlatformViewLayer::PlatformViewLayer(const SkPoint& offset,
                                      int64_t view_id)
     : offset_(offset), size_(size), view_id_(view_id) {}
 
+bool PlatformViewLayer::IsReplacing(DiffContext* context,
+                                    const Layer* layer) const {
+  // Platform view layers are recreated every frame, so they replace the
+  // layer of the previous frame if they show the same view in the same place.
+  auto old_layer = layer->as_platform_view_layer();
+  return old_layer != nullptr && view_id_ == old_layer->view_id_ &&
+         offset_ == old_layer->offset_ && size_ == old_layer->size_;
+}
+
+void PlatformViewLayer::Diff(DiffContext* context, const Layer* old_layer) {
+  DiffContext::AutoSubtreeRestore subtree(context);
+  // The contents of the view are composited by the embedder, but a view that
+  // appears, disappears or moves changes what Flutter renders around it.
+  context->AddLayerBounds(SkRect::MakeXYWH(offset_.x(), offset_.y(),
+                                           size_.width(), size_.height()));
+  context->SetLayerPaintRegion(this, context->CurrentSubtreeRegion());
+}
+
 void PlatformViewLayer::Preroll(PrerollContext* context) {
   set_paint_bounds(SkRect::MakeXYWH(offset_.x(), offset_.y(), size_.width(),
                                     size_.height()));
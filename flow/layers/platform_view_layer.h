@@ -16,6 +16,14 @@ class PlatformViewLayer : public Layer {
  public:
   PlatformViewLayer(const SkPoint& offset, const SkSize& size, int64_t view_id);
 
+  bool IsReplacing(DiffContext* context, const Layer* layer) const override;
+
+  void Diff(DiffContext* context, const Layer* old_layer) override;
+
+  const PlatformViewLayer* as_platform_view_layer() const override {
+    return this;
+  }
+
   void Preroll(PrerollContext* context) override;
   void Paint(PaintContext& context) const override;
 
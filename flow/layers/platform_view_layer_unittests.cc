@@ -6,6 +6,7 @@
 #include "flutter/flow/layers/platform_view_layer.h"
 #include "flutter/flow/layers/transform_layer.h"
 
+#include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_embedder.h"
 #include "flutter/flow/testing/mock_layer.h"
@@ -139,5 +140,39 @@ TEST_F(PlatformViewLayerTest, StateTransfer) {
   transform_layer1->Paint(paint_ctx);
 }
 
+using PlatformViewLayerDiffTest = DiffContextTest;
+
+TEST_F(PlatformViewLayerDiffTest, UnchangedPlatformViewHasNoDamage) {
+  MockLayerTree tree1;
+  tree1.root()->Add(std::make_shared<PlatformViewLayer>(
+      SkPoint::Make(10, 10), SkSize::Make(50, 50), 0));
+  auto damage = DiffLayerTree(tree1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(10, 10, 60, 60));
+
+  // Platform view layers are recreated for every frame.
+  MockLayerTree tree2;
+  tree2.root()->Add(std::make_shared<PlatformViewLayer>(
+      SkPoint::Make(10, 10), SkSize::Make(50, 50), 0));
+  damage = DiffLayerTree(tree2, tree1);
+  EXPECT_TRUE(damage.frame_damage.isEmpty());
+}
+
+TEST_F(PlatformViewLayerDiffTest, MovedPlatformViewIsDamaged) {
+  MockLayerTree tree1;
+  tree1.root()->Add(std::make_shared<PlatformViewLayer>(
+      SkPoint::Make(10, 10), SkSize::Make(50, 50), 0));
+  DiffLayerTree(tree1, MockLayerTree());
+
+  MockLayerTree tree2;
+  tree2.root()->Add(std::make_shared<PlatformViewLayer>(
+      SkPoint::Make(20, 10), SkSize::Make(50, 50), 0));
+  auto damage = DiffLayerTree(tree2, tree1);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(10, 10, 70, 60));
+
+  MockLayerTree tree3;
+  damage = DiffLayerTree(tree3, tree2);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(20, 10, 70, 60));
+}
+
 }  // namespace testing
 }  // namespace flutter
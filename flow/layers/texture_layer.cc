@@ -24,9 +24,18 @@ void TextureLayer::Diff(DiffContext* context, const Layer* old_layer) {
   if (!context->IsSubtreeDirty()) {
     FML_DCHECK(old_layer);
     auto prev = old_layer->as_texture_layer();
-    // TODO(knopp) It would be nice to be able to determine that a texture is
-    // dirty
-    context->MarkSubtreeDirty(context->GetOldLayerPaintRegion(prev));
+    // The layer only needs to be repainted if it shows a different frame, or
+    // shows the frame differently, than when |prev| was painted.
+    std::optional<uint64_t> frame_sequence =
+        context->GetTextureFrameSequence(texture_id_);
+    bool unchanged = frame_sequence.has_value() &&
+                     frame_sequence == prev->painted_frame_sequence_ &&
+                     prev->texture_id_ == texture_id_ &&
+                     prev->offset_ == offset_ && prev->size_ == size_ &&
+                     prev->freeze_ == freeze_ && prev->sampling_ == sampling_;
+    if (!unchanged) {
+      context->MarkSubtreeDirty(context->GetOldLayerPaintRegion(prev));
+    }
   }
 
   // Make sure DiffContext knows there is a TextureLayer in this subtree.
@@ -65,6 +74,7 @@ void TextureLayer::Paint(PaintContext& context) const {
       .aiks_context = context.aiks_context,
       .paint = context.state_stack.fill(paint),
   };
+  painted_frame_sequence_ = texture->GetFrameSequence();
   texture->Paint(ctx, paint_bounds(), freeze_, sampling_);
 }
 
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_FLOW_LAYERS_TEXTURE_LAYER_H_
 #define FLUTTER_FLOW_LAYERS_TEXTURE_LAYER_H_
 
+#include <optional>
+
 #include "flutter/flow/layers/layer.h"
 #include "third_party/skia/include/core/SkPoint.h"
 #include "third_party/skia/include/core/SkSize.h"
@@ -37,6 +39,12 @@ class TextureLayer : public Layer {
   bool freeze_;
   DlImageSampling sampling_;
 
+  // The frame sequence of the texture when this layer last painted it, which
+  // the layer replacing this one in the next frame compares against. This is
+  // recorded by Paint rather than by Diff, because the same layer tree may be
+  // diffed more than once before it is painted.
+  mutable std::optional<uint64_t> painted_frame_sequence_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(TextureLayer);
 };
 
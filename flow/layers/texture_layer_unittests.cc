@@ -117,6 +117,73 @@ TEST_F(TextureLayerDiffTest, TextureInRetainedLayer) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 100, 100));
 }
 
+TEST_F(TextureLayerDiffTest, UnchangedTextureIsNotDamaged) {
+  const int64_t texture_id = 0;
+  auto mock_texture = std::make_shared<MockTexture>(
+      texture_id, MockTexture::MakeTestTexture(20, 20, 5));
+  texture_registry()->RegisterTexture(mock_texture);
+
+  MockLayerTree tree1;
+  auto layer1 = std::make_shared<TextureLayer>(
+      SkPoint::Make(0, 0), SkSize::Make(100, 100), texture_id, false,
+      DlImageSampling::kLinear);
+  tree1.root()->Add(layer1);
+  auto damage = DiffLayerTree(tree1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 100, 100));
+  layer1->Preroll(preroll_context());
+  layer1->Paint(display_list_paint_context());
+
+  // Diffing the painted tree against itself, as when the last layer tree is
+  // drawn again, and diffing a new layer for the same texture find no damage.
+  damage = DiffLayerTree(tree1, tree1);
+  EXPECT_TRUE(damage.frame_damage.isEmpty());
+
+  MockLayerTree tree2;
+  auto layer2 = std::make_shared<TextureLayer>(
+      SkPoint::Make(0, 0), SkSize::Make(100, 100), texture_id, false,
+      DlImageSampling::kLinear);
+  tree2.root()->Add(layer2);
+  damage = DiffLayerTree(tree2, tree1);
+  EXPECT_TRUE(damage.frame_damage.isEmpty());
+  layer2->Preroll(preroll_context());
+  layer2->Paint(display_list_paint_context());
+
+  // The texture is damaged until a layer paints its new frame.
+  mock_texture->MarkFrameAvailable();
+  MockLayerTree tree3;
+  tree3.root()->Add(layer2);
+  damage = DiffLayerTree(tree3, tree2);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 100, 100));
+  damage = DiffLayerTree(tree3, tree2);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 100, 100));
+
+  layer2->Paint(display_list_paint_context());
+  damage = DiffLayerTree(tree3, tree2);
+  EXPECT_TRUE(damage.frame_damage.isEmpty());
+}
+
+TEST_F(TextureLayerDiffTest, ReplacedTextureIsDamaged) {
+  const int64_t texture_id = 0;
+  texture_registry()->RegisterTexture(std::make_shared<MockTexture>(
+      texture_id, MockTexture::MakeTestTexture(20, 20, 5)));
+
+  MockLayerTree tree1;
+  auto layer = std::make_shared<TextureLayer>(
+      SkPoint::Make(0, 0), SkSize::Make(100, 100), texture_id, false,
+      DlImageSampling::kLinear);
+  tree1.root()->Add(layer);
+  DiffLayerTree(tree1, MockLayerTree());
+  layer->Preroll(preroll_context());
+  layer->Paint(display_list_paint_context());
+
+  // A new texture with the same id starts a new frame sequence.
+  texture_registry()->UnregisterTexture(texture_id);
+  texture_registry()->RegisterTexture(std::make_shared<MockTexture>(
+      texture_id, MockTexture::MakeTestTexture(20, 20, 5)));
+  auto damage = DiffLayerTree(tree1, tree1);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 100, 100));
+}
+
 TEST_F(TextureLayerTest, OpacityInheritance) {
   const SkPoint layer_offset = SkPoint::Make(0.0f, 0.0f);
   const SkSize layer_size = SkSize::Make(8.0f, 8.0f);
@@ -39,6 +39,14 @@ void TransformLayer::Diff(DiffContext* context, const Layer* old_layer) {
   context->SetLayerPaintRegion(this, context->CurrentSubtreeRegion());
 }
 
+bool TransformLayer::ApplyRetainedUpdate(const RetainedLayerUpdate& update) {
+  if (!update.transform.has_value() || !update.transform->isFinite()) {
+    return false;
+  }
+  transform_ = update.transform.value();
+  return true;
+}
+
 void TransformLayer::Preroll(PrerollContext* context) {
   auto mutator = context->state_stack.save();
   mutator.transform(transform_);
@@ -19,6 +19,8 @@ class TransformLayer : public ContainerLayer {
 
   void Diff(DiffContext* context, const Layer* old_layer) override;
 
+  bool ApplyRetainedUpdate(const RetainedLayerUpdate& update) override;
+
   void Preroll(PrerollContext* context) override;
 
   void Paint(PaintContext& context) const override;
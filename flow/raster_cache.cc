@@ -4,20 +4,26 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <optional>
 #include <vector>
 
 #include "flutter/common/constants.h"
+#include "flutter/display_list/display_list.h"
 #include "flutter/display_list/skia/dl_sk_dispatcher.h"
 #include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
+#include "flutter/flow/raster_cache_atlas.h"
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColorSpace.h"
 #include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPixmap.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "third_party/skia/include/gpu/ganesh/SkSurfaceGanesh.h"
@@ -73,13 +79,16 @@ RasterCache::RasterCache(size_t access_threshold,
     : access_threshold_(access_threshold),
       display_list_cache_limit_per_frame_(display_list_cache_limit_per_frame) {}
 
-/// @note Procedure doesn't copy all closures.
-std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
+RasterCache::~RasterCache() = default;
+
+// Renders |draw_function| into a new surface covering the device bounds of
+// the logical rect of |context|, a GPU surface if |context| has a
+// GrDirectContext and a raster surface otherwise.
+static sk_sp<SkSurface> RasterizeToSurface(
     const RasterCache::Context& context,
-    sk_sp<const DlRTree> rtree,
     const std::function<void(DlCanvas*)>& draw_function,
-    const std::function<void(DlCanvas*, const SkRect& rect)>& draw_checkerboard)
-    const {
+    const std::function<void(DlCanvas*, const SkRect& rect)>*
+        draw_checkerboard) {
   auto matrix = RasterCacheUtil::GetIntegralTransCTM(context.matrix);
   SkRect dest_rect =
       RasterCacheUtil::GetRoundedOutDeviceBounds(context.logical_rect, matrix);
@@ -104,8 +113,24 @@ std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
   canvas.Transform(matrix);
   draw_function(&canvas);
 
-  if (checkerboard_images_) {
-    draw_checkerboard(&canvas, context.logical_rect);
+  if (draw_checkerboard) {
+    (*draw_checkerboard)(&canvas, context.logical_rect);
+  }
+  return surface;
+}
+
+/// @note Procedure doesn't copy all closures.
+std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
+    const RasterCache::Context& context,
+    sk_sp<const DlRTree> rtree,
+    const std::function<void(DlCanvas*)>& draw_function,
+    const std::function<void(DlCanvas*, const SkRect& rect)>& draw_checkerboard)
+    const {
+  sk_sp<SkSurface> surface =
+      RasterizeToSurface(context, draw_function,
+                         checkerboard_images_ ? &draw_checkerboard : nullptr);
+  if (!surface) {
+    return nullptr;
   }
 
   auto image = DlImage::Make(surface->makeImageSnapshot());
@@ -121,12 +146,45 @@ bool RasterCache::UpdateCacheEntry(
   RasterCacheKey key = RasterCacheKey(id, raster_cache_context.matrix);
   Entry& entry = cache_[key];
   if (!entry.image) {
+    // Avoid rasterizing images that would not fit in the byte budget, N32
+    // images take 4 bytes per pixel.
+    SkRect device_rect = RasterCacheUtil::GetRoundedOutDeviceBounds(
+        raster_cache_context.logical_rect,
+        RasterCacheUtil::GetIntegralTransCTM(raster_cache_context.matrix));
+    if (!MakeRoomFor(
+            static_cast<size_t>(device_rect.width() * device_rect.height()) * 4,
+            false)) {
+      return false;
+    }
     void (*func)(DlCanvas*, const SkRect& rect) = DrawCheckerboard;
-    entry.image = Rasterize(raster_cache_context, std::move(rtree),
-                            render_function, func);
-    if (entry.image != nullptr) {
+    fml::TimePoint start = fml::TimePoint::Now();
+    std::unique_ptr<RasterCacheResult> image;
+    if (atlas_ && RasterCacheAtlas::CanPack(device_rect.width(),
+                                            device_rect.height())) {
+      std::function<void(DlCanvas*, const SkRect& rect)> draw_checkerboard =
+          func;
+      image = atlas_->Rasterize(raster_cache_context, rtree, render_function,
+                                checkerboard_images_ ? &draw_checkerboard
+                                                     : nullptr);
+    }
+    if (!image) {
+      image = Rasterize(raster_cache_context, std::move(rtree),
+                        render_function, func);
+    }
+    if (image != nullptr) {
+      size_t bytes = image->image_bytes();
+      if (!MakeRoomFor(bytes, false)) {
+        return false;
+      }
+      entry.rasterize_time = fml::TimePoint::Now() - start;
+      entry.image = std::move(image);
+      cached_bytes_ += bytes;
+      RasterCacheMetrics& metrics = GetMetricsForKind(key.kind());
+      metrics.rasterize_count++;
+      metrics.rasterize_time = metrics.rasterize_time + entry.rasterize_time;
       switch (id.type()) {
-        case RasterCacheKeyType::kDisplayList: {
+        case RasterCacheKeyType::kDisplayList:
+        case RasterCacheKeyType::kDisplayListContent: {
           display_list_cached_this_frame_++;
           break;
         }
@@ -139,6 +197,136 @@ bool RasterCache::UpdateCacheEntry(
   return entry.image != nullptr;
 }
 
+bool RasterCache::UpdateDisplayListCacheEntry(
+    const RasterCacheKeyID& id,
+    const Context& raster_cache_context,
+    const sk_sp<DisplayList>& display_list) const {
+  auto render_function = [display_list](DlCanvas* canvas) {
+    canvas->DrawDisplayList(display_list);
+  };
+  // Fills render into a CPU surface on another thread, where the textures and
+  // deferred images of the raster thread can't be drawn.
+  if (!async_fill_task_runner_ || !display_list->isUIThreadSafe() ||
+      display_list->has_images()) {
+    return UpdateCacheEntry(id, raster_cache_context, render_function,
+                            display_list->rtree());
+  }
+
+  RasterCacheKey key = RasterCacheKey(id, raster_cache_context.matrix);
+  Entry& entry = cache_[key];
+  if (entry.image) {
+    return true;
+  }
+  if (entry.fill_pending) {
+    return false;
+  }
+  SkRect device_rect = RasterCacheUtil::GetRoundedOutDeviceBounds(
+      raster_cache_context.logical_rect,
+      RasterCacheUtil::GetIntegralTransCTM(raster_cache_context.matrix));
+  size_t fill_bytes =
+      static_cast<size_t>(device_rect.width() * device_rect.height()) * 4;
+  if (!MakeRoomFor(fill_bytes, false)) {
+    return false;
+  }
+  // The bytes are reserved until the result of the fill is installed, so
+  // that fills started in the same frame don't overrun the budget together.
+  entry.fill_pending = true;
+  entry.pending_fill_bytes = fill_bytes;
+  pending_fill_bytes_ += fill_bytes;
+  // Fills count towards the per frame limit when they are started, which
+  // keeps the work queued on the fill task runner bounded.
+  display_list_cached_this_frame_++;
+
+  std::optional<std::function<void(DlCanvas*, const SkRect& rect)>>
+      draw_checkerboard;
+  if (checkerboard_images_) {
+    draw_checkerboard = DrawCheckerboard;
+  }
+  async_fill_task_runner_->PostTask(
+      [results = async_fill_results_, upload = async_fill_upload_, key,
+       generation = fill_generation_, render_function,
+       rtree = display_list->rtree(),
+       dst_color_space = raster_cache_context.dst_color_space,
+       matrix = raster_cache_context.matrix,
+       logical_rect = raster_cache_context.logical_rect,
+       flow_type = raster_cache_context.flow_type, draw_checkerboard]() {
+        TRACE_EVENT0("flutter", "RasterCache::AsyncFill");
+        fml::TimePoint start = fml::TimePoint::Now();
+        RasterCache::Context context = {
+            // clang-format off
+            .gr_context         = nullptr,
+            .dst_color_space    = dst_color_space,
+            .matrix             = matrix,
+            .logical_rect       = logical_rect,
+            .flow_type          = flow_type,
+            // clang-format on
+        };
+        sk_sp<SkSurface> surface = RasterizeToSurface(
+            context, render_function,
+            draw_checkerboard.has_value() ? &draw_checkerboard.value()
+                                          : nullptr);
+        sk_sp<DlImage> image;
+        SkPixmap pixmap;
+        if (surface && surface->peekPixels(&pixmap)) {
+          image = upload
+                      ? upload(pixmap)
+                      : DlImage::Make(SkImages::RasterFromPixmapCopy(pixmap));
+        }
+        std::scoped_lock lock(results->mutex);
+        results->results.push_back({
+            .key = key,
+            .generation = generation,
+            .rasterize_time = fml::TimePoint::Now() - start,
+            .image = image ? std::make_unique<RasterCacheResult>(
+                                 image, logical_rect, flow_type, rtree)
+                           : nullptr,
+        });
+      });
+  return false;
+}
+
+void RasterCache::SetAsyncFillTaskRunner(
+    fml::RefPtr<fml::TaskRunner> task_runner,
+    AsyncUploadFunction upload) {
+  async_fill_task_runner_ = std::move(task_runner);
+  async_fill_upload_ = std::move(upload);
+}
+
+void RasterCache::InstallAsyncFillResults() {
+  std::vector<AsyncFillResults::Result> results;
+  {
+    std::scoped_lock lock(async_fill_results_->mutex);
+    results.swap(async_fill_results_->results);
+  }
+  for (auto& result : results) {
+    auto it = cache_.find(result.key);
+    if (it == cache_.end() || !it->second.fill_pending ||
+        result.generation != fill_generation_) {
+      // The entry was evicted or the cache cleared while the fill ran.
+      continue;
+    }
+    Entry& entry = it->second;
+    entry.fill_pending = false;
+    pending_fill_bytes_ -= entry.pending_fill_bytes;
+    entry.pending_fill_bytes = 0;
+    if (!result.image) {
+      continue;
+    }
+    size_t bytes = result.image->image_bytes();
+    if (!MakeRoomFor(bytes, false)) {
+      continue;
+    }
+    entry.rasterize_time = result.rasterize_time;
+    entry.image = std::move(result.image);
+    cached_bytes_ += bytes;
+    // The fill ran on another thread, but it is counted towards the frame
+    // that starts using its image.
+    RasterCacheMetrics& metrics = GetMetricsForKind(result.key.kind());
+    metrics.rasterize_count++;
+    metrics.rasterize_time = metrics.rasterize_time + result.rasterize_time;
+  }
+}
+
 RasterCache::CacheInfo RasterCache::MarkSeen(const RasterCacheKeyID& id,
                                              const SkMatrix& matrix,
                                              bool visible) const {
@@ -146,6 +334,9 @@ RasterCache::CacheInfo RasterCache::MarkSeen(const RasterCacheKeyID& id,
   Entry& entry = cache_[key];
   entry.encountered_this_frame = true;
   entry.visible_this_frame = visible;
+  if (visible) {
+    entry.last_visible_frame = frame_number_;
+  }
   if (visible || entry.accesses_since_visible > 0) {
     entry.accesses_since_visible++;
   }
@@ -184,32 +375,45 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
 
   if (entry.image) {
     entry.image->draw(canvas, paint, preserve_rtree);
+    draw_hit_count_++;
+    GetMetricsForKind(it->first.kind()).hit_count++;
     return true;
   }
 
   return false;
 }
 
-void RasterCache::BeginFrame() {
+void RasterCache::BeginFrame(size_t view_count) {
+  frame_number_++;
+  views_to_evict_ = std::max<size_t>(view_count, 1u);
   display_list_cached_this_frame_ = 0;
   picture_metrics_ = {};
   layer_metrics_ = {};
+  InstallAsyncFillResults();
 }
 
 void RasterCache::UpdateMetrics() {
   for (auto it = cache_.begin(); it != cache_.end(); ++it) {
     Entry& entry = it->second;
     FML_DCHECK(entry.encountered_this_frame);
+    RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
     if (entry.image) {
-      RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
       metrics.in_use_count++;
       metrics.in_use_bytes += entry.image->image_bytes();
+    } else {
+      metrics.miss_count++;
     }
     entry.encountered_this_frame = false;
   }
 }
 
 void RasterCache::EvictUnusedCacheEntries() {
+  if (views_to_evict_ > 1) {
+    views_to_evict_--;
+    return;
+  }
+  views_to_evict_ = 0;
+
   std::vector<RasterCacheKey::Map<Entry>::iterator> dead;
 
   for (auto it = cache_.begin(); it != cache_.end(); ++it) {
@@ -224,18 +428,111 @@ void RasterCache::EvictUnusedCacheEntries() {
       RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
       metrics.eviction_count++;
       metrics.eviction_bytes += it->second.image->image_bytes();
+      cached_bytes_ -= it->second.image->image_bytes();
     }
+    pending_fill_bytes_ -= it->second.pending_fill_bytes;
     cache_.erase(it);
   }
 }
 
+void RasterCache::EvictImage(RasterCacheKey::Map<Entry>::iterator it) const {
+  FML_DCHECK(it->second.image);
+  size_t bytes = it->second.image->image_bytes();
+  RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
+  metrics.eviction_count++;
+  metrics.eviction_bytes += bytes;
+  cached_bytes_ -= bytes;
+  // The entry itself is kept so that its access count is not lost.
+  it->second.image.reset();
+}
+
+bool RasterCache::MakeRoomFor(size_t bytes, bool evict_visible) const {
+  if (bytes > max_bytes_) {
+    return false;
+  }
+  size_t available = max_bytes_ - bytes;
+  if (cached_bytes_ + pending_fill_bytes_ <= available) {
+    return true;
+  }
+
+  std::vector<RasterCacheKey::Map<Entry>::iterator> candidates;
+  size_t evictable_bytes = 0;
+  for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+    const Entry& entry = it->second;
+    if (entry.image &&
+        (evict_visible || entry.last_visible_frame != frame_number_)) {
+      candidates.push_back(it);
+      evictable_bytes += entry.image->image_bytes();
+    }
+  }
+  if (cached_bytes_ + pending_fill_bytes_ - evictable_bytes > available) {
+    // Evicting would not help, keep what is already cached.
+    return false;
+  }
+
+  auto cost_per_byte = [](const Entry& entry) {
+    return entry.rasterize_time.ToNanosecondsF() /
+           std::max<int64_t>(entry.image->image_bytes(), 1);
+  };
+  std::sort(candidates.begin(), candidates.end(),
+            [this, &cost_per_byte](const auto& a, const auto& b) {
+              if (eviction_policy_ == RasterCacheEvictionPolicy::kCostAware) {
+                double a_cost = cost_per_byte(a->second);
+                double b_cost = cost_per_byte(b->second);
+                if (a_cost != b_cost) {
+                  return a_cost < b_cost;
+                }
+              }
+              return a->second.last_visible_frame <
+                     b->second.last_visible_frame;
+            });
+  for (auto it : candidates) {
+    if (cached_bytes_ + pending_fill_bytes_ <= available) {
+      break;
+    }
+    EvictImage(it);
+  }
+  return true;
+}
+
+void RasterCache::SetMaxBytes(size_t max_bytes) {
+  max_bytes_ = max_bytes;
+  configured_max_bytes_ = max_bytes;
+  low_memory_frames_left_ = 0;
+  MakeRoomFor(0, true);
+}
+
+void RasterCache::NotifyLowMemory() {
+  size_t min_bytes = configured_max_bytes_ == kUnlimitedBytes
+                         ? kLowMemoryMinBytes
+                         : configured_max_bytes_ / kLowMemoryBudgetDivisor;
+  size_t budget = max_bytes_ == kUnlimitedBytes ? cached_bytes_ : max_bytes_;
+  max_bytes_ = std::min(std::max(budget / 2, min_bytes), max_bytes_);
+  low_memory_frames_left_ = kLowMemoryRecoveryFrames;
+  MakeRoomFor(0, true);
+}
+
 void RasterCache::EndFrame() {
+  // Some views of the frame were not painted, evict for them.
+  if (views_to_evict_ > 0) {
+    views_to_evict_ = 1;
+    EvictUnusedCacheEntries();
+  }
+  if (low_memory_frames_left_ > 0 && --low_memory_frames_left_ == 0) {
+    max_bytes_ = configured_max_bytes_;
+  }
   UpdateMetrics();
   TraceStatsToTimeline();
 }
 
 void RasterCache::Clear() {
   cache_.clear();
+  cached_bytes_ = 0;
+  pending_fill_bytes_ = 0;
+  fill_generation_++;
+  if (atlas_) {
+    atlas_->Clear();
+  }
   picture_metrics_ = {};
   layer_metrics_ = {};
 }
@@ -276,6 +573,14 @@ void RasterCache::SetCheckboardCacheImages(bool checkerboard) {
   Clear();
 }
 
+void RasterCache::SetAtlasEnabled(bool enabled) {
+  if (enabled == atlas_enabled()) {
+    return;
+  }
+  Clear();
+  atlas_ = enabled ? std::make_unique<RasterCacheAtlas>() : nullptr;
+}
+
 void RasterCache::TraceStatsToTimeline() const {
 #if !FLUTTER_RELEASE
   FML_TRACE_COUNTER(
@@ -285,6 +590,19 @@ void RasterCache::TraceStatsToTimeline() const {
       "LayerMBytes", layer_metrics_.total_bytes() / kMegaByteSizeInBytes,  //
       "PictureCount", picture_metrics_.total_count(),                      //
       "PictureMBytes", picture_metrics_.total_bytes() / kMegaByteSizeInBytes);
+  FML_TRACE_COUNTER(
+      "flutter",                                                         //
+      "RasterCacheReuse", reinterpret_cast<int64_t>(this),               //
+      "LayerHits", layer_metrics_.hit_count,                             //
+      "LayerMisses", layer_metrics_.miss_count,                          //
+      "LayerEvictions", layer_metrics_.eviction_count,                   //
+      "LayerRasterizeMicros",                                            //
+      layer_metrics_.rasterize_time.ToMicroseconds(),                    //
+      "PictureHits", picture_metrics_.hit_count,                         //
+      "PictureMisses", picture_metrics_.miss_count,                      //
+      "PictureEvictions", picture_metrics_.eviction_count,               //
+      "PictureRasterizeMicros",                                          //
+      picture_metrics_.rasterize_time.ToMicroseconds());
 
 #endif  // !FLUTTER_RELEASE
 }
@@ -311,7 +629,8 @@ size_t RasterCache::EstimatePictureCacheByteSize() const {
   return picture_cache_bytes;
 }
 
-RasterCacheMetrics& RasterCache::GetMetricsForKind(RasterCacheKeyKind kind) {
+RasterCacheMetrics& RasterCache::GetMetricsForKind(
+    RasterCacheKeyKind kind) const {
   switch (kind) {
     case RasterCacheKeyKind::kDisplayListMetrics:
       return picture_metrics_;
@@ -5,25 +5,43 @@
 #ifndef FLUTTER_FLOW_RASTER_CACHE_H_
 #define FLUTTER_FLOW_RASTER_CACHE_H_
 
+#include <functional>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "flutter/display_list/dl_canvas.h"
 #include "flutter/flow/raster_cache_key.h"
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkRect.h"
 
 class GrDirectContext;
 class SkColorSpace;
+class SkPixmap;
 
 namespace flutter {
 
 enum class RasterCacheLayerStrategy { kLayer, kLayerChildren };
 
+// The order in which cached images are evicted when the cache is over its
+// byte budget, see |RasterCache::SetMaxBytes|.
+enum class RasterCacheEvictionPolicy {
+  // Evict the images that have not been visible for the longest first.
+  kLeastRecentlyUsed,
+  // Evict the images that took the least time to rasterize per byte first,
+  // so that the images that are the most expensive to recreate are kept.
+  kCostAware,
+};
+
 class RasterCacheResult {
  public:
   RasterCacheResult(sk_sp<DlImage> image,
@@ -45,6 +63,11 @@ class RasterCacheResult {
     return image_ ? image_->GetApproximateByteSize() : 0;
   };
 
+ protected:
+  const SkRect& logical_rect() const { return logical_rect_; }
+  const fml::tracing::TraceFlow& flow() const { return flow_; }
+  const sk_sp<const DlRTree>& rtree() const { return rtree_; }
+
  private:
   sk_sp<DlImage> image_;
   SkRect logical_rect_;
@@ -53,6 +76,7 @@ class RasterCacheResult {
 };
 
 class Layer;
+class RasterCacheAtlas;
 class RasterCacheItem;
 struct PrerollContext;
 struct PaintContext;
@@ -78,6 +102,28 @@ struct RasterCacheMetrics {
    */
   size_t in_use_bytes = 0;
 
+  /**
+   * The number of times a cached image was drawn in this frame.
+   */
+  size_t hit_count = 0;
+
+  /**
+   * The number of cache entries encountered in this frame that had no image,
+   * because they were not accessed often enough yet, did not fit, or are
+   * still being filled.
+   */
+  size_t miss_count = 0;
+
+  /**
+   * The number of images rasterized into the cache in this frame.
+   */
+  size_t rasterize_count = 0;
+
+  /**
+   * The time spent rasterizing those images.
+   */
+  fml::TimeDelta rasterize_time;
+
   /**
    * The total cache entries that had images during this frame.
    */
@@ -106,7 +152,12 @@ struct RasterCacheMetrics {
  *   - RasterCache::EvictUnusedCacheEntries
  *       Evict cached images that are no longer used.
  *   - LayerTree::TryToPrepareRasterCache
- *       Create cache image for each cache entry if it does not exist.
+ *       Create cache image for each cache entry if it does not exist. If the
+ *       new image does not fit in the byte budget, images of entries that
+ *       are not visible in this frame are evicted to make room for it.
+ *       With |SetAsyncFillTaskRunner|, DisplayList images are instead
+ *       rasterized on another thread and installed by the next
+ *       |BeginFrame|.
  *   - LayerTree::Paint - for each layer in the tree:
  *       If layers or display lists are cached as cached images, the method
  *       `RasterCache::Draw` will be used to draw those cache images.
@@ -127,6 +178,12 @@ class RasterCache {
     const bool has_image;
   };
 
+  // Makes a texture, or other image that can be drawn on the raster thread,
+  // from pixels rasterized by an asynchronous cache fill. Called on the
+  // fill task runner.
+  using AsyncUploadFunction =
+      std::function<sk_sp<DlImage>(const SkPixmap& pixmap)>;
+
   std::unique_ptr<RasterCacheResult> Rasterize(
       const RasterCache::Context& context,
       sk_sp<const DlRTree> rtree,
@@ -139,7 +196,7 @@ class RasterCache {
       size_t picture_and_display_list_cache_limit_per_frame =
           RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame);
 
-  virtual ~RasterCache() = default;
+  virtual ~RasterCache();
 
   // Draws this item if it should be rendered from the cache and returns
   // true iff it was successfully drawn. Typically this should only fail
@@ -158,7 +215,15 @@ class RasterCache {
 
   bool HasEntry(const RasterCacheKeyID& id, const SkMatrix&) const;
 
-  void BeginFrame();
+  /**
+   * @brief Begins a frame that paints |view_count| layer trees, one for each
+   * view of the frame, into this cache.
+   *
+   * Entries are only evicted by the |EvictUnusedCacheEntries| of the last
+   * view, so that the entries of the views that are prerolled later in the
+   * frame survive the painting of the earlier views.
+   */
+  void BeginFrame(size_t view_count = 1);
 
   void EvictUnusedCacheEntries();
 
@@ -168,11 +233,83 @@ class RasterCache {
 
   void SetCheckboardCacheImages(bool checkerboard);
 
+  static constexpr size_t kUnlimitedBytes = std::numeric_limits<size_t>::max();
+
+  // The smallest budget low memory notifications shrink an unlimited budget
+  // to. A configured budget is kept above 1/|kLowMemoryBudgetDivisor| of it.
+  static constexpr size_t kLowMemoryMinBytes = 4 * 1024 * 1024;
+  static constexpr size_t kLowMemoryBudgetDivisor = 8;
+
+  // The frames without a low memory notification after which the configured
+  // budget is restored.
+  static constexpr size_t kLowMemoryRecoveryFrames = 120;
+
+  /**
+   * @brief Limit the total size of the cached images to |max_bytes|,
+   * evicting images that no longer fit according to the eviction policy.
+   */
+  void SetMaxBytes(size_t max_bytes);
+
+  size_t max_bytes() const { return max_bytes_; }
+
+  void SetEvictionPolicy(RasterCacheEvictionPolicy policy) {
+    eviction_policy_ = policy;
+  }
+
+  RasterCacheEvictionPolicy eviction_policy() const {
+    return eviction_policy_;
+  }
+
+  /**
+   * @brief Halve the byte budget, or the bytes currently cached if the budget
+   * is unlimited, down to a floor, and evict images to fit. The budget set by
+   * |SetMaxBytes| is restored once |kLowMemoryRecoveryFrames| frames ended
+   * without another notification.
+   */
+  void NotifyLowMemory();
+
+  /**
+   * @brief The size of all of the images currently held by the cache.
+   */
+  size_t cached_bytes() const { return cached_bytes_; }
+
+  /**
+   * @brief Rasterize new DisplayList cache images on |task_runner| instead
+   * of inline during the frame.
+   *
+   * The frame that requests an image draws the DisplayList uncached and the
+   * image is used from the first frame that begins after it is ready.
+   * DisplayLists are rasterized in software and |upload| turns the pixels
+   * into an image for the raster thread, the same way decoded images are
+   * uploaded on the IO thread. DisplayLists that are not thread safe, and
+   * layers, are still rasterized inline. A null |task_runner| restores
+   * inline rasterization for everything.
+   */
+  void SetAsyncFillTaskRunner(fml::RefPtr<fml::TaskRunner> task_runner,
+                              AsyncUploadFunction upload);
+
+  bool async_fill_enabled() const { return async_fill_task_runner_ != nullptr; }
+
+  /**
+   * @brief Pack images of up to |RasterCacheAtlas::kMaxEntrySize| pixels
+   * square into shared atlas pages instead of giving each its own image,
+   * see |RasterCacheAtlas|. Changing the setting clears the cache.
+   */
+  void SetAtlasEnabled(bool enabled);
+
+  bool atlas_enabled() const { return atlas_ != nullptr; }
+
   const RasterCacheMetrics& picture_metrics() const { return picture_metrics_; }
   const RasterCacheMetrics& layer_metrics() const { return layer_metrics_; }
 
   size_t GetCachedEntriesCount() const;
 
+  /**
+   * Return the number of successful |Draw| calls made since this cache was
+   * created. Callers interested in a span of work compare two readings.
+   */
+  size_t draw_hit_count() const { return draw_hit_count_; }
+
   /**
    * Return the number of map entries in the layer cache regardless of whether
    * the entries have been populated with an image.
@@ -246,25 +383,90 @@ class RasterCache {
                         const std::function<void(DlCanvas*)>& render_function,
                         sk_sp<const DlRTree> rtree = nullptr) const;
 
+  /**
+   * @brief The |UpdateCacheEntry| for DisplayLists, which starts an
+   * asynchronous fill if |SetAsyncFillTaskRunner| is in effect.
+   * @return whether the entry has an image that can be drawn in this frame.
+   */
+  bool UpdateDisplayListCacheEntry(
+      const RasterCacheKeyID& id,
+      const Context& raster_cache_context,
+      const sk_sp<DisplayList>& display_list) const;
+
  private:
   struct Entry {
     bool encountered_this_frame = false;
     bool visible_this_frame = false;
     size_t accesses_since_visible = 0;
+    // The last frame, counted by |BeginFrame|, in which the entry was
+    // visible.
+    size_t last_visible_frame = 0;
+    // How long it took to rasterize |image|.
+    fml::TimeDelta rasterize_time;
+    // An asynchronous fill of |image| has been started.
+    bool fill_pending = false;
+    // The bytes reserved for the pending fill in |pending_fill_bytes_|.
+    size_t pending_fill_bytes = 0;
     std::unique_ptr<RasterCacheResult> image;
   };
 
+  // Images rasterized by asynchronous fills waiting for the next
+  // |BeginFrame|. Shared with the fill tasks, which may outlive the cache.
+  struct AsyncFillResults {
+    struct Result {
+      RasterCacheKey key;
+      size_t generation;
+      fml::TimeDelta rasterize_time;
+      std::unique_ptr<RasterCacheResult> image;
+    };
+
+    std::mutex mutex;
+    std::vector<Result> results;
+  };
+
+  void InstallAsyncFillResults();
+
   void UpdateMetrics();
 
-  RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind);
+  RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind) const;
+
+  // Evicts images, in the order of the eviction policy, until |bytes| more
+  // fit in the byte budget. Images of entries that are visible in this
+  // frame are only evicted if |evict_visible| is true. Returns false if
+  // there is not enough room even after evicting all candidates.
+  bool MakeRoomFor(size_t bytes, bool evict_visible) const;
+
+  void EvictImage(RasterCacheKey::Map<Entry>::iterator it) const;
 
   const size_t access_threshold_;
   const size_t display_list_cache_limit_per_frame_;
   mutable size_t display_list_cached_this_frame_ = 0;
-  RasterCacheMetrics layer_metrics_;
-  RasterCacheMetrics picture_metrics_;
+  mutable RasterCacheMetrics layer_metrics_;
+  mutable RasterCacheMetrics picture_metrics_;
   mutable RasterCacheKey::Map<Entry> cache_;
+  mutable size_t cached_bytes_ = 0;
+  // The bytes of the images of pending fills, which |MakeRoomFor| counts
+  // as cached.
+  mutable size_t pending_fill_bytes_ = 0;
+  mutable size_t draw_hit_count_ = 0;
+  size_t max_bytes_ = kUnlimitedBytes;
+  // The budget set by |SetMaxBytes|, which |max_bytes_| is below while the
+  // cache recovers from low memory.
+  size_t configured_max_bytes_ = kUnlimitedBytes;
+  size_t low_memory_frames_left_ = 0;
+  RasterCacheEvictionPolicy eviction_policy_ =
+      RasterCacheEvictionPolicy::kLeastRecentlyUsed;
+  size_t frame_number_ = 0;
+  // The views of this frame that have yet to call |EvictUnusedCacheEntries|.
+  size_t views_to_evict_ = 0;
   bool checkerboard_images_ = false;
+  fml::RefPtr<fml::TaskRunner> async_fill_task_runner_;
+  AsyncUploadFunction async_fill_upload_;
+  std::shared_ptr<AsyncFillResults> async_fill_results_ =
+      std::make_shared<AsyncFillResults>();
+  // Incremented by |Clear| so that fills started earlier are dropped.
+  size_t fill_generation_ = 0;
+  std::unique_ptr<RasterCacheAtlas> atlas_;
 
   void TraceStatsToTimeline() const;
 
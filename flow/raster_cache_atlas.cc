@@ -0,0 +1,224 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_cache_atlas.h"
+
+#include <optional>
+
+#include "flutter/display_list/skia/dl_sk_canvas.h"
+#include "flutter/flow/raster_cache_util.h"
+#include "flutter/impeller/typographer/rectangle_packer.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkRSXform.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/ganesh/SkSurfaceGanesh.h"
+
+namespace flutter {
+
+// Keeps neighboring regions apart so that no sampling bleeds between them.
+static constexpr int kRegionPadding = 1;
+
+class RasterCacheAtlasPage {
+ public:
+  explicit RasterCacheAtlasPage(sk_sp<SkSurface> surface)
+      : surface_(std::move(surface)),
+        packer_(impeller::RectanglePacker::Factory(
+            RasterCacheAtlas::kPageSize,
+            RasterCacheAtlas::kPageSize)) {}
+
+  std::optional<SkIRect> Allocate(int width, int height) {
+    impeller::IPoint16 location;
+    if (!packer_->addRect(width + kRegionPadding, height + kRegionPadding,
+                          &location)) {
+      return std::nullopt;
+    }
+    live_regions_++;
+    return SkIRect::MakeXYWH(location.x(), location.y(), width, height);
+  }
+
+  // Called when a result drawn from this page is destroyed. The page is
+  // emptied once none are left.
+  void Release() {
+    FML_DCHECK(live_regions_ > 0);
+    if (--live_regions_ == 0) {
+      packer_->reset();
+    }
+  }
+
+  // The canvas to rasterize a newly allocated region with. Drops the snapshot
+  // first so that the surface does not have to copy its contents.
+  SkCanvas* BeginWrite() {
+    snapshot_.reset();
+    return surface_->getCanvas();
+  }
+
+  const sk_sp<DlImage>& image() {
+    if (!snapshot_) {
+      snapshot_ = DlImage::Make(surface_->makeImageSnapshot());
+    }
+    return snapshot_;
+  }
+
+ private:
+  sk_sp<SkSurface> surface_;
+  std::unique_ptr<impeller::RectanglePacker> packer_;
+  sk_sp<DlImage> snapshot_;
+  size_t live_regions_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RasterCacheAtlasPage);
+};
+
+namespace {
+
+class AtlasRasterCacheResult : public RasterCacheResult {
+ public:
+  AtlasRasterCacheResult(std::shared_ptr<RasterCacheAtlasPage> page,
+                         const SkIRect& region,
+                         const SkRect& logical_rect,
+                         const char* type,
+                         sk_sp<const DlRTree> rtree)
+      : RasterCacheResult(nullptr, logical_rect, type, std::move(rtree)),
+        page_(std::move(page)),
+        region_(region) {}
+
+  ~AtlasRasterCacheResult() override { page_->Release(); }
+
+  void draw(DlCanvas& canvas,
+            const DlPaint* paint,
+            bool preserve_rtree) const override {
+    DlAutoCanvasRestore auto_restore(&canvas, true);
+
+    auto matrix = RasterCacheUtil::GetIntegralTransCTM(canvas.GetTransform());
+    SkRect bounds =
+        RasterCacheUtil::GetRoundedOutDeviceBounds(logical_rect(), matrix);
+    FML_DCHECK(std::abs(bounds.width() - region_.width()) <= 1 &&
+               std::abs(bounds.height() - region_.height()) <= 1);
+    canvas.TransformReset();
+    flow().Step();
+
+    std::vector<SkRSXform> xforms;
+    std::vector<SkRect> tex;
+    if (!preserve_rtree || !rtree()) {
+      xforms.push_back(SkRSXform::Make(1, 0, bounds.fLeft, bounds.fTop));
+      tex.push_back(SkRect::Make(region_));
+    } else {
+      // Draw the individual rects of the RTree, as |RasterCacheResult| does,
+      // but with a single call.
+      SkRect rtree_bounds = RasterCacheUtil::GetRoundedOutDeviceBounds(
+          rtree()->bounds(), matrix);
+      for (auto rect : rtree()->region().getRects(true)) {
+        SkRect device_rect = RasterCacheUtil::GetRoundedOutDeviceBounds(
+            SkRect::Make(rect), matrix);
+        device_rect.offset(-rtree_bounds.fLeft, -rtree_bounds.fTop);
+        xforms.push_back(SkRSXform::Make(1, 0, bounds.fLeft + device_rect.fLeft,
+                                         bounds.fTop + device_rect.fTop));
+        tex.push_back(device_rect.makeOffset(region_.fLeft, region_.fTop));
+      }
+    }
+    canvas.DrawAtlas(page_->image(), xforms.data(), tex.data(), nullptr,
+                     xforms.size(), DlBlendMode::kSrcOver,
+                     DlImageSampling::kNearestNeighbor, nullptr, paint);
+  }
+
+  SkISize image_dimensions() const override { return region_.size(); }
+
+  int64_t image_bytes() const override {
+    return static_cast<int64_t>(region_.width()) * region_.height() * 4;
+  }
+
+ private:
+  std::shared_ptr<RasterCacheAtlasPage> page_;
+  SkIRect region_;
+};
+
+}  // namespace
+
+RasterCacheAtlas::RasterCacheAtlas() = default;
+
+RasterCacheAtlas::~RasterCacheAtlas() = default;
+
+bool RasterCacheAtlas::CanPack(int width, int height) {
+  return width > 0 && height > 0 && width <= kMaxEntrySize &&
+         height <= kMaxEntrySize;
+}
+
+std::unique_ptr<RasterCacheResult> RasterCacheAtlas::Rasterize(
+    const RasterCache::Context& context,
+    sk_sp<const DlRTree> rtree,
+    const std::function<void(DlCanvas*)>& draw_function,
+    const std::function<void(DlCanvas*, const SkRect& rect)>*
+        draw_checkerboard) {
+  auto matrix = RasterCacheUtil::GetIntegralTransCTM(context.matrix);
+  SkRect dest_rect =
+      RasterCacheUtil::GetRoundedOutDeviceBounds(context.logical_rect, matrix);
+  int width = dest_rect.width();
+  int height = dest_rect.height();
+  if (!CanPack(width, height)) {
+    return nullptr;
+  }
+
+  if (context.gr_context != gr_context_ ||
+      !SkColorSpace::Equals(context.dst_color_space.get(),
+                            color_space_.get())) {
+    // Pages can only be drawn to surfaces of the same context.
+    Clear();
+    gr_context_ = context.gr_context;
+    color_space_ = context.dst_color_space;
+  }
+
+  std::shared_ptr<RasterCacheAtlasPage> page;
+  std::optional<SkIRect> region;
+  for (auto& candidate : pages_) {
+    region = candidate->Allocate(width, height);
+    if (region.has_value()) {
+      page = candidate;
+      break;
+    }
+  }
+  if (!region.has_value()) {
+    if (pages_.size() >= kMaxPageCount) {
+      return nullptr;
+    }
+    const SkImageInfo image_info =
+        SkImageInfo::MakeN32Premul(kPageSize, kPageSize, color_space_);
+    sk_sp<SkSurface> surface =
+        gr_context_ ? SkSurfaces::RenderTarget(
+                          gr_context_, skgpu::Budgeted::kYes, image_info)
+                    : SkSurfaces::Raster(image_info);
+    if (!surface) {
+      return nullptr;
+    }
+    page = std::make_shared<RasterCacheAtlasPage>(std::move(surface));
+    pages_.push_back(page);
+    region = page->Allocate(width, height);
+    if (!region.has_value()) {
+      return nullptr;
+    }
+  }
+
+  DlSkCanvasAdapter canvas(page->BeginWrite());
+  canvas.Save();
+  canvas.ClipRect(SkRect::Make(region.value()), DlCanvas::ClipOp::kIntersect,
+                  false);
+  canvas.Clear(DlColor::kTransparent());
+  canvas.Translate(region->fLeft - dest_rect.left(),
+                   region->fTop - dest_rect.top());
+  canvas.Transform(matrix);
+  draw_function(&canvas);
+  if (draw_checkerboard) {
+    (*draw_checkerboard)(&canvas, context.logical_rect);
+  }
+  canvas.Restore();
+
+  return std::make_unique<AtlasRasterCacheResult>(
+      std::move(page), region.value(), context.logical_rect, context.flow_type,
+      std::move(rtree));
+}
+
+void RasterCacheAtlas::Clear() {
+  pages_.clear();
+}
+
+}  // namespace flutter
@@ -0,0 +1,71 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_RASTER_CACHE_ATLAS_H_
+#define FLUTTER_FLOW_RASTER_CACHE_ATLAS_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "flutter/flow/raster_cache.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace flutter {
+
+class RasterCacheAtlasPage;
+
+//------------------------------------------------------------------------------
+/// @brief      Packs small raster cache images into shared atlas pages.
+///
+/// Images are rasterized directly into a free region of a page and drawn
+/// with |DlCanvas::DrawAtlas|, so that consecutive cached items that live
+/// on the same page bind the same texture and can be combined into a
+/// single draw by the backend.
+///
+/// Regions are not reused individually. A page is emptied once all of the
+/// results drawn from it are gone, like the glyph atlas.
+///
+class RasterCacheAtlas {
+ public:
+  static constexpr int kPageSize = 1024;
+  static constexpr int kMaxEntrySize = 256;
+  static constexpr size_t kMaxPageCount = 4;
+
+  RasterCacheAtlas();
+
+  ~RasterCacheAtlas();
+
+  /// Whether an image of the given device size should be packed into a
+  /// page.
+  static bool CanPack(int width, int height);
+
+  /// Rasterizes |draw_function| into a page and returns a result that draws
+  /// from it, or nullptr if the image is too large or there is no room in
+  /// any page. A new page is added if needed and |kMaxPageCount| allows.
+  std::unique_ptr<RasterCacheResult> Rasterize(
+      const RasterCache::Context& context,
+      sk_sp<const DlRTree> rtree,
+      const std::function<void(DlCanvas*)>& draw_function,
+      const std::function<void(DlCanvas*, const SkRect& rect)>*
+          draw_checkerboard);
+
+  /// Drops all pages. Results that are still alive keep their page until
+  /// they are destroyed.
+  void Clear();
+
+  size_t page_count() const { return pages_.size(); }
+
+ private:
+  std::vector<std::shared_ptr<RasterCacheAtlasPage>> pages_;
+  GrDirectContext* gr_context_ = nullptr;
+  sk_sp<SkColorSpace> color_space_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RasterCacheAtlas);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_RASTER_CACHE_ATLAS_H_
@@ -0,0 +1,135 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_cache_atlas.h"
+
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/skia/dl_sk_canvas.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Collects the atlas images of all DrawAtlas calls.
+class AtlasRecorder : public IgnoreAttributeDispatchHelper,
+                      public IgnoreClipDispatchHelper,
+                      public IgnoreTransformDispatchHelper,
+                      public IgnoreDrawDispatchHelper {
+ public:
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    atlases.push_back(atlas.get());
+  }
+
+  std::vector<const DlImage*> atlases;
+};
+
+std::unique_ptr<RasterCacheResult> RasterizeSquare(RasterCacheAtlas& atlas,
+                                                   int size,
+                                                   DlColor color) {
+  SkMatrix matrix = SkMatrix::I();
+  SkRect logical_rect = SkRect::MakeWH(size, size);
+  RasterCache::Context context = {
+      .gr_context = nullptr,
+      .dst_color_space = nullptr,
+      .matrix = matrix,
+      .logical_rect = logical_rect,
+      .flow_type = "RasterCacheFlow::DisplayList",
+  };
+  return atlas.Rasterize(
+      context, nullptr,
+      [size, color](DlCanvas* canvas) {
+        canvas->DrawRect(SkRect::MakeWH(size, size), DlPaint(color));
+      },
+      nullptr);
+}
+
+}  // namespace
+
+TEST(RasterCacheAtlas, SmallImagesSharePage) {
+  RasterCacheAtlas atlas;
+  auto red = RasterizeSquare(atlas, 50, DlColor::kRed());
+  auto blue = RasterizeSquare(atlas, 50, DlColor::kBlue());
+  ASSERT_NE(red, nullptr);
+  ASSERT_NE(blue, nullptr);
+  EXPECT_EQ(atlas.page_count(), 1u);
+  EXPECT_EQ(red->image_dimensions(), SkISize::Make(50, 50));
+  EXPECT_EQ(red->image_bytes(), 50 * 50 * 4);
+
+  DisplayListBuilder builder;
+  red->draw(builder, nullptr, false);
+  builder.Translate(100, 0);
+  blue->draw(builder, nullptr, false);
+  AtlasRecorder recorder;
+  builder.Build()->Dispatch(recorder);
+  ASSERT_EQ(recorder.atlases.size(), 2u);
+  EXPECT_EQ(recorder.atlases[0], recorder.atlases[1]);
+}
+
+TEST(RasterCacheAtlas, DrawsTheRegionOfTheEntry) {
+  RasterCacheAtlas atlas;
+  auto red = RasterizeSquare(atlas, 20, DlColor::kRed());
+  auto blue = RasterizeSquare(atlas, 20, DlColor::kBlue());
+  ASSERT_NE(red, nullptr);
+  ASSERT_NE(blue, nullptr);
+
+  sk_sp<SkSurface> surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(
+      100, 100, SkColorSpace::MakeSRGB()));
+  DlSkCanvasAdapter canvas(surface->getCanvas());
+  canvas.Clear(DlColor::kTransparent());
+  canvas.Translate(30, 30);
+  blue->draw(canvas, nullptr, false);
+
+  SkBitmap bitmap;
+  bitmap.allocPixels(SkImageInfo::MakeN32Premul(100, 100));
+  ASSERT_TRUE(surface->readPixels(bitmap, 0, 0));
+  EXPECT_EQ(bitmap.getColor(40, 40), SK_ColorBLUE);
+  EXPECT_EQ(bitmap.getColor(29, 29), SK_ColorTRANSPARENT);
+  EXPECT_EQ(bitmap.getColor(50, 50), SK_ColorTRANSPARENT);
+}
+
+TEST(RasterCacheAtlas, LargeImagesAreNotPacked) {
+  RasterCacheAtlas atlas;
+  EXPECT_FALSE(RasterCacheAtlas::CanPack(RasterCacheAtlas::kMaxEntrySize + 1,
+                                         10));
+  EXPECT_EQ(RasterizeSquare(atlas, RasterCacheAtlas::kMaxEntrySize + 1,
+                            DlColor::kRed()),
+            nullptr);
+  EXPECT_EQ(atlas.page_count(), 0u);
+}
+
+TEST(RasterCacheAtlas, PagesAreReusedOnceEmpty) {
+  RasterCacheAtlas atlas;
+  std::vector<std::unique_ptr<RasterCacheResult>> results;
+  while (auto result = RasterizeSquare(atlas, RasterCacheAtlas::kMaxEntrySize,
+                                       DlColor::kRed())) {
+    results.push_back(std::move(result));
+  }
+  EXPECT_EQ(atlas.page_count(), RasterCacheAtlas::kMaxPageCount);
+  ASSERT_GT(results.size(), RasterCacheAtlas::kMaxPageCount);
+
+  results.clear();
+  EXPECT_NE(RasterizeSquare(atlas, RasterCacheAtlas::kMaxEntrySize,
+                            DlColor::kRed()),
+            nullptr);
+  EXPECT_EQ(atlas.page_count(), RasterCacheAtlas::kMaxPageCount);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,6 +4,7 @@
 
 #include "flutter/flow/raster_cache_key.h"
 #include <optional>
+#include "flutter/display_list/display_list.h"
 #include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/layers/display_list_layer.h"
 #include "flutter/flow/layers/layer.h"
@@ -26,4 +27,15 @@ std::optional<std::vector<RasterCacheKeyID>> RasterCacheKeyID::LayerChildrenIds(
   return ids;
 }
 
+RasterCacheKeyID RasterCacheKeyID::ForDisplayList(
+    const DisplayList& display_list) {
+  std::optional<uint64_t> content_hash = display_list.content_hash();
+  if (content_hash.has_value()) {
+    return RasterCacheKeyID(content_hash.value(),
+                            RasterCacheKeyType::kDisplayListContent);
+  }
+  return RasterCacheKeyID(display_list.unique_id(),
+                          RasterCacheKeyType::kDisplayList);
+}
+
 }  // namespace flutter
@@ -16,9 +16,16 @@
 
 namespace flutter {
 
+class DisplayList;
 class Layer;
 
-enum class RasterCacheKeyType { kLayer, kDisplayList, kLayerChildren };
+enum class RasterCacheKeyType {
+  kLayer,
+  kDisplayList,
+  kLayerChildren,
+  // A DisplayList identified by its content hash rather than its unique id.
+  kDisplayListContent,
+};
 
 class RasterCacheKeyID {
  public:
@@ -42,6 +49,11 @@ class RasterCacheKeyID {
   static std::optional<std::vector<RasterCacheKeyID>> LayerChildrenIds(
       const Layer* layer);
 
+  /// The id used to cache |display_list|. DisplayLists that have a
+  /// content hash are keyed by it, so that a re-recording of the same
+  /// content on a later frame finds the entry cached for the earlier one.
+  static RasterCacheKeyID ForDisplayList(const DisplayList& display_list);
+
   std::size_t GetHash() const {
     if (cached_hash_) {
       return cached_hash_.value();
@@ -93,6 +105,7 @@ class RasterCacheKey {
   RasterCacheKeyKind kind() const {
     switch (id_.type()) {
       case RasterCacheKeyType::kDisplayList:
+      case RasterCacheKeyType::kDisplayListContent:
         return RasterCacheKeyKind::kDisplayListMetrics;
       case RasterCacheKeyType::kLayer:
       case RasterCacheKeyType::kLayerChildren:
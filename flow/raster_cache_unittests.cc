@@ -15,8 +15,11 @@
 #include "flutter/flow/raster_cache_item.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_raster_cache.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
 #include "flutter/testing/assertions_skia.h"
 #include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkPoint.h"
 
@@ -91,6 +94,69 @@ TEST(RasterCache, MetricsOmitUnpopulatedEntries) {
   ASSERT_EQ(cache.picture_metrics().total_bytes(), 25624u);
 }
 
+TEST(RasterCache, MetricsCountHitsMissesAndRasterizations) {
+  size_t threshold = 2;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item(display_list, SkPoint(), true,
+                                               false);
+
+  // The first accesses are below the threshold, so they miss.
+  for (int i = 0; i < 2; i++) {
+    cache.BeginFrame();
+    ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+        display_list_item, preroll_context, paint_context, matrix));
+    ASSERT_FALSE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+    cache.EndFrame();
+    EXPECT_EQ(cache.picture_metrics().hit_count, 0u);
+    EXPECT_EQ(cache.picture_metrics().miss_count, 1u);
+    EXPECT_EQ(cache.picture_metrics().rasterize_count, 0u);
+  }
+
+  // The third access rasterizes the image and draws it.
+  cache.BeginFrame();
+  ASSERT_TRUE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  ASSERT_TRUE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+  EXPECT_EQ(cache.picture_metrics().hit_count, 1u);
+  EXPECT_EQ(cache.picture_metrics().miss_count, 0u);
+  EXPECT_EQ(cache.picture_metrics().rasterize_count, 1u);
+
+  // Later accesses reuse the image.
+  cache.BeginFrame();
+  ASSERT_TRUE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  ASSERT_TRUE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_TRUE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+  EXPECT_EQ(cache.picture_metrics().hit_count, 2u);
+  EXPECT_EQ(cache.picture_metrics().miss_count, 0u);
+  EXPECT_EQ(cache.picture_metrics().rasterize_count, 0u);
+  EXPECT_EQ(cache.layer_metrics().hit_count, 0u);
+}
+
 TEST(RasterCache, ThresholdIsRespectedForDisplayList) {
   size_t threshold = 2;
   flutter::RasterCache cache(threshold);
@@ -266,7 +332,11 @@ TEST(RasterCache, EvictUnusedCacheEntries) {
   SkMatrix matrix = SkMatrix::I();
 
   auto display_list_1 = GetSampleDisplayList();
-  auto display_list_2 = GetSampleDisplayList();
+  // Same bounds as the sample, but different content so that the two
+  // DisplayLists do not share a cache entry.
+  DisplayListBuilder builder(SkRect::MakeWH(150, 100));
+  builder.DrawRect(SkRect::MakeXYWH(10, 10, 80, 80), DlPaint(DlColor::kBlue()));
+  auto display_list_2 = builder.Build();
 
   MockCanvas dummy_canvas(1000, 1000);
   DlPaint paint;
@@ -359,6 +429,183 @@ TEST(RasterCache, EvictUnusedCacheEntries) {
   cache.EndFrame();
 }
 
+namespace {
+
+// Caches an empty 50x50 image, 10000 bytes plus a small overhead, for the
+// DisplayList |id| after marking it as seen.
+bool SeeAndCache(RasterCache& cache, uint64_t id, bool visible) {
+  SkMatrix matrix = SkMatrix::I();
+  SkRect logical_rect = SkRect::MakeWH(50, 50);
+  RasterCacheKeyID key_id(id, RasterCacheKeyType::kDisplayList);
+  cache.MarkSeen(key_id, matrix, visible);
+  RasterCache::Context context = {
+      .gr_context = nullptr,
+      .dst_color_space = nullptr,
+      .matrix = matrix,
+      .logical_rect = logical_rect,
+      .flow_type = "RasterCacheFlow::DisplayList",
+  };
+  return cache.UpdateCacheEntry(key_id, context, [](DlCanvas* canvas) {});
+}
+
+bool HasImage(RasterCache& cache, uint64_t id) {
+  MockCanvas canvas(1000, 1000);
+  return cache.Draw(RasterCacheKeyID(id, RasterCacheKeyType::kDisplayList),
+                    canvas, nullptr);
+}
+
+}  // namespace
+
+TEST(RasterCache, ByteBudgetEvictsLeastRecentlyVisibleImages) {
+  flutter::RasterCache cache(1);
+  cache.SetMaxBytes(25000);
+
+  cache.BeginFrame();
+  ASSERT_TRUE(SeeAndCache(cache, 1, true));
+  ASSERT_TRUE(SeeAndCache(cache, 2, true));
+  cache.EndFrame();
+  size_t image_bytes = cache.cached_bytes() / 2;
+  ASSERT_GE(image_bytes, 10000u);
+
+  // 2 is not visible in this frame, so its image makes room for 3.
+  cache.BeginFrame();
+  cache.MarkSeen(RasterCacheKeyID(1, RasterCacheKeyType::kDisplayList),
+                 SkMatrix::I(), true);
+  cache.MarkSeen(RasterCacheKeyID(2, RasterCacheKeyType::kDisplayList),
+                 SkMatrix::I(), false);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(SeeAndCache(cache, 3, true));
+  EXPECT_EQ(cache.picture_metrics().eviction_count, 1u);
+  EXPECT_EQ(cache.picture_metrics().eviction_bytes, image_bytes);
+  EXPECT_TRUE(HasImage(cache, 1));
+  EXPECT_FALSE(HasImage(cache, 2));
+  EXPECT_TRUE(HasImage(cache, 3));
+  cache.EndFrame();
+  EXPECT_EQ(cache.cached_bytes(), 2 * image_bytes);
+  EXPECT_EQ(cache.GetPictureCachedEntriesCount(), 3u);
+
+  // Images that are visible in the frame are not evicted for new ones.
+  cache.BeginFrame();
+  cache.MarkSeen(RasterCacheKeyID(1, RasterCacheKeyType::kDisplayList),
+                 SkMatrix::I(), true);
+  cache.MarkSeen(RasterCacheKeyID(2, RasterCacheKeyType::kDisplayList),
+                 SkMatrix::I(), true);
+  cache.MarkSeen(RasterCacheKeyID(3, RasterCacheKeyType::kDisplayList),
+                 SkMatrix::I(), true);
+  cache.EvictUnusedCacheEntries();
+  EXPECT_FALSE(SeeAndCache(cache, 2, true));
+  EXPECT_EQ(cache.picture_metrics().eviction_count, 0u);
+  cache.EndFrame();
+  EXPECT_EQ(cache.cached_bytes(), 2 * image_bytes);
+}
+
+TEST(RasterCache, ShrinkingByteBudgetEvictsImages) {
+  flutter::RasterCache cache(1);
+
+  cache.BeginFrame();
+  ASSERT_TRUE(SeeAndCache(cache, 1, true));
+  cache.EndFrame();
+  cache.BeginFrame();
+  cache.MarkSeen(RasterCacheKeyID(1, RasterCacheKeyType::kDisplayList),
+                 SkMatrix::I(), false);
+  ASSERT_TRUE(SeeAndCache(cache, 2, true));
+  ASSERT_TRUE(SeeAndCache(cache, 3, true));
+  ASSERT_TRUE(SeeAndCache(cache, 4, true));
+  cache.EndFrame();
+  size_t image_bytes = cache.cached_bytes() / 4;
+  EXPECT_EQ(cache.max_bytes(), RasterCache::kUnlimitedBytes);
+
+  // The budget is halved each time, and 1 was visible the least recently.
+  cache.SetMaxBytes(8 * image_bytes);
+  cache.NotifyLowMemory();
+  EXPECT_EQ(cache.max_bytes(), 4 * image_bytes);
+  EXPECT_EQ(cache.cached_bytes(), 4 * image_bytes);
+  cache.NotifyLowMemory();
+  EXPECT_EQ(cache.max_bytes(), 2 * image_bytes);
+  EXPECT_EQ(cache.cached_bytes(), 2 * image_bytes);
+  EXPECT_FALSE(HasImage(cache, 1));
+
+  // The budget does not shrink below its floor.
+  cache.NotifyLowMemory();
+  cache.NotifyLowMemory();
+  EXPECT_EQ(cache.max_bytes(), image_bytes);
+
+  cache.SetMaxBytes(image_bytes);
+  EXPECT_EQ(cache.cached_bytes(), image_bytes);
+
+  cache.SetMaxBytes(0);
+  EXPECT_EQ(cache.cached_bytes(), 0u);
+  cache.BeginFrame();
+  cache.EvictUnusedCacheEntries();
+  EXPECT_FALSE(SeeAndCache(cache, 1, true));
+  cache.EndFrame();
+}
+
+TEST(RasterCache, LowMemoryBudgetRecoversAfterPressureClears) {
+  flutter::RasterCache cache(1);
+  cache.SetMaxBytes(20000);
+
+  // An empty cache keeps half of its budget.
+  cache.NotifyLowMemory();
+  EXPECT_EQ(cache.max_bytes(), 10000u);
+  cache.NotifyLowMemory();
+  EXPECT_EQ(cache.max_bytes(), 5000u);
+
+  for (size_t i = 1; i < RasterCache::kLowMemoryRecoveryFrames; i++) {
+    cache.BeginFrame();
+    EXPECT_FALSE(SeeAndCache(cache, 1, true));
+    cache.EndFrame();
+  }
+  EXPECT_EQ(cache.max_bytes(), 5000u);
+  cache.BeginFrame();
+  cache.EndFrame();
+  EXPECT_EQ(cache.max_bytes(), 20000u);
+
+  cache.BeginFrame();
+  EXPECT_TRUE(SeeAndCache(cache, 1, true));
+  cache.EndFrame();
+
+  // An unlimited budget that held nothing shrinks to the minimum.
+  cache.SetMaxBytes(RasterCache::kUnlimitedBytes);
+  cache.Clear();
+  cache.NotifyLowMemory();
+  EXPECT_EQ(cache.max_bytes(), RasterCache::kLowMemoryMinBytes);
+}
+
+TEST(RasterCache, MultiViewFramesEvictAfterTheLastView) {
+  RasterCache cache(1);
+
+  cache.BeginFrame(2);
+  ASSERT_TRUE(SeeAndCache(cache, 1, true));
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(SeeAndCache(cache, 2, true));
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+  ASSERT_TRUE(HasImage(cache, 1));
+  ASSERT_TRUE(HasImage(cache, 2));
+
+  // Painting the first view does not evict the entries of the second view,
+  // which has not been prerolled yet.
+  cache.BeginFrame(2);
+  ASSERT_TRUE(SeeAndCache(cache, 1, true));
+  cache.EvictUnusedCacheEntries();
+  EXPECT_TRUE(HasImage(cache, 2));
+  ASSERT_TRUE(SeeAndCache(cache, 2, true));
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+  EXPECT_TRUE(HasImage(cache, 1));
+  EXPECT_TRUE(HasImage(cache, 2));
+
+  // Entries of views that were not painted are evicted at the end of the
+  // frame.
+  cache.BeginFrame(2);
+  ASSERT_TRUE(SeeAndCache(cache, 1, true));
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+  EXPECT_TRUE(HasImage(cache, 1));
+  EXPECT_FALSE(HasImage(cache, 2));
+}
+
 TEST(RasterCache, ComputeDeviceRectBasedOnFractionalTranslation) {
   SkRect logical_rect = SkRect::MakeLTRB(0, 0, 300.2, 300.3);
   SkMatrix ctm = SkMatrix::MakeAll(2.0, 0, 0, 0, 2.0, 0, 0, 0, 1);
@@ -588,6 +835,277 @@ TEST(RasterCache, DisplayListWithSingularMatrixIsNotCached) {
   }
 }
 
+TEST(RasterCache, IdenticalDisplayListsShareCacheEntry) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  // Two separate recordings of the same content, as produced by
+  // rebuilding an unchanged widget on a later frame.
+  auto display_list_1 = GetSampleDisplayList();
+  auto display_list_2 = GetSampleDisplayList();
+  ASSERT_NE(display_list_1->unique_id(), display_list_2->unique_id());
+  ASSERT_EQ(RasterCacheKeyID::ForDisplayList(*display_list_1),
+            RasterCacheKeyID::ForDisplayList(*display_list_2));
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item_1(display_list_1, SkPoint(),
+                                                 true, false);
+  DisplayListRasterCacheItem display_list_item_2(display_list_2, SkPoint(),
+                                                 true, false);
+
+  // The first DisplayList is seen often enough to be cached.
+  cache.BeginFrame();
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item_1, preroll_context, paint_context, matrix));
+  cache.EndFrame();
+  cache.BeginFrame();
+  ASSERT_TRUE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item_1, preroll_context, paint_context, matrix));
+  ASSERT_TRUE(display_list_item_1.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 1u);
+
+  // The re-recording is drawn from the same entry on the next frame.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  ASSERT_TRUE(display_list_item_2.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 1u);
+}
+
+TEST(RasterCache, AsyncFillIsUsedFromTheNextFrame) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  fml::Thread fill_thread("fill");
+  size_t upload_count = 0;
+  cache.SetAsyncFillTaskRunner(
+      fill_thread.GetTaskRunner(), [&upload_count](const SkPixmap& pixmap) {
+        upload_count++;
+        return DlImage::Make(SkImages::RasterFromPixmapCopy(pixmap));
+      });
+  ASSERT_TRUE(cache.async_fill_enabled());
+
+  SkMatrix matrix = SkMatrix::I();
+  auto display_list = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item(display_list, SkPoint(), true,
+                                               false);
+
+  cache.BeginFrame();
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  cache.EndFrame();
+
+  // The fill is started, but the frame draws uncached.
+  cache.BeginFrame();
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  ASSERT_FALSE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+
+  fml::AutoResetWaitableEvent latch;
+  fill_thread.GetTaskRunner()->PostTask([&latch] { latch.Signal(); });
+  latch.Wait();
+  EXPECT_EQ(upload_count, 1u);
+
+  cache.BeginFrame();
+  ASSERT_TRUE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  ASSERT_TRUE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  EXPECT_EQ(upload_count, 1u);
+}
+
+namespace {
+// An image that claims to be safe to share with the UI thread, like the
+// GPU and deferred images of lib/ui.
+class UIThreadSafeImage final : public DlImage {
+ public:
+  explicit UIThreadSafeImage(sk_sp<SkImage> image)
+      : image_(std::move(image)) {}
+
+  sk_sp<SkImage> skia_image() const override { return image_; }
+  std::shared_ptr<impeller::Texture> impeller_texture() const override {
+    return nullptr;
+  }
+  bool isOpaque() const override { return image_->isOpaque(); }
+  bool isTextureBacked() const override { return true; }
+  bool isUIThreadSafe() const override { return true; }
+  SkISize dimensions() const override { return image_->dimensions(); }
+  size_t GetApproximateByteSize() const override {
+    return image_->imageInfo().computeMinByteSize();
+  }
+
+ private:
+  sk_sp<SkImage> image_;
+};
+}  // namespace
+
+TEST(RasterCache, DisplayListsWithImagesAreNotFilledAsynchronously) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  fml::Thread fill_thread("fill");
+  size_t upload_count = 0;
+  cache.SetAsyncFillTaskRunner(
+      fill_thread.GetTaskRunner(), [&upload_count](const SkPixmap& pixmap) {
+        upload_count++;
+        return DlImage::Make(SkImages::RasterFromPixmapCopy(pixmap));
+      });
+
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(80, 80);
+  bitmap.eraseColor(SK_ColorBLUE);
+  auto image = sk_make_sp<UIThreadSafeImage>(bitmap.asImage());
+  DisplayListBuilder builder(SkRect::MakeWH(150, 100));
+  builder.DrawImage(image, SkPoint::Make(10, 10), DlImageSampling::kLinear);
+  auto display_list = builder.Build();
+  ASSERT_TRUE(display_list->isUIThreadSafe());
+  ASSERT_TRUE(display_list->has_images());
+
+  SkMatrix matrix = SkMatrix::I();
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item(display_list, SkPoint(), true,
+                                               false);
+
+  cache.BeginFrame();
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  cache.EndFrame();
+
+  // The list is rasterized on this thread as soon as it is cached.
+  cache.BeginFrame();
+  ASSERT_TRUE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  ASSERT_TRUE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+
+  fml::AutoResetWaitableEvent latch;
+  fill_thread.GetTaskRunner()->PostTask([&latch] { latch.Signal(); });
+  latch.Wait();
+  EXPECT_EQ(upload_count, 0u);
+}
+
+TEST(RasterCache, PendingAsyncFillsCountTowardsTheByteBudget) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  // Room for the 80x80 fill of one of the display lists, but not both.
+  cache.SetMaxBytes(40000);
+  fml::Thread fill_thread("fill");
+  size_t upload_count = 0;
+  cache.SetAsyncFillTaskRunner(
+      fill_thread.GetTaskRunner(), [&upload_count](const SkPixmap& pixmap) {
+        upload_count++;
+        return DlImage::Make(SkImages::RasterFromPixmapCopy(pixmap));
+      });
+
+  DisplayListBuilder builder(SkRect::MakeWH(150, 100));
+  builder.DrawRect(SkRect::MakeXYWH(10, 10, 80, 80), DlPaint(DlColor::kRed()));
+  auto display_list_1 = builder.Build();
+  builder.DrawRect(SkRect::MakeXYWH(10, 10, 80, 80),
+                   DlPaint(DlColor::kBlue()));
+  auto display_list_2 = builder.Build();
+
+  SkMatrix matrix = SkMatrix::I();
+  MockCanvas dummy_canvas(1000, 1000);
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item_1(display_list_1, SkPoint(),
+                                                 true, false);
+  DisplayListRasterCacheItem display_list_item_2(display_list_2, SkPoint(),
+                                                 true, false);
+
+  for (int frame = 0; frame < 2; frame++) {
+    cache.BeginFrame();
+    ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+        display_list_item_1, preroll_context, paint_context, matrix));
+    ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+        display_list_item_2, preroll_context, paint_context, matrix));
+    cache.EndFrame();
+  }
+
+  fml::AutoResetWaitableEvent latch;
+  fill_thread.GetTaskRunner()->PostTask([&latch] { latch.Signal(); });
+  latch.Wait();
+  EXPECT_EQ(upload_count, 1u);
+
+  cache.BeginFrame();
+  RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item_1, preroll_context, paint_context, matrix);
+  RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item_2, preroll_context, paint_context, matrix);
+  cache.EndFrame();
+  EXPECT_LE(cache.EstimatePictureCacheByteSize(), 40000u);
+}
+
 TEST(RasterCache, PrepareLayerTransform) {
   SkRect child_bounds = SkRect::MakeLTRB(10, 10, 50, 50);
   SkPath child_path = SkPath().addOval(child_bounds);
@@ -802,8 +1320,9 @@ TEST_F(RasterCacheTest, RasterCacheKeyIDLayerChildrenIds) {
   std::vector<RasterCacheKeyID> expected_ids;
   expected_ids.emplace_back(
       RasterCacheKeyID(mock_layer->unique_id(), RasterCacheKeyType::kLayer));
-  expected_ids.emplace_back(RasterCacheKeyID(display_list->unique_id(),
-                                             RasterCacheKeyType::kDisplayList));
+  expected_ids.emplace_back(RasterCacheKeyID(
+      display_list->content_hash().value(),
+      RasterCacheKeyType::kDisplayListContent));
   ASSERT_EQ(expected_ids[0], mock_layer->caching_key_id());
   ASSERT_EQ(expected_ids[1], display_list_layer->caching_key_id());
   ASSERT_EQ(ids, expected_ids);
@@ -49,6 +49,11 @@ class Surface {
 
   virtual bool EnableRasterCache() const;
 
+  /// Whether the surface keeps showing the last presented frame when no new
+  /// frame is acquired. If so, the rasterizer doesn't acquire or present a
+  /// frame whose layer tree has no damage compared to the last one.
+  virtual bool AllowsSkippingUnchangedFrames() const;
+
   virtual std::shared_ptr<impeller::AiksContext> GetAiksContext() const;
 
   /// Capture the `SurfaceData` currently present in the surface.
@@ -10,6 +10,7 @@
 
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/geometry/dl_region.h"
 #include "flutter/display_list/skia/dl_sk_canvas.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_point.h"
@@ -54,6 +55,10 @@ class SurfaceFrame {
     // rasterized (no partial redraw). To signal that there is no existing
     // damage use an empty SkIRect.
     std::optional<SkIRect> existing_damage = std::nullopt;
+
+    // The number of rects the target can present damage as. Frame and
+    // buffer damage are reported as a single rect if this is 1.
+    size_t max_damage_rect_count = 1;
   };
 
   SurfaceFrame(sk_sp<SkSurface> surface,
@@ -61,7 +66,8 @@ class SurfaceFrame {
                const SubmitCallback& submit_callback,
                SkISize frame_size,
                std::unique_ptr<GLContextResult> context_result = nullptr,
-               bool display_list_fallback = false);
+               bool display_list_fallback = false,
+               bool display_list_rtree = false);
 
   struct SubmitInfo {
     // The frame damage for frame n is the difference between frame n and
@@ -77,6 +83,12 @@ class SurfaceFrame {
     // Corresponds to EGL_KHR_partial_update
     std::optional<SkIRect> buffer_damage;
 
+    // The frame and buffer damage covered by at most
+    // |FramebufferInfo::max_damage_rect_count| rects. Their bounds are
+    // |frame_damage| and |buffer_damage|.
+    std::optional<DlRegion> frame_damage_region;
+    std::optional<DlRegion> buffer_damage_region;
+
     // Time at which this frame is scheduled to be presented. This is a hint
     // that can be passed to the platform to drop queued frames.
     std::optional<fml::TimePoint> presentation_time;
@@ -52,4 +52,19 @@ TEST(FlowTest, SurfaceFrameDoesNotPrepareRtree) {
   EXPECT_FALSE(surface_frame->BuildDisplayList()->has_rtree());
 }
 
+TEST(FlowTest, SurfaceFramePreparesRtreeWhenAsked) {
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  auto callback = [](const SurfaceFrame&, DlCanvas*) { return true; };
+  auto surface_frame = std::make_unique<SurfaceFrame>(
+      /*surface=*/nullptr,
+      /*framebuffer_info=*/framebuffer_info,
+      /*submit_callback=*/callback,
+      /*frame_size=*/SkISize::Make(800, 600),
+      /*context_result=*/nullptr,
+      /*display_list_fallback=*/true,
+      /*display_list_rtree=*/true);
+  surface_frame->Canvas()->DrawRect(SkRect::MakeWH(100, 100), DlPaint());
+  EXPECT_TRUE(surface_frame->BuildDisplayList()->has_rtree());
+}
+
 }  // namespace flutter
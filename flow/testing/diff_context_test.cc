@@ -18,17 +18,18 @@ Damage DiffContextTest::DiffLayerTree(MockLayerTree& layer_tree,
                                       int horizontal_clip_alignment,
                                       int vertical_clip_alignment,
                                       bool use_raster_cache,
-                                      bool impeller_enabled) {
+                                      bool impeller_enabled,
+                                      size_t max_damage_rect_count) {
   FML_CHECK(layer_tree.size() == old_layer_tree.size());
 
   DiffContext dc(layer_tree.size(), layer_tree.paint_region_map(),
                  old_layer_tree.paint_region_map(), use_raster_cache,
-                 impeller_enabled);
+                 impeller_enabled, texture_registry().get());
   dc.PushCullRect(
       SkRect::MakeIWH(layer_tree.size().width(), layer_tree.size().height()));
   layer_tree.root()->Diff(&dc, old_layer_tree.root());
   return dc.ComputeDamage(additional_damage, horizontal_clip_alignment,
-                          vertical_clip_alignment);
+                          vertical_clip_alignment, max_damage_rect_count);
 }
 
 sk_sp<DisplayList> DiffContextTest::CreateDisplayList(const SkRect& bounds,
@@ -72,8 +72,7 @@ void MockRasterCache::AddMockPicture(int width, int height) {
       .logical_rect       = display_list->bounds(),
       // clang-format on
   };
-  UpdateCacheEntry(RasterCacheKeyID(display_list->unique_id(),
-                                    RasterCacheKeyType::kDisplayList),
+  UpdateCacheEntry(RasterCacheKeyID::ForDisplayList(*display_list),
                    r_context, [&](DlCanvas* canvas) {
                      SkRect cache_rect = RasterCacheUtil::GetDeviceBounds(
                          r_context.logical_rect, r_context.matrix);
@@ -32,18 +32,20 @@ class MockTexture : public Texture {
 
   void OnGrContextCreated() override { gr_context_created_ = true; }
   void OnGrContextDestroyed() override { gr_context_destroyed_ = true; }
-  void MarkNewFrameAvailable() override {}
+  void MarkNewFrameAvailable() override { new_frame_available_ = true; }
   void OnTextureUnregistered() override { unregistered_ = true; }
 
   bool gr_context_created() { return gr_context_created_; }
   bool gr_context_destroyed() { return gr_context_destroyed_; }
   bool unregistered() { return unregistered_; }
+  bool new_frame_available() { return new_frame_available_; }
 
  private:
   sk_sp<DlImage> texture_;
   bool gr_context_created_ = false;
   bool gr_context_destroyed_ = false;
   bool unregistered_ = false;
+  bool new_frame_available_ = false;
 };
 
 }  // namespace testing
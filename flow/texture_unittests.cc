@@ -119,6 +119,19 @@ TEST(TextureRegistryTest, ReuseSameTextureSlot) {
   ASSERT_TRUE(mock_texture2->unregistered());
 }
 
+TEST(TextureTest, MarkFrameAvailableAdvancesFrameSequence) {
+  auto mock_texture1 = std::make_shared<MockTexture>(0);
+  auto mock_texture2 = std::make_shared<MockTexture>(0);
+  uint64_t sequence1 = mock_texture1->GetFrameSequence();
+  ASSERT_NE(sequence1, mock_texture2->GetFrameSequence());
+
+  mock_texture1->MarkFrameAvailable();
+  ASSERT_TRUE(mock_texture1->new_frame_available());
+  ASSERT_NE(mock_texture1->GetFrameSequence(), sequence1);
+  ASSERT_NE(mock_texture1->GetFrameSequence(),
+            mock_texture2->GetFrameSequence());
+}
+
 TEST(TextureRegistryTest, CallsOnGrContextCreatedInInsertionOrder) {
   TextureRegistry registry;
   std::vector<int> create_order;
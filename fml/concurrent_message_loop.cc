@@ -8,22 +8,61 @@
 
 #include "flutter/fml/thread.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/fml/work_stealing_deque.h"
 
 namespace fml {
 
+namespace {
+
+// The loop the current thread is a worker of, if any, and the index of that
+// worker in the loop.
+thread_local const ConcurrentMessageLoop* tCurrentLoop = nullptr;
+thread_local size_t tCurrentWorkerIndex = 0;
+
+// The most tasks a worker moves from the shared queue to its own deque at
+// once, where idle workers can steal them without taking the lock.
+constexpr size_t kMaxSharedTasksBatch = 16u;
+
+}  // namespace
+
+struct ConcurrentMessageLoop::PendingTask {
+  fml::TaskClosure task;
+  // |fml::TimePoint::Max()| for tasks without a deadline.
+  fml::TimePoint deadline;
+  uint64_t order = 0;
+  fml::TimePoint post_time;
+
+  // Orders the lane heaps so that the front is the task to run next.
+  bool operator<(const PendingTask& other) const {
+    if (deadline != other.deadline) {
+      return deadline > other.deadline;
+    }
+    return order > other.order;
+  }
+};
+
+struct ConcurrentMessageLoop::Worker {
+  // Owned by the worker thread. Holds heap allocated closures since deque
+  // slots must be trivially copyable.
+  WorkStealingDeque<fml::TaskClosure*> tasks;
+  // Tasks posted with |PostTaskToAllWorkers|. Guarded by |tasks_mutex_|.
+  std::vector<fml::closure> all_workers_tasks;
+  // Whether |all_workers_tasks| is non-empty, readable without the lock.
+  std::atomic<bool> has_all_workers_tasks = false;
+};
+
 ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
     : worker_count_(std::max<size_t>(worker_count, 1ul)) {
+  for (size_t i = 0; i < worker_count_; ++i) {
+    worker_states_.emplace_back(std::make_unique<Worker>());
+  }
   for (size_t i = 0; i < worker_count_; ++i) {
     workers_.emplace_back([i, this]() {
       fml::Thread::SetCurrentThreadName(fml::Thread::ThreadConfig(
           std::string{"io.worker." + std::to_string(i + 1)}));
-      WorkerMain();
+      WorkerMain(i);
     });
   }
-
-  for (const auto& worker : workers_) {
-    worker_thread_ids_.emplace_back(worker.get_id());
-  }
 }
 
 ConcurrentMessageLoop::~ConcurrentMessageLoop() {
@@ -32,6 +71,12 @@ ConcurrentMessageLoop::~ConcurrentMessageLoop() {
     FML_DCHECK(worker.joinable());
     worker.join();
   }
+  // Tasks that never ran are dropped, as are the ones left in |tasks_|.
+  for (auto& worker : worker_states_) {
+    while (auto task = worker->tasks.Pop()) {
+      delete task.value();
+    }
+  }
 }
 
 size_t ConcurrentMessageLoop::GetWorkerCount() const {
@@ -42,11 +87,23 @@ std::shared_ptr<ConcurrentTaskRunner> ConcurrentMessageLoop::GetTaskRunner() {
   return std::make_shared<ConcurrentTaskRunner>(weak_from_this());
 }
 
-void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
+void ConcurrentMessageLoop::PostTask(fml::TaskClosure task,
+                                     ConcurrentTaskPriority priority,
+                                     std::optional<fml::TimePoint> deadline) {
   if (!task) {
     return;
   }
 
+  // Tasks posted by tasks of this loop stay on the worker that posted them
+  // and don't contend on the mutex. Other workers steal them when idle. The
+  // deques are unordered, so they only hold tasks of the default priority.
+  if (tCurrentLoop == this &&
+      priority == ConcurrentTaskPriority::kUserVisible &&
+      !deadline.has_value() && !shutdown_.load()) {
+    PushWorkerTask(*worker_states_[tCurrentWorkerIndex], std::move(task));
+    return;
+  }
+
   std::unique_lock lock(tasks_mutex_);
 
   // Don't just drop tasks on the floor in case of shutdown.
@@ -59,8 +116,15 @@ void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
     return;
   }
 
-  tasks_.push(task);
-
+  auto& lane = lanes_[static_cast<size_t>(priority)];
+  lane.push_back(PendingTask{std::move(task),
+                             deadline.value_or(fml::TimePoint::Max()),
+                             next_task_order_++, fml::TimePoint::Now()});
+  std::push_heap(lane.begin(), lane.end());
+  pending_lane_tasks_++;
+  if (priority == ConcurrentTaskPriority::kFrameCritical) {
+    pending_frame_critical_tasks_++;
+  }
   // Unlock the mutex before notifying the condition variable because that mutex
   // has to be acquired on the other thread anyway. Waiting in this scope till
   // it is acquired there is a pessimization.
@@ -69,50 +133,169 @@ void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
   tasks_condition_.notify_one();
 }
 
-void ConcurrentMessageLoop::WorkerMain() {
-  while (true) {
-    std::unique_lock lock(tasks_mutex_);
-    tasks_condition_.wait(lock, [&]() {
-      return !tasks_.empty() || shutdown_ || HasThreadTasksLocked();
-    });
+void ConcurrentMessageLoop::PushWorkerTask(Worker& worker,
+                                           fml::TaskClosure task) {
+  worker.tasks.Push(new fml::TaskClosure(std::move(task)));
+  WakeSleepingWorker();
+}
 
-    // Shutdown cannot be read with the task mutex unlocked.
-    bool shutdown_now = shutdown_;
-    fml::closure task;
-    std::vector<fml::closure> thread_tasks;
+void ConcurrentMessageLoop::WakeSleepingWorker() {
+  // Workers read the epoch before looking for tasks and only sleep while it
+  // is unchanged. Both this increment and the sleeper count are sequentially
+  // consistent, so either a worker about to sleep sees the new epoch or this
+  // thread sees that worker and wakes it up.
+  work_epoch_.fetch_add(1);
+  if (sleeping_workers_.load() == 0) {
+    return;
+  }
+  {
+    // Taking the lock orders the notification after the wait of a worker
+    // that checked the epoch just before the increment.
+    std::scoped_lock lock(tasks_mutex_);
+  }
+  tasks_condition_.notify_one();
+}
 
-    if (!tasks_.empty()) {
-      task = tasks_.front();
-      tasks_.pop();
+bool ConcurrentMessageLoop::TakeWorkerTask(size_t index,
+                                           fml::TaskClosure& task) {
+  std::optional<fml::TaskClosure*> found = worker_states_[index]->tasks.Pop();
+  // Steal from the other workers starting at the next one so that thieves
+  // spread out over the victims.
+  for (size_t i = 1; !found && i < worker_count_; ++i) {
+    found = worker_states_[(index + i) % worker_count_]->tasks.Steal();
+  }
+  if (!found) {
+    return false;
+  }
+  task = std::move(*found.value());
+  delete found.value();
+  return true;
+}
+
+bool ConcurrentMessageLoop::TakeTaskLocked(Worker& worker,
+                                           fml::TaskClosure& task) {
+  constexpr auto kFrameCritical =
+      static_cast<size_t>(ConcurrentTaskPriority::kFrameCritical);
+  constexpr auto kUserVisible =
+      static_cast<size_t>(ConcurrentTaskPriority::kUserVisible);
+  for (size_t priority = 0; priority < kPriorityCount; ++priority) {
+    auto& lane = lanes_[priority];
+    if (lane.empty()) {
+      continue;
+    }
+    std::pop_heap(lane.begin(), lane.end());
+    task = std::move(lane.back().task);
+    lane_latencies_[priority] = fml::TimePoint::Now() - lane.back().post_time;
+    const bool has_deadline = lane.back().deadline != fml::TimePoint::Max();
+    lane.pop_back();
+    pending_lane_tasks_--;
+    if (priority == kFrameCritical) {
+      pending_frame_critical_tasks_--;
     }
 
-    if (HasThreadTasksLocked()) {
-      thread_tasks = GetThreadTasksLocked();
-      FML_DCHECK(!HasThreadTasksLocked());
+    // Take part of the rest of the default lane along so that the other
+    // workers steal them from this one instead of queueing up on the mutex.
+    // Tasks without deadlines come last so the rest have none either.
+    if (priority != kUserVisible || has_deadline) {
+      return true;
+    }
+    const size_t batch = std::min(lane.size() / 2u, kMaxSharedTasksBatch);
+    for (size_t i = 0; i < batch; ++i) {
+      std::pop_heap(lane.begin(), lane.end());
+      worker.tasks.Push(new fml::TaskClosure(std::move(lane.back().task)));
+      lane.pop_back();
     }
+    pending_lane_tasks_ -= batch;
+    if (batch > 0u) {
+      work_epoch_.fetch_add(1);
+    }
+    return true;
+  }
+  return false;
+}
 
-    // Don't hold onto the mutex while tasks are being executed as they could
-    // themselves try to post more tasks to the message loop.
-    lock.unlock();
+void ConcurrentMessageLoop::TraceLaneLatencies(
+    const fml::TimeDelta (&latencies)[kPriorityCount]) const {
+  FML_TRACE_COUNTER(
+      "flutter",                                                            //
+      "ConcurrentTaskQueueLatency", reinterpret_cast<int64_t>(this),        //
+      "FrameCriticalMicros", latencies[0].ToMicroseconds(),                 //
+      "UserVisibleMicros", latencies[1].ToMicroseconds(),                   //
+      "BackgroundMicros", latencies[2].ToMicroseconds());
+}
 
-    TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
-    // Execute the primary task we woke up for.
-    if (task) {
-      ExecuteTask(task);
-    }
+void ConcurrentMessageLoop::RunAllWorkersTasks(Worker& worker) {
+  std::vector<fml::closure> tasks;
+  {
+    std::scoped_lock lock(tasks_mutex_);
+    std::swap(tasks, worker.all_workers_tasks);
+    worker.has_all_workers_tasks = false;
+  }
+  for (const auto& task : tasks) {
+    // These are copies shared by all workers, run them in place.
+    ExecuteTask([&task]() { task(); });
+  }
+}
+
+void ConcurrentMessageLoop::WorkerMain(size_t index) {
+  tCurrentLoop = this;
+  tCurrentWorkerIndex = index;
+  Worker& worker = *worker_states_[index];
 
-    // Execute any thread tasks.
-    for (const auto& thread_task : thread_tasks) {
-      ExecuteTask(thread_task);
+  while (true) {
+    if (worker.has_all_workers_tasks.load()) {
+      RunAllWorkersTasks(worker);
     }
 
-    if (shutdown_now) {
+    if (shutdown_.load()) {
       break;
     }
+
+    const uint64_t epoch = work_epoch_.load();
+    fml::TaskClosure task;
+    // Frame critical tasks go before the tasks of the worker deques, all of
+    // which have the default priority.
+    const bool skipped_deques = pending_frame_critical_tasks_.load() > 0;
+    if (!skipped_deques && TakeWorkerTask(index, task)) {
+      ExecuteTask(task);
+      continue;
+    }
+
+    std::unique_lock lock(tasks_mutex_);
+    if (TakeTaskLocked(worker, task)) {
+      const bool took_batch = !worker.tasks.IsEmpty();
+      fml::TimeDelta latencies[kPriorityCount];
+      std::copy(std::begin(lane_latencies_), std::end(lane_latencies_),
+                std::begin(latencies));
+      // Don't hold onto the mutex while tasks are being executed as they could
+      // themselves try to post more tasks to the message loop.
+      lock.unlock();
+      if (took_batch && sleeping_workers_.load() > 0) {
+        tasks_condition_.notify_one();
+      }
+      TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
+      TraceLaneLatencies(latencies);
+      ExecuteTask(task);
+      continue;
+    }
+    if (skipped_deques) {
+      // Another worker took the frame critical task first.
+      continue;
+    }
+
+    sleeping_workers_.fetch_add(1);
+    tasks_condition_.wait(lock, [&]() {
+      return pending_lane_tasks_ > 0 || shutdown_ ||
+             worker.has_all_workers_tasks.load() ||
+             work_epoch_.load() != epoch;
+    });
+    sleeping_workers_.fetch_sub(1);
   }
+
+  tCurrentLoop = nullptr;
 }
 
-void ConcurrentMessageLoop::ExecuteTask(const fml::closure& task) {
+void ConcurrentMessageLoop::ExecuteTask(const fml::TaskClosure& task) {
   task();
 }
 
@@ -128,38 +311,32 @@ void ConcurrentMessageLoop::PostTaskToAllWorkers(const fml::closure& task) {
   }
 
   std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    thread_tasks_[worker_thread_id].emplace_back(task);
+  for (auto& worker : worker_states_) {
+    worker->all_workers_tasks.emplace_back(task);
+    worker->has_all_workers_tasks = true;
   }
   tasks_condition_.notify_all();
 }
 
-bool ConcurrentMessageLoop::HasThreadTasksLocked() const {
-  return thread_tasks_.count(std::this_thread::get_id()) > 0;
-}
-
-std::vector<fml::closure> ConcurrentMessageLoop::GetThreadTasksLocked() {
-  auto found = thread_tasks_.find(std::this_thread::get_id());
-  FML_DCHECK(found != thread_tasks_.end());
-  std::vector<fml::closure> pending_tasks;
-  std::swap(pending_tasks, found->second);
-  thread_tasks_.erase(found);
-  return pending_tasks;
-}
-
 ConcurrentTaskRunner::ConcurrentTaskRunner(
     std::weak_ptr<ConcurrentMessageLoop> weak_loop)
     : weak_loop_(std::move(weak_loop)) {}
 
 ConcurrentTaskRunner::~ConcurrentTaskRunner() = default;
 
-void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
+void ConcurrentTaskRunner::PostTask(fml::TaskClosure task) {
+  PostTask(std::move(task), ConcurrentTaskPriority::kUserVisible);
+}
+
+void ConcurrentTaskRunner::PostTask(fml::TaskClosure task,
+                                    ConcurrentTaskPriority priority,
+                                    std::optional<fml::TimePoint> deadline) {
   if (!task) {
     return;
   }
 
   if (auto loop = weak_loop_.lock()) {
-    loop->PostTask(task);
+    loop->PostTask(std::move(task), priority, deadline);
     return;
   }
 
@@ -169,14 +346,15 @@ void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
   task();
 }
 
-bool ConcurrentMessageLoop::RunsTasksOnCurrentThread() {
-  std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    if (worker_thread_id == std::this_thread::get_id()) {
-      return true;
-    }
+bool ConcurrentTaskRunner::RunsTasksOnCurrentThread() {
+  if (auto loop = weak_loop_.lock()) {
+    return loop->RunsTasksOnCurrentThread();
   }
   return false;
 }
 
+bool ConcurrentMessageLoop::RunsTasksOnCurrentThread() {
+  return tCurrentLoop == this;
+}
+
 }  // namespace fml
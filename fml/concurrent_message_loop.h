@@ -5,19 +5,36 @@
 #ifndef FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 #define FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 
+#include <atomic>
 #include <condition_variable>
-#include <map>
-#include <queue>
+#include <memory>
+#include <optional>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/task_closure.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_point.h"
 
 namespace fml {
 
 class ConcurrentTaskRunner;
 
+/// The scheduling classes of concurrent tasks. Workers only pick up tasks of a
+/// class once no tasks of the classes before it are pending.
+enum class ConcurrentTaskPriority {
+  /// Work that the frame in flight waits on, like pipeline compilation or
+  /// recording split across workers.
+  kFrameCritical,
+  /// Work whose result is about to be visible, like image decoding. This is
+  /// the priority of tasks posted without one.
+  kUserVisible,
+  /// Work nobody waits on, like persisting caches to disk.
+  kBackground,
+};
+
 class ConcurrentMessageLoop
     : public std::enable_shared_from_this<ConcurrentMessageLoop> {
  public:
@@ -38,27 +55,59 @@ class ConcurrentMessageLoop
 
  protected:
   explicit ConcurrentMessageLoop(size_t worker_count);
-  virtual void ExecuteTask(const fml::closure& task);
+  virtual void ExecuteTask(const fml::TaskClosure& task);
 
  private:
   friend ConcurrentTaskRunner;
 
+  struct Worker;
+  struct PendingTask;
+
+  static constexpr size_t kPriorityCount = 3u;
+
   size_t worker_count_ = 0;
   std::vector<std::thread> workers_;
+  // One per worker thread, created before any of the threads start. Tasks
+  // posted from a worker go to the bottom of its own deque and idle workers
+  // steal from the top of the others.
+  std::vector<std::unique_ptr<Worker>> worker_states_;
   std::mutex tasks_mutex_;
   std::condition_variable tasks_condition_;
-  std::queue<fml::closure> tasks_;
-  std::vector<std::thread::id> worker_thread_ids_;
-  std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
-  bool shutdown_ = false;
+  // Tasks posted from threads that are not workers of this loop and tasks
+  // with a priority other than |kUserVisible| or a deadline, one heap per
+  // priority ordered by deadline and then posting order.
+  std::vector<PendingTask> lanes_[kPriorityCount];
+  size_t pending_lane_tasks_ = 0;
+  uint64_t next_task_order_ = 0;
+  // The queueing latency of the task last taken from each lane.
+  fml::TimeDelta lane_latencies_[kPriorityCount];
+  // Lets workers look for frame critical tasks before their own deque without
+  // taking the lock every time.
+  std::atomic<size_t> pending_frame_critical_tasks_ = 0;
+  // Bumped whenever a task is pushed to a worker deque so that workers about
+  // to sleep notice tasks they did not see while looking for work.
+  std::atomic<uint64_t> work_epoch_ = 0;
+  std::atomic<size_t> sleeping_workers_ = 0;
+  std::atomic<bool> shutdown_ = false;
+
+  void WorkerMain(size_t index);
+
+  void PostTask(fml::TaskClosure task,
+                ConcurrentTaskPriority priority,
+                std::optional<fml::TimePoint> deadline);
 
-  void WorkerMain();
+  void PushWorkerTask(Worker& worker, fml::TaskClosure task);
 
-  void PostTask(const fml::closure& task);
+  void WakeSleepingWorker();
 
-  bool HasThreadTasksLocked() const;
+  bool TakeWorkerTask(size_t index, fml::TaskClosure& task);
 
-  std::vector<fml::closure> GetThreadTasksLocked();
+  bool TakeTaskLocked(Worker& worker, fml::TaskClosure& task);
+
+  void RunAllWorkersTasks(Worker& worker);
+
+  void TraceLaneLatencies(
+      const fml::TimeDelta (&latencies)[kPriorityCount]) const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ConcurrentMessageLoop);
 };
@@ -69,7 +118,21 @@ class ConcurrentTaskRunner : public BasicTaskRunner {
 
   virtual ~ConcurrentTaskRunner();
 
-  void PostTask(const fml::closure& task) override;
+  /// Posts a |ConcurrentTaskPriority::kUserVisible| task without a deadline.
+  void PostTask(fml::TaskClosure task) override;
+
+  /// Posts a task of the given priority. Pending tasks of the same priority
+  /// run in order of their deadlines, tasks without one after all tasks with
+  /// one, and in posting order otherwise. Missing a deadline has no effect
+  /// other than the task running late.
+  void PostTask(fml::TaskClosure task,
+                ConcurrentTaskPriority priority,
+                std::optional<fml::TimePoint> deadline = std::nullopt);
+
+  /// Whether the calling thread is one of the workers of the loop. Tasks
+  /// running on a worker must not block on other tasks of the same loop,
+  /// which may never run if every worker is blocked.
+  bool RunsTasksOnCurrentThread();
 
  private:
   friend ConcurrentMessageLoop;
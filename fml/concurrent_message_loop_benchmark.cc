@@ -0,0 +1,101 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/concurrent_message_loop.h"
+
+#include <atomic>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+
+namespace fml {
+namespace benchmarking {
+
+static constexpr size_t kTaskCount = 10000;
+
+// Tasks posted from outside of the loop, which go through the shared queue.
+static void BM_ConcurrentMessageLoopPostTasks(
+    benchmark::State& state) {  // NOLINT
+  auto loop = ConcurrentMessageLoop::Create(state.range(0));
+  auto task_runner = loop->GetTaskRunner();
+  while (state.KeepRunning()) {
+    CountDownLatch latch(kTaskCount);
+    for (size_t i = 0; i < kTaskCount; ++i) {
+      task_runner->PostTask([&latch]() { latch.CountDown(); });
+    }
+    latch.Wait();
+  }
+  state.SetItemsProcessed(state.iterations() * kTaskCount);
+}
+
+// Tasks posted from a task of the loop, which stay on the posting worker
+// unless the other workers steal them. The posting task counts down last so
+// that the loop isn't collected while it is still posting.
+static void BM_ConcurrentMessageLoopPostTasksFromWorker(
+    benchmark::State& state) {  // NOLINT
+  auto loop = ConcurrentMessageLoop::Create(state.range(0));
+  auto task_runner = loop->GetTaskRunner();
+  while (state.KeepRunning()) {
+    CountDownLatch latch(kTaskCount + 1);
+    task_runner->PostTask([&latch, task_runner]() {
+      for (size_t i = 0; i < kTaskCount; ++i) {
+        task_runner->PostTask([&latch]() { latch.CountDown(); });
+      }
+      latch.CountDown();
+    });
+    latch.Wait();
+  }
+  state.SetItemsProcessed(state.iterations() * kTaskCount);
+}
+
+// A binary tree of tasks where each task forks two more, like divide and
+// conquer jobs do.
+static void ForkTasks(const std::shared_ptr<ConcurrentTaskRunner>& runner,
+                      size_t depth,
+                      CountDownLatch& latch) {
+  if (depth > 0) {
+    for (size_t i = 0; i < 2; ++i) {
+      runner->PostTask(
+          [runner, depth, &latch]() { ForkTasks(runner, depth - 1, latch); });
+    }
+  }
+  latch.CountDown();
+}
+
+static void BM_ConcurrentMessageLoopForkTasks(
+    benchmark::State& state) {  // NOLINT
+  constexpr size_t kDepth = 13;
+  constexpr size_t kForkedTaskCount = (1u << (kDepth + 1)) - 1;
+  auto loop = ConcurrentMessageLoop::Create(state.range(0));
+  auto task_runner = loop->GetTaskRunner();
+  while (state.KeepRunning()) {
+    CountDownLatch latch(kForkedTaskCount);
+    task_runner->PostTask([&latch, task_runner]() {
+      ForkTasks(task_runner, kDepth, latch);
+    });
+    latch.Wait();
+  }
+  state.SetItemsProcessed(state.iterations() * kForkedTaskCount);
+}
+
+// The work happens on the workers, so CPU time of the benchmark thread is
+// meaningless.
+BENCHMARK(BM_ConcurrentMessageLoopPostTasks)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
+BENCHMARK(BM_ConcurrentMessageLoopPostTasksFromWorker)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
+BENCHMARK(BM_ConcurrentMessageLoopForkTasks)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
+
+}  // namespace benchmarking
+}  // namespace fml
@@ -6,25 +6,34 @@
 
 #include "flutter/fml/delayed_task.h"
 
+#include <algorithm>
+#include <functional>
+
 namespace fml {
 
 DelayedTask::DelayedTask(size_t order,
-                         const fml::closure& task,
+                         fml::TaskClosure task,
                          fml::TimePoint target_time,
                          fml::TaskSourceGrade task_source_grade)
     : order_(order),
-      task_(task),
+      task_(std::move(task)),
       target_time_(target_time),
       task_source_grade_(task_source_grade) {}
 
 DelayedTask::~DelayedTask() = default;
 
-DelayedTask::DelayedTask(const DelayedTask& other) = default;
+DelayedTask::DelayedTask(DelayedTask&& other) noexcept = default;
+
+DelayedTask& DelayedTask::operator=(DelayedTask&& other) noexcept = default;
 
-const fml::closure& DelayedTask::GetTask() const {
+const fml::TaskClosure& DelayedTask::GetTask() const {
   return task_;
 }
 
+fml::TaskClosure DelayedTask::TakeTask() {
+  return std::move(task_);
+}
+
 fml::TimePoint DelayedTask::GetTargetTime() const {
   return target_time_;
 }
@@ -40,4 +49,32 @@ bool DelayedTask::operator>(const DelayedTask& other) const {
   return target_time_ > other.target_time_;
 }
 
+DelayedTaskQueue::DelayedTaskQueue() = default;
+
+DelayedTaskQueue::DelayedTaskQueue(DelayedTaskQueue&& other) noexcept =
+    default;
+
+DelayedTaskQueue& DelayedTaskQueue::operator=(
+    DelayedTaskQueue&& other) noexcept = default;
+
+DelayedTaskQueue::~DelayedTaskQueue() = default;
+
+const DelayedTask& DelayedTaskQueue::top() const {
+  FML_DCHECK(!tasks_.empty());
+  return tasks_.front();
+}
+
+void DelayedTaskQueue::push(DelayedTask task) {
+  tasks_.push_back(std::move(task));
+  std::push_heap(tasks_.begin(), tasks_.end(), std::greater<DelayedTask>());
+}
+
+DelayedTask DelayedTaskQueue::pop() {
+  FML_DCHECK(!tasks_.empty());
+  std::pop_heap(tasks_.begin(), tasks_.end(), std::greater<DelayedTask>());
+  DelayedTask task = std::move(tasks_.back());
+  tasks_.pop_back();
+  return task;
+}
+
 }  // namespace fml
@@ -5,9 +5,9 @@
 #ifndef FLUTTER_FML_DELAYED_TASK_H_
 #define FLUTTER_FML_DELAYED_TASK_H_
 
-#include <queue>
+#include <vector>
 
-#include "flutter/fml/closure.h"
+#include "flutter/fml/task_closure.h"
 #include "flutter/fml/task_source_grade.h"
 #include "flutter/fml/time/time_point.h"
 
@@ -16,15 +16,20 @@ namespace fml {
 class DelayedTask {
  public:
   DelayedTask(size_t order,
-              const fml::closure& task,
+              fml::TaskClosure task,
               fml::TimePoint target_time,
               fml::TaskSourceGrade task_source_grade);
 
-  DelayedTask(const DelayedTask& other);
+  DelayedTask(DelayedTask&& other) noexcept;
+
+  DelayedTask& operator=(DelayedTask&& other) noexcept;
 
   ~DelayedTask();
 
-  const fml::closure& GetTask() const;
+  const fml::TaskClosure& GetTask() const;
+
+  /// Moves the task out, leaving this delayed task without one.
+  fml::TaskClosure TakeTask();
 
   fml::TimePoint GetTargetTime() const;
 
@@ -34,14 +39,40 @@ class DelayedTask {
 
  private:
   size_t order_;
-  fml::closure task_;
+  fml::TaskClosure task_;
   fml::TimePoint target_time_;
   fml::TaskSourceGrade task_source_grade_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DelayedTask);
 };
 
-using DelayedTaskQueue = std::priority_queue<DelayedTask,
-                                             std::deque<DelayedTask>,
-                                             std::greater<DelayedTask>>;
+/// A min-heap of delayed tasks. Unlike |std::priority_queue|, popping moves
+/// the task out instead of requiring a copy of the top.
+class DelayedTaskQueue {
+ public:
+  DelayedTaskQueue();
+
+  DelayedTaskQueue(DelayedTaskQueue&& other) noexcept;
+
+  DelayedTaskQueue& operator=(DelayedTaskQueue&& other) noexcept;
+
+  ~DelayedTaskQueue();
+
+  bool empty() const { return tasks_.empty(); }
+
+  size_t size() const { return tasks_.size(); }
+
+  const DelayedTask& top() const;
+
+  void push(DelayedTask task);
+
+  DelayedTask pop();
+
+ private:
+  std::vector<DelayedTask> tasks_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DelayedTaskQueue);
+};
 
 }  // namespace fml
 
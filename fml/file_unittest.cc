@@ -253,6 +253,37 @@ TEST(FileTest, AtomicWriteTest) {
   ASSERT_TRUE(fml::UnlinkFile(dir.fd(), "precious_data"));
 }
 
+TEST(FileTest, MapsFilesWithAdvice) {
+  fml::ScopedTemporaryDirectory dir;
+
+  const std::string contents(3 * 4096 + 7, 'a');
+  fml::DataMapping data(contents);
+  ASSERT_TRUE(fml::WriteAtomically(dir.fd(), "advised_data", data));
+
+  fml::FileMapping::Advice advice;
+  advice.populate = true;
+  advice.will_need = true;
+  advice.huge_pages = true;
+  auto mapping = fml::FileMapping::CreateReadOnly(dir.fd(), "advised_data",
+                                                  advice);
+  ASSERT_NE(mapping, nullptr);
+  ASSERT_EQ(mapping->GetSize(), contents.size());
+  ASSERT_EQ(::memcmp(mapping->GetMapping(), contents.data(), contents.size()),
+            0);
+
+#if !FML_OS_WIN
+  EXPECT_TRUE(mapping->Prefetch(0, contents.size()));
+  EXPECT_TRUE(mapping->Prefetch(4097, 10));
+  EXPECT_TRUE(mapping->Prefetch(contents.size(), 0));
+  EXPECT_TRUE(fml::PrefetchMappedPages(mapping->GetMapping() + 4097, 10));
+#endif  // !FML_OS_WIN
+  EXPECT_FALSE(mapping->Prefetch(contents.size(), 1));
+  EXPECT_FALSE(mapping->Prefetch(1, contents.size()));
+
+  mapping.reset();
+  ASSERT_TRUE(fml::UnlinkFile(dir.fd(), "advised_data"));
+}
+
 TEST(FileTest, IgnoreBaseDirWhenPathIsAbsolute) {
   fml::ScopedTemporaryDirectory dir;
 
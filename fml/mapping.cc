@@ -18,21 +18,24 @@ uint8_t* FileMapping::GetMutableMapping() {
 }
 
 std::unique_ptr<FileMapping> FileMapping::CreateReadOnly(
-    const std::string& path) {
+    const std::string& path,
+    const Advice& advice) {
   return CreateReadOnly(OpenFile(path.c_str(), false, FilePermission::kRead),
-                        "");
+                        "", advice);
 }
 
 std::unique_ptr<FileMapping> FileMapping::CreateReadOnly(
     const fml::UniqueFD& base_fd,
-    const std::string& sub_path) {
+    const std::string& sub_path,
+    const Advice& advice) {
   if (!sub_path.empty()) {
     return CreateReadOnly(
-        OpenFile(base_fd, sub_path.c_str(), false, FilePermission::kRead), "");
+        OpenFile(base_fd, sub_path.c_str(), false, FilePermission::kRead), "",
+        advice);
   }
 
   auto mapping = std::make_unique<FileMapping>(
-      base_fd, std::initializer_list<Protection>{Protection::kRead});
+      base_fd, std::initializer_list<Protection>{Protection::kRead}, advice);
 
   if (!mapping->IsValid()) {
     return nullptr;
@@ -42,22 +45,27 @@ std::unique_ptr<FileMapping> FileMapping::CreateReadOnly(
 }
 
 std::unique_ptr<FileMapping> FileMapping::CreateReadExecute(
-    const std::string& path) {
+    const std::string& path,
+    const Advice& advice) {
   return CreateReadExecute(
-      OpenFile(path.c_str(), false, FilePermission::kRead));
+      OpenFile(path.c_str(), false, FilePermission::kRead), "", advice);
 }
 
 std::unique_ptr<FileMapping> FileMapping::CreateReadExecute(
     const fml::UniqueFD& base_fd,
-    const std::string& sub_path) {
+    const std::string& sub_path,
+    const Advice& advice) {
   if (!sub_path.empty()) {
     return CreateReadExecute(
-        OpenFile(base_fd, sub_path.c_str(), false, FilePermission::kRead), "");
+        OpenFile(base_fd, sub_path.c_str(), false, FilePermission::kRead), "",
+        advice);
   }
 
   auto mapping = std::make_unique<FileMapping>(
-      base_fd, std::initializer_list<Protection>{Protection::kRead,
-                                                 Protection::kExecute});
+      base_fd,
+      std::initializer_list<Protection>{Protection::kRead,
+                                        Protection::kExecute},
+      advice);
 
   if (!mapping->IsValid()) {
     return nullptr;
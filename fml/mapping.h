@@ -36,6 +36,26 @@ class Mapping {
   FML_DISALLOW_COPY_AND_ASSIGN(Mapping);
 };
 
+/// Asks the OS to start reading the file-backed pages that hold the given
+/// memory range in the background, ahead of their first use. Returns false
+/// if the OS does not support prefetching or the range is not mapped.
+bool PrefetchMappedPages(const uint8_t* address, size_t length);
+
+/// How a mapping is going to be accessed. These are hints to the OS that
+/// avoid faulting in large files one page at a time. They are only
+/// supported on POSIX platforms and ignored elsewhere.
+struct FileMappingAdvice {
+  /// Faults in the whole file when it is mapped (MAP_POPULATE). Only
+  /// supported on Linux and Android.
+  bool populate = false;
+  /// Starts reading the whole file in the background (MADV_WILLNEED).
+  bool will_need = false;
+  /// Backs the mapping with transparent huge pages where the kernel
+  /// supports them for files (MADV_HUGEPAGE). Only supported on Linux and
+  /// Android.
+  bool huge_pages = false;
+};
+
 class FileMapping final : public Mapping {
  public:
   enum class Protection {
@@ -44,24 +64,31 @@ class FileMapping final : public Mapping {
     kExecute,
   };
 
+  using Advice = FileMappingAdvice;
+
   explicit FileMapping(const fml::UniqueFD& fd,
                        std::initializer_list<Protection> protection = {
-                           Protection::kRead});
+                           Protection::kRead},
+                       const Advice& advice = {});
 
   ~FileMapping() override;
 
-  static std::unique_ptr<FileMapping> CreateReadOnly(const std::string& path);
+  static std::unique_ptr<FileMapping> CreateReadOnly(const std::string& path,
+                                                     const Advice& advice = {});
 
   static std::unique_ptr<FileMapping> CreateReadOnly(
       const fml::UniqueFD& base_fd,
-      const std::string& sub_path = "");
+      const std::string& sub_path = "",
+      const Advice& advice = {});
 
   static std::unique_ptr<FileMapping> CreateReadExecute(
-      const std::string& path);
+      const std::string& path,
+      const Advice& advice = {});
 
   static std::unique_ptr<FileMapping> CreateReadExecute(
       const fml::UniqueFD& base_fd,
-      const std::string& sub_path = "");
+      const std::string& sub_path = "",
+      const Advice& advice = {});
 
   // |Mapping|
   size_t GetSize() const override;
@@ -76,6 +103,11 @@ class FileMapping final : public Mapping {
 
   bool IsValid() const;
 
+  /// Asks the OS to start reading the given range of the file in the
+  /// background, ahead of its first use. Returns false if the range is
+  /// outside of the mapping or the OS does not support prefetching.
+  bool Prefetch(size_t offset, size_t length) const;
+
  private:
   bool valid_ = false;
   size_t size_ = 0;
@@ -0,0 +1,77 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/memory/allocation_counter.h"
+
+#include <atomic>
+
+namespace fml {
+
+namespace {
+
+struct ThreadAllocationCounts {
+  AllocationCount counts[kAllocationTagCount];
+};
+
+struct ProcessAllocationCounts {
+  std::atomic<uint64_t> allocations{0u};
+  std::atomic<uint64_t> bytes{0u};
+};
+
+thread_local ThreadAllocationCounts tThreadCounts;
+ProcessAllocationCounts gProcessCounts[kAllocationTagCount];
+
+}  // namespace
+
+const char* GetAllocationTagName(AllocationTag tag) {
+  switch (tag) {
+    case AllocationTag::kDisplayList:
+      return "DisplayList";
+    case AllocationTag::kHostBuffer:
+      return "HostBuffer";
+    case AllocationTag::kEntityPass:
+      return "EntityPass";
+    case AllocationTag::kTextFrame:
+      return "TextFrame";
+    case AllocationTag::kPath:
+      return "Path";
+  }
+  return "Unknown";
+}
+
+void RecordAllocation(AllocationTag tag, size_t bytes) {
+  const auto index = static_cast<size_t>(tag);
+  AllocationCount& thread_count = tThreadCounts.counts[index];
+  thread_count.allocations++;
+  thread_count.bytes += bytes;
+  // Nothing is ordered by the counts, and reports may read slightly stale
+  // values.
+  gProcessCounts[index].allocations.fetch_add(1u, std::memory_order_relaxed);
+  gProcessCounts[index].bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+AllocationCount GetThreadAllocationCount(AllocationTag tag) {
+  return tThreadCounts.counts[static_cast<size_t>(tag)];
+}
+
+AllocationCount GetProcessAllocationCount(AllocationTag tag) {
+  const auto& counts = gProcessCounts[static_cast<size_t>(tag)];
+  return {
+      .allocations = counts.allocations.load(std::memory_order_relaxed),
+      .bytes = counts.bytes.load(std::memory_order_relaxed),
+  };
+}
+
+ScopedAllocationCounter::ScopedAllocationCounter(AllocationTag tag)
+    : tag_(tag), start_(GetThreadAllocationCount(tag)) {}
+
+AllocationCount ScopedAllocationCounter::GetCount() const {
+  AllocationCount current = GetThreadAllocationCount(tag_);
+  return {
+      .allocations = current.allocations - start_.allocations,
+      .bytes = current.bytes - start_.bytes,
+  };
+}
+
+}  // namespace fml
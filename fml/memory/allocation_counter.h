@@ -0,0 +1,69 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_MEMORY_ALLOCATION_COUNTER_H_
+#define FLUTTER_FML_MEMORY_ALLOCATION_COUNTER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fml {
+
+/// The engine subsystems whose native allocations are counted.
+enum class AllocationTag : uint8_t {
+  kDisplayList,
+  kHostBuffer,
+  kEntityPass,
+  kTextFrame,
+  kPath,
+  kLast = kPath,
+};
+
+constexpr size_t kAllocationTagCount =
+    static_cast<size_t>(AllocationTag::kLast) + 1;
+
+/// @brief The name of |tag| for reports, such as "DisplayList".
+const char* GetAllocationTagName(AllocationTag tag);
+
+struct AllocationCount {
+  uint64_t allocations = 0u;
+  uint64_t bytes = 0u;
+};
+
+/// @brief Counts an allocation of |bytes| bytes made by the |tag| subsystem.
+///
+///        The allocation is added to the counts of the calling thread and of
+///        the process. This only updates counters, so it is cheap enough to
+///        call on every allocation the subsystem makes.
+void RecordAllocation(AllocationTag tag, size_t bytes);
+
+/// @brief The allocations the |tag| subsystem made on the calling thread.
+AllocationCount GetThreadAllocationCount(AllocationTag tag);
+
+/// @brief The allocations the |tag| subsystem made on all threads.
+AllocationCount GetProcessAllocationCount(AllocationTag tag);
+
+/// Counts the allocations a subsystem makes on the current thread while the
+/// counter is alive, for example during the iterations of a benchmark.
+class ScopedAllocationCounter {
+ public:
+  explicit ScopedAllocationCounter(AllocationTag tag);
+
+  ~ScopedAllocationCounter() = default;
+
+  /// @brief The allocations made since the counter was created.
+  AllocationCount GetCount() const;
+
+ private:
+  const AllocationTag tag_;
+  const AllocationCount start_;
+
+  ScopedAllocationCounter(const ScopedAllocationCounter&) = delete;
+
+  ScopedAllocationCounter& operator=(const ScopedAllocationCounter&) = delete;
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_MEMORY_ALLOCATION_COUNTER_H_
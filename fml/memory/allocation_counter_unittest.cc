@@ -0,0 +1,51 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/memory/allocation_counter.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(AllocationCounterTest, CountsAllocationsOfTheScope) {
+  RecordAllocation(AllocationTag::kPath, 16u);
+
+  ScopedAllocationCounter counter(AllocationTag::kPath);
+  EXPECT_EQ(counter.GetCount().allocations, 0u);
+
+  RecordAllocation(AllocationTag::kPath, 32u);
+  RecordAllocation(AllocationTag::kPath, 64u);
+  RecordAllocation(AllocationTag::kTextFrame, 128u);
+
+  EXPECT_EQ(counter.GetCount().allocations, 2u);
+  EXPECT_EQ(counter.GetCount().bytes, 96u);
+}
+
+TEST(AllocationCounterTest, ThreadCountsOnlyIncludeTheirThread) {
+  auto thread_before = GetThreadAllocationCount(AllocationTag::kHostBuffer);
+  auto process_before = GetProcessAllocationCount(AllocationTag::kHostBuffer);
+
+  std::thread thread(
+      [] { RecordAllocation(AllocationTag::kHostBuffer, 1024u); });
+  thread.join();
+
+  auto thread_after = GetThreadAllocationCount(AllocationTag::kHostBuffer);
+  auto process_after = GetProcessAllocationCount(AllocationTag::kHostBuffer);
+  EXPECT_EQ(thread_after.allocations, thread_before.allocations);
+  EXPECT_EQ(process_after.allocations, process_before.allocations + 1u);
+  EXPECT_EQ(process_after.bytes, process_before.bytes + 1024u);
+}
+
+TEST(AllocationCounterTest, EveryTagHasAName) {
+  for (size_t i = 0; i < kAllocationTagCount; i++) {
+    EXPECT_STRNE(GetAllocationTagName(static_cast<AllocationTag>(i)),
+                 "Unknown");
+  }
+}
+
+}  // namespace testing
+}  // namespace fml
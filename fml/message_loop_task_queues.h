@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "flutter/fml/closure.h"
+#include "flutter/fml/task_closure.h"
 #include "flutter/fml/delayed_task.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
@@ -46,6 +47,10 @@ class TaskQueueEntry {
 
   TaskQueueId created_for;
 
+  /// Guards the tasks, observers and wakeable of this TaskQueue. The entries
+  /// of merged TaskQueues are locked together, owner first.
+  std::mutex mutex;
+
   explicit TaskQueueEntry(TaskQueueId created_for);
 
  private:
@@ -61,6 +66,11 @@ enum class FlushType {
 /// fml::MessageLoops.
 ///
 /// This also wakes up the loop at the required times.
+///
+/// Each TaskQueue has its own lock so that the loops of different engines
+/// don't contend with each other. Creating, disposing, merging and unmerging
+/// TaskQueues takes a separate lock exclusively, everything else takes it
+/// shared.
 /// \see fml::MessageLoop
 /// \see fml::Wakeable
 class MessageLoopTaskQueues {
@@ -78,14 +88,15 @@ class MessageLoopTaskQueues {
   // Tasks methods.
 
   void RegisterTask(TaskQueueId queue_id,
-                    const fml::closure& task,
+                    fml::TaskClosure task,
                     fml::TimePoint target_time,
                     fml::TaskSourceGrade task_source_grade =
                         fml::TaskSourceGrade::kUnspecified);
 
   bool HasPendingTasks(TaskQueueId queue_id) const;
 
-  fml::closure GetNextTaskToRun(TaskQueueId queue_id, fml::TimePoint from_time);
+  fml::TaskClosure GetNextTaskToRun(TaskQueueId queue_id,
+                                    fml::TimePoint from_time);
 
   size_t GetNumPendingTasks(TaskQueueId queue_id) const;
 
@@ -139,6 +150,7 @@ class MessageLoopTaskQueues {
 
  private:
   class MergedQueuesRunner;
+  class QueueGroupLock;
 
   MessageLoopTaskQueues();
 
@@ -152,7 +164,8 @@ class MessageLoopTaskQueues {
 
   fml::TimePoint GetNextWakeTimeUnlocked(TaskQueueId queue_id) const;
 
-  mutable std::mutex queue_mutex_;
+  // Guards |queue_entries_| and the merged state of the entries.
+  std::unique_ptr<fml::SharedMutex> topology_mutex_;
   std::map<TaskQueueId, std::unique_ptr<TaskQueueEntry>> queue_entries_;
 
   size_t task_queue_id_counter_ = 0;
@@ -44,7 +44,7 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
         const auto now = fml::TimePoint::Now();
         int num_invocations = 0;
         for (;;) {
-          fml::closure invocation =
+          fml::TaskClosure invocation =
               task_queue->GetNextTaskToRun(TaskQueueId(task_runner_id), now);
           if (!invocation) {
             break;
@@ -64,7 +64,64 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
   }
 }
 
+// Engines with a platform, UI, raster and IO task queue each, where every
+// thread posts tasks to its own queue and the next queue of its engine before
+// draining its own queue. Queues of different engines don't share any state.
+static void BM_RegisterAndGetTasksAcrossEngines(
+    benchmark::State& state) {  // NOLINT
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  const int num_engines = state.range(0);
+  const int num_queues_per_engine = 4;
+  const int num_tasks_per_queue = 100;
+  const int num_queues = num_engines * num_queues_per_engine;
+
+  while (state.KeepRunning()) {
+    const fml::TimePoint past = fml::TimePoint::Now();
+    std::vector<TaskQueueId> queue_ids;
+    for (int i = 0; i < num_queues; i++) {
+      queue_ids.push_back(task_queues->CreateTaskQueue());
+    }
+
+    CountDownLatch tasks_registered(num_queues);
+    std::vector<std::thread> threads;
+    threads.reserve(num_queues);
+    for (int i = 0; i < num_queues; i++) {
+      const int engine_start = i - i % num_queues_per_engine;
+      const TaskQueueId own_queue = queue_ids[i];
+      const TaskQueueId next_queue =
+          queue_ids[engine_start + (i + 1) % num_queues_per_engine];
+      threads.emplace_back([&, own_queue, next_queue]() {
+        for (int j = 0; j < num_tasks_per_queue / 2; j++) {
+          task_queues->RegisterTask(own_queue, [] {}, past);
+          task_queues->RegisterTask(next_queue, [] {}, past);
+        }
+        tasks_registered.CountDown();
+        tasks_registered.Wait();
+        const auto now = fml::TimePoint::Now();
+        int num_invocations = 0;
+        while (task_queues->GetNextTaskToRun(own_queue, now)) {
+          num_invocations++;
+        }
+        assert(num_invocations == num_tasks_per_queue);
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (const auto& queue_id : queue_ids) {
+      task_queues->Dispose(queue_id);
+    }
+  }
+}
+
 BENCHMARK(BM_RegisterAndGetTasks);
+BENCHMARK(BM_RegisterAndGetTasksAcrossEngines)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
 
 }  // namespace benchmarking
 }  // namespace fml
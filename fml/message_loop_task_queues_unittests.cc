@@ -7,6 +7,7 @@
 #include "flutter/fml/message_loop_task_queues.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <thread>
 #include <utility>
@@ -108,7 +109,7 @@ TEST(MessageLoopTaskQueue, PreserveTaskOrdering) {
   const auto now = ChronoTicksSinceEpoch();
   int expected_value = 1;
   while (true) {
-    fml::closure invocation = task_queue->GetNextTaskToRun(queue_id, now);
+    fml::TaskClosure invocation = task_queue->GetNextTaskToRun(queue_id, now);
     if (!invocation) {
       break;
     }
@@ -148,7 +149,8 @@ TEST(MessageLoopTaskQueue, RegisterTasksOnMergedQueuesPreserveTaskOrdering) {
   // "test_val = 1" in platform_queue
   // "test_val = 2" in raster2_queue
   while (true) {
-    fml::closure invocation = task_queue->GetNextTaskToRun(platform_queue, now);
+    fml::TaskClosure invocation =
+        task_queue->GetNextTaskToRun(platform_queue, now);
     if (!invocation) {
       break;
     }
@@ -191,7 +193,8 @@ TEST(MessageLoopTaskQueue, UnmergeRespectTheOriginalTaskOrderingInQueues) {
   // "test_val = 1" in platform_queue
   // "test_val = 2" in raster_queue (running on platform)
   for (int i = 0; i < 3; i++) {
-    fml::closure invocation = task_queue->GetNextTaskToRun(platform_queue, now);
+    fml::TaskClosure invocation =
+        task_queue->GetNextTaskToRun(platform_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == i);
@@ -210,7 +213,8 @@ TEST(MessageLoopTaskQueue, UnmergeRespectTheOriginalTaskOrderingInQueues) {
   // platform_queue has 1 task left: "test_val = 4"
   {
     ASSERT_TRUE(task_queue->GetNumPendingTasks(platform_queue) == 1);
-    fml::closure invocation = task_queue->GetNextTaskToRun(platform_queue, now);
+    fml::TaskClosure invocation =
+        task_queue->GetNextTaskToRun(platform_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == 4);
@@ -220,14 +224,16 @@ TEST(MessageLoopTaskQueue, UnmergeRespectTheOriginalTaskOrderingInQueues) {
   // raster_queue has 2 tasks left: "test_val = 3" and "test_val = 5"
   {
     ASSERT_TRUE(task_queue->GetNumPendingTasks(raster_queue) == 2);
-    fml::closure invocation = task_queue->GetNextTaskToRun(raster_queue, now);
+    fml::TaskClosure invocation =
+        task_queue->GetNextTaskToRun(raster_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == 3);
   }
   {
     ASSERT_TRUE(task_queue->GetNumPendingTasks(raster_queue) == 1);
-    fml::closure invocation = task_queue->GetNextTaskToRun(raster_queue, now);
+    fml::TaskClosure invocation =
+        task_queue->GetNextTaskToRun(raster_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == 5);
@@ -413,6 +419,57 @@ TEST(MessageLoopTaskQueue, ConcurrentQueueAndTaskCreatingCounts) {
   ASSERT_EQ(pending_tasks, kThreadCount * kThreadTaskCount);
 }
 
+//------------------------------------------------------------------------------
+/// Verifies that tasks can be registered and run concurrently while other
+/// task queues are merged and unmerged.
+///
+TEST(MessageLoopTaskQueue, ConcurrentTasksWhileMergingOtherQueues) {
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+
+  constexpr size_t kThreadCount = 4;
+  constexpr size_t kThreadTaskCount = 500;
+
+  auto platform_queue = task_queues->CreateTaskQueue();
+  auto raster_queue = task_queues->CreateTaskQueue();
+  std::atomic<bool> done = false;
+  std::thread merger([&]() {
+    do {
+      ASSERT_TRUE(task_queues->Merge(platform_queue, raster_queue));
+      task_queues->RegisterTask(
+          raster_queue, []() {}, ChronoTicksSinceEpoch());
+      ASSERT_TRUE(task_queues->Unmerge(platform_queue, raster_queue));
+    } while (!done);
+  });
+
+  std::atomic<size_t> tasks_run = 0;
+  auto thread_main = [&]() {
+    auto queue = task_queues->CreateTaskQueue();
+    for (size_t i = 0; i < kThreadTaskCount; i++) {
+      task_queues->RegisterTask(
+          queue, [&tasks_run]() { tasks_run++; }, ChronoTicksSinceEpoch());
+    }
+    while (auto task =
+               task_queues->GetNextTaskToRun(queue, ChronoTicksSinceEpoch())) {
+      task();
+    }
+    ASSERT_FALSE(task_queues->HasPendingTasks(queue));
+    task_queues->Dispose(queue);
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreadCount; i++) {
+    threads.emplace_back(std::thread{thread_main});
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  done = true;
+  merger.join();
+
+  ASSERT_EQ(tasks_run, kThreadCount * kThreadTaskCount);
+  ASSERT_GT(task_queues->GetNumPendingTasks(raster_queue), 0u);
+}
+
 TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
   auto platform_queue = task_queue->CreateTaskQueue();
@@ -6,8 +6,10 @@
 
 #include "flutter/fml/message_loop.h"
 
+#include <atomic>
 #include <iostream>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/concurrent_message_loop.h"
@@ -191,6 +193,65 @@ TEST(MessageLoop, CanCreateAndShutdownConcurrentMessageLoopsOverAndOver) {
   }
 }
 
+TEST(MessageLoop, ConcurrentMessageLoopRunsTasksPostedFromWorkers) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4u);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t kCount = 1000;
+  // The posting task counts down too so that it is done with the loop before
+  // the test destroys it, which must not happen on a worker.
+  fml::CountDownLatch latch(kCount + 1);
+  std::atomic<size_t> tasks_on_workers = 0;
+  task_runner->PostTask([&]() {
+    for (size_t i = 0; i < kCount; ++i) {
+      task_runner->PostTask([&]() {
+        if (task_runner->RunsTasksOnCurrentThread()) {
+          tasks_on_workers++;
+        }
+        latch.CountDown();
+      });
+    }
+    latch.CountDown();
+  });
+  latch.Wait();
+  ASSERT_EQ(tasks_on_workers, kCount);
+  ASSERT_FALSE(task_runner->RunsTasksOnCurrentThread());
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsTasksByPriorityAndDeadline) {
+  auto loop = fml::ConcurrentMessageLoop::Create(1u);
+  auto task_runner = loop->GetTaskRunner();
+  fml::AutoResetWaitableEvent blocked;
+  fml::AutoResetWaitableEvent unblock;
+  // Keep the only worker busy until all tasks are posted.
+  task_runner->PostTask([&]() {
+    blocked.Signal();
+    unblock.Wait();
+  });
+  blocked.Wait();
+
+  std::vector<int> order;
+  fml::CountDownLatch latch(5);
+  auto record = [&](int id) {
+    return [&, id]() {
+      order.push_back(id);
+      latch.CountDown();
+    };
+  };
+  const auto now = fml::TimePoint::Now();
+  task_runner->PostTask(record(4), fml::ConcurrentTaskPriority::kBackground);
+  task_runner->PostTask(record(3));
+  task_runner->PostTask(record(2), fml::ConcurrentTaskPriority::kUserVisible,
+                        now + fml::TimeDelta::FromSeconds(1));
+  task_runner->PostTask(record(1), fml::ConcurrentTaskPriority::kFrameCritical,
+                        now + fml::TimeDelta::FromSeconds(2));
+  task_runner->PostTask(record(0), fml::ConcurrentTaskPriority::kFrameCritical,
+                        now + fml::TimeDelta::FromSeconds(1));
+  unblock.Signal();
+  latch.Wait();
+
+  ASSERT_EQ(order, (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
 TEST(MessageLoop, CanCreateConcurrentMessageLoop) {
   auto loop = fml::ConcurrentMessageLoop::Create();
   auto task_runner = loop->GetTaskRunner();
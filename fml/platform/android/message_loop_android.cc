@@ -7,12 +7,14 @@
 #include <fcntl.h>
 #include <unistd.h>
 
-#include "flutter/fml/platform/linux/timerfd.h"
-
 namespace fml {
 
 static constexpr int kClockType = CLOCK_MONOTONIC;
 
+// How late a timer may fire to share a wake up with the one after it.
+static constexpr fml::TimeDelta kTimerSlack =
+    fml::TimeDelta::FromMicroseconds(500);
+
 static ALooper* AcquireLooperForThread() {
   ALooper* looper = ALooper_forThread();
 
@@ -30,7 +32,8 @@ static ALooper* AcquireLooperForThread() {
 
 MessageLoopAndroid::MessageLoopAndroid()
     : looper_(AcquireLooperForThread()),
-      timer_fd_(::timerfd_create(kClockType, TFD_NONBLOCK | TFD_CLOEXEC)) {
+      timer_fd_(::timerfd_create(kClockType, TFD_NONBLOCK | TFD_CLOEXEC)),
+      timer_(timer_fd_.get(), kTimerSlack) {
   FML_CHECK(looper_.is_valid());
   FML_CHECK(timer_fd_.is_valid());
 
@@ -82,12 +85,12 @@ void MessageLoopAndroid::Terminate() {
 }
 
 void MessageLoopAndroid::WakeUp(fml::TimePoint time_point) {
-  [[maybe_unused]] bool result = TimerRearm(timer_fd_.get(), time_point);
+  [[maybe_unused]] bool result = timer_.Rearm(time_point);
   FML_DCHECK(result);
 }
 
 void MessageLoopAndroid::OnEventFired() {
-  if (TimerDrain(timer_fd_.get())) {
+  if (timer_.Drain()) {
     RunExpiredTasksNow();
   }
 }
@@ -11,6 +11,7 @@
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/message_loop_impl.h"
+#include "flutter/fml/platform/linux/timerfd.h"
 #include "flutter/fml/unique_fd.h"
 
 namespace fml {
@@ -29,6 +30,7 @@ class MessageLoopAndroid : public MessageLoopImpl {
  private:
   fml::UniqueObject<ALooper*, UniqueLooperTraits> looper_;
   fml::UniqueFD timer_fd_;
+  fml::CoalescingTimer timer_;
   bool running_ = false;
 
   MessageLoopAndroid();
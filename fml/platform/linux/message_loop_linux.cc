@@ -8,15 +8,19 @@
 #include <unistd.h>
 
 #include "flutter/fml/eintr_wrapper.h"
-#include "flutter/fml/platform/linux/timerfd.h"
 
 namespace fml {
 
 static constexpr int kClockType = CLOCK_MONOTONIC;
 
+// How late a timer may fire to share a wake up with the one after it.
+static constexpr fml::TimeDelta kTimerSlack =
+    fml::TimeDelta::FromMicroseconds(500);
+
 MessageLoopLinux::MessageLoopLinux()
     : epoll_fd_(FML_HANDLE_EINTR(::epoll_create(1 /* unused */))),
-      timer_fd_(::timerfd_create(kClockType, TFD_NONBLOCK | TFD_CLOEXEC)) {
+      timer_fd_(::timerfd_create(kClockType, TFD_NONBLOCK | TFD_CLOEXEC)),
+      timer_(timer_fd_.get(), kTimerSlack) {
   FML_CHECK(epoll_fd_.is_valid());
   FML_CHECK(timer_fd_.is_valid());
   bool added_source = AddOrRemoveTimerSource(true);
@@ -79,13 +83,13 @@ void MessageLoopLinux::Terminate() {
 
 // |fml::MessageLoopImpl|
 void MessageLoopLinux::WakeUp(fml::TimePoint time_point) {
-  bool result = TimerRearm(timer_fd_.get(), time_point);
+  bool result = timer_.Rearm(time_point);
   (void)result;
   FML_DCHECK(result);
 }
 
 void MessageLoopLinux::OnEventFired() {
-  if (TimerDrain(timer_fd_.get())) {
+  if (timer_.Drain()) {
     RunExpiredTasksNow();
   }
 }
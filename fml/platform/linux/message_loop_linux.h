@@ -9,6 +9,7 @@
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/message_loop_impl.h"
+#include "flutter/fml/platform/linux/timerfd.h"
 #include "flutter/fml/unique_fd.h"
 
 namespace fml {
@@ -17,6 +18,7 @@ class MessageLoopLinux : public MessageLoopImpl {
  private:
   fml::UniqueFD epoll_fd_;
   fml::UniqueFD timer_fd_;
+  fml::CoalescingTimer timer_;
   bool running_ = false;
 
   MessageLoopLinux();
@@ -66,4 +66,43 @@ bool TimerDrain(int fd) {
   return fire_count > 0;
 }
 
+CoalescingTimer::CoalescingTimer(int fd, fml::TimeDelta slack)
+    : fd_(fd), slack_(slack) {}
+
+CoalescingTimer::~CoalescingTimer() = default;
+
+bool CoalescingTimer::Rearm(fml::TimePoint time_point) {
+  std::scoped_lock lock(mutex_);
+  if (armed_time_.has_value()) {
+    const fml::TimePoint armed_time = armed_time_.value();
+    if (armed_time == time_point) {
+      return true;
+    }
+    const fml::TimePoint now = fml::TimePoint::Now();
+    if (armed_time <= now) {
+      // About to wake up, or woken up and not drained yet.
+      return true;
+    }
+    if (time_point > now && time_point < armed_time &&
+        armed_time - time_point <= slack_) {
+      return true;
+    }
+  }
+  if (!TimerRearm(fd_, time_point)) {
+    return false;
+  }
+  armed_time_ = time_point;
+  return true;
+}
+
+bool CoalescingTimer::Drain() {
+  std::scoped_lock lock(mutex_);
+  if (!TimerDrain(fd_)) {
+    // Woken up by an expiry that a re-arm since then has reset.
+    return false;
+  }
+  armed_time_ = std::nullopt;
+  return true;
+}
+
 }  // namespace fml
@@ -5,6 +5,11 @@
 #ifndef FLUTTER_FML_PLATFORM_LINUX_TIMERFD_H_
 #define FLUTTER_FML_PLATFORM_LINUX_TIMERFD_H_
 
+#include <mutex>
+#include <optional>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 
 // clang-format off
@@ -51,6 +56,54 @@ bool TimerRearm(int fd, fml::TimePoint time_point);
 /// timer expiry.
 bool TimerDrain(int fd);
 
+//------------------------------------------------------------------------------
+/// @brief      Re-arms and drains a timer file descriptor, skipping the
+///             re-arming when it would not change when the loop wakes up.
+///
+///             The task queues ask for a wake up on every posted and run task,
+///             mostly for the time the timer is already armed for. Deadlines
+///             that arrive while the timer is already due are skipped too
+///             since the loop looks at the next deadline again when it wakes
+///             up. A deadline at most |slack| before the armed one is folded
+///             into that wake up instead of waking the loop up twice, which
+///             makes its task run late by that much at most. Deadlines that
+///             have passed are never deferred.
+///
+///             Timer file descriptors ignore the timer slack of the thread, so
+///             this is the only slack applied to the wake ups of the loop.
+///
+class CoalescingTimer {
+ public:
+  CoalescingTimer(int fd, fml::TimeDelta slack);
+
+  ~CoalescingTimer();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Makes sure the timer fires at |time_point|, or at most
+  ///             |slack| later. May be called on any thread.
+  ///
+  /// @return     If the timer is armed.
+  ///
+  bool Rearm(fml::TimePoint time_point);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reads the expirations of the timer on the thread of the loop.
+  ///
+  /// @return     If the timer had fired.
+  ///
+  bool Drain();
+
+ private:
+  const int fd_;
+  const fml::TimeDelta slack_;
+  // Orders re-arming against the draining on the thread of the loop.
+  std::mutex mutex_;
+  // The time the timer fires at, or none if it fired already and was drained.
+  std::optional<fml::TimePoint> armed_time_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(CoalescingTimer);
+};
+
 }  // namespace fml
 
 #endif  // FLUTTER_FML_PLATFORM_LINUX_TIMERFD_H_
@@ -0,0 +1,83 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/platform/linux/timerfd.h"
+
+#include <poll.h>
+
+#include "flutter/fml/unique_fd.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+namespace {
+
+fml::UniqueFD CreateTimerFD() {
+  return fml::UniqueFD(
+      ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC));
+}
+
+fml::TimeDelta GetRemainingTime(int fd) {
+  struct itimerspec spec = {};
+  EXPECT_EQ(::timerfd_gettime(fd, &spec), 0);
+  return fml::TimeDelta::FromSeconds(spec.it_value.tv_sec) +
+         fml::TimeDelta::FromNanoseconds(spec.it_value.tv_nsec);
+}
+
+bool WaitForExpiry(int fd) {
+  struct pollfd poll_fd = {};
+  poll_fd.fd = fd;
+  poll_fd.events = POLLIN;
+  return ::poll(&poll_fd, 1, 5000 /* timeout in ms */) == 1;
+}
+
+}  // namespace
+
+TEST(CoalescingTimerTest, FoldsEarlierDeadlinesWithinSlack) {
+  auto fd = CreateTimerFD();
+  ASSERT_TRUE(fd.is_valid());
+  CoalescingTimer timer(fd.get(), fml::TimeDelta::FromSeconds(1));
+
+  const auto deadline = fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(10);
+  ASSERT_TRUE(timer.Rearm(deadline));
+  ASSERT_TRUE(timer.Rearm(deadline - fml::TimeDelta::FromMilliseconds(500)));
+  EXPECT_GT(GetRemainingTime(fd.get()), fml::TimeDelta::FromSeconds(9));
+
+  ASSERT_TRUE(timer.Rearm(deadline - fml::TimeDelta::FromSeconds(5)));
+  EXPECT_LT(GetRemainingTime(fd.get()), fml::TimeDelta::FromSeconds(6));
+}
+
+TEST(CoalescingTimerTest, NeverDefersPassedDeadlines) {
+  auto fd = CreateTimerFD();
+  ASSERT_TRUE(fd.is_valid());
+  CoalescingTimer timer(fd.get(), fml::TimeDelta::FromSeconds(1));
+
+  const auto now = fml::TimePoint::Now();
+  ASSERT_TRUE(timer.Rearm(now + fml::TimeDelta::FromMilliseconds(500)));
+  ASSERT_TRUE(timer.Rearm(now));
+  ASSERT_TRUE(WaitForExpiry(fd.get()));
+  EXPECT_TRUE(timer.Drain());
+}
+
+TEST(CoalescingTimerTest, RearmsAfterDraining) {
+  auto fd = CreateTimerFD();
+  ASSERT_TRUE(fd.is_valid());
+  CoalescingTimer timer(fd.get(), fml::TimeDelta::FromSeconds(1));
+
+  EXPECT_FALSE(timer.Drain());
+  ASSERT_TRUE(timer.Rearm(fml::TimePoint::Now()));
+  ASSERT_TRUE(WaitForExpiry(fd.get()));
+  // The loop wakes up anyway, so there is no need to re-arm until then.
+  ASSERT_TRUE(timer.Rearm(fml::TimePoint::Now()));
+  EXPECT_TRUE(timer.Drain());
+  EXPECT_FALSE(timer.Drain());
+
+  ASSERT_TRUE(timer.Rearm(fml::TimePoint::Now()));
+  ASSERT_TRUE(WaitForExpiry(fd.get()));
+  EXPECT_TRUE(timer.Drain());
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -51,7 +51,8 @@ Mapping::Mapping() = default;
 Mapping::~Mapping() = default;
 
 FileMapping::FileMapping(const fml::UniqueFD& handle,
-                         std::initializer_list<Protection> protection) {
+                         std::initializer_list<Protection> protection,
+                         const Advice& advice) {
   if (!handle.is_valid()) {
     return;
   }
@@ -69,9 +70,16 @@ FileMapping::FileMapping(const fml::UniqueFD& handle,
 
   const auto is_writable = IsWritable(protection);
 
+  int flags = is_writable ? MAP_SHARED : MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+  if (advice.populate) {
+    flags |= MAP_POPULATE;
+  }
+#endif  // defined(MAP_POPULATE)
+
   auto* mapping =
       ::mmap(nullptr, stat_buffer.st_size, ToPosixProtectionFlags(protection),
-             is_writable ? MAP_SHARED : MAP_PRIVATE, handle.get(), 0);
+             flags, handle.get(), 0);
 
   if (mapping == MAP_FAILED) {
     return;
@@ -83,6 +91,16 @@ FileMapping::FileMapping(const fml::UniqueFD& handle,
   if (is_writable) {
     mutable_mapping_ = mapping_;
   }
+
+  // The advice is only a hint, so failures are ignored.
+#if defined(MADV_HUGEPAGE)
+  if (advice.huge_pages) {
+    ::madvise(mapping_, size_, MADV_HUGEPAGE);
+  }
+#endif  // defined(MADV_HUGEPAGE)
+  if (advice.will_need) {
+    Prefetch(0, size_);
+  }
 }
 
 FileMapping::~FileMapping() {
@@ -107,4 +125,26 @@ bool FileMapping::IsValid() const {
   return valid_;
 }
 
+bool FileMapping::Prefetch(size_t offset, size_t length) const {
+  if (mapping_ == nullptr || offset > size_ || length > size_ - offset) {
+    return false;
+  }
+  return PrefetchMappedPages(mapping_ + offset, length);
+}
+
+bool PrefetchMappedPages(const uint8_t* address, size_t length) {
+  if (length == 0) {
+    return true;
+  }
+  if (address == nullptr) {
+    return false;
+  }
+  // madvise needs a page aligned address.
+  static const uintptr_t page_size = ::sysconf(_SC_PAGESIZE);
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(address);
+  const uintptr_t aligned_begin = begin - begin % page_size;
+  return ::madvise(reinterpret_cast<void*>(aligned_begin),
+                   begin + length - aligned_begin, MADV_WILLNEED) == 0;
+}
+
 }  // namespace fml
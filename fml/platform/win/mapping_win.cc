@@ -41,7 +41,8 @@ static bool IsExecutable(
 }
 
 FileMapping::FileMapping(const fml::UniqueFD& fd,
-                         std::initializer_list<Protection> protections)
+                         std::initializer_list<Protection> protections,
+                         const Advice& advice)
     : size_(0), mapping_(nullptr) {
   if (!fd.is_valid()) {
     return;
@@ -119,6 +120,14 @@ bool FileMapping::IsDontNeedSafe() const {
   return mutable_mapping_ == nullptr;
 }
 
+bool FileMapping::Prefetch(size_t offset, size_t length) const {
+  return false;
+}
+
+bool PrefetchMappedPages(const uint8_t* address, size_t length) {
+  return false;
+}
+
 bool FileMapping::IsValid() const {
   return valid_;
 }
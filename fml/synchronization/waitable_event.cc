@@ -11,8 +11,227 @@
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 
+#if FML_WAITABLE_EVENT_USES_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <climits>
+#include <optional>
+#include <thread>
+#endif  // FML_WAITABLE_EVENT_USES_FUTEX
+
 namespace fml {
 
+#if FML_WAITABLE_EVENT_USES_FUTEX
+
+namespace {
+
+// How many times a waiter checks the event before going to sleep. Threads
+// handing work to each other are often signaled within a few microseconds,
+// which is less than what sleeping on the futex and being woken costs.
+constexpr size_t kSpinCount = 128u;
+
+// The states of an |AutoResetWaitableEvent|. A waiter that has slept leaves
+// |kUnsignaledWithWaiters| behind when it consumes a signal, since other
+// waiters may still be asleep.
+constexpr uint32_t kUnsignaled = 0u;
+constexpr uint32_t kSignaled = 1u;
+constexpr uint32_t kUnsignaledWithWaiters = 2u;
+
+// The state of a |ManualResetWaitableEvent| is a signaled bit and a
+// has-waiters bit, with the number of |Signal()| calls in the bits above.
+constexpr uint32_t kSignaledBit = 1u;
+constexpr uint32_t kWaitersBit = 2u;
+constexpr uint32_t kSignalIdMask = ~(kSignaledBit | kWaitersBit);
+constexpr uint32_t kSignalIdIncrement = 4u;
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  __asm__ __volatile__("yield");
+#endif
+}
+
+// Returns true as soon as |done()| does, or false once the spin phase is
+// over. There is no spin phase on single core devices, where the signaling
+// thread cannot run while the waiter spins.
+template <typename DoneFn>
+bool SpinUntil(DoneFn done) {
+  static const size_t spin_count =
+      std::thread::hardware_concurrency() > 1u ? kSpinCount : 0u;
+  for (size_t i = 0; i < spin_count; i++) {
+    if (done()) {
+      return true;
+    }
+    CpuRelax();
+  }
+  return false;
+}
+
+// Sleeps until |word| is woken, unless it no longer holds |expected|. May
+// return spuriously.
+void FutexWait(std::atomic<uint32_t>* word,
+               uint32_t expected,
+               std::optional<TimeDelta> timeout) {
+  struct timespec spec = {};
+  if (timeout.has_value()) {
+    const int64_t nanoseconds = timeout->ToNanoseconds();
+    spec.tv_sec = nanoseconds / 1000000000;
+    spec.tv_nsec = nanoseconds % 1000000000;
+  }
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT_PRIVATE,
+          expected, timeout.has_value() ? &spec : nullptr, nullptr, 0);
+}
+
+void FutexWake(std::atomic<uint32_t>* word, int count) {
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE_PRIVATE,
+          count, nullptr, nullptr, 0);
+}
+
+// Returns the time left until |deadline|, which is zero or negative once it
+// has passed, or |std::nullopt| to wait forever.
+std::optional<TimeDelta> TimeLeft(std::optional<TimePoint> deadline) {
+  if (!deadline.has_value()) {
+    return std::nullopt;
+  }
+  return deadline.value() - TimePoint::Now();
+}
+
+// Waits on an |AutoResetWaitableEvent| until it is signaled or |deadline|
+// passes. Returns true on timeout.
+bool AutoResetWait(std::atomic<uint32_t>* state,
+                   std::optional<TimePoint> deadline) {
+  auto consume = [state](uint32_t next) {
+    uint32_t expected = kSignaled;
+    return state->compare_exchange_strong(expected, next,
+                                          std::memory_order_acquire,
+                                          std::memory_order_relaxed);
+  };
+  if (SpinUntil([state, &consume]() {
+        return state->load(std::memory_order_relaxed) == kSignaled &&
+               consume(kUnsignaled);
+      })) {
+    return false;
+  }
+  while (true) {
+    uint32_t current = kSignaled;
+    if (state->compare_exchange_strong(current, kUnsignaledWithWaiters,
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+      return false;
+    }
+    if (current == kUnsignaled &&
+        !state->compare_exchange_strong(current, kUnsignaledWithWaiters,
+                                        std::memory_order_relaxed)) {
+      continue;
+    }
+    const auto time_left = TimeLeft(deadline);
+    if (time_left.has_value() && time_left.value() <= TimeDelta::Zero()) {
+      return true;
+    }
+    FutexWait(state, kUnsignaledWithWaiters, time_left);
+  }
+}
+
+// Waits on a |ManualResetWaitableEvent| until it is signaled or |deadline|
+// passes. Returns true on timeout.
+bool ManualResetWait(std::atomic<uint32_t>* state,
+                     std::optional<TimePoint> deadline) {
+  const uint32_t initial = state->load(std::memory_order_acquire);
+  auto signaled = [initial](uint32_t current) {
+    return (current & kSignaledBit) != 0u ||
+           (current & kSignalIdMask) != (initial & kSignalIdMask);
+  };
+  if (SpinUntil([state, &signaled]() {
+        return signaled(state->load(std::memory_order_acquire));
+      })) {
+    return false;
+  }
+  while (true) {
+    uint32_t current = state->load(std::memory_order_acquire);
+    if (signaled(current)) {
+      return false;
+    }
+    if ((current & kWaitersBit) == 0u &&
+        !state->compare_exchange_weak(current, current | kWaitersBit,
+                                      std::memory_order_relaxed)) {
+      continue;
+    }
+    const auto time_left = TimeLeft(deadline);
+    if (time_left.has_value() && time_left.value() <= TimeDelta::Zero()) {
+      return true;
+    }
+    FutexWait(state, current | kWaitersBit, time_left);
+  }
+}
+
+}  // namespace
+
+// AutoResetWaitableEvent ------------------------------------------------------
+
+void AutoResetWaitableEvent::Signal() {
+  if (state_.exchange(kSignaled, std::memory_order_release) ==
+      kUnsignaledWithWaiters) {
+    FutexWake(&state_, 1);
+  }
+}
+
+void AutoResetWaitableEvent::Reset() {
+  // A waiter that was woken by the signal marks the waiters it may have left
+  // behind again before sleeping.
+  uint32_t expected = kSignaled;
+  state_.compare_exchange_strong(expected, kUnsignaled,
+                                 std::memory_order_relaxed);
+}
+
+void AutoResetWaitableEvent::Wait() {
+  AutoResetWait(&state_, std::nullopt);
+}
+
+bool AutoResetWaitableEvent::WaitWithTimeout(TimeDelta timeout) {
+  return AutoResetWait(&state_, TimePoint::Now() + timeout);
+}
+
+bool AutoResetWaitableEvent::IsSignaledForTest() {
+  return state_.load(std::memory_order_acquire) == kSignaled;
+}
+
+// ManualResetWaitableEvent ----------------------------------------------------
+
+void ManualResetWaitableEvent::Signal() {
+  uint32_t current = state_.load(std::memory_order_relaxed);
+  while (!state_.compare_exchange_weak(
+      current, ((current & kSignalIdMask) + kSignalIdIncrement) | kSignaledBit,
+      std::memory_order_release, std::memory_order_relaxed)) {
+  }
+  if ((current & kWaitersBit) != 0u) {
+    FutexWake(&state_, INT_MAX);
+  }
+}
+
+void ManualResetWaitableEvent::Reset() {
+  state_.fetch_and(~kSignaledBit, std::memory_order_relaxed);
+}
+
+void ManualResetWaitableEvent::Wait() {
+  ManualResetWait(&state_, std::nullopt);
+}
+
+bool ManualResetWaitableEvent::WaitWithTimeout(TimeDelta timeout) {
+  return ManualResetWait(&state_, TimePoint::Now() + timeout);
+}
+
+bool ManualResetWaitableEvent::IsSignaledForTest() {
+  return (state_.load(std::memory_order_acquire) & kSignaledBit) != 0u;
+}
+
+#else  // FML_WAITABLE_EVENT_USES_FUTEX
+
 // Waits with a timeout on |condition()|. Returns true on timeout, or false if
 // |condition()| ever returns true. |condition()| should have no side effects
 // (and will always be called with |*mutex| held).
@@ -173,4 +392,6 @@ bool ManualResetWaitableEvent::IsSignaledForTest() {
   return signaled_;
 }
 
+#endif  // FML_WAITABLE_EVENT_USES_FUTEX
+
 }  // namespace fml
@@ -10,12 +10,24 @@
 #ifndef FLUTTER_FML_SYNCHRONIZATION_WAITABLE_EVENT_H_
 #define FLUTTER_FML_SYNCHRONIZATION_WAITABLE_EVENT_H_
 
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <mutex>
 
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_delta.h"
 
+// On Linux and Android, the events are a single atomic word the waiters spin
+// on briefly before sleeping on it with a futex. Elsewhere, they use a mutex
+// and a condition variable.
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+#define FML_WAITABLE_EVENT_USES_FUTEX 1
+#else
+#define FML_WAITABLE_EVENT_USES_FUTEX 0
+#endif
+
 namespace fml {
 
 // AutoResetWaitableEvent ------------------------------------------------------
@@ -62,11 +74,17 @@ class AutoResetWaitableEvent final {
   bool IsSignaledForTest();
 
  private:
+#if FML_WAITABLE_EVENT_USES_FUTEX
+  // Either |kUnsignaled|, |kSignaled| or |kUnsignaledWithWaiters|, see
+  // waitable_event.cc.
+  std::atomic<uint32_t> state_ = 0u;
+#else
   std::condition_variable cv_;
   std::mutex mutex_;
 
   // True if this event is in the signaled state.
   bool signaled_ = false;
+#endif  // FML_WAITABLE_EVENT_USES_FUTEX
 
   FML_DISALLOW_COPY_AND_ASSIGN(AutoResetWaitableEvent);
 };
@@ -104,6 +122,11 @@ class ManualResetWaitableEvent final {
   bool IsSignaledForTest();
 
  private:
+#if FML_WAITABLE_EVENT_USES_FUTEX
+  // The signaled and has-waiters bits, followed by a count of the |Signal()|
+  // calls that waiters use like |signal_id_| below, see waitable_event.cc.
+  std::atomic<uint32_t> state_ = 0u;
+#else
   std::condition_variable cv_;
   std::mutex mutex_;
 
@@ -118,6 +141,7 @@ class ManualResetWaitableEvent final {
   // |std::condition_variable::notify_all()|. A waiting thread knows it was
   // awoken if |signal_id_| is different from when it started waiting.
   unsigned signal_id_ = 0u;
+#endif  // FML_WAITABLE_EVENT_USES_FUTEX
 
   FML_DISALLOW_COPY_AND_ASSIGN(ManualResetWaitableEvent);
 };
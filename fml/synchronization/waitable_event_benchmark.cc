@@ -0,0 +1,61 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/synchronization/waitable_event.h"
+
+#include <thread>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+
+namespace fml {
+namespace benchmarking {
+
+// A round trip between two threads, like a synchronous task posted to the
+// raster thread.
+static void BM_AutoResetWaitableEventHandoff(benchmark::State& state) {
+  AutoResetWaitableEvent request;
+  AutoResetWaitableEvent response;
+  bool done = false;
+  std::thread thread([&]() {
+    while (true) {
+      request.Wait();
+      if (done) {
+        return;
+      }
+      response.Signal();
+    }
+  });
+  for (auto _ : state) {
+    request.Signal();
+    response.Wait();
+  }
+  done = true;
+  request.Signal();
+  thread.join();
+}
+
+// A thread waiting for several others to count down, like the shell waiting
+// for its threads during setup and teardown.
+static void BM_CountDownLatchHandoff(benchmark::State& state) {
+  const size_t thread_count = state.range(0);
+  for (auto _ : state) {
+    CountDownLatch latch(thread_count);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_count; i++) {
+      threads.emplace_back([&latch]() { latch.CountDown(); });
+    }
+    latch.Wait();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+}
+
+BENCHMARK(BM_AutoResetWaitableEventHandoff)->UseRealTime();
+BENCHMARK(BM_CountDownLatchHandoff)->Arg(1)->Arg(4)->UseRealTime();
+
+}  // namespace benchmarking
+}  // namespace fml
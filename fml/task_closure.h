@@ -0,0 +1,179 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TASK_CLOSURE_H_
+#define FLUTTER_FML_TASK_CLOSURE_H_
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      A move-only closure for tasks posted to task runners.
+///
+///             Callables of up to |kInlineCapacity| bytes are stored inline.
+///             That covers the common lambdas capturing a few shared or weak
+///             pointers, which don't fit the inline storage of
+///             |fml::closure| and would allocate once per posted task.
+///
+///             Any callable converts implicitly, including |fml::closure|.
+///             Move-only callables are accepted too since the closure is
+///             never copied.
+///
+class TaskClosure {
+ public:
+  static constexpr size_t kInlineCapacity = 8 * sizeof(void*);
+
+  TaskClosure() = default;
+
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  TaskClosure(std::nullptr_t) {}
+
+  template <typename Callable,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<Callable>, TaskClosure> &&
+                std::is_invocable_r_v<void, std::decay_t<Callable>&>>>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  TaskClosure(Callable&& callable) {
+    Emplace(std::forward<Callable>(callable));
+  }
+
+  TaskClosure(TaskClosure&& other) noexcept { MoveFrom(other); }
+
+  TaskClosure& operator=(TaskClosure&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  TaskClosure& operator=(std::nullptr_t) {
+    Reset();
+    return *this;
+  }
+
+  ~TaskClosure() { Reset(); }
+
+  explicit operator bool() const { return ops_ != nullptr; }
+
+  void operator()() const {
+    FML_DCHECK(ops_);
+    ops_->invoke(storage_);
+  }
+
+  /// Whether the callable is stored inline rather than on the heap.
+  bool IsInline() const { return ops_ && ops_->is_inline; }
+
+ private:
+  struct Ops {
+    void (*invoke)(void* storage);
+    // Moves the callable to |to| and destroys what is left in |from|.
+    void (*relocate)(void* from, void* to);
+    void (*destroy)(void* storage);
+    bool is_inline;
+  };
+
+  template <typename T>
+  static constexpr bool kFitsInline =
+      sizeof(T) <= kInlineCapacity &&
+      alignof(T) <= alignof(std::max_align_t) &&
+      std::is_nothrow_move_constructible_v<T>;
+
+  template <typename T>
+  struct InlineOps {
+    static void Invoke(void* storage) { (*static_cast<T*>(storage))(); }
+    static void Relocate(void* from, void* to) {
+      T* callable = static_cast<T*>(from);
+      new (to) T(std::move(*callable));
+      callable->~T();
+    }
+    static void Destroy(void* storage) { static_cast<T*>(storage)->~T(); }
+    static constexpr Ops kOps = {&Invoke, &Relocate, &Destroy, true};
+  };
+
+  template <typename T>
+  struct HeapOps {
+    static T*& Get(void* storage) { return *static_cast<T**>(storage); }
+    static void Invoke(void* storage) { (*Get(storage))(); }
+    static void Relocate(void* from, void* to) { Get(to) = Get(from); }
+    static void Destroy(void* storage) { delete Get(storage); }
+    static constexpr Ops kOps = {&Invoke, &Relocate, &Destroy, false};
+  };
+
+  template <typename T>
+  struct IsFunction : std::false_type {};
+
+  template <typename Signature>
+  struct IsFunction<std::function<Signature>> : std::true_type {};
+
+  template <typename T>
+  static bool IsNull(const T& callable) {
+    if constexpr (std::is_pointer_v<T> || std::is_member_pointer_v<T>) {
+      return callable == nullptr;
+    } else if constexpr (IsFunction<T>::value) {
+      return !callable;
+    } else {
+      return false;
+    }
+  }
+
+  template <typename Callable>
+  void Emplace(Callable&& callable) {
+    using T = std::decay_t<Callable>;
+    if (IsNull<T>(callable)) {
+      return;
+    }
+    if constexpr (kFitsInline<T>) {
+      new (storage_) T(std::forward<Callable>(callable));
+      ops_ = &InlineOps<T>::kOps;
+    } else {
+      HeapOps<T>::Get(storage_) = new T(std::forward<Callable>(callable));
+      ops_ = &HeapOps<T>::kOps;
+    }
+  }
+
+  void MoveFrom(TaskClosure& other) {
+    if (other.ops_) {
+      other.ops_->relocate(other.storage_, storage_);
+      ops_ = other.ops_;
+      other.ops_ = nullptr;
+    }
+  }
+
+  void Reset() {
+    if (ops_) {
+      // Clear first in case the destructor of the callable looks at this.
+      const Ops* ops = ops_;
+      ops_ = nullptr;
+      ops->destroy(storage_);
+    }
+  }
+
+  // Calls are const like the ones of |fml::closure| even though the stored
+  // callable may be mutable.
+  alignas(std::max_align_t) mutable unsigned char storage_[kInlineCapacity];
+  const Ops* ops_ = nullptr;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TaskClosure);
+};
+
+inline bool operator==(const TaskClosure& closure, std::nullptr_t) {
+  return !closure;
+}
+
+inline bool operator!=(const TaskClosure& closure, std::nullptr_t) {
+  return static_cast<bool>(closure);
+}
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TASK_CLOSURE_H_
@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/task_closure.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/closure.h"
+#include "flutter/fml/message_loop_task_queues.h"
+
+namespace {
+
+std::atomic<size_t> gAllocationCount = 0;
+
+}  // namespace
+
+// Counts every allocation made by the benchmarks in this executable.
+void* operator new(size_t size) {
+  gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+  void* result = std::malloc(size == 0 ? 1 : size);
+  if (!result) {
+    // Exceptions are disabled.
+    std::abort();
+  }
+  return result;
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+  std::free(pointer);
+}
+
+namespace fml {
+namespace benchmarking {
+
+namespace {
+
+// The captures of a typical posted task, a couple of strong and weak
+// pointers and a value.
+struct TaskCaptures {
+  std::shared_ptr<int> strong = std::make_shared<int>(0);
+  std::weak_ptr<int> weak = strong;
+  int value = 1;
+};
+
+template <typename Closure>
+void PostAndRunTasks(benchmark::State& state) {
+  auto task_queues = MessageLoopTaskQueues::GetInstance();
+  const TaskQueueId queue = task_queues->CreateTaskQueue();
+  const TaskCaptures captures;
+  constexpr size_t kTaskCount = 100u;
+  size_t allocations = 0;
+  size_t tasks = 0;
+  for (auto _ : state) {
+    const fml::TimePoint now = fml::TimePoint::Now();
+    const size_t start = gAllocationCount.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < kTaskCount; i++) {
+      Closure task = [strong = captures.strong, weak = captures.weak,
+                      value = captures.value]() {
+        benchmark::DoNotOptimize(*strong + value + weak.use_count());
+      };
+      task_queues->RegisterTask(queue, std::move(task), now);
+    }
+    while (auto task = task_queues->GetNextTaskToRun(queue, now)) {
+      task();
+    }
+    allocations += gAllocationCount.load(std::memory_order_relaxed) - start;
+    tasks += kTaskCount;
+  }
+  task_queues->Dispose(queue);
+  state.counters["AllocationsPerTask"] =
+      static_cast<double>(allocations) / static_cast<double>(tasks);
+}
+
+}  // namespace
+
+// Tasks that are wrapped in an |fml::closure| before being posted, which
+// allocates once their captures outgrow its inline storage.
+static void BM_PostTasksFromFunctions(benchmark::State& state) {  // NOLINT
+  PostAndRunTasks<fml::closure>(state);
+}
+
+// Lambdas that are posted as they are and stored inline.
+static void BM_PostTasksFromLambdas(benchmark::State& state) {  // NOLINT
+  PostAndRunTasks<fml::TaskClosure>(state);
+}
+
+BENCHMARK(BM_PostTasksFromFunctions);
+BENCHMARK(BM_PostTasksFromLambdas);
+
+}  // namespace benchmarking
+}  // namespace fml
@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/task_closure.h"
+
+#include <array>
+#include <memory>
+
+#include "flutter/fml/closure.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(TaskClosureTest, EmptyByDefault) {
+  TaskClosure closure;
+  EXPECT_FALSE(closure);
+  EXPECT_TRUE(closure == nullptr);
+
+  TaskClosure null_closure = nullptr;
+  EXPECT_FALSE(null_closure);
+}
+
+TEST(TaskClosureTest, EmptyFromEmptyFunctions) {
+  fml::closure empty_function;
+  TaskClosure from_function = empty_function;
+  EXPECT_FALSE(from_function);
+
+  void (*empty_pointer)() = nullptr;
+  TaskClosure from_pointer = empty_pointer;
+  EXPECT_FALSE(from_pointer);
+}
+
+TEST(TaskClosureTest, StoresSmallCapturesInline) {
+  auto shared = std::make_shared<int>(0);
+  std::weak_ptr<int> weak = shared;
+  int calls = 0;
+  TaskClosure closure = [shared, weak, &calls]() { calls++; };
+  EXPECT_TRUE(closure.IsInline());
+  closure();
+  closure();
+  EXPECT_EQ(calls, 2);
+}
+
+TEST(TaskClosureTest, StoresLargeCapturesOnTheHeap) {
+  std::array<char, TaskClosure::kInlineCapacity + 1> big = {};
+  int calls = 0;
+  TaskClosure closure = [big, &calls]() { calls += big.size(); };
+  EXPECT_TRUE(closure);
+  EXPECT_FALSE(closure.IsInline());
+  closure();
+  EXPECT_EQ(calls, static_cast<int>(big.size()));
+}
+
+TEST(TaskClosureTest, AcceptsMoveOnlyCallables) {
+  auto value = std::make_unique<int>(42);
+  int result = 0;
+  TaskClosure closure = [value = std::move(value), &result]() {
+    result = *value;
+  };
+  closure();
+  EXPECT_EQ(result, 42);
+}
+
+TEST(TaskClosureTest, MovingTransfersTheCallable) {
+  for (size_t padding : {0u, 1u}) {
+    auto shared = std::make_shared<int>(0);
+    TaskClosure closure;
+    if (padding == 0u) {
+      closure = [shared]() { (*shared)++; };
+    } else {
+      std::array<char, TaskClosure::kInlineCapacity> big = {};
+      closure = [shared, big]() { (*shared) += 1 + big[0]; };
+    }
+    EXPECT_EQ(shared.use_count(), 2);
+
+    TaskClosure moved = std::move(closure);
+    EXPECT_FALSE(closure);  // NOLINT(bugprone-use-after-move)
+    ASSERT_TRUE(moved);
+    moved();
+    EXPECT_EQ(*shared, 1);
+    EXPECT_EQ(shared.use_count(), 2);
+
+    TaskClosure assigned;
+    assigned = std::move(moved);
+    assigned();
+    EXPECT_EQ(*shared, 2);
+    EXPECT_EQ(shared.use_count(), 2);
+
+    assigned = nullptr;
+    EXPECT_FALSE(assigned);
+    EXPECT_EQ(shared.use_count(), 1);
+  }
+}
+
+TEST(TaskClosureTest, DestroysTheCallable) {
+  auto shared = std::make_shared<int>(0);
+  {
+    TaskClosure closure = [shared]() {};
+    EXPECT_EQ(shared.use_count(), 2);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+}  // namespace testing
+}  // namespace fml
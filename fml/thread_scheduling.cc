@@ -0,0 +1,321 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/thread_scheduling.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <sstream>
+#include <vector>
+
+#include "flutter/fml/build_config.h"
+
+#if defined(FML_OS_WIN)
+#include <windows.h>
+
+#include <avrt.h>
+
+#include "flutter/fml/platform/win/wstring_conversion.h"
+#elif !defined(OS_FUCHSIA)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(FML_OS_MACOSX)
+#include <pthread/qos.h>
+#endif
+
+#if defined(FML_OS_WIN) || defined(OS_FUCHSIA)
+#define FML_HAS_SCHED_FIFO 0
+#else
+#define FML_HAS_SCHED_FIFO 1
+#endif
+
+namespace fml {
+
+namespace {
+
+std::vector<std::string_view> SplitPairs(std::string_view description) {
+  std::vector<std::string_view> pairs;
+  if (description.empty()) {
+    return pairs;
+  }
+  while (true) {
+    const size_t comma = description.find(',');
+    pairs.push_back(description.substr(0, comma));
+    if (comma == std::string_view::npos) {
+      return pairs;
+    }
+    description.remove_prefix(comma + 1);
+  }
+}
+
+std::optional<int64_t> ParseInteger(std::string_view value, int base) {
+  if (value.empty()) {
+    return std::nullopt;
+  }
+  const std::string string(value);
+  char* end = nullptr;
+  const long long result = std::strtoll(string.c_str(), &end, base);
+  if (end != string.c_str() + string.size()) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+std::optional<int> ParseIntegerInRange(std::string_view value,
+                                       int min,
+                                       int max) {
+  auto result = ParseInteger(value, 10);
+  if (!result.has_value() || result.value() < min || result.value() > max) {
+    return std::nullopt;
+  }
+  return static_cast<int>(result.value());
+}
+
+std::optional<CpuAffinity> ParseAffinity(std::string_view value) {
+  if (value == "performance") {
+    return CpuAffinity::kPerformance;
+  }
+  if (value == "efficiency") {
+    return CpuAffinity::kEfficiency;
+  }
+  if (value == "not-performance") {
+    return CpuAffinity::kNotPerformance;
+  }
+  return std::nullopt;
+}
+
+std::optional<ThreadQoSClass> ParseQoSClass(std::string_view value) {
+  if (value == "user-interactive") {
+    return ThreadQoSClass::kUserInteractive;
+  }
+  if (value == "user-initiated") {
+    return ThreadQoSClass::kUserInitiated;
+  }
+  if (value == "default") {
+    return ThreadQoSClass::kDefault;
+  }
+  if (value == "utility") {
+    return ThreadQoSClass::kUtility;
+  }
+  if (value == "background") {
+    return ThreadQoSClass::kBackground;
+  }
+  return std::nullopt;
+}
+
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+pid_t CurrentThreadId() {
+  return static_cast<pid_t>(syscall(SYS_gettid));
+}
+#endif
+
+#if defined(FML_OS_MACOSX)
+qos_class_t ToQoSClass(ThreadQoSClass qos_class) {
+  switch (qos_class) {
+    case ThreadQoSClass::kUserInteractive:
+      return QOS_CLASS_USER_INTERACTIVE;
+    case ThreadQoSClass::kUserInitiated:
+      return QOS_CLASS_USER_INITIATED;
+    case ThreadQoSClass::kDefault:
+      return QOS_CLASS_DEFAULT;
+    case ThreadQoSClass::kUtility:
+      return QOS_CLASS_UTILITY;
+    case ThreadQoSClass::kBackground:
+      return QOS_CLASS_BACKGROUND;
+  }
+  return QOS_CLASS_DEFAULT;
+}
+
+const char* QoSClassName(qos_class_t qos_class) {
+  switch (qos_class) {
+    case QOS_CLASS_USER_INTERACTIVE:
+      return "user-interactive";
+    case QOS_CLASS_USER_INITIATED:
+      return "user-initiated";
+    case QOS_CLASS_DEFAULT:
+      return "default";
+    case QOS_CLASS_UTILITY:
+      return "utility";
+    case QOS_CLASS_BACKGROUND:
+      return "background";
+    default:
+      return "unspecified";
+  }
+}
+#endif  // defined(FML_OS_MACOSX)
+
+}  // namespace
+
+bool ThreadSchedulingPolicy::IsEmpty() const {
+  return !affinity.has_value() && !cpu_mask.has_value() && !nice.has_value() &&
+         !realtime_priority.has_value() && !qos_class.has_value() &&
+         !mmcss_task.has_value();
+}
+
+std::optional<ThreadSchedulingPolicy> ParseThreadSchedulingPolicy(
+    std::string_view description) {
+  ThreadSchedulingPolicy policy;
+  for (const auto pair : SplitPairs(description)) {
+    const size_t equals = pair.find('=');
+    if (equals == std::string_view::npos) {
+      return std::nullopt;
+    }
+    const std::string_view key = pair.substr(0, equals);
+    const std::string_view value = pair.substr(equals + 1);
+    if (key == "affinity") {
+      policy.affinity = ParseAffinity(value);
+      if (!policy.affinity.has_value()) {
+        return std::nullopt;
+      }
+    } else if (key == "cpus") {
+      auto mask = ParseInteger(value, 16);
+      if (!mask.has_value() || mask.value() <= 0) {
+        return std::nullopt;
+      }
+      policy.cpu_mask = static_cast<uint64_t>(mask.value());
+    } else if (key == "nice") {
+      policy.nice = ParseIntegerInRange(value, -20, 19);
+      if (!policy.nice.has_value()) {
+        return std::nullopt;
+      }
+    } else if (key == "fifo") {
+      policy.realtime_priority = ParseIntegerInRange(value, 1, 99);
+      if (!policy.realtime_priority.has_value()) {
+        return std::nullopt;
+      }
+    } else if (key == "qos") {
+      policy.qos_class = ParseQoSClass(value);
+      if (!policy.qos_class.has_value()) {
+        return std::nullopt;
+      }
+    } else if (key == "mmcss") {
+      if (value.empty()) {
+        return std::nullopt;
+      }
+      policy.mmcss_task = std::string(value);
+    } else {
+      return std::nullopt;
+    }
+  }
+  return policy;
+}
+
+bool ApplyThreadSchedulingPolicy(const ThreadSchedulingPolicy& policy) {
+  bool success = true;
+
+  if (policy.affinity.has_value()) {
+    success &= RequestAffinity(policy.affinity.value());
+  }
+
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+  if (policy.cpu_mask.has_value()) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (size_t cpu = 0; cpu < 64u; cpu++) {
+      if (policy.cpu_mask.value() & (uint64_t{1} << cpu)) {
+        CPU_SET(cpu, &set);
+      }
+    }
+    success &= sched_setaffinity(0, sizeof(set), &set) == 0;
+  }
+
+  if (policy.nice.has_value()) {
+    // Linux applies nice values to individual threads.
+    success &=
+        setpriority(PRIO_PROCESS, CurrentThreadId(), policy.nice.value()) == 0;
+  }
+#endif  // defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+
+#if defined(FML_OS_MACOSX)
+  // Darwin rejects QoS changes for threads that no longer use the default
+  // scheduling policy, so the QoS class is applied before SCHED_FIFO.
+  if (policy.qos_class.has_value()) {
+    success &=
+        pthread_set_qos_class_self_np(ToQoSClass(policy.qos_class.value()),
+                                      0) == 0;
+  }
+#endif  // defined(FML_OS_MACOSX)
+
+#if FML_HAS_SCHED_FIFO
+  if (policy.realtime_priority.has_value()) {
+    struct sched_param param = {};
+    param.sched_priority = policy.realtime_priority.value();
+    success &= pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+  }
+#endif  // FML_HAS_SCHED_FIFO
+
+#if defined(FML_OS_WIN)
+  if (policy.mmcss_task.has_value()) {
+    // The thread stays registered with MMCSS until it exits.
+    DWORD task_index = 0;
+    success &= AvSetMmThreadCharacteristicsW(
+                   Utf8ToWideString(policy.mmcss_task.value()).c_str(),
+                   &task_index) != nullptr;
+  }
+#endif  // defined(FML_OS_WIN)
+
+  return success;
+}
+
+std::string DescribeCurrentThreadScheduling() {
+  std::stringstream stream;
+
+#if FML_HAS_SCHED_FIFO
+  int sched_policy = 0;
+  struct sched_param param = {};
+  if (pthread_getschedparam(pthread_self(), &sched_policy, &param) == 0) {
+    switch (sched_policy) {
+      case SCHED_FIFO:
+        stream << "policy=fifo(" << param.sched_priority << ")";
+        break;
+      case SCHED_RR:
+        stream << "policy=rr(" << param.sched_priority << ")";
+        break;
+      default:
+        stream << "policy=other";
+        break;
+    }
+  }
+#endif  // FML_HAS_SCHED_FIFO
+
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+  errno = 0;
+  const int nice = getpriority(PRIO_PROCESS, CurrentThreadId());
+  if (errno == 0) {
+    stream << " nice=" << nice;
+  }
+
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    uint64_t mask = 0;
+    for (size_t cpu = 0; cpu < 64u; cpu++) {
+      if (CPU_ISSET(cpu, &set)) {
+        mask |= uint64_t{1} << cpu;
+      }
+    }
+    stream << " cpus=0x" << std::hex << mask << std::dec;
+  }
+#endif  // defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+
+#if defined(FML_OS_MACOSX)
+  stream << " qos=" << QoSClassName(qos_class_self());
+#endif  // defined(FML_OS_MACOSX)
+
+#if defined(FML_OS_WIN)
+  stream << "priority=" << GetThreadPriority(GetCurrentThread());
+#endif  // defined(FML_OS_WIN)
+
+  return stream.str();
+}
+
+}  // namespace fml
@@ -0,0 +1,82 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_THREAD_SCHEDULING_H_
+#define FLUTTER_FML_THREAD_SCHEDULING_H_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "flutter/fml/cpu_affinity.h"
+
+namespace fml {
+
+/// The quality of service classes of Darwin threads, from the most to the
+/// least important.
+enum class ThreadQoSClass {
+  kUserInteractive,
+  kUserInitiated,
+  kDefault,
+  kUtility,
+  kBackground,
+};
+
+/// OS scheduling settings requested for a thread. Settings that are not set
+/// are left as they are, and settings the platform does not support are
+/// ignored.
+struct ThreadSchedulingPolicy {
+  /// Restricts the thread to the cores with the given affinity. Only
+  /// supported on Android.
+  std::optional<CpuAffinity> affinity;
+
+  /// Restricts the thread to the CPUs whose bits are set. Supported on Linux
+  /// and Android, and applied after |affinity|.
+  std::optional<uint64_t> cpu_mask;
+
+  /// The nice value of the thread, from -20 to 19. Supported on Linux and
+  /// Android.
+  std::optional<int> nice;
+
+  /// Schedules the thread with SCHED_FIFO at the given priority, from 1 to
+  /// 99. Supported on POSIX platforms and usually requires privileges.
+  std::optional<int> realtime_priority;
+
+  /// The quality of service class of the thread. Only supported on Darwin.
+  std::optional<ThreadQoSClass> qos_class;
+
+  /// The name of the MMCSS task the thread joins (ex "Games" or
+  /// "Pro Audio"). Only supported on Windows.
+  std::optional<std::string> mmcss_task;
+
+  /// Whether the policy leaves the thread as it is.
+  bool IsEmpty() const;
+};
+
+/// @brief Parses a policy from comma separated `key=value` pairs, for
+///        example "affinity=performance,nice=-10". The keys are `affinity`
+///        (`performance`, `efficiency` or `not-performance`), `cpus` (a hex
+///        CPU mask like `0xf0`), `nice`, `fifo` (the SCHED_FIFO priority),
+///        `qos` (`user-interactive`, `user-initiated`, `default`, `utility`
+///        or `background`) and `mmcss` (the MMCSS task name).
+///
+///        Returns `std::nullopt` if any pair is malformed or out of range.
+std::optional<ThreadSchedulingPolicy> ParseThreadSchedulingPolicy(
+    std::string_view description);
+
+/// @brief Applies the policy to the current thread.
+///
+///        Returns true if every setting the platform supports was applied.
+///        Settings are applied independently, so a failure to apply one does
+///        not prevent the others from taking effect.
+bool ApplyThreadSchedulingPolicy(const ThreadSchedulingPolicy& policy);
+
+/// @brief Describes the effective scheduling settings of the current thread
+///        as reported by the OS, for diagnostic logging.
+std::string DescribeCurrentThreadScheduling();
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_THREAD_SCHEDULING_H_
@@ -0,0 +1,73 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/thread_scheduling.h"
+
+#include <thread>
+
+#include "flutter/fml/build_config.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(ThreadSchedulingTest, ParsesEmptyPolicy) {
+  auto policy = ParseThreadSchedulingPolicy("");
+  ASSERT_TRUE(policy.has_value());
+  EXPECT_TRUE(policy->IsEmpty());
+}
+
+TEST(ThreadSchedulingTest, ParsesEverySetting) {
+  auto policy = ParseThreadSchedulingPolicy(
+      "affinity=performance,cpus=0xf0,nice=-10,fifo=2,qos=user-interactive,"
+      "mmcss=Pro Audio");
+  ASSERT_TRUE(policy.has_value());
+  EXPECT_EQ(policy->affinity, CpuAffinity::kPerformance);
+  EXPECT_EQ(policy->cpu_mask, 0xf0u);
+  EXPECT_EQ(policy->nice, -10);
+  EXPECT_EQ(policy->realtime_priority, 2);
+  EXPECT_EQ(policy->qos_class, ThreadQoSClass::kUserInteractive);
+  EXPECT_EQ(policy->mmcss_task, "Pro Audio");
+  EXPECT_FALSE(policy->IsEmpty());
+}
+
+TEST(ThreadSchedulingTest, RejectsMalformedPolicies) {
+  EXPECT_FALSE(ParseThreadSchedulingPolicy("nice").has_value());
+  EXPECT_FALSE(ParseThreadSchedulingPolicy("nice=").has_value());
+  EXPECT_FALSE(ParseThreadSchedulingPolicy("nice=-21").has_value());
+  EXPECT_FALSE(ParseThreadSchedulingPolicy("nice=high").has_value());
+  EXPECT_FALSE(ParseThreadSchedulingPolicy("fifo=0").has_value());
+  EXPECT_FALSE(ParseThreadSchedulingPolicy("fifo=100").has_value());
+  EXPECT_FALSE(ParseThreadSchedulingPolicy("cpus=0").has_value());
+  EXPECT_FALSE(ParseThreadSchedulingPolicy("cpus=0xfg").has_value());
+  EXPECT_FALSE(ParseThreadSchedulingPolicy("affinity=fast").has_value());
+  EXPECT_FALSE(ParseThreadSchedulingPolicy("qos=urgent").has_value());
+  EXPECT_FALSE(ParseThreadSchedulingPolicy("mmcss=").has_value());
+  EXPECT_FALSE(ParseThreadSchedulingPolicy("priority=1").has_value());
+  EXPECT_FALSE(ParseThreadSchedulingPolicy("nice=1,").has_value());
+}
+
+TEST(ThreadSchedulingTest, AppliesEmptyPolicy) {
+  EXPECT_TRUE(ApplyThreadSchedulingPolicy({}));
+}
+
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+TEST(ThreadSchedulingTest, AppliesNiceValueToCurrentThreadOnly) {
+  ThreadSchedulingPolicy policy;
+  // Lowering the priority of a thread does not require privileges.
+  policy.nice = 19;
+  std::string description;
+  std::thread thread([&]() {
+    EXPECT_TRUE(ApplyThreadSchedulingPolicy(policy));
+    description = DescribeCurrentThreadScheduling();
+  });
+  thread.join();
+  EXPECT_NE(description.find("nice=19"), std::string::npos);
+  EXPECT_EQ(DescribeCurrentThreadScheduling().find("nice=19"),
+            std::string::npos);
+}
+#endif  // defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+
+}  // namespace testing
+}  // namespace fml
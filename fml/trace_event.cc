@@ -126,6 +126,7 @@ void TraceEvent0(TraceArg category_group,
                  TraceArg name,
                  size_t flow_id_count,
                  const uint64_t* flow_ids) {
+  RecordToRingBuffer(TraceRingEventType::kDurationBegin, name);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,              // timestamp1_or_async_id
@@ -144,6 +145,7 @@ void TraceEvent1(TraceArg category_group,
                  const uint64_t* flow_ids,
                  TraceArg arg1_name,
                  TraceArg arg1_val) {
+  RecordToRingBuffer(TraceRingEventType::kDurationBegin, name);
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
   FlutterTimelineEvent(name,                            // label
@@ -166,6 +168,7 @@ void TraceEvent2(TraceArg category_group,
                  TraceArg arg1_val,
                  TraceArg arg2_name,
                  TraceArg arg2_val) {
+  RecordToRingBuffer(TraceRingEventType::kDurationBegin, name);
   const char* arg_names[] = {arg1_name, arg2_name};
   const char* arg_values[] = {arg1_val, arg2_val};
   FlutterTimelineEvent(name,                            // label
@@ -181,6 +184,7 @@ void TraceEvent2(TraceArg category_group,
 }
 
 void TraceEventEnd(TraceArg name) {
+  RecordToRingBuffer(TraceRingEventType::kDurationEnd, name);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,                        // timestamp1_or_async_id
@@ -269,6 +273,7 @@ void TraceEventInstant0(TraceArg category_group,
                         TraceArg name,
                         size_t flow_id_count,
                         const uint64_t* flow_ids) {
+  RecordToRingBuffer(TraceRingEventType::kInstant, name);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,              // timestamp1_or_async_id
@@ -287,6 +292,7 @@ void TraceEventInstant1(TraceArg category_group,
                         const uint64_t* flow_ids,
                         TraceArg arg1_name,
                         TraceArg arg1_val) {
+  RecordToRingBuffer(TraceRingEventType::kInstant, name);
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
   FlutterTimelineEvent(name,                            // label
@@ -309,6 +315,7 @@ void TraceEventInstant2(TraceArg category_group,
                         TraceArg arg1_val,
                         TraceArg arg2_name,
                         TraceArg arg2_val) {
+  RecordToRingBuffer(TraceRingEventType::kInstant, name);
   const char* arg_names[] = {arg1_name, arg2_name};
   const char* arg_values[] = {arg1_val, arg2_val};
   FlutterTimelineEvent(name,                            // label
@@ -326,6 +333,7 @@ void TraceEventInstant2(TraceArg category_group,
 void TraceEventFlowBegin0(TraceArg category_group,
                           TraceArg name,
                           TraceIDArg id) {
+  RecordToRingBuffer(TraceRingEventType::kFlowBegin, name, id);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        id,       // timestamp1_or_async_id
@@ -341,6 +349,7 @@ void TraceEventFlowBegin0(TraceArg category_group,
 void TraceEventFlowStep0(TraceArg category_group,
                          TraceArg name,
                          TraceIDArg id) {
+  RecordToRingBuffer(TraceRingEventType::kFlowStep, name, id);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        id,                             // timestamp1_or_async_id
@@ -354,6 +363,7 @@ void TraceEventFlowStep0(TraceArg category_group,
 }
 
 void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id) {
+  RecordToRingBuffer(TraceRingEventType::kFlowEnd, name, id);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        id,                            // timestamp1_or_async_id
@@ -408,14 +418,18 @@ void TraceTimelineEvent(TraceArg category_group,
 void TraceEvent0(TraceArg category_group,
                  TraceArg name,
                  size_t flow_id_count,
-                 const uint64_t* flow_ids) {}
+                 const uint64_t* flow_ids) {
+  RecordToRingBuffer(TraceRingEventType::kDurationBegin, name);
+}
 
 void TraceEvent1(TraceArg category_group,
                  TraceArg name,
                  size_t flow_id_count,
                  const uint64_t* flow_ids,
                  TraceArg arg1_name,
-                 TraceArg arg1_val) {}
+                 TraceArg arg1_val) {
+  RecordToRingBuffer(TraceRingEventType::kDurationBegin, name);
+}
 
 void TraceEvent2(TraceArg category_group,
                  TraceArg name,
@@ -424,9 +438,13 @@ void TraceEvent2(TraceArg category_group,
                  TraceArg arg1_name,
                  TraceArg arg1_val,
                  TraceArg arg2_name,
-                 TraceArg arg2_val) {}
+                 TraceArg arg2_val) {
+  RecordToRingBuffer(TraceRingEventType::kDurationBegin, name);
+}
 
-void TraceEventEnd(TraceArg name) {}
+void TraceEventEnd(TraceArg name) {
+  RecordToRingBuffer(TraceRingEventType::kDurationEnd, name);
+}
 
 void TraceEventAsyncComplete(TraceArg category_group,
                              TraceArg name,
@@ -460,14 +478,18 @@ void TraceEventAsyncEnd1(TraceArg category_group,
 void TraceEventInstant0(TraceArg category_group,
                         TraceArg name,
                         size_t flow_id_count,
-                        const uint64_t* flow_ids) {}
+                        const uint64_t* flow_ids) {
+  RecordToRingBuffer(TraceRingEventType::kInstant, name);
+}
 
 void TraceEventInstant1(TraceArg category_group,
                         TraceArg name,
                         size_t flow_id_count,
                         const uint64_t* flow_ids,
                         TraceArg arg1_name,
-                        TraceArg arg1_val) {}
+                        TraceArg arg1_val) {
+  RecordToRingBuffer(TraceRingEventType::kInstant, name);
+}
 
 void TraceEventInstant2(TraceArg category_group,
                         TraceArg name,
@@ -476,17 +498,24 @@ void TraceEventInstant2(TraceArg category_group,
                         TraceArg arg1_name,
                         TraceArg arg1_val,
                         TraceArg arg2_name,
-                        TraceArg arg2_val) {}
+                        TraceArg arg2_val) {
+  RecordToRingBuffer(TraceRingEventType::kInstant, name);
+}
 
 void TraceEventFlowBegin0(TraceArg category_group,
                           TraceArg name,
-                          TraceIDArg id) {}
+                          TraceIDArg id) {
+  RecordToRingBuffer(TraceRingEventType::kFlowBegin, name, id);
+}
 
 void TraceEventFlowStep0(TraceArg category_group,
                          TraceArg name,
-                         TraceIDArg id) {}
+                         TraceIDArg id) {
+  RecordToRingBuffer(TraceRingEventType::kFlowStep, name, id);
+}
 
 void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id) {
+  RecordToRingBuffer(TraceRingEventType::kFlowEnd, name, id);
 }
 
 #endif  // FLUTTER_TIMELINE_ENABLED
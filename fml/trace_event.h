@@ -61,6 +61,7 @@
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_ring_buffer.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 
 #if (FLUTTER_RELEASE && !defined(OS_FUCHSIA) && !defined(FML_OS_ANDROID))
@@ -300,11 +301,35 @@ SplitArguments(Key key, Value value, Args... args) {
 
 size_t TraceNonce();
 
+// Events are recorded to the trace ring buffer even when the timeline is
+// disabled.
+inline void RecordToRingBuffer(TraceRingEventType type,
+                               TraceArg name,
+                               int64_t value = 0) {
+  if (TraceRingBufferIsEnabled()) {
+    TraceRingBufferRecord(type, name, value);
+  }
+}
+
+inline void RecordCounterValuesToRingBuffer() {}
+
+template <typename Key, typename Value, typename... Args>
+void RecordCounterValuesToRingBuffer(Key key, Value value, Args... args) {
+  if constexpr (std::is_arithmetic<Value>::value) {
+    TraceRingBufferRecordCounterValue(key, static_cast<double>(value));
+  }
+  RecordCounterValuesToRingBuffer(args...);
+}
+
 template <typename... Args>
 void TraceCounter(TraceArg category,
                   TraceArg name,
                   TraceIDArg identifier,
                   Args... args) {
+  if (TraceRingBufferIsEnabled()) {
+    TraceRingBufferRecord(TraceRingEventType::kCounter, name, identifier);
+    RecordCounterValuesToRingBuffer(args...);
+  }
 #if FLUTTER_TIMELINE_ENABLED
   auto split = SplitArguments(args...);
   TraceTimelineEvent(category, name, identifier, /*flow_id_count=*/0,
@@ -327,6 +352,7 @@ void TraceEvent(TraceArg category,
                 size_t flow_id_count,
                 const uint64_t* flow_ids,
                 Args... args) {
+  RecordToRingBuffer(TraceRingEventType::kDurationBegin, name);
 #if FLUTTER_TIMELINE_ENABLED
   auto split = SplitArguments(args...);
   TraceTimelineEvent(category, name, 0, flow_id_count, flow_ids,
@@ -0,0 +1,401 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_ring_buffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/thread_local.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace fml {
+namespace tracing {
+
+namespace internal {
+std::atomic<bool> gTraceRingBufferEnabled = false;
+}  // namespace internal
+
+namespace {
+
+// The type of an event is packed into the top byte of its timestamp, which
+// leaves room for more than two years of nanoseconds.
+constexpr int kTypeShift = 56;
+constexpr uint64_t kTimestampMask = (uint64_t{1} << kTypeShift) - 1;
+
+// Every word of a slot is an atomic so that snapshots may read slots while
+// they are being overwritten. The torn reads are detected and dropped.
+struct Slot {
+  std::atomic<uint64_t> header;
+  std::atomic<uintptr_t> name;
+  std::atomic<int64_t> value;
+};
+
+class ThreadRing {
+ public:
+  ThreadRing(int64_t id, size_t capacity)
+      : id_(id), capacity_(capacity), slots_(new Slot[capacity]()) {}
+
+  int64_t id() const { return id_; }
+
+  size_t capacity() const { return capacity_; }
+
+  // Only called by the thread that owns the ring.
+  void Record(TraceRingEventType type, const char* name, int64_t value) {
+    const uint64_t index = next_.load(std::memory_order_relaxed);
+    const uint64_t timestamp =
+        static_cast<uint64_t>(
+            TimePoint::Now().ToEpochDelta().ToNanoseconds()) &
+        kTimestampMask;
+    // Orders the claim of the slot before the stores that overwrite it. A
+    // snapshot that reads any of the new values is then guaranteed to see
+    // that the slot is being reused.
+    claimed_.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    Slot& slot = slots_[index & (capacity_ - 1)];
+    slot.header.store(
+        (static_cast<uint64_t>(type) << kTypeShift) | timestamp,
+        std::memory_order_relaxed);
+    slot.name.store(reinterpret_cast<uintptr_t>(name),
+                    std::memory_order_relaxed);
+    slot.value.store(value, std::memory_order_relaxed);
+    next_.store(index + 1, std::memory_order_release);
+  }
+
+  // The members below are guarded by the registry mutex.
+
+  bool in_use = false;
+  std::string name;
+
+  // Hands the ring of an exited thread to a new one. The events of the
+  // previous owner are not attributed to the new thread.
+  void Adopt() {
+    first_index_ = next_.load(std::memory_order_relaxed);
+    in_use = true;
+    name.clear();
+  }
+
+  std::vector<TraceRingEvent> Read() const {
+    const uint64_t end = next_.load(std::memory_order_acquire);
+    uint64_t begin = end > capacity_ ? end - capacity_ : 0;
+    begin = std::max(begin, first_index_);
+
+    std::vector<TraceRingEvent> events;
+    events.reserve(end - begin);
+    for (uint64_t index = begin; index < end; index++) {
+      const Slot& slot = slots_[index & (capacity_ - 1)];
+      const uint64_t header = slot.header.load(std::memory_order_relaxed);
+      events.push_back({
+          static_cast<TraceRingEventType>(header >> kTypeShift),
+          static_cast<int64_t>(header & kTimestampMask),
+          reinterpret_cast<const char*>(
+              slot.name.load(std::memory_order_relaxed)),
+          slot.value.load(std::memory_order_relaxed),
+      });
+    }
+
+    // The owner may have lapped the copy, in which case the slots it claimed
+    // in the meantime may be torn.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t claimed = claimed_.load(std::memory_order_relaxed);
+    if (claimed > capacity_) {
+      const uint64_t first_valid = claimed - capacity_;
+      if (first_valid > begin) {
+        const size_t dropped = std::min<uint64_t>(first_valid - begin,
+                                                  events.size());
+        events.erase(events.begin(), events.begin() + dropped);
+      }
+    }
+    return events;
+  }
+
+ private:
+  const int64_t id_;
+  const size_t capacity_;
+  std::unique_ptr<Slot[]> slots_;
+  // The number of slots the owner has started and finished writing.
+  std::atomic<uint64_t> claimed_ = 0;
+  std::atomic<uint64_t> next_ = 0;
+  uint64_t first_index_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadRing);
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadRing>> rings;
+  size_t capacity = 0;
+};
+
+// Leaked so that threads may still record while the process exits.
+Registry& GetRegistry() {
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+thread_local ThreadRing* tCurrentRing = nullptr;
+
+// Returns the ring of the current thread to the registry when the thread
+// exits.
+class RingLease {
+ public:
+  explicit RingLease(ThreadRing* ring) : ring_(ring) {}
+
+  ~RingLease() {
+    auto& registry = GetRegistry();
+    std::scoped_lock lock(registry.mutex);
+    ring_->in_use = false;
+    tCurrentRing = nullptr;
+  }
+
+ private:
+  ThreadRing* ring_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RingLease);
+};
+
+FML_THREAD_LOCAL ThreadLocalUniquePtr<RingLease> tRingLease;
+
+ThreadRing* AcquireCurrentThreadRing() {
+  auto& registry = GetRegistry();
+  ThreadRing* ring = nullptr;
+  {
+    std::scoped_lock lock(registry.mutex);
+    if (registry.capacity == 0) {
+      return nullptr;
+    }
+    for (const auto& candidate : registry.rings) {
+      if (!candidate->in_use && candidate->capacity() == registry.capacity) {
+        ring = candidate.get();
+        break;
+      }
+    }
+    if (ring == nullptr) {
+      registry.rings.push_back(std::make_unique<ThreadRing>(
+          registry.rings.size() + 1, registry.capacity));
+      ring = registry.rings.back().get();
+    }
+    ring->Adopt();
+  }
+  tCurrentRing = ring;
+  tRingLease.reset(new RingLease(ring));
+  return ring;
+}
+
+size_t RoundUpToPowerOfTwo(size_t value) {
+  size_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+void WriteJSONString(std::ostream& stream, const char* string) {
+  stream << '"';
+  for (const char* c = string; *c != '\0'; c++) {
+    switch (*c) {
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\\':
+        stream << "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(*c) < 0x20) {
+          stream << ' ';
+        } else {
+          stream << *c;
+        }
+        break;
+    }
+  }
+  stream << '"';
+}
+
+void WriteMicros(std::ostream& stream, int64_t nanos) {
+  const int64_t remainder = nanos % 1000;
+  stream << nanos / 1000 << '.' << (remainder < 100 ? "0" : "")
+         << (remainder < 10 ? "0" : "") << remainder;
+}
+
+double CounterValueFromBits(int64_t bits) {
+  double value;
+  static_assert(sizeof(value) == sizeof(bits));
+  std::memcpy(&value, &bits, sizeof(value));
+  return std::isfinite(value) ? value : 0.0;
+}
+
+const char* PhaseForType(TraceRingEventType type) {
+  switch (type) {
+    case TraceRingEventType::kDurationBegin:
+      return "B";
+    case TraceRingEventType::kDurationEnd:
+      return "E";
+    case TraceRingEventType::kInstant:
+      return "i";
+    case TraceRingEventType::kCounter:
+    case TraceRingEventType::kCounterValue:
+      return "C";
+    case TraceRingEventType::kFlowBegin:
+      return "s";
+    case TraceRingEventType::kFlowStep:
+      return "t";
+    case TraceRingEventType::kFlowEnd:
+      return "f";
+  }
+  return "i";
+}
+
+}  // namespace
+
+void TraceRingBufferEnable(size_t events_per_thread) {
+  FML_DCHECK(events_per_thread > 0);
+  auto& registry = GetRegistry();
+  {
+    std::scoped_lock lock(registry.mutex);
+    registry.capacity = RoundUpToPowerOfTwo(std::max<size_t>(
+        events_per_thread, 2u));
+  }
+  internal::gTraceRingBufferEnabled.store(true, std::memory_order_relaxed);
+}
+
+void TraceRingBufferDisable() {
+  internal::gTraceRingBufferEnabled.store(false, std::memory_order_relaxed);
+}
+
+void TraceRingBufferRecord(TraceRingEventType type,
+                           const char* name,
+                           int64_t value) {
+  if (!TraceRingBufferIsEnabled() || name == nullptr) {
+    return;
+  }
+  ThreadRing* ring = tCurrentRing;
+  if (ring == nullptr) {
+    ring = AcquireCurrentThreadRing();
+    if (ring == nullptr) {
+      return;
+    }
+  }
+  ring->Record(type, name, value);
+}
+
+void TraceRingBufferRecordCounterValue(const char* name, double value) {
+  int64_t bits;
+  static_assert(sizeof(value) == sizeof(bits));
+  std::memcpy(&bits, &value, sizeof(bits));
+  TraceRingBufferRecord(TraceRingEventType::kCounterValue, name, bits);
+}
+
+void TraceRingBufferSetCurrentThreadName(const std::string& name) {
+  if (!TraceRingBufferIsEnabled()) {
+    return;
+  }
+  ThreadRing* ring = tCurrentRing;
+  if (ring == nullptr) {
+    ring = AcquireCurrentThreadRing();
+    if (ring == nullptr) {
+      return;
+    }
+  }
+  std::scoped_lock lock(GetRegistry().mutex);
+  ring->name = name;
+}
+
+std::vector<TraceRingThread> TraceRingBufferSnapshot() {
+  auto& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  std::vector<TraceRingThread> threads;
+  threads.reserve(registry.rings.size());
+  for (const auto& ring : registry.rings) {
+    TraceRingThread thread;
+    thread.thread_id = ring->id();
+    thread.thread_name = ring->name;
+    thread.events = ring->Read();
+    threads.push_back(std::move(thread));
+  }
+  return threads;
+}
+
+std::string TraceRingBufferToJSON(const std::vector<TraceRingThread>& threads) {
+  std::ostringstream stream;
+  stream << "{\"traceEvents\":[";
+  bool first = true;
+  auto begin_event = [&](const char* phase, int64_t thread_id) {
+    stream << (first ? "\n" : ",\n") << "{\"ph\":\"" << phase
+           << "\",\"pid\":0,\"tid\":" << thread_id;
+    first = false;
+  };
+
+  for (const auto& thread : threads) {
+    if (!thread.thread_name.empty()) {
+      begin_event("M", thread.thread_id);
+      stream << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+      WriteJSONString(stream, thread.thread_name.c_str());
+      stream << "}}";
+    }
+
+    bool in_counter = false;
+    bool first_series = true;
+    for (const auto& event : thread.events) {
+      if (in_counter && event.type != TraceRingEventType::kCounterValue) {
+        stream << "}}";
+        in_counter = false;
+      }
+      switch (event.type) {
+        case TraceRingEventType::kCounter:
+          begin_event("C", thread.thread_id);
+          stream << ",\"name\":";
+          WriteJSONString(stream, event.name);
+          stream << ",\"id\":" << event.value << ",\"ts\":";
+          WriteMicros(stream, event.timestamp_nanos);
+          stream << ",\"args\":{";
+          in_counter = true;
+          first_series = true;
+          break;
+        case TraceRingEventType::kCounterValue:
+          // The sample that started the series was overwritten.
+          if (!in_counter) {
+            break;
+          }
+          stream << (first_series ? "" : ",");
+          WriteJSONString(stream, event.name);
+          stream << ':' << CounterValueFromBits(event.value);
+          first_series = false;
+          break;
+        default:
+          begin_event(PhaseForType(event.type), thread.thread_id);
+          stream << ",\"name\":";
+          WriteJSONString(stream, event.name);
+          stream << ",\"ts\":";
+          WriteMicros(stream, event.timestamp_nanos);
+          if (event.type == TraceRingEventType::kInstant) {
+            stream << ",\"s\":\"t\"";
+          } else if (event.type == TraceRingEventType::kFlowBegin ||
+                     event.type == TraceRingEventType::kFlowStep ||
+                     event.type == TraceRingEventType::kFlowEnd) {
+            stream << ",\"cat\":\"flow\",\"id\":" << event.value;
+            if (event.type == TraceRingEventType::kFlowEnd) {
+              stream << ",\"bp\":\"e\"";
+            }
+          }
+          stream << '}';
+          break;
+      }
+    }
+    if (in_counter) {
+      stream << "}}";
+    }
+  }
+  stream << "\n]}\n";
+  return stream.str();
+}
+
+}  // namespace tracing
+}  // namespace fml
@@ -0,0 +1,101 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TRACE_RING_BUFFER_H_
+#define FLUTTER_FML_TRACE_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fml {
+namespace tracing {
+
+/// The kinds of events recorded in the trace ring buffer.
+enum class TraceRingEventType : uint8_t {
+  kDurationBegin,
+  kDurationEnd,
+  kInstant,
+  /// Starts a counter sample. The |value| is the counter ID and the
+  /// |kCounterValue| events that follow on the same thread are its series.
+  kCounter,
+  /// A series of the preceding |kCounter| event. The |name| is the series
+  /// name and the |value| holds the bits of a double.
+  kCounterValue,
+  kFlowBegin,
+  kFlowStep,
+  kFlowEnd,
+};
+
+/// An event read back from the trace ring buffer.
+struct TraceRingEvent {
+  TraceRingEventType type;
+  /// The time of the event on the |fml::TimePoint| clock.
+  int64_t timestamp_nanos;
+  const char* name;
+  /// The flow ID of flow events, the counter ID of |kCounter| events, the
+  /// value of |kCounterValue| events, and zero for the rest.
+  int64_t value;
+};
+
+/// The events recorded by one thread, oldest first.
+struct TraceRingThread {
+  /// Identifies the thread within the trace. This is not the OS thread ID.
+  int64_t thread_id = 0;
+  std::string thread_name;
+  std::vector<TraceRingEvent> events;
+};
+
+namespace internal {
+extern std::atomic<bool> gTraceRingBufferEnabled;
+}  // namespace internal
+
+/// @brief Starts recording trace events into per-thread rings that keep the
+///        most recent |events_per_thread| events of each thread. The size is
+///        rounded up to a power of two and only applies to threads that have
+///        not recorded events yet.
+///
+///        Unlike the timeline, recording is cheap enough to stay enabled in
+///        release builds, so that the events leading up to a janky frame can
+///        be collected after the fact.
+void TraceRingBufferEnable(size_t events_per_thread);
+
+/// @brief Stops recording. The events recorded so far can still be read.
+void TraceRingBufferDisable();
+
+inline bool TraceRingBufferIsEnabled() {
+  return internal::gTraceRingBufferEnabled.load(std::memory_order_relaxed);
+}
+
+/// @brief Records an event on the ring of the current thread.
+///
+///        The |name| is not copied and must be a string with static storage
+///        duration, which is already the case for the names passed to the
+///        trace macros.
+void TraceRingBufferRecord(TraceRingEventType type,
+                           const char* name,
+                           int64_t value = 0);
+
+/// @brief Records a |kCounterValue| event.
+void TraceRingBufferRecordCounterValue(const char* name, double value);
+
+/// @brief Names the ring of the current thread in snapshots.
+void TraceRingBufferSetCurrentThreadName(const std::string& name);
+
+/// @brief Copies the events currently held by every ring. Only the thread
+///        that records to a ring writes to it, so taking a snapshot never
+///        blocks recording. Events overwritten while being copied are
+///        dropped.
+std::vector<TraceRingThread> TraceRingBufferSnapshot();
+
+/// @brief Serializes a snapshot in the JSON trace event format, which can be
+///        loaded into Perfetto's trace viewer and chrome://tracing.
+std::string TraceRingBufferToJSON(const std::vector<TraceRingThread>& threads);
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TRACE_RING_BUFFER_H_
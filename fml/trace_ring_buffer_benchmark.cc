@@ -0,0 +1,43 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_ring_buffer.h"
+
+#include "flutter/benchmarking/benchmarking.h"
+
+namespace fml {
+namespace tracing {
+
+static void BM_TraceRingBufferRecord(benchmark::State& state) {
+  TraceRingBufferEnable(4096);
+  for (auto _ : state) {
+    TraceRingBufferRecord(TraceRingEventType::kDurationBegin, "Event");
+  }
+  TraceRingBufferDisable();
+}
+
+static void BM_TraceRingBufferRecordDisabled(benchmark::State& state) {
+  TraceRingBufferDisable();
+  for (auto _ : state) {
+    TraceRingBufferRecord(TraceRingEventType::kDurationBegin, "Event");
+  }
+}
+
+static void BM_TraceRingBufferSnapshot(benchmark::State& state) {
+  TraceRingBufferEnable(state.range(0));
+  for (int64_t i = 0; i < state.range(0); i++) {
+    TraceRingBufferRecord(TraceRingEventType::kInstant, "Event", i);
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(TraceRingBufferSnapshot());
+  }
+  TraceRingBufferDisable();
+}
+
+BENCHMARK(BM_TraceRingBufferRecord);
+BENCHMARK(BM_TraceRingBufferRecordDisabled);
+BENCHMARK(BM_TraceRingBufferSnapshot)->Arg(4096);
+
+}  // namespace tracing
+}  // namespace fml
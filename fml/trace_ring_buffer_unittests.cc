@@ -0,0 +1,156 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_ring_buffer.h"
+
+#include <atomic>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+namespace {
+
+const TraceRingThread* FindThread(const std::vector<TraceRingThread>& threads,
+                                  const std::string& name) {
+  for (const auto& thread : threads) {
+    if (thread.thread_name == name) {
+      return &thread;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+TEST(TraceRingBufferTest, RecordsEventsInOrder) {
+  TraceRingBufferEnable(16);
+  std::thread thread([]() {
+    TraceRingBufferSetCurrentThreadName("ring.in_order");
+    TraceRingBufferRecord(TraceRingEventType::kDurationBegin, "Frame");
+    TraceRingBufferRecord(TraceRingEventType::kFlowBegin, "Flow", 42);
+    TraceRingBufferRecord(TraceRingEventType::kInstant, "Mark");
+    TraceRingBufferRecord(TraceRingEventType::kDurationEnd, "Frame");
+  });
+  thread.join();
+  TraceRingBufferDisable();
+
+  const auto threads = TraceRingBufferSnapshot();
+  const auto* recorded = FindThread(threads, "ring.in_order");
+  ASSERT_NE(recorded, nullptr);
+  ASSERT_EQ(recorded->events.size(), 4u);
+  EXPECT_EQ(recorded->events[0].type, TraceRingEventType::kDurationBegin);
+  EXPECT_STREQ(recorded->events[0].name, "Frame");
+  EXPECT_EQ(recorded->events[1].type, TraceRingEventType::kFlowBegin);
+  EXPECT_EQ(recorded->events[1].value, 42);
+  EXPECT_EQ(recorded->events[2].type, TraceRingEventType::kInstant);
+  EXPECT_EQ(recorded->events[3].type, TraceRingEventType::kDurationEnd);
+  for (size_t i = 1; i < recorded->events.size(); i++) {
+    EXPECT_GE(recorded->events[i].timestamp_nanos,
+              recorded->events[i - 1].timestamp_nanos);
+  }
+}
+
+TEST(TraceRingBufferTest, KeepsMostRecentEvents) {
+  TraceRingBufferEnable(8);
+  std::thread thread([]() {
+    TraceRingBufferSetCurrentThreadName("ring.most_recent");
+    for (int64_t i = 0; i < 20; i++) {
+      TraceRingBufferRecord(TraceRingEventType::kInstant, "Event", i);
+    }
+  });
+  thread.join();
+  TraceRingBufferDisable();
+
+  const auto threads = TraceRingBufferSnapshot();
+  const auto* recorded = FindThread(threads, "ring.most_recent");
+  ASSERT_NE(recorded, nullptr);
+  ASSERT_EQ(recorded->events.size(), 8u);
+  for (size_t i = 0; i < recorded->events.size(); i++) {
+    EXPECT_EQ(recorded->events[i].value, static_cast<int64_t>(12 + i));
+  }
+}
+
+TEST(TraceRingBufferTest, RecordsNothingWhenDisabled) {
+  TraceRingBufferDisable();
+  std::thread thread([]() {
+    TraceRingBufferSetCurrentThreadName("ring.disabled");
+    TraceRingBufferRecord(TraceRingEventType::kInstant, "Event");
+  });
+  thread.join();
+
+  EXPECT_EQ(FindThread(TraceRingBufferSnapshot(), "ring.disabled"), nullptr);
+}
+
+TEST(TraceRingBufferTest, SnapshotsWhileRecording) {
+  TraceRingBufferEnable(64);
+  std::atomic<bool> done = false;
+  std::atomic<bool> named = false;
+  std::thread thread([&]() {
+    TraceRingBufferSetCurrentThreadName("ring.concurrent");
+    named = true;
+    for (int64_t i = 0; !done; i++) {
+      TraceRingBufferRecord(TraceRingEventType::kInstant, "Event", i);
+    }
+  });
+  while (!named) {
+    std::this_thread::yield();
+  }
+
+  for (size_t snapshot = 0; snapshot < 200; snapshot++) {
+    const auto threads = TraceRingBufferSnapshot();
+    const auto* recorded = FindThread(threads, "ring.concurrent");
+    ASSERT_NE(recorded, nullptr);
+    ASSERT_LE(recorded->events.size(), 64u);
+    for (size_t i = 0; i < recorded->events.size(); i++) {
+      ASSERT_STREQ(recorded->events[i].name, "Event");
+      ASSERT_EQ(recorded->events[i].type, TraceRingEventType::kInstant);
+      if (i > 0) {
+        ASSERT_EQ(recorded->events[i].value,
+                  recorded->events[i - 1].value + 1);
+      }
+    }
+  }
+
+  done = true;
+  thread.join();
+  TraceRingBufferDisable();
+}
+
+TEST(TraceRingBufferTest, SerializesToJSON) {
+  TraceRingThread thread;
+  thread.thread_id = 3;
+  thread.thread_name = "io.flutter.\"raster\"";
+  thread.events = {
+      {TraceRingEventType::kDurationBegin, 1000, "Rasterize", 0},
+      {TraceRingEventType::kCounter, 1500, "RasterCache", 7},
+      {TraceRingEventType::kCounterValue, 1500, "LayerCount", 0},
+      {TraceRingEventType::kFlowEnd, 1999, "PipelineItem", 9},
+      {TraceRingEventType::kDurationEnd, 2001, "Rasterize", 0},
+  };
+  const std::string json = TraceRingBufferToJSON({thread});
+
+  EXPECT_NE(json.find(R"({"ph":"M","pid":0,"tid":3,"name":"thread_name",)"
+                      R"("args":{"name":"io.flutter.\"raster\""}})"),
+            std::string::npos);
+  EXPECT_NE(json.find(R"({"ph":"B","pid":0,"tid":3,"name":"Rasterize",)"
+                      R"("ts":1.000})"),
+            std::string::npos);
+  EXPECT_NE(json.find(R"({"ph":"C","pid":0,"tid":3,"name":"RasterCache",)"
+                      R"("id":7,"ts":1.500,"args":{"LayerCount":0}})"),
+            std::string::npos);
+  EXPECT_NE(json.find(R"({"ph":"f","pid":0,"tid":3,"name":"PipelineItem",)"
+                      R"("ts":1.999,"cat":"flow","id":9,"bp":"e"})"),
+            std::string::npos);
+  EXPECT_NE(json.find(R"({"ph":"E","pid":0,"tid":3,"name":"Rasterize",)"
+                      R"("ts":2.001})"),
+            std::string::npos);
+}
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
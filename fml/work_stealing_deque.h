@@ -0,0 +1,181 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_WORK_STEALING_DEQUE_H_
+#define FLUTTER_FML_WORK_STEALING_DEQUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      A Chase-Lev work stealing deque.
+///
+///             The owning thread pushes and pops items at the bottom of the
+///             deque without taking locks. Any other thread may steal items
+///             from the top. The memory orderings follow "Correct and
+///             Efficient Work-Stealing for Weak Memory Models" by Lê et al.
+///
+///             Arrays that were outgrown are kept alive until the deque is
+///             destroyed since a concurrent thief may still be reading them.
+///
+/// @tparam     T  The type of the items. Since items are copied in and out of
+///                atomic slots, this is usually a pointer.
+///
+template <typename T>
+class WorkStealingDeque {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Items are stored in atomics and must be trivially copyable.");
+
+ public:
+  explicit WorkStealingDeque(size_t initial_capacity = 64u) {
+    size_t capacity = 1u;
+    while (capacity < initial_capacity) {
+      capacity <<= 1u;
+    }
+    arrays_.emplace_back(std::make_unique<Array>(capacity));
+    array_.store(arrays_.back().get(), std::memory_order_relaxed);
+  }
+
+  ~WorkStealingDeque() = default;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds an item at the bottom of the deque. Must only be called
+  ///             on the owning thread.
+  ///
+  void Push(T item) {
+    const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    const int64_t top = top_.load(std::memory_order_acquire);
+    Array* array = array_.load(std::memory_order_relaxed);
+    if (bottom - top > static_cast<int64_t>(array->capacity) - 1) {
+      array = Grow(array, top, bottom);
+    }
+    array->Store(bottom, item);
+    // A release store rather than the paper's release fence followed by a
+    // relaxed store. It is equivalent and thread sanitizer understands it.
+    bottom_.store(bottom + 1, std::memory_order_release);
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes the most recently pushed item. Must only be called on
+  ///             the owning thread.
+  ///
+  /// @return     The item or std::nullopt if the deque is empty.
+  ///
+  std::optional<T> Pop() {
+    const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Array* array = array_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+      // Empty.
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return std::nullopt;
+    }
+
+    std::optional<T> item = array->Load(bottom);
+    if (top == bottom) {
+      // The last item, race any thieves for it.
+      if (!top_.compare_exchange_strong(top, top + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        item = std::nullopt;
+      }
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes the least recently pushed item. May be called on any
+  ///             thread.
+  ///
+  /// @return     The item or std::nullopt if the deque is empty or another
+  ///             thread won the race for the item.
+  ///
+  std::optional<T> Steal() {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) {
+      return std::nullopt;
+    }
+
+    // Consume ordering is promoted to acquire by every compiler anyway.
+    Array* array = array_.load(std::memory_order_acquire);
+    const T item = array->Load(top);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return std::nullopt;
+    }
+    return item;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the deque looked empty at some point during the call.
+  ///             Racy by nature and only useful as a hint.
+  ///
+  bool IsEmpty() const {
+    const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    const int64_t top = top_.load(std::memory_order_relaxed);
+    return top >= bottom;
+  }
+
+ private:
+  struct Array {
+    explicit Array(size_t p_capacity)
+        : capacity(p_capacity),
+          mask(p_capacity - 1u),
+          slots(std::make_unique<std::atomic<T>[]>(p_capacity)) {
+      FML_DCHECK((capacity & mask) == 0u);
+    }
+
+    T Load(int64_t index) const {
+      return slots[index & mask].load(std::memory_order_relaxed);
+    }
+
+    void Store(int64_t index, T item) {
+      slots[index & mask].store(item, std::memory_order_relaxed);
+    }
+
+    const size_t capacity;
+    const size_t mask;
+    std::unique_ptr<std::atomic<T>[]> slots;
+  };
+
+  // Modified by the owner only, read by thieves.
+  std::atomic<int64_t> bottom_ = 0;
+  // Advanced by whoever takes the last item, owner or thief.
+  std::atomic<int64_t> top_ = 0;
+  std::atomic<Array*> array_ = nullptr;
+  // The current array and all the ones it replaced. Owner only.
+  std::vector<std::unique_ptr<Array>> arrays_;
+
+  Array* Grow(Array* array, int64_t top, int64_t bottom) {
+    auto grown = std::make_unique<Array>(array->capacity * 2u);
+    for (int64_t i = top; i < bottom; i++) {
+      grown->Store(i, array->Load(i));
+    }
+    Array* result = grown.get();
+    arrays_.emplace_back(std::move(grown));
+    array_.store(result, std::memory_order_release);
+    return result;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(WorkStealingDeque);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_WORK_STEALING_DEQUE_H_
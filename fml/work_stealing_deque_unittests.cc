@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/work_stealing_deque.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(WorkStealingDequeTest, OwnerPopsNewestAndThievesStealOldest) {
+  WorkStealingDeque<int> deque;
+  EXPECT_TRUE(deque.IsEmpty());
+  deque.Push(1);
+  deque.Push(2);
+  deque.Push(3);
+  EXPECT_FALSE(deque.IsEmpty());
+  EXPECT_EQ(deque.Pop(), 3);
+  EXPECT_EQ(deque.Steal(), 1);
+  EXPECT_EQ(deque.Pop(), 2);
+  EXPECT_FALSE(deque.Pop().has_value());
+  EXPECT_FALSE(deque.Steal().has_value());
+  EXPECT_TRUE(deque.IsEmpty());
+}
+
+TEST(WorkStealingDequeTest, GrowsPastInitialCapacity) {
+  WorkStealingDeque<int> deque(2u);
+  for (int i = 0; i < 100; i++) {
+    deque.Push(i);
+  }
+  EXPECT_EQ(deque.Steal(), 0);
+  for (int i = 99; i > 0; i--) {
+    EXPECT_EQ(deque.Pop(), i);
+  }
+  EXPECT_TRUE(deque.IsEmpty());
+}
+
+TEST(WorkStealingDequeTest, EveryItemIsTakenExactlyOnce) {
+  constexpr int kItemCount = 100000;
+  constexpr int kThiefCount = 3;
+  WorkStealingDeque<int> deque(4u);
+  std::vector<std::atomic<int>> taken(kItemCount);
+  std::atomic<int> taken_count = 0;
+  std::atomic<bool> done = false;
+
+  std::vector<std::thread> thieves;
+  for (int i = 0; i < kThiefCount; i++) {
+    thieves.emplace_back([&]() {
+      while (!done) {
+        if (auto item = deque.Steal()) {
+          taken[item.value()]++;
+          taken_count++;
+        }
+      }
+    });
+  }
+
+  for (int i = 0; i < kItemCount; i++) {
+    deque.Push(i);
+    // Pop every other item so that the owner races the thieves too.
+    if (i % 2 == 0) {
+      if (auto item = deque.Pop()) {
+        taken[item.value()]++;
+        taken_count++;
+      }
+    }
+  }
+  while (auto item = deque.Pop()) {
+    taken[item.value()]++;
+    taken_count++;
+  }
+  // Thieves may still be finishing up a steal of the last items.
+  while (taken_count < kItemCount) {
+    std::this_thread::yield();
+  }
+  done = true;
+  for (auto& thief : thieves) {
+    thief.join();
+  }
+
+  EXPECT_EQ(taken_count, kItemCount);
+  for (int i = 0; i < kItemCount; i++) {
+    ASSERT_EQ(taken[i], 1) << "Item " << i;
+  }
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -2103,6 +2103,61 @@ TEST_P(AiksTest, OpacityPeepHoleApplicationTest) {
   ASSERT_TRUE(delegate->CanCollapseIntoParentPass(entity_pass.get()));
 }
 
+TEST_P(AiksTest, OpacityPeepHoleFoldsColorFilterAndBlendMode) {
+  auto rect = Rect::MakeLTRB(0, 0, 100, 100);
+  auto make_pass = [&rect]() {
+    auto entity_pass = std::make_shared<EntityPass>();
+    Entity entity;
+    entity.SetContents(SolidColorContents::Make(
+        PathBuilder{}.AddRect(rect).TakePath(), Color::Red()));
+    entity_pass->AddEntity(std::move(entity));
+    return entity_pass;
+  };
+  auto get_draw = [](EntityPass& entity_pass) {
+    Entity* result = nullptr;
+    entity_pass.IterateUntilSubpass([&result](Entity& entity) {
+      result = &entity;
+      return true;
+    });
+    return result;
+  };
+
+  // Color filters that keep transparent black transparent are folded into the
+  // child contents.
+  Paint paint;
+  paint.color_filter =
+      ColorFilter::MakeBlend(BlendMode::kSourceIn, Color::Blue());
+  auto entity_pass = make_pass();
+  auto delegate = std::make_shared<OpacityPeepholePassDelegate>(paint);
+  ASSERT_TRUE(delegate->CanCollapseIntoParentPass(entity_pass.get()));
+  auto* draw = get_draw(*entity_pass);
+  ASSERT_NE(draw, nullptr);
+  auto* contents = draw->GetContents()->AsSolidColor();
+  ASSERT_NE(contents, nullptr);
+  EXPECT_EQ(contents->GetColor(), Color::Blue());
+
+  // Color filters that would tint the whole layer are not.
+  paint.color_filter =
+      ColorFilter::MakeBlend(BlendMode::kSourceOver, Color::Blue());
+  entity_pass = make_pass();
+  delegate = std::make_shared<OpacityPeepholePassDelegate>(paint);
+  ASSERT_FALSE(delegate->CanCollapseIntoParentPass(entity_pass.get()));
+
+  // Non-destructive pipeline blend modes are moved onto the child.
+  paint.color_filter = nullptr;
+  paint.blend_mode = BlendMode::kPlus;
+  entity_pass = make_pass();
+  delegate = std::make_shared<OpacityPeepholePassDelegate>(paint);
+  ASSERT_TRUE(delegate->CanCollapseIntoParentPass(entity_pass.get()));
+  EXPECT_EQ(get_draw(*entity_pass)->GetBlendMode(), BlendMode::kPlus);
+
+  // Destructive ones are not.
+  paint.blend_mode = BlendMode::kSourceIn;
+  entity_pass = make_pass();
+  delegate = std::make_shared<OpacityPeepholePassDelegate>(paint);
+  ASSERT_FALSE(delegate->CanCollapseIntoParentPass(entity_pass.get()));
+}
+
 TEST_P(AiksTest, DrawPaintAbsorbsClears) {
   Canvas canvas;
   canvas.DrawPaint({.color = Color::Red(), .blend_mode = BlendMode::kSource});
@@ -174,6 +174,9 @@ bool Canvas::Restore() {
       Entity::RenderingMode::kSubpass) {
     current_pass_ = GetCurrentPass().GetSuperpass();
     FML_DCHECK(current_pass_);
+    // Adjacent layers that don't overlap, such as the items of a faded list,
+    // can share one offscreen texture.
+    GetCurrentPass().MergeLastSubpasses();
   }
 
   bool contains_clips = transform_stack_.back().contains_clips;
@@ -691,8 +694,10 @@ void Canvas::SaveLayer(const Paint& paint,
   auto& new_layer_pass = GetCurrentPass();
   new_layer_pass.SetBoundsLimit(bounds);
 
-  // Only apply opacity peephole on default blending.
-  if (paint.blend_mode == BlendMode::kSourceOver) {
+  // Only apply the peephole on blend modes that it is able to fold into the
+  // children of the layer.
+  if (paint.blend_mode <= Entity::kLastPipelineBlendMode &&
+      !Entity::IsBlendModeDestructive(paint.blend_mode)) {
     new_layer_pass.SetDelegate(
         std::make_shared<OpacityPeepholePassDelegate>(paint));
   } else {
@@ -700,6 +705,14 @@ void Canvas::SaveLayer(const Paint& paint,
   }
 }
 
+static bool CanBlurInGlyphAtlas(const Paint& paint, const Matrix& transform) {
+  const auto& blur = paint.mask_blur_descriptor.value();
+  return blur.style == FilterContents::BlurStyle::kNormal &&
+         paint.color_source.GetType() == ColorSource::Type::kColor &&
+         blur.sigma.sigma * transform.GetMaxBasisLength() <=
+             TextFrame::kMaxAtlasBlurSigma;
+}
+
 void Canvas::DrawTextFrame(const std::shared_ptr<TextFrame>& text_frame,
                            Point position,
                            const Paint& paint) {
@@ -715,6 +728,16 @@ void Canvas::DrawTextFrame(const std::shared_ptr<TextFrame>& text_frame,
   entity.SetTransform(GetCurrentTransform() *
                       Matrix::MakeTranslation(position));
 
+  // Normal blurs of solid colored text, such as text shadows, are drawn from
+  // blurred glyphs in the atlas instead of blurring an offscreen pass.
+  if (paint.mask_blur_descriptor.has_value() &&
+      CanBlurInGlyphAtlas(paint, entity.GetTransform())) {
+    text_contents->SetBlurSigma(paint.mask_blur_descriptor->sigma.sigma);
+    entity.SetContents(paint.WithFilters(std::move(text_contents)));
+    GetCurrentPass().AddEntity(std::move(entity));
+    return;
+  }
+
   // TODO(bdero): This mask blur application is a hack. It will always wind up
   //              doing a gaussian blur that affects the color source itself
   //              instead of just the mask. The color filter text support
@@ -4,6 +4,7 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 
+#include "flutter/fml/memory/allocation_counter.h"
 #include "impeller/aiks/canvas.h"
 
 namespace impeller {
@@ -45,6 +46,9 @@ static void BM_CanvasRecord(benchmark::State& state, Args&&... args) {
 
   size_t op_count = 0u;
   size_t canvas_count = 0u;
+  fml::ScopedAllocationCounter pass_allocations(
+      fml::AllocationTag::kEntityPass);
+  fml::ScopedAllocationCounter path_allocations(fml::AllocationTag::kPath);
   while (state.KeepRunning()) {
     // A new canvas is allocated for each iteration to avoid the benchmark
     // becoming a measurement of only the entity vector re-allocation time.
@@ -54,6 +58,12 @@ static void BM_CanvasRecord(benchmark::State& state, Args&&... args) {
   }
   state.counters["TotalOpCount"] = op_count;
   state.counters["TotalCanvasCount"] = canvas_count;
+  state.counters["EntityPassAllocsPerIteration"] = benchmark::Counter(
+      pass_allocations.GetCount().allocations,
+      benchmark::Counter::kAvgIterations);
+  state.counters["PathAllocsPerIteration"] = benchmark::Counter(
+      path_allocations.GetCount().allocations,
+      benchmark::Counter::kAvgIterations);
 }
 
 BENCHMARK_CAPTURE(BM_CanvasRecord, draw_rect, &DrawRect);
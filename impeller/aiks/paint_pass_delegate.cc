@@ -4,6 +4,10 @@
 
 #include "impeller/aiks/paint_pass_delegate.h"
 
+#include <optional>
+#include <vector>
+
+#include "impeller/aiks/color_filter.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/entity/contents/contents.h"
@@ -54,9 +58,20 @@ std::shared_ptr<FilterContents> PaintPassDelegate::WithImageFilter(
                                 Entity::RenderingMode::kSubpass);
 }
 
+// |EntityPassDelgate|
+std::optional<Scalar> PaintPassDelegate::GetSubpassOpacity(
+    const EntityPass& entity_pass) const {
+  if (paint_.image_filter || paint_.GetColorFilter()) {
+    return std::nullopt;
+  }
+  return paint_.color.alpha;
+}
+
 /// OpacityPeepholePassDelegate
 /// ----------------------------------------------
 
+static constexpr size_t kMaxCollapsedElementCount = 3u;
+
 OpacityPeepholePassDelegate::OpacityPeepholePassDelegate(Paint paint)
     : paint_(std::move(paint)) {}
 
@@ -76,10 +91,31 @@ bool OpacityPeepholePassDelegate::CanCollapseIntoParentPass(
     return false;
   }
 
-  // OpacityPeepholePassDelegate will only get used if the pass's blend mode is
-  // SourceOver, so no need to check here.
-  if (paint_.color.alpha <= 0.0 || paint_.color.alpha >= 1.0 ||
-      paint_.image_filter || paint_.color_filter) {
+  if (paint_.color.alpha <= 0.0 || paint_.image_filter) {
+    return false;
+  }
+
+  // The layer blend mode may only be moved onto the children if the
+  // transparent parts of the layer would have left the parent untouched.
+  // Advanced blends read back the parent texture and are not folded.
+  if (paint_.blend_mode > Entity::kLastPipelineBlendMode ||
+      Entity::IsBlendModeDestructive(paint_.blend_mode)) {
+    return false;
+  }
+
+  // Likewise, the color filter would have been applied to the transparent
+  // parts of the layer too. It can only be folded if those stay transparent.
+  std::optional<ColorFilter::ColorFilterProc> color_filter_proc;
+  if (paint_.color_filter) {
+    color_filter_proc = paint_.color_filter->GetCPUColorFilterProc();
+    if (color_filter_proc.value()(Color::BlackTransparent()).alpha > 0.0) {
+      return false;
+    }
+  }
+
+  bool needs_opacity = paint_.color.alpha < 1.0;
+  if (!needs_opacity && !color_filter_proc.has_value() &&
+      paint_.blend_mode == BlendMode::kSourceOver) {
     return false;
   }
 
@@ -91,7 +127,7 @@ bool OpacityPeepholePassDelegate::CanCollapseIntoParentPass(
   // command wrapped in save layer. This would indicate something like an
   // Opacity or FadeTransition wrapping a very simple widget, like in the
   // CupertinoPicker.
-  if (entity_pass->GetElementCount() > 3) {
+  if (entity_pass->GetElementCount() > kMaxCollapsedElementCount) {
     // Single paint command with a save layer would be:
     // 1. clip
     // 2. draw command
@@ -100,8 +136,9 @@ bool OpacityPeepholePassDelegate::CanCollapseIntoParentPass(
   }
   bool all_can_accept = true;
   std::vector<Rect> all_coverages;
+  std::vector<Entity*> draws;
   auto had_subpass = entity_pass->IterateUntilSubpass(
-      [&all_coverages, &all_can_accept](Entity& entity) {
+      [&all_coverages, &all_can_accept, &draws](Entity& entity) {
         const auto& contents = entity.GetContents();
         if (!entity.CanInheritOpacity()) {
           all_can_accept = false;
@@ -118,16 +155,35 @@ bool OpacityPeepholePassDelegate::CanCollapseIntoParentPass(
           }
           all_coverages.push_back(coverage);
         }
+        if (entity.GetClipCoverage(std::nullopt).type ==
+            Contents::ClipCoverage::Type::kNoChange) {
+          draws.push_back(&entity);
+        }
         return true;
       });
   if (had_subpass || !all_can_accept) {
     return false;
   }
-  auto alpha = paint_.color.alpha;
-  entity_pass->IterateUntilSubpass([&alpha](Entity& entity) {
-    entity.SetInheritedOpacity(alpha);
-    return true;
-  });
+
+  // Color filters are applied on the CPU, which either fully succeeds or
+  // leaves the contents untouched. With a single draw there's nothing to undo
+  // when it fails.
+  if (color_filter_proc.has_value()) {
+    if (draws.size() != 1u ||
+        !draws.front()->GetContents()->ApplyColorFilter(
+            color_filter_proc.value())) {
+      return false;
+    }
+  }
+
+  for (auto* entity : draws) {
+    if (needs_opacity) {
+      entity->SetInheritedOpacity(paint_.color.alpha);
+    }
+    if (paint_.blend_mode != BlendMode::kSourceOver) {
+      entity->SetBlendMode(paint_.blend_mode);
+    }
+  }
   return true;
 }
 
@@ -155,4 +211,18 @@ std::shared_ptr<FilterContents> OpacityPeepholePassDelegate::WithImageFilter(
                                 Entity::RenderingMode::kSubpass);
 }
 
+// |EntityPassDelgate|
+std::optional<Scalar> OpacityPeepholePassDelegate::GetSubpassOpacity(
+    const EntityPass& entity_pass) const {
+  // Small passes may still be collapsed, which is cheaper than sharing a
+  // texture with a neighbor. Merging passes only adds elements.
+  if (entity_pass.GetElementCount() <= kMaxCollapsedElementCount) {
+    return std::nullopt;
+  }
+  if (paint_.image_filter || paint_.GetColorFilter()) {
+    return std::nullopt;
+  }
+  return paint_.color.alpha;
+}
+
 }  // namespace impeller
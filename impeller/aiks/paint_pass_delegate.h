@@ -36,6 +36,10 @@ class PaintPassDelegate final : public EntityPassDelegate {
       const FilterInput::Variant& input,
       const Matrix& effect_transform) const override;
 
+  // |EntityPassDelgate|
+  std::optional<Scalar> GetSubpassOpacity(
+      const EntityPass& entity_pass) const override;
+
  private:
   const Paint paint_;
 
@@ -44,11 +48,13 @@ class PaintPassDelegate final : public EntityPassDelegate {
   PaintPassDelegate& operator=(const PaintPassDelegate&) = delete;
 };
 
-/// A delegate that attempts to forward opacity from a save layer to
-/// child contents.
+/// A delegate that attempts to forward opacity, a CPU applicable color filter
+/// and a non-destructive pipeline blend mode from a save layer to child
+/// contents.
 ///
-/// Currently this has a hardcoded limit of 3 entities in a pass, and
-/// cannot forward to child subpass delegates.
+/// Currently this has a hardcoded limit of 3 entities in a pass, color filters
+/// are only forwarded to a single drawing entity, and it cannot forward to
+/// child subpass delegates.
 class OpacityPeepholePassDelegate final : public EntityPassDelegate {
  public:
   explicit OpacityPeepholePassDelegate(Paint paint);
@@ -72,6 +78,10 @@ class OpacityPeepholePassDelegate final : public EntityPassDelegate {
       const FilterInput::Variant& input,
       const Matrix& effect_transform) const override;
 
+  // |EntityPassDelgate|
+  std::optional<Scalar> GetSubpassOpacity(
+      const EntityPass& entity_pass) const override;
+
  private:
   const Paint paint_;
 
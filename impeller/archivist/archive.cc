@@ -39,15 +39,16 @@ std::optional<int64_t /* row id */> Archive::ArchiveInstance(
     return std::nullopt;
   }
 
-  auto statement = registration->CreateInsertStatement();
+  auto lease = registration->AcquireInsertStatement();
 
-  if (!statement.IsValid() || !statement.Reset()) {
+  if (!lease.IsValid() || !lease.Get().Reset()) {
     /*
      *  Must be able to reset the statement for a new write
      */
     return std::nullopt;
   }
 
+  auto& statement = lease.Get();
   auto primary_key = archivable.GetPrimaryKey();
 
   /*
@@ -92,6 +93,29 @@ std::optional<int64_t /* row id */> Archive::ArchiveInstance(
   return lastInsert;
 }
 
+bool Archive::ArchiveInstances(
+    const ArchiveDef& definition,
+    const std::vector<const Archivable*>& archivables) {
+  if (!IsValid()) {
+    return false;
+  }
+
+  /*
+   *  The transactions of the individual writes are nested in this one, so
+   *  nothing is committed until all of them succeeded.
+   */
+  auto transaction = database_->CreateTransaction(transaction_count_);
+
+  for (const auto* archivable : archivables) {
+    if (!ArchiveInstance(definition, *archivable).has_value()) {
+      return false;
+    }
+  }
+
+  transaction.MarkWritesAsReadyForCommit();
+  return true;
+}
+
 bool Archive::UnarchiveInstance(const ArchiveDef& definition,
                                 PrimaryKey name,
                                 Archivable& archivable) {
@@ -119,12 +143,14 @@ size_t Archive::UnarchiveInstances(const ArchiveDef& definition,
 
   const bool isQueryingSingle = primary_key.has_value();
 
-  auto statement = registration->CreateQueryStatement(isQueryingSingle);
+  auto lease = registration->AcquireQueryStatement(isQueryingSingle);
 
-  if (!statement.IsValid() || !statement.Reset()) {
+  if (!lease.IsValid() || !lease.Get().Reset()) {
     return 0;
   }
 
+  auto& statement = lease.Get();
+
   if (isQueryingSingle) {
     /*
      *  If a single statement is being queried for, bind the primary key as a
@@ -10,6 +10,7 @@
 #include <optional>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "impeller/archivist/archivable.h"
 
@@ -33,6 +34,25 @@ class Archive {
     return ArchiveInstance(def, archivable).has_value();
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Writes all |archivables| in a single transaction. Either all
+  ///             of them are written or, if one cannot be, none are.
+  ///
+  ///             This is much faster than writing many items one by one, as
+  ///             the database only commits once.
+  ///
+  template <class T,
+            class = std::enable_if_t<std::is_base_of<Archivable, T>::value>>
+  [[nodiscard]] bool Write(const std::vector<T>& archivables) {
+    const ArchiveDef& def = T::kArchiveDefinition;
+    std::vector<const Archivable*> items;
+    items.reserve(archivables.size());
+    for (const auto& archivable : archivables) {
+      items.push_back(&archivable);
+    }
+    return ArchiveInstances(def, items);
+  }
+
   template <class T,
             class = std::enable_if_t<std::is_base_of<Archivable, T>::value>>
   [[nodiscard]] bool Read(PrimaryKey name, T& archivable) {
@@ -59,6 +79,9 @@ class Archive {
       const ArchiveDef& definition,
       const Archivable& archivable);
 
+  bool ArchiveInstances(const ArchiveDef& definition,
+                        const std::vector<const Archivable*>& archivables);
+
   bool UnarchiveInstance(const ArchiveDef& definition,
                          PrimaryKey name,
                          Archivable& archivable);
@@ -6,6 +6,8 @@
 
 #include <sstream>
 
+#include "flutter/fml/logging.h"
+
 #include "impeller/archivist/archive_database.h"
 #include "impeller/archivist/archive_statement.h"
 #include "impeller/base/validation.h"
@@ -83,7 +85,57 @@ bool ArchiveClassRegistration::CreateTable() {
   return statement.Execute() == ArchiveStatement::Result::kDone;
 }
 
-ArchiveStatement ArchiveClassRegistration::CreateQueryStatement(
+ArchiveClassRegistration::StatementLease::StatementLease(
+    StatementPool& pool,
+    std::unique_ptr<ArchiveStatement> statement)
+    : pool_(pool), statement_(std::move(statement)) {}
+
+ArchiveClassRegistration::StatementLease::~StatementLease() {
+  // Statements that cannot be reset are dropped instead of being reused.
+  if (IsValid() && statement_->Reset()) {
+    pool_.push_back(std::move(statement_));
+  }
+}
+
+bool ArchiveClassRegistration::StatementLease::IsValid() const {
+  return statement_ && statement_->IsValid();
+}
+
+ArchiveStatement& ArchiveClassRegistration::StatementLease::Get() const {
+  FML_DCHECK(statement_);
+  return *statement_;
+}
+
+static std::unique_ptr<ArchiveStatement> TakeCachedStatement(
+    ArchiveClassRegistration::StatementPool& pool) {
+  if (pool.empty()) {
+    return nullptr;
+  }
+  auto statement = std::move(pool.back());
+  pool.pop_back();
+  return statement;
+}
+
+ArchiveClassRegistration::StatementLease
+ArchiveClassRegistration::AcquireInsertStatement() const {
+  auto statement = TakeCachedStatement(insert_statements_);
+  if (!statement) {
+    statement = database_.PrepareStatement(CreateInsertStatementString());
+  }
+  return StatementLease{insert_statements_, std::move(statement)};
+}
+
+ArchiveClassRegistration::StatementLease
+ArchiveClassRegistration::AcquireQueryStatement(bool single) const {
+  auto& pool = single ? query_single_statements_ : query_all_statements_;
+  auto statement = TakeCachedStatement(pool);
+  if (!statement) {
+    statement = database_.PrepareStatement(CreateQueryStatementString(single));
+  }
+  return StatementLease{pool, std::move(statement)};
+}
+
+std::string ArchiveClassRegistration::CreateQueryStatementString(
     bool single) const {
   std::stringstream stream;
   stream << "SELECT " << kArchivePrimaryKeyColumnName << ", ";
@@ -103,10 +155,10 @@ ArchiveStatement ArchiveClassRegistration::CreateQueryStatement(
 
   stream << ";";
 
-  return database_.CreateStatement(stream.str());
+  return stream.str();
 }
 
-ArchiveStatement ArchiveClassRegistration::CreateInsertStatement() const {
+std::string ArchiveClassRegistration::CreateInsertStatementString() const {
   std::stringstream stream;
   stream << "INSERT OR REPLACE INTO " << definition_.table_name
          << " VALUES ( ?, ";
@@ -118,7 +170,7 @@ ArchiveStatement ArchiveClassRegistration::CreateInsertStatement() const {
   }
   stream << ");";
 
-  return database_.CreateStatement(stream.str());
+  return stream.str();
 }
 
 }  // namespace impeller
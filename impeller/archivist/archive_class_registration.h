@@ -6,7 +6,10 @@
 #define FLUTTER_IMPELLER_ARCHIVIST_ARCHIVE_CLASS_REGISTRATION_H_
 
 #include <map>
+#include <memory>
 #include <optional>
+#include <string>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/archivist/archive.h"
@@ -18,6 +21,35 @@ class ArchiveClassRegistration {
  public:
   static constexpr size_t kPrimaryKeyIndex = 0u;
 
+  using StatementPool = std::vector<std::unique_ptr<ArchiveStatement>>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      A prepared statement borrowed from a registration. It is reset
+  ///             and returned to the registration when the lease ends, so that
+  ///             the next write or query does not prepare it again.
+  ///
+  class StatementLease {
+   public:
+    ~StatementLease();
+
+    bool IsValid() const;
+
+    ArchiveStatement& Get() const;
+
+   private:
+    friend class ArchiveClassRegistration;
+
+    StatementPool& pool_;
+    std::unique_ptr<ArchiveStatement> statement_;
+
+    StatementLease(StatementPool& pool,
+                   std::unique_ptr<ArchiveStatement> statement);
+
+    StatementLease(const StatementLease&) = delete;
+
+    StatementLease& operator=(const StatementLease&) = delete;
+  };
+
   bool IsValid() const;
 
   std::optional<size_t> FindColumnIndex(const std::string& member) const;
@@ -26,9 +58,18 @@ class ArchiveClassRegistration {
 
   size_t GetMemberCount() const;
 
-  ArchiveStatement CreateInsertStatement() const;
+  //----------------------------------------------------------------------------
+  /// @brief      Borrows a statement that inserts an instance of the class.
+  ///
+  ///             Nested writes of the same class each get their own statement.
+  ///
+  StatementLease AcquireInsertStatement() const;
 
-  ArchiveStatement CreateQueryStatement(bool single) const;
+  //----------------------------------------------------------------------------
+  /// @brief      Borrows a statement that reads either the instance with a
+  ///             given primary key, or all instances of the class.
+  ///
+  StatementLease AcquireQueryStatement(bool single) const;
 
  private:
   using MemberColumnMap = std::map<std::string, size_t>;
@@ -39,9 +80,16 @@ class ArchiveClassRegistration {
 
   bool CreateTable();
 
+  std::string CreateInsertStatementString() const;
+
+  std::string CreateQueryStatementString(bool single) const;
+
   ArchiveDatabase& database_;
   const ArchiveDef definition_;
   MemberColumnMap column_map_;
+  mutable StatementPool insert_statements_;
+  mutable StatementPool query_single_statements_;
+  mutable StatementPool query_all_statements_;
   bool is_valid_ = false;
 
   ArchiveClassRegistration(const ArchiveClassRegistration&) = delete;
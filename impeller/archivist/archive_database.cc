@@ -59,6 +59,10 @@ ArchiveDatabase::ArchiveDatabase(const std::string& filename)
     return;
   }
 
+  if (!ConfigureJournal()) {
+    VALIDATION_LOG << "Could not enable write-ahead logging for the archive.";
+  }
+
   begin_transaction_stmt_ = std::unique_ptr<ArchiveStatement>(
       new ArchiveStatement(handle_->Get(), "BEGIN TRANSACTION;"));
 
@@ -132,6 +136,27 @@ ArchiveStatement ArchiveDatabase::CreateStatement(
   return ArchiveStatement{handle_ ? handle_->Get() : nullptr, statementString};
 }
 
+std::unique_ptr<ArchiveStatement> ArchiveDatabase::PrepareStatement(
+    const std::string& statementString) const {
+  return std::unique_ptr<ArchiveStatement>(new ArchiveStatement(
+      handle_ ? handle_->Get() : nullptr, statementString));
+}
+
+bool ArchiveDatabase::ConfigureJournal() {
+  /*
+   *  With a write-ahead log, commits append to the log instead of rewriting
+   *  the database, and only checkpoints need to sync it.
+   */
+  auto journal_mode = CreateStatement("PRAGMA journal_mode = WAL;");
+  if (!journal_mode.IsValid() ||
+      journal_mode.Execute() != ArchiveStatement::Result::kRow) {
+    return false;
+  }
+  auto synchronous = CreateStatement("PRAGMA synchronous = NORMAL;");
+  return synchronous.IsValid() &&
+         synchronous.Execute() == ArchiveStatement::Result::kDone;
+}
+
 ArchiveTransaction ArchiveDatabase::CreateTransaction(
     int64_t& transactionCount) {
   return ArchiveTransaction{transactionCount,          //
@@ -48,6 +48,11 @@ class ArchiveDatabase {
 
   ArchiveStatement CreateStatement(const std::string& statementString) const;
 
+  std::unique_ptr<ArchiveStatement> PrepareStatement(
+      const std::string& statementString) const;
+
+  bool ConfigureJournal();
+
   ArchiveDatabase(const ArchiveDatabase&) = delete;
 
   ArchiveDatabase& operator=(const ArchiveDatabase&) = delete;
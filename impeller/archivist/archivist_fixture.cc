@@ -32,8 +32,12 @@ void ArchivistFixture::TearDown() {
 
 void ArchivistFixture::DeleteArchiveFile() const {
   auto fixtures = flutter::testing::OpenFixturesDirectory();
-  if (fml::FileExists(fixtures, archive_file_name_.c_str())) {
-    fml::UnlinkFile(fixtures, archive_file_name_.c_str());
+  // Archives are journaled in a write-ahead log next to the database.
+  for (const auto* suffix : {"", "-wal", "-shm"}) {
+    const auto file_name = archive_file_name_ + suffix;
+    if (fml::FileExists(fixtures, file_name.c_str())) {
+      fml::UnlinkFile(fixtures, file_name.c_str());
+    }
   }
 }
 
@@ -5,6 +5,7 @@
 #include <cstdio>
 #include <thread>
 
+#include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/testing.h"
 #include "impeller/archivist/archive.h"
@@ -107,6 +108,50 @@ const ArchiveDef SampleWithVector::kArchiveDefinition = {
     .members = {"hello", "samples"},
 };
 
+class Node : public Archivable {
+ public:
+  explicit Node(uint64_t value = 0, bool fails_to_write = false)
+      : value_(value), fails_to_write_(fails_to_write) {}
+
+  Node(Node&&) = default;
+
+  uint64_t GetValue() const { return value_; }
+
+  const std::vector<Node>& GetChildren() const { return children_; }
+
+  void AddChild(Node child) { children_.emplace_back(std::move(child)); }
+
+  // |Archivable|
+  PrimaryKey GetPrimaryKey() const override { return std::nullopt; }
+
+  // |Archivable|
+  bool Write(ArchiveLocation& item) const override {
+    return !fails_to_write_ && item.Write("value", value_) &&
+           item.Write("children", children_);
+  };
+
+  // |Archivable|
+  bool Read(ArchiveLocation& item) override {
+    return item.Read("value", value_) && item.Read("children", children_);
+  };
+
+  static const ArchiveDef kArchiveDefinition;
+
+ private:
+  uint64_t value_ = 0;
+  bool fails_to_write_ = false;
+  std::vector<Node> children_;
+
+  Node(const Node&) = delete;
+
+  Node& operator=(const Node&) = delete;
+};
+
+const ArchiveDef Node::kArchiveDefinition = {
+    .table_name = "Node",
+    .members = {"value", "children"},
+};
+
 using ArchiveTest = ArchivistFixture;
 
 TEST_F(ArchiveTest, SimpleInitialization) {
@@ -203,6 +248,63 @@ TEST_F(ArchiveTest, CanReadWriteVectorOfArchivables) {
   ASSERT_TRUE(read_success);
 }
 
+TEST_F(ArchiveTest, CanWriteNestedInstancesOfTheSameClass) {
+  Archive archive(GetArchiveFileName().c_str());
+  ASSERT_TRUE(archive.IsValid());
+
+  Node root(1);
+  Node child(2);
+  child.AddChild(Node(3));
+  root.AddChild(std::move(child));
+  root.AddChild(Node(4));
+  std::vector<Node> nodes;
+  nodes.emplace_back(std::move(root));
+  ASSERT_TRUE(archive.Write(nodes));
+
+  // Children are written before their parents.
+  std::vector<uint64_t> values;
+  ASSERT_EQ(archive.Read<Node>([&](ArchiveLocation& location) -> bool {
+    Node node;
+    EXPECT_TRUE(node.Read(location));
+    values.push_back(node.GetValue());
+    return true;
+  }),
+            4u);
+  ASSERT_EQ(values, (std::vector<uint64_t>{3, 2, 4, 1}));
+}
+
+TEST_F(ArchiveTest, FailedBatchWritesNothing) {
+  Archive archive(GetArchiveFileName().c_str());
+  ASSERT_TRUE(archive.IsValid());
+
+  std::vector<Node> nodes;
+  nodes.emplace_back(1);
+  nodes.emplace_back(2, /*fails_to_write=*/true);
+  ASSERT_FALSE(archive.Write(nodes));
+
+  ASSERT_EQ(archive.Read<Node>([](ArchiveLocation&) { return true; }),
+            0u);
+}
+
+TEST_F(ArchiveTest, CanWriteAndReadManySamplesInOneBatch) {
+  Archive archive(GetArchiveFileName().c_str());
+  ASSERT_TRUE(archive.IsValid());
+
+  const size_t count = 10000u;
+  std::vector<Sample> samples;
+  samples.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    samples.emplace_back(i);
+  }
+
+  ASSERT_TRUE(archive.Write(samples));
+  size_t read_count = archive.Read<Sample>([&](ArchiveLocation& location) {
+    Sample sample;
+    return sample.Read(location);
+  });
+  ASSERT_EQ(read_count, count);
+}
+
 }  // namespace testing
 }  // namespace impeller
 
@@ -150,6 +150,22 @@ struct {{camel_case(shader_name)}}{{camel_case(shader_stage)}}Shader {
   };
 {% endif %}
 
+  // ===========================================================================
+  // Specialization Constants ==================================================
+  // ===========================================================================
+{% for constant in specialization_constants %}
+  static constexpr auto kSpecializationConstant{{camel_case(constant.name)}} = ShaderSpecializationConstant { // {{constant.name}}
+    "{{constant.name}}",          // name
+    {{constant.constant_id}}u,    // constant id
+    {{constant.default_value}}f,  // default value
+  };
+{% endfor %}
+  static constexpr std::array<const ShaderSpecializationConstant*, {{length(specialization_constants)}}> kAllSpecializationConstants = {
+{% for constant in specialization_constants %}
+    &kSpecializationConstant{{camel_case(constant.name)}}, // {{constant.name}}
+{% endfor %}
+  };
+
   // ===========================================================================
   // Resource Binding Utilities ================================================
   // ===========================================================================
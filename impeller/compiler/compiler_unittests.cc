@@ -127,6 +127,27 @@ TEST_P(CompilerTest, UniformsHaveBindingAndSet) {
   ASSERT_EQ(vert_uniform_binding.binding, 17u);
 }
 
+TEST_P(CompilerTest, ReflectsSpecializationConstants) {
+  if (GetParam() == TargetPlatform::kSkSL) {
+    GTEST_SKIP() << "Not supported with SkSL";
+  }
+  ASSERT_TRUE(CanCompileAndReflect("specialization_constants.frag",
+                                   SourceType::kFragmentShader));
+
+  auto json_fd = GetReflectionJson("specialization_constants.frag");
+  nlohmann::json shader_json = nlohmann::json::parse(json_fd->GetMapping());
+  const auto& constants = shader_json["specialization_constants"];
+  ASSERT_EQ(constants.size(), 2u);
+
+  // Ordered by constant ID, not by declaration.
+  EXPECT_EQ(constants[0]["name"].get<std::string>(), "supports_decal");
+  EXPECT_EQ(constants[0]["constant_id"].get<uint32_t>(), 0u);
+  EXPECT_EQ(constants[0]["default_value"].get<float>(), 1.0f);
+  EXPECT_EQ(constants[1]["name"].get<std::string>(), "tile_mode");
+  EXPECT_EQ(constants[1]["constant_id"].get<uint32_t>(), 1u);
+  EXPECT_EQ(constants[1]["default_value"].get<float>(), 0.0f);
+}
+
 TEST_P(CompilerTest, SkSLTextureLookUpOrderOfOperations) {
   if (GetParam() != TargetPlatform::kSkSL) {
     GTEST_SKIP() << "Only supported on SkSL";
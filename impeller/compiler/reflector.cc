@@ -269,6 +269,17 @@ std::optional<nlohmann::json> Reflector::GenerateTemplateArguments() const {
     return std::nullopt;
   }
 
+  // Specialization constants. The workgroup size of compute shaders is
+  // specialized by the backends themselves.
+  if (execution_model == spv::ExecutionModelGLCompute) {
+    root["specialization_constants"] = nlohmann::json::array_t{};
+  } else if (auto constants = ReflectSpecializationConstants();
+             constants.has_value()) {
+    root["specialization_constants"] = std::move(constants.value());
+  } else {
+    return std::nullopt;
+  }
+
   {
     auto& struct_definitions = root["struct_definitions"] =
         nlohmann::json::array_t{};
@@ -431,6 +442,38 @@ std::shared_ptr<fml::Mapping> Reflector::InflateTemplate(
       inflated_template->size(), [inflated_template](auto, auto) {});
 }
 
+// The backends pass the values of the constants of a pipeline as an array
+// of floats indexed by constant ID.
+std::optional<nlohmann::json::array_t>
+Reflector::ReflectSpecializationConstants() const {
+  const auto constants = compiler_->get_specialization_constants();
+  nlohmann::json::array_t result(constants.size());
+  for (const auto& constant : constants) {
+    const auto& value = compiler_->get_constant(constant.id);
+    const auto& type = compiler_->get_type(value.constant_type);
+    const auto name = compiler_->get_name(constant.id);
+    if (type.basetype != spirv_cross::SPIRType::BaseType::Float ||
+        type.vecsize != 1u || type.columns != 1u) {
+      VALIDATION_LOG << "Specialization constant " << name
+                     << " must be a float.";
+      return std::nullopt;
+    }
+    if (constant.constant_id >= constants.size() ||
+        !result[constant.constant_id].is_null()) {
+      VALIDATION_LOG << "The constant IDs of specialization constants must "
+                        "be unique and start at zero. Found "
+                     << constant.constant_id << " for " << name << ".";
+      return std::nullopt;
+    }
+    nlohmann::json::object_t item;
+    item["name"] = name;
+    item["constant_id"] = constant.constant_id;
+    item["default_value"] = value.scalar_f32();
+    result[constant.constant_id] = std::move(item);
+  }
+  return result;
+}
+
 std::vector<size_t> Reflector::ComputeOffsets(
     const spirv_cross::SmallVector<spirv_cross::Resource>& resources) const {
   std::vector<size_t> offsets(resources.size(), 0);
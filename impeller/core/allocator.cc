@@ -4,6 +4,8 @@
 
 #include "impeller/core/allocator.h"
 
+#include <algorithm>
+
 #include "impeller/base/validation.h"
 #include "impeller/core/device_buffer.h"
 #include "impeller/core/formats.h"
@@ -11,6 +13,24 @@
 
 namespace impeller {
 
+namespace {
+
+size_t EstimateTextureBytes(const TextureDescriptor& desc) {
+  size_t bytes = 0u;
+  TextureDescriptor mip_level = desc;
+  for (size_t i = 0; i < desc.mip_count; i++) {
+    mip_level.size = ISize(std::max<int64_t>(desc.size.width >> i, 1),
+                           std::max<int64_t>(desc.size.height >> i, 1));
+    bytes += mip_level.GetByteSizeOfBaseMipLevel();
+  }
+  if (desc.type == TextureType::kTextureCube) {
+    bytes *= 6u;
+  }
+  return bytes * static_cast<size_t>(desc.sample_count);
+}
+
+}  // namespace
+
 Allocator::Allocator() = default;
 
 Allocator::~Allocator() = default;
@@ -43,7 +63,14 @@ std::shared_ptr<DeviceBuffer> Allocator::CreateBufferWithCopy(
 
 std::shared_ptr<DeviceBuffer> Allocator::CreateBuffer(
     const DeviceBufferDescriptor& desc) {
-  return OnCreateBuffer(desc);
+  auto buffer = OnCreateBuffer(desc);
+  // Buffers returned by another allocator are already counted by it.
+  if (buffer && !buffer->allocated_bytes_) {
+    buffer->allocated_bytes_ = buffer_bytes_;
+    buffer->tracked_bytes_ = desc.size;
+    buffer_bytes_->fetch_add(desc.size, std::memory_order_relaxed);
+  }
+  return buffer;
 }
 
 std::shared_ptr<Texture> Allocator::CreateTexture(
@@ -55,7 +82,29 @@ std::shared_ptr<Texture> Allocator::CreateTexture(
     return nullptr;
   }
 
-  return OnCreateTexture(desc);
+  auto texture = OnCreateTexture(desc);
+  if (texture && !texture->allocated_bytes_) {
+    const size_t bytes = EstimateTextureBytes(desc);
+    texture->allocated_bytes_ = texture_bytes_;
+    texture->tracked_bytes_ = bytes;
+    texture_bytes_->fetch_add(bytes, std::memory_order_relaxed);
+  }
+  if (texture && backend_stats_) {
+    backend_stats_->Record(BackendObject::kTexture);
+  }
+  return texture;
+}
+
+size_t Allocator::GetAllocatedBufferBytes() const {
+  return buffer_bytes_->load(std::memory_order_relaxed);
+}
+
+size_t Allocator::GetAllocatedTextureBytes() const {
+  return texture_bytes_->load(std::memory_order_relaxed);
+}
+
+void Allocator::SetBackendStats(std::shared_ptr<BackendStats> backend_stats) {
+  backend_stats_ = std::move(backend_stats);
 }
 
 void Allocator::DidAcquireSurfaceFrame() {}
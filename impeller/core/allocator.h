@@ -5,7 +5,11 @@
 #ifndef FLUTTER_IMPELLER_CORE_ALLOCATOR_H_
 #define FLUTTER_IMPELLER_CORE_ALLOCATOR_H_
 
+#include <atomic>
+#include <memory>
+
 #include "flutter/fml/mapping.h"
+#include "impeller/core/backend_stats.h"
 #include "impeller/core/device_buffer_descriptor.h"
 #include "impeller/core/texture.h"
 #include "impeller/core/texture_descriptor.h"
@@ -44,6 +48,26 @@ class Allocator {
 
   virtual ISize GetMaxTextureSizeSupported() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The number of bytes of the buffers created by this allocator
+  ///             that are still alive.
+  ///
+  size_t GetAllocatedBufferBytes() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      An estimate of the number of bytes of the textures created by
+  ///             this allocator that are still alive, computed from their
+  ///             descriptors. Backends may pad or compress textures, so this
+  ///             is only an approximation of the device memory they hold.
+  ///
+  size_t GetAllocatedTextureBytes() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the statistics that count the textures created by this
+  ///             allocator. Contexts share theirs with their allocator.
+  ///
+  void SetBackendStats(std::shared_ptr<BackendStats> backend_stats);
+
   /// @brief Increment an internal frame used to cycle through a ring buffer of
   /// allocation pools.
   virtual void DidAcquireSurfaceFrame();
@@ -58,6 +82,14 @@ class Allocator {
       const TextureDescriptor& desc) = 0;
 
  private:
+  // Shared with the buffers and textures so that they can outlive the
+  // allocator.
+  std::shared_ptr<std::atomic<size_t>> buffer_bytes_ =
+      std::make_shared<std::atomic<size_t>>(0u);
+  std::shared_ptr<std::atomic<size_t>> texture_bytes_ =
+      std::make_shared<std::atomic<size_t>>(0u);
+  std::shared_ptr<BackendStats> backend_stats_;
+
   Allocator(const Allocator&) = delete;
 
   Allocator& operator=(const Allocator&) = delete;
@@ -79,5 +79,38 @@ TEST(AllocatorTest, TextureDescriptorCompatibility) {
   }
 }
 
+TEST(AllocatorTest, TracksLiveAllocations) {
+  MockAllocator allocator;
+  EXPECT_CALL(allocator, GetMaxTextureSizeSupported())
+      .WillRepeatedly(::testing::Return(ISize(1024, 1024)));
+  EXPECT_CALL(allocator, OnCreateBuffer(::testing::_))
+      .WillRepeatedly([](const DeviceBufferDescriptor& desc)
+                          -> std::shared_ptr<DeviceBuffer> {
+        return std::make_shared<MockDeviceBuffer>(desc);
+      });
+  EXPECT_CALL(allocator, OnCreateTexture(::testing::_))
+      .WillRepeatedly(
+          [](const TextureDescriptor& desc) -> std::shared_ptr<Texture> {
+            return std::make_shared<MockTexture>(desc);
+          });
+
+  auto buffer = allocator.CreateBuffer({.size = 256u});
+  ASSERT_TRUE(buffer);
+  EXPECT_EQ(allocator.GetAllocatedBufferBytes(), 256u);
+
+  // 16x16 + 8x8 + 4x4 RGBA pixels.
+  auto texture =
+      allocator.CreateTexture({.format = PixelFormat::kR8G8B8A8UNormInt,
+                               .size = ISize(16, 16),
+                               .mip_count = 3u});
+  ASSERT_TRUE(texture);
+  EXPECT_EQ(allocator.GetAllocatedTextureBytes(), (256u + 64u + 16u) * 4u);
+
+  buffer.reset();
+  texture.reset();
+  EXPECT_EQ(allocator.GetAllocatedBufferBytes(), 0u);
+  EXPECT_EQ(allocator.GetAllocatedTextureBytes(), 0u);
+}
+
 }  // namespace testing
 }  // namespace impeller
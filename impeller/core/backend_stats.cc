@@ -0,0 +1,60 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/core/backend_stats.h"
+
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+const char* GetBackendObjectName(BackendObject object) {
+  switch (object) {
+    case BackendObject::kCommandBuffer:
+      return "CommandBuffers";
+    case BackendObject::kRenderPass:
+      return "RenderPasses";
+    case BackendObject::kFramebuffer:
+      return "Framebuffers";
+    case BackendObject::kTexture:
+      return "Textures";
+    case BackendObject::kPipeline:
+      return "Pipelines";
+    case BackendObject::kSampler:
+      return "Samplers";
+    case BackendObject::kDescriptorSet:
+      return "DescriptorSets";
+  }
+  return "Unknown";
+}
+
+BackendStats::BackendStats() = default;
+
+BackendStats::~BackendStats() = default;
+
+void BackendStats::Record(BackendObject object, uint32_t count) {
+  created_[static_cast<size_t>(object)].fetch_add(count,
+                                                  std::memory_order_relaxed);
+}
+
+BackendFrameStats BackendStats::EndFrame() {
+  BackendFrameStats stats;
+  for (size_t i = 0; i < kBackendObjectCount; i++) {
+    stats.created[i] = created_[i].exchange(0u, std::memory_order_relaxed);
+  }
+  auto created = [&stats](BackendObject object) {
+    return stats.GetCreated(object);
+  };
+  FML_TRACE_COUNTER(
+      "impeller", "BackendObjectsCreated", reinterpret_cast<int64_t>(this),  //
+      "CommandBuffers", created(BackendObject::kCommandBuffer),              //
+      "RenderPasses", created(BackendObject::kRenderPass),                   //
+      "Framebuffers", created(BackendObject::kFramebuffer),                  //
+      "Textures", created(BackendObject::kTexture),                          //
+      "Pipelines", created(BackendObject::kPipeline),                        //
+      "Samplers", created(BackendObject::kSampler),                          //
+      "DescriptorSets", created(BackendObject::kDescriptorSet));
+  return stats;
+}
+
+}  // namespace impeller
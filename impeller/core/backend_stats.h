@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_CORE_BACKEND_STATS_H_
+#define FLUTTER_IMPELLER_CORE_BACKEND_STATS_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace impeller {
+
+/// The objects of the client rendering APIs whose creation is counted by
+/// |BackendStats|.
+enum class BackendObject : uint8_t {
+  kCommandBuffer,
+  kRenderPass,
+  kFramebuffer,
+  kTexture,
+  kPipeline,
+  kSampler,
+  kDescriptorSet,
+  kLast = kDescriptorSet,
+};
+
+constexpr size_t kBackendObjectCount =
+    static_cast<size_t>(BackendObject::kLast) + 1;
+
+/// @brief The name of |object| for reports, such as "CommandBuffers".
+const char* GetBackendObjectName(BackendObject object);
+
+/// The number of objects of each kind that were created during a frame.
+struct BackendFrameStats {
+  std::array<uint32_t, kBackendObjectCount> created = {};
+
+  uint32_t GetCreated(BackendObject object) const {
+    return created[static_cast<size_t>(object)];
+  }
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Counts the driver objects a context creates in each frame.
+///
+///             Most of these objects should be created once and reused, so a
+///             change that creates some of them every frame shows up in the
+///             counters long before it shows up in the frame times.
+///
+///             Objects may be created on any thread, so recording is atomic.
+///             Frames are ended by the thread that renders them.
+///
+class BackendStats {
+ public:
+  BackendStats();
+
+  ~BackendStats();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Counts the creation of |count| objects of the |object| kind.
+  ///
+  void Record(BackendObject object, uint32_t count = 1u);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Ends the current frame and starts counting the next one.
+  ///
+  ///             The counts of the frame are also traced as the
+  ///             "BackendObjectsCreated" counter.
+  ///
+  /// @return     The objects created since the previous frame ended.
+  ///
+  BackendFrameStats EndFrame();
+
+ private:
+  std::array<std::atomic<uint32_t>, kBackendObjectCount> created_ = {};
+
+  BackendStats(const BackendStats&) = delete;
+
+  BackendStats& operator=(const BackendStats&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_CORE_BACKEND_STATS_H_
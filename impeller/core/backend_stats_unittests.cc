@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <thread>
+
+#include "flutter/testing/testing.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/backend_stats.h"
+#include "impeller/renderer/testing/mocks.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(BackendStatsTest, EndingAFrameResetsTheCounts) {
+  BackendStats stats;
+  stats.Record(BackendObject::kCommandBuffer);
+  stats.Record(BackendObject::kDescriptorSet, 3u);
+
+  std::thread thread([&stats] { stats.Record(BackendObject::kCommandBuffer); });
+  thread.join();
+
+  auto frame = stats.EndFrame();
+  EXPECT_EQ(frame.GetCreated(BackendObject::kCommandBuffer), 2u);
+  EXPECT_EQ(frame.GetCreated(BackendObject::kDescriptorSet), 3u);
+  EXPECT_EQ(frame.GetCreated(BackendObject::kPipeline), 0u);
+
+  auto next_frame = stats.EndFrame();
+  EXPECT_EQ(next_frame.GetCreated(BackendObject::kCommandBuffer), 0u);
+  EXPECT_EQ(next_frame.GetCreated(BackendObject::kDescriptorSet), 0u);
+}
+
+TEST(BackendStatsTest, EveryObjectHasAName) {
+  for (size_t i = 0; i < kBackendObjectCount; i++) {
+    EXPECT_STRNE(GetBackendObjectName(static_cast<BackendObject>(i)),
+                 "Unknown");
+  }
+}
+
+TEST(BackendStatsTest, AllocatorCountsTheTexturesItCreates) {
+  auto stats = std::make_shared<BackendStats>();
+  MockAllocator allocator;
+  allocator.SetBackendStats(stats);
+  EXPECT_CALL(allocator, GetMaxTextureSizeSupported())
+      .WillRepeatedly(::testing::Return(ISize(1024, 1024)));
+  EXPECT_CALL(allocator, OnCreateTexture(::testing::_))
+      .WillRepeatedly(
+          [](const TextureDescriptor& desc) -> std::shared_ptr<Texture> {
+            return std::make_shared<MockTexture>(desc);
+          });
+
+  ASSERT_TRUE(allocator.CreateTexture({.size = ISize(16, 16)}));
+  ASSERT_TRUE(allocator.CreateTexture({.size = ISize(32, 32)}));
+  // Textures that exceed the maximum size are never created.
+  ASSERT_FALSE(allocator.CreateTexture({.size = ISize(2048, 2048)}));
+
+  EXPECT_EQ(stats->EndFrame().GetCreated(BackendObject::kTexture), 2u);
+}
+
+}  // namespace testing
+}  // namespace impeller
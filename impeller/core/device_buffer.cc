@@ -8,7 +8,11 @@ namespace impeller {
 
 DeviceBuffer::DeviceBuffer(DeviceBufferDescriptor desc) : desc_(desc) {}
 
-DeviceBuffer::~DeviceBuffer() = default;
+DeviceBuffer::~DeviceBuffer() {
+  if (allocated_bytes_) {
+    allocated_bytes_->fetch_sub(tracked_bytes_, std::memory_order_relaxed);
+  }
+}
 
 // |Buffer|
 std::shared_ptr<const DeviceBuffer> DeviceBuffer::GetDeviceBuffer(
@@ -16,6 +20,8 @@ std::shared_ptr<const DeviceBuffer> DeviceBuffer::GetDeviceBuffer(
   return shared_from_this();
 }
 
+void DeviceBuffer::Flush(std::optional<Range> range) const {}
+
 BufferView DeviceBuffer::AsBufferView() const {
   BufferView view;
   view.buffer = shared_from_this();
@@ -5,7 +5,9 @@
 #ifndef FLUTTER_IMPELLER_CORE_DEVICE_BUFFER_H_
 #define FLUTTER_IMPELLER_CORE_DEVICE_BUFFER_H_
 
+#include <atomic>
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "impeller/core/allocator.h"
@@ -45,6 +47,16 @@ class DeviceBuffer : public Buffer,
 
   virtual uint8_t* OnGetContents() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Make writes to the contents returned by |OnGetContents| in the
+  ///             given range visible to the device. Writes through
+  ///             |CopyHostBuffer| are flushed automatically.
+  ///
+  /// @param[in]  range  The range that was written to, or std::nullopt for
+  ///                    the entire buffer.
+  ///
+  virtual void Flush(std::optional<Range> range = std::nullopt) const;
+
  protected:
   const DeviceBufferDescriptor desc_;
 
@@ -55,6 +67,13 @@ class DeviceBuffer : public Buffer,
                                 size_t offset) = 0;
 
  private:
+  friend class Allocator;
+
+  // The count of live bytes of the allocator that created this buffer, if
+  // any, and the number of bytes this buffer contributes to it.
+  std::shared_ptr<std::atomic<size_t>> allocated_bytes_;
+  size_t tracked_bytes_ = 0u;
+
   DeviceBuffer(const DeviceBuffer&) = delete;
 
   DeviceBuffer& operator=(const DeviceBuffer&) = delete;
@@ -105,6 +105,11 @@ enum class PixelFormat : uint8_t {
   kB10G10R10XR,
   kB10G10R10XRSRGB,
   kB10G10R10A10XR,
+  // Block compressed formats, that store blocks of 4x4 pixels in 16 bytes.
+  // These can only be sampled from, and only on devices that support them.
+  kASTC4x4UNormInt,
+  kETC2R8G8B8A8UNormInt,
+  kBC7UNormInt,
   // Depth and stencil formats.
   kS8UInt,
   kD24UnormS8Uint,
@@ -160,6 +165,12 @@ constexpr const char* PixelFormatToString(PixelFormat format) {
       return "B10G10R10XRSRGB";
     case PixelFormat::kB10G10R10A10XR:
       return "B10G10R10A10XR";
+    case PixelFormat::kASTC4x4UNormInt:
+      return "ASTC4x4UNormInt";
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+      return "ETC2R8G8B8A8UNormInt";
+    case PixelFormat::kBC7UNormInt:
+      return "BC7UNormInt";
     case PixelFormat::kS8UInt:
       return "S8UInt";
     case PixelFormat::kD24UnormS8Uint:
@@ -465,10 +476,39 @@ constexpr size_t BytesPerPixelForPixelFormat(PixelFormat format) {
       return 8u;
     case PixelFormat::kR32G32B32A32Float:
       return 16u;
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kBC7UNormInt:
+      // Pixels of block compressed formats aren't addressable on their own.
+      return 0u;
   }
   return 0u;
 }
 
+constexpr bool IsBlockCompressedFormat(PixelFormat format) {
+  switch (format) {
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kBC7UNormInt:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// The width and height in pixels of the blocks of a block compressed format,
+/// or 1 for formats that store every pixel on its own.
+constexpr int64_t BlockSizeForPixelFormat(PixelFormat format) {
+  return IsBlockCompressedFormat(format) ? 4 : 1;
+}
+
+/// The number of bytes in a block of a block compressed format, or in a pixel
+/// for other formats.
+constexpr size_t BytesPerBlockForPixelFormat(PixelFormat format) {
+  return IsBlockCompressedFormat(format) ? 16u
+                                         : BytesPerPixelForPixelFormat(format);
+}
+
 //------------------------------------------------------------------------------
 /// @brief      Describe the color attachment that will be used with this
 ///             pipeline.
@@ -8,6 +8,7 @@
 #include <cstring>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/memory/allocation_counter.h"
 
 #include "impeller/core/allocator.h"
 #include "impeller/core/buffer_view.h"
@@ -19,8 +20,16 @@ std::shared_ptr<HostBuffer> HostBuffer::Create() {
   return std::shared_ptr<HostBuffer>(new HostBuffer());
 }
 
+std::shared_ptr<HostBuffer> HostBuffer::Create(
+    const std::shared_ptr<Allocator>& allocator) {
+  return std::shared_ptr<HostBuffer>(new HostBuffer(allocator));
+}
+
 HostBuffer::HostBuffer() = default;
 
+HostBuffer::HostBuffer(std::shared_ptr<Allocator> allocator)
+    : allocator_(std::move(allocator)) {}
+
 HostBuffer::~HostBuffer() = default;
 
 void HostBuffer::SetLabel(std::string label) {
@@ -30,6 +39,18 @@ void HostBuffer::SetLabel(std::string label) {
 BufferView HostBuffer::Emplace(const void* buffer,
                                size_t length,
                                size_t align) {
+  if (allocator_) {
+    auto view = EmplaceToDeviceBuffer(length, align, [&](uint8_t* contents) {
+      if (buffer) {
+        ::memmove(contents, buffer, length);
+      }
+    });
+    // If the allocator turned out not to support mapped buffers, fall back to
+    // the host allocation below.
+    if (view || allocator_) {
+      return view;
+    }
+  }
   auto [device_buffer, range] = state_->Emplace(buffer, length, align);
   if (!device_buffer) {
     return {};
@@ -38,6 +59,9 @@ BufferView HostBuffer::Emplace(const void* buffer,
 }
 
 BufferView HostBuffer::Emplace(const void* buffer, size_t length) {
+  if (allocator_) {
+    return Emplace(buffer, length, 0u);
+  }
   auto [device_buffer, range] = state_->Emplace(buffer, length);
   if (!device_buffer) {
     return {};
@@ -48,6 +72,12 @@ BufferView HostBuffer::Emplace(const void* buffer, size_t length) {
 BufferView HostBuffer::Emplace(size_t length,
                                size_t align,
                                const EmplaceProc& cb) {
+  if (allocator_ && cb) {
+    auto view = EmplaceToDeviceBuffer(length, align, cb);
+    if (view || allocator_) {
+      return view;
+    }
+  }
   auto [buffer, range] = state_->Emplace(length, align, cb);
   if (!buffer) {
     return {};
@@ -60,16 +90,107 @@ std::shared_ptr<const DeviceBuffer> HostBuffer::GetDeviceBuffer(
   return state_->GetDeviceBuffer(allocator);
 }
 
+BufferView HostBuffer::EmplaceToDeviceBuffer(size_t length,
+                                             size_t align,
+                                             const EmplaceProc& cb) {
+  if (length > kAllocatorBlockSize) {
+    auto buffer = CreateDeviceBuffer(length);
+    if (!buffer) {
+      return {};
+    }
+    auto contents = buffer->OnGetContents();
+    cb(contents);
+    buffer->Flush(Range{0u, length});
+    return BufferView{std::move(buffer), contents, Range{0u, length}};
+  }
+
+  auto& buffers = device_buffers_[frame_index_];
+  auto padding =
+      (align == 0u || offset_ % align == 0u) ? 0u : align - offset_ % align;
+  if (current_buffer_ < buffers.size() &&
+      offset_ + padding + length > kAllocatorBlockSize) {
+    current_buffer_++;
+    offset_ = 0u;
+    padding = 0u;
+  }
+  if (current_buffer_ == buffers.size()) {
+    auto buffer = CreateDeviceBuffer(kAllocatorBlockSize);
+    if (!buffer) {
+      return {};
+    }
+    buffers.push_back(std::move(buffer));
+    offset_ = 0u;
+    padding = 0u;
+  }
+
+  const auto& buffer = buffers[current_buffer_];
+  auto contents = buffer->OnGetContents();
+  offset_ += padding;
+  auto range = Range{offset_, length};
+  cb(contents + offset_);
+  buffer->Flush(range);
+  offset_ += length;
+  return BufferView{buffer, contents, range};
+}
+
+std::shared_ptr<DeviceBuffer> HostBuffer::CreateDeviceBuffer(size_t length) {
+  DeviceBufferDescriptor desc;
+  desc.storage_mode = StorageMode::kHostVisible;
+  desc.size = length;
+  auto buffer = allocator_->CreateBuffer(desc);
+  if (!buffer) {
+    return nullptr;
+  }
+  fml::RecordAllocation(fml::AllocationTag::kHostBuffer, length);
+  if (!buffer->OnGetContents()) {
+    // Host visible buffers of this allocator can't be mapped (for example,
+    // managed buffers on Macs without unified memory).
+    allocator_.reset();
+    return nullptr;
+  }
+  if (!state_->label.empty()) {
+    buffer->SetLabel(state_->label);
+  }
+  return buffer;
+}
+
 void HostBuffer::Reset() {
-  state_->Reset();
+  if (!allocator_) {
+    state_->Reset();
+    return;
+  }
+  frame_index_ = (frame_index_ + 1u) % kHostBufferArenaSize;
+  current_buffer_ = 0u;
+  offset_ = 0u;
+  // Anything still holding on to a block of this frame, like a command buffer
+  // that the device hasn't finished yet, may still read from it.
+  auto& buffers = device_buffers_[frame_index_];
+  buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                               [](const auto& buffer) {
+                                 return buffer.use_count() > 1;
+                               }),
+                buffers.end());
 }
 
 size_t HostBuffer::GetSize() const {
-  return state_->GetReservedLength();
+  if (!allocator_) {
+    return state_->GetReservedLength();
+  }
+  size_t size = 0u;
+  for (const auto& buffers : device_buffers_) {
+    size += buffers.size() * kAllocatorBlockSize;
+  }
+  return size;
 }
 
 size_t HostBuffer::GetLength() const {
-  return state_->GetLength();
+  if (!allocator_) {
+    return state_->GetLength();
+  }
+  if (device_buffers_[frame_index_].empty()) {
+    return 0u;
+  }
+  return current_buffer_ * kAllocatorBlockSize + offset_;
 }
 
 std::pair<uint8_t*, Range> HostBuffer::HostBufferState::Emplace(
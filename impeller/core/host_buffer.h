@@ -6,9 +6,11 @@
 #define FLUTTER_IMPELLER_CORE_HOST_BUFFER_H_
 
 #include <algorithm>
+#include <array>
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "impeller/base/allocation.h"
 #include "impeller/core/buffer.h"
@@ -17,10 +19,42 @@
 
 namespace impeller {
 
+class Allocator;
+class DeviceBuffer;
+
 class HostBuffer final : public Buffer {
  public:
+  /// The number of frames the device buffers of a host buffer created with an
+  /// allocator are rotated through.
+  static constexpr size_t kHostBufferArenaSize = 3u;
+
+  /// The size of each device buffer block of a host buffer created with an
+  /// allocator. Larger emplacements get a dedicated device buffer.
+  static constexpr size_t kAllocatorBlockSize = 1024000u;
+
   static std::shared_ptr<HostBuffer> Create();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Create a host buffer that emplaces data directly into
+  ///             persistently mapped, host visible device buffers instead of
+  ///             copying a host allocation into a new device buffer every time
+  ///             its contents change.
+  ///
+  ///             The device buffers are kept in a ring of
+  ///             |kHostBufferArenaSize| frames and are reused by |Reset|.
+  ///             Blocks that are still referenced by unfinished work when their
+  ///             frame comes around again are replaced instead of overwritten.
+  ///
+  ///             If the allocator can not map its host visible buffers, the
+  ///             host buffer falls back to copying like the one returned by
+  ///             |Create()|.
+  ///
+  ///             Like all host buffers, this must only be used from one thread
+  ///             at a time.
+  ///
+  static std::shared_ptr<HostBuffer> Create(
+      const std::shared_ptr<Allocator>& allocator);
+
   // |Buffer|
   virtual ~HostBuffer();
 
@@ -111,7 +145,8 @@ class HostBuffer final : public Buffer {
 
   //----------------------------------------------------------------------------
   /// @brief Resets the contents of the HostBuffer to nothing so it can be
-  ///        reused.
+  ///        reused. For host buffers created with an allocator, this moves on
+  ///        to the device buffers of the next frame.
   void Reset();
 
   //----------------------------------------------------------------------------
@@ -149,6 +184,19 @@ class HostBuffer final : public Buffer {
 
   std::shared_ptr<HostBufferState> state_ = std::make_shared<HostBufferState>();
 
+  std::shared_ptr<Allocator> allocator_;
+  std::array<std::vector<std::shared_ptr<DeviceBuffer>>, kHostBufferArenaSize>
+      device_buffers_;
+  size_t frame_index_ = 0u;
+  size_t current_buffer_ = 0u;
+  size_t offset_ = 0u;
+
+  [[nodiscard]] BufferView EmplaceToDeviceBuffer(size_t length,
+                                                 size_t align,
+                                                 const EmplaceProc& cb);
+
+  std::shared_ptr<DeviceBuffer> CreateDeviceBuffer(size_t length);
+
   // |Buffer|
   std::shared_ptr<const DeviceBuffer> GetDeviceBuffer(
       Allocator& allocator) const override;
@@ -157,6 +205,8 @@ class HostBuffer final : public Buffer {
 
   HostBuffer();
 
+  explicit HostBuffer(std::shared_ptr<Allocator> allocator);
+
   HostBuffer(const HostBuffer&) = delete;
 
   HostBuffer& operator=(const HostBuffer&) = delete;
@@ -0,0 +1,101 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/core/sampling_capture.h"
+
+namespace impeller {
+
+SamplingCapture::SamplingCapture() = default;
+
+SamplingCapture::~SamplingCapture() = default;
+
+void SamplingCapture::Enable(uint32_t period, size_t draw_capacity) {
+  if (period == 0u) {
+    Disable();
+    return;
+  }
+  period_ = period;
+  draw_capacity_ = draw_capacity;
+  frame_.draws.reserve(draw_capacity);
+  last_frame_.draws.reserve(draw_capacity);
+  passes_.reserve(kMaxPassCount);
+}
+
+void SamplingCapture::Disable() {
+  period_ = 0u;
+  draw_capacity_ = 0u;
+  sampling_frame_ = false;
+  frame_ = {};
+  last_frame_ = {};
+  passes_ = {};
+}
+
+void SamplingCapture::BeginFrame() {
+  const uint64_t frame_number = frame_number_++;
+  sampling_frame_ = IsEnabled() && frame_number % period_ == 0u;
+  if (!sampling_frame_) {
+    return;
+  }
+  frame_.frame_number = frame_number;
+  frame_.pass_count = 0u;
+  frame_.dropped_draw_count = 0u;
+  // Keeps the capacity reserved by |Enable|.
+  frame_.draws.clear();
+  passes_.clear();
+}
+
+void SamplingCapture::EndFrame() {
+  if (!sampling_frame_) {
+    return;
+  }
+  sampling_frame_ = false;
+  // Swapping keeps the buffers of both frames allocated.
+  std::swap(frame_, last_frame_);
+}
+
+void SamplingCapture::BeginPass(const void* pass) {
+  if (!sampling_frame_) {
+    return;
+  }
+  const uint32_t pass_id = frame_.pass_count++;
+  // The address of a pass that ended may be reused by a later pass.
+  for (auto& [started_pass, id] : passes_) {
+    if (started_pass == pass) {
+      id = pass_id;
+      return;
+    }
+  }
+  if (passes_.size() < kMaxPassCount) {
+    passes_.emplace_back(pass, pass_id);
+  }
+}
+
+void SamplingCapture::RecordDraw(const void* pass,
+                                 uint64_t pipeline_hash,
+                                 const Rect& coverage) {
+  if (!sampling_frame_) {
+    return;
+  }
+  if (frame_.draws.size() >= draw_capacity_) {
+    frame_.dropped_draw_count++;
+    return;
+  }
+  frame_.draws.push_back({
+      .pipeline_hash = pipeline_hash,
+      .coverage = coverage,
+      .pass_id = GetPassId(pass),
+  });
+}
+
+uint32_t SamplingCapture::GetPassId(const void* pass) const {
+  // Most draws go to one of the most recently started passes.
+  for (auto it = passes_.rbegin(); it != passes_.rend(); ++it) {
+    if (it->first == pass) {
+      return it->second;
+    }
+  }
+  return kUnknownPassId;
+}
+
+}  // namespace impeller
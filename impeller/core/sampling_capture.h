@@ -0,0 +1,142 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_CORE_SAMPLING_CAPTURE_H_
+#define FLUTTER_IMPELLER_CORE_SAMPLING_CAPTURE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "impeller/geometry/rect.h"
+
+namespace impeller {
+
+/// A draw recorded by |SamplingCapture|.
+struct SampledDraw {
+  /// The hash of the descriptor of the pipeline the draw used, or 0 if the
+  /// draw had no pipeline.
+  uint64_t pipeline_hash = 0u;
+  /// The coverage of the entity that issued the draw, in the coordinates of
+  /// the root pass.
+  Rect coverage;
+  /// The render pass the draw was recorded into, numbered in the order the
+  /// passes of the frame were started.
+  uint32_t pass_id = 0u;
+};
+
+static_assert(std::is_trivially_copyable_v<SampledDraw>,
+              "Sampled draws are copied around as plain bytes.");
+
+/// A frame recorded by |SamplingCapture|.
+struct SampledFrame {
+  /// The index of the frame among all frames the capture has seen.
+  uint64_t frame_number = 0u;
+  /// The number of render passes started during the frame.
+  uint32_t pass_count = 0u;
+  /// The number of draws that did not fit into the buffer.
+  uint32_t dropped_draw_count = 0u;
+  std::vector<SampledDraw> draws;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Records the draws of one frame in every N into a preallocated
+///             buffer, so that overdraw and the number of passes can be
+///             looked at on release builds.
+///
+///             Unlike |Capture|, recording doesn't look up or allocate
+///             anything, and frames that aren't sampled only cost a branch.
+///             The renderer only calls into it when Impeller is built with
+///             `impeller_sampling_capture`, and it records nothing until
+///             sampling is enabled.
+///
+///             Must only be used on the thread that renders the frames of
+///             the context it belongs to.
+///
+class SamplingCapture {
+ public:
+  static constexpr size_t kDefaultDrawCapacity = 4096u;
+
+  static constexpr size_t kMaxPassCount = 256u;
+
+  /// The pass id of draws into passes beyond |kMaxPassCount|.
+  static constexpr uint32_t kUnknownPassId =
+      std::numeric_limits<uint32_t>::max();
+
+  SamplingCapture();
+
+  ~SamplingCapture();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts sampling one frame in every |period| frames. The
+  ///             buffers for |draw_capacity| draws are allocated here, so
+  ///             that recording never allocates.
+  ///
+  void Enable(uint32_t period, size_t draw_capacity = kDefaultDrawCapacity);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stops sampling and frees the buffers.
+  ///
+  void Disable();
+
+  bool IsEnabled() const { return period_ > 0u; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called by the renderer when it starts rendering a frame.
+  ///
+  void BeginFrame();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called by the renderer when it is done rendering a frame. A
+  ///             sampled frame becomes the last sampled frame.
+  ///
+  void EndFrame();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the draws of the current frame are recorded.
+  ///
+  bool IsSamplingFrame() const { return sampling_frame_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called by the renderer when it starts the render pass at
+  ///             |pass|, which draws are then recorded into.
+  ///
+  void BeginPass(const void* pass);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records a draw into |pass| during a sampled frame.
+  ///
+  void RecordDraw(const void* pass,
+                  uint64_t pipeline_hash,
+                  const Rect& coverage);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The last sampled frame. Its draws are empty until a frame
+  ///             has been sampled.
+  ///
+  const SampledFrame& GetLastSampledFrame() const { return last_frame_; }
+
+ private:
+  uint32_t period_ = 0u;
+  size_t draw_capacity_ = 0u;
+  uint64_t frame_number_ = 0u;
+  bool sampling_frame_ = false;
+  SampledFrame frame_;
+  SampledFrame last_frame_;
+  // The passes started during the current frame, with their ids.
+  std::vector<std::pair<const void*, uint32_t>> passes_;
+
+  uint32_t GetPassId(const void* pass) const;
+
+  SamplingCapture(const SamplingCapture&) = delete;
+
+  SamplingCapture& operator=(const SamplingCapture&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_CORE_SAMPLING_CAPTURE_H_
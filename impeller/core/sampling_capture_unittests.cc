@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"
+#include "impeller/core/sampling_capture.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(SamplingCaptureTest, RecordsNothingUntilEnabled) {
+  SamplingCapture capture;
+  int pass;
+  capture.BeginFrame();
+  EXPECT_FALSE(capture.IsSamplingFrame());
+  capture.BeginPass(&pass);
+  capture.RecordDraw(&pass, 1u, Rect::MakeXYWH(0, 0, 10, 10));
+  capture.EndFrame();
+  EXPECT_TRUE(capture.GetLastSampledFrame().draws.empty());
+}
+
+TEST(SamplingCaptureTest, SamplesOneFrameInEveryPeriod) {
+  SamplingCapture capture;
+  capture.Enable(3u);
+  int pass;
+  for (int i = 0; i < 5; i++) {
+    capture.BeginFrame();
+    EXPECT_EQ(capture.IsSamplingFrame(), i % 3 == 0);
+    capture.BeginPass(&pass);
+    capture.RecordDraw(&pass, i, Rect::MakeXYWH(0, 0, 10, 10));
+    capture.EndFrame();
+  }
+
+  const SampledFrame& frame = capture.GetLastSampledFrame();
+  EXPECT_EQ(frame.frame_number, 3u);
+  ASSERT_EQ(frame.draws.size(), 1u);
+  EXPECT_EQ(frame.draws[0].pipeline_hash, 3u);
+
+  capture.Disable();
+  capture.BeginFrame();
+  EXPECT_FALSE(capture.IsSamplingFrame());
+  EXPECT_TRUE(capture.GetLastSampledFrame().draws.empty());
+}
+
+TEST(SamplingCaptureTest, NumbersPassesInTheOrderTheyStart) {
+  SamplingCapture capture;
+  capture.Enable(1u);
+  int parent_pass;
+  int subpass;
+  int unknown_pass;
+  capture.BeginFrame();
+  capture.BeginPass(&parent_pass);
+  capture.RecordDraw(&parent_pass, 1u, Rect::MakeXYWH(0, 0, 10, 10));
+  capture.BeginPass(&subpass);
+  capture.RecordDraw(&subpass, 2u, Rect::MakeXYWH(0, 0, 5, 5));
+  capture.RecordDraw(&parent_pass, 3u, Rect::MakeXYWH(5, 5, 5, 5));
+  capture.RecordDraw(&unknown_pass, 4u, Rect::MakeXYWH(0, 0, 1, 1));
+  // A new pass at the address of an ended pass gets a new id.
+  capture.BeginPass(&subpass);
+  capture.RecordDraw(&subpass, 5u, Rect::MakeXYWH(0, 0, 5, 5));
+  capture.EndFrame();
+
+  const SampledFrame& frame = capture.GetLastSampledFrame();
+  EXPECT_EQ(frame.pass_count, 3u);
+  ASSERT_EQ(frame.draws.size(), 5u);
+  EXPECT_EQ(frame.draws[0].pass_id, 0u);
+  EXPECT_EQ(frame.draws[1].pass_id, 1u);
+  EXPECT_EQ(frame.draws[2].pass_id, 0u);
+  EXPECT_EQ(frame.draws[2].coverage, Rect::MakeXYWH(5, 5, 5, 5));
+  EXPECT_EQ(frame.draws[3].pass_id, SamplingCapture::kUnknownPassId);
+  EXPECT_EQ(frame.draws[4].pass_id, 2u);
+}
+
+TEST(SamplingCaptureTest, DropsDrawsBeyondTheCapacity) {
+  SamplingCapture capture;
+  capture.Enable(1u, 2u);
+  int pass;
+  capture.BeginFrame();
+  capture.BeginPass(&pass);
+  for (int i = 0; i < 5; i++) {
+    capture.RecordDraw(&pass, i, Rect::MakeXYWH(0, 0, 10, 10));
+  }
+  capture.EndFrame();
+
+  const SampledFrame& frame = capture.GetLastSampledFrame();
+  EXPECT_EQ(frame.draws.size(), 2u);
+  EXPECT_EQ(frame.dropped_draw_count, 3u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -91,6 +91,21 @@ struct ShaderUniformSlot {
   size_t binding;
 };
 
+/// @brief A specialization constant of a shader stage.
+///
+/// Pipelines are specialized with one value per constant, indexed by
+/// `constant_id`.
+struct ShaderSpecializationConstant {
+  /// @brief The name of the constant.
+  const char* name;
+
+  /// @brief The `constant_id` of the constant in the shader.
+  size_t constant_id;
+
+  /// @brief The value of the constant if the pipeline does not override it.
+  float default_value;
+};
+
 /// @brief Metadata required to bind a combined texture and sampler.
 ///
 /// OpenGL binding requires the usage of the separate shader metadata struct.
@@ -10,7 +10,11 @@ namespace impeller {
 
 Texture::Texture(TextureDescriptor desc) : desc_(desc) {}
 
-Texture::~Texture() = default;
+Texture::~Texture() {
+  if (allocated_bytes_) {
+    allocated_bytes_->fetch_sub(tracked_bytes_, std::memory_order_relaxed);
+  }
+}
 
 bool Texture::SetContents(const uint8_t* contents,
                           size_t length,
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_IMPELLER_CORE_TEXTURE_H_
 #define FLUTTER_IMPELLER_CORE_TEXTURE_H_
 
+#include <atomic>
+#include <memory>
 #include <string_view>
 
 #include "flutter/fml/mapping.h"
@@ -61,6 +63,14 @@ class Texture {
   bool mipmap_generated_ = false;
 
  private:
+  friend class Allocator;
+  friend class BlitPass;
+
+  // The count of live bytes of the allocator that created this texture, if
+  // any, and the number of bytes this texture contributes to it.
+  std::shared_ptr<std::atomic<size_t>> allocated_bytes_;
+  size_t tracked_bytes_ = 0u;
+
   TextureCoordinateSystem coordinate_system_ =
       TextureCoordinateSystem::kRenderToTexture;
   const TextureDescriptor desc_;
@@ -49,14 +49,20 @@ struct TextureDescriptor {
     if (!IsValid()) {
       return 0u;
     }
-    return size.Area() * BytesPerPixelForPixelFormat(format);
+    const int64_t block_size = BlockSizeForPixelFormat(format);
+    const int64_t block_rows = (size.height + block_size - 1) / block_size;
+    return block_rows * GetBytesPerRow();
   }
 
+  /// The number of bytes in a row of pixels, or in a row of blocks for block
+  /// compressed formats.
   constexpr size_t GetBytesPerRow() const {
     if (!IsValid()) {
       return 0u;
     }
-    return size.width * BytesPerPixelForPixelFormat(format);
+    const int64_t block_size = BlockSizeForPixelFormat(format);
+    const int64_t block_columns = (size.width + block_size - 1) / block_size;
+    return block_columns * BytesPerBlockForPixelFormat(format);
   }
 
   constexpr bool SamplingOptionsAreValid() const {
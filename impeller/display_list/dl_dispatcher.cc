@@ -17,6 +17,7 @@
 #include "impeller/core/formats.h"
 #include "impeller/display_list/dl_vertices_geometry.h"
 #include "impeller/display_list/nine_patch_converter.h"
+#include "impeller/display_list/path_conversion_cache.h"
 #include "impeller/display_list/skia_conversions.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
@@ -756,7 +757,8 @@ void DlDispatcher::clipPath(const SkPath& path, ClipOp sk_op, bool is_aa) {
                         skia_conversions::ToSize(rrect.getSimpleRadii()),
                         clip_op);
     } else {
-      canvas_.ClipPath(skia_conversions::ToPath(path), clip_op);
+      canvas_.ClipPath(PathConversionCache::GetForProcess().ToPath(path),
+                       clip_op);
     }
   }
 }
@@ -844,7 +846,7 @@ void DlDispatcher::SimplifyOrDrawPath(CanvasType& canvas,
     return;
   }
 
-  canvas.DrawPath(skia_conversions::ToPath(path), paint);
+  canvas.DrawPath(PathConversionCache::GetForProcess().ToPath(path), paint);
 }
 
 // |flutter::DlOpReceiver|
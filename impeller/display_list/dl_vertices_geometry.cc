@@ -4,6 +4,8 @@
 
 #include "impeller/display_list/dl_vertices_geometry.h"
 
+#include <utility>
+
 #include "display_list/dl_vertices.h"
 #include "impeller/display_list/skia_conversions.h"
 #include "impeller/entity/geometry/vertices_geometry.h"
@@ -17,6 +19,13 @@ static Rect ToRect(const SkRect& rect) {
   return Rect::MakeLTRB(rect.fLeft, rect.fTop, rect.fRight, rect.fBottom);
 }
 
+// Points have the layout of SkPoints, so they are copied in bulk.
+static std::vector<Point> ToPoints(const SkPoint* points, int count) {
+  static_assert(sizeof(Point) == sizeof(SkPoint));
+  const Point* begin = reinterpret_cast<const Point*>(points);
+  return std::vector<Point>(begin, begin + count);
+}
+
 static VerticesGeometry::VertexMode ToVertexMode(flutter::DlVertexMode mode) {
   switch (mode) {
     case flutter::DlVertexMode::kTriangles:
@@ -32,15 +41,9 @@ std::shared_ptr<impeller::VerticesGeometry> MakeVertices(
     const flutter::DlVertices* vertices) {
   auto bounds = ToRect(vertices->bounds());
   auto mode = ToVertexMode(vertices->mode());
-  std::vector<Point> positions(vertices->vertex_count());
-  for (auto i = 0; i < vertices->vertex_count(); i++) {
-    positions[i] = skia_conversions::ToPoint(vertices->vertices()[i]);
-  }
-
-  std::vector<uint16_t> indices(vertices->index_count());
-  for (auto i = 0; i < vertices->index_count(); i++) {
-    indices[i] = vertices->indices()[i];
-  }
+  auto positions = ToPoints(vertices->vertices(), vertices->vertex_count());
+  std::vector<uint16_t> indices(
+      vertices->indices(), vertices->indices() + vertices->index_count());
 
   std::vector<Color> colors;
   if (vertices->colors()) {
@@ -52,14 +55,12 @@ std::shared_ptr<impeller::VerticesGeometry> MakeVertices(
   }
   std::vector<Point> texture_coordinates;
   if (vertices->texture_coordinates()) {
-    texture_coordinates.reserve(vertices->vertex_count());
-    for (auto i = 0; i < vertices->vertex_count(); i++) {
-      texture_coordinates.push_back(
-          skia_conversions::ToPoint(vertices->texture_coordinates()[i]));
-    }
+    texture_coordinates = ToPoints(vertices->texture_coordinates(),
+                                   vertices->vertex_count());
   }
   return std::make_shared<VerticesGeometry>(
-      positions, indices, texture_coordinates, colors, bounds, mode);
+      std::move(positions), std::move(indices), std::move(texture_coordinates),
+      std::move(colors), bounds, mode);
 }
 
 }  // namespace impeller
@@ -0,0 +1,75 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/display_list/path_conversion_cache.h"
+
+#include "flutter/fml/hash_combine.h"
+#include "impeller/display_list/skia_conversions.h"
+
+namespace impeller {
+
+size_t PathConversionCache::Key::Hash::operator()(const Key& key) const {
+  return fml::HashCombine(key.generation_id, key.fill_type);
+}
+
+PathConversionCache& PathConversionCache::GetForProcess() {
+  static PathConversionCache* cache = new PathConversionCache();
+  return *cache;
+}
+
+PathConversionCache::PathConversionCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+PathConversionCache::~PathConversionCache() = default;
+
+Path PathConversionCache::ToPath(const SkPath& path) {
+  // Volatile paths are about to be edited, so caching them would only evict
+  // paths that are drawn again.
+  if (path.isVolatile()) {
+    return skia_conversions::ToPath(path);
+  }
+
+  const Key key{.generation_id = path.getGenerationID(),
+                .fill_type = path.getFillType()};
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = entries_by_key_.find(key);
+    if (found != entries_by_key_.end()) {
+      entries_.splice(entries_.begin(), entries_, found->second);
+      return found->second->path.Clone();
+    }
+  }
+
+  Path converted = skia_conversions::ToPath(path);
+  const size_t bytes = path.approximateBytesUsed();
+  if (bytes > max_bytes_) {
+    return converted;
+  }
+
+  std::scoped_lock lock(mutex_);
+  // Another thread may have converted the same path in the meantime.
+  if (entries_by_key_.find(key) != entries_by_key_.end()) {
+    return converted;
+  }
+  while (!entries_.empty() && cached_bytes_ + bytes > max_bytes_) {
+    cached_bytes_ -= entries_.back().bytes;
+    entries_by_key_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+  entries_.push_front(Entry{
+      .key = key,
+      .path = converted.Clone(),
+      .bytes = bytes,
+  });
+  entries_by_key_[key] = entries_.begin();
+  cached_bytes_ += bytes;
+  return converted;
+}
+
+size_t PathConversionCache::CachedPathCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+}  // namespace impeller
@@ -0,0 +1,90 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_DISPLAY_LIST_PATH_CONVERSION_CACHE_H_
+#define FLUTTER_IMPELLER_DISPLAY_LIST_PATH_CONVERSION_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "impeller/geometry/path.h"
+#include "third_party/skia/include/core/SkPath.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A least recently used cache of the conversions of `SkPath`s into
+///             Impeller paths.
+///
+///             Paths that are not volatile are usually drawn again in the
+///             following frames, either because the display list that holds
+///             them is retained or because the framework reuses the same
+///             `ui.Path`. Conversions are keyed by the generation ID of the
+///             path, which Skia changes whenever the path is edited, so a hit
+///             always has the content of the path being drawn.
+///
+///             The cache may be used from any thread.
+///
+class PathConversionCache {
+ public:
+  /// The default limit of the memory held by cached paths.
+  static constexpr size_t kDefaultMaxBytes = 2u * 1024u * 1024u;
+
+  /// The cache shared by all display list dispatchers in the process.
+  static PathConversionCache& GetForProcess();
+
+  explicit PathConversionCache(size_t max_bytes = kDefaultMaxBytes);
+
+  ~PathConversionCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Converts |path| like `skia_conversions::ToPath`, reusing the
+  ///             previous conversion of a non-volatile path with the same
+  ///             generation ID and fill type.
+  ///
+  Path ToPath(const SkPath& path);
+
+  // visible for testing.
+  size_t CachedPathCount() const;
+
+ private:
+  struct Key {
+    uint32_t generation_id = 0u;
+    SkPathFillType fill_type = SkPathFillType::kWinding;
+
+    bool operator==(const Key& other) const {
+      return generation_id == other.generation_id &&
+             fill_type == other.fill_type;
+    }
+
+    struct Hash {
+      size_t operator()(const Key& key) const;
+    };
+  };
+
+  struct Entry {
+    Key key;
+    Path path;
+    size_t bytes = 0u;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  const size_t max_bytes_;
+  mutable std::mutex mutex_;
+  // Most recently used first.
+  EntryList entries_;
+  std::unordered_map<Key, EntryList::iterator, Key::Hash> entries_by_key_;
+  size_t cached_bytes_ = 0u;
+
+  PathConversionCache(const PathConversionCache&) = delete;
+
+  PathConversionCache& operator=(const PathConversionCache&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_DISPLAY_LIST_PATH_CONVERSION_CACHE_H_
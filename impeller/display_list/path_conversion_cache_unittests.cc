@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"
+#include "impeller/display_list/path_conversion_cache.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+SkPath CreateTriangle(SkScalar size) {
+  SkPath path;
+  path.moveTo(0, 0);
+  path.lineTo(size, 0);
+  path.lineTo(size, size);
+  path.close();
+  return path;
+}
+
+}  // namespace
+
+TEST(PathConversionCacheTest, ReusesConversionOfTheSamePath) {
+  PathConversionCache cache;
+  SkPath path = CreateTriangle(10);
+
+  Path first = cache.ToPath(path);
+  Path second = cache.ToPath(path);
+  EXPECT_EQ(cache.CachedPathCount(), 1u);
+  EXPECT_EQ(first.GetComponentCount(), second.GetComponentCount());
+  EXPECT_EQ(first.GetBoundingBox(), second.GetBoundingBox());
+}
+
+TEST(PathConversionCacheTest, EditedPathIsConvertedAgain) {
+  PathConversionCache cache;
+  SkPath path = CreateTriangle(10);
+  cache.ToPath(path);
+
+  path.lineTo(20, 20);
+  Path edited = cache.ToPath(path);
+  EXPECT_EQ(cache.CachedPathCount(), 2u);
+  EXPECT_EQ(edited.GetBoundingBox(), Rect::MakeLTRB(0, 0, 20, 20));
+}
+
+TEST(PathConversionCacheTest, FillTypeIsPartOfTheKey) {
+  PathConversionCache cache;
+  SkPath path = CreateTriangle(10);
+  EXPECT_EQ(cache.ToPath(path).GetFillType(), FillType::kNonZero);
+
+  path.setFillType(SkPathFillType::kEvenOdd);
+  EXPECT_EQ(cache.ToPath(path).GetFillType(), FillType::kOdd);
+  EXPECT_EQ(cache.CachedPathCount(), 2u);
+}
+
+TEST(PathConversionCacheTest, DoesNotCacheVolatilePaths) {
+  PathConversionCache cache;
+  SkPath path = CreateTriangle(10);
+  path.setIsVolatile(true);
+
+  Path converted = cache.ToPath(path);
+  EXPECT_EQ(cache.CachedPathCount(), 0u);
+  EXPECT_EQ(converted.GetBoundingBox(), Rect::MakeLTRB(0, 0, 10, 10));
+}
+
+TEST(PathConversionCacheTest, EvictsLeastRecentlyUsedPaths) {
+  SkPath first = CreateTriangle(10);
+  SkPath second = CreateTriangle(20);
+  SkPath third = CreateTriangle(30);
+  PathConversionCache cache(first.approximateBytesUsed() +
+                            second.approximateBytesUsed());
+
+  cache.ToPath(first);
+  cache.ToPath(second);
+  cache.ToPath(third);
+  EXPECT_EQ(cache.CachedPathCount(), 2u);
+}
+
+TEST(PathConversionCacheTest, DoesNotCachePathsLargerThanTheLimit) {
+  SkPath path = CreateTriangle(10);
+  PathConversionCache cache(path.approximateBytesUsed() - 1);
+
+  cache.ToPath(path);
+  EXPECT_EQ(cache.CachedPathCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -123,6 +123,9 @@ Path ToPath(const SkPath& path, Point shift) {
   }
   builder.SetConvexity(path.isConvex() ? Convexity::kConvex
                                        : Convexity::kUnknown);
+  // The volatile path tracker of dart:ui clears the bit once the path has
+  // stayed the same for a few frames.
+  builder.SetVolatile(path.isVolatile());
   builder.Shift(shift);
   auto sk_bounds = path.getBounds().makeOutset(shift.x, shift.y);
   builder.SetBounds(ToRect(sk_bounds));
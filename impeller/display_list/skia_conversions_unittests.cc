@@ -174,5 +174,14 @@ TEST(SkiaConversionsTest, GradientConversionNonMonotonic) {
   ASSERT_TRUE(ScalarNearlyEqual(converted_stops[3], 1.0f));
 }
 
+TEST(SkiaConversionsTest, ToPathForwardsVolatility) {
+  SkPath sk_path;
+  sk_path.moveTo(0, 0).lineTo(10, 0).lineTo(10, 10).close();
+  EXPECT_FALSE(skia_conversions::ToPath(sk_path).IsVolatile());
+
+  sk_path.setIsVolatile(true);
+  EXPECT_TRUE(skia_conversions::ToPath(sk_path).IsVolatile());
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -9,6 +9,7 @@
 #include "flutter/fml/macros.h"
 
 #include "impeller/core/formats.h"
+#include "impeller/core/platform.h"
 #include "impeller/entity/contents/atlas_contents.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/filters/blend_filter_contents.h"
@@ -188,6 +189,103 @@ const std::vector<Color>& AtlasContents::GetColors() const {
   return colors_;
 }
 
+bool AtlasContents::CanDrawInstanced(const ContentContext& renderer) const {
+  if (!renderer.GetDeviceCapabilities().SupportsSSBO() ||
+      texture_coords_.empty()) {
+    return false;
+  }
+  // The sprite transforms are uploaded as 2D affine transforms.
+  for (const auto& transform : transforms_) {
+    if (transform.HasPerspective() || transform.m[2] != 0.0f ||
+        transform.m[6] != 0.0f || transform.m[14] != 0.0f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool AtlasContents::BindSprites(const ContentContext& renderer,
+                                RenderPass& pass,
+                                const Matrix& mvp,
+                                Command& cmd) const {
+  auto& host_buffer = pass.GetTransientsBuffer();
+  const Size texture_size(texture_->GetSize());
+  auto options = OptionsFromPass(pass);
+
+  if (CanDrawInstanced(renderer)) {
+    using VS = AtlasInstancedPipeline::VertexShader;
+
+    // Only the four corners of a unit square are uploaded as vertices, and
+    // the vertex shader places them for each sprite.
+    std::vector<Vector4> sprites;
+    sprites.reserve(texture_coords_.size() * 4);
+    for (size_t i = 0; i < texture_coords_.size(); i++) {
+      const auto& sample_rect = texture_coords_[i];
+      const auto& m = transforms_[i].m;
+      const auto color = colors_[i].Premultiply();
+      sprites.push_back(Vector4(m[0], m[1], m[4], m[5]));
+      sprites.push_back(Vector4(m[12], m[13], sample_rect.GetWidth(),
+                                sample_rect.GetHeight()));
+      sprites.push_back(Vector4(sample_rect.GetLeft() / texture_size.width,
+                                sample_rect.GetTop() / texture_size.height,
+                                sample_rect.GetRight() / texture_size.width,
+                                sample_rect.GetBottom() / texture_size.height));
+      sprites.push_back(Vector4(color.red, color.green, color.blue,
+                                color.alpha));
+    }
+
+    options.primitive_type = PrimitiveType::kTriangleStrip;
+    cmd.pipeline = renderer.GetAtlasInstancedPipeline(options);
+    cmd.BindVertices(VertexBufferBuilder<VS::PerVertexData>{}
+                         .AddVertices({{Point(0, 0)},
+                                       {Point(1, 0)},
+                                       {Point(0, 1)},
+                                       {Point(1, 1)}})
+                         .CreateVertexBuffer(host_buffer));
+    cmd.instance_count = texture_coords_.size();
+    VS::BindSpriteInfo(
+        cmd, host_buffer.Emplace(sprites.data(),
+                                 sprites.size() * sizeof(Vector4),
+                                 DefaultUniformAlignment()));
+
+    VS::FrameInfo frame_info;
+    frame_info.mvp = mvp;
+    frame_info.texture_sampler_y_coord_scale = texture_->GetYCoordScale();
+    VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+    return cmd.pipeline != nullptr;
+  }
+
+  using VS = PorterDuffBlendPipeline::VertexShader;
+
+  constexpr size_t indices[6] = {0, 1, 2, 1, 2, 3};
+  VertexBufferBuilder<VS::PerVertexData> vtx_builder;
+  vtx_builder.Reserve(texture_coords_.size() * 6);
+  for (size_t i = 0; i < texture_coords_.size(); i++) {
+    auto sample_rect = texture_coords_[i];
+    auto matrix = transforms_[i];
+    auto points = sample_rect.GetPoints();
+    auto transformed_points =
+        Rect::MakeSize(sample_rect.GetSize()).GetTransformedPoints(matrix);
+    auto color = colors_[i].Premultiply();
+    for (size_t j = 0; j < 6; j++) {
+      VS::PerVertexData data;
+      data.vertices = transformed_points[indices[j]];
+      data.texture_coords = points[indices[j]] / texture_size;
+      data.color = color;
+      vtx_builder.AppendVertex(data);
+    }
+  }
+
+  cmd.pipeline = renderer.GetPorterDuffBlendPipeline(options);
+  cmd.BindVertices(vtx_builder.CreateVertexBuffer(host_buffer));
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = mvp;
+  frame_info.texture_sampler_y_coord_scale = texture_->GetYCoordScale();
+  VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+  return true;
+}
+
 bool AtlasContents::Render(const ContentContext& renderer,
                            const Entity& entity,
                            RenderPass& pass) const {
@@ -213,44 +311,23 @@ bool AtlasContents::Render(const ContentContext& renderer,
     return child_contents.Render(renderer, entity, pass);
   }
 
-  constexpr size_t indices[6] = {0, 1, 2, 1, 2, 3};
-
   if (blend_mode_ <= BlendMode::kModulate) {
     // Simple Porter-Duff blends can be accomplished without a subpass.
-    using VS = PorterDuffBlendPipeline::VertexShader;
     using FS = PorterDuffBlendPipeline::FragmentShader;
 
-    VertexBufferBuilder<VS::PerVertexData> vtx_builder;
-    vtx_builder.Reserve(texture_coords_.size() * 6);
-    const auto texture_size = texture_->GetSize();
     auto& host_buffer = pass.GetTransientsBuffer();
 
-    for (size_t i = 0; i < texture_coords_.size(); i++) {
-      auto sample_rect = texture_coords_[i];
-      auto matrix = transforms_[i];
-      auto points = sample_rect.GetPoints();
-      auto transformed_points =
-          Rect::MakeSize(sample_rect.GetSize()).GetTransformedPoints(matrix);
-      auto color = colors_[i].Premultiply();
-      for (size_t j = 0; j < 6; j++) {
-        VS::PerVertexData data;
-        data.vertices = transformed_points[indices[j]];
-        data.texture_coords = points[indices[j]] / texture_size;
-        data.color = color;
-        vtx_builder.AppendVertex(data);
-      }
-    }
-
     Command cmd;
     DEBUG_COMMAND_INFO(
         cmd, SPrintF("DrawAtlas Blend (%s)", BlendModeToString(blend_mode_)));
-    cmd.BindVertices(vtx_builder.CreateVertexBuffer(host_buffer));
     cmd.stencil_reference = entity.GetClipDepth();
-    auto options = OptionsFromPass(pass);
-    cmd.pipeline = renderer.GetPorterDuffBlendPipeline(options);
+    const Matrix mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                       entity.GetTransform();
+    if (!BindSprites(renderer, pass, mvp, cmd)) {
+      return false;
+    }
 
     FS::FragInfo frag_info;
-    VS::FrameInfo frame_info;
 
     auto dst_sampler_descriptor = sampler_descriptor_;
     if (renderer.GetDeviceCapabilities().SupportsDecalSamplerAddressMode()) {
@@ -260,7 +337,6 @@ bool AtlasContents::Render(const ContentContext& renderer,
     auto dst_sampler = renderer.GetContext()->GetSamplerLibrary()->GetSampler(
         dst_sampler_descriptor);
     FS::BindTextureSamplerDst(cmd, texture_, dst_sampler);
-    frame_info.texture_sampler_y_coord_scale = texture_->GetYCoordScale();
 
     frag_info.output_alpha = alpha_;
     frag_info.input_alpha = 1.0;
@@ -277,12 +353,6 @@ bool AtlasContents::Render(const ContentContext& renderer,
 
     FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
 
-    frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
-                     entity.GetTransform();
-
-    auto uniform_view = host_buffer.EmplaceUniform(frame_info);
-    VS::BindFrameInfo(cmd, uniform_view);
-
     return pass.AddCommand(std::move(cmd));
   }
 
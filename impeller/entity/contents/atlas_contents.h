@@ -16,6 +16,8 @@
 
 namespace impeller {
 
+struct Command;
+
 struct SubAtlasResult {
   // Sub atlas values.
   std::vector<Rect> sub_texture_coords;
@@ -78,6 +80,17 @@ class AtlasContents final : public Contents {
  private:
   Rect ComputeBoundingBox() const;
 
+  // Whether the sprites can be expanded into quads by the vertex shader of an
+  // instanced draw, instead of on the CPU.
+  bool CanDrawInstanced(const ContentContext& renderer) const;
+
+  // Binds the pipeline, vertices and frame info that draw the colored sprites
+  // with the Porter-Duff blend fragment shader.
+  bool BindSprites(const ContentContext& renderer,
+                   RenderPass& pass,
+                   const Matrix& mvp,
+                   Command& cmd) const;
+
   std::shared_ptr<Texture> texture_;
   std::vector<Rect> texture_coords_;
   std::vector<Color> colors_;
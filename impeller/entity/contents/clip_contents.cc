@@ -57,6 +57,10 @@ Contents::ClipCoverage ClipContents::GetClipCoverage(
       return {
           .type = ClipCoverage::Type::kAppend,
           .coverage = current_clip_coverage->Intersection(coverage.value()),
+          .is_pixel_aligned_rect =
+              geometry_->IsAxisAlignedRect() &&
+              entity.GetTransform().IsTranslationScaleOnly() &&
+              Rect::RoundOut(coverage.value()) == coverage.value(),
       };
   }
   FML_UNREACHABLE();
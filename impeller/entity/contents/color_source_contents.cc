@@ -47,6 +47,12 @@ std::optional<Rect> ColorSourceContents::GetCoverage(
   return geometry_->GetCoverage(entity.GetTransform());
 };
 
+bool ColorSourceContents::OccludesArea(const Entity& entity,
+                                       const Rect& rect) const {
+  return geometry_ && IsOpaque() &&
+         geometry_->CoversArea(entity.GetTransform(), rect);
+}
+
 bool ColorSourceContents::CanInheritOpacity(const Entity& entity) const {
   return true;
 }
@@ -96,6 +96,9 @@ class ColorSourceContents : public Contents {
   // |Contents|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
 
+  // |Contents|
+  bool OccludesArea(const Entity& entity, const Rect& rect) const override;
+
   // |Contents|
   bool CanInheritOpacity(const Entity& entity) const override;
 
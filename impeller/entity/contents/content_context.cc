@@ -4,13 +4,21 @@
 
 #include "impeller/entity/contents/content_context.h"
 
+#include <cinttypes>
+#include <cstdlib>
 #include <memory>
+#include <sstream>
+#include <string_view>
 
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/strings.h"
 #include "impeller/core/formats.h"
 #include "impeller/entity/contents/framebuffer_blend_contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/render_target_cache.h"
+#include "impeller/entity/gradient_cache.h"
+#include "impeller/entity/tessellation_cache.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/pipeline_descriptor.h"
 #include "impeller/renderer/pipeline_library.h"
@@ -145,7 +153,14 @@ void ContentContextOptions::ApplyToPipelineDescriptor(
     StencilAttachmentDescriptor stencil = maybe_stencil.value();
     stencil.stencil_compare = stencil_compare;
     stencil.depth_stencil_pass = stencil_operation;
-    desc.SetStencilAttachmentDescriptors(stencil);
+    if (count_stencil_winding) {
+      StencilAttachmentDescriptor back = stencil;
+      stencil.depth_stencil_pass = StencilOperation::kIncrementWrap;
+      back.depth_stencil_pass = StencilOperation::kDecrementWrap;
+      desc.SetStencilAttachmentDescriptors(stencil, back);
+    } else {
+      desc.SetStencilAttachmentDescriptors(stencil);
+    }
   }
 
   desc.SetPrimitiveType(primitive_type);
@@ -170,6 +185,11 @@ static std::unique_ptr<PipelineT> CreateDefaultPipeline(
   return std::make_unique<PipelineT>(context, desc);
 }
 
+// Render targets are kept for a few frames after their last use so that
+// offscreen passes that are skipped on some frames, like those of layers that
+// toggle or are drawn from the raster cache, can reuse them.
+static constexpr uint32_t kRenderTargetKeepAliveFrameCount = 3u;
+
 ContentContext::ContentContext(
     std::shared_ptr<Context> context,
     std::shared_ptr<TypographerContext> typographer_context,
@@ -183,8 +203,13 @@ ContentContext::ContentContext(
 #endif  // IMPELLER_ENABLE_3D
       render_target_cache_(render_target_allocator == nullptr
                                ? std::make_shared<RenderTargetCache>(
-                                     context_->GetResourceAllocator())
-                               : std::move(render_target_allocator)) {
+                                     context_->GetResourceAllocator(),
+                                     kRenderTargetKeepAliveFrameCount)
+                               : std::move(render_target_allocator)),
+      host_buffer_(HostBuffer::Create(context_->GetResourceAllocator())),
+      tessellation_cache_(std::make_shared<TessellationCache>(
+          context_->GetResourceAllocator())),
+      gradient_cache_(std::make_shared<GradientCache>()) {
   if (!context_ || !context_->IsValid()) {
     return;
   }
@@ -328,6 +353,7 @@ ContentContext::ContentContext(
       {static_cast<Scalar>(BlendSelectValues::kSoftLight), supports_decal});
 
   rrect_blur_pipelines_.CreateDefault(*context_, options_trianglestrip);
+  solid_rrect_fill_pipelines_.CreateDefault(*context_, options_trianglestrip);
   texture_blend_pipelines_.CreateDefault(*context_, options);
   texture_pipelines_.CreateDefault(*context_, options);
   position_uv_pipelines_.CreateDefault(*context_, options);
@@ -347,10 +373,15 @@ ContentContext::ContentContext(
                                                  options_trianglestrip);
   glyph_atlas_pipelines_.CreateDefault(*context_, options);
   glyph_atlas_color_pipelines_.CreateDefault(*context_, options);
+  glyph_atlas_sdf_pipelines_.CreateDefault(*context_, options);
   geometry_color_pipelines_.CreateDefault(*context_, options);
   yuv_to_rgb_filter_pipelines_.CreateDefault(*context_, options_trianglestrip);
   porter_duff_blend_pipelines_.CreateDefault(*context_, options_trianglestrip,
                                              {supports_decal});
+  if (context_->GetCapabilities()->SupportsSSBO()) {
+    atlas_instanced_pipelines_.CreateDefault(*context_, options_trianglestrip,
+                                             {supports_decal});
+  }
   // GLES only shader that is unsupported on macOS.
 #if defined(IMPELLER_ENABLE_OPENGLES) && !defined(FML_OS_MACOSX)
   if (GetContext()->GetBackendType() == Context::BackendType::kOpenGLES) {
@@ -396,11 +427,178 @@ ContentContext::ContentContext(
   clip_pipelines_.SetDefault(options, std::make_unique<ClipPipeline>(
                                           *context_, clip_pipeline_descriptor));
 
+  PrewarmPipelines();
+
   is_valid_ = true;
 }
 
 ContentContext::~ContentContext() = default;
 
+// The first line of a pipeline usage manifest. Every following line is the
+// packed |ContentContextOptions| of a variant in hex followed by a tab and the
+// label of the prototype pipeline it was created from.
+static constexpr std::string_view kPipelineUsageManifestHeader =
+    "impeller-pipeline-usage-manifest 1";
+
+static std::optional<ContentContextOptions> UnpackContentContextOptions(
+    uint64_t packed) {
+  ContentContextOptions options;
+  options.is_for_rrect_blur_clear = (packed >> 0) & 1u;
+  options.wireframe = (packed >> 1) & 1u;
+  options.has_stencil_attachment = (packed >> 2) & 1u;
+  options.count_stencil_winding = (packed >> 3) & 1u;
+  options.color_attachment_pixel_format =
+      static_cast<PixelFormat>((packed >> 16) & 0xff);
+  options.primitive_type = static_cast<PrimitiveType>((packed >> 24) & 0xff);
+  options.stencil_operation =
+      static_cast<StencilOperation>((packed >> 32) & 0xff);
+  options.stencil_compare = static_cast<CompareFunction>((packed >> 40) & 0xff);
+  options.blend_mode = static_cast<BlendMode>((packed >> 48) & 0xff);
+  options.sample_count = static_cast<SampleCount>((packed >> 56) & 0xff);
+
+  if (ContentContextOptions::Hash{}(options) != packed ||
+      options.color_attachment_pixel_format > PixelFormat::kD32FloatS8UInt ||
+      options.primitive_type > PrimitiveType::kPoint ||
+      options.stencil_operation > StencilOperation::kDecrementWrap ||
+      options.stencil_compare > CompareFunction::kGreaterEqual ||
+      options.blend_mode > Entity::kLastPipelineBlendMode ||
+      (options.sample_count != SampleCount::kCount1 &&
+       options.sample_count != SampleCount::kCount4)) {
+    return std::nullopt;
+  }
+  return options;
+}
+
+template <typename Callback>
+void ContentContext::ForEachVariants(const Callback& callback) const {
+#ifdef IMPELLER_DEBUG
+  callback(checkerboard_pipelines_);
+#endif  // IMPELLER_DEBUG
+  callback(solid_fill_pipelines_);
+  callback(linear_gradient_fill_pipelines_);
+  callback(radial_gradient_fill_pipelines_);
+  callback(conical_gradient_fill_pipelines_);
+  callback(sweep_gradient_fill_pipelines_);
+  callback(linear_gradient_ssbo_fill_pipelines_);
+  callback(radial_gradient_ssbo_fill_pipelines_);
+  callback(conical_gradient_ssbo_fill_pipelines_);
+  callback(sweep_gradient_ssbo_fill_pipelines_);
+  callback(rrect_blur_pipelines_);
+  callback(solid_rrect_fill_pipelines_);
+  callback(texture_blend_pipelines_);
+  callback(texture_pipelines_);
+#ifdef IMPELLER_ENABLE_OPENGLES
+  callback(texture_external_pipelines_);
+  callback(tiled_texture_external_pipelines_);
+#endif  // IMPELLER_ENABLE_OPENGLES
+  callback(position_uv_pipelines_);
+  callback(tiled_texture_pipelines_);
+  callback(gaussian_blur_noalpha_decal_pipelines_);
+  callback(gaussian_blur_noalpha_nodecal_pipelines_);
+  callback(border_mask_blur_pipelines_);
+  callback(morphology_filter_pipelines_);
+  callback(color_matrix_color_filter_pipelines_);
+  callback(linear_to_srgb_filter_pipelines_);
+  callback(srgb_to_linear_filter_pipelines_);
+  callback(clip_pipelines_);
+  callback(glyph_atlas_pipelines_);
+  callback(glyph_atlas_color_pipelines_);
+  callback(glyph_atlas_sdf_pipelines_);
+  callback(geometry_color_pipelines_);
+  callback(yuv_to_rgb_filter_pipelines_);
+  callback(porter_duff_blend_pipelines_);
+  callback(atlas_instanced_pipelines_);
+  callback(blend_color_pipelines_);
+  callback(blend_colorburn_pipelines_);
+  callback(blend_colordodge_pipelines_);
+  callback(blend_darken_pipelines_);
+  callback(blend_difference_pipelines_);
+  callback(blend_exclusion_pipelines_);
+  callback(blend_hardlight_pipelines_);
+  callback(blend_hue_pipelines_);
+  callback(blend_lighten_pipelines_);
+  callback(blend_luminosity_pipelines_);
+  callback(blend_multiply_pipelines_);
+  callback(blend_overlay_pipelines_);
+  callback(blend_saturation_pipelines_);
+  callback(blend_screen_pipelines_);
+  callback(blend_softlight_pipelines_);
+  callback(framebuffer_blend_color_pipelines_);
+  callback(framebuffer_blend_colorburn_pipelines_);
+  callback(framebuffer_blend_colordodge_pipelines_);
+  callback(framebuffer_blend_darken_pipelines_);
+  callback(framebuffer_blend_difference_pipelines_);
+  callback(framebuffer_blend_exclusion_pipelines_);
+  callback(framebuffer_blend_hardlight_pipelines_);
+  callback(framebuffer_blend_hue_pipelines_);
+  callback(framebuffer_blend_lighten_pipelines_);
+  callback(framebuffer_blend_luminosity_pipelines_);
+  callback(framebuffer_blend_multiply_pipelines_);
+  callback(framebuffer_blend_overlay_pipelines_);
+  callback(framebuffer_blend_saturation_pipelines_);
+  callback(framebuffer_blend_screen_pipelines_);
+  callback(framebuffer_blend_softlight_pipelines_);
+}
+
+void ContentContext::RecordPipelineUsage(
+    const std::string& label,
+    const ContentContextOptions& opts) const {
+  pipeline_usage_manifest_ +=
+      SPrintF("%" PRIx64 "\t%s\n", ContentContextOptions::Hash{}(opts),
+              label.c_str());
+  pipeline_usage_manifest_changed_ = true;
+}
+
+void ContentContext::PrewarmPipelines() {
+  TRACE_EVENT0("impeller", "ContentContext::PrewarmPipelines");
+  pipeline_usage_manifest_ = std::string{kPipelineUsageManifestHeader} + "\n";
+
+  auto manifest = context_->GetPipelineLibrary()->LoadPipelineUsageManifest();
+  if (!manifest || manifest->GetSize() == 0u) {
+    return;
+  }
+  std::istringstream lines(
+      std::string{reinterpret_cast<const char*>(manifest->GetMapping()),
+                  manifest->GetSize()});
+  std::string line;
+  if (!std::getline(lines, line) || line != kPipelineUsageManifestHeader) {
+    return;
+  }
+
+  // Variants that were used on a previous launch are created here without
+  // waiting so that the pipeline library compiles them on its worker threads
+  // before the first frame that needs them.
+  while (std::getline(lines, line)) {
+    auto tab = line.find('\t');
+    if (tab == std::string::npos) {
+      continue;
+    }
+    auto options = UnpackContentContextOptions(
+        std::strtoull(line.substr(0, tab).c_str(), nullptr, 16));
+    if (!options.has_value()) {
+      continue;
+    }
+    auto label = line.substr(tab + 1);
+    bool prewarmed = false;
+    ForEachVariants([&](auto& variants) {
+      prewarmed = prewarmed || variants.Prewarm(*context_, label, *options);
+    });
+    if (prewarmed) {
+      RecordPipelineUsage(label, *options);
+    }
+  }
+  pipeline_usage_manifest_changed_ = false;
+}
+
+void ContentContext::PersistPipelineUsageManifest() const {
+  if (!pipeline_usage_manifest_changed_) {
+    return;
+  }
+  pipeline_usage_manifest_changed_ = false;
+  context_->GetPipelineLibrary()->PersistPipelineUsageManifest(
+      std::make_shared<fml::DataMapping>(pipeline_usage_manifest_));
+}
+
 bool ContentContext::IsValid() const {
   return is_valid_;
 }
@@ -444,6 +642,11 @@ std::shared_ptr<Texture> ContentContext::MakeSubpass(
     return nullptr;
   }
   sub_renderpass->SetLabel(SPrintF("%s RenderPass", label.c_str()));
+  sub_renderpass->SetTransientsBuffer(GetTransientsBuffer());
+#ifdef IMPELLER_ENABLE_SAMPLING_CAPTURE
+  // The draws of subpasses aren't recorded, but they count as passes.
+  GetContext()->GetSamplingCapture()->BeginPass(sub_renderpass.get());
+#endif
 
   if (!subpass_callback(*this, *sub_renderpass)) {
     return nullptr;
@@ -466,6 +669,15 @@ std::shared_ptr<Tessellator> ContentContext::GetTessellator() const {
   return tessellator_;
 }
 
+std::shared_ptr<TessellationCache> ContentContext::GetTessellationCache()
+    const {
+  return tessellation_cache_;
+}
+
+std::shared_ptr<GradientCache> ContentContext::GetGradientCache() const {
+  return gradient_cache_;
+}
+
 std::shared_ptr<Context> ContentContext::GetContext() const {
   return context_;
 }
@@ -8,12 +8,14 @@
 #include <initializer_list>
 #include <memory>
 #include <optional>
+#include <string>
 #include <unordered_map>
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
+#include "impeller/core/host_buffer.h"
 #include "impeller/entity/entity.h"
 #include "impeller/renderer/capabilities.h"
 #include "impeller/renderer/pipeline.h"
@@ -38,6 +40,7 @@
 #include "impeller/entity/glyph_atlas.frag.h"
 #include "impeller/entity/glyph_atlas.vert.h"
 #include "impeller/entity/glyph_atlas_color.frag.h"
+#include "impeller/entity/glyph_atlas_sdf.frag.h"
 #include "impeller/entity/gradient_fill.vert.h"
 #include "impeller/entity/linear_gradient_fill.frag.h"
 #include "impeller/entity/linear_to_srgb_filter.frag.h"
@@ -52,6 +55,7 @@
 #include "impeller/entity/rrect_blur.vert.h"
 #include "impeller/entity/solid_fill.frag.h"
 #include "impeller/entity/solid_fill.vert.h"
+#include "impeller/entity/solid_rrect_fill.frag.h"
 #include "impeller/entity/srgb_to_linear_filter.frag.h"
 #include "impeller/entity/srgb_to_linear_filter.vert.h"
 #include "impeller/entity/sweep_gradient_fill.frag.h"
@@ -71,6 +75,7 @@
 
 #include "impeller/typographer/glyph_atlas.h"
 
+#include "impeller/entity/atlas_instanced.vert.h"
 #include "impeller/entity/conical_gradient_ssbo_fill.frag.h"
 #include "impeller/entity/linear_gradient_ssbo_fill.frag.h"
 #include "impeller/entity/radial_gradient_ssbo_fill.frag.h"
@@ -123,6 +128,8 @@ using SweepGradientSSBOFillPipeline =
                     SweepGradientSsboFillFragmentShader>;
 using RRectBlurPipeline =
     RenderPipelineT<RrectBlurVertexShader, RrectBlurFragmentShader>;
+using SolidRRectFillPipeline =
+    RenderPipelineT<RrectBlurVertexShader, SolidRrectFillFragmentShader>;
 using BlendPipeline = RenderPipelineT<BlendVertexShader, BlendFragmentShader>;
 using TexturePipeline =
     RenderPipelineT<TextureFillVertexShader, TextureFillFragmentShader>;
@@ -154,8 +161,12 @@ using GlyphAtlasPipeline =
     RenderPipelineT<GlyphAtlasVertexShader, GlyphAtlasFragmentShader>;
 using GlyphAtlasColorPipeline =
     RenderPipelineT<GlyphAtlasVertexShader, GlyphAtlasColorFragmentShader>;
+using GlyphAtlasSdfPipeline =
+    RenderPipelineT<GlyphAtlasVertexShader, GlyphAtlasSdfFragmentShader>;
 using PorterDuffBlendPipeline =
     RenderPipelineT<PorterDuffBlendVertexShader, PorterDuffBlendFragmentShader>;
+using AtlasInstancedPipeline =
+    RenderPipelineT<AtlasInstancedVertexShader, PorterDuffBlendFragmentShader>;
 // Instead of requiring new shaders for clips, the solid fill stages are used
 // to redirect writing to the stencil instead of color attachments.
 using ClipPipeline = RenderPipelineT<ClipVertexShader, ClipFragmentShader>;
@@ -276,6 +287,10 @@ struct ContentContextOptions {
   bool has_stencil_attachment = true;
   bool wireframe = false;
   bool is_for_rrect_blur_clear = false;
+  /// Increment the stencil of front facing triangles and decrement the stencil
+  /// of back facing ones instead of applying |stencil_operation|, leaving the
+  /// nonzero winding count of a path in the stencil buffer.
+  bool count_stencil_winding = false;
 
   struct Hash {
     constexpr uint64_t operator()(const ContentContextOptions& o) const {
@@ -290,6 +305,7 @@ struct ContentContextOptions {
       return (o.is_for_rrect_blur_clear ? 1llu : 0llu) << 0 |
              (o.wireframe ? 1llu : 0llu) << 1 |
              (o.has_stencil_attachment ? 1llu : 0llu) << 2 |
+             (o.count_stencil_winding ? 1llu : 0llu) << 3 |
              // enums
              static_cast<uint64_t>(o.color_attachment_pixel_format) << 16 |
              static_cast<uint64_t>(o.primitive_type) << 24 |
@@ -312,7 +328,8 @@ struct ContentContextOptions {
                  rhs.color_attachment_pixel_format &&
              lhs.has_stencil_attachment == rhs.has_stencil_attachment &&
              lhs.wireframe == rhs.wireframe &&
-             lhs.is_for_rrect_blur_clear == rhs.is_for_rrect_blur_clear;
+             lhs.is_for_rrect_blur_clear == rhs.is_for_rrect_blur_clear &&
+             lhs.count_stencil_winding == rhs.count_stencil_winding;
     }
   };
 
@@ -320,6 +337,8 @@ struct ContentContextOptions {
 };
 
 class Tessellator;
+class GradientCache;
+class TessellationCache;
 class RenderTargetCache;
 
 class ContentContext {
@@ -339,6 +358,12 @@ class ContentContext {
 
   std::shared_ptr<Tessellator> GetTessellator() const;
 
+  /// @brief The cache of path tessellations reused across frames.
+  std::shared_ptr<TessellationCache> GetTessellationCache() const;
+
+  /// @brief The cache of gradient ramp textures reused across frames.
+  std::shared_ptr<GradientCache> GetGradientCache() const;
+
 #ifdef IMPELLER_DEBUG
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetCheckerboardPipeline(
       ContentContextOptions opts) const {
@@ -390,6 +415,11 @@ class ContentContext {
     return GetPipeline(rrect_blur_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetSolidRRectFillPipeline(
+      ContentContextOptions opts) const {
+    return GetPipeline(solid_rrect_fill_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetSweepGradientFillPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(sweep_gradient_fill_pipelines_, opts);
@@ -486,6 +516,11 @@ class ContentContext {
     return GetPipeline(glyph_atlas_color_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetGlyphAtlasSdfPipeline(
+      ContentContextOptions opts) const {
+    return GetPipeline(glyph_atlas_sdf_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetGeometryColorPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(geometry_color_pipelines_, opts);
@@ -501,6 +536,12 @@ class ContentContext {
     return GetPipeline(porter_duff_blend_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetAtlasInstancedPipeline(
+      ContentContextOptions opts) const {
+    FML_DCHECK(GetDeviceCapabilities().SupportsSSBO());
+    return GetPipeline(atlas_instanced_pipelines_, opts);
+  }
+
   // Advanced blends.
 
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetBlendColorPipeline(
@@ -705,6 +746,20 @@ class ContentContext {
     return render_target_cache_;
   }
 
+  /// @brief  The transients buffer shared by the render passes of a frame.
+  ///         It is reset at the end of every `EntityPass::Render`.
+  std::shared_ptr<HostBuffer> GetTransientsBuffer() const {
+    return host_buffer_;
+  }
+
+  /// @brief  Persists the manifest of the pipeline variants used so far if
+  ///         new variants were created since it was last persisted.
+  ///
+  ///         The next `ContentContext` created for a context with the same
+  ///         pipeline library starts compiling these variants in the
+  ///         background as soon as it is constructed.
+  void PersistPipelineUsageManifest() const;
+
  private:
   std::shared_ptr<Context> context_;
   std::shared_ptr<LazyGlyphAtlas> lazy_glyph_atlas_;
@@ -754,6 +809,31 @@ class ContentContext {
       return Get(default_options_.value());
     }
 
+    /// Starts creating the variant for |options| without waiting for it or
+    /// for the prototype.
+    ///
+    /// Returns false if the label of the prototype does not match |label|.
+    bool Prewarm(const Context& context,
+                 const std::string& label,
+                 const ContentContextOptions& options) {
+      auto prototype = GetDefault();
+      if (!prototype) {
+        return false;
+      }
+      auto desc = prototype->GetDescriptor();
+      if (!desc.has_value() || desc->GetLabel() != label) {
+        return false;
+      }
+      if (Get(options)) {
+        return true;
+      }
+      options.ApplyToPipelineDescriptor(*desc);
+      desc->SetLabel(
+          SPrintF("%s V#%zu", desc->GetLabel().c_str(), GetPipelineCount()));
+      Set(options, std::make_unique<PipelineT>(context, desc));
+      return true;
+    }
+
     size_t GetPipelineCount() const { return pipelines_.size(); }
 
    private:
@@ -792,6 +872,7 @@ class ContentContext {
   mutable Variants<SweepGradientSSBOFillPipeline>
       sweep_gradient_ssbo_fill_pipelines_;
   mutable Variants<RRectBlurPipeline> rrect_blur_pipelines_;
+  mutable Variants<SolidRRectFillPipeline> solid_rrect_fill_pipelines_;
   mutable Variants<BlendPipeline> texture_blend_pipelines_;
   mutable Variants<TexturePipeline> texture_pipelines_;
 #ifdef IMPELLER_ENABLE_OPENGLES
@@ -814,9 +895,11 @@ class ContentContext {
   mutable Variants<ClipPipeline> clip_pipelines_;
   mutable Variants<GlyphAtlasPipeline> glyph_atlas_pipelines_;
   mutable Variants<GlyphAtlasColorPipeline> glyph_atlas_color_pipelines_;
+  mutable Variants<GlyphAtlasSdfPipeline> glyph_atlas_sdf_pipelines_;
   mutable Variants<GeometryColorPipeline> geometry_color_pipelines_;
   mutable Variants<YUVToRGBFilterPipeline> yuv_to_rgb_filter_pipelines_;
   mutable Variants<PorterDuffBlendPipeline> porter_duff_blend_pipelines_;
+  mutable Variants<AtlasInstancedPipeline> atlas_instanced_pipelines_;
   // Advanced blends.
   mutable Variants<BlendColorPipeline> blend_color_pipelines_;
   mutable Variants<BlendColorBurnPipeline> blend_colorburn_pipelines_;
@@ -905,15 +988,32 @@ class ContentContext {
     auto variant = std::make_unique<TypedPipeline>(std::move(variant_future));
     auto variant_pipeline = variant->WaitAndGet();
     container.Set(opts, std::move(variant));
+    RecordPipelineUsage(pipeline->GetDescriptor().GetLabel(), opts);
     return variant_pipeline;
   }
 
+  /// Calls |callback| with every container of render pipeline variants.
+  template <typename Callback>
+  void ForEachVariants(const Callback& callback) const;
+
+  void RecordPipelineUsage(const std::string& label,
+                           const ContentContextOptions& opts) const;
+
+  void PrewarmPipelines();
+
   bool is_valid_ = false;
   std::shared_ptr<Tessellator> tessellator_;
 #if IMPELLER_ENABLE_3D
   std::shared_ptr<scene::SceneContext> scene_context_;
 #endif  // IMPELLER_ENABLE_3D
   std::shared_ptr<RenderTargetAllocator> render_target_cache_;
+  std::shared_ptr<HostBuffer> host_buffer_;
+  std::shared_ptr<TessellationCache> tessellation_cache_;
+  std::shared_ptr<GradientCache> gradient_cache_;
+  // The serialized pipeline usage manifest and whether it changed since it
+  // was last persisted.
+  mutable std::string pipeline_usage_manifest_;
+  mutable bool pipeline_usage_manifest_changed_ = false;
   bool wireframe_ = false;
 
   ContentContext(const ContentContext&) = delete;
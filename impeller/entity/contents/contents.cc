@@ -47,6 +47,10 @@ bool Contents::IsOpaque() const {
   return false;
 }
 
+bool Contents::OccludesArea(const Entity& entity, const Rect& rect) const {
+  return false;
+}
+
 Contents::ClipCoverage Contents::GetClipCoverage(
     const Entity& entity,
     const std::optional<Rect>& current_clip_coverage) const {
@@ -125,6 +129,10 @@ const FilterContents* Contents::AsFilter() const {
   return nullptr;
 }
 
+const SolidColorContents* Contents::AsSolidColor() const {
+  return nullptr;
+}
+
 bool Contents::ApplyColorFilter(
     const Contents::ColorFilterProc& color_filter_proc) {
   return false;
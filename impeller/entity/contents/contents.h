@@ -25,6 +25,7 @@ class Entity;
 class Surface;
 class RenderPass;
 class FilterContents;
+class SolidColorContents;
 
 ContentContextOptions OptionsFromPass(const RenderPass& pass);
 
@@ -42,6 +43,10 @@ class Contents {
 
     Type type = Type::kNoChange;
     std::optional<Rect> coverage = std::nullopt;
+    /// Whether an appended clip is exactly the intersection of the current
+    /// clip with a pixel aligned rectangle, so that a scissor rect can stand
+    /// in for writing it to the clip buffer.
+    bool is_pixel_aligned_rect = false;
   };
 
   using RenderProc = std::function<bool(const ContentContext& renderer,
@@ -96,6 +101,16 @@ class Contents {
   ///
   virtual bool IsOpaque() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief Whether rendering this Contents with the given entity overwrites
+  ///        every pixel of the pass space `rect` with an opaque color, so that
+  ///        anything drawn there earlier can be skipped. Like `IsOpaque`, this
+  ///        does not account for the blend mode or clips of the entity.
+  ///
+  ///        It is always safe to return false.
+  ///
+  virtual bool OccludesArea(const Entity& entity, const Rect& rect) const;
+
   //----------------------------------------------------------------------------
   /// @brief Given the current pass space bounding rectangle of the clip
   ///        buffer, return the expected clip coverage after this draw call.
@@ -173,6 +188,12 @@ class Contents {
   ///
   virtual const FilterContents* AsFilter() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief Cast to a solid color. Returns `nullptr` if this Contents is not a
+  ///        `SolidColorContents`.
+  ///
+  virtual const SolidColorContents* AsSolidColor() const;
+
   //----------------------------------------------------------------------------
   /// @brief      If possible, applies a color filter to this contents inputs on
   ///             the CPU.
@@ -26,6 +26,51 @@ void ColorMatrixFilterContents::SetMatrix(const ColorMatrix& matrix) {
   matrix_ = matrix;
 }
 
+const ColorMatrixFilterContents*
+ColorMatrixFilterContents::AsColorMatrixFilter() const {
+  return this;
+}
+
+// Whether every color stays in the [0, 1] range when transformed by |matrix|,
+// so that the filter never clamps its result.
+static bool IsClampFree(const ColorMatrix& matrix) {
+  for (size_t row = 0; row < 4; row++) {
+    const Scalar* coefficients = &matrix.array[row * 5];
+    Scalar min = coefficients[4];
+    Scalar max = coefficients[4];
+    for (size_t column = 0; column < 4; column++) {
+      (coefficients[column] < 0 ? min : max) += coefficients[column];
+    }
+    if (min < 0 || max > 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Whether the alpha computed by |matrix| only scales the input alpha. Colors
+// then only turn transparent if they were transparent to begin with, and
+// don't lose color information to premultiplication in between two filters.
+static bool ScalesAlphaOnly(const ColorMatrix& matrix) {
+  return matrix.array[15] == 0 && matrix.array[16] == 0 &&
+         matrix.array[17] == 0 && matrix.array[19] == 0;
+}
+
+// Returns the matrix that applies |inner| and then |outer|.
+static ColorMatrix Concat(const ColorMatrix& outer, const ColorMatrix& inner) {
+  ColorMatrix result;
+  for (size_t row = 0; row < 4; row++) {
+    for (size_t column = 0; column < 5; column++) {
+      Scalar value = column == 4 ? outer.array[row * 5 + 4] : 0;
+      for (size_t i = 0; i < 4; i++) {
+        value += outer.array[row * 5 + i] * inner.array[i * 5 + column];
+      }
+      result.array[row * 5 + column] = value;
+    }
+  }
+  return result;
+}
+
 std::optional<Entity> ColorMatrixFilterContents::RenderFilter(
     const FilterInput::Vector& inputs,
     const ContentContext& renderer,
@@ -44,7 +89,32 @@ std::optional<Entity> ColorMatrixFilterContents::RenderFilter(
     return std::nullopt;
   }
 
-  auto input_snapshot = inputs[0]->GetSnapshot("ColorMatrix", renderer, entity);
+  // Color matrix filters that this one is applied to are folded into its
+  // matrix, instead of rendering their results to textures first. This only
+  // works if their results are neither clamped nor made transparent.
+  FilterInput::Ref input = inputs[0];
+  ColorMatrix color_matrix = matrix_;
+  AbsorbOpacity absorb_opacity = GetAbsorbOpacity();
+  while (ScalesAlphaOnly(color_matrix)) {
+    FilterInput::Variant input_variant = input->GetInput();
+    auto input_filter =
+        std::get_if<std::shared_ptr<FilterContents>>(&input_variant);
+    if (!input_filter) {
+      break;
+    }
+    auto inner = (*input_filter)->AsColorMatrixFilter();
+    if (!inner || inner->GetInputs().size() != 1u ||
+        !IsClampFree(inner->matrix_) || !ScalesAlphaOnly(inner->matrix_)) {
+      break;
+    }
+    color_matrix = Concat(color_matrix, inner->matrix_);
+    // The texture the inner filter would have rendered to is opaque to this
+    // one, so only the inner filter decides about the input opacity.
+    absorb_opacity = inner->GetAbsorbOpacity();
+    input = inner->GetInputs()[0];
+  }
+
+  auto input_snapshot = input->GetSnapshot("ColorMatrix", renderer, entity);
   if (!input_snapshot.has_value()) {
     return std::nullopt;
   }
@@ -52,8 +122,8 @@ std::optional<Entity> ColorMatrixFilterContents::RenderFilter(
   //----------------------------------------------------------------------------
   /// Create AnonymousContents for rendering.
   ///
-  RenderProc render_proc = [input_snapshot, color_matrix = matrix_,
-                            absorb_opacity = GetAbsorbOpacity()](
+  RenderProc render_proc = [input_snapshot, color_matrix,
+                            absorb_opacity](
                                const ContentContext& renderer,
                                const Entity& entity, RenderPass& pass) -> bool {
     Command cmd;
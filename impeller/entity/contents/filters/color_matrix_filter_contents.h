@@ -23,6 +23,9 @@ class ColorMatrixFilterContents final : public ColorFilterContents {
 
   void SetMatrix(const ColorMatrix& matrix);
 
+  // |FilterContents|
+  const ColorMatrixFilterContents* AsColorMatrixFilter() const override;
+
  private:
   // |FilterContents|
   std::optional<Entity> RenderFilter(
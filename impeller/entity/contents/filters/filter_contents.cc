@@ -166,6 +166,10 @@ void FilterContents::SetInputs(FilterInput::Vector inputs) {
   inputs_ = std::move(inputs);
 }
 
+const FilterInput::Vector& FilterContents::GetInputs() const {
+  return inputs_;
+}
+
 void FilterContents::SetEffectTransform(const Matrix& effect_transform) {
   effect_transform_ = effect_transform;
 
@@ -310,6 +314,10 @@ const FilterContents* FilterContents::AsFilter() const {
   return this;
 }
 
+const ColorMatrixFilterContents* FilterContents::AsColorMatrixFilter() const {
+  return nullptr;
+}
+
 Matrix FilterContents::GetLocalTransform(const Matrix& parent_transform) const {
   return Matrix();
 }
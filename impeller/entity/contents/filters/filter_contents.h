@@ -18,6 +18,8 @@
 
 namespace impeller {
 
+class ColorMatrixFilterContents;
+
 class FilterContents : public Contents {
  public:
   enum class BlurStyle {
@@ -95,6 +97,8 @@ class FilterContents : public Contents {
   ///         particular filter's implementation.
   void SetInputs(FilterInput::Vector inputs);
 
+  const FilterInput::Vector& GetInputs() const;
+
   /// @brief  Sets the transform which gets appended to the effect of this
   ///         filter. Note that this is in addition to the entity's transform.
   ///
@@ -134,6 +138,11 @@ class FilterContents : public Contents {
   // |Contents|
   const FilterContents* AsFilter() const override;
 
+  /// @brief  Returns this filter if it only transforms the colors of its
+  ///         input with a color matrix, so that chained color matrices can be
+  ///         applied in one pass.
+  virtual const ColorMatrixFilterContents* AsColorMatrixFilter() const;
+
   /// @brief  Determines the coverage of source pixels that will be needed
   ///         to produce results for the specified |output_limit| under the
   ///         specified |effect_transform|. This is essentially a reverse of
@@ -221,15 +221,33 @@ Scalar GaussianBlurFilterContents::CalculateScale(Scalar sigma) {
   return 4.0 / sigma;
 };
 
+std::vector<ISize> GaussianBlurFilterContents::CalculateDownsampleSizes(
+    const ISize& padded_size,
+    const ISize& subpass_size) {
+  std::vector<ISize> sizes;
+  ISize size = padded_size;
+  while (size.width / 2 > subpass_size.width ||
+         size.height / 2 > subpass_size.height) {
+    size = ISize(std::max(size.width / 2, subpass_size.width),
+                 std::max(size.height / 2, subpass_size.height));
+    sizes.push_back(size);
+  }
+  sizes.push_back(subpass_size);
+  return sizes;
+}
+
 std::optional<Rect> GaussianBlurFilterContents::GetFilterSourceCoverage(
     const Matrix& effect_transform,
     const Rect& output_limit) const {
   Vector2 scaled_sigma = {ScaleSigma(sigma_x_), ScaleSigma(sigma_y_)};
   Vector2 blur_radius = {CalculateBlurRadius(scaled_sigma.x),
                          CalculateBlurRadius(scaled_sigma.y)};
-  Vector3 blur_radii =
-      effect_transform.Basis() * Vector3{blur_radius.x, blur_radius.y, 0.0};
-  return output_limit.Expand(Point(blur_radii.x, blur_radii.y));
+  // Mirroring or rotating effect transforms must still grow the source
+  // coverage on both sides, so the radii are expanded per axis.
+  Vector2 blur_radii =
+      effect_transform.TransformDirection(Vector2(blur_radius.x, 0)).Abs() +
+      effect_transform.TransformDirection(Vector2(0, blur_radius.y)).Abs();
+  return output_limit.Expand(blur_radii);
 }
 
 std::optional<Rect> GaussianBlurFilterContents::GetFilterCoverage(
@@ -312,9 +330,23 @@ std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
   Quad uvs =
       CalculateUVs(inputs[0], entity, input_snapshot->texture->GetSize());
 
+  // Large sigmas scale the input down a lot. Doing that in one pass would
+  // skip most of the input texels, so it is split into steps of at most half.
+  std::vector<ISize> downsample_sizes = CalculateDownsampleSizes(
+      ISize(round(padded_size.x), round(padded_size.y)), subpass_size);
   std::shared_ptr<Texture> pass1_out_texture = MakeDownsampleSubpass(
       renderer, input_snapshot->texture, input_snapshot->sampler_descriptor,
-      uvs, subpass_size, padding, tile_mode_);
+      uvs, downsample_sizes.front(), padding, tile_mode_);
+  for (size_t i = 1; i < downsample_sizes.size() && pass1_out_texture; i++) {
+    // The gutter is already part of the texture.
+    pass1_out_texture = MakeDownsampleSubpass(
+        renderer, pass1_out_texture, input_snapshot->sampler_descriptor,
+        {Point(0, 0), Point(1, 0), Point(0, 1), Point(1, 1)},
+        downsample_sizes[i], Vector2(0, 0), Entity::TileMode::kClamp);
+  }
+  if (!pass1_out_texture) {
+    return std::nullopt;
+  }
 
   Vector2 pass1_pixel_size = 1.0 / Vector2(pass1_out_texture->GetSize());
 
@@ -6,6 +6,8 @@
 #define FLUTTER_IMPELLER_ENTITY_CONTENTS_FILTERS_GAUSSIAN_BLUR_FILTER_CONTENTS_H_
 
 #include <optional>
+#include <vector>
+
 #include "impeller/entity/contents/filters/filter_contents.h"
 
 namespace impeller {
@@ -51,6 +53,15 @@ class GaussianBlurFilterContents final : public FilterContents {
   /// Visible for testing.
   static Scalar CalculateScale(Scalar sigma);
 
+  /// Calculate the sizes of the downsample passes that take a `padded_size`
+  /// input to `subpass_size`. Each pass shrinks the image by at most half, like
+  /// a mip chain, so that every input texel contributes to the bilinear
+  /// samples of the next pass. The last size is always `subpass_size`.
+  ///
+  /// Visible for testing.
+  static std::vector<ISize> CalculateDownsampleSizes(const ISize& padded_size,
+                                                     const ISize& subpass_size);
+
   /// Scales down the sigma value to match Skia's behavior.
   ///
   /// effective_blur_radius = CalculateBlurRadius(ScaleSigma(sigma_));
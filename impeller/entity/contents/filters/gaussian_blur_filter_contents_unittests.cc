@@ -164,6 +164,16 @@ TEST(GaussianBlurFilterContentsTest, FilterSourceCoverage) {
   ASSERT_EQ(coverage, Rect::MakeLTRB(100 - 2, 100 - 2, 200 + 2, 200 + 2));
 }
 
+TEST(GaussianBlurFilterContentsTest, FilterSourceCoverageMirrored) {
+  Scalar sigma_radius_1 = CalculateSigmaForBlurRadius(1.0);
+  auto contents = std::make_unique<GaussianBlurFilterContents>(
+      sigma_radius_1, sigma_radius_1, Entity::TileMode::kDecal);
+  std::optional<Rect> coverage = contents->GetFilterSourceCoverage(
+      /*effect_transform=*/Matrix::MakeScale({-2.0, 2.0, 1.0}),
+      /*output_limit=*/Rect::MakeLTRB(100, 100, 200, 200));
+  ASSERT_EQ(coverage, Rect::MakeLTRB(100 - 2, 100 - 2, 200 + 2, 200 + 2));
+}
+
 TEST(GaussianBlurFilterContentsTest, CalculateSigmaValues) {
   EXPECT_EQ(GaussianBlurFilterContents::CalculateScale(1.0f), 1);
   EXPECT_EQ(GaussianBlurFilterContents::CalculateScale(2.0f), 1);
@@ -173,6 +183,26 @@ TEST(GaussianBlurFilterContentsTest, CalculateSigmaValues) {
   EXPECT_EQ(GaussianBlurFilterContents::CalculateScale(1024.0f), 4.f / 1024.f);
 }
 
+TEST(GaussianBlurFilterContentsTest, CalculateDownsampleSizes) {
+  EXPECT_EQ(GaussianBlurFilterContents::CalculateDownsampleSizes(
+                ISize(100, 100), ISize(100, 100)),
+            std::vector<ISize>({ISize(100, 100)}));
+  EXPECT_EQ(GaussianBlurFilterContents::CalculateDownsampleSizes(
+                ISize(100, 100), ISize(60, 60)),
+            std::vector<ISize>({ISize(60, 60)}));
+  EXPECT_EQ(GaussianBlurFilterContents::CalculateDownsampleSizes(
+                ISize(100, 100), ISize(30, 30)),
+            std::vector<ISize>({ISize(50, 50), ISize(30, 30)}));
+  EXPECT_EQ(GaussianBlurFilterContents::CalculateDownsampleSizes(
+                ISize(1000, 200), ISize(100, 20)),
+            std::vector<ISize>({ISize(500, 100), ISize(250, 50),
+                                ISize(125, 25), ISize(100, 20)}));
+  // Only the longer side keeps halving.
+  EXPECT_EQ(GaussianBlurFilterContents::CalculateDownsampleSizes(
+                ISize(400, 40), ISize(100, 30)),
+            std::vector<ISize>({ISize(200, 30), ISize(100, 30)}));
+}
+
 TEST_P(GaussianBlurFilterContentsTest, RenderCoverageMatchesGetCoverage) {
   TextureDescriptor desc = {
       .storage_mode = StorageMode::kDevicePrivate,
@@ -193,14 +193,11 @@ std::optional<Rect>
 DirectionalMorphologyFilterContents::GetFilterSourceCoverage(
     const Matrix& effect_transform,
     const Rect& output_limit) const {
+  // Both dilation and erosion sample a window of |radius_| around every
+  // output pixel, so either way the source extends past the output limit.
   auto transformed_vector =
       effect_transform.TransformDirection(direction_ * radius_.radius).Abs();
-  switch (morph_type_) {
-    case FilterContents::MorphType::kDilate:
-      return output_limit.Expand(-transformed_vector);
-    case FilterContents::MorphType::kErode:
-      return output_limit.Expand(transformed_vector);
-  }
+  return output_limit.Expand(transformed_vector);
 }
 
 }  // namespace impeller
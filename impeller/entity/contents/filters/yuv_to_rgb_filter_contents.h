@@ -17,6 +17,10 @@ class YUVToRGBFilterContents final : public FilterContents {
 
   void SetYUVColorSpace(YUVColorSpace yuv_color_space);
 
+  /// The matrix that the `yuv_to_rgb_filter` fragment shader converts colors
+  /// in |yuv_color_space| with.
+  static Matrix GetYUVToRGBMatrix(YUVColorSpace yuv_color_space);
+
  private:
   // |FilterContents|
   std::optional<Entity> RenderFilter(
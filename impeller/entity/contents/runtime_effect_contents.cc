@@ -6,9 +6,11 @@
 
 #include <future>
 #include <memory>
+#include <mutex>
 
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/shader_types.h"
@@ -22,50 +24,27 @@
 
 namespace impeller {
 
-void RuntimeEffectContents::SetRuntimeStage(
-    std::shared_ptr<RuntimeStage> runtime_stage) {
-  runtime_stage_ = std::move(runtime_stage);
-}
-
-void RuntimeEffectContents::SetUniformData(
-    std::shared_ptr<std::vector<uint8_t>> uniform_data) {
-  uniform_data_ = std::move(uniform_data);
-}
-
-void RuntimeEffectContents::SetTextureInputs(
-    std::vector<TextureInput> texture_inputs) {
-  texture_inputs_ = std::move(texture_inputs);
-}
-
-bool RuntimeEffectContents::CanInheritOpacity(const Entity& entity) const {
-  return false;
+#ifndef FML_OS_ANDROID
+// Shaders are registered on the raster thread when they are first drawn, and
+// on a worker when they are prewarmed.
+static std::mutex& GetRegistrationMutex() {
+  static std::mutex mutex;
+  return mutex;
 }
 
-bool RuntimeEffectContents::Render(const ContentContext& renderer,
-                                   const Entity& entity,
-                                   RenderPass& pass) const {
-// TODO(jonahwilliams): FragmentProgram API is not fully wired up on Android.
-// Disable until this is complete so that integration tests and benchmarks can
-// run m3 applications.
-#ifdef FML_OS_ANDROID
-  return true;
-#else
-
-  auto context = renderer.GetContext();
-  auto library = context->GetShaderLibrary();
-
-  //--------------------------------------------------------------------------
-  /// Get or register shader.
-  ///
-
-  // TODO(113719): Register the shader function earlier.
+// Gets or registers the fragment function of |runtime_stage|.
+static std::shared_ptr<const ShaderFunction> RegisterShaderFunction(
+    const Context& context,
+    RuntimeStage& runtime_stage) {
+  std::scoped_lock lock(GetRegistrationMutex());
+  auto library = context.GetShaderLibrary();
 
   std::shared_ptr<const ShaderFunction> function = library->GetFunction(
-      runtime_stage_->GetEntrypoint(), ShaderStage::kFragment);
+      runtime_stage.GetEntrypoint(), ShaderStage::kFragment);
 
-  if (function && runtime_stage_->IsDirty()) {
-    context->GetPipelineLibrary()->RemovePipelinesWithEntryPoint(function);
-    library->UnregisterFunction(runtime_stage_->GetEntrypoint(),
+  if (function && runtime_stage.IsDirty()) {
+    context.GetPipelineLibrary()->RemovePipelinesWithEntryPoint(function);
+    library->UnregisterFunction(runtime_stage.GetEntrypoint(),
                                 ShaderStage::kFragment);
 
     function = nullptr;
@@ -76,54 +55,48 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
     auto future = promise.get_future();
 
     library->RegisterFunction(
-        runtime_stage_->GetEntrypoint(),
-        ToShaderStage(runtime_stage_->GetShaderStage()),
-        runtime_stage_->GetCodeMapping(),
+        runtime_stage.GetEntrypoint(),
+        ToShaderStage(runtime_stage.GetShaderStage()),
+        runtime_stage.GetCodeMapping(),
         fml::MakeCopyable([promise = std::move(promise)](bool result) mutable {
           promise.set_value(result);
         }));
 
     if (!future.get()) {
       VALIDATION_LOG << "Failed to build runtime effect (entry point: "
-                     << runtime_stage_->GetEntrypoint() << ")";
-      return false;
+                     << runtime_stage.GetEntrypoint() << ")";
+      return nullptr;
     }
 
-    function = library->GetFunction(runtime_stage_->GetEntrypoint(),
+    function = library->GetFunction(runtime_stage.GetEntrypoint(),
                                     ShaderStage::kFragment);
     if (!function) {
       VALIDATION_LOG
           << "Failed to fetch runtime effect function immediately after "
              "registering it (entry point: "
-          << runtime_stage_->GetEntrypoint() << ")";
-      return false;
+          << runtime_stage.GetEntrypoint() << ")";
+      return nullptr;
     }
 
-    runtime_stage_->SetClean();
+    runtime_stage.SetClean();
   }
+  return function;
+}
 
-  //--------------------------------------------------------------------------
-  /// Resolve geometry.
-  ///
-
-  auto geometry_result =
-      GetGeometry()->GetPositionBuffer(renderer, entity, pass);
-
-  //--------------------------------------------------------------------------
-  /// Get or create runtime stage pipeline.
-  ///
-
-  const auto& caps = context->GetCapabilities();
+static PipelineDescriptor MakePipelineDescriptor(
+    const Context& context,
+    std::shared_ptr<const ShaderFunction> fragment_function,
+    const ContentContextOptions& options) {
+  const auto& caps = context.GetCapabilities();
   const auto color_attachment_format = caps->GetDefaultColorFormat();
   const auto stencil_attachment_format = caps->GetDefaultStencilFormat();
 
   using VS = RuntimeEffectVertexShader;
   PipelineDescriptor desc;
   desc.SetLabel("Runtime Stage");
-  desc.AddStageEntrypoint(
-      library->GetFunction(VS::kEntrypointName, ShaderStage::kVertex));
-  desc.AddStageEntrypoint(library->GetFunction(runtime_stage_->GetEntrypoint(),
-                                               ShaderStage::kFragment));
+  desc.AddStageEntrypoint(context.GetShaderLibrary()->GetFunction(
+      VS::kEntrypointName, ShaderStage::kVertex));
+  desc.AddStageEntrypoint(std::move(fragment_function));
   auto vertex_descriptor = std::make_shared<VertexDescriptor>();
   vertex_descriptor->SetStageInputs(VS::kAllShaderStageInputs,
                                     VS::kInterleavedBufferLayout);
@@ -136,15 +109,103 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
   desc.SetStencilAttachmentDescriptors(stencil0);
   desc.SetStencilPixelFormat(stencil_attachment_format);
 
+  options.ApplyToPipelineDescriptor(desc);
+  return desc;
+}
+#endif  // FML_OS_ANDROID
+
+bool RuntimeEffectContents::Prewarm(
+    const Context& context,
+    const std::shared_ptr<RuntimeStage>& runtime_stage) {
+  // See |Render|.
+#ifdef FML_OS_ANDROID
+  return true;
+#else
+  TRACE_EVENT0("impeller", "RuntimeEffectContents::Prewarm");
+  auto function = RegisterShaderFunction(context, *runtime_stage);
+  if (!function) {
+    return false;
+  }
+
+  // Matches drawing a rectangle with the default blend mode into the
+  // onscreen render target.
+  const auto& caps = context.GetCapabilities();
+  ContentContextOptions options;
+  options.sample_count = caps->SupportsOffscreenMSAA() ? SampleCount::kCount4
+                                                       : SampleCount::kCount1;
+  options.color_attachment_pixel_format = caps->GetDefaultColorFormat();
+  options.primitive_type = PrimitiveType::kTriangleStrip;
+
+  // The pipeline is created in the background. It is not waited for.
+  context.GetPipelineLibrary()->GetPipeline(
+      MakePipelineDescriptor(context, std::move(function), options));
+  return true;
+#endif  // FML_OS_ANDROID
+}
+
+void RuntimeEffectContents::SetRuntimeStage(
+    std::shared_ptr<RuntimeStage> runtime_stage) {
+  runtime_stage_ = std::move(runtime_stage);
+}
+
+void RuntimeEffectContents::SetUniformData(
+    std::shared_ptr<std::vector<uint8_t>> uniform_data) {
+  uniform_data_ = std::move(uniform_data);
+}
+
+void RuntimeEffectContents::SetTextureInputs(
+    std::vector<TextureInput> texture_inputs) {
+  texture_inputs_ = std::move(texture_inputs);
+}
+
+bool RuntimeEffectContents::CanInheritOpacity(const Entity& entity) const {
+  return false;
+}
+
+bool RuntimeEffectContents::Render(const ContentContext& renderer,
+                                   const Entity& entity,
+                                   RenderPass& pass) const {
+// TODO(jonahwilliams): FragmentProgram API is not fully wired up on Android.
+// Disable until this is complete so that integration tests and benchmarks can
+// run m3 applications.
+#ifdef FML_OS_ANDROID
+  return true;
+#else
+
+  auto context = renderer.GetContext();
+
+  //--------------------------------------------------------------------------
+  /// Get or register shader.
+  ///
+
+  // Usually registered by |Prewarm| already.
+  auto function = RegisterShaderFunction(*context, *runtime_stage_);
+  if (!function) {
+    return false;
+  }
+
+  //--------------------------------------------------------------------------
+  /// Resolve geometry.
+  ///
+
+  auto geometry_result =
+      GetGeometry()->GetPositionBuffer(renderer, entity, pass);
+
+  //--------------------------------------------------------------------------
+  /// Get or create runtime stage pipeline.
+  ///
+
   auto options = OptionsFromPassAndEntity(pass, entity);
   if (geometry_result.prevent_overdraw) {
     options.stencil_compare = CompareFunction::kEqual;
     options.stencil_operation = StencilOperation::kIncrementClamp;
   }
   options.primitive_type = geometry_result.type;
-  options.ApplyToPipelineDescriptor(desc);
 
-  auto pipeline = context->GetPipelineLibrary()->GetPipeline(desc).Get();
+  auto pipeline =
+      context->GetPipelineLibrary()
+          ->GetPipeline(MakePipelineDescriptor(*context, function, options))
+          .Get();
   if (!pipeline) {
     VALIDATION_LOG << "Failed to get or create runtime effect pipeline.";
     return false;
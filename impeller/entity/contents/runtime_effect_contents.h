@@ -21,6 +21,19 @@ class RuntimeEffectContents final : public ColorSourceContents {
     std::shared_ptr<Texture> texture;
   };
 
+  //----------------------------------------------------------------------------
+  /// @brief      Registers the shader of |runtime_stage| with |context| and
+  ///             starts creating the pipeline that its first draw most likely
+  ///             uses, so that the draw does not wait for the compiler.
+  ///
+  ///             Blocks until the shader is registered, and is meant to be
+  ///             called on a worker thread.
+  ///
+  /// @return     Whether the shader could be registered.
+  ///
+  static bool Prewarm(const Context& context,
+                      const std::shared_ptr<RuntimeStage>& runtime_stage);
+
   void SetRuntimeStage(std::shared_ptr<RuntimeStage> runtime_stage);
 
   void SetUniformData(std::shared_ptr<std::vector<uint8_t>> uniform_data);
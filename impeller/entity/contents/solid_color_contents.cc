@@ -4,11 +4,15 @@
 
 #include "solid_color_contents.h"
 
+#include <algorithm>
+
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/entity.h"
+#include "impeller/geometry/constants.h"
 #include "impeller/geometry/path.h"
 #include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
 
 namespace impeller {
 
@@ -45,11 +49,147 @@ std::optional<Rect> SolidColorContents::GetCoverage(
   return geometry->GetCoverage(entity.GetTransform());
 };
 
+// Fills the geometry of a stencil-then-cover |geometry_result| by counting
+// its windings into the stencil buffer and then drawing |coverage| wherever
+// the count satisfies the fill rule. The cover pass resets every stencil value
+// it passes back to zero, the clip depth this is only used at.
+static bool RenderStencilThenCover(const ContentContext& renderer,
+                                   const Entity& entity,
+                                   RenderPass& pass,
+                                   GeometryResult geometry_result,
+                                   Rect coverage,
+                                   Color color) {
+  {
+    using VS = ClipPipeline::VertexShader;
+
+    Command cmd;
+    DEBUG_COMMAND_INFO(cmd, "Solid Fill (Stencil)");
+    cmd.stencil_reference = entity.GetClipDepth();
+
+    auto options = OptionsFromPass(pass);
+    options.blend_mode = BlendMode::kDestination;
+    options.stencil_compare = CompareFunction::kAlways;
+    if (geometry_result.stencil_then_cover == FillType::kNonZero) {
+      options.count_stencil_winding = true;
+    } else {
+      options.stencil_operation = StencilOperation::kInvert;
+    }
+    options.primitive_type = geometry_result.type;
+    cmd.pipeline = renderer.GetClipPipeline(options);
+    cmd.BindVertices(std::move(geometry_result.vertex_buffer));
+
+    VS::FrameInfo info;
+    info.mvp = geometry_result.transform;
+    VS::BindFrameInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(info));
+
+    if (!pass.AddCommand(std::move(cmd))) {
+      return false;
+    }
+  }
+
+  using VS = SolidFillPipeline::VertexShader;
+
+  Command cmd;
+  DEBUG_COMMAND_INFO(cmd, "Solid Fill (Cover)");
+  cmd.stencil_reference = entity.GetClipDepth();
+
+  auto options = OptionsFromPassAndEntity(pass, entity);
+  options.stencil_compare = CompareFunction::kNotEqual;
+  options.stencil_operation = StencilOperation::kSetToReferenceValue;
+  options.primitive_type = PrimitiveType::kTriangleStrip;
+  cmd.pipeline = renderer.GetSolidFillPipeline(options);
+
+  auto points = coverage.GetPoints();
+  cmd.BindVertices(
+      VertexBufferBuilder<VS::PerVertexData>{}
+          .AddVertices({{points[0]}, {points[1]}, {points[2]}, {points[3]}})
+          .CreateVertexBuffer(pass.GetTransientsBuffer()));
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize());
+  frame_info.color = color.Premultiply();
+  VS::BindFrameInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frame_info));
+
+  return pass.AddCommand(std::move(cmd));
+}
+
+// Whether the edges of rounded rects can be anti-aliased by their coverage
+// instead of by multisampling. Fragments outside of the shape are drawn with
+// a transparent color, which only leaves the destination alone with source
+// over blending.
+static bool CanAntialiasAnalytically(const Entity& entity,
+                                     const RenderPass& pass) {
+  return pass.GetSampleCount() == SampleCount::kCount1 &&
+         entity.GetBlendMode() == BlendMode::kSourceOver &&
+         !entity.GetTransform().HasPerspective();
+}
+
+// Draws |round_rect| as a quad that covers its edges by one more pixel, and
+// fades the color out over the pixel that each edge passes through.
+static bool RenderAnalyticRoundRect(const ContentContext& renderer,
+                                    const Entity& entity,
+                                    RenderPass& pass,
+                                    const RoundRect& round_rect,
+                                    Color color) {
+  using VS = SolidRRectFillPipeline::VertexShader;
+  using FS = SolidRRectFillPipeline::FragmentShader;
+
+  const Rect rect = round_rect.bounds.GetPositive();
+  const Matrix& transform = entity.GetTransform();
+  const Scalar min_scale = std::min(transform.GetBasisX().Length(),
+                                    transform.GetBasisY().Length());
+  if (rect.IsEmpty() || min_scale <= kEhCloseEnough) {
+    return true;
+  }
+  const Scalar padding = 1.0f / min_scale;
+
+  Command cmd;
+  DEBUG_COMMAND_INFO(cmd, "Solid RRect Fill");
+  cmd.stencil_reference = entity.GetClipDepth();
+
+  auto options = OptionsFromPassAndEntity(pass, entity);
+  options.primitive_type = PrimitiveType::kTriangleStrip;
+  cmd.pipeline = renderer.GetSolidRRectFillPipeline(options);
+
+  const Scalar right = rect.GetWidth() + padding;
+  const Scalar bottom = rect.GetHeight() + padding;
+  cmd.BindVertices(VertexBufferBuilder<VS::PerVertexData>{}
+                       .AddVertices({{Point(-padding, -padding)},
+                                     {Point(right, -padding)},
+                                     {Point(-padding, bottom)},
+                                     {Point(right, bottom)}})
+                       .CreateVertexBuffer(pass.GetTransientsBuffer()));
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   transform * Matrix::MakeTranslation(rect.GetOrigin());
+  VS::BindFrameInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frame_info));
+
+  FS::FragInfo frag_info;
+  frag_info.color = color.Premultiply();
+  frag_info.rect_size = Point(rect.GetSize());
+  frag_info.corner_radii = Point(
+      std::clamp(round_rect.radii.width, 0.0f, rect.GetWidth() / 2.0f),
+      std::clamp(round_rect.radii.height, 0.0f, rect.GetHeight() / 2.0f));
+  FS::BindFragInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frag_info));
+
+  return pass.AddCommand(std::move(cmd));
+}
+
 bool SolidColorContents::Render(const ContentContext& renderer,
                                 const Entity& entity,
                                 RenderPass& pass) const {
   auto capture = entity.GetCapture().CreateChild("SolidColorContents");
 
+  if (CanAntialiasAnalytically(entity, pass)) {
+    if (auto round_rect = GetGeometry()->GetRoundRect();
+        round_rect.has_value()) {
+      return RenderAnalyticRoundRect(renderer, entity, pass,
+                                     round_rect.value(),
+                                     capture.AddColor("Color", GetColor()));
+    }
+  }
+
   using VS = SolidFillPipeline::VertexShader;
 
   Command cmd;
@@ -57,7 +197,16 @@ bool SolidColorContents::Render(const ContentContext& renderer,
   cmd.stencil_reference = entity.GetClipDepth();
 
   auto geometry_result =
-      GetGeometry()->GetPositionBuffer(renderer, entity, pass);
+      GetGeometry()->GetStencilThenCoverPositionBuffer(renderer, entity, pass);
+  if (geometry_result.stencil_then_cover.has_value()) {
+    auto coverage = GetCoverage(entity);
+    if (!coverage.has_value()) {
+      return true;
+    }
+    return RenderStencilThenCover(
+        renderer, entity, pass, std::move(geometry_result), coverage.value(),
+        capture.AddColor("Color", GetColor()));
+  }
 
   auto options = OptionsFromPassAndEntity(pass, entity);
   if (geometry_result.prevent_overdraw) {
@@ -103,6 +252,10 @@ std::optional<Color> SolidColorContents::AsBackgroundColor(
              : std::optional<Color>();
 }
 
+const SolidColorContents* SolidColorContents::AsSolidColor() const {
+  return this;
+}
+
 bool SolidColorContents::ApplyColorFilter(
     const ColorFilterProc& color_filter_proc) {
   color_ = color_filter_proc(color_);
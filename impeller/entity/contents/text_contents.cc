@@ -4,6 +4,7 @@
 
 #include "impeller/entity/contents/text_contents.h"
 
+#include <algorithm>
 #include <cstring>
 #include <optional>
 #include <type_traits>
@@ -64,14 +65,21 @@ void TextContents::SetForceTextColor(bool value) {
   force_text_color_ = value;
 }
 
+void TextContents::SetBlurSigma(Scalar sigma) {
+  blur_sigma_ = std::max(sigma, 0.0f);
+}
+
 std::optional<Rect> TextContents::GetCoverage(const Entity& entity) const {
-  return frame_->GetBounds().TransformBounds(entity.GetTransform());
+  // Blurred glyphs are outset by three sigmas.
+  return frame_->GetBounds()
+      .Expand(3.0f * blur_sigma_)
+      .TransformBounds(entity.GetTransform());
 }
 
 void TextContents::PopulateGlyphAtlas(
     const std::shared_ptr<LazyGlyphAtlas>& lazy_glyph_atlas,
     Scalar scale) {
-  lazy_glyph_atlas->AddTextFrame(*frame_, scale);
+  lazy_glyph_atlas->AddTextFrame(*frame_, scale, blur_sigma_);
   scale_ = scale;
 }
 
@@ -83,7 +91,7 @@ bool TextContents::Render(const ContentContext& renderer,
     return true;
   }
 
-  auto type = frame_->GetAtlasType();
+  auto type = frame_->GetAtlasType(scale_, blur_sigma_);
   auto atlas =
       ResolveAtlas(*renderer.GetContext(), type, renderer.GetLazyGlyphAtlas());
 
@@ -97,10 +105,16 @@ bool TextContents::Render(const ContentContext& renderer,
   DEBUG_COMMAND_INFO(cmd, "TextFrame");
   auto opts = OptionsFromPassAndEntity(pass, entity);
   opts.primitive_type = PrimitiveType::kTriangle;
-  if (type == GlyphAtlas::Type::kAlphaBitmap) {
-    cmd.pipeline = renderer.GetGlyphAtlasPipeline(opts);
-  } else {
-    cmd.pipeline = renderer.GetGlyphAtlasColorPipeline(opts);
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      cmd.pipeline = renderer.GetGlyphAtlasPipeline(opts);
+      break;
+    case GlyphAtlas::Type::kColorBitmap:
+      cmd.pipeline = renderer.GetGlyphAtlasColorPipeline(opts);
+      break;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      cmd.pipeline = renderer.GetGlyphAtlasSdfPipeline(opts);
+      break;
   }
   cmd.stencil_reference = entity.GetClipDepth();
 
@@ -130,7 +144,8 @@ bool TextContents::Render(const ContentContext& renderer,
   }
 
   SamplerDescriptor sampler_desc;
-  if (frame_info.is_translation_scale) {
+  if (frame_info.is_translation_scale &&
+      type != GlyphAtlas::Type::kSignedDistanceField) {
     sampler_desc.min_filter = MinMagFilter::kNearest;
     sampler_desc.mag_filter = MinMagFilter::kNearest;
   } else {
@@ -139,6 +154,8 @@ bool TextContents::Render(const ContentContext& renderer,
     // on linear sampling to prevent crunchiness caused by the pixel grid not
     // being perfectly aligned.
     // The downside is that this slightly over-blurs rotated/skewed text.
+    // Signed distance fields are always interpolated, since they are drawn
+    // at a different size than they are stored at.
     sampler_desc.min_filter = MinMagFilter::kLinear;
     sampler_desc.mag_filter = MinMagFilter::kLinear;
   }
@@ -163,6 +180,8 @@ bool TextContents::Render(const ContentContext& renderer,
                                                 Point{0, 1}, Point{1, 1}};
 
   auto& host_buffer = pass.GetTransientsBuffer();
+  const size_t subpixel_positions =
+      renderer.GetLazyGlyphAtlas()->GetSubpixelPositions(type);
   size_t vertex_count = 0;
   for (const auto& run : frame_->GetRuns()) {
     vertex_count += run.GetGlyphPositions().size();
@@ -177,10 +196,12 @@ bool TextContents::Render(const ContentContext& renderer,
             reinterpret_cast<VS::PerVertexData*>(contents);
         for (const TextRun& run : frame_->GetRuns()) {
           const Font& font = run.GetFont();
-          Scalar rounded_scale = TextFrame::RoundScaledFontSize(
-              scale_, font.GetMetrics().point_size);
+          Scalar rounded_scale = TextFrame::GetAtlasScale(
+              type, scale_, font.GetMetrics().point_size);
+          Scalar atlas_blur_sigma =
+              TextFrame::GetAtlasBlurSigma(blur_sigma_, rounded_scale);
           const FontGlyphAtlas* font_atlas =
-              atlas->GetFontGlyphAtlas(font, rounded_scale);
+              atlas->GetFontGlyphAtlas(font, rounded_scale, atlas_blur_sigma);
           if (!font_atlas) {
             VALIDATION_LOG << "Could not find font in the atlas.";
             continue;
@@ -188,16 +209,25 @@ bool TextContents::Render(const ContentContext& renderer,
 
           for (const TextRun::GlyphPosition& glyph_position :
                run.GetGlyphPositions()) {
+            Glyph glyph =
+                TextFrame::GetAtlasGlyph(glyph_position, rounded_scale,
+                                         subpixel_positions, atlas_blur_sigma);
             std::optional<Rect> maybe_atlas_glyph_bounds =
-                font_atlas->FindGlyphBounds(glyph_position.glyph);
+                font_atlas->FindGlyphBounds(glyph);
             if (!maybe_atlas_glyph_bounds.has_value()) {
               VALIDATION_LOG << "Could not find glyph position in the atlas.";
               continue;
             }
             const Rect& atlas_glyph_bounds = maybe_atlas_glyph_bounds.value();
             vtx.atlas_glyph_bounds = Vector4(atlas_glyph_bounds.GetXYWH());
-            vtx.glyph_bounds = Vector4(glyph_position.glyph.bounds.GetXYWH());
+            vtx.glyph_bounds = Vector4(glyph.bounds.GetXYWH());
             vtx.glyph_position = glyph_position.position;
+            if (glyph.subpixel_offset != 0) {
+              // The offset is already part of the rasterized glyph, so the
+              // glyph is placed that much to the left of its position.
+              vtx.glyph_position.x -=
+                  glyph.subpixel_offset / (256.0f * rounded_scale);
+            }
 
             for (const Point& point : unit_points) {
               vtx.unit_position = point;
@@ -37,6 +37,14 @@ class TextContents final : public Contents {
   ///        This is used to ensure that mask blurs work correctly on emoji.
   void SetForceTextColor(bool value);
 
+  /// @brief Draw the glyphs with a normal gaussian blur of the given sigma,
+  ///        in the coordinates of the text frame.
+  ///
+  ///        The blurred glyphs are rasterized into the glyph atlas, so this
+  ///        needs no offscreen pass. The sigma in pixels is limited to
+  ///        TextFrame::kMaxAtlasBlurSigma.
+  void SetBlurSigma(Scalar sigma);
+
   Color GetColor() const;
 
   // |Contents|
@@ -69,6 +77,7 @@ class TextContents final : public Contents {
   Scalar inherited_opacity_ = 1.0;
   Vector2 offset_;
   bool force_text_color_ = false;
+  Scalar blur_sigma_ = 0.0f;
 
   std::shared_ptr<GlyphAtlas> ResolveAtlas(
       Context& context,
@@ -13,6 +13,7 @@
 #include "impeller/entity/contents/vertices_contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/entity_playground.h"
+#include "impeller/entity/tessellation_cache.h"
 #include "impeller/entity/vertices.frag.h"
 #include "impeller/geometry/path_builder.h"
 #include "impeller/renderer/render_target.h"
@@ -74,5 +75,36 @@ TEST_P(EntityTest, RendersDstPerColorWithAlpha) {
   ASSERT_EQ(frag_uniforms->alpha, 0.5);
 }
 
+TEST_P(EntityTest, VerticesAreUploadedOnceForAllFrames) {
+  auto content_context = GetContentContext();
+  auto& cache = *content_context->GetTessellationCache();
+  auto buffer = content_context->GetContext()->CreateCommandBuffer();
+  auto render_target = RenderTarget::CreateOffscreenMSAA(
+      *content_context->GetContext(),
+      *GetContentContext()->GetRenderTargetCache(), {100, 100});
+  auto render_pass = buffer->CreateRenderPass(render_target);
+  Entity entity;
+
+  // Every frame converts the vertices into a new geometry, as display lists
+  // do.
+  std::vector<std::shared_ptr<const Buffer>> buffers;
+  for (auto frame = 0; frame < 4; frame++) {
+    auto vertices =
+        CreateColorVertices({{0, 0}, {100, 0}, {0, 100}},
+                            {Color::Red(), Color::Green(), Color::Blue()});
+    auto result = vertices->GetPositionColorBuffer(*content_context, entity,
+                                                   *render_pass);
+    ASSERT_EQ(result.vertex_buffer.vertex_count, 3u);
+    buffers.push_back(result.vertex_buffer.vertex_buffer.buffer);
+    cache.End();
+  }
+
+  // The second frame stores the upload that the later ones reuse.
+  EXPECT_NE(buffers[0], buffers[1]);
+  EXPECT_EQ(buffers[1], buffers[2]);
+  EXPECT_EQ(buffers[1], buffers[3]);
+  EXPECT_EQ(cache.GetLastFrameStats().cache_hits, 1u);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -10,6 +10,8 @@
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/memory/allocation_counter.h"
+#include "flutter/fml/thread_local.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/strings.h"
 #include "impeller/base/validation.h"
@@ -19,9 +21,12 @@
 #include "impeller/entity/contents/filters/color_filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
 #include "impeller/entity/contents/framebuffer_blend_contents.h"
+#include "impeller/entity/contents/solid_color_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/inline_pass_context.h"
+#include "impeller/entity/gradient_cache.h"
+#include "impeller/entity/tessellation_cache.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/rect.h"
 #include "impeller/renderer/command_buffer.h"
@@ -44,13 +49,189 @@ std::tuple<std::optional<Color>, BlendMode> ElementAsBackgroundColor(
   }
   return {};
 }
+
+/// The number of opaque entities that each earlier entity is tested against
+/// when looking for draws that are completely hidden.
+constexpr size_t kMaxOccluders = 8;
+
+/// Finds the entities in `elements` that are entirely covered by a later opaque
+/// entity and so never contribute to the pass. Walking backwards, each opaque
+/// source-over entity occludes the earlier entities it covers until a clip
+/// change or a subpass is reached, since either may change which pixels the
+/// occluder writes (clips) or read pixels beyond its own bounds (backdrop
+/// filters).
+std::vector<bool> FindOccludedEntities(
+    const std::vector<EntityPass::Element>& elements) {
+  std::vector<bool> occluded(elements.size(), false);
+  std::vector<const Entity*> occluders;
+  for (size_t i = elements.size(); i > 0; i--) {
+    const Entity* entity = std::get_if<Entity>(&elements[i - 1]);
+    if (!entity || !entity->GetContents() ||
+        entity->GetContents()->GetClipCoverage(*entity, std::nullopt).type !=
+            Contents::ClipCoverage::Type::kNoChange) {
+      occluders.clear();
+      continue;
+    }
+    std::optional<Rect> coverage = entity->GetCoverage();
+    if (coverage.has_value()) {
+      for (const Entity* occluder : occluders) {
+        if (occluder->GetClipDepth() == entity->GetClipDepth() &&
+            occluder->GetContents()->OccludesArea(*occluder,
+                                                  coverage.value())) {
+          occluded[i - 1] = true;
+          break;
+        }
+      }
+    }
+    if (!occluded[i - 1] && occluders.size() < kMaxOccluders &&
+        (entity->GetBlendMode() == BlendMode::kSourceOver ||
+         entity->GetBlendMode() == BlendMode::kSource) &&
+        entity->GetContents()->IsOpaque()) {
+      occluders.push_back(entity);
+    }
+  }
+  return occluded;
+}
+
+/// The most rectangles that are merged into a single draw.
+constexpr size_t kMaxMergedRects = 64;
+
+/// How many earlier elements a rectangle draw may be moved in front of in order
+/// to be merged with a matching rectangle draw.
+constexpr size_t kMaxMergeLookback = 4;
+
+bool AnyRectsIntersect(const std::vector<Rect>& rects,
+                       const std::vector<Rect>& other_rects) {
+  for (const Rect& rect : rects) {
+    for (const Rect& other_rect : other_rects) {
+      if (rect.IntersectsWithRect(other_rect)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool CanMergeRects(const Entity& entity, const Entity& other) {
+  const SolidColorContents* contents = entity.GetContents()->AsSolidColor();
+  const SolidColorContents* other_contents =
+      other.GetContents()->AsSolidColor();
+  return contents && other_contents &&
+         contents->GetColor() == other_contents->GetColor() &&
+         contents->GetOpacityFactor() == other_contents->GetOpacityFactor() &&
+         entity.GetBlendMode() <= Entity::kLastPipelineBlendMode &&
+         entity.GetBlendMode() == other.GetBlendMode() &&
+         entity.GetClipDepth() == other.GetClipDepth() &&
+         entity.GetTransform() == other.GetTransform();
+}
+
+/// Appends the rectangles of the solid color rectangle draw `entity` to a
+/// matching earlier draw in `elements`, so that both are issued as a single
+/// command. The rectangles may move in front of the elements in between only
+/// when they overlap none of them, which keeps the rendered result the same.
+bool MergeIntoEarlierRects(std::vector<EntityPass::Element>& elements,
+                           const Entity& entity) {
+  if (!entity.GetContents()->AsSolidColor()) {
+    return false;
+  }
+  std::vector<Rect> rects = entity.GetContents()
+                                ->AsSolidColor()
+                                ->GetGeometry()
+                                ->GetRects();
+  std::optional<Rect> coverage = entity.GetCoverage();
+  if (rects.empty() || !coverage.has_value()) {
+    return false;
+  }
+
+  size_t lookback = 0;
+  for (auto it = elements.rbegin();
+       it != elements.rend() && lookback < kMaxMergeLookback;
+       ++it, ++lookback) {
+    Entity* previous = std::get_if<Entity>(&*it);
+    if (!previous || !previous->GetContents()) {
+      return false;
+    }
+    if (CanMergeRects(*previous, entity)) {
+      std::vector<Rect> merged_rects = previous->GetContents()
+                                           ->AsSolidColor()
+                                           ->GetGeometry()
+                                           ->GetRects();
+      if (!merged_rects.empty() &&
+          merged_rects.size() + rects.size() <= kMaxMergedRects &&
+          !AnyRectsIntersect(merged_rects, rects)) {
+        merged_rects.insert(merged_rects.end(), rects.begin(), rects.end());
+        // The contents are owned by the recorded entity, so its geometry can
+        // be replaced in place.
+        std::static_pointer_cast<SolidColorContents>(previous->GetContents())
+            ->SetGeometry(Geometry::MakeRectList(std::move(merged_rects)));
+        return true;
+      }
+    }
+    auto clip_coverage =
+        previous->GetContents()->GetClipCoverage(*previous, std::nullopt);
+    if (clip_coverage.type != Contents::ClipCoverage::Type::kNoChange) {
+      return false;
+    }
+    std::optional<Rect> previous_coverage = previous->GetCoverage();
+    if (previous_coverage.has_value() &&
+        previous_coverage->IntersectsWithRect(coverage.value())) {
+      return false;
+    }
+  }
+  return false;
+}
 }  // namespace
 
 const std::string EntityPass::kCaptureDocumentName = "EntityPass";
 
-EntityPass::EntityPass() = default;
+// The element storage of destroyed passes, which is reused by the passes
+// recorded next on the same thread. Without it, every frame grows the element
+// vectors of its passes from scratch.
+using ElementStoragePool = std::vector<std::vector<EntityPass::Element>>;
+FML_THREAD_LOCAL fml::ThreadLocalUniquePtr<ElementStoragePool>
+    tls_element_storage_pool;
+
+// Enough for the passes of a frame with a few save layers.
+static constexpr size_t kMaxPooledElementStorage = 16u;
+// Storage for more elements than this is not worth holding on to.
+static constexpr size_t kMaxPooledElementCapacity = 4096u;
+
+/// Appends |element| to |elements|, counting the storage the append allocates.
+static void AppendElement(std::vector<EntityPass::Element>& elements,
+                          EntityPass::Element element) {
+  size_t capacity = elements.capacity();
+  elements.emplace_back(std::move(element));
+  if (elements.capacity() != capacity) {
+    fml::RecordAllocation(fml::AllocationTag::kEntityPass,
+                          elements.capacity() * sizeof(EntityPass::Element));
+  }
+}
 
-EntityPass::~EntityPass() = default;
+EntityPass::EntityPass() {
+  fml::RecordAllocation(fml::AllocationTag::kEntityPass, sizeof(EntityPass));
+  ElementStoragePool* pool = tls_element_storage_pool.get();
+  if (pool && !pool->empty()) {
+    elements_ = std::move(pool->back());
+    pool->pop_back();
+  }
+}
+
+EntityPass::~EntityPass() {
+  // Clearing destroys the subpasses, which return their own storage first.
+  elements_.clear();
+  if (elements_.capacity() == 0u ||
+      elements_.capacity() > kMaxPooledElementCapacity) {
+    return;
+  }
+  ElementStoragePool* pool = tls_element_storage_pool.get();
+  if (!pool) {
+    pool = new ElementStoragePool();
+    tls_element_storage_pool.reset(pool);
+  }
+  if (pool->size() < kMaxPooledElementStorage) {
+    pool->push_back(std::move(elements_));
+  }
+}
 
 void EntityPass::SetDelegate(std::shared_ptr<EntityPassDelegate> delegate) {
   if (!delegate) {
@@ -76,7 +257,10 @@ void EntityPass::AddEntity(Entity entity) {
   if (entity.GetBlendMode() > Entity::kLastPipelineBlendMode) {
     advanced_blend_reads_from_pass_texture_ += 1;
   }
-  elements_.emplace_back(std::move(entity));
+  if (MergeIntoEarlierRects(elements_, entity)) {
+    return;
+  }
+  AppendElement(elements_, std::move(entity));
 }
 
 void EntityPass::SetElements(std::vector<Element> elements) {
@@ -116,8 +300,11 @@ std::optional<Rect> EntityPass::GetElementsCoverage(
                    std::get_if<std::unique_ptr<EntityPass>>(&element)) {
       auto& subpass = *subpass_ptr->get();
 
+      // Only the part of the subpass that can reach the coverage limit after
+      // filtering matters. |GetSubpassCoverage| maps the limit back through
+      // the subpass image filter, if any.
       std::optional<Rect> unfiltered_coverage =
-          GetSubpassCoverage(subpass, std::nullopt);
+          GetSubpassCoverage(subpass, coverage_limit);
 
       // If the current pass elements have any coverage so far and there's a
       // backdrop filter, then incorporate the backdrop filter in the
@@ -198,6 +385,94 @@ std::optional<Rect> EntityPass::GetSubpassCoverage(
   return entities_coverage->Intersection(user_bounds_coverage);
 }
 
+bool EntityPass::CanMergeWith(const EntityPass& other) const {
+  for (const EntityPass* pass : {this, &other}) {
+    if (pass->backdrop_filter_proc_ || pass->flood_clip_ ||
+        pass->advanced_blend_reads_from_pass_texture_ > 0 ||
+        pass->backdrop_filter_reads_from_pass_texture_ > 0) {
+      return false;
+    }
+  }
+  // The transparent parts of the merged texture must leave the parent pass
+  // untouched.
+  if (blend_mode_ != other.blend_mode_ ||
+      blend_mode_ > Entity::kLastPipelineBlendMode ||
+      Entity::IsBlendModeDestructive(blend_mode_)) {
+    return false;
+  }
+  if (clip_depth_ != other.clip_depth_ || transform_ != other.transform_) {
+    return false;
+  }
+  std::optional<Scalar> opacity = delegate_->GetSubpassOpacity(*this);
+  if (!opacity.has_value() ||
+      opacity != other.delegate_->GetSubpassOpacity(other)) {
+    return false;
+  }
+
+  // Clips that this pass leaves behind would apply to the elements of
+  // `other`.
+  for (auto it = elements_.rbegin(); it != elements_.rend(); ++it) {
+    auto entity = std::get_if<Entity>(&*it);
+    if (!entity) {
+      continue;
+    }
+    auto clip_coverage = entity->GetClipCoverage(std::nullopt);
+    if (clip_coverage.type == Contents::ClipCoverage::Type::kNoChange) {
+      continue;
+    }
+    if (clip_coverage.type != Contents::ClipCoverage::Type::kRestore ||
+        entity->GetClipDepth() > clip_depth_) {
+      return false;
+    }
+    break;
+  }
+
+  // Pixels that both passes touch would be blended with each other before
+  // the opacity is applied. The coverage is rounded out to the pixels of the
+  // parent pass, so that anti-aliased edges don't share a pixel either.
+  std::optional<Rect> coverage = GetSubpassCoverage(*this, std::nullopt);
+  std::optional<Rect> other_coverage = GetSubpassCoverage(other, std::nullopt);
+  if (!coverage.has_value() || !other_coverage.has_value() ||
+      Rect::RoundOut(coverage.value())
+          .IntersectsWithRect(Rect::RoundOut(other_coverage.value()))) {
+    return false;
+  }
+  // The bounds limits must not matter, since the merged pass can only have
+  // one of them.
+  for (const EntityPass* pass : {this, &other}) {
+    if (pass->bounds_limit_.has_value() &&
+        pass->GetElementsCoverage(std::nullopt) !=
+            GetSubpassCoverage(*pass, std::nullopt)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool EntityPass::MergeLastSubpasses() {
+  if (elements_.size() < 2u) {
+    return false;
+  }
+  auto last = std::get_if<std::unique_ptr<EntityPass>>(&elements_.back());
+  auto previous = std::get_if<std::unique_ptr<EntityPass>>(
+      &elements_[elements_.size() - 2u]);
+  if (!last || !previous || !(*previous)->CanMergeWith(**last)) {
+    return false;
+  }
+
+  EntityPass& merged = **previous;
+  for (auto& element : (*last)->elements_) {
+    if (auto subpass = std::get_if<std::unique_ptr<EntityPass>>(&element)) {
+      (*subpass)->superpass_ = &merged;
+    }
+    merged.elements_.emplace_back(std::move(element));
+  }
+  // Neither bounds limit clips anything.
+  merged.bounds_limit_ = std::nullopt;
+  elements_.pop_back();
+  return true;
+}
+
 EntityPass* EntityPass::GetSuperpass() const {
   return superpass_;
 }
@@ -217,7 +492,7 @@ EntityPass* EntityPass::AddSubpass(std::unique_ptr<EntityPass> pass) {
   }
 
   auto subpass_pointer = pass.get();
-  elements_.emplace_back(std::move(pass));
+  AppendElement(elements_, std::move(pass));
   return subpass_pointer;
 }
 
@@ -229,7 +504,7 @@ void EntityPass::AddSubpassInline(std::unique_ptr<EntityPass> pass) {
 
   std::vector<Element>& elements = pass->elements_;
   for (auto i = 0u; i < elements.size(); i++) {
-    elements_.emplace_back(std::move(elements[i]));
+    AppendElement(elements_, std::move(elements[i]));
   }
 
   backdrop_filter_reads_from_pass_texture_ +=
@@ -317,9 +592,21 @@ bool EntityPass::Render(ContentContext& renderer,
                   Rect::MakeSize(root_render_target.GetRenderTargetSize()),
                   {.readonly = true});
 
+#ifdef IMPELLER_ENABLE_SAMPLING_CAPTURE
+  SamplingCapture& sampling_capture =
+      *renderer.GetContext()->GetSamplingCapture();
+  sampling_capture.BeginFrame();
+  fml::ScopedCleanupClosure end_sampled_frame(
+      [&sampling_capture]() { sampling_capture.EndFrame(); });
+#endif
+
   fml::ScopedCleanupClosure reset_state([&renderer]() {
     renderer.GetLazyGlyphAtlas()->ResetTextFrames();
     renderer.GetRenderTargetCache()->End();
+    renderer.GetTransientsBuffer()->Reset();
+    renderer.GetTessellationCache()->End();
+    renderer.GetGradientCache()->End();
+    renderer.PersistPipelineUsageManifest();
   });
 
   IterateAllEntities([lazy_glyph_atlas =
@@ -620,6 +907,16 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
     ClipCoverageStack subpass_clip_coverage_stack = {ClipCoverageLayer{
         .coverage = subpass_coverage, .clip_depth = subpass->clip_depth_}};
 
+    // Subpasses are recorded one after the other on this thread even when
+    // they are independent. Recording an entity may add a pipeline variant to
+    // the renderer's unsynchronized |Variants| caches, use the shared
+    // |Tessellator|'s scratch buffers, and take textures from the render
+    // target cache, none of which are thread safe. On Vulkan, command pools
+    // are per thread and only the raster thread's are recycled at the end of
+    // a frame. Backends that can encode a command buffer off this thread do so
+    // when the pass is submitted, in submission order, see
+    // |CommandBuffer::EncodeAndSubmit|.
+    //
     // Stencil textures aren't shared between EntityPasses (as much of the
     // time they are transient).
     if (!subpass->OnRender(
@@ -754,16 +1051,26 @@ bool EntityPass::RenderElement(Entity& element_entity,
       break;
     case Contents::ClipCoverage::Type::kAppend: {
       auto op = clip_coverage_stack.back().coverage;
-      clip_coverage_stack.push_back(
-          ClipCoverageLayer{.coverage = clip_coverage.coverage,
-                            .clip_depth = element_entity.GetClipDepth() + 1});
+      // A pixel aligned rect clip is applied by scissoring everything drawn
+      // while it is active to its coverage instead of writing it to the clip
+      // buffer, which saves both its clip draw and the restore that undoes it.
+      bool use_scissor = clip_coverage.is_pixel_aligned_rect;
+      ClipCoverageLayer layer = clip_coverage_stack.back();
+      layer.coverage = clip_coverage.coverage;
+      layer.clip_depth = element_entity.GetClipDepth() + 1;
+      if (use_scissor) {
+        layer.scissor = clip_coverage.coverage.value_or(Rect());
+        layer.scissored_clip_count++;
+      }
+      clip_coverage_stack.push_back(layer);
       FML_DCHECK(clip_coverage_stack.back().clip_depth ==
                  clip_coverage_stack.front().clip_depth +
                      clip_coverage_stack.size() - 1);
 
-      if (!op.has_value()) {
+      if (!op.has_value() || use_scissor) {
         // Running this append op won't impact the clip buffer because the
-        // whole screen is already being clipped, so skip it.
+        // whole screen is already being clipped, or because the clip is
+        // applied with a scissor, so skip it.
         return true;
       }
     } break;
@@ -788,13 +1095,25 @@ bool EntityPass::RenderElement(Entity& element_entity,
         // Make the coverage rectangle relative to the current pass.
         restore_coverage = restore_coverage->Shift(-global_pass_position);
       }
+      size_t popped_clip_count =
+          clip_coverage_stack.size() - (restoration_index + 1);
+      size_t popped_scissored_clip_count =
+          clip_coverage_stack.back().scissored_clip_count;
       clip_coverage_stack.resize(restoration_index + 1);
+      popped_scissored_clip_count -=
+          clip_coverage_stack.back().scissored_clip_count;
 
       if (!clip_coverage_stack.back().coverage.has_value()) {
         // Running this restore op won't make anything renderable, so skip it.
         return true;
       }
 
+      if (popped_scissored_clip_count == popped_clip_count) {
+        // None of the restored clips were written to the clip buffer, popping
+        // them from the stack is all it takes.
+        return true;
+      }
+
       auto restore_contents =
           static_cast<ClipRestoreContents*>(element_entity.GetContents().get());
       restore_contents->SetRestoreCoverage(restore_coverage);
@@ -814,12 +1133,53 @@ bool EntityPass::RenderElement(Entity& element_entity,
   }
 #endif
 
-  element_entity.SetClipDepth(element_entity.GetClipDepth() - clip_depth_floor);
+  // Clips applied with a scissor never incremented the clip buffer, so the
+  // clip depths above them are lowered accordingly.
+  const ClipCoverageLayer& clip_layer = clip_coverage_stack.back();
+  FML_DCHECK(element_entity.GetClipDepth() >=
+             clip_depth_floor + clip_layer.scissored_clip_count);
+  element_entity.SetClipDepth(element_entity.GetClipDepth() - clip_depth_floor -
+                              clip_layer.scissored_clip_count);
   clip_replay_->RecordEntity(element_entity, clip_coverage.type);
-  if (!element_entity.Render(renderer, *result.pass)) {
+
+  std::optional<IRect> scissor;
+  if (clip_layer.scissor.has_value()) {
+    scissor = IRect(Rect::RoundOut(
+                        clip_layer.scissor->Shift(-global_pass_position)))
+                  .Intersection(IRect::MakeSize(
+                      result.pass->GetRenderTargetSize()));
+    if (!scissor.has_value()) {
+      return true;  // Nothing to render.
+    }
+  }
+
+  result.pass->SetScissorLimit(scissor);
+#ifdef IMPELLER_ENABLE_SAMPLING_CAPTURE
+  const size_t first_command = result.pass->GetCommands().size();
+#endif
+  bool rendered = element_entity.Render(renderer, *result.pass);
+  result.pass->SetScissorLimit(std::nullopt);
+  if (!rendered) {
     VALIDATION_LOG << "Failed to render entity.";
     return false;
   }
+
+#ifdef IMPELLER_ENABLE_SAMPLING_CAPTURE
+  SamplingCapture& sampling_capture =
+      *renderer.GetContext()->GetSamplingCapture();
+  if (sampling_capture.IsSamplingFrame()) {
+    Rect coverage = element_entity.GetCoverage()
+                        .value_or(Rect())
+                        .Shift(global_pass_position);
+    const auto& commands = result.pass->GetCommands();
+    for (size_t i = first_command; i < commands.size(); i++) {
+      const auto& pipeline = commands[i].pipeline;
+      uint64_t pipeline_hash =
+          pipeline ? pipeline->GetDescriptor().GetHash() : 0u;
+      sampling_capture.RecordDraw(result.pass.get(), pipeline_hash, coverage);
+    }
+  }
+#endif
   return true;
 }
 
@@ -839,7 +1199,7 @@ bool EntityPass::OnRender(
   TRACE_EVENT0("impeller", "EntityPass::OnRender");
 
   auto context = renderer.GetContext();
-  InlinePassContext pass_context(context, pass_target,
+  InlinePassContext pass_context(renderer, pass_target,
                                  GetTotalPassReads(renderer), GetElementCount(),
                                  collapsed_parent_pass);
   if (!pass_context.IsValid()) {
@@ -878,7 +1238,9 @@ bool EntityPass::OnRender(
                                     // Backdrop filters act as a entity before
                                     // everything and disrupt the optimization.
                                     !backdrop_filter_proc_;
-  for (const auto& element : elements_) {
+  std::vector<bool> occluded = FindOccludedEntities(elements_);
+  for (size_t i = 0; i < elements_.size(); i++) {
+    const auto& element = elements_[i];
     // Skip elements that are incorporated into the clear color.
     if (is_collapsing_clear_colors) {
       auto [entity_color, _] =
@@ -889,6 +1251,11 @@ bool EntityPass::OnRender(
       is_collapsing_clear_colors = false;
     }
 
+    // Skip entities that a later opaque entity paints over entirely.
+    if (occluded[i]) {
+      continue;
+    }
+
     EntityResult result =
         GetEntityForElement(element,               // element
                             renderer,              // renderer
@@ -1081,6 +1448,10 @@ size_t EntityPass::GetElementCount() const {
   return elements_.size();
 }
 
+size_t EntityPass::GetElementCapacity() const {
+  return elements_.capacity();
+}
+
 std::unique_ptr<EntityPass> EntityPass::Clone() const {
   std::vector<Element> new_elements;
   new_elements.reserve(elements_.size());
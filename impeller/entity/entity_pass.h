@@ -46,6 +46,11 @@ class EntityPass {
   struct ClipCoverageLayer {
     std::optional<Rect> coverage;
     size_t clip_depth;
+    /// The rect that draws are scissored to in place of the pixel aligned
+    /// rect clips that were never written to the clip buffer.
+    std::optional<Rect> scissor = std::nullopt;
+    /// How many of the clips up to this layer were replaced by the scissor.
+    size_t scissored_clip_count = 0;
   };
 
   using ClipCoverageStack = std::vector<ClipCoverageLayer>;
@@ -90,6 +95,16 @@ class EntityPass {
   ///
   void AddSubpassInline(std::unique_ptr<EntityPass> pass);
 
+  //----------------------------------------------------------------------------
+  /// @brief  Merges the last subpass of this pass into the subpass right
+  ///         before it, if both are composited the same way and their
+  ///         contents don't overlap. Both are then drawn into one offscreen
+  ///         texture with a single render pass.
+  ///
+  /// @return Whether the subpasses were merged.
+  ///
+  bool MergeLastSubpasses();
+
   EntityPass* GetSuperpass() const;
 
   bool Render(ContentContext& renderer,
@@ -128,6 +143,9 @@ class EntityPass {
   ///
   size_t GetElementCount() const;
 
+  // visible for testing.
+  size_t GetElementCapacity() const;
+
   void SetTransform(Matrix transform);
 
   void SetClipDepth(size_t clip_depth);
@@ -311,6 +329,11 @@ class EntityPass {
 
   uint32_t GetTotalPassReads(ContentContext& renderer) const;
 
+  /// Whether drawing the elements of `other` after the elements of this pass
+  /// into the same texture looks the same as compositing both passes one
+  /// after the other.
+  bool CanMergeWith(const EntityPass& other) const;
+
   BackdropFilterProc backdrop_filter_proc_ = nullptr;
 
   std::shared_ptr<EntityPassDelegate> delegate_ =
@@ -11,6 +11,11 @@ EntityPassDelegate::EntityPassDelegate() = default;
 
 EntityPassDelegate::~EntityPassDelegate() = default;
 
+std::optional<Scalar> EntityPassDelegate::GetSubpassOpacity(
+    const EntityPass& entity_pass) const {
+  return std::nullopt;
+}
+
 class DefaultEntityPassDelegate final : public EntityPassDelegate {
  public:
   DefaultEntityPassDelegate() = default;
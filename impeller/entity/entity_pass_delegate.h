@@ -6,6 +6,7 @@
 #define FLUTTER_IMPELLER_ENTITY_ENTITY_PASS_DELEGATE_H_
 
 #include <memory>
+#include <optional>
 
 #include "flutter/fml/macros.h"
 #include "impeller/core/texture.h"
@@ -39,6 +40,13 @@ class EntityPassDelegate {
       const FilterInput::Variant& input,
       const Matrix& effect_transform) const = 0;
 
+  /// @brief  If `entity_pass` is never collapsed and its texture is composited
+  ///         with only an opacity and without filters, returns that opacity.
+  ///         Subpasses that return the same opacity may be drawn into a shared
+  ///         texture.
+  virtual std::optional<Scalar> GetSubpassOpacity(
+      const EntityPass& entity_pass) const;
+
  private:
   EntityPassDelegate(const EntityPassDelegate&) = delete;
 
@@ -69,7 +69,9 @@ TEST_P(EntityTest, CanCreateEntity) {
 
 class TestPassDelegate final : public EntityPassDelegate {
  public:
-  explicit TestPassDelegate(bool collapse = false) : collapse_(collapse) {}
+  explicit TestPassDelegate(bool collapse = false,
+                            std::optional<Scalar> opacity = std::nullopt)
+      : collapse_(collapse), opacity_(opacity) {}
 
   // |EntityPassDelegate|
   ~TestPassDelegate() override = default;
@@ -96,9 +98,16 @@ class TestPassDelegate final : public EntityPassDelegate {
     return nullptr;
   }
 
+  // |EntityPassDelegate|
+  std::optional<Scalar> GetSubpassOpacity(
+      const EntityPass& entity_pass) const override {
+    return opacity_;
+  }
+
  private:
   const std::optional<Rect> coverage_;
   const bool collapse_;
+  const std::optional<Scalar> opacity_;
 };
 
 auto CreatePassWithRectPath(Rect rect,
@@ -192,6 +201,111 @@ TEST_P(EntityTest, EntityPassCoverageRespectsCoverageLimit) {
   }
 }
 
+TEST_P(EntityTest, EntityPassMergesDisjointSolidRects) {
+  auto make_rect_entity = [](Rect rect, Color color) {
+    Entity entity;
+    auto contents = std::make_unique<SolidColorContents>();
+    contents->SetGeometry(Geometry::MakeRect(rect));
+    contents->SetColor(color);
+    entity.SetContents(std::move(contents));
+    return entity;
+  };
+
+  EntityPass pass;
+  pass.AddEntity(
+      make_rect_entity(Rect::MakeLTRB(0, 0, 100, 100), Color::Blue()));
+  pass.AddEntity(
+      make_rect_entity(Rect::MakeLTRB(100, 0, 200, 100), Color::Blue()));
+  ASSERT_EQ(pass.GetElementCount(), 1u);
+
+  // A red rect that overlaps nothing lets the next blue rect move before it.
+  pass.AddEntity(
+      make_rect_entity(Rect::MakeLTRB(0, 200, 100, 300), Color::Red()));
+  pass.AddEntity(
+      make_rect_entity(Rect::MakeLTRB(200, 0, 300, 100), Color::Blue()));
+  ASSERT_EQ(pass.GetElementCount(), 2u);
+
+  // An overlapping blue rect has to be drawn after the red rect.
+  pass.AddEntity(
+      make_rect_entity(Rect::MakeLTRB(50, 250, 150, 350), Color::Blue()));
+  ASSERT_EQ(pass.GetElementCount(), 3u);
+
+  auto coverage = pass.GetElementsCoverage(std::nullopt);
+  ASSERT_TRUE(coverage.has_value());
+  ASSERT_RECT_NEAR(coverage.value(), Rect::MakeLTRB(0, 0, 300, 350));
+}
+
+TEST_P(EntityTest, EntityPassMergesAdjacentDisjointSubpasses) {
+  auto make_subpass = [](Rect rect, Scalar opacity) {
+    auto subpass = std::make_unique<EntityPass>();
+    Entity entity;
+    entity.SetContents(SolidColorContents::Make(
+        PathBuilder{}.AddRect(rect).TakePath(), Color::Red()));
+    subpass->AddEntity(std::move(entity));
+    subpass->SetDelegate(std::make_unique<TestPassDelegate>(false, opacity));
+    return subpass;
+  };
+
+  EntityPass pass;
+  pass.AddSubpass(make_subpass(Rect::MakeXYWH(0, 0, 100, 100), 0.5));
+  pass.AddSubpass(make_subpass(Rect::MakeXYWH(0, 150, 100, 100), 0.5));
+  ASSERT_TRUE(pass.MergeLastSubpasses());
+  ASSERT_EQ(pass.GetElementCount(), 1u);
+  auto merged_coverage = pass.GetElementsCoverage(std::nullopt);
+  ASSERT_TRUE(merged_coverage.has_value());
+  ASSERT_RECT_NEAR(merged_coverage.value(), Rect::MakeLTRB(0, 0, 100, 250));
+
+  // Overlapping contents would be blended with each other first.
+  pass.AddSubpass(make_subpass(Rect::MakeXYWH(50, 200, 100, 100), 0.5));
+  EXPECT_FALSE(pass.MergeLastSubpasses());
+
+  // Layers with different opacities can't share a texture.
+  pass.AddSubpass(make_subpass(Rect::MakeXYWH(500, 500, 9.5, 10), 0.25));
+  EXPECT_FALSE(pass.MergeLastSubpasses());
+
+  // Edges that share a pixel of the parent pass aren't merged either.
+  pass.AddSubpass(make_subpass(Rect::MakeXYWH(509.75, 500, 10, 10), 0.25));
+  EXPECT_FALSE(pass.MergeLastSubpasses());
+  EXPECT_EQ(pass.GetElementCount(), 4u);
+}
+
+TEST_P(EntityTest, EntityPassReusesElementStorageOfDestroyedPasses) {
+  auto make_rect_entity = [](Scalar x) {
+    Entity entity;
+    auto contents = std::make_unique<SolidColorContents>();
+    contents->SetGeometry(Geometry::MakeRect(Rect::MakeXYWH(x, x, 10, 10)));
+    contents->SetColor(Color::Red());
+    entity.SetContents(std::move(contents));
+    return entity;
+  };
+
+  // Take the storage that earlier tests left in the pool.
+  std::vector<std::unique_ptr<EntityPass>> earlier_passes;
+  for (auto i = 0; i < 16; i++) {
+    earlier_passes.push_back(std::make_unique<EntityPass>());
+  }
+
+  size_t capacity = 0u;
+  {
+    auto pass = std::make_unique<EntityPass>();
+    auto subpass = std::make_unique<EntityPass>();
+    for (auto i = 0; i < 100; i++) {
+      pass->AddEntity(make_rect_entity(i * 5));
+      subpass->AddEntity(make_rect_entity(i * 5));
+    }
+    pass->AddSubpass(std::move(subpass));
+    capacity = pass->GetElementCapacity();
+    ASSERT_GE(capacity, 101u);
+  }
+
+  // The storage of both passes is reused, the most recently destroyed first.
+  EntityPass first;
+  EXPECT_EQ(first.GetElementCount(), 0u);
+  EXPECT_EQ(first.GetElementCapacity(), capacity);
+  EntityPass second;
+  EXPECT_GE(second.GetElementCapacity(), 100u);
+}
+
 TEST_P(EntityTest, FilterCoverageRespectsCropRect) {
   auto image = CreateTextureForFixture("boston.jpg");
   auto filter = ColorFilterContents::MakeBlend(BlendMode::kSoftLight,
@@ -1255,6 +1369,19 @@ TEST_P(EntityTest, MorphologyFilter) {
   ASSERT_TRUE(OpenPlaygroundHere(callback));
 }
 
+TEST_P(EntityTest, MorphologyFilterSourceCoverageIncludesRadius) {
+  auto input = FilterInput::Make(Rect::MakeLTRB(0, 0, 300, 300));
+  auto output_limit = Rect::MakeLTRB(100, 100, 200, 200);
+  for (auto morph_type : {FilterContents::MorphType::kDilate,
+                          FilterContents::MorphType::kErode}) {
+    auto filter = FilterContents::MakeMorphology(input, Radius{5}, Radius{10},
+                                                 morph_type);
+    auto coverage = filter->GetSourceCoverage(Matrix(), output_limit);
+    ASSERT_TRUE(coverage.has_value());
+    EXPECT_RECT_NEAR(coverage.value(), Rect::MakeLTRB(95, 90, 205, 210));
+  }
+}
+
 TEST_P(EntityTest, SetBlendMode) {
   Entity entity;
   ASSERT_EQ(entity.GetBlendMode(), BlendMode::kSourceOver);
@@ -1451,6 +1578,35 @@ TEST_P(EntityTest, DrawAtlasWithColorSimple) {
   ASSERT_TRUE(OpenPlaygroundHere(std::move(e)));
 }
 
+TEST_P(EntityTest, DrawAtlasWithManyRotatedSprites) {
+  // Enough sprites to take the instanced path wherever it is supported.
+  auto atlas = CreateTextureForFixture("bay_bridge.jpg");
+  std::vector<Rect> texture_coordinates;
+  std::vector<Matrix> transforms;
+  std::vector<Color> colors;
+  for (int i = 0; i < 1000; i++) {
+    Scalar x = 50 + (i % 40) * 25;
+    Scalar y = 50 + (i / 40) * 25;
+    texture_coordinates.push_back(Rect::MakeXYWH((i % 10) * 20, 0, 20, 20));
+    transforms.push_back(Matrix::MakeTranslation({x, y, 0}) *
+                         Matrix::MakeRotationZ(Degrees(i * 7)));
+    colors.push_back(i % 2 == 0 ? Color::Red() : Color::Blue());
+  }
+  std::shared_ptr<AtlasContents> contents = std::make_shared<AtlasContents>();
+
+  contents->SetTransforms(std::move(transforms));
+  contents->SetTextureCoordinates(std::move(texture_coordinates));
+  contents->SetTexture(atlas);
+  contents->SetColors(colors);
+  contents->SetBlendMode(BlendMode::kModulate);
+
+  Entity e;
+  e.SetTransform(Matrix::MakeScale(GetContentScale()));
+  e.SetContents(contents);
+
+  ASSERT_TRUE(OpenPlaygroundHere(std::move(e)));
+}
+
 TEST_P(EntityTest, DrawAtlasUsesProvidedCullRectForCoverage) {
   auto atlas = CreateTextureForFixture("bay_bridge.jpg");
   auto size = atlas->GetSize();
@@ -1717,6 +1873,36 @@ TEST_P(EntityTest, ClipContentsGetClipCoverageIsCorrect) {
   }
 }
 
+TEST_P(EntityTest, ClipContentsReportsPixelAlignedRects) {
+  auto clip = std::make_shared<ClipContents>();
+  clip->SetClipOperation(Entity::ClipOperation::kIntersect);
+  clip->SetGeometry(Geometry::MakeRect(Rect::MakeLTRB(10, 10, 50, 50)));
+  auto current_clip = Rect::MakeLTRB(0, 0, 100, 100);
+
+  Entity entity;
+  ASSERT_TRUE(
+      clip->GetClipCoverage(entity, current_clip).is_pixel_aligned_rect);
+
+  entity.SetTransform(Matrix::MakeTranslation({0.5, 0}));
+  ASSERT_FALSE(
+      clip->GetClipCoverage(entity, current_clip).is_pixel_aligned_rect);
+
+  entity.SetTransform(Matrix::MakeRotationZ(Degrees(90)));
+  ASSERT_FALSE(
+      clip->GetClipCoverage(entity, current_clip).is_pixel_aligned_rect);
+
+  // Paths are always written to the clip buffer.
+  clip->SetGeometry(Geometry::MakeFillPath(
+      PathBuilder{}.AddRect(Rect::MakeLTRB(10, 10, 50, 50)).TakePath()));
+  ASSERT_FALSE(
+      clip->GetClipCoverage(Entity{}, current_clip).is_pixel_aligned_rect);
+
+  clip->SetGeometry(Geometry::MakeRect(Rect::MakeLTRB(10, 10, 50, 50)));
+  clip->SetClipOperation(Entity::ClipOperation::kDifference);
+  ASSERT_FALSE(
+      clip->GetClipCoverage(Entity{}, current_clip).is_pixel_aligned_rect);
+}
+
 TEST_P(EntityTest, RRectShadowTest) {
   auto callback = [&](ContentContext& context, RenderPass& pass) {
     static Color color = Color::Red();
@@ -2163,6 +2349,23 @@ TEST_P(EntityTest, RuntimeEffect) {
   ASSERT_TRUE(OpenPlaygroundHere(callback));
 }
 
+TEST_P(EntityTest, RuntimeEffectPrewarmRegistersTheShader) {
+  if (GetParam() != PlaygroundBackend::kMetal) {
+    GTEST_SKIP_("This backend doesn't support runtime effects.");
+  }
+
+  auto runtime_stage =
+      OpenAssetAsRuntimeStage("runtime_stage_example.frag.iplr");
+  ASSERT_TRUE(runtime_stage->IsDirty());
+
+  auto context = GetContext();
+  ASSERT_TRUE(RuntimeEffectContents::Prewarm(*context, runtime_stage));
+  ASSERT_FALSE(runtime_stage->IsDirty());
+  ASSERT_NE(context->GetShaderLibrary()->GetFunction(
+                runtime_stage->GetEntrypoint(), ShaderStage::kFragment),
+            nullptr);
+}
+
 TEST_P(EntityTest, InheritOpacityTest) {
   Entity entity;
 
@@ -2337,6 +2540,19 @@ TEST_P(EntityTest, SolidColorContentsIsOpaque) {
   ASSERT_FALSE(contents.IsOpaque());
 }
 
+TEST_P(EntityTest, SolidColorContentsOccludesArea) {
+  SolidColorContents contents;
+  contents.SetGeometry(Geometry::MakeRect(Rect::MakeXYWH(0, 0, 100, 100)));
+  contents.SetColor(Color::CornflowerBlue());
+  Entity entity;
+  ASSERT_TRUE(contents.OccludesArea(entity, Rect::MakeXYWH(10, 10, 50, 50)));
+  ASSERT_FALSE(contents.OccludesArea(entity, Rect::MakeXYWH(60, 60, 50, 50)));
+  entity.SetTransform(Matrix::MakeTranslation({50, 50}));
+  ASSERT_TRUE(contents.OccludesArea(entity, Rect::MakeXYWH(60, 60, 50, 50)));
+  contents.SetColor(Color::CornflowerBlue().WithAlpha(0.5));
+  ASSERT_FALSE(contents.OccludesArea(entity, Rect::MakeXYWH(60, 60, 50, 50)));
+}
+
 TEST_P(EntityTest, ConicalGradientContentsIsOpaque) {
   ConicalGradientContents contents;
   contents.SetColors({Color::CornflowerBlue()});
@@ -2524,6 +2740,50 @@ TEST_P(EntityTest, AdvancedBlendCoverageHintIsNotResetByEntityPass) {
   }
 }
 
+TEST_P(EntityTest, ChainedColorMatrixFiltersRenderInOnePass) {
+  auto test_allocator = std::make_shared<TestRenderTargetAllocator>(
+      GetContext()->GetResourceAllocator());
+  auto content_context = ContentContext(
+      GetContext(), TypographerContextSkia::Make(), test_allocator);
+  auto image = FilterInput::Make(CreateTextureForFixture("boston.jpg"));
+
+  ColorMatrix sepia = {
+      0.393, 0.769, 0.189, 0, 0,  //
+      0.349, 0.686, 0.168, 0, 0,  //
+      0.272, 0.534, 0.131, 0, 0,  //
+      0,     0,     0,     1, 0,  //
+  };
+  ColorMatrix invert = {
+      -1, 0,  0,  0, 1,  //
+      0,  -1, 0,  0, 1,  //
+      0,  0,  -1, 0, 1,  //
+      0,  0,  0,  1, 0,  //
+  };
+  ColorMatrix brighten = {
+      2, 0, 0, 0, 0,  //
+      0, 2, 0, 0, 0,  //
+      0, 0, 2, 0, 0,  //
+      0, 0, 0, 1, 0,  //
+  };
+
+  // Inverting never leaves the [0, 1] range, so it is folded into the sepia
+  // matrix.
+  std::shared_ptr<FilterContents> inverted =
+      ColorFilterContents::MakeColorMatrix(image, invert);
+  auto fused =
+      ColorFilterContents::MakeColorMatrix(FilterInput::Make(inverted), sepia);
+  ASSERT_TRUE(fused->GetEntity(content_context, Entity(), std::nullopt));
+  EXPECT_TRUE(test_allocator->GetDescriptors().empty());
+
+  // Brightening clamps, so its result is rendered first.
+  std::shared_ptr<FilterContents> brightened =
+      ColorFilterContents::MakeColorMatrix(image, brighten);
+  auto chained = ColorFilterContents::MakeColorMatrix(
+      FilterInput::Make(brightened), sepia);
+  ASSERT_TRUE(chained->GetEntity(content_context, Entity(), std::nullopt));
+  EXPECT_FALSE(test_allocator->GetDescriptors().empty());
+}
+
 TEST_P(EntityTest, SpecializationConstantsAreAppliedToVariants) {
   auto content_context =
       ContentContext(GetContext(), TypographerContextSkia::Make());
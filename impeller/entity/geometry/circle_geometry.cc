@@ -95,4 +95,14 @@ bool CircleGeometry::IsAxisAlignedRect() const {
   return false;
 }
 
+std::optional<RoundRect> CircleGeometry::GetRoundRect() const {
+  // Stroked circles are rings.
+  if (stroke_width_ >= 0) {
+    return std::nullopt;
+  }
+  return RoundRect{Rect::MakeLTRB(center_.x - radius_, center_.y - radius_,
+                                  center_.x + radius_, center_.y + radius_),
+                   Size(radius_, radius_)};
+}
+
 }  // namespace impeller
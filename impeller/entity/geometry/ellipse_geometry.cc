@@ -52,4 +52,8 @@ bool EllipseGeometry::IsAxisAlignedRect() const {
   return false;
 }
 
+std::optional<RoundRect> EllipseGeometry::GetRoundRect() const {
+  return RoundRect{bounds_, bounds_.GetSize() * 0.5};
+}
+
 }  // namespace impeller
@@ -4,6 +4,7 @@
 
 #include "impeller/entity/geometry/fill_path_geometry.h"
 #include "impeller/core/formats.h"
+#include "impeller/entity/tessellation_cache.h"
 
 namespace impeller {
 
@@ -36,11 +37,42 @@ GeometryResult FillPathGeometry::GetPositionBuffer(
     };
   }
 
+  // Paths that change every frame, as told by the volatile bit, are neither
+  // hashed nor offered to the cache and are tessellated straight into the
+  // host buffer.
+  TessellationCache* cache = nullptr;
+  TessellationCache::Key key;
+  Scalar scale = entity.GetTransform().GetMaxBasisLength();
+  if (!path_.IsVolatile()) {
+    cache = renderer.GetTessellationCache().get();
+    key = TessellationCache::MakeKey(path_, scale);
+    if (auto cached = cache->Get(key); cached.has_value()) {
+      return GeometryResult{
+          .type = PrimitiveType::kTriangle,
+          .vertex_buffer = cached.value(),
+          .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                       entity.GetTransform(),
+          .prevent_overdraw = false,
+      };
+    }
+    // Tessellate at the scale of the cache key so that the result can be
+    // reused for any scale that maps to the same key.
+    scale = TessellationCache::GetTessellationScale(key);
+  }
+
   auto tesselation_result = renderer.GetTessellator()->Tessellate(
-      path_, entity.GetTransform().GetMaxBasisLength(),
-      [&vertex_buffer, &host_buffer](
+      path_, scale,
+      [&vertex_buffer, &host_buffer, cache, &key](
           const float* vertices, size_t vertices_count, const uint16_t* indices,
           size_t indices_count) {
+        if (auto cached =
+                cache ? cache->Store(key, vertices, vertices_count, indices,
+                                     indices_count)
+                      : std::nullopt;
+            cached.has_value()) {
+          vertex_buffer = cached.value();
+          return true;
+        }
         vertex_buffer.vertex_buffer = host_buffer.Emplace(
             vertices, vertices_count * sizeof(float) * 2, alignof(float));
         if (indices != nullptr) {
@@ -67,6 +99,58 @@ GeometryResult FillPathGeometry::GetPositionBuffer(
   };
 }
 
+bool FillPathGeometry::ShouldStencilThenCover(const Path& path) {
+  switch (path.GetFillType()) {
+    case FillType::kNonZero:
+      if (path.IsConvex()) {
+        return false;
+      }
+      break;
+    case FillType::kOdd:
+      break;
+    case FillType::kPositive:
+    case FillType::kNegative:
+      // The cover pass can only tell zero from nonzero stencil values.
+      return false;
+  }
+  return path.GetComponentCount() >= kMinStencilThenCoverComponents;
+}
+
+// |Geometry|
+GeometryResult FillPathGeometry::GetStencilThenCoverPositionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  // The stencil buffer also holds the clip depth. Only at a depth of zero is
+  // every stencil value known to be zero, leaving it free to count windings.
+  if (entity.GetClipDepth() != 0u || !pass.HasStencilAttachment() ||
+      !ShouldStencilThenCover(path_)) {
+    return GetPositionBuffer(renderer, entity, pass);
+  }
+
+  // The strip generated for convex paths is not a valid triangulation of
+  // other paths, but its triangles still cover every point as many times, in
+  // signed facing, as the contours wind around it. That is all the stencil
+  // pass needs.
+  auto points = renderer.GetTessellator()->TessellateConvex(
+      path_, entity.GetTransform().GetMaxBasisLength());
+
+  VertexBuffer vertex_buffer;
+  vertex_buffer.vertex_buffer = pass.GetTransientsBuffer().Emplace(
+      points.data(), points.size() * sizeof(Point), alignof(Point));
+  vertex_buffer.vertex_count = points.size();
+  vertex_buffer.index_type = IndexType::kNone;
+
+  return GeometryResult{
+      .type = PrimitiveType::kTriangleStrip,
+      .vertex_buffer = vertex_buffer,
+      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   entity.GetTransform(),
+      .prevent_overdraw = false,
+      .stencil_then_cover = path_.GetFillType(),
+  };
+}
+
 // |Geometry|
 GeometryResult FillPathGeometry::GetPositionUVBuffer(
     Rect texture_coverage,
@@ -23,12 +23,26 @@ class FillPathGeometry final : public Geometry {
   // |Geometry|
   bool CoversArea(const Matrix& transform, const Rect& rect) const override;
 
+  /// The number of components above which a path that is not trivially
+  /// convex is filled with stencil-then-cover instead of being triangulated.
+  static constexpr size_t kMinStencilThenCoverComponents = 32u;
+
+  /// @brief  Whether filling the path with a stencil-then-cover pass is
+  ///         expected to be cheaper than triangulating it on the CPU.
+  static bool ShouldStencilThenCover(const Path& path);
+
  private:
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
                                    const Entity& entity,
                                    RenderPass& pass) const override;
 
+  // |Geometry|
+  GeometryResult GetStencilThenCoverPositionBuffer(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass) const override;
+
   // |Geometry|
   GeometryVertexType GetVertexType() const override;
 
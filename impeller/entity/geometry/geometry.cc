@@ -14,6 +14,7 @@
 #include "impeller/entity/geometry/line_geometry.h"
 #include "impeller/entity/geometry/point_field_geometry.h"
 #include "impeller/entity/geometry/rect_geometry.h"
+#include "impeller/entity/geometry/rect_list_geometry.h"
 #include "impeller/entity/geometry/round_rect_geometry.h"
 #include "impeller/entity/geometry/stroke_path_geometry.h"
 #include "impeller/geometry/rect.h"
@@ -150,6 +151,13 @@ GeometryResult Geometry::GetPositionUVBuffer(Rect texture_coverage,
   return {};
 }
 
+GeometryResult Geometry::GetStencilThenCoverPositionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  return GetPositionBuffer(renderer, entity, pass);
+}
+
 std::shared_ptr<Geometry> Geometry::MakeFillPath(
     Path path,
     std::optional<Rect> inner_rect) {
@@ -183,6 +191,10 @@ std::shared_ptr<Geometry> Geometry::MakeRect(const Rect& rect) {
   return std::make_shared<RectGeometry>(rect);
 }
 
+std::shared_ptr<Geometry> Geometry::MakeRectList(std::vector<Rect> rects) {
+  return std::make_shared<RectListGeometry>(std::move(rects));
+}
+
 std::shared_ptr<Geometry> Geometry::MakeOval(const Rect& rect) {
   return std::make_shared<EllipseGeometry>(rect);
 }
@@ -218,4 +230,12 @@ bool Geometry::IsAxisAlignedRect() const {
   return false;
 }
 
+std::vector<Rect> Geometry::GetRects() const {
+  return {};
+}
+
+std::optional<RoundRect> Geometry::GetRoundRect() const {
+  return std::nullopt;
+}
+
 }  // namespace impeller
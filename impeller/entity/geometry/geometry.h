@@ -5,11 +5,14 @@
 #ifndef FLUTTER_IMPELLER_ENTITY_GEOMETRY_GEOMETRY_H_
 #define FLUTTER_IMPELLER_ENTITY_GEOMETRY_GEOMETRY_H_
 
+#include <optional>
+
 #include "impeller/core/formats.h"
 #include "impeller/core/vertex_buffer.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/texture_fill.vert.h"
+#include "impeller/geometry/path.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/vertex_buffer_builder.h"
 
@@ -22,6 +25,10 @@ struct GeometryResult {
   VertexBuffer vertex_buffer;
   Matrix transform;
   bool prevent_overdraw;
+  /// When set, |vertex_buffer| does not fill the geometry by itself. It must
+  /// be drawn into the stencil buffer with this winding rule and the coverage
+  /// of the geometry then drawn where the stencil is not zero.
+  std::optional<FillType> stencil_then_cover = std::nullopt;
 };
 
 static const GeometryResult kEmptyResult = {
@@ -37,6 +44,12 @@ enum GeometryVertexType {
   kUV,
 };
 
+/// @brief A filled rectangle with the same elliptical radii at each corner.
+struct RoundRect {
+  Rect bounds;
+  Size radii;
+};
+
 /// @brief Compute UV geometry for a VBB that contains only position geometry.
 ///
 /// texture_origin should be set to 0, 0 for stroke and stroke based geometry,
@@ -72,6 +85,8 @@ class Geometry {
 
   static std::shared_ptr<Geometry> MakeRect(const Rect& rect);
 
+  static std::shared_ptr<Geometry> MakeRectList(std::vector<Rect> rects);
+
   static std::shared_ptr<Geometry> MakeOval(const Rect& rect);
 
   static std::shared_ptr<Geometry> MakeLine(const Point& p0,
@@ -103,6 +118,18 @@ class Geometry {
                                              const Entity& entity,
                                              RenderPass& pass) const = 0;
 
+  /// @brief    Like `GetPositionBuffer`, but allows the geometry to skip
+  ///           triangulation and return the vertices of a stencil-then-cover
+  ///           fill instead, as indicated by
+  ///           `GeometryResult::stencil_then_cover`.
+  ///
+  ///           Only contents that render both the stencil and the cover pass
+  ///           may call this.
+  virtual GeometryResult GetStencilThenCoverPositionBuffer(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass) const;
+
   virtual GeometryVertexType GetVertexType() const = 0;
 
   virtual std::optional<Rect> GetCoverage(const Matrix& transform) const = 0;
@@ -121,6 +148,19 @@ class Geometry {
 
   virtual bool IsAxisAlignedRect() const;
 
+  /// @brief    Returns the rectangles that make up this geometry when it is
+  ///           exactly a set of non-overlapping untransformed rectangles.
+  ///
+  /// @returns  An empty list for any other kind of geometry.
+  virtual std::vector<Rect> GetRects() const;
+
+  /// @brief    Returns the shape of this geometry when it is a filled rounded
+  ///           rectangle, which includes rectangles, circles and ellipses.
+  ///           Such shapes can be anti-aliased analytically.
+  ///
+  /// @returns  std::nullopt for any other kind of geometry.
+  virtual std::optional<RoundRect> GetRoundRect() const;
+
  protected:
   static GeometryResult ComputePositionGeometry(
       const Tessellator::VertexGenerator& generator,
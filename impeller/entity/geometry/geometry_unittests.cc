@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "flutter/testing/testing.h"
+#include "impeller/entity/geometry/fill_path_geometry.h"
 #include "impeller/entity/geometry/geometry.h"
 #include "impeller/geometry/path_builder.h"
 
@@ -36,6 +37,31 @@ TEST(EntityGeometryTest, FillPathGeometryCoversAreaNoInnerRect) {
   ASSERT_FALSE(geometry->CoversArea({}, Rect()));
 }
 
+TEST(EntityGeometryTest, FillPathGeometryStencilsThenCoversComplexPaths) {
+  auto make_zigzag = [](size_t segments, Convexity convexity, FillType fill) {
+    PathBuilder builder;
+    builder.SetConvexity(convexity);
+    builder.MoveTo({0, 0});
+    for (auto i = 0u; i < segments; i++) {
+      builder.LineTo({i * 10.0f, (i % 2) * 100.0f});
+    }
+    return builder.Close().TakePath(fill);
+  };
+  const auto kMany = FillPathGeometry::kMinStencilThenCoverComponents;
+
+  EXPECT_TRUE(FillPathGeometry::ShouldStencilThenCover(
+      make_zigzag(kMany, Convexity::kUnknown, FillType::kNonZero)));
+  EXPECT_TRUE(FillPathGeometry::ShouldStencilThenCover(
+      make_zigzag(kMany, Convexity::kConvex, FillType::kOdd)));
+  // Convex nonzero paths are already cheap to fill without libtess.
+  EXPECT_FALSE(FillPathGeometry::ShouldStencilThenCover(
+      make_zigzag(kMany, Convexity::kConvex, FillType::kNonZero)));
+  EXPECT_FALSE(FillPathGeometry::ShouldStencilThenCover(
+      make_zigzag(4u, Convexity::kUnknown, FillType::kNonZero)));
+  EXPECT_FALSE(FillPathGeometry::ShouldStencilThenCover(
+      make_zigzag(kMany, Convexity::kUnknown, FillType::kPositive)));
+}
+
 TEST(EntityGeometryTest, LineGeometryCoverage) {
   {
     auto geometry = Geometry::MakeLine({10, 10}, {20, 10}, 2, Cap::kButt);
@@ -71,5 +97,35 @@ TEST(EntityGeometryTest, RoundRectGeometryCoversArea) {
   EXPECT_TRUE(geometry->CoversArea({}, Rect::MakeLTRB(1, 30, 99, 70)));
 }
 
+TEST(EntityGeometryTest, SimpleShapesProvideTheirRoundRect) {
+  auto rect = Geometry::MakeRect(Rect::MakeLTRB(0, 0, 100, 50))->GetRoundRect();
+  ASSERT_TRUE(rect.has_value());
+  EXPECT_EQ(rect->bounds, Rect::MakeLTRB(0, 0, 100, 50));
+  EXPECT_EQ(rect->radii, Size());
+
+  auto round_rect =
+      Geometry::MakeRoundRect(Rect::MakeLTRB(0, 0, 100, 50), Size(10, 5))
+          ->GetRoundRect();
+  ASSERT_TRUE(round_rect.has_value());
+  EXPECT_EQ(round_rect->radii, Size(10, 5));
+
+  auto circle = Geometry::MakeCircle({50, 50}, 10)->GetRoundRect();
+  ASSERT_TRUE(circle.has_value());
+  EXPECT_EQ(circle->bounds, Rect::MakeLTRB(40, 40, 60, 60));
+  EXPECT_EQ(circle->radii, Size(10, 10));
+
+  auto oval = Geometry::MakeOval(Rect::MakeLTRB(0, 0, 100, 50))->GetRoundRect();
+  ASSERT_TRUE(oval.has_value());
+  EXPECT_EQ(oval->radii, Size(50, 25));
+
+  EXPECT_FALSE(
+      Geometry::MakeStrokedCircle({50, 50}, 10, 2)->GetRoundRect().has_value());
+  EXPECT_FALSE(Geometry::MakeFillPath(PathBuilder{}.AddCircle({50, 50}, 10)
+                                          .TakePath())
+                   ->GetRoundRect()
+                   .has_value());
+}
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -4,6 +4,7 @@
 
 #include "impeller/entity/geometry/point_field_geometry.h"
 
+#include "impeller/geometry/point_batch.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/compute_command.h"
 
@@ -278,26 +279,11 @@ GeometryVertexType PointFieldGeometry::GetVertexType() const {
 // |Geometry|
 std::optional<Rect> PointFieldGeometry::GetCoverage(
     const Matrix& transform) const {
-  if (points_.size() > 0) {
-    // Doesn't use MakePointBounds as this isn't resilient to points that
-    // all lie along the same axis.
-    auto first = points_.begin();
-    auto last = points_.end();
-    auto left = first->x;
-    auto top = first->y;
-    auto right = first->x;
-    auto bottom = first->y;
-    for (auto it = first + 1; it < last; ++it) {
-      left = std::min(left, it->x);
-      top = std::min(top, it->y);
-      right = std::max(right, it->x);
-      bottom = std::max(bottom, it->y);
-    }
-    auto coverage = Rect::MakeLTRB(left - radius_, top - radius_,
-                                   right + radius_, bottom + radius_);
-    return coverage.TransformBounds(transform);
+  auto bounds = ComputePointBounds(points_.data(), points_.size());
+  if (!bounds.has_value()) {
+    return std::nullopt;
   }
-  return std::nullopt;
+  return bounds->Expand(radius_).TransformBounds(transform);
 }
 
 }  // namespace impeller
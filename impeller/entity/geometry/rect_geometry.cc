@@ -57,4 +57,12 @@ bool RectGeometry::IsAxisAlignedRect() const {
   return true;
 }
 
+std::vector<Rect> RectGeometry::GetRects() const {
+  return {rect_};
+}
+
+std::optional<RoundRect> RectGeometry::GetRoundRect() const {
+  return RoundRect{rect_, Size()};
+}
+
 }  // namespace impeller
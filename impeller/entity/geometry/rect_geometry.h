@@ -21,6 +21,12 @@ class RectGeometry final : public Geometry {
   // |Geometry|
   bool IsAxisAlignedRect() const override;
 
+  // |Geometry|
+  std::vector<Rect> GetRects() const override;
+
+  // |Geometry|
+  std::optional<RoundRect> GetRoundRect() const override;
+
  private:
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
@@ -0,0 +1,96 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/geometry/rect_list_geometry.h"
+
+namespace impeller {
+
+RectListGeometry::RectListGeometry(std::vector<Rect> rects)
+    : rects_(std::move(rects)) {}
+
+std::vector<Rect> RectListGeometry::GetRects() const {
+  return rects_;
+}
+
+VertexBufferBuilder<SolidFillVertexShader::PerVertexData>
+RectListGeometry::CreateVertices() const {
+  VertexBufferBuilder<SolidFillVertexShader::PerVertexData> vtx_builder;
+  vtx_builder.Reserve(rects_.size() * 6);
+  for (const Rect& rect : rects_) {
+    auto points = rect.GetPoints();
+    // Two triangles per rectangle, sharing the top-right to bottom-left
+    // diagonal.
+    for (size_t index : {0u, 1u, 2u, 1u, 2u, 3u}) {
+      vtx_builder.AppendVertex({.position = points[index]});
+    }
+  }
+  return vtx_builder;
+}
+
+GeometryResult RectListGeometry::GetPositionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  auto& host_buffer = pass.GetTransientsBuffer();
+  return GeometryResult{
+      .type = PrimitiveType::kTriangle,
+      .vertex_buffer = CreateVertices().CreateVertexBuffer(host_buffer),
+      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   entity.GetTransform(),
+      .prevent_overdraw = false,
+  };
+}
+
+// |Geometry|
+GeometryResult RectListGeometry::GetPositionUVBuffer(
+    Rect texture_coverage,
+    Matrix effect_transform,
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  auto vtx_builder = CreateVertices();
+  auto uv_vtx_builder =
+      ComputeUVGeometryCPU(vtx_builder, texture_coverage.GetOrigin(),
+                           texture_coverage.GetSize(), effect_transform);
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+  return GeometryResult{
+      .type = PrimitiveType::kTriangle,
+      .vertex_buffer = uv_vtx_builder.CreateVertexBuffer(host_buffer),
+      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   entity.GetTransform(),
+      .prevent_overdraw = false,
+  };
+}
+
+GeometryVertexType RectListGeometry::GetVertexType() const {
+  return GeometryVertexType::kPosition;
+}
+
+std::optional<Rect> RectListGeometry::GetCoverage(
+    const Matrix& transform) const {
+  if (rects_.empty()) {
+    return std::nullopt;
+  }
+  Rect coverage = rects_[0];
+  for (const Rect& rect : rects_) {
+    coverage = coverage.Union(rect);
+  }
+  return coverage.TransformBounds(transform);
+}
+
+bool RectListGeometry::CoversArea(const Matrix& transform,
+                                  const Rect& rect) const {
+  if (!transform.IsTranslationScaleOnly()) {
+    return false;
+  }
+  for (const Rect& list_rect : rects_) {
+    if (list_rect.TransformBounds(transform).Contains(rect)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace impeller
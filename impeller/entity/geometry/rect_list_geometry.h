@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_GEOMETRY_RECT_LIST_GEOMETRY_H_
+#define FLUTTER_IMPELLER_ENTITY_GEOMETRY_RECT_LIST_GEOMETRY_H_
+
+#include <vector>
+
+#include "impeller/entity/geometry/geometry.h"
+
+namespace impeller {
+
+/// @brief A list of rectangles drawn as a single triangle list.
+///
+///        This is produced by `EntityPass` when it merges adjacent rectangle
+///        draws that would otherwise each be recorded as their own command.
+///        The rectangles are expected not to overlap.
+class RectListGeometry final : public Geometry {
+ public:
+  explicit RectListGeometry(std::vector<Rect> rects);
+
+  ~RectListGeometry() = default;
+
+  // |Geometry|
+  bool CoversArea(const Matrix& transform, const Rect& rect) const override;
+
+  // |Geometry|
+  std::vector<Rect> GetRects() const override;
+
+ private:
+  // |Geometry|
+  GeometryResult GetPositionBuffer(const ContentContext& renderer,
+                                   const Entity& entity,
+                                   RenderPass& pass) const override;
+
+  // |Geometry|
+  GeometryVertexType GetVertexType() const override;
+
+  // |Geometry|
+  std::optional<Rect> GetCoverage(const Matrix& transform) const override;
+
+  // |Geometry|
+  GeometryResult GetPositionUVBuffer(Rect texture_coverage,
+                                     Matrix effect_transform,
+                                     const ContentContext& renderer,
+                                     const Entity& entity,
+                                     RenderPass& pass) const override;
+
+  VertexBufferBuilder<SolidFillVertexShader::PerVertexData> CreateVertices()
+      const;
+
+  std::vector<Rect> rects_;
+
+  RectListGeometry(const RectListGeometry&) = delete;
+
+  RectListGeometry& operator=(const RectListGeometry&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_GEOMETRY_RECT_LIST_GEOMETRY_H_
@@ -82,4 +82,8 @@ bool RoundRectGeometry::IsAxisAlignedRect() const {
   return false;
 }
 
+std::optional<RoundRect> RoundRectGeometry::GetRoundRect() const {
+  return RoundRect{bounds_, radii_};
+}
+
 }  // namespace impeller
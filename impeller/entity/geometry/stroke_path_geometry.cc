@@ -5,6 +5,7 @@
 #include "impeller/entity/geometry/stroke_path_geometry.h"
 
 #include "impeller/geometry/path_builder.h"
+#include "impeller/tessellator/tessellator.h"
 
 namespace impeller {
 
@@ -229,6 +230,7 @@ StrokePathGeometry::CapProc StrokePathGeometry::GetCapProc(Cap stroke_cap) {
 // static
 VertexBufferBuilder<SolidFillVertexShader::PerVertexData>
 StrokePathGeometry::CreateSolidStrokeVertices(
+    Tessellator& tessellator,
     const Path& path,
     Scalar stroke_width,
     Scalar scaled_miter_limit,
@@ -236,12 +238,7 @@ StrokePathGeometry::CreateSolidStrokeVertices(
     const StrokePathGeometry::CapProc& cap_proc,
     Scalar scale) {
   VertexBufferBuilder<VS::PerVertexData> vtx_builder;
-  auto point_buffer = std::make_unique<std::vector<Point>>();
-  // 512 is an arbitrary choice that should be big enough for most paths without
-  // needing to reallocate. If we have motivating benchmarks we should raise or
-  // lower this number, cause dnfield just made it up!
-  point_buffer->reserve(512);
-  auto polyline = path.CreatePolyline(scale, std::move(point_buffer));
+  const auto& polyline = tessellator.CreateTempPolyline(path, scale);
 
   VS::PerVertexData vtx;
 
@@ -278,7 +275,8 @@ StrokePathGeometry::CreateSolidStrokeVertices(
           const Path::PolylineContour& contour) {
         auto is_last_component =
             component_start_index ==
-            contour.components.back().component_start_index;
+            polyline.components[contour.components_end_index - 1]
+                .component_start_index;
 
         for (size_t point_i = component_start_index;
              point_i < component_end_index; point_i++) {
@@ -313,7 +311,8 @@ StrokePathGeometry::CreateSolidStrokeVertices(
           const Path::PolylineContour& contour) {
         auto is_last_component =
             component_start_index ==
-            contour.components.back().component_start_index;
+            polyline.components[contour.components_end_index - 1]
+                .component_start_index;
 
         for (size_t point_i = component_start_index;
              point_i < component_end_index; point_i++) {
@@ -398,17 +397,19 @@ StrokePathGeometry::CreateSolidStrokeVertices(
     }
 
     for (size_t contour_component_i = 0;
-         contour_component_i < contour.components.size();
+         contour_component_i < contour.GetComponentCount();
          contour_component_i++) {
-      auto component = contour.components[contour_component_i];
+      auto component =
+          polyline.GetContourComponent(contour, contour_component_i);
       auto is_last_component =
-          contour_component_i == contour.components.size() - 1;
+          contour_component_i == contour.GetComponentCount() - 1;
 
       auto component_start_index = component.component_start_index;
       auto component_end_index =
-          is_last_component ? contour_end_point_i - 1
-                            : contour.components[contour_component_i + 1]
-                                  .component_start_index;
+          is_last_component
+              ? contour_end_point_i - 1
+              : polyline.GetContourComponent(contour, contour_component_i + 1)
+                    .component_start_index;
       if (component.is_curve) {
         add_vertices_for_curve_component(
             component_start_index, component_end_index, contour_start_point_i,
@@ -453,9 +454,9 @@ GeometryResult StrokePathGeometry::GetPositionBuffer(
 
   auto& host_buffer = pass.GetTransientsBuffer();
   auto vertex_builder = CreateSolidStrokeVertices(
-      path_, stroke_width, miter_limit_ * stroke_width_ * 0.5,
-      GetJoinProc(stroke_join_), GetCapProc(stroke_cap_),
-      entity.GetTransform().GetMaxBasisLength());
+      *renderer.GetTessellator(), path_, stroke_width,
+      miter_limit_ * stroke_width_ * 0.5, GetJoinProc(stroke_join_),
+      GetCapProc(stroke_cap_), entity.GetTransform().GetMaxBasisLength());
 
   return GeometryResult{
       .type = PrimitiveType::kTriangleStrip,
@@ -485,9 +486,9 @@ GeometryResult StrokePathGeometry::GetPositionUVBuffer(
 
   auto& host_buffer = pass.GetTransientsBuffer();
   auto stroke_builder = CreateSolidStrokeVertices(
-      path_, stroke_width, miter_limit_ * stroke_width_ * 0.5,
-      GetJoinProc(stroke_join_), GetCapProc(stroke_cap_),
-      entity.GetTransform().GetMaxBasisLength());
+      *renderer.GetTessellator(), path_, stroke_width,
+      miter_limit_ * stroke_width_ * 0.5, GetJoinProc(stroke_join_),
+      GetCapProc(stroke_cap_), entity.GetTransform().GetMaxBasisLength());
   auto vertex_builder = ComputeUVGeometryCPU(
       stroke_builder, {0, 0}, texture_coverage.GetSize(), effect_transform);
 
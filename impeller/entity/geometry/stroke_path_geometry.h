@@ -72,7 +72,8 @@ class StrokePathGeometry final : public Geometry {
       const Point& end_offset);
 
   static VertexBufferBuilder<SolidFillVertexShader::PerVertexData>
-  CreateSolidStrokeVertices(const Path& path,
+  CreateSolidStrokeVertices(Tessellator& tessellator,
+                            const Path& path,
                             Scalar stroke_width,
                             Scalar scaled_miter_limit,
                             const JoinProc& join_proc,
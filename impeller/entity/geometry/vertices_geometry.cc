@@ -4,10 +4,15 @@
 
 #include "impeller/entity/geometry/vertices_geometry.h"
 
+#include <memory>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 
-#include <utility>
+#include "flutter/fml/hash_combine.h"
 #include "impeller/core/formats.h"
+#include "impeller/entity/tessellation_cache.h"
+#include "impeller/geometry/point_batch.h"
 
 namespace impeller {
 
@@ -50,6 +55,22 @@ static std::vector<uint16_t> fromFanIndices(
   return unrolled_indices;
 }
 
+static size_t HashBytes(const std::vector<uint8_t>& bytes) {
+  return std::hash<std::string_view>{}(std::string_view(
+      reinterpret_cast<const char*>(bytes.data()), bytes.size()));
+}
+
+template <typename T>
+static void AppendBytes(std::vector<uint8_t>& bytes,
+                        const std::vector<T>& values) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  const size_t size = values.size();
+  const auto* size_data = reinterpret_cast<const uint8_t*>(&size);
+  bytes.insert(bytes.end(), size_data, size_data + sizeof(size));
+  const auto* data = reinterpret_cast<const uint8_t*>(values.data());
+  bytes.insert(bytes.end(), data, data + size * sizeof(T));
+}
+
 /////// Vertices Geometry ///////
 
 VerticesGeometry::VerticesGeometry(std::vector<Point> vertices,
@@ -65,6 +86,9 @@ VerticesGeometry::VerticesGeometry(std::vector<Point> vertices,
       bounds_(bounds),
       vertex_mode_(vertex_mode) {
   NormalizeIndices();
+  auto content = std::make_shared<std::vector<uint8_t>>(SerializeContent());
+  content_hash_ = HashBytes(*content);
+  content_ = std::move(content);
 }
 
 PrimitiveType VerticesGeometry::GetPrimitiveType() const {
@@ -104,18 +128,55 @@ std::optional<Rect> VerticesGeometry::GetTextureCoordinateCoverge() const {
     return std::nullopt;
   }
 
-  return Rect::MakePointBounds(texture_coordinates_.begin(),
-                               texture_coordinates_.end());
+  return ComputePointBounds(texture_coordinates_.data(),
+                            texture_coordinates_.size());
 }
 
-GeometryResult VerticesGeometry::GetPositionBuffer(
-    const ContentContext& renderer,
-    const Entity& entity,
-    RenderPass& pass) const {
+std::vector<uint8_t> VerticesGeometry::SerializeContent() const {
+  std::vector<uint8_t> bytes;
+  bytes.reserve(sizeof(vertex_mode_) + 4 * sizeof(size_t) +
+                vertices_.size() * sizeof(Point) +
+                colors_.size() * sizeof(Color) +
+                texture_coordinates_.size() * sizeof(Point) +
+                indices_.size() * sizeof(uint16_t));
+  const auto* mode = reinterpret_cast<const uint8_t*>(&vertex_mode_);
+  bytes.insert(bytes.end(), mode, mode + sizeof(vertex_mode_));
+  AppendBytes(bytes, vertices_);
+  AppendBytes(bytes, colors_);
+  AppendBytes(bytes, texture_coordinates_);
+  AppendBytes(bytes, indices_);
+  return bytes;
+}
+
+GeometryResult VerticesGeometry::MakeResult(const VertexBuffer& vertex_buffer,
+                                            const Entity& entity,
+                                            const RenderPass& pass) const {
+  return GeometryResult{
+      .type = GetPrimitiveType(),
+      .vertex_buffer = vertex_buffer,
+      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   entity.GetTransform(),
+      .prevent_overdraw = false,
+  };
+}
+
+GeometryResult VerticesGeometry::Upload(const ContentContext& renderer,
+                                        const Entity& entity,
+                                        const RenderPass& pass,
+                                        const TessellationCache::Key& key,
+                                        const void* vertex_data,
+                                        size_t vertex_size) const {
   auto index_count = indices_.size();
   auto vertex_count = vertices_.size();
+  const uint16_t* indices = index_count > 0 ? indices_.data() : nullptr;
 
-  size_t total_vtx_bytes = vertex_count * sizeof(float) * 2;
+  if (auto cached = renderer.GetTessellationCache()->Store(
+          key, vertex_data, vertex_size, vertex_count, indices, index_count);
+      cached.has_value()) {
+    return MakeResult(cached.value(), entity, pass);
+  }
+
+  size_t total_vtx_bytes = vertex_count * vertex_size;
   size_t total_idx_bytes = index_count * sizeof(uint16_t);
 
   DeviceBufferDescriptor buffer_desc;
@@ -125,35 +186,39 @@ GeometryResult VerticesGeometry::GetPositionBuffer(
   auto buffer =
       renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
 
-  if (!buffer->CopyHostBuffer(
-          reinterpret_cast<const uint8_t*>(vertices_.data()),
-          Range{0, total_vtx_bytes}, 0)) {
+  if (!buffer->CopyHostBuffer(reinterpret_cast<const uint8_t*>(vertex_data),
+                              Range{0, total_vtx_bytes}, 0)) {
     return {};
   }
   if (index_count > 0 &&
-      !buffer->CopyHostBuffer(
-          reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(indices_.data())),
-          Range{0, total_idx_bytes}, total_vtx_bytes)) {
+      !buffer->CopyHostBuffer(reinterpret_cast<const uint8_t*>(indices),
+                              Range{0, total_idx_bytes}, total_vtx_bytes)) {
     return {};
   }
 
-  return GeometryResult{
-      .type = GetPrimitiveType(),
-      .vertex_buffer =
-          {
-              .vertex_buffer = {.buffer = buffer,
-                                .range = Range{0, total_vtx_bytes}},
-              .index_buffer = {.buffer = buffer,
-                               .range =
-                                   Range{total_vtx_bytes, total_idx_bytes}},
-              .vertex_count = index_count > 0 ? index_count : vertex_count,
-              .index_type =
-                  index_count > 0 ? IndexType::k16bit : IndexType::kNone,
-          },
-      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
-                   entity.GetTransform(),
-      .prevent_overdraw = false,
-  };
+  return MakeResult(
+      VertexBuffer{
+          .vertex_buffer = {.buffer = buffer,
+                            .range = Range{0, total_vtx_bytes}},
+          .index_buffer = {.buffer = buffer,
+                           .range = Range{total_vtx_bytes, total_idx_bytes}},
+          .vertex_count = index_count > 0 ? index_count : vertex_count,
+          .index_type = index_count > 0 ? IndexType::k16bit : IndexType::kNone,
+      },
+      entity, pass);
+}
+
+GeometryResult VerticesGeometry::GetPositionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  auto key = TessellationCache::MakeKey(
+      TessellationCache::Key::Kind::kVertexPositions, content_hash_, content_);
+  if (auto cached = renderer.GetTessellationCache()->Get(key);
+      cached.has_value()) {
+    return MakeResult(cached.value(), entity, pass);
+  }
+  return Upload(renderer, entity, pass, key, vertices_.data(), sizeof(Point));
 }
 
 GeometryResult VerticesGeometry::GetPositionColorBuffer(
@@ -162,9 +227,14 @@ GeometryResult VerticesGeometry::GetPositionColorBuffer(
     RenderPass& pass) {
   using VS = GeometryColorPipeline::VertexShader;
 
-  auto index_count = indices_.size();
-  auto vertex_count = vertices_.size();
+  auto key = TessellationCache::MakeKey(
+      TessellationCache::Key::Kind::kVertexColors, content_hash_, content_);
+  if (auto cached = renderer.GetTessellationCache()->Get(key);
+      cached.has_value()) {
+    return MakeResult(cached.value(), entity, pass);
+  }
 
+  auto vertex_count = vertices_.size();
   std::vector<VS::PerVertexData> vertex_data(vertex_count);
   {
     for (auto i = 0u; i < vertex_count; i++) {
@@ -175,44 +245,8 @@ GeometryResult VerticesGeometry::GetPositionColorBuffer(
     }
   }
 
-  size_t total_vtx_bytes = vertex_data.size() * sizeof(VS::PerVertexData);
-  size_t total_idx_bytes = index_count * sizeof(uint16_t);
-
-  DeviceBufferDescriptor buffer_desc;
-  buffer_desc.size = total_vtx_bytes + total_idx_bytes;
-  buffer_desc.storage_mode = StorageMode::kHostVisible;
-
-  auto buffer =
-      renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
-
-  if (!buffer->CopyHostBuffer(reinterpret_cast<uint8_t*>(vertex_data.data()),
-                              Range{0, total_vtx_bytes}, 0)) {
-    return {};
-  }
-  if (index_count > 0 &&
-      !buffer->CopyHostBuffer(
-          reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(indices_.data())),
-          Range{0, total_idx_bytes}, total_vtx_bytes)) {
-    return {};
-  }
-
-  return GeometryResult{
-      .type = GetPrimitiveType(),
-      .vertex_buffer =
-          {
-              .vertex_buffer = {.buffer = buffer,
-                                .range = Range{0, total_vtx_bytes}},
-              .index_buffer = {.buffer = buffer,
-                               .range =
-                                   Range{total_vtx_bytes, total_idx_bytes}},
-              .vertex_count = index_count > 0 ? index_count : vertex_count,
-              .index_type =
-                  index_count > 0 ? IndexType::k16bit : IndexType::kNone,
-          },
-      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
-                   entity.GetTransform(),
-      .prevent_overdraw = false,
-  };
+  return Upload(renderer, entity, pass, key, vertex_data.data(),
+                sizeof(VS::PerVertexData));
 }
 
 GeometryResult VerticesGeometry::GetPositionUVBuffer(
@@ -223,18 +257,34 @@ GeometryResult VerticesGeometry::GetPositionUVBuffer(
     RenderPass& pass) const {
   using VS = TexturePipeline::VertexShader;
 
-  auto index_count = indices_.size();
-  auto vertex_count = vertices_.size();
   auto uv_transform =
       texture_coverage.GetNormalizingTransform() * effect_transform;
-  auto has_texture_coordinates = HasTextureCoordinates();
+  // The texture coordinates are baked into the vertices, so the key also
+  // holds the transform applied to them.
+  auto content = std::make_shared<std::vector<uint8_t>>(*content_);
+  const auto* transform = reinterpret_cast<const uint8_t*>(&uv_transform);
+  content->insert(content->end(), transform, transform + sizeof(Matrix));
+  auto transform_hash = std::hash<std::string_view>{}(std::string_view(
+      reinterpret_cast<const char*>(&uv_transform), sizeof(Matrix)));
+  auto key = TessellationCache::MakeKey(
+      TessellationCache::Key::Kind::kVertexTextureCoordinates,
+      fml::HashCombine(content_hash_, transform_hash), std::move(content));
+  if (auto cached = renderer.GetTessellationCache()->Get(key);
+      cached.has_value()) {
+    return MakeResult(cached.value(), entity, pass);
+  }
+
+  auto vertex_count = vertices_.size();
+  const auto& texture_coords =
+      HasTextureCoordinates() ? texture_coordinates_ : vertices_;
+  std::vector<Point> uvs(vertex_count);
+  TransformPoints(uv_transform, texture_coords.data(), uvs.data(),
+                  vertex_count);
   std::vector<VS::PerVertexData> vertex_data(vertex_count);
   {
     for (auto i = 0u; i < vertex_count; i++) {
       auto vertex = vertices_[i];
-      auto texture_coord =
-          has_texture_coordinates ? texture_coordinates_[i] : vertices_[i];
-      auto uv = uv_transform * texture_coord;
+      auto uv = uvs[i];
       // From experimentation we need to clamp these values to < 1.0 or else
       // there can be flickering.
       vertex_data[i] = {
@@ -246,44 +296,8 @@ GeometryResult VerticesGeometry::GetPositionUVBuffer(
     }
   }
 
-  size_t total_vtx_bytes = vertex_data.size() * sizeof(VS::PerVertexData);
-  size_t total_idx_bytes = index_count * sizeof(uint16_t);
-
-  DeviceBufferDescriptor buffer_desc;
-  buffer_desc.size = total_vtx_bytes + total_idx_bytes;
-  buffer_desc.storage_mode = StorageMode::kHostVisible;
-
-  auto buffer =
-      renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
-
-  if (!buffer->CopyHostBuffer(reinterpret_cast<uint8_t*>(vertex_data.data()),
-                              Range{0, total_vtx_bytes}, 0)) {
-    return {};
-  }
-  if (index_count > 0u &&
-      !buffer->CopyHostBuffer(
-          reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(indices_.data())),
-          Range{0, total_idx_bytes}, total_vtx_bytes)) {
-    return {};
-  }
-
-  return GeometryResult{
-      .type = GetPrimitiveType(),
-      .vertex_buffer =
-          {
-              .vertex_buffer = {.buffer = buffer,
-                                .range = Range{0, total_vtx_bytes}},
-              .index_buffer = {.buffer = buffer,
-                               .range =
-                                   Range{total_vtx_bytes, total_idx_bytes}},
-              .vertex_count = index_count > 0 ? index_count : vertex_count,
-              .index_type =
-                  index_count > 0 ? IndexType::k16bit : IndexType::kNone,
-          },
-      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
-                   entity.GetTransform(),
-      .prevent_overdraw = false,
-  };
+  return Upload(renderer, entity, pass, key, vertex_data.data(),
+                sizeof(VS::PerVertexData));
 }
 
 GeometryVertexType VerticesGeometry::GetVertexType() const {
@@ -5,11 +5,20 @@
 #ifndef FLUTTER_IMPELLER_ENTITY_GEOMETRY_VERTICES_GEOMETRY_H_
 #define FLUTTER_IMPELLER_ENTITY_GEOMETRY_VERTICES_GEOMETRY_H_
 
+#include <memory>
+#include <vector>
+
 #include "impeller/entity/geometry/geometry.h"
+#include "impeller/entity/tessellation_cache.h"
 
 namespace impeller {
 
 /// @brief A geometry that is created from a vertices object.
+///
+///        The interleaved vertex data is uploaded into device buffers that
+///        are kept in the tessellation cache, keyed by the content of the
+///        vertices. Vertices that are drawn again in later frames, such as
+///        those of a retained display list, are not uploaded again.
 class VerticesGeometry final : public Geometry {
  public:
   enum class VertexMode {
@@ -60,6 +69,19 @@ class VerticesGeometry final : public Geometry {
 
   PrimitiveType GetPrimitiveType() const;
 
+  std::vector<uint8_t> SerializeContent() const;
+
+  GeometryResult MakeResult(const VertexBuffer& vertex_buffer,
+                            const Entity& entity,
+                            const RenderPass& pass) const;
+
+  GeometryResult Upload(const ContentContext& renderer,
+                        const Entity& entity,
+                        const RenderPass& pass,
+                        const TessellationCache::Key& key,
+                        const void* vertex_data,
+                        size_t vertex_size) const;
+
   std::vector<Point> vertices_;
   std::vector<Color> colors_;
   std::vector<Point> texture_coordinates_;
@@ -67,6 +89,10 @@ class VerticesGeometry final : public Geometry {
   Rect bounds_;
   VerticesGeometry::VertexMode vertex_mode_ =
       VerticesGeometry::VertexMode::kTriangles;
+  // The bytes of the vertices, which the tessellation cache compares them
+  // by, and their hash.
+  std::shared_ptr<const std::vector<uint8_t>> content_;
+  size_t content_hash_ = 0u;
 };
 
 }  // namespace impeller
@@ -0,0 +1,71 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/gradient_cache.h"
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/entity/contents/gradient_generator.h"
+#include "impeller/geometry/gradient.h"
+
+namespace impeller {
+
+size_t GradientCache::Key::Hash::operator()(const Key& key) const {
+  size_t hash = fml::HashCombine(key.colors.size());
+  for (const auto& color : key.colors) {
+    fml::HashCombineSeed(hash, color.red, color.green, color.blue,
+                         color.alpha);
+  }
+  for (auto stop : key.stops) {
+    fml::HashCombineSeed(hash, stop);
+  }
+  return hash;
+}
+
+GradientCache::GradientCache(size_t max_entries) : max_entries_(max_entries) {}
+
+GradientCache::~GradientCache() = default;
+
+std::shared_ptr<Texture> GradientCache::GetTexture(
+    const std::vector<Color>& colors,
+    const std::vector<Scalar>& stops,
+    const std::shared_ptr<Context>& context) {
+  Key key{colors, stops};
+  if (auto found = entries_by_key_.find(key); found != entries_by_key_.end()) {
+    cache_hits_++;
+    entries_.splice(entries_.begin(), entries_, found->second);
+    return found->second->texture;
+  }
+  cache_misses_++;
+
+  auto texture =
+      CreateGradientTexture(CreateGradientBuffer(colors, stops), context);
+  if (!texture || max_entries_ == 0u) {
+    return texture;
+  }
+
+  if (entries_.size() >= max_entries_) {
+    entries_by_key_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+  entries_.push_front({std::move(key), texture});
+  entries_by_key_[entries_.front().key] = entries_.begin();
+  return texture;
+}
+
+void GradientCache::End() {
+  FML_TRACE_COUNTER("impeller", "GradientCache",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "CachedTextures", entries_.size(),  //
+                    "CacheHits", cache_hits_,           //
+                    "CacheMisses", cache_misses_);
+  cache_hits_ = 0u;
+  cache_misses_ = 0u;
+}
+
+size_t GradientCache::CachedTextureCount() const {
+  return entries_.size();
+}
+
+}  // namespace impeller
@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_GRADIENT_CACHE_H_
+#define FLUTTER_IMPELLER_ENTITY_GRADIENT_CACHE_H_
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "impeller/core/texture.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/scalar.h"
+
+namespace impeller {
+
+class Context;
+
+//------------------------------------------------------------------------------
+/// @brief      A least recently used cache of the color ramp textures that
+///             gradients are drawn with on backends without storage buffers.
+///
+///             Ramps are keyed by the colors and stops of the gradient. The
+///             tile mode and geometry of a gradient are applied by its shader,
+///             so gradients that only differ in those share a texture.
+///
+class GradientCache {
+ public:
+  /// The default limit of the number of cached ramps. A ramp is at most
+  /// 1024 texels wide.
+  static constexpr size_t kDefaultMaxEntries = 64u;
+
+  explicit GradientCache(size_t max_entries = kDefaultMaxEntries);
+
+  ~GradientCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the ramp texture of the gradient, creating it if it is
+  ///             not cached yet.
+  ///
+  /// @return     The texture or null if it could not be created.
+  ///
+  std::shared_ptr<Texture> GetTexture(const std::vector<Color>& colors,
+                                      const std::vector<Scalar>& stops,
+                                      const std::shared_ptr<Context>& context);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Marks the end of a frame and reports its cache use.
+  ///
+  void End();
+
+  // visible for testing.
+  size_t CachedTextureCount() const;
+
+ private:
+  struct Key {
+    std::vector<Color> colors;
+    std::vector<Scalar> stops;
+
+    bool operator==(const Key& other) const {
+      return colors == other.colors && stops == other.stops;
+    }
+
+    struct Hash {
+      size_t operator()(const Key& key) const;
+    };
+  };
+
+  struct Entry {
+    Key key;
+    std::shared_ptr<Texture> texture;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  const size_t max_entries_;
+  // Most recently used first.
+  EntryList entries_;
+  std::unordered_map<Key, EntryList::iterator, Key::Hash> entries_by_key_;
+  size_t cache_hits_ = 0u;
+  size_t cache_misses_ = 0u;
+
+  GradientCache(const GradientCache&) = delete;
+
+  GradientCache& operator=(const GradientCache&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_GRADIENT_CACHE_H_
@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "gmock/gmock.h"
+#include "impeller/core/allocator.h"
+#include "impeller/entity/gradient_cache.h"
+#include "impeller/renderer/testing/mocks.h"
+
+namespace impeller {
+namespace testing {
+
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace {
+class TextureAllocator : public Allocator {
+ public:
+  ISize GetMaxTextureSizeSupported() const override {
+    return ISize(1024, 1024);
+  };
+
+  std::shared_ptr<DeviceBuffer> OnCreateBuffer(
+      const DeviceBufferDescriptor& desc) override {
+    return nullptr;
+  };
+
+  std::shared_ptr<Texture> OnCreateTexture(
+      const TextureDescriptor& desc) override {
+    created_texture_count++;
+    auto texture = std::make_shared<NiceMock<MockTexture>>(desc);
+    ON_CALL(*texture, IsValid()).WillByDefault(Return(true));
+    ON_CALL(*texture, OnSetContents(_, _)).WillByDefault(Return(true));
+    return texture;
+  };
+
+  size_t created_texture_count = 0u;
+};
+
+std::shared_ptr<Context> MakeContext(
+    const std::shared_ptr<Allocator>& allocator) {
+  auto context = std::make_shared<NiceMock<MockImpellerContext>>();
+  ON_CALL(*context, GetResourceAllocator()).WillByDefault(Return(allocator));
+  return context;
+}
+}  // namespace
+
+static const std::vector<Color> kColors = {Color::Red(), Color::Blue()};
+static const std::vector<Scalar> kStops = {0.0, 1.0};
+
+TEST(GradientCacheTest, ReusesTexturesOfIdenticalGradients) {
+  auto allocator = std::make_shared<TextureAllocator>();
+  auto context = MakeContext(allocator);
+  GradientCache cache;
+
+  auto texture = cache.GetTexture(kColors, kStops, context);
+  ASSERT_NE(texture, nullptr);
+  cache.End();
+  EXPECT_EQ(cache.GetTexture(kColors, kStops, context), texture);
+  EXPECT_EQ(allocator->created_texture_count, 1u);
+
+  EXPECT_NE(cache.GetTexture(kColors, {0.0, 0.5}, context), texture);
+  EXPECT_NE(cache.GetTexture({Color::Red(), Color::Green()}, kStops, context),
+            texture);
+  EXPECT_EQ(allocator->created_texture_count, 3u);
+  EXPECT_EQ(cache.CachedTextureCount(), 3u);
+}
+
+TEST(GradientCacheTest, EvictsLeastRecentlyUsedTextures) {
+  auto allocator = std::make_shared<TextureAllocator>();
+  auto context = MakeContext(allocator);
+  GradientCache cache(/*max_entries=*/2u);
+
+  auto red_blue = cache.GetTexture(kColors, kStops, context);
+  cache.GetTexture({Color::Red(), Color::Green()}, kStops, context);
+  // Makes the red to green gradient the least recently used one.
+  EXPECT_EQ(cache.GetTexture(kColors, kStops, context), red_blue);
+  cache.GetTexture({Color::Green(), Color::Blue()}, kStops, context);
+  EXPECT_EQ(cache.CachedTextureCount(), 2u);
+  EXPECT_EQ(allocator->created_texture_count, 3u);
+
+  EXPECT_EQ(cache.GetTexture(kColors, kStops, context), red_blue);
+  cache.GetTexture({Color::Red(), Color::Green()}, kStops, context);
+  EXPECT_EQ(allocator->created_texture_count, 4u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -9,18 +9,20 @@
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/texture_descriptor.h"
+#include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/entity_pass_target.h"
 #include "impeller/renderer/command_buffer.h"
 
 namespace impeller {
 
 InlinePassContext::InlinePassContext(
-    std::shared_ptr<Context> context,
+    const ContentContext& renderer,
     EntityPassTarget& pass_target,
     uint32_t pass_texture_reads,
     uint32_t entity_count,
     std::optional<RenderPassResult> collapsed_parent_pass)
-    : context_(std::move(context)),
+    : renderer_(renderer),
+      context_(renderer.GetContext()),
       pass_target_(pass_target),
       entity_count_(entity_count),
       is_collapsed_(collapsed_parent_pass.has_value()) {
@@ -151,6 +153,10 @@ InlinePassContext::RenderPassResult InlinePassContext::GetRenderPass(
     VALIDATION_LOG << "Could not create render pass.";
     return {};
   }
+  pass_->SetTransientsBuffer(renderer_.GetTransientsBuffer());
+#ifdef IMPELLER_ENABLE_SAMPLING_CAPTURE
+  renderer_.GetContext()->GetSamplingCapture()->BeginPass(pass_.get());
+#endif
   // Commands are fairly large (500B) objects, so re-allocation of the command
   // buffer while encoding can add a surprising amount of overhead. We make a
   // conservative npot estimate to avoid this case.
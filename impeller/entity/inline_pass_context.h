@@ -14,6 +14,8 @@
 
 namespace impeller {
 
+class ContentContext;
+
 class InlinePassContext {
  public:
   struct RenderPassResult {
@@ -22,7 +24,7 @@ class InlinePassContext {
   };
 
   InlinePassContext(
-      std::shared_ptr<Context> context,
+      const ContentContext& renderer,
       EntityPassTarget& pass_target,
       uint32_t pass_texture_reads,
       uint32_t entity_count,
@@ -45,6 +47,7 @@ class InlinePassContext {
   RenderPassResult GetRenderPass(uint32_t pass_depth);
 
  private:
+  const ContentContext& renderer_;
   std::shared_ptr<Context> context_;
   EntityPassTarget& pass_target_;
   std::shared_ptr<CommandBuffer> command_buffer_;
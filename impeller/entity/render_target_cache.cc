@@ -3,28 +3,68 @@
 // found in the LICENSE file.
 
 #include "impeller/entity/render_target_cache.h"
+
+#include "flutter/fml/trace_event.h"
 #include "impeller/renderer/render_target.h"
 
 namespace impeller {
 
-RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator)
-    : RenderTargetAllocator(std::move(allocator)) {}
+RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator,
+                                     uint32_t keep_alive_frame_count)
+    : RenderTargetAllocator(std::move(allocator)),
+      keep_alive_frame_count_(keep_alive_frame_count) {}
 
 void RenderTargetCache::Start() {
   for (auto& td : texture_data_) {
     td.used_this_frame = false;
   }
+  frame_stats_ = {};
 }
 
 void RenderTargetCache::End() {
   std::vector<TextureData> retain;
 
-  for (const auto& td : texture_data_) {
+  for (auto& td : texture_data_) {
     if (td.used_this_frame) {
+      td.unused_frame_count = 0;
+      retain.push_back(td);
+
+      const TextureDescriptor& desc = td.texture->GetTextureDescriptor();
+      size_t bytes = desc.GetByteSizeOfBaseMipLevel() *
+                     static_cast<size_t>(desc.sample_count);
+      if (desc.storage_mode == StorageMode::kDeviceTransient) {
+        frame_stats_.device_transient_bytes += bytes;
+      } else {
+        frame_stats_.device_private_bytes += bytes;
+      }
+    } else if (++td.unused_frame_count <= keep_alive_frame_count_) {
       retain.push_back(td);
     }
   }
   texture_data_.swap(retain);
+
+  last_frame_stats_ = frame_stats_;
+  FML_TRACE_COUNTER("impeller", "RenderTargetCache",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "DevicePrivateBytes", frame_stats_.device_private_bytes,
+                    "DeviceTransientBytes", frame_stats_.device_transient_bytes,
+                    "CacheHits", frame_stats_.cache_hits,  //
+                    "CacheMisses", frame_stats_.cache_misses);
+}
+
+void RenderTargetCache::DisposeUnused() {
+  std::vector<TextureData> retain;
+  for (auto& td : texture_data_) {
+    if (td.used_this_frame || td.unused_frame_count == 0) {
+      retain.push_back(td);
+    }
+  }
+  texture_data_.swap(retain);
+}
+
+const RenderTargetCache::FrameStats&
+RenderTargetCache::GetLastFrameStats() const {
+  return last_frame_stats_;
 }
 
 size_t RenderTargetCache::CachedTextureCount() const {
@@ -42,15 +82,17 @@ std::shared_ptr<Texture> RenderTargetCache::CreateTexture(
     FML_DCHECK(td.texture != nullptr);
     if (!td.used_this_frame && desc == other_desc) {
       td.used_this_frame = true;
+      frame_stats_.cache_hits++;
       return td.texture;
     }
   }
+  frame_stats_.cache_misses++;
   auto result = RenderTargetAllocator::CreateTexture(desc);
   if (result == nullptr) {
     return result;
   }
-  texture_data_.push_back(
-      TextureData{.used_this_frame = true, .texture = result});
+  texture_data_.push_back(TextureData{
+      .used_this_frame = true, .unused_frame_count = 0, .texture = result});
   return result;
 }
 
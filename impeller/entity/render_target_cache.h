@@ -10,12 +10,25 @@
 namespace impeller {
 
 /// @brief An implementation of the [RenderTargetAllocator] that caches all
-///        allocated texture data for one frame.
+///        allocated texture data across frames.
 ///
-///        Any textures unused after a frame are immediately discarded.
+///        Textures are discarded once they go unused for more than
+///        `keep_alive_frame_count` frames.
 class RenderTargetCache : public RenderTargetAllocator {
  public:
-  explicit RenderTargetCache(std::shared_ptr<Allocator> allocator);
+  /// @brief How a frame used the cache. The byte counts are the memory held
+  ///        by the render target textures that were used in the frame, split
+  ///        by storage mode. Transient textures only take up memory on backends
+  ///        that do not support memoryless attachments.
+  struct FrameStats {
+    size_t device_private_bytes = 0u;
+    size_t device_transient_bytes = 0u;
+    size_t cache_hits = 0u;
+    size_t cache_misses = 0u;
+  };
+
+  explicit RenderTargetCache(std::shared_ptr<Allocator> allocator,
+                             uint32_t keep_alive_frame_count = 0u);
 
   ~RenderTargetCache() = default;
 
@@ -25,6 +38,9 @@ class RenderTargetCache : public RenderTargetAllocator {
   // |RenderTargetAllocator|
   void End() override;
 
+  // |RenderTargetAllocator|
+  void DisposeUnused() override;
+
   // |RenderTargetAllocator|
   std::shared_ptr<Texture> CreateTexture(
       const TextureDescriptor& desc) override;
@@ -32,13 +48,20 @@ class RenderTargetCache : public RenderTargetAllocator {
   // visible for testing.
   size_t CachedTextureCount() const;
 
+  /// @brief The cache use of the last completed frame.
+  const FrameStats& GetLastFrameStats() const;
+
  private:
   struct TextureData {
     bool used_this_frame;
+    uint32_t unused_frame_count;
     std::shared_ptr<Texture> texture;
   };
 
+  const uint32_t keep_alive_frame_count_;
   std::vector<TextureData> texture_data_;
+  FrameStats frame_stats_;
+  FrameStats last_frame_stats_;
 
   RenderTargetCache(const RenderTargetCache&) = delete;
 
@@ -70,6 +70,65 @@ TEST(RenderTargetCacheTest, CachesUsedTexturesAcrossFrames) {
   ASSERT_EQ(render_target_cache.CachedTextureCount(), 1u);
 }
 
+TEST(RenderTargetCacheTest, KeepsUnusedTexturesAlive) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache =
+      RenderTargetCache(allocator, /*keep_alive_frame_count=*/2);
+  auto desc = TextureDescriptor{
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .size = ISize(100, 100),
+      .usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)};
+
+  render_target_cache.Start();
+  auto texture = render_target_cache.CreateTexture(desc);
+  render_target_cache.End();
+  EXPECT_EQ(render_target_cache.GetLastFrameStats().cache_misses, 1u);
+
+  // Two frames without the texture keep it in the cache.
+  for (int i = 0; i < 2; i++) {
+    render_target_cache.Start();
+    render_target_cache.End();
+    ASSERT_EQ(render_target_cache.CachedTextureCount(), 1u);
+  }
+
+  // So it is reused on the next frame that asks for it.
+  render_target_cache.Start();
+  EXPECT_EQ(render_target_cache.CreateTexture(desc), texture);
+  render_target_cache.End();
+  EXPECT_EQ(render_target_cache.GetLastFrameStats().cache_hits, 1u);
+  EXPECT_EQ(render_target_cache.GetLastFrameStats().cache_misses, 0u);
+
+  // Three unused frames evict it.
+  for (int i = 0; i < 3; i++) {
+    render_target_cache.Start();
+    render_target_cache.End();
+  }
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 0u);
+}
+
+TEST(RenderTargetCacheTest, DisposeUnusedReleasesKeptAliveTextures) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache =
+      RenderTargetCache(allocator, /*keep_alive_frame_count=*/2);
+  auto desc = TextureDescriptor{
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .size = ISize(100, 100),
+      .usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)};
+
+  render_target_cache.Start();
+  render_target_cache.CreateTexture(desc);
+  render_target_cache.CreateTexture(desc);
+  render_target_cache.End();
+  render_target_cache.Start();
+  render_target_cache.CreateTexture(desc);
+  render_target_cache.End();
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 2u);
+
+  // Only the texture used by the last frame is kept.
+  render_target_cache.DisposeUnused();
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 1u);
+}
+
 TEST(RenderTargetCacheTest, DoesNotPersistFailedAllocations) {
   auto allocator = std::make_shared<TestAllocator>();
   auto render_target_cache = RenderTargetCache(allocator);
@@ -85,5 +144,41 @@ TEST(RenderTargetCacheTest, DoesNotPersistFailedAllocations) {
   ASSERT_EQ(render_target_cache.CachedTextureCount(), 0u);
 }
 
+TEST(RenderTargetCacheTest, ReportsFrameStatsByStorageMode) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache = RenderTargetCache(allocator);
+  auto resolve_desc = TextureDescriptor{
+      .storage_mode = StorageMode::kDevicePrivate,
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .size = ISize(100, 100),
+      .usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)};
+  auto msaa_desc = resolve_desc;
+  msaa_desc.storage_mode = StorageMode::kDeviceTransient;
+  msaa_desc.type = TextureType::kTexture2DMultisample;
+  msaa_desc.sample_count = SampleCount::kCount4;
+
+  render_target_cache.Start();
+  render_target_cache.CreateTexture(resolve_desc);
+  render_target_cache.CreateTexture(msaa_desc);
+  render_target_cache.End();
+
+  EXPECT_EQ(render_target_cache.GetLastFrameStats().device_private_bytes,
+            100u * 100u * 4u);
+  EXPECT_EQ(
+      render_target_cache.GetLastFrameStats().device_transient_bytes,
+      100u * 100u * 4u * 4u);
+
+  // Textures that go unused in a frame are not counted.
+  render_target_cache.Start();
+  render_target_cache.CreateTexture(resolve_desc);
+  render_target_cache.End();
+
+  EXPECT_EQ(render_target_cache.GetLastFrameStats().device_private_bytes,
+            100u * 100u * 4u);
+  EXPECT_EQ(
+      render_target_cache.GetLastFrameStats().device_transient_bytes,
+      0u);
+}
+
 }  // namespace testing
 }  // namespace impeller
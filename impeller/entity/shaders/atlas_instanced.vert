@@ -0,0 +1,44 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <impeller/conversions.glsl>
+#include <impeller/types.glsl>
+
+uniform FrameInfo {
+  mat4 mvp;
+  float texture_sampler_y_coord_scale;
+}
+frame_info;
+
+// Four vectors per sprite:
+//   0: The x and y basis vectors of its transform.
+//   1: The translation of its transform and the size of its sample rect.
+//   2: The top left and bottom right texture coordinates of its sample rect.
+//   3: Its premultiplied color.
+readonly buffer SpriteInfo {
+  vec4 sprites[];
+}
+sprite_info;
+
+// A corner of the unit square.
+in vec2 corner;
+
+out vec2 v_texture_coords;
+out f16vec4 v_color;
+
+void main() {
+  int sprite = gl_InstanceIndex * 4;
+  vec4 basis = sprite_info.sprites[sprite];
+  vec4 translation_and_size = sprite_info.sprites[sprite + 1];
+  vec4 texture_rect = sprite_info.sprites[sprite + 2];
+
+  vec2 local = corner * translation_and_size.zw;
+  vec2 position =
+      basis.xy * local.x + basis.zw * local.y + translation_and_size.xy;
+  gl_Position = frame_info.mvp * vec4(position, 0.0, 1.0);
+  v_color = f16vec4(sprite_info.sprites[sprite + 3]);
+  v_texture_coords =
+      IPRemapCoords(mix(texture_rect.xy, texture_rect.zw, corner),
+                    frame_info.texture_sampler_y_coord_scale);
+}
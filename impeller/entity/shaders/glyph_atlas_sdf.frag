@@ -0,0 +1,25 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+precision mediump float;
+
+#include <impeller/types.glsl>
+
+uniform f16sampler2D glyph_atlas_sampler;
+
+in highp vec2 v_uv;
+
+IMPELLER_MAYBE_FLAT in f16vec4 v_text_color;
+
+out f16vec4 frag_color;
+
+void main() {
+  // The atlas stores signed distances to the glyph outline with the outline
+  // at one half. Thresholding over the change of the distance across one
+  // pixel anti-aliases the edge at any scale.
+  float distance = texture(glyph_atlas_sampler, v_uv).a;
+  float width = max(fwidth(distance), 1.0 / 255.0);
+  float coverage = clamp((distance - 0.5) / width + 0.5, 0.0, 1.0);
+  frag_color = f16vec4(coverage) * v_text_color;
+}
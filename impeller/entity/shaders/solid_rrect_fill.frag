@@ -0,0 +1,50 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+precision highp float;
+
+#include <impeller/types.glsl>
+
+uniform FragInfo {
+  f16vec4 color;
+  vec2 rect_size;
+  vec2 corner_radii;
+}
+frag_info;
+
+in vec2 v_position;
+
+out f16vec4 frag_color;
+
+/// The signed distance to the edge of the rounded rect, with elliptical
+/// corners approximated by their first order distance.
+float RRectDistance(vec2 sample_position, vec2 half_size) {
+  vec2 position = abs(sample_position);
+  float rect_distance =
+      max(position.x - half_size.x, position.y - half_size.y);
+
+  vec2 radii = max(frag_info.corner_radii, vec2(0.001));
+  vec2 corner_position = position - (half_size - radii);
+  float k0 = length(corner_position / radii);
+  float k1 = length(corner_position / (radii * radii));
+  float corner_distance = k0 * (k0 - 1.0) / max(k1, 0.001);
+
+  // Both distances are computed everywhere so that their derivatives are
+  // defined in every fragment of the quad.
+  bool in_corner = corner_position.x > 0.0 && corner_position.y > 0.0 &&
+                   frag_info.corner_radii.x > 0.0 &&
+                   frag_info.corner_radii.y > 0.0;
+  return in_corner ? corner_distance : rect_distance;
+}
+
+void main() {
+  vec2 half_size = frag_info.rect_size * 0.5;
+  float distance = RRectDistance(v_position - half_size, half_size);
+
+  // Fade the edge out over one pixel, centered on the edge, whatever the
+  // scale of the transform is.
+  float width = max(fwidth(distance), 0.0001);
+  float coverage = clamp(0.5 - distance / width, 0.0, 1.0);
+  frag_color = frag_info.color * float16_t(coverage);
+}
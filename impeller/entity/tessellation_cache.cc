@@ -0,0 +1,202 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/tessellation_cache.h"
+
+#include <cmath>
+#include <limits>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+// Tessellations that would take up more than this fraction of the cache are
+// not worth evicting everything else for.
+static constexpr size_t kMaxEntryFraction = 4u;
+
+// The number of scale buckets per power of two.
+static constexpr Scalar kScaleBucketsPerOctave = 4.0f;
+
+static constexpr int32_t kZeroScaleBucket =
+    std::numeric_limits<int32_t>::min();
+
+// Not reachable by any scale.
+static constexpr int32_t kUnscaledBucket = std::numeric_limits<int32_t>::max();
+
+bool TessellationCache::Key::operator==(const Key& other) const {
+  if (kind != other.kind || content_hash != other.content_hash ||
+      scale_bucket != other.scale_bucket) {
+    return false;
+  }
+  if (content == other.content) {
+    return true;
+  }
+  return content && other.content && *content == *other.content;
+}
+
+size_t TessellationCache::Key::Hash::operator()(const Key& key) const {
+  return fml::HashCombine(key.kind, key.content_hash, key.scale_bucket);
+}
+
+TessellationCache::TessellationCache(std::shared_ptr<Allocator> allocator,
+                                     size_t max_bytes)
+    : allocator_(std::move(allocator)), max_bytes_(max_bytes) {}
+
+TessellationCache::~TessellationCache() = default;
+
+TessellationCache::Key TessellationCache::MakeKey(const Path& path,
+                                                  Scalar scale) {
+  Key key;
+  key.kind = Key::Kind::kPath;
+  key.content_hash = path.ComputeHash();
+  auto content = std::make_shared<std::vector<uint8_t>>();
+  path.AppendContent(*content);
+  key.content = std::move(content);
+  // A scale of zero turns curves into straight lines and gets a bucket of its
+  // own.
+  key.scale_bucket =
+      scale > 0.0f ? static_cast<int32_t>(
+                         std::ceil(std::log2(scale) * kScaleBucketsPerOctave))
+                   : kZeroScaleBucket;
+  return key;
+}
+
+TessellationCache::Key TessellationCache::MakeKey(
+    Key::Kind kind,
+    size_t content_hash,
+    std::shared_ptr<const std::vector<uint8_t>> content) {
+  FML_DCHECK(kind != Key::Kind::kPath);
+  Key key;
+  key.kind = kind;
+  key.content_hash = content_hash;
+  key.scale_bucket = kUnscaledBucket;
+  key.content = std::move(content);
+  return key;
+}
+
+Scalar TessellationCache::GetTessellationScale(const Key& key) {
+  if (key.scale_bucket == kZeroScaleBucket) {
+    return 0.0f;
+  }
+  return std::exp2(key.scale_bucket / kScaleBucketsPerOctave);
+}
+
+std::optional<VertexBuffer> TessellationCache::Get(const Key& key) {
+  auto found = entries_by_key_.find(key);
+  if (found == entries_by_key_.end()) {
+    frame_stats_.cache_misses++;
+    return std::nullopt;
+  }
+  frame_stats_.cache_hits++;
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return found->second->vertex_buffer;
+}
+
+std::optional<VertexBuffer> TessellationCache::Store(
+    const Key& key,
+    const float* vertices,
+    size_t vertices_count,
+    const uint16_t* indices,
+    size_t indices_count) {
+  return Store(key, vertices, sizeof(float) * 2, vertices_count, indices,
+               indices_count);
+}
+
+std::optional<VertexBuffer> TessellationCache::Store(
+    const Key& key,
+    const void* vertices,
+    size_t vertex_size,
+    size_t vertices_count,
+    const uint16_t* indices,
+    size_t indices_count) {
+  if (!allocator_ || entries_by_key_.find(key) != entries_by_key_.end()) {
+    return std::nullopt;
+  }
+
+  // Only keep tessellations that were needed before, within this or the
+  // previous frame.
+  if (misses_last_frame_.find(key) == misses_last_frame_.end() &&
+      misses_this_frame_.insert(key).second) {
+    return std::nullopt;
+  }
+
+  // The indices follow the vertices, whose size is always a multiple of the
+  // index alignment.
+  const size_t vertex_bytes = vertices_count * vertex_size;
+  const size_t index_offset = vertex_bytes;
+  const size_t index_bytes =
+      indices != nullptr ? indices_count * sizeof(uint16_t) : 0u;
+  const size_t bytes = vertex_bytes + index_bytes;
+  if (bytes == 0u || bytes > max_bytes_ / kMaxEntryFraction) {
+    return std::nullopt;
+  }
+
+  DeviceBufferDescriptor desc;
+  desc.storage_mode = StorageMode::kHostVisible;
+  desc.size = bytes;
+  auto buffer = allocator_->CreateBuffer(desc);
+  if (!buffer ||
+      !buffer->CopyHostBuffer(reinterpret_cast<const uint8_t*>(vertices),
+                              Range{0u, vertex_bytes}) ||
+      !buffer->CopyHostBuffer(reinterpret_cast<const uint8_t*>(indices),
+                              Range{0u, index_bytes}, index_offset)) {
+    return std::nullopt;
+  }
+  buffer->SetLabel("TessellationCache");
+
+  while (!entries_.empty() && cached_bytes_ + bytes > max_bytes_) {
+    cached_bytes_ -= entries_.back().bytes;
+    entries_by_key_.erase(entries_.back().key);
+    entries_.pop_back();
+    frame_stats_.evictions++;
+  }
+
+  Entry entry;
+  entry.key = key;
+  entry.bytes = bytes;
+  entry.vertex_buffer.vertex_buffer = buffer->AsBufferView();
+  entry.vertex_buffer.vertex_buffer.range = Range{0u, vertex_bytes};
+  if (index_bytes > 0u) {
+    entry.vertex_buffer.index_buffer = buffer->AsBufferView();
+    entry.vertex_buffer.index_buffer.range = Range{index_offset, index_bytes};
+    entry.vertex_buffer.vertex_count = indices_count;
+    entry.vertex_buffer.index_type = IndexType::k16bit;
+  } else {
+    entry.vertex_buffer.vertex_count = vertices_count;
+    entry.vertex_buffer.index_type = IndexType::kNone;
+  }
+
+  entries_.push_front(std::move(entry));
+  entries_by_key_[key] = entries_.begin();
+  cached_bytes_ += bytes;
+  return entries_.front().vertex_buffer;
+}
+
+void TessellationCache::End() {
+  misses_last_frame_.swap(misses_this_frame_);
+  misses_this_frame_.clear();
+
+  frame_stats_.cached_bytes = cached_bytes_;
+  last_frame_stats_ = frame_stats_;
+  frame_stats_ = {};
+  FML_TRACE_COUNTER("impeller", "TessellationCache",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "CachedBytes", last_frame_stats_.cached_bytes,  //
+                    "CacheHits", last_frame_stats_.cache_hits,      //
+                    "CacheMisses", last_frame_stats_.cache_misses,  //
+                    "Evictions", last_frame_stats_.evictions);
+}
+
+const TessellationCache::FrameStats& TessellationCache::GetLastFrameStats()
+    const {
+  return last_frame_stats_;
+}
+
+size_t TessellationCache::CachedTessellationCount() const {
+  return entries_.size();
+}
+
+}  // namespace impeller
@@ -0,0 +1,171 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_TESSELLATION_CACHE_H_
+#define FLUTTER_IMPELLER_ENTITY_TESSELLATION_CACHE_H_
+
+#include <list>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "impeller/core/allocator.h"
+#include "impeller/core/vertex_buffer.h"
+#include "impeller/geometry/path.h"
+#include "impeller/geometry/scalar.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A least recently used cache of path tessellations that lives in
+///             device buffers reused across frames.
+///
+///             Tessellations are keyed by the content of the path and the
+///             scale it is drawn at, rounded up to a quarter of a power of
+///             two. A tessellation is only stored the second time it misses
+///             within two frames, so paths that change every frame do not pay
+///             for a device buffer allocation. Paths marked as volatile are
+///             never offered to the cache.
+///
+///             Geometry that is uploaded as is, such as vertices, is keyed by
+///             its content alone and shares the memory limit.
+///
+///             Keys hold the content they were made from, which lookups
+///             compare, so that content with colliding hashes never shares a
+///             tessellation.
+///
+class TessellationCache {
+ public:
+  /// The default limit of the memory held by cached tessellations.
+  static constexpr size_t kDefaultMaxBytes = 4u * 1024u * 1024u;
+
+  struct Key {
+    /// What the content of a key describes. Keys of different kinds are
+    /// never equal, even if their content is.
+    enum class Kind {
+      kPath,
+      kVertexPositions,
+      kVertexColors,
+      kVertexTextureCoordinates,
+    };
+
+    Kind kind = Kind::kPath;
+    size_t content_hash = 0u;
+    int32_t scale_bucket = 0;
+    /// The bytes |content_hash| was computed from.
+    std::shared_ptr<const std::vector<uint8_t>> content;
+
+    bool operator==(const Key& other) const;
+
+    struct Hash {
+      size_t operator()(const Key& key) const;
+    };
+  };
+
+  /// @brief How a frame used the cache.
+  struct FrameStats {
+    size_t cached_bytes = 0u;
+    size_t cache_hits = 0u;
+    size_t cache_misses = 0u;
+    size_t evictions = 0u;
+  };
+
+  explicit TessellationCache(std::shared_ptr<Allocator> allocator,
+                             size_t max_bytes = kDefaultMaxBytes);
+
+  ~TessellationCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the key of a path drawn at the given scale, such as
+  ///             the max basis length of its transform.
+  ///
+  static Key MakeKey(const Path& path, Scalar scale);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the key of geometry that does not depend on the
+  ///             scale it is drawn at, from its content and a hash of it.
+  ///
+  static Key MakeKey(Key::Kind kind,
+                     size_t content_hash,
+                     std::shared_ptr<const std::vector<uint8_t>> content);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The scale that all paths with the given key must be
+  ///             tessellated at. It is never smaller than the scale the key
+  ///             was made with.
+  ///
+  static Scalar GetTessellationScale(const Key& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the cached tessellation of the key and marks it as
+  ///             the most recently used one.
+  ///
+  std::optional<VertexBuffer> Get(const Key& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Copies a tessellation into a device buffer owned by the
+  ///             cache, evicting the least recently used tessellations to stay
+  ///             within the memory limit.
+  ///
+  /// @return     The cached tessellation or std::nullopt if it was not stored,
+  ///             in which case the caller must upload the data itself.
+  ///
+  std::optional<VertexBuffer> Store(const Key& key,
+                                    const float* vertices,
+                                    size_t vertices_count,
+                                    const uint16_t* indices,
+                                    size_t indices_count);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Same as above, for vertices of |vertex_size| bytes each.
+  ///             The vertex size must be a multiple of the index size.
+  ///
+  std::optional<VertexBuffer> Store(const Key& key,
+                                    const void* vertices,
+                                    size_t vertex_size,
+                                    size_t vertices_count,
+                                    const uint16_t* indices,
+                                    size_t indices_count);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Marks the end of a frame and reports its cache use.
+  ///
+  void End();
+
+  /// @brief The cache use of the last completed frame.
+  const FrameStats& GetLastFrameStats() const;
+
+  // visible for testing.
+  size_t CachedTessellationCount() const;
+
+ private:
+  struct Entry {
+    Key key;
+    VertexBuffer vertex_buffer;
+    size_t bytes = 0u;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  const std::shared_ptr<Allocator> allocator_;
+  const size_t max_bytes_;
+  // Most recently used first.
+  EntryList entries_;
+  std::unordered_map<Key, EntryList::iterator, Key::Hash> entries_by_key_;
+  std::unordered_set<Key, Key::Hash> misses_this_frame_;
+  std::unordered_set<Key, Key::Hash> misses_last_frame_;
+  size_t cached_bytes_ = 0u;
+  FrameStats frame_stats_;
+  FrameStats last_frame_stats_;
+
+  TessellationCache(const TessellationCache&) = delete;
+
+  TessellationCache& operator=(const TessellationCache&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_TESSELLATION_CACHE_H_
@@ -0,0 +1,158 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "gmock/gmock.h"
+#include "impeller/core/allocator.h"
+#include "impeller/entity/tessellation_cache.h"
+#include "impeller/geometry/path_builder.h"
+#include "impeller/renderer/testing/mocks.h"
+
+namespace impeller {
+namespace testing {
+
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace {
+class BufferAllocator : public Allocator {
+ public:
+  ISize GetMaxTextureSizeSupported() const override {
+    return ISize(1024, 1024);
+  };
+
+  std::shared_ptr<DeviceBuffer> OnCreateBuffer(
+      const DeviceBufferDescriptor& desc) override {
+    created_buffer_count++;
+    auto buffer = std::make_shared<NiceMock<MockDeviceBuffer>>(desc);
+    ON_CALL(*buffer, OnCopyHostBuffer(_, _, _)).WillByDefault(Return(true));
+    return buffer;
+  };
+
+  std::shared_ptr<Texture> OnCreateTexture(
+      const TextureDescriptor& desc) override {
+    return nullptr;
+  };
+
+  size_t created_buffer_count = 0u;
+};
+
+Path MakeTrianglePath(Scalar x) {
+  return PathBuilder{}
+      .MoveTo({x, 0})
+      .LineTo({x, 100})
+      .LineTo({100, 0})
+      .TakePath();
+}
+}  // namespace
+
+// Three vertices and three indices.
+static const std::vector<float> kVertices = {0, 0, 0, 100, 100, 0};
+static const std::vector<uint16_t> kIndices = {0, 1, 2};
+
+TEST(TessellationCacheTest, KeysQuantizeScaleUpwards) {
+  auto path = MakeTrianglePath(0);
+
+  auto key = TessellationCache::MakeKey(path, 1.1f);
+  EXPECT_EQ(key, TessellationCache::MakeKey(path, 1.15f));
+  EXPECT_GE(TessellationCache::GetTessellationScale(key), 1.15f);
+  EXPECT_FALSE(key == TessellationCache::MakeKey(path, 2.0f));
+  EXPECT_FALSE(key == TessellationCache::MakeKey(MakeTrianglePath(1), 1.1f));
+  EXPECT_EQ(TessellationCache::GetTessellationScale(
+                TessellationCache::MakeKey(path, 0.0f)),
+            0.0f);
+}
+
+TEST(TessellationCacheTest, CollidingHashesDoNotShareTessellations) {
+  auto allocator = std::make_shared<BufferAllocator>();
+  TessellationCache cache(allocator);
+  auto key = TessellationCache::MakeKey(MakeTrianglePath(0), 1.0f);
+  cache.Store(key, kVertices.data(), 3u, nullptr, 0u);
+  ASSERT_TRUE(cache.Store(key, kVertices.data(), 3u, nullptr, 0u).has_value());
+
+  // Another path whose hash happens to be the same.
+  auto colliding_key = TessellationCache::MakeKey(MakeTrianglePath(1), 1.0f);
+  colliding_key.content_hash = key.content_hash;
+  EXPECT_FALSE(colliding_key == key);
+  EXPECT_FALSE(cache.Get(colliding_key).has_value());
+
+  // Vertices with the same hash and bytes as the path, at the bucket of
+  // unscaled geometry.
+  auto vertices_key = TessellationCache::MakeKey(
+      TessellationCache::Key::Kind::kVertexPositions, key.content_hash,
+      key.content);
+  vertices_key.scale_bucket = key.scale_bucket;
+  EXPECT_FALSE(vertices_key == key);
+  EXPECT_FALSE(cache.Get(vertices_key).has_value());
+
+  // A key made again from the same path finds the tessellation.
+  EXPECT_TRUE(cache.Get(TessellationCache::MakeKey(MakeTrianglePath(0), 1.0f))
+                  .has_value());
+}
+
+TEST(TessellationCacheTest, StoresTessellationsThatMissTwice) {
+  auto allocator = std::make_shared<BufferAllocator>();
+  TessellationCache cache(allocator);
+  auto key = TessellationCache::MakeKey(MakeTrianglePath(0), 1.0f);
+
+  // The first miss is not stored, the second one in the next frame is.
+  EXPECT_FALSE(cache.Get(key).has_value());
+  EXPECT_FALSE(cache.Store(key, kVertices.data(), 3u, kIndices.data(), 3u)
+                   .has_value());
+  cache.End();
+  EXPECT_FALSE(cache.Get(key).has_value());
+  auto stored = cache.Store(key, kVertices.data(), 3u, kIndices.data(), 3u);
+  ASSERT_TRUE(stored.has_value());
+  EXPECT_EQ(stored->vertex_count, 3u);
+  EXPECT_EQ(stored->index_type, IndexType::k16bit);
+  EXPECT_EQ(stored->index_buffer.range.offset, 6 * sizeof(float));
+  cache.End();
+
+  EXPECT_TRUE(cache.Get(key).has_value());
+  cache.End();
+
+  EXPECT_EQ(allocator->created_buffer_count, 1u);
+  EXPECT_EQ(cache.GetLastFrameStats().cache_hits, 1u);
+  EXPECT_EQ(cache.GetLastFrameStats().cache_misses, 0u);
+  EXPECT_EQ(cache.GetLastFrameStats().cached_bytes,
+            6 * sizeof(float) + 3 * sizeof(uint16_t));
+}
+
+TEST(TessellationCacheTest, EvictsLeastRecentlyUsedTessellations) {
+  auto allocator = std::make_shared<BufferAllocator>();
+  // Room for about four tessellations of six floats.
+  TessellationCache cache(allocator, 4 * 6 * sizeof(float) + 1);
+
+  std::vector<TessellationCache::Key> keys;
+  for (auto i = 0; i < 4; i++) {
+    keys.push_back(TessellationCache::MakeKey(MakeTrianglePath(i), 1.0f));
+  }
+  auto store = [&](const TessellationCache::Key& key) {
+    cache.Store(key, kVertices.data(), 3u, nullptr, 0u);
+    return cache.Store(key, kVertices.data(), 3u, nullptr, 0u).has_value();
+  };
+
+  EXPECT_TRUE(store(keys[0]));
+  EXPECT_TRUE(store(keys[1]));
+  EXPECT_TRUE(store(keys[2]));
+  EXPECT_TRUE(store(keys[3]));
+  EXPECT_EQ(cache.CachedTessellationCount(), 4u);
+
+  // Touch the oldest entry so that the second one is evicted instead.
+  EXPECT_TRUE(cache.Get(keys[0]).has_value());
+  EXPECT_TRUE(store(TessellationCache::MakeKey(MakeTrianglePath(4), 1.0f)));
+  cache.End();
+
+  EXPECT_EQ(cache.CachedTessellationCount(), 4u);
+  EXPECT_EQ(cache.GetLastFrameStats().evictions, 1u);
+  EXPECT_TRUE(cache.Get(keys[0]).has_value());
+  EXPECT_FALSE(cache.Get(keys[1]).has_value());
+}
+
+}  // namespace testing
+}  // namespace impeller
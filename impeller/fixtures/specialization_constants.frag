@@ -0,0 +1,17 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+layout(constant_id = 1) const float tile_mode = 0.0;
+layout(constant_id = 0) const float supports_decal = 1.0;
+
+uniform FragInfo {
+  vec4 color;
+}
+frag_info;
+
+out vec4 frag_color;
+
+void main() {
+  frag_color = frag_info.color * supports_decal + vec4(tile_mode);
+}
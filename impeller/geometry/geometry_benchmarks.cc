@@ -4,10 +4,32 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+
 #include "impeller/geometry/path.h"
 #include "impeller/geometry/path_builder.h"
+#include "impeller/geometry/point_batch.h"
 #include "impeller/tessellator/tessellator.h"
 
+// Counts the heap allocations of this benchmark binary so that benchmarks can
+// report how many they make per iteration.
+static std::atomic<size_t> allocation_count = 0u;
+
+void* operator new(size_t size) {
+  allocation_count.fetch_add(1u, std::memory_order_relaxed);
+  void* allocation = std::malloc(size == 0u ? 1u : size);
+  if (allocation == nullptr) {
+    std::abort();
+  }
+  return allocation;
+}
+
+void operator delete(void* allocation) noexcept {
+  std::free(allocation);
+}
+
 namespace impeller {
 
 namespace {
@@ -18,10 +40,31 @@ Path CreateCubic();
 Path CreateQuadratic();
 /// Create a rounded rect.
 Path CreateRRect();
+
+// A corpus of paths shaped like the ones apps draw, rather than ones
+// constructed to stress a single kind of component.
+
+/// A heart and a star icon on a circular badge, as in an icon font.
+Path CreateIcon();
+/// A few coastline-like polygons with hundreds of short line segments each.
+Path CreateMapShape();
+/// A line of glyph outlines made of quadratics, each with a counter.
+Path CreateTextOutline();
+/// An open zig-zag and wave, with the sharp joins of a chart line.
+Path CreateStrokedLine();
 }  // namespace
 
 static Tessellator tess;
 
+static void ReportVertexCounters(benchmark::State& state,
+                                 size_t vertex_count,
+                                 size_t allocations) {
+  state.counters["VerticesPerSecond"] =
+      benchmark::Counter(vertex_count, benchmark::Counter::kIsRate);
+  state.counters["AllocationsPerIteration"] = benchmark::Counter(
+      allocations, benchmark::Counter::kAvgIterations);
+}
+
 template <class... Args>
 static void BM_Polyline(benchmark::State& state, Args&&... args) {
   auto args_tuple = std::make_tuple(std::move(args)...);
@@ -64,6 +107,31 @@ static void BM_Polyline(benchmark::State& state, Args&&... args) {
   state.counters["TotalPointCount"] = point_count;
 }
 
+template <class... Args>
+static void BM_TempPolyline(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto path = std::get<Path>(args_tuple).Clone();
+
+  // Let the tessellator grow its polyline storage to fit the path first, as
+  // it would after drawing the path once.
+  tess.CreateTempPolyline(path, 1.0f);
+
+  size_t point_count = 0u;
+  size_t single_point_count = 0u;
+  size_t allocations = allocation_count.load();
+  while (state.KeepRunning()) {
+    const auto& polyline = tess.CreateTempPolyline(path, 1.0f);
+    single_point_count = polyline.points->size();
+    point_count += single_point_count;
+  }
+  allocations = allocation_count.load() - allocations;
+  state.counters["SinglePointCount"] = single_point_count;
+  state.counters["TotalPointCount"] = point_count;
+  state.counters["Allocations"] = allocations;
+  state.counters["AllocationsPerIteration"] = benchmark::Counter(
+      allocations, benchmark::Counter::kAvgIterations);
+}
+
 template <class... Args>
 static void BM_Convex(benchmark::State& state, Args&&... args) {
   auto args_tuple = std::make_tuple(std::move(args)...);
@@ -71,22 +139,124 @@ static void BM_Convex(benchmark::State& state, Args&&... args) {
 
   size_t point_count = 0u;
   size_t single_point_count = 0u;
-  auto points = std::make_unique<std::vector<Point>>();
-  points->reserve(2048);
+  size_t allocations = allocation_count.load();
   while (state.KeepRunning()) {
     auto points = tess.TessellateConvex(path, 1.0f);
     single_point_count = points.size();
     point_count += points.size();
   }
+  allocations = allocation_count.load() - allocations;
   state.counters["SinglePointCount"] = single_point_count;
   state.counters["TotalPointCount"] = point_count;
+  ReportVertexCounters(state, point_count, allocations);
+}
+
+// Measures the fill path of |Tessellator::Tessellate| for paths that are not
+// convex.
+template <class... Args>
+static void BM_Fill(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto path = std::get<Path>(args_tuple).Clone();
+
+  size_t vertex_count = 0u;
+  size_t allocations = allocation_count.load();
+  while (state.KeepRunning()) {
+    tess.Tessellate(path, 1.0f,
+                    [&vertex_count](const float* vertices,
+                                    size_t vertices_count,
+                                    const uint16_t* indices,
+                                    size_t indices_count) {
+                      vertex_count +=
+                          indices_count > 0 ? indices_count : vertices_count;
+                      return true;
+                    });
+  }
+  allocations = allocation_count.load() - allocations;
+  ReportVertexCounters(state, vertex_count, allocations);
+}
+
+// Measures the polyline that strokes are built from. The joins and caps are
+// generated by the entity geometry, which these benchmarks do not depend on.
+template <class... Args>
+static void BM_Stroke(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto path = std::get<Path>(args_tuple).Clone();
+  // Stroked paths are usually drawn scaled, which subdivides curves further.
+  Scalar scale = std::get<Scalar>(args_tuple);
+
+  tess.CreateTempPolyline(path, scale);
+
+  size_t point_count = 0u;
+  size_t allocations = allocation_count.load();
+  while (state.KeepRunning()) {
+    const auto& polyline = tess.CreateTempPolyline(path, scale);
+    point_count += polyline.points->size();
+  }
+  allocations = allocation_count.load() - allocations;
+  ReportVertexCounters(state, point_count, allocations);
+}
+
+static std::vector<Point> CreatePoints() {
+  std::vector<Point> points;
+  for (auto i = 0; i < 4096; i++) {
+    points.emplace_back(i % 64, i / 64);
+  }
+  return points;
+}
+
+template <class... Args>
+static void BM_TransformPoints(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto transform = std::get<Matrix>(args_tuple);
+  auto points = CreatePoints();
+  std::vector<Point> results(points.size());
+  while (state.KeepRunning()) {
+    TransformPoints(transform, points.data(), results.data(), points.size());
+    benchmark::DoNotOptimize(results.data());
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+static void BM_PointBounds(benchmark::State& state) {
+  auto points = CreatePoints();
+  while (state.KeepRunning()) {
+    auto bounds = ComputePointBounds(points.data(), points.size());
+    benchmark::DoNotOptimize(bounds);
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
 }
 
 BENCHMARK_CAPTURE(BM_Polyline, cubic_polyline, CreateCubic(), false);
 BENCHMARK_CAPTURE(BM_Polyline, cubic_polyline_tess, CreateCubic(), true);
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline, CreateQuadratic(), false);
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline_tess, CreateQuadratic(), true);
+BENCHMARK_CAPTURE(BM_TempPolyline, cubic_temp_polyline, CreateCubic());
+BENCHMARK_CAPTURE(BM_TempPolyline, quad_temp_polyline, CreateQuadratic());
 BENCHMARK_CAPTURE(BM_Convex, rrect_convex, CreateRRect(), true);
+BENCHMARK_CAPTURE(BM_Convex,
+                  circle_convex,
+                  PathBuilder{}.AddCircle({200, 200}, 150).TakePath(),
+                  true);
+BENCHMARK_CAPTURE(BM_Fill, icon_fill, CreateIcon());
+BENCHMARK_CAPTURE(BM_Fill, map_shape_fill, CreateMapShape());
+BENCHMARK_CAPTURE(BM_Fill, text_outline_fill, CreateTextOutline());
+BENCHMARK_CAPTURE(BM_Fill, cubic_fill, CreateCubic());
+BENCHMARK_CAPTURE(BM_Stroke, stroked_line, CreateStrokedLine(), Scalar{1});
+BENCHMARK_CAPTURE(BM_Stroke,
+                  stroked_line_scaled,
+                  CreateStrokedLine(),
+                  Scalar{4});
+BENCHMARK_CAPTURE(BM_Stroke, icon_stroke, CreateIcon(), Scalar{1});
+BENCHMARK_CAPTURE(BM_Stroke, map_shape_stroke, CreateMapShape(), Scalar{1});
+BENCHMARK_CAPTURE(BM_TransformPoints,
+                  affine,
+                  Matrix::MakeTranslation({10, 20}) *
+                      Matrix::MakeRotationZ(Degrees{30}));
+BENCHMARK_CAPTURE(BM_TransformPoints,
+                  perspective,
+                  Matrix::MakePerspective(Degrees{60}, Size(100, 100), 1,
+                                          10));
+BENCHMARK(BM_PointBounds);
 
 namespace {
 
@@ -359,5 +529,121 @@ Path CreateQuadratic() {
       .TakePath();
 }
 
+Path CreateIcon() {
+  PathBuilder builder;
+  // The "favorite" heart of the Material icons, scaled from 24x24 to 192x192.
+  builder.MoveTo({96, 170.8})
+      .LineTo({84.4, 160.24})
+      .CubicCurveTo({43.2, 122.88}, {16, 98.24}, {16, 68})
+      .CubicCurveTo({16, 43.36}, {35.36, 24}, {60, 24})
+      .CubicCurveTo({73.92, 24}, {87.28, 30.48}, {96, 40.72})
+      .CubicCurveTo({104.72, 30.48}, {118.08, 24}, {132, 24})
+      .CubicCurveTo({156.64, 24}, {176, 43.36}, {176, 68})
+      .CubicCurveTo({176, 98.24}, {148.8, 122.88}, {107.6, 160.32})
+      .Close();
+  // A five pointed star.
+  constexpr Point kStarCenter = {288, 96};
+  for (int i = 0; i < 10; i++) {
+    Scalar radius = i % 2 == 0 ? 80 : 32;
+    Scalar angle = kPi * (i / 5.0f - 0.5f);
+    Point point =
+        kStarCenter + Point(std::cos(angle), std::sin(angle)) * radius;
+    if (i == 0) {
+      builder.MoveTo(point);
+    } else {
+      builder.LineTo(point);
+    }
+  }
+  builder.Close();
+  // The badge behind both icons.
+  builder.AddCircle({192, 96}, 190);
+  return builder.TakePath();
+}
+
+Path CreateMapShape() {
+  PathBuilder builder;
+  constexpr int kIslandCount = 4;
+  constexpr int kPointsPerIsland = 512;
+  for (int island = 0; island < kIslandCount; island++) {
+    Point center = {200.0f + island * 420.0f, 300.0f + (island % 2) * 120.0f};
+    for (int i = 0; i < kPointsPerIsland; i++) {
+      Scalar angle = kPi * 2 * i / kPointsPerIsland;
+      // Overlapping frequencies give the ragged outline of a coastline.
+      Scalar radius = 180 + 24 * std::sin(angle * (5 + island)) +
+                      9 * std::sin(angle * 23) + 3 * std::sin(angle * 71);
+      Point point = center + Point(std::cos(angle), std::sin(angle)) * radius;
+      if (i == 0) {
+        builder.MoveTo(point);
+      } else {
+        builder.LineTo(point);
+      }
+    }
+    builder.Close();
+  }
+  return builder.TakePath();
+}
+
+Path CreateTextOutline() {
+  PathBuilder builder;
+  constexpr int kGlyphCount = 24;
+  constexpr Scalar kAdvance = 36;
+  constexpr Scalar kBaseline = 64;
+  // Adds an ellipse of eight quadratics, winding the other way when
+  // |reverse| so that it cuts a counter out of the glyph.
+  auto add_ellipse = [&builder](Point center, Size radius, bool reverse) {
+    constexpr int kQuadCount = 8;
+    // The control point lies on the tangents of the segment's end points.
+    Scalar control_scale = 1 / std::cos(kPi / kQuadCount);
+    for (int i = 0; i <= kQuadCount; i++) {
+      Scalar angle = (reverse ? -kPi : kPi) * 2 * i / kQuadCount;
+      Point point = center + Point(std::cos(angle) * radius.width,
+                                   std::sin(angle) * radius.height);
+      if (i == 0) {
+        builder.MoveTo(point);
+        continue;
+      }
+      Scalar control_angle = angle - (reverse ? -kPi : kPi) / kQuadCount;
+      Point control =
+          center + Point(std::cos(control_angle) * radius.width,
+                         std::sin(control_angle) * radius.height) *
+                       control_scale;
+      builder.QuadraticCurveTo(control, point);
+    }
+    builder.Close();
+  };
+  for (int i = 0; i < kGlyphCount; i++) {
+    Scalar x = 16 + i * kAdvance;
+    if (i % 3 == 2) {
+      // A stem, like the one of an "l".
+      builder.AddRect(
+          Rect::MakeLTRB(x + 10, kBaseline - 48, x + 18, kBaseline));
+      continue;
+    }
+    // A bowl, like the one of an "o".
+    Point center = {x + 14, kBaseline - 14};
+    add_ellipse(center, {14, 15}, false);
+    add_ellipse(center, {8, 10}, true);
+  }
+  return builder.TakePath();
+}
+
+Path CreateStrokedLine() {
+  PathBuilder builder;
+  // A chart line with sharp joins.
+  builder.MoveTo({0, 200});
+  for (int i = 1; i <= 64; i++) {
+    builder.LineTo({i * 12.0f, 200.0f + ((i * 37) % 23 - 11) * 8.0f});
+  }
+  // A wave of cubics, as in a path animation.
+  builder.MoveTo({0, 400});
+  for (int i = 0; i < 32; i++) {
+    Scalar x = i * 24.0f;
+    Scalar direction = i % 2 == 0 ? -1 : 1;
+    builder.CubicCurveTo({x + 8, 400 + direction * 40},
+                         {x + 16, 400 + direction * 40}, {x + 24, 400});
+  }
+  return builder.TakePath();
+}
+
 }  // namespace
 }  // namespace impeller
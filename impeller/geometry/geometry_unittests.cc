@@ -16,6 +16,7 @@
 #include "impeller/geometry/gradient.h"
 #include "impeller/geometry/half.h"
 #include "impeller/geometry/point.h"
+#include "impeller/geometry/point_batch.h"
 #include "impeller/geometry/rect.h"
 #include "impeller/geometry/scalar.h"
 #include "impeller/geometry/size.h"
@@ -2184,6 +2185,58 @@ TEST(GeometryTest, HalfConversions) {
 #endif  // FML_OS_WIN
 }
 
+TEST(GeometryTest, TransformPointsMatchesMatrixMultiplication) {
+  // An odd count exercises the tails of the vectorized loops.
+  std::vector<Point> points;
+  for (auto i = 0; i < 11; i++) {
+    points.emplace_back(i * 3.5f - 10.0f, 20.0f - i * i);
+  }
+  std::vector<Matrix> transforms = {
+      Matrix(),
+      Matrix::MakeTranslation({10, -20}) * Matrix::MakeScale({2, 3, 1}),
+      Matrix::MakeRotationZ(Degrees{30}) * Matrix::MakeSkew(0.5, 0.25),
+      Matrix::MakePerspective(Degrees{60}, Size(100, 100), 1, 10) *
+          Matrix::MakeTranslation({0, 0, 5}),
+  };
+
+  for (const auto& transform : transforms) {
+    std::vector<Point> results(points.size());
+    TransformPoints(transform, points.data(), results.data(), points.size());
+    for (auto i = 0u; i < points.size(); i++) {
+      ASSERT_POINT_NEAR(results[i], transform * points[i]);
+    }
+
+    // Transforming in place gives the same results.
+    auto in_place = points;
+    TransformPoints(transform, in_place.data(), in_place.data(),
+                    in_place.size());
+    for (auto i = 0u; i < points.size(); i++) {
+      ASSERT_POINT_NEAR(in_place[i], results[i]);
+    }
+  }
+
+  // Empty input is a no-op.
+  TransformPoints(Matrix(), nullptr, nullptr, 0u);
+}
+
+TEST(GeometryTest, ComputePointBoundsMatchesMakePointBounds) {
+  ASSERT_FALSE(ComputePointBounds(nullptr, 0u).has_value());
+
+  std::vector<Point> points;
+  for (auto i = 0; i < 9; i++) {
+    points.emplace_back((i * 7) % 5 - 2.0f, (i * 3) % 8 + 1.0f);
+    auto bounds = ComputePointBounds(points.data(), points.size());
+    ASSERT_TRUE(bounds.has_value());
+    auto expected = Rect::MakePointBounds(points.begin(), points.end());
+    ASSERT_RECT_NEAR(bounds.value(), expected.value());
+  }
+
+  // Points along a single axis still have (empty) bounds.
+  std::vector<Point> line = {{1, 5}, {1, 2}, {1, 9}};
+  ASSERT_RECT_NEAR(ComputePointBounds(line.data(), line.size()).value(),
+                   Rect::MakeLTRB(1, 2, 1, 9));
+}
+
 }  // namespace testing
 }  // namespace impeller
 
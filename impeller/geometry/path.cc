@@ -5,9 +5,12 @@
 #include "impeller/geometry/path.h"
 
 #include <optional>
+#include <type_traits>
 #include <variant>
 
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/memory/allocation_counter.h"
 #include "impeller/geometry/path_component.h"
 #include "impeller/geometry/point.h"
 
@@ -15,10 +18,17 @@ namespace impeller {
 
 Path::Path() {
   AddContourComponent({});
+  fml::RecordAllocation(fml::AllocationTag::kPath, GetStorageSize());
 };
 
 Path::~Path() = default;
 
+size_t Path::GetStorageSize() const {
+  return components_.capacity() * sizeof(ComponentIndexPair) +
+         points_.capacity() * sizeof(Point) +
+         contours_.capacity() * sizeof(ContourComponent);
+}
+
 std::tuple<size_t, size_t> Path::Polyline::GetContourPointBounds(
     size_t contour_index) const {
   if (contour_index >= contours.size()) {
@@ -64,6 +74,14 @@ void Path::SetConvexity(Convexity value) {
   convexity_ = value;
 }
 
+bool Path::IsVolatile() const {
+  return is_volatile_;
+}
+
+void Path::SetVolatile(bool is_volatile) {
+  is_volatile_ = is_volatile;
+}
+
 void Path::Shift(Point shift) {
   for (auto i = 0u; i < points_.size(); i++) {
     points_[i] += shift;
@@ -73,8 +91,56 @@ void Path::Shift(Point shift) {
   }
 }
 
+size_t Path::ComputeHash() const {
+  size_t hash = fml::HashCombine(fill_, components_.size());
+  for (const auto& component : components_) {
+    fml::HashCombineSeed(hash, component.type, component.index);
+  }
+  for (const auto& point : points_) {
+    fml::HashCombineSeed(hash, point.x, point.y);
+  }
+  for (const auto& contour : contours_) {
+    fml::HashCombineSeed(hash, contour.destination.x, contour.destination.y,
+                         contour.is_closed);
+  }
+  return hash;
+}
+
+template <typename T>
+static void AppendBytes(std::vector<uint8_t>& bytes, const T& value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  const auto* data = reinterpret_cast<const uint8_t*>(&value);
+  bytes.insert(bytes.end(), data, data + sizeof(T));
+}
+
+void Path::AppendContent(std::vector<uint8_t>& bytes) const {
+  // Fields are appended one by one, since the structs have padding.
+  bytes.reserve(bytes.size() + sizeof(fill_) + 3 * sizeof(size_t) +
+                components_.size() * sizeof(ComponentIndexPair) +
+                points_.size() * sizeof(Point) +
+                contours_.size() * sizeof(ContourComponent));
+  AppendBytes(bytes, fill_);
+  AppendBytes(bytes, components_.size());
+  for (const auto& component : components_) {
+    AppendBytes(bytes, component.type);
+    AppendBytes(bytes, component.index);
+  }
+  AppendBytes(bytes, points_.size());
+  for (const auto& point : points_) {
+    AppendBytes(bytes, point.x);
+    AppendBytes(bytes, point.y);
+  }
+  AppendBytes(bytes, contours_.size());
+  for (const auto& contour : contours_) {
+    AppendBytes(bytes, contour.destination.x);
+    AppendBytes(bytes, contour.destination.y);
+    AppendBytes(bytes, contour.is_closed);
+  }
+}
+
 Path Path::Clone() const {
   Path new_path = *this;
+  fml::RecordAllocation(fml::AllocationTag::kPath, GetStorageSize());
   return new_path;
 }
 
@@ -241,6 +307,7 @@ Path::Polyline::Polyline(Path::Polyline&& other) {
   points = std::move(other.points);
   reclaim_points_ = std::move(other.reclaim_points_);
   contours = std::move(other.contours);
+  components = std::move(other.components);
 }
 
 Path::Polyline::~Polyline() {
@@ -255,6 +322,14 @@ Path::Polyline Path::CreatePolyline(
     Path::Polyline::PointBufferPtr point_buffer,
     Path::Polyline::ReclaimPointBufferCallback reclaim) const {
   Polyline polyline(std::move(point_buffer), std::move(reclaim));
+  WritePolyline(scale, polyline);
+  return polyline;
+}
+
+void Path::WritePolyline(Scalar scale, Polyline& polyline) const {
+  polyline.points->clear();
+  polyline.contours.clear();
+  polyline.components.clear();
 
   auto get_path_component = [this](size_t component_i) -> PathComponentVariant {
     if (component_i >= components_.size()) {
@@ -293,7 +368,7 @@ Path::Polyline Path::CreatePolyline(
         return Vector2(0, -1);
       };
 
-  std::vector<PolylineContour::Component> components;
+  auto& components = polyline.components;
   std::optional<size_t> previous_path_component_index;
   auto end_contour = [&polyline, &previous_path_component_index,
                       &get_path_component, &components]() {
@@ -309,8 +384,7 @@ Path::Polyline Path::CreatePolyline(
 
     auto& contour = polyline.contours.back();
     contour.end_direction = Vector2(0, 1);
-    contour.components = components;
-    components.clear();
+    contour.components_end_index = components.size();
 
     size_t previous_index = previous_path_component_index.value();
     while (!std::holds_alternative<std::monostate>(
@@ -372,17 +446,18 @@ Path::Polyline Path::CreatePolyline(
 
         Vector2 start_direction = compute_contour_start_direction(component_i);
         const auto& contour = contours_[component.index];
-        polyline.contours.push_back({.start_index = polyline.points->size(),
-                                     .is_closed = contour.is_closed,
-                                     .start_direction = start_direction,
-                                     .components = components});
+        polyline.contours.push_back(
+            {.start_index = polyline.points->size(),
+             .is_closed = contour.is_closed,
+             .start_direction = start_direction,
+             .components_start_index = components.size(),
+             .components_end_index = components.size()});
 
         polyline.points->push_back(contour.destination);
         break;
     }
   }
   end_contour();
-  return polyline;
 }
 
 std::optional<Rect> Path::GetBoundingBox() const {
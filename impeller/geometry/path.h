@@ -5,6 +5,7 @@
 #ifndef FLUTTER_IMPELLER_GEOMETRY_PATH_H_
 #define FLUTTER_IMPELLER_GEOMETRY_PATH_H_
 
+#include <cstdint>
 #include <functional>
 #include <optional>
 #include <set>
@@ -82,11 +83,17 @@ class Path {
     /// The direction of the contour's end cap.
     Vector2 end_direction;
 
-    /// Distinct components in this contour.
+    /// The range of this contour's components in |Polyline::components|,
+    /// from the start (inclusive) to the end (exclusive) index.
     ///
     /// If this contour is generated from multiple path components, each
-    /// path component forms a component in this vector.
-    std::vector<Component> components;
+    /// path component forms a component in this range.
+    size_t components_start_index = 0u;
+    size_t components_end_index = 0u;
+
+    size_t GetComponentCount() const {
+      return components_end_index - components_start_index;
+    }
   };
 
   /// One or more contours represented as a series of points and indices in
@@ -118,6 +125,18 @@ class Path {
     /// was issued on a PathBuilder.
     std::vector<PolylineContour> contours;
 
+    /// The components of all contours, in order. Keeping them in a single
+    /// vector instead of one per contour allows a polyline that is reused
+    /// with |Path::WritePolyline| to not allocate once it is large enough.
+    std::vector<PolylineContour::Component> components;
+
+    /// Convenience method to get a component of the given contour.
+    const PolylineContour::Component& GetContourComponent(
+        const PolylineContour& contour,
+        size_t component_index) const {
+      return components[contour.components_start_index + component_index];
+    }
+
     /// Convenience method to compute the start (inclusive) and end (exclusive)
     /// point of the given contour index.
     ///
@@ -144,6 +163,21 @@ class Path {
 
   bool IsConvex() const;
 
+  /// @brief  Whether the path is expected to change from frame to frame, in
+  ///         which case work derived from it is not worth caching.
+  bool IsVolatile() const;
+
+  /// @brief  Computes a hash of the fill type and the components of this
+  ///         path. Paths built from the same components hash the same, which
+  ///         allows caching work derived from the path content alone.
+  size_t ComputeHash() const;
+
+  /// @brief  Appends the fill type and the components of this path to
+  ///         |bytes|. Two paths append the same bytes only if they were
+  ///         built from the same components, so caches can tell paths with
+  ///         colliding hashes apart.
+  void AppendContent(std::vector<uint8_t>& bytes) const;
+
   template <class T>
   using Applier = std::function<void(size_t index, const T& component)>;
   void EnumerateComponents(
@@ -175,6 +209,12 @@ class Path {
           std::make_unique<std::vector<Point>>(),
       Polyline::ReclaimPointBufferCallback reclaim = nullptr) const;
 
+  /// Like |CreatePolyline|, but replaces the contents of an existing
+  /// polyline. The memory already held by the polyline is reused, so callers
+  /// that keep a polyline around, such as the |Tessellator|, do not allocate
+  /// once it has grown to fit the paths they draw.
+  void WritePolyline(Scalar scale, Polyline& polyline) const;
+
   std::optional<Rect> GetBoundingBox() const;
 
   std::optional<Rect> GetTransformedBoundingBox(const Matrix& transform) const;
@@ -186,8 +226,13 @@ class Path {
 
   Path(const Path& other) = default;
 
+  /// @brief The bytes allocated for the components, points, and contours.
+  size_t GetStorageSize() const;
+
   void SetConvexity(Convexity value);
 
+  void SetVolatile(bool is_volatile);
+
   void SetFillType(FillType fill);
 
   void SetBounds(Rect rect);
@@ -227,6 +272,7 @@ class Path {
 
   FillType fill_ = FillType::kNonZero;
   Convexity convexity_ = Convexity::kUnknown;
+  bool is_volatile_ = false;
   std::vector<ComponentIndexPair> components_;
   std::vector<Point> points_;
   std::vector<ContourComponent> contours_;
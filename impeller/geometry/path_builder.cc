@@ -22,6 +22,7 @@ Path PathBuilder::TakePath(FillType fill) {
   auto path = std::move(prototype_);
   path.SetFillType(fill);
   path.SetConvexity(convexity_);
+  path.SetVolatile(is_volatile_);
   if (!did_compute_bounds_) {
     path.ComputeBounds();
   }
@@ -86,6 +87,11 @@ PathBuilder& PathBuilder::SetConvexity(Convexity value) {
   return *this;
 }
 
+PathBuilder& PathBuilder::SetVolatile(bool is_volatile) {
+  is_volatile_ = is_volatile;
+  return *this;
+}
+
 PathBuilder& PathBuilder::CubicCurveTo(Point controlPoint1,
                                        Point controlPoint2,
                                        Point point,
@@ -185,12 +185,23 @@ Point CubicPathComponent::SolveDerivative(Scalar time) const {
   };
 }
 
+// The fraction of the curve tolerance spent on approximating cubics with
+// quadratics. The remainder is left for flattening the quadratics.
+static constexpr Scalar kCubicToQuadraticToleranceFraction = 0.1f;
+
 void CubicPathComponent::AppendPolylinePoints(
     Scalar scale,
     std::vector<Point>& points) const {
-  auto quads = ToQuadraticPathComponents(.1);
-  for (const auto& quad : quads) {
-    quad.AppendPolylinePoints(scale, points);
+  auto tolerance = kDefaultCurveTolerance / scale;
+  auto quad_count = CountQuadraticPathComponents(
+      tolerance * kCubicToQuadraticToleranceFraction);
+  // Flattening the quadratics at a larger scale leaves them the rest of the
+  // tolerance.
+  auto quad_scale = scale / (1.0f - kCubicToQuadraticToleranceFraction);
+  for (size_t i = 0; i < quad_count; i++) {
+    Scalar t0 = static_cast<Scalar>(i) / quad_count;
+    Scalar t1 = static_cast<Scalar>(i + 1) / quad_count;
+    ToQuadraticPathComponent(t0, t1).AppendPolylinePoints(quad_scale, points);
   }
 }
 
@@ -209,9 +220,8 @@ CubicPathComponent CubicPathComponent::Subsegment(Scalar t0, Scalar t1) const {
   return CubicPathComponent(p0, p1, p2, p3);
 }
 
-std::vector<QuadraticPathComponent>
-CubicPathComponent::ToQuadraticPathComponents(Scalar accuracy) const {
-  std::vector<QuadraticPathComponent> quads;
+size_t CubicPathComponent::CountQuadraticPathComponents(
+    Scalar accuracy) const {
   // The maximum error, as a vector from the cubic to the best approximating
   // quadratic, is proportional to the third derivative, which is constant
   // across the segment. Thus, the error scales down as the third power of
@@ -228,16 +238,28 @@ CubicPathComponent::ToQuadraticPathComponents(Scalar accuracy) const {
   auto p2x2 = 3.0 * cp2 - p2;
   auto p = p2x2 - p1x2;
   auto err = p.Dot(p);
-  auto quad_count = std::max(1., ceil(pow(err / max_hypot2, 1. / 6.0)));
+  return static_cast<size_t>(
+      std::max(1., ceil(pow(err / max_hypot2, 1. / 6.0))));
+}
+
+QuadraticPathComponent CubicPathComponent::ToQuadraticPathComponent(
+    Scalar t0,
+    Scalar t1) const {
+  auto seg = Subsegment(t0, t1);
+  auto p1x2 = 3.0 * seg.cp1 - seg.p1;
+  auto p2x2 = 3.0 * seg.cp2 - seg.p2;
+  return QuadraticPathComponent(seg.p1, ((p1x2 + p2x2) / 4.0), seg.p2);
+}
+
+std::vector<QuadraticPathComponent>
+CubicPathComponent::ToQuadraticPathComponents(Scalar accuracy) const {
+  std::vector<QuadraticPathComponent> quads;
+  auto quad_count = CountQuadraticPathComponents(accuracy);
   quads.reserve(quad_count);
   for (size_t i = 0; i < quad_count; i++) {
-    auto t0 = i / quad_count;
-    auto t1 = (i + 1) / quad_count;
-    auto seg = Subsegment(t0, t1);
-    auto p1x2 = 3.0 * seg.cp1 - seg.p1;
-    auto p2x2 = 3.0 * seg.cp2 - seg.p2;
-    quads.emplace_back(
-        QuadraticPathComponent(seg.p1, ((p1x2 + p2x2) / 4.0), seg.p2));
+    Scalar t0 = static_cast<Scalar>(i) / quad_count;
+    Scalar t1 = static_cast<Scalar>(i + 1) / quad_count;
+    quads.emplace_back(ToQuadraticPathComponent(t0, t1));
   }
   return quads;
 }
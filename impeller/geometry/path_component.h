@@ -119,6 +119,10 @@ struct CubicPathComponent {
   // This method approximates the cubic component with quadratics, and then
   // generates a polyline from those quadratics.
   //
+  // The curve tolerance is split between both steps, so the number of
+  // quadratics and the number of points generated for each of them follow
+  // from the scale analytically, without any recursive subdivision.
+  //
   // See the note on QuadraticPathComponent::AppendPolylinePoints for
   // references.
   void AppendPolylinePoints(Scalar scale, std::vector<Point>& points) const;
@@ -141,6 +145,13 @@ struct CubicPathComponent {
 
  private:
   QuadraticPathComponent Lower() const;
+
+  // The number of quadratics needed to approximate this cubic within the
+  // accuracy.
+  size_t CountQuadraticPathComponents(Scalar accuracy) const;
+
+  // The quadratic approximating the cubic between t0 and t1.
+  QuadraticPathComponent ToQuadraticPathComponent(Scalar t0, Scalar t1) const;
 };
 
 struct ContourComponent {
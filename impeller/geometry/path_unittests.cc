@@ -4,6 +4,9 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "flutter/testing/testing.h"
 #include "impeller/geometry/geometry_asserts.h"
 #include "impeller/geometry/path.h"
@@ -22,6 +25,40 @@ TEST(PathTest, CubicPathComponentPolylineDoesNotIncludePointOne) {
   ASSERT_EQ(polyline.back().y, 40);
 }
 
+TEST(PathTest, CubicPathComponentPolylineStaysWithinToleranceAtScale) {
+  CubicPathComponent component({0, 0}, {100, 200}, {200, -100}, {300, 100});
+  auto distance_to_polyline = [](Point point,
+                                 const std::vector<Point>& polyline) {
+    auto distance = std::numeric_limits<Scalar>::max();
+    for (auto i = 1u; i < polyline.size(); i++) {
+      auto segment = polyline[i] - polyline[i - 1];
+      auto t = std::clamp(
+          (point - polyline[i - 1]).Dot(segment) / segment.Dot(segment), 0.0f,
+          1.0f);
+      distance = std::min(distance,
+                          point.GetDistance(polyline[i - 1] + segment * t));
+    }
+    return distance;
+  };
+
+  size_t previous_count = 0u;
+  for (auto scale : {1.0f, 10.0f, 100.0f}) {
+    std::vector<Point> polyline = {component.p1};
+    component.AppendPolylinePoints(scale, polyline);
+    EXPECT_GT(polyline.size(), previous_count);
+    previous_count = polyline.size();
+
+    Scalar max_error = 0.0f;
+    for (auto i = 0; i <= 1000; i++) {
+      max_error = std::max(
+          max_error, distance_to_polyline(component.Solve(i / 1000.0f),
+                                          polyline));
+    }
+    // The error is measured in device pixels.
+    EXPECT_LE(max_error * scale, kDefaultCurveTolerance * 1.1f) << scale;
+  }
+}
+
 TEST(PathTest, PathCreatePolyLineDoesNotDuplicatePoints) {
   PathBuilder builder;
   builder.MoveTo({10, 10});
@@ -139,6 +176,36 @@ TEST(PathTest, PathCreatePolylineGeneratesCorrectContourData) {
   ASSERT_EQ(polyline.contours[1].start_index, 2u);
 }
 
+TEST(PathTest, WritePolylineReusesPolylineStorage) {
+  auto path = PathBuilder{}
+                  .AddLine({100, 100}, {200, 100})
+                  .MoveTo({100, 200})
+                  .LineTo({150, 250})
+                  .QuadraticCurveTo({175, 275}, {200, 200})
+                  .Close()
+                  .TakePath();
+  Path::Polyline polyline = path.CreatePolyline(1.0f);
+  ASSERT_EQ(polyline.contours.size(), 2u);
+  ASSERT_EQ(polyline.contours[0].GetComponentCount(), 1u);
+  ASSERT_EQ(polyline.contours[1].GetComponentCount(), 3u);
+  ASSERT_FALSE(
+      polyline.GetContourComponent(polyline.contours[1], 0u).is_curve);
+  ASSERT_TRUE(polyline.GetContourComponent(polyline.contours[1], 1u).is_curve);
+
+  const auto* points = polyline.points->data();
+  const auto* contours = polyline.contours.data();
+  const auto* components = polyline.components.data();
+  const auto point_count = polyline.points->size();
+  path.WritePolyline(1.0f, polyline);
+
+  ASSERT_EQ(polyline.points->size(), point_count);
+  ASSERT_EQ(polyline.contours.size(), 2u);
+  ASSERT_EQ(polyline.components.size(), 4u);
+  ASSERT_EQ(polyline.points->data(), points);
+  ASSERT_EQ(polyline.contours.data(), contours);
+  ASSERT_EQ(polyline.components.data(), components);
+}
+
 TEST(PathTest, PolylineGetContourPointBoundsReturnsCorrectRanges) {
   Path::Polyline polyline = PathBuilder{}
                                 .AddLine({100, 100}, {200, 100})
@@ -157,6 +224,25 @@ TEST(PathTest, PolylineGetContourPointBoundsReturnsCorrectRanges) {
   ASSERT_EQ(b2, 6u);
 }
 
+TEST(PathTest, ComputeHashDependsOnContentOnly) {
+  auto make_path = [](Point end, FillType fill) {
+    return PathBuilder{}
+        .MoveTo({0, 0})
+        .QuadraticCurveTo({50, 100}, end)
+        .Close()
+        .TakePath(fill);
+  };
+
+  auto path = make_path({100, 0}, FillType::kNonZero);
+  EXPECT_EQ(path.ComputeHash(), path.Clone().ComputeHash());
+  EXPECT_EQ(path.ComputeHash(),
+            make_path({100, 0}, FillType::kNonZero).ComputeHash());
+  EXPECT_NE(path.ComputeHash(),
+            make_path({100, 1}, FillType::kNonZero).ComputeHash());
+  EXPECT_NE(path.ComputeHash(),
+            make_path({100, 0}, FillType::kOdd).ComputeHash());
+}
+
 TEST(PathTest, PathAddRectPolylineHasCorrectContourData) {
   Path::Polyline polyline = PathBuilder{}
                                 .AddRect(Rect::MakeLTRB(50, 60, 70, 80))
@@ -485,5 +571,15 @@ TEST(PathTest, CanBeCloned) {
   }
 }
 
+TEST(PathTest, PathBuilderSetsVolatility) {
+  PathBuilder builder;
+  builder.AddRect(Rect::MakeLTRB(0, 0, 10, 10));
+  EXPECT_FALSE(builder.CopyPath().IsVolatile());
+
+  Path path = builder.SetVolatile(true).TakePath();
+  EXPECT_TRUE(path.IsVolatile());
+  EXPECT_TRUE(path.Clone().IsVolatile());
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -0,0 +1,132 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/geometry/point_batch.h"
+
+#include <algorithm>
+#include <type_traits>
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define IMPELLER_POINT_BATCH_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define IMPELLER_POINT_BATCH_SSE2 1
+#endif
+
+namespace impeller {
+
+// The SIMD paths treat arrays of points as interleaved arrays of scalars.
+static_assert(sizeof(Point) == 2 * sizeof(Scalar));
+static_assert(std::is_same_v<Scalar, float>);
+
+void TransformPoints(const Matrix& transform,
+                     const Point* points,
+                     Point* results,
+                     size_t count) {
+  size_t i = 0u;
+  const bool has_perspective =
+      transform.m[3] != 0 || transform.m[7] != 0 || transform.m[15] != 1;
+  if (!has_perspective) {
+    [[maybe_unused]] const auto* in = reinterpret_cast<const float*>(points);
+    [[maybe_unused]] auto* out = reinterpret_cast<float*>(results);
+#if IMPELLER_POINT_BATCH_NEON
+    // Four points at a time, split into their x and y components.
+    for (; i + 4u <= count; i += 4u) {
+      float32x4x2_t p = vld2q_f32(in + i * 2u);
+      float32x4x2_t r;
+      r.val[0] = vdupq_n_f32(transform.m[12]);
+      r.val[0] = vfmaq_n_f32(r.val[0], p.val[0], transform.m[0]);
+      r.val[0] = vfmaq_n_f32(r.val[0], p.val[1], transform.m[4]);
+      r.val[1] = vdupq_n_f32(transform.m[13]);
+      r.val[1] = vfmaq_n_f32(r.val[1], p.val[0], transform.m[1]);
+      r.val[1] = vfmaq_n_f32(r.val[1], p.val[1], transform.m[5]);
+      vst2q_f32(out + i * 2u, r);
+    }
+#elif IMPELLER_POINT_BATCH_SSE2
+    // Two interleaved points at a time.
+    const __m128 scale_x = _mm_setr_ps(transform.m[0], transform.m[1],
+                                       transform.m[0], transform.m[1]);
+    const __m128 scale_y = _mm_setr_ps(transform.m[4], transform.m[5],
+                                       transform.m[4], transform.m[5]);
+    const __m128 translate = _mm_setr_ps(transform.m[12], transform.m[13],
+                                         transform.m[12], transform.m[13]);
+    for (; i + 2u <= count; i += 2u) {
+      __m128 p = _mm_loadu_ps(in + i * 2u);
+      __m128 x = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 0, 0));
+      __m128 y = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 1, 1));
+      __m128 r = _mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(x, scale_x), _mm_mul_ps(y, scale_y)),
+          translate);
+      _mm_storeu_ps(out + i * 2u, r);
+    }
+#endif
+  }
+  for (; i < count; i++) {
+    results[i] = transform * points[i];
+  }
+}
+
+std::optional<Rect> ComputePointBounds(const Point* points, size_t count) {
+  if (count == 0u) {
+    return std::nullopt;
+  }
+  auto left = points[0].x;
+  auto top = points[0].y;
+  auto right = points[0].x;
+  auto bottom = points[0].y;
+  size_t i = 1u;
+
+#if IMPELLER_POINT_BATCH_NEON
+  if (count >= 4u) {
+    const auto* in = reinterpret_cast<const float*>(points);
+    float32x4_t min_x = vdupq_n_f32(left);
+    float32x4_t min_y = vdupq_n_f32(top);
+    float32x4_t max_x = min_x;
+    float32x4_t max_y = min_y;
+    for (i = 0u; i + 4u <= count; i += 4u) {
+      float32x4x2_t p = vld2q_f32(in + i * 2u);
+      min_x = vminq_f32(min_x, p.val[0]);
+      min_y = vminq_f32(min_y, p.val[1]);
+      max_x = vmaxq_f32(max_x, p.val[0]);
+      max_y = vmaxq_f32(max_y, p.val[1]);
+    }
+    left = vminvq_f32(min_x);
+    top = vminvq_f32(min_y);
+    right = vmaxvq_f32(max_x);
+    bottom = vmaxvq_f32(max_y);
+  }
+#elif IMPELLER_POINT_BATCH_SSE2
+  if (count >= 2u) {
+    const auto* in = reinterpret_cast<const float*>(points);
+    __m128 min = _mm_setr_ps(left, top, left, top);
+    __m128 max = min;
+    for (i = 0u; i + 2u <= count; i += 2u) {
+      __m128 p = _mm_loadu_ps(in + i * 2u);
+      min = _mm_min_ps(min, p);
+      max = _mm_max_ps(max, p);
+    }
+    // Fold the two points of each register into the low lanes.
+    min = _mm_min_ps(min, _mm_movehl_ps(min, min));
+    max = _mm_max_ps(max, _mm_movehl_ps(max, max));
+    float result[4];
+    _mm_storeu_ps(result, min);
+    left = result[0];
+    top = result[1];
+    _mm_storeu_ps(result, max);
+    right = result[0];
+    bottom = result[1];
+  }
+#endif
+
+  for (; i < count; i++) {
+    left = std::min(left, points[i].x);
+    top = std::min(top, points[i].y);
+    right = std::max(right, points[i].x);
+    bottom = std::max(bottom, points[i].y);
+  }
+  return Rect::MakeLTRB(left, top, right, bottom);
+}
+
+}  // namespace impeller
@@ -0,0 +1,46 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_GEOMETRY_POINT_BATCH_H_
+#define FLUTTER_IMPELLER_GEOMETRY_POINT_BATCH_H_
+
+#include <cstddef>
+#include <optional>
+
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/point.h"
+#include "impeller/geometry/rect.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Transforms `count` points by `transform`, with the same result
+///             as `transform * point` for each point up to rounding.
+///
+///             Transforms without perspective use NEON or SSE2 instructions
+///             where available and process several points at once.
+///
+/// @param[in]  transform  The transform to apply.
+/// @param[in]  points     The points to transform.
+/// @param[out] results    The transformed points. This may be the same array
+///                        as `points`, but the two must not otherwise overlap.
+/// @param[in]  count      The number of points in both arrays.
+///
+void TransformPoints(const Matrix& transform,
+                     const Point* points,
+                     Point* results,
+                     size_t count);
+
+//------------------------------------------------------------------------------
+/// @brief      Computes the bounds of `count` points using NEON or SSE2
+///             instructions where available.
+///
+/// @return     The smallest rectangle containing all points, or std::nullopt
+///             if `count` is zero.
+///
+std::optional<Rect> ComputePointBounds(const Point* points, size_t count);
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_GEOMETRY_POINT_BATCH_H_
@@ -6,6 +6,7 @@
 #define FLUTTER_IMPELLER_GOLDEN_TESTS_METAL_SCREENSHOTTER_H_
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/impeller/aiks/picture.h"
 #include "flutter/impeller/golden_tests/metal_screenshot.h"
 #include "flutter/impeller/playground/playground_impl.h"
@@ -27,6 +28,10 @@ class MetalScreenshotter {
 
   PlaygroundImpl& GetPlayground() { return *playground_; }
 
+  /// The GPU time of the frames rendered with the playground context so far,
+  /// or zero if the GPU tracer of the context is disabled.
+  fml::TimeDelta GetTotalGPUTime() const;
+
  private:
   std::unique_ptr<PlaygroundImpl> playground_;
 };
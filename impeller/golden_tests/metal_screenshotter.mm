@@ -57,5 +57,15 @@ std::unique_ptr<MetalScreenshot> MetalScreenshotter::MakeScreenshot(
   return std::unique_ptr<MetalScreenshot>(new MetalScreenshot(cgImage));
 }
 
+fml::TimeDelta MetalScreenshotter::GetTotalGPUTime() const {
+#ifdef IMPELLER_DEBUG
+  return ContextMTL::Cast(*playground_->GetContext())
+      .GetGPUTracer()
+      ->GetTotalGPUTime();
+#else
+  return fml::TimeDelta::Zero();
+#endif  // IMPELLER_DEBUG
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -45,6 +45,10 @@ bool BufferBindingsGLES::RegisterVertexStageInput(
     vertex_attrib_arrays.emplace_back(attrib);
   }
   vertex_attrib_arrays_ = std::move(vertex_attrib_arrays);
+  vertex_attrib_indices_.clear();
+  for (const auto& array : vertex_attrib_arrays_) {
+    vertex_attrib_indices_.push_back(array.index);
+  }
   return true;
 }
 
@@ -124,9 +128,10 @@ bool BufferBindingsGLES::ReadUniformsBindings(const ProcTableGLES& gl,
 }
 
 bool BufferBindingsGLES::BindVertexAttributes(const ProcTableGLES& gl,
+                                              StateTrackerGLES& state,
                                               size_t vertex_offset) const {
+  state.SetEnabledVertexAttribArrays(vertex_attrib_indices_);
   for (const auto& array : vertex_attrib_arrays_) {
-    gl.EnableVertexAttribArray(array.index);
     gl.VertexAttribPointer(array.index,       // index
                            array.size,        // size (must be 1, 2, 3, or 4)
                            array.type,        // type
@@ -141,27 +146,28 @@ bool BufferBindingsGLES::BindVertexAttributes(const ProcTableGLES& gl,
 }
 
 bool BufferBindingsGLES::BindUniformData(const ProcTableGLES& gl,
+                                         StateTrackerGLES& state,
                                          Allocator& transients_allocator,
                                          const Bindings& vertex_bindings,
                                          const Bindings& fragment_bindings) {
   for (const auto& buffer : vertex_bindings.buffers) {
-    if (!BindUniformBuffer(gl, transients_allocator, buffer.view)) {
+    if (!BindUniformBuffer(gl, state, transients_allocator, buffer.view)) {
       return false;
     }
   }
   for (const auto& buffer : fragment_bindings.buffers) {
-    if (!BindUniformBuffer(gl, transients_allocator, buffer.view)) {
+    if (!BindUniformBuffer(gl, state, transients_allocator, buffer.view)) {
       return false;
     }
   }
 
   std::optional<size_t> next_unit_index =
-      BindTextures(gl, vertex_bindings, ShaderStage::kVertex);
+      BindTextures(gl, state, vertex_bindings, ShaderStage::kVertex);
   if (!next_unit_index.has_value()) {
     return false;
   }
 
-  if (!BindTextures(gl, fragment_bindings, ShaderStage::kFragment,
+  if (!BindTextures(gl, state, fragment_bindings, ShaderStage::kFragment,
                     *next_unit_index)
            .has_value()) {
     return false;
@@ -170,10 +176,17 @@ bool BufferBindingsGLES::BindUniformData(const ProcTableGLES& gl,
   return true;
 }
 
-bool BufferBindingsGLES::UnbindVertexAttributes(const ProcTableGLES& gl) const {
-  for (const auto& array : vertex_attrib_arrays_) {
-    gl.DisableVertexAttribArray(array.index);
+bool BufferBindingsGLES::UpdateUniformValue(StateTrackerGLES& state,
+                                            GLint location,
+                                            const void* data,
+                                            size_t length) {
+  auto& value = uniform_values_[location];
+  if (value.size() == length && std::memcmp(value.data(), data, length) == 0) {
+    state.RecordElidedCall();
+    return false;
   }
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  value.assign(bytes, bytes + length);
   return true;
 }
 
@@ -227,6 +240,7 @@ const std::vector<GLint>& BufferBindingsGLES::ComputeUniformLocations(
 }
 
 bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
+                                           StateTrackerGLES& state,
                                            Allocator& transients_allocator,
                                            const BufferResource& buffer) {
   const auto* metadata = buffer.GetMetadata();
@@ -277,6 +291,11 @@ bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
           reinterpret_cast<const GLfloat*>(array_element_buffer.data());
     }
 
+    if (!UpdateUniformValue(state, location, buffer_data,
+                            member.size * element_count)) {
+      continue;
+    }
+
     switch (member.type) {
       case ShaderType::kFloat:
         switch (member.size) {
@@ -340,6 +359,7 @@ bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
 
 std::optional<size_t> BufferBindingsGLES::BindTextures(
     const ProcTableGLES& gl,
+    StateTrackerGLES& state,
     const Bindings& bindings,
     ShaderStage stage,
     size_t unit_start_index) {
@@ -385,7 +405,10 @@ std::optional<size_t> BufferBindingsGLES::BindTextures(
     //--------------------------------------------------------------------------
     /// Set the texture uniform location.
     ///
-    gl.Uniform1i(location, active_index);
+    const GLint unit = active_index;
+    if (UpdateUniformValue(state, location, &unit, sizeof(unit))) {
+      gl.Uniform1i(location, unit);
+    }
 
     //--------------------------------------------------------------------------
     /// Bump up the active index at binding.
@@ -12,6 +12,7 @@
 #include "impeller/core/shader_types.h"
 #include "impeller/renderer/backend/gles/gles.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "impeller/renderer/backend/gles/state_tracker_gles.h"
 #include "impeller/renderer/command.h"
 
 namespace impeller {
@@ -34,15 +35,15 @@ class BufferBindingsGLES {
   bool ReadUniformsBindings(const ProcTableGLES& gl, GLuint program);
 
   bool BindVertexAttributes(const ProcTableGLES& gl,
+                            StateTrackerGLES& state,
                             size_t vertex_offset) const;
 
   bool BindUniformData(const ProcTableGLES& gl,
+                       StateTrackerGLES& state,
                        Allocator& transients_allocator,
                        const Bindings& vertex_bindings,
                        const Bindings& fragment_bindings);
 
-  bool UnbindVertexAttributes(const ProcTableGLES& gl) const;
-
  private:
   //----------------------------------------------------------------------------
   /// @brief      The arguments to glVertexAttribPointer.
@@ -56,22 +57,40 @@ class BufferBindingsGLES {
     GLsizei offset = 0u;
   };
   std::vector<VertexAttribPointer> vertex_attrib_arrays_;
+  std::vector<GLuint> vertex_attrib_indices_;
 
   std::unordered_map<std::string, GLint> uniform_locations_;
 
   using BindingMap = std::unordered_map<std::string, std::vector<GLint>>;
   BindingMap binding_map_ = {};
 
+  // The last values uploaded to each uniform location of the program. Uniform
+  // values are program state and survive across passes and contexts.
+  std::unordered_map<GLint, std::vector<uint8_t>> uniform_values_;
+
   const std::vector<GLint>& ComputeUniformLocations(
       const ShaderMetadata* metadata);
 
   GLint ComputeTextureLocation(const ShaderMetadata* metadata);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Records the value about to be uploaded to a uniform location.
+  ///
+  /// @return     Whether the value differs from the last upload and must be
+  ///             uploaded.
+  ///
+  bool UpdateUniformValue(StateTrackerGLES& state,
+                          GLint location,
+                          const void* data,
+                          size_t length);
+
   bool BindUniformBuffer(const ProcTableGLES& gl,
+                         StateTrackerGLES& state,
                          Allocator& transients_allocator,
                          const BufferResource& buffer);
 
   std::optional<size_t> BindTextures(const ProcTableGLES& gl,
+                                     StateTrackerGLES& state,
                                      const Bindings& bindings,
                                      ShaderStage stage,
                                      size_t unit_start_index = 0);
@@ -15,15 +15,17 @@ namespace impeller {
 std::shared_ptr<ContextGLES> ContextGLES::Create(
     std::unique_ptr<ProcTableGLES> gl,
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
-    bool enable_gpu_tracing) {
-  return std::shared_ptr<ContextGLES>(
-      new ContextGLES(std::move(gl), shader_libraries, enable_gpu_tracing));
+    bool enable_gpu_tracing,
+    const fml::UniqueFD& cache_directory) {
+  return std::shared_ptr<ContextGLES>(new ContextGLES(
+      std::move(gl), shader_libraries, enable_gpu_tracing, cache_directory));
 }
 
 ContextGLES::ContextGLES(
     std::unique_ptr<ProcTableGLES> gl,
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_mappings,
-    bool enable_gpu_tracing) {
+    bool enable_gpu_tracing,
+    const fml::UniqueFD& cache_directory) {
   reactor_ = std::make_shared<ReactorGLES>(std::move(gl));
   if (!reactor_->IsValid()) {
     VALIDATION_LOG << "Could not create valid reactor.";
@@ -43,8 +45,8 @@ ContextGLES::ContextGLES(
 
   // Create the pipeline library.
   {
-    pipeline_library_ =
-        std::shared_ptr<PipelineLibraryGLES>(new PipelineLibraryGLES(reactor_));
+    pipeline_library_ = std::shared_ptr<PipelineLibraryGLES>(
+        new PipelineLibraryGLES(reactor_, cache_directory, GetBackendStats()));
   }
 
   // Create allocators.
@@ -55,6 +57,7 @@ ContextGLES::ContextGLES(
       VALIDATION_LOG << "Could not create a resource allocator.";
       return;
     }
+    resource_allocator_->SetBackendStats(GetBackendStats());
   }
 
   device_capabilities_ = reactor_->GetProcTable().GetCapabilities();
@@ -95,6 +98,12 @@ bool ContextGLES::RemoveReactorWorker(ReactorGLES::WorkerID id) {
   return reactor_->RemoveWorker(id);
 }
 
+void ContextGLES::SetGPUFrameTimeCallback(GPUFrameTimeCallback callback) {
+  if (gpu_tracer_) {
+    gpu_tracer_->SetFrameTimeCallback(std::move(callback));
+  }
+}
+
 bool ContextGLES::IsValid() const {
   return is_valid_;
 }
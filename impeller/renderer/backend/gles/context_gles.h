@@ -28,7 +28,8 @@ class ContextGLES final : public Context,
   static std::shared_ptr<ContextGLES> Create(
       std::unique_ptr<ProcTableGLES> gl,
       const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
-      bool enable_gpu_tracing);
+      bool enable_gpu_tracing,
+      const fml::UniqueFD& cache_directory = {});
 
   // |Context|
   ~ContextGLES() override;
@@ -45,6 +46,9 @@ class ContextGLES final : public Context,
 
   std::shared_ptr<GPUTracerGLES> GetGPUTracer() const { return gpu_tracer_; }
 
+  // |Context|
+  void SetGPUFrameTimeCallback(GPUFrameTimeCallback callback) override;
+
  private:
   ReactorGLES::Ref reactor_;
   std::shared_ptr<ShaderLibraryGLES> shader_library_;
@@ -62,7 +66,8 @@ class ContextGLES final : public Context,
   ContextGLES(
       std::unique_ptr<ProcTableGLES> gl,
       const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
-      bool enable_gpu_tracing);
+      bool enable_gpu_tracing,
+      const fml::UniqueFD& cache_directory);
 
   // |Context|
   std::string DescribeGpuModel() const override;
@@ -38,6 +38,12 @@ uint8_t* DeviceBufferGLES::OnGetContents() const {
   return backing_store_->GetBuffer();
 }
 
+// |DeviceBuffer|
+void DeviceBufferGLES::Flush(std::optional<Range> range) const {
+  // The backing store is uploaded in its entirety when it is next bound.
+  ++generation_;
+}
+
 // |DeviceBuffer|
 bool DeviceBufferGLES::OnCopyHostBuffer(const uint8_t* source,
                                         Range source_range,
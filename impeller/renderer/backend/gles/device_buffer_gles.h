@@ -49,6 +49,9 @@ class DeviceBufferGLES final
   // |DeviceBuffer|
   uint8_t* OnGetContents() const override;
 
+  // |DeviceBuffer|
+  void Flush(std::optional<Range> range) const override;
+
   // |DeviceBuffer|
   bool OnCopyHostBuffer(const uint8_t* source,
                         Range source_range,
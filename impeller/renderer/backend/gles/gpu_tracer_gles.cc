@@ -33,6 +33,7 @@ void GPUTracerGLES::MarkFrameStart(const ProcTableGLES& gl) {
   }
 
   active_frame_ = query;
+  active_frame_start_ = fml::TimePoint::Now();
   gl.BeginQueryEXT(GL_TIME_ELAPSED_EXT, query);
 }
 
@@ -45,7 +46,7 @@ void GPUTracerGLES::ProcessQueries(const ProcTableGLES& gl) {
   // one query object per frame causes crashes on a Pixel 6 pro.
   // It does not crash on an S10.
   while (!pending_traces_.empty()) {
-    auto query = pending_traces_.front();
+    auto query = pending_traces_.front().query;
 
     // First check if the query is complete without blocking
     // on the result. Incomplete results are left in the pending
@@ -63,6 +64,11 @@ void GPUTracerGLES::ProcessQueries(const ProcTableGLES& gl) {
     uint64_t duration = 0;
     gl.GetQueryObjectui64vEXT(query, GL_QUERY_RESULT_EXT, &duration);
     auto gpu_ms = duration / 1000000.0;
+    auto gpu_time = fml::TimeDelta::FromNanoseconds(duration);
+    total_gpu_time_ = total_gpu_time_ + gpu_time;
+    if (frame_time_callback_) {
+      frame_time_callback_(pending_traces_.front().frame_start, gpu_time);
+    }
 
     FML_TRACE_COUNTER("flutter", "GPUTracer",
                       reinterpret_cast<int64_t>(this),  // Trace Counter ID
@@ -81,8 +87,17 @@ void GPUTracerGLES::MarkFrameEnd(const ProcTableGLES& gl) {
   auto query = active_frame_.value();
   gl.EndQueryEXT(GL_TIME_ELAPSED_EXT);
 
-  pending_traces_.push_back(query);
+  pending_traces_.push_back({query, active_frame_start_});
   active_frame_ = std::nullopt;
 }
 
+fml::TimeDelta GPUTracerGLES::GetTotalGPUTime() const {
+  return total_gpu_time_;
+}
+
+void GPUTracerGLES::SetFrameTimeCallback(
+    Context::GPUFrameTimeCallback callback) {
+  frame_time_callback_ = std::move(callback);
+}
+
 }  // namespace impeller
@@ -9,7 +9,9 @@
 #include <deque>
 #include <thread>
 
+#include "flutter/fml/time/time_delta.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "impeller/renderer/context.h"
 
 namespace impeller {
 
@@ -40,12 +42,28 @@ class GPUTracerGLES {
   /// @brief Record the end of a frame workload.
   void MarkFrameEnd(const ProcTableGLES& gl);
 
+  /// @brief The GPU time of all the frame workloads whose queries have been
+  ///        processed so far.
+  fml::TimeDelta GetTotalGPUTime() const;
+
+  /// @brief Set the callback that receives the GPU time of each frame
+  ///        workload. It is invoked on the raster thread.
+  void SetFrameTimeCallback(Context::GPUFrameTimeCallback callback);
+
  private:
+  struct PendingTrace {
+    uint32_t query = 0;
+    fml::TimePoint frame_start;
+  };
+
   void ProcessQueries(const ProcTableGLES& gl);
 
-  std::deque<uint32_t> pending_traces_;
+  std::deque<PendingTrace> pending_traces_;
   std::optional<uint32_t> active_frame_ = std::nullopt;
+  fml::TimePoint active_frame_start_;
   std::thread::id raster_thread_;
+  Context::GPUFrameTimeCallback frame_time_callback_;
+  fml::TimeDelta total_gpu_time_;
 
   bool enabled_ = false;
 };
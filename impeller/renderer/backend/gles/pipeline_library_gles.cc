@@ -4,10 +4,16 @@
 
 #include "impeller/renderer/backend/gles/pipeline_library_gles.h"
 
+#include <cstring>
 #include <sstream>
 #include <string>
+#include <string_view>
 
 #include "flutter/fml/container.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/trace_event.h"
 #include "fml/closure.h"
 #include "impeller/base/promise.h"
@@ -16,8 +22,123 @@
 
 namespace impeller {
 
-PipelineLibraryGLES::PipelineLibraryGLES(ReactorGLES::Ref reactor)
-    : reactor_(std::move(reactor)) {}
+static constexpr const char* kProgramCacheDirectoryName =
+    "impeller_gles_programs";
+
+// Precedes the driver specific program binary in each cache file.
+struct ProgramCacheHeader {
+  static constexpr uint32_t kMagic = 0x49505247;  // "IPRG"
+  static constexpr uint32_t kVersion = 1u;
+
+  uint32_t magic = kMagic;
+  uint32_t version = kVersion;
+  uint32_t binary_format = GL_NONE;
+  uint32_t binary_length = 0u;
+};
+
+PipelineLibraryGLES::PipelineLibraryGLES(
+    ReactorGLES::Ref reactor,
+    const fml::UniqueFD& cache_directory,
+    std::shared_ptr<BackendStats> backend_stats)
+    : reactor_(std::move(reactor)), backend_stats_(std::move(backend_stats)) {
+  if (!reactor_ || !cache_directory.is_valid()) {
+    return;
+  }
+  driver_description_ = reactor_->GetProcTable().GetDescription()->GetString();
+  // Binaries are only loadable by the driver that created them.
+  PipelineCacheStore::Settings store_settings;
+  store_settings.version = driver_description_;
+  program_cache_ = PipelineCacheStore::Create(
+      fml::CreateDirectory(cache_directory, {kProgramCacheDirectoryName},
+                           fml::FilePermission::kReadWrite),
+      std::move(store_settings));
+}
+
+static bool CanCacheProgramBinaries(const ProcTableGLES& gl) {
+  if (!gl.GetProgramBinary.IsAvailable() || !gl.ProgramBinary.IsAvailable() ||
+      !gl.ProgramParameteri.IsAvailable()) {
+    return false;
+  }
+  GLint format_count = 0;
+  gl.GetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+  return format_count > 0;
+}
+
+static std::string GetProgramCacheFileName(
+    const PipelineDescriptor& descriptor,
+    const fml::Mapping& vert_mapping,
+    const fml::Mapping& frag_mapping,
+    const std::string& driver_description) {
+  auto to_string_view = [](const fml::Mapping& mapping) {
+    return std::string_view{reinterpret_cast<const char*>(mapping.GetMapping()),
+                            mapping.GetSize()};
+  };
+  auto hash = fml::HashCombine(to_string_view(vert_mapping),
+                               to_string_view(frag_mapping),
+                               std::string_view{driver_description});
+  for (const auto& constant : descriptor.GetSpecializationConstants()) {
+    fml::HashCombineSeed(hash, constant);
+  }
+  for (const auto& stage_input :
+       descriptor.GetVertexDescriptor()->GetStageInputs()) {
+    fml::HashCombineSeed(hash, std::string_view{stage_input.name},
+                         stage_input.location);
+  }
+  return SPrintF("%016zx.bin", hash);
+}
+
+static bool LoadCachedProgram(const ProcTableGLES& gl,
+                              GLuint program,
+                              PipelineCacheStore& program_cache,
+                              const std::string& file_name) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  auto mapping = program_cache.Load(file_name);
+  if (!mapping || mapping->GetSize() < sizeof(ProgramCacheHeader)) {
+    return false;
+  }
+  ProgramCacheHeader header;
+  std::memcpy(&header, mapping->GetMapping(), sizeof(header));
+  if (header.magic != ProgramCacheHeader::kMagic ||
+      header.version != ProgramCacheHeader::kVersion ||
+      header.binary_length != mapping->GetSize() - sizeof(header)) {
+    return false;
+  }
+  gl.ProgramBinary(program, header.binary_format,
+                   mapping->GetMapping() + sizeof(header),
+                   header.binary_length);
+  // The driver may reject binaries it produced itself, for instance after an
+  // update. This is not an error, the program is linked from source instead.
+  GLint link_status = GL_FALSE;
+  gl.GetProgramiv(program, GL_LINK_STATUS, &link_status);
+  return link_status == GL_TRUE;
+}
+
+static void StoreCachedProgram(const ProcTableGLES& gl,
+                               GLuint program,
+                               PipelineCacheStore& program_cache,
+                               const std::string& file_name) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  GLint binary_length = 0;
+  gl.GetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_length);
+  if (binary_length <= 0) {
+    return;
+  }
+  std::vector<uint8_t> data(sizeof(ProgramCacheHeader) + binary_length);
+  ProgramCacheHeader header;
+  GLenum binary_format = GL_NONE;
+  GLsizei written_length = 0;
+  gl.GetProgramBinary(program, binary_length, &written_length, &binary_format,
+                      data.data() + sizeof(header));
+  if (written_length <= 0) {
+    return;
+  }
+  header.binary_format = binary_format;
+  header.binary_length = written_length;
+  std::memcpy(data.data(), &header, sizeof(header));
+  data.resize(sizeof(header) + written_length);
+  program_cache.Store(file_name,
+                      std::make_shared<fml::DataMapping>(std::move(data)));
+}
 
 static std::string GetShaderInfoLog(const ProcTableGLES& gl, GLuint shader) {
   GLint log_length = 0;
@@ -78,7 +199,9 @@ static bool LinkProgram(
     const ReactorGLES& reactor,
     const std::shared_ptr<PipelineGLES>& pipeline,
     const std::shared_ptr<const ShaderFunction>& vert_function,
-    const std::shared_ptr<const ShaderFunction>& frag_function) {
+    const std::shared_ptr<const ShaderFunction>& frag_function,
+    const std::shared_ptr<PipelineCacheStore>& program_cache,
+    const std::string& driver_description) {
   TRACE_EVENT0("impeller", __FUNCTION__);
 
   const auto& descriptor = pipeline->GetDescriptor();
@@ -90,6 +213,22 @@ static bool LinkProgram(
 
   const auto& gl = reactor.GetProcTable();
 
+  const auto cache_programs =
+      program_cache != nullptr && CanCacheProgramBinaries(gl);
+  std::string cache_file_name;
+  if (cache_programs) {
+    auto program = reactor.GetGLHandle(pipeline->GetProgramHandle());
+    if (!program.has_value()) {
+      VALIDATION_LOG << "Could not get program handle from reactor.";
+      return false;
+    }
+    cache_file_name = GetProgramCacheFileName(
+        descriptor, *vert_mapping, *frag_mapping, driver_description);
+    if (LoadCachedProgram(gl, *program, *program_cache, cache_file_name)) {
+      return true;
+    }
+  }
+
   auto vert_shader = gl.CreateShader(GL_VERTEX_SHADER);
   auto frag_shader = gl.CreateShader(GL_FRAGMENT_SHADER);
 
@@ -161,6 +300,11 @@ static bool LinkProgram(
     );
   }
 
+  if (cache_programs) {
+    gl.ProgramParameteri(*program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT,
+                         GL_TRUE);
+  }
+
   gl.LinkProgram(*program);
 
   GLint link_status = GL_FALSE;
@@ -171,6 +315,10 @@ static bool LinkProgram(
                    << gl.GetProgramInfoLogString(*program);
     return false;
   }
+
+  if (cache_programs) {
+    StoreCachedProgram(gl, *program, *program_cache, cache_file_name);
+  }
   return true;
 }
 
@@ -182,6 +330,7 @@ bool PipelineLibraryGLES::IsValid() const {
 // |PipelineLibrary|
 PipelineFuture<PipelineDescriptor> PipelineLibraryGLES::GetPipeline(
     PipelineDescriptor descriptor) {
+  Lock lock(pipelines_mutex_);
   if (auto found = pipelines_.find(descriptor); found != pipelines_.end()) {
     return found->second;
   }
@@ -228,16 +377,20 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryGLES::GetPipeline(
           VALIDATION_LOG << "Could not obtain program handle.";
           return;
         }
-        const auto link_result = LinkProgram(reactor,        //
-                                             pipeline,       //
-                                             vert_function,  //
-                                             frag_function   //
-        );
+        const auto link_result =
+            LinkProgram(reactor,                          //
+                        pipeline,                         //
+                        vert_function,                    //
+                        frag_function,                    //
+                        strong_this->program_cache_,      //
+                        strong_this->driver_description_  //
+            );
         if (!link_result) {
           promise->set_value(nullptr);
           VALIDATION_LOG << "Could not link pipeline program.";
           return;
         }
+        strong_this->backend_stats_->Record(BackendObject::kPipeline);
         if (!pipeline->BuildVertexDescriptor(reactor.GetProcTable(),
                                              program.value())) {
           promise->set_value(nullptr);
@@ -269,6 +422,7 @@ PipelineFuture<ComputePipelineDescriptor> PipelineLibraryGLES::GetPipeline(
 // |PipelineLibrary|
 void PipelineLibraryGLES::RemovePipelinesWithEntryPoint(
     std::shared_ptr<const ShaderFunction> function) {
+  Lock lock(pipelines_mutex_);
   fml::erase_if(pipelines_, [&](auto item) {
     return item->first.GetEntrypointForStage(function->GetStage())
         ->IsEqual(*function);
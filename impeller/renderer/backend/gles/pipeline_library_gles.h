@@ -6,7 +6,11 @@
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PIPELINE_LIBRARY_GLES_H_
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/base/thread.h"
+#include "impeller/core/backend_stats.h"
 #include "impeller/renderer/backend/gles/reactor_gles.h"
+#include "impeller/renderer/pipeline_cache_store.h"
 #include "impeller/renderer/pipeline_library.h"
 
 namespace impeller {
@@ -22,9 +26,19 @@ class PipelineLibraryGLES final : public PipelineLibrary {
   friend ContextGLES;
 
   ReactorGLES::Ref reactor_;
-  PipelineMap pipelines_;
-
-  explicit PipelineLibraryGLES(ReactorGLES::Ref reactor);
+  Mutex pipelines_mutex_;
+  PipelineMap pipelines_ IPLR_GUARDED_BY(pipelines_mutex_);
+  // The store linked program binaries are cached in. Null if program binaries
+  // are not cached. The GLES backend has no worker task runner, so entries are
+  // written on the reactor thread.
+  std::shared_ptr<PipelineCacheStore> program_cache_;
+  // Identifies the driver the cached program binaries were created by.
+  std::string driver_description_;
+  std::shared_ptr<BackendStats> backend_stats_;
+
+  PipelineLibraryGLES(ReactorGLES::Ref reactor,
+                      const fml::UniqueFD& cache_directory,
+                      std::shared_ptr<BackendStats> backend_stats);
 
   // |PipelineLibrary|
   bool IsValid() const override;
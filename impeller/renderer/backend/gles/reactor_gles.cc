@@ -12,6 +12,13 @@
 
 namespace impeller {
 
+// The number of OpenGL names generated at once when a handle pool runs dry.
+static constexpr size_t kHandlePoolBatchSize = 32u;
+
+// The number of collected handles after which they are deleted without waiting
+// for the next frame.
+static constexpr size_t kMaxPendingCollections = 64u;
+
 ReactorGLES::ReactorGLES(std::unique_ptr<ProcTableGLES> gl)
     : proc_table_(std::move(gl)) {
   if (!proc_table_ || !proc_table_->IsValid()) {
@@ -22,7 +29,20 @@ ReactorGLES::ReactorGLES(std::unique_ptr<ProcTableGLES> gl)
   is_valid_ = true;
 }
 
-ReactorGLES::~ReactorGLES() = default;
+static void DeleteGLHandles(const ProcTableGLES& gl,
+                            HandleType type,
+                            const std::vector<GLuint>& names);
+
+ReactorGLES::~ReactorGLES() {
+  if (!IsValid() || !CanReactOnCurrentThread()) {
+    return;
+  }
+  WriterLock handles_lock(handles_mutex_);
+  for (const auto& [type, names] : handle_pool_) {
+    DeleteGLHandles(GetProcTable(), type, names);
+  }
+  handle_pool_.clear();
+}
 
 bool ReactorGLES::IsValid() const {
   return is_valid_;
@@ -76,58 +96,117 @@ bool ReactorGLES::AddOperation(Operation operation) {
     Lock ops_lock(ops_mutex_);
     ops_.emplace_back(std::move(operation));
   }
+  frame_operations_++;
   // Attempt a reaction if able but it is not an error if this isn't possible.
   [[maybe_unused]] auto result = React();
   return true;
 }
 
-static std::optional<GLuint> CreateGLHandle(const ProcTableGLES& gl,
-                                            HandleType type) {
-  GLuint handle = GL_NONE;
+static bool GenerateGLHandles(const ProcTableGLES& gl,
+                              HandleType type,
+                              std::vector<GLuint>& names) {
+  if (names.empty()) {
+    return true;
+  }
+  const auto count = static_cast<GLsizei>(names.size());
   switch (type) {
     case HandleType::kUnknown:
-      return std::nullopt;
+    case HandleType::kProgram:
+      return false;
     case HandleType::kTexture:
-      gl.GenTextures(1u, &handle);
-      return handle;
+      gl.GenTextures(count, names.data());
+      return true;
     case HandleType::kBuffer:
-      gl.GenBuffers(1u, &handle);
-      return handle;
-    case HandleType::kProgram:
-      return gl.CreateProgram();
+      gl.GenBuffers(count, names.data());
+      return true;
     case HandleType::kRenderBuffer:
-      gl.GenRenderbuffers(1u, &handle);
-      return handle;
+      gl.GenRenderbuffers(count, names.data());
+      return true;
     case HandleType::kFrameBuffer:
-      gl.GenFramebuffers(1u, &handle);
-      return handle;
+      gl.GenFramebuffers(count, names.data());
+      return true;
   }
-  return std::nullopt;
+  return false;
 }
 
-static bool CollectGLHandle(const ProcTableGLES& gl,
+static void DeleteGLHandles(const ProcTableGLES& gl,
                             HandleType type,
-                            GLuint handle) {
+                            const std::vector<GLuint>& names) {
+  if (names.empty()) {
+    return;
+  }
+  const auto count = static_cast<GLsizei>(names.size());
   switch (type) {
     case HandleType::kUnknown:
-      return false;
+      return;
     case HandleType::kTexture:
-      gl.DeleteTextures(1u, &handle);
-      return true;
+      gl.DeleteTextures(count, names.data());
+      return;
     case HandleType::kBuffer:
-      gl.DeleteBuffers(1u, &handle);
-      return true;
+      gl.DeleteBuffers(count, names.data());
+      return;
     case HandleType::kProgram:
-      gl.DeleteProgram(handle);
-      return true;
+      // Programs can only be deleted one at a time.
+      for (auto name : names) {
+        gl.DeleteProgram(name);
+      }
+      return;
     case HandleType::kRenderBuffer:
-      gl.DeleteRenderbuffers(1u, &handle);
-      return true;
+      gl.DeleteRenderbuffers(count, names.data());
+      return;
     case HandleType::kFrameBuffer:
-      gl.DeleteFramebuffers(1u, &handle);
-      return true;
+      gl.DeleteFramebuffers(count, names.data());
+      return;
+  }
+}
+
+std::optional<GLuint> ReactorGLES::TakeGLHandle(HandleType type) {
+  const auto& gl = GetProcTable();
+  switch (type) {
+    case HandleType::kUnknown:
+      return std::nullopt;
+    case HandleType::kProgram:
+      // Programs can't be generated ahead of time.
+      frame_gen_calls_++;
+      return gl.CreateProgram();
+    case HandleType::kTexture:
+    case HandleType::kBuffer:
+    case HandleType::kRenderBuffer:
+    case HandleType::kFrameBuffer:
+      break;
+  }
+  auto& pool = handle_pool_[type];
+  if (pool.empty()) {
+    pool.resize(kHandlePoolBatchSize, GL_NONE);
+    if (!GenerateGLHandles(gl, type, pool)) {
+      pool.clear();
+      return std::nullopt;
+    }
+    frame_gen_calls_++;
+  }
+  auto name = pool.back();
+  pool.pop_back();
+  return name;
+}
+
+void ReactorGLES::CollectHandles(const std::vector<HandleGLES>& handles) {
+  std::unordered_map<HandleType, std::vector<GLuint>> names_by_type;
+  for (const auto& handle : handles) {
+    auto found = handles_.find(handle);
+    if (found == handles_.end()) {
+      continue;
+    }
+    // This could be false if the handle was created and collected without
+    // use. We still need to get rid of map entry.
+    if (found->second.name.has_value()) {
+      names_by_type[handle.type].push_back(found->second.name.value());
+    }
+    handles_.erase(found);
+  }
+  for (const auto& [type, names] : names_by_type) {
+    DeleteGLHandles(GetProcTable(), type, names);
+    frame_delete_calls_ += type == HandleType::kProgram ? names.size() : 1u;
   }
-  return false;
 }
 
 HandleGLES ReactorGLES::CreateHandle(HandleType type) {
@@ -138,26 +217,49 @@ HandleGLES ReactorGLES::CreateHandle(HandleType type) {
   if (new_handle.IsDead()) {
     return HandleGLES::DeadHandle();
   }
+  const auto can_react = CanReactOnCurrentThread();
   WriterLock handles_lock(handles_mutex_);
-  auto gl_handle = CanReactOnCurrentThread()
-                       ? CreateGLHandle(GetProcTable(), type)
-                       : std::nullopt;
+  auto gl_handle = can_react ? TakeGLHandle(type) : std::nullopt;
   handles_[new_handle] = LiveHandle{gl_handle};
+  if (!gl_handle.has_value()) {
+    handles_to_create_.push_back(new_handle);
+  }
   return new_handle;
 }
 
 void ReactorGLES::CollectHandle(HandleGLES handle) {
   WriterLock handles_lock(handles_mutex_);
   if (auto found = handles_.find(handle); found != handles_.end()) {
-    found->second.pending_collection = true;
+    if (!found->second.pending_collection) {
+      found->second.pending_collection = true;
+      handles_to_collect_.push_back(handle);
+    }
   }
 }
 
+void ReactorGLES::DidAcquireSurfaceFrame() {
+  FML_TRACE_COUNTER("impeller", "ReactorGLES",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "Reactions", frame_reactions_.exchange(0),
+                    "Operations", frame_operations_.exchange(0),
+                    "GenCalls", frame_gen_calls_.exchange(0),
+                    "DeleteCalls", frame_delete_calls_.exchange(0),
+                    "ElidedCalls", frame_elided_calls_.exchange(0));
+  WriterLock handles_lock(handles_mutex_);
+  has_frame_boundaries_ = true;
+  flush_collected_handles_ = true;
+}
+
+void ReactorGLES::RecordElidedCalls(size_t count) const {
+  frame_elided_calls_ += count;
+}
+
 bool ReactorGLES::React() {
   if (!CanReactOnCurrentThread()) {
     return false;
   }
   TRACE_EVENT0("impeller", "ReactorGLES::React");
+  frame_reactions_++;
   while (HasPendingOperations()) {
     // Both the raster thread and the IO thread can flush queued operations.
     // Ensure that execution of the ops is serialized.
@@ -200,39 +302,50 @@ bool ReactorGLES::ConsolidateHandles() {
   TRACE_EVENT0("impeller", __FUNCTION__);
   const auto& gl = GetProcTable();
   WriterLock handles_lock(handles_mutex_);
-  std::vector<HandleGLES> handles_to_delete;
-  for (auto& handle : handles_) {
-    // Collect dead handles.
-    if (handle.second.pending_collection) {
-      // This could be false if the handle was created and collected without
-      // use. We still need to get rid of map entry.
-      if (handle.second.name.has_value()) {
-        CollectGLHandle(gl, handle.first.type, handle.second.name.value());
-      }
-      handles_to_delete.push_back(handle.first);
+
+  // Collect dead handles. Until the first frame is reported, there is no frame
+  // boundary to wait for and handles are collected on every reaction.
+  if (!has_frame_boundaries_ || flush_collected_handles_ ||
+      handles_to_collect_.size() >= kMaxPendingCollections) {
+    CollectHandles(handles_to_collect_);
+    handles_to_collect_.clear();
+    flush_collected_handles_ = false;
+  }
+
+  // Create live handles.
+  for (const auto& handle : handles_to_create_) {
+    auto found = handles_.find(handle);
+    if (found == handles_.end() || found->second.pending_collection ||
+        found->second.name.has_value()) {
       continue;
     }
-    // Create live handles.
-    if (!handle.second.name.has_value()) {
-      auto gl_handle = CreateGLHandle(gl, handle.first.type);
-      if (!gl_handle) {
-        VALIDATION_LOG << "Could not create GL handle.";
-        return false;
-      }
-      handle.second.name = gl_handle;
-    }
-    // Set pending debug labels.
-    if (handle.second.pending_debug_label.has_value()) {
-      if (gl.SetDebugLabel(ToDebugResourceType(handle.first.type),
-                           handle.second.name.value(),
-                           handle.second.pending_debug_label.value())) {
-        handle.second.pending_debug_label = std::nullopt;
-      }
+    auto gl_handle = TakeGLHandle(handle.type);
+    if (!gl_handle) {
+      VALIDATION_LOG << "Could not create GL handle.";
+      return false;
     }
+    found->second.name = gl_handle;
   }
-  for (const auto& handle_to_delete : handles_to_delete) {
-    handles_.erase(handle_to_delete);
+  handles_to_create_.clear();
+
+  // Set pending debug labels.
+  std::vector<HandleGLES> unlabeled_handles;
+  for (const auto& handle : handles_to_label_) {
+    auto found = handles_.find(handle);
+    if (found == handles_.end() || found->second.pending_collection ||
+        !found->second.pending_debug_label.has_value()) {
+      continue;
+    }
+    if (!found->second.name.has_value() ||
+        !gl.SetDebugLabel(ToDebugResourceType(handle.type),
+                          found->second.name.value(),
+                          found->second.pending_debug_label.value())) {
+      unlabeled_handles.push_back(handle);
+      continue;
+    }
+    found->second.pending_debug_label = std::nullopt;
   }
+  handles_to_label_ = std::move(unlabeled_handles);
   return true;
 }
 
@@ -280,6 +393,9 @@ void ReactorGLES::SetDebugLabel(const HandleGLES& handle, std::string label) {
   }
   WriterLock handles_lock(handles_mutex_);
   if (auto found = handles_.find(handle); found != handles_.end()) {
+    if (!found->second.pending_debug_label.has_value()) {
+      handles_to_label_.push_back(handle);
+    }
     found->second.pending_debug_label = std::move(label);
   }
 }
@@ -5,8 +5,10 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_REACTOR_GLES_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_REACTOR_GLES_H_
 
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -53,6 +55,10 @@ namespace impeller {
 ///             reactor handle means that the OpenGL handle will be deleted at
 ///             some point in the near future.
 ///
+///             To keep the number of driver calls down, OpenGL names are
+///             generated in batches ahead of time and deleted in batches once
+///             per frame, or earlier if many handles are pending collection.
+///
 class ReactorGLES {
  public:
   using WorkerID = UniqueID;
@@ -219,6 +225,27 @@ class ReactorGLES {
   ///
   [[nodiscard]] bool React();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Called when a new onscreen frame is acquired. Reports the
+  ///             reactor statistics of the previous frame as trace counters
+  ///             and flushes the handles collected during that frame on the
+  ///             next reaction.
+  ///
+  ///             This can be called on any thread.
+  ///
+  void DidAcquireSurfaceFrame();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records OpenGL calls that operations skipped because they
+  ///             would not have changed any state. These are reported along
+  ///             with the other per-frame reactor statistics.
+  ///
+  ///             This can be called on any thread.
+  ///
+  /// @param[in]  count  The number of elided calls.
+  ///
+  void RecordElidedCalls(size_t count) const;
+
  private:
   struct LiveHandle {
     std::optional<GLuint> name;
@@ -246,6 +273,23 @@ class ReactorGLES {
                                          HandleGLES::Equal>;
   mutable RWMutex handles_mutex_;
   LiveHandles handles_ IPLR_GUARDED_BY(handles_mutex_);
+  // Handles that need work in the next reaction. Tracked separately so that
+  // reactions don't have to visit every live handle.
+  std::vector<HandleGLES> handles_to_create_ IPLR_GUARDED_BY(handles_mutex_);
+  std::vector<HandleGLES> handles_to_collect_ IPLR_GUARDED_BY(handles_mutex_);
+  std::vector<HandleGLES> handles_to_label_ IPLR_GUARDED_BY(handles_mutex_);
+  bool has_frame_boundaries_ IPLR_GUARDED_BY(handles_mutex_) = false;
+  bool flush_collected_handles_ IPLR_GUARDED_BY(handles_mutex_) = false;
+  // OpenGL names generated ahead of time, by handle type.
+  std::unordered_map<HandleType, std::vector<GLuint>> handle_pool_
+      IPLR_GUARDED_BY(handles_mutex_);
+
+  // Statistics of the current frame, reported as trace counters.
+  std::atomic<int64_t> frame_reactions_ = 0;
+  std::atomic<int64_t> frame_operations_ = 0;
+  std::atomic<int64_t> frame_gen_calls_ = 0;
+  std::atomic<int64_t> frame_delete_calls_ = 0;
+  mutable std::atomic<int64_t> frame_elided_calls_ = 0;
 
   mutable Mutex workers_mutex_;
   mutable std::map<WorkerID, std::weak_ptr<Worker>> workers_
@@ -262,6 +306,12 @@ class ReactorGLES {
 
   bool ConsolidateHandles();
 
+  std::optional<GLuint> TakeGLHandle(HandleType type)
+      IPLR_REQUIRES(handles_mutex_);
+
+  void CollectHandles(const std::vector<HandleGLES>& handles)
+      IPLR_REQUIRES(handles_mutex_);
+
   bool FlushOps();
 
   void SetupDebugGroups();
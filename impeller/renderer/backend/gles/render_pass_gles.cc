@@ -17,6 +17,7 @@
 #include "impeller/renderer/backend/gles/formats_gles.h"
 #include "impeller/renderer/backend/gles/gpu_tracer_gles.h"
 #include "impeller/renderer/backend/gles/pipeline_gles.h"
+#include "impeller/renderer/backend/gles/state_tracker_gles.h"
 #include "impeller/renderer/backend/gles/texture_gles.h"
 
 namespace impeller {
@@ -41,7 +42,7 @@ void RenderPassGLES::OnSetLabel(std::string label) {
   label_ = std::move(label);
 }
 
-void ConfigureBlending(const ProcTableGLES& gl,
+void ConfigureBlending(StateTrackerGLES& gl,
                        const ColorAttachmentDescriptor* color) {
   if (color->blending_enabled) {
     gl.Enable(GL_BLEND);
@@ -77,7 +78,7 @@ void ConfigureBlending(const ProcTableGLES& gl,
 }
 
 void ConfigureStencil(GLenum face,
-                      const ProcTableGLES& gl,
+                      StateTrackerGLES& gl,
                       const StencilAttachmentDescriptor& stencil,
                       uint32_t stencil_reference) {
   gl.StencilOpSeparate(
@@ -94,7 +95,7 @@ void ConfigureStencil(GLenum face,
   gl.StencilMaskSeparate(face, stencil.write_mask);
 }
 
-void ConfigureStencil(const ProcTableGLES& gl,
+void ConfigureStencil(StateTrackerGLES& gl,
                       const PipelineDescriptor& pipeline,
                       uint32_t stencil_reference) {
   if (!pipeline.HasStencilAttachmentDescriptors()) {
@@ -241,12 +242,9 @@ struct RenderPassData {
     clear_bits |= GL_STENCIL_BUFFER_BIT;
   }
 
-  gl.Disable(GL_SCISSOR_TEST);
-  gl.Disable(GL_DEPTH_TEST);
-  gl.Disable(GL_STENCIL_TEST);
-  gl.Disable(GL_CULL_FACE);
-  gl.Disable(GL_BLEND);
-  gl.ColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+  // Redundant state changes for the commands in this pass are skipped.
+  StateTrackerGLES state(gl);
+  state.Reset();
 
   gl.Clear(clear_bits);
 
@@ -284,12 +282,13 @@ struct RenderPassData {
     //--------------------------------------------------------------------------
     /// Configure blending.
     ///
-    ConfigureBlending(gl, color_attachment);
+    ConfigureBlending(state, color_attachment);
 
     //--------------------------------------------------------------------------
     /// Setup stencil.
     ///
-    ConfigureStencil(gl, pipeline.GetDescriptor(), command.stencil_reference);
+    ConfigureStencil(state, pipeline.GetDescriptor(),
+                     command.stencil_reference);
 
     //--------------------------------------------------------------------------
     /// Configure depth.
@@ -297,11 +296,11 @@ struct RenderPassData {
     if (auto depth =
             pipeline.GetDescriptor().GetDepthStencilAttachmentDescriptor();
         depth.has_value()) {
-      gl.Enable(GL_DEPTH_TEST);
-      gl.DepthFunc(ToCompareFunction(depth->depth_compare));
-      gl.DepthMask(depth->depth_write_enabled ? GL_TRUE : GL_FALSE);
+      state.Enable(GL_DEPTH_TEST);
+      state.DepthFunc(ToCompareFunction(depth->depth_compare));
+      state.DepthMask(depth->depth_write_enabled ? GL_TRUE : GL_FALSE);
     } else {
-      gl.Disable(GL_DEPTH_TEST);
+      state.Disable(GL_DEPTH_TEST);
     }
 
     // Both the viewport and scissor are specified in framebuffer coordinates.
@@ -313,18 +312,19 @@ struct RenderPassData {
     /// Setup the viewport.
     ///
     const auto& viewport = command.viewport.value_or(pass_data.viewport);
-    gl.Viewport(viewport.rect.GetX(),  // x
-                target_size.height - viewport.rect.GetY() -
-                    viewport.rect.GetHeight(),  // y
-                viewport.rect.GetWidth(),       // width
-                viewport.rect.GetHeight()       // height
+    state.Viewport(viewport.rect.GetX(),  // x
+                   target_size.height - viewport.rect.GetY() -
+                       viewport.rect.GetHeight(),  // y
+                   viewport.rect.GetWidth(),       // width
+                   viewport.rect.GetHeight()       // height
     );
     if (pass_data.depth_attachment) {
       // TODO(bdero): Desktop GL for Apple requires glDepthRange. glDepthRangef
       //              throws GL_INVALID_OPERATION.
       //              https://github.com/flutter/flutter/issues/136322
 #if !FML_OS_MACOSX
-      gl.DepthRangef(viewport.depth_range.z_near, viewport.depth_range.z_far);
+      state.DepthRangef(viewport.depth_range.z_near,
+                        viewport.depth_range.z_far);
 #endif
     }
 
@@ -333,15 +333,15 @@ struct RenderPassData {
     ///
     if (command.scissor.has_value()) {
       const auto& scissor = command.scissor.value();
-      gl.Enable(GL_SCISSOR_TEST);
-      gl.Scissor(
+      state.Enable(GL_SCISSOR_TEST);
+      state.Scissor(
           scissor.GetX(),                                             // x
           target_size.height - scissor.GetY() - scissor.GetHeight(),  // y
           scissor.GetWidth(),                                         // width
           scissor.GetHeight()                                         // height
       );
     } else {
-      gl.Disable(GL_SCISSOR_TEST);
+      state.Disable(GL_SCISSOR_TEST);
     }
 
     //--------------------------------------------------------------------------
@@ -349,15 +349,15 @@ struct RenderPassData {
     ///
     switch (pipeline.GetDescriptor().GetCullMode()) {
       case CullMode::kNone:
-        gl.Disable(GL_CULL_FACE);
+        state.Disable(GL_CULL_FACE);
         break;
       case CullMode::kFrontFace:
-        gl.Enable(GL_CULL_FACE);
-        gl.CullFace(GL_FRONT);
+        state.Enable(GL_CULL_FACE);
+        state.CullFace(GL_FRONT);
         break;
       case CullMode::kBackFace:
-        gl.Enable(GL_CULL_FACE);
-        gl.CullFace(GL_BACK);
+        state.Enable(GL_CULL_FACE);
+        state.CullFace(GL_BACK);
         break;
     }
     //--------------------------------------------------------------------------
@@ -365,10 +365,10 @@ struct RenderPassData {
     ///
     switch (pipeline.GetDescriptor().GetWindingOrder()) {
       case WindingOrder::kClockwise:
-        gl.FrontFace(GL_CW);
+        state.FrontFace(GL_CW);
         break;
       case WindingOrder::kCounterClockwise:
-        gl.FrontFace(GL_CCW);
+        state.FrontFace(GL_CCW);
         break;
     }
 
@@ -411,7 +411,7 @@ struct RenderPassData {
     /// Bind vertex attribs.
     ///
     if (!vertex_desc_gles->BindVertexAttributes(
-            gl, vertex_buffer_view.range.offset)) {
+            gl, state, vertex_buffer_view.range.offset)) {
       return false;
     }
 
@@ -419,6 +419,7 @@ struct RenderPassData {
     /// Bind uniform data.
     ///
     if (!vertex_desc_gles->BindUniformData(gl,                        //
+                                           state,                     //
                                            *transients_allocator,     //
                                            command.vertex_bindings,   //
                                            command.fragment_bindings  //
@@ -462,13 +463,6 @@ struct RenderPassData {
       );
     }
 
-    //--------------------------------------------------------------------------
-    /// Unbind vertex attribs.
-    ///
-    if (!vertex_desc_gles->UnbindVertexAttributes(gl)) {
-      return false;
-    }
-
     //--------------------------------------------------------------------------
     /// Unbind the program pipeline.
     ///
@@ -477,6 +471,13 @@ struct RenderPassData {
     }
   }
 
+  //----------------------------------------------------------------------------
+  /// Unbind vertex attribs. These are left enabled between commands in case
+  /// the next command uses the same ones.
+  ///
+  state.DisableVertexAttribArrays();
+  reactor.RecordElidedCalls(state.GetElidedCallCount());
+
   if (gl.DiscardFramebufferEXT.IsAvailable()) {
     std::vector<GLenum> attachments;
 
@@ -543,6 +544,10 @@ bool RenderPassGLES::OnEncodeCommands(const Context& context) const {
   pass_data->clear_color_attachment = CanClearAttachment(color0.load_action);
   pass_data->discard_color_attachment =
       CanDiscardAttachmentWhenDone(color0.store_action);
+  // Passes that do not render to the default FBO create their own.
+  if (!TextureGLES::Cast(*color0.texture).IsWrapped()) {
+    context.GetBackendStats()->Record(BackendObject::kFramebuffer);
+  }
 
   // When we are using EXT_multisampled_render_to_texture, it is implicitly
   // resolved when we bind the texture to the framebuffer. We don't need to
@@ -7,6 +7,7 @@
 #include <sstream>
 
 #include "flutter/fml/closure.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/config.h"
 #include "impeller/base/validation.h"
 #include "impeller/renderer/backend/gles/shader_function_gles.h"
@@ -51,21 +52,15 @@ static std::string GLESShaderNameToShaderKeyName(const std::string& name,
 
 ShaderLibraryGLES::ShaderLibraryGLES(
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries) {
-  ShaderFunctionMap functions;
-  auto iterator = [&functions, library_id = library_id_](auto type,           //
-                                                         const auto& name,    //
-                                                         const auto& mapping  //
-                                                         ) -> bool {
+  ShaderCodeMap archived_code;
+  // Functions are created when the shaders are first looked up.
+  auto iterator = [&archived_code](auto type,           //
+                                   const auto& name,    //
+                                   const auto& mapping  //
+                                   ) -> bool {
     const auto stage = ToShaderStage(type);
     const auto key_name = GLESShaderNameToShaderKeyName(name, stage);
-
-    functions[ShaderKey{key_name, stage}] = std::shared_ptr<ShaderFunctionGLES>(
-        new ShaderFunctionGLES(library_id,  //
-                               stage,       //
-                               key_name,    //
-                               mapping      //
-                               ));
-
+    archived_code[ShaderKey{key_name, stage}] = mapping;
     return true;
   };
   for (auto library : shader_libraries) {
@@ -78,7 +73,10 @@ ShaderLibraryGLES::ShaderLibraryGLES(
     gles_archive->IterateAllShaders(iterator);
   }
 
-  functions_ = functions;
+  WriterLock lock(functions_mutex_);
+  archived_count_ = archived_code.size();
+  archived_code_ = std::move(archived_code);
+  TraceFunctionCountsLocked();
   is_valid_ = true;
 }
 
@@ -94,12 +92,33 @@ bool ShaderLibraryGLES::IsValid() const {
 std::shared_ptr<const ShaderFunction> ShaderLibraryGLES::GetFunction(
     std::string_view name,
     ShaderStage stage) {
-  ReaderLock lock(functions_mutex_);
   const auto key = ShaderKey{name, stage};
+  {
+    ReaderLock lock(functions_mutex_);
+    if (auto found = functions_.find(key); found != functions_.end()) {
+      return found->second;
+    }
+  }
+
+  WriterLock lock(functions_mutex_);
   if (auto found = functions_.find(key); found != functions_.end()) {
     return found->second;
   }
-  return nullptr;
+  auto archived = archived_code_.find(key);
+  if (archived == archived_code_.end()) {
+    return nullptr;
+  }
+  auto function = std::shared_ptr<ShaderFunctionGLES>(
+      new ShaderFunctionGLES(library_id_,      //
+                             stage,            //
+                             key.name,         //
+                             archived->second  //
+                             ));
+  archived_code_.erase(archived);
+  functions_[key] = function;
+  instantiated_count_++;
+  TraceFunctionCountsLocked();
+  return function;
 }
 
 // |ShaderLibrary|
@@ -118,7 +137,7 @@ void ShaderLibraryGLES::RegisterFunction(std::string name,
   }
   const auto key = ShaderKey{name, stage};
   WriterLock lock(functions_mutex_);
-  if (functions_.count(key) != 0) {
+  if (functions_.count(key) != 0 || archived_code_.count(key) != 0) {
     VALIDATION_LOG << "Runtime stage named " << name
                    << " has already been registered.";
     return;
@@ -136,7 +155,7 @@ void ShaderLibraryGLES::RegisterFunction(std::string name,
 // |ShaderLibrary|
 void ShaderLibraryGLES::UnregisterFunction(std::string name,
                                            ShaderStage stage) {
-  ReaderLock lock(functions_mutex_);
+  WriterLock lock(functions_mutex_);
 
   const auto key = ShaderKey{name, stage};
 
@@ -152,4 +171,11 @@ void ShaderLibraryGLES::UnregisterFunction(std::string name,
   return;
 }
 
+void ShaderLibraryGLES::TraceFunctionCountsLocked() const {
+  FML_TRACE_COUNTER("impeller", "ShaderLibraryGLES",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "ArchivedShaders", archived_count_,
+                    "InstantiatedShaders", instantiated_count_);
+}
+
 }  // namespace impeller
@@ -29,6 +29,11 @@ class ShaderLibraryGLES final : public ShaderLibrary {
   const UniqueID library_id_;
   mutable RWMutex functions_mutex_;
   ShaderFunctionMap functions_ IPLR_GUARDED_BY(functions_mutex_);
+  // Shaders in the archives that have not been looked up yet. Their code
+  // points into the archives, which are not copied.
+  ShaderCodeMap archived_code_ IPLR_GUARDED_BY(functions_mutex_);
+  size_t archived_count_ = 0u;
+  size_t instantiated_count_ IPLR_GUARDED_BY(functions_mutex_) = 0u;
   bool is_valid_ = false;
 
   explicit ShaderLibraryGLES(
@@ -47,6 +52,9 @@ class ShaderLibraryGLES final : public ShaderLibrary {
   // |ShaderLibrary|
   void UnregisterFunction(std::string name, ShaderStage stage) override;
 
+  void TraceFunctionCountsLocked() const
+      IPLR_REQUIRES_SHARED(functions_mutex_);
+
   ShaderLibraryGLES(const ShaderLibraryGLES&) = delete;
 
   ShaderLibraryGLES& operator=(const ShaderLibraryGLES&) = delete;
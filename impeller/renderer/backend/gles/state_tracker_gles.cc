@@ -0,0 +1,189 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/state_tracker_gles.h"
+
+#include <algorithm>
+
+namespace impeller {
+
+StateTrackerGLES::StateTrackerGLES(const ProcTableGLES& gl) : gl_(gl) {}
+
+StateTrackerGLES::~StateTrackerGLES() = default;
+
+void StateTrackerGLES::Reset() {
+  for (auto cap : {GL_SCISSOR_TEST, GL_DEPTH_TEST, GL_STENCIL_TEST,
+                   GL_CULL_FACE, GL_BLEND}) {
+    gl_.Disable(cap);
+    capabilities_[static_cast<size_t>(ToCapability(cap).value())] = false;
+  }
+  gl_.ColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+  color_mask_ = {GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE};
+}
+
+std::optional<StateTrackerGLES::Capability> StateTrackerGLES::ToCapability(
+    GLenum cap) {
+  switch (cap) {
+    case GL_BLEND:
+      return Capability::kBlend;
+    case GL_CULL_FACE:
+      return Capability::kCullFace;
+    case GL_DEPTH_TEST:
+      return Capability::kDepthTest;
+    case GL_SCISSOR_TEST:
+      return Capability::kScissorTest;
+    case GL_STENCIL_TEST:
+      return Capability::kStencilTest;
+  }
+  return std::nullopt;
+}
+
+void StateTrackerGLES::SetCapability(GLenum cap, bool enabled) {
+  auto capability = ToCapability(cap);
+  if (capability.has_value() &&
+      !Update(capabilities_[static_cast<size_t>(capability.value())],
+              enabled)) {
+    return;
+  }
+  if (enabled) {
+    gl_.Enable(cap);
+  } else {
+    gl_.Disable(cap);
+  }
+}
+
+void StateTrackerGLES::Enable(GLenum cap) {
+  SetCapability(cap, true);
+}
+
+void StateTrackerGLES::Disable(GLenum cap) {
+  SetCapability(cap, false);
+}
+
+void StateTrackerGLES::BlendFuncSeparate(GLenum src_color,
+                                         GLenum dst_color,
+                                         GLenum src_alpha,
+                                         GLenum dst_alpha) {
+  if (Update(blend_func_, {src_color, dst_color, src_alpha, dst_alpha})) {
+    gl_.BlendFuncSeparate(src_color, dst_color, src_alpha, dst_alpha);
+  }
+}
+
+void StateTrackerGLES::BlendEquationSeparate(GLenum mode_color,
+                                             GLenum mode_alpha) {
+  if (Update(blend_equation_, {mode_color, mode_alpha})) {
+    gl_.BlendEquationSeparate(mode_color, mode_alpha);
+  }
+}
+
+void StateTrackerGLES::ColorMask(GLboolean red,
+                                 GLboolean green,
+                                 GLboolean blue,
+                                 GLboolean alpha) {
+  if (Update(color_mask_, {red, green, blue, alpha})) {
+    gl_.ColorMask(red, green, blue, alpha);
+  }
+}
+
+void StateTrackerGLES::StencilOpSeparate(GLenum face,
+                                         GLenum stencil_fail,
+                                         GLenum depth_fail,
+                                         GLenum depth_stencil_pass) {
+  if (UpdateStencil(face, &StencilFaceState::op,
+                    {stencil_fail, depth_fail, depth_stencil_pass})) {
+    gl_.StencilOpSeparate(face, stencil_fail, depth_fail, depth_stencil_pass);
+  }
+}
+
+void StateTrackerGLES::StencilFuncSeparate(GLenum face,
+                                           GLenum func,
+                                           GLint ref,
+                                           GLuint mask) {
+  if (UpdateStencil(face, &StencilFaceState::func,
+                    {func, static_cast<GLuint>(ref), mask})) {
+    gl_.StencilFuncSeparate(face, func, ref, mask);
+  }
+}
+
+void StateTrackerGLES::StencilMaskSeparate(GLenum face, GLuint mask) {
+  if (UpdateStencil(face, &StencilFaceState::write_mask, mask)) {
+    gl_.StencilMaskSeparate(face, mask);
+  }
+}
+
+void StateTrackerGLES::DepthFunc(GLenum func) {
+  if (Update(depth_func_, func)) {
+    gl_.DepthFunc(func);
+  }
+}
+
+void StateTrackerGLES::DepthMask(GLboolean flag) {
+  if (Update(depth_mask_, flag)) {
+    gl_.DepthMask(flag);
+  }
+}
+
+void StateTrackerGLES::Viewport(GLint x,
+                                GLint y,
+                                GLsizei width,
+                                GLsizei height) {
+  if (Update(viewport_, {x, y, width, height})) {
+    gl_.Viewport(x, y, width, height);
+  }
+}
+
+void StateTrackerGLES::DepthRangef(GLfloat z_near, GLfloat z_far) {
+  if (Update(depth_range_, {z_near, z_far})) {
+    gl_.DepthRangef(z_near, z_far);
+  }
+}
+
+void StateTrackerGLES::Scissor(GLint x,
+                               GLint y,
+                               GLsizei width,
+                               GLsizei height) {
+  if (Update(scissor_, {x, y, width, height})) {
+    gl_.Scissor(x, y, width, height);
+  }
+}
+
+void StateTrackerGLES::CullFace(GLenum mode) {
+  if (Update(cull_face_, mode)) {
+    gl_.CullFace(mode);
+  }
+}
+
+void StateTrackerGLES::FrontFace(GLenum mode) {
+  if (Update(front_face_, mode)) {
+    gl_.FrontFace(mode);
+  }
+}
+
+void StateTrackerGLES::SetEnabledVertexAttribArrays(
+    const std::vector<GLuint>& indices) {
+  for (auto index : enabled_vertex_attrib_arrays_) {
+    if (std::find(indices.begin(), indices.end(), index) == indices.end()) {
+      gl_.DisableVertexAttribArray(index);
+    }
+  }
+  for (auto index : indices) {
+    if (std::find(enabled_vertex_attrib_arrays_.begin(),
+                  enabled_vertex_attrib_arrays_.end(),
+                  index) == enabled_vertex_attrib_arrays_.end()) {
+      gl_.EnableVertexAttribArray(index);
+    } else {
+      elided_calls_++;
+    }
+  }
+  enabled_vertex_attrib_arrays_ = indices;
+}
+
+void StateTrackerGLES::DisableVertexAttribArrays() {
+  for (auto index : enabled_vertex_attrib_arrays_) {
+    gl_.DisableVertexAttribArray(index);
+  }
+  enabled_vertex_attrib_arrays_.clear();
+}
+
+}  // namespace impeller
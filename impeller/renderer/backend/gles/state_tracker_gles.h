@@ -0,0 +1,180 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_TRACKER_GLES_H_
+#define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_TRACKER_GLES_H_
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Shadows the fixed function state set while encoding a render
+///             pass and skips calls that would not change that state.
+///
+///             OpenGL state belongs to the context that is current. Since the
+///             reactor may encode passes on different contexts, a tracker only
+///             lives as long as the encoding of a single pass and assumes
+///             nothing about the state before |Reset| is called.
+///
+class StateTrackerGLES {
+ public:
+  explicit StateTrackerGLES(const ProcTableGLES& gl);
+
+  ~StateTrackerGLES();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Unconditionally disables blending, depth, stencil, scissor
+  ///             and culling and enables all color channels.
+  ///
+  void Reset();
+
+  void Enable(GLenum cap);
+
+  void Disable(GLenum cap);
+
+  void BlendFuncSeparate(GLenum src_color,
+                         GLenum dst_color,
+                         GLenum src_alpha,
+                         GLenum dst_alpha);
+
+  void BlendEquationSeparate(GLenum mode_color, GLenum mode_alpha);
+
+  void ColorMask(GLboolean red,
+                 GLboolean green,
+                 GLboolean blue,
+                 GLboolean alpha);
+
+  void StencilOpSeparate(GLenum face,
+                         GLenum stencil_fail,
+                         GLenum depth_fail,
+                         GLenum depth_stencil_pass);
+
+  void StencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask);
+
+  void StencilMaskSeparate(GLenum face, GLuint mask);
+
+  void DepthFunc(GLenum func);
+
+  void DepthMask(GLboolean flag);
+
+  void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+  void DepthRangef(GLfloat z_near, GLfloat z_far);
+
+  void Scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+  void CullFace(GLenum mode);
+
+  void FrontFace(GLenum mode);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Enables exactly the given vertex attribute arrays, disabling
+  ///             the ones enabled for a previous draw that are not needed for
+  ///             the next.
+  ///
+  void SetEnabledVertexAttribArrays(const std::vector<GLuint>& indices);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Disables all vertex attribute arrays enabled through this
+  ///             tracker.
+  ///
+  void DisableVertexAttribArrays();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records a call that was skipped outside of the tracker, such
+  ///             as the upload of a uniform that already had the same value.
+  ///
+  void RecordElidedCall() { elided_calls_++; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of calls skipped because they would not have
+  ///             changed any state.
+  ///
+  size_t GetElidedCallCount() const { return elided_calls_; }
+
+ private:
+  enum class Capability {
+    kBlend,
+    kCullFace,
+    kDepthTest,
+    kScissorTest,
+    kStencilTest,
+    kLast = kStencilTest,
+  };
+
+  struct StencilFaceState {
+    std::optional<std::array<GLenum, 3>> op;
+    std::optional<std::array<GLuint, 3>> func;
+    std::optional<GLuint> write_mask;
+  };
+
+  const ProcTableGLES& gl_;
+  std::array<std::optional<bool>, static_cast<size_t>(Capability::kLast) + 1>
+      capabilities_;
+  std::optional<std::array<GLenum, 4>> blend_func_;
+  std::optional<std::array<GLenum, 2>> blend_equation_;
+  std::optional<std::array<GLboolean, 4>> color_mask_;
+  StencilFaceState front_stencil_;
+  StencilFaceState back_stencil_;
+  std::optional<GLenum> depth_func_;
+  std::optional<GLboolean> depth_mask_;
+  std::optional<std::array<GLint, 4>> viewport_;
+  std::optional<std::array<GLfloat, 2>> depth_range_;
+  std::optional<std::array<GLint, 4>> scissor_;
+  std::optional<GLenum> cull_face_;
+  std::optional<GLenum> front_face_;
+  std::vector<GLuint> enabled_vertex_attrib_arrays_;
+  size_t elided_calls_ = 0u;
+
+  static std::optional<Capability> ToCapability(GLenum cap);
+
+  void SetCapability(GLenum cap, bool enabled);
+
+  // Returns true and updates the shadowed value if the value changed.
+  template <class T>
+  bool Update(std::optional<T>& shadow, const T& value) {
+    if (shadow.has_value() && shadow.value() == value) {
+      elided_calls_++;
+      return false;
+    }
+    shadow = value;
+    return true;
+  }
+
+  // Like |Update| but for the stencil state of one or both faces.
+  template <class T>
+  bool UpdateStencil(GLenum face,
+                     std::optional<T> StencilFaceState::*member,
+                     const T& value) {
+    auto& front = front_stencil_.*member;
+    auto& back = back_stencil_.*member;
+    switch (face) {
+      case GL_FRONT:
+        return Update(front, value);
+      case GL_BACK:
+        return Update(back, value);
+      default:
+        if (front == value && back == value) {
+          elided_calls_++;
+          return false;
+        }
+        front = value;
+        back = value;
+        return true;
+    }
+  }
+
+  StateTrackerGLES(const StateTrackerGLES&) = delete;
+
+  StateTrackerGLES& operator=(const StateTrackerGLES&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_TRACKER_GLES_H_
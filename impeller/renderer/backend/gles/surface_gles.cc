@@ -24,6 +24,7 @@ std::unique_ptr<Surface> SurfaceGLES::WrapFBO(
   }
 
   const auto& gl_context = ContextGLES::Cast(*context);
+  gl_context.GetReactor()->DidAcquireSurfaceFrame();
 
   TextureDescriptor color0_tex;
   color0_tex.type = TextureType::kTexture2D;
@@ -44,6 +44,37 @@ TEST(GPUTracerGLES, CanFormatFramebufferErrorMessage) {
   }
 }
 
+TEST(GPUTracerGLES, ReportsTheGPUTimeOfEachFrame) {
+  auto const extensions = std::vector<const unsigned char*>{
+      reinterpret_cast<const unsigned char*>("GL_KHR_debug"),                 //
+      reinterpret_cast<const unsigned char*>("GL_EXT_disjoint_timer_query"),  //
+  };
+  auto mock_gles = MockGLES::Init(extensions);
+  auto tracer =
+      std::make_shared<GPUTracerGLES>(mock_gles->GetProcTable(), true);
+  std::vector<std::pair<fml::TimePoint, fml::TimeDelta>> frames;
+  tracer->SetFrameTimeCallback(
+      [&frames](fml::TimePoint frame_start, fml::TimeDelta gpu_time) {
+        frames.emplace_back(frame_start, gpu_time);
+      });
+  tracer->RecordRasterThread();
+
+  auto before_frame = fml::TimePoint::Now();
+  tracer->MarkFrameStart(mock_gles->GetProcTable());
+  auto after_frame_start = fml::TimePoint::Now();
+  tracer->MarkFrameEnd(mock_gles->GetProcTable());
+  EXPECT_TRUE(frames.empty());
+
+  // The result of the first frame is read when the second frame starts.
+  tracer->MarkFrameStart(mock_gles->GetProcTable());
+  ASSERT_EQ(frames.size(), 1u);
+  EXPECT_GE(frames[0].first, before_frame);
+  EXPECT_LE(frames[0].first, after_frame_start);
+  // The mock reports 1000ns for every query.
+  EXPECT_EQ(frames[0].second, fml::TimeDelta::FromNanoseconds(1000));
+  EXPECT_EQ(tracer->GetTotalGPUTime(), fml::TimeDelta::FromNanoseconds(1000));
+}
+
 #endif  // IMPELLER_DEBUG
 
 }  // namespace testing
@@ -159,6 +159,23 @@ void mockDeleteQueriesEXT(GLsizei size, const GLuint* queries) {
 static_assert(CheckSameSignature<decltype(mockDeleteQueriesEXT),  //
                                  decltype(glDeleteQueriesEXT)>::value);
 
+void mockGenTextures(GLsizei n, GLuint* textures) {
+  RecordGLCall("glGenTextures");
+  for (auto i = 0; i < n; i++) {
+    textures[i] = i + 1;
+  }
+}
+
+static_assert(CheckSameSignature<decltype(mockGenTextures),  //
+                                 decltype(glGenTextures)>::value);
+
+void mockDeleteTextures(GLsizei n, const GLuint* textures) {
+  RecordGLCall("glDeleteTextures");
+}
+
+static_assert(CheckSameSignature<decltype(mockDeleteTextures),  //
+                                 decltype(glDeleteTextures)>::value);
+
 std::shared_ptr<MockGLES> MockGLES::Init(
     const std::optional<std::vector<const unsigned char*>>& extensions) {
   // If we cannot obtain a lock, MockGLES is already being used elsewhere.
@@ -195,6 +212,10 @@ const ProcTableGLES::Resolver kMockResolver = [](const char* name) {
     return reinterpret_cast<void*>(mockGetQueryObjectui64vEXT);
   } else if (strcmp(name, "glGetQueryObjectuivEXT") == 0) {
     return reinterpret_cast<void*>(mockGetQueryObjectuivEXT);
+  } else if (strcmp(name, "glGenTextures") == 0) {
+    return reinterpret_cast<void*>(&mockGenTextures);
+  } else if (strcmp(name, "glDeleteTextures") == 0) {
+    return reinterpret_cast<void*>(&mockDeleteTextures);
   } else {
     return reinterpret_cast<void*>(&doNothing);
   }
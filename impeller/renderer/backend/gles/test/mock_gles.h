@@ -10,6 +10,10 @@
 namespace impeller {
 namespace testing {
 
+/// @brief      The resolver used by |MockGLES|, for tests that need to own
+///             their |ProcTableGLES| (such as tests of |ReactorGLES|).
+extern const ProcTableGLES::Resolver kMockResolver;
+
 /// @brief      Provides a mocked version of the |ProcTableGLES| class.
 ///
 /// Typically, Open GLES at runtime will be provided the host's GLES bindings
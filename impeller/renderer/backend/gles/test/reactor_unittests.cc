@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/gles/reactor_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+class TestWorker : public ReactorGLES::Worker {
+ public:
+  bool CanReactorReactOnCurrentThreadNow(
+      const ReactorGLES& reactor) const override {
+    return true;
+  }
+};
+
+size_t CountCalls(const std::vector<std::string>& calls,
+                  const std::string& name) {
+  return std::count(calls.begin(), calls.end(), name);
+}
+}  // namespace
+
+TEST(ReactorGLES, GeneratesHandlesInBatches) {
+  auto mock_gles = MockGLES::Init();
+  auto reactor = std::make_shared<ReactorGLES>(
+      std::make_unique<ProcTableGLES>(kMockResolver));
+  ASSERT_TRUE(reactor->IsValid());
+  auto worker = std::make_shared<TestWorker>();
+  reactor->AddWorker(worker);
+  mock_gles->GetCapturedCalls();
+
+  for (auto i = 0; i < 8; i++) {
+    auto handle = reactor->CreateHandle(HandleType::kTexture);
+    EXPECT_TRUE(reactor->GetGLHandle(handle).has_value());
+  }
+
+  EXPECT_EQ(CountCalls(mock_gles->GetCapturedCalls(), "glGenTextures"), 1u);
+}
+
+TEST(ReactorGLES, DeletesCollectedHandlesOncePerFrame) {
+  auto mock_gles = MockGLES::Init();
+  auto reactor = std::make_shared<ReactorGLES>(
+      std::make_unique<ProcTableGLES>(kMockResolver));
+  ASSERT_TRUE(reactor->IsValid());
+  auto worker = std::make_shared<TestWorker>();
+  reactor->AddWorker(worker);
+  reactor->DidAcquireSurfaceFrame();
+
+  for (auto i = 0; i < 4; i++) {
+    reactor->CollectHandle(reactor->CreateHandle(HandleType::kTexture));
+    ASSERT_TRUE(reactor->AddOperation([](const ReactorGLES&) {}));
+  }
+  mock_gles->GetCapturedCalls();
+
+  // Collected handles are deleted together at the start of the next frame.
+  reactor->DidAcquireSurfaceFrame();
+  ASSERT_TRUE(reactor->AddOperation([](const ReactorGLES&) {}));
+  EXPECT_EQ(CountCalls(mock_gles->GetCapturedCalls(), "glDeleteTextures"),
+            1u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -0,0 +1,57 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/gles/state_tracker_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(StateTrackerGLES, ElidesRedundantStateChanges) {
+  auto mock_gles = MockGLES::Init();
+  StateTrackerGLES state(mock_gles->GetProcTable());
+  state.Reset();
+
+  // Already disabled by the reset.
+  state.Disable(GL_BLEND);
+  state.ColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+  EXPECT_EQ(state.GetElidedCallCount(), 2u);
+
+  state.Enable(GL_BLEND);
+  state.Enable(GL_BLEND);
+  state.Viewport(0, 0, 100, 100);
+  state.Viewport(0, 0, 100, 100);
+  state.Viewport(0, 0, 200, 100);
+  EXPECT_EQ(state.GetElidedCallCount(), 4u);
+}
+
+TEST(StateTrackerGLES, TracksStencilStatePerFace) {
+  auto mock_gles = MockGLES::Init();
+  StateTrackerGLES state(mock_gles->GetProcTable());
+
+  state.StencilMaskSeparate(GL_FRONT, 0xFF);
+  EXPECT_EQ(state.GetElidedCallCount(), 0u);
+
+  // The back face is still unknown.
+  state.StencilMaskSeparate(GL_FRONT_AND_BACK, 0xFF);
+  EXPECT_EQ(state.GetElidedCallCount(), 0u);
+
+  state.StencilMaskSeparate(GL_BACK, 0xFF);
+  state.StencilMaskSeparate(GL_FRONT_AND_BACK, 0xFF);
+  EXPECT_EQ(state.GetElidedCallCount(), 2u);
+}
+
+TEST(StateTrackerGLES, KeepsSharedVertexAttribArraysEnabled) {
+  auto mock_gles = MockGLES::Init();
+  StateTrackerGLES state(mock_gles->GetProcTable());
+
+  state.SetEnabledVertexAttribArrays({0u, 1u});
+  state.SetEnabledVertexAttribArrays({0u, 2u});
+  EXPECT_EQ(state.GetElidedCallCount(), 1u);
+}
+
+}  // namespace testing
+}  // namespace impeller
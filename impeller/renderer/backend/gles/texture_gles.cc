@@ -141,6 +141,9 @@ struct TexImage2DData {
       case PixelFormat::kB10G10R10XRSRGB:
       case PixelFormat::kB10G10R10XR:
       case PixelFormat::kB10G10R10A10XR:
+      case PixelFormat::kASTC4x4UNormInt:
+      case PixelFormat::kETC2R8G8B8A8UNormInt:
+      case PixelFormat::kBC7UNormInt:
         return;
     }
     is_valid_ = true;
@@ -301,6 +304,9 @@ static std::optional<GLenum> ToRenderBufferFormat(PixelFormat format) {
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kBC7UNormInt:
       return std::nullopt;
   }
   FML_UNREACHABLE();
@@ -119,12 +119,11 @@ bool BlitCopyBufferToTextureCommandMTL::Encode(
   auto image_size = destination->GetTextureDescriptor().size;
   auto source_size_mtl = MTLSizeMake(image_size.width, image_size.height, 1);
 
-  auto destination_bytes_per_pixel =
-      BytesPerPixelForPixelFormat(destination->GetTextureDescriptor().format);
+  // Rows of block compressed formats are rows of blocks.
   auto destination_bytes_per_row =
-      source_size_mtl.width * destination_bytes_per_pixel;
+      destination->GetTextureDescriptor().GetBytesPerRow();
   auto destination_bytes_per_image =
-      source_size_mtl.height * destination_bytes_per_row;
+      destination->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
 
   [encoder copyFromBuffer:source_mtl
              sourceOffset:source.range.offset
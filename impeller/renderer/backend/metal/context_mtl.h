@@ -42,14 +42,16 @@ class ContextMTL final : public Context,
   static std::shared_ptr<ContextMTL> Create(
       const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_data,
       std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch,
-      const std::string& label);
+      const std::string& label,
+      const PipelineArchivesMTL& pipeline_archives = {});
 
   static std::shared_ptr<ContextMTL> Create(
       id<MTLDevice> device,
       id<MTLCommandQueue> command_queue,
       const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_data,
       std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch,
-      const std::string& label);
+      const std::string& label,
+      const PipelineArchivesMTL& pipeline_archives = {});
 
   // |Context|
   ~ContextMTL() override;
@@ -95,6 +97,12 @@ class ContextMTL final : public Context,
 
   const std::shared_ptr<fml::ConcurrentTaskRunner> GetWorkerTaskRunner() const;
 
+  /// @brief Returns the number of threads that can run tasks posted to the
+  ///        worker task runner concurrently with the calling thread. This is
+  ///        zero when called on one of the workers, since blocking a worker on
+  ///        other worker tasks could deadlock.
+  size_t GetAvailableWorkerCount() const;
+
   std::shared_ptr<const fml::SyncSwitch> GetIsGpuDisabledSyncSwitch() const;
 
 #ifdef IMPELLER_DEBUG
@@ -104,6 +112,9 @@ class ContextMTL final : public Context,
   // |Context|
   void StoreTaskForGPU(const std::function<void()>& task) override;
 
+  // |Context|
+  void SetGPUFrameTimeCallback(GPUFrameTimeCallback callback) override;
+
  private:
   class SyncSwitchObserver : public fml::SyncSwitch::Observer {
    public:
@@ -135,7 +146,8 @@ class ContextMTL final : public Context,
       id<MTLDevice> device,
       id<MTLCommandQueue> command_queue,
       NSArray<id<MTLLibrary>>* shader_libraries,
-      std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch);
+      std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch,
+      const PipelineArchivesMTL& pipeline_archives = {});
 
   std::shared_ptr<CommandBuffer> CreateCommandBufferInQueue(
       id<MTLCommandQueue> queue) const;
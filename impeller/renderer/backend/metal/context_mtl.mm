@@ -14,6 +14,7 @@
 #include "flutter/fml/synchronization/sync_switch.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/sampler_descriptor.h"
+#include "impeller/renderer/backend/metal/formats_mtl.h"
 #include "impeller/renderer/backend/metal/gpu_tracer_mtl.h"
 #include "impeller/renderer/backend/metal/sampler_library_mtl.h"
 #include "impeller/renderer/capabilities.h"
@@ -51,6 +52,34 @@ static bool DeviceSupportsComputeSubgroups(id<MTLDevice> device) {
   return supports_subgroups;
 }
 
+// Refer to the "Texture capabilities" section of
+// https://developer.apple.com/metal/Metal-Feature-Set-Tables.pdf
+static bool DeviceSupportsBlockCompressedFormat(id<MTLDevice> device,
+                                                PixelFormat format) {
+  if (ToMTLPixelFormat(format) == MTLPixelFormatInvalid) {
+    return false;
+  }
+  switch (format) {
+    case PixelFormat::kASTC4x4UNormInt:
+      if (@available(ios 13.0, tvos 13.0, macos 10.15, *)) {
+        return [device supportsFamily:MTLGPUFamilyApple2];
+      }
+      return false;
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+      if (@available(ios 13.0, tvos 13.0, macos 10.15, *)) {
+        return [device supportsFamily:MTLGPUFamilyApple1];
+      }
+      return false;
+    case PixelFormat::kBC7UNormInt:
+      if (@available(ios 16.4, tvos 16.4, macos 11.0, *)) {
+        return device.supportsBCTextureCompression;
+      }
+      return false;
+    default:
+      return false;
+  }
+}
+
 static std::unique_ptr<Capabilities> InferMetalCapabilities(
     id<MTLDevice> device,
     PixelFormat color_format) {
@@ -68,6 +97,18 @@ static std::unique_ptr<Capabilities> InferMetalCapabilities(
       .SetSupportsComputeSubgroups(DeviceSupportsComputeSubgroups(device))
       .SetSupportsReadFromResolve(true)
       .SetSupportsDeviceTransientTextures(true)
+      .SetSupportsBlockCompressedFormat(
+          PixelFormat::kASTC4x4UNormInt,
+          DeviceSupportsBlockCompressedFormat(device,
+                                              PixelFormat::kASTC4x4UNormInt))
+      .SetSupportsBlockCompressedFormat(
+          PixelFormat::kETC2R8G8B8A8UNormInt,
+          DeviceSupportsBlockCompressedFormat(
+              device, PixelFormat::kETC2R8G8B8A8UNormInt))
+      .SetSupportsBlockCompressedFormat(
+          PixelFormat::kBC7UNormInt,
+          DeviceSupportsBlockCompressedFormat(device,
+                                              PixelFormat::kBC7UNormInt))
       .Build();
 }
 
@@ -75,7 +116,8 @@ ContextMTL::ContextMTL(
     id<MTLDevice> device,
     id<MTLCommandQueue> command_queue,
     NSArray<id<MTLLibrary>>* shader_libraries,
-    std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch)
+    std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch,
+    const PipelineArchivesMTL& pipeline_archives)
     : device_(device),
       command_queue_(command_queue),
       is_gpu_disabled_sync_switch_(std::move(is_gpu_disabled_sync_switch)) {
@@ -125,14 +167,14 @@ ContextMTL::ContextMTL(
 
   // Setup the pipeline library.
   {
-    pipeline_library_ =
-        std::shared_ptr<PipelineLibraryMTL>(new PipelineLibraryMTL(device_));
+    pipeline_library_ = std::shared_ptr<PipelineLibraryMTL>(
+        new PipelineLibraryMTL(device_, pipeline_archives, GetBackendStats()));
   }
 
   // Setup the sampler library.
   {
-    sampler_library_ =
-        std::shared_ptr<SamplerLibraryMTL>(new SamplerLibraryMTL(device_));
+    sampler_library_ = std::shared_ptr<SamplerLibraryMTL>(
+        new SamplerLibraryMTL(device_, GetBackendStats()));
   }
 
   // Setup the resource allocator.
@@ -143,6 +185,7 @@ ContextMTL::ContextMTL(
       VALIDATION_LOG << "Could not set up the resource allocator.";
       return;
     }
+    resource_allocator_->SetBackendStats(GetBackendStats());
   }
 
   device_capabilities_ =
@@ -255,17 +298,18 @@ std::shared_ptr<ContextMTL> ContextMTL::Create(
 std::shared_ptr<ContextMTL> ContextMTL::Create(
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_data,
     std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch,
-    const std::string& library_label) {
+    const std::string& library_label,
+    const PipelineArchivesMTL& pipeline_archives) {
   auto device = CreateMetalDevice();
   auto command_queue = CreateMetalCommandQueue(device);
   if (!command_queue) {
     return nullptr;
   }
-  auto context = std::shared_ptr<ContextMTL>(
-      new ContextMTL(device, command_queue,
-                     MTLShaderLibraryFromFileData(device, shader_libraries_data,
-                                                  library_label),
-                     std::move(is_gpu_disabled_sync_switch)));
+  auto context = std::shared_ptr<ContextMTL>(new ContextMTL(
+      device, command_queue,
+      MTLShaderLibraryFromFileData(device, shader_libraries_data,
+                                   library_label),
+      std::move(is_gpu_disabled_sync_switch), pipeline_archives));
   if (!context->IsValid()) {
     FML_LOG(ERROR) << "Could not create Metal context.";
     return nullptr;
@@ -278,12 +322,13 @@ std::shared_ptr<ContextMTL> ContextMTL::Create(
     id<MTLCommandQueue> command_queue,
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_data,
     std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch,
-    const std::string& library_label) {
-  auto context = std::shared_ptr<ContextMTL>(
-      new ContextMTL(device, command_queue,
-                     MTLShaderLibraryFromFileData(device, shader_libraries_data,
-                                                  library_label),
-                     std::move(is_gpu_disabled_sync_switch)));
+    const std::string& library_label,
+    const PipelineArchivesMTL& pipeline_archives) {
+  auto context = std::shared_ptr<ContextMTL>(new ContextMTL(
+      device, command_queue,
+      MTLShaderLibraryFromFileData(device, shader_libraries_data,
+                                   library_label),
+      std::move(is_gpu_disabled_sync_switch), pipeline_archives));
   if (!context->IsValid()) {
     FML_LOG(ERROR) << "Could not create Metal context.";
     return nullptr;
@@ -340,11 +385,24 @@ std::shared_ptr<GPUTracerMTL> ContextMTL::GetGPUTracer() const {
 }
 #endif  // IMPELLER_DEBUG
 
+void ContextMTL::SetGPUFrameTimeCallback(GPUFrameTimeCallback callback) {
+#ifdef IMPELLER_DEBUG
+  gpu_tracer_->SetFrameTimeCallback(std::move(callback));
+#endif  // IMPELLER_DEBUG
+}
+
 const std::shared_ptr<fml::ConcurrentTaskRunner>
 ContextMTL::GetWorkerTaskRunner() const {
   return raster_message_loop_->GetTaskRunner();
 }
 
+size_t ContextMTL::GetAvailableWorkerCount() const {
+  if (raster_message_loop_->RunsTasksOnCurrentThread()) {
+    return 0u;
+  }
+  return raster_message_loop_->GetWorkerCount();
+}
+
 std::shared_ptr<const fml::SyncSwitch> ContextMTL::GetIsGpuDisabledSyncSwitch()
     const {
   return is_gpu_disabled_sync_switch_;
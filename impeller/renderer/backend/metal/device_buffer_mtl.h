@@ -36,6 +36,9 @@ class DeviceBufferMTL final : public DeviceBuffer,
   // |DeviceBuffer|
   uint8_t* OnGetContents() const override;
 
+  // |DeviceBuffer|
+  void Flush(std::optional<Range> range) const override;
+
   // |DeviceBuffer|
   std::shared_ptr<Texture> AsTexture(Allocator& allocator,
                                      const TextureDescriptor& descriptor,
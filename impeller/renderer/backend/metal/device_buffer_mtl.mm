@@ -53,6 +53,16 @@ std::shared_ptr<Texture> DeviceBufferMTL::AsTexture(
   return TextureMTL::Create(descriptor, texture);
 }
 
+void DeviceBufferMTL::Flush(std::optional<Range> range) const {
+#if !FML_OS_IOS
+  auto flush_range = range.value_or(Range{0, GetDeviceBufferDescriptor().size});
+  if (storage_mode_ == MTLStorageModeManaged) {
+    [buffer_
+        didModifyRange:NSMakeRange(flush_range.offset, flush_range.length)];
+  }
+#endif  // !FML_OS_IOS
+}
+
 [[nodiscard]] bool DeviceBufferMTL::OnCopyHostBuffer(const uint8_t* source,
                                                      Range source_range,
                                                      size_t offset) {
@@ -9,9 +9,11 @@
 
 #include <memory>
 #include <optional>
+#include "flutter/fml/time/time_delta.h"
 #include "impeller/base/thread.h"
 #include "impeller/base/thread_safety.h"
 #include "impeller/geometry/scalar.h"
+#include "impeller/renderer/context.h"
 
 namespace impeller {
 
@@ -19,7 +21,8 @@ class ContextMTL;
 
 /// @brief Approximate the GPU frame time by computing a difference between the
 ///        smallest GPUStartTime and largest GPUEndTime for all command buffers
-///        submitted in a frame workload.
+///        submitted in a frame workload. Also reports the CPU time spent
+///        encoding render passes for each frame.
 class GPUTracerMTL : public std::enable_shared_from_this<GPUTracerMTL> {
  public:
   GPUTracerMTL() = default;
@@ -34,16 +37,33 @@ class GPUTracerMTL : public std::enable_shared_from_this<GPUTracerMTL> {
   ///        aggregate frame workload metric.
   void RecordCmdBuffer(id<MTLCommandBuffer> buffer);
 
+  /// @brief Record the CPU time spent encoding the commands of a render pass.
+  ///        The total for the frame is reported when the frame ends.
+  void RecordEncodeTime(fml::TimeDelta encode_time);
+
+  /// @brief The GPU time of all the frame workloads that have completed so
+  ///        far.
+  fml::TimeDelta GetTotalGPUTime() const;
+
+  /// @brief Set the callback that receives the GPU time of each frame
+  ///        workload.
+  void SetFrameTimeCallback(Context::GPUFrameTimeCallback callback);
+
  private:
   struct GPUTraceState {
     Scalar smallest_timestamp = std::numeric_limits<float>::max();
     Scalar largest_timestamp = 0;
     size_t pending_buffers = 0;
+    fml::TimePoint frame_start;
   };
 
   mutable Mutex trace_state_mutex_;
   GPUTraceState trace_states_[16] IPLR_GUARDED_BY(trace_state_mutex_);
   size_t current_state_ IPLR_GUARDED_BY(trace_state_mutex_) = 0u;
+  fml::TimeDelta frame_encode_time_ IPLR_GUARDED_BY(trace_state_mutex_);
+  fml::TimeDelta total_gpu_time_ IPLR_GUARDED_BY(trace_state_mutex_);
+  Context::GPUFrameTimeCallback frame_time_callback_
+      IPLR_GUARDED_BY(trace_state_mutex_);
 };
 
 }  // namespace impeller
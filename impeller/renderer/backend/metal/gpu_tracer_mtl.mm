@@ -14,17 +14,41 @@
 namespace impeller {
 
 void GPUTracerMTL::MarkFrameEnd() {
+  Lock lock(trace_state_mutex_);
+  FML_TRACE_COUNTER("flutter", "GPUTracer",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "EncodeTimeMS", frame_encode_time_.ToMillisecondsF());
+  frame_encode_time_ = fml::TimeDelta::Zero();
   if (@available(ios 10.3, tvos 10.2, macos 10.15, macCatalyst 13.0, *)) {
-    Lock lock(trace_state_mutex_);
     current_state_ = (current_state_ + 1) % 16;
   }
 }
 
+void GPUTracerMTL::RecordEncodeTime(fml::TimeDelta encode_time) {
+  Lock lock(trace_state_mutex_);
+  frame_encode_time_ = frame_encode_time_ + encode_time;
+}
+
+fml::TimeDelta GPUTracerMTL::GetTotalGPUTime() const {
+  Lock lock(trace_state_mutex_);
+  return total_gpu_time_;
+}
+
+void GPUTracerMTL::SetFrameTimeCallback(
+    Context::GPUFrameTimeCallback callback) {
+  Lock lock(trace_state_mutex_);
+  frame_time_callback_ = std::move(callback);
+}
+
 void GPUTracerMTL::RecordCmdBuffer(id<MTLCommandBuffer> buffer) {
   if (@available(ios 10.3, tvos 10.2, macos 10.15, macCatalyst 13.0, *)) {
     Lock lock(trace_state_mutex_);
     auto current_state = current_state_;
-    trace_states_[current_state].pending_buffers += 1;
+    auto& trace_state = trace_states_[current_state];
+    if (trace_state.pending_buffers == 0) {
+      trace_state.frame_start = fml::TimePoint::Now();
+    }
+    trace_state.pending_buffers += 1;
 
     auto weak_self = weak_from_this();
     [buffer addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
@@ -43,6 +67,11 @@ void GPUTracerMTL::RecordCmdBuffer(id<MTLCommandBuffer> buffer) {
       if (state.pending_buffers == 0) {
         auto gpu_ms =
             (state.largest_timestamp - state.smallest_timestamp) * 1000;
+        auto gpu_time = fml::TimeDelta::FromMillisecondsF(gpu_ms);
+        self->total_gpu_time_ = self->total_gpu_time_ + gpu_time;
+        if (self->frame_time_callback_) {
+          self->frame_time_callback_(state.frame_start, gpu_time);
+        }
         state.smallest_timestamp = std::numeric_limits<float>::max();
         state.largest_timestamp = 0;
         FML_TRACE_COUNTER("flutter", "GPUTracer",
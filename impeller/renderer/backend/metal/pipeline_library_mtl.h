@@ -7,13 +7,37 @@
 
 #include <Metal/Metal.h>
 
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
+#include "impeller/core/backend_stats.h"
 #include "impeller/renderer/pipeline_library.h"
 
 namespace impeller {
 
 class ContextMTL;
 
+//------------------------------------------------------------------------------
+/// @brief      The binary archives that a |PipelineLibraryMTL| looks up
+///             compiled pipelines in, and records them to. Binary archives
+///             need iOS 14 or macOS 11, and are ignored on older versions.
+///
+struct PipelineArchivesMTL {
+  /// Paths of binary archives that were harvested before, for instance ones
+  /// that ship with the assets of the application. Pipelines found in them
+  /// are created without invoking the compiler of the driver.
+  std::vector<std::string> archive_paths;
+
+  /// If not empty, the functions of every pipeline that is created are added
+  /// to the binary archive at this path, which is written after each
+  /// addition. An existing archive is added to, so that several warmup runs
+  /// can cover different parts of an application.
+  std::string harvest_path;
+};
+
 class PipelineLibraryMTL final : public PipelineLibrary {
  public:
   PipelineLibraryMTL();
@@ -25,10 +49,32 @@ class PipelineLibraryMTL final : public PipelineLibrary {
   friend ContextMTL;
 
   id<MTLDevice> device_ = nullptr;
-  PipelineMap pipelines_;
-  ComputePipelineMap compute_pipelines_;
+  Mutex pipelines_mutex_;
+  PipelineMap pipelines_ IPLR_GUARDED_BY(pipelines_mutex_);
+  Mutex compute_pipelines_mutex_;
+  ComputePipelineMap compute_pipelines_
+      IPLR_GUARDED_BY(compute_pipelines_mutex_);
+  // Of |id<MTLBinaryArchive>|, which cannot be named on all supported OS
+  // versions.
+  NSArray* binary_archives_ = nil;
+  std::mutex harvest_mutex_;
+  id harvest_archive_ = nil;
+  NSURL* harvest_url_ = nil;
+  std::shared_ptr<BackendStats> backend_stats_;
+
+  PipelineLibraryMTL(id<MTLDevice> device,
+                     const PipelineArchivesMTL& archives,
+                     std::shared_ptr<BackendStats> backend_stats);
+
+  void AttachBinaryArchives(MTLRenderPipelineDescriptor* descriptor) const;
+
+  void AttachBinaryArchives(MTLComputePipelineDescriptor* descriptor) const;
+
+  void HarvestPipeline(MTLRenderPipelineDescriptor* descriptor);
+
+  void HarvestPipeline(MTLComputePipelineDescriptor* descriptor);
 
-  explicit PipelineLibraryMTL(id<MTLDevice> device);
+  void SerializeHarvestArchiveLocked();
 
   // |PipelineLibrary|
   bool IsValid() const override;
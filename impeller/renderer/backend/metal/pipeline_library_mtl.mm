@@ -9,6 +9,7 @@
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/container.h"
+#include "flutter/fml/logging.h"
 #include "impeller/base/promise.h"
 #include "impeller/renderer/backend/metal/compute_pipeline_mtl.h"
 #include "impeller/renderer/backend/metal/formats_mtl.h"
@@ -18,11 +19,119 @@
 
 namespace impeller {
 
-PipelineLibraryMTL::PipelineLibraryMTL(id<MTLDevice> device)
-    : device_(device) {}
+API_AVAILABLE(ios(14.0), macos(11.0))
+static id<MTLBinaryArchive> CreateBinaryArchive(id<MTLDevice> device,
+                                                NSURL* url) {
+  auto descriptor = [[MTLBinaryArchiveDescriptor alloc] init];
+  descriptor.url = url;
+  NSError* error = nil;
+  id<MTLBinaryArchive> archive =
+      [device newBinaryArchiveWithDescriptor:descriptor error:&error];
+  if (error != nil) {
+    FML_LOG(ERROR) << "Could not open pipeline binary archive "
+                   << (url != nil ? url.path.UTF8String : "")
+                   << ": " << error.localizedDescription.UTF8String;
+    return nil;
+  }
+  return archive;
+}
+
+PipelineLibraryMTL::PipelineLibraryMTL(
+    id<MTLDevice> device,
+    const PipelineArchivesMTL& archives,
+    std::shared_ptr<BackendStats> backend_stats)
+    : device_(device), backend_stats_(std::move(backend_stats)) {
+  if (@available(iOS 14.0, macOS 11.0, *)) {
+    NSMutableArray<id<MTLBinaryArchive>>* binary_archives =
+        [NSMutableArray array];
+    for (const auto& path : archives.archive_paths) {
+      NSURL* url = [NSURL fileURLWithPath:@(path.c_str())];
+      if (id<MTLBinaryArchive> archive = CreateBinaryArchive(device, url)) {
+        [binary_archives addObject:archive];
+      }
+    }
+    binary_archives_ = binary_archives;
+
+    if (!archives.harvest_path.empty()) {
+      harvest_url_ = [NSURL fileURLWithPath:@(archives.harvest_path.c_str())];
+      const bool exists = [[NSFileManager defaultManager]
+          fileExistsAtPath:harvest_url_.path];
+      harvest_archive_ =
+          CreateBinaryArchive(device, exists ? harvest_url_ : nil);
+    }
+  }
+}
 
 PipelineLibraryMTL::~PipelineLibraryMTL() = default;
 
+void PipelineLibraryMTL::AttachBinaryArchives(
+    MTLRenderPipelineDescriptor* descriptor) const {
+  if (@available(iOS 14.0, macOS 11.0, *)) {
+    if (binary_archives_.count > 0u) {
+      descriptor.binaryArchives = binary_archives_;
+    }
+  }
+}
+
+void PipelineLibraryMTL::AttachBinaryArchives(
+    MTLComputePipelineDescriptor* descriptor) const {
+  if (@available(iOS 14.0, macOS 11.0, *)) {
+    if (binary_archives_.count > 0u) {
+      descriptor.binaryArchives = binary_archives_;
+    }
+  }
+}
+
+void PipelineLibraryMTL::HarvestPipeline(
+    MTLRenderPipelineDescriptor* descriptor) {
+  if (@available(iOS 14.0, macOS 11.0, *)) {
+    std::scoped_lock lock(harvest_mutex_);
+    if (harvest_archive_ == nil) {
+      return;
+    }
+    NSError* error = nil;
+    if (![harvest_archive_ addRenderPipelineFunctionsWithDescriptor:descriptor
+                                                              error:&error]) {
+      FML_LOG(ERROR) << "Could not harvest render pipeline "
+                     << descriptor.label.UTF8String << ": "
+                     << error.localizedDescription.UTF8String;
+      return;
+    }
+    SerializeHarvestArchiveLocked();
+  }
+}
+
+void PipelineLibraryMTL::HarvestPipeline(
+    MTLComputePipelineDescriptor* descriptor) {
+  if (@available(iOS 14.0, macOS 11.0, *)) {
+    std::scoped_lock lock(harvest_mutex_);
+    if (harvest_archive_ == nil) {
+      return;
+    }
+    NSError* error = nil;
+    if (![harvest_archive_ addComputePipelineFunctionsWithDescriptor:descriptor
+                                                               error:&error]) {
+      FML_LOG(ERROR) << "Could not harvest compute pipeline "
+                     << descriptor.label.UTF8String << ": "
+                     << error.localizedDescription.UTF8String;
+      return;
+    }
+    SerializeHarvestArchiveLocked();
+  }
+}
+
+// Written after every addition, since applications are usually terminated
+// without a chance to write the archive on shutdown.
+void PipelineLibraryMTL::SerializeHarvestArchiveLocked() {
+  if (@available(iOS 14.0, macOS 11.0, *)) {
+    NSError* error = nil;
+    if (![harvest_archive_ serializeToURL:harvest_url_ error:&error]) {
+      FML_LOG(ERROR) << "Could not write pipeline binary archive: "
+                     << error.localizedDescription.UTF8String;
+    }
+  }
+}
+
 using Callback = std::function<void(MTLRenderPipelineDescriptor*)>;
 
 static void GetMTLRenderPipelineDescriptor(const PipelineDescriptor& desc,
@@ -110,6 +219,7 @@ bool PipelineLibraryMTL::IsValid() const {
 // |PipelineLibrary|
 PipelineFuture<PipelineDescriptor> PipelineLibraryMTL::GetPipeline(
     PipelineDescriptor descriptor) {
+  Lock lock(pipelines_mutex_);
   if (auto found = pipelines_.find(descriptor); found != pipelines_.end()) {
     return found->second;
   }
@@ -125,6 +235,9 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryMTL::GetPipeline(
   auto pipeline_future =
       PipelineFuture<PipelineDescriptor>{descriptor, promise->get_future()};
   pipelines_[descriptor] = pipeline_future;
+  if (backend_stats_) {
+    backend_stats_->Record(BackendObject::kPipeline);
+  }
   auto weak_this = weak_from_this();
 
   auto completion_handler =
@@ -153,8 +266,13 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryMTL::GetPipeline(
         promise->set_value(new_pipeline);
       };
   GetMTLRenderPipelineDescriptor(
-      descriptor, [device = device_, completion_handler](
+      descriptor, [weak_this, device = device_, completion_handler](
                       MTLRenderPipelineDescriptor* descriptor) {
+        if (auto strong_this = weak_this.lock()) {
+          auto& library = static_cast<PipelineLibraryMTL&>(*strong_this);
+          library.AttachBinaryArchives(descriptor);
+          library.HarvestPipeline(descriptor);
+        }
         [device newRenderPipelineStateWithDescriptor:descriptor
                                    completionHandler:completion_handler];
       });
@@ -163,6 +281,7 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryMTL::GetPipeline(
 
 PipelineFuture<ComputePipelineDescriptor> PipelineLibraryMTL::GetPipeline(
     ComputePipelineDescriptor descriptor) {
+  Lock lock(compute_pipelines_mutex_);
   if (auto found = compute_pipelines_.find(descriptor);
       found != compute_pipelines_.end()) {
     return found->second;
@@ -180,6 +299,9 @@ PipelineFuture<ComputePipelineDescriptor> PipelineLibraryMTL::GetPipeline(
   auto pipeline_future = PipelineFuture<ComputePipelineDescriptor>{
       descriptor, promise->get_future()};
   compute_pipelines_[descriptor] = pipeline_future;
+  if (backend_stats_) {
+    backend_stats_->Record(BackendObject::kPipeline);
+  }
   auto weak_this = weak_from_this();
 
   auto completion_handler =
@@ -208,17 +330,19 @@ PipelineFuture<ComputePipelineDescriptor> PipelineLibraryMTL::GetPipeline(
                                    ));
         promise->set_value(new_pipeline);
       };
-  [device_
-      newComputePipelineStateWithDescriptor:GetMTLComputePipelineDescriptor(
-                                                descriptor)
-                                    options:MTLPipelineOptionNone
-                          completionHandler:completion_handler];
+  auto compute_descriptor = GetMTLComputePipelineDescriptor(descriptor);
+  AttachBinaryArchives(compute_descriptor);
+  HarvestPipeline(compute_descriptor);
+  [device_ newComputePipelineStateWithDescriptor:compute_descriptor
+                                         options:MTLPipelineOptionNone
+                               completionHandler:completion_handler];
   return pipeline_future;
 }
 
 // |PipelineLibrary|
 void PipelineLibraryMTL::RemovePipelinesWithEntryPoint(
     std::shared_ptr<const ShaderFunction> function) {
+  Lock lock(pipelines_mutex_);
   fml::erase_if(pipelines_, [&](auto item) {
     return item->first.GetEntrypointForStage(function->GetStage())
         ->IsEqual(*function);
@@ -13,6 +13,8 @@
 
 namespace impeller {
 
+class ContextMTL;
+
 class RenderPassMTL final : public RenderPass {
  public:
   // |RenderPass|
@@ -42,6 +44,26 @@ class RenderPassMTL final : public RenderPass {
   bool EncodeCommands(const std::shared_ptr<Allocator>& transients_allocator,
                       id<MTLRenderCommandEncoder> pass) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Encodes the commands in [command_begin, command_end) into the
+  ///             given encoder. Each encoder starts out with no state, so
+  ///             ranges may be encoded concurrently into different
+  ///             sub-encoders of a parallel render command encoder.
+  ///
+  bool EncodeCommands(const std::shared_ptr<Allocator>& transients_allocator,
+                      id<MTLRenderCommandEncoder> pass,
+                      size_t command_begin,
+                      size_t command_end) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Splits the commands of the pass across the worker threads of
+  ///             the context, each filling a sub-encoder of a
+  ///             MTLParallelRenderCommandEncoder. Blocks until all of them
+  ///             are done.
+  ///
+  bool EncodeCommandsInParallel(const ContextMTL& context,
+                                size_t chunk_count) const;
+
   RenderPassMTL(const RenderPassMTL&) = delete;
 
   RenderPassMTL& operator=(const RenderPassMTL&) = delete;
@@ -4,9 +4,13 @@
 
 #include "impeller/renderer/backend/metal/render_pass_mtl.h"
 
+#include <algorithm>
+
 #include "flutter/fml/closure.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/core/formats.h"
@@ -23,6 +27,10 @@
 
 namespace impeller {
 
+// Passes with fewer commands per worker than this are encoded on the calling
+// thread. Below this, the cost of handing work to the workers dominates.
+static constexpr size_t kMinCommandsPerParallelEncoder = 256u;
+
 static bool ConfigureResolveTextureAttachment(
     const Attachment& desc,
     MTLRenderPassAttachmentDescriptor* attachment) {
@@ -164,6 +172,15 @@ bool RenderPassMTL::OnEncodeCommands(const Context& context) const {
   if (!IsValid()) {
     return false;
   }
+
+  const auto& context_mtl = ContextMTL::Cast(context);
+  const auto chunk_count =
+      std::min(context_mtl.GetAvailableWorkerCount(),
+               commands_.size() / kMinCommandsPerParallelEncoder);
+  if (chunk_count > 1u) {
+    return EncodeCommandsInParallel(context_mtl, chunk_count);
+  }
+
   auto render_command_encoder =
       [buffer_ renderCommandEncoderWithDescriptor:desc_];
 
@@ -180,9 +197,78 @@ bool RenderPassMTL::OnEncodeCommands(const Context& context) const {
   fml::ScopedCleanupClosure auto_end(
       [render_command_encoder]() { [render_command_encoder endEncoding]; });
 
+#ifdef IMPELLER_DEBUG
+  const auto encode_start = fml::TimePoint::Now();
+  fml::ScopedCleanupClosure record_encode_time([&context, encode_start]() {
+    ContextMTL::Cast(context).GetGPUTracer()->RecordEncodeTime(
+        fml::TimePoint::Now() - encode_start);
+  });
+#endif  // IMPELLER_DEBUG
+
   return EncodeCommands(context.GetResourceAllocator(), render_command_encoder);
 }
 
+bool RenderPassMTL::EncodeCommandsInParallel(const ContextMTL& context,
+                                             size_t chunk_count) const {
+  TRACE_EVENT0("impeller", "RenderPassMTL::EncodeCommandsInParallel");
+  auto parallel_encoder =
+      [buffer_ parallelRenderCommandEncoderWithDescriptor:desc_];
+  if (!parallel_encoder) {
+    return false;
+  }
+
+  if (!label_.empty()) {
+    [parallel_encoder setLabel:@(label_.c_str())];
+  }
+
+  fml::ScopedCleanupClosure auto_end(
+      [parallel_encoder]() { [parallel_encoder endEncoding]; });
+
+  // Sub-encoders execute in the order they were created, so they are all
+  // created up front on this thread.
+  std::vector<id<MTLRenderCommandEncoder>> encoders;
+  encoders.reserve(chunk_count);
+  for (size_t i = 0; i < chunk_count; i++) {
+    auto encoder = [parallel_encoder renderCommandEncoder];
+    if (!encoder) {
+      for (const auto& created : encoders) {
+        [created endEncoding];
+      }
+      return false;
+    }
+    encoders.push_back(encoder);
+  }
+
+#ifdef IMPELLER_DEBUG
+  const auto encode_start = fml::TimePoint::Now();
+#endif  // IMPELLER_DEBUG
+
+  const auto allocator = context.GetResourceAllocator();
+  const auto commands_per_chunk =
+      (commands_.size() + chunk_count - 1u) / chunk_count;
+  std::vector<char> results(chunk_count, false);
+  fml::CountDownLatch latch(chunk_count);
+  auto worker_task_runner = context.GetWorkerTaskRunner();
+  for (size_t i = 0; i < chunk_count; i++) {
+    worker_task_runner->PostTask([&, i]() {
+      const auto begin = std::min(i * commands_per_chunk, commands_.size());
+      const auto end = std::min(begin + commands_per_chunk, commands_.size());
+      results[i] = EncodeCommands(allocator, encoders[i], begin, end);
+      [encoders[i] endEncoding];
+      latch.CountDown();
+    });
+  }
+  latch.Wait();
+
+#ifdef IMPELLER_DEBUG
+  context.GetGPUTracer()->RecordEncodeTime(fml::TimePoint::Now() -
+                                           encode_start);
+#endif  // IMPELLER_DEBUG
+
+  return std::all_of(results.begin(), results.end(),
+                     [](char result) { return result; });
+}
+
 //-----------------------------------------------------------------------------
 /// @brief      Ensures that bindings on the pass are not redundantly set or
 ///             updated. Avoids making the driver do additional checks and makes
@@ -336,6 +422,39 @@ struct PassBindingsCache {
     scissor_ = scissor;
   }
 
+  void SetFrontFacingWinding(MTLWinding winding) {
+    if (winding_.has_value() && winding_.value() == winding) {
+      return;
+    }
+    [encoder_ setFrontFacingWinding:winding];
+    winding_ = winding;
+  }
+
+  void SetCullMode(MTLCullMode cull_mode) {
+    if (cull_mode_.has_value() && cull_mode_.value() == cull_mode) {
+      return;
+    }
+    [encoder_ setCullMode:cull_mode];
+    cull_mode_ = cull_mode;
+  }
+
+  void SetTriangleFillMode(MTLTriangleFillMode fill_mode) {
+    if (fill_mode_.has_value() && fill_mode_.value() == fill_mode) {
+      return;
+    }
+    [encoder_ setTriangleFillMode:fill_mode];
+    fill_mode_ = fill_mode;
+  }
+
+  void SetStencilReferenceValue(uint32_t reference) {
+    if (stencil_reference_.has_value() &&
+        stencil_reference_.value() == reference) {
+      return;
+    }
+    [encoder_ setStencilReferenceValue:reference];
+    stencil_reference_ = reference;
+  }
+
  private:
   struct BufferOffsetPair {
     id<MTLBuffer> buffer = nullptr;
@@ -353,6 +472,10 @@ struct PassBindingsCache {
   std::map<ShaderStage, SamplerMap> samplers_;
   std::optional<Viewport> viewport_;
   std::optional<IRect> scissor_;
+  std::optional<MTLWinding> winding_;
+  std::optional<MTLCullMode> cull_mode_;
+  std::optional<MTLTriangleFillMode> fill_mode_;
+  std::optional<uint32_t> stencil_reference_;
 };
 
 static bool Bind(PassBindingsCache& pass,
@@ -405,6 +528,13 @@ static bool Bind(PassBindingsCache& pass,
 
 bool RenderPassMTL::EncodeCommands(const std::shared_ptr<Allocator>& allocator,
                                    id<MTLRenderCommandEncoder> encoder) const {
+  return EncodeCommands(allocator, encoder, 0u, commands_.size());
+}
+
+bool RenderPassMTL::EncodeCommands(const std::shared_ptr<Allocator>& allocator,
+                                   id<MTLRenderCommandEncoder> encoder,
+                                   size_t command_begin,
+                                   size_t command_end) const {
   PassBindingsCache pass_bindings(encoder);
   auto bind_stage_resources = [&allocator, &pass_bindings](
                                   const Bindings& bindings,
@@ -427,7 +557,8 @@ bool RenderPassMTL::EncodeCommands(const std::shared_ptr<Allocator>& allocator,
   const auto target_sample_count = render_target_.GetSampleCount();
 
   fml::closure pop_debug_marker = [encoder]() { [encoder popDebugGroup]; };
-  for (const auto& command : commands_) {
+  for (auto i = command_begin; i < command_end; i++) {
+    const auto& command = commands_[i];
 #ifdef IMPELLER_DEBUG
     fml::ScopedCleanupClosure auto_pop_debug_marker(pop_debug_marker);
     if (!command.label.empty()) {
@@ -457,14 +588,14 @@ bool RenderPassMTL::EncodeCommands(const std::shared_ptr<Allocator>& allocator,
     pass_bindings.SetScissor(
         command.scissor.value_or(IRect::MakeSize(GetRenderTargetSize())));
 
-    [encoder setFrontFacingWinding:pipeline_desc.GetWindingOrder() ==
-                                           WindingOrder::kClockwise
-                                       ? MTLWindingClockwise
-                                       : MTLWindingCounterClockwise];
-    [encoder setCullMode:ToMTLCullMode(pipeline_desc.GetCullMode())];
-    [encoder setTriangleFillMode:ToMTLTriangleFillMode(
-                                     pipeline_desc.GetPolygonMode())];
-    [encoder setStencilReferenceValue:command.stencil_reference];
+    pass_bindings.SetFrontFacingWinding(
+        pipeline_desc.GetWindingOrder() == WindingOrder::kClockwise
+            ? MTLWindingClockwise
+            : MTLWindingCounterClockwise);
+    pass_bindings.SetCullMode(ToMTLCullMode(pipeline_desc.GetCullMode()));
+    pass_bindings.SetTriangleFillMode(
+        ToMTLTriangleFillMode(pipeline_desc.GetPolygonMode()));
+    pass_bindings.SetStencilReferenceValue(command.stencil_reference);
 
     if (!Bind(pass_bindings, *allocator, ShaderStage::kVertex,
               VertexDescriptor::kReservedVertexBufferIndex,
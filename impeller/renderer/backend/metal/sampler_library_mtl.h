@@ -12,6 +12,7 @@
 #include "flutter/fml/macros.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/base/comparable.h"
+#include "impeller/core/backend_stats.h"
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/renderer/sampler_library.h"
 
@@ -29,8 +30,10 @@ class SamplerLibraryMTL final
 
   id<MTLDevice> device_ = nullptr;
   SamplerMap samplers_;
+  std::shared_ptr<BackendStats> backend_stats_;
 
-  explicit SamplerLibraryMTL(id<MTLDevice> device);
+  SamplerLibraryMTL(id<MTLDevice> device,
+                    std::shared_ptr<BackendStats> backend_stats);
 
   // |SamplerLibrary|
   std::shared_ptr<const Sampler> GetSampler(
@@ -9,7 +9,10 @@
 
 namespace impeller {
 
-SamplerLibraryMTL::SamplerLibraryMTL(id<MTLDevice> device) : device_(device) {}
+SamplerLibraryMTL::SamplerLibraryMTL(
+    id<MTLDevice> device,
+    std::shared_ptr<BackendStats> backend_stats)
+    : device_(device), backend_stats_(std::move(backend_stats)) {}
 
 SamplerLibraryMTL::~SamplerLibraryMTL() = default;
 
@@ -46,6 +49,7 @@ std::shared_ptr<const Sampler> SamplerLibraryMTL::GetSampler(
     return nullptr;
   }
   samplers_[descriptor] = sampler;
+  backend_stats_->Record(BackendObject::kSampler);
   return sampler;
 }
 
@@ -421,12 +421,22 @@ std::shared_ptr<Texture> AllocatorVK::OnCreateTexture(
   if (!source->IsValid()) {
     return nullptr;
   }
+  frame_texture_count_++;
   return std::make_shared<TextureVK>(context_, std::move(source));
 }
 
 void AllocatorVK::DidAcquireSurfaceFrame() {
+  FML_TRACE_COUNTER("impeller", "AllocatorVK",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "BufferCount", frame_buffer_count_.exchange(0),
+                    "BufferBytes", frame_buffer_bytes_.exchange(0),
+                    "TextureCount", frame_texture_count_.exchange(0));
   frame_count_++;
   raster_thread_id_ = std::this_thread::get_id();
+  // Lets VMA attribute allocations and budget queries to frames.
+  if (is_valid_) {
+    ::vmaSetCurrentFrameIndex(allocator_.get(), frame_count_);
+  }
 }
 
 // |Allocator|
@@ -471,6 +481,8 @@ std::shared_ptr<DeviceBuffer> AllocatorVK::OnCreateBuffer(
     return {};
   }
 
+  frame_buffer_count_++;
+  frame_buffer_bytes_ += desc.size;
   return std::make_shared<DeviceBufferVK>(
       desc,                                            //
       context_,                                        //
@@ -14,6 +14,7 @@
 #include "impeller/renderer/backend/vulkan/vk.h"
 
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <memory>
 
@@ -39,6 +40,11 @@ class AllocatorVK final : public Allocator {
   bool created_buffer_pool_ = true;
   uint32_t frame_count_ = 0;
   std::thread::id raster_thread_id_;
+  // Resources created since the last surface frame was acquired. Resources
+  // may be created on any thread.
+  std::atomic<uint32_t> frame_buffer_count_ = 0;
+  std::atomic<uint64_t> frame_buffer_bytes_ = 0;
+  std::atomic<uint32_t> frame_texture_count_ = 0;
 
   AllocatorVK(std::weak_ptr<Context> context,
               uint32_t vulkan_api_version,
@@ -3,6 +3,9 @@
 // found in the LICENSE file.
 
 #include "impeller/renderer/backend/vulkan/binding_helpers_vk.h"
+
+#include <algorithm>
+
 #include "fml/status.h"
 #include "impeller/core/shader_types.h"
 #include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
@@ -65,6 +68,7 @@ static bool BindBuffers(const Bindings& bindings,
                         const std::shared_ptr<CommandEncoderVK>& encoder,
                         vk::DescriptorSet& vk_desc_set,
                         const std::vector<DescriptorSetLayout>& desc_set,
+                        bool dynamic_uniform_buffers,
                         std::vector<vk::DescriptorBufferInfo>& buffers,
                         std::vector<vk::WriteDescriptorSet>& writes) {
   for (const BufferAndUniformSlot& data : bindings.buffers) {
@@ -112,7 +116,10 @@ static bool BindBuffers(const Bindings& bindings,
     write_set.dstSet = vk_desc_set;
     write_set.dstBinding = uniform.binding;
     write_set.descriptorCount = 1u;
-    write_set.descriptorType = ToVKDescriptorType(layout.descriptor_type);
+    write_set.descriptorType =
+        dynamic_uniform_buffers
+            ? ToVKDynamicDescriptorType(layout.descriptor_type)
+            : ToVKDescriptorType(layout.descriptor_type);
     write_set.pBufferInfo = &buffers.back();
 
     writes.push_back(write_set);
@@ -120,46 +127,68 @@ static bool BindBuffers(const Bindings& bindings,
   return true;
 }
 
-fml::StatusOr<std::vector<vk::DescriptorSet>> AllocateAndBindDescriptorSets(
+static bool IsSameDescriptor(const vk::WriteDescriptorSet& a,
+                             const vk::WriteDescriptorSet& b) {
+  if (a.dstBinding != b.dstBinding || a.descriptorType != b.descriptorType) {
+    return false;
+  }
+  if (a.pBufferInfo || b.pBufferInfo) {
+    return a.pBufferInfo && b.pBufferInfo && *a.pBufferInfo == *b.pBufferInfo;
+  }
+  return a.pImageInfo && b.pImageInfo && *a.pImageInfo == *b.pImageInfo;
+}
+
+/// Moves the offsets of the dynamic uniform buffers written by |writes| into
+/// |dynamic_offsets|, ordered by binding as vkCmdBindDescriptorSets expects.
+static void ExtractDynamicOffsets(
+    const std::vector<vk::WriteDescriptorSet>& writes,
+    size_t first_write,
+    std::vector<vk::DescriptorBufferInfo>& buffers,
+    size_t first_buffer,
+    std::vector<uint32_t>& dynamic_offsets) {
+  std::vector<std::pair<uint32_t, size_t>> dynamic_buffers;
+  for (auto i = first_write; i < writes.size(); i++) {
+    if (writes[i].descriptorType == vk::DescriptorType::eUniformBufferDynamic) {
+      dynamic_buffers.emplace_back(
+          writes[i].dstBinding,
+          static_cast<size_t>(writes[i].pBufferInfo - buffers.data()));
+    }
+  }
+  std::sort(dynamic_buffers.begin(), dynamic_buffers.end());
+  for (const auto& [_, buffer_index] : dynamic_buffers) {
+    FML_DCHECK(buffer_index >= first_buffer);
+    auto& buffer_info = buffers[buffer_index];
+    dynamic_offsets.push_back(static_cast<uint32_t>(buffer_info.offset));
+    buffer_info.offset = 0u;
+  }
+}
+
+fml::StatusOr<DescriptorSetsVK> AllocateAndBindDescriptorSets(
     const ContextVK& context,
     const std::shared_ptr<CommandEncoderVK>& encoder,
     const std::vector<Command>& commands,
     const TextureVK& input_attachment) {
   if (commands.empty()) {
-    return std::vector<vk::DescriptorSet>{};
+    return DescriptorSetsVK{};
   }
 
-  // Step 1: Determine the total number of buffer and sampler descriptor
-  // sets required. Collect this information along with the layout information
-  // to allocate a correctly sized descriptor pool.
+  // Step 1: Determine the upper bound of buffer and sampler descriptors
+  // required so that the descriptor infos below are never reallocated.
   size_t buffer_count = 0;
   size_t samplers_count = 0;
   size_t subpass_count = 0;
-  std::vector<vk::DescriptorSetLayout> layouts;
-  layouts.reserve(commands.size());
-
   for (const auto& command : commands) {
     buffer_count += command.vertex_bindings.buffers.size();
     buffer_count += command.fragment_bindings.buffers.size();
     samplers_count += command.fragment_bindings.sampled_images.size();
     subpass_count +=
         command.pipeline->GetDescriptor().UsesSubpassInput() ? 1 : 0;
-
-    layouts.emplace_back(
-        PipelineVK::Cast(*command.pipeline).GetDescriptorSetLayout());
-  }
-  auto descriptor_result = encoder->AllocateDescriptorSets(
-      buffer_count, samplers_count, subpass_count, layouts);
-  if (!descriptor_result.ok()) {
-    return descriptor_result.status();
-  }
-  auto descriptor_sets = descriptor_result.value();
-  if (descriptor_sets.empty()) {
-    return fml::Status();
   }
 
-  // Step 2: Update the descriptors for all image and buffer descriptors used
-  // in the render pass.
+  // Step 2: Collect the descriptor writes of every command. Uniform buffers
+  // are bound with dynamic offsets, so a command that writes the same
+  // descriptors as the previous one with the same layout reuses its
+  // descriptor set instead of allocating and updating a new one.
   std::vector<vk::DescriptorImageInfo> images;
   std::vector<vk::DescriptorBufferInfo> buffers;
   std::vector<vk::WriteDescriptorSet> writes;
@@ -167,19 +196,38 @@ fml::StatusOr<std::vector<vk::DescriptorSet>> AllocateAndBindDescriptorSets(
   buffers.reserve(buffer_count);
   writes.reserve(samplers_count + buffer_count + subpass_count);
 
+  DescriptorSetsVK result;
+  result.dynamic_offset_ranges.reserve(commands.size());
+  result.dynamic_offsets.reserve(buffer_count);
+
+  // The layouts of the descriptor sets to allocate, the first write of each
+  // of them, and the set used by each command.
+  std::vector<vk::DescriptorSetLayout> layouts;
+  std::vector<size_t> set_first_writes;
+  std::vector<size_t> command_sets;
+  layouts.reserve(commands.size());
+  set_first_writes.reserve(commands.size());
+  command_sets.reserve(commands.size());
+
   auto& allocator = *context.GetResourceAllocator();
-  auto desc_index = 0u;
+  vk::DescriptorSet pending_set;
   for (const auto& command : commands) {
     auto desc_set = command.pipeline->GetDescriptor()
                         .GetVertexDescriptor()
                         ->GetDescriptorSetLayouts();
-
-    if (!BindBuffers(command.vertex_bindings, allocator, encoder,
-                     descriptor_sets[desc_index], desc_set, buffers, writes) ||
+    auto layout = PipelineVK::Cast(*command.pipeline).GetDescriptorSetLayout();
+
+    const size_t first_write = writes.size();
+    const size_t first_buffer = buffers.size();
+    const size_t first_image = images.size();
+    if (!BindBuffers(command.vertex_bindings, allocator, encoder, pending_set,
+                     desc_set, /*dynamic_uniform_buffers=*/true, buffers,
+                     writes) ||
         !BindBuffers(command.fragment_bindings, allocator, encoder,
-                     descriptor_sets[desc_index], desc_set, buffers, writes) ||
-        !BindImages(command.fragment_bindings, allocator, encoder,
-                    descriptor_sets[desc_index], images, writes)) {
+                     pending_set, desc_set, /*dynamic_uniform_buffers=*/true,
+                     buffers, writes) ||
+        !BindImages(command.fragment_bindings, allocator, encoder, pending_set,
+                    images, writes)) {
       return fml::Status(fml::StatusCode::kUnknown,
                          "Failed to bind texture or buffer.");
     }
@@ -192,7 +240,7 @@ fml::StatusOr<std::vector<vk::DescriptorSet>> AllocateAndBindDescriptorSets(
       images.push_back(image_info);
 
       vk::WriteDescriptorSet write_set;
-      write_set.dstSet = descriptor_sets[desc_index];
+      write_set.dstSet = pending_set;
       write_set.dstBinding = kMagicSubpassInputBinding;
       write_set.descriptorCount = 1u;
       write_set.descriptorType = vk::DescriptorType::eInputAttachment;
@@ -200,11 +248,63 @@ fml::StatusOr<std::vector<vk::DescriptorSet>> AllocateAndBindDescriptorSets(
 
       writes.push_back(write_set);
     }
-    desc_index += 1;
+
+    const size_t first_offset = result.dynamic_offsets.size();
+    ExtractDynamicOffsets(writes, first_write, buffers, first_buffer,
+                          result.dynamic_offsets);
+    result.dynamic_offset_ranges.push_back(
+        Range{first_offset, result.dynamic_offsets.size() - first_offset});
+
+    bool reuse_previous_set = false;
+    if (!layouts.empty() && layouts.back() == layout) {
+      const size_t previous_first_write = set_first_writes.back();
+      const size_t previous_count = first_write - previous_first_write;
+      reuse_previous_set = previous_count == writes.size() - first_write;
+      for (auto i = 0u; reuse_previous_set && i < previous_count; i++) {
+        reuse_previous_set = IsSameDescriptor(
+            writes[previous_first_write + i], writes[first_write + i]);
+      }
+    }
+
+    if (reuse_previous_set) {
+      writes.resize(first_write);
+      buffers.resize(first_buffer);
+      images.resize(first_image);
+    } else {
+      layouts.push_back(layout);
+      set_first_writes.push_back(first_write);
+    }
+    command_sets.push_back(layouts.size() - 1);
+  }
+
+  // Step 3: Allocate the descriptor sets that are actually needed and update
+  // all of them at once.
+  auto descriptor_result = encoder->AllocateDescriptorSets(
+      buffers.size(), images.size(), subpass_count, layouts);
+  if (!descriptor_result.ok()) {
+    return descriptor_result.status();
+  }
+  auto descriptor_sets = descriptor_result.value();
+  if (descriptor_sets.empty()) {
+    return fml::Status();
+  }
+
+  for (auto i = 0u; i < set_first_writes.size(); i++) {
+    const size_t last_write = i + 1 < set_first_writes.size()
+                                  ? set_first_writes[i + 1]
+                                  : writes.size();
+    for (auto j = set_first_writes[i]; j < last_write; j++) {
+      writes[j].dstSet = descriptor_sets[i];
+    }
+  }
+
+  result.sets.reserve(commands.size());
+  for (auto set_index : command_sets) {
+    result.sets.push_back(descriptor_sets[set_index]);
   }
 
   context.GetDevice().updateDescriptorSets(writes, {});
-  return descriptor_sets;
+  return result;
 }
 
 fml::StatusOr<std::vector<vk::DescriptorSet>> AllocateAndBindDescriptorSets(
@@ -253,7 +353,8 @@ fml::StatusOr<std::vector<vk::DescriptorSet>> AllocateAndBindDescriptorSets(
     auto desc_set = command.pipeline->GetDescriptor().GetDescriptorSetLayouts();
 
     if (!BindBuffers(command.bindings, allocator, encoder,
-                     descriptor_sets[desc_index], desc_set, buffers, writes) ||
+                     descriptor_sets[desc_index], desc_set,
+                     /*dynamic_uniform_buffers=*/false, buffers, writes) ||
         !BindImages(command.bindings, allocator, encoder,
                     descriptor_sets[desc_index], images, writes)) {
       return fml::Status(fml::StatusCode::kUnknown,
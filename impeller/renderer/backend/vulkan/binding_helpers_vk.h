@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "fml/status_or.h"
+#include "impeller/core/range.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/texture_vk.h"
 #include "impeller/renderer/command.h"
@@ -15,7 +16,24 @@
 
 namespace impeller {
 
-fml::StatusOr<std::vector<vk::DescriptorSet>> AllocateAndBindDescriptorSets(
+//------------------------------------------------------------------------------
+/// @brief      The descriptor sets and dynamic uniform buffer offsets of the
+///             commands in a render pass.
+///
+///             Consecutive commands with the same pipeline layout and the same
+///             buffers, images, and samplers share a descriptor set. They only
+///             differ by their dynamic offsets.
+///
+struct DescriptorSetsVK {
+  /// One descriptor set per command, possibly repeated.
+  std::vector<vk::DescriptorSet> sets;
+  /// The dynamic offsets of all commands, ordered by binding per command.
+  std::vector<uint32_t> dynamic_offsets;
+  /// The range of |dynamic_offsets| used by each command.
+  std::vector<Range> dynamic_offset_ranges;
+};
+
+fml::StatusOr<DescriptorSetsVK> AllocateAndBindDescriptorSets(
     const ContextVK& context,
     const std::shared_ptr<CommandEncoderVK>& encoder,
     const std::vector<Command>& commands,
@@ -161,6 +161,10 @@ static const char* GetDeviceExtensionName(OptionalDeviceExtensionVK ext) {
       return VK_ARM_RASTERIZATION_ORDER_ATTACHMENT_ACCESS_EXTENSION_NAME;
     case OptionalDeviceExtensionVK::kEXTRasterizationOrderAttachmentAccess:
       return VK_EXT_RASTERIZATION_ORDER_ATTACHMENT_ACCESS_EXTENSION_NAME;
+    case OptionalDeviceExtensionVK::kKHRTimelineSemaphore:
+      return VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME;
+    case OptionalDeviceExtensionVK::kGOOGLEDisplayTiming:
+      return VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME;
     case OptionalDeviceExtensionVK::kLast:
       return "Unknown";
   }
@@ -253,6 +257,13 @@ static bool HasSuitableDepthStencilFormat(const vk::PhysicalDevice& device,
             vk::FormatFeatureFlagBits::eDepthStencilAttachment);
 }
 
+static bool HasSuitableSampledFormat(const vk::PhysicalDevice& device,
+                                     vk::Format format) {
+  const auto props = device.getFormatProperties(format);
+  return !!(props.optimalTilingFeatures &
+            vk::FormatFeatureFlagBits::eSampledImage);
+}
+
 static bool PhysicalDeviceSupportsRequiredFormats(
     const vk::PhysicalDevice& device) {
   const auto has_color_format =
@@ -318,6 +329,36 @@ CapabilitiesVK::GetEnabledDeviceFeatures(
   // necessarily a big deal if we don't have this feature.
   required.fillModeNonSolid = device_features.fillModeNonSolid;
 
+  // Block compressed image data is uploaded as is where the device supports
+  // its format, and decoded to uncompressed pixels where it doesn't.
+  required.textureCompressionASTC_LDR =
+      device_features.textureCompressionASTC_LDR;
+  required.textureCompressionETC2 = device_features.textureCompressionETC2;
+  required.textureCompressionBC = device_features.textureCompressionBC;
+
+  return required;
+}
+
+std::optional<vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>
+CapabilitiesVK::GetEnabledTimelineSemaphoreFeatures(
+    const vk::PhysicalDevice& device) const {
+  auto exts = GetSupportedDeviceExtensions(device);
+  if (!exts.has_value() ||
+      exts->find(GetDeviceExtensionName(
+          OptionalDeviceExtensionVK::kKHRTimelineSemaphore)) == exts->end()) {
+    return std::nullopt;
+  }
+
+  auto features =
+      device.getFeatures2<vk::PhysicalDeviceFeatures2,
+                          vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>();
+  if (!features.get<vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>()
+           .timelineSemaphore) {
+    return std::nullopt;
+  }
+
+  vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR required;
+  required.timelineSemaphore = true;
   return required;
 }
 
@@ -376,6 +417,26 @@ bool CapabilitiesVK::SetPhysicalDevice(const vk::PhysicalDevice& device) {
              .supportedOperations &
          vk::SubgroupFeatureFlagBits::eArithmetic);
 
+  {
+    // Query the block compressed formats that can be sampled from. These are
+    // only available if the matching feature is enabled for the device.
+    const auto features = device.getFeatures();
+    block_compressed_formats_.clear();
+    if (features.textureCompressionASTC_LDR &&
+        HasSuitableSampledFormat(device, vk::Format::eAstc4x4UnormBlock)) {
+      block_compressed_formats_.insert(PixelFormat::kASTC4x4UNormInt);
+    }
+    if (features.textureCompressionETC2 &&
+        HasSuitableSampledFormat(device,
+                                 vk::Format::eEtc2R8G8B8A8UnormBlock)) {
+      block_compressed_formats_.insert(PixelFormat::kETC2R8G8B8A8UNormInt);
+    }
+    if (features.textureCompressionBC &&
+        HasSuitableSampledFormat(device, vk::Format::eBc7UnormBlock)) {
+      block_compressed_formats_.insert(PixelFormat::kBC7UNormInt);
+    }
+  }
+
   {
     // Query texture support.
     // TODO(jonahwilliams):
@@ -407,7 +468,7 @@ bool CapabilitiesVK::SetPhysicalDevice(const vk::PhysicalDevice& device) {
   }
 
   {
-    supports_framebuffer_fetch_ =
+    supports_rasterization_order_attachment_access_ =
         (optional_device_extensions_.find(
              OptionalDeviceExtensionVK::
                  kARMRasterizationOrderAttachmentAccess) !=
@@ -416,8 +477,16 @@ bool CapabilitiesVK::SetPhysicalDevice(const vk::PhysicalDevice& device) {
              OptionalDeviceExtensionVK::
                  kEXTRasterizationOrderAttachmentAccess) !=
              optional_device_extensions_.end());
+    // Input attachments are core Vulkan. Without rasterization order
+    // attachment access, reads are synchronized with subpass self-dependency
+    // barriers instead, which is still cheaper than copying the backdrop into
+    // a separate texture for every advanced blend.
+    supports_framebuffer_fetch_ = true;
   }
 
+  supports_timeline_semaphores_ =
+      GetEnabledTimelineSemaphoreFeatures(device).has_value();
+
   return true;
 }
 
@@ -451,6 +520,14 @@ bool CapabilitiesVK::SupportsFramebufferFetch() const {
   return supports_framebuffer_fetch_;
 }
 
+bool CapabilitiesVK::SupportsRasterizationOrderAttachmentAccess() const {
+  return supports_rasterization_order_attachment_access_;
+}
+
+bool CapabilitiesVK::SupportsTimelineSemaphores() const {
+  return supports_timeline_semaphores_;
+}
+
 // |Capabilities|
 bool CapabilitiesVK::SupportsCompute() const {
   // Vulkan 1.1 requires support for compute.
@@ -477,6 +554,12 @@ bool CapabilitiesVK::SupportsDeviceTransientTextures() const {
   return supports_device_transient_textures_;
 }
 
+// |Capabilities|
+bool CapabilitiesVK::SupportsBlockCompressedFormat(PixelFormat format) const {
+  return block_compressed_formats_.find(format) !=
+         block_compressed_formats_.end();
+}
+
 // |Capabilities|
 PixelFormat CapabilitiesVK::GetDefaultColorFormat() const {
   return default_color_format_;
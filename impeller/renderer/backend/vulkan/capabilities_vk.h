@@ -24,6 +24,8 @@ enum class OptionalDeviceExtensionVK : uint32_t {
   kEXTPipelineCreationFeedback,
   kARMRasterizationOrderAttachmentAccess,
   kEXTRasterizationOrderAttachmentAccess,
+  kKHRTimelineSemaphore,
+  kGOOGLEDisplayTiming,
   kLast,
 };
 
@@ -53,6 +55,17 @@ class CapabilitiesVK final : public Capabilities,
   std::optional<vk::PhysicalDeviceFeatures> GetEnabledDeviceFeatures(
       const vk::PhysicalDevice& physical_device) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The timeline semaphore features to chain into the logical
+  ///             device create info.
+  ///
+  /// @return     The features, or `std::nullopt` if the physical device does
+  ///             not support timeline semaphores.
+  ///
+  std::optional<vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>
+  GetEnabledTimelineSemaphoreFeatures(
+      const vk::PhysicalDevice& physical_device) const;
+
   [[nodiscard]] bool SetPhysicalDevice(
       const vk::PhysicalDevice& physical_device);
 
@@ -93,6 +106,9 @@ class CapabilitiesVK final : public Capabilities,
   // |Capabilities|
   bool SupportsDeviceTransientTextures() const override;
 
+  // |Capabilities|
+  bool SupportsBlockCompressedFormat(PixelFormat format) const override;
+
   // |Capabilities|
   PixelFormat GetDefaultColorFormat() const override;
 
@@ -102,6 +118,22 @@ class CapabilitiesVK final : public Capabilities,
   // |Capabilities|
   PixelFormat GetDefaultDepthStencilFormat() const override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether reads of the color attachment through an input
+  ///             attachment are ordered with earlier writes in the same
+  ///             subpass by the hardware. When false, framebuffer fetch is
+  ///             emulated with a subpass self-dependency and a pipeline
+  ///             barrier before each draw that reads the attachment.
+  ///
+  bool SupportsRasterizationOrderAttachmentAccess() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the logical device was created with timeline
+  ///             semaphores enabled. When true, queue submissions signal a
+  ///             single timeline instead of a fence each.
+  ///
+  bool SupportsTimelineSemaphores() const;
+
  private:
   bool validations_enabled_ = false;
   std::map<std::string, std::set<std::string>> exts_;
@@ -112,7 +144,10 @@ class CapabilitiesVK final : public Capabilities,
   vk::PhysicalDeviceProperties device_properties_;
   bool supports_compute_subgroups_ = false;
   bool supports_device_transient_textures_ = false;
+  std::set<PixelFormat> block_compressed_formats_;
   bool supports_framebuffer_fetch_ = false;
+  bool supports_rasterization_order_attachment_access_ = false;
+  bool supports_timeline_semaphores_ = false;
   bool is_valid_ = false;
 
   bool HasExtension(const std::string& ext) const;
@@ -55,13 +55,21 @@ bool CommandBufferVK::OnSubmitCommands(CompletionCallback callback) {
   if (!encoder_) {
     encoder_ = encoder_factory_->Create();
   }
+  auto work_type = CommandEncoderVK::WorkType::kGraphics;
+  if (has_compute_passes_ && !has_graphics_passes_) {
+    work_type = CommandEncoderVK::WorkType::kCompute;
+  } else if (upload_only_ && !has_compute_passes_) {
+    work_type = CommandEncoderVK::WorkType::kUpload;
+  }
   if (!callback) {
-    return encoder_->Submit();
+    return encoder_->Submit({}, work_type);
   }
-  return encoder_->Submit([callback](bool submitted) {
-    callback(submitted ? CommandBuffer::Status::kCompleted
-                       : CommandBuffer::Status::kError);
-  });
+  return encoder_->Submit(
+      [callback](bool submitted) {
+        callback(submitted ? CommandBuffer::Status::kCompleted
+                           : CommandBuffer::Status::kError);
+      },
+      work_type);
 }
 
 void CommandBufferVK::OnWaitUntilScheduled() {}
@@ -72,6 +80,7 @@ std::shared_ptr<RenderPass> CommandBufferVK::OnCreateRenderPass(
   if (!context) {
     return nullptr;
   }
+  has_graphics_passes_ = true;
   auto pass =
       std::shared_ptr<RenderPassVK>(new RenderPassVK(context,          //
                                                      target,           //
@@ -87,6 +96,7 @@ std::shared_ptr<BlitPass> CommandBufferVK::OnCreateBlitPass() {
   if (!IsValid()) {
     return nullptr;
   }
+  has_graphics_passes_ = true;
   auto pass = std::shared_ptr<BlitPassVK>(new BlitPassVK(weak_from_this()));
   if (!pass->IsValid()) {
     return nullptr;
@@ -102,6 +112,7 @@ std::shared_ptr<ComputePass> CommandBufferVK::OnCreateComputePass() {
   if (!context) {
     return nullptr;
   }
+  has_compute_passes_ = true;
   auto pass =
       std::shared_ptr<ComputePassVK>(new ComputePassVK(context,          //
                                                        weak_from_this()  //
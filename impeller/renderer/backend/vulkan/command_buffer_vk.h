@@ -31,6 +31,10 @@ class CommandBufferVK final
 
   std::shared_ptr<CommandEncoderVK> encoder_;
   std::shared_ptr<CommandEncoderFactoryVK> encoder_factory_;
+  // Command buffers with only compute passes may be submitted to the compute
+  // queue.
+  bool has_compute_passes_ = false;
+  bool has_graphics_passes_ = false;
 
   CommandBufferVK(std::weak_ptr<const Context> context,
                   std::shared_ptr<CommandEncoderFactoryVK> encoder_factory);
@@ -33,6 +33,9 @@ class TrackedObjectsVK {
   }
 
   ~TrackedObjectsVK() {
+    for (auto& [pool, buffer] : secondary_buffers_) {
+      pool->CollectCommandBuffer(std::move(buffer));
+    }
     if (!buffer_) {
       return;
     }
@@ -76,6 +79,14 @@ class TrackedObjectsVK {
     return tracked_textures_.find(texture) != tracked_textures_.end();
   }
 
+  void Track(std::shared_ptr<CommandPoolVK> pool,
+             vk::UniqueCommandBuffer buffer) {
+    if (!pool || !buffer) {
+      return;
+    }
+    secondary_buffers_.emplace_back(std::move(pool), std::move(buffer));
+  }
+
   vk::CommandBuffer GetCommandBuffer() const { return *buffer_; }
 
   DescriptorPoolVK& GetDescriptorPool() { return desc_pool_; }
@@ -87,6 +98,11 @@ class TrackedObjectsVK {
   // `shared_ptr` since command buffers have a link to the command pool.
   std::shared_ptr<CommandPoolVK> pool_;
   vk::UniqueCommandBuffer buffer_;
+  // Secondary command buffers recorded on other threads with the pools they
+  // were allocated from.
+  std::vector<std::pair<std::shared_ptr<CommandPoolVK>,
+                        vk::UniqueCommandBuffer>>
+      secondary_buffers_;
   std::set<std::shared_ptr<SharedObjectVK>> tracked_objects_;
   std::set<std::shared_ptr<const Buffer>> tracked_buffers_;
   std::set<std::shared_ptr<const TextureSourceVK>> tracked_textures_;
@@ -142,20 +158,34 @@ std::shared_ptr<CommandEncoderVK> CommandEncoderFactoryVK::Create() {
   tracked_objects->GetGPUProbe().RecordCmdBufferStart(
       tracked_objects->GetCommandBuffer());
 
-  return std::make_shared<CommandEncoderVK>(context->GetDeviceHolder(),
-                                            tracked_objects, queue,
-                                            context->GetFenceWaiter());
+  // Command buffers from the thread local pool may only be submitted to
+  // queues of the graphics queue family.
+  auto same_family_queue = [&queue](std::shared_ptr<QueueVK> other) {
+    if (!other || other->GetIndex().family != queue->GetIndex().family) {
+      return std::shared_ptr<QueueVK>{};
+    }
+    return other;
+  };
+
+  return std::make_shared<CommandEncoderVK>(
+      context->GetDeviceHolder(), tracked_objects, queue,
+      context->GetFenceWaiter(), same_family_queue(context->GetComputeQueue()),
+      same_family_queue(context->GetTransferQueue()));
 }
 
 CommandEncoderVK::CommandEncoderVK(
     std::weak_ptr<const DeviceHolder> device_holder,
     std::shared_ptr<TrackedObjectsVK> tracked_objects,
     const std::shared_ptr<QueueVK>& queue,
-    std::shared_ptr<FenceWaiterVK> fence_waiter)
+    std::shared_ptr<FenceWaiterVK> fence_waiter,
+    std::shared_ptr<QueueVK> compute_queue,
+    std::shared_ptr<QueueVK> transfer_queue)
     : device_holder_(std::move(device_holder)),
       tracked_objects_(std::move(tracked_objects)),
       queue_(queue),
-      fence_waiter_(std::move(fence_waiter)) {}
+      fence_waiter_(std::move(fence_waiter)),
+      compute_queue_(std::move(compute_queue)),
+      transfer_queue_(std::move(transfer_queue)) {}
 
 CommandEncoderVK::~CommandEncoderVK() = default;
 
@@ -163,7 +193,18 @@ bool CommandEncoderVK::IsValid() const {
   return is_valid_;
 }
 
-bool CommandEncoderVK::Submit(SubmitCallback callback) {
+// The stages of graphics queue work that may consume the results of work
+// on other queues, such as tessellated vertices, storage buffers or uploaded
+// textures.
+static constexpr vk::PipelineStageFlags kSideQueueConsumerStages =
+    vk::PipelineStageFlagBits::eDrawIndirect |
+    vk::PipelineStageFlagBits::eVertexInput |
+    vk::PipelineStageFlagBits::eVertexShader |
+    vk::PipelineStageFlagBits::eFragmentShader |
+    vk::PipelineStageFlagBits::eComputeShader |
+    vk::PipelineStageFlagBits::eTransfer;
+
+bool CommandEncoderVK::Submit(SubmitCallback callback, WorkType work_type) {
   // Make sure to call callback with `false` if anything returns early.
   bool fail_callback = !!callback;
   if (!IsValid()) {
@@ -198,34 +239,97 @@ bool CommandEncoderVK::Submit(SubmitCallback callback) {
     VALIDATION_LOG << "Device lost.";
     return false;
   }
+
+  vk::SubmitInfo submit_info;
+  std::vector<vk::CommandBuffer> buffers = {command_buffer};
+  submit_info.setCommandBuffers(buffers);
+
+  // Compute only and upload only work goes to the compute and transfer
+  // queues, if there are any, so that it may overlap with work on the
+  // graphics queue. It signals a semaphore the next graphics queue
+  // submission waits on.
+  std::shared_ptr<QueueVK> side_queue;
+  switch (work_type) {
+    case WorkType::kGraphics:
+      break;
+    case WorkType::kCompute:
+      side_queue = compute_queue_;
+      break;
+    case WorkType::kUpload:
+      side_queue = transfer_queue_;
+      break;
+  }
+  if (side_queue == queue_) {
+    side_queue = nullptr;
+  }
+  SharedHandleVK<vk::Semaphore> side_queue_semaphore;
+  if (side_queue) {
+    auto [semaphore_result, semaphore] =
+        strong_device->GetDevice().createSemaphoreUnique({});
+    if (semaphore_result != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Failed to create semaphore: "
+                     << vk::to_string(semaphore_result);
+      return false;
+    }
+    side_queue_semaphore = MakeSharedVK(std::move(semaphore));
+    submit_info.setSignalSemaphores(side_queue_semaphore->Get());
+  }
+
+  // Semaphores waited on by this submission are tracked once the submission
+  // is made. Hold a reference since the completion callback may run first.
+  std::shared_ptr<TrackedObjectsVK> tracked_objects = tracked_objects_;
+  std::vector<SharedHandleVK<vk::Semaphore>> waited;
+
+  auto on_completed = [callback, tracked_objects =
+                                     std::move(tracked_objects_)]() mutable {
+    // Ensure tracked objects are destructed before calling any final
+    // callbacks.
+    tracked_objects.reset();
+    if (callback) {
+      callback(true);
+    }
+  };
+
+  // Timeline values are signaled in submission order, so only the graphics
+  // queue signals the timeline semaphore.
+  if (!side_queue && fence_waiter_->UsesTimelineSemaphore()) {
+    if (!fence_waiter_->Submit(*queue_, submit_info, on_completed, &waited)) {
+      return false;
+    }
+    fail_callback = false;
+    for (auto& semaphore : waited) {
+      tracked_objects->Track(std::move(semaphore));
+    }
+    return true;
+  }
+
   auto [fence_result, fence] = strong_device->GetDevice().createFenceUnique({});
   if (fence_result != vk::Result::eSuccess) {
     VALIDATION_LOG << "Failed to create fence: " << vk::to_string(fence_result);
     return false;
   }
 
-  vk::SubmitInfo submit_info;
-  std::vector<vk::CommandBuffer> buffers = {command_buffer};
-  submit_info.setCommandBuffers(buffers);
-  status = queue_->Submit(submit_info, *fence);
+  if (side_queue) {
+    status = side_queue->Submit(submit_info, *fence);
+  } else {
+    status = queue_->Submit(submit_info, *fence, &waited);
+  }
   if (status != vk::Result::eSuccess) {
     VALIDATION_LOG << "Failed to submit queue: " << vk::to_string(status);
     return false;
   }
+  for (auto& semaphore : waited) {
+    tracked_objects->Track(std::move(semaphore));
+  }
+  if (side_queue) {
+    queue_->AddWaitSemaphore(std::move(side_queue_semaphore),
+                             kSideQueueConsumerStages);
+  }
 
   // Submit will proceed, call callback with true when it is done and do not
   // call when `reset` is collected.
   fail_callback = false;
-  return fence_waiter_->AddFence(
-      std::move(fence),
-      [callback, tracked_objects = std::move(tracked_objects_)]() mutable {
-        // Ensure tracked objects are destructed before calling any final
-        // callbacks.
-        tracked_objects.reset();
-        if (callback) {
-          callback(true);
-        }
-      });
+  return fence_waiter_->AddFence(std::move(fence), on_completed);
 }
 
 vk::CommandBuffer CommandEncoderVK::GetCommandBuffer() const {
@@ -258,6 +362,15 @@ bool CommandEncoderVK::Track(std::shared_ptr<const Buffer> buffer) {
   return true;
 }
 
+bool CommandEncoderVK::Track(std::shared_ptr<CommandPoolVK> pool,
+                             vk::UniqueCommandBuffer buffer) {
+  if (!IsValid()) {
+    return false;
+  }
+  tracked_objects_->Track(std::move(pool), std::move(buffer));
+  return true;
+}
+
 bool CommandEncoderVK::IsTracking(
     const std::shared_ptr<const Buffer>& buffer) const {
   if (!IsValid()) {
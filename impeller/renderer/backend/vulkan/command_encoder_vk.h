@@ -50,22 +50,55 @@ class CommandEncoderVK {
  public:
   using SubmitCallback = std::function<void(bool)>;
 
+  /// The kind of work recorded by the encoder, which determines the queue it
+  /// is submitted to.
+  enum class WorkType {
+    kGraphics,
+    /// Only compute work.
+    kCompute,
+    /// Only uploads into resources no prior work accesses.
+    kUpload,
+  };
+
   // Visible for testing.
   CommandEncoderVK(std::weak_ptr<const DeviceHolder> device_holder,
                    std::shared_ptr<TrackedObjectsVK> tracked_objects,
                    const std::shared_ptr<QueueVK>& queue,
-                   std::shared_ptr<FenceWaiterVK> fence_waiter);
+                   std::shared_ptr<FenceWaiterVK> fence_waiter,
+                   std::shared_ptr<QueueVK> compute_queue = nullptr,
+                   std::shared_ptr<QueueVK> transfer_queue = nullptr);
 
   ~CommandEncoderVK();
 
   bool IsValid() const;
 
-  bool Submit(SubmitCallback callback = {});
+  //----------------------------------------------------------------------------
+  /// @brief      Submits the recorded commands.
+  ///
+  /// @param[in]  callback   Invoked once the commands complete or the
+  ///                        submission fails.
+  /// @param[in]  work_type  The kind of work recorded. If there is a compute
+  ///                        or transfer queue distinct from the graphics
+  ///                        queue for it, the commands are submitted there
+  ///                        and the next graphics queue submission waits for
+  ///                        them.
+  ///
+  bool Submit(SubmitCallback callback = {},
+              WorkType work_type = WorkType::kGraphics);
 
   bool Track(std::shared_ptr<SharedObjectVK> object);
 
   bool Track(std::shared_ptr<const Buffer> buffer);
 
+  /// @brief      Keeps a secondary command buffer executed by this encoder's
+  ///             command buffer alive until the submission completes.
+  ///
+  /// @param[in]  pool    The pool the secondary command buffer was allocated
+  ///                     from.
+  /// @param[in]  buffer  The secondary command buffer.
+  bool Track(std::shared_ptr<CommandPoolVK> pool,
+             vk::UniqueCommandBuffer buffer);
+
   bool IsTracking(const std::shared_ptr<const Buffer>& texture) const;
 
   bool Track(const std::shared_ptr<const Texture>& texture);
@@ -95,6 +128,8 @@ class CommandEncoderVK {
   std::shared_ptr<TrackedObjectsVK> tracked_objects_;
   std::shared_ptr<QueueVK> queue_;
   const std::shared_ptr<FenceWaiterVK> fence_waiter_;
+  std::shared_ptr<QueueVK> compute_queue_;
+  std::shared_ptr<QueueVK> transfer_queue_;
   bool is_valid_ = true;
 
   void Reset();
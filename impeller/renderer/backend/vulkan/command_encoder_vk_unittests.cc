@@ -74,5 +74,73 @@ TEST(CommandEncoderVKTest, CleanupAfterSubmit) {
   EXPECT_TRUE(free_buffers < destroy_pool);
 }
 
+TEST(CommandEncoderVKTest, AsyncComputeSubmitsToComputeQueue) {
+  // The mock device exposes several queues in its only queue family, so
+  // compute only work gets its own queue and signals a semaphore the next
+  // graphics submission waits on.
+  std::shared_ptr<std::vector<std::string>> called_functions;
+  {
+    auto context = MockVulkanContextBuilder().Build();
+    ASSERT_NE(context->GetComputeQueue(), context->GetGraphicsQueue());
+    called_functions = GetMockVulkanFunctions(context->GetDevice());
+    CommandEncoderFactoryVK factory(context);
+
+    fml::AutoResetWaitableEvent compute_done;
+    std::shared_ptr<CommandEncoderVK> compute_encoder = factory.Create();
+    ASSERT_TRUE(compute_encoder->Submit(
+        [&](bool success) {
+          EXPECT_TRUE(success);
+          compute_done.Signal();
+        },
+        CommandEncoderVK::WorkType::kCompute));
+    compute_done.Wait();
+    EXPECT_EQ(std::count(called_functions->begin(), called_functions->end(),
+                         "vkCreateSemaphore"),
+              1);
+    // The graphics queue still holds on to the semaphore.
+    EXPECT_EQ(std::count(called_functions->begin(), called_functions->end(),
+                         "vkDestroySemaphore"),
+              0);
+
+    fml::AutoResetWaitableEvent graphics_done;
+    std::shared_ptr<CommandEncoderVK> graphics_encoder = factory.Create();
+    ASSERT_TRUE(graphics_encoder->Submit([&](bool success) {
+      EXPECT_TRUE(success);
+      graphics_done.Signal();
+    }));
+    graphics_done.Wait();
+    context->Shutdown();
+  }
+
+  EXPECT_EQ(std::count(called_functions->begin(), called_functions->end(),
+                       "vkDestroySemaphore"),
+            1);
+}
+
+TEST(CommandEncoderVKTest, UploadsSubmitToTransferQueue) {
+  std::shared_ptr<std::vector<std::string>> called_functions;
+  {
+    auto context = MockVulkanContextBuilder().Build();
+    ASSERT_NE(context->GetTransferQueue(), context->GetGraphicsQueue());
+    ASSERT_NE(context->GetTransferQueue(), context->GetComputeQueue());
+    called_functions = GetMockVulkanFunctions(context->GetDevice());
+    CommandEncoderFactoryVK factory(context);
+
+    fml::AutoResetWaitableEvent upload_done;
+    std::shared_ptr<CommandEncoderVK> encoder = factory.Create();
+    ASSERT_TRUE(encoder->Submit(
+        [&](bool success) {
+          EXPECT_TRUE(success);
+          upload_done.Signal();
+        },
+        CommandEncoderVK::WorkType::kUpload));
+    upload_done.Wait();
+    EXPECT_EQ(std::count(called_functions->begin(), called_functions->end(),
+                         "vkCreateSemaphore"),
+              1);
+    context->Shutdown();
+  }
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -80,7 +80,8 @@ CommandPoolVK::~CommandPoolVK() {
 }
 
 // TODO(matanlurey): Return a status_or<> instead of {} when we have one.
-vk::UniqueCommandBuffer CommandPoolVK::CreateCommandBuffer() {
+vk::UniqueCommandBuffer CommandPoolVK::CreateCommandBuffer(
+    vk::CommandBufferLevel level) {
   auto const context = context_.lock();
   if (!context) {
     return {};
@@ -95,7 +96,7 @@ vk::UniqueCommandBuffer CommandPoolVK::CreateCommandBuffer() {
   vk::CommandBufferAllocateInfo info;
   info.setCommandPool(pool_.get());
   info.setCommandBufferCount(1u);
-  info.setLevel(vk::CommandBufferLevel::ePrimary);
+  info.setLevel(level);
   auto [result, buffers] = device.allocateCommandBuffersUnique(info);
   if (result != vk::Result::eSuccess) {
     return {};
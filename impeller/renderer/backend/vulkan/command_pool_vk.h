@@ -42,10 +42,14 @@ class CommandPoolVK final {
 
   /// @brief      Creates and returns a new |vk::CommandBuffer|.
   ///
+  /// @param[in]  level  Whether the command buffer is submitted to a queue
+  ///                    or executed by a primary command buffer.
+  ///
   /// @return     Always returns a new |vk::CommandBuffer|, but if for any
   ///             reason a valid command buffer could not be created, it will be
   ///             a `{}` default instance (i.e. while being torn down).
-  vk::UniqueCommandBuffer CreateCommandBuffer();
+  vk::UniqueCommandBuffer CreateCommandBuffer(
+      vk::CommandBufferLevel level = vk::CommandBufferLevel::ePrimary);
 
   /// @brief      Collects the given |vk::CommandBuffer| to be retained.
   ///
@@ -55,8 +55,10 @@ static std::optional<vk::PhysicalDevice> PickPhysicalDevice(
   return std::nullopt;
 }
 
+// The create infos point into |priorities|, which must outlive them.
 static std::vector<vk::DeviceQueueCreateInfo> GetQueueCreateInfos(
-    std::initializer_list<QueueIndexVK> queues) {
+    std::initializer_list<QueueIndexVK> queues,
+    std::vector<std::vector<float>>& priorities) {
   std::map<size_t /* family */, size_t /* index */> family_index_map;
   for (const auto& queue : queues) {
     family_index_map[queue.family] = 0;
@@ -66,13 +68,19 @@ static std::vector<vk::DeviceQueueCreateInfo> GetQueueCreateInfos(
     family_index_map[queue.family] = std::max(value, queue.index);
   }
 
-  static float kQueuePriority = 1.0f;
+  // All of the priorities are created before any of the infos refer to them,
+  // so that they are not moved by a reallocation of |priorities|.
+  priorities.clear();
+  for (const auto& item : family_index_map) {
+    priorities.emplace_back(item.second + 1, 1.0f);
+  }
   std::vector<vk::DeviceQueueCreateInfo> infos;
+  size_t family = 0;
   for (const auto& item : family_index_map) {
     vk::DeviceQueueCreateInfo info;
     info.setQueueFamilyIndex(item.first);
-    info.setQueueCount(item.second + 1);
-    info.setQueuePriorities(kQueuePriority);
+    // Sets the queue count to the number of priorities.
+    info.setQueuePriorities(priorities[family++]);
     infos.push_back(info);
   }
   return infos;
@@ -92,6 +100,26 @@ static std::optional<QueueIndexVK> PickQueue(const vk::PhysicalDevice& device,
   return std::nullopt;
 }
 
+// Picks the queue after the given one in the same queue family, used to give
+// async compute and upload work queues of their own. Using the graphics
+// queue family means resources need no queue family ownership transfers and
+// command buffers from the same pools may be submitted to any of the queues.
+static std::optional<QueueIndexVK> PickNextQueueInFamily(
+    const vk::PhysicalDevice& device,
+    const QueueIndexVK& queue,
+    vk::QueueFlags flags) {
+  const auto families = device.getQueueFamilyProperties();
+  if (queue.family >= families.size()) {
+    return std::nullopt;
+  }
+  const auto& family = families[queue.family];
+  if ((family.queueFlags & flags) != flags ||
+      family.queueCount <= queue.index + 1) {
+    return std::nullopt;
+  }
+  return QueueIndexVK{.family = queue.family, .index = queue.index + 1};
+}
+
 std::shared_ptr<ContextVK> ContextVK::Create(Settings settings) {
   auto context = std::shared_ptr<ContextVK>(new ContextVK());
   context->Setup(std::move(settings));
@@ -288,6 +316,23 @@ void ContextVK::Setup(Settings settings) {
     VALIDATION_LOG << "Could not pick compute queue.";
     return;
   }
+  if (auto async_compute_queue = PickNextQueueInFamily(
+          device_holder->physical_device, graphics_queue.value(),
+          vk::QueueFlagBits::eCompute);
+      async_compute_queue.has_value()) {
+    compute_queue = async_compute_queue;
+  }
+  // Uploads record blits for mipmap generation, so the transfer queue needs
+  // to support graphics work too.
+  if (auto upload_queue = PickNextQueueInFamily(
+          device_holder->physical_device,
+          compute_queue->family == graphics_queue->family
+              ? compute_queue.value()
+              : graphics_queue.value(),
+          vk::QueueFlagBits::eGraphics);
+      upload_queue.has_value()) {
+    transfer_queue = upload_queue;
+  }
 
   //----------------------------------------------------------------------------
   /// Create the logical device.
@@ -305,8 +350,10 @@ void ContextVK::Setup(Settings settings) {
     enabled_device_extensions_c.push_back(ext.c_str());
   }
 
+  std::vector<std::vector<float>> queue_priorities;
   const auto queue_create_infos = GetQueueCreateInfos(
-      {graphics_queue.value(), compute_queue.value(), transfer_queue.value()});
+      {graphics_queue.value(), compute_queue.value(), transfer_queue.value()},
+      queue_priorities);
 
   const auto enabled_features =
       caps->GetEnabledDeviceFeatures(device_holder->physical_device);
@@ -321,6 +368,11 @@ void ContextVK::Setup(Settings settings) {
   device_info.setQueueCreateInfos(queue_create_infos);
   device_info.setPEnabledExtensionNames(enabled_device_extensions_c);
   device_info.setPEnabledFeatures(&enabled_features.value());
+  auto timeline_semaphore_features =
+      caps->GetEnabledTimelineSemaphoreFeatures(device_holder->physical_device);
+  if (timeline_semaphore_features.has_value()) {
+    device_info.setPNext(&timeline_semaphore_features.value());
+  }
   // Device layers are deprecated and ignored.
 
   {
@@ -354,15 +406,17 @@ void ContextVK::Setup(Settings settings) {
     VALIDATION_LOG << "Could not create memory allocator.";
     return;
   }
+  allocator->SetBackendStats(GetBackendStats());
 
   //----------------------------------------------------------------------------
   /// Setup the pipeline library.
   ///
   auto pipeline_library = std::shared_ptr<PipelineLibraryVK>(
-      new PipelineLibraryVK(device_holder,                         //
-                            caps,                                  //
-                            std::move(settings.cache_directory),   //
-                            raster_message_loop_->GetTaskRunner()  //
+      new PipelineLibraryVK(device_holder,                          //
+                            caps,                                   //
+                            std::move(settings.cache_directory),    //
+                            raster_message_loop_->GetTaskRunner(),  //
+                            GetBackendStats()                       //
                             ));
 
   if (!pipeline_library->IsValid()) {
@@ -371,7 +425,8 @@ void ContextVK::Setup(Settings settings) {
   }
 
   auto sampler_library =
-      std::shared_ptr<SamplerLibraryVK>(new SamplerLibraryVK(device_holder));
+      std::shared_ptr<SamplerLibraryVK>(new SamplerLibraryVK(
+          device_holder, GetBackendStats()));
 
   auto shader_library = std::shared_ptr<ShaderLibraryVK>(
       new ShaderLibraryVK(device_holder,                   //
@@ -386,8 +441,8 @@ void ContextVK::Setup(Settings settings) {
   //----------------------------------------------------------------------------
   /// Create the fence waiter.
   ///
-  auto fence_waiter =
-      std::shared_ptr<FenceWaiterVK>(new FenceWaiterVK(device_holder));
+  auto fence_waiter = std::shared_ptr<FenceWaiterVK>(new FenceWaiterVK(
+      device_holder, caps->SupportsTimelineSemaphores()));
 
   //----------------------------------------------------------------------------
   /// Create the resource manager and command pool recycler.
@@ -536,6 +591,14 @@ const std::shared_ptr<QueueVK>& ContextVK::GetGraphicsQueue() const {
   return queues_.graphics_queue;
 }
 
+const std::shared_ptr<QueueVK>& ContextVK::GetComputeQueue() const {
+  return queues_.compute_queue;
+}
+
+const std::shared_ptr<QueueVK>& ContextVK::GetTransferQueue() const {
+  return queues_.transfer_queue;
+}
+
 vk::PhysicalDevice ContextVK::GetPhysicalDevice() const {
   return device_holder_->physical_device;
 }
@@ -562,4 +625,10 @@ std::shared_ptr<GPUTracerVK> ContextVK::GetGPUTracer() const {
   return gpu_tracer_;
 }
 
+void ContextVK::SetGPUFrameTimeCallback(GPUFrameTimeCallback callback) {
+  if (gpu_tracer_) {
+    gpu_tracer_->SetFrameTimeCallback(std::move(callback));
+  }
+}
+
 }  // namespace impeller
@@ -92,6 +92,9 @@ class ContextVK final : public Context,
   // |Context|
   void SetSyncPresentation(bool value) override { sync_presentation_ = value; }
 
+  // |Context|
+  void SetGPUFrameTimeCallback(GPUFrameTimeCallback callback) override;
+
   bool GetSyncPresentation() const { return sync_presentation_; }
 
   void SetOffscreenFormat(PixelFormat pixel_format);
@@ -152,6 +155,14 @@ class ContextVK final : public Context,
 
   const std::shared_ptr<QueueVK>& GetGraphicsQueue() const;
 
+  /// @brief The queue compute only command buffers are submitted to. May be
+  ///        the same as the graphics queue.
+  const std::shared_ptr<QueueVK>& GetComputeQueue() const;
+
+  /// @brief The queue upload only command buffers are submitted to. May be
+  ///        the same as the graphics queue.
+  const std::shared_ptr<QueueVK>& GetTransferQueue() const;
+
   vk::PhysicalDevice GetPhysicalDevice() const;
 
   std::shared_ptr<FenceWaiterVK> GetFenceWaiter() const;
@@ -7,6 +7,7 @@
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+#include "impeller/shader_archive/shader_archive_writer.h"
 
 namespace impeller {
 namespace testing {
@@ -98,6 +99,42 @@ TEST(ContextVKTest, DeleteShaderFunctionAfterContext) {
                         "vkDestroyDevice") != functions->end());
 }
 
+TEST(ContextVKTest, CreatesArchivedShaderModulesOnFirstUse) {
+  std::vector<uint8_t> spirv = {0x03, 0x02, 0x23, 0x07};
+  ShaderArchiveWriter writer;
+  ASSERT_TRUE(writer.AddShader(ArchiveShaderType::kVertex, "foo",
+                               std::make_shared<fml::DataMapping>(spirv)));
+  ASSERT_TRUE(writer.AddShader(ArchiveShaderType::kFragment, "foo",
+                               std::make_shared<fml::DataMapping>(spirv)));
+  auto archive = writer.CreateMapping();
+  ASSERT_TRUE(archive);
+
+  std::shared_ptr<ContextVK> context =
+      MockVulkanContextBuilder()
+          .SetSettingsCallback([&](ContextVK::Settings& settings) {
+            settings.shader_libraries_data = {archive};
+          })
+          .Build();
+  ASSERT_TRUE(context);
+  auto count_modules = [&]() {
+    auto functions = GetMockVulkanFunctions(context->GetDevice());
+    return std::count(functions->begin(), functions->end(),
+                      "vkCreateShaderModule");
+  };
+  EXPECT_EQ(count_modules(), 0);
+
+  auto library = context->GetShaderLibrary();
+  EXPECT_TRUE(
+      library->GetFunction("foo_fragment_main", ShaderStage::kFragment));
+  EXPECT_EQ(count_modules(), 1);
+  EXPECT_TRUE(
+      library->GetFunction("foo_fragment_main", ShaderStage::kFragment));
+  EXPECT_EQ(count_modules(), 1);
+  EXPECT_FALSE(
+      library->GetFunction("bar_fragment_main", ShaderStage::kFragment));
+  EXPECT_EQ(count_modules(), 1);
+}
+
 TEST(ContextVKTest, DeletePipelineLibraryAfterContext) {
   std::shared_ptr<PipelineLibrary> pipeline_library;
   std::shared_ptr<std::vector<std::string>> functions;
@@ -143,5 +180,56 @@ TEST(ContextVKTest, CanCreateContextWithValidationLayers) {
   ASSERT_TRUE(capabilites_vk->AreValidationsEnabled());
 }
 
+TEST(ContextVKTest, CreatesEveryQueueItHandsOut) {
+  auto context = MockVulkanContextBuilder().Build();
+  ASSERT_NE(context, nullptr);
+  auto priorities =
+      GetMockVulkanQueuePriorities(context->GetDevice(), /*family=*/0);
+  EXPECT_EQ(priorities, std::vector<float>({1.0f, 1.0f, 1.0f}));
+
+  const QueueIndexVK& compute = context->GetComputeQueue()->GetIndex();
+  EXPECT_EQ(compute.family, 0u);
+  EXPECT_EQ(compute.index, 1u);
+  for (const auto& queue : {context->GetGraphicsQueue(),
+                            context->GetComputeQueue(),
+                            context->GetTransferQueue()}) {
+    EXPECT_LT(queue->GetIndex().index, priorities.size());
+  }
+
+  auto functions = GetMockVulkanFunctions(context->GetDevice());
+  EXPECT_EQ(std::find(functions->begin(), functions->end(),
+                      "vkGetDeviceQueue (not created)"),
+            functions->end());
+}
+
+TEST(ContextVKTest, UsesATransferQueueOfTheGraphicsFamilyIfThereIsOne) {
+  auto context = MockVulkanContextBuilder().SetQueueCount(3).Build();
+  ASSERT_NE(context, nullptr);
+  EXPECT_EQ(GetMockVulkanQueuePriorities(context->GetDevice(), 0).size(), 3u);
+  const QueueIndexVK& transfer = context->GetTransferQueue()->GetIndex();
+  EXPECT_EQ(transfer.family, 0u);
+  EXPECT_EQ(transfer.index, 2u);
+  EXPECT_NE(context->GetTransferQueue(), context->GetGraphicsQueue());
+  EXPECT_NE(context->GetTransferQueue(), context->GetComputeQueue());
+}
+
+TEST(ContextVKTest, FallsBackToTheGraphicsQueueWithoutSpareQueues) {
+  for (uint32_t queue_count : {1u, 2u}) {
+    auto context =
+        MockVulkanContextBuilder().SetQueueCount(queue_count).Build();
+    ASSERT_NE(context, nullptr);
+    EXPECT_EQ(GetMockVulkanQueuePriorities(context->GetDevice(), 0).size(),
+              queue_count);
+    // With two queues, the second one is used for async compute.
+    EXPECT_EQ(context->GetComputeQueue()->GetIndex().index, queue_count - 1);
+    EXPECT_EQ(context->GetTransferQueue(), context->GetGraphicsQueue());
+
+    auto functions = GetMockVulkanFunctions(context->GetDevice());
+    EXPECT_EQ(std::find(functions->begin(), functions->end(),
+                        "vkGetDeviceQueue (not created)"),
+              functions->end());
+  }
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -111,6 +111,8 @@ DescriptorPoolVK::AllocateDescriptorSets(
                    << vk::to_string(result);
     return fml::Status(fml::StatusCode::kUnknown, "");
   }
+  strong_context->GetBackendStats()->Record(
+      BackendObject::kDescriptorSet, static_cast<uint32_t>(sets.size()));
   return sets;
 }
 
@@ -183,6 +185,8 @@ DescriptorPoolAndSize DescriptorPoolRecyclerVK::Create(
                              minimum_capacity},
       vk::DescriptorPoolSize{vk::DescriptorType::eUniformBuffer,
                              minimum_capacity},
+      vk::DescriptorPoolSize{vk::DescriptorType::eUniformBufferDynamic,
+                             minimum_capacity},
       vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer,
                              minimum_capacity},
       vk::DescriptorPoolSize{vk::DescriptorType::eInputAttachment,
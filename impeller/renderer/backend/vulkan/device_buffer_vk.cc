@@ -26,6 +26,13 @@ uint8_t* DeviceBufferVK::OnGetContents() const {
   return static_cast<uint8_t*>(resource_->info.pMappedData);
 }
 
+void DeviceBufferVK::Flush(std::optional<Range> range) const {
+  auto flush_range = range.value_or(Range{0, desc_.size});
+  ::vmaFlushAllocation(resource_->buffer.get().allocator,
+                       resource_->buffer.get().allocation, flush_range.offset,
+                       flush_range.length);
+}
+
 bool DeviceBufferVK::OnCopyHostBuffer(const uint8_t* source,
                                       Range source_range,
                                       size_t offset) {
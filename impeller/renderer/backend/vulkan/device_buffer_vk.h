@@ -58,6 +58,9 @@ class DeviceBufferVK final : public DeviceBuffer,
   // |DeviceBuffer|
   uint8_t* OnGetContents() const override;
 
+  // |DeviceBuffer|
+  void Flush(std::optional<Range> range) const override;
+
   // |DeviceBuffer|
   bool OnCopyHostBuffer(const uint8_t* source,
                         Range source_range,
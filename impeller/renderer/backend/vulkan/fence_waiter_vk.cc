@@ -20,27 +20,46 @@ class WaitSetEntry {
   static std::shared_ptr<WaitSetEntry> Create(vk::UniqueFence p_fence,
                                               const fml::closure& p_callback) {
     return std::shared_ptr<WaitSetEntry>(
-        new WaitSetEntry(std::move(p_fence), p_callback));
+        new WaitSetEntry(std::move(p_fence), 0u, p_callback));
   }
 
-  void UpdateSignalledStatus(const vk::Device& device) {
+  static std::shared_ptr<WaitSetEntry> Create(uint64_t p_timeline_value,
+                                              const fml::closure& p_callback) {
+    return std::shared_ptr<WaitSetEntry>(
+        new WaitSetEntry(vk::UniqueFence{}, p_timeline_value, p_callback));
+  }
+
+  void UpdateSignalledStatus(const vk::Device& device,
+                             uint64_t timeline_counter) {
     if (is_signalled_) {
       return;
     }
+    if (!fence_) {
+      is_signalled_ = timeline_value_ <= timeline_counter;
+      return;
+    }
     is_signalled_ = device.getFenceStatus(fence_.get()) == vk::Result::eSuccess;
   }
 
   const vk::Fence& GetFence() const { return fence_.get(); }
 
+  /// The value of the waiter's timeline semaphore that signals this entry,
+  /// or zero if it waits on a fence instead.
+  uint64_t GetTimelineValue() const { return fence_ ? 0u : timeline_value_; }
+
   bool IsSignalled() const { return is_signalled_; }
 
  private:
   vk::UniqueFence fence_;
+  uint64_t timeline_value_ = 0u;
   fml::ScopedCleanupClosure callback_;
   bool is_signalled_ = false;
 
-  WaitSetEntry(vk::UniqueFence p_fence, const fml::closure& p_callback)
+  WaitSetEntry(vk::UniqueFence p_fence,
+               uint64_t p_timeline_value,
+               const fml::closure& p_callback)
       : fence_(std::move(p_fence)),
+        timeline_value_(p_timeline_value),
         callback_(fml::ScopedCleanupClosure{p_callback}) {}
 
   WaitSetEntry(const WaitSetEntry&) = delete;
@@ -52,14 +71,81 @@ class WaitSetEntry {
   WaitSetEntry& operator=(WaitSetEntry&&) = delete;
 };
 
-FenceWaiterVK::FenceWaiterVK(std::weak_ptr<DeviceHolder> device_holder)
+FenceWaiterVK::FenceWaiterVK(std::weak_ptr<DeviceHolder> device_holder,
+                             bool use_timeline_semaphore)
     : device_holder_(std::move(device_holder)) {
+  if (auto strong_device = device_holder_.lock();
+      strong_device && use_timeline_semaphore) {
+    vk::StructureChain<vk::SemaphoreCreateInfo,
+                       vk::SemaphoreTypeCreateInfoKHR>
+        semaphore_chain;
+    semaphore_chain.get<vk::SemaphoreTypeCreateInfoKHR>()
+        .setSemaphoreType(vk::SemaphoreType::eTimeline)
+        .setInitialValue(0u);
+    auto [result, semaphore] = strong_device->GetDevice().createSemaphoreUnique(
+        semaphore_chain.get());
+    if (result == vk::Result::eSuccess) {
+      timeline_semaphore_ = std::move(semaphore);
+    } else {
+      VALIDATION_LOG << "Could not create timeline semaphore, falling back to "
+                        "fences: "
+                     << vk::to_string(result);
+    }
+  }
   waiter_thread_ = std::make_unique<std::thread>([&]() { Main(); });
 }
 
 FenceWaiterVK::~FenceWaiterVK() {
   Terminate();
   waiter_thread_->join();
+  if (!device_holder_.lock()) {
+    // The semaphore died with the device.
+    timeline_semaphore_.release();
+  }
+}
+
+bool FenceWaiterVK::UsesTimelineSemaphore() const {
+  return !!timeline_semaphore_;
+}
+
+bool FenceWaiterVK::Submit(
+    const QueueVK& queue,
+    vk::SubmitInfo submit_info,
+    const fml::closure& callback,
+    std::vector<SharedHandleVK<vk::Semaphore>>* waited) {
+  if (!timeline_semaphore_ || !callback) {
+    return false;
+  }
+
+  std::scoped_lock submit_lock(submit_mutex_);
+  {
+    std::scoped_lock lock(wait_set_mutex_);
+    if (terminate_) {
+      return false;
+    }
+  }
+
+  const uint64_t signal_value = last_submitted_value_ + 1u;
+  const vk::Semaphore semaphore = timeline_semaphore_.get();
+  vk::TimelineSemaphoreSubmitInfoKHR timeline_info;
+  timeline_info.setSignalSemaphoreValues(signal_value);
+  timeline_info.setPNext(submit_info.pNext);
+  submit_info.setSignalSemaphores(semaphore);
+  submit_info.setPNext(&timeline_info);
+
+  auto result = queue.Submit(submit_info, {}, waited);
+  if (result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Failed to submit queue: " << vk::to_string(result);
+    return false;
+  }
+  last_submitted_value_ = signal_value;
+
+  {
+    std::scoped_lock lock(wait_set_mutex_);
+    wait_set_.emplace_back(WaitSetEntry::Create(signal_value, callback));
+  }
+  wait_set_cv_.notify_one();
+  return true;
 }
 
 bool FenceWaiterVK::AddFence(vk::UniqueFence fence,
@@ -82,13 +168,27 @@ bool FenceWaiterVK::AddFence(vk::UniqueFence fence,
 static std::vector<vk::Fence> GetFencesForWaitSet(const WaitSet& set) {
   std::vector<vk::Fence> fences;
   for (const auto& entry : set) {
-    if (!entry->IsSignalled()) {
+    if (!entry->IsSignalled() && entry->GetFence()) {
       fences.emplace_back(entry->GetFence());
     }
   }
   return fences;
 }
 
+// The smallest timeline value that must be reached for any entry in the set
+// to be signaled. Zero if no entry waits on the timeline.
+static uint64_t GetTimelineValueForWaitSet(const WaitSet& set) {
+  uint64_t value = 0u;
+  for (const auto& entry : set) {
+    const auto entry_value = entry->GetTimelineValue();
+    if (!entry->IsSignalled() && entry_value != 0u &&
+        (value == 0u || entry_value < value)) {
+      value = entry_value;
+    }
+  }
+  return value;
+}
+
 void FenceWaiterVK::Main() {
   fml::Thread::SetCurrentThreadName(
       fml::Thread::ThreadConfig{"io.flutter.impeller.fence_waiter"});
@@ -152,15 +252,28 @@ bool FenceWaiterVK::Wait() {
   // to be signaled at an abnormally long deadline is the only one in the set,
   // a timeout will bail out the wait.
   auto fences = GetFencesForWaitSet(wait_set);
-  if (fences.empty()) {
+  const auto timeline_value = GetTimelineValueForWaitSet(wait_set);
+  if (fences.empty() && timeline_value == 0u) {
     return true;
   }
 
-  auto result = device.waitForFences(
-      /*fenceCount=*/fences.size(),
-      /*pFences=*/fences.data(),
-      /*waitAll=*/false,
-      /*timeout=*/std::chrono::nanoseconds{100ms}.count());
+  // Submissions signal the timeline in order, so waiting for the oldest
+  // pending value wakes up as soon as any entry can be completed.
+  vk::Result result;
+  if (timeline_value != 0u) {
+    const vk::Semaphore semaphore = timeline_semaphore_.get();
+    vk::SemaphoreWaitInfoKHR wait_info;
+    wait_info.setSemaphores(semaphore);
+    wait_info.setValues(timeline_value);
+    result = device.waitSemaphoresKHR(
+        wait_info, /*timeout=*/std::chrono::nanoseconds{100ms}.count());
+  } else {
+    result = device.waitForFences(
+        /*fenceCount=*/fences.size(),
+        /*pFences=*/fences.data(),
+        /*waitAll=*/false,
+        /*timeout=*/std::chrono::nanoseconds{100ms}.count());
+  }
   if (!(result == vk::Result::eSuccess || result == vk::Result::eTimeout)) {
     VALIDATION_LOG << "Fence waiter encountered an unexpected error. Tearing "
                       "down the waiter thread.";
@@ -171,8 +284,16 @@ bool FenceWaiterVK::Wait() {
   // their signaled statuses.
   {
     TRACE_EVENT0("impeller", "CheckFenceStatus");
+    uint64_t timeline_counter = 0u;
+    if (timeline_semaphore_) {
+      auto counter =
+          device.getSemaphoreCounterValueKHR(timeline_semaphore_.get());
+      if (counter.result == vk::Result::eSuccess) {
+        timeline_counter = counter.value;
+      }
+    }
     for (auto& entry : wait_set) {
-      entry->UpdateSignalledStatus(device);
+      entry->UpdateSignalledStatus(device, timeline_counter);
     }
     wait_set.clear();
   }
@@ -14,6 +14,7 @@
 #include "flutter/fml/macros.h"
 #include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
+#include "impeller/renderer/backend/vulkan/queue_vk.h"
 #include "impeller/renderer/backend/vulkan/shared_object_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 
@@ -34,17 +35,53 @@ class FenceWaiterVK {
 
   bool AddFence(vk::UniqueFence fence, const fml::closure& callback);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether submissions should go through |Submit| instead of
+  ///             creating a fence for |AddFence|.
+  ///
+  bool UsesTimelineSemaphore() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Submits work to the queue so that it signals the next value
+  ///             of the timeline semaphore of this waiter, and invokes the
+  ///             callback once the work has completed.
+  ///
+  ///             All submissions made through a waiter must target the same
+  ///             queue since timeline values are signaled in submission
+  ///             order. Any signal semaphores of the submit info are
+  ///             replaced.
+  ///
+  /// @param[in]  queue        The queue to submit to.
+  /// @param[in]  submit_info  The work to submit.
+  /// @param[in]  callback     The callback to invoke on completion.
+  /// @param[out] waited       Forwarded to |QueueVK::Submit|.
+  ///
+  /// @return     Whether the work was submitted and the callback will be
+  ///             invoked.
+  ///
+  bool Submit(
+      const QueueVK& queue,
+      vk::SubmitInfo submit_info,
+      const fml::closure& callback,
+      std::vector<SharedHandleVK<vk::Semaphore>>* waited = nullptr);
+
  private:
   friend class ContextVK;
 
   std::weak_ptr<DeviceHolder> device_holder_;
+  vk::UniqueSemaphore timeline_semaphore_;
+  // Guards the assignment of timeline values together with the submissions
+  // that signal them.
+  std::mutex submit_mutex_;
+  uint64_t last_submitted_value_ = 0u;
   std::unique_ptr<std::thread> waiter_thread_;
   std::mutex wait_set_mutex_;
   std::condition_variable wait_set_cv_;
   WaitSet wait_set_;
   bool terminate_ = false;
 
-  explicit FenceWaiterVK(std::weak_ptr<DeviceHolder> device_holder);
+  explicit FenceWaiterVK(std::weak_ptr<DeviceHolder> device_holder,
+                         bool use_timeline_semaphore = false);
 
   void Main();
 
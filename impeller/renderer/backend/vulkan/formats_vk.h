@@ -165,6 +165,12 @@ constexpr vk::Format ToVKImageFormat(PixelFormat format) {
       return vk::Format::eR8Unorm;
     case PixelFormat::kR8G8UNormInt:
       return vk::Format::eR8G8Unorm;
+    case PixelFormat::kASTC4x4UNormInt:
+      return vk::Format::eAstc4x4UnormBlock;
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+      return vk::Format::eEtc2R8G8B8A8UnormBlock;
+    case PixelFormat::kBC7UNormInt:
+      return vk::Format::eBc7UnormBlock;
   }
 
   FML_UNREACHABLE();
@@ -290,12 +296,31 @@ constexpr vk::DescriptorType ToVKDescriptorType(DescriptorType type) {
   FML_UNREACHABLE();
 }
 
+/// @brief      Like |ToVKDescriptorType| but with uniform buffers bound using
+///             dynamic offsets.
+///
+///             Descriptor sets of render pipelines use dynamic uniform
+///             buffers so that draws which only differ by the uniform data
+///             they read from the same buffer can share a descriptor set.
+///
+constexpr vk::DescriptorType ToVKDynamicDescriptorType(DescriptorType type) {
+  if (type == DescriptorType::kUniformBuffer) {
+    return vk::DescriptorType::eUniformBufferDynamic;
+  }
+  return ToVKDescriptorType(type);
+}
+
 constexpr vk::DescriptorSetLayoutBinding ToVKDescriptorSetLayoutBinding(
-    const DescriptorSetLayout& layout) {
+    const DescriptorSetLayout& layout,
+    bool dynamic_uniform_buffers = false) {
   vk::DescriptorSetLayoutBinding binding;
   binding.binding = layout.binding;
   binding.descriptorCount = 1u;
-  binding.descriptorType = ToVKDescriptorType(layout.descriptor_type);
+  if (dynamic_uniform_buffers) {
+    binding.descriptorType = ToVKDynamicDescriptorType(layout.descriptor_type);
+  } else {
+    binding.descriptorType = ToVKDescriptorType(layout.descriptor_type);
+  }
   binding.stageFlags = ToVkShaderStage(layout.shader_stage);
   return binding;
 }
@@ -385,6 +410,9 @@ constexpr bool PixelFormatIsDepthStencil(PixelFormat format) {
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kBC7UNormInt:
       return false;
     case PixelFormat::kS8UInt:
     case PixelFormat::kD24UnormS8Uint:
@@ -416,6 +444,9 @@ constexpr AttachmentKind AttachmentKindFromFormat(PixelFormat format) {
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kBC7UNormInt:
       return AttachmentKind::kColor;
     case PixelFormat::kS8UInt:
       return AttachmentKind::kStencil;
@@ -490,6 +521,37 @@ constexpr vk::AttachmentDescription CreateAttachmentDescription(
   return vk_attachment;
 }
 
+//------------------------------------------------------------------------------
+/// @brief      The self-dependency that lets a subpass read its own color
+///             attachment as an input attachment on devices without
+///             rasterization order attachment access. Each draw that reads
+///             the attachment must be preceded by a matching pipeline barrier
+///             (see `CreateFramebufferFetchBarrier`).
+///
+constexpr vk::SubpassDependency CreateFramebufferFetchSelfDependency() {
+  vk::SubpassDependency dependency;
+  dependency.srcSubpass = 0u;
+  dependency.dstSubpass = 0u;
+  dependency.srcStageMask = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+  dependency.dstStageMask = vk::PipelineStageFlagBits::eFragmentShader;
+  dependency.srcAccessMask = vk::AccessFlagBits::eColorAttachmentWrite;
+  dependency.dstAccessMask = vk::AccessFlagBits::eInputAttachmentRead;
+  dependency.dependencyFlags = vk::DependencyFlagBits::eByRegion;
+  return dependency;
+}
+
+//------------------------------------------------------------------------------
+/// @brief      The memory barrier recorded inside a render pass before a draw
+///             that reads the color attachment, matching
+///             `CreateFramebufferFetchSelfDependency`.
+///
+constexpr vk::MemoryBarrier CreateFramebufferFetchBarrier() {
+  vk::MemoryBarrier barrier;
+  barrier.srcAccessMask = vk::AccessFlagBits::eColorAttachmentWrite;
+  barrier.dstAccessMask = vk::AccessFlagBits::eInputAttachmentRead;
+  return barrier;
+}
+
 static constexpr vk::AttachmentReference kUnusedAttachmentReference = {
     VK_ATTACHMENT_UNUSED, vk::ImageLayout::eUndefined};
 
@@ -580,6 +642,9 @@ constexpr vk::ImageAspectFlags ToVKImageAspectFlags(PixelFormat format) {
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kBC7UNormInt:
       return vk::ImageAspectFlagBits::eColor;
     case PixelFormat::kS8UInt:
       return vk::ImageAspectFlagBits::eStencil;
@@ -654,6 +719,9 @@ constexpr vk::ImageAspectFlags ToImageAspectFlags(PixelFormat format) {
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kBC7UNormInt:
       return vk::ImageAspectFlagBits::eColor;
     case PixelFormat::kS8UInt:
       return vk::ImageAspectFlagBits::eStencil;
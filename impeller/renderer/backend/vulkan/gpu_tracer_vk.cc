@@ -92,6 +92,7 @@ void GPUTracerVK::RecordCmdBufferStart(const vk::CommandBuffer& buffer,
     trace_states_[current_state_].query_pool = std::move(pool);
     buffer.resetQueryPool(trace_states_[current_state_].query_pool.get(), 0,
                           kPoolSize);
+    state.frame_start = fml::TimePoint::Now();
   }
 
   // We size the query pool to kPoolSize, but Flutter applications can create an
@@ -134,6 +135,17 @@ void GPUTracerVK::RecordCmdBufferEnd(const vk::CommandBuffer& buffer,
   }
 }
 
+fml::TimeDelta GPUTracerVK::GetTotalGPUTime() const {
+  Lock lock(trace_state_mutex_);
+  return total_gpu_time_;
+}
+
+void GPUTracerVK::SetFrameTimeCallback(
+    Context::GPUFrameTimeCallback callback) {
+  Lock lock(trace_state_mutex_);
+  frame_time_callback_ = std::move(callback);
+}
+
 void GPUTracerVK::OnFenceComplete(size_t frame_index) {
   if (!enabled_) {
     return;
@@ -173,6 +185,11 @@ void GPUTracerVK::OnFenceComplete(size_t frame_index) {
     auto gpu_ms =
         (((largest_timestamp - smallest_timestamp) * timestamp_period_) /
          1000000);
+    auto gpu_time = fml::TimeDelta::FromMillisecondsF(gpu_ms);
+    total_gpu_time_ = total_gpu_time_ + gpu_time;
+    if (frame_time_callback_) {
+      frame_time_callback_(state.frame_start, gpu_time);
+    }
     FML_TRACE_COUNTER("flutter", "GPUTracer",
                       reinterpret_cast<int64_t>(this),  // Trace Counter ID
                       "FrameTimeMS", gpu_ms);
@@ -5,6 +5,7 @@
 #include <memory>
 #include <thread>
 
+#include "flutter/fml/time/time_delta.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
 #include "vulkan/vulkan_handles.hpp"
@@ -34,6 +35,14 @@ class GPUTracerVK : public std::enable_shared_from_this<GPUTracerVK> {
   /// @brief Signal the end of a frame workload.
   void MarkFrameEnd();
 
+  /// @brief The GPU time of all the frame workloads that have completed so
+  ///        far.
+  fml::TimeDelta GetTotalGPUTime() const;
+
+  /// @brief Set the callback that receives the GPU time of each frame
+  ///        workload.
+  void SetFrameTimeCallback(Context::GPUFrameTimeCallback callback);
+
   // visible for testing.
   bool IsEnabled() const;
 
@@ -61,12 +70,16 @@ class GPUTracerVK : public std::enable_shared_from_this<GPUTracerVK> {
     size_t current_index = 0;
     size_t pending_buffers = 0;
     vk::UniqueQueryPool query_pool;
+    fml::TimePoint frame_start;
   };
 
   mutable Mutex trace_state_mutex_;
   GPUTraceState trace_states_[kTraceStatesSize] IPLR_GUARDED_BY(
       trace_state_mutex_);
   size_t current_state_ IPLR_GUARDED_BY(trace_state_mutex_) = 0u;
+  fml::TimeDelta total_gpu_time_ IPLR_GUARDED_BY(trace_state_mutex_);
+  Context::GPUFrameTimeCallback frame_time_callback_
+      IPLR_GUARDED_BY(trace_state_mutex_);
 
   // The number of nanoseconds for each timestamp unit.
   float timestamp_period_ = 1;
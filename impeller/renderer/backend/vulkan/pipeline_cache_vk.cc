@@ -16,57 +16,40 @@ namespace impeller {
 static constexpr const char* kPipelineCacheFileName =
     "flutter.impeller.vkcache";
 
-static bool VerifyExistingCache(const fml::Mapping& mapping,
-                                const CapabilitiesVK& caps) {
-  return true;
-}
-
-static std::shared_ptr<fml::Mapping> DecorateCacheWithMetadata(
-    std::shared_ptr<fml::Mapping> data) {
-  return data;
-}
-
-static std::unique_ptr<fml::Mapping> RemoveMetadataFromCache(
-    std::unique_ptr<fml::Mapping> data) {
-  return data;
-}
-
-static std::unique_ptr<fml::Mapping> OpenCacheFile(
-    const fml::UniqueFD& base_directory,
-    const std::string& cache_file_name,
-    const CapabilitiesVK& caps) {
-  if (!base_directory.is_valid()) {
-    return nullptr;
-  }
-  std::unique_ptr<fml::Mapping> mapping =
-      fml::FileMapping::CreateReadOnly(base_directory, cache_file_name);
-  if (!mapping) {
-    return nullptr;
-  }
-  if (!VerifyExistingCache(*mapping, caps)) {
-    return nullptr;
-  }
-  mapping = RemoveMetadataFromCache(std::move(mapping));
-  if (!mapping) {
-    return nullptr;
-  }
-  return mapping;
+static constexpr const char* kPipelineUsageManifestFileName =
+    "flutter.impeller.vkpipelines";
+
+// Caches are only valid for the device and driver that created them. The
+// driver checks this too, but not all drivers can be trusted to.
+static std::string GetCacheVersion(const CapabilitiesVK& caps) {
+  const vk::PhysicalDeviceProperties& properties =
+      caps.GetPhysicalDeviceProperties();
+  std::stringstream stream;
+  stream << "vulkan:" << properties.vendorID << ":" << properties.deviceID
+         << ":" << properties.driverVersion << ":";
+  for (uint8_t byte : properties.pipelineCacheUUID) {
+    stream << static_cast<uint32_t>(byte) << ".";
+  }
+  return stream.str();
 }
 
 PipelineCacheVK::PipelineCacheVK(std::shared_ptr<const Capabilities> caps,
                                  std::shared_ptr<DeviceHolder> device_holder,
                                  fml::UniqueFD cache_directory)
-    : caps_(std::move(caps)),
-      device_holder_(device_holder),
-      cache_directory_(std::move(cache_directory)) {
+    : caps_(std::move(caps)), device_holder_(device_holder) {
   if (!caps_ || !device_holder->GetDevice()) {
     return;
   }
 
   const auto& vk_caps = CapabilitiesVK::Cast(*caps_);
 
-  auto existing_cache_data =
-      OpenCacheFile(cache_directory_, kPipelineCacheFileName, vk_caps);
+  PipelineCacheStore::Settings store_settings;
+  store_settings.version = GetCacheVersion(vk_caps);
+  store_ = PipelineCacheStore::Create(std::move(cache_directory),
+                                      std::move(store_settings));
+
+  std::unique_ptr<fml::Mapping> existing_cache_data =
+      store_ ? store_->Load(kPipelineCacheFileName) : nullptr;
 
   vk::PipelineCacheCreateInfo cache_info;
   if (existing_cache_data) {
@@ -167,7 +150,7 @@ std::shared_ptr<fml::Mapping> PipelineCacheVK::CopyPipelineCacheData() const {
 }
 
 void PipelineCacheVK::PersistCacheToDisk() const {
-  if (!cache_directory_.is_valid()) {
+  if (!store_) {
     return;
   }
   auto data = CopyPipelineCacheData();
@@ -175,16 +158,22 @@ void PipelineCacheVK::PersistCacheToDisk() const {
     VALIDATION_LOG << "Could not copy pipeline cache data.";
     return;
   }
-  data = DecorateCacheWithMetadata(std::move(data));
-  if (!data) {
-    VALIDATION_LOG
-        << "Could not decorate pipeline cache with additional metadata.";
-    return;
+  store_->Store(kPipelineCacheFileName, std::move(data));
+}
+
+std::unique_ptr<fml::Mapping> PipelineCacheVK::LoadUsageManifest() const {
+  if (!store_) {
+    return nullptr;
   }
-  if (!fml::WriteAtomically(cache_directory_, kPipelineCacheFileName, *data)) {
-    VALIDATION_LOG << "Could not persist pipeline cache to disk.";
+  return store_->Load(kPipelineUsageManifestFileName);
+}
+
+void PipelineCacheVK::PersistUsageManifest(
+    std::shared_ptr<const fml::Mapping> manifest) const {
+  if (!store_) {
     return;
   }
+  store_->Store(kPipelineUsageManifestFileName, std::move(manifest));
 }
 
 const CapabilitiesVK* PipelineCacheVK::GetCapabilities() const {
@@ -9,6 +9,7 @@
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
+#include "impeller/renderer/pipeline_cache_store.h"
 
 namespace impeller {
 
@@ -34,10 +35,15 @@ class PipelineCacheVK {
 
   void PersistCacheToDisk() const;
 
+  std::unique_ptr<fml::Mapping> LoadUsageManifest() const;
+
+  void PersistUsageManifest(std::shared_ptr<const fml::Mapping> manifest) const;
+
  private:
   const std::shared_ptr<const Capabilities> caps_;
   std::weak_ptr<DeviceHolder> device_holder_;
-  const fml::UniqueFD cache_directory_;
+  // Null if the pipeline cache is not persisted.
+  std::shared_ptr<PipelineCacheStore> store_;
   vk::UniquePipelineCache cache_;
   bool is_valid_ = false;
 
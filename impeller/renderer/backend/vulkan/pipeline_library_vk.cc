@@ -14,6 +14,7 @@
 #include "impeller/base/promise.h"
 #include "impeller/base/timing.h"
 #include "impeller/base/validation.h"
+#include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
 #include "impeller/renderer/backend/vulkan/pipeline_vk.h"
@@ -28,13 +29,18 @@ PipelineLibraryVK::PipelineLibraryVK(
     const std::shared_ptr<DeviceHolder>& device_holder,
     std::shared_ptr<const Capabilities> caps,
     fml::UniqueFD cache_directory,
-    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner)
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
+    std::shared_ptr<BackendStats> backend_stats)
     : device_holder_(device_holder),
       supports_framebuffer_fetch_(caps->SupportsFramebufferFetch()),
+      supports_rasterization_order_attachment_access_(
+          CapabilitiesVK::Cast(*caps)
+              .SupportsRasterizationOrderAttachmentAccess()),
       pso_cache_(std::make_shared<PipelineCacheVK>(std::move(caps),
                                                    device_holder,
                                                    std::move(cache_directory))),
-      worker_task_runner_(std::move(worker_task_runner)) {
+      worker_task_runner_(std::move(worker_task_runner)),
+      backend_stats_(std::move(backend_stats)) {
   FML_DCHECK(worker_task_runner_);
   if (!pso_cache_->IsValid() || !worker_task_runner_) {
     return;
@@ -83,7 +89,8 @@ static vk::AttachmentDescription CreatePlaceholderAttachmentDescription(
 static vk::UniqueRenderPass CreateCompatRenderPassForPipeline(
     const vk::Device& device,
     const PipelineDescriptor& desc,
-    bool supports_framebuffer_fetch) {
+    bool supports_framebuffer_fetch,
+    bool supports_rasterization_order_attachment_access) {
   std::vector<vk::AttachmentDescription> attachments;
 
   std::vector<vk::AttachmentReference> color_refs;
@@ -125,13 +132,18 @@ static vk::UniqueRenderPass CreateCompatRenderPassForPipeline(
   subpass_desc.pipelineBindPoint = vk::PipelineBindPoint::eGraphics;
 
   // If the device supports framebuffer fetch, compatibility pipelines are
-  // always created with the self reference and rasterization order flag. This
-  // ensures that all compiled pipelines are compatible with a render pass that
-  // contains a framebuffer fetch shader (advanced blends).
+  // always created with the self reference and either the rasterization order
+  // flag or a self-dependency. This ensures that all compiled pipelines are
+  // compatible with a render pass that contains a framebuffer fetch shader
+  // (advanced blends). This must match |RenderPassVK::CreateVKRenderPass|.
   std::vector<vk::SubpassDependency> subpass_dependencies;
   if (supports_framebuffer_fetch) {
-    subpass_desc.setFlags(vk::SubpassDescriptionFlagBits::
-                              eRasterizationOrderAttachmentColorAccessARM);
+    if (supports_rasterization_order_attachment_access) {
+      subpass_desc.setFlags(vk::SubpassDescriptionFlagBits::
+                                eRasterizationOrderAttachmentColorAccessARM);
+    } else {
+      subpass_dependencies.push_back(CreateFramebufferFetchSelfDependency());
+    }
     subpass_desc.setInputAttachments(subpass_color_ref);
   }
   subpass_desc.setColorAttachments(color_refs);
@@ -389,7 +401,8 @@ std::unique_ptr<PipelineVK> PipelineLibraryVK::CreatePipeline(
   }
 
   auto render_pass = CreateCompatRenderPassForPipeline(
-      strong_device->GetDevice(), desc, supports_framebuffer_fetch_);
+      strong_device->GetDevice(), desc, supports_framebuffer_fetch_,
+      supports_rasterization_order_attachment_access_);
   if (render_pass) {
     pipeline_info.setBasePipelineHandle(VK_NULL_HANDLE);
     pipeline_info.setSubpass(0);
@@ -435,7 +448,8 @@ std::unique_ptr<PipelineVK> PipelineLibraryVK::CreatePipeline(
   std::vector<vk::DescriptorSetLayoutBinding> desc_bindings;
 
   for (auto layout : desc.GetVertexDescriptor()->GetDescriptorSetLayouts()) {
-    auto vk_desc_layout = ToVKDescriptorSetLayoutBinding(layout);
+    auto vk_desc_layout = ToVKDescriptorSetLayoutBinding(
+        layout, /*dynamic_uniform_buffers=*/true);
     desc_bindings.push_back(vk_desc_layout);
   }
 
@@ -496,6 +510,7 @@ std::unique_ptr<PipelineVK> PipelineLibraryVK::CreatePipeline(
     VALIDATION_LOG << "Could not create graphics pipeline: " << desc.GetLabel();
     return nullptr;
   }
+  backend_stats_->Record(BackendObject::kPipeline);
 
   if (supports_pipeline_creation_feedback) {
     ReportPipelineCreationFeedback(desc, feedback);
@@ -606,6 +621,7 @@ std::unique_ptr<ComputePipelineVK> PipelineLibraryVK::CreateComputePipeline(
     VALIDATION_LOG << "Could not create graphics pipeline: " << desc.GetLabel();
     return nullptr;
   }
+  backend_stats_->Record(BackendObject::kPipeline);
 
   ContextVK::SetDebugName(strong_device->GetDevice(), *pipeline_layout.value,
                           "Pipeline Layout " + desc.GetLabel());
@@ -644,7 +660,7 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryVK::GetPipeline(
 
   auto weak_this = weak_from_this();
 
-  worker_task_runner_->PostTask([descriptor, weak_this, promise]() {
+  auto create_pipeline = [descriptor, weak_this, promise]() {
     auto thiz = weak_this.lock();
     if (!thiz) {
       promise->set_value(nullptr);
@@ -661,7 +677,9 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryVK::GetPipeline(
     }
 
     promise->set_value(std::move(pipeline));
-  });
+  };
+  worker_task_runner_->PostTask(create_pipeline,
+                                fml::ConcurrentTaskPriority::kFrameCritical);
 
   return pipeline_future;
 }
@@ -690,7 +708,7 @@ PipelineFuture<ComputePipelineDescriptor> PipelineLibraryVK::GetPipeline(
 
   auto weak_this = weak_from_this();
 
-  worker_task_runner_->PostTask([descriptor, weak_this, promise]() {
+  auto create_pipeline = [descriptor, weak_this, promise]() {
     auto self = weak_this.lock();
     if (!self) {
       promise->set_value(nullptr);
@@ -708,7 +726,9 @@ PipelineFuture<ComputePipelineDescriptor> PipelineLibraryVK::GetPipeline(
     }
 
     promise->set_value(std::move(pipeline));
-  });
+  };
+  worker_task_runner_->PostTask(create_pipeline,
+                                fml::ConcurrentTaskPriority::kFrameCritical);
 
   return pipeline_future;
 }
@@ -724,6 +744,30 @@ void PipelineLibraryVK::RemovePipelinesWithEntryPoint(
   });
 }
 
+// |PipelineLibrary|
+std::unique_ptr<fml::Mapping> PipelineLibraryVK::LoadPipelineUsageManifest()
+    const {
+  return pso_cache_->LoadUsageManifest();
+}
+
+// |PipelineLibrary|
+void PipelineLibraryVK::PersistPipelineUsageManifest(
+    std::shared_ptr<const fml::Mapping> manifest) {
+  if (!manifest) {
+    return;
+  }
+  worker_task_runner_->PostTask(
+      [weak_cache = decltype(pso_cache_)::weak_type(pso_cache_),
+       manifest = std::move(manifest)]() {
+        auto cache = weak_cache.lock();
+        if (!cache) {
+          return;
+        }
+        cache->PersistUsageManifest(manifest);
+      },
+      fml::ConcurrentTaskPriority::kBackground);
+}
+
 void PipelineLibraryVK::DidAcquireSurfaceFrame() {
   if (++frames_acquired_ == 50u) {
     PersistPipelineCacheToDisk();
@@ -738,7 +782,8 @@ void PipelineLibraryVK::PersistPipelineCacheToDisk() {
           return;
         }
         cache->PersistCacheToDisk();
-      });
+      },
+      fml::ConcurrentTaskPriority::kBackground);
 }
 
 }  // namespace impeller
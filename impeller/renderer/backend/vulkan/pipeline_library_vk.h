@@ -13,6 +13,7 @@
 #include "flutter/fml/unique_fd.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/base/thread.h"
+#include "impeller/core/backend_stats.h"
 #include "impeller/renderer/backend/vulkan/compute_pipeline_vk.h"
 #include "impeller/renderer/backend/vulkan/pipeline_cache_vk.h"
 #include "impeller/renderer/backend/vulkan/pipeline_vk.h"
@@ -37,8 +38,10 @@ class PipelineLibraryVK final
 
   std::weak_ptr<DeviceHolder> device_holder_;
   bool supports_framebuffer_fetch_ = false;
+  bool supports_rasterization_order_attachment_access_ = false;
   std::shared_ptr<PipelineCacheVK> pso_cache_;
   std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
+  std::shared_ptr<BackendStats> backend_stats_;
   Mutex pipelines_mutex_;
   PipelineMap pipelines_ IPLR_GUARDED_BY(pipelines_mutex_);
   Mutex compute_pipelines_mutex_;
@@ -51,7 +54,8 @@ class PipelineLibraryVK final
       const std::shared_ptr<DeviceHolder>& device_holder,
       std::shared_ptr<const Capabilities> caps,
       fml::UniqueFD cache_directory,
-      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner);
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
+      std::shared_ptr<BackendStats> backend_stats);
 
   // |PipelineLibrary|
   bool IsValid() const override;
@@ -68,6 +72,13 @@ class PipelineLibraryVK final
   void RemovePipelinesWithEntryPoint(
       std::shared_ptr<const ShaderFunction> function) override;
 
+  // |PipelineLibrary|
+  std::unique_ptr<fml::Mapping> LoadPipelineUsageManifest() const override;
+
+  // |PipelineLibrary|
+  void PersistPipelineUsageManifest(
+      std::shared_ptr<const fml::Mapping> manifest) override;
+
   std::unique_ptr<PipelineVK> CreatePipeline(const PipelineDescriptor& desc);
 
   std::unique_ptr<ComputePipelineVK> CreateComputePipeline(
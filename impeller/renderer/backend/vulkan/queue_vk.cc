@@ -17,10 +17,49 @@ const QueueIndexVK& QueueVK::GetIndex() const {
   return index_;
 }
 
-vk::Result QueueVK::Submit(const vk::SubmitInfo& submit_info,
-                           const vk::Fence& fence) const {
+vk::Result QueueVK::Submit(
+    const vk::SubmitInfo& submit_info,
+    const vk::Fence& fence,
+    std::vector<SharedHandleVK<vk::Semaphore>>* waited) const {
   Lock lock(queue_mutex_);
-  return queue_.submit(submit_info, fence);
+  if (!waited || wait_semaphores_.empty()) {
+    return queue_.submit(submit_info, fence);
+  }
+
+  std::vector<vk::Semaphore> semaphores(
+      submit_info.pWaitSemaphores,
+      submit_info.pWaitSemaphores + submit_info.waitSemaphoreCount);
+  std::vector<vk::PipelineStageFlags> stages(
+      submit_info.pWaitDstStageMask,
+      submit_info.pWaitDstStageMask + submit_info.waitSemaphoreCount);
+  for (size_t i = 0; i < wait_semaphores_.size(); i++) {
+    semaphores.push_back(wait_semaphores_[i]->Get());
+    stages.push_back(wait_stages_[i]);
+  }
+
+  vk::SubmitInfo info = submit_info;
+  info.setWaitSemaphores(semaphores);
+  info.setWaitDstStageMask(stages);
+  auto result = queue_.submit(info, fence);
+  if (result != vk::Result::eSuccess) {
+    // The semaphores remain signaled. Leave them for the next submission.
+    return result;
+  }
+  waited->insert(waited->end(), wait_semaphores_.begin(),
+                 wait_semaphores_.end());
+  wait_semaphores_.clear();
+  wait_stages_.clear();
+  return result;
+}
+
+void QueueVK::AddWaitSemaphore(SharedHandleVK<vk::Semaphore> semaphore,
+                               vk::PipelineStageFlags stages) const {
+  if (!semaphore) {
+    return;
+  }
+  Lock lock(queue_mutex_);
+  wait_semaphores_.emplace_back(std::move(semaphore));
+  wait_stages_.push_back(stages);
 }
 
 void QueueVK::InsertDebugMarker(const char* label) const {
@@ -6,9 +6,11 @@
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_QUEUE_VK_H_
 
 #include <memory>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/base/thread.h"
+#include "impeller/renderer/backend/vulkan/shared_object_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 
 namespace impeller {
@@ -37,8 +39,29 @@ class QueueVK {
 
   const QueueIndexVK& GetIndex() const;
 
-  vk::Result Submit(const vk::SubmitInfo& submit_info,
-                    const vk::Fence& fence) const;
+  //----------------------------------------------------------------------------
+  /// @brief      Submits work to the queue.
+  ///
+  /// @param[in]  submit_info  The submission.
+  /// @param[in]  fence        The fence to signal, may be null.
+  /// @param[out] waited       If not null, the submission also waits on the
+  ///                          semaphores added via `AddWaitSemaphore` since
+  ///                          they were last consumed and they are appended
+  ///                          here. The caller must keep them alive till the
+  ///                          submission completes.
+  ///
+  vk::Result Submit(
+      const vk::SubmitInfo& submit_info,
+      const vk::Fence& fence,
+      std::vector<SharedHandleVK<vk::Semaphore>>* waited = nullptr) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Makes the next submission to this queue wait on the given
+  ///             semaphore before executing the given stages. Used to order
+  ///             work submitted to another queue before work on this one.
+  ///
+  void AddWaitSemaphore(SharedHandleVK<vk::Semaphore> semaphore,
+                        vk::PipelineStageFlags stages) const;
 
   void InsertDebugMarker(const char* label) const;
 
@@ -47,6 +70,10 @@ class QueueVK {
 
   const QueueIndexVK index_;
   const vk::Queue queue_ IPLR_GUARDED_BY(queue_mutex_);
+  mutable std::vector<SharedHandleVK<vk::Semaphore>> wait_semaphores_
+      IPLR_GUARDED_BY(queue_mutex_);
+  mutable std::vector<vk::PipelineStageFlags> wait_stages_
+      IPLR_GUARDED_BY(queue_mutex_);
 
   QueueVK(const QueueVK&) = delete;
 
@@ -4,17 +4,24 @@
 
 #include "impeller/renderer/backend/vulkan/render_pass_vk.h"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
+#include <optional>
 #include <vector>
 
+#include "flutter/fml/closure.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
 #include "impeller/renderer/backend/vulkan/barrier_vk.h"
 #include "impeller/renderer/backend/vulkan/binding_helpers_vk.h"
+#include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
+#include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
@@ -102,7 +109,8 @@ static void SetTextureLayout(
 SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
     const ContextVK& context,
     const std::shared_ptr<CommandBufferVK>& command_buffer,
-    bool supports_framebuffer_fetch) const {
+    bool supports_framebuffer_fetch,
+    bool supports_rasterization_order_attachment_access) const {
   std::vector<vk::AttachmentDescription> attachments;
 
   std::vector<vk::AttachmentReference> color_refs;
@@ -171,13 +179,20 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
   subpass_desc.setResolveAttachments(resolve_refs);
   subpass_desc.setPDepthStencilAttachment(&depth_stencil_ref);
 
+  // The color attachment is read as an input attachment by framebuffer fetch
+  // shaders. The layout must be general since it is also being written to.
+  // This must match |CreateCompatRenderPassForPipeline|.
   std::vector<vk::SubpassDependency> subpass_dependencies;
   std::vector<vk::AttachmentReference> subpass_color_ref;
   subpass_color_ref.push_back(vk::AttachmentReference{
-      static_cast<uint32_t>(0), vk::ImageLayout::eColorAttachmentOptimal});
+      static_cast<uint32_t>(0), vk::ImageLayout::eGeneral});
   if (supports_framebuffer_fetch) {
-    subpass_desc.setFlags(vk::SubpassDescriptionFlagBits::
-                              eRasterizationOrderAttachmentColorAccessARM);
+    if (supports_rasterization_order_attachment_access) {
+      subpass_desc.setFlags(vk::SubpassDescriptionFlagBits::
+                                eRasterizationOrderAttachmentColorAccessARM);
+    } else {
+      subpass_dependencies.push_back(CreateFramebufferFetchSelfDependency());
+    }
     subpass_desc.setInputAttachments(subpass_color_ref);
   }
 
@@ -185,6 +200,7 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
   render_pass_desc.setAttachments(attachments);
   render_pass_desc.setPSubpasses(&subpass_desc);
   render_pass_desc.setSubpassCount(1u);
+  render_pass_desc.setDependencies(subpass_dependencies);
 
   auto [result, pass] =
       context.GetDevice().createRenderPassUnique(render_pass_desc);
@@ -297,6 +313,7 @@ SharedHandleVK<vk::Framebuffer> RenderPassVK::CreateVKFramebuffer(
     VALIDATION_LOG << "Could not create framebuffer: " << vk::to_string(result);
     return {};
   }
+  context.GetBackendStats()->Record(BackendObject::kFramebuffer);
 
   return MakeSharedVK(std::move(framebuffer));
 }
@@ -364,49 +381,21 @@ static void SetViewportAndScissor(const Command& command,
   cmd_buffer_cache.SetScissor(cmd_buffer, 0, 1, &scissor);
 }
 
-static bool EncodeCommand(const Context& context,
-                          const Command& command,
-                          CommandEncoderVK& encoder,
-                          PassBindingsCache& command_buffer_cache,
-                          const ISize& target_size,
-                          const vk::DescriptorSet vk_desc_set) {
-#ifdef IMPELLER_DEBUG
-  fml::ScopedCleanupClosure pop_marker(
-      [&encoder]() { encoder.PopDebugGroup(); });
-  if (!command.label.empty()) {
-    encoder.PushDebugGroup(command.label.c_str());
-  } else {
-    pop_marker.Release();
-  }
-#endif  // IMPELLER_DEBUG
-
-  const auto& cmd_buffer = encoder.GetCommandBuffer();
-  const auto& pipeline_vk = PipelineVK::Cast(*command.pipeline);
-
-  encoder.GetCommandBuffer().bindDescriptorSets(
-      vk::PipelineBindPoint::eGraphics,  // bind point
-      pipeline_vk.GetPipelineLayout(),   // layout
-      0,                                 // first set
-      {vk::DescriptorSet{vk_desc_set}},  // sets
-      nullptr                            // offsets
-  );
-
-  command_buffer_cache.BindPipeline(
-      cmd_buffer, vk::PipelineBindPoint::eGraphics, pipeline_vk.GetPipeline());
-
-  // Set the viewport and scissors.
-  SetViewportAndScissor(command, cmd_buffer, command_buffer_cache, target_size);
-
-  // Set the stencil reference.
-  command_buffer_cache.SetStencilReference(
-      cmd_buffer, vk::StencilFaceFlagBits::eVkStencilFrontAndBack,
-      command.stencil_reference);
+/// The device buffers that a command reads vertices and indices from.
+struct CommandBuffersVK {
+  vk::Buffer vertex_buffer;
+  vk::Buffer index_buffer;
+};
 
+static std::optional<CommandBuffersVK> ResolveCommandBuffers(
+    const Context& context,
+    const Command& command,
+    CommandEncoderVK& encoder) {
   // Configure vertex and index and buffers for binding.
   auto& vertex_buffer_view = command.vertex_buffer.vertex_buffer;
 
   if (!vertex_buffer_view) {
-    return false;
+    return std::nullopt;
   }
 
   auto& allocator = *context.GetResourceAllocator();
@@ -415,40 +404,92 @@ static bool EncodeCommand(const Context& context,
   if (!vertex_buffer) {
     VALIDATION_LOG << "Failed to acquire device buffer"
                    << " for vertex buffer view";
-    return false;
+    return std::nullopt;
   }
 
   if (!encoder.Track(vertex_buffer)) {
-    return false;
+    return std::nullopt;
   }
 
-  // Bind the vertex buffer.
-  auto vertex_buffer_handle = DeviceBufferVK::Cast(*vertex_buffer).GetBuffer();
-  vk::Buffer vertex_buffers[] = {vertex_buffer_handle};
-  vk::DeviceSize vertex_buffer_offsets[] = {vertex_buffer_view.range.offset};
-  cmd_buffer.bindVertexBuffers(0u, 1u, vertex_buffers, vertex_buffer_offsets);
+  CommandBuffersVK buffers;
+  buffers.vertex_buffer = DeviceBufferVK::Cast(*vertex_buffer).GetBuffer();
 
   if (command.vertex_buffer.index_type != IndexType::kNone) {
-    // Bind the index buffer.
     auto index_buffer_view = command.vertex_buffer.index_buffer;
     if (!index_buffer_view) {
-      return false;
+      return std::nullopt;
     }
 
     auto index_buffer = index_buffer_view.buffer->GetDeviceBuffer(allocator);
     if (!index_buffer) {
       VALIDATION_LOG << "Failed to acquire device buffer"
                      << " for index buffer view";
-      return false;
+      return std::nullopt;
     }
 
     if (!encoder.Track(index_buffer)) {
-      return false;
+      return std::nullopt;
     }
 
-    auto index_buffer_handle = DeviceBufferVK::Cast(*index_buffer).GetBuffer();
-    cmd_buffer.bindIndexBuffer(index_buffer_handle,
-                               index_buffer_view.range.offset,
+    buffers.index_buffer = DeviceBufferVK::Cast(*index_buffer).GetBuffer();
+  }
+  return buffers;
+}
+
+static void EncodeCommand(const Command& command,
+                          const vk::CommandBuffer& cmd_buffer,
+                          PassBindingsCache& command_buffer_cache,
+                          const ISize& target_size,
+                          const vk::DescriptorSet vk_desc_set,
+                          vk::ArrayProxy<const uint32_t> dynamic_offsets,
+                          const CommandBuffersVK& buffers,
+                          bool needs_framebuffer_fetch_barrier) {
+  const auto& pipeline_vk = PipelineVK::Cast(*command.pipeline);
+
+  cmd_buffer.bindDescriptorSets(
+      vk::PipelineBindPoint::eGraphics,  // bind point
+      pipeline_vk.GetPipelineLayout(),   // layout
+      0,                                 // first set
+      {vk::DescriptorSet{vk_desc_set}},  // sets
+      dynamic_offsets                    // offsets
+  );
+
+  command_buffer_cache.BindPipeline(
+      cmd_buffer, vk::PipelineBindPoint::eGraphics, pipeline_vk.GetPipeline());
+
+  // Without rasterization order attachment access, the writes of earlier
+  // draws must be made visible to the input attachment reads of this one.
+  if (needs_framebuffer_fetch_barrier &&
+      command.pipeline->GetDescriptor().UsesSubpassInput()) {
+    const auto barrier = CreateFramebufferFetchBarrier();
+    cmd_buffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eColorAttachmentOutput,  // src stage
+        vk::PipelineStageFlagBits::eFragmentShader,         // dst stage
+        vk::DependencyFlagBits::eByRegion,                  // dependency flags
+        barrier,                                            // memory barriers
+        nullptr,                                            // buffer barriers
+        nullptr                                             // image barriers
+    );
+  }
+
+  // Set the viewport and scissors.
+  SetViewportAndScissor(command, cmd_buffer, command_buffer_cache, target_size);
+
+  // Set the stencil reference.
+  command_buffer_cache.SetStencilReference(
+      cmd_buffer, vk::StencilFaceFlagBits::eVkStencilFrontAndBack,
+      command.stencil_reference);
+
+  // Bind the vertex buffer.
+  vk::Buffer vertex_buffers[] = {buffers.vertex_buffer};
+  vk::DeviceSize vertex_buffer_offsets[] = {
+      command.vertex_buffer.vertex_buffer.range.offset};
+  cmd_buffer.bindVertexBuffers(0u, 1u, vertex_buffers, vertex_buffer_offsets);
+
+  if (command.vertex_buffer.index_type != IndexType::kNone) {
+    // Bind the index buffer.
+    cmd_buffer.bindIndexBuffer(buffers.index_buffer,
+                               command.vertex_buffer.index_buffer.range.offset,
                                ToVKIndexType(command.vertex_buffer.index_type));
 
     // Engage!
@@ -465,6 +506,111 @@ static bool EncodeCommand(const Context& context,
                     0u                                   // first instance
     );
   }
+}
+
+// Passes with fewer commands than this per secondary command buffer are
+// recorded inline on the calling thread.
+static constexpr size_t kMinCommandsPerSecondaryCommandBuffer = 128u;
+static constexpr size_t kMaxSecondaryCommandBuffers = 4u;
+
+/// Records |command_count| commands split across |buffer_count| secondary
+/// command buffers on the worker threads of |context| and executes them in
+/// the render pass described by |pass_info|.
+template <typename EncodeCommandsCallback>
+static bool EncodeSecondaryCommandBuffers(
+    const ContextVK& context,
+    CommandEncoderVK& encoder,
+    const vk::RenderPassBeginInfo& pass_info,
+    size_t command_count,
+    size_t buffer_count,
+    const EncodeCommandsCallback& encode_commands) {
+  TRACE_EVENT0("impeller", "EncodeSecondaryCommandBuffers");
+  auto recycler = context.GetCommandPoolRecycler();
+  auto task_runner = context.GetConcurrentWorkerTaskRunner();
+  if (!recycler || !task_runner) {
+    return false;
+  }
+
+  vk::CommandBufferInheritanceInfo inheritance_info;
+  inheritance_info.renderPass = pass_info.renderPass;
+  inheritance_info.subpass = 0u;
+  inheritance_info.framebuffer = pass_info.framebuffer;
+
+  struct SecondaryCommandBuffer {
+    std::shared_ptr<CommandPoolVK> pool;
+    vk::UniqueCommandBuffer buffer;
+  };
+  std::vector<SecondaryCommandBuffer> secondary_buffers(buffer_count);
+  const size_t commands_per_buffer =
+      (command_count + buffer_count - 1u) / buffer_count;
+
+  fml::CountDownLatch latch(buffer_count);
+  for (auto i = 0u; i < buffer_count; i++) {
+    auto encode = [&, i]() {
+      fml::ScopedCleanupClosure count_down([&latch]() { latch.CountDown(); });
+
+      // Command pools must not be used by several threads at once, so each
+      // worker records into its own. Disposing of it afterwards gives the
+      // next frame on this worker a new pool while |encoder| keeps this one
+      // alive until the GPU is done with the command buffer.
+      auto pool = recycler->Get();
+      if (!pool) {
+        return;
+      }
+      fml::ScopedCleanupClosure dispose_pool(
+          [&recycler]() { recycler->Dispose(); });
+
+      auto buffer =
+          pool->CreateCommandBuffer(vk::CommandBufferLevel::eSecondary);
+      if (!buffer) {
+        return;
+      }
+
+      vk::CommandBufferBeginInfo begin_info;
+      begin_info.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit |
+                         vk::CommandBufferUsageFlagBits::eRenderPassContinue;
+      begin_info.setPInheritanceInfo(&inheritance_info);
+      if (buffer->begin(begin_info) != vk::Result::eSuccess) {
+        return;
+      }
+
+      // Dynamic state is not inherited by secondary command buffers.
+      PassBindingsCache pass_bindings_cache;
+      const auto begin = i * commands_per_buffer;
+      const auto end = std::min(command_count, begin + commands_per_buffer);
+      encode_commands(*buffer, pass_bindings_cache, begin, end);
+
+      if (buffer->end() != vk::Result::eSuccess) {
+        return;
+      }
+      secondary_buffers[i] = {std::move(pool), std::move(buffer)};
+    };
+    task_runner->PostTask(encode, fml::ConcurrentTaskPriority::kFrameCritical);
+  }
+  latch.Wait();
+
+  std::vector<vk::CommandBuffer> buffers;
+  buffers.reserve(buffer_count);
+  for (const auto& secondary_buffer : secondary_buffers) {
+    if (!secondary_buffer.buffer) {
+      VALIDATION_LOG << "Could not record secondary command buffer.";
+      return false;
+    }
+    buffers.push_back(*secondary_buffer.buffer);
+  }
+
+  const auto& cmd_buffer = encoder.GetCommandBuffer();
+  cmd_buffer.beginRenderPass(pass_info,
+                             vk::SubpassContents::eSecondaryCommandBuffers);
+  cmd_buffer.executeCommands(buffers);
+  cmd_buffer.endRenderPass();
+
+  for (auto& secondary_buffer : secondary_buffers) {
+    if (!encoder.Track(std::move(secondary_buffer.pool),
+                       std::move(secondary_buffer.buffer))) {
+      return false;
+    }
+  }
   return true;
 }
 
@@ -509,9 +655,14 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
 
   const auto& target_size = render_target_.GetRenderTargetSize();
 
-  auto render_pass = CreateVKRenderPass(
-      vk_context, command_buffer,
-      vk_context.GetCapabilities()->SupportsFramebufferFetch());
+  const auto& caps = CapabilitiesVK::Cast(*vk_context.GetCapabilities());
+  const auto needs_framebuffer_fetch_barrier =
+      caps.SupportsFramebufferFetch() &&
+      !caps.SupportsRasterizationOrderAttachmentAccess();
+  auto render_pass =
+      CreateVKRenderPass(vk_context, command_buffer,
+                         caps.SupportsFramebufferFetch(),
+                         caps.SupportsRasterizationOrderAttachmentAccess());
   if (!render_pass) {
     VALIDATION_LOG << "Could not create renderpass.";
     return false;
@@ -544,7 +695,43 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
   if (!desc_sets_result.ok()) {
     return false;
   }
-  auto desc_sets = desc_sets_result.value();
+  const auto& desc_sets = desc_sets_result.value();
+
+  // Resolve and track the vertex and index buffers up front so that the
+  // commands can be recorded on any thread.
+  std::vector<CommandBuffersVK> command_buffers;
+  command_buffers.reserve(commands_.size());
+  for (const auto& command : commands_) {
+    auto buffers = ResolveCommandBuffers(context, command, *encoder);
+    if (!buffers.has_value()) {
+      return false;
+    }
+    command_buffers.push_back(buffers.value());
+  }
+
+  const auto encode_commands = [&](const vk::CommandBuffer& buffer,
+                                   PassBindingsCache& cache, size_t begin,
+                                   size_t end) {
+    for (auto i = begin; i < end; i++) {
+      const auto& offsets = desc_sets.dynamic_offset_ranges[i];
+      EncodeCommand(commands_[i], buffer, cache, target_size,
+                    desc_sets.sets[i],
+                    vk::ArrayProxy<const uint32_t>(
+                        static_cast<uint32_t>(offsets.length),
+                        desc_sets.dynamic_offsets.data() + offsets.offset),
+                    command_buffers[i], needs_framebuffer_fetch_barrier);
+    }
+  };
+
+  const auto secondary_buffer_count = std::min(
+      kMaxSecondaryCommandBuffers,
+      commands_.size() / kMinCommandsPerSecondaryCommandBuffer);
+  if (secondary_buffer_count > 1u) {
+    return EncodeSecondaryCommandBuffers(vk_context, *encoder, pass_info,
+                                         commands_.size(),
+                                         secondary_buffer_count,
+                                         encode_commands);
+  }
 
   {
     TRACE_EVENT0("impeller", "EncodeRenderPassCommands");
@@ -553,13 +740,17 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
     fml::ScopedCleanupClosure end_render_pass(
         [cmd_buffer]() { cmd_buffer.endRenderPass(); });
 
-    auto desc_index = 0u;
-    for (const auto& command : commands_) {
-      if (!EncodeCommand(context, command, *encoder, pass_bindings_cache_,
-                         target_size, desc_sets[desc_index])) {
-        return false;
+    for (auto i = 0u; i < commands_.size(); i++) {
+#ifdef IMPELLER_DEBUG
+      fml::ScopedCleanupClosure pop_marker(
+          [&encoder]() { encoder->PopDebugGroup(); });
+      if (!commands_[i].label.empty()) {
+        encoder->PushDebugGroup(commands_[i].label.c_str());
+      } else {
+        pop_marker.Release();
       }
-      desc_index += 1;
+#endif  // IMPELLER_DEBUG
+      encode_commands(cmd_buffer, pass_bindings_cache_, i, i + 1);
     }
   }
 
@@ -45,7 +45,8 @@ class RenderPassVK final : public RenderPass {
   SharedHandleVK<vk::RenderPass> CreateVKRenderPass(
       const ContextVK& context,
       const std::shared_ptr<CommandBufferVK>& command_buffer,
-      bool has_subpass_dependency) const;
+      bool supports_framebuffer_fetch,
+      bool supports_rasterization_order_attachment_access) const;
 
   SharedHandleVK<vk::Framebuffer> CreateVKFramebuffer(
       const ContextVK& context,
@@ -11,8 +11,9 @@
 namespace impeller {
 
 SamplerLibraryVK::SamplerLibraryVK(
-    const std::weak_ptr<DeviceHolder>& device_holder)
-    : device_holder_(device_holder) {}
+    const std::weak_ptr<DeviceHolder>& device_holder,
+    std::shared_ptr<BackendStats> backend_stats)
+    : device_holder_(device_holder), backend_stats_(std::move(backend_stats)) {}
 
 SamplerLibraryVK::~SamplerLibraryVK() = default;
 
@@ -65,6 +66,7 @@ std::shared_ptr<const Sampler> SamplerLibraryVK::GetSampler(
   }
 
   samplers_[desc] = sampler;
+  backend_stats_->Record(BackendObject::kSampler);
   return sampler;
 }
 
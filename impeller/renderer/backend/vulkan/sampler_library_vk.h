@@ -8,6 +8,7 @@
 #include "flutter/fml/macros.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/base/comparable.h"
+#include "impeller/core/backend_stats.h"
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
@@ -27,8 +28,10 @@ class SamplerLibraryVK final
 
   std::weak_ptr<DeviceHolder> device_holder_;
   SamplerMap samplers_;
+  std::shared_ptr<BackendStats> backend_stats_;
 
-  explicit SamplerLibraryVK(const std::weak_ptr<DeviceHolder>& device_holder);
+  SamplerLibraryVK(const std::weak_ptr<DeviceHolder>& device_holder,
+                   std::shared_ptr<BackendStats> backend_stats);
 
   // |SamplerLibrary|
   std::shared_ptr<const Sampler> GetSampler(
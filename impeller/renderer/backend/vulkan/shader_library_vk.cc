@@ -49,20 +49,37 @@ static std::string VKShaderNameToShaderKeyName(const std::string& name,
   return stream.str();
 }
 
+static bool IsMappingSPIRV(const fml::Mapping& mapping) {
+  // https://registry.khronos.org/SPIR-V/specs/1.0/SPIRV.html#Magic
+  const uint32_t kSPIRVMagic = 0x07230203;
+  if (mapping.GetSize() < sizeof(kSPIRVMagic)) {
+    return false;
+  }
+  uint32_t magic = 0u;
+  ::memcpy(&magic, mapping.GetMapping(), sizeof(magic));
+  return magic == kSPIRVMagic;
+}
+
 ShaderLibraryVK::ShaderLibraryVK(
     std::weak_ptr<DeviceHolder> device_holder,
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_data)
     : device_holder_(std::move(device_holder)) {
   TRACE_EVENT0("impeller", "CreateShaderLibrary");
   bool success = true;
+  ShaderCodeMap archived_code;
+  // Modules are created when the shaders are first looked up.
   auto iterator = [&](auto type,         //
                       const auto& name,  //
                       const auto& code   //
                       ) -> bool {
-    if (!RegisterFunction(name, ToShaderStage(type), code)) {
+    if (!code || !IsMappingSPIRV(*code)) {
+      VALIDATION_LOG << "Shader " << name << " is not valid SPIRV.";
       success = false;
       return false;
     }
+    const auto stage = ToShaderStage(type);
+    archived_code[ShaderKey{VKShaderNameToShaderKeyName(name, stage),
+                            stage}] = code;
     return true;
   };
   for (const auto& library_data : shader_libraries_data) {
@@ -76,9 +93,14 @@ ShaderLibraryVK::ShaderLibraryVK(
   }
 
   if (!success) {
-    VALIDATION_LOG << "Could not create shader modules for all shader blobs.";
+    VALIDATION_LOG << "Could not read all shader blobs.";
     return;
   }
+
+  WriterLock lock(functions_mutex_);
+  archived_count_ = archived_code.size();
+  archived_code_ = std::move(archived_code);
+  TraceFunctionCountsLocked();
   is_valid_ = true;
 }
 
@@ -92,14 +114,32 @@ bool ShaderLibraryVK::IsValid() const {
 std::shared_ptr<const ShaderFunction> ShaderLibraryVK::GetFunction(
     std::string_view name,
     ShaderStage stage) {
-  ReaderLock lock(functions_mutex_);
-
   const auto key = ShaderKey{{name.data(), name.size()}, stage};
-  auto found = functions_.find(key);
-  if (found != functions_.end()) {
+  {
+    ReaderLock lock(functions_mutex_);
+    auto found = functions_.find(key);
+    if (found != functions_.end()) {
+      return found->second;
+    }
+  }
+
+  WriterLock lock(functions_mutex_);
+  if (auto found = functions_.find(key); found != functions_.end()) {
     return found->second;
   }
-  return nullptr;
+  auto archived = archived_code_.find(key);
+  if (archived == archived_code_.end()) {
+    return nullptr;
+  }
+  auto function = CreateFunction(key.name, stage, archived->second);
+  if (!function) {
+    return nullptr;
+  }
+  archived_code_.erase(archived);
+  functions_[key] = function;
+  instantiated_count_++;
+  TraceFunctionCountsLocked();
+  return function;
 }
 
 // |ShaderLibrary|
@@ -113,28 +153,32 @@ void ShaderLibraryVK::RegisterFunction(std::string name,
   }
 }
 
-static bool IsMappingSPIRV(const fml::Mapping& mapping) {
-  // https://registry.khronos.org/SPIR-V/specs/1.0/SPIRV.html#Magic
-  const uint32_t kSPIRVMagic = 0x07230203;
-  if (mapping.GetSize() < sizeof(kSPIRVMagic)) {
+bool ShaderLibraryVK::RegisterFunction(
+    const std::string& name,
+    ShaderStage stage,
+    const std::shared_ptr<fml::Mapping>& code) {
+  const auto key_name = VKShaderNameToShaderKeyName(name, stage);
+  auto function = CreateFunction(key_name, stage, code);
+  if (!function) {
     return false;
   }
-  uint32_t magic = 0u;
-  ::memcpy(&magic, mapping.GetMapping(), sizeof(magic));
-  return magic == kSPIRVMagic;
+
+  WriterLock lock(functions_mutex_);
+  functions_[ShaderKey{key_name, stage}] = std::move(function);
+  return true;
 }
 
-bool ShaderLibraryVK::RegisterFunction(
-    const std::string& name,
+std::shared_ptr<const ShaderFunction> ShaderLibraryVK::CreateFunction(
+    const std::string& key_name,
     ShaderStage stage,
-    const std::shared_ptr<fml::Mapping>& code) {
+    const std::shared_ptr<fml::Mapping>& code) const {
   if (!code) {
-    return false;
+    return nullptr;
   }
 
   if (!IsMappingSPIRV(*code)) {
     VALIDATION_LOG << "Shader is not valid SPIRV.";
-    return false;
+    return nullptr;
   }
 
   vk::ShaderModuleCreateInfo shader_module_info;
@@ -145,7 +189,7 @@ bool ShaderLibraryVK::RegisterFunction(
 
   auto device_holder = device_holder_.lock();
   if (!device_holder) {
-    return false;
+    return nullptr;
   }
   FML_DCHECK(device_holder->GetDevice());
   auto module =
@@ -154,25 +198,27 @@ bool ShaderLibraryVK::RegisterFunction(
   if (module.result != vk::Result::eSuccess) {
     VALIDATION_LOG << "Could not create shader module: "
                    << vk::to_string(module.result);
-    return false;
+    return nullptr;
   }
 
-  const auto key_name = VKShaderNameToShaderKeyName(name, stage);
-
   vk::UniqueShaderModule shader_module = std::move(module.value);
   ContextVK::SetDebugName(device_holder->GetDevice(), *shader_module,
-                          "Shader " + name);
+                          "Shader " + key_name);
 
-  WriterLock lock(functions_mutex_);
-  functions_[ShaderKey{key_name, stage}] = std::shared_ptr<ShaderFunctionVK>(
+  return std::shared_ptr<ShaderFunctionVK>(
       new ShaderFunctionVK(device_holder_,
                            library_id_,              //
                            key_name,                 //
                            stage,                    //
                            std::move(shader_module)  //
                            ));
+}
 
-  return true;
+void ShaderLibraryVK::TraceFunctionCountsLocked() const {
+  FML_TRACE_COUNTER("impeller", "ShaderLibraryVK",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "ArchivedShaders", archived_count_,
+                    "InstantiatedShaders", instantiated_count_);
 }
 
 // |ShaderLibrary|
@@ -29,6 +29,11 @@ class ShaderLibraryVK final : public ShaderLibrary {
   const UniqueID library_id_;
   mutable RWMutex functions_mutex_;
   ShaderFunctionMap functions_ IPLR_GUARDED_BY(functions_mutex_);
+  // Shaders in the archives that have no module yet. Their code points into
+  // the archives, which are not copied.
+  ShaderCodeMap archived_code_ IPLR_GUARDED_BY(functions_mutex_);
+  size_t archived_count_ = 0u;
+  size_t instantiated_count_ IPLR_GUARDED_BY(functions_mutex_) = 0u;
   bool is_valid_ = false;
 
   ShaderLibraryVK(
@@ -49,6 +54,14 @@ class ShaderLibraryVK final : public ShaderLibrary {
                         ShaderStage stage,
                         const std::shared_ptr<fml::Mapping>& code);
 
+  std::shared_ptr<const ShaderFunction> CreateFunction(
+      const std::string& key_name,
+      ShaderStage stage,
+      const std::shared_ptr<fml::Mapping>& code) const;
+
+  void TraceFunctionCountsLocked() const
+      IPLR_REQUIRES_SHARED(functions_mutex_);
+
   // |ShaderLibrary|
   void UnregisterFunction(std::string name, ShaderStage stage) override;
 
@@ -57,8 +57,18 @@ void SurfaceContextVK::Shutdown() {
   parent_->Shutdown();
 }
 
-bool SurfaceContextVK::SetWindowSurface(vk::UniqueSurfaceKHR surface) {
-  auto swapchain = SwapchainVK::Create(parent_, std::move(surface));
+const std::shared_ptr<BackendStats>& SurfaceContextVK::GetBackendStats() const {
+  return parent_->GetBackendStats();
+}
+
+const std::shared_ptr<SamplingCapture>& SurfaceContextVK::GetSamplingCapture()
+    const {
+  return parent_->GetSamplingCapture();
+}
+
+bool SurfaceContextVK::SetWindowSurface(vk::UniqueSurfaceKHR surface,
+                                        const SwapchainSettingsVK& settings) {
+  auto swapchain = SwapchainVK::Create(parent_, std::move(surface), settings);
   if (!swapchain) {
     VALIDATION_LOG << "Could not create swapchain.";
     return false;
@@ -88,6 +98,11 @@ std::unique_ptr<Surface> SurfaceContextVK::AcquireNextSurface() {
   return surface;
 }
 
+FramePacingStatsVK SurfaceContextVK::GetFramePacingStats() const {
+  return swapchain_ ? swapchain_->GetFramePacingStats()
+                    : FramePacingStatsVK{};
+}
+
 void SurfaceContextVK::SetSyncPresentation(bool value) {
   parent_->SetSyncPresentation(value);
 }
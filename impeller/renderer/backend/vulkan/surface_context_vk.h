@@ -8,6 +8,7 @@
 #include <memory>
 
 #include "impeller/base/backend_cast.h"
+#include "impeller/renderer/backend/vulkan/swapchain_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 #include "impeller/renderer/context.h"
 
@@ -15,7 +16,6 @@ namespace impeller {
 
 class ContextVK;
 class Surface;
-class SwapchainVK;
 
 class SurfaceContextVK : public Context,
                          public BackendCast<SurfaceContextVK, Context> {
@@ -58,10 +58,21 @@ class SurfaceContextVK : public Context,
   // |Context|
   void SetSyncPresentation(bool value) override;
 
-  [[nodiscard]] bool SetWindowSurface(vk::UniqueSurfaceKHR surface);
+  // |Context|
+  const std::shared_ptr<BackendStats>& GetBackendStats() const override;
+
+  // |Context|
+  const std::shared_ptr<SamplingCapture>& GetSamplingCapture() const override;
+
+  [[nodiscard]] bool SetWindowSurface(
+      vk::UniqueSurfaceKHR surface,
+      const SwapchainSettingsVK& settings = {});
 
   std::unique_ptr<Surface> AcquireNextSurface();
 
+  /// @brief Frame pacing statistics of the most recently acquired surface.
+  FramePacingStatsVK GetFramePacingStats() const;
+
 #ifdef FML_OS_ANDROID
   vk::UniqueSurfaceKHR CreateAndroidSurface(ANativeWindow* window) const;
 #endif  // FML_OS_ANDROID
@@ -4,8 +4,10 @@
 
 #include "impeller/renderer/backend/vulkan/swapchain_impl_vk.h"
 
+#include "flutter/fml/trace_event.h"
 #include "fml/synchronization/count_down_latch.h"
 #include "impeller/base/validation.h"
+#include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
@@ -25,6 +27,9 @@ static constexpr size_t kMaxFramesInFlight = 3u;
 // orientation will be polled every other frame.
 static constexpr size_t kPollFramesForOrientation = 1u;
 
+// The number of queued presents whose display timing is still awaited.
+static constexpr size_t kMaxPendingPresentTimes = 16u;
+
 struct FrameSynchronizer {
   vk::UniqueFence acquire;
   vk::UniqueSemaphore render_ready;
@@ -121,6 +126,16 @@ static std::optional<vk::CompositeAlphaFlagBitsKHR> ChooseAlphaCompositionMode(
   return std::nullopt;
 }
 
+static vk::PresentModeKHR ChoosePresentMode(
+    const std::vector<vk::PresentModeKHR>& modes,
+    vk::PresentModeKHR preference) {
+  if (std::find(modes.begin(), modes.end(), preference) != modes.end()) {
+    return preference;
+  }
+  // FIFO is the only mode all surfaces are required to support.
+  return vk::PresentModeKHR::eFifo;
+}
+
 static std::optional<vk::Queue> ChoosePresentQueue(
     const vk::PhysicalDevice& physical_device,
     const vk::Device& device,
@@ -140,15 +155,17 @@ static std::optional<vk::Queue> ChoosePresentQueue(
 std::shared_ptr<SwapchainImplVK> SwapchainImplVK::Create(
     const std::shared_ptr<Context>& context,
     vk::UniqueSurfaceKHR surface,
+    const SwapchainSettingsVK& settings,
     vk::SwapchainKHR old_swapchain,
     vk::SurfaceTransformFlagBitsKHR last_transform) {
   return std::shared_ptr<SwapchainImplVK>(new SwapchainImplVK(
-      context, std::move(surface), old_swapchain, last_transform));
+      context, std::move(surface), settings, old_swapchain, last_transform));
 }
 
 SwapchainImplVK::SwapchainImplVK(
     const std::shared_ptr<Context>& context,
     vk::UniqueSurfaceKHR surface,
+    const SwapchainSettingsVK& settings,
     vk::SwapchainKHR old_swapchain,
     vk::SurfaceTransformFlagBitsKHR last_transform) {
   if (!context) {
@@ -189,6 +206,14 @@ SwapchainImplVK::SwapchainImplVK(
     return;
   }
 
+  auto [present_modes_result, present_modes] =
+      vk_context.GetPhysicalDevice().getSurfacePresentModesKHR(*surface);
+  if (present_modes_result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not get surface present modes: "
+                   << vk::to_string(present_modes_result);
+    return;
+  }
+
   auto present_queue = ChoosePresentQueue(vk_context.GetPhysicalDevice(),  //
                                           vk_context.GetDevice(),          //
                                           *surface                         //
@@ -202,17 +227,22 @@ SwapchainImplVK::SwapchainImplVK(
   swapchain_info.surface = *surface;
   swapchain_info.imageFormat = format.value().format;
   swapchain_info.imageColorSpace = format.value().colorSpace;
-  swapchain_info.presentMode = vk::PresentModeKHR::eFifo;
+  swapchain_info.presentMode =
+      ChoosePresentMode(present_modes, settings.present_mode);
   swapchain_info.imageExtent = vk::Extent2D{
       std::clamp(caps.currentExtent.width, caps.minImageExtent.width,
                  caps.maxImageExtent.width),
       std::clamp(caps.currentExtent.height, caps.minImageExtent.height,
                  caps.maxImageExtent.height),
   };
+  const uint32_t preferred_image_count = settings.image_count == 0u
+                                             ? caps.minImageCount + 1u
+                                             : settings.image_count;
   swapchain_info.minImageCount = std::clamp(
-      caps.minImageCount + 1u,  // preferred image count
-      caps.minImageCount,       // min count cannot be zero
-      caps.maxImageCount == 0u ? caps.minImageCount + 1u
+      preferred_image_count,  // preferred image count
+      caps.minImageCount,     // min count cannot be zero
+      caps.maxImageCount == 0u ? std::max(preferred_image_count,
+                                          caps.minImageCount)
                                : caps.maxImageCount  // max zero means no limit
   );
   swapchain_info.imageArrayLayers = 1u;
@@ -297,6 +327,11 @@ SwapchainImplVK::SwapchainImplVK(
   current_frame_ = synchronizers_.size() - 1u;
   is_valid_ = true;
   transform_if_changed_discard_swapchain_ = last_transform;
+  settings_ = settings;
+  supports_display_timing_ =
+      CapabilitiesVK::Cast(*vk_context.GetCapabilities())
+          .HasOptionalDeviceExtension(
+              OptionalDeviceExtensionVK::kGOOGLEDisplayTiming);
 }
 
 SwapchainImplVK::~SwapchainImplVK() {
@@ -336,6 +371,40 @@ std::shared_ptr<Context> SwapchainImplVK::GetContext() const {
   return context_.lock();
 }
 
+const SwapchainSettingsVK& SwapchainImplVK::GetSettings() const {
+  return settings_;
+}
+
+FramePacingStatsVK SwapchainImplVK::GetFramePacingStats() const {
+  Lock lock(frame_pacing_mutex_);
+  return frame_pacing_stats_;
+}
+
+void SwapchainImplVK::UpdatePresentLatency(const vk::Device& device) {
+  auto [result, timings] =
+      device.getPastPresentationTimingGOOGLE(*swapchain_);
+  if (result != vk::Result::eSuccess || timings.empty()) {
+    return;
+  }
+  Lock lock(frame_pacing_mutex_);
+  for (const auto& timing : timings) {
+    while (!present_times_.empty() &&
+           present_times_.front().first < timing.presentID) {
+      present_times_.pop_front();
+    }
+    if (present_times_.empty() ||
+        present_times_.front().first != timing.presentID) {
+      continue;
+    }
+    // Display timing uses the same monotonic clock as |fml::TimePoint|.
+    const auto displayed = fml::TimePoint::FromEpochDelta(
+        fml::TimeDelta::FromNanoseconds(timing.actualPresentTime));
+    frame_pacing_stats_.present_latency =
+        displayed - present_times_.front().second;
+    present_times_.pop_front();
+  }
+}
+
 SwapchainImplVK::AcquireResult SwapchainImplVK::AcquireNextDrawable() {
   auto context_strong = context_.lock();
   if (!context_strong) {
@@ -348,6 +417,8 @@ SwapchainImplVK::AcquireResult SwapchainImplVK::AcquireNextDrawable() {
 
   const auto& sync = synchronizers_[current_frame_];
 
+  const auto acquire_start = fml::TimePoint::Now();
+
   //----------------------------------------------------------------------------
   /// Wait on the host for the synchronizer fence.
   ///
@@ -407,6 +478,18 @@ SwapchainImplVK::AcquireResult SwapchainImplVK::AcquireNextDrawable() {
     return SwapchainImplVK::AcquireResult{};
   }
 
+  {
+    Lock lock(frame_pacing_mutex_);
+    frame_pacing_stats_.acquire_wait = fml::TimePoint::Now() - acquire_start;
+    FML_TRACE_COUNTER(
+        "impeller", "SwapchainVK",
+        reinterpret_cast<int64_t>(this),  // Trace Counter ID
+        "AcquireWaitUs", frame_pacing_stats_.acquire_wait.ToMicroseconds(),
+        "PresentLatencyUs",
+        frame_pacing_stats_.present_latency.value_or(fml::TimeDelta::Zero())
+            .ToMicroseconds());
+  }
+
   /// Record all subsequent cmd buffers as part of the current frame.
   context.GetGPUTracer()->MarkFrameStart();
 
@@ -504,9 +587,27 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
     present_info.setImageIndices(indices);
     present_info.setWaitSemaphores(*sync->present_ready);
 
+    vk::PresentTimeGOOGLE present_time;
+    vk::PresentTimesInfoGOOGLE present_times_info;
+    if (supports_display_timing_) {
+      Lock lock(frame_pacing_mutex_);
+      present_time.presentID = ++last_present_id_;
+      present_times_info.setTimes(present_time);
+      present_info.setPNext(&present_times_info);
+      if (present_times_.size() >= kMaxPendingPresentTimes) {
+        present_times_.pop_front();
+      }
+      present_times_.emplace_back(present_time.presentID,
+                                  fml::TimePoint::Now());
+    }
+
     auto result = present_queue_.presentKHR(present_info);
     sync->present_latch->CountDown();
 
+    if (supports_display_timing_) {
+      UpdatePresentLatency(ContextVK::Cast(*context_strong).GetDevice());
+    }
+
     switch (result) {
       case vk::Result::eErrorOutOfDateKHR:
         // Caller will recreate the impl on acquisition, not submission.
@@ -6,10 +6,14 @@
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_SWAPCHAIN_IMPL_VK_H_
 
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <variant>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
+#include "impeller/base/thread.h"
+#include "impeller/renderer/backend/vulkan/swapchain_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 #include "vulkan/vulkan_enums.hpp"
 
@@ -34,6 +38,7 @@ class SwapchainImplVK final
   static std::shared_ptr<SwapchainImplVK> Create(
       const std::shared_ptr<Context>& context,
       vk::UniqueSurfaceKHR surface,
+      const SwapchainSettingsVK& settings = {},
       vk::SwapchainKHR old_swapchain = VK_NULL_HANDLE,
       vk::SurfaceTransformFlagBitsKHR last_transform =
           vk::SurfaceTransformFlagBitsKHR::eIdentity);
@@ -59,6 +64,10 @@ class SwapchainImplVK final
 
   vk::SurfaceTransformFlagBitsKHR GetLastTransform() const;
 
+  const SwapchainSettingsVK& GetSettings() const;
+
+  FramePacingStatsVK GetFramePacingStats() const;
+
   std::shared_ptr<Context> GetContext() const;
 
   std::pair<vk::UniqueSurfaceKHR, vk::UniqueSwapchainKHR> DestroySwapchain();
@@ -75,14 +84,29 @@ class SwapchainImplVK final
   bool is_valid_ = false;
   size_t current_transform_poll_count_ = 0u;
   vk::SurfaceTransformFlagBitsKHR transform_if_changed_discard_swapchain_;
+  SwapchainSettingsVK settings_;
+  bool supports_display_timing_ = false;
+  mutable Mutex frame_pacing_mutex_;
+  FramePacingStatsVK frame_pacing_stats_ IPLR_GUARDED_BY(frame_pacing_mutex_);
+  uint32_t last_present_id_ IPLR_GUARDED_BY(frame_pacing_mutex_) = 0u;
+  // The times at which recent frames were queued for presentation, by their
+  // `VK_GOOGLE_display_timing` present ID.
+  std::deque<std::pair<uint32_t, fml::TimePoint>> present_times_
+      IPLR_GUARDED_BY(frame_pacing_mutex_);
 
   SwapchainImplVK(const std::shared_ptr<Context>& context,
                   vk::UniqueSurfaceKHR surface,
+                  const SwapchainSettingsVK& settings,
                   vk::SwapchainKHR old_swapchain,
                   vk::SurfaceTransformFlagBitsKHR last_transform);
 
   bool Present(const std::shared_ptr<SwapchainImageVK>& image, uint32_t index);
 
+  /// Reads back the timing of frames presented so far. Must be called on the
+  /// thread frames are presented on since the swapchain is externally
+  /// synchronized.
+  void UpdatePresentLatency(const vk::Device& device);
+
   void WaitIdle() const;
 
   SwapchainImplVK(const SwapchainImplVK&) = delete;
@@ -12,8 +12,9 @@ namespace impeller {
 
 std::shared_ptr<SwapchainVK> SwapchainVK::Create(
     const std::shared_ptr<Context>& context,
-    vk::UniqueSurfaceKHR surface) {
-  auto impl = SwapchainImplVK::Create(context, std::move(surface));
+    vk::UniqueSurfaceKHR surface,
+    const SwapchainSettingsVK& settings) {
+  auto impl = SwapchainImplVK::Create(context, std::move(surface), settings);
   if (!impl || !impl->IsValid()) {
     VALIDATION_LOG << "Failed to create SwapchainVK implementation.";
     return nullptr;
@@ -51,6 +52,7 @@ std::unique_ptr<Surface> SwapchainVK::AcquireNextDrawable() {
 
   auto new_impl = SwapchainImplVK::Create(context,                   //
                                           std::move(surface),        //
+                                          impl_->GetSettings(),      //
                                           *old_swapchain,            //
                                           impl_->GetLastTransform()  //
   );
@@ -73,4 +75,8 @@ vk::Format SwapchainVK::GetSurfaceFormat() const {
   return IsValid() ? impl_->GetSurfaceFormat() : vk::Format::eUndefined;
 }
 
+FramePacingStatsVK SwapchainVK::GetFramePacingStats() const {
+  return IsValid() ? impl_->GetFramePacingStats() : FramePacingStatsVK{};
+}
+
 }  // namespace impeller
@@ -6,8 +6,10 @@
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_SWAPCHAIN_VK_H_
 
 #include <memory>
+#include <optional>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 #include "impeller/renderer/context.h"
 #include "impeller/renderer/surface.h"
@@ -16,6 +18,30 @@ namespace impeller {
 
 class SwapchainImplVK;
 
+//------------------------------------------------------------------------------
+/// @brief      Presentation preferences of a swapchain. A present mode the
+///             surface does not support falls back to FIFO, and the image
+///             count is clamped to the limits of the surface.
+///
+struct SwapchainSettingsVK {
+  vk::PresentModeKHR present_mode = vk::PresentModeKHR::eFifo;
+  /// The number of swapchain images to request. Zero requests one more than
+  /// the minimum the surface requires.
+  uint32_t image_count = 0u;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Frame pacing statistics of the most recently acquired drawable.
+///
+struct FramePacingStatsVK {
+  /// The time spent waiting for a frame slot and a swapchain image.
+  fml::TimeDelta acquire_wait;
+  /// The time between the most recent frame with known timing being queued
+  /// for presentation and it being displayed. Only available where the
+  /// device supports `VK_GOOGLE_display_timing`.
+  std::optional<fml::TimeDelta> present_latency;
+};
+
 //------------------------------------------------------------------------------
 /// @brief      A swapchain that adapts to the underlying surface going out of
 ///             date. If the caller cannot acquire the next drawable, it is due
@@ -26,7 +52,8 @@ class SwapchainVK {
  public:
   static std::shared_ptr<SwapchainVK> Create(
       const std::shared_ptr<Context>& context,
-      vk::UniqueSurfaceKHR surface);
+      vk::UniqueSurfaceKHR surface,
+      const SwapchainSettingsVK& settings = {});
 
   ~SwapchainVK();
 
@@ -36,6 +63,8 @@ class SwapchainVK {
 
   vk::Format GetSurfaceFormat() const;
 
+  FramePacingStatsVK GetFramePacingStats() const;
+
  private:
   std::shared_ptr<SwapchainImplVK> impl_;
 
@@ -6,6 +6,7 @@
 
 #include <cstdint>
 #include <cstring>
+#include <map>
 #include <utility>
 #include <vector>
 
@@ -34,6 +35,8 @@ struct MockCommandPool {};
 
 struct MockDescriptorPool {};
 
+struct MockSemaphore {};
+
 class MockDevice final {
  public:
   explicit MockDevice() : called_functions_(new std::vector<std::string>()) {}
@@ -74,6 +77,16 @@ class MockDevice final {
     called_functions_->push_back(function);
   }
 
+  void SetQueuePriorities(uint32_t family, std::vector<float> priorities) {
+    queue_priorities_[family] = std::move(priorities);
+  }
+
+  std::vector<float> GetQueuePriorities(uint32_t family) const {
+    auto found = queue_priorities_.find(family);
+    return found == queue_priorities_.end() ? std::vector<float>{}
+                                            : found->second;
+  }
+
  private:
   MockDevice(const MockDevice&) = delete;
 
@@ -90,6 +103,10 @@ class MockDevice final {
   Mutex commmand_pools_mutex_;
   std::vector<std::unique_ptr<MockCommandPool>> command_pools_
       IPLR_GUARDED_BY(commmand_pools_mutex_);
+
+  // The priorities of the queues created for each family by
+  // |vkCreateDevice|, only written while the device is created.
+  std::map<uint32_t, std::vector<float>> queue_priorities_;
 };
 
 void noop() {}
@@ -116,6 +133,8 @@ VkResult vkEnumerateInstanceExtensionProperties(
 
 FML_THREAD_LOCAL std::vector<std::string> g_instance_layers;
 
+FML_THREAD_LOCAL uint32_t g_queue_count = 3;
+
 VkResult vkEnumerateInstanceLayerProperties(uint32_t* pPropertyCount,
                                             VkLayerProperties* pProperties) {
   if (!pProperties) {
@@ -174,7 +193,7 @@ void vkGetPhysicalDeviceQueueFamilyProperties(
   if (!pQueueFamilyProperties) {
     *pQueueFamilyPropertyCount = 1;
   } else {
-    pQueueFamilyProperties[0].queueCount = 3;
+    pQueueFamilyProperties[0].queueCount = g_queue_count;
     pQueueFamilyProperties[0].queueFlags = static_cast<VkQueueFlags>(
         VK_QUEUE_TRANSFER_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_GRAPHICS_BIT);
   }
@@ -198,10 +217,34 @@ VkResult vkCreateDevice(VkPhysicalDevice physicalDevice,
                         const VkDeviceCreateInfo* pCreateInfo,
                         const VkAllocationCallbacks* pAllocator,
                         VkDevice* pDevice) {
-  *pDevice = reinterpret_cast<VkDevice>(new MockDevice());
+  auto mock_device = new MockDevice();
+  for (uint32_t i = 0; i < pCreateInfo->queueCreateInfoCount; i++) {
+    const VkDeviceQueueCreateInfo& info = pCreateInfo->pQueueCreateInfos[i];
+    mock_device->SetQueuePriorities(
+        info.queueFamilyIndex,
+        std::vector<float>(info.pQueuePriorities,
+                           info.pQueuePriorities + info.queueCount));
+  }
+  *pDevice = reinterpret_cast<VkDevice>(mock_device);
   return VK_SUCCESS;
 }
 
+void vkGetDeviceQueue(VkDevice device,
+                      uint32_t queueFamilyIndex,
+                      uint32_t queueIndex,
+                      VkQueue* pQueue) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  if (queueIndex >= mock_device->GetQueuePriorities(queueFamilyIndex).size()) {
+    // Like a real driver, don't hand out queues that were not created.
+    mock_device->AddCalledFunction("vkGetDeviceQueue (not created)");
+    *pQueue = VK_NULL_HANDLE;
+    return;
+  }
+  mock_device->AddCalledFunction("vkGetDeviceQueue");
+  *pQueue = reinterpret_cast<VkQueue>(
+      static_cast<uintptr_t>(0x1000 + queueFamilyIndex * 16 + queueIndex));
+}
+
 VkResult vkCreateInstance(const VkInstanceCreateInfo* pCreateInfo,
                           const VkAllocationCallbacks* pAllocator,
                           VkInstance* pInstance) {
@@ -472,6 +515,24 @@ VkResult vkDestroyFence(VkDevice device,
   return VK_SUCCESS;
 }
 
+VkResult vkCreateSemaphore(VkDevice device,
+                           const VkSemaphoreCreateInfo* pCreateInfo,
+                           const VkAllocationCallbacks* pAllocator,
+                           VkSemaphore* pSemaphore) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->AddCalledFunction("vkCreateSemaphore");
+  *pSemaphore = reinterpret_cast<VkSemaphore>(new MockSemaphore());
+  return VK_SUCCESS;
+}
+
+void vkDestroySemaphore(VkDevice device,
+                        VkSemaphore semaphore,
+                        const VkAllocationCallbacks* pAllocator) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->AddCalledFunction("vkDestroySemaphore");
+  delete reinterpret_cast<MockSemaphore*>(semaphore);
+}
+
 VkResult vkQueueSubmit(VkQueue queue,
                        uint32_t submitCount,
                        const VkSubmitInfo* pSubmits,
@@ -587,6 +648,8 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkEnumerateDeviceExtensionProperties;
   } else if (strcmp("vkCreateDevice", pName) == 0) {
     return (PFN_vkVoidFunction)vkCreateDevice;
+  } else if (strcmp("vkGetDeviceQueue", pName) == 0) {
+    return (PFN_vkVoidFunction)vkGetDeviceQueue;
   } else if (strcmp("vkCreateInstance", pName) == 0) {
     return (PFN_vkVoidFunction)vkCreateInstance;
   } else if (strcmp("vkGetPhysicalDeviceMemoryProperties", pName) == 0) {
@@ -659,6 +722,10 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkCreateFence;
   } else if (strcmp("vkDestroyFence", pName) == 0) {
     return (PFN_vkVoidFunction)vkDestroyFence;
+  } else if (strcmp("vkCreateSemaphore", pName) == 0) {
+    return (PFN_vkVoidFunction)vkCreateSemaphore;
+  } else if (strcmp("vkDestroySemaphore", pName) == 0) {
+    return (PFN_vkVoidFunction)vkDestroySemaphore;
   } else if (strcmp("vkQueueSubmit", pName) == 0) {
     return (PFN_vkVoidFunction)vkQueueSubmit;
   } else if (strcmp("vkWaitForFences", pName) == 0) {
@@ -697,6 +764,7 @@ std::shared_ptr<ContextVK> MockVulkanContextBuilder::Build() {
   }
   g_instance_extensions = instance_extensions_;
   g_instance_layers = instance_layers_;
+  g_queue_count = queue_count_;
   std::shared_ptr<ContextVK> result = ContextVK::Create(std::move(settings));
   return result;
 }
@@ -707,5 +775,11 @@ std::shared_ptr<std::vector<std::string>> GetMockVulkanFunctions(
   return mock_device->GetCalledFunctions();
 }
 
+std::vector<float> GetMockVulkanQueuePriorities(VkDevice device,
+                                                uint32_t family) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  return mock_device->GetQueuePriorities(family);
+}
+
 }  // namespace testing
 }  // namespace impeller
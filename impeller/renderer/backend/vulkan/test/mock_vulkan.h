@@ -20,6 +20,11 @@ namespace testing {
 std::shared_ptr<std::vector<std::string>> GetMockVulkanFunctions(
     VkDevice device);
 
+// Returns the priorities of the queues |vkCreateDevice| was asked to create
+// in the given queue family, one per queue.
+std::vector<float> GetMockVulkanQueuePriorities(VkDevice device,
+                                                uint32_t family);
+
 // A test-controlled version of |vk::Fence|.
 class MockFence final {
  public:
@@ -88,10 +93,17 @@ class MockVulkanContextBuilder {
     return *this;
   }
 
+  /// The number of queues in the single queue family of the mock device.
+  MockVulkanContextBuilder& SetQueueCount(uint32_t queue_count) {
+    queue_count_ = queue_count;
+    return *this;
+  }
+
  private:
   std::function<void(ContextVK::Settings&)> settings_callback_;
   std::vector<std::string> instance_extensions_;
   std::vector<std::string> instance_layers_;
+  uint32_t queue_count_ = 3;
 };
 
 }  // namespace testing
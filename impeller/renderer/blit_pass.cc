@@ -136,10 +136,8 @@ bool BlitPass::AddCopy(BufferView source,
     return false;
   }
 
-  auto bytes_per_pixel =
-      BytesPerPixelForPixelFormat(destination->GetTextureDescriptor().format);
   auto bytes_per_image =
-      destination->GetTextureDescriptor().size.Area() * bytes_per_pixel;
+      destination->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
 
   if (source.range.length != bytes_per_image) {
     VALIDATION_LOG
@@ -159,6 +157,9 @@ bool BlitPass::GenerateMipmap(std::shared_ptr<Texture> texture,
     return false;
   }
 
+  // Backends generate the mip levels before any later submitted work samples
+  // them, so the texture doesn't need another generation from here on.
+  texture->mipmap_generated_ = true;
   return OnGenerateMipmapCommand(std::move(texture), std::move(label));
 }
 
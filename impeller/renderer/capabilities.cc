@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/capabilities.h"
 
+#include <algorithm>
+
 namespace impeller {
 
 Capabilities::Capabilities() = default;
@@ -78,6 +80,13 @@ class StandardCapabilities final : public Capabilities {
     return supports_device_transient_textures_;
   }
 
+  // |Capabilities|
+  bool SupportsBlockCompressedFormat(PixelFormat format) const override {
+    return std::find(block_compressed_formats_.begin(),
+                     block_compressed_formats_.end(),
+                     format) != block_compressed_formats_.end();
+  }
+
  private:
   StandardCapabilities(bool supports_offscreen_msaa,
                        bool supports_ssbo,
@@ -89,6 +98,7 @@ class StandardCapabilities final : public Capabilities {
                        bool supports_read_from_resolve,
                        bool supports_decal_sampler_address_mode,
                        bool supports_device_transient_textures,
+                       std::vector<PixelFormat> block_compressed_formats,
                        PixelFormat default_color_format,
                        PixelFormat default_stencil_format,
                        PixelFormat default_depth_stencil_format)
@@ -103,6 +113,7 @@ class StandardCapabilities final : public Capabilities {
         supports_decal_sampler_address_mode_(
             supports_decal_sampler_address_mode),
         supports_device_transient_textures_(supports_device_transient_textures),
+        block_compressed_formats_(std::move(block_compressed_formats)),
         default_color_format_(default_color_format),
         default_stencil_format_(default_stencil_format),
         default_depth_stencil_format_(default_depth_stencil_format) {}
@@ -119,6 +130,7 @@ class StandardCapabilities final : public Capabilities {
   bool supports_read_from_resolve_ = false;
   bool supports_decal_sampler_address_mode_ = false;
   bool supports_device_transient_textures_ = false;
+  std::vector<PixelFormat> block_compressed_formats_;
   PixelFormat default_color_format_ = PixelFormat::kUnknown;
   PixelFormat default_stencil_format_ = PixelFormat::kUnknown;
   PixelFormat default_depth_stencil_format_ = PixelFormat::kUnknown;
@@ -207,6 +219,19 @@ CapabilitiesBuilder& CapabilitiesBuilder::SetSupportsDeviceTransientTextures(
   return *this;
 }
 
+CapabilitiesBuilder& CapabilitiesBuilder::SetSupportsBlockCompressedFormat(
+    PixelFormat format,
+    bool value) {
+  auto found = std::find(block_compressed_formats_.begin(),
+                         block_compressed_formats_.end(), format);
+  if (value && found == block_compressed_formats_.end()) {
+    block_compressed_formats_.push_back(format);
+  } else if (!value && found != block_compressed_formats_.end()) {
+    block_compressed_formats_.erase(found);
+  }
+  return *this;
+}
+
 std::unique_ptr<Capabilities> CapabilitiesBuilder::Build() {
   return std::unique_ptr<StandardCapabilities>(new StandardCapabilities(  //
       supports_offscreen_msaa_,                                           //
@@ -219,6 +244,7 @@ std::unique_ptr<Capabilities> CapabilitiesBuilder::Build() {
       supports_read_from_resolve_,                                        //
       supports_decal_sampler_address_mode_,                               //
       supports_device_transient_textures_,                                //
+      block_compressed_formats_,                                          //
       default_color_format_.value_or(PixelFormat::kUnknown),              //
       default_stencil_format_.value_or(PixelFormat::kUnknown),            //
       default_depth_stencil_format_.value_or(PixelFormat::kUnknown)       //
@@ -6,6 +6,7 @@
 #define FLUTTER_IMPELLER_RENDERER_CAPABILITIES_H_
 
 #include <memory>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/core/formats.h"
@@ -89,6 +90,11 @@ class Capabilities {
   ///         This feature is especially useful for MSAA and stencils.
   virtual bool SupportsDeviceTransientTextures() const = 0;
 
+  /// @brief  Whether the context backend supports sampling from textures with
+  ///         the given block compressed `PixelFormat`, so that image data
+  ///         already compressed in that format can be uploaded as is.
+  virtual bool SupportsBlockCompressedFormat(PixelFormat format) const = 0;
+
   /// @brief  Returns a supported `PixelFormat` for textures that store
   ///         4-channel colors (red/green/blue/alpha).
   virtual PixelFormat GetDefaultColorFormat() const = 0;
@@ -145,6 +151,9 @@ class CapabilitiesBuilder {
 
   CapabilitiesBuilder& SetSupportsDeviceTransientTextures(bool value);
 
+  CapabilitiesBuilder& SetSupportsBlockCompressedFormat(PixelFormat format,
+                                                        bool value);
+
   std::unique_ptr<Capabilities> Build();
 
  private:
@@ -158,6 +167,7 @@ class CapabilitiesBuilder {
   bool supports_read_from_resolve_ = false;
   bool supports_decal_sampler_address_mode_ = false;
   bool supports_device_transient_textures_ = false;
+  std::vector<PixelFormat> block_compressed_formats_;
   std::optional<PixelFormat> default_color_format_ = std::nullopt;
   std::optional<PixelFormat> default_stencil_format_ = std::nullopt;
   std::optional<PixelFormat> default_depth_stencil_format_ = std::nullopt;
@@ -6,13 +6,18 @@
 
 #include "flutter/fml/trace_event.h"
 #include "impeller/renderer/compute_pass.h"
+#include "impeller/renderer/context.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/render_target.h"
 
 namespace impeller {
 
 CommandBuffer::CommandBuffer(std::weak_ptr<const Context> context)
-    : context_(std::move(context)) {}
+    : context_(std::move(context)) {
+  if (auto strong_context = context_.lock()) {
+    strong_context->GetBackendStats()->Record(BackendObject::kCommandBuffer);
+  }
+}
 
 CommandBuffer::~CommandBuffer() = default;
 
@@ -36,6 +41,10 @@ void CommandBuffer::WaitUntilScheduled() {
   return OnWaitUntilScheduled();
 }
 
+void CommandBuffer::SetIsUploadOnly(bool upload_only) {
+  upload_only_ = upload_only;
+}
+
 bool CommandBuffer::EncodeAndSubmit(
     const std::shared_ptr<RenderPass>& render_pass) {
   TRACE_EVENT0("impeller", "CommandBuffer::EncodeAndSubmit");
@@ -67,6 +76,9 @@ std::shared_ptr<RenderPass> CommandBuffer::CreateRenderPass(
     const RenderTarget& render_target) {
   auto pass = OnCreateRenderPass(render_target);
   if (pass && pass->IsValid()) {
+    if (auto context = context_.lock()) {
+      context->GetBackendStats()->Record(BackendObject::kRenderPass);
+    }
     pass->SetLabel("RenderPass");
     return pass;
   }
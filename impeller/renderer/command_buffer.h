@@ -101,6 +101,14 @@ class CommandBuffer {
   ///
   void WaitUntilScheduled();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Hints that this command buffer only uploads data into
+  ///             resources that no previously submitted work accesses, such
+  ///             as the textures of newly decoded images. Backends with a
+  ///             dedicated transfer queue may submit it there.
+  ///
+  void SetIsUploadOnly(bool upload_only);
+
   //----------------------------------------------------------------------------
   /// @brief      Create a render pass to record render commands into.
   ///
@@ -128,6 +136,7 @@ class CommandBuffer {
 
  protected:
   std::weak_ptr<const Context> context_;
+  bool upload_only_ = false;
 
   explicit CommandBuffer(std::weak_ptr<const Context> context);
 
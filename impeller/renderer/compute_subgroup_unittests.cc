@@ -39,6 +39,25 @@ namespace testing {
 using ComputeSubgroupTest = ComputePlaygroundTest;
 INSTANTIATE_COMPUTE_SUITE(ComputeSubgroupTest);
 
+TEST(ComputeTessellatorTest, CanTessellateRequiresSubgroupsAndSmallPaths) {
+  auto path = PathBuilder{}.AddCircle({100, 100}, 50).TakePath();
+  auto capabilities = CapabilitiesBuilder()
+                          .SetSupportsCompute(true)
+                          .SetSupportsComputeSubgroups(true)
+                          .Build();
+  EXPECT_TRUE(ComputeTessellator::CanTessellate(path, *capabilities));
+
+  auto no_subgroups = CapabilitiesBuilder().SetSupportsCompute(true).Build();
+  EXPECT_FALSE(ComputeTessellator::CanTessellate(path, *no_subgroups));
+
+  PathBuilder builder;
+  for (auto i = 0u; i <= ComputeTessellator::kMaxCubicCount; i++) {
+    builder.CubicCurveTo({i + 1.0f, 0}, {i + 2.0f, 10}, {i + 3.0f, 0});
+  }
+  EXPECT_FALSE(
+      ComputeTessellator::CanTessellate(builder.TakePath(), *capabilities));
+}
+
 TEST_P(ComputeSubgroupTest, CapabilitiesSuportSubgroups) {
   auto context = GetContext();
   ASSERT_TRUE(context);
@@ -29,6 +29,38 @@ static std::shared_ptr<DeviceBuffer> CreateDeviceBuffer(
   return buffer;
 }
 
+struct ComponentCounts {
+  size_t cubic_count = 0u;
+  size_t quad_count = 0u;
+  size_t line_count = 0u;
+};
+
+// Cubics are subdivided into 6 quads, and quads into 6 lines.
+static ComponentCounts GetComponentCounts(const Path& path) {
+  ComponentCounts counts;
+  counts.cubic_count = path.GetComponentCount(Path::ComponentType::kCubic);
+  counts.quad_count = path.GetComponentCount(Path::ComponentType::kQuadratic) +
+                      (counts.cubic_count * 6);
+  counts.line_count = path.GetComponentCount(Path::ComponentType::kLinear) +
+                      (counts.quad_count * 6);
+  return counts;
+}
+
+static bool IsWithinComponentLimits(const ComponentCounts& counts) {
+  return counts.cubic_count <= ComputeTessellator::kMaxCubicCount &&
+         counts.quad_count <= ComputeTessellator::kMaxQuadCount &&
+         counts.line_count <= ComputeTessellator::kMaxLineCount;
+}
+
+bool ComputeTessellator::CanTessellate(const Path& path,
+                                       const Capabilities& capabilities) {
+  if (!capabilities.SupportsCompute() ||
+      !capabilities.SupportsComputeSubgroups()) {
+    return false;
+  }
+  return IsWithinComponentLimits(GetComponentCounts(path));
+}
+
 ComputeTessellator& ComputeTessellator::SetStyle(Style value) {
   style_ = value;
   return *this;
@@ -70,15 +102,11 @@ ComputeTessellator::Status ComputeTessellator::Tessellate(
   using PS = PathPolylineComputeShader;
   using SS = StrokeComputeShader;
 
-  auto cubic_count = path.GetComponentCount(Path::ComponentType::kCubic);
-  auto quad_count = path.GetComponentCount(Path::ComponentType::kQuadratic) +
-                    (cubic_count * 6);
-  auto line_count =
-      path.GetComponentCount(Path::ComponentType::kLinear) + (quad_count * 6);
-  if (cubic_count > kMaxCubicCount || quad_count > kMaxQuadCount ||
-      line_count > kMaxLineCount) {
+  const auto counts = GetComponentCounts(path);
+  if (!IsWithinComponentLimits(counts)) {
     return Status::kTooManyComponents;
   }
+  const auto line_count = counts.line_count;
   PS::Cubics<kMaxCubicCount> cubics{.count = 0};
   PS::Quads<kMaxQuadCount> quads{.count = 0};
   PS::Lines<kMaxLineCount> lines{.count = 0};
@@ -8,6 +8,7 @@
 #include "flutter/fml/macros.h"
 #include "impeller/core/buffer_view.h"
 #include "impeller/geometry/path.h"
+#include "impeller/renderer/capabilities.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/context.h"
 
@@ -40,6 +41,17 @@ class ComputeTessellator {
     // TODO(dnfield): Implement kFill.
   };
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the path can be tessellated with compute on a device
+  ///             with the given capabilities. Callers should fall back to the
+  ///             CPU |Tessellator| otherwise.
+  ///
+  ///             The shaders require compute subgroup support, and paths are
+  ///             limited to the component counts above once curves are
+  ///             subdivided.
+  ///
+  static bool CanTessellate(const Path& path, const Capabilities& capabilities);
+
   ComputeTessellator& SetStyle(Style value);
   ComputeTessellator& SetStrokeWidth(Scalar value);
   ComputeTessellator& SetStrokeJoin(Join value);
@@ -5,14 +5,19 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_CONTEXT_H_
 #define FLUTTER_IMPELLER_RENDERER_CONTEXT_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
 #include "impeller/core/allocator.h"
+#include "impeller/core/backend_stats.h"
 #include "impeller/core/capture.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/host_buffer.h"
+#include "impeller/core/sampling_capture.h"
 #include "impeller/renderer/capabilities.h"
 #include "impeller/renderer/pool.h"
 
@@ -181,10 +186,44 @@ class Context {
   ///             pending work.
   virtual void SetSyncPresentation(bool value) {}
 
+  /// Receives the GPU time of a frame workload, along with the time at which
+  /// the first command buffer of the workload was recorded.
+  using GPUFrameTimeCallback =
+      std::function<void(fml::TimePoint frame_start, fml::TimeDelta gpu_time)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the callback that receives the GPU time of each frame
+  ///             workload once the backend has measured it.
+  ///
+  ///             The callback may be invoked on any thread, some time after the
+  ///             frame was submitted. Backends that do not measure GPU time,
+  ///             and builds with GPU tracing disabled, never invoke it.
+  ///
+  virtual void SetGPUFrameTimeCallback(GPUFrameTimeCallback callback) {}
+
   //----------------------------------------------------------------------------
   /// @brief Accessor for a pool of HostBuffers.
   Pool<HostBuffer>& GetHostBufferPool() const { return host_buffer_pool_; }
 
+  //----------------------------------------------------------------------------
+  /// @brief      The counts of the driver objects created by this context, by
+  ///             its allocator, and by the passes and libraries it owns.
+  ///
+  ///             Whoever renders the frames of the context ends each frame on
+  ///             the statistics, which also traces the counts of the frame.
+  ///
+  virtual const std::shared_ptr<BackendStats>& GetBackendStats() const {
+    return backend_stats_;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the draws of sampled frames rendered with this
+  ///             context, if Impeller is built with sampling capture.
+  ///
+  virtual const std::shared_ptr<SamplingCapture>& GetSamplingCapture() const {
+    return sampling_capture_;
+  }
+
   CaptureContext capture;
 
   /// Stores a task on the `ContextMTL` that is awaiting access for the GPU.
@@ -205,6 +244,10 @@ class Context {
 
  private:
   mutable Pool<HostBuffer> host_buffer_pool_ = Pool<HostBuffer>(1'000'000);
+  std::shared_ptr<BackendStats> backend_stats_ =
+      std::make_shared<BackendStats>();
+  std::shared_ptr<SamplingCapture> sampling_capture_ =
+      std::make_shared<SamplingCapture>();
 
   Context(const Context&) = delete;
 
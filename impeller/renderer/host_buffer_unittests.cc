@@ -2,12 +2,70 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cstring>
+#include <vector>
+
 #include "flutter/testing/testing.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/device_buffer.h"
 #include "impeller/core/host_buffer.h"
 
 namespace impeller {
 namespace testing {
 
+namespace {
+
+class MappedDeviceBuffer final : public DeviceBuffer {
+ public:
+  explicit MappedDeviceBuffer(const DeviceBufferDescriptor& desc)
+      : DeviceBuffer(desc), contents_(desc.size) {}
+
+  bool SetLabel(const std::string& label) override { return true; }
+
+  bool SetLabel(const std::string& label, Range range) override {
+    return true;
+  }
+
+  uint8_t* OnGetContents() const override {
+    return const_cast<uint8_t*>(contents_.data());
+  }
+
+  void Flush(std::optional<Range> range) const override { flush_count++; }
+
+  bool OnCopyHostBuffer(const uint8_t* source,
+                        Range source_range,
+                        size_t offset) override {
+    return false;
+  }
+
+  mutable size_t flush_count = 0u;
+
+ private:
+  std::vector<uint8_t> contents_;
+};
+
+class MappedAllocator final : public Allocator {
+ public:
+  ISize GetMaxTextureSizeSupported() const override {
+    return ISize(1024, 1024);
+  }
+
+  std::shared_ptr<DeviceBuffer> OnCreateBuffer(
+      const DeviceBufferDescriptor& desc) override {
+    buffer_count++;
+    return std::make_shared<MappedDeviceBuffer>(desc);
+  }
+
+  std::shared_ptr<Texture> OnCreateTexture(
+      const TextureDescriptor& desc) override {
+    return nullptr;
+  }
+
+  size_t buffer_count = 0u;
+};
+
+}  // namespace
+
 TEST(HostBufferTest, TestInitialization) {
   ASSERT_TRUE(HostBuffer::Create());
   // Newly allocated buffers don't touch the heap till they have to.
@@ -75,5 +133,69 @@ TEST(HostBufferTest, CanEmplaceWithAlignment) {
   }
 }
 
+TEST(HostBufferTest, EmplacesIntoMappedDeviceBuffers) {
+  auto allocator = std::make_shared<MappedAllocator>();
+  auto buffer = HostBuffer::Create(allocator);
+
+  auto first = buffer->Emplace(uint32_t{0xAABBCCDD});
+  auto second = buffer->EmplaceUniform(uint32_t{0x11223344});
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+
+  // Both land in the same device buffer, which is written to directly.
+  EXPECT_EQ(allocator->buffer_count, 1u);
+  EXPECT_EQ(first.buffer, second.buffer);
+  EXPECT_EQ(first.range, Range(0u, 4u));
+  EXPECT_EQ(second.range.offset % DefaultUniformAlignment(), 0u);
+  uint32_t value = 0u;
+  ::memcpy(&value, second.contents + second.range.offset, sizeof(value));
+  EXPECT_EQ(value, 0x11223344u);
+  EXPECT_EQ(static_cast<const MappedDeviceBuffer&>(*first.buffer).flush_count,
+            2u);
+}
+
+TEST(HostBufferTest, ReusesDeviceBuffersAcrossFrames) {
+  auto allocator = std::make_shared<MappedAllocator>();
+  auto buffer = HostBuffer::Create(allocator);
+
+  const Buffer* first_frame_buffer = buffer->Emplace(uint32_t{}).buffer.get();
+  for (size_t i = 0; i < HostBuffer::kHostBufferArenaSize; i++) {
+    buffer->Reset();
+    ASSERT_TRUE(buffer->Emplace(uint32_t{}));
+  }
+
+  // Every frame of the ring got its own block. The ring then came back around
+  // to the block of the first frame.
+  EXPECT_EQ(allocator->buffer_count, HostBuffer::kHostBufferArenaSize);
+  EXPECT_EQ(buffer->GetLength(), 4u);
+
+  // Blocks still in use when their frame comes around are not overwritten.
+  auto in_use = buffer->Emplace(uint32_t{});
+  EXPECT_EQ(in_use.buffer.get(), first_frame_buffer);
+  for (size_t i = 0; i < HostBuffer::kHostBufferArenaSize; i++) {
+    buffer->Reset();
+  }
+  EXPECT_NE(buffer->Emplace(uint32_t{}).buffer, in_use.buffer);
+  EXPECT_EQ(allocator->buffer_count, HostBuffer::kHostBufferArenaSize + 1u);
+}
+
+TEST(HostBufferTest, LargeEmplacementsGetDedicatedDeviceBuffers) {
+  auto allocator = std::make_shared<MappedAllocator>();
+  auto buffer = HostBuffer::Create(allocator);
+
+  auto small = buffer->Emplace(uint32_t{});
+  auto large = buffer->Emplace(nullptr, HostBuffer::kAllocatorBlockSize + 1u,
+                               alignof(uint32_t));
+  ASSERT_TRUE(small);
+  ASSERT_TRUE(large);
+  EXPECT_NE(small.buffer, large.buffer);
+  EXPECT_EQ(large.range, Range(0u, HostBuffer::kAllocatorBlockSize + 1u));
+
+  // The remainder of the first block is still used for small emplacements.
+  auto next = buffer->Emplace(uint32_t{});
+  EXPECT_EQ(next.buffer, small.buffer);
+  EXPECT_EQ(next.range.offset, 4u);
+}
+
 }  // namespace  testing
 }  // namespace impeller
@@ -5,6 +5,10 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_PIPELINE_BUILDER_H_
 #define FLUTTER_IMPELLER_RENDERER_PIPELINE_BUILDER_H_
 
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
 #include "impeller/base/strings.h"
@@ -59,6 +63,31 @@ struct PipelineBuilder {
     return std::nullopt;
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the values to specialize a pipeline with, which are
+  ///             the reflected defaults of the fragment shader except for
+  ///             |overrides|.
+  ///
+  /// @param[in]  overrides  The reflected constants of the fragment shader,
+  ///                        such as
+  ///                        `FragmentShader::kSpecializationConstantFoo`, with
+  ///                        the values to use instead of their defaults.
+  ///
+  static std::vector<Scalar> MakeSpecializationConstants(
+      std::initializer_list<std::pair<const ShaderSpecializationConstant*,
+                                      Scalar>> overrides = {}) {
+    std::vector<Scalar> constants(
+        FragmentShader::kAllSpecializationConstants.size());
+    for (const auto* constant : FragmentShader::kAllSpecializationConstants) {
+      constants[constant->constant_id] = constant->default_value;
+    }
+    for (const auto& [constant, value] : overrides) {
+      FML_DCHECK(constant->constant_id < constants.size());
+      constants[constant->constant_id] = value;
+    }
+    return constants;
+  }
+
   [[nodiscard]] static bool InitializePipelineDescriptorDefaults(
       const Context& context,
       PipelineDescriptor& desc) {
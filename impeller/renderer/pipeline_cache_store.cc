@@ -0,0 +1,186 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/pipeline_cache_store.h"
+
+#include <cstring>
+#include <iterator>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+namespace {
+
+// Precedes the version string and the data in each entry.
+struct EntryHeader {
+  static constexpr uint32_t kMagic = 0x49504353;  // "IPCS"
+
+  uint32_t magic = kMagic;
+  uint32_t version_length = 0u;
+  uint64_t data_size = 0u;
+};
+
+}  // namespace
+
+std::shared_ptr<PipelineCacheStore> PipelineCacheStore::Create(
+    fml::UniqueFD directory,
+    Settings settings) {
+  if (!directory.is_valid()) {
+    return nullptr;
+  }
+  return std::shared_ptr<PipelineCacheStore>(
+      new PipelineCacheStore(std::move(directory), std::move(settings)));
+}
+
+PipelineCacheStore::PipelineCacheStore(fml::UniqueFD directory,
+                                       Settings settings)
+    : directory_(std::move(directory)), settings_(std::move(settings)) {
+  TRACE_EVENT0("impeller", "PipelineCacheStore::PipelineCacheStore");
+  fml::VisitFiles(directory_, [&](const fml::UniqueFD& directory,
+                                  const std::string& file_name) {
+    auto mapping = fml::FileMapping::CreateReadOnly(directory, file_name);
+    if (mapping) {
+      entries_.push_back({file_name, mapping->GetSize()});
+      entries_index_[file_name] = std::prev(entries_.end());
+      size_ += mapping->GetSize();
+    }
+    return true;
+  });
+  std::scoped_lock lock(mutex_);
+  EvictLocked(settings_.max_size);
+}
+
+PipelineCacheStore::~PipelineCacheStore() = default;
+
+std::unique_ptr<fml::Mapping> PipelineCacheStore::Load(const std::string& key) {
+  TRACE_EVENT0("impeller", "PipelineCacheStore::Load");
+  std::shared_ptr<fml::Mapping> mapping =
+      fml::FileMapping::CreateReadOnly(directory_, key);
+
+  std::scoped_lock lock(mutex_);
+  if (!mapping) {
+    ForgetEntryLocked(key);
+    return nullptr;
+  }
+
+  EntryHeader header;
+  const size_t version_size = settings_.version.size();
+  bool is_current = mapping->GetSize() >= sizeof(EntryHeader);
+  if (is_current) {
+    std::memcpy(&header, mapping->GetMapping(), sizeof(EntryHeader));
+    is_current =
+        header.magic == EntryHeader::kMagic &&
+        header.version_length == version_size &&
+        mapping->GetSize() - sizeof(EntryHeader) >= version_size &&
+        header.data_size ==
+            mapping->GetSize() - sizeof(EntryHeader) - version_size &&
+        std::memcmp(mapping->GetMapping() + sizeof(EntryHeader),
+                    settings_.version.data(), version_size) == 0;
+  }
+  if (!is_current) {
+    FML_LOG(INFO) << "Removing outdated pipeline cache entry " << key << ".";
+    RemoveEntryLocked(key);
+    return nullptr;
+  }
+
+  auto found = entries_index_.find(key);
+  if (found != entries_index_.end()) {
+    entries_.splice(entries_.begin(), entries_, found->second);
+  }
+  const uint8_t* data =
+      mapping->GetMapping() + sizeof(EntryHeader) + version_size;
+  return std::make_unique<fml::NonOwnedMapping>(
+      data, header.data_size,
+      [mapping = std::move(mapping)](const uint8_t*, size_t) {});
+}
+
+void PipelineCacheStore::Store(const std::string& key,
+                               std::shared_ptr<const fml::Mapping> data) {
+  if (key.empty() || key.find('/') != std::string::npos || !data) {
+    FML_LOG(ERROR) << "Invalid pipeline cache entry.";
+    return;
+  }
+  if (!settings_.worker_task_runner) {
+    Write(key, *data);
+    return;
+  }
+  settings_.worker_task_runner->PostTask(
+      [weak_store = weak_from_this(), key, data = std::move(data)]() {
+        if (auto store = weak_store.lock()) {
+          store->Write(key, *data);
+        }
+      },
+      fml::ConcurrentTaskPriority::kBackground);
+}
+
+size_t PipelineCacheStore::GetSize() const {
+  std::scoped_lock lock(mutex_);
+  return size_;
+}
+
+void PipelineCacheStore::Write(const std::string& key,
+                               const fml::Mapping& data) {
+  TRACE_EVENT0("impeller", "PipelineCacheStore::Write");
+  const size_t version_size = settings_.version.size();
+  const size_t entry_size = sizeof(EntryHeader) + version_size + data.GetSize();
+
+  // Holding the lock while writing keeps writes of the same key in order.
+  std::scoped_lock lock(mutex_);
+  if (entry_size > settings_.max_size) {
+    // The previous entry is outdated either way.
+    if (entries_index_.count(key) > 0) {
+      RemoveEntryLocked(key);
+    }
+    return;
+  }
+  ForgetEntryLocked(key);
+  EvictLocked(settings_.max_size - entry_size);
+
+  std::vector<uint8_t> contents(entry_size);
+  EntryHeader header;
+  header.version_length = version_size;
+  header.data_size = data.GetSize();
+  std::memcpy(contents.data(), &header, sizeof(EntryHeader));
+  std::memcpy(contents.data() + sizeof(EntryHeader), settings_.version.data(),
+              version_size);
+  if (data.GetSize() > 0) {
+    std::memcpy(contents.data() + sizeof(EntryHeader) + version_size,
+                data.GetMapping(), data.GetSize());
+  }
+  if (!fml::WriteAtomically(directory_, key.c_str(),
+                            fml::DataMapping(std::move(contents)))) {
+    FML_LOG(ERROR) << "Could not write pipeline cache entry " << key << ".";
+    return;
+  }
+  entries_.push_front({key, entry_size});
+  entries_index_[key] = entries_.begin();
+  size_ += entry_size;
+}
+
+void PipelineCacheStore::RemoveEntryLocked(const std::string& key) {
+  fml::UnlinkFile(directory_, key.c_str());
+  ForgetEntryLocked(key);
+}
+
+void PipelineCacheStore::ForgetEntryLocked(const std::string& key) {
+  auto found = entries_index_.find(key);
+  if (found == entries_index_.end()) {
+    return;
+  }
+  size_ -= found->second->size;
+  entries_.erase(found->second);
+  entries_index_.erase(found);
+}
+
+void PipelineCacheStore::EvictLocked(size_t max_size) {
+  while (size_ > max_size && !entries_.empty()) {
+    RemoveEntryLocked(std::string{entries_.back().key});
+  }
+}
+
+}  // namespace impeller
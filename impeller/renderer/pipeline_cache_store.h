@@ -0,0 +1,115 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_PIPELINE_CACHE_STORE_H_
+#define FLUTTER_IMPELLER_RENDERER_PIPELINE_CACHE_STORE_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Persists the data that backends derive from compiled pipelines
+///             across launches, such as Vulkan pipeline caches, GLES program
+///             binaries and Metal binary archives.
+///
+///             Every entry is a file in the directory of the store, and starts
+///             with the version the store was created with. Entries written
+///             with another version, for instance by another engine or for
+///             another driver, are removed when they are loaded. The total size
+///             of the entries is bounded, and storing an entry that does not
+///             fit removes the least recently used ones.
+///
+///             All methods may be called on any thread.
+///
+class PipelineCacheStore
+    : public std::enable_shared_from_this<PipelineCacheStore> {
+ public:
+  struct Settings {
+    /// Identifies the data that can be used by this process, for example
+    /// the name and version of the driver. Changing it invalidates all
+    /// entries.
+    std::string version;
+    /// The maximum number of bytes of all entries together.
+    size_t max_size = 64u * 1024u * 1024u;
+    /// The task runner entries are written on. If null, entries are written
+    /// on the thread that stores them.
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a store for the entries in |directory|.
+  ///
+  /// @return     The store, or null if |directory| is not valid.
+  ///
+  static std::shared_ptr<PipelineCacheStore> Create(fml::UniqueFD directory,
+                                                    Settings settings);
+
+  ~PipelineCacheStore();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the data stored under |key| with the current version,
+  ///             or null if there is none.
+  ///
+  std::unique_ptr<fml::Mapping> Load(const std::string& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stores |data| under |key|, replacing any previous entry.
+  ///
+  /// @param[in]  key   The name of the entry. It must be a valid file name.
+  /// @param[in]  data  The data to store.
+  ///
+  void Store(const std::string& key, std::shared_ptr<const fml::Mapping> data);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the number of bytes of all entries, including their
+  ///             headers.
+  ///
+  size_t GetSize() const;
+
+ private:
+  struct Entry {
+    std::string key;
+    size_t size = 0;
+  };
+  using EntryList = std::list<Entry>;
+
+  const fml::UniqueFD directory_;
+  const Settings settings_;
+  mutable std::mutex mutex_;
+  // Most recently used first.
+  EntryList entries_;
+  std::unordered_map<std::string, EntryList::iterator> entries_index_;
+  size_t size_ = 0u;
+
+  PipelineCacheStore(fml::UniqueFD directory, Settings settings);
+
+  void Write(const std::string& key, const fml::Mapping& data);
+
+  // Must be called with |mutex_| held.
+  void RemoveEntryLocked(const std::string& key);
+
+  // Drops the bookkeeping of an entry but leaves its file alone. Must be
+  // called with |mutex_| held.
+  void ForgetEntryLocked(const std::string& key);
+
+  // Must be called with |mutex_| held.
+  void EvictLocked(size_t max_size);
+
+  PipelineCacheStore(const PipelineCacheStore&) = delete;
+
+  PipelineCacheStore& operator=(const PipelineCacheStore&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_PIPELINE_CACHE_STORE_H_
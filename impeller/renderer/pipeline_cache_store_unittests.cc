@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/file.h"
+#include "gtest/gtest.h"
+
+#include "impeller/renderer/pipeline_cache_store.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+std::shared_ptr<PipelineCacheStore> CreateStore(
+    const fml::ScopedTemporaryDirectory& directory,
+    const std::string& version,
+    size_t max_size = 1024u) {
+  PipelineCacheStore::Settings settings;
+  settings.version = version;
+  settings.max_size = max_size;
+  return PipelineCacheStore::Create(
+      fml::OpenDirectory(directory.path().c_str(), false,
+                         fml::FilePermission::kReadWrite),
+      std::move(settings));
+}
+
+std::shared_ptr<const fml::Mapping> MakeData(const std::string& data) {
+  return std::make_shared<fml::DataMapping>(data);
+}
+
+std::string ToString(const std::unique_ptr<fml::Mapping>& mapping) {
+  return {reinterpret_cast<const char*>(mapping->GetMapping()),
+          mapping->GetSize()};
+}
+
+}  // namespace
+
+TEST(PipelineCacheStoreTest, RejectsInvalidDirectory) {
+  EXPECT_EQ(PipelineCacheStore::Create(fml::UniqueFD(), {}), nullptr);
+}
+
+TEST(PipelineCacheStoreTest, EntriesPersistAcrossStores) {
+  fml::ScopedTemporaryDirectory directory;
+  {
+    auto store = CreateStore(directory, "driver 1");
+    ASSERT_NE(store, nullptr);
+    EXPECT_EQ(store->Load("pipelines"), nullptr);
+    store->Store("pipelines", MakeData("binary"));
+    auto mapping = store->Load("pipelines");
+    ASSERT_NE(mapping, nullptr);
+    EXPECT_EQ(ToString(mapping), "binary");
+  }
+
+  auto store = CreateStore(directory, "driver 1");
+  ASSERT_NE(store, nullptr);
+  EXPECT_GT(store->GetSize(), 0u);
+  auto mapping = store->Load("pipelines");
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_EQ(ToString(mapping), "binary");
+}
+
+TEST(PipelineCacheStoreTest, VersionChangeInvalidatesEntries) {
+  fml::ScopedTemporaryDirectory directory;
+  CreateStore(directory, "driver 1")->Store("pipelines", MakeData("binary"));
+
+  auto store = CreateStore(directory, "driver 2");
+  EXPECT_EQ(store->Load("pipelines"), nullptr);
+  EXPECT_EQ(store->GetSize(), 0u);
+  EXPECT_EQ(fml::FileMapping::CreateReadOnly(directory.fd(), "pipelines"),
+            nullptr);
+}
+
+TEST(PipelineCacheStoreTest, EvictsLeastRecentlyUsedEntries) {
+  fml::ScopedTemporaryDirectory directory;
+  // Leaves room for two entries with their headers.
+  auto store = CreateStore(directory, "v", 128u);
+  const std::string data(40u, 'x');
+  store->Store("a", MakeData(data));
+  store->Store("b", MakeData(data));
+  EXPECT_NE(store->Load("a"), nullptr);
+  store->Store("c", MakeData(data));
+
+  EXPECT_NE(store->Load("a"), nullptr);
+  EXPECT_EQ(store->Load("b"), nullptr);
+  EXPECT_NE(store->Load("c"), nullptr);
+  EXPECT_LE(store->GetSize(), 128u);
+
+  // An entry that can never fit is not stored.
+  store->Store("d", MakeData(std::string(200u, 'x')));
+  EXPECT_EQ(store->Load("d"), nullptr);
+}
+
+TEST(PipelineCacheStoreTest, RejectsInvalidKeys) {
+  fml::ScopedTemporaryDirectory directory;
+  auto store = CreateStore(directory, "v");
+  store->Store("", MakeData("binary"));
+  store->Store("nested/key", MakeData("binary"));
+  EXPECT_EQ(store->GetSize(), 0u);
+}
+
+}  // namespace testing
+}  // namespace impeller
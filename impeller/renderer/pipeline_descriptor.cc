@@ -46,6 +46,9 @@ std::size_t PipelineDescriptor::GetHash() const {
   fml::HashCombineSeed(seed, primitive_type_);
   fml::HashCombineSeed(seed, polygon_mode_);
   fml::HashCombineSeed(seed, use_subpass_input_);
+  for (const auto& constant : specialization_constants_) {
+    fml::HashCombineSeed(seed, constant);
+  }
   return seed;
 }
 
@@ -23,5 +23,20 @@ TEST(PipelineDescriptorTest, PrimitiveTypeHashEquality) {
   ASSERT_NE(descA.GetHash(), descB.GetHash());
 }
 
+TEST(PipelineDescriptorTest, SpecializationConstantsHashEquality) {
+  PipelineDescriptor descA;
+  PipelineDescriptor descB;
+  descA.SetSpecializationConstants({0.0f, 1.0f});
+  descB.SetSpecializationConstants({0.0f, 1.0f});
+
+  ASSERT_TRUE(descA.IsEqual(descB));
+  ASSERT_EQ(descA.GetHash(), descB.GetHash());
+
+  descB.SetSpecializationConstants({1.0f, 1.0f});
+
+  ASSERT_FALSE(descA.IsEqual(descB));
+  ASSERT_NE(descA.GetHash(), descB.GetHash());
+}
+
 }  // namespace  testing
 }  // namespace impeller
@@ -32,4 +32,12 @@ PipelineFuture<ComputePipelineDescriptor> PipelineLibrary::GetPipeline(
   return {descriptor, promise->get_future()};
 }
 
+std::unique_ptr<fml::Mapping> PipelineLibrary::LoadPipelineUsageManifest()
+    const {
+  return nullptr;
+}
+
+void PipelineLibrary::PersistPipelineUsageManifest(
+    std::shared_ptr<const fml::Mapping> manifest) {}
+
 }  // namespace impeller
@@ -9,6 +9,7 @@
 
 #include "compute_pipeline_descriptor.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
 #include "impeller/renderer/pipeline.h"
 #include "impeller/renderer/pipeline_descriptor.h"
 
@@ -48,6 +49,28 @@ class PipelineLibrary : public std::enable_shared_from_this<PipelineLibrary> {
   virtual void RemovePipelinesWithEntryPoint(
       std::shared_ptr<const ShaderFunction> function) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Reads the pipeline usage manifest persisted by a previous
+  ///             launch of the application.
+  ///
+  /// @return     The manifest, or `nullptr` if the backend does not keep one
+  ///             or none has been persisted yet.
+  ///
+  virtual std::unique_ptr<fml::Mapping> LoadPipelineUsageManifest() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Asynchronously persists a manifest of the pipeline variants
+  ///             used by the renderer so that the next launch of the
+  ///             application can compile them ahead of time. The contents of
+  ///             the manifest are opaque to the library.
+  ///
+  ///             Backends without an on-disk cache drop the manifest.
+  ///
+  /// @param[in]  manifest  The manifest to persist.
+  ///
+  virtual void PersistPipelineUsageManifest(
+      std::shared_ptr<const fml::Mapping> manifest);
+
  protected:
   PipelineLibrary();
 
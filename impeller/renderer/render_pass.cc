@@ -4,6 +4,9 @@
 
 #include "impeller/renderer/render_pass.h"
 
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/context.h"
+
 namespace impeller {
 
 RenderPass::RenderPass(std::weak_ptr<const Context> context,
@@ -22,7 +25,7 @@ RenderPass::RenderPass(std::weak_ptr<const Context> context,
 
 RenderPass::~RenderPass() {
   auto strong_context = context_.lock();
-  if (strong_context) {
+  if (strong_context && is_transients_buffer_pooled_) {
     strong_context->GetHostBufferPool().Recycle(transients_buffer_);
   }
 }
@@ -51,6 +54,19 @@ HostBuffer& RenderPass::GetTransientsBuffer() {
   return *transients_buffer_;
 }
 
+void RenderPass::SetTransientsBuffer(
+    std::shared_ptr<HostBuffer> transients_buffer) {
+  if (!transients_buffer) {
+    return;
+  }
+  auto strong_context = context_.lock();
+  if (strong_context && is_transients_buffer_pooled_) {
+    strong_context->GetHostBufferPool().Recycle(std::move(transients_buffer_));
+  }
+  transients_buffer_ = std::move(transients_buffer);
+  is_transients_buffer_pooled_ = false;
+}
+
 void RenderPass::SetLabel(std::string label) {
   if (label.empty()) {
     return;
@@ -65,6 +81,16 @@ bool RenderPass::AddCommand(Command&& command) {
     return false;
   }
 
+  if (scissor_limit_.has_value()) {
+    command.scissor = command.scissor.has_value()
+                          ? command.scissor->Intersection(*scissor_limit_)
+                          : scissor_limit_;
+    if (!command.scissor.has_value()) {
+      // Nothing the command draws is visible.
+      return true;
+    }
+  }
+
   if (command.scissor.has_value()) {
     auto target_rect = IRect::MakeSize(render_target_.GetRenderTargetSize());
     if (!target_rect.Contains(command.scissor.value())) {
@@ -81,10 +107,53 @@ bool RenderPass::AddCommand(Command&& command) {
     return true;
   }
 
+  // Images are uploaded without their mip levels, which are only generated
+  // once an image is drawn. Images that never are don't pay for them.
+  GenerateMissingMipmaps(command.vertex_bindings);
+  GenerateMissingMipmaps(command.fragment_bindings);
+
   commands_.emplace_back(std::move(command));
   return true;
 }
 
+void RenderPass::GenerateMissingMipmaps(const Bindings& bindings) const {
+  for (const TextureAndSampler& sampled_image : bindings.sampled_images) {
+    const std::shared_ptr<const Texture>& texture =
+        sampled_image.texture.resource;
+    if (!texture->NeedsMipmapGeneration()) {
+      continue;
+    }
+    auto context = context_.lock();
+    if (!context) {
+      return;
+    }
+    auto command_buffer = context->CreateCommandBuffer();
+    if (!command_buffer) {
+      VALIDATION_LOG
+          << "Could not create command buffer for mipmap generation.";
+      return;
+    }
+    command_buffer->SetLabel("Mipmap Command Buffer");
+    auto blit_pass = command_buffer->CreateBlitPass();
+    if (!blit_pass) {
+      VALIDATION_LOG << "Could not create blit pass for mipmap generation.";
+      return;
+    }
+    blit_pass->SetLabel("Mipmap Blit Pass");
+    // The mip levels are derived from the contents of the texture, which they
+    // don't change.
+    blit_pass->GenerateMipmap(std::const_pointer_cast<Texture>(texture));
+    if (!command_buffer->EncodeAndSubmit(blit_pass,
+                                         context->GetResourceAllocator())) {
+      VALIDATION_LOG << "Could not submit mipmap generation.";
+    }
+  }
+}
+
+void RenderPass::SetScissorLimit(std::optional<IRect> scissor) {
+  scissor_limit_ = scissor;
+}
+
 bool RenderPass::EncodeCommands() const {
   auto context = context_.lock();
   // The context could have been collected in the meantime.
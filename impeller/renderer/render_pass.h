@@ -49,6 +49,13 @@ class RenderPass {
 
   HostBuffer& GetTransientsBuffer();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Replace the transients buffer taken from the context's pool,
+  ///             for example with one that is shared by all passes of a frame.
+  ///             The caller is responsible for resetting it.
+  ///
+  void SetTransientsBuffer(std::shared_ptr<HostBuffer> transients_buffer);
+
   //----------------------------------------------------------------------------
   /// @brief      Record a command for subsequent encoding to the underlying
   ///             command buffer. No work is encoded into the command buffer at
@@ -60,6 +67,16 @@ class RenderPass {
   ///
   bool AddCommand(Command&& command);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Limit the commands added from now on to the given scissor
+  ///             rect. Commands that set their own scissor are limited to the
+  ///             intersection of both, and commands outside of it are dropped.
+  ///
+  /// @param[in]  scissor  The scissor rect, which must lie within the render
+  ///                      target, or `std::nullopt` to stop limiting commands.
+  ///
+  void SetScissorLimit(std::optional<IRect> scissor);
+
   //----------------------------------------------------------------------------
   /// @brief      Encode the recorded commands to the underlying command buffer.
   ///
@@ -100,7 +117,9 @@ class RenderPass {
   const ISize render_target_size_;
   const RenderTarget render_target_;
   std::shared_ptr<HostBuffer> transients_buffer_;
+  bool is_transients_buffer_pooled_ = true;
   std::vector<Command> commands_;
+  std::optional<IRect> scissor_limit_;
 
   RenderPass(std::weak_ptr<const Context> context, const RenderTarget& target);
 
@@ -109,6 +128,10 @@ class RenderPass {
   virtual bool OnEncodeCommands(const Context& context) const = 0;
 
  private:
+  // Generates the mip levels of the textures in |bindings| that don't have
+  // them yet, in a blit pass that is submitted before this render pass.
+  void GenerateMissingMipmaps(const Bindings& bindings) const;
+
   RenderPass(const RenderPass&) = delete;
 
   RenderPass& operator=(const RenderPass&) = delete;
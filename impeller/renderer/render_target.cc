@@ -22,6 +22,8 @@ void RenderTargetAllocator::Start() {}
 
 void RenderTargetAllocator::End() {}
 
+void RenderTargetAllocator::DisposeUnused() {}
+
 std::shared_ptr<Texture> RenderTargetAllocator::CreateTexture(
     const TextureDescriptor& desc) {
   return allocator_->CreateTexture(desc);
@@ -42,6 +42,11 @@ class RenderTargetAllocator {
   ///        This may be used to deallocate any unused textures.
   virtual void End();
 
+  /// @brief Release any textures that were kept alive although they were not
+  ///        used by the last frame, for example while the application is
+  ///        idle.
+  virtual void DisposeUnused();
+
  private:
   std::shared_ptr<Allocator> allocator_;
 };
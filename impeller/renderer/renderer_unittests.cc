@@ -814,6 +814,60 @@ TEST_P(RendererTest, CanGenerateMipmaps) {
   OpenPlaygroundHere(callback);
 }
 
+TEST_P(RendererTest, GeneratesMipmapsWhenTexturesAreFirstDrawn) {
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+
+  using VS = MipmapsVertexShader;
+  using FS = MipmapsFragmentShader;
+  auto desc = PipelineBuilder<VS, FS>::MakeDefaultPipelineDescriptor(*context);
+  ASSERT_TRUE(desc.has_value());
+  desc->SetStencilAttachmentDescriptors(std::nullopt);
+  auto mipmaps_pipeline =
+      context->GetPipelineLibrary()->GetPipeline(std::move(desc)).Get();
+  ASSERT_TRUE(mipmaps_pipeline);
+
+  TextureDescriptor texture_desc;
+  texture_desc.storage_mode = StorageMode::kHostVisible;
+  texture_desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  texture_desc.size = {64, 64};
+  texture_desc.mip_count = texture_desc.size.MipCount();
+  auto texture = context->GetResourceAllocator()->CreateTexture(texture_desc);
+  ASSERT_TRUE(texture);
+  std::vector<uint8_t> pixels(texture_desc.GetByteSizeOfBaseMipLevel(), 0xff);
+  ASSERT_TRUE(texture->SetContents(pixels.data(), pixels.size()));
+  EXPECT_TRUE(texture->NeedsMipmapGeneration());
+
+  VertexBufferBuilder<VS::PerVertexData> vertex_builder;
+  vertex_builder.AddVertices({
+      {{0, 0}, {0.0, 0.0}},
+      {{64, 0}, {1.0, 0.0}},
+      {{64, 64}, {1.0, 1.0}},
+  });
+  auto vertex_buffer =
+      vertex_builder.CreateVertexBuffer(*context->GetResourceAllocator());
+
+  auto render_target_cache = std::make_shared<RenderTargetAllocator>(
+      context->GetResourceAllocator());
+  auto render_target =
+      RenderTarget::CreateOffscreen(*context, *render_target_cache, {64, 64});
+  auto buffer = context->CreateCommandBuffer();
+  auto pass = buffer->CreateRenderPass(render_target);
+  ASSERT_TRUE(pass);
+
+  Command cmd;
+  cmd.pipeline = mipmaps_pipeline;
+  cmd.BindVertices(vertex_buffer);
+  VS::BindFrameInfo(
+      cmd, pass->GetTransientsBuffer().EmplaceUniform(VS::FrameInfo{}));
+  FS::BindFragInfo(cmd,
+                   pass->GetTransientsBuffer().EmplaceUniform(FS::FragInfo{}));
+  FS::BindTex(cmd, texture, context->GetSamplerLibrary()->GetSampler({}));
+  ASSERT_TRUE(pass->AddCommand(std::move(cmd)));
+
+  EXPECT_FALSE(texture->NeedsMipmapGeneration());
+}
+
 TEST_P(RendererTest, TheImpeller) {
   using VS = ImpellerVertexShader;
   using FS = ImpellerFragmentShader;
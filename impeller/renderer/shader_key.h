@@ -11,6 +11,7 @@
 
 #include "flutter/fml/hash_combine.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
 #include "impeller/core/shader_types.h"
 
 namespace impeller {
@@ -43,6 +44,11 @@ using ShaderFunctionMap =
                        ShaderKey::Hash,
                        ShaderKey::Equal>;
 
+using ShaderCodeMap = std::unordered_map<ShaderKey,
+                                         std::shared_ptr<fml::Mapping>,
+                                         ShaderKey::Hash,
+                                         ShaderKey::Equal>;
+
 }  // namespace impeller
 
 #endif  // FLUTTER_IMPELLER_RENDERER_SHADER_KEY_H_
@@ -4,6 +4,8 @@
 
 #include "impeller/scene/geometry.h"
 
+#include <algorithm>
+#include <array>
 #include <iostream>
 #include <memory>
 #include <ostream>
@@ -19,10 +21,36 @@
 #include "impeller/scene/importer/scene_flatbuffers.h"
 #include "impeller/scene/shaders/skinned.vert.h"
 #include "impeller/scene/shaders/unskinned.vert.h"
+#include "impeller/scene/shaders/unskinned_instanced.vert.h"
 
 namespace impeller {
 namespace scene {
 
+//------------------------------------------------------------------------------
+/// AABB
+///
+
+bool AABB::IsOutsideFrustum(const Matrix& mvp) const {
+  std::array<Vector4, 8> corners;
+  for (size_t i = 0; i < corners.size(); i++) {
+    corners[i] = mvp * Vector4(i & 1 ? max.x : min.x,  //
+                               i & 2 ? max.y : min.y,  //
+                               i & 4 ? max.z : min.z,  //
+                               1.0f);
+  }
+  // The box is outside if all of its corners are on the outer side of one of
+  // the clip planes. Depth is clipped to [0, w].
+  auto all_outside = [&corners](auto is_outside) {
+    return std::all_of(corners.begin(), corners.end(), is_outside);
+  };
+  return all_outside([](const Vector4& c) { return c.x < -c.w; }) ||
+         all_outside([](const Vector4& c) { return c.x > c.w; }) ||
+         all_outside([](const Vector4& c) { return c.y < -c.w; }) ||
+         all_outside([](const Vector4& c) { return c.y > c.w; }) ||
+         all_outside([](const Vector4& c) { return c.z < 0.0f; }) ||
+         all_outside([](const Vector4& c) { return c.z > c.w; });
+}
+
 //------------------------------------------------------------------------------
 /// Geometry
 ///
@@ -64,6 +92,7 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
   const uint8_t* vertices_start;
   size_t vertices_bytes;
   bool is_skinned;
+  std::optional<AABB> bounds;
 
   switch (mesh.vertices_type()) {
     case fb::VertexBuffer::UnskinnedVertexBuffer: {
@@ -72,6 +101,17 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
       vertices_start = reinterpret_cast<const uint8_t*>(vertices->Get(0));
       vertices_bytes = vertices->size() * sizeof(fb::Vertex);
       is_skinned = false;
+      // Skinned vertices move with their joints, so only unskinned ones have
+      // bounds.
+      for (const auto* vertex : *vertices) {
+        const Vector3 position(vertex->position().x(), vertex->position().y(),
+                               vertex->position().z());
+        if (!bounds.has_value()) {
+          bounds = AABB{position, position};
+        }
+        bounds->min = bounds->min.Min(position);
+        bounds->max = bounds->max.Max(position);
+      }
       break;
     }
     case fb::VertexBuffer::SkinnedVertexBuffer: {
@@ -116,16 +156,52 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
       .vertex_count = mesh.indices()->count(),
       .index_type = index_type,
   };
-  return MakeVertexBuffer(std::move(vertex_buffer), is_skinned);
+  auto geometry = MakeVertexBuffer(std::move(vertex_buffer), is_skinned);
+  geometry->SetBounds(bounds);
+  return geometry;
+}
+
+bool Geometry::BindInstancesToCommand(const SceneContext& scene_context,
+                                      HostBuffer& buffer,
+                                      const Matrix& view_transform,
+                                      const std::vector<Matrix>& transforms,
+                                      Command& command) const {
+  return false;
 }
 
 void Geometry::SetJointsTexture(const std::shared_ptr<Texture>& texture) {}
 
+const std::optional<AABB>& Geometry::GetBounds() const {
+  return bounds_;
+}
+
+void Geometry::SetBounds(std::optional<AABB> bounds) {
+  bounds_ = bounds;
+}
+
+static void BindInstanceInfo(HostBuffer& buffer,
+                             const Matrix& view_transform,
+                             const std::vector<Matrix>& transforms,
+                             Command& command) {
+  UnskinnedInstancedVertexShader::FrameInfo info;
+  info.view_transform = view_transform;
+  UnskinnedInstancedVertexShader::BindFrameInfo(command,
+                                                buffer.EmplaceUniform(info));
+  UnskinnedInstancedVertexShader::BindInstanceInfo(
+      command, buffer.Emplace(transforms.data(),
+                              transforms.size() * sizeof(Matrix),
+                              DefaultUniformAlignment()));
+  command.instance_count = transforms.size();
+}
+
 //------------------------------------------------------------------------------
 /// CuboidGeometry
 ///
 
-CuboidGeometry::CuboidGeometry() = default;
+CuboidGeometry::CuboidGeometry() {
+  // The vertices span the unit square, regardless of the size.
+  SetBounds(AABB{Vector3(0, 0, 0), Vector3(1, 1, 0)});
+}
 
 CuboidGeometry::~CuboidGeometry() = default;
 
@@ -173,6 +249,19 @@ void CuboidGeometry::BindToCommand(const SceneContext& scene_context,
   UnskinnedVertexShader::BindFrameInfo(command, buffer.EmplaceUniform(info));
 }
 
+// |Geometry|
+bool CuboidGeometry::BindInstancesToCommand(
+    const SceneContext& scene_context,
+    HostBuffer& buffer,
+    const Matrix& view_transform,
+    const std::vector<Matrix>& transforms,
+    Command& command) const {
+  command.BindVertices(
+      GetVertexBuffer(*scene_context.GetContext()->GetResourceAllocator()));
+  BindInstanceInfo(buffer, view_transform, transforms, command);
+  return true;
+}
+
 //------------------------------------------------------------------------------
 /// UnskinnedVertexBufferGeometry
 ///
@@ -211,6 +300,19 @@ void UnskinnedVertexBufferGeometry::BindToCommand(
   UnskinnedVertexShader::BindFrameInfo(command, buffer.EmplaceUniform(info));
 }
 
+// |Geometry|
+bool UnskinnedVertexBufferGeometry::BindInstancesToCommand(
+    const SceneContext& scene_context,
+    HostBuffer& buffer,
+    const Matrix& view_transform,
+    const std::vector<Matrix>& transforms,
+    Command& command) const {
+  command.BindVertices(
+      GetVertexBuffer(*scene_context.GetContext()->GetResourceAllocator()));
+  BindInstanceInfo(buffer, view_transform, transforms, command);
+  return true;
+}
+
 //------------------------------------------------------------------------------
 /// SkinnedVertexBufferGeometry
 ///
@@ -6,6 +6,8 @@
 #define FLUTTER_IMPELLER_SCENE_GEOMETRY_H_
 
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/core/allocator.h"
@@ -25,6 +27,15 @@ namespace scene {
 class CuboidGeometry;
 class UnskinnedVertexBufferGeometry;
 
+/// An axis-aligned bounding box.
+struct AABB {
+  Vector3 min;
+  Vector3 max;
+
+  /// Whether the box is entirely outside of the view frustum of |mvp|.
+  bool IsOutsideFrustum(const Matrix& mvp) const;
+};
+
 class Geometry {
  public:
   virtual ~Geometry();
@@ -47,7 +58,28 @@ class Geometry {
                              const Matrix& transform,
                              Command& command) const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Binds the vertices and one model transform per instance.
+  ///
+  /// @return     Whether the geometry can be instanced. Skinned geometry
+  ///             cannot.
+  ///
+  virtual bool BindInstancesToCommand(const SceneContext& scene_context,
+                                      HostBuffer& buffer,
+                                      const Matrix& view_transform,
+                                      const std::vector<Matrix>& transforms,
+                                      Command& command) const;
+
   virtual void SetJointsTexture(const std::shared_ptr<Texture>& texture);
+
+  /// The bounds of the vertices before they are transformed, if known.
+  /// Geometry without bounds is never culled.
+  const std::optional<AABB>& GetBounds() const;
+
+  void SetBounds(std::optional<AABB> bounds);
+
+ private:
+  std::optional<AABB> bounds_;
 };
 
 class CuboidGeometry final : public Geometry {
@@ -70,6 +102,13 @@ class CuboidGeometry final : public Geometry {
                      const Matrix& transform,
                      Command& command) const override;
 
+  // |Geometry|
+  bool BindInstancesToCommand(const SceneContext& scene_context,
+                              HostBuffer& buffer,
+                              const Matrix& view_transform,
+                              const std::vector<Matrix>& transforms,
+                              Command& command) const override;
+
  private:
   Vector3 size_;
 
@@ -98,6 +137,13 @@ class UnskinnedVertexBufferGeometry final : public Geometry {
                      const Matrix& transform,
                      Command& command) const override;
 
+  // |Geometry|
+  bool BindInstancesToCommand(const SceneContext& scene_context,
+                              HostBuffer& buffer,
+                              const Matrix& view_transform,
+                              const std::vector<Matrix>& transforms,
+                              Command& command) const override;
+
  private:
   VertexBuffer vertex_buffer_;
 
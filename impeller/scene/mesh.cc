@@ -37,12 +37,12 @@ bool Mesh::Render(SceneEncoder& encoder,
                   const Matrix& transform,
                   const std::shared_ptr<Texture>& joints) const {
   for (const auto& mesh : primitives_) {
-    mesh.geometry->SetJointsTexture(joints);
     SceneCommand command = {
         .label = "Mesh Primitive",
         .transform = transform,
         .geometry = mesh.geometry.get(),
         .material = mesh.material.get(),
+        .joints_texture = joints,
     };
     encoder.Add(command);
   }
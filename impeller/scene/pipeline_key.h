@@ -13,7 +13,8 @@ namespace scene {
 enum class GeometryType {
   kUnskinned = 0,
   kSkinned = 1,
-  kLastType = kSkinned,
+  kUnskinnedInstanced = 2,
+  kLastType = kUnskinnedInstanced,
 };
 enum class MaterialType {
   kUnlit = 0,
@@ -8,6 +8,7 @@
 #include "impeller/scene/shaders/skinned.vert.h"
 #include "impeller/scene/shaders/unlit.frag.h"
 #include "impeller/scene/shaders/unskinned.vert.h"
+#include "impeller/scene/shaders/unskinned_instanced.vert.h"
 
 namespace impeller {
 namespace scene {
@@ -59,6 +60,21 @@ SceneContext::SceneContext(std::shared_ptr<Context> context)
   pipelines_[{PipelineKey{GeometryType::kSkinned, MaterialType::kUnlit}}] =
       std::move(skinned_variant);
 
+  // The instance transforms are read from a storage buffer.
+  if (context_->GetCapabilities()->SupportsSSBO()) {
+    auto instanced_variant =
+        MakePipelineVariants<UnskinnedInstancedVertexShader,
+                             UnlitFragmentShader>(*context_);
+    if (instanced_variant) {
+      pipelines_[{PipelineKey{GeometryType::kUnskinnedInstanced,
+                              MaterialType::kUnlit}}] =
+          std::move(instanced_variant);
+      supports_instancing_ = true;
+    } else {
+      FML_LOG(ERROR) << "Could not create instanced pipeline variant.";
+    }
+  }
+
   {
     impeller::TextureDescriptor texture_descriptor;
     texture_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
@@ -110,5 +126,9 @@ std::shared_ptr<Texture> SceneContext::GetPlaceholderTexture() const {
   return placeholder_texture_;
 }
 
+bool SceneContext::SupportsInstancing() const {
+  return supports_instancing_;
+}
+
 }  // namespace scene
 }  // namespace impeller
@@ -53,6 +53,10 @@ class SceneContext {
 
   std::shared_ptr<Texture> GetPlaceholderTexture() const;
 
+  /// Whether unskinned geometry that is drawn several times with the same
+  /// material may be drawn with a single instanced command.
+  bool SupportsInstancing() const;
+
  private:
   class PipelineVariants {
    public:
@@ -144,6 +148,7 @@ class SceneContext {
   // A 1x1 opaque white texture that can be used as a placeholder binding.
   // Available for the lifetime of the scene context
   std::shared_ptr<Texture> placeholder_texture_;
+  bool supports_instancing_ = false;
 
   SceneContext(const SceneContext&) = delete;
 
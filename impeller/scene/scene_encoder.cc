@@ -2,9 +2,13 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <unordered_map>
+#include <utility>
+
 #include "flutter/fml/macros.h"
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/renderer/command.h"
 #include "impeller/renderer/render_target.h"
 #include "impeller/scene/scene_context.h"
@@ -36,6 +40,7 @@ static void EncodeCommand(const SceneContext& scene_context,
                   scene_command.material->GetMaterialType()},
       scene_command.material->GetContextOptions(render_pass));
 
+  scene_command.geometry->SetJointsTexture(scene_command.joints_texture);
   scene_command.geometry->BindToCommand(
       scene_context, host_buffer, view_transform * scene_command.transform,
       cmd);
@@ -44,6 +49,50 @@ static void EncodeCommand(const SceneContext& scene_context,
   render_pass.AddCommand(std::move(cmd));
 }
 
+/// Draws all of |scene_commands| at once. They must share the same unskinned
+/// geometry and material.
+static bool EncodeInstancedCommands(
+    const SceneContext& scene_context,
+    const Matrix& view_transform,
+    RenderPass& render_pass,
+    const std::vector<const SceneCommand*>& scene_commands) {
+  auto& host_buffer = render_pass.GetTransientsBuffer();
+  const SceneCommand& first = *scene_commands.front();
+
+  std::vector<Matrix> transforms;
+  transforms.reserve(scene_commands.size());
+  for (const auto* scene_command : scene_commands) {
+    transforms.push_back(scene_command->transform);
+  }
+
+  Command cmd;
+  DEBUG_COMMAND_INFO(cmd, first.label + " (Instanced)");
+  cmd.stencil_reference = 0;
+  if (!first.geometry->BindInstancesToCommand(scene_context, host_buffer,
+                                              view_transform, transforms,
+                                              cmd)) {
+    return false;
+  }
+  cmd.pipeline = scene_context.GetPipeline(
+      PipelineKey{GeometryType::kUnskinnedInstanced,
+                  first.material->GetMaterialType()},
+      first.material->GetContextOptions(render_pass));
+  if (!cmd.pipeline) {
+    return false;
+  }
+  first.material->BindToCommand(scene_context, host_buffer, cmd);
+
+  render_pass.AddCommand(std::move(cmd));
+  return true;
+}
+
+static bool IsCulled(const Matrix& view_transform,
+                     const SceneCommand& scene_command) {
+  const auto& bounds = scene_command.geometry->GetBounds();
+  return bounds.has_value() &&
+         bounds->IsOutsideFrustum(view_transform * scene_command.transform);
+}
+
 std::shared_ptr<CommandBuffer> SceneEncoder::BuildSceneCommandBuffer(
     const SceneContext& scene_context,
     const Matrix& camera_transform,
@@ -90,8 +139,48 @@ std::shared_ptr<CommandBuffer> SceneEncoder::BuildSceneCommandBuffer(
     return nullptr;
   }
 
-  for (auto& command : commands_) {
-    EncodeCommand(scene_context, camera_transform, *render_pass, command);
+  // Commands that draw the same unskinned geometry with the same material are
+  // drawn together, in the order of the first one of them.
+  struct Batch {
+    std::vector<const SceneCommand*> commands;
+  };
+  std::vector<Batch> batches;
+  std::unordered_map<Geometry*, std::unordered_map<Material*, size_t>>
+      batch_indices;
+  size_t culled_count = 0u;
+  for (const auto& command : commands_) {
+    if (IsCulled(camera_transform, command)) {
+      culled_count++;
+      continue;
+    }
+    if (!scene_context.SupportsInstancing() ||
+        command.geometry->GetGeometryType() != GeometryType::kUnskinned ||
+        command.joints_texture) {
+      batches.push_back({{&command}});
+      continue;
+    }
+    auto [found, inserted] = batch_indices[command.geometry].try_emplace(
+        command.material, batches.size());
+    if (inserted) {
+      batches.push_back({});
+    }
+    batches[found->second].commands.push_back(&command);
+  }
+  FML_TRACE_COUNTER("impeller", "SceneEncoder",
+                    reinterpret_cast<int64_t>(this),  //
+                    "Commands", commands_.size(),     //
+                    "Culled", culled_count,           //
+                    "Draws", batches.size());
+
+  for (const auto& batch : batches) {
+    if (batch.commands.size() > 1 &&
+        EncodeInstancedCommands(scene_context, camera_transform, *render_pass,
+                                batch.commands)) {
+      continue;
+    }
+    for (const auto* command : batch.commands) {
+      EncodeCommand(scene_context, camera_transform, *render_pass, *command);
+    }
   }
 
   if (!render_pass->EncodeCommands()) {
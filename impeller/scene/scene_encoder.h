@@ -25,6 +25,9 @@ struct SceneCommand {
   Matrix transform;
   Geometry* geometry;
   Material* material;
+  /// The joints of skinned geometry. Geometry may be shared by several
+  /// skinned nodes, so the texture is bound when the command is encoded.
+  std::shared_ptr<Texture> joints_texture;
 };
 
 class SceneEncoder {
@@ -300,6 +300,25 @@ TEST_P(SceneTest, Dash) {
   OpenPlaygroundHere(callback);
 }
 
+TEST(SceneGeometryTest, BoundsOutsideOfTheFrustumAreCulled) {
+  AABB box{Vector3(0, 0, 0), Vector3(1, 1, 0)};
+  EXPECT_FALSE(box.IsOutsideFrustum(Matrix()));
+  EXPECT_TRUE(box.IsOutsideFrustum(Matrix::MakeTranslation({2, 0, 0})));
+  EXPECT_TRUE(box.IsOutsideFrustum(Matrix::MakeTranslation({0, -3, 0})));
+  EXPECT_TRUE(box.IsOutsideFrustum(Matrix::MakeTranslation({0, 0, -1})));
+  EXPECT_TRUE(box.IsOutsideFrustum(Matrix::MakeTranslation({0, 0, 2})));
+
+  // Boxes that cross the frustum are kept, even if no corner is inside.
+  AABB large_box{Vector3(-5, -5, 0.5), Vector3(5, 5, 0.5)};
+  EXPECT_FALSE(large_box.IsOutsideFrustum(Matrix()));
+
+  auto camera = Matrix::MakePerspective(Degrees(60), 1.0f, 0.1f, 100.0f) *
+                Matrix::MakeLookAt({0, 0, -5}, {0, 0, 0}, {0, 1, 0});
+  EXPECT_FALSE(box.IsOutsideFrustum(camera));
+  EXPECT_TRUE(box.IsOutsideFrustum(camera * Matrix::MakeTranslation(
+                                                {0, 0, -10})));
+}
+
 }  // namespace testing
 }  // namespace scene
 }  // namespace impeller
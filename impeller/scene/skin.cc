@@ -7,6 +7,7 @@
 #include <cmath>
 #include <memory>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/fml/logging.h"
@@ -83,6 +84,29 @@ std::shared_ptr<Texture> Skin::GetJointsTexture(Allocator& allocator) {
     return nullptr;
   }
 
+  // Joints usually share most of their ancestors, so the model space matrix
+  // of every bone is only computed once.
+  std::unordered_map<const Node*, Matrix> model_transforms;
+  auto get_model_transform = [&model_transforms](const Node* joint) {
+    // Walk up the bones to the skeleton root, or the first bone whose matrix
+    // is known.
+    std::vector<const Node*> bones;
+    Matrix transform;
+    for (; joint && joint->IsJoint(); joint = joint->GetParent()) {
+      if (auto found = model_transforms.find(joint);
+          found != model_transforms.end()) {
+        transform = found->second;
+        break;
+      }
+      bones.push_back(joint);
+    }
+    for (auto bone = bones.rbegin(); bone != bones.rend(); bone++) {
+      transform = transform * (*bone)->GetLocalTransform();
+      model_transforms[*bone] = transform;
+    }
+    return transform;
+  };
+
   std::vector<Matrix> joints;
   joints.resize(result->GetSize().Area() / 4, Matrix());
   FML_DCHECK(joints.size() >= joints_.size());
@@ -93,12 +117,8 @@ std::shared_ptr<Texture> Skin::GetJointsTexture(Allocator& allocator) {
       continue;
     }
 
-    // Compute a model space matrix for the joint by walking up the bones to the
-    // skeleton root.
-    while (joint && joint->IsJoint()) {
-      joints[joint_i] = joint->GetLocalTransform() * joints[joint_i];
-      joint = joint->GetParent();
-    }
+    // Compute a model space matrix for the joint.
+    joints[joint_i] = get_model_transform(joint);
 
     // Get the joint transform relative to the default pose of the bone by
     // incorporating the joint's inverse bind matrix. The inverse bind matrix
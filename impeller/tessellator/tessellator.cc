@@ -32,9 +32,9 @@ static const TESSalloc kAlloc = {
 };
 
 Tessellator::Tessellator()
-    : point_buffer_(std::make_unique<std::vector<Point>>()),
+    : polyline_(std::make_unique<std::vector<Point>>(), nullptr),
       c_tessellator_(nullptr, &DestroyTessellator) {
-  point_buffer_->reserve(2048);
+  polyline_.points->reserve(2048);
   TESSalloc alloc = kAlloc;
   {
     // libTess2 copies the TESSalloc despite the non-const argument.
@@ -61,6 +61,12 @@ static int ToTessWindingRule(FillType fill_type) {
   return TESS_WINDING_ODD;
 }
 
+const Path::Polyline& Tessellator::CreateTempPolyline(const Path& path,
+                                                     Scalar tolerance) {
+  path.WritePolyline(tolerance, polyline_);
+  return polyline_;
+}
+
 Tessellator::Result Tessellator::Tessellate(const Path& path,
                                             Scalar tolerance,
                                             const BuilderCallback& callback) {
@@ -68,12 +74,7 @@ Tessellator::Result Tessellator::Tessellate(const Path& path,
     return Result::kInputError;
   }
 
-  point_buffer_->clear();
-  auto polyline =
-      path.CreatePolyline(tolerance, std::move(point_buffer_),
-                          [this](Path::Polyline::PointBufferPtr point_buffer) {
-                            point_buffer_ = std::move(point_buffer);
-                          });
+  const auto& polyline = CreateTempPolyline(path, tolerance);
 
   auto fill_type = path.GetFillType();
 
@@ -174,15 +175,10 @@ std::vector<Point> Tessellator::TessellateConvex(const Path& path,
                                                  Scalar tolerance) {
   std::vector<Point> output;
 
-  point_buffer_->clear();
-  auto polyline =
-      path.CreatePolyline(tolerance, std::move(point_buffer_),
-                          [this](Path::Polyline::PointBufferPtr point_buffer) {
-                            point_buffer_ = std::move(point_buffer);
-                          });
+  const auto& polyline = CreateTempPolyline(path, tolerance);
 
   output.reserve(polyline.points->size() +
-                 (4 * (polyline.contours.size() - 1)));
+                 (5 * (polyline.contours.size() - 1)));
   for (auto j = 0u; j < polyline.contours.size(); j++) {
     auto [start, end] = polyline.GetContourPointBounds(j);
     auto first_point = polyline.GetPoint(start);
@@ -195,9 +191,14 @@ std::vector<Point> Tessellator::TessellateConvex(const Path& path,
     }
 
     if (j > 0) {
-      // Triangle strip break.
+      // Triangle strip break. The contour must start at an even index so
+      // that its triangles keep the facing of the contour when the strip is
+      // used to count windings.
       output.emplace_back(output.back());
       output.emplace_back(first_point);
+      if (output.size() % 2 == 1) {
+        output.emplace_back(first_point);
+      }
       output.emplace_back(first_point);
     } else {
       output.emplace_back(first_point);
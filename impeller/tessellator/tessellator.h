@@ -205,6 +205,23 @@ class Tessellator {
                                  Scalar tolerance,
                                  const BuilderCallback& callback);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a polyline of the path in storage owned by the
+  ///             tessellator. The storage is reused by every call so that
+  ///             creating polylines does not allocate once it has grown to
+  ///             fit the paths being drawn.
+  ///
+  /// @param[in]  path  The path to convert.
+  /// @param[in]  tolerance  The tolerance value for conversion of the path to
+  ///                        a polyline. This value is often derived from the
+  ///                        Matrix::GetMaxBasisLength of the CTM applied to the
+  ///                        path for rendering.
+  ///
+  /// @return     The polyline, which is only valid until the next call to a
+  ///             method of this tessellator that takes a path.
+  ///
+  const Path::Polyline& CreateTempPolyline(const Path& path, Scalar tolerance);
+
   //----------------------------------------------------------------------------
   /// @brief      Given a convex path, create a triangle fan structure.
   ///
@@ -296,7 +313,7 @@ class Tessellator {
 
  private:
   /// Used for polyline generation.
-  std::unique_ptr<std::vector<Point>> point_buffer_;
+  Path::Polyline polyline_;
   CTessellator c_tessellator_;
 
   // Data for variouos Circle/EllipseGenerator classes, cached per
@@ -134,6 +134,70 @@ TEST(TessellatorTest, TessellateConvex) {
   }
 }
 
+namespace {
+
+// The number of triangles of |strip| that cover |point|, counted up for the
+// triangles that face one way and down for the others, like the stencil pass
+// of stencil-then-cover does.
+int GetStripWindingAt(const std::vector<Point>& strip, Point point) {
+  int winding = 0;
+  for (size_t i = 0; i + 2 < strip.size(); i++) {
+    Point a = strip[i];
+    Point b = strip[i + 1];
+    Point c = strip[i + 2];
+    // Every other triangle of a strip is wound the other way.
+    if (i % 2 == 1) {
+      std::swap(a, b);
+    }
+    Scalar ab = (b - a).Cross(point - a);
+    Scalar bc = (c - b).Cross(point - b);
+    Scalar ca = (a - c).Cross(point - c);
+    if (ab > 0 && bc > 0 && ca > 0) {
+      winding++;
+    } else if (ab < 0 && bc < 0 && ca < 0) {
+      winding--;
+    }
+  }
+  return winding;
+}
+
+}  // namespace
+
+TEST(TessellatorTest, TessellateConvexKeepsTheFacingOfEveryContour) {
+  Tessellator t;
+  // A pentagon with a square hole, then a square with a triangular hole, so
+  // that contours with odd and even point counts follow each other.
+  auto pts = t.TessellateConvex(PathBuilder{}
+                                    .MoveTo({0, 0})
+                                    .LineTo({100, 0})
+                                    .LineTo({120, 60})
+                                    .LineTo({50, 110})
+                                    .LineTo({-20, 60})
+                                    .Close()
+                                    .MoveTo({30, 30})
+                                    .LineTo({30, 70})
+                                    .LineTo({70, 70})
+                                    .LineTo({70, 30})
+                                    .Close()
+                                    .MoveTo({200, 0})
+                                    .LineTo({300, 0})
+                                    .LineTo({300, 100})
+                                    .LineTo({200, 100})
+                                    .Close()
+                                    .MoveTo({220, 20})
+                                    .LineTo({250, 80})
+                                    .LineTo({280, 20})
+                                    .Close()
+                                    .TakePath(),
+                                1.0);
+
+  EXPECT_EQ(std::abs(GetStripWindingAt(pts, {10, 10})), 1);
+  EXPECT_EQ(GetStripWindingAt(pts, {40, 45}), 0);
+  EXPECT_EQ(std::abs(GetStripWindingAt(pts, {210, 80})), 1);
+  EXPECT_EQ(GetStripWindingAt(pts, {250, 40}), 0);
+  EXPECT_EQ(GetStripWindingAt(pts, {150, 50}), 0);
+}
+
 TEST(TessellatorTest, CircleVertexCounts) {
   auto tessellator = std::make_shared<Tessellator>();
 
@@ -4,20 +4,28 @@
 
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 
+#include <algorithm>
 #include <numeric>
 #include <utility>
 
+#include "flutter/fml/closure.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/allocation.h"
 #include "impeller/core/allocator.h"
 #include "impeller/typographer/backends/skia/glyph_atlas_context_skia.h"
 #include "impeller/typographer/backends/skia/typeface_skia.h"
 #include "impeller/typographer/rectangle_packer.h"
+#include "impeller/typographer/signed_distance_field.h"
+#include "impeller/typographer/text_frame.h"
 #include "impeller/typographer/typographer_context.h"
 #include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkBlurTypes.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkFont.h"
+#include "third_party/skia/include/core/SkMaskFilter.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace impeller {
@@ -27,11 +35,27 @@ namespace impeller {
 //              https://github.com/flutter/flutter/issues/114563
 constexpr auto kPadding = 2;
 
-std::shared_ptr<TypographerContext> TypographerContextSkia::Make() {
-  return std::make_shared<TypographerContextSkia>();
+// Atlases only grow in place up to this size. Beyond it they are rebuilt with
+// only the recently used glyphs, which bounds the memory of long sessions.
+constexpr int64_t kMaxGrownAtlasSize = 2048;
+
+// Glyphs used within this many frames are kept when an atlas is rebuilt.
+constexpr uint64_t kGlyphRetentionFrames = 120u;
+
+// Below this many glyphs, handing them to the workers costs more than drawing
+// them on the calling thread.
+constexpr size_t kMinConcurrentGlyphCount = 64u;
+constexpr size_t kGlyphsPerConcurrentTask = 32u;
+
+std::shared_ptr<TypographerContext> TypographerContextSkia::Make(
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner) {
+  return std::make_shared<TypographerContextSkia>(
+      std::move(worker_task_runner));
 }
 
-TypographerContextSkia::TypographerContextSkia() = default;
+TypographerContextSkia::TypographerContextSkia(
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner)
+    : worker_task_runner_(std::move(worker_task_runner)) {}
 
 TypographerContextSkia::~TypographerContextSkia() = default;
 
@@ -152,14 +176,66 @@ static ISize OptimumAtlasSizeForFontGlyphPairs(
   return ISize{0, 0};
 }
 
+static ISize GrowAtlasForFontGlyphPairs(
+    const std::shared_ptr<GlyphAtlas>& atlas,
+    const std::vector<FontGlyphPair>& extra_pairs,
+    std::vector<Rect>& glyph_positions,
+    const std::shared_ptr<GlyphAtlasContext>& atlas_context,
+    const ISize& max_texture_size) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+
+  auto rect_packer = atlas_context->GetRectPacker();
+  ISize current_size = atlas_context->GetAtlasSize();
+  if (!rect_packer || current_size.IsEmpty()) {
+    return ISize{0, 0};
+  }
+  // Double the shorter side until the extra glyphs fit next to the existing
+  // ones, which keep their positions.
+  while (true) {
+    if (current_size.width <= current_size.height) {
+      current_size.width *= 2;
+    } else {
+      current_size.height *= 2;
+    }
+    if (current_size.width > max_texture_size.width ||
+        current_size.height > max_texture_size.height) {
+      return ISize{0, 0};
+    }
+    auto grown_packer =
+        rect_packer->Grow(current_size.width, current_size.height);
+    glyph_positions.clear();
+    if (CanAppendToExistingAtlas(atlas, extra_pairs, glyph_positions,
+                                 current_size, grown_packer)) {
+      atlas_context->UpdateRectPacker(grown_packer);
+      return current_size;
+    }
+  }
+}
+
+static std::vector<FontGlyphPair> CollectFontGlyphPairs(
+    const FontGlyphMap& font_glyph_map) {
+  std::vector<FontGlyphPair> font_glyph_pairs;
+  font_glyph_pairs.reserve(std::accumulate(
+      font_glyph_map.begin(), font_glyph_map.end(), 0,
+      [](const int a, const auto& b) { return a + b.second.size(); }));
+  for (const auto& font_value : font_glyph_map) {
+    const ScaledFont& scaled_font = font_value.first;
+    for (const Glyph& glyph : font_value.second) {
+      font_glyph_pairs.push_back({scaled_font, glyph});
+    }
+  }
+  return font_glyph_pairs;
+}
+
 static void DrawGlyph(SkCanvas* canvas,
                       const ScaledFont& scaled_font,
                       const Glyph& glyph,
                       const Rect& location,
                       bool has_color) {
   const auto& metrics = scaled_font.font.GetMetrics();
-  const auto position = SkPoint::Make(location.GetX() / scaled_font.scale,
-                                      location.GetY() / scaled_font.scale);
+  const auto position = SkPoint::Make(
+      (location.GetX() + glyph.subpixel_offset / 256.0f) / scaled_font.scale,
+      location.GetY() / scaled_font.scale);
   SkGlyphID glyph_id = glyph.index;
 
   SkFont sk_font(
@@ -167,12 +243,21 @@ static void DrawGlyph(SkCanvas* canvas,
       metrics.point_size, metrics.scaleX, metrics.skewX);
   sk_font.setEdging(SkFont::Edging::kAntiAlias);
   sk_font.setHinting(SkFontHinting::kSlight);
+  // Keep fractional positions so that glyphs at subpixel offsets are shifted
+  // and all glyphs are drawn at the same place relative to their bounds.
+  sk_font.setSubpixel(true);
   sk_font.setEmbolden(metrics.embolden);
 
   auto glyph_color = has_color ? SK_ColorWHITE : SK_ColorBLACK;
 
   SkPaint glyph_paint;
   glyph_paint.setColor(glyph_color);
+  if (scaled_font.blur_sigma > 0.0f && scaled_font.scale > 0.0f) {
+    // The sigma is in atlas pixels and the blur respects the scale below. The
+    // glyph bounds leave room for it.
+    glyph_paint.setMaskFilter(SkMaskFilter::MakeBlur(
+        kNormal_SkBlurStyle, scaled_font.blur_sigma / scaled_font.scale));
+  }
   canvas->resetMatrix();
   canvas->scale(scaled_font.scale, scaled_font.scale);
   canvas->drawGlyphs(1u,         // count
@@ -185,13 +270,22 @@ static void DrawGlyph(SkCanvas* canvas,
   );
 }
 
-static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
-                              const std::shared_ptr<SkBitmap>& bitmap,
-                              const std::vector<FontGlyphPair>& new_pairs) {
-  TRACE_EVENT0("impeller", __FUNCTION__);
-  FML_DCHECK(bitmap != nullptr);
-
-  auto surface = SkSurfaces::WrapPixels(bitmap->pixmap());
+namespace {
+struct AtlasGlyph {
+  const ScaledFont& scaled_font;
+  const Glyph& glyph;
+  Rect location;
+};
+}  // namespace
+
+static bool DrawGlyphRange(const SkBitmap& bitmap,
+                           const std::vector<AtlasGlyph>& glyphs,
+                           size_t begin,
+                           size_t end,
+                           GlyphAtlas::Type type) {
+  TRACE_EVENT0("impeller", "DrawGlyphs");
+  const bool has_color = type == GlyphAtlas::Type::kColorBitmap;
+  auto surface = SkSurfaces::WrapPixels(bitmap.pixmap());
   if (!surface) {
     return false;
   }
@@ -199,27 +293,94 @@ static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
   if (!canvas) {
     return false;
   }
+  for (size_t i = begin; i < end; i++) {
+    const AtlasGlyph& glyph = glyphs[i];
+    // Keep each glyph to its own pixels, which other threads may be drawing
+    // next to.
+    canvas->save();
+    canvas->resetMatrix();
+    canvas->clipRect(SkRect::MakeXYWH(
+        glyph.location.GetX(), glyph.location.GetY(),
+        glyph.location.GetWidth(), glyph.location.GetHeight()));
+    DrawGlyph(canvas, glyph.scaled_font, glyph.glyph, glyph.location,
+              has_color);
+    canvas->restore();
+    if (type == GlyphAtlas::Type::kSignedDistanceField) {
+      ConvertCoverageToSignedDistanceField(
+          bitmap.getAddr8(static_cast<int>(glyph.location.GetX()),
+                          static_cast<int>(glyph.location.GetY())),
+          bitmap.rowBytes(), ISize::Ceil(glyph.location.GetSize()),
+          TextFrame::kSignedDistanceFieldSpread);
+    }
+  }
+  return true;
+}
+
+static bool DrawGlyphs(
+    const SkBitmap& bitmap,
+    const std::vector<AtlasGlyph>& glyphs,
+    GlyphAtlas::Type type,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  // Workers never wait on other workers, which might all be waiting too.
+  if (!worker_task_runner || glyphs.size() < kMinConcurrentGlyphCount ||
+      worker_task_runner->RunsTasksOnCurrentThread()) {
+    return DrawGlyphRange(bitmap, glyphs, 0u, glyphs.size(), type);
+  }
 
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
+  // Glyphs never overlap in the atlas, so ranges of them can be drawn into
+  // the same bitmap concurrently.
+  TRACE_EVENT0("impeller", "DrawGlyphsConcurrently");
+  const size_t task_count =
+      (glyphs.size() + kGlyphsPerConcurrentTask - 1) / kGlyphsPerConcurrentTask;
+  fml::CountDownLatch latch(task_count);
+  std::vector<char> results(task_count, false);
+  for (size_t i = 0; i < task_count; i++) {
+    auto draw_glyphs = [&, i]() {
+      const size_t begin = i * kGlyphsPerConcurrentTask;
+      const size_t end =
+          std::min(begin + kGlyphsPerConcurrentTask, glyphs.size());
+      results[i] = DrawGlyphRange(bitmap, glyphs, begin, end, type);
+      latch.CountDown();
+    };
+    worker_task_runner->PostTask(draw_glyphs,
+                                 fml::ConcurrentTaskPriority::kFrameCritical);
+  }
+  latch.Wait();
+  return std::all_of(results.begin(), results.end(),
+                     [](char result) { return result; });
+}
 
+static bool UpdateAtlasBitmap(
+    const GlyphAtlas& atlas,
+    const std::shared_ptr<SkBitmap>& bitmap,
+    const std::vector<FontGlyphPair>& new_pairs,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  FML_DCHECK(bitmap != nullptr);
+
+  std::vector<AtlasGlyph> glyphs;
+  glyphs.reserve(new_pairs.size());
   for (const FontGlyphPair& pair : new_pairs) {
     auto pos = atlas.FindFontGlyphBounds(pair);
     if (!pos.has_value()) {
       continue;
     }
-    DrawGlyph(canvas, pair.scaled_font, pair.glyph, pos.value(), has_color);
+    glyphs.push_back({pair.scaled_font, pair.glyph, pos.value()});
   }
-  return true;
+  return DrawGlyphs(*bitmap, glyphs, atlas.GetType(), worker_task_runner);
 }
 
-static std::shared_ptr<SkBitmap> CreateAtlasBitmap(const GlyphAtlas& atlas,
-                                                   const ISize& atlas_size) {
+static std::shared_ptr<SkBitmap> CreateAtlasBitmap(
+    const GlyphAtlas& atlas,
+    const ISize& atlas_size,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   auto bitmap = std::make_shared<SkBitmap>();
   SkImageInfo image_info;
 
   switch (atlas.GetType()) {
     case GlyphAtlas::Type::kAlphaBitmap:
+    case GlyphAtlas::Type::kSignedDistanceField:
       image_info = SkImageInfo::MakeA8(atlas_size.width, atlas_size.height);
       break;
     case GlyphAtlas::Type::kColorBitmap:
@@ -232,24 +393,33 @@ static std::shared_ptr<SkBitmap> CreateAtlasBitmap(const GlyphAtlas& atlas,
     return nullptr;
   }
 
-  auto surface = SkSurfaces::WrapPixels(bitmap->pixmap());
-  if (!surface) {
-    return nullptr;
-  }
-  auto canvas = surface->getCanvas();
-  if (!canvas) {
+  std::vector<AtlasGlyph> glyphs;
+  glyphs.reserve(atlas.GetGlyphCount());
+  atlas.IterateGlyphs([&glyphs](const ScaledFont& scaled_font,
+                                const Glyph& glyph,
+                                const Rect& location) -> bool {
+    glyphs.push_back({scaled_font, glyph, location});
+    return true;
+  });
+  if (!DrawGlyphs(*bitmap, glyphs, atlas.GetType(), worker_task_runner)) {
     return nullptr;
   }
 
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
-
-  atlas.IterateGlyphs([canvas, has_color](const ScaledFont& scaled_font,
-                                          const Glyph& glyph,
-                                          const Rect& location) -> bool {
-    DrawGlyph(canvas, scaled_font, glyph, location, has_color);
-    return true;
-  });
+  return bitmap;
+}
 
+static std::shared_ptr<SkBitmap> GrowAtlasBitmap(const SkBitmap& old_bitmap,
+                                                 const ISize& atlas_size) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  auto bitmap = std::make_shared<SkBitmap>();
+  if (!bitmap->tryAllocPixels(
+          old_bitmap.info().makeWH(atlas_size.width, atlas_size.height))) {
+    return nullptr;
+  }
+  bitmap->eraseColor(SK_ColorTRANSPARENT);
+  if (!bitmap->writePixels(old_bitmap.pixmap(), 0, 0)) {
+    return nullptr;
+  }
   return bitmap;
 }
 
@@ -269,6 +439,16 @@ static bool UpdateGlyphTextureAtlas(std::shared_ptr<SkBitmap> bitmap,
   return texture->SetContents(mapping);
 }
 
+static PixelFormat GetGlyphAtlasPixelFormat(GlyphAtlas::Type type) {
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+    case GlyphAtlas::Type::kSignedDistanceField:
+      return PixelFormat::kA8UNormInt;
+    case GlyphAtlas::Type::kColorBitmap:
+      return PixelFormat::kR8G8B8A8UNormInt;
+  }
+}
+
 static std::shared_ptr<Texture> UploadGlyphTextureAtlas(
     const std::shared_ptr<Allocator>& allocator,
     std::shared_ptr<SkBitmap> bitmap,
@@ -325,6 +505,7 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   if (font_glyph_map.empty()) {
     return last_atlas;
   }
+  atlas_context->MarkGlyphsUsed(font_glyph_map);
 
   // ---------------------------------------------------------------------------
   // Step 1: Determine if the atlas type and font glyph pairs are compatible
@@ -334,7 +515,8 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   for (const auto& font_value : font_glyph_map) {
     const ScaledFont& scaled_font = font_value.first;
     const FontGlyphAtlas* font_glyph_atlas =
-        last_atlas->GetFontGlyphAtlas(scaled_font.font, scaled_font.scale);
+        last_atlas->GetFontGlyphAtlas(scaled_font.font, scaled_font.scale,
+                                      scaled_font.blur_sigma);
     if (font_glyph_atlas) {
       for (const Glyph& glyph : font_value.second) {
         if (!font_glyph_atlas->FindGlyphBounds(glyph)) {
@@ -347,6 +529,22 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
       }
     }
   }
+
+  GlyphAtlasFrameStats stats;
+  stats.miss_count = new_glyphs.size();
+  for (const auto& font_value : font_glyph_map) {
+    stats.hit_count += font_value.second.size();
+  }
+  stats.hit_count -= stats.miss_count;
+  const size_t last_glyph_count = last_atlas->GetGlyphCount();
+  const fml::TimePoint start = fml::TimePoint::Now();
+  fml::ScopedCleanupClosure record_stats([&stats, &atlas_context, start]() {
+    if (stats.miss_count > 0 || stats.regenerated) {
+      stats.update_time = fml::TimePoint::Now() - start;
+    }
+    atlas_context->RecordFrameStats(stats);
+  });
+
   if (last_atlas->GetType() == type && new_glyphs.size() == 0) {
     return last_atlas;
   }
@@ -376,7 +574,8 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
     // Step 4a: Draw new font-glyph pairs into the existing bitmap.
     // ---------------------------------------------------------------------------
     auto bitmap = atlas_context_skia.GetBitmap();
-    if (!UpdateAtlasBitmap(*last_atlas, bitmap, new_glyphs)) {
+    if (!UpdateAtlasBitmap(*last_atlas, bitmap, new_glyphs,
+                           worker_task_runner_)) {
       return nullptr;
     }
 
@@ -388,29 +587,101 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
     }
     return last_atlas;
   }
-  // A new glyph atlas must be created.
+
+  std::vector<FontGlyphPair> font_glyph_pairs =
+      CollectFontGlyphPairs(font_glyph_map);
+  const ISize max_texture_size =
+      context.GetResourceAllocator()->GetMaxTextureSizeSupported();
+  const ISize max_grown_size =
+      ISize(std::min(max_texture_size.width, kMaxGrownAtlasSize),
+            std::min(max_texture_size.height, kMaxGrownAtlasSize));
 
   // ---------------------------------------------------------------------------
-  // Step 3b: Get the optimum size of the texture atlas.
+  // Step 3c: If the glyphs of this frame do not fit into an atlas of the
+  //          current size either, the atlas has to grow. Grow the existing
+  //          atlas so that the existing glyphs keep their positions and only
+  //          the additional glyphs are drawn.
   // ---------------------------------------------------------------------------
-  std::vector<FontGlyphPair> font_glyph_pairs;
-  font_glyph_pairs.reserve(std::accumulate(
-      font_glyph_map.begin(), font_glyph_map.end(), 0,
-      [](const int a, const auto& b) { return a + b.second.size(); }));
-  for (const auto& font_value : font_glyph_map) {
-    const ScaledFont& scaled_font = font_value.first;
-    for (const Glyph& glyph : font_value.second) {
-      font_glyph_pairs.push_back({scaled_font, glyph});
+  auto atlas_bitmap = atlas_context_skia.GetBitmap();
+  const ISize last_atlas_size = atlas_context->GetAtlasSize();
+  const bool must_grow =
+      last_atlas->GetType() == type && last_atlas->GetTexture() &&
+      atlas_bitmap && !last_atlas_size.IsEmpty() &&
+      PairsFitInAtlasOfSize(
+          font_glyph_pairs, last_atlas_size, glyph_positions,
+          std::shared_ptr<RectanglePacker>(RectanglePacker::Factory(
+              last_atlas_size.width, last_atlas_size.height))) > 0;
+  if (must_grow) {
+    auto atlas_size =
+        GrowAtlasForFontGlyphPairs(last_atlas, new_glyphs, glyph_positions,
+                                   atlas_context, max_grown_size);
+    auto bitmap = atlas_size.IsEmpty()
+                      ? nullptr
+                      : GrowAtlasBitmap(*atlas_bitmap, atlas_size);
+    if (bitmap) {
+      for (size_t i = 0, count = glyph_positions.size(); i < count; i++) {
+        last_atlas->AddTypefaceGlyphPosition(new_glyphs[i],
+                                             glyph_positions[i]);
+      }
+
+      // -----------------------------------------------------------------------
+      // Step 4c: Draw the additional font-glyph pairs into the grown bitmap.
+      // -----------------------------------------------------------------------
+      if (!UpdateAtlasBitmap(*last_atlas, bitmap, new_glyphs,
+                             worker_task_runner_)) {
+        return nullptr;
+      }
+      atlas_context_skia.UpdateBitmap(bitmap);
+      atlas_context->UpdateGlyphAtlas(last_atlas, atlas_size);
+
+      // -----------------------------------------------------------------------
+      // Step 5c: Upload the grown bitmap as a new texture.
+      // -----------------------------------------------------------------------
+      auto texture = UploadGlyphTextureAtlas(context.GetResourceAllocator(),
+                                             bitmap, atlas_size,
+                                             GetGlyphAtlasPixelFormat(type));
+      if (!texture) {
+        return nullptr;
+      }
+      last_atlas->SetTexture(std::move(texture));
+      return last_atlas;
     }
+    glyph_positions.clear();
   }
+
+  // A new glyph atlas must be created.
+  stats.regenerated = true;
+
+  // ---------------------------------------------------------------------------
+  // Step 3b: Get the optimum size of the texture atlas. Glyphs used by recent
+  //          frames are kept as long as they fit into the size the atlas has
+  //          (or may grow to), so that they are not drawn again soon. All
+  //          other glyphs that are not used by this frame are evicted.
+  // ---------------------------------------------------------------------------
   auto glyph_atlas = std::make_shared<GlyphAtlas>(type);
-  auto atlas_size = OptimumAtlasSizeForFontGlyphPairs(
-      font_glyph_pairs,                                             //
-      glyph_positions,                                              //
-      atlas_context,                                                //
-      type,                                                         //
-      context.GetResourceAllocator()->GetMaxTextureSizeSupported()  //
-  );
+  ISize atlas_size;
+  FontGlyphMap recent_glyph_map =
+      atlas_context->RetainRecentlyUsedGlyphs(kGlyphRetentionFrames);
+  auto recent_glyph_pairs = CollectFontGlyphPairs(recent_glyph_map);
+  const ISize recent_glyphs_size = must_grow ? max_grown_size : last_atlas_size;
+  if (recent_glyph_pairs.size() > font_glyph_pairs.size() &&
+      !recent_glyphs_size.IsEmpty()) {
+    atlas_size = OptimumAtlasSizeForFontGlyphPairs(
+        recent_glyph_pairs, glyph_positions, atlas_context, type,
+        recent_glyphs_size);
+    if (!atlas_size.IsEmpty()) {
+      font_glyph_pairs = std::move(recent_glyph_pairs);
+    }
+  }
+  if (atlas_size.IsEmpty()) {
+    atlas_size = OptimumAtlasSizeForFontGlyphPairs(
+        font_glyph_pairs,  //
+        glyph_positions,   //
+        atlas_context,     //
+        type,              //
+        max_texture_size   //
+    );
+  }
 
   atlas_context->UpdateGlyphAtlas(glyph_atlas, atlas_size);
   if (atlas_size.IsEmpty()) {
@@ -436,11 +707,17 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
       glyph_atlas->AddTypefaceGlyphPosition(*it, glyph_positions[i]);
     }
   }
+  // The glyphs of the last atlas that the new atlas no longer holds.
+  const size_t kept_glyph_count = font_glyph_pairs.size() - stats.miss_count;
+  stats.eviction_count = last_glyph_count > kept_glyph_count
+                             ? last_glyph_count - kept_glyph_count
+                             : 0u;
 
   // ---------------------------------------------------------------------------
   // Step 6b: Draw font-glyph pairs in the correct spot in the atlas.
   // ---------------------------------------------------------------------------
-  auto bitmap = CreateAtlasBitmap(*glyph_atlas, atlas_size);
+  auto bitmap =
+      CreateAtlasBitmap(*glyph_atlas, atlas_size, worker_task_runner_);
   if (!bitmap) {
     return nullptr;
   }
@@ -463,17 +740,9 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   // ---------------------------------------------------------------------------
   // Step 7b: Upload the atlas as a texture.
   // ---------------------------------------------------------------------------
-  PixelFormat format;
-  switch (type) {
-    case GlyphAtlas::Type::kAlphaBitmap:
-      format = PixelFormat::kA8UNormInt;
-      break;
-    case GlyphAtlas::Type::kColorBitmap:
-      format = PixelFormat::kR8G8B8A8UNormInt;
-      break;
-  }
   auto texture = UploadGlyphTextureAtlas(context.GetResourceAllocator(), bitmap,
-                                         atlas_size, format);
+                                         atlas_size,
+                                         GetGlyphAtlasPixelFormat(type));
   if (!texture) {
     return nullptr;
   }
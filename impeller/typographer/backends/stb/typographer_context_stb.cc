@@ -7,12 +7,16 @@
 #include <numeric>
 #include <utility>
 
+#include "flutter/fml/closure.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/allocation.h"
 #include "impeller/core/allocator.h"
 #include "impeller/typographer/backends/stb/glyph_atlas_context_stb.h"
 #include "impeller/typographer/font_glyph_pair.h"
+#include "impeller/typographer/signed_distance_field.h"
+#include "impeller/typographer/text_frame.h"
 #include "typeface_stb.h"
 
 #define DISABLE_COLOR_FONT_SUPPORT 1
@@ -199,8 +203,9 @@ static void DrawGlyph(BitmapSTB* bitmap,
                       const ScaledFont& scaled_font,
                       const Glyph& glyph,
                       const Rect& location,
-                      bool has_color) {
+                      GlyphAtlas::Type type) {
   const auto& metrics = scaled_font.font.GetMetrics();
+  const bool has_color = type == GlyphAtlas::Type::kColorBitmap;
 
   const impeller::Font& font = scaled_font.font;
   auto typeface = font.GetTypeface();
@@ -219,10 +224,15 @@ static void DrawGlyph(BitmapSTB* bitmap,
   // For Alpha and Signed Distance field bitmaps we can use STB to draw the
   // Glyph in place
   if (!has_color || DISABLE_COLOR_FONT_SUPPORT) {
-    stbtt_MakeGlyphBitmap(typeface_stb->GetFontInfo(), output,
-                          location.GetWidth() - kPadding,
-                          location.GetHeight() - kPadding,
-                          bitmap->GetRowBytes(), scale_x, scale_y, glyph.index);
+    stbtt_MakeGlyphBitmapSubpixel(
+        typeface_stb->GetFontInfo(), output, location.GetWidth() - kPadding,
+        location.GetHeight() - kPadding, bitmap->GetRowBytes(), scale_x,
+        scale_y, glyph.subpixel_offset / 256.0f, 0.0f, glyph.index);
+    if (type == GlyphAtlas::Type::kSignedDistanceField) {
+      ConvertCoverageToSignedDistanceField(
+          output, bitmap->GetRowBytes(), ISize::Ceil(location.GetSize()),
+          TextFrame::kSignedDistanceFieldSpread);
+    }
   } else {
     // But for color bitmaps we need to get the glyph pixels and then carry all
     // channels into the atlas bitmap. This may not be performant but I'm unsure
@@ -275,15 +285,13 @@ static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
   TRACE_EVENT0("impeller", __FUNCTION__);
   FML_DCHECK(bitmap != nullptr);
 
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
-
   for (const FontGlyphPair& pair : new_pairs) {
     auto pos = atlas.FindFontGlyphBounds(pair);
     if (!pos.has_value()) {
       continue;
     }
     DrawGlyph(bitmap.get(), pair.scaled_font, pair.glyph, pos.value(),
-              has_color);
+              atlas.GetType());
   }
   return true;
 }
@@ -300,12 +308,12 @@ static std::shared_ptr<BitmapSTB> CreateAtlasBitmap(const GlyphAtlas& atlas,
   auto bitmap = std::make_shared<BitmapSTB>(atlas_size.width, atlas_size.height,
                                             bytes_per_pixel);
 
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
+  auto type = atlas.GetType();
 
-  atlas.IterateGlyphs([&bitmap, has_color](const ScaledFont& scaled_font,
-                                           const Glyph& glyph,
-                                           const Rect& location) -> bool {
-    DrawGlyph(bitmap.get(), scaled_font, glyph, location, has_color);
+  atlas.IterateGlyphs([&bitmap, type](const ScaledFont& scaled_font,
+                                      const Glyph& glyph,
+                                      const Rect& location) -> bool {
+    DrawGlyph(bitmap.get(), scaled_font, glyph, location, type);
     return true;
   });
 
@@ -396,7 +404,8 @@ std::shared_ptr<GlyphAtlas> TypographerContextSTB::CreateGlyphAtlas(
   for (const auto& font_value : font_glyph_map) {
     const ScaledFont& scaled_font = font_value.first;
     const FontGlyphAtlas* font_glyph_atlas =
-        last_atlas->GetFontGlyphAtlas(scaled_font.font, scaled_font.scale);
+        last_atlas->GetFontGlyphAtlas(scaled_font.font, scaled_font.scale,
+                                      scaled_font.blur_sigma);
     if (font_glyph_atlas) {
       for (const Glyph& glyph : font_value.second) {
         if (!font_glyph_atlas->FindGlyphBounds(glyph)) {
@@ -409,6 +418,22 @@ std::shared_ptr<GlyphAtlas> TypographerContextSTB::CreateGlyphAtlas(
       }
     }
   }
+
+  GlyphAtlasFrameStats stats;
+  stats.miss_count = new_glyphs.size();
+  for (const auto& font_value : font_glyph_map) {
+    stats.hit_count += font_value.second.size();
+  }
+  stats.hit_count -= stats.miss_count;
+  const size_t last_glyph_count = last_atlas->GetGlyphCount();
+  const fml::TimePoint start = fml::TimePoint::Now();
+  fml::ScopedCleanupClosure record_stats([&stats, &atlas_context, start]() {
+    if (stats.miss_count > 0 || stats.regenerated) {
+      stats.update_time = fml::TimePoint::Now() - start;
+    }
+    atlas_context->RecordFrameStats(stats);
+  });
+
   if (last_atlas->GetType() == type && new_glyphs.size() == 0) {
     return last_atlas;
   }
@@ -452,6 +477,7 @@ std::shared_ptr<GlyphAtlas> TypographerContextSTB::CreateGlyphAtlas(
     return last_atlas;
   }
   // A new glyph atlas must be created.
+  stats.regenerated = true;
 
   // ---------------------------------------------------------------------------
   // Step 3b: Get the optimum size of the texture atlas.
@@ -500,6 +526,11 @@ std::shared_ptr<GlyphAtlas> TypographerContextSTB::CreateGlyphAtlas(
       glyph_atlas->AddTypefaceGlyphPosition(*it, glyph_positions[i]);
     }
   }
+  // The glyphs of the last atlas that the new atlas no longer holds.
+  const size_t kept_glyph_count = font_glyph_pairs.size() - stats.miss_count;
+  stats.eviction_count = last_glyph_count > kept_glyph_count
+                             ? last_glyph_count - kept_glyph_count
+                             : 0u;
 
   // ---------------------------------------------------------------------------
   // Step 6b: Draw font-glyph pairs in the correct spot in the atlas.
@@ -516,6 +547,7 @@ std::shared_ptr<GlyphAtlas> TypographerContextSTB::CreateGlyphAtlas(
   PixelFormat format;
   switch (type) {
     case GlyphAtlas::Type::kAlphaBitmap:
+    case GlyphAtlas::Type::kSignedDistanceField:
       format = PixelFormat::kA8UNormInt;
       break;
     case GlyphAtlas::Type::kColorBitmap:
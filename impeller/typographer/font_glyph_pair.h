@@ -24,6 +24,9 @@ namespace impeller {
 struct ScaledFont {
   Font font;
   Scalar scale;
+  /// The sigma, in atlas pixels, of the gaussian blur that the glyphs are
+  /// rasterized with. Zero for sharp glyphs.
+  Scalar blur_sigma = 0.0f;
 };
 
 using FontGlyphMap = std::unordered_map<ScaledFont, std::unordered_set<Glyph>>;
@@ -44,7 +47,7 @@ struct FontGlyphPair {
 template <>
 struct std::hash<impeller::ScaledFont> {
   constexpr std::size_t operator()(const impeller::ScaledFont& sf) const {
-    return fml::HashCombine(sf.font.GetHash(), sf.scale);
+    return fml::HashCombine(sf.font.GetHash(), sf.scale, sf.blur_sigma);
   }
 };
 
@@ -52,7 +55,8 @@ template <>
 struct std::equal_to<impeller::ScaledFont> {
   constexpr bool operator()(const impeller::ScaledFont& lhs,
                             const impeller::ScaledFont& rhs) const {
-    return lhs.font.IsEqual(rhs.font) && lhs.scale == rhs.scale;
+    return lhs.font.IsEqual(rhs.font) && lhs.scale == rhs.scale &&
+           lhs.blur_sigma == rhs.blur_sigma;
   }
 };
 
@@ -30,6 +30,13 @@ struct Glyph {
   ///
   Type type = Type::kPath;
 
+  //------------------------------------------------------------------------------
+  /// @brief  The horizontal offset, in 1/256ths of a pixel, at which the glyph
+  ///         is rasterized into an atlas. Glyphs with different offsets are
+  ///         separate atlas entries.
+  ///
+  uint8_t subpixel_offset = 0;
+
   //------------------------------------------------------------------------------
   /// @brief  Visibility coverage of the glyph in text run space (relative to
   ///         the baseline, no scaling applied).
@@ -51,7 +58,9 @@ struct std::hash<impeller::Glyph> {
   constexpr std::size_t operator()(const impeller::Glyph& g) const {
     static_assert(sizeof(g.index) == 2);
     static_assert(sizeof(g.type) == 1);
-    return (static_cast<size_t>(g.type) << 16) | g.index;
+    static_assert(sizeof(g.subpixel_offset) == 1);
+    return (static_cast<size_t>(g.subpixel_offset) << 24) |
+           (static_cast<size_t>(g.type) << 16) | g.index;
   }
 };
 
@@ -59,7 +68,8 @@ template <>
 struct std::equal_to<impeller::Glyph> {
   constexpr bool operator()(const impeller::Glyph& lhs,
                             const impeller::Glyph& rhs) const {
-    return lhs.index == rhs.index && lhs.type == rhs.type;
+    return lhs.index == rhs.index && lhs.type == rhs.type &&
+           lhs.subpixel_offset == rhs.subpixel_offset;
   }
 };
 
@@ -67,7 +77,10 @@ template <>
 struct std::less<impeller::Glyph> {
   constexpr bool operator()(const impeller::Glyph& lhs,
                             const impeller::Glyph& rhs) const {
-    return lhs.index < rhs.index;
+    if (lhs.index != rhs.index) {
+      return lhs.index < rhs.index;
+    }
+    return lhs.subpixel_offset < rhs.subpixel_offset;
   }
 };
 
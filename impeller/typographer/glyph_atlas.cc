@@ -7,6 +7,8 @@
 #include <numeric>
 #include <utility>
 
+#include "flutter/fml/trace_event.h"
+
 namespace impeller {
 
 GlyphAtlasContext::GlyphAtlasContext()
@@ -38,6 +40,55 @@ void GlyphAtlasContext::UpdateRectPacker(
   rect_packer_ = std::move(rect_packer);
 }
 
+void GlyphAtlasContext::MarkGlyphsUsed(const FontGlyphMap& font_glyph_map) {
+  frame_++;
+  for (const auto& font_value : font_glyph_map) {
+    auto& last_used_frames = last_used_frames_[font_value.first];
+    for (const Glyph& glyph : font_value.second) {
+      last_used_frames[glyph] = frame_;
+    }
+  }
+}
+
+FontGlyphMap GlyphAtlasContext::RetainRecentlyUsedGlyphs(
+    uint64_t frame_count) {
+  FontGlyphMap font_glyph_map;
+  for (auto font_it = last_used_frames_.begin();
+       font_it != last_used_frames_.end();) {
+    auto& last_used_frames = font_it->second;
+    for (auto glyph_it = last_used_frames.begin();
+         glyph_it != last_used_frames.end();) {
+      if (frame_ - glyph_it->second >= frame_count) {
+        glyph_it = last_used_frames.erase(glyph_it);
+      } else {
+        font_glyph_map[font_it->first].insert(glyph_it->first);
+        ++glyph_it;
+      }
+    }
+    if (last_used_frames.empty()) {
+      font_it = last_used_frames_.erase(font_it);
+    } else {
+      ++font_it;
+    }
+  }
+  return font_glyph_map;
+}
+
+void GlyphAtlasContext::RecordFrameStats(const GlyphAtlasFrameStats& stats) {
+  last_frame_stats_ = stats;
+  FML_TRACE_COUNTER("impeller",                                      //
+                    "GlyphAtlas", reinterpret_cast<int64_t>(this),   //
+                    "Hits", stats.hit_count,                         //
+                    "Misses", stats.miss_count,                      //
+                    "Evictions", stats.eviction_count,               //
+                    "Regenerations", stats.regenerated ? 1 : 0,      //
+                    "UpdateMicros", stats.update_time.ToMicroseconds());
+}
+
+const GlyphAtlasFrameStats& GlyphAtlasContext::GetLastFrameStats() const {
+  return last_frame_stats_;
+}
+
 GlyphAtlas::GlyphAtlas(Type type) : type_(type) {}
 
 GlyphAtlas::~GlyphAtlas() = default;
@@ -73,8 +124,9 @@ std::optional<Rect> GlyphAtlas::FindFontGlyphBounds(
 }
 
 const FontGlyphAtlas* GlyphAtlas::GetFontGlyphAtlas(const Font& font,
-                                                    Scalar scale) const {
-  const auto& found = font_atlas_map_.find({font, scale});
+                                                    Scalar scale,
+                                                    Scalar blur_sigma) const {
+  const auto& found = font_atlas_map_.find({font, scale, blur_sigma});
   if (found == font_atlas_map_.end()) {
     return nullptr;
   }
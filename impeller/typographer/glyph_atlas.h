@@ -11,6 +11,7 @@
 #include <unordered_map>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
 #include "impeller/core/texture.h"
 #include "impeller/geometry/rect.h"
 #include "impeller/renderer/pipeline.h"
@@ -42,6 +43,14 @@ class GlyphAtlas {
     /// colors.
     ///
     kColorBitmap,
+
+    //--------------------------------------------------------------------------
+    /// The glyphs are represented at a fixed reference size as signed
+    /// distances to their outlines, stored in an 8-bit alpha channel. A single
+    /// entry can be drawn at any larger or somewhat smaller size by
+    /// thresholding the distance.
+    ///
+    kSignedDistanceField,
   };
 
   //----------------------------------------------------------------------------
@@ -119,14 +128,17 @@ class GlyphAtlas {
   ///             atlas for the given font and scale.  This provides a more
   ///             efficient way to look up a run of glyphs in the same font.
   ///
-  /// @param[in]  font  The font
-  /// @param[in]  scale The scale
+  /// @param[in]  font        The font
+  /// @param[in]  scale       The scale
+  /// @param[in]  blur_sigma  The blur sigma of the glyphs, in atlas pixels
   ///
   /// @return     A pointer to a FontGlyphAtlas, or nullptr if the font and
   ///             scale are not available in the atlas.  The pointer is only
   ///             valid for the lifetime of the GlyphAtlas.
   ///
-  const FontGlyphAtlas* GetFontGlyphAtlas(const Font& font, Scalar scale) const;
+  const FontGlyphAtlas* GetFontGlyphAtlas(const Font& font,
+                                          Scalar scale,
+                                          Scalar blur_sigma = 0.0f) const;
 
  private:
   const Type type_;
@@ -142,6 +154,24 @@ class GlyphAtlas {
 //------------------------------------------------------------------------------
 /// @brief      A container for caching a glyph atlas across frames.
 ///
+//------------------------------------------------------------------------------
+/// @brief      How one frame used a glyph atlas.
+///
+struct GlyphAtlasFrameStats {
+  /// The glyphs of the frame that were already in the atlas.
+  size_t hit_count = 0u;
+  /// The glyphs of the frame that had to be drawn into the atlas.
+  size_t miss_count = 0u;
+  /// The glyphs of earlier frames that were dropped when the atlas was
+  /// created again.
+  size_t eviction_count = 0u;
+  /// Whether the atlas had to be created again instead of being reused or
+  /// appended to.
+  bool regenerated = false;
+  /// The time spent drawing the missing glyphs and uploading the atlas.
+  fml::TimeDelta update_time;
+};
+
 class GlyphAtlasContext {
  public:
   virtual ~GlyphAtlasContext();
@@ -164,6 +194,28 @@ class GlyphAtlasContext {
 
   void UpdateRectPacker(std::shared_ptr<RectanglePacker> rect_packer);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Start a new frame and record the glyphs it uses.
+  void MarkGlyphsUsed(const FontGlyphMap& font_glyph_map);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Forget the glyphs that were not used within the last
+  ///             `frame_count` frames.
+  ///
+  /// @return     The glyphs that were used within the last `frame_count`
+  ///             frames, including the current one.
+  ///
+  FontGlyphMap RetainRecentlyUsedGlyphs(uint64_t frame_count);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record how the latest frame used the atlas, and trace it as a
+  ///             counter so that the reuse of the atlas shows on the timeline.
+  void RecordFrameStats(const GlyphAtlasFrameStats& stats);
+
+  //----------------------------------------------------------------------------
+  /// @brief      How the latest frame that created the atlas used it.
+  const GlyphAtlasFrameStats& GetLastFrameStats() const;
+
  protected:
   GlyphAtlasContext();
 
@@ -171,6 +223,10 @@ class GlyphAtlasContext {
   std::shared_ptr<GlyphAtlas> atlas_;
   ISize atlas_size_;
   std::shared_ptr<RectanglePacker> rect_packer_;
+  uint64_t frame_ = 0u;
+  std::unordered_map<ScaledFont, std::unordered_map<Glyph, uint64_t>>
+      last_used_frames_;
+  GlyphAtlasFrameStats last_frame_stats_;
 
   GlyphAtlasContext(const GlyphAtlasContext&) = delete;
 
@@ -4,9 +4,12 @@
 
 #include "impeller/typographer/lazy_glyph_atlas.h"
 
+#include "flutter/fml/closure.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 #include "impeller/typographer/typographer_context.h"
 
+#include <algorithm>
 #include <utility>
 
 namespace impeller {
@@ -19,28 +22,129 @@ LazyGlyphAtlas::LazyGlyphAtlas(
                          : nullptr),
       color_context_(typographer_context_
                          ? typographer_context_->CreateGlyphAtlasContext()
-                         : nullptr) {}
+                         : nullptr),
+      sdf_context_(typographer_context_
+                       ? typographer_context_->CreateGlyphAtlasContext()
+                       : nullptr) {}
 
-LazyGlyphAtlas::~LazyGlyphAtlas() = default;
+LazyGlyphAtlas::~LazyGlyphAtlas() {
+  WaitForPreparation();
+}
 
-void LazyGlyphAtlas::AddTextFrame(const TextFrame& frame, Scalar scale) {
+void LazyGlyphAtlas::AddTextFrame(const TextFrame& frame,
+                                  Scalar scale,
+                                  Scalar blur_sigma) {
+  WaitForPreparation();
   FML_DCHECK(atlas_map_.empty());
-  if (frame.GetAtlasType() == GlyphAtlas::Type::kAlphaBitmap) {
-    frame.CollectUniqueFontGlyphPairs(alpha_glyph_map_, scale);
-  } else {
-    frame.CollectUniqueFontGlyphPairs(color_glyph_map_, scale);
+  switch (frame.GetAtlasType(scale, blur_sigma)) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      frame.CollectUniqueFontGlyphPairs(alpha_glyph_map_, scale,
+                                        GlyphAtlas::Type::kAlphaBitmap,
+                                        subpixel_positions_, blur_sigma);
+      break;
+    case GlyphAtlas::Type::kColorBitmap:
+      frame.CollectUniqueFontGlyphPairs(color_glyph_map_, scale,
+                                        GlyphAtlas::Type::kColorBitmap, 1u,
+                                        blur_sigma);
+      break;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      frame.CollectUniqueFontGlyphPairs(
+          sdf_glyph_map_, scale, GlyphAtlas::Type::kSignedDistanceField);
+      break;
   }
 }
 
 void LazyGlyphAtlas::ResetTextFrames() {
+  WaitForPreparation();
   alpha_glyph_map_.clear();
   color_glyph_map_.clear();
+  sdf_glyph_map_.clear();
   atlas_map_.clear();
 }
 
+void LazyGlyphAtlas::PrepareTextFrames(
+    const std::shared_ptr<Context>& context,
+    std::vector<std::pair<std::shared_ptr<TextFrame>, Scalar>> text_frames,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  WaitForPreparation();
+  if (!context || !worker_task_runner || text_frames.empty() ||
+      !typographer_context_ || !typographer_context_->IsValid()) {
+    return;
+  }
+
+  auto done = std::make_shared<fml::ManualResetWaitableEvent>();
+  preparation_done_ = done;
+  // Signal when the task is destroyed, so that waiting can't hang if the task
+  // is dropped without running.
+  auto signal = std::make_shared<fml::ScopedCleanupClosure>(
+      [done]() { done->Signal(); });
+  auto prepare = [this, context, signal,
+                  text_frames = std::move(text_frames)]() {
+    TRACE_EVENT0("impeller", "PrepareGlyphAtlases");
+    FontGlyphMap alpha_glyph_map;
+    FontGlyphMap color_glyph_map;
+    FontGlyphMap sdf_glyph_map;
+    for (const auto& [frame, scale] : text_frames) {
+      if (!frame) {
+        continue;
+      }
+      switch (frame->GetAtlasType(scale)) {
+        case GlyphAtlas::Type::kAlphaBitmap:
+          frame->CollectUniqueFontGlyphPairs(alpha_glyph_map, scale,
+                                             GlyphAtlas::Type::kAlphaBitmap,
+                                             subpixel_positions_);
+          break;
+        case GlyphAtlas::Type::kColorBitmap:
+          frame->CollectUniqueFontGlyphPairs(color_glyph_map, scale);
+          break;
+        case GlyphAtlas::Type::kSignedDistanceField:
+          frame->CollectUniqueFontGlyphPairs(
+              sdf_glyph_map, scale, GlyphAtlas::Type::kSignedDistanceField);
+          break;
+      }
+    }
+    // The atlases are not kept, their contexts hold on to the glyphs.
+    if (!alpha_glyph_map.empty()) {
+      typographer_context_->CreateGlyphAtlas(
+          *context, GlyphAtlas::Type::kAlphaBitmap, alpha_context_,
+          alpha_glyph_map);
+    }
+    if (!color_glyph_map.empty()) {
+      typographer_context_->CreateGlyphAtlas(
+          *context, GlyphAtlas::Type::kColorBitmap, color_context_,
+          color_glyph_map);
+    }
+    if (!sdf_glyph_map.empty()) {
+      typographer_context_->CreateGlyphAtlas(
+          *context, GlyphAtlas::Type::kSignedDistanceField, sdf_context_,
+          sdf_glyph_map);
+    }
+  };
+  worker_task_runner->PostTask(prepare,
+                               fml::ConcurrentTaskPriority::kFrameCritical);
+}
+
+void LazyGlyphAtlas::WaitForPreparation() const {
+  if (preparation_done_) {
+    preparation_done_->Wait();
+    preparation_done_.reset();
+  }
+}
+
+void LazyGlyphAtlas::SetSubpixelPositions(size_t subpixel_positions) {
+  WaitForPreparation();
+  FML_DCHECK(alpha_glyph_map_.empty());
+  subpixel_positions_ = std::clamp<size_t>(subpixel_positions, 1u, 256u);
+}
+
+size_t LazyGlyphAtlas::GetSubpixelPositions(GlyphAtlas::Type type) const {
+  return type == GlyphAtlas::Type::kAlphaBitmap ? subpixel_positions_ : 1u;
+}
+
 std::shared_ptr<GlyphAtlas> LazyGlyphAtlas::CreateOrGetGlyphAtlas(
     Context& context,
     GlyphAtlas::Type type) const {
+  WaitForPreparation();
   {
     auto atlas_it = atlas_map_.find(type);
     if (atlas_it != atlas_map_.end()) {
@@ -59,12 +163,24 @@ std::shared_ptr<GlyphAtlas> LazyGlyphAtlas::CreateOrGetGlyphAtlas(
     return nullptr;
   }
 
-  auto& glyph_map = type == GlyphAtlas::Type::kAlphaBitmap ? alpha_glyph_map_
-                                                           : color_glyph_map_;
-  auto atlas_context =
-      type == GlyphAtlas::Type::kAlphaBitmap ? alpha_context_ : color_context_;
-  auto atlas = typographer_context_->CreateGlyphAtlas(context, type,
-                                                      atlas_context, glyph_map);
+  const FontGlyphMap* glyph_map = nullptr;
+  std::shared_ptr<GlyphAtlasContext> atlas_context;
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      glyph_map = &alpha_glyph_map_;
+      atlas_context = alpha_context_;
+      break;
+    case GlyphAtlas::Type::kColorBitmap:
+      glyph_map = &color_glyph_map_;
+      atlas_context = color_context_;
+      break;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      glyph_map = &sdf_glyph_map_;
+      atlas_context = sdf_context_;
+      break;
+  }
+  auto atlas = typographer_context_->CreateGlyphAtlas(
+      context, type, std::move(atlas_context), *glyph_map);
   if (!atlas || !atlas->IsValid()) {
     VALIDATION_LOG << "Could not create valid atlas.";
     return nullptr;
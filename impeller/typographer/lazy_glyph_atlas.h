@@ -5,9 +5,14 @@
 #ifndef FLUTTER_IMPELLER_TYPOGRAPHER_LAZY_GLYPH_ATLAS_H_
 #define FLUTTER_IMPELLER_TYPOGRAPHER_LAZY_GLYPH_ATLAS_H_
 
+#include <memory>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "impeller/renderer/context.h"
 #include "impeller/typographer/glyph_atlas.h"
 #include "impeller/typographer/text_frame.h"
@@ -17,15 +22,60 @@ namespace impeller {
 
 class LazyGlyphAtlas {
  public:
+  static constexpr size_t kDefaultSubpixelPositions = 4u;
+
   explicit LazyGlyphAtlas(
       std::shared_ptr<TypographerContext> typographer_context);
 
   ~LazyGlyphAtlas();
 
-  void AddTextFrame(const TextFrame& frame, Scalar scale);
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the glyphs of a frame drawn at `scale`, blurred with
+  ///             `blur_sigma` in the coordinates of the frame.
+  ///
+  void AddTextFrame(const TextFrame& frame,
+                    Scalar scale,
+                    Scalar blur_sigma = 0.0f);
 
   void ResetTextFrames();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Rasterizes the glyphs of text frames that are expected to be
+  ///             drawn soon into the glyph atlases on a worker.
+  ///
+  ///             The atlases created afterwards find the prepared glyphs
+  ///             already in place and only rasterize the glyphs that were not
+  ///             prepared. All other methods wait for the preparation to
+  ///             finish first.
+  ///
+  /// @param[in]  context             The context to create atlas textures in.
+  /// @param[in]  text_frames         The text frames and the scales they are
+  ///                                 expected to be drawn at.
+  /// @param[in]  worker_task_runner  The runner to prepare the atlases on. No
+  ///                                 preparation is done without one.
+  ///
+  void PrepareTextFrames(
+      const std::shared_ptr<Context>& context,
+      std::vector<std::pair<std::shared_ptr<TextFrame>, Scalar>> text_frames,
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the number of horizontal positions per pixel at which
+  ///             glyphs of alpha bitmap atlases are rasterized.
+  ///
+  ///             More positions place glyphs more accurately at the cost of
+  ///             more atlas entries per glyph. One disables subpixel
+  ///             positioning. This must only change between frames.
+  ///
+  void SetSubpixelPositions(size_t subpixel_positions);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of horizontal positions per pixel at which glyphs
+  ///             of atlases of `type` are rasterized. This is always one for
+  ///             color and signed distance field atlases.
+  ///
+  size_t GetSubpixelPositions(GlyphAtlas::Type type) const;
+
   std::shared_ptr<GlyphAtlas> CreateOrGetGlyphAtlas(
       Context& context,
       GlyphAtlas::Type type) const;
@@ -35,10 +85,16 @@ class LazyGlyphAtlas {
 
   FontGlyphMap alpha_glyph_map_;
   FontGlyphMap color_glyph_map_;
+  FontGlyphMap sdf_glyph_map_;
   std::shared_ptr<GlyphAtlasContext> alpha_context_;
   std::shared_ptr<GlyphAtlasContext> color_context_;
+  std::shared_ptr<GlyphAtlasContext> sdf_context_;
   mutable std::unordered_map<GlyphAtlas::Type, std::shared_ptr<GlyphAtlas>>
       atlas_map_;
+  size_t subpixel_positions_ = kDefaultSubpixelPositions;
+  mutable std::shared_ptr<fml::ManualResetWaitableEvent> preparation_done_;
+
+  void WaitForPreparation() const;
 
   LazyGlyphAtlas(const LazyGlyphAtlas&) = delete;
 
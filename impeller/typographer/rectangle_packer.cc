@@ -29,6 +29,8 @@ class SkylineRectanglePacker final : public RectanglePacker {
 
   bool addRect(int w, int h, IPoint16* loc) final;
 
+  std::shared_ptr<RectanglePacker> Grow(int width, int height) const final;
+
   float percentFull() const final {
     return area_so_far_ / ((float)this->width() * this->height());
   }
@@ -166,6 +168,23 @@ void SkylineRectanglePacker::addSkylineLevel(int skylineIndex,
   }
 }
 
+std::shared_ptr<RectanglePacker> SkylineRectanglePacker::Grow(
+    int width,
+    int height) const {
+  FML_DCHECK(width >= this->width());
+  FML_DCHECK(height >= this->height());
+  auto packer = std::make_shared<SkylineRectanglePacker>(width, height);
+  // The skyline only tracks the lowest free row of each column, so the extra
+  // rows are free already. Extra columns are free from the top.
+  packer->skyline_ = skyline_;
+  packer->area_so_far_ = area_so_far_;
+  if (width > this->width()) {
+    packer->skyline_.push_back(
+        SkylineSegment{this->width(), 0, width - this->width()});
+  }
+  return packer;
+}
+
 RectanglePacker* RectanglePacker::Factory(int width, int height) {
   return new SkylineRectanglePacker(width, height);
 }
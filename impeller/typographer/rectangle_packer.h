@@ -8,6 +8,7 @@
 #include "flutter/fml/logging.h"
 
 #include <cstdint>
+#include <memory>
 
 namespace impeller {
 
@@ -55,6 +56,16 @@ class RectanglePacker {
   ///
   virtual void reset() = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief     Return a packer with a larger area that keeps all previously
+  ///            added rectangles where they are. This packer is unchanged.
+  ///
+  /// @param[in]   width   The new width, at least the current width.
+  /// @param[in]   height  The new height, at least the current height.
+  ///
+  virtual std::shared_ptr<RectanglePacker> Grow(int width,
+                                                int height) const = 0;
+
  protected:
   RectanglePacker(int width, int height) : width_(width), height_(height) {
     FML_DCHECK(width >= 0);
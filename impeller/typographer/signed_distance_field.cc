@@ -0,0 +1,96 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/typographer/signed_distance_field.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "impeller/geometry/constants.h"
+
+namespace impeller {
+
+void ConvertCoverageToSignedDistanceField(uint8_t* pixels,
+                                          size_t row_bytes,
+                                          ISize size,
+                                          Scalar spread) {
+  const auto width = static_cast<size_t>(std::max<int64_t>(size.width, 0));
+  const auto height = static_cast<size_t>(std::max<int64_t>(size.height, 0));
+  if (width == 0u || height == 0u || spread <= 0) {
+    return;
+  }
+
+  auto coverage = [&](size_t x, size_t y) -> Scalar {
+    return pixels[y * row_bytes + x] / 255.0f;
+  };
+  auto is_inside = [&](size_t x, size_t y) { return coverage(x, y) >= 0.5f; };
+
+  // Seed the pixels along the outline with their distance to it. Partially
+  // covered pixels are about as far from the outline as their coverage is
+  // from one half, pixels on either side of a hard edge are half a pixel away.
+  std::vector<Scalar> distances(width * height,
+                                std::numeric_limits<Scalar>::infinity());
+  for (size_t y = 0; y < height; y++) {
+    for (size_t x = 0; x < width; x++) {
+      auto& distance = distances[y * width + x];
+      auto value = coverage(x, y);
+      if (value > 0.0f && value < 1.0f) {
+        distance = std::abs(0.5f - value);
+        continue;
+      }
+      bool inside = is_inside(x, y);
+      if ((x > 0 && is_inside(x - 1, y) != inside) ||
+          (x + 1 < width && is_inside(x + 1, y) != inside) ||
+          (y > 0 && is_inside(x, y - 1) != inside) ||
+          (y + 1 < height && is_inside(x, y + 1) != inside)) {
+        distance = 0.5f;
+      }
+    }
+  }
+
+  // Propagate the distances with a forward and a backward chamfer pass.
+  constexpr Scalar kDiagonal = kSqrt2;
+  auto relax = [&](size_t x, size_t y, int dx, int dy, Scalar weight) {
+    auto nx = static_cast<int64_t>(x) + dx;
+    auto ny = static_cast<int64_t>(y) + dy;
+    if (nx < 0 || ny < 0 || nx >= static_cast<int64_t>(width) ||
+        ny >= static_cast<int64_t>(height)) {
+      return;
+    }
+    auto& distance = distances[y * width + x];
+    distance = std::min(distance, distances[ny * width + nx] + weight);
+  };
+  for (size_t y = 0; y < height; y++) {
+    for (size_t x = 0; x < width; x++) {
+      relax(x, y, -1, 0, 1.0f);
+      relax(x, y, -1, -1, kDiagonal);
+      relax(x, y, 0, -1, 1.0f);
+      relax(x, y, 1, -1, kDiagonal);
+    }
+  }
+  for (size_t y = height; y-- > 0;) {
+    for (size_t x = width; x-- > 0;) {
+      relax(x, y, 1, 0, 1.0f);
+      relax(x, y, 1, 1, kDiagonal);
+      relax(x, y, 0, 1, 1.0f);
+      relax(x, y, -1, 1, kDiagonal);
+    }
+  }
+
+  // Each pixel is read for the sign of its distance before it is replaced.
+  for (size_t y = 0; y < height; y++) {
+    for (size_t x = 0; x < width; x++) {
+      auto distance = distances[y * width + x];
+      if (!is_inside(x, y)) {
+        distance = -distance;
+      }
+      auto value = std::clamp(0.5f + distance / (2.0f * spread), 0.0f, 1.0f);
+      pixels[y * row_bytes + x] = static_cast<uint8_t>(std::round(value * 255));
+    }
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,38 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_TYPOGRAPHER_SIGNED_DISTANCE_FIELD_H_
+#define FLUTTER_IMPELLER_TYPOGRAPHER_SIGNED_DISTANCE_FIELD_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "impeller/geometry/scalar.h"
+#include "impeller/geometry/size.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Replaces the 8-bit coverage of a glyph with the signed distance
+///             of each pixel to the glyph outline.
+///
+///             Distances are approximated from the anti-aliased coverage along
+///             the outline and propagated with a chamfer distance transform.
+///             A value of 128 lies on the outline, larger values are inside of
+///             it and the values saturate `spread` pixels away from it.
+///
+/// @param[in]  pixels     The first pixel of the glyph.
+/// @param[in]  row_bytes  The distance in bytes between two rows of pixels.
+/// @param[in]  size       The size of the glyph in pixels.
+/// @param[in]  spread     The distance from the outline, in pixels, at which
+///                        the values saturate.
+///
+void ConvertCoverageToSignedDistanceField(uint8_t* pixels,
+                                          size_t row_bytes,
+                                          ISize size,
+                                          Scalar spread);
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_TYPOGRAPHER_SIGNED_DISTANCE_FIELD_H_
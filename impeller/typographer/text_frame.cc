@@ -4,12 +4,19 @@
 
 #include "impeller/typographer/text_frame.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "flutter/fml/memory/allocation_counter.h"
+
 namespace impeller {
 
 TextFrame::TextFrame() = default;
 
 TextFrame::TextFrame(std::vector<TextRun>& runs, Rect bounds, bool has_color)
-    : runs_(std::move(runs)), bounds_(bounds), has_color_(has_color) {}
+    : runs_(std::move(runs)), bounds_(bounds), has_color_(has_color) {
+  fml::RecordAllocation(fml::AllocationTag::kTextFrame, sizeof(TextFrame));
+}
 
 TextFrame::~TextFrame() = default;
 
@@ -30,6 +37,20 @@ GlyphAtlas::Type TextFrame::GetAtlasType() const {
                     : GlyphAtlas::Type::kAlphaBitmap;
 }
 
+GlyphAtlas::Type TextFrame::GetAtlasType(Scalar scale,
+                                         Scalar blur_sigma) const {
+  if (has_color_ || runs_.empty() || blur_sigma > 0.0f) {
+    return GetAtlasType();
+  }
+  for (const TextRun& run : runs_) {
+    if (run.GetFont().GetMetrics().point_size * scale <
+        kMinSignedDistanceFieldSize) {
+      return GlyphAtlas::Type::kAlphaBitmap;
+    }
+  }
+  return GlyphAtlas::Type::kSignedDistanceField;
+}
+
 bool TextFrame::MaybeHasOverlapping() const {
   if (runs_.size() > 1) {
     return true;
@@ -67,13 +88,65 @@ Scalar TextFrame::RoundScaledFontSize(Scalar scale, Scalar point_size) {
   return std::round(scale * 100) / 100;
 }
 
+// static
+Scalar TextFrame::GetAtlasScale(GlyphAtlas::Type type,
+                                Scalar scale,
+                                Scalar point_size) {
+  if (type == GlyphAtlas::Type::kSignedDistanceField && point_size > 0) {
+    return RoundScaledFontSize(kSignedDistanceFieldSize / point_size,
+                               point_size);
+  }
+  return RoundScaledFontSize(scale, point_size);
+}
+
+// static
+Scalar TextFrame::GetAtlasBlurSigma(Scalar blur_sigma, Scalar atlas_scale) {
+  if (blur_sigma <= 0.0f || atlas_scale <= 0.0f) {
+    return 0.0f;
+  }
+  return std::min(std::round(blur_sigma * atlas_scale * 4.0f) / 4.0f,
+                  kMaxAtlasBlurSigma);
+}
+
+// static
+Glyph TextFrame::GetAtlasGlyph(const TextRun::GlyphPosition& glyph_position,
+                               Scalar atlas_scale,
+                               size_t subpixel_positions,
+                               Scalar atlas_blur_sigma) {
+  Glyph glyph = glyph_position.glyph;
+  if (atlas_blur_sigma > 0.0f && atlas_scale > 0.0f) {
+    // The blur already smears the glyph over several pixels.
+    glyph.bounds = glyph.bounds.Expand(3.0f * atlas_blur_sigma / atlas_scale);
+    return glyph;
+  }
+  if (subpixel_positions <= 1u || atlas_scale <= 0) {
+    return glyph;
+  }
+  auto count = static_cast<int64_t>(std::min<size_t>(subpixel_positions, 256u));
+  auto x = (glyph_position.position.x + glyph.bounds.GetLeft()) * atlas_scale;
+  auto position = static_cast<int64_t>(std::round(x * count));
+  auto bin = ((position % count) + count) % count;
+  if (bin == 0) {
+    return glyph;
+  }
+  glyph.subpixel_offset = static_cast<uint8_t>(bin * 256 / count);
+  glyph.bounds = Rect::MakeLTRB(glyph.bounds.GetLeft(), glyph.bounds.GetTop(),
+                                glyph.bounds.GetRight() + 1.0f / atlas_scale,
+                                glyph.bounds.GetBottom());
+  return glyph;
+}
+
 void TextFrame::CollectUniqueFontGlyphPairs(FontGlyphMap& glyph_map,
-                                            Scalar scale) const {
+                                            Scalar scale,
+                                            GlyphAtlas::Type type,
+                                            size_t subpixel_positions,
+                                            Scalar blur_sigma) const {
   for (const TextRun& run : GetRuns()) {
     const Font& font = run.GetFont();
     auto rounded_scale =
-        RoundScaledFontSize(scale, font.GetMetrics().point_size);
-    auto& set = glyph_map[{font, rounded_scale}];
+        GetAtlasScale(type, scale, font.GetMetrics().point_size);
+    auto atlas_blur_sigma = GetAtlasBlurSigma(blur_sigma, rounded_scale);
+    auto& set = glyph_map[{font, rounded_scale, atlas_blur_sigma}];
     for (const TextRun::GlyphPosition& glyph_position :
          run.GetGlyphPositions()) {
 #if false
@@ -83,7 +156,8 @@ if (rounded_scale != scale) {
   FML_LOG(ERROR) << glyph_position.glyph.bounds.size * delta;
 }
 #endif
-      set.insert(glyph_position.glyph);
+      set.insert(GetAtlasGlyph(glyph_position, rounded_scale,
+                               subpixel_positions, atlas_blur_sigma));
     }
   }
 }
@@ -25,10 +25,95 @@ class TextFrame {
 
   ~TextFrame();
 
-  void CollectUniqueFontGlyphPairs(FontGlyphMap& glyph_map, Scalar scale) const;
+  //----------------------------------------------------------------------------
+  /// @brief      The smallest size, in pixels, at which text without color is
+  ///             drawn from a signed distance field atlas instead of a bitmap.
+  ///
+  static constexpr Scalar kMinSignedDistanceFieldSize = 48.0f;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The size, in pixels, at which glyphs are rasterized into a
+  ///             signed distance field atlas regardless of their drawn size.
+  ///
+  static constexpr Scalar kSignedDistanceFieldSize = 64.0f;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The distance from the outline, in pixels of a glyph of
+  ///             kSignedDistanceFieldSize, at which the signed distances in
+  ///             the atlas saturate.
+  ///
+  static constexpr Scalar kSignedDistanceFieldSpread = 4.0f;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The largest blur sigma, in atlas pixels, that glyphs are
+  ///             rasterized with. Wider blurs take too much atlas space.
+  ///
+  static constexpr Scalar kMaxAtlasBlurSigma = 16.0f;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Collects the glyphs of the frame drawn at `scale` into
+  ///             `glyph_map`.
+  ///
+  /// @param[in]  blur_sigma  The sigma, in the coordinates of the frame, of
+  ///                         the blur the glyphs are drawn with, or zero.
+  ///
+  void CollectUniqueFontGlyphPairs(
+      FontGlyphMap& glyph_map,
+      Scalar scale,
+      GlyphAtlas::Type type = GlyphAtlas::Type::kAlphaBitmap,
+      size_t subpixel_positions = 1u,
+      Scalar blur_sigma = 0.0f) const;
 
   static Scalar RoundScaledFontSize(Scalar scale, Scalar point_size);
 
+  //----------------------------------------------------------------------------
+  /// @brief      The scale at which glyphs of a font of `point_size` drawn at
+  ///             `scale` are rasterized into an atlas of `type`.
+  ///
+  ///             This is the rounded scale for bitmap atlases and the scale
+  ///             that yields kSignedDistanceFieldSize for signed distance
+  ///             field atlases, so that one entry serves all scales.
+  ///
+  static Scalar GetAtlasScale(GlyphAtlas::Type type,
+                              Scalar scale,
+                              Scalar point_size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The sigma, in atlas pixels, at which glyphs drawn with a blur
+  ///             of `blur_sigma` are rasterized into an atlas at
+  ///             `atlas_scale`.
+  ///
+  ///             Sigmas are rounded to a quarter of a pixel, so that text
+  ///             drawn with similar blurs shares atlas entries, and they are
+  ///             clamped to kMaxAtlasBlurSigma.
+  ///
+  static Scalar GetAtlasBlurSigma(Scalar blur_sigma, Scalar atlas_scale);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The glyph under which `glyph_position` is stored in an atlas
+  ///             rasterized at `atlas_scale`.
+  ///
+  ///             With more than one subpixel position, the horizontal
+  ///             position of the glyph within its run is quantized to that
+  ///             many offsets per pixel. Glyphs drawn at a non-zero offset
+  ///             are rasterized shifted by it and one pixel wider.
+  ///
+  ///             Blurred glyphs are outset by three sigmas on every side and
+  ///             never rasterized at subpixel offsets.
+  ///
+  /// @param[in]  glyph_position      The glyph and its position in the run.
+  /// @param[in]  atlas_scale         The scale the glyph is rasterized at.
+  /// @param[in]  subpixel_positions  The number of horizontal offsets per
+  ///                                 pixel, at most 256. One disables
+  ///                                 subpixel positioning.
+  /// @param[in]  atlas_blur_sigma    The blur sigma, in atlas pixels, the
+  ///                                 glyph is rasterized with.
+  ///
+  static Glyph GetAtlasGlyph(const TextRun::GlyphPosition& glyph_position,
+                             Scalar atlas_scale,
+                             size_t subpixel_positions,
+                             Scalar atlas_blur_sigma = 0.0f);
+
   //----------------------------------------------------------------------------
   /// @brief      The conservative bounding box for this text frame.
   ///
@@ -65,6 +150,15 @@ class TextFrame {
   /// @brief      The type of atlas this run should be emplaced in.
   GlyphAtlas::Type GetAtlasType() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The type of atlas this run should be emplaced in when drawn
+  ///             at `scale`.
+  ///
+  ///             Frames without color whose runs are all drawn at least
+  ///             kMinSignedDistanceFieldSize pixels large use a signed
+  ///             distance field atlas, unless they are blurred.
+  GlyphAtlas::Type GetAtlasType(Scalar scale, Scalar blur_sigma = 0.0f) const;
+
   TextFrame& operator=(TextFrame&& other) = default;
 
   TextFrame(const TextFrame& other) = default;
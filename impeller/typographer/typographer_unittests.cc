@@ -2,13 +2,18 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <array>
+
 #include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/testing/testing.h"
 #include "impeller/playground/playground_test.h"
+#include "impeller/typographer/backends/skia/glyph_atlas_context_skia.h"
 #include "impeller/typographer/backends/skia/text_frame_skia.h"
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 #include "impeller/typographer/lazy_glyph_atlas.h"
 #include "impeller/typographer/rectangle_packer.h"
+#include "impeller/typographer/signed_distance_field.h"
 #include "third_party/skia/include/core/SkFont.h"
 #include "third_party/skia/include/core/SkFontMgr.h"
 #include "third_party/skia/include/core/SkRect.h"
@@ -127,6 +132,121 @@ TEST_P(TypographerTest, LazyAtlasTracksColor) {
   ASSERT_FALSE(color_atlas == bitmap_atlas);
 }
 
+TEST_P(TypographerTest, LargeTextSharesSignedDistanceFieldAtlasEntries) {
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString("hello", sk_font);
+  ASSERT_TRUE(blob);
+  auto frame = MakeTextFrameFromTextBlobSkia(blob);
+  ASSERT_EQ(frame->GetAtlasType(1.0f), GlyphAtlas::Type::kAlphaBitmap);
+  ASSERT_EQ(frame->GetAtlasType(8.0f),
+            GlyphAtlas::Type::kSignedDistanceField);
+  ASSERT_EQ(frame->GetAtlasType(16.0f),
+            GlyphAtlas::Type::kSignedDistanceField);
+
+  LazyGlyphAtlas lazy_atlas(TypographerContextSkia::Make());
+  lazy_atlas.AddTextFrame(*frame, 8.0f);
+  lazy_atlas.AddTextFrame(*frame, 16.0f);
+
+  auto atlas = lazy_atlas.CreateOrGetGlyphAtlas(
+      *GetContext(), GlyphAtlas::Type::kSignedDistanceField);
+  ASSERT_TRUE(atlas && atlas->IsValid());
+  ASSERT_EQ(atlas->GetType(), GlyphAtlas::Type::kSignedDistanceField);
+  ASSERT_EQ(atlas->GetTexture()->GetTextureDescriptor().format,
+            PixelFormat::kA8UNormInt);
+
+  // Both scales are served by the same four glyphs at the reference size.
+  const auto& font = frame->GetRuns()[0].GetFont();
+  auto atlas_scale = TextFrame::GetAtlasScale(
+      GlyphAtlas::Type::kSignedDistanceField, 8.0f, 12.0f);
+  ASSERT_EQ(atlas_scale, TextFrame::GetAtlasScale(
+                             GlyphAtlas::Type::kSignedDistanceField, 16.0f,
+                             12.0f));
+  ASSERT_NE(atlas->GetFontGlyphAtlas(font, atlas_scale), nullptr);
+  ASSERT_EQ(atlas->GetGlyphCount(), 4u);
+}
+
+TEST(TextFrameTest, AtlasGlyphsQuantizeSubpixelPositions) {
+  Glyph glyph(5, Glyph::Type::kPath, Rect::MakeXYWH(0, -10, 8, 10));
+  auto at = [&](Scalar x, Scalar scale, size_t subpixel_positions) {
+    return TextFrame::GetAtlasGlyph(TextRun::GlyphPosition(glyph, {x, 0}),
+                                    scale, subpixel_positions);
+  };
+
+  EXPECT_EQ(at(0.3f, 1.0f, 1u).subpixel_offset, 0u);
+  EXPECT_EQ(at(0.3f, 1.0f, 4u).subpixel_offset, 64u);
+  EXPECT_EQ(at(2.45f, 1.0f, 4u).subpixel_offset, 128u);
+  EXPECT_EQ(at(-0.25f, 1.0f, 4u).subpixel_offset, 192u);
+  EXPECT_EQ(at(0.25f, 2.0f, 4u).subpixel_offset, 128u);
+
+  // Whole pixel positions share the unshifted glyph.
+  auto unshifted = at(3.0f, 1.0f, 4u);
+  EXPECT_EQ(unshifted.subpixel_offset, 0u);
+  EXPECT_EQ(unshifted.bounds, glyph.bounds);
+  EXPECT_TRUE(std::equal_to<Glyph>()(unshifted, at(7.05f, 1.0f, 4u)));
+
+  // Shifted glyphs are separate entries that are one pixel wider.
+  auto shifted = at(0.125f, 2.0f, 4u);
+  EXPECT_FALSE(std::equal_to<Glyph>()(unshifted, shifted));
+  EXPECT_EQ(shifted.bounds, Rect::MakeXYWH(0, -10, 8.5, 10));
+}
+
+TEST(TextFrameTest, BlurredAtlasGlyphsAreOutsetByThreeSigmas) {
+  Glyph glyph(5, Glyph::Type::kPath, Rect::MakeXYWH(0, -10, 8, 10));
+  EXPECT_EQ(TextFrame::GetAtlasBlurSigma(0.0f, 2.0f), 0.0f);
+  EXPECT_EQ(TextFrame::GetAtlasBlurSigma(1.1f, 2.0f), 2.25f);
+  EXPECT_EQ(TextFrame::GetAtlasBlurSigma(100.0f, 1.0f),
+            TextFrame::kMaxAtlasBlurSigma);
+
+  // Blurred glyphs ignore subpixel positions.
+  auto blurred = TextFrame::GetAtlasGlyph(
+      TextRun::GlyphPosition(glyph, {0.3f, 0}), 2.0f, 4u, 2.0f);
+  EXPECT_EQ(blurred.subpixel_offset, 0u);
+  EXPECT_EQ(blurred.bounds, Rect::MakeXYWH(-3, -13, 14, 16));
+}
+
+TEST_P(TypographerTest, BlurredTextHasItsOwnAtlasEntries) {
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto frame =
+      MakeTextFrameFromTextBlobSkia(SkTextBlob::MakeFromString("ab", sk_font));
+  // Large blurred text is never drawn from a signed distance field.
+  ASSERT_EQ(frame->GetAtlasType(8.0f, 1.0f), GlyphAtlas::Type::kAlphaBitmap);
+
+  LazyGlyphAtlas lazy_atlas(TypographerContextSkia::Make());
+  lazy_atlas.AddTextFrame(*frame, 1.0f);
+  lazy_atlas.AddTextFrame(*frame, 1.0f, 2.0f);
+  auto atlas = lazy_atlas.CreateOrGetGlyphAtlas(*GetContext(),
+                                                GlyphAtlas::Type::kAlphaBitmap);
+  ASSERT_TRUE(atlas && atlas->IsValid());
+  ASSERT_EQ(atlas->GetGlyphCount(), 4u);
+
+  const auto& font = frame->GetRuns()[0].GetFont();
+  auto* sharp = atlas->GetFontGlyphAtlas(font, 1.0f);
+  auto* blurred = atlas->GetFontGlyphAtlas(font, 1.0f, 2.0f);
+  ASSERT_NE(sharp, nullptr);
+  ASSERT_NE(blurred, nullptr);
+  const auto& position = frame->GetRuns()[0].GetGlyphPositions()[0];
+  auto sharp_bounds = sharp->FindGlyphBounds(TextFrame::GetAtlasGlyph(
+      position, 1.0f,
+      lazy_atlas.GetSubpixelPositions(GlyphAtlas::Type::kAlphaBitmap)));
+  auto blurred_bounds = blurred->FindGlyphBounds(
+      TextFrame::GetAtlasGlyph(position, 1.0f, 1u, 2.0f));
+  ASSERT_TRUE(sharp_bounds.has_value() && blurred_bounds.has_value());
+  // Three sigmas on either side, less the pixel of a subpixel offset.
+  EXPECT_GE(blurred_bounds->GetWidth(), sharp_bounds->GetWidth() + 11.0f);
+}
+
+TEST(SignedDistanceFieldTest, CrossesOneHalfAtTheOutline) {
+  std::array<uint8_t, 8> pixels = {255, 255, 255, 255, 0, 0, 0, 0};
+  ConvertCoverageToSignedDistanceField(pixels.data(), pixels.size(),
+                                       ISize(8, 1), 4.0f);
+  for (size_t i = 1; i < pixels.size(); i++) {
+    EXPECT_LT(pixels[i], pixels[i - 1]);
+  }
+  EXPECT_GT(pixels[3], 128);
+  EXPECT_LT(pixels[4], 128);
+  EXPECT_EQ(pixels[3] - 128, 128 - pixels[4] - 1);
+}
+
 TEST_P(TypographerTest, GlyphAtlasWithOddUniqueGlyphSize) {
   auto context = TypographerContextSkia::Make();
   auto atlas_context = context->CreateGlyphAtlasContext();
@@ -167,6 +287,36 @@ TEST_P(TypographerTest, GlyphAtlasIsRecycledIfUnchanged) {
   ASSERT_EQ(atlas_context->GetGlyphAtlas(), atlas);
 }
 
+TEST_P(TypographerTest, GlyphAtlasReportsTheReuseOfItsGlyphs) {
+  auto context = TypographerContextSkia::Make();
+  auto atlas_context = context->CreateGlyphAtlasContext();
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString("spooky skellingtons", sk_font);
+  ASSERT_TRUE(blob);
+  auto atlas = CreateGlyphAtlas(
+      *GetContext(), context.get(), GlyphAtlas::Type::kAlphaBitmap, 1.0f,
+      atlas_context, *MakeTextFrameFromTextBlobSkia(blob));
+  ASSERT_NE(atlas, nullptr);
+
+  // All glyphs of the first frame are drawn into a new atlas.
+  const GlyphAtlasFrameStats& stats = atlas_context->GetLastFrameStats();
+  EXPECT_EQ(stats.hit_count, 0u);
+  EXPECT_EQ(stats.miss_count, atlas->GetGlyphCount());
+  EXPECT_EQ(stats.eviction_count, 0u);
+  EXPECT_TRUE(stats.regenerated);
+
+  // The same glyphs are all found in the atlas again.
+  CreateGlyphAtlas(*GetContext(), context.get(),
+                   GlyphAtlas::Type::kAlphaBitmap, 1.0f, atlas_context,
+                   *MakeTextFrameFromTextBlobSkia(blob));
+  const GlyphAtlasFrameStats& next_stats = atlas_context->GetLastFrameStats();
+  EXPECT_EQ(next_stats.hit_count, atlas->GetGlyphCount());
+  EXPECT_EQ(next_stats.miss_count, 0u);
+  EXPECT_FALSE(next_stats.regenerated);
+  EXPECT_EQ(next_stats.update_time, fml::TimeDelta::Zero());
+}
+
 TEST_P(TypographerTest, GlyphAtlasWithLotsOfdUniqueGlyphSize) {
   auto context = TypographerContextSkia::Make();
   auto atlas_context = context->CreateGlyphAtlasContext();
@@ -374,6 +524,156 @@ TEST_P(TypographerTest, GlyphAtlasTextureIsRecycledWhenContentsAreRecreated) {
   ASSERT_NE(old_packer, new_packer);
 }
 
+TEST_P(TypographerTest, RectanglePackerGrowKeepsPlacedRectangles) {
+  auto packer = std::shared_ptr<RectanglePacker>(
+      RectanglePacker::Factory(100, 100));
+
+  IPoint16 first_output = {-1, -1};
+  ASSERT_TRUE(packer->addRect(100, 60, &first_output));
+  IPoint16 output;
+  ASSERT_FALSE(packer->addRect(60, 60, &output));
+
+  auto taller = packer->Grow(100, 200);
+  ASSERT_TRUE(flutter::testing::NumberNear(taller->percentFull(), 0.3));
+  IPoint16 second_output = {-1, -1};
+  ASSERT_TRUE(taller->addRect(60, 60, &second_output));
+  ASSERT_EQ(second_output.x(), 0);
+  ASSERT_EQ(second_output.y(), 60);
+
+  auto wider = packer->Grow(200, 100);
+  IPoint16 third_output = {-1, -1};
+  ASSERT_TRUE(wider->addRect(60, 60, &third_output));
+  ASSERT_EQ(third_output.x(), 100);
+  ASSERT_EQ(third_output.y(), 0);
+
+  // The original packer is unchanged.
+  ASSERT_FALSE(packer->addRect(60, 60, &output));
+}
+
+TEST_P(TypographerTest, GlyphAtlasGrowsWithoutMovingExistingGlyphs) {
+  auto context = TypographerContextSkia::Make();
+  auto atlas_context = context->CreateGlyphAtlasContext();
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString("A", sk_font);
+  ASSERT_TRUE(blob);
+  auto atlas = CreateGlyphAtlas(
+      *GetContext(), context.get(), GlyphAtlas::Type::kColorBitmap, 1.0f,
+      atlas_context, *MakeTextFrameFromTextBlobSkia(blob));
+  ASSERT_NE(atlas, nullptr);
+  ASSERT_NE(atlas->GetTexture(), nullptr);
+  auto first_size = atlas->GetTexture()->GetSize();
+
+  std::optional<Rect> first_bounds;
+  atlas->IterateGlyphs(
+      [&](const ScaledFont& scaled_font, const Glyph& glyph, const Rect& rect) {
+        first_bounds = rect;
+        return true;
+      });
+  ASSERT_TRUE(first_bounds.has_value());
+
+  // Many more glyphs than fit into the first atlas, along with the one that
+  // is already there.
+  auto blob2 =
+      SkTextBlob::MakeFromString("ABCDEFGHIJKLMNOPQRSTUVWXYZ", sk_font);
+  auto next_atlas = CreateGlyphAtlas(
+      *GetContext(), context.get(), GlyphAtlas::Type::kColorBitmap, 1.0f,
+      atlas_context, *MakeTextFrameFromTextBlobSkia(blob2));
+  ASSERT_EQ(atlas, next_atlas);
+  ASSERT_EQ(next_atlas->GetGlyphCount(), 26u);
+
+  auto next_size = next_atlas->GetTexture()->GetSize();
+  EXPECT_GE(next_size.width, first_size.width);
+  EXPECT_GE(next_size.height, first_size.height);
+  EXPECT_GT(next_size.Area(), first_size.Area());
+  EXPECT_EQ(atlas_context->GetAtlasSize(), next_size);
+
+  // The glyph that was already in the atlas was not moved.
+  bool found = false;
+  next_atlas->IterateGlyphs(
+      [&](const ScaledFont& scaled_font, const Glyph& glyph, const Rect& rect) {
+        found |= rect == first_bounds.value();
+        return true;
+      });
+  EXPECT_TRUE(found);
+}
+
+TEST_P(TypographerTest, GlyphAtlasContextForgetsGlyphsNotUsedRecently) {
+  auto context = TypographerContextSkia::Make();
+  auto atlas_context = context->CreateGlyphAtlasContext();
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  FontGlyphMap first_glyphs;
+  MakeTextFrameFromTextBlobSkia(SkTextBlob::MakeFromString("ab", sk_font))
+      ->CollectUniqueFontGlyphPairs(first_glyphs, 1.0f);
+  FontGlyphMap second_glyphs;
+  MakeTextFrameFromTextBlobSkia(SkTextBlob::MakeFromString("bc", sk_font))
+      ->CollectUniqueFontGlyphPairs(second_glyphs, 1.0f);
+  auto count_glyphs = [](const FontGlyphMap& font_glyph_map) {
+    size_t count = 0u;
+    for (const auto& font_value : font_glyph_map) {
+      count += font_value.second.size();
+    }
+    return count;
+  };
+
+  atlas_context->MarkGlyphsUsed(first_glyphs);
+  atlas_context->MarkGlyphsUsed(second_glyphs);
+
+  // "a" was last used one frame ago, "b" and "c" in the current frame.
+  EXPECT_EQ(count_glyphs(atlas_context->RetainRecentlyUsedGlyphs(2u)), 3u);
+  EXPECT_EQ(count_glyphs(atlas_context->RetainRecentlyUsedGlyphs(1u)), 2u);
+  // "a" is forgotten now.
+  EXPECT_EQ(count_glyphs(atlas_context->RetainRecentlyUsedGlyphs(2u)), 2u);
+}
+
+TEST_P(TypographerTest, GlyphAtlasDrawnOnWorkersMatchesSerialDrawing) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  auto serial_context = TypographerContextSkia::Make();
+  auto concurrent_context = TypographerContextSkia::Make(loop->GetTaskRunner());
+  auto serial_atlas_context = serial_context->CreateGlyphAtlasContext();
+  auto concurrent_atlas_context = concurrent_context->CreateGlyphAtlasContext();
+
+  // Enough unique glyphs to be drawn on the workers.
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString(
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789!?@#$%&*",
+      sk_font);
+  ASSERT_TRUE(blob);
+  auto frame = MakeTextFrameFromTextBlobSkia(blob);
+  auto serial_atlas = CreateGlyphAtlas(
+      *GetContext(), serial_context.get(), GlyphAtlas::Type::kAlphaBitmap,
+      1.0f, serial_atlas_context, *frame);
+  auto concurrent_atlas = CreateGlyphAtlas(
+      *GetContext(), concurrent_context.get(), GlyphAtlas::Type::kAlphaBitmap,
+      1.0f, concurrent_atlas_context, *frame);
+  ASSERT_NE(serial_atlas, nullptr);
+  ASSERT_NE(concurrent_atlas, nullptr);
+  ASSERT_GE(concurrent_atlas->GetGlyphCount(), 64u);
+
+  auto serial_bitmap =
+      GlyphAtlasContextSkia::Cast(*serial_atlas_context).GetBitmap();
+  auto concurrent_bitmap =
+      GlyphAtlasContextSkia::Cast(*concurrent_atlas_context).GetBitmap();
+  ASSERT_EQ(serial_bitmap->width(), concurrent_bitmap->width());
+  ASSERT_EQ(serial_bitmap->height(), concurrent_bitmap->height());
+
+  // The glyphs are placed identically, so their pixels must match.
+  concurrent_atlas->IterateGlyphs([&](const ScaledFont& scaled_font,
+                                      const Glyph& glyph,
+                                      const Rect& rect) {
+    auto serial_rect = serial_atlas->FindFontGlyphBounds({scaled_font, glyph});
+    EXPECT_EQ(serial_rect, rect);
+    for (auto y = rect.GetTop(); y < rect.GetBottom(); y++) {
+      for (auto x = rect.GetLeft(); x < rect.GetRight(); x++) {
+        EXPECT_EQ(*serial_bitmap->getAddr8(x, y),
+                  *concurrent_bitmap->getAddr8(x, y));
+      }
+    }
+    return true;
+  });
+  loop->Terminate();
+}
+
 }  // namespace testing
 }  // namespace impeller
 
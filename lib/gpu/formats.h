@@ -131,6 +131,10 @@ constexpr FlutterGPUPixelFormat FromImpellerPixelFormat(
       return FlutterGPUPixelFormat::kD24UnormS8Uint;
     case impeller::PixelFormat::kD32FloatS8UInt:
       return FlutterGPUPixelFormat::kD32FloatS8UInt;
+    case impeller::PixelFormat::kASTC4x4UNormInt:
+    case impeller::PixelFormat::kETC2R8G8B8A8UNormInt:
+    case impeller::PixelFormat::kBC7UNormInt:
+      return FlutterGPUPixelFormat::kUnknown;
   }
 }
 
@@ -51,9 +51,7 @@ void SceneBuilder::pushTransform(Dart_Handle layer_handle,
   matrix4.Release();
   EngineLayer::MakeRetained(layer_handle, layer);
 
-  if (oldLayer && oldLayer->Layer()) {
-    layer->AssignOldLayer(oldLayer->Layer().get());
-  }
+  AssignOldLayer(layer.get(), oldLayer);
 }
 
 void SceneBuilder::pushOffset(Dart_Handle layer_handle,
@@ -65,9 +63,7 @@ void SceneBuilder::pushOffset(Dart_Handle layer_handle,
   PushLayer(layer);
   EngineLayer::MakeRetained(layer_handle, layer);
 
-  if (oldLayer && oldLayer->Layer()) {
-    layer->AssignOldLayer(oldLayer->Layer().get());
-  }
+  AssignOldLayer(layer.get(), oldLayer);
 }
 
 void SceneBuilder::pushClipRect(Dart_Handle layer_handle,
@@ -85,9 +81,7 @@ void SceneBuilder::pushClipRect(Dart_Handle layer_handle,
   PushLayer(layer);
   EngineLayer::MakeRetained(layer_handle, layer);
 
-  if (oldLayer && oldLayer->Layer()) {
-    layer->AssignOldLayer(oldLayer->Layer().get());
-  }
+  AssignOldLayer(layer.get(), oldLayer);
 }
 
 void SceneBuilder::pushClipRRect(Dart_Handle layer_handle,
@@ -100,9 +94,7 @@ void SceneBuilder::pushClipRRect(Dart_Handle layer_handle,
   PushLayer(layer);
   EngineLayer::MakeRetained(layer_handle, layer);
 
-  if (oldLayer && oldLayer->Layer()) {
-    layer->AssignOldLayer(oldLayer->Layer().get());
-  }
+  AssignOldLayer(layer.get(), oldLayer);
 }
 
 void SceneBuilder::pushClipPath(Dart_Handle layer_handle,
@@ -116,9 +108,7 @@ void SceneBuilder::pushClipPath(Dart_Handle layer_handle,
   PushLayer(layer);
   EngineLayer::MakeRetained(layer_handle, layer);
 
-  if (oldLayer && oldLayer->Layer()) {
-    layer->AssignOldLayer(oldLayer->Layer().get());
-  }
+  AssignOldLayer(layer.get(), oldLayer);
 }
 
 void SceneBuilder::pushOpacity(Dart_Handle layer_handle,
@@ -131,9 +121,7 @@ void SceneBuilder::pushOpacity(Dart_Handle layer_handle,
   PushLayer(layer);
   EngineLayer::MakeRetained(layer_handle, layer);
 
-  if (oldLayer && oldLayer->Layer()) {
-    layer->AssignOldLayer(oldLayer->Layer().get());
-  }
+  AssignOldLayer(layer.get(), oldLayer);
 }
 
 void SceneBuilder::pushColorFilter(Dart_Handle layer_handle,
@@ -144,9 +132,7 @@ void SceneBuilder::pushColorFilter(Dart_Handle layer_handle,
   PushLayer(layer);
   EngineLayer::MakeRetained(layer_handle, layer);
 
-  if (oldLayer && oldLayer->Layer()) {
-    layer->AssignOldLayer(oldLayer->Layer().get());
-  }
+  AssignOldLayer(layer.get(), oldLayer);
 }
 
 void SceneBuilder::pushImageFilter(Dart_Handle layer_handle,
@@ -159,9 +145,7 @@ void SceneBuilder::pushImageFilter(Dart_Handle layer_handle,
   PushLayer(layer);
   EngineLayer::MakeRetained(layer_handle, layer);
 
-  if (oldLayer && oldLayer->Layer()) {
-    layer->AssignOldLayer(oldLayer->Layer().get());
-  }
+  AssignOldLayer(layer.get(), oldLayer);
 }
 
 void SceneBuilder::pushBackdropFilter(
@@ -174,9 +158,7 @@ void SceneBuilder::pushBackdropFilter(
   PushLayer(layer);
   EngineLayer::MakeRetained(layer_handle, layer);
 
-  if (oldLayer && oldLayer->Layer()) {
-    layer->AssignOldLayer(oldLayer->Layer().get());
-  }
+  AssignOldLayer(layer.get(), oldLayer);
 }
 
 void SceneBuilder::pushShaderMask(Dart_Handle layer_handle,
@@ -197,9 +179,7 @@ void SceneBuilder::pushShaderMask(Dart_Handle layer_handle,
   PushLayer(layer);
   EngineLayer::MakeRetained(layer_handle, layer);
 
-  if (oldLayer && oldLayer->Layer()) {
-    layer->AssignOldLayer(oldLayer->Layer().get());
-  }
+  AssignOldLayer(layer.get(), oldLayer);
 }
 
 void SceneBuilder::addRetained(const fml::RefPtr<EngineLayer>& retainedLayer) {
@@ -303,6 +283,18 @@ void SceneBuilder::PushLayer(std::shared_ptr<ContainerLayer> layer) {
   layer_stack_.push_back(std::move(layer));
 }
 
+void SceneBuilder::AssignOldLayer(ContainerLayer* layer,
+                                  const fml::RefPtr<EngineLayer>& old_layer) {
+  if (!old_layer || !old_layer->Layer()) {
+    return;
+  }
+  const ContainerLayer* old_container = old_layer->Layer().get();
+  layer->AssignOldLayer(old_layer->Layer().get());
+  // A layer pushed in place of an old one is usually rebuilt with the same
+  // children, most of them retained, so size its children for them up front.
+  layer->ReserveLayers(old_container->layers().size());
+}
+
 void SceneBuilder::PopLayer() {
   // We never pop the root layer, so that AddLayer operations are always valid.
   if (layer_stack_.size() > 1) {
@@ -133,6 +133,8 @@ class SceneBuilder : public RefCountedDartWrappable<SceneBuilder> {
   void AddLayer(std::shared_ptr<Layer> layer);
   void PushLayer(std::shared_ptr<ContainerLayer> layer);
   void PopLayer();
+  void AssignOldLayer(ContainerLayer* layer,
+                      const fml::RefPtr<EngineLayer>& old_layer);
 
   std::vector<std::shared_ptr<ContainerLayer>> layer_stack_;
   int rasterizer_tracing_threshold_ = 0;
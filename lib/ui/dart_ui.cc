@@ -90,17 +90,20 @@ typedef CanvasPath Path;
   V(ImmutableBuffer::init, 3)                                         \
   V(ImmutableBuffer::initFromAsset, 3)                                \
   V(ImmutableBuffer::initFromFile, 3)                                 \
+  V(ImmutableBuffer::prefetchAssets, 2)                               \
   V(ImageDescriptor::initRaw, 6)                                      \
   V(IsolateNameServerNatives::LookupPortByName, 1)                    \
   V(IsolateNameServerNatives::RegisterPortWithName, 2)                \
   V(IsolateNameServerNatives::RemovePortNameMapping, 1)               \
   V(NativeStringAttribute::initLocaleStringAttribute, 4)              \
   V(NativeStringAttribute::initSpellOutStringAttribute, 3)            \
+  V(Paragraph::LayoutAll, 3)                                          \
   V(PlatformConfigurationNativeApi::DefaultRouteName, 0)              \
   V(PlatformConfigurationNativeApi::ScheduleFrame, 0)                 \
   V(PlatformConfigurationNativeApi::Render, 1)                        \
   V(PlatformConfigurationNativeApi::UpdateSemantics, 1)               \
   V(PlatformConfigurationNativeApi::SetNeedsReportTimings, 1)         \
+  V(PlatformConfigurationNativeApi::SetFrameRateRange, 3)             \
   V(PlatformConfigurationNativeApi::SetIsolateDebugName, 1)           \
   V(PlatformConfigurationNativeApi::RequestDartPerformanceMode, 1)    \
   V(PlatformConfigurationNativeApi::GetPersistentIsolateData, 0)      \
@@ -143,6 +146,7 @@ typedef CanvasPath Path;
   V(Canvas, drawAtlas, 10)                             \
   V(Canvas, drawCircle, 6)                             \
   V(Canvas, drawColor, 3)                              \
+  V(Canvas, drawCommands, 4)                           \
   V(Canvas, drawDRRect, 5)                             \
   V(Canvas, drawImage, 7)                              \
   V(Canvas, drawImageNine, 13)                         \
@@ -197,6 +201,7 @@ typedef CanvasPath Path;
   V(ImageDescriptor, dispose, 1)                       \
   V(ImageDescriptor, height, 1)                        \
   V(ImageDescriptor, instantiateCodec, 4)              \
+  V(ImageDescriptor, instantiateRegionCodec, 8)        \
   V(ImageDescriptor, width, 1)                         \
   V(ImageFilter, initBlur, 4)                          \
   V(ImageFilter, initDilate, 3)                        \
@@ -381,6 +386,14 @@ void DartUI::InitForIsolate(const Settings& settings) {
     }
   }
 
+  if (settings.batch_canvas_commands) {
+    result =
+        Dart_SetField(dart_ui, ToDart("_batchCanvasCommands"), Dart_True());
+    if (Dart_IsError(result)) {
+      Dart_PropagateError(result);
+    }
+  }
+
   result = Dart_SetField(dart_ui, ToDart("_implicitViewId"),
                          Dart_NewInteger(kFlutterImplicitViewId));
   if (Dart_IsError(result)) {
@@ -5,6 +5,10 @@
 #ifndef FLUTTER_LIB_UI_DART_WRAPPER_H_
 #define FLUTTER_LIB_UI_DART_WRAPPER_H_
 
+#include <cstddef>
+#include <new>
+#include <vector>
+
 #include "flutter/fml/memory/ref_counted.h"
 #include "third_party/tonic/dart_wrappable.h"
 
@@ -23,6 +27,84 @@ class RefCountedDartWrappable : public fml::RefCountedThreadSafe<T>,
   }
 };
 
+namespace internal {
+
+// Keeps the memory of up to |kMaxFreeCount| destroyed instances of T on each
+// thread, for the next instances of T that the thread creates.
+template <typename T>
+class DartWrappablePool {
+ public:
+  static constexpr size_t kMaxFreeCount = 256;
+
+  static void* Allocate(size_t size) {
+    if (size == sizeof(T)) {
+      if (FreeList* free_list = GetFreeList();
+          free_list && !free_list->blocks.empty()) {
+        void* block = free_list->blocks.back();
+        free_list->blocks.pop_back();
+        return block;
+      }
+    }
+    return ::operator new(size);
+  }
+
+  static void Free(void* block, size_t size) {
+    // Subclasses of T that are larger than T use the heap.
+    if (size == sizeof(T)) {
+      if (FreeList* free_list = GetFreeList();
+          free_list && free_list->blocks.size() < kMaxFreeCount) {
+        free_list->blocks.push_back(block);
+        return;
+      }
+    }
+    ::operator delete(block);
+  }
+
+ private:
+  struct FreeList {
+    FreeList() { blocks.reserve(kMaxFreeCount); }
+
+    ~FreeList() {
+      for (void* block : blocks) {
+        ::operator delete(block);
+      }
+      is_destroyed_ = true;
+    }
+
+    std::vector<void*> blocks;
+  };
+
+  // Instances may still be destroyed by the destructors of other thread
+  // locals after the free list of the thread is gone.
+  static inline thread_local bool is_destroyed_ = false;
+
+  static FreeList* GetFreeList() {
+    if (is_destroyed_) {
+      return nullptr;
+    }
+    thread_local FreeList free_list;
+    return &free_list;
+  }
+};
+
+}  // namespace internal
+
+// A RefCountedDartWrappable for the types that frames create and release in
+// large numbers, such as paths and pictures. Instead of going back to the
+// heap, the memory of the instances that the finalizers of their wrappers
+// destroy is reused for the next instances.
+template <typename T>
+class PooledDartWrappable : public RefCountedDartWrappable<T> {
+ public:
+  static void* operator new(size_t size) {
+    return internal::DartWrappablePool<T>::Allocate(size);
+  }
+
+  static void operator delete(void* block, size_t size) {
+    internal::DartWrappablePool<T>::Free(block, size);
+  }
+};
+
 }  // namespace flutter
 
 #endif  // FLUTTER_LIB_UI_DART_WRAPPER_H_
@@ -0,0 +1,71 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/dart_wrapper.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class PooledWrappable : public PooledDartWrappable<PooledWrappable> {
+  DEFINE_WRAPPERTYPEINFO();
+  FML_FRIEND_MAKE_REF_COUNTED(PooledWrappable);
+
+ protected:
+  PooledWrappable() = default;
+};
+
+IMPLEMENT_WRAPPERTYPEINFO(test, PooledWrappable);
+
+class LargerPooledWrappable : public PooledWrappable {
+  FML_FRIEND_MAKE_REF_COUNTED(LargerPooledWrappable);
+
+ private:
+  LargerPooledWrappable() = default;
+
+  char padding_[64] = {};
+};
+
+}  // namespace
+
+TEST(DartWrapperTest, PooledWrappablesReuseTheMemoryOfReleasedOnes) {
+  auto first = fml::MakeRefCounted<PooledWrappable>();
+  const void* address = first.get();
+  first = nullptr;
+
+  auto second = fml::MakeRefCounted<PooledWrappable>();
+  EXPECT_EQ(second.get(), address);
+}
+
+TEST(DartWrapperTest, PooledWrappablesAreNotReusedByLargerSubclasses) {
+  auto wrappable = fml::MakeRefCounted<PooledWrappable>();
+  const void* address = wrappable.get();
+  wrappable = nullptr;
+
+  auto larger = fml::MakeRefCounted<LargerPooledWrappable>();
+  EXPECT_NE(static_cast<const void*>(larger.get()), address);
+  larger = nullptr;
+
+  // The memory of the larger instance went back to the heap.
+  auto reused = fml::MakeRefCounted<PooledWrappable>();
+  EXPECT_EQ(reused.get(), address);
+}
+
+TEST(DartWrapperTest, PooledWrappablesCanBeReleasedOnAnotherThread) {
+  auto wrappable = fml::MakeRefCounted<PooledWrappable>();
+  std::thread thread([wrappable = std::move(wrappable)]() mutable {
+    wrappable = nullptr;
+  });
+  thread.join();
+
+  EXPECT_TRUE(fml::MakeRefCounted<PooledWrappable>());
+}
+
+}  // namespace testing
+}  // namespace flutter
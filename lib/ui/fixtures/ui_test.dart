@@ -48,6 +48,25 @@ void setLatencyPerformanceMode() {
   _finish();
 }
 
+@pragma('vm:entry-point')
+void receiveLargePlatformMessage() {
+  channelBuffers.setListener('test/large', (ByteData? data, PlatformMessageResponseCallback callback) {
+    int sum = 0;
+    for (int i = 0; i < data!.lengthInBytes; i++) {
+      sum += data.getUint8(i);
+    }
+    // Messages are handed over to Dart, so they stay writable.
+    data.setUint8(0, 0);
+    _validateLargePlatformMessage(data.lengthInBytes, sum, data.getUint8(0));
+  });
+  _sendLargePlatformMessage();
+}
+
+@pragma('vm:external-name', 'SendLargePlatformMessage')
+external void _sendLargePlatformMessage();
+@pragma('vm:external-name', 'ValidateLargePlatformMessage')
+external void _validateLargePlatformMessage(int length, int sum, int first);
+
 @pragma('vm:entry-point')
 void validateSceneBuilderAndScene() {
   final SceneBuilder builder = SceneBuilder();
@@ -464,6 +483,25 @@ void convertPaintToDlPaint() {
 @pragma('vm:external-name',  'ConvertPaintToDlPaint')
 external void _convertPaintToDlPaint(Paint paint);
 
+@pragma('vm:entry-point')
+void recordBatchedCanvasCommands() {
+  final PictureRecorder recorder = PictureRecorder();
+  final Canvas canvas = Canvas(recorder);
+  final Paint paint = Paint()..color = const Color(0xFF00FF00);
+  canvas.save();
+  canvas.translate(10, 20);
+  canvas.drawRect(const Rect.fromLTRB(0, 0, 10, 10), paint);
+  canvas.drawRect(const Rect.fromLTRB(10, 0, 20, 10), paint);
+  paint.color = const Color(0xFF0000FF);
+  canvas.drawCircle(const Offset(5, 5), 5, paint);
+  canvas.drawColor(const Color(0xFFFF0000), BlendMode.srcOver);
+  canvas.restore();
+  canvas.drawRRect(RRect.fromLTRBR(0, 0, 10, 10, const Radius.circular(2)), paint);
+  _validateBatchedPicture(recorder.endRecording());
+}
+@pragma('vm:external-name', 'ValidateBatchedPicture')
+external void _validateBatchedPicture(Picture picture);
+
 @pragma('vm:entry-point')
 void hooksTests() async {
   Future<void> test(String name, FutureOr<void> Function() testFunction) async {
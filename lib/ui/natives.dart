@@ -113,6 +113,11 @@ _ScheduleImmediateClosure _getScheduleMicrotaskClosure() => _scheduleMicrotask;
 @pragma('vm:entry-point')
 bool _impellerEnabled = false;
 
+// Used internally to indicate whether a Canvas records its common commands
+// into a buffer that is sent to the engine in batches.
+@pragma('vm:entry-point')
+bool _batchCanvasCommands = false;
+
 // Used internally to indicate whether the embedder enables the implicit view,
 // and the implicit view's ID if so.
 //
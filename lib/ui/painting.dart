@@ -4595,6 +4595,18 @@ base class FragmentShader extends Shader {
     _floats[index] = value;
   }
 
+  /// Sets the float uniforms starting at [index] to [values].
+  ///
+  /// This is equivalent to calling [setFloat] for each of the [values] in
+  /// turn, but copies them in bulk, which is faster for shaders that update
+  /// many uniforms every frame, such as a `mat4` or an array of `vec4`s.
+  ///
+  /// The [values] must fit within the float uniforms of the shader.
+  void setFloats(int index, List<double> values) {
+    assert(!debugDisposed, 'Tried to accesss uniforms on a disposed Shader: $this');
+    _floats.setRange(index, index + values.length, values);
+  }
+
   /// Sets the sampler uniform at [index] to [image].
   ///
   /// The index provided to setImageSampler is the index of the sampler uniform defined
@@ -4959,7 +4971,11 @@ abstract class Canvas {
   ///
   /// To end the recording, call [PictureRecorder.endRecording] on the
   /// given recorder.
-  factory Canvas(PictureRecorder recorder, [ Rect? cullRect ]) = _NativeCanvas;
+  factory Canvas(PictureRecorder recorder, [ Rect? cullRect ]) {
+    return _batchCanvasCommands
+        ? _BatchingCanvas(recorder, cullRect)
+        : _NativeCanvas(recorder, cullRect);
+  }
 
   /// Saves a copy of the current transform and clip on the save stack.
   ///
@@ -6220,6 +6236,416 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
 
   @Native<Void Function(Pointer<Void>, Pointer<Void>, Uint32, Double, Bool)>(symbol: 'Canvas::drawShadow')
   external void _drawShadow(_NativePath path, int color, double elevation, bool transparentOccluder);
+
+  // Sends the commands that a _BatchingCanvas has recorded to the engine.
+  void _flush() {}
+}
+
+// The commands a _BatchingCanvas records.
+//
+// Must be kept in sync with CanvasCommand in canvas.cc.
+enum _CanvasCommand {
+  save,
+  restore,
+  translate,
+  scale,
+  rotate,
+  clipRect,
+  drawLine,
+  drawRect,
+  drawRRect,
+  drawOval,
+  drawCircle,
+}
+
+/// A [Canvas] that records its most common commands into a buffer, which is
+/// sent to the engine with a single native call when it is full, instead of
+/// making a native call for every command.
+///
+/// The buffer is a sequence of 32-bit values. Each command is its
+/// [_CanvasCommand] index followed by its arguments. A command that paints
+/// ends with the index of a copy of the paint objects in [_objects], or -1 if
+/// the paint has none, and with a copy of the paint data.
+///
+/// Every other command flushes the buffer before it is made, so the engine
+/// sees the commands in the order they were made. So do the commands that
+/// refer to a [Path] or a [Paragraph], since those may change before the
+/// buffer is flushed, and the paints whose shader may be disposed or change
+/// its uniforms.
+///
+/// The binary format must match the deserialization code in canvas.cc.
+base class _BatchingCanvas extends _NativeCanvas {
+  _BatchingCanvas(super.recorder, [ super.cullRect ]);
+
+  static const int _kCapacity = 16 * 1024;
+
+  // The index of the paint objects and the paint data.
+  static const int _kPaintValueCount = 1 + Paint._kDataByteCount ~/ 4;
+
+  final ByteData _commands = ByteData(_kCapacity);
+  int _length = 0;
+
+  final List<Object?> _objects = <Object?>[];
+
+  // The copy of the paint objects that the last command used, which the next
+  // command reuses when its paint has the same objects.
+  List<Object?>? _lastPaintObjects;
+
+  @override
+  void _flush() {
+    if (_length == 0) {
+      return;
+    }
+    _drawCommands(_commands, _length, _objects);
+    _length = 0;
+    _objects.clear();
+    _lastPaintObjects = null;
+  }
+
+  @Native<Void Function(Pointer<Void>, Handle, Int32, Handle)>(symbol: 'Canvas::drawCommands')
+  external void _drawCommands(ByteData commands, int length, List<Object?> objects);
+
+  // Starts a command with |valueCount| values after its index.
+  void _beginCommand(_CanvasCommand command, int valueCount) {
+    if (_length + (valueCount + 1) * 4 > _kCapacity) {
+      _flush();
+    }
+    _writeInt(command.index);
+  }
+
+  void _writeInt(int value) {
+    _commands.setInt32(_length, value, _kFakeHostEndian);
+    _length += 4;
+  }
+
+  void _writeFloat(double value) {
+    _commands.setFloat32(_length, value, _kFakeHostEndian);
+    _length += 4;
+  }
+
+  void _writeRect(Rect rect) {
+    _writeFloat(rect.left);
+    _writeFloat(rect.top);
+    _writeFloat(rect.right);
+    _writeFloat(rect.bottom);
+  }
+
+  void _writePaint(Paint paint) {
+    final List<Object?>? objects = paint._objects;
+    if (objects == null) {
+      _writeInt(-1);
+    } else {
+      // The paint may be changed before the buffer is flushed, so the objects
+      // are copied.
+      final List<Object?>? lastObjects = _lastPaintObjects;
+      if (lastObjects == null ||
+          !identical(lastObjects[Paint._kShaderIndex], objects[Paint._kShaderIndex]) ||
+          !identical(lastObjects[Paint._kColorFilterIndex], objects[Paint._kColorFilterIndex]) ||
+          !identical(lastObjects[Paint._kImageFilterIndex], objects[Paint._kImageFilterIndex])) {
+        _lastPaintObjects = List<Object?>.of(objects, growable: false);
+        _objects.add(_lastPaintObjects);
+      }
+      _writeInt(_objects.length - 1);
+    }
+    final ByteData data = paint._data;
+    for (int offset = 0; offset < Paint._kDataByteCount; offset += 4) {
+      _writeInt(data.getInt32(offset, _kFakeHostEndian));
+    }
+  }
+
+  static bool _canBatch(Paint paint) {
+    final Object? shader = paint._objects?[Paint._kShaderIndex];
+    return shader == null || shader is Gradient;
+  }
+
+  @override
+  void save() {
+    _beginCommand(_CanvasCommand.save, 0);
+  }
+
+  @override
+  void saveLayer(Rect? bounds, Paint paint) {
+    _flush();
+    super.saveLayer(bounds, paint);
+  }
+
+  @override
+  void restore() {
+    _beginCommand(_CanvasCommand.restore, 0);
+  }
+
+  @override
+  void restoreToCount(int count) {
+    _flush();
+    super.restoreToCount(count);
+  }
+
+  @override
+  int getSaveCount() {
+    _flush();
+    return super.getSaveCount();
+  }
+
+  @override
+  void translate(double dx, double dy) {
+    _beginCommand(_CanvasCommand.translate, 2);
+    _writeFloat(dx);
+    _writeFloat(dy);
+  }
+
+  @override
+  void scale(double sx, [double? sy]) {
+    _beginCommand(_CanvasCommand.scale, 2);
+    _writeFloat(sx);
+    _writeFloat(sy ?? sx);
+  }
+
+  @override
+  void rotate(double radians) {
+    _beginCommand(_CanvasCommand.rotate, 1);
+    _writeFloat(radians);
+  }
+
+  @override
+  void skew(double sx, double sy) {
+    _flush();
+    super.skew(sx, sy);
+  }
+
+  @override
+  void transform(Float64List matrix4) {
+    _flush();
+    super.transform(matrix4);
+  }
+
+  @override
+  Float64List getTransform() {
+    _flush();
+    return super.getTransform();
+  }
+
+  @override
+  void clipRect(Rect rect, { ClipOp clipOp = ClipOp.intersect, bool doAntiAlias = true }) {
+    assert(_rectIsValid(rect));
+    _beginCommand(_CanvasCommand.clipRect, 6);
+    _writeRect(rect);
+    _writeInt(clipOp.index);
+    _writeInt(doAntiAlias ? 1 : 0);
+  }
+
+  @override
+  void clipRRect(RRect rrect, {bool doAntiAlias = true}) {
+    _flush();
+    super.clipRRect(rrect, doAntiAlias: doAntiAlias);
+  }
+
+  @override
+  void clipPath(Path path, {bool doAntiAlias = true}) {
+    _flush();
+    super.clipPath(path, doAntiAlias: doAntiAlias);
+  }
+
+  @override
+  Rect getLocalClipBounds() {
+    _flush();
+    return super.getLocalClipBounds();
+  }
+
+  @override
+  Rect getDestinationClipBounds() {
+    _flush();
+    return super.getDestinationClipBounds();
+  }
+
+  @override
+  void drawColor(Color color, BlendMode blendMode) {
+    _flush();
+    super.drawColor(color, blendMode);
+  }
+
+  @override
+  void drawLine(Offset p1, Offset p2, Paint paint) {
+    if (!_canBatch(paint)) {
+      _flush();
+      super.drawLine(p1, p2, paint);
+      return;
+    }
+    assert(_offsetIsValid(p1));
+    assert(_offsetIsValid(p2));
+    _beginCommand(_CanvasCommand.drawLine, 4 + _kPaintValueCount);
+    _writeFloat(p1.dx);
+    _writeFloat(p1.dy);
+    _writeFloat(p2.dx);
+    _writeFloat(p2.dy);
+    _writePaint(paint);
+  }
+
+  @override
+  void drawPaint(Paint paint) {
+    _flush();
+    super.drawPaint(paint);
+  }
+
+  @override
+  void drawRect(Rect rect, Paint paint) {
+    if (!_canBatch(paint)) {
+      _flush();
+      super.drawRect(rect, paint);
+      return;
+    }
+    assert(_rectIsValid(rect));
+    _beginCommand(_CanvasCommand.drawRect, 4 + _kPaintValueCount);
+    _writeRect(rect);
+    _writePaint(paint);
+  }
+
+  @override
+  void drawRRect(RRect rrect, Paint paint) {
+    if (!_canBatch(paint)) {
+      _flush();
+      super.drawRRect(rrect, paint);
+      return;
+    }
+    assert(_rrectIsValid(rrect));
+    _beginCommand(_CanvasCommand.drawRRect, 12 + _kPaintValueCount);
+    _writeFloat(rrect.left);
+    _writeFloat(rrect.top);
+    _writeFloat(rrect.right);
+    _writeFloat(rrect.bottom);
+    _writeFloat(rrect.tlRadiusX);
+    _writeFloat(rrect.tlRadiusY);
+    _writeFloat(rrect.trRadiusX);
+    _writeFloat(rrect.trRadiusY);
+    _writeFloat(rrect.brRadiusX);
+    _writeFloat(rrect.brRadiusY);
+    _writeFloat(rrect.blRadiusX);
+    _writeFloat(rrect.blRadiusY);
+    _writePaint(paint);
+  }
+
+  @override
+  void drawDRRect(RRect outer, RRect inner, Paint paint) {
+    _flush();
+    super.drawDRRect(outer, inner, paint);
+  }
+
+  @override
+  void drawOval(Rect rect, Paint paint) {
+    if (!_canBatch(paint)) {
+      _flush();
+      super.drawOval(rect, paint);
+      return;
+    }
+    assert(_rectIsValid(rect));
+    _beginCommand(_CanvasCommand.drawOval, 4 + _kPaintValueCount);
+    _writeRect(rect);
+    _writePaint(paint);
+  }
+
+  @override
+  void drawCircle(Offset c, double radius, Paint paint) {
+    if (!_canBatch(paint)) {
+      _flush();
+      super.drawCircle(c, radius, paint);
+      return;
+    }
+    assert(_offsetIsValid(c));
+    _beginCommand(_CanvasCommand.drawCircle, 3 + _kPaintValueCount);
+    _writeFloat(c.dx);
+    _writeFloat(c.dy);
+    _writeFloat(radius);
+    _writePaint(paint);
+  }
+
+  @override
+  void drawArc(Rect rect, double startAngle, double sweepAngle, bool useCenter, Paint paint) {
+    _flush();
+    super.drawArc(rect, startAngle, sweepAngle, useCenter, paint);
+  }
+
+  @override
+  void drawPath(Path path, Paint paint) {
+    _flush();
+    super.drawPath(path, paint);
+  }
+
+  @override
+  void drawImage(Image image, Offset offset, Paint paint) {
+    _flush();
+    super.drawImage(image, offset, paint);
+  }
+
+  @override
+  void drawImageRect(Image image, Rect src, Rect dst, Paint paint) {
+    _flush();
+    super.drawImageRect(image, src, dst, paint);
+  }
+
+  @override
+  void drawImageNine(Image image, Rect center, Rect dst, Paint paint) {
+    _flush();
+    super.drawImageNine(image, center, dst, paint);
+  }
+
+  @override
+  void drawPicture(Picture picture) {
+    _flush();
+    super.drawPicture(picture);
+  }
+
+  @override
+  void drawParagraph(Paragraph paragraph, Offset offset) {
+    _flush();
+    super.drawParagraph(paragraph, offset);
+  }
+
+  @override
+  void drawPoints(PointMode pointMode, List<Offset> points, Paint paint) {
+    _flush();
+    super.drawPoints(pointMode, points, paint);
+  }
+
+  @override
+  void drawRawPoints(PointMode pointMode, Float32List points, Paint paint) {
+    _flush();
+    super.drawRawPoints(pointMode, points, paint);
+  }
+
+  @override
+  void drawVertices(Vertices vertices, BlendMode blendMode, Paint paint) {
+    _flush();
+    super.drawVertices(vertices, blendMode, paint);
+  }
+
+  @override
+  void drawAtlas(Image atlas,
+                 List<RSTransform> transforms,
+                 List<Rect> rects,
+                 List<Color>? colors,
+                 BlendMode? blendMode,
+                 Rect? cullRect,
+                 Paint paint) {
+    _flush();
+    super.drawAtlas(atlas, transforms, rects, colors, blendMode, cullRect, paint);
+  }
+
+  @override
+  void drawRawAtlas(Image atlas,
+                    Float32List rstTransforms,
+                    Float32List rects,
+                    Int32List? colors,
+                    BlendMode? blendMode,
+                    Rect? cullRect,
+                    Paint paint) {
+    _flush();
+    super.drawRawAtlas(atlas, rstTransforms, rects, colors, blendMode, cullRect, paint);
+  }
+
+  @override
+  void drawShadow(Path path, Color color, double elevation, bool transparentOccluder) {
+    _flush();
+    super.drawShadow(path, color, elevation, transparentOccluder);
+  }
 }
 
 /// Signature for [Picture] lifecycle events.
@@ -6407,6 +6833,7 @@ base class _NativePictureRecorder extends NativeFieldWrapperClass1 implements Pi
       throw StateError('PictureRecorder did not start recording.');
     }
     final _NativePicture picture = _NativePicture._();
+    _canvas!._flush();
     _endRecording(picture);
     _canvas!._recorder = null;
     _canvas = null;
@@ -6673,6 +7100,25 @@ base class ImmutableBuffer extends NativeFieldWrapperClass1 {
     });
   }
 
+  /// Loads the assets with keys [assetKeys] in the background, so that later
+  /// calls to [fromAsset] for them do not wait for storage.
+  ///
+  /// Call this ahead of showing content that needs the assets, such as when
+  /// starting a route transition. Loaded assets are kept in a memory cache of
+  /// bounded size, so prefetching more than is about to be used can evict
+  /// assets that were prefetched earlier.
+  ///
+  /// The returned future completes once all of the assets were loaded. Keys of
+  /// assets that do not exist are ignored.
+  static Future<void> prefetchAssets(List<String> assetKeys) {
+    final List<String> encodedKeys = <String>[
+      for (final String assetKey in assetKeys) Uri(path: Uri.encodeFull(assetKey)).path,
+    ];
+    return _futurize((_Callback<void> callback) {
+      return _prefetchAssets(encodedKeys, callback);
+    });
+  }
+
   @Native<Handle Function(Handle, Handle, Handle)>(symbol: 'ImmutableBuffer::init')
   external String? _init(Uint8List list, _Callback<void> callback);
 
@@ -6682,6 +7128,9 @@ base class ImmutableBuffer extends NativeFieldWrapperClass1 {
   @Native<Handle Function(Handle, Handle, Handle)>(symbol: 'ImmutableBuffer::initFromFile')
   external String? _initFromFile(String assetKey, _Callback<int> callback);
 
+  @Native<Handle Function(Handle, Handle)>(symbol: 'ImmutableBuffer::prefetchAssets')
+  external static String? _prefetchAssets(List<String> assetKeys, _Callback<void> callback);
+
   /// The length, in bytes, of the underlying data.
   int get length => _length;
   int _length;
@@ -6786,7 +7235,15 @@ abstract class ImageDescriptor {
   ///
   /// If either targetWidth or targetHeight is less than or equal to zero, it
   /// will be treated as if it is null.
-  Future<Codec> instantiateCodec({int? targetWidth, int? targetHeight});
+  ///
+  /// If `region` is not null, only that region of the image is decoded, for
+  /// example the visible tile of a map or of a large scan, and the target
+  /// dimensions are those of the decoded region. The region is rounded out to
+  /// whole pixels and must lie within the image. Animated images decode the
+  /// region of their first frame.
+  ///
+  /// On the Web, `region` is not supported.
+  Future<Codec> instantiateCodec({int? targetWidth, int? targetHeight, Rect? region});
 }
 
 base class _NativeImageDescriptor extends NativeFieldWrapperClass1 implements ImageDescriptor {
@@ -6851,7 +7308,17 @@ base class _NativeImageDescriptor extends NativeFieldWrapperClass1 implements Im
   external void dispose();
 
   @override
-  Future<Codec> instantiateCodec({int? targetWidth, int? targetHeight}) async {
+  Future<Codec> instantiateCodec({int? targetWidth, int? targetHeight, Rect? region}) async {
+    final int left = region?.left.floor() ?? 0;
+    final int top = region?.top.floor() ?? 0;
+    final int right = region?.right.ceil() ?? width;
+    final int bottom = region?.bottom.ceil() ?? height;
+    if (left < 0 || top < 0 || right > width || bottom > height || left >= right || top >= bottom) {
+      throw ArgumentError.value(region, 'region', 'must be non-empty and within the ${width}x$height image');
+    }
+    final int sourceWidth = right - left;
+    final int sourceHeight = bottom - top;
+
     if (targetWidth != null && targetWidth <= 0) {
       targetWidth = null;
     }
@@ -6860,23 +7327,33 @@ base class _NativeImageDescriptor extends NativeFieldWrapperClass1 implements Im
     }
 
     if (targetWidth == null && targetHeight == null) {
-      targetWidth = width;
-      targetHeight = height;
+      targetWidth = sourceWidth;
+      targetHeight = sourceHeight;
     } else if (targetWidth == null && targetHeight != null) {
-      targetWidth = (targetHeight * (width / height)).round();
+      targetWidth = (targetHeight * (sourceWidth / sourceHeight)).round();
     } else if (targetHeight == null && targetWidth != null) {
-      targetHeight = targetWidth ~/ (width / height);
+      targetHeight = targetWidth ~/ (sourceWidth / sourceHeight);
     }
     assert(targetWidth != null);
     assert(targetHeight != null);
 
     final Codec codec = _NativeCodec._();
-    _instantiateCodec(codec, targetWidth!, targetHeight!);
+    if (region == null) {
+      _instantiateCodec(codec, targetWidth!, targetHeight!);
+    } else {
+      final String? error = _instantiateRegionCodec(codec, left, top, right, bottom, targetWidth!, targetHeight!);
+      if (error != null) {
+        throw Exception(error);
+      }
+    }
     return codec;
   }
 
   @Native<Void Function(Pointer<Void>, Handle, Int32, Int32)>(symbol: 'ImageDescriptor::instantiateCodec')
   external void _instantiateCodec(Codec outCodec, int targetWidth, int targetHeight);
+
+  @Native<Handle Function(Pointer<Void>, Handle, Int32, Int32, Int32, Int32, Int32, Int32)>(symbol: 'ImageDescriptor::instantiateRegionCodec')
+  external String? _instantiateRegionCodec(Codec outCodec, int left, int top, int right, int bottom, int targetWidth, int targetHeight);
 }
 
 /// Generic callback signature, used by [_futurize].
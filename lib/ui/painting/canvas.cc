@@ -5,6 +5,8 @@
 #include "flutter/lib/ui/painting/canvas.h"
 
 #include <cmath>
+#include <cstring>
+#include <vector>
 
 #include "flutter/display_list/dl_builder.h"
 #include "flutter/lib/ui/floating_point.h"
@@ -13,6 +15,7 @@
 #include "flutter/lib/ui/painting/paint.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/platform_configuration.h"
+#include "third_party/tonic/typed_data/dart_byte_data.h"
 
 using tonic::ToDart;
 
@@ -643,6 +646,213 @@ void Canvas::drawShadow(const CanvasPath* path,
   }
 }
 
+namespace {
+
+// The commands of a batch. Must be kept in sync with _CanvasCommand in
+// painting.dart.
+enum class CanvasCommand : uint32_t {
+  kSave,
+  kRestore,
+  kTranslate,
+  kScale,
+  kRotate,
+  kClipRect,
+  kDrawLine,
+  kDrawRect,
+  kDrawRRect,
+  kDrawOval,
+  kDrawCircle,
+};
+
+// Reads the 32-bit values of a batch of commands. Reading past the end of the
+// batch returns zeroes and marks the batch as malformed.
+class CanvasCommandReader {
+ public:
+  explicit CanvasCommandReader(const std::vector<uint8_t>& commands)
+      : position_(commands.data()), end_(position_ + commands.size()) {}
+
+  bool HasMore() const { return is_valid_ && position_ < end_; }
+
+  bool is_valid() const { return is_valid_; }
+
+  // The next |size| bytes, or nullptr if the batch is shorter.
+  const uint8_t* ReadBytes(size_t size) {
+    if (static_cast<size_t>(end_ - position_) < size) {
+      is_valid_ = false;
+      return nullptr;
+    }
+    const uint8_t* bytes = position_;
+    position_ += size;
+    return bytes;
+  }
+
+  template <typename T>
+  T Read() {
+    static_assert(sizeof(T) == sizeof(uint32_t));
+    T value = {};
+    if (const uint8_t* bytes = ReadBytes(sizeof(T))) {
+      memcpy(&value, bytes, sizeof(T));
+    }
+    return value;
+  }
+
+  SkScalar ReadScalar() { return Read<float>(); }
+
+  SkPoint ReadPoint() {
+    SkScalar x = ReadScalar();
+    SkScalar y = ReadScalar();
+    return SkPoint::Make(x, y);
+  }
+
+  SkRect ReadRect() {
+    SkScalar left = ReadScalar();
+    SkScalar top = ReadScalar();
+    SkScalar right = ReadScalar();
+    SkScalar bottom = ReadScalar();
+    return SkRect::MakeLTRB(left, top, right, bottom);
+  }
+
+ private:
+  const uint8_t* position_;
+  const uint8_t* const end_;
+  bool is_valid_ = true;
+};
+
+}  // namespace
+
+void Canvas::drawCommands(Dart_Handle commands_handle,
+                          int length,
+                          Dart_Handle objects_handle) {
+  if (!display_list_builder_) {
+    return;
+  }
+  // The commands are copied out of their ByteData before any paint objects
+  // are unwrapped, which re-enters the VM.
+  std::vector<uint8_t> commands;
+  {
+    tonic::DartByteData byte_data(commands_handle);
+    if (length < 0 ||
+        static_cast<size_t>(length) > byte_data.length_in_bytes()) {
+      Dart_ThrowException(
+          ToDart("Canvas.drawCommands called with non-genuine commands."));
+      return;
+    }
+    const uint8_t* data = static_cast<const uint8_t*>(byte_data.data());
+    commands.assign(data, data + length);
+  }
+  intptr_t object_count = 0;
+  if (Dart_IsError(Dart_ListLength(objects_handle, &object_count))) {
+    return;
+  }
+
+  // Consecutive commands usually draw with the same paint, in which case the
+  // paint is only decoded once.
+  DlPaint paint;
+  const uint8_t* paint_data = nullptr;
+  int32_t paint_objects_index = -1;
+  bool is_valid = true;
+  auto read_paint = [&](CanvasCommandReader& reader) -> const DlPaint& {
+    int32_t objects_index = reader.Read<int32_t>();
+    const uint8_t* data = reader.ReadBytes(Paint::kDataByteCount);
+    if (!data || objects_index < -1 || objects_index >= object_count) {
+      is_valid = false;
+      return paint;
+    }
+    if (paint_data && objects_index == paint_objects_index &&
+        memcmp(data, paint_data, Paint::kDataByteCount) == 0) {
+      return paint;
+    }
+    Dart_Handle paint_objects = Dart_Null();
+    if (objects_index >= 0) {
+      paint_objects = Dart_ListGetAt(objects_handle, objects_index);
+      if (Dart_IsError(paint_objects)) {
+        is_valid = false;
+        return paint;
+      }
+    }
+    paint = DlPaint();
+    Paint::DecodeDlPaint(data, paint_objects, paint);
+    paint_data = data;
+    paint_objects_index = objects_index;
+    return paint;
+  };
+
+  CanvasCommandReader reader(commands);
+  while (reader.HasMore() && is_valid) {
+    switch (reader.Read<CanvasCommand>()) {
+      case CanvasCommand::kSave:
+        builder()->Save();
+        break;
+      case CanvasCommand::kRestore:
+        builder()->Restore();
+        break;
+      case CanvasCommand::kTranslate: {
+        SkScalar dx = reader.ReadScalar();
+        SkScalar dy = reader.ReadScalar();
+        builder()->Translate(dx, dy);
+        break;
+      }
+      case CanvasCommand::kScale: {
+        SkScalar sx = reader.ReadScalar();
+        SkScalar sy = reader.ReadScalar();
+        builder()->Scale(sx, sy);
+        break;
+      }
+      case CanvasCommand::kRotate:
+        builder()->Rotate(reader.ReadScalar() * 180.0f /
+                          static_cast<float>(M_PI));
+        break;
+      case CanvasCommand::kClipRect: {
+        SkRect rect = reader.ReadRect();
+        auto clip_op = static_cast<DlCanvas::ClipOp>(reader.Read<uint32_t>());
+        bool is_aa = reader.Read<uint32_t>() != 0;
+        builder()->ClipRect(rect, clip_op, is_aa);
+        break;
+      }
+      case CanvasCommand::kDrawLine: {
+        SkPoint p0 = reader.ReadPoint();
+        SkPoint p1 = reader.ReadPoint();
+        builder()->DrawLine(p0, p1, read_paint(reader));
+        break;
+      }
+      case CanvasCommand::kDrawRect: {
+        SkRect rect = reader.ReadRect();
+        builder()->DrawRect(rect, read_paint(reader));
+        break;
+      }
+      case CanvasCommand::kDrawRRect: {
+        SkRect rect = reader.ReadRect();
+        SkVector radii[4];
+        for (SkVector& radius : radii) {
+          radius = reader.ReadPoint();
+        }
+        SkRRect rrect;
+        rrect.setRectRadii(rect, radii);
+        builder()->DrawRRect(rrect, read_paint(reader));
+        break;
+      }
+      case CanvasCommand::kDrawOval: {
+        SkRect rect = reader.ReadRect();
+        builder()->DrawOval(rect, read_paint(reader));
+        break;
+      }
+      case CanvasCommand::kDrawCircle: {
+        SkPoint center = reader.ReadPoint();
+        SkScalar radius = reader.ReadScalar();
+        builder()->DrawCircle(center, radius, read_paint(reader));
+        break;
+      }
+      default:
+        is_valid = false;
+        break;
+    }
+  }
+  if (!is_valid || !reader.is_valid()) {
+    Dart_ThrowException(
+        ToDart("Canvas.drawCommands called with malformed commands."));
+  }
+}
+
 void Canvas::Invalidate() {
   display_list_builder_ = nullptr;
   if (dart_wrapper()) {
@@ -184,6 +184,13 @@ class Canvas : public RefCountedDartWrappable<Canvas>, DisplayListOpFlags {
                   double elevation,
                   bool transparentOccluder);
 
+  // Draws a batch of commands that a Canvas recorded in painting.dart. The
+  // commands are the first |length| bytes of the |commands_handle| ByteData,
+  // and the |objects_handle| list holds the paint objects they refer to.
+  void drawCommands(Dart_Handle commands_handle,
+                    int length,
+                    Dart_Handle objects_handle);
+
   void Invalidate();
 
   DisplayListBuilder* builder() { return display_list_builder_.get(); }
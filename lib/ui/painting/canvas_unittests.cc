@@ -0,0 +1,83 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/canvas.h"
+
+#include <memory>
+
+#include "flutter/common/task_runners.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/lib/ui/painting/picture.h"
+#include "flutter/shell/common/shell_test.h"
+#include "flutter/shell/common/thread_host.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+TEST_F(ShellTest, BatchedCanvasCommandsRecordTheSameDisplayList) {
+  auto message_latch = std::make_shared<fml::AutoResetWaitableEvent>();
+  sk_sp<DisplayList> display_list;
+
+  auto native_validate_picture = [message_latch,
+                                  &display_list](Dart_NativeArguments args) {
+    intptr_t peer = 0;
+    Dart_Handle result = Dart_GetNativeInstanceField(
+        Dart_GetNativeArgument(args, 0), tonic::DartWrappable::kPeerIndex,
+        &peer);
+    EXPECT_FALSE(Dart_IsError(result));
+    Picture* picture = reinterpret_cast<Picture*>(peer);
+    EXPECT_TRUE(picture);
+    display_list = picture->display_list();
+    message_latch->Signal();
+  };
+
+  Settings settings = CreateSettingsForFixture();
+  settings.batch_canvas_commands = true;
+  TaskRunners task_runners("test",                  // label
+                           GetCurrentTaskRunner(),  // platform
+                           CreateNewThread(),       // raster
+                           CreateNewThread(),       // ui
+                           CreateNewThread()        // io
+  );
+
+  AddNativeCallback("ValidateBatchedPicture",
+                    CREATE_NATIVE_ENTRY(native_validate_picture));
+
+  std::unique_ptr<Shell> shell = CreateShell(settings, task_runners);
+
+  ASSERT_TRUE(shell->IsSetup());
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("recordBatchedCanvasCommands");
+
+  shell->RunEngine(std::move(configuration), [](auto result) {
+    ASSERT_EQ(result, Engine::RunStatus::Success);
+  });
+
+  message_latch->Wait();
+  DestroyShell(std::move(shell), task_runners);
+
+  // The commands the fixture makes, in order. The drawColor command is not
+  // batched, so the commands before it must be drawn before it.
+  DisplayListBuilder builder;
+  // Paints in Dart are anti-aliased by default.
+  DlPaint green = DlPaint().setAntiAlias(true).setColor(DlColor(0xFF00FF00));
+  DlPaint blue = DlPaint().setAntiAlias(true).setColor(DlColor(0xFF0000FF));
+  builder.Save();
+  builder.Translate(10, 20);
+  builder.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), green);
+  builder.DrawRect(SkRect::MakeLTRB(10, 0, 20, 10), green);
+  builder.DrawCircle(SkPoint::Make(5, 5), 5, blue);
+  builder.DrawColor(DlColor(0xFFFF0000), DlBlendMode::kSrcOver);
+  builder.Restore();
+  builder.DrawRRect(SkRRect::MakeRectXY(SkRect::MakeLTRB(0, 0, 10, 10), 2, 2),
+                    blue);
+
+  ASSERT_TRUE(display_list);
+  EXPECT_TRUE(display_list->Equals(builder.Build()));
+}
+
+}  // namespace testing
+}  // namespace flutter
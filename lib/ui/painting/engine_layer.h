@@ -12,7 +12,7 @@ namespace flutter {
 
 class EngineLayer;
 
-class EngineLayer : public RefCountedDartWrappable<EngineLayer> {
+class EngineLayer : public PooledDartWrappable<EngineLayer> {
   DEFINE_WRAPPERTYPEINFO();
 
  public:
@@ -9,11 +9,15 @@
 #include "flutter/lib/ui/painting/fragment_program.h"
 
 #include "flutter/assets/asset_manager.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/impeller/runtime_stage/runtime_stage.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/platform_configuration.h"
+#if IMPELLER_SUPPORTS_RENDERING
+#include "impeller/entity/contents/runtime_effect_contents.h"  // nogncheck
+#endif  // IMPELLER_SUPPORTS_RENDERING
 
 #include "third_party/skia/include/core/SkString.h"
 #include "third_party/tonic/converter/dart_converter.h"
@@ -26,6 +30,31 @@ namespace flutter {
 
 IMPLEMENT_WRAPPERTYPEINFO(ui, FragmentProgram);
 
+#if IMPELLER_SUPPORTS_RENDERING
+// Compiles the shader and its most likely pipeline on a worker, so that the
+// first frame that draws with the program does not wait for it.
+static void PrewarmRuntimeStage(
+    std::shared_ptr<impeller::RuntimeStage> runtime_stage) {
+  const auto& task_runners = UIDartState::Current()->GetTaskRunners();
+  task_runners.GetIOTaskRunner()->PostTask(fml::MakeCopyable(
+      [runtime_stage = std::move(runtime_stage),
+       io_manager = UIDartState::Current()->GetIOManager(),
+       concurrent_task_runner =
+           UIDartState::Current()->GetConcurrentTaskRunner()]() mutable {
+        auto context = io_manager ? io_manager->GetImpellerContext() : nullptr;
+        if (!context || !concurrent_task_runner) {
+          return;
+        }
+        concurrent_task_runner->PostTask(
+            [runtime_stage = std::move(runtime_stage),
+             context = std::move(context)]() {
+              impeller::RuntimeEffectContents::Prewarm(*context,
+                                                       runtime_stage);
+            });
+      }));
+}
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 std::string FragmentProgram::initFromAsset(const std::string& asset_name) {
   FML_TRACE_EVENT("flutter", "FragmentProgram::initFromAsset", "asset",
                   asset_name);
@@ -56,8 +85,12 @@ std::string FragmentProgram::initFromAsset(const std::string& asset_name) {
   }
 
   if (UIDartState::Current()->IsImpellerEnabled()) {
-    runtime_effect_ = DlRuntimeEffect::MakeImpeller(
-        std::make_unique<impeller::RuntimeStage>(std::move(runtime_stage)));
+    auto impeller_runtime_stage =
+        std::make_shared<impeller::RuntimeStage>(std::move(runtime_stage));
+#if IMPELLER_SUPPORTS_RENDERING
+    PrewarmRuntimeStage(impeller_runtime_stage);
+#endif  // IMPELLER_SUPPORTS_RENDERING
+    runtime_effect_ = DlRuntimeEffect::MakeImpeller(impeller_runtime_stage);
   } else {
     const auto& code_mapping = runtime_stage.GetSkSLMapping();
     auto code_size = code_mapping->GetSize();
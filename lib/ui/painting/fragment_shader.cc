@@ -80,6 +80,7 @@ void ReusableFragmentShader::SetImageSampler(Dart_Handle index_handle,
 
   // TODO(115794): Once the DlImageSampling enum is replaced, expose the
   //               sampling options as a new default parameter for users.
+  last_source_.reset();
   samplers_[index] = std::make_shared<DlImageColorSource>(
       image->image(), DlTileMode::kClamp, DlTileMode::kClamp,
       DlImageSampling::kNearestNeighbor, nullptr);
@@ -97,6 +98,16 @@ std::shared_ptr<DlColorSource> ReusableFragmentShader::shader(
     DlImageSampling sampling) {
   FML_CHECK(program_);
 
+  // Shaders are usually painted again with the same uniforms, for example
+  // for every frame that only animates other parts of the scene. Returning
+  // the same source avoids a copy, and lets the display lists that draw it
+  // compare equal, as color sources compare their uniforms by identity.
+  if (last_source_ &&
+      memcmp(last_uniform_data_->data(), uniform_data_->bytes(),
+             last_uniform_data_->size()) == 0) {
+    return last_source_;
+  }
+
   // The lifetime of this object is longer than a frame, and the uniforms can be
   // continually changed on the UI thread. So we take a copy of the uniforms
   // before handing it to the DisplayList for consumption on the render thread.
@@ -104,10 +115,12 @@ std::shared_ptr<DlColorSource> ReusableFragmentShader::shader(
   uniform_data->resize(uniform_data_->size());
   memcpy(uniform_data->data(), uniform_data_->bytes(), uniform_data->size());
 
-  auto source = program_->MakeDlColorSource(std::move(uniform_data), samplers_);
+  auto source = program_->MakeDlColorSource(uniform_data, samplers_);
   // The samplers should have been checked as they were added, this
   // is a double-sanity-check.
   FML_DCHECK(source->isUIThreadSafe());
+  last_source_ = source;
+  last_uniform_data_ = std::move(uniform_data);
   return source;
 }
 
@@ -115,6 +128,8 @@ void ReusableFragmentShader::Dispose() {
   uniform_data_.reset();
   program_ = nullptr;
   samplers_.clear();
+  last_source_.reset();
+  last_uniform_data_.reset();
   ClearDartWrapper();
 }
 
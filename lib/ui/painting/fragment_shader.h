@@ -52,6 +52,11 @@ class ReusableFragmentShader : public Shader {
   sk_sp<SkData> uniform_data_;
   std::vector<std::shared_ptr<DlColorSource>> samplers_;
   size_t float_count_;
+
+  // The color source returned by the last call to |shader|, and the copy of
+  // the uniforms it was made with.
+  std::shared_ptr<DlColorSource> last_source_;
+  std::shared_ptr<std::vector<uint8_t>> last_uniform_data_;
 };
 
 }  // namespace flutter
@@ -4,6 +4,8 @@
 
 #include "flutter/lib/ui/painting/image_decoder.h"
 
+#include <algorithm>
+
 #include "flutter/lib/ui/painting/image_decoder_skia.h"
 
 #if IMPELLER_SUPPORTS_RENDERING
@@ -54,4 +56,108 @@ fml::WeakPtr<ImageDecoder> ImageDecoder::GetWeakPtr() const {
   return weak_factory_.GetWeakPtr();
 }
 
+bool ImageDecoder::PendingDecode::Matches(const ImageDescriptor& other,
+                                         uint32_t other_target_width,
+                                         uint32_t other_target_height) const {
+  if (target_width != other_target_width ||
+      target_height != other_target_height ||
+      is_compressed != other.is_compressed() ||
+      row_bytes != other.row_bytes() || region != other.region() ||
+      image_info != other.image_info()) {
+    return false;
+  }
+  sk_sp<SkData> other_data = other.data();
+  if (!data || !other_data) {
+    return false;
+  }
+  // Comparing the bytes only happens for data of the same size that is
+  // decoded to the same size, and is far cheaper than decoding it again.
+  return data == other_data || data->equals(other_data.get());
+}
+
+void ImageDecoder::Decode(fml::RefPtr<ImageDescriptor> descriptor,
+                          uint32_t target_width,
+                          uint32_t target_height,
+                          const ImageResult& result) {
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  if (!descriptor) {
+    DoDecode(std::move(descriptor), target_width, target_height, result);
+    return;
+  }
+
+  for (const auto& pending : in_flight_decodes_) {
+    if (pending->Matches(*descriptor, target_width, target_height)) {
+      pending->results.push_back(result);
+      return;
+    }
+  }
+  for (const auto& pending : queued_decodes_) {
+    if (pending->Matches(*descriptor, target_width, target_height)) {
+      pending->results.push_back(result);
+      return;
+    }
+  }
+
+  auto pending = std::make_shared<PendingDecode>();
+  pending->data = descriptor->data();
+  pending->image_info = descriptor->image_info();
+  pending->row_bytes = descriptor->row_bytes();
+  pending->is_compressed = descriptor->is_compressed();
+  pending->region = descriptor->region();
+  pending->target_width = target_width;
+  pending->target_height = target_height;
+  // The decoded image, and the image at its full size that it may be resized
+  // from.
+  pending->estimated_bytes =
+      descriptor->image_info().computeMinByteSize() +
+      static_cast<size_t>(target_width) * target_height *
+          std::max(descriptor->image_info().bytesPerPixel(), 4);
+  pending->descriptor = std::move(descriptor);
+  pending->results.push_back(result);
+
+  if (in_flight_decodes_.empty() ||
+      in_flight_bytes_ + pending->estimated_bytes <=
+          kInFlightDecodeBudgetBytes) {
+    StartDecode(pending);
+  } else {
+    queued_decodes_.push_back(std::move(pending));
+  }
+}
+
+void ImageDecoder::StartDecode(const std::shared_ptr<PendingDecode>& pending) {
+  in_flight_decodes_.push_back(pending);
+  in_flight_bytes_ += pending->estimated_bytes;
+  DoDecode(std::move(pending->descriptor), pending->target_width,
+           pending->target_height,
+           [decoder = GetWeakPtr(), pending](sk_sp<DlImage> image,
+                                             std::string decode_error) {
+             // Callbacks may start new decodes that must not share this one.
+             if (decoder) {
+               decoder->FinishDecode(pending);
+             }
+             for (const auto& result : pending->results) {
+               result(image, decode_error);
+             }
+           });
+}
+
+void ImageDecoder::FinishDecode(const std::shared_ptr<PendingDecode>& pending) {
+  auto found = std::find(in_flight_decodes_.begin(), in_flight_decodes_.end(),
+                         pending);
+  if (found == in_flight_decodes_.end()) {
+    return;
+  }
+  in_flight_decodes_.erase(found);
+  in_flight_bytes_ -= pending->estimated_bytes;
+
+  while (!queued_decodes_.empty() &&
+         (in_flight_decodes_.empty() ||
+          in_flight_bytes_ + queued_decodes_.front()->estimated_bytes <=
+              kInFlightDecodeBudgetBytes)) {
+    auto next = std::move(queued_decodes_.front());
+    queued_decodes_.pop_front();
+    StartDecode(next);
+  }
+}
+
 }  // namespace flutter
@@ -5,7 +5,10 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_H_
 
+#include <deque>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
@@ -39,13 +42,24 @@ class ImageDecoder {
   // concurrently. Texture upload is done on the IO thread and the result
   // returned back on the UI thread. On error, the texture is null but the
   // callback is guaranteed to return on the UI thread.
-  virtual void Decode(fml::RefPtr<ImageDescriptor> descriptor,
-                      uint32_t target_width,
-                      uint32_t target_height,
-                      const ImageResult& result) = 0;
+  //
+  // Requests for the same image data at the same target size that arrive
+  // while an earlier one is still pending share its decode and result. Decodes
+  // are started as long as the pixels they are estimated to allocate fit in
+  // |kInFlightDecodeBudgetBytes|, and the rest wait for earlier decodes to
+  // complete, in the order they were requested.
+  void Decode(fml::RefPtr<ImageDescriptor> descriptor,
+              uint32_t target_width,
+              uint32_t target_height,
+              const ImageResult& result);
 
   fml::WeakPtr<ImageDecoder> GetWeakPtr() const;
 
+  // The estimated number of bytes of pixels that decodes in flight may
+  // allocate at once. A single decode larger than this is still started once
+  // no other decode is in flight.
+  static constexpr size_t kInFlightDecodeBudgetBytes = 128 * 1024 * 1024;
+
  protected:
   TaskRunners runners_;
   std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
@@ -56,7 +70,42 @@ class ImageDecoder {
       std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
       fml::WeakPtr<IOManager> io_manager);
 
+  // Decodes the image described by |descriptor|, with the same contract as
+  // |Decode|. Called by |Decode| once per distinct pending request.
+  virtual void DoDecode(fml::RefPtr<ImageDescriptor> descriptor,
+                        uint32_t target_width,
+                        uint32_t target_height,
+                        const ImageResult& result) = 0;
+
  private:
+  // A request that is queued or in flight, with the callbacks of every
+  // request that shares it. The descriptor is only kept until the decode
+  // starts, as it must be collected on the UI thread and the last reference
+  // to a pending decode may be dropped on a worker.
+  struct PendingDecode {
+    sk_sp<SkData> data;
+    SkImageInfo image_info;
+    int row_bytes;
+    bool is_compressed;
+    std::optional<SkIRect> region;
+    uint32_t target_width;
+    uint32_t target_height;
+    size_t estimated_bytes;
+    fml::RefPtr<ImageDescriptor> descriptor;
+    std::vector<ImageResult> results;
+
+    bool Matches(const ImageDescriptor& other,
+                 uint32_t other_target_width,
+                 uint32_t other_target_height) const;
+  };
+
+  void StartDecode(const std::shared_ptr<PendingDecode>& pending);
+
+  void FinishDecode(const std::shared_ptr<PendingDecode>& pending);
+
+  std::vector<std::shared_ptr<PendingDecode>> in_flight_decodes_;
+  std::deque<std::shared_ptr<PendingDecode>> queued_decodes_;
+  size_t in_flight_bytes_ = 0;
   fml::WeakPtrFactory<ImageDecoder> weak_factory_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ImageDecoder);
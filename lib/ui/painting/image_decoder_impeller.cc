@@ -12,11 +12,19 @@
 #include "flutter/impeller/core/allocator.h"
 #include "flutter/impeller/core/texture.h"
 #include "flutter/impeller/display_list/dl_image_impeller.h"
+#include "flutter/impeller/entity/contents/filters/yuv_to_rgb_filter_contents.h"
 #include "flutter/impeller/renderer/command_buffer.h"
 #include "flutter/impeller/renderer/context.h"
+#include "flutter/impeller/renderer/pipeline_library.h"
+#include "flutter/impeller/renderer/render_pass.h"
+#include "flutter/impeller/renderer/render_target.h"
+#include "flutter/impeller/renderer/sampler_library.h"
+#include "flutter/impeller/renderer/vertex_buffer_builder.h"
 #include "flutter/lib/ui/painting/image_decoder_skia.h"
 #include "impeller/base/strings.h"
 #include "impeller/display_list/skia_conversions.h"
+#include "impeller/entity/yuv_to_rgb_filter.frag.h"
+#include "impeller/entity/yuv_to_rgb_filter.vert.h"
 #include "impeller/geometry/size.h"
 #include "third_party/skia/include/core/SkAlphaType.h"
 #include "third_party/skia/include/core/SkBitmap.h"
@@ -29,6 +37,7 @@
 #include "third_party/skia/include/core/SkPoint.h"
 #include "third_party/skia/include/core/SkSamplingOptions.h"
 #include "third_party/skia/include/core/SkSize.h"
+#include "third_party/skia/include/core/SkYUVAPixmaps.h"
 
 namespace flutter {
 
@@ -68,6 +77,21 @@ static constexpr bool kShouldUseMallocDeviceBuffer = true;
 static constexpr bool kShouldUseMallocDeviceBuffer = false;
 #endif  // FML_OS_ANDROID
 
+static std::shared_ptr<impeller::DeviceBuffer> CreateHostVisibleBuffer(
+    const std::shared_ptr<impeller::Allocator>& allocator,
+    size_t size) {
+  impeller::DeviceBufferDescriptor descriptor;
+  descriptor.storage_mode = impeller::StorageMode::kHostVisible;
+  descriptor.size = size;
+  return kShouldUseMallocDeviceBuffer
+             ? std::make_shared<MallocDeviceBuffer>(descriptor)
+             : allocator->CreateBuffer(descriptor);
+}
+
+using YUVToRGBPipeline =
+    impeller::RenderPipelineT<impeller::YuvToRgbFilterVertexShader,
+                              impeller::YuvToRgbFilterFragmentShader>;
+
 namespace {
 /**
  *  Loads the gamut as a set of three points (triangle).
@@ -208,12 +232,22 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
     return DecompressResult{.decode_error = decode_error};
   }
 
+  // Unless the decoded image is already the target size, it is only an
+  // intermediate for the resize below, and the resized image is the one that
+  // needs a device buffer. Keep the intermediate on the heap so that a decode
+  // for a small target doesn't hold two device buffers at once.
+  const bool needs_resize = image_info.dimensions() != target_size;
+
   auto bitmap = std::make_shared<SkBitmap>();
   bitmap->setInfo(image_info);
   auto bitmap_allocator = std::make_shared<ImpellerAllocator>(allocator);
+  auto try_alloc_pixels = [&bitmap, &bitmap_allocator, needs_resize]() {
+    return needs_resize ? bitmap->tryAllocPixels()
+                        : bitmap->tryAllocPixels(bitmap_allocator.get());
+  };
 
   if (descriptor->is_compressed()) {
-    if (!bitmap->tryAllocPixels(bitmap_allocator.get())) {
+    if (!try_alloc_pixels()) {
       std::string decode_error(
           "Could not allocate intermediate for image decompression.");
       FML_DLOG(ERROR) << decode_error;
@@ -232,7 +266,7 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
         base_image_info, descriptor->row_bytes(), descriptor->data());
     temp_bitmap->setPixelRef(pixel_ref, 0, 0);
 
-    if (!bitmap->tryAllocPixels(bitmap_allocator.get())) {
+    if (!try_alloc_pixels()) {
       std::string decode_error(
           "Could not allocate intermediate for pixel conversion.");
       FML_DLOG(ERROR) << decode_error;
@@ -242,7 +276,7 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
     bitmap->setImmutable();
   }
 
-  if (bitmap->dimensions() == target_size) {
+  if (!needs_resize) {
     auto buffer = bitmap_allocator->GetDeviceBuffer();
     if (!buffer) {
       return DecompressResult{.decode_error = "Unable to get device buffer"};
@@ -284,6 +318,301 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
                           .image_info = scaled_bitmap->info()};
 }
 
+bool ImageDecoderImpeller::SupportsYUVTextures(
+    const impeller::Context& context) {
+  // The OpenGL ES backend has no mapping for single and two channel pixel
+  // formats, so it fails to create the textures of the planes.
+  return context.GetBackendType() !=
+         impeller::Context::BackendType::kOpenGLES;
+}
+
+std::optional<DecompressYUVResult> ImageDecoderImpeller::DecompressYUVTexture(
+    ImageDescriptor* descriptor,
+    SkISize target_size,
+    impeller::ISize max_texture_size,
+    bool supports_wide_gamut,
+    const std::shared_ptr<impeller::Allocator>& allocator) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  // Codecs only decode planes at full scale, and the planes of wide gamut
+  // images would lose precision at 8 bits per channel.
+  const SkImageInfo& image_info = descriptor->image_info();
+  if (!descriptor->is_compressed() ||
+      image_info.dimensions() != target_size ||
+      image_info.width() > max_texture_size.width ||
+      image_info.height() > max_texture_size.height ||
+      (supports_wide_gamut && IsWideGamut(image_info.colorSpace()))) {
+    return std::nullopt;
+  }
+
+  SkYUVAPixmapInfo::SupportedDataTypes supported_data_types;
+  supported_data_types.enableDataType(SkYUVAPixmapInfo::DataType::kUnorm8, 1);
+  SkYUVAPixmapInfo pixmap_info;
+  if (!descriptor->query_yuva_info(supported_data_types, &pixmap_info) ||
+      pixmap_info.yuvaInfo().planeConfig() !=
+          SkYUVAInfo::PlaneConfig::kY_U_V) {
+    return std::nullopt;
+  }
+
+  impeller::YUVColorSpace yuv_color_space;
+  switch (pixmap_info.yuvaInfo().yuvColorSpace()) {
+    case kJPEG_Full_SkYUVColorSpace:
+      yuv_color_space = impeller::YUVColorSpace::kBT601FullRange;
+      break;
+    case kRec601_Limited_SkYUVColorSpace:
+      yuv_color_space = impeller::YUVColorSpace::kBT601LimitedRange;
+      break;
+    default:
+      return std::nullopt;
+  }
+
+  const SkImageInfo& y_info = pixmap_info.planeInfo(0);
+  const SkImageInfo& u_info = pixmap_info.planeInfo(1);
+  const SkImageInfo& v_info = pixmap_info.planeInfo(2);
+  if (u_info.dimensions() != v_info.dimensions()) {
+    return std::nullopt;
+  }
+  const size_t chroma_plane_size = u_info.computeMinByteSize();
+
+  // The luma plane is decoded straight into the buffer it is uploaded from.
+  // The shader samples both chroma planes from one texture, so they are
+  // decoded next to each other and then interleaved.
+  auto y_buffer =
+      CreateHostVisibleBuffer(allocator, y_info.computeMinByteSize());
+  auto uv_buffer = CreateHostVisibleBuffer(allocator, chroma_plane_size * 2);
+  if (!y_buffer || !uv_buffer) {
+    FML_DLOG(ERROR) << "Could not allocate buffers for the YUV planes.";
+    return std::nullopt;
+  }
+  std::vector<uint8_t> chroma_planes(chroma_plane_size * 2);
+  const SkPixmap plane_pixmaps[SkYUVAInfo::kMaxPlanes] = {
+      SkPixmap(y_info, y_buffer->OnGetContents(), y_info.minRowBytes()),
+      SkPixmap(u_info, chroma_planes.data(), u_info.minRowBytes()),
+      SkPixmap(v_info, chroma_planes.data() + chroma_plane_size,
+               v_info.minRowBytes()),
+  };
+  const auto yuva_pixmaps = SkYUVAPixmaps::FromExternalPixmaps(
+      pixmap_info.yuvaInfo(), plane_pixmaps);
+  if (!yuva_pixmaps.isValid() || !descriptor->get_yuva_planes(yuva_pixmaps)) {
+    FML_DLOG(ERROR) << "Could not decompress image into YUV planes.";
+    return std::nullopt;
+  }
+
+  const uint8_t* u_plane = chroma_planes.data();
+  const uint8_t* v_plane = chroma_planes.data() + chroma_plane_size;
+  uint8_t* uv_plane = uv_buffer->OnGetContents();
+  for (size_t i = 0; i < chroma_plane_size; i++) {
+    uv_plane[i * 2] = u_plane[i];
+    uv_plane[i * 2 + 1] = v_plane[i];
+  }
+  y_buffer->Flush();
+  uv_buffer->Flush();
+
+  return DecompressYUVResult{
+      .y_buffer = std::move(y_buffer),
+      .y_size = {y_info.width(), y_info.height()},
+      .uv_buffer = std::move(uv_buffer),
+      .uv_size = {u_info.width(), u_info.height()},
+      .yuv_color_space = yuv_color_space,
+  };
+}
+
+static std::shared_ptr<impeller::Texture> CreatePlaneTexture(
+    const std::shared_ptr<impeller::Context>& context,
+    const std::shared_ptr<impeller::DeviceBuffer>& buffer,
+    impeller::ISize size,
+    impeller::PixelFormat format,
+    impeller::BlitPass* blit_pass) {
+  impeller::TextureDescriptor texture_descriptor;
+  texture_descriptor.storage_mode = impeller::StorageMode::kDevicePrivate;
+  texture_descriptor.format = format;
+  texture_descriptor.size = size;
+  texture_descriptor.mip_count = 1;
+
+  auto texture =
+      context->GetResourceAllocator()->CreateTexture(texture_descriptor);
+  if (!texture) {
+    return nullptr;
+  }
+  if (blit_pass) {
+    blit_pass->AddCopy(buffer->AsBufferView(), texture);
+    return texture;
+  }
+  auto mapping = std::make_shared<fml::NonOwnedMapping>(
+      buffer->OnGetContents(),                          // data
+      texture_descriptor.GetByteSizeOfBaseMipLevel(),   // size
+      [buffer](auto, auto) mutable { buffer.reset(); }  // proc
+  );
+  if (!texture->SetContents(mapping)) {
+    return nullptr;
+  }
+  return texture;
+}
+
+/// Only call this method if the GPU is available.
+static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadYUVTexture(
+    const std::shared_ptr<impeller::Context>& context,
+    const DecompressYUVResult& planes) {
+  using VS = YUVToRGBPipeline::VertexShader;
+  using FS = YUVToRGBPipeline::FragmentShader;
+
+  // The quad covers every pixel of the single sampled target exactly once.
+  auto pipeline_desc =
+      YUVToRGBPipeline::Builder::MakeDefaultPipelineDescriptor(*context);
+  if (pipeline_desc.has_value()) {
+    pipeline_desc->SetSampleCount(impeller::SampleCount::kCount1);
+    pipeline_desc->SetPrimitiveType(impeller::PrimitiveType::kTriangleStrip);
+    pipeline_desc->ClearStencilAttachments();
+    auto color0_desc = *pipeline_desc->GetColorAttachmentDescriptor(0u);
+    color0_desc.blending_enabled = false;
+    pipeline_desc->SetColorAttachmentDescriptor(0u, color0_desc);
+  }
+  auto pipeline =
+      context->GetPipelineLibrary()->GetPipeline(pipeline_desc).Get();
+  if (!pipeline) {
+    std::string decode_error("Could not create the YUV to RGB pipeline.");
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+
+  auto command_buffer = context->CreateCommandBuffer();
+  if (!command_buffer) {
+    std::string decode_error(
+        "Could not create command buffer for YUV conversion.");
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+  command_buffer->SetLabel("YUV Conversion Command Buffer");
+
+  std::shared_ptr<impeller::BlitPass> upload_pass;
+  if (!kShouldUseMallocDeviceBuffer &&
+      context->GetCapabilities()->SupportsBufferToTextureBlits()) {
+    upload_pass = command_buffer->CreateBlitPass();
+    if (!upload_pass) {
+      std::string decode_error("Could not create blit pass for YUV planes.");
+      FML_DLOG(ERROR) << decode_error;
+      return std::make_pair(nullptr, decode_error);
+    }
+    upload_pass->SetLabel("YUV Upload Blit Pass");
+  }
+  auto y_texture = CreatePlaneTexture(context, planes.y_buffer, planes.y_size,
+                                      impeller::PixelFormat::kR8UNormInt,
+                                      upload_pass.get());
+  auto uv_texture = CreatePlaneTexture(
+      context, planes.uv_buffer, planes.uv_size,
+      impeller::PixelFormat::kR8G8UNormInt, upload_pass.get());
+  if (!y_texture || !uv_texture) {
+    std::string decode_error("Could not upload YUV planes.");
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+  if (upload_pass) {
+    upload_pass->EncodeCommands(context->GetResourceAllocator());
+  }
+
+  impeller::TextureDescriptor texture_descriptor;
+  texture_descriptor.storage_mode = impeller::StorageMode::kDevicePrivate;
+  texture_descriptor.format =
+      pipeline_desc->GetColorAttachmentDescriptor(0u)->format;
+  texture_descriptor.size = planes.y_size;
+  texture_descriptor.mip_count = texture_descriptor.size.MipCount();
+  texture_descriptor.usage =
+      static_cast<uint64_t>(impeller::TextureUsage::kRenderTarget) |
+      static_cast<uint64_t>(impeller::TextureUsage::kShaderRead);
+  auto dest_texture =
+      context->GetResourceAllocator()->CreateTexture(texture_descriptor);
+  if (!dest_texture) {
+    std::string decode_error("Could not create Impeller texture.");
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+  dest_texture->SetLabel(
+      impeller::SPrintF("ui.Image(%p)", dest_texture.get()).c_str());
+
+  impeller::ColorAttachment color0;
+  color0.texture = dest_texture;
+  color0.load_action = impeller::LoadAction::kDontCare;
+  color0.store_action = impeller::StoreAction::kStore;
+  impeller::RenderTarget render_target;
+  render_target.SetColorAttachment(color0, 0u);
+
+  auto render_pass = command_buffer->CreateRenderPass(render_target);
+  if (!render_pass || !render_pass->IsValid()) {
+    std::string decode_error("Could not create render pass for YUV planes.");
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+  render_pass->SetLabel("YUV Conversion Render Pass");
+
+  impeller::Command cmd;
+  DEBUG_COMMAND_INFO(cmd, "YUV to RGB");
+  cmd.pipeline = std::move(pipeline);
+
+  impeller::VertexBufferBuilder<VS::PerVertexData> vtx_builder;
+  vtx_builder.AddVertices({
+      {impeller::Point(0, 0)},
+      {impeller::Point(1, 0)},
+      {impeller::Point(0, 1)},
+      {impeller::Point(1, 1)},
+  });
+  auto& host_buffer = render_pass->GetTransientsBuffer();
+  cmd.BindVertices(vtx_builder.CreateVertexBuffer(host_buffer));
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp =
+      impeller::Matrix::MakeOrthographic(planes.y_size) *
+      impeller::Matrix::MakeScale(impeller::Vector2(planes.y_size));
+  frame_info.texture_sampler_y_coord_scale = y_texture->GetYCoordScale();
+
+  FS::FragInfo frag_info;
+  frag_info.yuv_color_space =
+      static_cast<impeller::Scalar>(planes.yuv_color_space);
+  frag_info.matrix = impeller::YUVToRGBFilterContents::GetYUVToRGBMatrix(
+      planes.yuv_color_space);
+
+  auto sampler = context->GetSamplerLibrary()->GetSampler({});
+  FS::BindYTexture(cmd, y_texture, sampler);
+  FS::BindUvTexture(cmd, uv_texture, sampler);
+  FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+  VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+
+  if (!render_pass->AddCommand(std::move(cmd)) ||
+      !render_pass->EncodeCommands()) {
+    std::string decode_error("Could not encode the YUV conversion.");
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+
+  // The mip levels are generated when the image is first drawn, see
+  // |RenderPass::AddCommand|.
+  if (!command_buffer->SubmitCommands()) {
+    std::string decode_error(
+        "Failed to submit YUV conversion command buffer.");
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+
+  return std::make_pair(
+      impeller::DlImageImpeller::Make(std::move(dest_texture)), std::string());
+}
+
+std::pair<sk_sp<DlImage>, std::string> ImageDecoderImpeller::UploadYUVTexture(
+    const std::shared_ptr<impeller::Context>& context,
+    const DecompressYUVResult& planes,
+    const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (!context) {
+    return std::make_pair(nullptr, "No Impeller context is available");
+  }
+
+  std::pair<sk_sp<DlImage>, std::string> result =
+      std::make_pair(nullptr, "The GPU is disabled");
+  gpu_disabled_switch->Execute(
+      fml::SyncSwitch::Handlers().SetIfFalse([&result, &context, &planes] {
+        result = UnsafeUploadYUVTexture(context, planes);
+      }));
+  return result;
+}
+
 /// Only call this method if the GPU is available.
 static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadTextureToPrivate(
     const std::shared_ptr<impeller::Context>& context,
@@ -318,25 +647,26 @@ static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadTextureToPrivate(
 
   auto command_buffer = context->CreateCommandBuffer();
   if (!command_buffer) {
-    std::string decode_error(
-        "Could not create command buffer for mipmap generation.");
+    std::string decode_error("Could not create command buffer for upload.");
     FML_DLOG(ERROR) << decode_error;
     return std::make_pair(nullptr, decode_error);
   }
-  command_buffer->SetLabel("Mipmap Command Buffer");
+  command_buffer->SetLabel("Upload Command Buffer");
+  // The destination texture was just created, so the upload does not need to
+  // be ordered after any rendering and may use a dedicated transfer queue.
+  command_buffer->SetIsUploadOnly(true);
 
   auto blit_pass = command_buffer->CreateBlitPass();
   if (!blit_pass) {
-    std::string decode_error(
-        "Could not create blit pass for mipmap generation.");
+    std::string decode_error("Could not create blit pass for upload.");
     FML_DLOG(ERROR) << decode_error;
     return std::make_pair(nullptr, decode_error);
   }
-  blit_pass->SetLabel("Mipmap Blit Pass");
+  blit_pass->SetLabel("Upload Blit Pass");
+  // Only the base level is uploaded. The other mip levels are generated when
+  // the image is first drawn, see |RenderPass::AddCommand|, so images that
+  // are decoded but never drawn don't pay for them.
   blit_pass->AddCopy(buffer->AsBufferView(), dest_texture);
-  if (texture_descriptor.size.MipCount() > 1) {
-    blit_pass->GenerateMipmap(dest_texture);
-  }
 
   blit_pass->EncodeCommands(context->GetResourceAllocator());
   if (!command_buffer->SubmitCommands()) {
@@ -474,11 +804,102 @@ ImageDecoderImpeller::UploadTextureToStorage(
                         std::string());
 }
 
+static impeller::PixelFormat ToPixelFormat(
+    ImageGenerator::BlockCompressedData::Format format) {
+  switch (format) {
+    case ImageGenerator::BlockCompressedData::Format::kASTC4x4:
+      return impeller::PixelFormat::kASTC4x4UNormInt;
+    case ImageGenerator::BlockCompressedData::Format::kETC2RGBA8:
+      return impeller::PixelFormat::kETC2R8G8B8A8UNormInt;
+    case ImageGenerator::BlockCompressedData::Format::kBC7:
+      return impeller::PixelFormat::kBC7UNormInt;
+  }
+  FML_UNREACHABLE();
+}
+
+std::pair<sk_sp<DlImage>, std::string>
+ImageDecoderImpeller::UploadBlockCompressedTexture(
+    const std::shared_ptr<impeller::Context>& context,
+    const ImageGenerator::BlockCompressedData& data,
+    SkISize target_size) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (!context) {
+    return std::make_pair(nullptr, "No Impeller context is available");
+  }
+  const auto pixel_format = ToPixelFormat(data.format);
+  if (!context->GetCapabilities()->SupportsBlockCompressedFormat(
+          pixel_format)) {
+    std::string decode_error(impeller::SPrintF(
+        "The device does not support the block compression format of this "
+        "image (%s)",
+        impeller::PixelFormatToString(pixel_format)));
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+  if (data.levels.empty()) {
+    return std::make_pair(nullptr, "The image has no block compressed data");
+  }
+
+  // Levels get smaller, so the last one that still covers the target size is
+  // the smallest that does, and also has to fit the largest texture size.
+  const auto max_size =
+      context->GetResourceAllocator()->GetMaxTextureSizeSupported();
+  const ImageGenerator::BlockCompressedData::Level* level = nullptr;
+  for (const auto& candidate : data.levels) {
+    const bool fits = candidate.size.width() <= max_size.width &&
+                      candidate.size.height() <= max_size.height;
+    const bool covers_target = candidate.size.width() >= target_size.width() &&
+                               candidate.size.height() >= target_size.height();
+    if (fits && (covers_target || !level)) {
+      level = &candidate;
+    }
+    if (!covers_target && level) {
+      break;
+    }
+  }
+  if (!level) {
+    std::string decode_error(impeller::SPrintF(
+        "Image %dx%d is larger than the maximum texture size",
+        data.levels.front().size.width(), data.levels.front().size.height()));
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+
+  impeller::TextureDescriptor texture_descriptor;
+  texture_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
+  texture_descriptor.format = pixel_format;
+  texture_descriptor.size = {level->size.width(), level->size.height()};
+  texture_descriptor.mip_count = 1;
+
+  auto texture =
+      context->GetResourceAllocator()->CreateTexture(texture_descriptor);
+  if (!texture) {
+    std::string decode_error("Could not create Impeller texture.");
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+
+  auto mapping = std::make_shared<fml::NonOwnedMapping>(
+      level->data->bytes(),                                       // data
+      level->data->size(),                                        // size
+      [data = level->data](auto, auto) mutable { data.reset(); }  // proc
+  );
+  if (!texture->SetContents(mapping)) {
+    std::string decode_error("Could not copy contents into Impeller texture.");
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+
+  texture->SetLabel(impeller::SPrintF("ui.Image(%p)", texture.get()).c_str());
+  return std::make_pair(impeller::DlImageImpeller::Make(std::move(texture)),
+                        std::string());
+}
+
 // |ImageDecoder|
-void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
-                                  uint32_t target_width,
-                                  uint32_t target_height,
-                                  const ImageResult& p_result) {
+void ImageDecoderImpeller::DoDecode(fml::RefPtr<ImageDescriptor> descriptor,
+                                    uint32_t target_width,
+                                    uint32_t target_height,
+                                    const ImageResult& p_result) {
   FML_DCHECK(descriptor);
   FML_DCHECK(p_result);
 
@@ -500,6 +921,7 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
        context = context_.get(),                                  //
        target_size = SkISize::Make(target_width, target_height),  //
        io_runner = runners_.GetIOTaskRunner(),                    //
+       concurrent_task_runner = concurrent_task_runner_,          //
        result,
        supports_wide_gamut = supports_wide_gamut_,  //
        gpu_disabled_switch = gpu_disabled_switch_]() {
@@ -507,41 +929,87 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
           result(nullptr, "No Impeller context is available");
           return;
         }
+        if (raw_descriptor->block_compressed_data()) {
+          // Block compressed data is uploaded as is, so there is nothing to
+          // decompress, but uploads are still serialized on the IO runner.
+          io_runner->PostTask([result, context, raw_descriptor, target_size]() {
+            sk_sp<DlImage> image;
+            std::string decode_error;
+            std::tie(image, decode_error) = UploadBlockCompressedTexture(
+                context, *raw_descriptor->block_compressed_data(), target_size);
+            result(image, decode_error);
+          });
+          return;
+        }
+
         auto max_size_supported =
             context->GetResourceAllocator()->GetMaxTextureSizeSupported();
 
-        // Always decompress on the concurrent runner.
-        auto bitmap_result = DecompressTexture(
-            raw_descriptor, target_size, max_size_supported,
-            supports_wide_gamut, context->GetResourceAllocator());
-        if (!bitmap_result.device_buffer) {
-          result(nullptr, bitmap_result.decode_error);
+        auto decode_and_upload = [raw_descriptor, context, target_size,
+                                  io_runner, result, supports_wide_gamut,
+                                  gpu_disabled_switch, max_size_supported]() {
+          // Always decompress on the concurrent runner.
+          auto bitmap_result = DecompressTexture(
+              raw_descriptor, target_size, max_size_supported,
+              supports_wide_gamut, context->GetResourceAllocator());
+          if (!bitmap_result.device_buffer) {
+            result(nullptr, bitmap_result.decode_error);
+            return;
+          }
+          auto upload_texture_and_invoke_result = [result, context,
+                                                   bitmap_result,
+                                                   gpu_disabled_switch]() {
+            sk_sp<DlImage> image;
+            std::string decode_error;
+            if (!kShouldUseMallocDeviceBuffer &&
+                context->GetCapabilities()->SupportsBufferToTextureBlits()) {
+              std::tie(image, decode_error) = UploadTextureToPrivate(
+                  context, bitmap_result.device_buffer,
+                  bitmap_result.image_info, bitmap_result.sk_bitmap,
+                  gpu_disabled_switch);
+              result(image, decode_error);
+            } else {
+              std::tie(image, decode_error) = UploadTextureToStorage(
+                  context, bitmap_result.sk_bitmap, gpu_disabled_switch,
+                  impeller::StorageMode::kDevicePrivate,
+                  /*create_mips=*/true);
+              result(image, decode_error);
+            }
+          };
+          // TODO(jonahwilliams):
+          // https://github.com/flutter/flutter/issues/123058 Technically we
+          // don't need to post tasks to the io runner, but without this
+          // forced serialization we can end up overloading the GPU and/or
+          // competing with raster workloads.
+          io_runner->PostTask(upload_texture_and_invoke_result);
+        };
+
+        // Images that the codec can decode into YUV planes, such as most
+        // JPEGs, are uploaded as planes and converted to RGBA on the GPU.
+        std::optional<DecompressYUVResult> yuv_result;
+        if (SupportsYUVTextures(*context)) {
+          yuv_result = DecompressYUVTexture(
+              raw_descriptor, target_size, max_size_supported,
+              supports_wide_gamut, context->GetResourceAllocator());
+        }
+        if (!yuv_result.has_value()) {
+          decode_and_upload();
           return;
         }
-        auto upload_texture_and_invoke_result = [result, context, bitmap_result,
-                                                 gpu_disabled_switch]() {
-          sk_sp<DlImage> image;
-          std::string decode_error;
-          if (!kShouldUseMallocDeviceBuffer &&
-              context->GetCapabilities()->SupportsBufferToTextureBlits()) {
-            std::tie(image, decode_error) = UploadTextureToPrivate(
-                context, bitmap_result.device_buffer, bitmap_result.image_info,
-                bitmap_result.sk_bitmap, gpu_disabled_switch);
-            result(image, decode_error);
-          } else {
-            std::tie(image, decode_error) = UploadTextureToStorage(
-                context, bitmap_result.sk_bitmap, gpu_disabled_switch,
-                impeller::StorageMode::kDevicePrivate,
-                /*create_mips=*/true);
+        io_runner->PostTask([result, context, planes = yuv_result.value(),
+                             gpu_disabled_switch, concurrent_task_runner,
+                             decode_and_upload]() {
+          auto [image, decode_error] =
+              UploadYUVTexture(context, planes, gpu_disabled_switch);
+          if (image) {
             result(image, decode_error);
+            return;
           }
-        };
-        // TODO(jonahwilliams):
-        // https://github.com/flutter/flutter/issues/123058 Technically we
-        // don't need to post tasks to the io runner, but without this
-        // forced serialization we can end up overloading the GPU and/or
-        // competing with raster workloads.
-        io_runner->PostTask(upload_texture_and_invoke_result);
+          // The planes can't be converted while the GPU is disabled, so the
+          // image is decoded again into a bitmap that can be uploaded
+          // without it.
+          concurrent_task_runner->PostTask(decode_and_upload);
+        });
       });
 }
 
@@ -561,15 +1029,10 @@ bool ImpellerAllocator::allocPixelRef(SkBitmap* bitmap) {
     return false;
   }
 
-  impeller::DeviceBufferDescriptor descriptor;
-  descriptor.storage_mode = impeller::StorageMode::kHostVisible;
-  descriptor.size = ((bitmap->height() - 1) * bitmap->rowBytes()) +
-                    (bitmap->width() * bitmap->bytesPerPixel());
-
   std::shared_ptr<impeller::DeviceBuffer> device_buffer =
-      kShouldUseMallocDeviceBuffer
-          ? std::make_shared<MallocDeviceBuffer>(descriptor)
-          : allocator_->CreateBuffer(descriptor);
+      CreateHostVisibleBuffer(
+          allocator_, ((bitmap->height() - 1) * bitmap->rowBytes()) +
+                          (bitmap->width() * bitmap->bytesPerPixel()));
 
   struct ImpellerPixelRef final : public SkPixelRef {
     ImpellerPixelRef(int w, int h, void* s, size_t r)
@@ -6,10 +6,12 @@
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_IMPELLER_H_
 
 #include <future>
+#include <optional>
 
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/painting/image_decoder.h"
 #include "impeller/core/formats.h"
+#include "impeller/geometry/color.h"
 #include "impeller/geometry/size.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 
@@ -44,6 +46,16 @@ struct DecompressResult {
   std::string decode_error;
 };
 
+/// The luma and interleaved chroma planes of an image, which are converted
+/// to RGB on the GPU after they are uploaded.
+struct DecompressYUVResult {
+  std::shared_ptr<impeller::DeviceBuffer> y_buffer;
+  impeller::ISize y_size;
+  std::shared_ptr<impeller::DeviceBuffer> uv_buffer;
+  impeller::ISize uv_size;
+  impeller::YUVColorSpace yuv_color_space;
+};
+
 class ImageDecoderImpeller final : public ImageDecoder {
  public:
   ImageDecoderImpeller(
@@ -55,12 +67,6 @@ class ImageDecoderImpeller final : public ImageDecoder {
 
   ~ImageDecoderImpeller() override;
 
-  // |ImageDecoder|
-  void Decode(fml::RefPtr<ImageDescriptor> descriptor,
-              uint32_t target_width,
-              uint32_t target_height,
-              const ImageResult& result) override;
-
   static DecompressResult DecompressTexture(
       ImageDescriptor* descriptor,
       SkISize target_size,
@@ -68,6 +74,37 @@ class ImageDecoderImpeller final : public ImageDecoder {
       bool supports_wide_gamut,
       const std::shared_ptr<impeller::Allocator>& allocator);
 
+  /// @brief Whether `context` can create the R8 and RG8 textures that the
+  ///        planes of a YUV image are uploaded to. When it can't, images
+  ///        should not be decoded with `DecompressYUVTexture`.
+  static bool SupportsYUVTextures(const impeller::Context& context);
+
+  /// @brief Decode an image into YUV planes instead of RGBA, which takes less
+  ///        than half the memory and upload bandwidth for JPEGs.
+  /// @return The planes, or nothing if the image can't be decoded to YUV
+  ///         planes at |target_size|, in which case `DecompressTexture`
+  ///         should be used.
+  static std::optional<DecompressYUVResult> DecompressYUVTexture(
+      ImageDescriptor* descriptor,
+      SkISize target_size,
+      impeller::ISize max_texture_size,
+      bool supports_wide_gamut,
+      const std::shared_ptr<impeller::Allocator>& allocator);
+
+  /// @brief Upload the planes of a YUV image and convert them into an RGBA
+  ///        texture on the GPU.
+  /// @param context     The Impeller graphics context.
+  /// @param planes      The planes returned by `DecompressYUVTexture`.
+  /// @param gpu_disabled_switch Whether the GPU is available for the
+  ///        conversion.
+  /// @return            A DlImage, or null if the GPU is disabled or the
+  ///                    conversion failed, in which case the image should be
+  ///                    decoded with `DecompressTexture` instead.
+  static std::pair<sk_sp<DlImage>, std::string> UploadYUVTexture(
+      const std::shared_ptr<impeller::Context>& context,
+      const DecompressYUVResult& planes,
+      const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch);
+
   /// @brief Create a device private texture from the provided host buffer.
   ///        This method is only suported on the metal backend.
   /// @param context    The Impeller graphics context.
@@ -98,7 +135,27 @@ class ImageDecoderImpeller final : public ImageDecoder {
       impeller::StorageMode storage_mode,
       bool create_mips = true);
 
+  /// @brief Create a texture from image data that is already block
+  ///        compressed, without decoding it.
+  /// @param context     The Impeller graphics context.
+  /// @param data        The block compressed mip levels of the image.
+  /// @param target_size The size the image is decoded at. The smallest level
+  ///                    that is at least this large is uploaded, as block
+  ///                    compressed data can't be resized.
+  /// @return            A DlImage, or an error if the device doesn't support
+  ///                    the block compression format of the data.
+  static std::pair<sk_sp<DlImage>, std::string> UploadBlockCompressedTexture(
+      const std::shared_ptr<impeller::Context>& context,
+      const ImageGenerator::BlockCompressedData& data,
+      SkISize target_size);
+
  private:
+  // |ImageDecoder|
+  void DoDecode(fml::RefPtr<ImageDescriptor> descriptor,
+                uint32_t target_width,
+                uint32_t target_height,
+                const ImageResult& result) override;
+
   using FutureContext = std::shared_future<std::shared_ptr<impeller::Context>>;
   FutureContext context_;
   const bool supports_wide_gamut_;
@@ -71,7 +71,11 @@ class TestImpellerAllocator : public impeller::Allocator {
 
   ~TestImpellerAllocator() = default;
 
+  size_t GetBufferCount() const { return buffer_count_; }
+
  private:
+  size_t buffer_count_ = 0;
+
   uint16_t MinimumBytesPerRow(PixelFormat format) const override { return 0; }
 
   ISize GetMaxTextureSizeSupported() const override {
@@ -80,6 +84,7 @@ class TestImpellerAllocator : public impeller::Allocator {
 
   std::shared_ptr<DeviceBuffer> OnCreateBuffer(
       const DeviceBufferDescriptor& desc) override {
+    buffer_count_++;
     return std::make_shared<TestImpellerDeviceBuffer>(desc);
   }
 
@@ -217,10 +217,11 @@ static SkiaGPUObject<SkImage> UploadRasterImage(
 }
 
 // |ImageDecoder|
-void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
-                              uint32_t target_width,
-                              uint32_t target_height,
-                              const ImageResult& callback) {
+void ImageDecoderSkia::DoDecode(
+    fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
+    uint32_t target_width,
+    uint32_t target_height,
+    const ImageResult& callback) {
   TRACE_EVENT0("flutter", __FUNCTION__);
   fml::tracing::TraceFlow flow(__FUNCTION__);
 
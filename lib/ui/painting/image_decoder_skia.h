@@ -19,12 +19,6 @@ class ImageDecoderSkia final : public ImageDecoder {
 
   ~ImageDecoderSkia() override;
 
-  // |ImageDecoder|
-  void Decode(fml::RefPtr<ImageDescriptor> descriptor,
-              uint32_t target_width,
-              uint32_t target_height,
-              const ImageResult& result) override;
-
   static sk_sp<SkImage> ImageFromCompressedData(
       ImageDescriptor* descriptor,
       uint32_t target_width,
@@ -32,6 +26,12 @@ class ImageDecoderSkia final : public ImageDecoder {
       const fml::tracing::TraceFlow& flow);
 
  private:
+  // |ImageDecoder|
+  void DoDecode(fml::RefPtr<ImageDescriptor> descriptor,
+                uint32_t target_width,
+                uint32_t target_height,
+                const ImageResult& result) override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(ImageDecoderSkia);
 };
 
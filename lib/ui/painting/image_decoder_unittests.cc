@@ -4,10 +4,12 @@
 
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/impeller/core/allocator.h"
 #include "flutter/impeller/core/device_buffer.h"
 #include "flutter/impeller/geometry/size.h"
+#include "flutter/impeller/renderer/capabilities.h"
 #include "flutter/impeller/renderer/context.h"
 #include "flutter/lib/ui/painting/image_decoder.h"
 #include "flutter/lib/ui/painting/image_decoder_impeller.h"
@@ -37,9 +39,12 @@ namespace impeller {
 
 class TestImpellerContext : public impeller::Context {
  public:
-  TestImpellerContext() = default;
+  explicit TestImpellerContext(
+      std::shared_ptr<const Capabilities> capabilities = nullptr,
+      BackendType backend_type = BackendType::kMetal)
+      : capabilities_(std::move(capabilities)), backend_type_(backend_type) {}
 
-  BackendType GetBackendType() const override { return BackendType::kMetal; }
+  BackendType GetBackendType() const override { return backend_type_; }
 
   std::string DescribeGpuModel() const override { return "TestGpu"; }
 
@@ -76,6 +81,7 @@ class TestImpellerContext : public impeller::Context {
 
  private:
   std::shared_ptr<const Capabilities> capabilities_;
+  BackendType backend_type_;
 };
 
 }  // namespace impeller
@@ -369,6 +375,30 @@ TEST_F(ImageDecoderFixtureTest, ImpellerNullColorspace) {
 #endif  // IMPELLER_SUPPORTS_RENDERING
 }
 
+TEST_F(ImageDecoderFixtureTest, ImpellerResizeAllocatesOneDeviceBuffer) {
+  auto info = SkImageInfo::Make(10, 10, SkColorType::kRGBA_8888_SkColorType,
+                                SkAlphaType::kPremul_SkAlphaType);
+  SkBitmap bitmap;
+  bitmap.allocPixels(info, 10 * 4);
+  auto data = SkData::MakeWithoutCopy(bitmap.getPixels(), 10 * 10 * 4);
+  auto descriptor =
+      fml::MakeRefCounted<ImageDescriptor>(std::move(data), info, 10 * 4);
+
+#if IMPELLER_SUPPORTS_RENDERING
+  auto allocator = std::make_shared<impeller::TestImpellerAllocator>();
+  std::optional<DecompressResult> decompressed =
+      ImageDecoderImpeller::DecompressTexture(
+          descriptor.get(), SkISize::Make(5, 5), {100, 100},
+          /*supports_wide_gamut=*/false, allocator);
+
+  ASSERT_TRUE(decompressed.has_value());
+  ASSERT_TRUE(decompressed->device_buffer);
+  EXPECT_EQ(decompressed->image_info.dimensions(), SkISize::Make(5, 5));
+  // The full size intermediate is not allocated from the device.
+  EXPECT_EQ(allocator->GetBufferCount(), 1u);
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
 TEST_F(ImageDecoderFixtureTest, ImpellerPixelConversion32F) {
   auto info = SkImageInfo::Make(10, 10, SkColorType::kRGBA_F32_SkColorType,
                                 SkAlphaType::kUnpremul_SkAlphaType);
@@ -476,6 +506,63 @@ TEST_F(ImageDecoderFixtureTest, ImpellerNonWideGamut) {
 #endif  // IMPELLER_SUPPORTS_RENDERING
 }
 
+TEST_F(ImageDecoderFixtureTest, ImpellerDecodesJPEGsToYUVPlanes) {
+#if IMPELLER_SUPPORTS_RENDERING
+  std::shared_ptr<impeller::Allocator> allocator =
+      std::make_shared<impeller::TestImpellerAllocator>();
+  ImageGeneratorRegistry registry;
+  auto make_descriptor = [&registry](const char* fixture) {
+    auto data = flutter::testing::OpenFixtureAsSkData(fixture);
+    std::shared_ptr<ImageGenerator> generator =
+        registry.CreateCompatibleGenerator(data);
+    return fml::MakeRefCounted<ImageDescriptor>(std::move(data),
+                                                std::move(generator));
+  };
+
+  auto descriptor = make_descriptor("DashInNooglerHat.jpg");
+  const SkISize size = descriptor->image_info().dimensions();
+  std::optional<DecompressYUVResult> result =
+      ImageDecoderImpeller::DecompressYUVTexture(
+          descriptor.get(), size, {size.width(), size.height()},
+          /*supports_wide_gamut=*/false, allocator);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->y_size, impeller::ISize(3024, 4032));
+  EXPECT_EQ(result->uv_size, impeller::ISize(1512, 2016));
+  EXPECT_EQ(result->yuv_color_space, impeller::YUVColorSpace::kBT601FullRange);
+
+  // Planes are only decoded at full scale.
+  EXPECT_FALSE(ImageDecoderImpeller::DecompressYUVTexture(
+                   descriptor.get(), SkISize::Make(100, 100), {4096, 4096},
+                   /*supports_wide_gamut=*/false, allocator)
+                   .has_value());
+
+  // The planes of this image would need to be rotated.
+  auto rotated = make_descriptor("Horizontal.jpg");
+  EXPECT_FALSE(ImageDecoderImpeller::DecompressYUVTexture(
+                   rotated.get(), SkISize::Make(600, 200), {600, 200},
+                   /*supports_wide_gamut=*/false, allocator)
+                   .has_value());
+
+  auto wide_gamut = make_descriptor("DisplayP3Logo.jpg");
+  EXPECT_FALSE(ImageDecoderImpeller::DecompressYUVTexture(
+                   wide_gamut.get(), SkISize::Make(100, 100), {100, 100},
+                   /*supports_wide_gamut=*/true, allocator)
+                   .has_value());
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+TEST_F(ImageDecoderFixtureTest, ImpellerOnlyUsesYUVPlanesWithR8Textures) {
+#if IMPELLER_SUPPORTS_RENDERING
+  using BackendType = impeller::Context::BackendType;
+  EXPECT_TRUE(ImageDecoderImpeller::SupportsYUVTextures(
+      impeller::TestImpellerContext(nullptr, BackendType::kMetal)));
+  EXPECT_TRUE(ImageDecoderImpeller::SupportsYUVTextures(
+      impeller::TestImpellerContext(nullptr, BackendType::kVulkan)));
+  EXPECT_FALSE(ImageDecoderImpeller::SupportsYUVTextures(
+      impeller::TestImpellerContext(nullptr, BackendType::kOpenGLES)));
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
 TEST_F(ImageDecoderFixtureTest, ExifDataIsRespectedOnDecode) {
   auto loop = fml::ConcurrentMessageLoop::Create();
   TaskRunners runners(GetCurrentTestName(),         // label
@@ -673,6 +760,63 @@ TEST_F(ImageDecoderFixtureTest, CanDecodeWithResizes) {
   PostTaskSync(runners.GetUITaskRunner(), [&]() { image_decoder.reset(); });
 }
 
+TEST_F(ImageDecoderFixtureTest, SharesDecodesOfTheSameImageAndSize) {
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  TaskRunners runners(GetCurrentTestName(),         // label
+                      CreateNewThread("platform"),  // platform
+                      CreateNewThread("raster"),    // raster
+                      CreateNewThread("ui"),        // ui
+                      CreateNewThread("io")         // io
+  );
+
+  fml::CountDownLatch latch(3);
+  std::unique_ptr<IOManager> io_manager;
+  std::unique_ptr<ImageDecoder> image_decoder;
+  std::vector<sk_sp<DlImage>> images(3);
+
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() {
+    io_manager = std::make_unique<TestIOManager>(runners.GetIOTaskRunner());
+  });
+
+  PostTaskSync(runners.GetUITaskRunner(), [&]() {
+    Settings settings;
+    image_decoder = ImageDecoder::Make(settings, runners, loop->GetTaskRunner(),
+                                       io_manager->GetWeakIOManager(),
+                                       std::make_shared<fml::SyncSwitch>());
+
+    // Every descriptor has a copy of the data of its own, as images that are
+    // loaded more than once would.
+    const uint32_t target_sizes[] = {100, 100, 50};
+    for (size_t i = 0; i < images.size(); i++) {
+      auto data = flutter::testing::OpenFixtureAsSkData("DashInNooglerHat.jpg");
+      ASSERT_TRUE(data);
+      ImageGeneratorRegistry registry;
+      std::shared_ptr<ImageGenerator> generator =
+          registry.CreateCompatibleGenerator(data);
+      ASSERT_TRUE(generator);
+      auto descriptor = fml::MakeRefCounted<ImageDescriptor>(
+          std::move(data), std::move(generator));
+      image_decoder->Decode(
+          descriptor, target_sizes[i], target_sizes[i],
+          [&, i](const sk_sp<DlImage>& image, const std::string& decode_error) {
+            ASSERT_TRUE(runners.GetUITaskRunner()->RunsTasksOnCurrentThread());
+            images[i] = image;
+            latch.CountDown();
+          });
+    }
+  });
+  latch.Wait();
+
+  ASSERT_TRUE(images[0] && images[2]);
+  EXPECT_EQ(images[0], images[1]);
+  EXPECT_NE(images[0], images[2]);
+  EXPECT_EQ(images[2]->dimensions(), SkISize::Make(50, 50));
+
+  images.clear();
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() { io_manager.reset(); });
+  PostTaskSync(runners.GetUITaskRunner(), [&]() { image_decoder.reset(); });
+}
+
 // Verifies https://skia-review.googlesource.com/c/skia/+/259161 is present in
 // Flutter.
 TEST(ImageDecoderTest,
@@ -752,6 +896,205 @@ TEST(ImageDecoderTest, ImagesWithTransparencyArePremulAlpha) {
   ASSERT_EQ(compressed_image->alphaType(), kPremul_SkAlphaType);
 }
 
+namespace {
+
+// Whether |image| has the pixels of |subset| of |full_image|.
+bool IsSubsetOf(const sk_sp<SkImage>& image,
+                const sk_sp<SkImage>& full_image,
+                const SkIRect& subset) {
+  SkBitmap expected;
+  expected.allocPixels(image->imageInfo());
+  SkBitmap actual;
+  actual.allocPixels(image->imageInfo());
+  if (!full_image->readPixels(expected.pixmap(), subset.left(),
+                              subset.top()) ||
+      !image->readPixels(actual.pixmap(), 0, 0)) {
+    return false;
+  }
+  for (int y = 0; y < subset.height(); y++) {
+    if (memcmp(expected.getAddr(0, y), actual.getAddr(0, y),
+               subset.width() * expected.bytesPerPixel()) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST(ImageDecoderTest, SubsetImageGeneratorDecodesTheRegion) {
+  auto data = flutter::testing::OpenFixtureAsSkData("heart_end.png");
+  ASSERT_TRUE(data);
+  ImageGeneratorRegistry registry;
+  auto full_image = registry.CreateCompatibleGenerator(data)->GetImage();
+  ASSERT_TRUE(full_image);
+
+  const SkIRect subset = SkIRect::MakeLTRB(30, 40, 130, 90);
+  SubsetImageGenerator generator(registry.CreateCompatibleGenerator(data),
+                                 subset);
+  EXPECT_EQ(generator.GetFrameCount(), 1u);
+  EXPECT_EQ(generator.GetInfo().dimensions(), SkISize::Make(100, 50));
+
+  auto image = generator.GetImage();
+  ASSERT_TRUE(image);
+  EXPECT_TRUE(IsSubsetOf(image, full_image, subset));
+}
+
+TEST(ImageDecoderTest, SubsetImageGeneratorRespectsExifOrientation) {
+  auto data = flutter::testing::OpenFixtureAsSkData("Horizontal.jpg");
+  ASSERT_TRUE(data);
+  ImageGeneratorRegistry registry;
+  auto full_image = registry.CreateCompatibleGenerator(data)->GetImage();
+  ASSERT_TRUE(full_image);
+
+  // The region is in the oriented 600x200 image, not the encoded 200x600 one.
+  const SkIRect subset = SkIRect::MakeLTRB(400, 50, 600, 200);
+  SubsetImageGenerator generator(registry.CreateCompatibleGenerator(data),
+                                 subset);
+  auto image = generator.GetImage();
+  ASSERT_TRUE(image);
+  EXPECT_EQ(image->dimensions(), SkISize::Make(200, 150));
+  EXPECT_TRUE(IsSubsetOf(image, full_image, subset));
+}
+
+TEST(ImageDecoderTest, SubsetImageGeneratorDecodesScaledRegions) {
+  auto data = flutter::testing::OpenFixtureAsSkData("DashInNooglerHat.jpg");
+  ASSERT_TRUE(data);
+  ImageGeneratorRegistry registry;
+  SubsetImageGenerator generator(registry.CreateCompatibleGenerator(data),
+                                 SkIRect::MakeLTRB(0, 0, 400, 200));
+
+  const SkISize scaled_size = generator.GetScaledDimensions(0.25);
+  EXPECT_LT(scaled_size.width(), 400);
+  EXPECT_LT(scaled_size.height(), 200);
+
+  SkBitmap bitmap;
+  bitmap.allocPixels(generator.GetInfo().makeDimensions(scaled_size));
+  EXPECT_TRUE(generator.GetPixels(bitmap.info(), bitmap.getPixels(),
+                                  bitmap.rowBytes()));
+}
+
+namespace {
+
+void AppendLittleEndian(std::vector<uint8_t>& bytes,
+                        uint64_t value,
+                        size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    bytes.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+// A KTX2 file of |width| by |height| ASTC 4x4 blocks, with all its mip levels.
+sk_sp<SkData> MakeASTCKTX2Data(uint32_t width,
+                               uint32_t height,
+                               uint32_t supercompression_scheme = 0) {
+  // The byte offset and length of every level.
+  std::vector<std::pair<uint64_t, uint64_t>> levels;
+  uint32_t level_width = width;
+  uint32_t level_height = height;
+  while (true) {
+    levels.push_back({0, ((level_width + 3) / 4) * ((level_height + 3) / 4) *
+                             16});
+    if (level_width == 1 && level_height == 1) {
+      break;
+    }
+    level_width = std::max(level_width / 2, 1u);
+    level_height = std::max(level_height / 2, 1u);
+  }
+
+  std::vector<uint8_t> bytes = {0xAB, 'K',  'T',  'X', ' ',  '2',
+                                '0',  0xBB, '\r', '\n', 0x1A, '\n'};
+  for (uint32_t field : {157u, 1u, width, height, 0u, 0u, 1u,
+                         static_cast<uint32_t>(levels.size()),
+                         supercompression_scheme}) {
+    AppendLittleEndian(bytes, field, 4);
+  }
+  // The data format descriptor, key/value data and supercompression global
+  // data aren't read.
+  bytes.resize(bytes.size() + 32, 0);
+  uint64_t offset = bytes.size() + levels.size() * 24;
+  for (auto& [level_offset, length] : levels) {
+    level_offset = offset;
+    offset += length;
+    AppendLittleEndian(bytes, level_offset, 8);
+    AppendLittleEndian(bytes, length, 8);
+    AppendLittleEndian(bytes, 0, 8);
+  }
+  bytes.resize(offset, 0x55);
+  return SkData::MakeWithCopy(bytes.data(), bytes.size());
+}
+
+}  // namespace
+
+TEST(ImageDecoderTest, KTX2ImageGeneratorReadsBlockCompressedLevels) {
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(MakeASTCKTX2Data(8, 4));
+  ASSERT_TRUE(generator);
+  EXPECT_EQ(generator->GetInfo().dimensions(), SkISize::Make(8, 4));
+
+  const auto* data = generator->GetBlockCompressedData();
+  ASSERT_TRUE(data);
+  EXPECT_EQ(data->format,
+            ImageGenerator::BlockCompressedData::Format::kASTC4x4);
+  ASSERT_EQ(data->levels.size(), 4u);
+  EXPECT_EQ(data->levels[0].size, SkISize::Make(8, 4));
+  EXPECT_EQ(data->levels[0].data->size(), 32u);
+  EXPECT_EQ(data->levels[3].size, SkISize::Make(1, 1));
+  EXPECT_EQ(data->levels[3].data->size(), 16u);
+
+  // The blocks can only be sampled from on GPUs, not decoded.
+  SkBitmap bitmap;
+  bitmap.allocPixels(generator->GetInfo());
+  EXPECT_FALSE(generator->GetPixels(bitmap.info(), bitmap.getPixels(),
+                                    bitmap.rowBytes()));
+}
+
+TEST(ImageDecoderTest, KTX2ImageGeneratorRejectsSupercompressedData) {
+  ImageGeneratorRegistry registry;
+  EXPECT_FALSE(registry.CreateCompatibleGenerator(
+      MakeASTCKTX2Data(8, 8, /*supercompression_scheme=*/1)));
+
+  // Data that is cut short is rejected too.
+  sk_sp<SkData> data = MakeASTCKTX2Data(8, 8);
+  EXPECT_FALSE(registry.CreateCompatibleGenerator(
+      SkData::MakeSubset(data.get(), 0, data->size() - 1)));
+}
+
+TEST(ImageDecoderTest, ImpellerUploadsTheSmallestBlockCompressedLevelNeeded) {
+#if !IMPELLER_SUPPORTS_RENDERING
+  GTEST_SKIP() << "Impeller only test.";
+#else
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(MakeASTCKTX2Data(16, 16));
+  ASSERT_TRUE(generator && generator->GetBlockCompressedData());
+
+  auto context = std::make_shared<impeller::TestImpellerContext>(
+      impeller::CapabilitiesBuilder()
+          .SetSupportsBlockCompressedFormat(
+              impeller::PixelFormat::kASTC4x4UNormInt, true)
+          .Build());
+  auto result = ImageDecoderImpeller::UploadBlockCompressedTexture(
+      context, *generator->GetBlockCompressedData(), SkISize::Make(5, 3));
+  ASSERT_TRUE(result.first) << result.second;
+  EXPECT_EQ(result.first->dimensions(), SkISize::Make(8, 8));
+
+  result = ImageDecoderImpeller::UploadBlockCompressedTexture(
+      context, *generator->GetBlockCompressedData(), SkISize::Make(32, 32));
+  ASSERT_TRUE(result.first) << result.second;
+  EXPECT_EQ(result.first->dimensions(), SkISize::Make(16, 16));
+
+  auto unsupported_context = std::make_shared<impeller::TestImpellerContext>(
+      impeller::CapabilitiesBuilder().Build());
+  result = ImageDecoderImpeller::UploadBlockCompressedTexture(
+      unsupported_context, *generator->GetBlockCompressedData(),
+      SkISize::Make(16, 16));
+  EXPECT_FALSE(result.first);
+  EXPECT_NE(result.second, "");
+#endif  // !IMPELLER_SUPPORTS_RENDERING
+}
+
 TEST(ImageDecoderTest, VerifySubpixelDecodingPreservesExifOrientation) {
   auto data = flutter::testing::OpenFixtureAsSkData("Horizontal.jpg");
 
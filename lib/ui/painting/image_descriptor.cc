@@ -121,6 +121,56 @@ void ImageDescriptor::instantiateCodec(Dart_Handle codec_handle,
   ui_codec->AssociateWithDartWrapper(codec_handle);
 }
 
+Dart_Handle ImageDescriptor::instantiateRegionCodec(Dart_Handle codec_handle,
+                                                    int left,
+                                                    int top,
+                                                    int right,
+                                                    int bottom,
+                                                    int target_width,
+                                                    int target_height) {
+  const SkIRect subset = SkIRect::MakeLTRB(left, top, right, bottom);
+  if (subset.isEmpty() ||
+      !SkIRect::MakeSize(image_info_.dimensions()).contains(subset)) {
+    return tonic::ToDart("Region must be non-empty and within the image");
+  }
+  if (!buffer_) {
+    return tonic::ToDart("Image descriptor has been disposed");
+  }
+
+  fml::RefPtr<ImageDescriptor> region_descriptor;
+  if (generator_) {
+    // Generators can't be shared between codecs that may decode in parallel,
+    // so each region gets a generator of its own.
+    auto registry = UIDartState::Current()->GetImageGeneratorRegistry();
+    std::shared_ptr<ImageGenerator> generator =
+        registry ? registry->CreateCompatibleGenerator(buffer_) : nullptr;
+    if (!generator) {
+      return tonic::ToDart("Invalid image data");
+    }
+    region_descriptor = fml::MakeRefCounted<ImageDescriptor>(
+        buffer_,
+        std::make_shared<SubsetImageGenerator>(std::move(generator), subset));
+    // The region descriptor shares the encoded data of the whole image, so
+    // the region is needed to tell its decodes apart from those of others.
+    region_descriptor->region_ = subset;
+  } else {
+    // Decoded pixels are cropped in place, by pointing at the first pixel of
+    // the region and keeping the row bytes of the whole image.
+    const size_t offset =
+        top * row_bytes() + left * image_info_.bytesPerPixel();
+    const size_t size = (subset.height() - 1) * row_bytes() +
+                        subset.width() * image_info_.bytesPerPixel();
+    region_descriptor = fml::MakeRefCounted<ImageDescriptor>(
+        SkData::MakeSubset(buffer_.get(), offset, size),
+        image_info_.makeDimensions(subset.size()), row_bytes());
+  }
+
+  auto ui_codec = fml::MakeRefCounted<SingleFrameCodec>(
+      std::move(region_descriptor), target_width, target_height);
+  ui_codec->AssociateWithDartWrapper(codec_handle);
+  return Dart_Null();
+}
+
 sk_sp<SkImage> ImageDescriptor::image() const {
   return generator_->GetImage();
 }
@@ -16,6 +16,7 @@
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
+#include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/core/SkPixmap.h"
 #include "third_party/skia/include/core/SkSize.h"
 #include "third_party/tonic/dart_library_natives.h"
@@ -62,6 +63,20 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   /// @brief  Associates a flutter::Codec object with the dart.ui Codec handle.
   void instantiateCodec(Dart_Handle codec, int target_width, int target_height);
 
+  /// @brief  Associates a flutter::Codec object that decodes only the region
+  ///         from `left`, `top` to `right`, `bottom` of this image, at
+  ///         `target_width` by `target_height`, with the dart.ui Codec
+  ///         handle. The region of an animated image is taken from its first
+  ///         frame.
+  /// @return An error string if the region could not be decoded, or null.
+  Dart_Handle instantiateRegionCodec(Dart_Handle codec,
+                                     int left,
+                                     int top,
+                                     int right,
+                                     int bottom,
+                                     int target_width,
+                                     int target_height);
+
   /// @brief  The width of this image, EXIF oriented if applicable.
   int width() const { return image_info_.width(); }
 
@@ -93,6 +108,11 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   ///         not.
   bool is_compressed() const { return !!generator_; }
 
+  /// @brief  The region of the encoded image that this descriptor decodes, if
+  ///         it was created for a region codec and decodes only part of the
+  ///         image in `data()`.
+  const std::optional<SkIRect>& region() const { return region_; }
+
   /// @brief  The orientation corrected image info for this image.
   const SkImageInfo& image_info() const { return image_info_; }
 
@@ -106,6 +126,29 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
     return image_info_.dimensions();
   }
 
+  /// @brief  Gets the image data in the GPU block compression format it is
+  ///         encoded in, if it doesn't need to be decoded before it is
+  ///         uploaded.
+  /// @see    `ImageGenerator::GetBlockCompressedData`
+  const ImageGenerator::BlockCompressedData* block_compressed_data() const {
+    return generator_ ? generator_->GetBlockCompressedData() : nullptr;
+  }
+
+  /// @brief  Queries whether this image can be decoded into YUV planes.
+  /// @see    `ImageGenerator::QueryYUVAInfo`
+  bool query_yuva_info(
+      const SkYUVAPixmapInfo::SupportedDataTypes& supported_data_types,
+      SkYUVAPixmapInfo* yuva_pixmap_info) const {
+    return generator_ &&
+           generator_->QueryYUVAInfo(supported_data_types, yuva_pixmap_info);
+  }
+
+  /// @brief  Decodes this image into YUV planes.
+  /// @see    `ImageGenerator::GetYUVAPlanes`
+  bool get_yuva_planes(const SkYUVAPixmaps& yuva_pixmaps) const {
+    return generator_ && generator_->GetYUVAPlanes(yuva_pixmaps);
+  }
+
   /// @brief  Gets pixels for this image transformed based on the EXIF
   ///         orientation tag, if applicable.
   bool get_pixels(const SkPixmap& pixmap) const;
@@ -127,6 +170,7 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   std::shared_ptr<ImageGenerator> generator_;
   const SkImageInfo image_info_;
   std::optional<size_t> row_bytes_;
+  std::optional<SkIRect> region_;
 
   const SkImageInfo CreateImageInfo() const;
 
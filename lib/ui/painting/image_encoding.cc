@@ -10,6 +10,7 @@
 
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/build_config.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/status_or.h"
 #include "flutter/fml/trace_event.h"
@@ -108,6 +109,7 @@ void EncodeImageAndInvokeDataCallback(
     const fml::RefPtr<fml::TaskRunner>& ui_task_runner,
     const fml::RefPtr<fml::TaskRunner>& raster_task_runner,
     const fml::RefPtr<fml::TaskRunner>& io_task_runner,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner,
     const fml::WeakPtr<GrDirectContext>& resource_context,
     const fml::TaskRunnerAffineWeakPtr<SnapshotDelegate>& snapshot_delegate,
     const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch,
@@ -122,14 +124,23 @@ void EncodeImageAndInvokeDataCallback(
   // EncodeImage.
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
   auto encode_task =
-      [callback_task = std::move(callback_task), format,
-       ui_task_runner](const fml::StatusOr<sk_sp<SkImage>>& raster_image) {
+      [callback_task = std::move(callback_task), format, ui_task_runner,
+       concurrent_task_runner](
+          const fml::StatusOr<sk_sp<SkImage>>& raster_image) {
         if (raster_image.ok()) {
-          sk_sp<SkData> encoded = EncodeImage(raster_image.value(), format);
-          ui_task_runner->PostTask([callback_task = callback_task,
-                                    encoded = std::move(encoded)]() mutable {
-            callback_task(std::move(encoded));
-          });
+          // Encoding a large image can take hundreds of milliseconds, which
+          // would hold up every other task on the IO thread. The raster image
+          // is immutable, so it is encoded on a worker instead.
+          concurrent_task_runner->PostTask(
+              [callback_task = callback_task, format, ui_task_runner,
+               raster_image = raster_image.value()]() {
+                sk_sp<SkData> encoded = EncodeImage(raster_image, format);
+                ui_task_runner->PostTask(
+                    [callback_task = callback_task,
+                     encoded = std::move(encoded)]() mutable {
+                      callback_task(std::move(encoded));
+                    });
+              });
         } else {
           ui_task_runner->PostTask([callback_task = callback_task,
                                     raster_image = raster_image]() mutable {
@@ -179,13 +190,15 @@ Dart_Handle EncodeImage(CanvasImage* canvas_image,
        image_format, ui_task_runner = task_runners.GetUITaskRunner(),
        raster_task_runner = task_runners.GetRasterTaskRunner(),
        io_task_runner = task_runners.GetIOTaskRunner(),
+       concurrent_task_runner =
+           UIDartState::Current()->GetConcurrentTaskRunner(),
        io_manager = UIDartState::Current()->GetIOManager(),
        snapshot_delegate = UIDartState::Current()->GetSnapshotDelegate(),
        is_impeller_enabled =
            UIDartState::Current()->IsImpellerEnabled()]() mutable {
         EncodeImageAndInvokeDataCallback(
             image, std::move(callback), image_format, ui_task_runner,
-            raster_task_runner, io_task_runner,
+            raster_task_runner, io_task_runner, concurrent_task_runner,
             io_manager->GetResourceContext(), snapshot_delegate,
             io_manager->GetIsGpuDisabledSyncSwitch(),
             io_manager->GetImpellerContext(), is_impeller_enabled);
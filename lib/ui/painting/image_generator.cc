@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/painting/image_generator.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "flutter/fml/logging.h"
@@ -11,11 +12,35 @@
 #include "third_party/skia/include/codec/SkPixmapUtils.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkRect.h"
+#include "third_party/skia/include/core/SkSamplingOptions.h"
 
 namespace flutter {
 
 ImageGenerator::~ImageGenerator() = default;
 
+bool ImageGenerator::GetSubsetPixels(const SkImageInfo& info,
+                                     void* pixels,
+                                     size_t row_bytes,
+                                     const SkIRect& subset) {
+  return false;
+}
+
+bool ImageGenerator::QueryYUVAInfo(
+    const SkYUVAPixmapInfo::SupportedDataTypes& supported_data_types,
+    SkYUVAPixmapInfo* yuva_pixmap_info) const {
+  return false;
+}
+
+bool ImageGenerator::GetYUVAPlanes(const SkYUVAPixmaps& yuva_pixmaps) {
+  return false;
+}
+
+const ImageGenerator::BlockCompressedData*
+ImageGenerator::GetBlockCompressedData() const {
+  return nullptr;
+}
+
 sk_sp<SkImage> ImageGenerator::GetImage() {
   SkImageInfo info = GetInfo();
 
@@ -188,6 +213,57 @@ bool BuiltinSkiaCodecImageGenerator::GetPixels(
   return SkPixmapUtils::Orient(output_pixmap, temp_pixmap, origin);
 }
 
+bool BuiltinSkiaCodecImageGenerator::GetSubsetPixels(
+    const SkImageInfo& info,
+    void* pixels,
+    size_t row_bytes,
+    const SkIRect& subset) {
+  // Codec subsets are in the encoded orientation.
+  if (codec_->getOrigin() != kTopLeft_SkEncodedOrigin ||
+      info.dimensions() != subset.size()) {
+    return false;
+  }
+
+  // Some codecs, such as WebP, decode subsets directly.
+  SkCodec::Options options;
+  options.fSubset = &subset;
+  if (codec_->getPixels(info, pixels, row_bytes, &options) ==
+      SkCodec::kSuccess) {
+    return true;
+  }
+
+  // Scanline decoders, such as JPEG, can decode a range of columns, and the
+  // rows above the subset are skipped without being written anywhere.
+  const SkIRect columns = SkIRect::MakeLTRB(subset.left(), 0, subset.right(),
+                                            codec_->dimensions().height());
+  SkCodec::Options scanline_options;
+  scanline_options.fSubset = &columns;
+  if (codec_->startScanlineDecode(info, &scanline_options) !=
+          SkCodec::kSuccess ||
+      codec_->getScanlineOrder() != SkCodec::kTopDown_SkScanlineOrder) {
+    return false;
+  }
+  return codec_->skipScanlines(subset.top()) &&
+         codec_->getScanlines(pixels, subset.height(), row_bytes) ==
+             subset.height();
+}
+
+bool BuiltinSkiaCodecImageGenerator::QueryYUVAInfo(
+    const SkYUVAPixmapInfo::SupportedDataTypes& supported_data_types,
+    SkYUVAPixmapInfo* yuva_pixmap_info) const {
+  // The planes are in the encoded orientation, and only hold the first frame.
+  if (codec_->getOrigin() != kTopLeft_SkEncodedOrigin ||
+      codec_->getFrameCount() > 1) {
+    return false;
+  }
+  return codec_->queryYUVAInfo(supported_data_types, yuva_pixmap_info);
+}
+
+bool BuiltinSkiaCodecImageGenerator::GetYUVAPlanes(
+    const SkYUVAPixmaps& yuva_pixmaps) {
+  return codec_->getYUVAPlanes(yuva_pixmaps) == SkCodec::kSuccess;
+}
+
 std::unique_ptr<ImageGenerator> BuiltinSkiaCodecImageGenerator::MakeFromData(
     sk_sp<SkData> data) {
   auto codec = SkCodec::MakeFromData(std::move(data));
@@ -197,4 +273,100 @@ std::unique_ptr<ImageGenerator> BuiltinSkiaCodecImageGenerator::MakeFromData(
   return std::make_unique<BuiltinSkiaCodecImageGenerator>(std::move(codec));
 }
 
+SubsetImageGenerator::~SubsetImageGenerator() = default;
+
+SubsetImageGenerator::SubsetImageGenerator(
+    std::shared_ptr<ImageGenerator> generator,
+    const SkIRect& subset)
+    : generator_(std::move(generator)), subset_(subset) {
+  FML_DCHECK(!subset_.isEmpty());
+  FML_DCHECK(SkIRect::MakeSize(generator_->GetInfo().dimensions())
+                 .contains(subset_));
+  image_info_ = generator_->GetInfo().makeDimensions(subset_.size());
+}
+
+const SkImageInfo& SubsetImageGenerator::GetInfo() {
+  return image_info_;
+}
+
+unsigned int SubsetImageGenerator::GetFrameCount() const {
+  return 1;
+}
+
+unsigned int SubsetImageGenerator::GetPlayCount() const {
+  return 1;
+}
+
+const ImageGenerator::FrameInfo SubsetImageGenerator::GetFrameInfo(
+    unsigned int frame_index) {
+  return {.required_frame = std::nullopt,
+          .duration = 0,
+          .disposal_method = SkCodecAnimation::DisposalMethod::kKeep};
+}
+
+SkISize SubsetImageGenerator::GetScaledDimensions(float desired_scale) {
+  if (desired_scale >= 1) {
+    return subset_.size();
+  }
+  return ScaleSubset(generator_->GetScaledDimensions(desired_scale)).size();
+}
+
+bool SubsetImageGenerator::GetPixels(const SkImageInfo& info,
+                                     void* pixels,
+                                     size_t row_bytes,
+                                     unsigned int frame_index,
+                                     std::optional<unsigned int> prior_frame) {
+  if (info.dimensions() == subset_.size() &&
+      generator_->GetSubsetPixels(info, pixels, row_bytes, subset_)) {
+    return true;
+  }
+
+  const float scale =
+      std::max(static_cast<float>(info.width()) / subset_.width(),
+               static_cast<float>(info.height()) / subset_.height());
+  const SkISize decoded_size = scale < 1
+                                   ? generator_->GetScaledDimensions(scale)
+                                   : generator_->GetInfo().dimensions();
+  SkBitmap decoded;
+  if (!decoded.tryAllocPixels(info.makeDimensions(decoded_size))) {
+    FML_DLOG(ERROR) << "Failed to allocate memory for bitmap of size "
+                    << decoded.info().computeMinByteSize() << "B";
+    return false;
+  }
+  if (!generator_->GetPixels(decoded.info(), decoded.getPixels(),
+                             decoded.rowBytes())) {
+    return false;
+  }
+
+  SkPixmap decoded_subset;
+  if (!decoded.pixmap().extractSubset(&decoded_subset,
+                                      ScaleSubset(decoded_size))) {
+    return false;
+  }
+  SkPixmap output_pixmap(info, pixels, row_bytes);
+  if (decoded_subset.dimensions() == info.dimensions()) {
+    return decoded_subset.readPixels(output_pixmap);
+  }
+  return decoded_subset.scalePixels(
+      output_pixmap,
+      SkSamplingOptions(SkFilterMode::kLinear, SkMipmapMode::kNone));
+}
+
+SkIRect SubsetImageGenerator::ScaleSubset(SkISize decoded_size) const {
+  const SkISize full_size = generator_->GetInfo().dimensions();
+  const float scale_x = static_cast<float>(decoded_size.width()) /
+                        static_cast<float>(full_size.width());
+  const float scale_y = static_cast<float>(decoded_size.height()) /
+                        static_cast<float>(full_size.height());
+  SkIRect scaled = SkRect::MakeLTRB(subset_.left() * scale_x,
+                                    subset_.top() * scale_y,
+                                    subset_.right() * scale_x,
+                                    subset_.bottom() * scale_y)
+                       .roundOut();
+  if (!scaled.intersect(SkIRect::MakeSize(decoded_size))) {
+    return SkIRect::MakeSize(decoded_size);
+  }
+  return scaled;
+}
+
 }  // namespace flutter
@@ -5,7 +5,9 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_H_
 
+#include <memory>
 #include <optional>
+#include <vector>
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/codec/SkCodec.h"
 #include "third_party/skia/include/codec/SkCodecAnimation.h"
@@ -14,6 +16,7 @@
 #include "third_party/skia/include/core/SkImageGenerator.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkSize.h"
+#include "third_party/skia/include/core/SkYUVAPixmaps.h"
 
 namespace flutter {
 
@@ -135,6 +138,67 @@ class ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) = 0;
 
+  /// @brief      Decode the |subset| of the first frame of the image, at full
+  ///             scale, into a given buffer without decoding the rest of the
+  ///             image. Decoders that can't do this return false, and the
+  ///             caller decodes the whole image instead.
+  /// @param[in]  info       The color info of the decoded subset, with the
+  ///                        dimensions of |subset|.
+  /// @param[in]  pixels     The location where the decoded subset should be
+  ///                        written.
+  /// @param[in]  row_bytes  The number of bytes in a row of |pixels|.
+  /// @param[in]  subset     The region to decode, in the EXIF oriented
+  ///                        coordinates of `GetInfo`.
+  /// @return     True if the subset was decoded.
+  virtual bool GetSubsetPixels(const SkImageInfo& info,
+                               void* pixels,
+                               size_t row_bytes,
+                               const SkIRect& subset);
+
+  /// @brief      Queries whether the first frame of the image can be decoded
+  ///             at full scale into separate Y, U and V planes, so that the
+  ///             conversion to RGB can be left to the GPU.
+  /// @param[in]  supported_data_types  The plane formats the caller can use.
+  /// @param[out] yuva_pixmap_info      The layout of the planes to allocate
+  ///                                   for `GetYUVAPlanes`.
+  /// @return     True if the image can be decoded with `GetYUVAPlanes`.
+  virtual bool QueryYUVAInfo(
+      const SkYUVAPixmapInfo::SupportedDataTypes& supported_data_types,
+      SkYUVAPixmapInfo* yuva_pixmap_info) const;
+
+  /// @brief      Decodes the first frame of the image into the planes of
+  ///             |yuva_pixmaps|, which use a layout returned by
+  ///             `QueryYUVAInfo`.
+  /// @return     True if the planes were decoded.
+  virtual bool GetYUVAPlanes(const SkYUVAPixmaps& yuva_pixmaps);
+
+  /// @brief  Image data that is stored in a GPU block compression format,
+  ///         which GPUs that support the format can sample from as is.
+  struct BlockCompressedData {
+    enum class Format {
+      kASTC4x4,
+      kETC2RGBA8,
+      kBC7,
+    };
+
+    struct Level {
+      SkISize size;
+      sk_sp<SkData> data;
+    };
+
+    Format format;
+
+    /// The mip levels of the image, from the largest to the smallest.
+    std::vector<Level> levels;
+  };
+
+  /// @brief      Gets the image data in the GPU block compression format it
+  ///             is encoded in, for images that don't need to be decoded
+  ///             before they are uploaded.
+  /// @return     The block compressed data of the image, or null if the image
+  ///             is decoded using `GetPixels`.
+  virtual const BlockCompressedData* GetBlockCompressedData() const;
+
   /// @brief   Creates an `SkImage` based on the current `ImageInfo` of this
   ///          `ImageGenerator`.
   /// @return  A new `SkImage` containing the decoded image data.
@@ -212,6 +276,20 @@ class BuiltinSkiaCodecImageGenerator : public ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) override;
 
+  // |ImageGenerator|
+  bool GetSubsetPixels(const SkImageInfo& info,
+                       void* pixels,
+                       size_t row_bytes,
+                       const SkIRect& subset) override;
+
+  // |ImageGenerator|
+  bool QueryYUVAInfo(
+      const SkYUVAPixmapInfo::SupportedDataTypes& supported_data_types,
+      SkYUVAPixmapInfo* yuva_pixmap_info) const override;
+
+  // |ImageGenerator|
+  bool GetYUVAPlanes(const SkYUVAPixmaps& yuva_pixmaps) override;
+
   static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
 
  private:
@@ -220,6 +298,62 @@ class BuiltinSkiaCodecImageGenerator : public ImageGenerator {
   SkImageInfo image_info_;
 };
 
+/// @brief  Presents a region of the first frame of another generator's image
+///         as a single-frame image of its own, so that it can be decoded
+///         without producing the rest of the image.
+///
+///         At full scale, the region is decoded with
+///         `ImageGenerator::GetSubsetPixels` when the wrapped generator
+///         supports it. Otherwise, and when scaling down, the whole image is
+///         decoded at the closest size the wrapped generator supports and the
+///         region is copied out of it.
+class SubsetImageGenerator : public ImageGenerator {
+ public:
+  ~SubsetImageGenerator();
+
+  /// @param[in]  generator  The generator of the whole image. It must not be
+  ///                        used elsewhere while this generator decodes.
+  /// @param[in]  subset     The region of the image, in the EXIF oriented
+  ///                        coordinates of `generator`. It must be non-empty
+  ///                        and within the bounds of the image.
+  SubsetImageGenerator(std::shared_ptr<ImageGenerator> generator,
+                       const SkIRect& subset);
+
+  // |ImageGenerator|
+  const SkImageInfo& GetInfo() override;
+
+  // |ImageGenerator|
+  unsigned int GetFrameCount() const override;
+
+  // |ImageGenerator|
+  unsigned int GetPlayCount() const override;
+
+  // |ImageGenerator|
+  const ImageGenerator::FrameInfo GetFrameInfo(
+      unsigned int frame_index) override;
+
+  // |ImageGenerator|
+  SkISize GetScaledDimensions(float desired_scale) override;
+
+  // |ImageGenerator|
+  bool GetPixels(
+      const SkImageInfo& info,
+      void* pixels,
+      size_t row_bytes,
+      unsigned int frame_index = 0,
+      std::optional<unsigned int> prior_frame = std::nullopt) override;
+
+ private:
+  // The region in the wrapped image decoded at |decoded_size|.
+  SkIRect ScaleSubset(SkISize decoded_size) const;
+
+  std::shared_ptr<ImageGenerator> generator_;
+  const SkIRect subset_;
+  SkImageInfo image_info_;
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(SubsetImageGenerator);
+};
+
 }  // namespace flutter
 
 #endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_H_
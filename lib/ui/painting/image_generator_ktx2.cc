@@ -0,0 +1,171 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_generator_ktx2.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "flutter/fml/endianness.h"
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+
+namespace flutter {
+
+namespace {
+
+// The header of a KTX2 file, up to the level index that follows it.
+// https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html
+constexpr size_t kVkFormatOffset = 12;
+constexpr size_t kPixelWidthOffset = 20;
+constexpr size_t kPixelHeightOffset = 24;
+constexpr size_t kPixelDepthOffset = 28;
+constexpr size_t kLayerCountOffset = 32;
+constexpr size_t kFaceCountOffset = 36;
+constexpr size_t kLevelCountOffset = 40;
+constexpr size_t kSupercompressionSchemeOffset = 44;
+constexpr size_t kLevelIndexOffset = 80;
+
+// Every level has its byte offset, byte length and uncompressed byte length.
+constexpr size_t kLevelIndexEntrySize = 24;
+
+// The formats read here all store blocks of 4x4 pixels in 16 bytes.
+constexpr uint32_t kBlockSize = 4;
+constexpr uint64_t kBytesPerBlock = 16;
+
+template <typename T>
+T ReadLittleEndian(const uint8_t* data, size_t offset) {
+  T value;
+  memcpy(&value, data + offset, sizeof(T));
+  return fml::LittleEndianToArch(value);
+}
+
+}  // namespace
+
+KTX2ImageGenerator::~KTX2ImageGenerator() = default;
+
+KTX2ImageGenerator::KTX2ImageGenerator(const SkImageInfo& image_info,
+                                       BlockCompressedData data)
+    : image_info_(image_info), data_(std::move(data)) {}
+
+const SkImageInfo& KTX2ImageGenerator::GetInfo() {
+  return image_info_;
+}
+
+unsigned int KTX2ImageGenerator::GetFrameCount() const {
+  return 1;
+}
+
+unsigned int KTX2ImageGenerator::GetPlayCount() const {
+  return 1;
+}
+
+const ImageGenerator::FrameInfo KTX2ImageGenerator::GetFrameInfo(
+    unsigned int frame_index) {
+  return {.required_frame = std::nullopt,
+          .duration = 0,
+          .disposal_method = SkCodecAnimation::DisposalMethod::kKeep};
+}
+
+SkISize KTX2ImageGenerator::GetScaledDimensions(float desired_scale) {
+  return image_info_.dimensions();
+}
+
+bool KTX2ImageGenerator::GetPixels(const SkImageInfo& info,
+                                   void* pixels,
+                                   size_t row_bytes,
+                                   unsigned int frame_index,
+                                   std::optional<unsigned int> prior_frame) {
+  FML_DLOG(ERROR) << "Block compressed KTX2 images can't be decoded to pixels, "
+                     "and can only be drawn where the GPU supports their "
+                     "format.";
+  return false;
+}
+
+const ImageGenerator::BlockCompressedData*
+KTX2ImageGenerator::GetBlockCompressedData() const {
+  return &data_;
+}
+
+std::unique_ptr<ImageGenerator> KTX2ImageGenerator::MakeFromData(
+    sk_sp<SkData> data) {
+  if (!data || data->size() < kLevelIndexOffset ||
+      memcmp(data->data(), kKTX2Identifier, sizeof(kKTX2Identifier))) {
+    return nullptr;
+  }
+  const uint8_t* data_p = data->bytes();
+
+  BlockCompressedData compressed;
+  switch (ReadLittleEndian<uint32_t>(data_p, kVkFormatOffset)) {
+    case kASTC4x4UNormBlock:
+    case kASTC4x4SRGBBlock:
+      compressed.format = BlockCompressedData::Format::kASTC4x4;
+      break;
+    case kETC2R8G8B8A8UNormBlock:
+    case kETC2R8G8B8A8SRGBBlock:
+      compressed.format = BlockCompressedData::Format::kETC2RGBA8;
+      break;
+    case kBC7UNormBlock:
+    case kBC7SRGBBlock:
+      compressed.format = BlockCompressedData::Format::kBC7;
+      break;
+    default:
+      // Other formats, including Basis Universal data that must be transcoded
+      // first, aren't supported.
+      return nullptr;
+  }
+
+  const uint32_t width = ReadLittleEndian<uint32_t>(data_p, kPixelWidthOffset);
+  const uint32_t height =
+      ReadLittleEndian<uint32_t>(data_p, kPixelHeightOffset);
+  // Only 2D textures that aren't arrays or cube maps are images.
+  if (width == 0 || height == 0 ||
+      width > static_cast<uint32_t>(std::numeric_limits<int32_t>::max()) ||
+      height > static_cast<uint32_t>(std::numeric_limits<int32_t>::max()) ||
+      ReadLittleEndian<uint32_t>(data_p, kPixelDepthOffset) != 0 ||
+      ReadLittleEndian<uint32_t>(data_p, kLayerCountOffset) != 0 ||
+      ReadLittleEndian<uint32_t>(data_p, kFaceCountOffset) != 1 ||
+      ReadLittleEndian<uint32_t>(data_p, kSupercompressionSchemeOffset) != 0) {
+    return nullptr;
+  }
+
+  // A level count of 0 asks for mipmaps to be generated, which isn't possible
+  // for block compressed formats, so only the base level is used.
+  const uint32_t level_count =
+      std::max(ReadLittleEndian<uint32_t>(data_p, kLevelCountOffset), 1u);
+  if (level_count > 32 ||
+      data->size() < kLevelIndexOffset + level_count * kLevelIndexEntrySize) {
+    return nullptr;
+  }
+
+  for (uint32_t level = 0; level < level_count; level++) {
+    const size_t entry = kLevelIndexOffset + level * kLevelIndexEntrySize;
+    const uint64_t offset = ReadLittleEndian<uint64_t>(data_p, entry);
+    const uint64_t length = ReadLittleEndian<uint64_t>(data_p, entry + 8);
+    const uint32_t level_width = std::max(width >> level, 1u);
+    const uint32_t level_height = std::max(height >> level, 1u);
+    const uint64_t expected_length =
+        static_cast<uint64_t>((level_width + kBlockSize - 1) / kBlockSize) *
+        ((level_height + kBlockSize - 1) / kBlockSize) * kBytesPerBlock;
+    if (length != expected_length || offset > data->size() ||
+        length > data->size() - offset) {
+      return nullptr;
+    }
+    compressed.levels.push_back(
+        {.size = SkISize::Make(level_width, level_height),
+         .data = SkData::MakeSubset(data.get(), offset, length)});
+    if (level_width == 1 && level_height == 1) {
+      break;
+    }
+  }
+
+  const SkImageInfo image_info =
+      SkImageInfo::Make(width, height, kRGBA_8888_SkColorType,
+                        kPremul_SkAlphaType, SkColorSpace::MakeSRGB());
+  return std::unique_ptr<KTX2ImageGenerator>(
+      new KTX2ImageGenerator(image_info, std::move(compressed)));
+}
+
+}  // namespace flutter
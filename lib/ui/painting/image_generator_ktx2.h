@@ -0,0 +1,77 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_KTX2_H_
+#define FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_KTX2_H_
+
+#include "image_generator.h"
+
+namespace flutter {
+
+/// @brief  Reads KTX2 textures that store ASTC 4x4, ETC2 RGBA8 or BC7 blocks
+///         without supercompression, so that they can be uploaded to GPUs
+///         that support their format without being decoded first.
+///
+///         The blocks can't be decoded to pixels on the CPU, so `GetPixels`
+///         always fails and these images can only be drawn where the GPU
+///         supports their format. The blocks are sampled as is, so they must
+///         hold premultiplied colors.
+/// @see    `ImageGenerator::GetBlockCompressedData`
+class KTX2ImageGenerator : public ImageGenerator {
+ public:
+  ~KTX2ImageGenerator();
+
+  // |ImageGenerator|
+  const SkImageInfo& GetInfo() override;
+
+  // |ImageGenerator|
+  unsigned int GetFrameCount() const override;
+
+  // |ImageGenerator|
+  unsigned int GetPlayCount() const override;
+
+  // |ImageGenerator|
+  const ImageGenerator::FrameInfo GetFrameInfo(
+      unsigned int frame_index) override;
+
+  // |ImageGenerator|
+  SkISize GetScaledDimensions(float desired_scale) override;
+
+  // |ImageGenerator|
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) override;
+
+  // |ImageGenerator|
+  const BlockCompressedData* GetBlockCompressedData() const override;
+
+  static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
+
+ private:
+  static constexpr uint8_t kKTX2Identifier[12] = {
+      0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+  // The values of the `VkFormat`s that KTX2 files identify their formats by.
+  enum VkFormat : uint32_t {
+    kBC7UNormBlock = 145,
+    kBC7SRGBBlock = 146,
+    kETC2R8G8B8A8UNormBlock = 151,
+    kETC2R8G8B8A8SRGBBlock = 152,
+    kASTC4x4UNormBlock = 157,
+    kASTC4x4SRGBBlock = 158,
+  };
+
+  KTX2ImageGenerator(const SkImageInfo& image_info, BlockCompressedData data);
+
+  const SkImageInfo image_info_;
+  const BlockCompressedData data_;
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(KTX2ImageGenerator);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_KTX2_H_
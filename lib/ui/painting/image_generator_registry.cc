@@ -15,6 +15,7 @@
 #endif
 
 #include "image_generator_apng.h"
+#include "image_generator_ktx2.h"
 
 namespace flutter {
 
@@ -31,6 +32,12 @@ ImageGeneratorRegistry::ImageGeneratorRegistry() : weak_factory_(this) {
       },
       0);
 
+  AddFactory(
+      [](sk_sp<SkData> buffer) {
+        return KTX2ImageGenerator::MakeFromData(std::move(buffer));
+      },
+      0);
+
   // todo(bdero): https://github.com/flutter/flutter/issues/82603
 #ifdef FML_OS_MACOSX
   AddFactory(
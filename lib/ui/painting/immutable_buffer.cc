@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/painting/immutable_buffer.h"
 
+#include <atomic>
 #include <cstring>
 
 #include "flutter/fml/file.h"
@@ -108,8 +109,7 @@ Dart_Handle ImmutableBuffer::initFromAsset(Dart_Handle raw_buffer_handle,
         size_t buffer_size = 0;
         if (mapping != nullptr) {
           buffer_size = mapping->GetSize();
-          const void* bytes = static_cast<const void*>(mapping->GetMapping());
-          sk_data = MakeSkDataWithCopy(bytes, buffer_size);
+          sk_data = MakeSkDataFromMapping(std::move(mapping));
         }
         ui_task_runner->PostTask(
             [sk_data = std::move(sk_data), ui_task = ui_task, buffer_size]() {
@@ -178,8 +178,7 @@ Dart_Handle ImmutableBuffer::initFromFile(Dart_Handle raw_buffer_handle,
         size_t buffer_size = 0;
         if (mapping->IsValid()) {
           buffer_size = mapping->GetSize();
-          const void* bytes = static_cast<const void*>(mapping->GetMapping());
-          sk_data = MakeSkDataWithCopy(bytes, buffer_size);
+          sk_data = MakeSkDataFromMapping(std::move(mapping));
         }
         ui_task_runner->PostTask(
             [sk_data = std::move(sk_data), ui_task = ui_task, buffer_size]() {
@@ -189,6 +188,73 @@ Dart_Handle ImmutableBuffer::initFromFile(Dart_Handle raw_buffer_handle,
   return Dart_Null();
 }
 
+Dart_Handle ImmutableBuffer::prefetchAssets(Dart_Handle asset_names_handle,
+                                            Dart_Handle callback_handle) {
+  UIDartState::ThrowIfUIOperationsProhibited();
+  if (!Dart_IsClosure(callback_handle)) {
+    return tonic::ToDart("Callback must be a function");
+  }
+
+  std::vector<std::string> asset_names =
+      tonic::DartConverter<std::vector<std::string>>::FromDart(
+          asset_names_handle);
+
+  auto* dart_state = UIDartState::Current();
+  auto ui_task_runner = dart_state->GetTaskRunners().GetUITaskRunner();
+  auto* callback_ptr =
+      new tonic::DartPersistentValue(dart_state, callback_handle);
+  auto asset_manager = UIDartState::Current()
+                           ->platform_configuration()
+                           ->client()
+                           ->GetAssetManager();
+
+  auto ui_task = [callback_ptr]() {
+    std::unique_ptr<tonic::DartPersistentValue> callback(callback_ptr);
+    auto dart_state = callback->dart_state().lock();
+    if (!dart_state) {
+      return;
+    }
+    tonic::DartState::Scope scope(dart_state);
+    tonic::DartInvoke(callback->Get(), {Dart_TypeVoid()});
+  };
+
+  if (asset_names.empty() || !asset_manager) {
+    ui_task_runner->PostTask(ui_task);
+    return Dart_Null();
+  }
+
+  // Each asset is loaded by its own task, so that the worker pool reads them
+  // in parallel. The last task to finish completes the future.
+  auto remaining = std::make_shared<std::atomic<size_t>>(asset_names.size());
+  auto concurrent_task_runner = dart_state->GetConcurrentTaskRunner();
+  for (std::string& asset_name : asset_names) {
+    concurrent_task_runner->PostTask(
+        [asset_name = std::move(asset_name), asset_manager, remaining,
+         ui_task_runner, ui_task]() {
+          asset_manager->Prefetch(asset_name);
+          if (--(*remaining) == 0) {
+            ui_task_runner->PostTask(ui_task);
+          }
+        });
+  }
+  return Dart_Null();
+}
+
+sk_sp<SkData> ImmutableBuffer::MakeSkDataFromMapping(
+    std::unique_ptr<fml::Mapping> mapping) {
+  if (!mapping || mapping->GetSize() == 0 || !mapping->GetMapping()) {
+    return SkData::MakeEmpty();
+  }
+  // Asset and file mappings are read only, and don't need to be copied to
+  // outlive the task that opened them.
+  const void* bytes = mapping->GetMapping();
+  const size_t length = mapping->GetSize();
+  SkData::ReleaseProc proc = [](const void* ptr, void* context) {
+    delete reinterpret_cast<fml::Mapping*>(context);
+  };
+  return SkData::MakeWithProc(bytes, length, proc, mapping.release());
+}
+
 #if FML_OS_ANDROID
 
 // Compressed image buffers are allocated on the UI thread but are deleted on a
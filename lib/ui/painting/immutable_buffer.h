@@ -6,8 +6,10 @@
 #define FLUTTER_LIB_UI_PAINTING_IMMUTABLE_BUFFER_H_
 
 #include <cstdint>
+#include <memory>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/tonic/dart_library_natives.h"
@@ -70,6 +72,16 @@ class ImmutableBuffer : public RefCountedDartWrappable<ImmutableBuffer> {
                                   Dart_Handle file_path_handle,
                                   Dart_Handle callback_handle);
 
+  /// Loads assets on the concurrent worker pool, so that later calls to
+  /// initFromAsset for them are served from memory.
+  ///
+  /// The zero indexed argument is a List<String> of the assets to load.
+  ///
+  /// The first indexed argument is expected to be a void callback to signal
+  /// when all of the assets were loaded.
+  static Dart_Handle prefetchAssets(Dart_Handle asset_names_handle,
+                                    Dart_Handle callback_handle);
+
   /// The length of the data in bytes.
   size_t length() const {
     FML_DCHECK(data_);
@@ -96,6 +108,11 @@ class ImmutableBuffer : public RefCountedDartWrappable<ImmutableBuffer> {
 
   static sk_sp<SkData> MakeSkDataWithCopy(const void* data, size_t length);
 
+  // Wraps the bytes of |mapping| without copying them. The mapping is kept
+  // alive until the returned data is collected, which may be on any thread.
+  static sk_sp<SkData> MakeSkDataFromMapping(
+      std::unique_ptr<fml::Mapping> mapping);
+
   DEFINE_WRAPPERTYPEINFO();
   FML_FRIEND_MAKE_REF_COUNTED(ImmutableBuffer);
   FML_DISALLOW_COPY_AND_ASSIGN(ImmutableBuffer);
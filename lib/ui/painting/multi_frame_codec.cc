@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/display_list_image_gpu.h"
 #include "flutter/lib/ui/painting/image.h"
 #if IMPELLER_SUPPORTS_RENDERING
@@ -21,20 +22,37 @@
 
 namespace flutter {
 
-MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator)
-    : state_(new State(std::move(generator))) {}
+MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator,
+                                 size_t look_ahead_frame_count,
+                                 size_t look_ahead_max_bytes)
+    : state_(new State(std::move(generator),
+                       look_ahead_frame_count,
+                       look_ahead_max_bytes)) {}
 
 MultiFrameCodec::~MultiFrameCodec() = default;
 
-MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator)
+MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator,
+                              size_t look_ahead_frame_count,
+                              size_t look_ahead_max_bytes)
     : generator_(std::move(generator)),
       frameCount_(generator_->GetFrameCount()),
       repetitionCount_(generator_->GetPlayCount() ==
                                ImageGenerator::kInfinitePlayCount
                            ? -1
                            : generator_->GetPlayCount() - 1),
+      lookAheadFrameCount_(look_ahead_frame_count),
+      lookAheadMaxBytes_(look_ahead_max_bytes),
       is_impeller_enabled_(UIDartState::Current()->IsImpellerEnabled()) {}
 
+static SkImageInfo GetFrameImageInfo(ImageGenerator& generator) {
+  SkImageInfo info = generator.GetInfo().makeColorType(kN32_SkColorType);
+  if (info.alphaType() == kUnpremul_SkAlphaType) {
+    SkImageInfo updated = info.makeAlphaType(kPremul_SkAlphaType);
+    info = updated;
+  }
+  return info;
+}
+
 static void InvokeNextFrameCallback(
     const fml::RefPtr<CanvasImage>& image,
     int duration,
@@ -53,32 +71,39 @@ static void InvokeNextFrameCallback(
                      tonic::ToDart(decode_error)});
 }
 
-std::pair<sk_sp<DlImage>, std::string>
-MultiFrameCodec::State::GetNextFrameImage(
-    fml::WeakPtr<GrDirectContext> resourceContext,
-    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
-    const std::shared_ptr<impeller::Context>& impeller_context,
-    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
+MultiFrameCodec::State::DecodedFrame
+MultiFrameCodec::State::DecodeNextFrame() {
+  TRACE_EVENT0("flutter", "MultiFrameCodec::DecodeNextFrame");
+  DecodedFrame frame;
+  const int frameIndex = nextFrameIndex_;
+  nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
+
+  const SkImageInfo info = GetFrameImageInfo(*generator_);
+  ImageGenerator::FrameInfo frameInfo = generator_->GetFrameInfo(frameIndex);
+  frame.duration = frameInfo.duration;
+
+  const int requiredFrameIndex =
+      frameInfo.required_frame.value_or(SkCodec::kNoFrame);
+
+  // Reuse the pixels of the last replaced required frame if no image refers
+  // to them anymore, instead of allocating a buffer for every frame.
   SkBitmap bitmap = SkBitmap();
-  SkImageInfo info = generator_->GetInfo().makeColorType(kN32_SkColorType);
-  if (info.alphaType() == kUnpremul_SkAlphaType) {
-    SkImageInfo updated = info.makeAlphaType(kPremul_SkAlphaType);
-    info = updated;
-  }
-  if (!bitmap.tryAllocPixels(info)) {
+  if (recycledFrame_.has_value() && recycledFrame_->info() == info &&
+      recycledFrame_->pixelRef()->unique()) {
+    bitmap = std::move(recycledFrame_.value());
+    if (requiredFrameIndex == SkCodec::kNoFrame ||
+        !lastRequiredFrame_.has_value()) {
+      bitmap.eraseColor(SK_ColorTRANSPARENT);
+    }
+  } else if (!bitmap.tryAllocPixels(info)) {
     std::ostringstream ostr;
     ostr << "Failed to allocate memory for bitmap of size "
          << info.computeMinByteSize() << "B";
-    std::string decode_error = ostr.str();
-    FML_LOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
+    frame.decode_error = ostr.str();
+    FML_LOG(ERROR) << frame.decode_error;
+    return frame;
   }
-
-  ImageGenerator::FrameInfo frameInfo =
-      generator_->GetFrameInfo(nextFrameIndex_);
-
-  const int requiredFrameIndex =
-      frameInfo.required_frame.value_or(SkCodec::kNoFrame);
+  recycledFrame_.reset();
 
   if (requiredFrameIndex != SkCodec::kNoFrame) {
     // We are here when the frame said |disposal_method| is
@@ -86,7 +111,7 @@ MultiFrameCodec::State::GetNextFrameImage(
     // |requiredFrameIndex| is set to ex-frame or ex-ex-frame.
     if (!lastRequiredFrame_.has_value()) {
       FML_DLOG(INFO)
-          << "Frame " << nextFrameIndex_ << " depends on frame "
+          << "Frame " << frameIndex << " depends on frame "
           << requiredFrameIndex
           << " and no required frames are cached. Using blank slate instead.";
     } else {
@@ -102,12 +127,12 @@ MultiFrameCodec::State::GetNextFrameImage(
   // Write the new frame to the output buffer. The bitmap pixels as supplied
   // are already set in accordance with the previous frame's disposal policy.
   if (!generator_->GetPixels(info, bitmap.getPixels(), bitmap.rowBytes(),
-                             nextFrameIndex_, requiredFrameIndex)) {
+                             frameIndex, requiredFrameIndex)) {
     std::ostringstream ostr;
-    ostr << "Could not getPixels for frame " << nextFrameIndex_;
-    std::string decode_error = ostr.str();
-    FML_LOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
+    ostr << "Could not getPixels for frame " << frameIndex;
+    frame.decode_error = ostr.str();
+    FML_LOG(ERROR) << frame.decode_error;
+    return frame;
   }
 
   const bool keep_current_frame =
@@ -131,8 +156,9 @@ MultiFrameCodec::State::GetNextFrameImage(
       (previous_frame_available && !restore_previous_frame)) {
     // Replace the stored frame. The `lastRequiredFrame_` will get used as the
     // starting backdrop for the next frame.
+    recycledFrame_ = std::move(lastRequiredFrame_);
     lastRequiredFrame_ = bitmap;
-    lastRequiredFrameIndex_ = nextFrameIndex_;
+    lastRequiredFrameIndex_ = frameIndex;
   }
 
   if (frameInfo.disposal_method ==
@@ -142,6 +168,29 @@ MultiFrameCodec::State::GetNextFrameImage(
     restoreBGColorRect_.reset();
   }
 
+  frame.bitmap = std::move(bitmap);
+  return frame;
+}
+
+bool MultiFrameCodec::State::DecodeFrameAhead() {
+  const size_t frame_bytes =
+      GetFrameImageInfo(*generator_).computeMinByteSize();
+  if (decodedFrames_.size() >= lookAheadFrameCount_ ||
+      decodedFramesBytes_ + frame_bytes > lookAheadMaxBytes_) {
+    return false;
+  }
+  DecodedFrame frame = DecodeNextFrame();
+  decodedFramesBytes_ += frame.bitmap.computeByteSize();
+  decodedFrames_.push_back(std::move(frame));
+  return true;
+}
+
+std::pair<sk_sp<DlImage>, std::string> MultiFrameCodec::State::UploadFrame(
+    const SkBitmap& bitmap,
+    fml::WeakPtr<GrDirectContext> resourceContext,
+    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
+    const std::shared_ptr<impeller::Context>& impeller_context,
+    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
 #if IMPELLER_SUPPORTS_RENDERING
   if (is_impeller_enabled_) {
     // This is safe regardless of whether the GPU is available or not because
@@ -193,17 +242,28 @@ void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
   int duration = 0;
   sk_sp<DlImage> dlImage;
   std::string decode_error;
-  std::tie(dlImage, decode_error) =
-      GetNextFrameImage(std::move(resourceContext), gpu_disable_sync_switch,
-                        impeller_context, std::move(unref_queue));
+
+  DecodedFrame frame;
+  if (decodedFrames_.empty()) {
+    frame = DecodeNextFrame();
+  } else {
+    frame = std::move(decodedFrames_.front());
+    decodedFrames_.pop_front();
+    decodedFramesBytes_ -= frame.bitmap.computeByteSize();
+  }
+  if (frame.decode_error.empty()) {
+    std::tie(dlImage, decode_error) =
+        UploadFrame(frame.bitmap, std::move(resourceContext),
+                    gpu_disable_sync_switch, impeller_context,
+                    std::move(unref_queue));
+  } else {
+    decode_error = std::move(frame.decode_error);
+  }
   if (dlImage) {
     image = CanvasImage::Create();
     image->set_image(dlImage);
-    ImageGenerator::FrameInfo frameInfo =
-        generator_->GetFrameInfo(nextFrameIndex_);
-    duration = frameInfo.duration;
+    duration = frame.duration;
   }
-  nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
 
   // The static leak checker gets confused by the use of fml::MakeCopyable.
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
@@ -245,6 +305,7 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
            tonic::DartState::Current(), callback_handle),
        weak_state = std::weak_ptr<MultiFrameCodec::State>(state_), trace_id,
        ui_task_runner = task_runners.GetUITaskRunner(),
+       io_task_runner = task_runners.GetIOTaskRunner(),
        io_manager = dart_state->GetIOManager()]() mutable {
         auto state = weak_state.lock();
         if (!state) {
@@ -257,6 +318,7 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
             io_manager->GetResourceContext(), io_manager->GetSkiaUnrefQueue(),
             io_manager->GetIsGpuDisabledSyncSwitch(), trace_id,
             io_manager->GetImpellerContext());
+        DecodeFramesAhead(std::move(weak_state), io_task_runner);
       }));
 
   return Dart_Null();
@@ -265,6 +327,20 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
 }
 
+void MultiFrameCodec::DecodeFramesAhead(
+    std::weak_ptr<State> weak_state,
+    fml::RefPtr<fml::TaskRunner> io_task_runner) {
+  // Decode one frame per task, so that other work on the IO task runner, such
+  // as the request for the next frame, is not held up by a run of decodes.
+  io_task_runner->PostTask([weak_state = std::move(weak_state),
+                            io_task_runner]() mutable {
+    auto state = weak_state.lock();
+    if (state && state->DecodeFrameAhead()) {
+      DecodeFramesAhead(std::move(weak_state), std::move(io_task_runner));
+    }
+  });
+}
+
 int MultiFrameCodec::frameCount() const {
   return state_->frameCount_;
 }
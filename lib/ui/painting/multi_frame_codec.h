@@ -9,13 +9,25 @@
 #include "flutter/lib/ui/painting/codec.h"
 #include "flutter/lib/ui/painting/image_generator.h"
 
+#include <deque>
 #include <utility>
 
 namespace flutter {
 
 class MultiFrameCodec : public Codec {
  public:
-  explicit MultiFrameCodec(std::shared_ptr<ImageGenerator> generator);
+  // The number of frames decoded ahead of the one Dart asked for, so that a
+  // slow decode has the duration of the current frame to finish in.
+  static constexpr size_t kDefaultLookAheadFrameCount = 2;
+
+  // The most memory the frames decoded ahead may hold. Fewer frames are
+  // decoded ahead when they are large.
+  static constexpr size_t kDefaultLookAheadMaxBytes = 16 * 1024 * 1024;
+
+  explicit MultiFrameCodec(
+      std::shared_ptr<ImageGenerator> generator,
+      size_t look_ahead_frame_count = kDefaultLookAheadFrameCount,
+      size_t look_ahead_max_bytes = kDefaultLookAheadMaxBytes);
 
   ~MultiFrameCodec() override;
 
@@ -39,11 +51,22 @@ class MultiFrameCodec : public Codec {
   // shares it with the IO task runner's decoding work, and sets the live_
   // member to false when it is destructed.
   struct State {
-    explicit State(std::shared_ptr<ImageGenerator> generator);
+    State(std::shared_ptr<ImageGenerator> generator,
+          size_t look_ahead_frame_count,
+          size_t look_ahead_max_bytes);
+
+    // A frame composed with the frames it depends on, before it is uploaded.
+    struct DecodedFrame {
+      SkBitmap bitmap;
+      int duration = 0;
+      std::string decode_error;
+    };
 
     const std::shared_ptr<ImageGenerator> generator_;
     const int frameCount_;
     const int repetitionCount_;
+    const size_t lookAheadFrameCount_;
+    const size_t lookAheadMaxBytes_;
     bool is_impeller_enabled_ = false;
 
     // The non-const members and functions below here are only read or written
@@ -55,11 +78,26 @@ class MultiFrameCodec : public Codec {
     // The index of the last decoded required frame.
     int lastRequiredFrameIndex_ = -1;
 
+    // A previously stored required frame whose pixels may be reused for a
+    // later frame once no image refers to them anymore.
+    std::optional<SkBitmap> recycledFrame_;
+
     // The rectangle that should be cleared if the previous frame's disposal
     // method was kRestoreBGColor.
     std::optional<SkIRect> restoreBGColorRect_;
 
-    std::pair<sk_sp<DlImage>, std::string> GetNextFrameImage(
+    // The frames decoded ahead, in the order Dart will ask for them.
+    std::deque<DecodedFrame> decodedFrames_;
+    size_t decodedFramesBytes_ = 0;
+
+    DecodedFrame DecodeNextFrame();
+
+    // Decodes the next frame into |decodedFrames_| unless the look-ahead
+    // limits are reached, and returns whether it did.
+    bool DecodeFrameAhead();
+
+    std::pair<sk_sp<DlImage>, std::string> UploadFrame(
+        const SkBitmap& bitmap,
         fml::WeakPtr<GrDirectContext> resourceContext,
         const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
         const std::shared_ptr<impeller::Context>& impeller_context,
@@ -75,6 +113,11 @@ class MultiFrameCodec : public Codec {
         const std::shared_ptr<impeller::Context>& impeller_context);
   };
 
+  // Decodes frames ahead on the IO task runner until the look-ahead limits
+  // of the state are reached or it is collected.
+  static void DecodeFramesAhead(std::weak_ptr<State> weak_state,
+                                fml::RefPtr<fml::TaskRunner> io_task_runner);
+
   // Shared across the UI and IO task runners.
   std::shared_ptr<State> state_;
 
@@ -34,8 +34,8 @@ constexpr int kMaskFilterIndex = 9;
 constexpr int kMaskFilterBlurStyleIndex = 10;
 constexpr int kMaskFilterSigmaIndex = 11;
 constexpr int kInvertColorIndex = 12;
-constexpr size_t kDataByteCount = 52;  // 4 * (last index + 1)
-static_assert(kDataByteCount == sizeof(uint32_t) * (kInvertColorIndex + 1),
+static_assert(Paint::kDataByteCount ==
+                  sizeof(uint32_t) * (kInvertColorIndex + 1),
               "kDataByteCount must match the size of the data array.");
 
 // Indices for objects.
@@ -198,23 +198,30 @@ void Paint::toDlPaint(DlPaint& paint) const {
   if (isNull()) {
     return;
   }
-  FML_DCHECK(paint == DlPaint());
 
   tonic::DartByteData byte_data(paint_data_);
   FML_CHECK(byte_data.length_in_bytes() == kDataByteCount);
 
-  const uint32_t* uint_data = static_cast<const uint32_t*>(byte_data.data());
-  const float* float_data = static_cast<const float*>(byte_data.data());
+  DecodeDlPaint(byte_data.data(), paint_objects_, paint);
+}
+
+void Paint::DecodeDlPaint(const void* data,
+                          Dart_Handle paint_objects,
+                          DlPaint& paint) {
+  FML_DCHECK(paint == DlPaint());
+
+  const uint32_t* uint_data = static_cast<const uint32_t*>(data);
+  const float* float_data = static_cast<const float*>(data);
 
   Dart_Handle values[kObjectCount];
-  if (!Dart_IsNull(paint_objects_)) {
-    FML_DCHECK(Dart_IsList(paint_objects_));
+  if (!Dart_IsNull(paint_objects)) {
+    FML_DCHECK(Dart_IsList(paint_objects));
     intptr_t length = 0;
-    Dart_ListLength(paint_objects_, &length);
+    Dart_ListLength(paint_objects, &length);
 
     FML_CHECK(length == kObjectCount);
     if (Dart_IsError(
-            Dart_ListGetRange(paint_objects_, 0, kObjectCount, values))) {
+            Dart_ListGetRange(paint_objects, 0, kObjectCount, values))) {
       return;
     }
 
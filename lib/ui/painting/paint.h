@@ -14,6 +14,9 @@ namespace flutter {
 
 class Paint {
  public:
+  // The size of the data of a Paint in painting.dart.
+  static constexpr size_t kDataByteCount = 52;
+
   Paint() = default;
   Paint(Dart_Handle paint_objects, Dart_Handle paint_data);
 
@@ -22,6 +25,13 @@ class Paint {
 
   void toDlPaint(DlPaint& paint) const;
 
+  // Sets all of the attributes of |paint|, which must be a default DlPaint,
+  // from |data| and |paint_objects|. The |data| is kDataByteCount bytes of
+  // the data of a Paint, which may have been copied out of its ByteData.
+  static void DecodeDlPaint(const void* data,
+                            Dart_Handle paint_objects,
+                            DlPaint& paint);
+
   bool isNull() const { return Dart_IsNull(paint_data_); }
   bool isNotNull() const { return !Dart_IsNull(paint_data_); }
 
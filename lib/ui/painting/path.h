@@ -15,7 +15,7 @@
 
 namespace flutter {
 
-class CanvasPath : public RefCountedDartWrappable<CanvasPath> {
+class CanvasPath : public PooledDartWrappable<CanvasPath> {
   DEFINE_WRAPPERTYPEINFO();
   FML_FRIEND_MAKE_REF_COUNTED(CanvasPath);
 
@@ -14,7 +14,7 @@
 namespace flutter {
 class Canvas;
 
-class Picture : public RefCountedDartWrappable<Picture> {
+class Picture : public PooledDartWrappable<Picture> {
   DEFINE_WRAPPERTYPEINFO();
   FML_FRIEND_MAKE_REF_COUNTED(Picture);
 
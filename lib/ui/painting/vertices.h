@@ -12,7 +12,7 @@
 
 namespace flutter {
 
-class Vertices : public RefCountedDartWrappable<Vertices> {
+class Vertices : public PooledDartWrappable<Vertices> {
   DEFINE_WRAPPERTYPEINFO();
   FML_FRIEND_MAKE_REF_COUNTED(Vertices);
 
@@ -775,6 +775,52 @@ class PlatformDispatcher {
   @Native<Void Function()>(symbol: 'PlatformConfigurationNativeApi::ScheduleFrame')
   external static void _scheduleFrame();
 
+  /// Requests that frames are produced at a rate within [range] while the
+  /// animation identified by [requester] runs, or withdraws the request of
+  /// [requester] if [range] is null.
+  ///
+  /// Frames are produced at the highest rate that any of the running
+  /// animations prefers, so that a slow ambient animation can run at 30 Hz on
+  /// a 120 Hz display to save power, while scrolling still gets the full
+  /// refresh rate. Without any request, frames are produced at the refresh
+  /// rate of the display.
+  ///
+  /// Where the platform supports it, the refresh rate of the display itself
+  /// is lowered. Otherwise, vsyncs that arrive too early for the preferred
+  /// rate are skipped.
+  ///
+  /// This operation is a no-op on web.
+  void requestFrameRateRange(Object requester, FrameRateRange? range) {
+    if (range == null) {
+      if (_frameRateRanges.remove(requester) == null) {
+        return;
+      }
+    } else {
+      if (_frameRateRanges[requester] == range) {
+        return;
+      }
+      _frameRateRanges[requester] = range;
+    }
+    _updateFrameRateRange();
+  }
+
+  final Map<Object, FrameRateRange> _frameRateRanges = <Object, FrameRateRange>{};
+
+  void _updateFrameRateRange() {
+    double minimum = 0.0;
+    double maximum = 0.0;
+    double preferred = 0.0;
+    for (final FrameRateRange range in _frameRateRanges.values) {
+      minimum = math.max(minimum, range.minimum);
+      maximum = math.max(maximum, range.maximum);
+      preferred = math.max(preferred, range.preferred);
+    }
+    _setFrameRateRange(math.min(minimum, preferred), maximum, preferred);
+  }
+
+  @Native<Void Function(Double, Double, Double)>(symbol: 'PlatformConfigurationNativeApi::SetFrameRateRange')
+  external static void _setFrameRateRange(double minimum, double maximum, double preferred);
+
   /// Additional accessibility features that may be enabled by the platform.
   AccessibilityFeatures get accessibilityFeatures => _configuration.accessibilityFeatures;
 
@@ -1603,6 +1649,9 @@ enum _FrameTimingInfo {
   /// The number of bytes used to cache pictures during the frame.
   pictureCacheBytes,
 
+  /// The time the GPU spent on the frame, in microseconds.
+  gpuDuration,
+
   /// The frame number of the frame.
   frameNumber,
 }
@@ -1638,6 +1687,7 @@ class FrameTiming {
     int layerCacheBytes = 0,
     int pictureCacheCount = 0,
     int pictureCacheBytes = 0,
+    int gpuDuration = 0,
     int frameNumber = -1,
   }) {
     return FrameTiming._(<int>[
@@ -1651,6 +1701,7 @@ class FrameTiming {
       layerCacheBytes,
       pictureCacheCount,
       pictureCacheBytes,
+      gpuDuration,
       frameNumber,
     ]);
   }
@@ -1711,6 +1762,16 @@ class FrameTiming {
   /// See also [vsyncOverhead], [buildDuration] and [rasterDuration].
   Duration get totalSpan => _rawDuration(FramePhase.rasterFinish) - _rawDuration(FramePhase.vsyncStart);
 
+  /// The time the GPU spent executing the work of the frame.
+  ///
+  /// Comparing this with [rasterDuration] tells whether a slow frame was
+  /// limited by the GPU or by the raster thread.
+  ///
+  /// This is [Duration.zero] when the GPU time was not measured, which is the
+  /// case with the Skia backends, in release builds, and for frames that were
+  /// reported before the GPU finished them.
+  Duration get gpuDuration => Duration(microseconds: _rawInfo(_FrameTimingInfo.gpuDuration));
+
   /// The number of layers stored in the raster cache during the frame.
   ///
   /// See also [layerCacheBytes], [pictureCacheCount] and [pictureCacheBytes].
@@ -2519,6 +2580,54 @@ class Locale {
   }
 }
 
+/// A range of frame rates, in frames per second, that an animation runs well
+/// at.
+///
+/// See also:
+///
+///  * [PlatformDispatcher.requestFrameRateRange], which requests frames to be
+///    produced at a rate within such a range.
+class FrameRateRange {
+  /// Creates a frame rate range.
+  ///
+  /// The [preferred] rate defaults to the [maximum] rate, and must lie within
+  /// the range.
+  const FrameRateRange({
+    required this.minimum,
+    required this.maximum,
+    double? preferred,
+  }) : assert(minimum > 0.0),
+       assert(maximum >= minimum),
+       assert(preferred == null || (preferred >= minimum && preferred <= maximum)),
+       preferred = preferred ?? maximum;
+
+  /// The lowest frame rate at which the animation still looks smooth.
+  final double minimum;
+
+  /// The highest frame rate that the animation benefits from.
+  final double maximum;
+
+  /// The frame rate the animation prefers to run at.
+  final double preferred;
+
+  @override
+  bool operator ==(Object other) {
+    if (identical(this, other)) {
+      return true;
+    }
+    return other is FrameRateRange &&
+        other.minimum == minimum &&
+        other.maximum == maximum &&
+        other.preferred == preferred;
+  }
+
+  @override
+  int get hashCode => Object.hash(minimum, maximum, preferred);
+
+  @override
+  String toString() => 'FrameRateRange(minimum: $minimum, maximum: $maximum, preferred: $preferred)';
+}
+
 /// Various performance modes for tuning the Dart VM's GC performance.
 ///
 /// For the editor of this enum, please keep the order in sync with `Dart_PerformanceMode`
@@ -3659,6 +3659,39 @@ base class _NativeParagraphBuilder extends NativeFieldWrapperClass1 implements P
   external void _build(_NativeParagraph outParagraph);
 }
 
+/// Lays out each of the `paragraphs` with the [ParagraphConstraints] at the
+/// same index of `constraints` on a background thread.
+///
+/// This lets apps measure many paragraphs, such as the cells of a large table,
+/// without blocking the frame. The paragraphs must not be used until the
+/// returned future completes. Afterwards their metrics are available as if
+/// [Paragraph.layout] had been called on each of them.
+Future<void> layoutParagraphs(List<Paragraph> paragraphs, List<ParagraphConstraints> constraints) {
+  if (paragraphs.length != constraints.length) {
+    throw ArgumentError('Each paragraph needs exactly one set of constraints.');
+  }
+  final List<_NativeParagraph> nativeParagraphs = <_NativeParagraph>[
+    for (final Paragraph paragraph in paragraphs) paragraph as _NativeParagraph,
+  ];
+  final Float64List widths = Float64List(constraints.length);
+  for (int index = 0; index < constraints.length; index += 1) {
+    widths[index] = constraints[index].width;
+  }
+  return _futurize((_Callback<void> callback) {
+    return _layoutParagraphs(nativeParagraphs, widths, callback);
+  }).then((_) {
+    assert(() {
+      for (final _NativeParagraph paragraph in nativeParagraphs) {
+        paragraph._needsLayout = false;
+      }
+      return true;
+    }());
+  });
+}
+
+@Native<Handle Function(Handle, Handle, Handle)>(symbol: 'Paragraph::LayoutAll')
+external String? _layoutParagraphs(List<_NativeParagraph> paragraphs, Float64List widths, _Callback<void> callback);
+
 /// Loads a font from a buffer and makes it available for rendering text.
 ///
 /// * `list`: A list of bytes containing the font file.
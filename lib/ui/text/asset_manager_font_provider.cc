@@ -4,8 +4,13 @@
 
 #include "flutter/lib/ui/text/asset_manager_font_provider.h"
 
+#include <algorithm>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkFontMgr.h"
@@ -22,6 +27,96 @@ void MappingReleaseProc(const void* ptr, void* context) {
   delete reinterpret_cast<fml::Mapping*>(context);
 }
 
+// Font files start with a table directory holding a checksum of every table,
+// so the name, the size and the first bytes of an asset identify the font.
+constexpr size_t kFontAssetKeyPrefixSize = 4096u;
+
+struct FontAssetKey {
+  std::string asset;
+  size_t size;
+  size_t prefix_hash;
+
+  bool operator==(const FontAssetKey& other) const {
+    return asset == other.asset && size == other.size &&
+           prefix_hash == other.prefix_hash;
+  }
+};
+
+struct FontAssetKeyHash {
+  size_t operator()(const FontAssetKey& key) const {
+    return fml::HashCombine(key.asset, key.size, key.prefix_hash);
+  }
+};
+
+// The typefaces of font assets that are alive in the process, so that engines
+// loading the same asset share one typeface and one mapping of the file
+// instead of each holding their own.
+class FontAssetRegistry {
+ public:
+  static FontAssetRegistry& GetForProcess() {
+    static FontAssetRegistry registry;
+    return registry;
+  }
+
+  sk_sp<SkTypeface> GetTypeface(const std::string& asset,
+                                std::unique_ptr<fml::Mapping> mapping,
+                                const std::string& family_name) {
+    const auto* bytes = reinterpret_cast<const char*>(mapping->GetMapping());
+    const size_t size = mapping->GetSize();
+    FontAssetKey key{asset, size,
+                     std::hash<std::string_view>{}(std::string_view(
+                         bytes, std::min(size, kFontAssetKeyPrefixSize)))};
+
+    std::scoped_lock lock(mutex_);
+    auto found = typefaces_.find(key);
+    if (found != typefaces_.end()) {
+      // The entries only hold weak references, which cannot be revived once
+      // the last engine releases the typeface.
+      if (found->second->try_ref()) {
+        return sk_sp<SkTypeface>(found->second);
+      }
+      found->second->weak_unref();
+      typefaces_.erase(found);
+    }
+
+    // The typeface reads the font straight from the mapping, which is
+    // released along with the typeface.
+    fml::Mapping* mapping_ptr = mapping.release();
+    sk_sp<SkData> data =
+        SkData::MakeWithProc(mapping_ptr->GetMapping(), mapping_ptr->GetSize(),
+                             MappingReleaseProc, mapping_ptr);
+    sk_sp<SkFontMgr> font_mgr = txt::GetDefaultFontManager();
+    // Ownership of the stream is transferred.
+    sk_sp<SkTypeface> typeface =
+        font_mgr->makeFromStream(SkMemoryStream::Make(std::move(data)));
+    if (!typeface) {
+      FML_DLOG(ERROR) << "Unable to load font asset for family: "
+                      << family_name;
+      return nullptr;
+    }
+
+    PurgeExpiredTypefaces();
+    typeface->weak_ref();
+    typefaces_.emplace(std::move(key), typeface.get());
+    return typeface;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<FontAssetKey, SkTypeface*, FontAssetKeyHash> typefaces_;
+
+  void PurgeExpiredTypefaces() {
+    for (auto it = typefaces_.begin(); it != typefaces_.end();) {
+      if (it->second->weak_expired()) {
+        it->second->weak_unref();
+        it = typefaces_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+};
+
 }  // anonymous namespace
 
 AssetManagerFontProvider::AssetManagerFontProvider(
@@ -112,18 +207,9 @@ auto AssetManagerFontStyleSet::createTypeface(int i) -> CreateTypefaceRet {
       return nullptr;
     }
 
-    fml::Mapping* asset_mapping_ptr = asset_mapping.release();
-    sk_sp<SkData> asset_data = SkData::MakeWithProc(
-        asset_mapping_ptr->GetMapping(), asset_mapping_ptr->GetSize(),
-        MappingReleaseProc, asset_mapping_ptr);
-    std::unique_ptr<SkMemoryStream> stream = SkMemoryStream::Make(asset_data);
-
-    sk_sp<SkFontMgr> font_mgr = txt::GetDefaultFontManager();
-    // Ownership of the stream is transferred.
-    asset.typeface = font_mgr->makeFromStream(std::move(stream));
+    asset.typeface = FontAssetRegistry::GetForProcess().GetTypeface(
+        asset.asset, std::move(asset_mapping), family_name_);
     if (!asset.typeface) {
-      FML_DLOG(ERROR) << "Unable to load font asset for family: "
-                      << family_name_;
       return nullptr;
     }
   }
@@ -0,0 +1,55 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/text/asset_manager_font_provider.h"
+
+#include <memory>
+#include <vector>
+
+#include "flutter/assets/asset_manager.h"
+#include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/runtime/test_font_data.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkStream.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+std::shared_ptr<AssetManager> MakeAssetManager(
+    const fml::ScopedTemporaryDirectory& directory) {
+  auto asset_manager = std::make_shared<AssetManager>();
+  asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
+      fml::OpenDirectory(directory.path().c_str(), false,
+                         fml::FilePermission::kRead),
+      false));
+  return asset_manager;
+}
+}  // namespace
+
+TEST(AssetManagerFontProviderTest, EnginesShareTypefacesOfTheSameAsset) {
+  fml::ScopedTemporaryDirectory asset_dir;
+  int ttc_index = 0;
+  auto stream = GetTestFontData()[0]->openStream(&ttc_index);
+  ASSERT_NE(stream, nullptr);
+  std::vector<uint8_t> font(stream->getLength());
+  ASSERT_EQ(stream->read(font.data(), font.size()), font.size());
+  ASSERT_TRUE(fml::WriteAtomically(asset_dir.fd(), "test_font.ttf",
+                                   fml::DataMapping(font)));
+
+  AssetManagerFontProvider first(MakeAssetManager(asset_dir));
+  AssetManagerFontProvider second(MakeAssetManager(asset_dir));
+  first.RegisterAsset("TestFont", "test_font.ttf");
+  second.RegisterAsset("TestFont", "test_font.ttf");
+
+  sk_sp<SkTypeface> typeface =
+      first.MatchFamily("TestFont")->createTypeface(0);
+  ASSERT_NE(typeface, nullptr);
+  EXPECT_EQ(second.MatchFamily("TestFont")->createTypeface(0), typeface);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -47,6 +47,7 @@ std::shared_ptr<txt::FontCollection> FontCollection::GetFontCollection() const {
 
 void FontCollection::SetupDefaultFontManager(
     uint32_t font_initialization_data) {
+  std::scoped_lock lock(collection_->GetLayoutMutex());
   collection_->SetupDefaultFontManager(font_initialization_data);
 }
 
@@ -69,7 +70,10 @@ void FontCollection::SetupDefaultFontManager(
 void FontCollection::RegisterFonts(
     const std::shared_ptr<AssetManager>& asset_manager) {
 #if FML_OS_MACOSX || FML_OS_IOS
-  RegisterSystemFonts(*dynamic_font_manager_);
+  {
+    std::scoped_lock lock(collection_->GetLayoutMutex());
+    RegisterSystemFonts(*dynamic_font_manager_);
+  }
 #endif
   std::unique_ptr<fml::Mapping> manifest_mapping =
       asset_manager->GetAsMapping("FontManifest.json");
@@ -124,6 +128,7 @@ void FontCollection::RegisterFonts(
     }
   }
 
+  std::scoped_lock lock(collection_->GetLayoutMutex());
   collection_->SetAssetFontManager(
       sk_make_sp<txt::AssetFontManager>(std::move(font_provider)));
 }
@@ -142,6 +147,7 @@ void FontCollection::RegisterTestFonts() {
     index++;
   }
 
+  std::scoped_lock lock(collection_->GetLayoutMutex());
   collection_->SetTestFontManager(
       sk_make_sp<txt::TestFontManager>(std::move(font_provider), names));
 
@@ -164,12 +170,15 @@ void FontCollection::LoadFontFromList(Dart_Handle font_data_handle,
   sk_sp<SkTypeface> typeface = font_mgr->makeFromStream(std::move(font_stream));
   txt::TypefaceFontAssetProvider& font_provider =
       font_collection.dynamic_font_manager_->font_provider();
-  if (family_name.empty()) {
-    font_provider.RegisterTypeface(typeface);
-  } else {
-    font_provider.RegisterTypeface(typeface, family_name);
+  {
+    std::scoped_lock lock(font_collection.collection_->GetLayoutMutex());
+    if (family_name.empty()) {
+      font_provider.RegisterTypeface(typeface);
+    } else {
+      font_provider.RegisterTypeface(typeface, family_name);
+    }
+    font_collection.collection_->ClearFontFamilyCache();
   }
-  font_collection.collection_->ClearFontFamilyCache();
 
   font_data.Release();
   tonic::DartInvoke(callback, {tonic::ToDart(0)});
@@ -4,10 +4,15 @@
 
 #include "flutter/lib/ui/text/paragraph.h"
 
+#include <mutex>
+
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/dart/runtime/include/dart_api.h"
 #include "third_party/skia/modules/skparagraph/include/DartTypes.h"
 #include "third_party/skia/modules/skparagraph/include/Paragraph.h"
@@ -16,13 +21,16 @@
 #include "third_party/tonic/dart_binding_macros.h"
 #include "third_party/tonic/dart_library_natives.h"
 #include "third_party/tonic/logging/dart_invoke.h"
+#include "third_party/tonic/typed_data/typed_list.h"
 
 namespace flutter {
 
 IMPLEMENT_WRAPPERTYPEINFO(ui, Paragraph);
 
-Paragraph::Paragraph(std::unique_ptr<txt::Paragraph> paragraph)
-    : m_paragraph_(std::move(paragraph)) {}
+Paragraph::Paragraph(std::unique_ptr<txt::Paragraph> paragraph,
+                     std::shared_ptr<txt::FontCollection> font_collection)
+    : m_paragraph_(std::move(paragraph)),
+      m_font_collection_(std::move(font_collection)) {}
 
 Paragraph::~Paragraph() = default;
 
@@ -59,9 +67,93 @@ bool Paragraph::didExceedMaxLines() {
 }
 
 void Paragraph::layout(double width) {
+  std::scoped_lock lock(m_font_collection_->GetLayoutMutex());
   m_paragraph_->Layout(width);
 }
 
+Dart_Handle Paragraph::LayoutAll(Dart_Handle paragraphs,
+                                 Dart_Handle widths,
+                                 Dart_Handle callback) {
+  if (!Dart_IsClosure(callback)) {
+    return tonic::ToDart("Callback must be a function");
+  }
+  tonic::Float64List width_list(widths);
+  intptr_t count = 0;
+  if (Dart_IsError(Dart_ListLength(paragraphs, &count)) ||
+      count != static_cast<intptr_t>(width_list.num_elements())) {
+    return tonic::ToDart("Each paragraph needs exactly one width");
+  }
+
+  struct PendingLayout {
+    fml::RefPtr<Paragraph> paragraph;
+    std::unique_ptr<txt::Paragraph> txt_paragraph;
+    double width;
+  };
+  std::vector<PendingLayout> layouts;
+  layouts.reserve(count);
+  for (intptr_t i = 0; i < count; i++) {
+    auto* paragraph = tonic::DartConverter<Paragraph*>::FromDart(
+        Dart_ListGetAt(paragraphs, i));
+    if (!paragraph || !paragraph->m_paragraph_) {
+      // Hand back the paragraphs taken so far.
+      for (auto& layout : layouts) {
+        layout.paragraph->m_paragraph_ = std::move(layout.txt_paragraph);
+      }
+      return tonic::ToDart("Paragraph is disposed or is being laid out");
+    }
+    // The paragraph is unusable from Dart until it is handed back on the UI
+    // thread, so that the worker has exclusive access to it.
+    layouts.push_back({fml::Ref(paragraph), std::move(paragraph->m_paragraph_),
+                       width_list[i]});
+  }
+  width_list.Release();
+
+  auto* dart_state = UIDartState::Current();
+  auto persistent_callback =
+      std::make_unique<tonic::DartPersistentValue>(dart_state, callback);
+  auto ui_task_runner = dart_state->GetTaskRunners().GetUITaskRunner();
+
+  auto ui_task = fml::MakeCopyable(
+      [persistent_callback = std::move(persistent_callback)](
+          std::vector<PendingLayout> layouts) mutable {
+        for (auto& layout : layouts) {
+          layout.paragraph->m_paragraph_ = std::move(layout.txt_paragraph);
+        }
+        auto dart_state = persistent_callback->dart_state().lock();
+        if (!dart_state) {
+          // The root isolate could have died in the meantime.
+          return;
+        }
+        tonic::DartState::Scope scope(dart_state);
+        tonic::DartInvoke(persistent_callback->Get(), {Dart_Null()});
+
+        // The callback is associated with the Dart isolate and must be
+        // deleted on the UI thread.
+        persistent_callback.reset();
+      });
+
+  dart_state->GetConcurrentTaskRunner()->PostTask(fml::MakeCopyable(
+      [ui_task_runner, ui_task = std::move(ui_task),
+       layouts = std::move(layouts)]() mutable {
+        TRACE_EVENT0("flutter", "Paragraph::LayoutAll");
+        for (auto& layout : layouts) {
+          // Take the lock per paragraph so that layouts on the UI thread are
+          // not held up by the whole batch.
+          std::scoped_lock lock(layout.paragraph->m_font_collection_
+                                    ->GetLayoutMutex());
+          layout.txt_paragraph->Layout(layout.width);
+        }
+        // The paragraphs are handed back and released on the UI thread.
+        ui_task_runner->PostTask(fml::MakeCopyable(
+            [ui_task = std::move(ui_task),
+             layouts = std::move(layouts)]() mutable {
+              ui_task(std::move(layouts));
+            }));
+      }));
+
+  return Dart_Null();
+}
+
 void Paragraph::paint(Canvas* canvas, double x, double y) {
   if (!m_paragraph_ || !canvas) {
     // disposed.
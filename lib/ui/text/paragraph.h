@@ -9,21 +9,34 @@
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/canvas.h"
 #include "flutter/lib/ui/text/line_metrics.h"
+#include "flutter/third_party/txt/src/txt/font_collection.h"
 #include "flutter/third_party/txt/src/txt/paragraph.h"
 
 namespace flutter {
 
-class Paragraph : public RefCountedDartWrappable<Paragraph> {
+class Paragraph : public PooledDartWrappable<Paragraph> {
   DEFINE_WRAPPERTYPEINFO();
   FML_FRIEND_MAKE_REF_COUNTED(Paragraph);
 
  public:
   static void Create(Dart_Handle paragraph_handle,
-                     std::unique_ptr<txt::Paragraph> txt_paragraph) {
-    auto paragraph = fml::MakeRefCounted<Paragraph>(std::move(txt_paragraph));
+                     std::unique_ptr<txt::Paragraph> txt_paragraph,
+                     std::shared_ptr<txt::FontCollection> font_collection) {
+    auto paragraph = fml::MakeRefCounted<Paragraph>(std::move(txt_paragraph),
+                                                    std::move(font_collection));
     paragraph->AssociateWithDartWrapper(paragraph_handle);
   }
 
+  // Lays out each paragraph in the |paragraphs| list at the width at the same
+  // index of the |widths| Float64List on a worker thread, and invokes
+  // |callback| on the UI thread once all of them are laid out.
+  //
+  // The paragraphs must not be used until the callback is invoked. Returns an
+  // error string if the arguments are invalid, or null otherwise.
+  static Dart_Handle LayoutAll(Dart_Handle paragraphs,
+                               Dart_Handle widths,
+                               Dart_Handle callback);
+
   ~Paragraph() override;
 
   double width();
@@ -60,8 +73,12 @@ class Paragraph : public RefCountedDartWrappable<Paragraph> {
 
  private:
   std::unique_ptr<txt::Paragraph> m_paragraph_;
+  // Paragraphs are laid out while holding the layout lock of the font
+  // collection they were built from.
+  std::shared_ptr<txt::FontCollection> m_font_collection_;
 
-  explicit Paragraph(std::unique_ptr<txt::Paragraph> paragraph);
+  Paragraph(std::unique_ptr<txt::Paragraph> paragraph,
+            std::shared_ptr<txt::FontCollection> font_collection);
 };
 
 }  // namespace flutter
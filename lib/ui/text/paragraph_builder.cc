@@ -301,8 +301,9 @@ ParagraphBuilder::ParagraphBuilder(
                                         ->GetFontCollection();
 
   auto impeller_enabled = UIDartState::Current()->IsImpellerEnabled();
+  m_font_collection_ = font_collection.GetFontCollection();
   m_paragraph_builder_ = txt::ParagraphBuilder::CreateSkiaBuilder(
-      style, font_collection.GetFontCollection(), impeller_enabled);
+      style, m_font_collection_, impeller_enabled);
 }
 
 ParagraphBuilder::~ParagraphBuilder() = default;
@@ -532,7 +533,8 @@ void ParagraphBuilder::addPlaceholder(double width,
 }
 
 void ParagraphBuilder::build(Dart_Handle paragraph_handle) {
-  Paragraph::Create(paragraph_handle, m_paragraph_builder_->Build());
+  Paragraph::Create(paragraph_handle, m_paragraph_builder_->Build(),
+                    std::move(m_font_collection_));
   m_paragraph_builder_.reset();
   ClearDartWrapper();
 }
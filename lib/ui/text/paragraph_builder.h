@@ -81,6 +81,7 @@ class ParagraphBuilder : public RefCountedDartWrappable<ParagraphBuilder> {
                             bool applyRoundingHack);
 
   std::unique_ptr<txt::ParagraphBuilder> m_paragraph_builder_;
+  std::shared_ptr<txt::FontCollection> m_font_collection_;
 };
 
 }  // namespace flutter
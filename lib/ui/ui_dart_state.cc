@@ -69,6 +69,7 @@ UIDartState::UIDartState(
       unhandled_exception_callback_(std::move(unhandled_exception_callback)),
       log_message_callback_(std::move(log_message_callback)),
       isolate_name_server_(std::move(isolate_name_server)),
+      display_list_storage_arena_(DisplayListStorageArena::Create()),
       context_(context) {
   AddOrRemoveTaskObserver(true /* add */);
 }
@@ -147,6 +148,11 @@ std::shared_ptr<VolatilePathTracker> UIDartState::GetVolatilePathTracker()
   return context_.volatile_path_tracker;
 }
 
+std::shared_ptr<DisplayListStorageArena>
+UIDartState::GetDisplayListStorageArena() const {
+  return display_list_storage_arena_;
+}
+
 std::shared_ptr<fml::ConcurrentTaskRunner>
 UIDartState::GetConcurrentTaskRunner() const {
   return context_.concurrent_task_runner;
@@ -11,6 +11,7 @@
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/display_list/dl_storage_arena.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -132,6 +133,10 @@ class UIDartState : public tonic::DartState {
 
   std::shared_ptr<VolatilePathTracker> GetVolatilePathTracker() const;
 
+  /// The arena that PictureRecorders created in this isolate draw their
+  /// DisplayList storage from.
+  std::shared_ptr<DisplayListStorageArena> GetDisplayListStorageArena() const;
+
   std::shared_ptr<fml::ConcurrentTaskRunner> GetConcurrentTaskRunner() const;
 
   fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> GetSnapshotDelegate() const;
@@ -195,6 +200,7 @@ class UIDartState : public tonic::DartState {
   UnhandledExceptionCallback unhandled_exception_callback_;
   LogMessageCallback log_message_callback_;
   const std::shared_ptr<IsolateNameServer> isolate_name_server_;
+  const std::shared_ptr<DisplayListStorageArena> display_list_storage_arena_;
   UIDartState::Context context_;
 
   void AddOrRemoveTaskObserver(bool add);
@@ -150,6 +150,22 @@ class PlatformConfigurationClient {
   ///
   virtual void SetNeedsReportTimings(bool value) = 0;
 
+  //--------------------------------------------------------------------------
+  /// @brief      Requests that frames are produced at a rate within the given
+  ///             range, in frames per second. This accounts for all the
+  ///             animations that requested a frame rate range through
+  ///             `PlatformDispatcher.requestFrameRateRange`.
+  ///
+  /// @param[in]  minimum    The lowest rate the animations run well at.
+  /// @param[in]  maximum    The highest rate the animations benefit from.
+  /// @param[in]  preferred  The rate to produce frames at, or zero when no
+  ///                        animation requested a range and frames are
+  ///                        produced at the refresh rate of the display.
+  ///
+  virtual void SetFrameRateRange(double minimum,
+                                 double maximum,
+                                 double preferred) = 0;
+
   //--------------------------------------------------------------------------
   /// @brief      The embedder can specify data that the isolate can request
   ///             synchronously on launch. This accessor fetches that data.
@@ -563,6 +579,10 @@ class PlatformConfigurationNativeApi {
 
   static void SetNeedsReportTimings(bool value);
 
+  static void SetFrameRateRange(double minimum,
+                                double maximum,
+                                double preferred);
+
   static Dart_Handle GetPersistentIsolateData();
 
   static Dart_Handle ComputePlatformResolvedLocale(
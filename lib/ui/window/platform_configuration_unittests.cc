@@ -7,14 +7,17 @@
 #include "flutter/lib/ui/window/platform_configuration.h"
 
 #include <memory>
+#include <vector>
 
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/lib/ui/painting/vertices.h"
+#include "flutter/lib/ui/window/platform_message.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/testing.h"
+#include "third_party/tonic/converter/dart_converter.h"
 
 namespace flutter {
 namespace testing {
@@ -332,5 +335,62 @@ TEST_F(PlatformConfigurationTest, SetDartPerformanceMode) {
   DestroyShell(std::move(shell), task_runners);
 }
 
+TEST_F(PlatformConfigurationTest, DispatchesLargePlatformMessagesWithoutCopy) {
+  auto message_latch = std::make_shared<fml::AutoResetWaitableEvent>();
+  constexpr size_t kMessageSize = 4096;
+  const uint8_t* message_data = nullptr;
+
+  auto nativeSendLargePlatformMessage = [&message_data](
+                                            Dart_NativeArguments args) {
+    auto mapping = fml::MallocMapping::Copy(
+        std::vector<uint8_t>(kMessageSize, 1).data(), kMessageSize);
+    message_data = mapping.GetMapping();
+    UIDartState::Current()->platform_configuration()->DispatchPlatformMessage(
+        std::make_unique<PlatformMessage>("test/large", std::move(mapping),
+                                          nullptr));
+  };
+  auto nativeValidateLargePlatformMessage =
+      [message_latch, &message_data](Dart_NativeArguments args) {
+        EXPECT_EQ(tonic::DartConverter<int64_t>::FromDart(
+                      Dart_GetNativeArgument(args, 0)),
+                  static_cast<int64_t>(kMessageSize));
+        EXPECT_EQ(tonic::DartConverter<int64_t>::FromDart(
+                      Dart_GetNativeArgument(args, 1)),
+                  static_cast<int64_t>(kMessageSize));
+        EXPECT_EQ(tonic::DartConverter<int64_t>::FromDart(
+                      Dart_GetNativeArgument(args, 2)),
+                  0);
+        // The Dart byte data wraps the buffer that was dispatched.
+        EXPECT_EQ(message_data[0], 0u);
+        message_latch->Signal();
+      };
+
+  Settings settings = CreateSettingsForFixture();
+  TaskRunners task_runners("test",                  // label
+                           GetCurrentTaskRunner(),  // platform
+                           CreateNewThread(),       // raster
+                           CreateNewThread(),       // ui
+                           CreateNewThread()        // io
+  );
+
+  AddNativeCallback("SendLargePlatformMessage",
+                    CREATE_NATIVE_ENTRY(nativeSendLargePlatformMessage));
+  AddNativeCallback("ValidateLargePlatformMessage",
+                    CREATE_NATIVE_ENTRY(nativeValidateLargePlatformMessage));
+
+  std::unique_ptr<Shell> shell = CreateShell(settings, task_runners);
+
+  ASSERT_TRUE(shell->IsSetup());
+  auto run_configuration = RunConfiguration::InferFromSettings(settings);
+  run_configuration.SetEntrypoint("receiveLargePlatformMessage");
+
+  shell->RunEngine(std::move(run_configuration), [&](auto result) {
+    ASSERT_EQ(result, Engine::RunStatus::Success);
+  });
+
+  message_latch->Wait();
+  DestroyShell(std::move(shell), task_runners);
+}
+
 }  // namespace testing
 }  // namespace flutter
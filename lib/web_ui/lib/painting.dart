@@ -780,6 +780,8 @@ class ImmutableBuffer {
     throw UnsupportedError('ImmutableBuffer.fromFilePath is not supported on the web.');
   }
 
+  static Future<void> prefetchAssets(List<String> assetKeys) async {}
+
   Uint8List? _list;
 
   int get length => _length;
@@ -838,10 +840,13 @@ class ImageDescriptor {
   int get bytesPerPixel =>
       throw UnsupportedError('ImageDescriptor.bytesPerPixel is not supported on web.');
   void dispose() => _data = null;
-  Future<Codec> instantiateCodec({int? targetWidth, int? targetHeight}) async {
+  Future<Codec> instantiateCodec({int? targetWidth, int? targetHeight, Rect? region}) async {
     if (_data == null) {
       throw StateError('Object is disposed');
     }
+    if (region != null) {
+      throw UnsupportedError('ImageDescriptor.instantiateCodec region is not supported on web.');
+    }
     if (_width == null) {
       return instantiateImageCodec(
         _data!,
@@ -866,6 +871,8 @@ abstract class FragmentProgram {
 abstract class FragmentShader implements Shader {
   void setFloat(int index, double value);
 
+  void setFloats(int index, List<double> values);
+
   void setImageSampler(int index, Image image);
 
   @override
@@ -80,6 +80,8 @@ abstract class PlatformDispatcher {
 
   void scheduleFrame();
 
+  void requestFrameRateRange(Object requester, FrameRateRange? range) {}
+
   Future<void> render(Scene scene, [FlutterView view]);
 
   AccessibilityFeatures get accessibilityFeatures;
@@ -164,6 +166,7 @@ enum _FrameTimingInfo {
   layerCacheBytes,
   pictureCacheCount,
   pictureCacheBytes,
+  gpuDuration,
   frameNumber,
 }
 
@@ -179,6 +182,7 @@ class FrameTiming {
     int layerCacheBytes = 0,
     int pictureCacheCount = 0,
     int pictureCacheBytes = 0,
+    int gpuDuration = 0,
     int frameNumber = 1,
   }) {
     return FrameTiming._(<int>[
@@ -192,6 +196,7 @@ class FrameTiming {
       layerCacheBytes,
       pictureCacheCount,
       pictureCacheBytes,
+      gpuDuration,
       frameNumber,
     ]);
   }
@@ -218,6 +223,8 @@ class FrameTiming {
   Duration get totalSpan =>
       _rawDuration(FramePhase.rasterFinish) - _rawDuration(FramePhase.vsyncStart);
 
+  Duration get gpuDuration => Duration(microseconds: _rawInfo(_FrameTimingInfo.gpuDuration));
+
   int get layerCacheCount => _rawInfo(_FrameTimingInfo.layerCacheCount);
 
   int get layerCacheBytes => _rawInfo(_FrameTimingInfo.layerCacheBytes);
@@ -510,6 +517,38 @@ class Locale {
   }
 }
 
+class FrameRateRange {
+  const FrameRateRange({
+    required this.minimum,
+    required this.maximum,
+    double? preferred,
+  }) : assert(minimum > 0.0),
+       assert(maximum >= minimum),
+       assert(preferred == null || (preferred >= minimum && preferred <= maximum)),
+       preferred = preferred ?? maximum;
+
+  final double minimum;
+  final double maximum;
+  final double preferred;
+
+  @override
+  bool operator ==(Object other) {
+    if (identical(this, other)) {
+      return true;
+    }
+    return other is FrameRateRange &&
+        other.minimum == minimum &&
+        other.maximum == maximum &&
+        other.preferred == preferred;
+  }
+
+  @override
+  int get hashCode => Object.hash(minimum, maximum, preferred);
+
+  @override
+  String toString() => 'FrameRateRange(minimum: $minimum, maximum: $maximum, preferred: $preferred)';
+}
+
 enum DartPerformanceMode {
   balanced,
   latency,
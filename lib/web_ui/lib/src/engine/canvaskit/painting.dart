@@ -378,6 +378,12 @@ class CkFragmentShader implements ui.FragmentShader, CkShader {
     floats[index] = value;
   }
 
+  @override
+  void setFloats(int index, List<double> values) {
+    assert(!_debugDisposed, 'FragmentShader has been disposed of.');
+    floats.setRange(index, index + values.length, values);
+  }
+
   @override
   void setImageSampler(int index, ui.Image image) {
     assert(!_debugDisposed, 'FragmentShader has been disposed of.');
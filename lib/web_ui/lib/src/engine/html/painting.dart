@@ -303,6 +303,11 @@ class HtmlFragmentShader implements ui.FragmentShader {
     throw UnsupportedError('FragmentShader is not supported for the HTML renderer.');
   }
 
+  @override
+  void setFloats(int index, List<double> values) {
+    throw UnsupportedError('FragmentShader is not supported for the HTML renderer.');
+  }
+
   @override
   void setImageSampler(int index, ui.Image image) {
     throw UnsupportedError('FragmentShader is not supported for the HTML renderer.');
@@ -296,6 +296,20 @@ class SkwasmFragmentShader implements SkwasmShader, ui.FragmentShader {
     dataPointer[index] = value;
   }
 
+  @override
+  void setFloats(int index, List<double> values) {
+    if (_nativeShader != null) {
+      // Invalidate the previous shader so that it is recreated with the new
+      // uniform data.
+      _nativeShader!.dispose();
+      _nativeShader = null;
+    }
+    final Pointer<Float> dataPointer = skDataGetPointer(_uniformData.handle).cast<Float>();
+    for (int i = 0; i < values.length; i++) {
+      dataPointer[index + i] = values[i];
+    }
+  }
+
   @override
   void setImageSampler(int index, ui.Image image) {
     if (_nativeShader != null) {
@@ -756,6 +756,18 @@ abstract class ParagraphBuilder {
   });
 }
 
+// The web has no background threads to lay out text on, so the paragraphs are
+// laid out right away.
+Future<void> layoutParagraphs(List<Paragraph> paragraphs, List<ParagraphConstraints> constraints) {
+  if (paragraphs.length != constraints.length) {
+    throw ArgumentError('Each paragraph needs exactly one set of constraints.');
+  }
+  for (int index = 0; index < paragraphs.length; index += 1) {
+    paragraphs[index].layout(constraints[index]);
+  }
+  return Future<void>.value();
+}
+
 Future<void> loadFontFromList(Uint8List list, {String? fontFamily}) async {
   await engine.renderer.fontCollection.loadFontFromList(list, fontFamily: fontFamily);
   engine.sendFontChangeMessage();
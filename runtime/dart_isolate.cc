@@ -179,6 +179,78 @@ std::weak_ptr<DartIsolate> DartIsolate::CreateRunningRootIsolate(
   return isolate;
 }
 
+std::weak_ptr<DartIsolate> DartIsolate::CreateWorkerIsolate(
+    const Settings& settings,
+    const UIDartState::Context& context,
+    const DartIsolate& group_isolate) {
+  TRACE_EVENT0("flutter", "DartIsolate::CreateWorkerIsolate");
+  fml::RefPtr<const DartSnapshot> isolate_snapshot =
+      group_isolate.GetIsolateGroupData().GetIsolateSnapshot();
+  if (!isolate_snapshot) {
+    return {};
+  }
+
+  // Like the isolates spawned by the VM, worker isolates are not root
+  // isolates, so UI operations throw in them instead of reaching for a
+  // platform configuration they do not have. Unlike those isolates, they
+  // handle their messages on the UI task runner in |context|.
+  auto isolate_data = std::make_unique<std::shared_ptr<DartIsolate>>(
+      std::shared_ptr<DartIsolate>(new DartIsolate(
+          /*settings=*/settings,
+          /*is_root_isolate=*/false,
+          /*context=*/context,
+          /*is_spawning_in_group=*/true,
+          /*is_worker_isolate=*/true)));
+
+  DartErrorString error;
+  auto isolate_flags = Flags().Get();
+
+  // The isolate is prepared to run by the child isolate preparer of the
+  // group, which the group isolate has set up by the time it is running.
+  Dart_Isolate vm_isolate = CreateDartIsolateGroup(
+      nullptr, std::move(isolate_data), &isolate_flags, error.error(),
+      [&group_isolate](
+          std::shared_ptr<DartIsolateGroupData>* isolate_group_data,
+          std::shared_ptr<DartIsolate>* isolate_data, Dart_IsolateFlags* flags,
+          char** error) {
+        return Dart_CreateIsolateInGroup(
+            /*group_member=*/group_isolate.isolate(),
+            /*name=*/
+            group_isolate.GetIsolateGroupData()
+                .GetAdvisoryScriptEntrypoint()
+                .c_str(),
+            /*shutdown_callback=*/
+            reinterpret_cast<Dart_IsolateShutdownCallback>(
+                DartIsolate::SpawnIsolateShutdownCallback),
+            /*cleanup_callback=*/
+            reinterpret_cast<Dart_IsolateCleanupCallback>(
+                DartIsolateCleanupCallback),
+            /*child_isolate_data=*/isolate_data,
+            /*error=*/error);
+      });
+
+  if (error) {
+    FML_LOG(ERROR) << "CreateWorkerIsolate failed: " << error.str();
+  }
+
+  if (vm_isolate == nullptr) {
+    return {};
+  }
+
+  std::shared_ptr<DartIsolate>* worker_isolate_data =
+      static_cast<std::shared_ptr<DartIsolate>*>(Dart_IsolateData(vm_isolate));
+
+  if ((*worker_isolate_data)->GetPhase() != DartIsolate::Phase::Ready) {
+    FML_LOG(ERROR) << "Could not prepare worker isolate.";
+    if (!(*worker_isolate_data)->Shutdown()) {
+      FML_DLOG(ERROR) << "Could not shutdown worker isolate.";
+    }
+    return {};
+  }
+
+  return (*worker_isolate_data)->GetWeakIsolatePtr();
+}
+
 void DartIsolate::SpawnIsolateShutdownCallback(
     std::shared_ptr<DartIsolateGroupData>* isolate_group_data,
     std::shared_ptr<DartIsolate>* isolate_data) {
@@ -283,7 +355,8 @@ std::weak_ptr<DartIsolate> DartIsolate::CreateRootIsolate(
 DartIsolate::DartIsolate(const Settings& settings,
                          bool is_root_isolate,
                          const UIDartState::Context& context,
-                         bool is_spawning_in_group)
+                         bool is_spawning_in_group,
+                         bool is_worker_isolate)
     : UIDartState(settings.task_observer_add,
                   settings.task_observer_remove,
                   settings.log_tag,
@@ -295,12 +368,14 @@ DartIsolate::DartIsolate(const Settings& settings,
       may_insecurely_connect_to_all_domains_(
           settings.may_insecurely_connect_to_all_domains),
       domain_network_policy_(settings.domain_network_policy),
-      is_spawning_in_group_(is_spawning_in_group) {
+      is_spawning_in_group_(is_spawning_in_group),
+      is_worker_isolate_(is_worker_isolate) {
   phase_ = Phase::Uninitialized;
 }
 
 DartIsolate::~DartIsolate() {
-  if (IsRootIsolate() && GetMessageHandlingTaskRunner()) {
+  if ((IsRootIsolate() || is_worker_isolate_) &&
+      GetMessageHandlingTaskRunner()) {
     FML_DCHECK(GetMessageHandlingTaskRunner()->RunsTasksOnCurrentThread());
   }
 }
@@ -393,7 +468,7 @@ void DartIsolate::LoadLoadingUnitError(intptr_t loading_unit_id,
 
 void DartIsolate::SetMessageHandlingTaskRunner(
     const fml::RefPtr<fml::TaskRunner>& runner) {
-  if (!IsRootIsolate() || !runner) {
+  if ((!IsRootIsolate() && !is_worker_isolate_) || !runner) {
     return;
   }
 
@@ -224,6 +224,32 @@ class DartIsolate : public UIDartState {
       const UIDartState::Context& context,
       const DartIsolate* spawning_isolate = nullptr);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a worker isolate in the isolate group of
+  ///             `group_isolate` that shares its snapshot, and returns a weak
+  ///             pointer to it. No entrypoint is run: the isolate is left in
+  ///             the `Phase::Ready` phase, ready for its caller to invoke
+  ///             functions of its root library.
+  ///
+  ///             Like the isolates spawned by the VM, the isolate is not a
+  ///             root isolate, so UI operations throw in it. Like root
+  ///             isolates, it handles its messages on the UI task runner in
+  ///             `context`, and may only be used on that task runner.
+  ///
+  /// @param[in]  settings       The settings used to create the isolate.
+  /// @param[in]  context        Engine-owned state which is accessed by the
+  ///                            isolate.
+  /// @param[in]  group_isolate  A running isolate of the group to create the
+  ///                            isolate in.
+  ///
+  /// @return     A weak pointer to the isolate, which is empty if it could
+  ///             not be created.
+  ///
+  static std::weak_ptr<DartIsolate> CreateWorkerIsolate(
+      const Settings& settings,
+      const UIDartState::Context& context,
+      const DartIsolate& group_isolate);
+
   // |UIDartState|
   ~DartIsolate() override;
 
@@ -414,6 +440,7 @@ class DartIsolate : public UIDartState {
   const bool may_insecurely_connect_to_all_domains_;
   std::string domain_network_policy_;
   const bool is_spawning_in_group_;
+  const bool is_worker_isolate_;
 
   static std::weak_ptr<DartIsolate> CreateRootIsolate(
       const Settings& settings,
@@ -428,7 +455,8 @@ class DartIsolate : public UIDartState {
   DartIsolate(const Settings& settings,
               bool is_root_isolate,
               const UIDartState::Context& context,
-              bool is_spawning_in_group = false);
+              bool is_spawning_in_group = false,
+              bool is_worker_isolate = false);
 
   //----------------------------------------------------------------------------
   /// @brief      Initializes the given (current) isolate.
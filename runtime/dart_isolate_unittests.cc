@@ -4,12 +4,16 @@
 
 #include "flutter/runtime/dart_isolate.h"
 
+#include <algorithm>
+#include <mutex>
+
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/runtime/isolate_configuration.h"
+#include "flutter/runtime/worker_isolate_pool.h"
 #include "flutter/testing/dart_isolate_runner.h"
 #include "flutter/testing/fixture_test.h"
 #include "flutter/testing/testing.h"
@@ -695,6 +699,96 @@ TEST_F(DartIsolateTest, SpawningAnIsolateDoesNotReloadKernel) {
   ASSERT_TRUE(root_isolate->Shutdown());
 }
 
+TEST_F(DartIsolateTest, WorkerIsolatesRunFunctionsOfTheRootLibrary) {
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+  const auto settings = CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  auto thread = CreateNewThread();
+  TaskRunners task_runners(GetCurrentTestName(),  //
+                           thread,                //
+                           thread,                //
+                           thread,                //
+                           thread                 //
+  );
+  auto isolate = RunDartCodeInIsolate(vm_ref, settings, task_runners, "main",
+                                      {}, GetDefaultKernelFilePath());
+  ASSERT_TRUE(isolate);
+  ASSERT_EQ(isolate->get()->GetPhase(), DartIsolate::Phase::Running);
+
+  std::mutex mutex;
+  std::vector<std::vector<uint8_t>> results;
+  size_t failed_count = 0;
+  fml::CountDownLatch latch(4);
+  auto callback = [&](std::unique_ptr<fml::Mapping> result) {
+    {
+      std::scoped_lock lock(mutex);
+      if (result) {
+        results.emplace_back(result->GetMapping(),
+                             result->GetMapping() + result->GetSize());
+      } else {
+        failed_count++;
+      }
+    }
+    latch.CountDown();
+  };
+
+  {
+    UIDartState::Context context(task_runners);
+    WorkerIsolatePool pool(settings, context, *isolate->get(), 2);
+    const uint8_t bytes[] = {1, 2, 3};
+    pool.PostTask("reverseBytes",
+                  std::make_unique<fml::NonOwnedMapping>(bytes, sizeof(bytes)),
+                  callback);
+    pool.PostTask("reverseBytes",
+                  std::make_unique<fml::NonOwnedMapping>(bytes, 1u), callback);
+    pool.PostTask("reverseBytes", nullptr, callback);
+    pool.PostTask("doesNotExist", nullptr, callback);
+    latch.Wait();
+  }
+
+  std::sort(results.begin(), results.end());
+  ASSERT_EQ(results.size(), 2u);
+  EXPECT_EQ(results[0], std::vector<uint8_t>({1}));
+  EXPECT_EQ(results[1], std::vector<uint8_t>({3, 2, 1}));
+  EXPECT_EQ(failed_count, 2u);
+}
+
+TEST_F(DartIsolateTest, UIOperationsThrowOnWorkerIsolates) {
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+  const auto settings = CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  auto thread = CreateNewThread();
+  TaskRunners task_runners(GetCurrentTestName(),  //
+                           thread,                //
+                           thread,                //
+                           thread,                //
+                           thread                 //
+  );
+  auto isolate = RunDartCodeInIsolate(vm_ref, settings, task_runners, "main",
+                                      {}, GetDefaultKernelFilePath());
+  ASSERT_TRUE(isolate);
+  ASSERT_EQ(isolate->get()->GetPhase(), DartIsolate::Phase::Running);
+
+  std::vector<uint8_t> result;
+  fml::AutoResetWaitableEvent latch;
+  {
+    UIDartState::Context context(task_runners);
+    WorkerIsolatePool pool(settings, context, *isolate->get(), 1);
+    pool.PostTask("scheduleFrameOnWorker", nullptr,
+                  [&](std::unique_ptr<fml::Mapping> mapping) {
+                    if (mapping) {
+                      result.assign(mapping->GetMapping(),
+                                    mapping->GetMapping() + mapping->GetSize());
+                    }
+                    latch.Signal();
+                  });
+    latch.Wait();
+  }
+
+  // The worker caught the exception thrown by `scheduleFrame`.
+  EXPECT_EQ(result, std::vector<uint8_t>({1}));
+}
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -6,6 +6,7 @@
 
 #include <sstream>
 
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/native_library.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
@@ -32,10 +33,16 @@ const char* DartSnapshot::kIsolateInstructionsSymbol =
 static std::unique_ptr<const fml::Mapping> GetFileMapping(
     const std::string& path,
     bool executable) {
+  fml::FileMapping::Advice advice;
+  advice.huge_pages = true;
   if (executable) {
-    return fml::FileMapping::CreateReadExecute(path);
+    // Instructions are faulted in as they run, have them read ahead.
+    advice.will_need = true;
+    return fml::FileMapping::CreateReadExecute(path, advice);
   } else {
-    return fml::FileMapping::CreateReadOnly(path);
+    // Data snapshots are read in full when the VM or an isolate starts.
+    advice.populate = true;
+    return fml::FileMapping::CreateReadOnly(path, advice);
   }
 }
 
@@ -264,6 +271,22 @@ bool DartSnapshot::IsDontNeedSafe() const {
   return true;
 }
 
+bool DartSnapshot::Prefetch(bool instructions,
+                            size_t offset,
+                            size_t length) const {
+  const auto& mapping = instructions ? instructions_ : data_;
+  if (!mapping || mapping->GetMapping() == nullptr) {
+    return false;
+  }
+  // Symbol mappings don't know their size, so their ranges can't be checked.
+  // A range past the end is at worst a wasted hint.
+  const size_t size = mapping->GetSize();
+  if (size != 0 && (offset > size || length > size - offset)) {
+    return false;
+  }
+  return fml::PrefetchMappedPages(mapping->GetMapping() + offset, length);
+}
+
 bool DartSnapshot::IsNullSafetyEnabled(const fml::Mapping* kernel) const {
   return ::Dart_DetectNullSafety(
       nullptr,           // script_uri (unsupported by Flutter)
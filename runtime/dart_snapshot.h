@@ -165,6 +165,20 @@ class DartSnapshot : public fml::RefCountedThreadSafe<DartSnapshot> {
   ///             safe to use with madvise(DONTNEED).
   bool IsDontNeedSafe() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Asks the OS to read a range of the heap or instructions
+  ///             snapshot in the background, ahead of its first use.
+  ///
+  /// @param[in]  instructions  Whether the range is in the instructions
+  ///                           snapshot rather than the heap snapshot.
+  /// @param[in]  offset        The offset of the range in the snapshot.
+  /// @param[in]  length        The length of the range in bytes.
+  ///
+  /// @return     Returns false if the snapshot component is absent, the range
+  ///             is outside of it, or the OS cannot prefetch it.
+  ///
+  bool Prefetch(bool instructions, size_t offset, size_t length) const;
+
   bool IsNullSafetyEnabled(
       const fml::Mapping* application_kernel_mapping) const;
 
@@ -15,12 +15,14 @@
 #include "flutter/fml/logging.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/size.h"
+#include "flutter/fml/thread_scheduling.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/dart_ui.h"
 #include "flutter/runtime/dart_isolate.h"
 #include "flutter/runtime/dart_vm_initializer.h"
 #include "flutter/runtime/ptrace_check.h"
+#include "flutter/runtime/startup_page_profile.h"
 #include "third_party/dart/runtime/include/bin/dart_io_api.h"
 #include "third_party/skia/include/core/SkExecutor.h"
 #include "third_party/tonic/converter/dart_converter.h"
@@ -306,6 +308,20 @@ DartVM::DartVM(const std::shared_ptr<const DartVMData>& vm_data,
   FML_DCHECK(isolate_name_server_);
   FML_DCHECK(service_protocol_);
 
+  // Read the snapshot pages the application touches while starting in the
+  // background, so that the VM and the root isolate don't fault them in one
+  // at a time.
+  if (!settings_.startup_page_profile_path.empty()) {
+    concurrent_message_loop_->GetTaskRunner()->PostTask(
+        [path = settings_.startup_page_profile_path, vm_data = vm_data_]() {
+          auto profile = StartupPageProfile::ReadFromFile(path);
+          if (profile.has_value()) {
+            profile->Prefetch(vm_data->GetVMSnapshot(),
+                              *vm_data->GetIsolateSnapshot());
+          }
+        });
+  }
+
   {
     TRACE_EVENT0("flutter", "dart::bin::BootstrapDartIo");
     dart::bin::BootstrapDartIo();
@@ -510,6 +526,18 @@ DartVM::DartVM(const std::shared_ptr<const DartVMData>& vm_data,
   // Update thread names now that the Dart VM is initialized.
   concurrent_message_loop_->PostTaskToAllWorkers(
       [] { Dart_SetThreadName("FlutterConcurrentMessageLoopWorker"); });
+
+  if (!settings_.worker_thread_policy.IsEmpty()) {
+    concurrent_message_loop_->PostTaskToAllWorkers(
+        [policy = settings_.worker_thread_policy]() {
+          if (!fml::ApplyThreadSchedulingPolicy(policy)) {
+            FML_LOG(ERROR) << "Could not apply every scheduling setting of a "
+                              "worker thread.";
+          }
+          FML_LOG(INFO) << "Scheduling of a worker thread: "
+                        << fml::DescribeCurrentThreadScheduling();
+        });
+  }
 }
 
 DartVM::~DartVM() {
@@ -4,6 +4,7 @@
 
 import 'dart:async';
 import 'dart:isolate';
+import 'dart:typed_data';
 import 'dart:ui';
 
 import 'split_lib_test.dart' deferred as splitlib;
@@ -188,3 +189,23 @@ void mainForPluginRegistrantTest() {
     passMessage('_PluginRegistrant.register() was not called');
   }
 }
+
+@pragma('vm:entry-point')
+ByteData? reverseBytes(ByteData? data) {
+  if (data == null) {
+    return null;
+  }
+  final Uint8List bytes = data.buffer.asUint8List(
+      data.offsetInBytes, data.lengthInBytes);
+  return Uint8List.fromList(bytes.reversed.toList()).buffer.asByteData();
+}
+
+@pragma('vm:entry-point')
+ByteData? scheduleFrameOnWorker(ByteData? data) {
+  try {
+    PlatformDispatcher.instance.scheduleFrame();
+  } catch (_) {
+    return ByteData(1)..setUint8(0, 1);
+  }
+  return ByteData(1);
+}
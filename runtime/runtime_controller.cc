@@ -80,6 +80,8 @@ std::unique_ptr<RuntimeController> RuntimeController::Spawn(
 
 RuntimeController::~RuntimeController() {
   FML_DCHECK(Dart_CurrentIsolate() == nullptr);
+  // The workers are in the isolate group of the root isolate.
+  worker_isolate_pool_.reset();
   std::shared_ptr<DartIsolate> root_isolate = root_isolate_.lock();
   if (root_isolate) {
     root_isolate->SetReturnCodeCallback(nullptr);
@@ -387,6 +389,13 @@ void RuntimeController::SetNeedsReportTimings(bool value) {
   client_.SetNeedsReportTimings(value);
 }
 
+// |PlatformConfigurationClient|
+void RuntimeController::SetFrameRateRange(double minimum,
+                                          double maximum,
+                                          double preferred) {
+  client_.SetFrameRateRange(minimum, maximum, preferred);
+}
+
 // |PlatformConfigurationClient|
 std::shared_ptr<const fml::Mapping>
 RuntimeController::GetPersistentIsolateData() {
@@ -489,6 +498,12 @@ bool RuntimeController::LaunchRootIsolate(
 
   FML_DCHECK(Dart_CurrentIsolate() == nullptr);
 
+  if (settings.worker_isolate_count > 0) {
+    worker_isolate_pool_ = std::make_unique<WorkerIsolatePool>(
+        settings, context_, *strong_root_isolate,
+        settings.worker_isolate_count);
+  }
+
   client_.OnRootIsolateCreated();
 
   return true;
@@ -501,6 +516,18 @@ std::optional<std::string> RuntimeController::GetRootIsolateServiceID() const {
   return std::nullopt;
 }
 
+void RuntimeController::RunInWorkerIsolate(
+    std::string function,
+    std::unique_ptr<fml::Mapping> message,
+    WorkerIsolatePool::TaskCallback callback) {
+  if (!worker_isolate_pool_) {
+    callback(nullptr);
+    return;
+  }
+  worker_isolate_pool_->PostTask(std::move(function), std::move(message),
+                                 std::move(callback));
+}
+
 std::optional<uint32_t> RuntimeController::GetRootIsolateReturnCode() {
   return root_isolate_return_code_;
 }
@@ -22,6 +22,7 @@
 #include "flutter/lib/ui/window/pointer_data_packet.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/runtime/platform_data.h"
+#include "flutter/runtime/worker_isolate_pool.h"
 #include "rapidjson/document.h"
 #include "rapidjson/stringbuffer.h"
 
@@ -521,6 +522,22 @@ class RuntimeController : public PlatformConfigurationClient {
   ///             be established.
   uint64_t GetRootIsolateGroup() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Invokes a top-level function of the root library on one of
+  ///             the worker isolates created for
+  ///             `Settings::worker_isolate_count` when the root isolate was
+  ///             launched. See |WorkerIsolatePool::PostTask|.
+  ///
+  /// @param[in]  function  The name of the function in the root library.
+  /// @param[in]  message   The bytes passed to the function, may be nullptr.
+  /// @param[in]  callback  The callback invoked on the worker thread with the
+  ///                       returned `ByteData`. It is invoked with nullptr
+  ///                       right away if there are no worker isolates.
+  ///
+  void RunInWorkerIsolate(std::string function,
+                          std::unique_ptr<fml::Mapping> message,
+                          WorkerIsolatePool::TaskCallback callback);
+
   //--------------------------------------------------------------------------
   /// @brief      Loads the Dart shared library into the Dart VM. When the
   ///             Dart library is loaded successfully, the Dart future
@@ -645,6 +662,7 @@ class RuntimeController : public PlatformConfigurationClient {
   const fml::closure isolate_shutdown_callback_;
   std::shared_ptr<const fml::Mapping> persistent_isolate_data_;
   UIDartState::Context context_;
+  std::unique_ptr<WorkerIsolatePool> worker_isolate_pool_;
   bool has_flushed_runtime_state_ = false;
 
   PlatformConfiguration* GetPlatformConfigurationIfAvailable();
@@ -679,6 +697,11 @@ class RuntimeController : public PlatformConfigurationClient {
   // |PlatformConfigurationClient|
   void SetNeedsReportTimings(bool value) override;
 
+  // |PlatformConfigurationClient|
+  void SetFrameRateRange(double minimum,
+                         double maximum,
+                         double preferred) override;
+
   // |PlatformConfigurationClient|
   std::unique_ptr<std::vector<std::string>> ComputePlatformResolvedLocale(
       const std::vector<std::string>& supported_locale_data) override;
@@ -45,6 +45,10 @@ class RuntimeDelegate {
 
   virtual void SetNeedsReportTimings(bool value) = 0;
 
+  virtual void SetFrameRateRange(double minimum,
+                                 double maximum,
+                                 double preferred) = 0;
+
   virtual std::unique_ptr<std::vector<std::string>>
   ComputePlatformResolvedLocale(
       const std::vector<std::string>& supported_locale_data) = 0;
@@ -40,8 +40,18 @@ const std::string_view
 const std::string_view
     ServiceProtocol::kRenderFrameWithRasterStatsExtensionName =
         "_flutter.renderFrameWithRasterStats";
+const std::string_view ServiceProtocol::kSampleLayerCostsExtensionName =
+    "_flutter.sampleLayerCosts";
 const std::string_view ServiceProtocol::kReloadAssetFonts =
     "_flutter.reloadAssetFonts";
+const std::string_view ServiceProtocol::kGetParagraphCacheStatsExtensionName =
+    "_flutter.getParagraphCacheStats";
+const std::string_view ServiceProtocol::kGetEngineMemoryUsageExtensionName =
+    "_flutter.getEngineMemoryUsage";
+const std::string_view ServiceProtocol::kGetAllocationCountsExtensionName =
+    "_flutter.getAllocationCounts";
+const std::string_view ServiceProtocol::kGetJankTraceExtensionName =
+    "_flutter.getJankTrace";
 
 static constexpr std::string_view kViewIdPrefx = "_flutterView/";
 static constexpr std::string_view kListViewsExtensionName =
@@ -62,7 +72,12 @@ ServiceProtocol::ServiceProtocol()
           kGetSkSLsExtensionName,
           kEstimateRasterCacheMemoryExtensionName,
           kRenderFrameWithRasterStatsExtensionName,
+          kSampleLayerCostsExtensionName,
           kReloadAssetFonts,
+          kGetParagraphCacheStatsExtensionName,
+          kGetEngineMemoryUsageExtensionName,
+          kGetAllocationCountsExtensionName,
+          kGetJankTraceExtensionName,
       }),
       handlers_mutex_(fml::SharedMutex::Create()) {}
 
@@ -30,7 +30,12 @@ class ServiceProtocol {
   static const std::string_view kGetSkSLsExtensionName;
   static const std::string_view kEstimateRasterCacheMemoryExtensionName;
   static const std::string_view kRenderFrameWithRasterStatsExtensionName;
+  static const std::string_view kSampleLayerCostsExtensionName;
   static const std::string_view kReloadAssetFonts;
+  static const std::string_view kGetParagraphCacheStatsExtensionName;
+  static const std::string_view kGetEngineMemoryUsageExtensionName;
+  static const std::string_view kGetAllocationCountsExtensionName;
+  static const std::string_view kGetJankTraceExtensionName;
 
   class Handler {
    public:
@@ -0,0 +1,125 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/startup_page_profile.h"
+
+#include <charconv>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+std::string_view TrimWhitespace(std::string_view text) {
+  const auto begin = text.find_first_not_of(" \t\r");
+  if (begin == std::string_view::npos) {
+    return {};
+  }
+  const auto end = text.find_last_not_of(" \t\r");
+  return text.substr(begin, end - begin + 1);
+}
+
+// Removes the next whitespace separated token from |text| and returns it.
+std::string_view NextToken(std::string_view& text) {
+  text = TrimWhitespace(text);
+  const auto end = text.find_first_of(" \t");
+  const auto token = text.substr(0, end);
+  text = end == std::string_view::npos ? std::string_view{} : text.substr(end);
+  return token;
+}
+
+bool ParseSize(std::string_view token, size_t* value) {
+  int base = 10;
+  if (token.size() > 2 && token[0] == '0' &&
+      (token[1] == 'x' || token[1] == 'X')) {
+    token.remove_prefix(2);
+    base = 16;
+  }
+  const char* end = token.data() + token.size();
+  auto result = std::from_chars(token.data(), end, *value, base);
+  return !token.empty() && result.ec == std::errc() && result.ptr == end;
+}
+
+bool ParseSnapshot(std::string_view token,
+                   StartupPageProfile::Snapshot* snapshot) {
+  using Snapshot = StartupPageProfile::Snapshot;
+  if (token == "vm_data") {
+    *snapshot = Snapshot::kVMData;
+  } else if (token == "vm_instructions") {
+    *snapshot = Snapshot::kVMInstructions;
+  } else if (token == "isolate_data") {
+    *snapshot = Snapshot::kIsolateData;
+  } else if (token == "isolate_instructions") {
+    *snapshot = Snapshot::kIsolateInstructions;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+std::optional<StartupPageProfile> StartupPageProfile::Parse(
+    std::string_view profile) {
+  StartupPageProfile result;
+  size_t line_number = 0;
+  while (!profile.empty()) {
+    line_number++;
+    const auto line_end = profile.find('\n');
+    auto line = TrimWhitespace(profile.substr(0, line_end));
+    profile = line_end == std::string_view::npos ? std::string_view{}
+                                                 : profile.substr(line_end + 1);
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    Range range;
+    if (!ParseSnapshot(NextToken(line), &range.snapshot) ||
+        !ParseSize(NextToken(line), &range.offset) ||
+        !ParseSize(NextToken(line), &range.length) ||
+        !TrimWhitespace(line).empty()) {
+      FML_LOG(ERROR) << "Malformed startup page profile entry on line "
+                     << line_number << ".";
+      return std::nullopt;
+    }
+    result.ranges_.push_back(range);
+  }
+  return result;
+}
+
+std::optional<StartupPageProfile> StartupPageProfile::ReadFromFile(
+    const std::string& path) {
+  auto mapping = fml::FileMapping::CreateReadOnly(path);
+  if (!mapping) {
+    FML_LOG(ERROR) << "Could not read the startup page profile at " << path;
+    return std::nullopt;
+  }
+  return Parse(std::string_view(
+      reinterpret_cast<const char*>(mapping->GetMapping()),
+      mapping->GetSize()));
+}
+
+size_t StartupPageProfile::Prefetch(
+    const DartSnapshot& vm_snapshot,
+    const DartSnapshot& isolate_snapshot) const {
+  TRACE_EVENT0("flutter", "StartupPageProfile::Prefetch");
+  size_t prefetched = 0;
+  for (const auto& range : ranges_) {
+    const bool is_vm = range.snapshot == Snapshot::kVMData ||
+                       range.snapshot == Snapshot::kVMInstructions;
+    const bool is_instructions =
+        range.snapshot == Snapshot::kVMInstructions ||
+        range.snapshot == Snapshot::kIsolateInstructions;
+    const auto& snapshot = is_vm ? vm_snapshot : isolate_snapshot;
+    if (snapshot.Prefetch(is_instructions, range.offset, range.length)) {
+      prefetched++;
+    }
+  }
+  return prefetched;
+}
+
+}  // namespace flutter
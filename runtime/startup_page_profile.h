@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_RUNTIME_STARTUP_PAGE_PROFILE_H_
+#define FLUTTER_RUNTIME_STARTUP_PAGE_PROFILE_H_
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flutter/runtime/dart_snapshot.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      The ranges of the Dart snapshots that an application touches
+///             while it starts, as recorded by a profiling run.
+///
+///             Snapshots are mapped lazily, so a cold start takes a page fault
+///             for every page it touches. Prefetching the ranges listed in the
+///             profile on a background thread lets the OS read them ahead of
+///             time while the rest of the engine is being set up.
+///
+///             The profile is a text file with one range per line:
+///
+///             ```
+///             # <snapshot> <offset> <length>
+///             isolate_instructions 0x4000 0x9000
+///             isolate_data 0 65536
+///             ```
+///
+///             where `<snapshot>` is one of `vm_data`, `vm_instructions`,
+///             `isolate_data` or `isolate_instructions`. Offsets and lengths
+///             are in bytes, in decimal or in hexadecimal with a `0x` prefix.
+///             Empty lines and lines starting with `#` are ignored.
+///
+class StartupPageProfile {
+ public:
+  enum class Snapshot {
+    kVMData,
+    kVMInstructions,
+    kIsolateData,
+    kIsolateInstructions,
+  };
+
+  struct Range {
+    Snapshot snapshot;
+    size_t offset;
+    size_t length;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Parses a profile.
+  ///
+  /// @return     The profile, or std::nullopt if any line is malformed.
+  ///
+  static std::optional<StartupPageProfile> Parse(std::string_view profile);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reads and parses the profile at |path|.
+  ///
+  /// @return     The profile, or std::nullopt if the file could not be read or
+  ///             is malformed.
+  ///
+  static std::optional<StartupPageProfile> ReadFromFile(
+      const std::string& path);
+
+  const std::vector<Range>& GetRanges() const { return ranges_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Asks the OS to read the ranges of the profile ahead of their
+  ///             first use. This makes one system call per range, so it is
+  ///             best called from a background thread.
+  ///
+  /// @return     The number of ranges that were prefetched.
+  ///
+  size_t Prefetch(const DartSnapshot& vm_snapshot,
+                  const DartSnapshot& isolate_snapshot) const;
+
+ private:
+  std::vector<Range> ranges_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_RUNTIME_STARTUP_PAGE_PROFILE_H_
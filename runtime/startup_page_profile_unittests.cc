@@ -0,0 +1,59 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/startup_page_profile.h"
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(StartupPageProfileTest, ParsesRanges) {
+  auto profile = StartupPageProfile::Parse(
+      "# snapshot offset length\n"
+      "isolate_instructions 0x4000 0x9000\n"
+      "\n"
+      "  isolate_data 0 65536  \r\n"
+      "vm_data\t16\t32\n"
+      "vm_instructions 0 4096");
+  ASSERT_TRUE(profile.has_value());
+
+  const auto& ranges = profile->GetRanges();
+  ASSERT_EQ(ranges.size(), 4u);
+  EXPECT_EQ(ranges[0].snapshot,
+            StartupPageProfile::Snapshot::kIsolateInstructions);
+  EXPECT_EQ(ranges[0].offset, 0x4000u);
+  EXPECT_EQ(ranges[0].length, 0x9000u);
+  EXPECT_EQ(ranges[1].snapshot, StartupPageProfile::Snapshot::kIsolateData);
+  EXPECT_EQ(ranges[1].offset, 0u);
+  EXPECT_EQ(ranges[1].length, 65536u);
+  EXPECT_EQ(ranges[2].snapshot, StartupPageProfile::Snapshot::kVMData);
+  EXPECT_EQ(ranges[2].offset, 16u);
+  EXPECT_EQ(ranges[2].length, 32u);
+  EXPECT_EQ(ranges[3].snapshot,
+            StartupPageProfile::Snapshot::kVMInstructions);
+}
+
+TEST(StartupPageProfileTest, EmptyProfileHasNoRanges) {
+  auto profile = StartupPageProfile::Parse("# nothing to prefetch\n");
+  ASSERT_TRUE(profile.has_value());
+  EXPECT_TRUE(profile->GetRanges().empty());
+}
+
+TEST(StartupPageProfileTest, RejectsMalformedEntries) {
+  EXPECT_FALSE(StartupPageProfile::Parse("kernel 0 16").has_value());
+  EXPECT_FALSE(StartupPageProfile::Parse("vm_data 0").has_value());
+  EXPECT_FALSE(StartupPageProfile::Parse("vm_data 0 16 32").has_value());
+  EXPECT_FALSE(StartupPageProfile::Parse("vm_data -1 16").has_value());
+  EXPECT_FALSE(StartupPageProfile::Parse("vm_data 0x 16").has_value());
+  EXPECT_FALSE(StartupPageProfile::Parse("vm_data 12ab 16").has_value());
+}
+
+TEST(StartupPageProfileTest, MissingFileIsNotAProfile) {
+  EXPECT_FALSE(
+      StartupPageProfile::ReadFromFile("/does/not/exist").has_value());
+}
+
+}  // namespace testing
+}  // namespace flutter
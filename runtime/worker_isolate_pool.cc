@@ -0,0 +1,145 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/worker_isolate_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/volatile_path_tracker.h"
+#include "flutter/runtime/dart_isolate.h"
+#include "third_party/dart/runtime/include/dart_api.h"
+#include "third_party/tonic/dart_state.h"
+#include "third_party/tonic/logging/dart_invoke.h"
+#include "third_party/tonic/scopes/dart_api_scope.h"
+#include "third_party/tonic/typed_data/dart_byte_data.h"
+
+namespace flutter {
+
+WorkerIsolatePool::Worker::Worker(const std::string& name) : thread(name) {}
+
+WorkerIsolatePool::WorkerIsolatePool(const Settings& settings,
+                                     const UIDartState::Context& context,
+                                     const DartIsolate& group_isolate,
+                                     size_t worker_count) {
+  TRACE_EVENT0("flutter", "WorkerIsolatePool::WorkerIsolatePool");
+  const TaskRunners& task_runners = context.task_runners;
+  for (size_t i = 0; i < worker_count; i++) {
+    auto worker = std::make_unique<Worker>(task_runners.GetLabel() +
+                                           ".worker" + std::to_string(i + 1));
+    auto worker_task_runner = worker->thread.GetTaskRunner();
+
+    TaskRunners worker_task_runners(task_runners.GetLabel(),               //
+                                    task_runners.GetPlatformTaskRunner(),  //
+                                    task_runners.GetRasterTaskRunner(),    //
+                                    worker_task_runner,                    //
+                                    task_runners.GetIOTaskRunner()         //
+    );
+    auto volatile_path_tracker = std::make_shared<VolatilePathTracker>(
+        worker_task_runner, /*enabled=*/false);
+
+    // The image decoder, the image generator registry and the volatile path
+    // tracker of |context| may only be used on the UI thread of the root
+    // isolate.
+    UIDartState::Context worker_context(worker_task_runners,                 //
+                                        context.snapshot_delegate,           //
+                                        context.io_manager,                  //
+                                        context.unref_queue,                 //
+                                        {},                                  //
+                                        {},                                  //
+                                        context.advisory_script_uri,         //
+                                        context.advisory_script_entrypoint,  //
+                                        std::move(volatile_path_tracker),    //
+                                        context.concurrent_task_runner,      //
+                                        context.enable_impeller              //
+    );
+
+    // The root isolate outlives the pool, and the pool joins the thread
+    // before it is collected.
+    worker_task_runner->PostTask([worker = worker.get(), settings,
+                                  worker_context = std::move(worker_context),
+                                  &group_isolate]() {
+      worker->isolate = DartIsolate::CreateWorkerIsolate(
+          settings, worker_context, group_isolate);
+    });
+    workers_.push_back(std::move(worker));
+  }
+}
+
+WorkerIsolatePool::~WorkerIsolatePool() {
+  for (const auto& worker : workers_) {
+    worker->thread.GetTaskRunner()->PostTask([worker = worker.get()]() {
+      if (auto isolate = worker->isolate.lock()) {
+        if (!isolate->Shutdown()) {
+          FML_LOG(ERROR) << "Could not shutdown worker isolate.";
+        }
+      }
+    });
+  }
+  for (const auto& worker : workers_) {
+    worker->thread.Join();
+  }
+}
+
+void WorkerIsolatePool::PostTask(std::string function,
+                                 std::unique_ptr<fml::Mapping> message,
+                                 TaskCallback callback) {
+  if (workers_.empty()) {
+    callback(nullptr);
+    return;
+  }
+
+  Worker* worker =
+      std::min_element(workers_.begin(), workers_.end(),
+                       [](const auto& a, const auto& b) {
+                         return a->pending_tasks < b->pending_tasks;
+                       })
+          ->get();
+  worker->pending_tasks++;
+
+  // Tasks posted before the pool is collected run before the isolate is shut
+  // down, which keeps |worker| alive for them.
+  worker->thread.GetTaskRunner()->PostTask(
+      fml::MakeCopyable([worker, function = std::move(function),
+                         message = std::move(message),
+                         callback = std::move(callback)]() mutable {
+        RunTask(worker, function, std::move(message), callback);
+      }));
+}
+
+void WorkerIsolatePool::RunTask(Worker* worker,
+                                const std::string& function,
+                                std::unique_ptr<fml::Mapping> message,
+                                const TaskCallback& callback) {
+  TRACE_EVENT1("flutter", "WorkerIsolatePool::RunTask", "function",
+               function.c_str());
+  std::unique_ptr<fml::Mapping> result_mapping;
+  if (auto isolate = worker->isolate.lock()) {
+    tonic::DartState::Scope scope(isolate.get());
+    tonic::DartApiScope api_scope;
+
+    Dart_Handle message_handle =
+        message ? tonic::DartByteData::Create(message->GetMapping(),
+                                              message->GetSize())
+                : Dart_Null();
+    Dart_Handle result = tonic::DartInvokeField(
+        Dart_RootLibrary(), function.c_str(), {message_handle});
+    if (!tonic::CheckAndHandleError(result) &&
+        Dart_GetTypeOfTypedData(result) == Dart_TypedData_kByteData) {
+      tonic::DartByteData data(result);
+      result_mapping = std::make_unique<fml::MallocMapping>(
+          fml::MallocMapping::Copy(data.data(), data.length_in_bytes()));
+    }
+  } else {
+    FML_LOG(ERROR) << "Could not run '" << function
+                   << "' on a worker isolate that failed to start.";
+  }
+  worker->pending_tasks--;
+  callback(std::move(result_mapping));
+}
+
+}  // namespace flutter
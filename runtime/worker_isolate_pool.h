@@ -0,0 +1,112 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_RUNTIME_WORKER_ISOLATE_POOL_H_
+#define FLUTTER_RUNTIME_WORKER_ISOLATE_POOL_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/thread.h"
+#include "flutter/lib/ui/ui_dart_state.h"
+
+namespace flutter {
+
+class DartIsolate;
+
+//------------------------------------------------------------------------------
+/// @brief      A fixed number of worker isolates in the isolate group of a
+///             root isolate, each running on its own engine managed thread.
+///
+///             The workers are created as soon as the pool is, so work
+///             handed to them later starts without waiting for an isolate to
+///             be spawned. They share the snapshot and heap of the root
+///             isolate's group and handle their messages on their thread.
+///             Like the isolates spawned by the VM they are not root
+///             isolates, so the UI operations of `dart:ui`, such as
+///             scheduling a frame or decoding an image, throw on them.
+///
+///             The pool must be collected before the isolate it was created
+///             from is shut down.
+///
+class WorkerIsolatePool {
+ public:
+  //----------------------------------------------------------------------------
+  /// The callback invoked on the worker thread with the `ByteData` returned
+  /// by a task, or nullptr if the task failed or did not return a `ByteData`.
+  ///
+  using TaskCallback = std::function<void(std::unique_ptr<fml::Mapping>)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts the threads of the pool and creates a worker isolate
+  ///             on each of them.
+  ///
+  /// @param[in]  settings       The settings used to create the isolates.
+  /// @param[in]  context        The context of `group_isolate`. The workers
+  ///                            use it with their own UI task runner.
+  /// @param[in]  group_isolate  The running root isolate whose group the
+  ///                            workers join.
+  /// @param[in]  worker_count   The number of worker isolates.
+  ///
+  WorkerIsolatePool(const Settings& settings,
+                    const UIDartState::Context& context,
+                    const DartIsolate& group_isolate,
+                    size_t worker_count);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Shuts down the worker isolates after the tasks already
+  ///             posted to them, and joins their threads.
+  ///
+  ~WorkerIsolatePool();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Invokes the top-level `function` of the root library with
+  ///             `message` as its `ByteData` argument, on the worker with the
+  ///             fewest tasks waiting. In AOT mode the function must be
+  ///             annotated with `@pragma('vm:entry-point')`.
+  ///
+  ///             The callback is invoked on the worker thread. Futures and
+  ///             ports the function leaves behind keep running on the worker,
+  ///             but the callback only receives what the function returns.
+  ///
+  /// @param[in]  function  The name of the function in the root library.
+  /// @param[in]  message   The bytes passed to the function, may be nullptr.
+  /// @param[in]  callback  The callback invoked with the result.
+  ///
+  void PostTask(std::string function,
+                std::unique_ptr<fml::Mapping> message,
+                TaskCallback callback);
+
+ private:
+  struct Worker {
+    explicit Worker(const std::string& name);
+
+    fml::Thread thread;
+
+    // Only used on |thread|.
+    std::weak_ptr<DartIsolate> isolate;
+
+    // The tasks posted to |thread| that haven't completed yet.
+    std::atomic<size_t> pending_tasks = 0;
+  };
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  static void RunTask(Worker* worker,
+                      const std::string& function,
+                      std::unique_ptr<fml::Mapping> message,
+                      const TaskCallback& callback);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(WorkerIsolatePool);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_RUNTIME_WORKER_ISOLATE_POOL_H_
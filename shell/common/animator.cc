@@ -20,27 +20,44 @@ namespace {
 constexpr fml::TimeDelta kNotifyIdleTaskWaitTime =
     fml::TimeDelta::FromMilliseconds(51);
 
+// Predictions of frames that never reach the rasterizer are dropped once this
+// many newer frames have been scheduled.
+constexpr size_t kMaxPendingPredictions = 8;
+
+uint32_t GetPipelineDepth(const TaskRunners& task_runners,
+                          uint32_t requested_depth) {
+  if (requested_depth > 0) {
+    return requested_depth;
+  }
+#if SHELL_ENABLE_METAL
+  return 2;
+#else   // SHELL_ENABLE_METAL
+  // TODO(dnfield): We should remove this logic and set the pipeline depth
+  // back to 2 in this case. See
+  // https://github.com/flutter/engine/pull/9132 for discussion.
+  return task_runners.GetPlatformTaskRunner() ==
+                 task_runners.GetRasterTaskRunner()
+             ? 1
+             : 2;
+#endif  // SHELL_ENABLE_METAL
+}
+
 }  // namespace
 
 Animator::Animator(Delegate& delegate,
                    const TaskRunners& task_runners,
-                   std::unique_ptr<VsyncWaiter> waiter)
+                   std::unique_ptr<VsyncWaiter> waiter,
+                   uint32_t pipeline_depth,
+                   bool predictive_scheduling)
     : delegate_(delegate),
       task_runners_(task_runners),
       waiter_(std::move(waiter)),
-#if SHELL_ENABLE_METAL
-      layer_tree_pipeline_(std::make_shared<FramePipeline>(2)),
-#else   // SHELL_ENABLE_METAL
-      // TODO(dnfield): We should remove this logic and set the pipeline depth
-      // back to 2 in this case. See
-      // https://github.com/flutter/engine/pull/9132 for discussion.
       layer_tree_pipeline_(std::make_shared<FramePipeline>(
-          task_runners.GetPlatformTaskRunner() ==
-                  task_runners.GetRasterTaskRunner()
-              ? 1
-              : 2)),
-#endif  // SHELL_ENABLE_METAL
+          GetPipelineDepth(task_runners, pipeline_depth))),
       pending_frame_semaphore_(1),
+      schedule_predictor_(predictive_scheduling
+                              ? std::make_unique<FrameSchedulePredictor>()
+                              : nullptr),
       weak_factory_(this) {
 }
 
@@ -58,6 +75,92 @@ void Animator::EnqueueTraceFlowId(uint64_t trace_flow_id) {
       });
 }
 
+void Animator::ScheduleBeginFrame(
+    std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
+  if (!schedule_predictor_) {
+    BeginFrame(std::move(frame_timings_recorder));
+    return;
+  }
+
+  const fml::TimePoint vsync_start =
+      frame_timings_recorder->GetVsyncStartTime();
+  const FrameSchedulePredictor::Schedule schedule =
+      schedule_predictor_->Predict(
+          frame_timings_recorder->GetVsyncTargetTime() - vsync_start);
+  FML_TRACE_COUNTER("flutter", "Animator::FrameSchedule",
+                    reinterpret_cast<int64_t>(this),  //
+                    "Mode", static_cast<int>(schedule.mode),
+                    "StartDelayMs", schedule.start_delay.ToMillisecondsF());
+
+  if (schedule.predicted_duration > fml::TimeDelta::Zero()) {
+    predicted_frame_durations_.emplace_back(
+        frame_timings_recorder->GetFrameNumber(), schedule.predicted_duration);
+    if (predicted_frame_durations_.size() > kMaxPendingPredictions) {
+      predicted_frame_durations_.pop_front();
+    }
+  }
+  target_following_vsync_ =
+      schedule.mode == FrameSchedulePredictor::Mode::kPipelined;
+
+  if (schedule.mode != FrameSchedulePredictor::Mode::kDelayed) {
+    BeginFrame(std::move(frame_timings_recorder));
+    return;
+  }
+
+  task_runners_.GetUITaskRunner()->PostTaskForTime(
+      [self = weak_factory_.GetWeakPtr(),
+       recorder = std::move(frame_timings_recorder)]() mutable {
+        if (self) {
+          self->BeginFrame(std::move(recorder));
+        }
+      },
+      vsync_start + schedule.start_delay);
+}
+
+void Animator::OnFrameRasterized(const FrameTiming& timing) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  if (!schedule_predictor_) {
+    return;
+  }
+
+  schedule_predictor_->AddFrame(
+      timing.Get(FrameTiming::kBuildFinish) -
+          timing.Get(FrameTiming::kBuildStart),
+      timing.Get(FrameTiming::kRasterFinish) -
+          timing.Get(FrameTiming::kRasterStart));
+
+  const uint64_t frame_number = timing.GetFrameNumber();
+  while (!predicted_frame_durations_.empty() &&
+         predicted_frame_durations_.front().first <= frame_number) {
+    const auto [predicted_frame_number, predicted_duration] =
+        predicted_frame_durations_.front();
+    predicted_frame_durations_.pop_front();
+    if (predicted_frame_number != frame_number) {
+      continue;
+    }
+    const fml::TimeDelta duration = timing.Get(FrameTiming::kRasterFinish) -
+                                    timing.Get(FrameTiming::kBuildStart);
+    FML_TRACE_COUNTER("flutter", "Animator::FramePredictionError",
+                      reinterpret_cast<int64_t>(this),  //
+                      "ErrorMs",
+                      (duration - predicted_duration).ToMillisecondsF());
+  }
+}
+
+void Animator::SetOverloadController(
+    std::shared_ptr<FrameOverloadController> controller) {
+  overload_controller_ = std::move(controller);
+}
+
+bool Animator::ShouldThrottleFrame() {
+  if (!overload_controller_ || !overload_controller_->IsOverloaded()) {
+    throttled_last_vsync_ = false;
+    return false;
+  }
+  throttled_last_vsync_ = !throttled_last_vsync_;
+  return throttled_last_vsync_;
+}
+
 void Animator::BeginFrame(
     std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
   TRACE_EVENT_ASYNC_END0("flutter", "Frame Request Pending",
@@ -107,9 +210,16 @@ void Animator::BeginFrame(
   // We have acquired a valid continuation from the pipeline and are ready
   // to service potential frame.
   FML_DCHECK(producer_continuation_);
-  const fml::TimePoint frame_target_time =
+  fml::TimePoint frame_target_time =
       frame_timings_recorder_->GetVsyncTargetTime();
   dart_frame_deadline_ = frame_target_time.ToEpochDelta();
+  if (target_following_vsync_) {
+    // The frame cannot be displayed before the following vsync, so that is
+    // the time animations are advanced to.
+    const fml::TimeDelta frame_interval =
+        frame_target_time - frame_timings_recorder_->GetVsyncStartTime();
+    frame_target_time = frame_target_time + frame_interval;
+  }
   uint64_t frame_number = frame_timings_recorder_->GetFrameNumber();
   delegate_.OnAnimatorBeginFrame(frame_target_time, frame_number);
 
@@ -252,10 +362,14 @@ void Animator::AwaitVSync() {
       [self = weak_factory_.GetWeakPtr()](
           std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
         if (self) {
-          if (self->CanReuseLastLayerTrees()) {
+          if (self->ShouldThrottleFrame()) {
+            // Halves the frame rate while the raster thread cannot keep up.
+            TRACE_EVENT0("flutter", "Animator::ThrottledFrame");
+            self->AwaitVSync();
+          } else if (self->CanReuseLastLayerTrees()) {
             self->DrawLastLayerTrees(std::move(frame_timings_recorder));
           } else {
-            self->BeginFrame(std::move(frame_timings_recorder));
+            self->ScheduleBeginFrame(std::move(frame_timings_recorder));
           }
         }
       });
@@ -269,6 +383,10 @@ void Animator::ScheduleSecondaryVsyncCallback(uintptr_t id,
   waiter_->ScheduleSecondaryCallback(id, callback);
 }
 
+void Animator::SetFrameRateRange(const VsyncWaiter::FrameRateRange& range) {
+  waiter_->SetFrameRateRange(range);
+}
+
 void Animator::ScheduleMaybeClearTraceFlowIds() {
   waiter_->ScheduleSecondaryCallback(
       reinterpret_cast<uintptr_t>(this), [self = weak_factory_.GetWeakPtr()] {
@@ -6,13 +6,17 @@
 #define FLUTTER_SHELL_COMMON_ANIMATOR_H_
 
 #include <deque>
+#include <utility>
 
+#include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/flow/frame_timings.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/shell/common/frame_overload_controller.h"
+#include "flutter/shell/common/frame_schedule_predictor.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/vsync_waiter.h"
@@ -45,9 +49,17 @@ class Animator final {
         std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) = 0;
   };
 
+  /// |pipeline_depth| is the number of frames the UI thread may produce
+  /// ahead of the raster thread, or 0 for the platform default.
+  ///
+  /// With |predictive_scheduling|, the start of each frame is picked by a
+  /// |FrameSchedulePredictor| from the timings reported to
+  /// |OnFrameRasterized| instead of always being at vsync.
   Animator(Delegate& delegate,
            const TaskRunners& task_runners,
-           std::unique_ptr<VsyncWaiter> waiter);
+           std::unique_ptr<VsyncWaiter> waiter,
+           uint32_t pipeline_depth = 0,
+           bool predictive_scheduling = false);
 
   ~Animator();
 
@@ -89,7 +101,38 @@ class Animator final {
   // rendering.
   void EnqueueTraceFlowId(uint64_t trace_flow_id);
 
+  //--------------------------------------------------------------------------
+  /// @brief    Forwards the frame rate range requested by the application to
+  ///           the vsync waiter. Must be called on the UI thread.
+  ///
+  /// @see      `VsyncWaiter::SetFrameRateRange`.
+  ///
+  void SetFrameRateRange(const VsyncWaiter::FrameRateRange& range);
+
+  //--------------------------------------------------------------------------
+  /// @brief    Tells the Animator the timings of a rasterized frame, which
+  ///           predictive scheduling uses to schedule the next frames. Must
+  ///           be called on the UI thread.
+  ///
+  void OnFrameRasterized(const FrameTiming& timing);
+
+  //--------------------------------------------------------------------------
+  /// @brief    Sets the overload controller shared with the rasterizer. While
+  ///           it reports an overload, the Animator only produces a frame
+  ///           every other vsync. May be `nullptr`.
+  ///
+  void SetOverloadController(
+      std::shared_ptr<FrameOverloadController> controller);
+
  private:
+  // Whether the frame of this vsync is skipped because of a raster overload.
+  bool ShouldThrottleFrame();
+
+  // Calls |BeginFrame| now, or later in the frame interval when predictive
+  // scheduling finds enough slack.
+  void ScheduleBeginFrame(
+      std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
+
   void BeginFrame(std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
 
   bool CanReuseLastLayerTrees();
@@ -117,6 +160,17 @@ class Animator final {
   std::deque<uint64_t> trace_flow_ids_;
   bool has_rendered_ = false;
 
+  // Only set if predictive scheduling is enabled.
+  std::unique_ptr<FrameSchedulePredictor> schedule_predictor_;
+  // The predicted durations of the frames still being built or rasterized,
+  // by frame number.
+  std::deque<std::pair<uint64_t, fml::TimeDelta>> predicted_frame_durations_;
+  // Whether the frame being built targets the vsync after the next one.
+  bool target_following_vsync_ = false;
+
+  std::shared_ptr<FrameOverloadController> overload_controller_;
+  bool throttled_last_vsync_ = false;
+
   fml::WeakPtrFactory<Animator> weak_factory_;
 
   friend class testing::ShellTest;
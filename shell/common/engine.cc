@@ -6,10 +6,12 @@
 
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/common/settings.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/trace_event.h"
@@ -18,6 +20,8 @@
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/shell.h"
+#include "flutter/shell/common/startup_report.h"
+#include "flutter/third_party/txt/src/txt/fallback_font_cache.h"
 #include "rapidjson/document.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 
@@ -30,6 +34,9 @@ static constexpr char kLocalizationChannel[] = "flutter/localization";
 static constexpr char kSettingsChannel[] = "flutter/settings";
 static constexpr char kIsolateChannel[] = "flutter/isolate";
 
+// The persistent cache key of the snapshot of resolved fallback fonts.
+static constexpr char kFallbackFontCacheKey[] = "flutter.fallbackFonts";
+
 namespace {
 fml::MallocMapping MakeMapping(const std::string& str) {
   return fml::MallocMapping::Copy(str.c_str(), str.length());
@@ -154,6 +161,15 @@ fml::WeakPtr<Engine> Engine::GetWeakPtr() const {
 
 void Engine::SetupDefaultFontManager() {
   TRACE_EVENT0("flutter", "Engine::SetupDefaultFontManager");
+  StartupReport::ScopedStage stage("DefaultFontManagerSetup");
+  static std::once_flag load_fallback_fonts;
+  std::call_once(load_fallback_fonts, [] {
+    auto snapshot = PersistentCache::GetCacheForProcess()->load(
+        *SkData::MakeWithCString(kFallbackFontCacheKey));
+    if (snapshot) {
+      txt::FallbackFontCache::GetForProcess().LoadSnapshot(*snapshot);
+    }
+  });
   font_collection_->SetupDefaultFontManager(settings_.font_initialization_data);
 }
 
@@ -233,6 +249,7 @@ Engine::RunStatus Engine::Run(RunConfiguration configuration) {
     }
   };
 
+  StartupReport::ScopedStage stage("RootIsolateLaunch");
   if (!runtime_controller_->LaunchRootIsolate(
           settings_,                                 //
           root_isolate_create_callback,              //
@@ -263,8 +280,17 @@ void Engine::ReportTimings(std::vector<int64_t> timings) {
   runtime_controller_->ReportTimings(std::move(timings));
 }
 
+void Engine::OnFrameRasterized(const FrameTiming& timing) {
+  animator_->OnFrameRasterized(timing);
+}
+
 void Engine::NotifyIdle(fml::TimeDelta deadline) {
   runtime_controller_->NotifyIdle(deadline);
+  if (auto snapshot =
+          txt::FallbackFontCache::GetForProcess().TakeSnapshotIfChanged()) {
+    PersistentCache::GetCacheForProcess()->StoreData(
+        *SkData::MakeWithCString(kFallbackFontCacheKey), *snapshot);
+  }
 }
 
 void Engine::NotifyDestroyed() {
@@ -276,6 +302,13 @@ std::optional<uint32_t> Engine::GetUIIsolateReturnCode() {
   return runtime_controller_->GetRootIsolateReturnCode();
 }
 
+void Engine::RunInWorkerIsolate(std::string function,
+                                std::unique_ptr<fml::Mapping> message,
+                                WorkerIsolatePool::TaskCallback callback) {
+  runtime_controller_->RunInWorkerIsolate(
+      std::move(function), std::move(message), std::move(callback));
+}
+
 Dart_Port Engine::GetUIIsolateMainPort() {
   return runtime_controller_->GetMainPort();
 }
@@ -509,6 +542,12 @@ void Engine::SetNeedsReportTimings(bool needs_reporting) {
   delegate_.SetNeedsReportTimings(needs_reporting);
 }
 
+void Engine::SetFrameRateRange(double minimum,
+                               double maximum,
+                               double preferred) {
+  animator_->SetFrameRateRange({minimum, maximum, preferred});
+}
+
 FontCollection& Engine::GetFontCollection() {
   return *font_collection_;
 }
@@ -630,6 +630,16 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   void ReportTimings(std::vector<int64_t> timings);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Forwards the timings of a rasterized frame to the animator,
+  ///             which uses them for predictive frame scheduling. Only called
+  ///             by the shell when `Settings::predictive_frame_scheduling` is
+  ///             enabled.
+  ///
+  /// @param[in]  timing  The timings of the frame.
+  ///
+  void OnFrameRasterized(const FrameTiming& timing);
+
   //----------------------------------------------------------------------------
   /// @brief      Gets the main port of the root isolate. Since the isolate is
   ///             created immediately in the constructor of the engine, it is
@@ -709,6 +719,19 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   std::optional<uint32_t> GetUIIsolateReturnCode();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Invokes a top-level function of the root library on one of
+  ///             the worker isolates of the UI isolate. See
+  ///             `RuntimeController::RunInWorkerIsolate`.
+  ///
+  /// @param[in]  function  The name of the function in the root library.
+  /// @param[in]  message   The bytes passed to the function, may be nullptr.
+  /// @param[in]  callback  The callback invoked with the returned `ByteData`.
+  ///
+  void RunInWorkerIsolate(std::string function,
+                          std::unique_ptr<fml::Mapping> message,
+                          WorkerIsolatePool::TaskCallback callback);
+
   //----------------------------------------------------------------------------
   /// @brief      Notify the Flutter application that a new view is available.
   ///
@@ -998,6 +1021,11 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
 
   void SetNeedsReportTimings(bool value) override;
 
+  // |RuntimeDelegate|
+  void SetFrameRateRange(double minimum,
+                         double maximum,
+                         double preferred) override;
+
   bool HandleLifecyclePlatformMessage(PlatformMessage* message);
 
   bool HandleNavigationPlatformMessage(
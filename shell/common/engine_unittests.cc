@@ -83,6 +83,7 @@ class MockRuntimeDelegate : public RuntimeDelegate {
               (const std::string, int64_t),
               (override));
   MOCK_METHOD(void, SetNeedsReportTimings, (bool), (override));
+  MOCK_METHOD(void, SetFrameRateRange, (double, double, double), (override));
   MOCK_METHOD(std::unique_ptr<std::vector<std::string>>,
               ComputePlatformResolvedLocale,
               (const std::vector<std::string>&),
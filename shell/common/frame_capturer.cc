@@ -0,0 +1,206 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_capturer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/skia/dl_sk_canvas.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/gpu/GpuTypes.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/ganesh/SkSurfaceGanesh.h"
+
+#if IMPELLER_SUPPORTS_RENDERING
+#include "flutter/lib/ui/painting/image_encoding_impeller.h"
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
+namespace flutter {
+
+namespace {
+
+// Renders the frame into a texture that is not read back.
+sk_sp<DlImage> RenderWithSkia(GrDirectContext* gr_context,
+                              const sk_sp<DisplayList>& display_list,
+                              SkISize size) {
+  sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(
+      gr_context, skgpu::Budgeted::kYes,
+      SkImageInfo::MakeN32Premul(size.width(), size.height(),
+                                 SkColorSpace::MakeSRGB()));
+  if (!surface) {
+    return nullptr;
+  }
+  DlSkCanvasAdapter(surface->getCanvas()).DrawDisplayList(display_list);
+  return DlImage::Make(surface->makeImageSnapshot());
+}
+
+struct SkiaReadback {
+  std::function<void(sk_sp<SkImage>)> finish;
+  SkImageInfo info;
+};
+
+void OnSkiaPixelsRead(void* context,
+                      std::unique_ptr<const SkImage::AsyncReadResult> result) {
+  std::unique_ptr<SkiaReadback> readback(static_cast<SkiaReadback*>(context));
+  sk_sp<SkImage> pixels;
+  if (result && result->count() == 1) {
+    const size_t row_bytes = result->rowBytes(0);
+    sk_sp<SkData> data = SkData::MakeWithCopy(
+        result->data(0), row_bytes * readback->info.height());
+    pixels = SkImages::RasterFromData(readback->info, std::move(data),
+                                      row_bytes);
+  }
+  readback->finish(std::move(pixels));
+}
+
+}  // namespace
+
+FrameCapturer::Delivery::Delivery(Callback callback)
+    : callback(std::move(callback)) {}
+
+void FrameCapturer::Delivery::Finish(int64_t view_id,
+                                     fml::TimePoint time,
+                                     sk_sp<SkImage> pixels) {
+  readback_in_flight.store(false, std::memory_order_release);
+  if (!pixels) {
+    FML_LOG(ERROR) << "Could not read back a captured frame.";
+    return;
+  }
+  callback({
+      .view_id = view_id,
+      .time = time,
+      .pixels = std::move(pixels),
+  });
+}
+
+FrameCapturer::FrameCapturer(Options options, Callback callback)
+    : options_(options),
+      delivery_(std::make_shared<Delivery>(std::move(callback))) {}
+
+FrameCapturer::~FrameCapturer() = default;
+
+bool FrameCapturer::ShouldCapture(fml::TimePoint now) const {
+  if (delivery_->readback_in_flight.load(std::memory_order_acquire)) {
+    return false;
+  }
+  return last_capture_time_ == fml::TimePoint() ||
+         now - last_capture_time_ >= options_.min_interval;
+}
+
+SkISize FrameCapturer::GetCaptureSize(SkISize frame_size) const {
+  if (frame_size.isEmpty() || options_.max_size.isEmpty()) {
+    return frame_size;
+  }
+  const double scale = std::min(
+      {1.0,
+       static_cast<double>(options_.max_size.width()) / frame_size.width(),
+       static_cast<double>(options_.max_size.height()) / frame_size.height()});
+  return SkISize::Make(
+      std::max(1, static_cast<int>(std::round(frame_size.width() * scale))),
+      std::max(1, static_cast<int>(std::round(frame_size.height() * scale))));
+}
+
+void FrameCapturer::Capture(
+    int64_t view_id,
+    fml::TimePoint time,
+    const sk_sp<DisplayList>& display_list,
+    SkISize frame_size,
+    GrDirectContext* gr_context,
+    SnapshotDelegate& snapshot_delegate,
+    const std::shared_ptr<impeller::Context>& impeller_context) {
+  TRACE_EVENT0("flutter", "FrameCapturer::Capture");
+  last_capture_time_ = time;
+  const SkISize size = GetCaptureSize(frame_size);
+  if (!display_list || size.isEmpty()) {
+    return;
+  }
+
+  DisplayListBuilder builder(SkRect::Make(size));
+  builder.Scale(static_cast<SkScalar>(size.width()) / frame_size.width(),
+                static_cast<SkScalar>(size.height()) / frame_size.height());
+  builder.DrawDisplayList(display_list);
+  sk_sp<DisplayList> scaled_display_list = builder.Build();
+
+  // The Skia snapshot controller reads its snapshots back synchronously, so
+  // Skia frames are rendered here.
+  sk_sp<DlImage> texture =
+      gr_context
+          ? RenderWithSkia(gr_context, scaled_display_list, size)
+          : snapshot_delegate.MakeRasterSnapshot(scaled_display_list, size);
+  if (!texture) {
+    return;
+  }
+
+  if (!options_.read_pixels) {
+    delivery_->callback({
+        .view_id = view_id,
+        .time = time,
+        .texture = std::move(texture),
+    });
+    return;
+  }
+
+  if (!texture->isTextureBacked()) {
+    delivery_->callback({
+        .view_id = view_id,
+        .time = time,
+        .pixels = texture->skia_image(),
+    });
+    return;
+  }
+
+  ReadPixels(view_id, time, texture, gr_context, impeller_context);
+}
+
+void FrameCapturer::ReadPixels(
+    int64_t view_id,
+    fml::TimePoint time,
+    const sk_sp<DlImage>& texture,
+    GrDirectContext* gr_context,
+    const std::shared_ptr<impeller::Context>& impeller_context) {
+  delivery_->readback_in_flight.store(true, std::memory_order_release);
+  auto finish = [delivery = delivery_, view_id, time](sk_sp<SkImage> pixels) {
+    delivery->Finish(view_id, time, std::move(pixels));
+  };
+
+#if IMPELLER_SUPPORTS_RENDERING
+  if (texture->impeller_texture()) {
+    // Copies the texture into a host visible buffer, which is mapped once
+    // the copy is complete.
+    ImageEncodingImpeller::ConvertDlImageToSkImage(
+        texture,
+        [finish = std::move(finish)](fml::StatusOr<sk_sp<SkImage>> image) {
+          finish(image.ok() ? image.value() : nullptr);
+        },
+        impeller_context);
+    return;
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
+  sk_sp<SkImage> image = texture->skia_image();
+  if (!image || !gr_context) {
+    finish(nullptr);
+    return;
+  }
+  // Skia reads the pixels back through a transfer buffer and calls back once
+  // the transfer has completed, after a later flush.
+  auto* readback = new SkiaReadback{
+      .finish = std::move(finish),
+      .info = image->imageInfo(),
+  };
+  image->asyncRescaleAndReadPixels(
+      readback->info, SkIRect::MakeSize(image->dimensions()),
+      SkImage::RescaleGamma::kSrc, SkImage::RescaleMode::kNearest,
+      &OnSkiaPixelsRead, readback);
+  gr_context->flushAndSubmit();
+}
+
+}  // namespace flutter
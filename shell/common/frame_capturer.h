@@ -0,0 +1,126 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_CAPTURER_H_
+#define FLUTTER_SHELL_COMMON_FRAME_CAPTURER_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/image/dl_image.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/lib/ui/snapshot_delegate.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+class GrDirectContext;
+
+namespace impeller {
+class Context;
+}  // namespace impeller
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Captures the frames drawn by the rasterizer for streaming, for
+///             example to a remote support tool.
+///
+///             Unlike `Rasterizer::ScreenshotLastLayerTree`, capturing never
+///             waits for the GPU. Frames are captured at most at the
+///             configured rate into a GPU texture of at most the configured
+///             size. If pixels are requested, the texture is read back into
+///             host memory asynchronously, and frames drawn while a readback
+///             is in flight are not captured.
+///
+class FrameCapturer {
+ public:
+  struct Options {
+    /// The size that frames are scaled down to fit in, or empty to capture
+    /// frames at their size.
+    SkISize max_size = SkISize::MakeEmpty();
+
+    /// The shortest time between two captured frames.
+    fml::TimeDelta min_interval;
+
+    /// Whether frames are read back into host memory.
+    bool read_pixels = false;
+  };
+
+  struct Frame {
+    int64_t view_id = 0;
+
+    /// When the captured frame was drawn.
+    fml::TimePoint time;
+
+    /// The frame on the GPU, if |Options::read_pixels| is false.
+    sk_sp<DlImage> texture;
+
+    /// The pixels of the frame, if |Options::read_pixels| is true.
+    sk_sp<SkImage> pixels;
+  };
+
+  /// Called with every captured frame. Textures are delivered on the raster
+  /// thread, pixels may be delivered on any thread.
+  using Callback = std::function<void(Frame frame)>;
+
+  FrameCapturer(Options options, Callback callback);
+
+  ~FrameCapturer();
+
+  /// Whether a frame drawn at |now| should be captured.
+  bool ShouldCapture(fml::TimePoint now) const;
+
+  /// The size that a frame of |frame_size| is captured at.
+  SkISize GetCaptureSize(SkISize frame_size) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Captures |display_list|, the frame of |frame_size| that was
+  ///             drawn at |time| for the view |view_id|. Must be called on
+  ///             the raster thread with the rendering context current.
+  ///
+  /// @param[in]  gr_context         The Skia context of the surface, if it
+  ///                                renders with Skia on the GPU.
+  /// @param[in]  snapshot_delegate  Renders the frame if |gr_context| is null.
+  /// @param[in]  impeller_context   The context to read back Impeller
+  ///                                textures with.
+  ///
+  void Capture(int64_t view_id,
+               fml::TimePoint time,
+               const sk_sp<DisplayList>& display_list,
+               SkISize frame_size,
+               GrDirectContext* gr_context,
+               SnapshotDelegate& snapshot_delegate,
+               const std::shared_ptr<impeller::Context>& impeller_context);
+
+ private:
+  // Shared with readbacks, which may complete after the capturer is gone.
+  struct Delivery {
+    explicit Delivery(Callback callback);
+
+    void Finish(int64_t view_id, fml::TimePoint time, sk_sp<SkImage> pixels);
+
+    const Callback callback;
+    std::atomic<bool> readback_in_flight = false;
+  };
+
+  void ReadPixels(int64_t view_id,
+                  fml::TimePoint time,
+                  const sk_sp<DlImage>& texture,
+                  GrDirectContext* gr_context,
+                  const std::shared_ptr<impeller::Context>& impeller_context);
+
+  const Options options_;
+  const std::shared_ptr<Delivery> delivery_;
+  fml::TimePoint last_capture_time_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameCapturer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_CAPTURER_H_
@@ -0,0 +1,117 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_capturer.h"
+
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/skia/dl_sk_canvas.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Renders snapshots into raster images, like the rasterizer without a GPU
+// surface.
+class SoftwareSnapshotDelegate : public SnapshotDelegate {
+ public:
+  std::unique_ptr<GpuImageResult> MakeSkiaGpuImage(
+      sk_sp<DisplayList> display_list,
+      const SkImageInfo& image_info) override {
+    return nullptr;
+  }
+
+  std::shared_ptr<TextureRegistry> GetTextureRegistry() override {
+    return nullptr;
+  }
+
+  GrDirectContext* GetGrContext() override { return nullptr; }
+
+  sk_sp<DlImage> MakeRasterSnapshot(sk_sp<DisplayList> display_list,
+                                    SkISize picture_size) override {
+    snapshot_sizes.push_back(picture_size);
+    sk_sp<SkSurface> surface =
+        SkSurfaces::Raster(SkImageInfo::MakeN32Premul(picture_size));
+    DlSkCanvasAdapter(surface->getCanvas()).DrawDisplayList(display_list);
+    return DlImage::Make(surface->makeImageSnapshot());
+  }
+
+  sk_sp<SkImage> ConvertToRasterImage(sk_sp<SkImage> image) override {
+    return image;
+  }
+
+  std::vector<SkISize> snapshot_sizes;
+};
+
+sk_sp<DisplayList> MakeFrame(SkISize size) {
+  DisplayListBuilder builder(SkRect::Make(size));
+  builder.DrawRect(SkRect::Make(size), DlPaint(DlColor::kRed()));
+  return builder.Build();
+}
+
+}  // namespace
+
+TEST(FrameCapturerTest, ScalesFramesDownToTheMaxSize) {
+  FrameCapturer capturer({.max_size = SkISize::Make(400, 400)},
+                         [](FrameCapturer::Frame frame) {});
+
+  EXPECT_EQ(capturer.GetCaptureSize(SkISize::Make(1000, 500)),
+            SkISize::Make(400, 200));
+  EXPECT_EQ(capturer.GetCaptureSize(SkISize::Make(200, 100)),
+            SkISize::Make(200, 100));
+
+  FrameCapturer unscaled_capturer({}, [](FrameCapturer::Frame frame) {});
+  EXPECT_EQ(unscaled_capturer.GetCaptureSize(SkISize::Make(1000, 500)),
+            SkISize::Make(1000, 500));
+}
+
+TEST(FrameCapturerTest, CapturesAtMostAtTheMinInterval) {
+  std::vector<FrameCapturer::Frame> frames;
+  FrameCapturer capturer(
+      {.min_interval = fml::TimeDelta::FromMilliseconds(100)},
+      [&frames](FrameCapturer::Frame frame) { frames.push_back(frame); });
+  SoftwareSnapshotDelegate snapshot_delegate;
+  const SkISize size = SkISize::Make(10, 10);
+  const fml::TimePoint start = fml::TimePoint::Now();
+
+  ASSERT_TRUE(capturer.ShouldCapture(start));
+  capturer.Capture(0, start, MakeFrame(size), size, nullptr, snapshot_delegate,
+                   nullptr);
+  EXPECT_FALSE(
+      capturer.ShouldCapture(start + fml::TimeDelta::FromMilliseconds(50)));
+  EXPECT_TRUE(
+      capturer.ShouldCapture(start + fml::TimeDelta::FromMilliseconds(100)));
+
+  ASSERT_EQ(frames.size(), 1u);
+  EXPECT_EQ(frames[0].time, start);
+  ASSERT_TRUE(frames[0].texture);
+  EXPECT_FALSE(frames[0].pixels);
+}
+
+TEST(FrameCapturerTest, DeliversPixelsOfScaledFrames) {
+  std::vector<FrameCapturer::Frame> frames;
+  FrameCapturer capturer(
+      {.max_size = SkISize::Make(50, 50), .read_pixels = true},
+      [&frames](FrameCapturer::Frame frame) { frames.push_back(frame); });
+  SoftwareSnapshotDelegate snapshot_delegate;
+  const SkISize size = SkISize::Make(200, 100);
+
+  capturer.Capture(2, fml::TimePoint::Now(), MakeFrame(size), size, nullptr,
+                   snapshot_delegate, nullptr);
+
+  ASSERT_EQ(snapshot_delegate.snapshot_sizes.size(), 1u);
+  EXPECT_EQ(snapshot_delegate.snapshot_sizes[0], SkISize::Make(50, 25));
+  ASSERT_EQ(frames.size(), 1u);
+  EXPECT_EQ(frames[0].view_id, 2);
+  EXPECT_FALSE(frames[0].texture);
+  ASSERT_TRUE(frames[0].pixels);
+  EXPECT_EQ(frames[0].pixels->dimensions(), SkISize::Make(50, 25));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,38 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_overload_controller.h"
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+FrameOverloadController::FrameOverloadController() = default;
+
+FrameOverloadController::~FrameOverloadController() = default;
+
+void FrameOverloadController::OnFrameRasterized(fml::TimeDelta raster_duration,
+                                                fml::TimeDelta frame_budget) {
+  const bool overloaded = IsOverloaded();
+  const bool counts = overloaded ? raster_duration * 4 < frame_budget * 3
+                                 : raster_duration > frame_budget;
+  if (!counts) {
+    consecutive_frames_ = 0;
+    return;
+  }
+
+  consecutive_frames_++;
+  if (consecutive_frames_ <
+      (overloaded ? kRecoveredFrameCount : kOverloadedFrameCount)) {
+    return;
+  }
+
+  consecutive_frames_ = 0;
+  overloaded_.store(!overloaded, std::memory_order_relaxed);
+  FML_TRACE_COUNTER("flutter", "RasterOverload",
+                    reinterpret_cast<int64_t>(this),  //
+                    "Overloaded", overloaded ? 0 : 1);
+}
+
+}  // namespace flutter
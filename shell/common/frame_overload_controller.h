@@ -0,0 +1,54 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_OVERLOAD_CONTROLLER_H_
+#define FLUTTER_SHELL_COMMON_FRAME_OVERLOAD_CONTROLLER_H_
+
+#include <atomic>
+#include <cstddef>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+/// Detects when rasterization is continuously slower than the frame budget,
+/// for example on devices that throttle their GPU when they heat up.
+///
+/// While overloaded, the |Animator| produces frames at half of the vsync rate
+/// and the |Rasterizer| only draws the most recent frame of its pipeline,
+/// instead of spending CPU on frames that will be late anyway. It recovers
+/// once frames rasterize comfortably within the budget again.
+class FrameOverloadController {
+ public:
+  /// The number of consecutive frames over budget that start an overload.
+  static constexpr size_t kOverloadedFrameCount = 10;
+
+  /// The number of consecutive frames under three quarters of the budget that
+  /// end an overload.
+  static constexpr size_t kRecoveredFrameCount = 30;
+
+  FrameOverloadController();
+
+  ~FrameOverloadController();
+
+  /// Must only be called on the raster thread.
+  void OnFrameRasterized(fml::TimeDelta raster_duration,
+                         fml::TimeDelta frame_budget);
+
+  /// May be called on any thread.
+  bool IsOverloaded() const {
+    return overloaded_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  size_t consecutive_frames_ = 0;
+  std::atomic<bool> overloaded_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameOverloadController);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_OVERLOAD_CONTROLLER_H_
@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_overload_controller.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr fml::TimeDelta kFrameBudget = fml::TimeDelta::FromMilliseconds(16);
+
+void RasterizeFrames(FrameOverloadController& controller,
+                     size_t count,
+                     int64_t raster_millis) {
+  for (size_t i = 0; i < count; i++) {
+    controller.OnFrameRasterized(
+        fml::TimeDelta::FromMilliseconds(raster_millis), kFrameBudget);
+  }
+}
+
+}  // namespace
+
+TEST(FrameOverloadControllerTest, OverloadsAfterConsecutiveSlowFrames) {
+  FrameOverloadController controller;
+  RasterizeFrames(controller,
+                  FrameOverloadController::kOverloadedFrameCount - 1, 20);
+  EXPECT_FALSE(controller.IsOverloaded());
+
+  RasterizeFrames(controller, 1, 20);
+  EXPECT_TRUE(controller.IsOverloaded());
+}
+
+TEST(FrameOverloadControllerTest, ToleratesOccasionalSlowFrames) {
+  FrameOverloadController controller;
+  for (size_t i = 0; i < 10; i++) {
+    RasterizeFrames(controller,
+                    FrameOverloadController::kOverloadedFrameCount - 1, 20);
+    RasterizeFrames(controller, 1, 10);
+  }
+  EXPECT_FALSE(controller.IsOverloaded());
+}
+
+TEST(FrameOverloadControllerTest, RecoversAfterConsecutiveFastFrames) {
+  FrameOverloadController controller;
+  RasterizeFrames(controller, FrameOverloadController::kOverloadedFrameCount,
+                  20);
+  ASSERT_TRUE(controller.IsOverloaded());
+
+  // Frames that only just fit the budget do not end the overload, as the
+  // frame rate would drop again as soon as it is restored.
+  RasterizeFrames(controller, FrameOverloadController::kRecoveredFrameCount,
+                  14);
+  EXPECT_TRUE(controller.IsOverloaded());
+
+  RasterizeFrames(controller, FrameOverloadController::kRecoveredFrameCount - 1,
+                  8);
+  EXPECT_TRUE(controller.IsOverloaded());
+
+  RasterizeFrames(controller, 1, 8);
+  EXPECT_FALSE(controller.IsOverloaded());
+}
+
+}  // namespace testing
+}  // namespace flutter
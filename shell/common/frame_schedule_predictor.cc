@@ -0,0 +1,69 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_schedule_predictor.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace flutter {
+
+namespace {
+
+constexpr fml::TimeDelta kMinSafetyMargin = fml::TimeDelta::FromMilliseconds(2);
+
+// Delays shorter than this are not worth the risk of missing the deadline.
+constexpr fml::TimeDelta kMinStartDelay = fml::TimeDelta::FromMilliseconds(1);
+
+fml::TimeDelta Percentile90(const std::deque<fml::TimeDelta>& durations) {
+  std::vector<fml::TimeDelta> sorted(durations.begin(), durations.end());
+  const size_t index = (sorted.size() * 9) / 10;
+  std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+  return sorted[index];
+}
+
+}  // namespace
+
+FrameSchedulePredictor::FrameSchedulePredictor() = default;
+
+FrameSchedulePredictor::~FrameSchedulePredictor() = default;
+
+void FrameSchedulePredictor::AddFrame(fml::TimeDelta build_duration,
+                                      fml::TimeDelta raster_duration) {
+  build_durations_.push_back(build_duration);
+  raster_durations_.push_back(raster_duration);
+  if (build_durations_.size() > kHistorySize) {
+    build_durations_.pop_front();
+    raster_durations_.pop_front();
+  }
+}
+
+FrameSchedulePredictor::Schedule FrameSchedulePredictor::Predict(
+    fml::TimeDelta frame_interval) const {
+  Schedule schedule;
+  if (build_durations_.size() < kMinHistorySize ||
+      frame_interval <= fml::TimeDelta::Zero()) {
+    return schedule;
+  }
+
+  schedule.predicted_duration =
+      Percentile90(build_durations_) + Percentile90(raster_durations_);
+
+  if (schedule.predicted_duration > frame_interval) {
+    schedule.mode = Mode::kPipelined;
+    return schedule;
+  }
+
+  const fml::TimeDelta safety_margin =
+      std::max(kMinSafetyMargin, frame_interval / 10);
+  const fml::TimeDelta slack =
+      frame_interval - schedule.predicted_duration - safety_margin;
+  if (slack >= kMinStartDelay) {
+    schedule.mode = Mode::kDelayed;
+    schedule.start_delay = std::min(slack, frame_interval / 2);
+  }
+  return schedule;
+}
+
+}  // namespace flutter
@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_SCHEDULE_PREDICTOR_H_
+#define FLUTTER_SHELL_COMMON_FRAME_SCHEDULE_PREDICTOR_H_
+
+#include <deque>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+/// Decides when the |Animator| starts to build a frame from the build and
+/// raster durations of the most recent frames.
+class FrameSchedulePredictor {
+ public:
+  enum class Mode {
+    /// Builds at vsync for the next vsync target. Used until there is enough
+    /// history to predict from.
+    kVsync = 0,
+    /// Delays the build into the slack of the frame interval, so that the
+    /// frame reflects more recent input.
+    kDelayed = 1,
+    /// Builds at vsync for the vsync target after the next one, because the
+    /// frame cannot be built and rasterized within one interval.
+    kPipelined = 2,
+  };
+
+  struct Schedule {
+    Mode mode = Mode::kVsync;
+    /// How long after vsync the build starts.
+    fml::TimeDelta start_delay;
+    /// The predicted time from the start of the build to the end of
+    /// rasterization.
+    fml::TimeDelta predicted_duration;
+  };
+
+  /// The number of frames the predictions are made from.
+  static constexpr size_t kHistorySize = 32;
+
+  /// The number of frames needed before the schedule deviates from vsync.
+  static constexpr size_t kMinHistorySize = 8;
+
+  FrameSchedulePredictor();
+
+  ~FrameSchedulePredictor();
+
+  void AddFrame(fml::TimeDelta build_duration, fml::TimeDelta raster_duration);
+
+  /// Returns the schedule of the next frame for vsyncs |frame_interval|
+  /// apart.
+  ///
+  /// The durations are predicted from the 90th percentile of the history,
+  /// which tolerates the odd slow frame without chasing it. Delays keep a
+  /// safety margin of a tenth of the interval, and at least two
+  /// milliseconds, and never exceed half of the interval.
+  Schedule Predict(fml::TimeDelta frame_interval) const;
+
+ private:
+  std::deque<fml::TimeDelta> build_durations_;
+  std::deque<fml::TimeDelta> raster_durations_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameSchedulePredictor);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_SCHEDULE_PREDICTOR_H_
@@ -0,0 +1,96 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_schedule_predictor.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr fml::TimeDelta kFrameInterval = fml::TimeDelta::FromMilliseconds(16);
+
+void AddFrames(FrameSchedulePredictor& predictor,
+               size_t count,
+               int64_t build_millis,
+               int64_t raster_millis) {
+  for (size_t i = 0; i < count; i++) {
+    predictor.AddFrame(fml::TimeDelta::FromMilliseconds(build_millis),
+                       fml::TimeDelta::FromMilliseconds(raster_millis));
+  }
+}
+
+}  // namespace
+
+TEST(FrameSchedulePredictorTest, StartsAtVsyncWithoutHistory) {
+  FrameSchedulePredictor predictor;
+  AddFrames(predictor, FrameSchedulePredictor::kMinHistorySize - 1, 1, 1);
+
+  const auto schedule = predictor.Predict(kFrameInterval);
+  EXPECT_EQ(schedule.mode, FrameSchedulePredictor::Mode::kVsync);
+  EXPECT_EQ(schedule.start_delay, fml::TimeDelta::Zero());
+  EXPECT_EQ(schedule.predicted_duration, fml::TimeDelta::Zero());
+}
+
+TEST(FrameSchedulePredictorTest, DelaysCheapFrames) {
+  FrameSchedulePredictor predictor;
+  AddFrames(predictor, FrameSchedulePredictor::kMinHistorySize, 3, 4);
+
+  const auto schedule = predictor.Predict(kFrameInterval);
+  EXPECT_EQ(schedule.mode, FrameSchedulePredictor::Mode::kDelayed);
+  EXPECT_EQ(schedule.predicted_duration, fml::TimeDelta::FromMilliseconds(7));
+  // 16ms - 7ms - the 2ms safety margin.
+  EXPECT_EQ(schedule.start_delay, fml::TimeDelta::FromMilliseconds(7));
+}
+
+TEST(FrameSchedulePredictorTest, DelaysAtMostHalfTheInterval) {
+  FrameSchedulePredictor predictor;
+  AddFrames(predictor, FrameSchedulePredictor::kMinHistorySize, 0, 1);
+
+  const auto schedule = predictor.Predict(kFrameInterval);
+  EXPECT_EQ(schedule.mode, FrameSchedulePredictor::Mode::kDelayed);
+  EXPECT_EQ(schedule.start_delay, kFrameInterval / 2);
+}
+
+TEST(FrameSchedulePredictorTest, StartsAtVsyncWithoutSlack) {
+  FrameSchedulePredictor predictor;
+  AddFrames(predictor, FrameSchedulePredictor::kMinHistorySize, 6, 8);
+
+  const auto schedule = predictor.Predict(kFrameInterval);
+  EXPECT_EQ(schedule.mode, FrameSchedulePredictor::Mode::kVsync);
+  EXPECT_EQ(schedule.start_delay, fml::TimeDelta::Zero());
+}
+
+TEST(FrameSchedulePredictorTest, PipelinesSlowFrames) {
+  FrameSchedulePredictor predictor;
+  AddFrames(predictor, FrameSchedulePredictor::kMinHistorySize, 6, 14);
+
+  const auto schedule = predictor.Predict(kFrameInterval);
+  EXPECT_EQ(schedule.mode, FrameSchedulePredictor::Mode::kPipelined);
+  EXPECT_EQ(schedule.start_delay, fml::TimeDelta::Zero());
+  EXPECT_EQ(schedule.predicted_duration, fml::TimeDelta::FromMilliseconds(20));
+}
+
+TEST(FrameSchedulePredictorTest, IgnoresOccasionalSlowFrames) {
+  FrameSchedulePredictor predictor;
+  AddFrames(predictor, 30, 3, 4);
+  AddFrames(predictor, 2, 20, 20);
+
+  EXPECT_EQ(predictor.Predict(kFrameInterval).mode,
+            FrameSchedulePredictor::Mode::kDelayed);
+}
+
+TEST(FrameSchedulePredictorTest, ForgetsOldFrames) {
+  FrameSchedulePredictor predictor;
+  AddFrames(predictor, FrameSchedulePredictor::kHistorySize, 20, 20);
+  AddFrames(predictor, FrameSchedulePredictor::kHistorySize, 3, 4);
+
+  EXPECT_EQ(predictor.Predict(kFrameInterval).mode,
+            FrameSchedulePredictor::Mode::kDelayed);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,60 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/idle_work_scheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+IdleWorkScheduler::IdleWorkScheduler(Clock clock) : clock_(std::move(clock)) {}
+
+IdleWorkScheduler::~IdleWorkScheduler() = default;
+
+void IdleWorkScheduler::Add(std::string name,
+                            Priority priority,
+                            fml::TimeDelta initial_cost,
+                            fml::TimeDelta min_interval,
+                            fml::closure work) {
+  auto position = std::upper_bound(
+      entries_.begin(), entries_.end(), priority,
+      [](Priority priority, const Entry& entry) {
+        return priority < entry.priority;
+      });
+  entries_.insert(position, {
+                                .name = std::move(name),
+                                .priority = priority,
+                                .cost = initial_cost,
+                                .min_interval = min_interval,
+                                .work = std::move(work),
+                            });
+}
+
+size_t IdleWorkScheduler::RunUntil(fml::TimePoint deadline) {
+  size_t ran = 0;
+  for (Entry& entry : entries_) {
+    const fml::TimePoint start = clock_();
+    if (start + entry.cost > deadline) {
+      continue;
+    }
+    if (entry.last_run != fml::TimePoint() &&
+        start - entry.last_run < entry.min_interval) {
+      continue;
+    }
+    {
+      TRACE_EVENT1("flutter", "IdleWork", "name", entry.name.c_str());
+      entry.work();
+    }
+    const fml::TimePoint end = clock_();
+    entry.cost = end - start;
+    entry.last_run = end;
+    ran++;
+  }
+  return ran;
+}
+
+}  // namespace flutter
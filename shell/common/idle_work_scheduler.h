@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_IDLE_WORK_SCHEDULER_H_
+#define FLUTTER_SHELL_COMMON_IDLE_WORK_SCHEDULER_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Spends the time until a deadline, such as the start of the next
+///             frame, on deferrable work like purging GPU caches.
+///
+///             Work runs in the order of its priority, and only if it is
+///             expected to finish before the deadline. The cost of work is
+///             measured every time it runs, so work that did not fit into one
+///             idle period waits for a longer one while cheaper work of lower
+///             priority still runs.
+///
+///             The scheduler is not thread safe, it must be used on the thread
+///             that its work runs on.
+///
+class IdleWorkScheduler {
+ public:
+  enum class Priority {
+    kHigh,
+    kMedium,
+    kLow,
+  };
+
+  using Clock = std::function<fml::TimePoint()>;
+
+  explicit IdleWorkScheduler(Clock clock = fml::TimePoint::Now);
+
+  ~IdleWorkScheduler();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds work that runs in the idle periods it fits in.
+  ///
+  /// @param[in]  name          The name of the work in traces.
+  /// @param[in]  priority      The priority of the work.
+  /// @param[in]  initial_cost  The expected duration of the work until it has
+  ///                           run once.
+  /// @param[in]  min_interval  The shortest time between two runs of the
+  ///                           work.
+  /// @param[in]  work          The work.
+  ///
+  void Add(std::string name,
+           Priority priority,
+           fml::TimeDelta initial_cost,
+           fml::TimeDelta min_interval,
+           fml::closure work);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Runs the work that fits before `deadline`.
+  ///
+  /// @return     The number of pieces of work that ran.
+  ///
+  size_t RunUntil(fml::TimePoint deadline);
+
+ private:
+  struct Entry {
+    std::string name;
+    Priority priority;
+    fml::TimeDelta cost;
+    fml::TimeDelta min_interval;
+    fml::closure work;
+    fml::TimePoint last_run;
+  };
+
+  const Clock clock_;
+  // Sorted by priority, in the order the work was added within a priority.
+  std::vector<Entry> entries_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(IdleWorkScheduler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_IDLE_WORK_SCHEDULER_H_
@@ -0,0 +1,90 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/idle_work_scheduler.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+using Priority = IdleWorkScheduler::Priority;
+
+constexpr fml::TimeDelta kMillisecond = fml::TimeDelta::FromMilliseconds(1);
+
+class FakeClock {
+ public:
+  IdleWorkScheduler::Clock AsClock() {
+    return [this]() { return now; };
+  }
+
+  fml::TimePoint now = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromSeconds(10));
+};
+
+}  // namespace
+
+TEST(IdleWorkSchedulerTest, RunsWorkInPriorityOrder) {
+  FakeClock clock;
+  IdleWorkScheduler scheduler(clock.AsClock());
+  std::vector<std::string> ran;
+  scheduler.Add("Low", Priority::kLow, kMillisecond, {},
+                [&ran]() { ran.push_back("Low"); });
+  scheduler.Add("High", Priority::kHigh, kMillisecond, {},
+                [&ran]() { ran.push_back("High"); });
+  scheduler.Add("Medium", Priority::kMedium, kMillisecond, {},
+                [&ran]() { ran.push_back("Medium"); });
+  scheduler.Add("SecondHigh", Priority::kHigh, kMillisecond, {},
+                [&ran]() { ran.push_back("SecondHigh"); });
+
+  EXPECT_EQ(scheduler.RunUntil(clock.now + kMillisecond * 10), 4u);
+  EXPECT_EQ(ran, (std::vector<std::string>{"High", "SecondHigh", "Medium",
+                                           "Low"}));
+}
+
+TEST(IdleWorkSchedulerTest, SkipsWorkThatDoesNotFitTheHeadroom) {
+  FakeClock clock;
+  IdleWorkScheduler scheduler(clock.AsClock());
+  std::vector<std::string> ran;
+  scheduler.Add("Expensive", Priority::kHigh, kMillisecond * 2, {},
+                [&]() {
+                  ran.push_back("Expensive");
+                  clock.now = clock.now + kMillisecond * 8;
+                });
+  scheduler.Add("Cheap", Priority::kLow, kMillisecond * 2, {},
+                [&]() { ran.push_back("Cheap"); });
+
+  // The initial cost of the expensive work fits, but it measures longer and
+  // leaves no room for the cheap work.
+  EXPECT_EQ(scheduler.RunUntil(clock.now + kMillisecond * 9), 1u);
+  EXPECT_EQ(ran, (std::vector<std::string>{"Expensive"}));
+
+  // The cheap work runs in the next idle period, the measured cost of the
+  // expensive work no longer fits.
+  ran.clear();
+  EXPECT_EQ(scheduler.RunUntil(clock.now + kMillisecond * 5), 1u);
+  EXPECT_EQ(ran, (std::vector<std::string>{"Cheap"}));
+}
+
+TEST(IdleWorkSchedulerTest, RespectsTheMinInterval) {
+  FakeClock clock;
+  IdleWorkScheduler scheduler(clock.AsClock());
+  size_t runs = 0;
+  scheduler.Add("Purge", Priority::kHigh, {}, kMillisecond * 100,
+                [&runs]() { runs++; });
+
+  EXPECT_EQ(scheduler.RunUntil(clock.now + kMillisecond * 10), 1u);
+  clock.now = clock.now + kMillisecond * 50;
+  EXPECT_EQ(scheduler.RunUntil(clock.now + kMillisecond * 10), 0u);
+  clock.now = clock.now + kMillisecond * 50;
+  EXPECT_EQ(scheduler.RunUntil(clock.now + kMillisecond * 10), 1u);
+  EXPECT_EQ(runs, 2u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -5,15 +5,15 @@
 #ifndef FLUTTER_SHELL_COMMON_PIPELINE_H_
 #define FLUTTER_SHELL_COMMON_PIPELINE_H_
 
-#include <deque>
+#include <atomic>
 #include <memory>
-#include <mutex>
+#include <utility>
+#include <vector>
 
 #include "flutter/flow/frame_timings.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
-#include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -36,8 +36,9 @@ enum class PipelineConsumeResult {
 
 size_t GetNextPipelineTraceID();
 
-/// A thread-safe queue of resources for a single consumer and a single
-/// producer, with a maximum queue depth.
+/// A lock-free queue of resources for a single consumer and a single
+/// producer, with a maximum queue depth. The producer can run ahead of the
+/// consumer by as many resources as the depth.
 ///
 /// Pipelines support two key operations: produce and consume.
 ///
@@ -128,12 +129,11 @@ class Pipeline {
     FML_DISALLOW_COPY_AND_ASSIGN(ProducerContinuation);
   };
 
-  explicit Pipeline(uint32_t depth)
-      : empty_(depth), available_(0), inflight_(0) {}
+  explicit Pipeline(uint32_t depth) : slots_(depth) {}
 
   ~Pipeline() = default;
 
-  bool IsValid() const { return empty_.IsValid() && available_.IsValid(); }
+  bool IsValid() const { return !slots_.empty(); }
 
   /// Creates a `ProducerContinuation` that a producer can use to add a
   /// resource to the queue.
@@ -141,14 +141,9 @@ class Pipeline {
   /// If the queue is already at its maximum depth, the `ProducerContinuation`
   /// is returned with success = false.
   ProducerContinuation Produce() {
-    if (!empty_.TryWait()) {
+    if (!Reserve()) {
       return {};
     }
-    ++inflight_;
-    FML_TRACE_COUNTER("flutter", "Pipeline Depth",
-                      reinterpret_cast<int64_t>(this),      //
-                      "frames in flight", inflight_.load()  //
-    );
 
     return ProducerContinuation{
         std::bind(&Pipeline::ProducerCommit, this, std::placeholders::_1,
@@ -160,16 +155,13 @@ class Pipeline {
   /// queue is empty.
   ///
   /// Prefer using |Produce|. ProducerContinuation returned by this method
-  /// doesn't guarantee that the frame will be rendered.
+  /// doesn't guarantee that the frame will be rendered. It must be completed
+  /// on the consumer thread, and the resource is consumed before the ones
+  /// from |Produce|.
   ProducerContinuation ProduceIfEmpty() {
-    if (!empty_.TryWait()) {
+    if (!Reserve()) {
       return {};
     }
-    ++inflight_;
-    FML_TRACE_COUNTER("flutter", "Pipeline Depth",
-                      reinterpret_cast<int64_t>(this),      //
-                      "frames in flight", inflight_.load()  //
-    );
 
     return ProducerContinuation{
         std::bind(&Pipeline::ProducerCommitIfEmpty, this, std::placeholders::_1,
@@ -185,25 +177,28 @@ class Pipeline {
       return PipelineConsumeResult::NoneAvailable;
     }
 
-    if (!available_.TryWait()) {
-      return PipelineConsumeResult::NoneAvailable;
-    }
-
     ResourcePtr resource;
     size_t trace_id = 0;
-    size_t items_count = 0;
 
-    {
-      std::scoped_lock lock(queue_mutex_);
-      std::tie(resource, trace_id) = std::move(queue_.front());
-      queue_.pop_front();
-      items_count = queue_.size();
+    if (has_front_.load()) {
+      std::tie(resource, trace_id) = std::move(front_);
+      has_front_.store(false);
+    } else {
+      const size_t head = head_.load(std::memory_order_relaxed);
+      if (head == tail_.load()) {
+        return PipelineConsumeResult::NoneAvailable;
+      }
+      std::tie(resource, trace_id) = std::move(slots_[head % slots_.size()]);
+      head_.store(head + 1);
     }
+    // Sequentially consistent with the producer publishing |tail_|, so that
+    // either this sees its resource or it sees the queue as non-empty and
+    // reports |is_first_item| to have the consumer scheduled again.
+    const size_t items_count = tail_.load() - head_.load();
 
     consumer(std::move(resource));
 
-    empty_.Signal();
-    --inflight_;
+    Release();
 
     TRACE_FLOW_END("flutter", "PipelineItem", trace_id);
     TRACE_EVENT_ASYNC_END0("flutter", "PipelineItem", trace_id);
@@ -212,43 +207,88 @@ class Pipeline {
                            : PipelineConsumeResult::Done;
   }
 
+  /// Discards every produced resource but the most recent one, for consumers
+  /// that have fallen so far behind that the older resources are stale. The
+  /// resource from |ProduceIfEmpty| is never discarded. Must be called on the
+  /// consumer thread.
+  ///
+  /// @return The number of discarded resources.
+  size_t DiscardStale() {
+    if (has_front_.load()) {
+      return 0;
+    }
+
+    size_t discarded = 0;
+    size_t head = head_.load(std::memory_order_relaxed);
+    while (tail_.load() - head > 1) {
+      auto [resource, trace_id] = std::move(slots_[head % slots_.size()]);
+      head_.store(++head);
+      resource.reset();
+      Release();
+
+      TRACE_FLOW_END("flutter", "PipelineItem", trace_id);
+      TRACE_EVENT_ASYNC_END0("flutter", "PipelineItem", trace_id);
+      discarded++;
+    }
+    return discarded;
+  }
+
  private:
-  fml::Semaphore empty_;
-  fml::Semaphore available_;
-  std::atomic<int> inflight_;
-  std::mutex queue_mutex_;
-  std::deque<std::pair<ResourcePtr, size_t>> queue_;
+  // The produced resources are a ring of |slots_| written by the producer at
+  // |tail_| and read by the consumer at |head_|. Both only ever increase.
+  // Reserving a slot in |Produce| bounds the number of resources to the depth
+  // of the pipeline, so the producer never overwrites an unconsumed slot.
+  std::vector<std::pair<ResourcePtr, size_t>> slots_;
+  std::atomic<size_t> head_ = 0;
+  std::atomic<size_t> tail_ = 0;
+  // Resources and continuations in flight, up to the depth of the pipeline.
+  std::atomic<uint32_t> reserved_ = 0;
+  // The resource from |ProduceIfEmpty|, which is committed by the consumer
+  // and only touched by its thread.
+  std::pair<ResourcePtr, size_t> front_;
+  std::atomic<bool> has_front_ = false;
+
+  bool Reserve() {
+    uint32_t reserved = reserved_.load(std::memory_order_relaxed);
+    do {
+      if (reserved >= slots_.size()) {
+        return false;
+      }
+    } while (!reserved_.compare_exchange_weak(reserved, reserved + 1,
+                                              std::memory_order_acquire,
+                                              std::memory_order_relaxed));
+    FML_TRACE_COUNTER("flutter", "Pipeline Depth",
+                      reinterpret_cast<int64_t>(this),  //
+                      "frames in flight", reserved + 1  //
+    );
+    return true;
+  }
+
+  void Release() { reserved_.fetch_sub(1, std::memory_order_release); }
 
   /// Commits a produced resource to the queue and signals the consumer that a
   /// resource is available.
   PipelineProduceResult ProducerCommit(ResourcePtr resource, size_t trace_id) {
-    bool is_first_item = false;
-    {
-      std::scoped_lock lock(queue_mutex_);
-      is_first_item = queue_.empty();
-      queue_.emplace_back(std::move(resource), trace_id);
-    }
-
-    // Ensure the queue mutex is not held as that would be a pessimization.
-    available_.Signal();
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    slots_[tail % slots_.size()] = {std::move(resource), trace_id};
+    tail_.store(tail + 1);
+    // The queue was empty if the consumer is at the new resource, or already
+    // past it. When it is behind, it will see the new resource once it
+    // reaches it, see |Consume|.
+    const bool is_first_item = head_.load() >= tail && !has_front_.load();
     return {.success = true, .is_first_item = is_first_item};
   }
 
   PipelineProduceResult ProducerCommitIfEmpty(ResourcePtr resource,
                                               size_t trace_id) {
-    {
-      std::scoped_lock lock(queue_mutex_);
-      if (!queue_.empty()) {
-        // Bail if the queue is not empty, opens up spaces to produce other
-        // frames.
-        empty_.Signal();
-        return {.success = false, .is_first_item = false};
-      }
-      queue_.emplace_back(std::move(resource), trace_id);
+    if (has_front_.load() || head_.load() != tail_.load()) {
+      // Bail if the queue is not empty, opens up spaces to produce other
+      // frames.
+      Release();
+      return {.success = false, .is_first_item = false};
     }
-
-    // Ensure the queue mutex is not held as that would be a pessimization.
-    available_.Signal();
+    front_ = {std::move(resource), trace_id};
+    has_front_.store(true);
     return {.success = true, .is_first_item = true};
   }
 
@@ -144,5 +144,93 @@ TEST(PipelineTest, ProduceIfEmptySuccessfulIfQueueIsEmpty) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, ProducerRunsAheadByDepth) {
+  const int depth = 3;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+
+  for (int i = 0; i < depth; i++) {
+    PipelineProduceResult result =
+        pipeline->Produce().Complete(std::make_unique<int>(i));
+    ASSERT_EQ(result.success, true);
+    ASSERT_EQ(result.is_first_item, i == 0);
+  }
+  ASSERT_FALSE(pipeline->Produce());
+
+  for (int i = 0; i < depth; i++) {
+    PipelineConsumeResult consume_result = pipeline->Consume(
+        [i](std::unique_ptr<int> v) { ASSERT_EQ(*v, i); });
+    ASSERT_EQ(consume_result, PipelineConsumeResult::MoreAvailable);
+    // Consuming frees a slot for the producer.
+    PipelineProduceResult result =
+        pipeline->Produce().Complete(std::make_unique<int>(depth + i));
+    ASSERT_EQ(result.success, true);
+  }
+  for (int i = 0; i < depth; i++) {
+    PipelineConsumeResult consume_result = pipeline->Consume(
+        [i](std::unique_ptr<int> v) { ASSERT_EQ(*v, depth + i); });
+    ASSERT_EQ(consume_result, i + 1 < depth
+                                  ? PipelineConsumeResult::MoreAvailable
+                                  : PipelineConsumeResult::Done);
+  }
+  ASSERT_EQ(pipeline->Consume([](std::unique_ptr<int> v) { FAIL(); }),
+            PipelineConsumeResult::NoneAvailable);
+}
+
+TEST(PipelineTest, ProduceIfEmptyIsConsumedFirst) {
+  const int depth = 2;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+
+  PipelineProduceResult result =
+      pipeline->ProduceIfEmpty().Complete(std::make_unique<int>(1));
+  ASSERT_EQ(result.success, true);
+  // The consumer is already going to consume the resubmitted resource.
+  result = pipeline->Produce().Complete(std::make_unique<int>(2));
+  ASSERT_EQ(result.success, true);
+  ASSERT_EQ(result.is_first_item, false);
+  ASSERT_FALSE(pipeline->Produce());
+
+  PipelineConsumeResult consume_result = pipeline->Consume(
+      [](std::unique_ptr<int> v) { ASSERT_EQ(*v, 1); });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::MoreAvailable);
+  consume_result = pipeline->Consume(
+      [](std::unique_ptr<int> v) { ASSERT_EQ(*v, 2); });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::Done);
+}
+
+TEST(PipelineTest, DiscardStaleKeepsMostRecentResource) {
+  const int depth = 3;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+  ASSERT_EQ(pipeline->DiscardStale(), 0u);
+
+  for (int i = 1; i <= depth; i++) {
+    ASSERT_TRUE(pipeline->Produce().Complete(std::make_unique<int>(i)).success);
+  }
+  ASSERT_EQ(pipeline->DiscardStale(), 2u);
+  // The discarded resources no longer count towards the depth.
+  ASSERT_TRUE(pipeline->Produce().Complete(std::make_unique<int>(4)).success);
+
+  PipelineConsumeResult consume_result = pipeline->Consume(
+      [](std::unique_ptr<int> v) { ASSERT_EQ(*v, 3); });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::MoreAvailable);
+  ASSERT_EQ(pipeline->DiscardStale(), 0u);
+  consume_result = pipeline->Consume(
+      [](std::unique_ptr<int> v) { ASSERT_EQ(*v, 4); });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::Done);
+}
+
+TEST(PipelineTest, DiscardStaleKeepsResubmittedResources) {
+  const int depth = 2;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+
+  ASSERT_TRUE(
+      pipeline->ProduceIfEmpty().Complete(std::make_unique<int>(1)).success);
+  ASSERT_TRUE(pipeline->Produce().Complete(std::make_unique<int>(2)).success);
+  ASSERT_EQ(pipeline->DiscardStale(), 0u);
+
+  PipelineConsumeResult consume_result = pipeline->Consume(
+      [](std::unique_ptr<int> v) { ASSERT_EQ(*v, 1); });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::MoreAvailable);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -4,6 +4,8 @@
 
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 
+#include <iterator>
+
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -15,6 +17,33 @@ SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate)
     : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
 SmoothPointerDataDispatcher::~SmoothPointerDataDispatcher() = default;
 
+CoalescingPointerDataDispatcher::CoalescingPointerDataDispatcher(
+    Delegate& delegate,
+    bool merge_moves)
+    : DefaultPointerDataDispatcher(delegate),
+      merge_moves_(merge_moves),
+      weak_factory_(this) {}
+CoalescingPointerDataDispatcher::~CoalescingPointerDataDispatcher() = default;
+
+namespace {
+
+bool IsContinuous(const PointerData& data) {
+  return (data.change == PointerData::Change::kHover ||
+          data.change == PointerData::Change::kMove) &&
+         data.signal_kind == PointerData::SignalKind::kNone;
+}
+
+bool CanMerge(const PointerData& previous, const PointerData& next) {
+  return IsContinuous(previous) && IsContinuous(next) &&
+         previous.change == next.change && previous.kind == next.kind &&
+         previous.device == next.device &&
+         previous.pointer_identifier == next.pointer_identifier &&
+         previous.buttons == next.buttons &&
+         previous.synthesized == next.synthesized;
+}
+
+}  // namespace
+
 void DefaultPointerDataDispatcher::DispatchPacket(
     std::unique_ptr<PointerDataPacket> packet,
     uint64_t trace_flow_id) {
@@ -72,4 +101,96 @@ void SmoothPointerDataDispatcher::DispatchPendingPacket() {
   ScheduleSecondaryVsyncCallback();
 }
 
+void CoalescingPointerDataDispatcher::DispatchPacket(
+    std::unique_ptr<PointerDataPacket> packet,
+    uint64_t trace_flow_id) {
+  TRACE_EVENT0_WITH_FLOW_IDS("flutter",
+                             "CoalescingPointerDataDispatcher::DispatchPacket",
+                             /*flow_id_count=*/1, &trace_flow_id);
+  TRACE_FLOW_STEP("flutter", "PointerEvent", trace_flow_id);
+
+  if (!is_pointer_data_in_progress_) {
+    FML_DCHECK(pending_trace_flow_ids_.empty());
+    DefaultPointerDataDispatcher::DispatchPacket(std::move(packet),
+                                                 trace_flow_id);
+    is_pointer_data_in_progress_ = true;
+    ScheduleSecondaryVsyncCallback();
+    return;
+  }
+
+  bool is_continuous = true;
+  const size_t length = packet->GetLength();
+  for (size_t i = 0; i < length; i++) {
+    const PointerData data = packet->GetPointerData(i);
+    is_continuous = is_continuous && IsContinuous(data);
+    AddPendingPointerData(data);
+  }
+  pending_trace_flow_ids_.push_back(trace_flow_id);
+
+  // Events other than moves are not held back, so that taps and the end of
+  // gestures are not delayed by a frame.
+  if (!is_continuous) {
+    DispatchPendingPackets();
+  }
+}
+
+void CoalescingPointerDataDispatcher::AddPendingPointerData(
+    const PointerData& data) {
+  if (merge_moves_) {
+    // Look for an earlier event of the same pointer, stopping at any event
+    // of that pointer that can't be merged so the order of its events is
+    // preserved.
+    for (auto it = pending_data_.rbegin(); it != pending_data_.rend(); ++it) {
+      if (it->device != data.device || it->kind != data.kind) {
+        continue;
+      }
+      if (!CanMerge(*it, data)) {
+        break;
+      }
+      PointerData merged = data;
+      merged.physical_delta_x += it->physical_delta_x;
+      merged.physical_delta_y += it->physical_delta_y;
+      pending_data_.erase(std::next(it).base());
+      pending_data_.push_back(merged);
+      return;
+    }
+  }
+  pending_data_.push_back(data);
+}
+
+void CoalescingPointerDataDispatcher::ScheduleSecondaryVsyncCallback() {
+  delegate_.ScheduleSecondaryVsyncCallback(
+      reinterpret_cast<uintptr_t>(this),
+      [dispatcher = weak_factory_.GetWeakPtr()]() {
+        if (dispatcher && dispatcher->is_pointer_data_in_progress_) {
+          if (!dispatcher->pending_trace_flow_ids_.empty()) {
+            dispatcher->DispatchPendingPackets();
+          } else {
+            dispatcher->is_pointer_data_in_progress_ = false;
+          }
+        }
+      });
+}
+
+void CoalescingPointerDataDispatcher::DispatchPendingPackets() {
+  FML_DCHECK(!pending_trace_flow_ids_.empty());
+  FML_DCHECK(is_pointer_data_in_progress_);
+  auto packet = std::make_unique<PointerDataPacket>(pending_data_.size());
+  for (size_t i = 0; i < pending_data_.size(); i++) {
+    packet->SetPointerData(i, pending_data_[i]);
+  }
+  // The flow of the last packet continues into the frame. The flows of the
+  // packets coalesced into it end here.
+  const uint64_t trace_flow_id = pending_trace_flow_ids_.back();
+  pending_trace_flow_ids_.pop_back();
+  for (uint64_t coalesced_flow_id : pending_trace_flow_ids_) {
+    TRACE_FLOW_END("flutter", "PointerEvent", coalesced_flow_id);
+  }
+  pending_data_.clear();
+  pending_trace_flow_ids_.clear();
+  DefaultPointerDataDispatcher::DispatchPacket(std::move(packet),
+                                               trace_flow_id);
+  ScheduleSecondaryVsyncCallback();
+}
+
 }  // namespace flutter
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_COMMON_POINTER_DATA_DISPATCHER_H_
 #define FLUTTER_SHELL_COMMON_POINTER_DATA_DISPATCHER_H_
 
+#include <vector>
+
 #include "flutter/runtime/runtime_controller.h"
 #include "flutter/shell/common/animator.h"
 
@@ -20,7 +22,8 @@ class PointerDataDispatcher;
 /// This class is used to filter the packets so the Flutter framework on the UI
 /// thread will receive packets with some desired properties. See
 /// `SmoothPointerDataDispatcher` for an example which filters irregularly
-/// delivered packets, and dispatches them in sync with the VSYNC signal.
+/// delivered packets, and dispatches them in sync with the VSYNC signal, and
+/// `CoalescingPointerDataDispatcher` which batches them per VSYNC.
 ///
 /// This object will be owned by the engine because it relies on the engine's
 /// `Animator` (which owns `VsyncWaiter`) and `RuntimeController` to do the
@@ -163,6 +166,54 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   FML_DISALLOW_COPY_AND_ASSIGN(SmoothPointerDataDispatcher);
 };
 
+//------------------------------------------------------------------------------
+/// A dispatcher that batches the packets received within one VSYNC into a
+/// single packet, so that high rate input devices (for example 240Hz touch
+/// screens or 1000Hz mice) wake the UI thread at most about once per frame.
+///
+/// Like `SmoothPointerDataDispatcher`, the first packet after an idle frame is
+/// dispatched right away, and packets received while a dispatch is in
+/// progress are held back until the next vsync. Unlike it, all the held back
+/// packets are dispatched together rather than one per packet.
+///
+/// Only continuous events (hover and move) are held back. A packet with any
+/// other event, such as a down or an up, is dispatched right away together
+/// with the held back events, so taps are not delayed and the order of the
+/// events is preserved.
+///
+/// If `merge_moves` is true, consecutive hover or move events of the same
+/// device and buttons in a batch are additionally merged into the latest one,
+/// with their deltas summed, so the framework receives one move per device
+/// per frame sampled at the time of the last event.
+class CoalescingPointerDataDispatcher : public DefaultPointerDataDispatcher {
+ public:
+  explicit CoalescingPointerDataDispatcher(Delegate& delegate,
+                                           bool merge_moves = false);
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  virtual ~CoalescingPointerDataDispatcher();
+
+ private:
+  void AddPendingPointerData(const PointerData& data);
+  void DispatchPendingPackets();
+  void ScheduleSecondaryVsyncCallback();
+
+  const bool merge_moves_;
+
+  // The events held back for the next vsync, and the trace flow ids of the
+  // packets they came from.
+  std::vector<PointerData> pending_data_;
+  std::vector<uint64_t> pending_trace_flow_ids_;
+  bool is_pointer_data_in_progress_ = false;
+
+  // WeakPtrFactory must be the last member.
+  fml::WeakPtrFactory<CoalescingPointerDataDispatcher> weak_factory_;
+  FML_DISALLOW_COPY_AND_ASSIGN(CoalescingPointerDataDispatcher);
+};
+
 //--------------------------------------------------------------------------
 /// @brief      Signature for constructing PointerDataDispatcher.
 ///
@@ -0,0 +1,166 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_data_dispatcher.h"
+
+#include <map>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class FakeDispatcherDelegate : public PointerDataDispatcher::Delegate {
+ public:
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    std::vector<PointerData> data;
+    for (size_t i = 0; i < packet->GetLength(); i++) {
+      data.push_back(packet->GetPointerData(i));
+    }
+    dispatched.push_back(std::move(data));
+    dispatched_trace_flow_ids.push_back(trace_flow_id);
+  }
+
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    vsync_callbacks[id] = callback;
+  }
+
+  void Vsync() {
+    auto callbacks = std::move(vsync_callbacks);
+    vsync_callbacks.clear();
+    for (const auto& [id, callback] : callbacks) {
+      callback();
+    }
+  }
+
+  std::vector<std::vector<PointerData>> dispatched;
+  std::vector<uint64_t> dispatched_trace_flow_ids;
+  std::map<uintptr_t, fml::closure> vsync_callbacks;
+};
+
+PointerData CreatePointerData(PointerData::Change change,
+                              int64_t device,
+                              double delta_x) {
+  PointerData data;
+  data.Clear();
+  data.change = change;
+  data.kind = PointerData::DeviceKind::kTouch;
+  data.device = device;
+  data.physical_x = delta_x;
+  data.physical_delta_x = delta_x;
+  return data;
+}
+
+std::unique_ptr<PointerDataPacket> CreatePacket(
+    const std::vector<PointerData>& data) {
+  auto packet = std::make_unique<PointerDataPacket>(data.size());
+  for (size_t i = 0; i < data.size(); i++) {
+    packet->SetPointerData(i, data[i]);
+  }
+  return packet;
+}
+
+std::unique_ptr<PointerDataPacket> CreateMovePacket(int64_t device,
+                                                    double delta_x) {
+  return CreatePacket(
+      {CreatePointerData(PointerData::Change::kMove, device, delta_x)});
+}
+
+}  // namespace
+
+TEST(CoalescingPointerDataDispatcherTest, DispatchesFirstPacketImmediately) {
+  FakeDispatcherDelegate delegate;
+  CoalescingPointerDataDispatcher dispatcher(delegate);
+
+  dispatcher.DispatchPacket(CreateMovePacket(0, 1), 1);
+  ASSERT_EQ(delegate.dispatched.size(), 1u);
+  EXPECT_EQ(delegate.dispatched_trace_flow_ids[0], 1u);
+
+  // After an idle frame, the next packet is not held back either.
+  delegate.Vsync();
+  dispatcher.DispatchPacket(CreateMovePacket(0, 1), 2);
+  EXPECT_EQ(delegate.dispatched.size(), 2u);
+}
+
+TEST(CoalescingPointerDataDispatcherTest, BatchesMovesUntilVsync) {
+  FakeDispatcherDelegate delegate;
+  CoalescingPointerDataDispatcher dispatcher(delegate);
+
+  dispatcher.DispatchPacket(CreateMovePacket(0, 1), 1);
+  dispatcher.DispatchPacket(CreateMovePacket(0, 2), 2);
+  dispatcher.DispatchPacket(CreateMovePacket(0, 3), 3);
+  dispatcher.DispatchPacket(CreateMovePacket(0, 4), 4);
+  ASSERT_EQ(delegate.dispatched.size(), 1u);
+
+  delegate.Vsync();
+  ASSERT_EQ(delegate.dispatched.size(), 2u);
+  ASSERT_EQ(delegate.dispatched[1].size(), 3u);
+  EXPECT_EQ(delegate.dispatched[1][0].physical_delta_x, 2);
+  EXPECT_EQ(delegate.dispatched[1][2].physical_delta_x, 4);
+  EXPECT_EQ(delegate.dispatched_trace_flow_ids[1], 4u);
+
+  delegate.Vsync();
+  EXPECT_EQ(delegate.dispatched.size(), 2u);
+  EXPECT_TRUE(delegate.vsync_callbacks.empty());
+}
+
+TEST(CoalescingPointerDataDispatcherTest, DoesNotHoldBackDiscreteEvents) {
+  FakeDispatcherDelegate delegate;
+  CoalescingPointerDataDispatcher dispatcher(delegate);
+
+  dispatcher.DispatchPacket(CreateMovePacket(0, 1), 1);
+  dispatcher.DispatchPacket(CreateMovePacket(0, 2), 2);
+  dispatcher.DispatchPacket(
+      CreatePacket({CreatePointerData(PointerData::Change::kUp, 0, 0)}), 3);
+
+  ASSERT_EQ(delegate.dispatched.size(), 2u);
+  ASSERT_EQ(delegate.dispatched[1].size(), 2u);
+  EXPECT_EQ(delegate.dispatched[1][0].change, PointerData::Change::kMove);
+  EXPECT_EQ(delegate.dispatched[1][1].change, PointerData::Change::kUp);
+}
+
+TEST(CoalescingPointerDataDispatcherTest, MergesMovesOfTheSamePointer) {
+  FakeDispatcherDelegate delegate;
+  CoalescingPointerDataDispatcher dispatcher(delegate, /*merge_moves=*/true);
+
+  dispatcher.DispatchPacket(CreateMovePacket(0, 1), 1);
+  dispatcher.DispatchPacket(CreateMovePacket(0, 2), 2);
+  dispatcher.DispatchPacket(CreateMovePacket(1, 5), 3);
+  dispatcher.DispatchPacket(CreateMovePacket(0, 3), 4);
+  delegate.Vsync();
+
+  ASSERT_EQ(delegate.dispatched.size(), 2u);
+  const auto& batch = delegate.dispatched[1];
+  ASSERT_EQ(batch.size(), 2u);
+  EXPECT_EQ(batch[0].device, 1);
+  EXPECT_EQ(batch[0].physical_delta_x, 5);
+  EXPECT_EQ(batch[1].device, 0);
+  EXPECT_EQ(batch[1].physical_x, 3);
+  EXPECT_EQ(batch[1].physical_delta_x, 5);
+}
+
+TEST(CoalescingPointerDataDispatcherTest, DoesNotMergeAcrossOtherEvents) {
+  FakeDispatcherDelegate delegate;
+  CoalescingPointerDataDispatcher dispatcher(delegate, /*merge_moves=*/true);
+
+  dispatcher.DispatchPacket(CreateMovePacket(0, 1), 1);
+  dispatcher.DispatchPacket(
+      CreatePacket({CreatePointerData(PointerData::Change::kMove, 0, 1),
+                    CreatePointerData(PointerData::Change::kUp, 0, 0),
+                    CreatePointerData(PointerData::Change::kDown, 0, 0),
+                    CreatePointerData(PointerData::Change::kMove, 0, 1),
+                    CreatePointerData(PointerData::Change::kMove, 0, 1)}),
+      2);
+
+  ASSERT_EQ(delegate.dispatched.size(), 2u);
+  ASSERT_EQ(delegate.dispatched[1].size(), 4u);
+  EXPECT_EQ(delegate.dispatched[1][3].physical_delta_x, 2);
+}
+
+}  // namespace testing
+}  // namespace flutter
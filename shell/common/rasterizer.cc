@@ -11,6 +11,8 @@
 #include "flow/frame_timings.h"
 #include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
 #include "flutter/flow/layers/offscreen_surface.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
@@ -40,6 +42,25 @@ namespace flutter {
 // used within this interval.
 static constexpr std::chrono::milliseconds kSkiaCleanupExpiration(15000);
 
+// While the application is idle, the rasterizer purges GPU resources that have
+// not been used within this shorter interval.
+static constexpr std::chrono::milliseconds kIdleSkiaCleanupExpiration(1000);
+
+// GPU resources are purged at most this often while idle, so that frames that
+// only briefly stop animating do not have to reallocate them.
+static constexpr fml::TimeDelta kIdlePurgeInterval =
+    fml::TimeDelta::FromSeconds(1);
+
+// The raster cache images are allocated from the resource cache budget, but
+// can not be purged by Skia. Limit them to half of the budget so that they can
+// not starve the other GPU resources.
+static constexpr size_t kRasterCacheBudgetDivisor = 2;
+
+// External view embedders that report frame damage composite their layers
+// themselves. A few rects cover unrelated changes in different parts of the
+// frame far more tightly than a single bounding rect.
+static constexpr size_t kMaxEmbedderFrameDamageRectCount = 4;
+
 Rasterizer::Rasterizer(Delegate& delegate,
                        MakeGpuImageBehavior gpu_image_behavior)
     : delegate_(delegate),
@@ -49,6 +70,9 @@ Rasterizer::Rasterizer(Delegate& delegate,
           SnapshotController::Make(*this, delegate.GetSettings())),
       weak_factory_(this) {
   FML_DCHECK(compositor_context_);
+  idle_work_.Add("PurgeGpuResources", IdleWorkScheduler::Priority::kHigh,
+                 fml::TimeDelta::FromMilliseconds(1), kIdlePurgeInterval,
+                 [this]() { PurgeUnusedGpuResources(); });
 }
 
 Rasterizer::~Rasterizer() = default;
@@ -65,6 +89,20 @@ fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> Rasterizer::GetSnapshotDelegate()
 void Rasterizer::SetImpellerContext(
     std::weak_ptr<impeller::Context> impeller_context) {
   impeller_context_ = std::move(impeller_context);
+  if (auto context = impeller_context_.lock()) {
+    // The GPU tracers of the backends measure frames on their own threads.
+    context->SetGPUFrameTimeCallback(
+        [raster_task_runner = delegate_.GetTaskRunners().GetRasterTaskRunner(),
+         weak_this = weak_factory_.GetWeakPtr()](fml::TimePoint frame_start,
+                                                 fml::TimeDelta gpu_time) {
+          raster_task_runner->PostTask([weak_this, frame_start, gpu_time]() {
+            if (weak_this) {
+              weak_this->delegate_.OnFrameGpuTimeMeasured(frame_start,
+                                                          gpu_time);
+            }
+          });
+        });
+  }
 }
 
 void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
@@ -171,6 +209,7 @@ void Rasterizer::NotifyLowMemoryWarning() const {
   if (!context_switch->GetResult()) {
     return;
   }
+  compositor_context_->raster_cache().NotifyLowMemory();
   context->performDeferredCleanup(std::chrono::milliseconds(0));
 }
 
@@ -186,6 +225,50 @@ GrDirectContext* Rasterizer::GetGrContext() {
   return surface_ ? surface_->GetContext() : nullptr;
 }
 
+static size_t EstimateDisplayListBytes(const Layer* layer) {
+  if (layer == nullptr) {
+    return 0u;
+  }
+  if (const auto* display_list_layer = layer->as_display_list_layer()) {
+    return display_list_layer->display_list()->bytes(true);
+  }
+  size_t bytes = 0u;
+  if (const auto* container = layer->as_container_layer()) {
+    for (const auto& child : container->layers()) {
+      bytes += EstimateDisplayListBytes(child.get());
+    }
+  }
+  return bytes;
+}
+
+Rasterizer::MemoryUsage Rasterizer::GetMemoryUsage() {
+  FML_DCHECK(delegate_.GetTaskRunners()
+                 .GetRasterTaskRunner()
+                 ->RunsTasksOnCurrentThread());
+  MemoryUsage usage;
+  for (const auto& [view_id, view_record] : view_records_) {
+    const auto& task = view_record.last_successful_task;
+    if (task && task->layer_tree) {
+      usage.display_list_bytes +=
+          EstimateDisplayListBytes(task->layer_tree->root_layer());
+    }
+  }
+  if (auto* gr_context = GetGrContext()) {
+    int resource_count = 0;
+    gr_context->getResourceCacheUsage(&resource_count,
+                                      &usage.skia_resource_cache_bytes);
+  }
+#if IMPELLER_SUPPORTS_RENDERING
+  if (auto context = impeller_context_.lock()) {
+    if (auto allocator = context->GetResourceAllocator()) {
+      usage.impeller_buffer_bytes = allocator->GetAllocatedBufferBytes();
+      usage.impeller_texture_bytes = allocator->GetAllocatedTextureBytes();
+    }
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  return usage;
+}
+
 flutter::LayerTree* Rasterizer::GetLastLayerTree(int64_t view_id) {
   auto found = view_records_.find(view_id);
   if (found == view_records_.end()) {
@@ -225,6 +308,40 @@ void Rasterizer::DrawLastLayerTrees(
   }
 }
 
+bool Rasterizer::UpdateRetainedLayer(uint64_t layer_id,
+                                     const RetainedLayerUpdate& update) {
+  bool updated = false;
+  for (auto& [view_id, view_record] : view_records_) {
+    auto& last_task = view_record.last_successful_task;
+    if (last_task && last_task->layer_tree &&
+        last_task->layer_tree->ApplyRetainedUpdate(layer_id, update)) {
+      updated = true;
+    }
+  }
+  if (!updated || retained_layer_draw_pending_) {
+    return updated;
+  }
+
+  retained_layer_draw_pending_ = true;
+  delegate_.GetTaskRunners().GetRasterTaskRunner()->PostTask(
+      [weak_this = weak_factory_.GetWeakPtr()]() {
+        if (!weak_this) {
+          return;
+        }
+        weak_this->retained_layer_draw_pending_ = false;
+        TRACE_EVENT0("flutter", "Rasterizer::DrawRetainedLayerUpdates");
+        // No frame is built for the update, but the recorder insists on the
+        // build having ended before the raster times are set.
+        auto frame_timings_recorder = std::make_unique<FrameTimingsRecorder>();
+        const auto now = fml::TimePoint::Now();
+        frame_timings_recorder->RecordVsync(now, now);
+        frame_timings_recorder->RecordBuildStart(now);
+        frame_timings_recorder->RecordBuildEnd(now);
+        weak_this->DrawLastLayerTrees(std::move(frame_timings_recorder));
+      });
+  return true;
+}
+
 DrawStatus Rasterizer::Draw(const std::shared_ptr<FramePipeline>& pipeline) {
   TRACE_EVENT0("flutter", "GPURasterizer::Draw");
   if (raster_thread_merger_ &&
@@ -236,6 +353,15 @@ DrawStatus Rasterizer::Draw(const std::shared_ptr<FramePipeline>& pipeline) {
                  .GetRasterTaskRunner()
                  ->RunsTasksOnCurrentThread());
 
+  if (overload_controller_ && overload_controller_->IsOverloaded()) {
+    // The older frames would only be drawn late, so only the most recent one
+    // is worth the GPU time.
+    const size_t discarded = pipeline->DiscardStale();
+    if (discarded > 0) {
+      TRACE_EVENT_INSTANT0("flutter", "Rasterizer::DiscardStaleFrames");
+    }
+  }
+
   DoDrawResult draw_result;
   FramePipeline::Consumer consumer = [&draw_result,
                                       this](std::unique_ptr<FrameItem> item) {
@@ -414,6 +540,12 @@ sk_sp<DlImage> Rasterizer::MakeRasterSnapshot(sk_sp<DisplayList> display_list,
   return snapshot_controller_->MakeRasterSnapshot(display_list, picture_size);
 }
 
+std::vector<sk_sp<DlImage>> Rasterizer::MakeRasterSnapshots(
+    const std::vector<RasterSnapshotJob>& jobs) {
+  TRACE_EVENT0("flutter", "Rasterizer::MakeRasterSnapshots");
+  return snapshot_controller_->MakeRasterSnapshots(jobs);
+}
+
 sk_sp<SkImage> Rasterizer::ConvertToRasterImage(sk_sp<SkImage> image) {
   TRACE_EVENT0("flutter", __FUNCTION__);
   return snapshot_controller_->ConvertToRasterImage(image);
@@ -423,6 +555,31 @@ fml::Milliseconds Rasterizer::GetFrameBudget() const {
   return delegate_.GetFrameBudget();
 };
 
+void Rasterizer::NotifyIdle(fml::TimePoint deadline) {
+  if (!surface_ || is_torn_down_) {
+    return;
+  }
+  delegate_.GetIsGpuDisabledSyncSwitch()->Execute(
+      fml::SyncSwitch::Handlers().SetIfFalse(
+          [&] { idle_work_.RunUntil(deadline); }));
+}
+
+void Rasterizer::PurgeUnusedGpuResources() {
+  if (auto* context = surface_->GetContext()) {
+    auto context_switch = surface_->MakeRenderContextCurrent();
+    if (context_switch->GetResult()) {
+      context->performDeferredCleanup(kIdleSkiaCleanupExpiration);
+    }
+  }
+#if IMPELLER_SUPPORTS_RENDERING
+  if (auto aiks_context = surface_->GetAiksContext()) {
+    aiks_context->GetContentContext()
+        .GetRenderTargetCache()
+        ->DisposeUnused();
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
 Rasterizer::DoDrawResult Rasterizer::DoDraw(
     std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder,
     std::vector<std::unique_ptr<LayerTreeTask>> tasks) {
@@ -464,6 +621,13 @@ Rasterizer::DoDrawResult Rasterizer::DoDraw(
   // for Fuchsia to capture SceneUpdateContext::ExecutePaintTasks.
   delegate_.OnFrameRasterized(frame_timings_recorder->GetRecordedTime());
 
+  if (overload_controller_) {
+    overload_controller_->OnFrameRasterized(
+        frame_timings_recorder->GetRasterEndTime() -
+            frame_timings_recorder->GetRasterStartTime(),
+        fml::TimeDelta::FromMillisecondsF(delegate_.GetFrameBudget().count()));
+  }
+
 // SceneDisplayLag events are disabled on Fuchsia.
 // see: https://github.com/flutter/flutter/issues/56598
 #if !defined(OS_FUCHSIA)
@@ -603,6 +767,12 @@ std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
 
   frame_timings_recorder.RecordRasterStart(fml::TimePoint::Now());
 
+  // The raster cache frame spans all views, so that entries are aged and
+  // evicted once per frame and not once per view.
+  RasterCache& raster_cache = compositor_context_->raster_cache();
+  raster_cache.BeginFrame(tasks.size());
+  bool painted = false;
+
   // Second traverse: draw all layer trees.
   std::vector<std::unique_ptr<LayerTreeTask>> resubmitted_tasks;
   for (std::unique_ptr<LayerTreeTask>& task : tasks) {
@@ -617,6 +787,8 @@ std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
     auto& view_record = EnsureViewRecord(task->view_id);
     view_record.last_draw_status = status;
     if (status == DrawSurfaceStatus::kSuccess) {
+      painted = true;
+      CaptureFrameIfNeeded(view_id, *layer_tree);
       view_record.last_successful_task = std::make_unique<LayerTreeTask>(
           view_id, std::move(layer_tree), device_pixel_ratio);
     } else if (status == DrawSurfaceStatus::kRetry) {
@@ -624,9 +796,17 @@ std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
           view_id, std::move(layer_tree), device_pixel_ratio));
     }
   }
-  // TODO(dkwingsmt): Pass in raster cache(s) for all views.
-  // See https://github.com/flutter/flutter/issues/135530, item 4.
-  frame_timings_recorder.RecordRasterEnd(&compositor_context_->raster_cache());
+  // Do not update raster cache metrics if no view was actually painted.
+  if (painted) {
+    raster_cache.EndFrame();
+#if IMPELLER_SUPPORTS_RENDERING
+    // Traces the driver objects the Impeller backend created for the frame.
+    if (auto context = impeller_context_.lock()) {
+      context->GetBackendStats()->EndFrame();
+    }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  }
+  frame_timings_recorder.RecordRasterEnd(&raster_cache);
   FireNextFrameCallbackIfPresent();
 
   if (surface_->GetContext()) {
@@ -651,6 +831,16 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
     std::optional<fml::TimePoint> presentation_time) {
   FML_DCHECK(surface_);
 
+  // Skip acquiring and presenting a frame if nothing changed. This happens
+  // before the external view embedder is involved, so that it still has the
+  // views of the last frame.
+  if (surface_->AllowsSkippingUnchangedFrames() &&
+      !layer_tree.is_leaf_layer_tracing_enabled() &&
+      IsUnchangedSinceLastFrame(view_id, layer_tree)) {
+    TRACE_EVENT0("flutter", "Rasterizer::SkipUnchangedFrame");
+    return DrawSurfaceStatus::kSuccess;
+  }
+
   DlCanvas* embedder_root_canvas = nullptr;
   if (external_view_embedder_) {
     external_view_embedder_->PrepareFlutterView(
@@ -688,13 +878,21 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
       surface_->GetAiksContext().get()  // aiks context
   );
   if (compositor_frame) {
-    compositor_context_->raster_cache().BeginFrame();
-
     std::unique_ptr<FrameDamage> damage;
     // when leaf layer tracing is enabled we wish to repaint the whole frame
     // for accurate performance metrics.
-    if (frame->framebuffer_info().supports_partial_repaint &&
+    if (external_view_embedder_ &&
+        external_view_embedder_->SupportsFrameDamage() &&
         !layer_tree.is_leaf_layer_tracing_enabled()) {
+      // The external view embedder repaints the entire frame, but reports
+      // what changed since the previous frame. The additional damage covering
+      // the frame keeps the rendering from being clipped to the changes.
+      damage = std::make_unique<FrameDamage>();
+      damage->SetPreviousLayerTree(GetLastLayerTree(view_id));
+      damage->AddAdditionalDamage(SkIRect::MakeSize(layer_tree.frame_size()));
+      damage->SetMaxDamageRectCount(kMaxEmbedderFrameDamageRectCount);
+    } else if (frame->framebuffer_info().supports_partial_repaint &&
+               !layer_tree.is_leaf_layer_tracing_enabled()) {
       // Disable partial repaint if external_view_embedder_ SubmitFlutterView is
       // involved - ExternalViewEmbedder unconditionally clears the entire
       // surface and also partial repaint with platform view present is
@@ -711,6 +909,8 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
         damage->SetClipAlignment(
             frame->framebuffer_info().horizontal_clip_alignment,
             frame->framebuffer_info().vertical_clip_alignment);
+        damage->SetMaxDamageRectCount(
+            frame->framebuffer_info().max_damage_rect_count);
       }
     }
 
@@ -734,6 +934,8 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
     if (damage) {
       submit_info.frame_damage = damage->GetFrameDamage();
       submit_info.buffer_damage = damage->GetBufferDamage();
+      submit_info.frame_damage_region = damage->GetFrameDamageRegion();
+      submit_info.buffer_damage_region = damage->GetBufferDamageRegion();
     }
 
     frame->set_submit_info(submit_info);
@@ -747,12 +949,6 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
       frame->Submit();
     }
 
-    // Do not update raster cache metrics for kResubmit because that status
-    // indicates that the frame was not actually painted.
-    if (frame_status != RasterStatus::kResubmit) {
-      compositor_context_->raster_cache().EndFrame();
-    }
-
     if (frame_status == RasterStatus::kResubmit) {
       return DrawSurfaceStatus::kRetry;
     } else {
@@ -764,6 +960,24 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
   return DrawSurfaceStatus::kFailed;
 }
 
+bool Rasterizer::IsUnchangedSinceLastFrame(int64_t view_id,
+                                           flutter::LayerTree& layer_tree) {
+  if (layer_tree.root_layer() == nullptr) {
+    return false;
+  }
+
+  // This also records the paint regions of |layer_tree|, which the next frame
+  // is diffed against, so it must run even if there is no last layer tree.
+  // The rendering doesn't necessarily compute frame damage itself.
+  FrameDamage damage;
+  damage.SetPreviousLayerTree(GetLastLayerTree(view_id));
+  damage.SetTextureRegistry(compositor_context_->texture_registry().get());
+  damage.ComputeClipRect(layer_tree, surface_->EnableRasterCache(),
+                         surface_->GetContext() == nullptr);
+  std::optional<SkIRect> frame_damage = damage.GetFrameDamage();
+  return frame_damage.has_value() && frame_damage->isEmpty();
+}
+
 Rasterizer::ViewRecord& Rasterizer::EnsureViewRecord(int64_t view_id) {
   return view_records_[view_id];
 }
@@ -923,10 +1137,37 @@ void Rasterizer::SetSnapshotSurfaceProducer(
   snapshot_surface_producer_ = std::move(producer);
 }
 
+void Rasterizer::SetOverloadController(
+    std::shared_ptr<FrameOverloadController> controller) {
+  overload_controller_ = std::move(controller);
+}
+
 fml::RefPtr<fml::RasterThreadMerger> Rasterizer::GetRasterThreadMerger() {
   return raster_thread_merger_;
 }
 
+void Rasterizer::SetFrameCapturer(std::unique_ptr<FrameCapturer> capturer) {
+  frame_capturer_ = std::move(capturer);
+}
+
+void Rasterizer::CaptureFrameIfNeeded(int64_t view_id, LayerTree& layer_tree) {
+  if (!frame_capturer_) {
+    return;
+  }
+  const fml::TimePoint now = fml::TimePoint::Now();
+  if (!frame_capturer_->ShouldCapture(now)) {
+    return;
+  }
+  const SkISize frame_size = layer_tree.frame_size();
+  sk_sp<DisplayList> display_list =
+      layer_tree.Flatten(SkRect::Make(frame_size),
+                         compositor_context_->texture_registry(),
+                         surface_->GetContext());
+  frame_capturer_->Capture(view_id, now, display_list, frame_size,
+                           surface_->GetContext(), *this,
+                           impeller_context_.lock());
+}
+
 void Rasterizer::FireNextFrameCallbackIfPresent() {
   if (!next_frame_callback_) {
     return;
@@ -947,6 +1188,8 @@ void Rasterizer::SetResourceCacheMaxBytes(size_t max_bytes, bool from_user) {
   }
 
   max_cache_bytes_ = max_bytes;
+  compositor_context_->raster_cache().SetMaxBytes(
+      max_bytes / kRasterCacheBudgetDivisor);
   if (!surface_) {
     return;
   }
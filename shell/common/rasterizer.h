@@ -8,6 +8,7 @@
 #include <memory>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
@@ -31,6 +32,9 @@
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"  // nogncheck
 #endif  // IMPELLER_SUPPORTS_RENDERING
 #include "flutter/lib/ui/snapshot_delegate.h"
+#include "flutter/shell/common/frame_capturer.h"
+#include "flutter/shell/common/frame_overload_controller.h"
+#include "flutter/shell/common/idle_work_scheduler.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/snapshot_controller.h"
 #include "flutter/shell/common/snapshot_surface_producer.h"
@@ -143,6 +147,18 @@ class Rasterizer final : public SnapshotDelegate,
     ///
     virtual void OnFrameRasterized(const FrameTiming& frame_timing) = 0;
 
+    //--------------------------------------------------------------------------
+    /// @brief      Notifies the delegate of the GPU time of a frame, once the
+    ///             GPU has finished it. This is usually after the frame was
+    ///             delivered to `OnFrameRasterized`.
+    ///
+    /// @param[in]  frame_start  When the first GPU work of the frame was
+    ///                          recorded, during its raster phase.
+    /// @param[in]  gpu_time     How long the GPU spent on the frame.
+    ///
+    virtual void OnFrameGpuTimeMeasured(fml::TimePoint frame_start,
+                                        fml::TimeDelta gpu_time) {}
+
     /// Time limit for a smooth frame.
     ///
     /// See: `DisplayManager::GetMainDisplayRefreshRate`.
@@ -244,7 +260,8 @@ class Rasterizer final : public SnapshotDelegate,
   /// @brief      Notifies the rasterizer that there is a low memory situation
   ///             and it must purge as many unnecessary resources as possible.
   ///             Currently, the Skia context associated with onscreen rendering
-  ///             is told to free GPU resources.
+  ///             is told to free GPU resources and the byte budget of the
+  ///             raster cache is reduced.
   ///
   void NotifyLowMemoryWarning() const;
 
@@ -303,11 +320,69 @@ class Rasterizer final : public SnapshotDelegate,
   void DrawLastLayerTrees(
       std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Applies new values of the opacity or transform of a retained
+  ///             layer to the last layer trees and schedules a frame that
+  ///             draws them again. This lets such a property be animated
+  ///             without the UI thread building a new layer tree per frame,
+  ///             while the subtree below the layer is drawn from the raster
+  ///             cache.
+  ///
+  ///             The updates applied before the scheduled frame is drawn are
+  ///             all drawn by that frame. A new layer tree from the UI thread
+  ///             replaces the updated values with its own.
+  ///
+  /// @param[in]  layer_id  The original layer id of the layer, which stays
+  ///                       the same across the layers that retain it.
+  /// @param[in]  update    The new values of the properties.
+  ///
+  /// @return     Whether a last layer tree had the layer and the layer had
+  ///             the properties of the update.
+  ///
+  bool UpdateRetainedLayer(uint64_t layer_id,
+                           const RetainedLayerUpdate& update);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Rasterizes the display lists of a batch of jobs into
+  ///             images. Like `MakeRasterSnapshot`, this does not need an
+  ///             onscreen surface, and the Skia backend reuses the render
+  ///             target of a job for the later jobs of the same size.
+  ///
+  /// @param[in]  jobs  The display lists and the sizes of their images.
+  ///
+  /// @return     An image per job, in the order of the jobs. The image of a
+  ///             job that could not be rasterized is null.
+  ///
+  std::vector<sk_sp<DlImage>> MakeRasterSnapshots(
+      const std::vector<RasterSnapshotJob>& jobs);
+
   // |SnapshotDelegate|
   GrDirectContext* GetGrContext() override;
 
   std::shared_ptr<flutter::TextureRegistry> GetTextureRegistry() override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The native memory held by the rasterizer besides its raster
+  ///             cache, in bytes.
+  ///
+  struct MemoryUsage {
+    /// The display lists of the last layer tree of every view. They are
+    /// retained so that the views can be redrawn without a new frame.
+    size_t display_list_bytes = 0u;
+    /// The resource cache of the Skia GPU context.
+    size_t skia_resource_cache_bytes = 0u;
+    /// The live buffers and textures of the Impeller resource allocator.
+    /// This includes the glyph atlases and the host buffers.
+    size_t impeller_buffer_bytes = 0u;
+    size_t impeller_texture_bytes = 0u;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Collects the native memory usage of the rasterizer. This must
+  ///             be called on the raster task runner.
+  ///
+  MemoryUsage GetMemoryUsage();
+
   //----------------------------------------------------------------------------
   /// @brief      Takes the next item from the layer tree pipeline and executes
   ///             the raster thread frame workload for that pipeline item to
@@ -462,6 +537,17 @@ class Rasterizer final : public SnapshotDelegate,
   ///
   void SetNextFrameCallback(const fml::closure& callback);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the capturer that frames drawn on-screen are captured
+  ///             with for streaming, or stops capturing frames if
+  ///             `capturer` is null.
+  ///
+  /// @see        `FrameCapturer`
+  ///
+  /// @param[in]  capturer  The frame capturer.
+  ///
+  void SetFrameCapturer(std::unique_ptr<FrameCapturer> capturer);
+
   //----------------------------------------------------------------------------
   /// @brief Set the External View Embedder. This is done on shell
   ///        initialization. This is non-null on platforms that support
@@ -483,6 +569,18 @@ class Rasterizer final : public SnapshotDelegate,
   void SetSnapshotSurfaceProducer(
       std::unique_ptr<SnapshotSurfaceProducer> producer);
 
+  //----------------------------------------------------------------------------
+  /// @brief Set the overload controller that the rasterizer reports the raster
+  ///        duration of each frame to. While it reports an overload, only the
+  ///        most recent frame of the pipeline is drawn. This is done on shell
+  ///        initialization and may be `nullptr`.
+  ///
+  /// @param[in]  controller  The overload controller shared with the
+  ///                         animator.
+  ///
+  void SetOverloadController(
+      std::shared_ptr<FrameOverloadController> controller);
+
   //----------------------------------------------------------------------------
   /// @brief      Returns a pointer to the compositor context used by this
   ///             rasterizer. This pointer will never be `nullptr`.
@@ -514,7 +612,8 @@ class Rasterizer final : public SnapshotDelegate,
   ///
   /// @attention  This cache does not describe the entirety of GPU resources
   ///             that may be cached. The `RasterCache` also holds very large
-  ///             GPU resources.
+  ///             GPU resources, its images are limited to half of
+  ///             `max_bytes`.
   ///
   /// @see        `RasterCache`
   ///
@@ -540,6 +639,17 @@ class Rasterizer final : public SnapshotDelegate,
   ///
   std::optional<size_t> GetResourceCacheMaxBytes() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Spends the time until `deadline`, when the next frame is
+  ///             expected to be rasterized, on deferrable work such as
+  ///             purging GPU resources that are no longer in use.
+  ///
+  /// @see        `IdleWorkScheduler`
+  ///
+  /// @param[in]  deadline  The time that the idle work must be done by.
+  ///
+  void NotifyIdle(fml::TimePoint deadline);
+
   //----------------------------------------------------------------------------
   /// @brief      Enables the thread merger if the external view embedder
   ///             supports dynamic thread merging.
@@ -706,10 +816,19 @@ class Rasterizer final : public SnapshotDelegate,
       float device_pixel_ratio,
       std::optional<fml::TimePoint> presentation_time);
 
+  // Whether |layer_tree| renders the same as the last layer tree drawn to the
+  // view, so that the surface can keep showing the last frame.
+  bool IsUnchangedSinceLastFrame(int64_t view_id,
+                                 flutter::LayerTree& layer_tree);
+
   ViewRecord& EnsureViewRecord(int64_t view_id);
 
   void FireNextFrameCallbackIfPresent();
 
+  void CaptureFrameIfNeeded(int64_t view_id, LayerTree& layer_tree);
+
+  void PurgeUnusedGpuResources();
+
   static bool ShouldResubmitFrame(const DoDrawResult& result);
   static DrawStatus ToDrawStatus(DoDrawStatus status);
 
@@ -722,11 +841,15 @@ class Rasterizer final : public SnapshotDelegate,
   std::unique_ptr<flutter::CompositorContext> compositor_context_;
   std::unordered_map<int64_t, ViewRecord> view_records_;
   fml::closure next_frame_callback_;
+  bool retained_layer_draw_pending_ = false;
   bool user_override_resource_cache_bytes_ = false;
   std::optional<size_t> max_cache_bytes_;
   fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
   std::shared_ptr<ExternalViewEmbedder> external_view_embedder_;
   std::unique_ptr<SnapshotController> snapshot_controller_;
+  std::shared_ptr<FrameOverloadController> overload_controller_;
+  std::unique_ptr<FrameCapturer> frame_capturer_;
+  IdleWorkScheduler idle_work_;
 
   // WeakPtrFactory must be the last member.
   fml::TaskRunnerAffineWeakPtrFactory<Rasterizer> weak_factory_;
@@ -10,6 +10,7 @@
 #include <optional>
 
 #include "flutter/flow/frame_timings.h"
+#include "flutter/flow/layers/container_layer.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/thread_host.h"
@@ -83,6 +84,7 @@ class MockSurface : public Surface {
               (override));
   MOCK_METHOD(bool, ClearRenderContext, (), (override));
   MOCK_METHOD(bool, AllowsDrawingWhenGpuDisabled, (), (const, override));
+  MOCK_METHOD(bool, AllowsSkippingUnchangedFrames, (), (const, override));
 };
 
 class MockExternalViewEmbedder : public ExternalViewEmbedder {
@@ -792,6 +794,71 @@ TEST(RasterizerTest,
   latch.Wait();
 }
 
+TEST(RasterizerTest, drawingAnUnchangedLayerTreeDoesNotAcquireFrame) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::kPlatform |
+                             ThreadHost::Type::kRaster | ThreadHost::Type::kIo |
+                             ThreadHost::Type::kUi);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  EXPECT_CALL(delegate, OnFrameRasterized(_)).Times(2);
+
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto surface = std::make_unique<NiceMock<MockSurface>>();
+
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  framebuffer_info.supports_readback = true;
+  auto surface_frame = std::make_unique<SurfaceFrame>(
+      /*surface=*/
+      nullptr, /*framebuffer_info=*/framebuffer_info,
+      /*submit_callback=*/[](const SurfaceFrame&, DlCanvas*) { return true; },
+      /*frame_size=*/SkISize::Make(800, 600));
+  ON_CALL(*surface, AllowsDrawingWhenGpuDisabled())
+      .WillByDefault(Return(true));
+  ON_CALL(*surface, AllowsSkippingUnchangedFrames())
+      .WillByDefault(Return(true));
+  EXPECT_CALL(*surface, AcquireFrame(SkISize::Make(800, 600)))
+      .WillOnce(Return(ByMove(std::move(surface_frame))));
+  EXPECT_CALL(*surface, MakeRenderContextCurrent())
+      .WillOnce(Return(ByMove(std::make_unique<GLContextDefaultResult>(true))));
+
+  rasterizer->Setup(std::move(surface));
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    ON_CALL(delegate, ShouldDiscardLayerTree).WillByDefault(Return(false));
+    // Both layer trees have an empty root layer, so the second one has no
+    // damage.
+    for (int i = 0; i < 2; i++) {
+      auto pipeline = std::make_shared<FramePipeline>(/*depth=*/10);
+      LayerTree::Config config;
+      config.root_layer = std::make_shared<ContainerLayer>();
+      auto layer_tree = std::make_unique<LayerTree>(
+          config, /*frame_size=*/SkISize::Make(800, 600));
+      auto layer_tree_item = std::make_unique<FrameItem>(
+          SingleLayerTreeList(kImplicitViewId, std::move(layer_tree),
+                              kDevicePixelRatio),
+          CreateFinishedBuildRecorder());
+      PipelineProduceResult result =
+          pipeline->Produce().Complete(std::move(layer_tree_item));
+      EXPECT_TRUE(result.success);
+      EXPECT_EQ(rasterizer->Draw(pipeline), DrawStatus::kDone);
+      EXPECT_EQ(rasterizer->GetLastDrawStatus(kImplicitViewId),
+                DrawSurfaceStatus::kSuccess);
+    }
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
 TEST(
     RasterizerTest,
     drawWithGpuDisabledAndSurfaceAllowsDrawingWhenGpuDisabledDoesAcquireFrame) {
@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/assets/packed_asset_bundle.h"
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/unique_fd.h"
@@ -25,10 +26,19 @@ RunConfiguration RunConfiguration::InferFromSettings(
         fml::Duplicate(settings.assets_dir), true));
   }
 
+  fml::UniqueFD assets_directory = fml::OpenDirectory(
+      settings.assets_path.c_str(), false, fml::FilePermission::kRead);
+
+  // A packed bundle answers lookups from its index, with a single mapping for
+  // all assets, so it is consulted before the files of the directory.
+  if (fml::FileExists(assets_directory, PackedAssetBundle::kFileName)) {
+    asset_manager->PushBack(std::make_unique<PackedAssetBundle>(
+        fml::OpenFileReadOnly(assets_directory, PackedAssetBundle::kFileName),
+        true));
+  }
+
   asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
-      fml::OpenDirectory(settings.assets_path.c_str(), false,
-                         fml::FilePermission::kRead),
-      true));
+      std::move(assets_directory), true));
 
   return {IsolateConfiguration::InferFromSettings(settings, asset_manager,
                                                   io_worker),
@@ -6,28 +6,36 @@
 #include "flutter/shell/common/shell.h"
 
 #include <memory>
+#include <mutex>
 #include <sstream>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/display_list/benchmarking/dl_complexity_table.h"
 #include "flutter/fml/base32.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/icu_util.h"
 #include "flutter/fml/log_settings.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/memory/allocation_counter.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
+#include "flutter/fml/thread_scheduling.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/painting/display_list_image_gpu.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/base64.h"
 #include "flutter/shell/common/engine.h"
 #include "flutter/shell/common/skia_event_tracer_impl.h"
+#include "flutter/shell/common/startup_report.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/common/vsync_waiter.h"
+#include "flutter/third_party/txt/src/txt/fallback_font_cache.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
@@ -40,6 +48,7 @@
 #include "third_party/skia/include/codec/SkWbmpDecoder.h"
 #include "third_party/skia/include/codec/SkWebpDecoder.h"
 #include "third_party/skia/include/core/SkGraphics.h"
+#include "third_party/skia/include/gpu/ganesh/SkImageGanesh.h"
 #include "third_party/tonic/common/log.h"
 
 namespace flutter {
@@ -48,6 +57,8 @@ constexpr char kSkiaChannel[] = "flutter/skia";
 constexpr char kSystemChannel[] = "flutter/system";
 constexpr char kTypeKey[] = "type";
 constexpr char kFontChange[] = "fontsChange";
+// The largest "frameCount" accepted by the layer costs service extension.
+constexpr size_t kMaxSampledLayerCostFrames = 1000;
 
 namespace {
 
@@ -94,6 +105,95 @@ void RegisterCodecsWithSkia() {
   SkCodecs::Register(SkIcoDecoder::Decoder());
 }
 
+// Uploads the pixels of asynchronous raster cache fills on the IO thread, in
+// the same way as |ImageDecoderSkia| uploads decoded images.
+RasterCache::AsyncUploadFunction MakeRasterCacheUploadFunction(
+    fml::WeakPtr<IOManager> io_manager) {
+  return [io_manager](const SkPixmap& pixmap) -> sk_sp<DlImage> {
+    if (!io_manager) {
+      return nullptr;
+    }
+    sk_sp<DlImage> result;
+    io_manager->GetIsGpuDisabledSyncSwitch()->Execute(
+        fml::SyncSwitch::Handlers()
+            .SetIfTrue([&result, &pixmap] {
+              result = DlImage::Make(SkImages::RasterFromPixmapCopy(pixmap));
+            })
+            .SetIfFalse([&result, &pixmap, &io_manager] {
+              auto context = io_manager->GetResourceContext();
+              if (!context) {
+                result = DlImage::Make(SkImages::RasterFromPixmapCopy(pixmap));
+                return;
+              }
+              sk_sp<SkImage> texture_image =
+                  SkImages::CrossContextTextureFromPixmap(
+                      context.get(),  // context
+                      pixmap,         // pixmap
+                      false,          // buildMips,
+                      true            // limitToMaxTextureSize
+                  );
+              if (texture_image) {
+                result = DlImageGPU::Make({std::move(texture_image),
+                                           io_manager->GetSkiaUnrefQueue()});
+              }
+            }));
+    return result;
+  };
+}
+
+// Signaled once the initialization tasks that run concurrently with the
+// creation of the Dart VM are done.
+fml::ManualResetWaitableEvent& ConcurrentInitializationTasksDone() {
+  static fml::ManualResetWaitableEvent* done =
+      new fml::ManualResetWaitableEvent();
+  return *done;
+}
+
+// Loads the ICU data, the display list complexity table and the persistent
+// cache directories on a background thread. None of them are needed before
+// the engine is created, so they overlap with the creation of the Dart VM,
+// which dominates the time spent in |Shell::Create|.
+void StartConcurrentInitializationTasks(const Settings& settings) {
+  std::thread([icu_initialization_required =
+                   settings.icu_initialization_required,
+               icu_data_path = settings.icu_data_path,
+               icu_mapper = settings.icu_mapper,
+               complexity_table_path = settings.complexity_table_path]() {
+    fml::Thread::SetCurrentThreadName(
+        fml::Thread::ThreadConfig("io.flutter.startup"));
+
+    if (icu_initialization_required) {
+      StartupReport::ScopedStage stage("ICUInitialization");
+      if (!icu_data_path.empty()) {
+        fml::icu::InitializeICU(icu_data_path);
+      } else if (icu_mapper) {
+        fml::icu::InitializeICUFromMapping(icu_mapper());
+      } else {
+        FML_DLOG(WARNING) << "Skipping ICU initialization in the shell.";
+      }
+    }
+
+    if (!complexity_table_path.empty()) {
+      StartupReport::ScopedStage stage("ComplexityTableLoading");
+      DisplayListTableComplexityCalculator::InstallForGpuBackends(
+          DisplayListComplexityTable::LoadFromFile(complexity_table_path));
+    }
+
+    {
+      StartupReport::ScopedStage stage("PersistentCacheLoading");
+      PersistentCache::GetCacheForProcess();
+    }
+
+    ConcurrentInitializationTasksDone().Signal();
+  }).detach();
+}
+
+void WaitForConcurrentInitializationTasks() {
+  StartupReport::ScopedStage stage("ConcurrentInitializationWait");
+  TRACE_EVENT0("flutter", "WaitForConcurrentInitializationTasks");
+  ConcurrentInitializationTasksDone().Wait();
+}
+
 // Though there can be multiple shells, some settings apply to all components in
 // the process. These have to be set up before the shell or any of its
 // sub-components can be initialized. In a perfect world, this would be empty.
@@ -110,6 +210,10 @@ void PerformInitializationTasks(Settings& settings) {
 
   static std::once_flag gShellSettingsInitialization = {};
   std::call_once(gShellSettingsInitialization, [&settings] {
+    if (!settings.startup_report_directory.empty()) {
+      StartupReport::GetForProcess().Enable();
+    }
+
     tonic::SetLogHandler(
         [](const char* message) { FML_LOG(ERROR) << message; });
 
@@ -121,27 +225,44 @@ void PerformInitializationTasks(Settings& settings) {
       fml::tracing::TraceSetAllowlist(settings.trace_allowlist);
     }
 
-    if (!settings.skia_deterministic_rendering_on_cpu) {
-      SkGraphics::Init();
-    } else {
-      FML_DLOG(INFO) << "Skia deterministic rendering is enabled.";
+    if (settings.trace_ring_buffer_size > 0) {
+      fml::tracing::TraceRingBufferEnable(settings.trace_ring_buffer_size);
     }
-    RegisterCodecsWithSkia();
 
-    if (settings.icu_initialization_required) {
-      if (!settings.icu_data_path.empty()) {
-        fml::icu::InitializeICU(settings.icu_data_path);
-      } else if (settings.icu_mapper) {
-        fml::icu::InitializeICUFromMapping(settings.icu_mapper());
+    StartConcurrentInitializationTasks(settings);
+
+    {
+      StartupReport::ScopedStage stage("SkiaInitialization");
+      if (!settings.skia_deterministic_rendering_on_cpu) {
+        SkGraphics::Init();
       } else {
-        FML_DLOG(WARNING) << "Skipping ICU initialization in the shell.";
+        FML_DLOG(INFO) << "Skia deterministic rendering is enabled.";
       }
+      RegisterCodecsWithSkia();
     }
   });
 
   PersistentCache::SetCacheSkSL(settings.cache_sksl);
 }
 
+// Applies |policy| to the thread of |runner| and reports the settings that
+// took effect.
+void ApplyThreadPolicy(const fml::RefPtr<fml::TaskRunner>& runner,
+                       const char* thread_name,
+                       const fml::ThreadSchedulingPolicy& policy) {
+  if (policy.IsEmpty()) {
+    return;
+  }
+  fml::TaskRunner::RunNowOrPostTask(runner, [thread_name, policy]() {
+    if (!fml::ApplyThreadSchedulingPolicy(policy)) {
+      FML_LOG(ERROR) << "Could not apply every scheduling setting of the "
+                     << thread_name << " thread.";
+    }
+    FML_LOG(INFO) << "Scheduling of the " << thread_name
+                  << " thread: " << fml::DescribeCurrentThreadScheduling();
+  });
+}
+
 }  // namespace
 
 std::pair<DartVMRef, fml::RefPtr<const DartSnapshot>>
@@ -149,9 +270,17 @@ Shell::InferVmInitDataFromSettings(Settings& settings) {
   // Always use the `vm_snapshot` and `isolate_snapshot` provided by the
   // settings to launch the VM.  If the VM is already running, the snapshot
   // arguments are ignored.
-  auto vm_snapshot = DartSnapshot::VMSnapshotFromSettings(settings);
-  auto isolate_snapshot = DartSnapshot::IsolateSnapshotFromSettings(settings);
-  auto vm = DartVMRef::Create(settings, vm_snapshot, isolate_snapshot);
+  fml::RefPtr<const DartSnapshot> vm_snapshot;
+  fml::RefPtr<const DartSnapshot> isolate_snapshot;
+  {
+    StartupReport::ScopedStage stage("SnapshotMapping");
+    vm_snapshot = DartSnapshot::VMSnapshotFromSettings(settings);
+    isolate_snapshot = DartSnapshot::IsolateSnapshotFromSettings(settings);
+  }
+  auto vm = [&] {
+    StartupReport::ScopedStage stage("DartVMInitialization");
+    return DartVMRef::Create(settings, vm_snapshot, isolate_snapshot);
+  }();
 
   // If the settings did not specify an `isolate_snapshot`, fall back to the
   // one the VM was launched with.
@@ -219,11 +348,21 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                 is_gpu_disabled));
 
   // Create the platform view on the platform thread (this thread).
-  auto platform_view = on_create_platform_view(*shell.get());
+  auto platform_view = [&] {
+    StartupReport::ScopedStage stage("PlatformViewSetup");
+    return on_create_platform_view(*shell.get());
+  }();
   if (!platform_view || !platform_view->GetWeakPtr()) {
     return nullptr;
   }
 
+  // Shared by the rasterizer, which detects overloads, and the animator, which
+  // throttles the frame rate during them.
+  std::shared_ptr<FrameOverloadController> overload_controller;
+  if (shell->GetSettings().raster_overload_throttling) {
+    overload_controller = std::make_shared<FrameOverloadController>();
+  }
+
   // Create the rasterizer on the raster thread.
   std::promise<std::unique_ptr<Rasterizer>> rasterizer_promise;
   auto rasterizer_future = rasterizer_promise.get_future();
@@ -234,13 +373,16 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
       task_runners.GetRasterTaskRunner(),
       [&rasterizer_promise,  //
        &snapshot_delegate_promise,
-       on_create_rasterizer,                                   //
-       shell = shell.get(),                                    //
-       impeller_context = platform_view->GetImpellerContext()  //
+       on_create_rasterizer,                                    //
+       shell = shell.get(),                                     //
+       impeller_context = platform_view->GetImpellerContext(),  //
+       overload_controller                                      //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupGPUSubsystem");
+        StartupReport::ScopedStage stage("RasterizerSetup");
         std::unique_ptr<Rasterizer> rasterizer(on_create_rasterizer(*shell));
         rasterizer->SetImpellerContext(impeller_context);
+        rasterizer->SetOverloadController(overload_controller);
         snapshot_delegate_promise.set_value(rasterizer->GetSnapshotDelegate());
         rasterizer_promise.set_value(std::move(rasterizer));
       });
@@ -278,6 +420,7 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
        is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch()  //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupIOSubsystem");
+        StartupReport::ScopedStage stage("IOManagerSetup");
         std::shared_ptr<ShellIOManager> io_manager;
         if (parent_io_manager) {
           io_manager = parent_io_manager;
@@ -297,6 +440,14 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   // Send dispatcher_maker to the engine constructor because shell won't have
   // platform_view set until Shell::Setup is called later.
   auto dispatcher_maker = platform_view->GetDispatcherMaker();
+  if (shell->GetSettings().coalesce_pointer_events) {
+    const bool merge_moves = shell->GetSettings().merge_coalesced_pointer_moves;
+    dispatcher_maker =
+        [merge_moves](PointerDataDispatcher::Delegate& delegate) {
+          return std::make_unique<CoalescingPointerDataDispatcher>(
+              delegate, merge_moves);
+        };
+  }
 
   // Create the engine on the UI thread.
   std::promise<std::unique_ptr<Engine>> engine_promise;
@@ -312,14 +463,19 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                          &weak_io_manager_future,                         //
                          &snapshot_delegate_future,                       //
                          &unref_queue_future,                             //
+                         overload_controller,                             //
                          &on_create_engine]() mutable {
         TRACE_EVENT0("flutter", "ShellSetupUISubsystem");
+        StartupReport::ScopedStage stage("EngineSetup");
         const auto& task_runners = shell->GetTaskRunners();
 
         // The animator is owned by the UI thread but it gets its vsync pulses
         // from the platform.
-        auto animator = std::make_unique<Animator>(*shell, task_runners,
-                                                   std::move(vsync_waiter));
+        auto animator = std::make_unique<Animator>(
+            *shell, task_runners, std::move(vsync_waiter),
+            shell->GetSettings().frame_pipeline_depth,
+            shell->GetSettings().predictive_frame_scheduling);
+        animator->SetOverloadController(overload_controller);
 
         engine_promise.set_value(
             on_create_engine(*shell,                          //
@@ -367,6 +523,8 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
 
   TRACE_EVENT0("flutter", "Shell::CreateWithSnapshot");
 
+  WaitForConcurrentInitializationTasks();
+
   const bool callbacks_valid =
       on_create_platform_view && on_create_rasterizer && on_create_engine;
   if (!task_runners.IsValid() || !callbacks_valid) {
@@ -432,6 +590,15 @@ Shell::Shell(DartVMRef vm,
   FML_DCHECK(task_runners_.IsValid());
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
+  ApplyThreadPolicy(task_runners_.GetPlatformTaskRunner(), "platform",
+                    settings_.platform_thread_policy);
+  ApplyThreadPolicy(task_runners_.GetUITaskRunner(), "UI",
+                    settings_.ui_thread_policy);
+  ApplyThreadPolicy(task_runners_.GetRasterTaskRunner(), "raster",
+                    settings_.raster_thread_policy);
+  ApplyThreadPolicy(task_runners_.GetIOTaskRunner(), "IO",
+                    settings_.io_thread_policy);
+
   display_manager_ = std::make_unique<DisplayManager>();
   resource_cache_limit_calculator->AddResourceCacheLimitItem(
       weak_factory_.GetWeakPtr());
@@ -488,13 +655,40 @@ Shell::Shell(DartVMRef vm,
           task_runners_.GetRasterTaskRunner(),
           std::bind(&Shell::OnServiceProtocolRenderFrameWithRasterStats, this,
                     std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kSampleLayerCostsExtensionName] =
+      {task_runners_.GetRasterTaskRunner(),
+       std::bind(&Shell::OnServiceProtocolSampleLayerCosts, this,
+                 std::placeholders::_1, std::placeholders::_2)};
   service_protocol_handlers_[ServiceProtocol::kReloadAssetFonts] = {
       task_runners_.GetPlatformTaskRunner(),
       std::bind(&Shell::OnServiceProtocolReloadAssetFonts, this,
                 std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetParagraphCacheStatsExtensionName] = {
+          task_runners_.GetUITaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetParagraphCacheStats, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetEngineMemoryUsageExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetEngineMemoryUsage, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetAllocationCountsExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetAllocationCounts, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kGetJankTraceExtensionName] = {
+      task_runners_.GetIOTaskRunner(),
+      std::bind(&Shell::OnServiceProtocolGetJankTrace, this,
+                std::placeholders::_1, std::placeholders::_2)};
 }
 
 Shell::~Shell() {
+  if (is_torn_down_) {
+    return;
+  }
+
   PersistentCache::GetCacheForProcess()->RemoveWorkerTaskRunner(
       task_runners_.GetIOTaskRunner());
 
@@ -547,6 +741,57 @@ Shell::~Shell() {
   platform_latch.Wait();
 }
 
+// static
+void Shell::DestroyAsync(std::unique_ptr<Shell> shell,
+                         const fml::closure& on_destroyed) {
+  FML_DCHECK(shell);
+  PersistentCache::GetCacheForProcess()->RemoveWorkerTaskRunner(
+      shell->task_runners_.GetIOTaskRunner());
+
+  shell->vm_->GetServiceProtocol()->RemoveHandler(shell.get());
+
+  // Each step releases one sub-component on its task runner and hands the
+  // shell over to the next one, in the order of the destructor, so that no
+  // thread waits for another.
+  auto ui_task_runner = shell->task_runners_.GetUITaskRunner();
+  fml::TaskRunner::RunNowOrPostTask(
+      ui_task_runner,
+      fml::MakeCopyable([shell = std::move(shell), on_destroyed]() mutable {
+        shell->engine_.reset();
+        auto raster_task_runner = shell->task_runners_.GetRasterTaskRunner();
+        fml::TaskRunner::RunNowOrPostTask(
+            raster_task_runner,
+            fml::MakeCopyable([shell = std::move(shell),
+                               on_destroyed]() mutable {
+              shell->rasterizer_.reset();
+              shell->weak_factory_gpu_.reset();
+              auto io_task_runner = shell->task_runners_.GetIOTaskRunner();
+              fml::TaskRunner::RunNowOrPostTask(
+                  io_task_runner,
+                  fml::MakeCopyable([shell = std::move(shell),
+                                     on_destroyed]() mutable {
+                    shell->io_manager_.reset();
+                    if (shell->platform_view_) {
+                      shell->platform_view_->ReleaseResourceContext();
+                    }
+                    auto platform_task_runner =
+                        shell->task_runners_.GetPlatformTaskRunner();
+                    fml::TaskRunner::RunNowOrPostTask(
+                        platform_task_runner,
+                        fml::MakeCopyable([shell = std::move(shell),
+                                           on_destroyed]() mutable {
+                          shell->platform_view_.reset();
+                          shell->is_torn_down_ = true;
+                          shell.reset();
+                          if (on_destroyed) {
+                            on_destroyed();
+                          }
+                        }));
+                  }));
+            }));
+      }));
+}
+
 std::unique_ptr<Shell> Shell::Spawn(
     RunConfiguration run_configuration,
     const std::string& initial_route,
@@ -612,6 +857,16 @@ void Shell::NotifyLowMemoryWarning() const {
   // to purge them.
 }
 
+void Shell::UpdateRetainedLayer(uint64_t layer_id,
+                                const RetainedLayerUpdate& update) const {
+  task_runners_.GetRasterTaskRunner()->PostTask(
+      [rasterizer = rasterizer_->GetWeakPtr(), layer_id, update]() {
+        if (rasterizer) {
+          rasterizer->UpdateRetainedLayer(layer_id, update);
+        }
+      });
+}
+
 void Shell::RunEngine(RunConfiguration run_configuration) {
   RunEngine(std::move(run_configuration), nullptr);
 }
@@ -697,6 +952,8 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
     return false;
   }
 
+  StartupReport::ScopedStage stage("ShellSetup");
+
   platform_view_ = std::move(platform_view);
   platform_message_handler_ = platform_view_->GetPlatformMessageHandler();
   route_messages_through_platform_thread_.store(true);
@@ -715,6 +972,19 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   rasterizer_->SetExternalViewEmbedder(view_embedder);
   rasterizer_->SetSnapshotSurfaceProducer(
       platform_view_->CreateSnapshotSurfaceProducer());
+  if (settings_.enable_async_raster_cache) {
+    rasterizer_->compositor_context()->raster_cache().SetAsyncFillTaskRunner(
+        task_runners_.GetIOTaskRunner(),
+        MakeRasterCacheUploadFunction(io_manager_->GetWeakPtr()));
+  }
+  rasterizer_->compositor_context()->raster_cache().SetAtlasEnabled(
+      settings_.enable_raster_cache_atlas);
+  if (settings_.enable_concurrent_preroll) {
+    rasterizer_->compositor_context()->SetConcurrentTaskRunner(
+        GetConcurrentWorkerTaskRunner());
+  }
+  rasterizer_->compositor_context()->SetBackdropFilterCacheEnabled(
+      settings_.enable_backdrop_filter_cache);
 
   // The weak ptr must be generated in the platform thread which owns the unique
   // ptr.
@@ -1148,7 +1418,7 @@ void Shell::OnPlatformViewMarkTextureFrameAvailable(int64_t texture_id) {
           return;
         }
 
-        texture->MarkNewFrameAvailable();
+        texture->MarkFrameAvailable();
       });
 
   // Schedule a new frame without having to rebuild the layer tree.
@@ -1198,10 +1468,25 @@ void Shell::OnAnimatorNotifyIdle(fml::TimeDelta deadline) {
   FML_DCHECK(is_set_up_);
   FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
 
+  // The headroom until the next frame is measured before the VM spends it on
+  // garbage collection, as the raster thread idles independently.
+  const fml::TimeDelta headroom =
+      deadline - fml::TimeDelta::FromMicroseconds(Dart_TimelineGetMicros());
+
   if (engine_) {
     engine_->NotifyIdle(deadline);
     volatile_path_tracker_->OnFrame();
   }
+
+  if (headroom > fml::TimeDelta::FromMilliseconds(1)) {
+    task_runners_.GetRasterTaskRunner()->PostTask(
+        [rasterizer = GetRasterizer(),
+         raster_deadline = fml::TimePoint::Now() + headroom]() {
+          if (rasterizer) {
+            rasterizer->NotifyIdle(raster_deadline);
+          }
+        });
+  }
 }
 
 void Shell::OnAnimatorUpdateLatestFrameTargetTime(
@@ -1513,6 +1798,81 @@ size_t Shell::UnreportedFramesCount() const {
   return unreported_timings_.size() / (FrameTiming::kStatisticsCount);
 }
 
+void Shell::SnapshotTraceRingBufferIfFrameJanked(const FrameTiming& timing) {
+  const fml::TimeDelta frame_time = timing.Get(FrameTiming::kRasterFinish) -
+                                    timing.Get(FrameTiming::kVsyncStart);
+  if (frame_time.ToMillisecondsF() <=
+      GetFrameBudget().count() * settings_.trace_ring_buffer_jank_threshold) {
+    return;
+  }
+
+  // A janky animation misses many deadlines in a row, and the ring buffer
+  // already holds well over a second of events.
+  const fml::TimePoint now = fml::TimePoint::Now();
+  if (now - last_trace_ring_buffer_dump_ < fml::TimeDelta::FromSeconds(1)) {
+    return;
+  }
+  last_trace_ring_buffer_dump_ = now;
+
+  // The snapshot is taken right away, before the events of the janky frame
+  // are overwritten, and serialized off the raster thread.
+  task_runners_.GetIOTaskRunner()->PostTask(
+      [jank_trace = jank_trace_,
+       threads = fml::tracing::TraceRingBufferSnapshot(),
+       directory = settings_.trace_ring_buffer_dump_directory,
+       callback = settings_.jank_trace_callback,
+       frame_number = timing.GetFrameNumber()]() {
+        TRACE_EVENT0("flutter", "Shell::DumpTraceRingBuffer");
+        std::string trace = fml::tracing::TraceRingBufferToJSON(threads);
+        if (callback) {
+          callback(frame_number, trace);
+        }
+        jank_trace->frame_number = frame_number;
+        jank_trace->trace = trace;
+        if (directory.empty()) {
+          return;
+        }
+        fml::DataMapping data(std::move(trace));
+        auto dump_directory = fml::OpenDirectory(
+            directory.c_str(), true, fml::FilePermission::kReadWrite);
+        std::stringstream file_name;
+        file_name << "trace_ring_buffer_frame_" << frame_number << ".json";
+        if (!dump_directory.is_valid() ||
+            !fml::WriteAtomically(dump_directory, file_name.str().c_str(),
+                                  data)) {
+          FML_LOG(ERROR) << "Could not write the trace ring buffer to "
+                         << directory;
+        }
+      });
+}
+
+void Shell::WriteStartupReportIfFirstFrame(const FrameTiming& timing) {
+  StartupReport& report = StartupReport::GetForProcess();
+  if (settings_.startup_report_directory.empty() || !report.IsEnabled()) {
+    return;
+  }
+
+  report.RecordStage("FirstFrame", timing.Get(FrameTiming::kVsyncStart),
+                     timing.Get(FrameTiming::kRasterFinish));
+  if (!report.Finish(timing.Get(FrameTiming::kRasterFinish))) {
+    return;
+  }
+
+  task_runners_.GetIOTaskRunner()->PostTask(
+      [directory = settings_.startup_report_directory, &report]() {
+        TRACE_EVENT0("flutter", "Shell::WriteStartupReport");
+        fml::DataMapping data(report.ToJSON());
+        auto report_directory = fml::OpenDirectory(
+            directory.c_str(), true, fml::FilePermission::kReadWrite);
+        if (!report_directory.is_valid() ||
+            !fml::WriteAtomically(report_directory, "startup_report.json",
+                                  data)) {
+          FML_LOG(ERROR) << "Could not write the startup report to "
+                         << directory;
+        }
+      });
+}
+
 void Shell::OnFrameRasterized(const FrameTiming& timing) {
   FML_DCHECK(is_set_up_);
   FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
@@ -1523,6 +1883,21 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  WriteStartupReportIfFirstFrame(timing);
+
+  if (fml::tracing::TraceRingBufferIsEnabled()) {
+    SnapshotTraceRingBufferIfFrameJanked(timing);
+  }
+
+  if (settings_.predictive_frame_scheduling) {
+    task_runners_.GetUITaskRunner()->PostTask(
+        [timing, engine = weak_engine_]() {
+          if (engine) {
+            engine->OnFrameRasterized(timing);
+          }
+        });
+  }
+
   if (!needs_report_timings_) {
     return;
   }
@@ -1537,6 +1912,8 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
   unreported_timings_.push_back(timing.GetLayerCacheBytes());
   unreported_timings_.push_back(timing.GetPictureCacheCount());
   unreported_timings_.push_back(timing.GetPictureCacheBytes());
+  // See |OnFrameGpuTimeMeasured|.
+  unreported_timings_.push_back(0);
   unreported_timings_.push_back(timing.GetFrameNumber());
   FML_DCHECK(unreported_timings_.size() ==
              old_count + FrameTiming::kStatisticsCount);
@@ -1581,6 +1958,27 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
   }
 }
 
+// |Rasterizer::Delegate|
+void Shell::OnFrameGpuTimeMeasured(fml::TimePoint frame_start,
+                                   fml::TimeDelta gpu_time) {
+  FML_DCHECK(is_set_up_);
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+
+  // The GPU work of a frame is recorded while the frame is rasterized. Frames
+  // that have already been reported keep a GPU duration of zero.
+  const int64_t frame_start_micros =
+      frame_start.ToEpochDelta().ToMicroseconds();
+  for (size_t i = 0; i < unreported_timings_.size();
+       i += FrameTiming::kStatisticsCount) {
+    int64_t* frame = &unreported_timings_[i];
+    if (frame[FrameTiming::kRasterStart] <= frame_start_micros &&
+        frame_start_micros <= frame[FrameTiming::kRasterFinish]) {
+      frame[FrameTiming::kGpuDurationIndex] += gpu_time.ToMicroseconds();
+      return;
+    }
+  }
+}
+
 fml::Milliseconds Shell::GetFrameBudget() {
   double display_refresh_rate = display_manager_->GetMainDisplayRefreshRate();
   if (display_refresh_rate > 0) {
@@ -2031,6 +2429,79 @@ bool Shell::OnServiceProtocolRenderFrameWithRasterStats(
   }
 }
 
+bool Shell::OnServiceProtocolSampleLayerCosts(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+
+  if (!rasterizer_ || !rasterizer_->compositor_context()) {
+    const char* error = "Layer costs are not available without a rasterizer.";
+    ServiceProtocolFailureError(response, error);
+    return false;
+  }
+  LayerCostProfiler& profiler =
+      rasterizer_->compositor_context()->layer_cost_profiler();
+
+  if (params.count("frameCount") != 0) {
+    const std::string_view frame_count = params.at("frameCount");
+    // Only plain decimal digits are accepted, so that signs, whitespace and
+    // values that overflow are rejected rather than wrapped around.
+    size_t value = 0;
+    bool valid = !frame_count.empty();
+    for (char digit : frame_count) {
+      if (digit < '0' || digit > '9') {
+        valid = false;
+        break;
+      }
+      value = value * 10 + (digit - '0');
+      if (value > kMaxSampledLayerCostFrames) {
+        valid = false;
+        break;
+      }
+    }
+    if (!valid) {
+      ServiceProtocolParameterError(
+          response, "'frameCount' must be an integer between 0 and " +
+                        std::to_string(kMaxSampledLayerCostFrames) + ".");
+      return false;
+    }
+    profiler.StartSampling(value);
+  }
+
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "LayerCosts", allocator);
+  response->AddMember("sampledFrames",
+                      static_cast<uint64_t>(profiler.sampled_frames()),
+                      allocator);
+  response->AddMember("requestedFrames",
+                      static_cast<uint64_t>(profiler.requested_frames()),
+                      allocator);
+
+  rapidjson::Value layers;
+  layers.SetArray();
+  for (const auto& [layer_unique_id, cost] : profiler.report()) {
+    rapidjson::Value layer;
+    layer.SetObject();
+    layer.AddMember("layer_unique_id", layer_unique_id, allocator);
+    layer.AddMember("preroll_micros", cost.preroll_time.ToMicroseconds(),
+                    allocator);
+    layer.AddMember("preroll_count", static_cast<uint64_t>(cost.preroll_count),
+                    allocator);
+    layer.AddMember("paint_micros", cost.paint_time.ToMicroseconds(),
+                    allocator);
+    layer.AddMember("paint_count", static_cast<uint64_t>(cost.paint_count),
+                    allocator);
+    layer.AddMember("raster_cache_hits",
+                    static_cast<uint64_t>(cost.raster_cache_hits), allocator);
+    layer.AddMember("offscreen_count",
+                    static_cast<uint64_t>(cost.offscreen_count), allocator);
+    layers.PushBack(layer, allocator);
+  }
+  response->AddMember("layers", layers, allocator);
+  return true;
+}
+
 void Shell::SendFontChangeNotification() {
   // After system fonts are reloaded, we send a system channel message
   // to notify flutter framework.
@@ -2060,7 +2531,11 @@ bool Shell::OnServiceProtocolReloadAssetFonts(
     return false;
   }
   engine_->GetFontCollection().RegisterFonts(engine_->GetAssetManager());
-  engine_->GetFontCollection().GetFontCollection()->ClearFontFamilyCache();
+  {
+    auto font_collection = engine_->GetFontCollection().GetFontCollection();
+    std::scoped_lock lock(font_collection->GetLayoutMutex());
+    font_collection->ClearFontFamilyCache();
+  }
   SendFontChangeNotification();
 
   auto& allocator = response->GetAllocator();
@@ -2070,6 +2545,92 @@ bool Shell::OnServiceProtocolReloadAssetFonts(
   return true;
 }
 
+bool Shell::OnServiceProtocolGetParagraphCacheStats(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  if (!engine_) {
+    return false;
+  }
+  const auto stats = engine_->GetFontCollection()
+                         .GetFontCollection()
+                         ->GetParagraphCache()
+                         ->GetStats();
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "ParagraphCacheStats", allocator);
+  response->AddMember<uint64_t>("hits", stats.hits, allocator);
+  response->AddMember<uint64_t>("misses", stats.misses, allocator);
+  response->AddMember<uint64_t>("entries", stats.entries, allocator);
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetEngineMemoryUsage(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  if (!rasterizer_) {
+    return false;
+  }
+  const auto& raster_cache = rasterizer_->compositor_context()->raster_cache();
+  const auto usage = rasterizer_->GetMemoryUsage();
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "EngineMemoryUsage", allocator);
+  response->AddMember<uint64_t>("rasterCacheLayerBytes",
+                                raster_cache.EstimateLayerCacheByteSize(),
+                                allocator);
+  response->AddMember<uint64_t>("rasterCachePictureBytes",
+                                raster_cache.EstimatePictureCacheByteSize(),
+                                allocator);
+  response->AddMember<uint64_t>("displayListBytes", usage.display_list_bytes,
+                                allocator);
+  response->AddMember<uint64_t>("skiaResourceCacheBytes",
+                                usage.skia_resource_cache_bytes, allocator);
+  response->AddMember<uint64_t>("impellerBufferBytes",
+                                usage.impeller_buffer_bytes, allocator);
+  response->AddMember<uint64_t>("impellerTextureBytes",
+                                usage.impeller_texture_bytes, allocator);
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetAllocationCounts(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "AllocationCounts", allocator);
+  rapidjson::Value counts(rapidjson::kObjectType);
+  for (size_t i = 0; i < fml::kAllocationTagCount; i++) {
+    const auto tag = static_cast<fml::AllocationTag>(i);
+    const auto count = fml::GetProcessAllocationCount(tag);
+    rapidjson::Value tag_count(rapidjson::kObjectType);
+    tag_count.AddMember<uint64_t>("allocations", count.allocations, allocator);
+    tag_count.AddMember<uint64_t>("bytes", count.bytes, allocator);
+    counts.AddMember(rapidjson::StringRef(fml::GetAllocationTagName(tag)),
+                     tag_count, allocator);
+  }
+  response->AddMember("counts", counts, allocator);
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetJankTrace(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "JankTrace", allocator);
+  response->AddMember("hasTrace", jank_trace_->frame_number >= 0, allocator);
+  response->AddMember<int64_t>("frameNumber", jank_trace_->frame_number,
+                               allocator);
+  response->AddMember(
+      "trace", rapidjson::Value(jank_trace_->trace.c_str(), allocator),
+      allocator);
+  return true;
+}
+
 void Shell::AddView(int64_t view_id, const ViewportMetrics& viewport_metrics) {
   TRACE_EVENT0("flutter", "Shell::AddView");
   FML_DCHECK(is_set_up_);
@@ -2141,6 +2702,35 @@ Rasterizer::Screenshot Shell::Screenshot(
   return screenshot;
 }
 
+std::vector<sk_sp<DlImage>> Shell::MakeRasterSnapshots(
+    const std::vector<RasterSnapshotJob>& jobs) {
+  TRACE_EVENT0("flutter", "Shell::MakeRasterSnapshots");
+  fml::AutoResetWaitableEvent latch;
+  std::vector<sk_sp<DlImage>> images;
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetRasterTaskRunner(),
+      [&latch, rasterizer = GetRasterizer(), &jobs, &images]() {
+        if (rasterizer) {
+          images = rasterizer->MakeRasterSnapshots(jobs);
+        }
+        latch.Signal();
+      });
+  latch.Wait();
+  images.resize(jobs.size());
+  return images;
+}
+
+void Shell::SetFrameCapturer(std::unique_ptr<FrameCapturer> capturer) {
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetRasterTaskRunner(),
+      fml::MakeCopyable([rasterizer = GetRasterizer(),
+                         capturer = std::move(capturer)]() mutable {
+        if (rasterizer) {
+          rasterizer->SetFrameCapturer(std::move(capturer));
+        }
+      }));
+}
+
 fml::Status Shell::WaitForFirstFrame(fml::TimeDelta timeout) {
   FML_DCHECK(is_set_up_);
   if (task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread() ||
@@ -2176,14 +2766,62 @@ bool Shell::ReloadSystemFonts() {
   if (!engine_) {
     return false;
   }
+  // The platform fonts may have changed, so resolve fallbacks again.
+  txt::FallbackFontCache::GetForProcess().Clear();
   engine_->SetupDefaultFontManager();
-  engine_->GetFontCollection().GetFontCollection()->ClearFontFamilyCache();
+  {
+    auto font_collection = engine_->GetFontCollection().GetFontCollection();
+    std::scoped_lock lock(font_collection->GetLayoutMutex());
+    font_collection->ClearFontFamilyCache();
+  }
   // After system fonts are reloaded, we send a system channel message
   // to notify flutter framework.
   SendFontChangeNotification();
   return true;
 }
 
+void Shell::PrefetchAssets(std::vector<std::string> asset_names) {
+  FML_DCHECK(is_set_up_);
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+
+  // The asset manager belongs to the engine, which lives on the UI thread.
+  task_runners_.GetUITaskRunner()->PostTask(
+      [engine = weak_engine_, asset_names = std::move(asset_names),
+       worker_task_runner = GetConcurrentWorkerTaskRunner()]() mutable {
+        if (!engine || !worker_task_runner) {
+          return;
+        }
+        std::shared_ptr<AssetManager> asset_manager =
+            engine->GetAssetManager();
+        if (!asset_manager) {
+          return;
+        }
+        for (std::string& asset_name : asset_names) {
+          worker_task_runner->PostTask(
+              [asset_manager, asset_name = std::move(asset_name)]() {
+                asset_manager->Prefetch(asset_name);
+              });
+        }
+      });
+}
+
+void Shell::RunInWorkerIsolate(std::string function,
+                               std::unique_ptr<fml::Mapping> message,
+                               WorkerIsolatePool::TaskCallback callback) {
+  FML_DCHECK(is_set_up_);
+
+  // The worker isolates belong to the runtime controller of the engine.
+  task_runners_.GetUITaskRunner()->PostTask(fml::MakeCopyable(
+      [engine = weak_engine_, function = std::move(function),
+       message = std::move(message), callback = std::move(callback)]() mutable {
+        if (!engine) {
+          return;
+        }
+        engine->RunInWorkerIsolate(std::move(function), std::move(message),
+                                   std::move(callback));
+      }));
+}
+
 std::shared_ptr<const fml::SyncSwitch> Shell::GetIsGpuDisabledSyncSwitch()
     const {
   return is_gpu_disabled_sync_switch_;
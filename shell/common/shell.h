@@ -9,6 +9,7 @@
 #include <mutex>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/graphics/texture.h"
@@ -33,6 +34,7 @@
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/runtime/platform_data.h"
 #include "flutter/runtime/service_protocol.h"
+#include "flutter/runtime/worker_isolate_pool.h"
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/display_manager.h"
 #include "flutter/shell/common/engine.h"
@@ -179,6 +181,22 @@ class Shell final : public PlatformView::Delegate,
   ///
   ~Shell();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Destroys the shell without blocking the calling thread. The
+  ///             sub-components of the shell are torn down in the same order
+  ///             as in the destructor, each on its own task runner, and the
+  ///             shell itself is deleted on the platform task runner.
+  ///
+  ///             The caller gives up its ownership of the shell and must not
+  ///             use it after this call.
+  ///
+  /// @param[in]  shell         The shell to destroy.
+  /// @param[in]  on_destroyed  Invoked on the platform task runner once the
+  ///                           shell has been deleted.
+  ///
+  static void DestroyAsync(std::unique_ptr<Shell> shell,
+                           const fml::closure& on_destroyed);
+
   //----------------------------------------------------------------------------
   /// @brief      Creates one Shell from another Shell where the created Shell
   ///             takes the opportunity to share any internal components it can.
@@ -288,6 +306,20 @@ class Shell final : public PlatformView::Delegate,
   ///             the rasterizer cache is purged.
   void NotifyLowMemoryWarning() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sends new values of the opacity or transform of a retained
+  ///             layer to the raster thread, which draws the last frame again
+  ///             with them. See `Rasterizer::UpdateRetainedLayer`.
+  ///
+  ///             This can be called from any thread and does not wait for
+  ///             the UI thread.
+  ///
+  /// @param[in]  layer_id  The original layer id of the layer.
+  /// @param[in]  update    The new values of the properties.
+  ///
+  void UpdateRetainedLayer(uint64_t layer_id,
+                           const RetainedLayerUpdate& update) const;
+
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to check if all shell subcomponents are
   ///             initialized. It is the embedder's responsibility to make this
@@ -345,6 +377,30 @@ class Shell final : public PlatformView::Delegate,
   Rasterizer::Screenshot Screenshot(Rasterizer::ScreenshotType type,
                                     bool base64_encode);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Rasterizes a batch of display lists into images in one task
+  ///             on the raster thread, and waits for the images. This works
+  ///             without a view, so that a shell can render pictures
+  ///             offscreen. See `Rasterizer::MakeRasterSnapshots`.
+  ///
+  /// @param[in]  jobs  The display lists and the sizes of their images.
+  ///
+  /// @return     An image per job, in the order of the jobs. The image of a
+  ///             job that could not be rasterized is null.
+  ///
+  std::vector<sk_sp<DlImage>> MakeRasterSnapshots(
+      const std::vector<RasterSnapshotJob>& jobs);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts capturing the frames rendered by the rasterizer in
+  ///             this shell for streaming, replacing any previous capturer,
+  ///             or stops capturing if `capturer` is null. Unlike
+  ///             `Screenshot`, this does not wait for the raster thread.
+  ///
+  /// @param[in]  capturer  The frame capturer.
+  ///
+  void SetFrameCapturer(std::unique_ptr<FrameCapturer> capturer);
+
   //----------------------------------------------------------------------------
   /// @brief      Pauses the calling thread until the first frame is presented.
   ///
@@ -369,6 +425,35 @@ class Shell final : public PlatformView::Delegate,
   ///
   bool ReloadSystemFonts();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Used by embedders to load assets on the concurrent worker
+  ///             pool ahead of their use, for example before showing content
+  ///             that needs them. See `AssetManager::Prefetch`.
+  ///
+  /// @param[in]  asset_names  The names of the assets to load.
+  ///
+  void PrefetchAssets(std::vector<std::string> asset_names);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Used by embedders to invoke a top-level function of the root
+  ///             library on one of the worker isolates created for
+  ///             `Settings::worker_isolate_count`, with `message` as its
+  ///             `ByteData` argument.
+  ///
+  ///             The callback is invoked with the `ByteData` the function
+  ///             returns, or nullptr if it failed, did not return a
+  ///             `ByteData`, or there are no worker isolates. It is invoked
+  ///             on an engine managed thread, and is not invoked if the
+  ///             engine is collected before the task reaches a worker.
+  ///
+  /// @param[in]  function  The name of the function in the root library.
+  /// @param[in]  message   The bytes passed to the function, may be nullptr.
+  /// @param[in]  callback  The callback invoked with the result.
+  ///
+  void RunInWorkerIsolate(std::string function,
+                          std::unique_ptr<fml::Mapping> message,
+                          WorkerIsolatePool::TaskCallback callback);
+
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to get the last error from the Dart UI
   ///             Isolate, if one exists.
@@ -496,6 +581,8 @@ class Shell final : public PlatformView::Delegate,
                      >
       service_protocol_handlers_;
   bool is_set_up_ = false;
+  // Whether the sub-components were already torn down by |DestroyAsync|.
+  bool is_torn_down_ = false;
   bool is_added_to_service_protocol_ = false;
   uint64_t next_pointer_flow_id_ = 0;
 
@@ -517,6 +604,19 @@ class Shell final : public PlatformView::Delegate,
   // stored here for easier conversions to Dart objects.
   std::vector<int64_t> unreported_timings_;
 
+  // When the trace ring buffer was last snapshotted because a frame janked.
+  // Only accessed on the raster thread.
+  fml::TimePoint last_trace_ring_buffer_dump_;
+
+  // The latest snapshot of the trace ring buffer taken for a janky frame, in
+  // the JSON trace event format. Only accessed on the IO thread, which may
+  // still write a snapshot after the shell is gone.
+  struct JankTrace {
+    int64_t frame_number = -1;
+    std::string trace;
+  };
+  std::shared_ptr<JankTrace> jank_trace_ = std::make_shared<JankTrace>();
+
   /// Manages the displays. This class is thread safe, can be accessed from
   /// any of the threads.
   std::unique_ptr<DisplayManager> display_manager_;
@@ -581,6 +681,17 @@ class Shell final : public PlatformView::Delegate,
 
   void ReportTimings();
 
+  // Snapshots the trace ring buffer if the frame took longer than
+  // |Settings::trace_ring_buffer_jank_threshold| frame budgets. The snapshot
+  // is kept for |OnServiceProtocolGetJankTrace|, passed to
+  // |Settings::jank_trace_callback|, and written to
+  // |Settings::trace_ring_buffer_dump_directory|.
+  void SnapshotTraceRingBufferIfFrameJanked(const FrameTiming& timing);
+
+  // Writes the startup report to |Settings::startup_report_directory| when the
+  // first frame of the process is rasterized.
+  void WriteStartupReportIfFirstFrame(const FrameTiming& timing);
+
   // |PlatformView::Delegate|
   void OnPlatformViewCreated(std::unique_ptr<Surface> surface) override;
 
@@ -707,6 +818,10 @@ class Shell final : public PlatformView::Delegate,
   // |Rasterizer::Delegate|
   void OnFrameRasterized(const FrameTiming&) override;
 
+  // |Rasterizer::Delegate|
+  void OnFrameGpuTimeMeasured(fml::TimePoint frame_start,
+                              fml::TimeDelta gpu_time) override;
+
   // |Rasterizer::Delegate|
   fml::Milliseconds GetFrameBudget() override;
 
@@ -783,6 +898,17 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Responds with the Preroll and Paint time, raster cache hits and offscreen
+  // layers of every layer over the frames sampled so far. If the optional
+  // "frameCount" parameter is present, the previous samples are discarded and
+  // the next "frameCount" frames are sampled instead. "frameCount" must be an
+  // integer between 0 and 1000.
+  bool OnServiceProtocolSampleLayerCosts(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Service protocol handler
   //
   // Forces the FontCollection to reload the font manifest. Used to support
@@ -791,6 +917,38 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Responds with the number of hits, misses and entries of the cache of laid
+  // out paragraphs of the engine's font collection.
+  bool OnServiceProtocolGetParagraphCacheStats(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Responds with the bytes of native memory held by the raster cache, the
+  // retained display lists and the GPU resources of the rasterizer.
+  bool OnServiceProtocolGetEngineMemoryUsage(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Responds with the number and bytes of the allocations each tagged engine
+  // subsystem has made since the process started.
+  bool OnServiceProtocolGetAllocationCounts(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Responds with the latest snapshot of the trace ring buffer taken because
+  // a frame janked.
+  bool OnServiceProtocolGetJankTrace(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Send a system font change notification.
   void SendFontChangeNotification();
 
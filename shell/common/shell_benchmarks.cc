@@ -4,15 +4,60 @@
 
 #include "flutter/shell/common/shell.h"
 
+#include <array>
+
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/runtime/dart_snapshot.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/runtime/dart_vm_lifecycle.h"
+#include "flutter/shell/common/run_configuration.h"
+#include "flutter/shell/common/shell_test_platform_view.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/elf_loader.h"
 #include "flutter/testing/testing.h"
 
 namespace flutter {
 
+// Settings that run the shell unittest fixtures. |assets_dir| and
+// |aot_symbols| must outlive the settings.
+static Settings CreateBenchmarkSettings(const fml::UniqueFD& assets_dir,
+                                        testing::ELFAOTSymbols& aot_symbols) {
+  Settings settings = {};
+  settings.task_observer_add = [](intptr_t, const fml::closure&) {};
+  settings.task_observer_remove = [](intptr_t) {};
+
+  if (DartVM::IsRunningPrecompiledCode()) {
+    aot_symbols = testing::LoadELFSymbolFromFixturesIfNeccessary(
+        testing::kDefaultAOTAppELFFileName);
+    FML_CHECK(testing::PrepareSettingsForAOTWithSymbols(settings, aot_symbols))
+        << "Could not set up settings with AOT symbols.";
+  } else {
+    settings.application_kernels = [&assets_dir]() {
+      std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
+      kernel_mappings.emplace_back(
+          fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
+      return kernel_mappings;
+    };
+  }
+  return settings;
+}
+
+static std::unique_ptr<ThreadHost> CreateBenchmarkThreadHost() {
+  return std::make_unique<ThreadHost>(ThreadHost::ThreadHostConfig(
+      "io.flutter.bench.", ThreadHost::Type::kPlatform |
+                               ThreadHost::Type::kRaster |
+                               ThreadHost::Type::kIo | ThreadHost::Type::kUi));
+}
+
+static TaskRunners CreateBenchmarkTaskRunners(const ThreadHost& thread_host) {
+  return TaskRunners("test", thread_host.platform_thread->GetTaskRunner(),
+                     thread_host.raster_thread->GetTaskRunner(),
+                     thread_host.ui_thread->GetTaskRunner(),
+                     thread_host.io_thread->GetTaskRunner());
+}
+
 static void StartupAndShutdownShell(benchmark::State& state,
                                     bool measure_startup,
                                     bool measure_shutdown) {
@@ -24,35 +69,9 @@ static void StartupAndShutdownShell(benchmark::State& state,
 
   {
     benchmarking::ScopedPauseTiming pause(state, !measure_startup);
-    Settings settings = {};
-    settings.task_observer_add = [](intptr_t, const fml::closure&) {};
-    settings.task_observer_remove = [](intptr_t) {};
-
-    if (DartVM::IsRunningPrecompiledCode()) {
-      aot_symbols = testing::LoadELFSymbolFromFixturesIfNeccessary(
-          testing::kDefaultAOTAppELFFileName);
-      FML_CHECK(
-          testing::PrepareSettingsForAOTWithSymbols(settings, aot_symbols))
-          << "Could not set up settings with AOT symbols.";
-    } else {
-      settings.application_kernels = [&]() {
-        std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
-        kernel_mappings.emplace_back(
-            fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
-        return kernel_mappings;
-      };
-    }
-
-    thread_host = std::make_unique<ThreadHost>(ThreadHost::ThreadHostConfig(
-        "io.flutter.bench.",
-        ThreadHost::Type::kPlatform | ThreadHost::Type::kRaster |
-            ThreadHost::Type::kIo | ThreadHost::Type::kUi));
-
-    TaskRunners task_runners("test",
-                             thread_host->platform_thread->GetTaskRunner(),
-                             thread_host->raster_thread->GetTaskRunner(),
-                             thread_host->ui_thread->GetTaskRunner(),
-                             thread_host->io_thread->GetTaskRunner());
+    Settings settings = CreateBenchmarkSettings(assets_dir, aot_symbols);
+    thread_host = CreateBenchmarkThreadHost();
+    TaskRunners task_runners = CreateBenchmarkTaskRunners(*thread_host);
 
     shell = Shell::Create(
         flutter::PlatformData(), task_runners, settings,
@@ -120,4 +139,149 @@ static void BM_ShellInitializationAndShutdown(benchmark::State& state) {
 
 BENCHMARK(BM_ShellInitializationAndShutdown);
 
+constexpr int64_t kImplicitViewId = 0;
+
+// The stages of starting up an engine and drawing its first frame.
+enum class StartupPhase {
+  kSnapshotMapping,
+  kVMCreation,
+  kPlatformViewCreation,
+  kGPUContextCreation,
+  kIsolateLaunch,
+  kFirstFrame,
+  kCount,
+};
+
+using StartupPhaseTimes =
+    std::array<fml::TimeDelta, static_cast<size_t>(StartupPhase::kCount)>;
+
+// Starts an engine with a test platform view, draws its first frame, and
+// shuts it down again, returning how long each phase of the startup took.
+//
+// The VM is shut down at the end, so every run creates it again unless
+// another benchmark in the process has leaked it.
+static StartupPhaseTimes StartupShellInPhases() {
+  StartupPhaseTimes times;
+  auto record = [&times](StartupPhase phase, fml::TimePoint start) {
+    times[static_cast<size_t>(phase)] = fml::TimePoint::Now() - start;
+  };
+
+  auto assets_dir = fml::OpenDirectory(testing::GetFixturesPath(), false,
+                                       fml::FilePermission::kRead);
+  testing::ELFAOTSymbols aot_symbols;
+  Settings settings = CreateBenchmarkSettings(assets_dir, aot_symbols);
+  settings.leak_vm = false;
+  fml::ManualResetWaitableEvent first_frame;
+  settings.frame_rasterized_callback = [&first_frame](const FrameTiming&) {
+    first_frame.Signal();
+  };
+
+  auto start = fml::TimePoint::Now();
+  auto vm_snapshot = DartSnapshot::VMSnapshotFromSettings(settings);
+  auto isolate_snapshot = DartSnapshot::IsolateSnapshotFromSettings(settings);
+  record(StartupPhase::kSnapshotMapping, start);
+
+  start = fml::TimePoint::Now();
+  auto vm = DartVMRef::Create(settings, vm_snapshot, isolate_snapshot);
+  record(StartupPhase::kVMCreation, start);
+  FML_CHECK(vm);
+
+  auto thread_host = CreateBenchmarkThreadHost();
+  TaskRunners task_runners = CreateBenchmarkTaskRunners(*thread_host);
+  testing::ShellTestPlatformViewBuilder platform_view_builder({});
+  auto shell = Shell::Create(
+      flutter::PlatformData(), task_runners, settings,
+      [&](Shell& shell) {
+        auto platform_view_start = fml::TimePoint::Now();
+        auto platform_view = platform_view_builder(shell);
+        record(StartupPhase::kPlatformViewCreation, platform_view_start);
+        return platform_view;
+      },
+      [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+  FML_CHECK(shell);
+
+  fml::AutoResetWaitableEvent latch;
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners.GetPlatformTaskRunner(), [&shell, &record, &latch]() {
+        auto gpu_start = fml::TimePoint::Now();
+        shell->GetPlatformView()->NotifyCreated();
+        record(StartupPhase::kGPUContextCreation, gpu_start);
+        shell->GetPlatformView()->SetViewportMetrics(kImplicitViewId,
+                                                     {1.0, 800, 600, 22, 0});
+        latch.Signal();
+      });
+  latch.Wait();
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("drawFirstFrame");
+  start = fml::TimePoint::Now();
+  shell->RunEngine(std::move(configuration),
+                   [&latch](Engine::RunStatus status) {
+                     FML_CHECK(status == Engine::RunStatus::Success);
+                     latch.Signal();
+                   });
+  latch.Wait();
+  record(StartupPhase::kIsolateLaunch, start);
+
+  start = fml::TimePoint::Now();
+  first_frame.Wait();
+  record(StartupPhase::kFirstFrame, start);
+
+  // Shutdown must occur synchronously on the platform thread.
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners.GetPlatformTaskRunner(), [&shell, &latch]() {
+        shell->GetPlatformView()->NotifyDestroyed();
+        shell.reset();
+        latch.Signal();
+      });
+  latch.Wait();
+  thread_host.reset();
+  return times;
+}
+
+// Reports the time of one |phase| of the startup, so that each phase can be
+// tracked for regressions on its own.
+//
+// With Impeller, creating the GPU context includes warming up the pipelines
+// the content context creates up front.
+static void BM_ShellStartupPhase(benchmark::State& state, StartupPhase phase) {
+  if (phase == StartupPhase::kVMCreation && DartVMRef::IsInstanceRunning()) {
+    state.SkipWithError(
+        "The VM was leaked by an earlier benchmark. Run this one on its own "
+        "with --benchmark_filter.");
+    return;
+  }
+  for ([[maybe_unused]] auto _ : state) {
+    auto times = StartupShellInPhases();
+    state.SetIterationTime(times[static_cast<size_t>(phase)].ToSecondsF());
+  }
+}
+
+BENCHMARK_CAPTURE(BM_ShellStartupPhase,
+                  snapshot_mapping,
+                  StartupPhase::kSnapshotMapping)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ShellStartupPhase, vm_creation, StartupPhase::kVMCreation)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ShellStartupPhase,
+                  platform_view_creation,
+                  StartupPhase::kPlatformViewCreation)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ShellStartupPhase,
+                  gpu_context_creation,
+                  StartupPhase::kGPUContextCreation)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ShellStartupPhase,
+                  isolate_launch,
+                  StartupPhase::kIsolateLaunch)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ShellStartupPhase, first_frame, StartupPhase::kFirstFrame)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
 }  // namespace flutter
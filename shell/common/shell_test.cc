@@ -283,6 +283,18 @@ void ShellTest::OnServiceProtocol(
       case ServiceProtocolEnum::kRenderFrameWithRasterStats:
         shell->OnServiceProtocolRenderFrameWithRasterStats(params, response);
         break;
+      case ServiceProtocolEnum::kGetEngineMemoryUsage:
+        shell->OnServiceProtocolGetEngineMemoryUsage(params, response);
+        break;
+      case ServiceProtocolEnum::kGetAllocationCounts:
+        shell->OnServiceProtocolGetAllocationCounts(params, response);
+        break;
+      case ServiceProtocolEnum::kGetJankTrace:
+        shell->OnServiceProtocolGetJankTrace(params, response);
+        break;
+      case ServiceProtocolEnum::kSampleLayerCosts:
+        shell->OnServiceProtocolSampleLayerCosts(params, response);
+        break;
     }
     finished.set_value(true);
   });
@@ -113,6 +113,10 @@ class ShellTest : public FixtureTest {
     kSetAssetBundlePath,
     kRunInView,
     kRenderFrameWithRasterStats,
+    kGetEngineMemoryUsage,
+    kGetAllocationCounts,
+    kGetJankTrace,
+    kSampleLayerCosts,
   };
 
   // Helper method to test private method Shell::OnServiceProtocolGetSkSLs.
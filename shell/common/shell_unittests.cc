@@ -24,11 +24,13 @@
 #include "flutter/flow/layers/clip_rect_layer.h"
 #include "flutter/flow/layers/display_list_layer.h"
 #include "flutter/flow/layers/layer_raster_cache_item.h"
+#include "flutter/flow/layers/opacity_layer.h"
 #include "flutter/flow/layers/platform_view_layer.h"
 #include "flutter/flow/layers/transform_layer.h"
 #include "flutter/fml/backtrace.h"
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/memory/allocation_counter.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -401,6 +403,46 @@ TEST_F(ShellTest, InitializeWithDifferentThreads) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST_F(ShellTest, DestroyAsyncDoesNotWaitForOtherThreads) {
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+  Settings settings = CreateSettingsForFixture();
+  ThreadHost thread_host(ThreadHost::ThreadHostConfig(
+      "io.flutter.test." + GetCurrentTestName() + ".",
+      ThreadHost::Type::kPlatform | ThreadHost::Type::kRaster |
+          ThreadHost::Type::kIo | ThreadHost::Type::kUi));
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  auto shell = CreateShell(settings, task_runners);
+  ASSERT_TRUE(ValidateShell(shell.get()));
+
+  // Keep the UI thread busy so that a synchronous teardown would block.
+  fml::AutoResetWaitableEvent ui_blocked;
+  task_runners.GetUITaskRunner()->PostTask(
+      [&ui_blocked] { ui_blocked.Wait(); });
+
+  fml::AutoResetWaitableEvent destroy_returned;
+  fml::AutoResetWaitableEvent destroyed;
+  task_runners.GetPlatformTaskRunner()->PostTask(
+      fml::MakeCopyable([&shell, &destroy_returned, &destroyed,
+                         platform_task_runner =
+                             task_runners.GetPlatformTaskRunner()]() mutable {
+        Shell::DestroyAsync(std::move(shell), [&destroyed,
+                                               platform_task_runner] {
+          EXPECT_TRUE(platform_task_runner->RunsTasksOnCurrentThread());
+          destroyed.Signal();
+        });
+        destroy_returned.Signal();
+      }));
+  destroy_returned.Wait();
+  ASSERT_TRUE(DartVMRef::IsInstanceRunning());
+
+  ui_blocked.Signal();
+  destroyed.Wait();
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+}
+
 TEST_F(ShellTest, InitializeWithSingleThread) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
   Settings settings = CreateSettingsForFixture();
@@ -881,6 +923,55 @@ TEST_F(ShellTest, ExternalEmbedderNoThreadMerger) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, UpdateRetainedLayerDrawsTheLastFrameAgain) {
+  auto settings = CreateSettingsForFixture();
+  fml::AutoResetWaitableEvent end_frame_latch;
+  int end_frame_count = 0;
+  auto end_frame_callback =
+      [&](bool should_resubmit_frame,
+          const fml::RefPtr<fml::RasterThreadMerger>& raster_thread_merger) {
+        end_frame_count++;
+        end_frame_latch.Signal();
+      };
+  auto external_view_embedder = std::make_shared<ShellTestExternalViewEmbedder>(
+      end_frame_callback, PostPrerollResult::kSuccess, false);
+  auto shell = CreateShell({
+      .settings = settings,
+      .platform_view_create_callback = ShellTestPlatformViewBuilder({
+          .shell_test_external_view_embedder = external_view_embedder,
+      }),
+  });
+
+  PlatformViewNotifyCreated(shell.get());
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+
+  RunEngine(shell.get(), std::move(configuration));
+
+  std::shared_ptr<OpacityLayer> opacity_layer;
+  LayerTreeBuilder builder = [&](const std::shared_ptr<ContainerLayer>& root) {
+    opacity_layer =
+        std::make_shared<OpacityLayer>(SK_AlphaOPAQUE, SkPoint::Make(0, 0));
+    opacity_layer->Add(std::make_shared<DisplayListLayer>(
+        SkPoint::Make(10, 10), MakeSizedDisplayList(80, 80), false, false));
+    root->Add(opacity_layer);
+  };
+
+  PumpOneFrame(shell.get(), 100, 100, builder);
+  end_frame_latch.Wait();
+  ASSERT_EQ(end_frame_count, 1);
+
+  // The frame is drawn again without the UI thread building a layer tree.
+  shell->UpdateRetainedLayer(opacity_layer->original_layer_id(),
+                             {.alpha = 0x40});
+  end_frame_latch.Wait();
+  EXPECT_EQ(end_frame_count, 2);
+  EXPECT_EQ(opacity_layer->opacity(), 0x40 * 1.0f / SK_AlphaOPAQUE);
+
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, PushBackdropFilterToVisitedPlatformViews) {
 #if defined(OS_FUCHSIA)
   GTEST_SKIP() << "RasterThreadMerger flakes on Fuchsia. "
@@ -2422,6 +2513,30 @@ TEST_F(ShellTest, RasterizerMakeRasterSnapshot) {
   DestroyShell(std::move(shell), task_runners);
 }
 
+TEST_F(ShellTest, MakeRasterSnapshotsRendersEveryJobWithoutAView) {
+  Settings settings = CreateSettingsForFixture();
+  auto task_runner = CreateNewThread();
+  TaskRunners task_runners("test", task_runner, task_runner, task_runner,
+                           task_runner);
+  std::unique_ptr<Shell> shell = CreateShell(settings, task_runners);
+  ASSERT_TRUE(ValidateShell(shell.get()));
+
+  // The jobs of the same size share a render target with Skia.
+  std::vector<RasterSnapshotJob> jobs = {
+      {MakeSizedDisplayList(50, 50), SkISize::Make(50, 50)},
+      {MakeSizedDisplayList(20, 30), SkISize::Make(20, 30)},
+      {MakeSizedDisplayList(50, 50), SkISize::Make(50, 50)},
+  };
+  std::vector<sk_sp<DlImage>> images = shell->MakeRasterSnapshots(jobs);
+
+  ASSERT_EQ(images.size(), jobs.size());
+  for (size_t i = 0; i < jobs.size(); i++) {
+    ASSERT_NE(images[i], nullptr);
+    EXPECT_EQ(images[i]->dimensions(), jobs[i].size);
+  }
+  DestroyShell(std::move(shell), task_runners);
+}
+
 TEST_F(ShellTest, OnServiceProtocolEstimateRasterCacheMemoryWorks) {
   Settings settings = CreateSettingsForFixture();
   std::unique_ptr<Shell> shell = CreateShell(settings);
@@ -2528,6 +2643,107 @@ TEST_F(ShellTest, OnServiceProtocolEstimateRasterCacheMemoryWorks) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, OnServiceProtocolGetEngineMemoryUsageWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  // Nothing has been rendered yet, so no memory is attributed to the engine.
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(
+      shell.get(), ServiceProtocolEnum::kGetEngineMemoryUsage,
+      shell->GetTaskRunners().GetRasterTaskRunner(), empty_params, &document);
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  document.Accept(writer);
+  std::string expected_json =
+      "{\"type\":\"EngineMemoryUsage\",\"rasterCacheLayerBytes\":0,"
+      "\"rasterCachePictureBytes\":0,\"displayListBytes\":0,"
+      "\"skiaResourceCacheBytes\":0,\"impellerBufferBytes\":0,"
+      "\"impellerTextureBytes\":0}";
+  std::string actual_json = buffer.GetString();
+  ASSERT_EQ(actual_json, expected_json);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolSampleLayerCostsRejectsBadFrameCounts) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  auto sample_layer_costs = [&shell](std::string_view frame_count) {
+    ServiceProtocol::Handler::ServiceProtocolMap params;
+    params["frameCount"] = frame_count;
+    rapidjson::Document document;
+    OnServiceProtocol(shell.get(), ServiceProtocolEnum::kSampleLayerCosts,
+                      shell->GetTaskRunners().GetRasterTaskRunner(), params,
+                      &document);
+    return document;
+  };
+
+  for (std::string_view frame_count :
+       {"", "-1", " 1", "1 ", "+1", "1x", "1001", "18446744073709551617"}) {
+    rapidjson::Document document = sample_layer_costs(frame_count);
+    ASSERT_TRUE(document.HasMember("code")) << frame_count;
+    EXPECT_EQ(document["code"].GetInt64(), -32602) << frame_count;
+  }
+
+  for (std::string_view frame_count : {"0", "1000"}) {
+    rapidjson::Document document = sample_layer_costs(frame_count);
+    ASSERT_TRUE(document.HasMember("type")) << frame_count;
+    EXPECT_STREQ(document["type"].GetString(), "LayerCosts");
+    EXPECT_EQ(document["requestedFrames"].GetUint64(),
+              std::stoull(std::string(frame_count)));
+  }
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetAllocationCountsWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(
+      shell.get(), ServiceProtocolEnum::kGetAllocationCounts,
+      shell->GetTaskRunners().GetRasterTaskRunner(), empty_params, &document);
+
+  ASSERT_TRUE(document.IsObject());
+  EXPECT_STREQ(document["type"].GetString(), "AllocationCounts");
+  const auto& counts = document["counts"];
+  for (size_t i = 0; i < fml::kAllocationTagCount; i++) {
+    const char* name =
+        fml::GetAllocationTagName(static_cast<fml::AllocationTag>(i));
+    ASSERT_TRUE(counts.HasMember(name)) << name;
+    EXPECT_TRUE(counts[name]["allocations"].IsUint64());
+    EXPECT_TRUE(counts[name]["bytes"].IsUint64());
+  }
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetJankTraceWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  // No frame has janked yet.
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetJankTrace,
+                    shell->GetTaskRunners().GetIOTaskRunner(), empty_params,
+                    &document);
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  document.Accept(writer);
+  std::string expected_json =
+      "{\"type\":\"JankTrace\",\"hasTrace\":false,\"frameNumber\":-1,"
+      "\"trace\":\"\"}";
+  ASSERT_EQ(buffer.GetString(), expected_json);
+
+  DestroyShell(std::move(shell));
+}
+
 // ktz
 TEST_F(ShellTest, OnServiceProtocolRenderFrameWithRasterStatsWorks) {
   auto settings = CreateSettingsForFixture();
@@ -26,4 +26,14 @@ std::unique_ptr<SnapshotController> SnapshotController::Make(
 SnapshotController::SnapshotController(const Delegate& delegate)
     : delegate_(delegate) {}
 
+std::vector<sk_sp<DlImage>> SnapshotController::MakeRasterSnapshots(
+    const std::vector<RasterSnapshotJob>& jobs) {
+  std::vector<sk_sp<DlImage>> images;
+  images.reserve(jobs.size());
+  for (const auto& job : jobs) {
+    images.push_back(MakeRasterSnapshot(job.display_list, job.size));
+  }
+  return images;
+}
+
 }  // namespace flutter
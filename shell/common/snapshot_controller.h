@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_COMMON_SNAPSHOT_CONTROLLER_H_
 #define FLUTTER_SHELL_COMMON_SNAPSHOT_CONTROLLER_H_
 
+#include <vector>
+
 #include "flutter/common/settings.h"
 #include "flutter/display_list/image/dl_image.h"
 #include "flutter/flow/surface.h"
@@ -18,6 +20,12 @@ class AiksContext;
 
 namespace flutter {
 
+/// A display list to rasterize into an image of |size|.
+struct RasterSnapshotJob {
+  sk_sp<DisplayList> display_list;
+  SkISize size;
+};
+
 class SnapshotController {
  public:
   class Delegate {
@@ -42,6 +50,13 @@ class SnapshotController {
   virtual sk_sp<DlImage> MakeRasterSnapshot(sk_sp<DisplayList> display_list,
                                             SkISize size) = 0;
 
+  // Makes the snapshots of |jobs| in order, with a null image for each job
+  // that failed. Implementations may share resources between the snapshots
+  // of a batch, which makes this cheaper than a |MakeRasterSnapshot| call
+  // per job.
+  virtual std::vector<sk_sp<DlImage>> MakeRasterSnapshots(
+      const std::vector<RasterSnapshotJob>& jobs);
+
   virtual sk_sp<SkImage> ConvertToRasterImage(sk_sp<SkImage> image) = 0;
 
  protected:
@@ -109,10 +109,7 @@ sk_sp<DlImage> SnapshotControllerSkia::DoMakeRasterSnapshot(
               // When there is an on screen surface, we need a render target
               // SkSurface because we want to access texture backed images.
               sk_sp<SkSurface> sk_surface =
-                  SkSurfaces::RenderTarget(context,               // context
-                                           skgpu::Budgeted::kNo,  // budgeted
-                                           image_info             // image info
-                  );
+                  AcquireRenderTarget(context, image_info);
               if (!sk_surface) {
                 FML_LOG(ERROR)
                     << "DoMakeRasterSnapshot can not create GPU render target";
@@ -129,6 +126,35 @@ sk_sp<DlImage> SnapshotControllerSkia::DoMakeRasterSnapshot(
   return DlImage::Make(result);
 }
 
+sk_sp<SkSurface> SnapshotControllerSkia::AcquireRenderTarget(
+    GrRecordingContext* context,
+    const SkImageInfo& image_info) {
+  if (reuse_render_targets_) {
+    // A snapshot is read back before the next one is drawn, so the render
+    // target only has to be cleared.
+    for (const auto& render_target : render_targets_) {
+      if (render_target->recordingContext() == context &&
+          render_target->imageInfo() == image_info) {
+        SkCanvas* canvas = render_target->getCanvas();
+        canvas->restoreToCount(1);
+        canvas->resetMatrix();
+        canvas->clear(SK_ColorTRANSPARENT);
+        return render_target;
+      }
+    }
+  }
+
+  sk_sp<SkSurface> render_target =
+      SkSurfaces::RenderTarget(context,               // context
+                               skgpu::Budgeted::kNo,  // budgeted
+                               image_info             // image info
+      );
+  if (render_target && reuse_render_targets_) {
+    render_targets_.push_back(render_target);
+  }
+  return render_target;
+}
+
 sk_sp<DlImage> SnapshotControllerSkia::MakeRasterSnapshot(
     sk_sp<DisplayList> display_list,
     SkISize size) {
@@ -137,6 +163,16 @@ sk_sp<DlImage> SnapshotControllerSkia::MakeRasterSnapshot(
   });
 }
 
+std::vector<sk_sp<DlImage>> SnapshotControllerSkia::MakeRasterSnapshots(
+    const std::vector<RasterSnapshotJob>& jobs) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  reuse_render_targets_ = true;
+  auto images = SnapshotController::MakeRasterSnapshots(jobs);
+  reuse_render_targets_ = false;
+  render_targets_.clear();
+  return images;
+}
+
 sk_sp<SkImage> SnapshotControllerSkia::ConvertToRasterImage(
     sk_sp<SkImage> image) {
   // If the rasterizer does not have a surface with a GrContext, then it will
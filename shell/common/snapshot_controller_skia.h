@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_COMMON_SNAPSHOT_CONTROLLER_SKIA_H_
 #define FLUTTER_SHELL_COMMON_SNAPSHOT_CONTROLLER_SKIA_H_
 
+#include <vector>
+
 #include "flutter/shell/common/snapshot_controller.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
@@ -18,13 +20,24 @@ class SnapshotControllerSkia : public SnapshotController {
   sk_sp<DlImage> MakeRasterSnapshot(sk_sp<DisplayList> display_list,
                                     SkISize size) override;
 
+  std::vector<sk_sp<DlImage>> MakeRasterSnapshots(
+      const std::vector<RasterSnapshotJob>& jobs) override;
+
   virtual sk_sp<SkImage> ConvertToRasterImage(sk_sp<SkImage> image) override;
 
  private:
+  // Whether the render targets of snapshots are kept for the next snapshots
+  // of the same batch.
+  bool reuse_render_targets_ = false;
+  std::vector<sk_sp<SkSurface>> render_targets_;
+
   sk_sp<DlImage> DoMakeRasterSnapshot(
       SkISize size,
       std::function<void(SkCanvas*)> draw_callback);
 
+  sk_sp<SkSurface> AcquireRenderTarget(GrRecordingContext* context,
+                                       const SkImageInfo& image_info);
+
   FML_DISALLOW_COPY_AND_ASSIGN(SnapshotControllerSkia);
 };
 
@@ -0,0 +1,116 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/startup_report.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+namespace flutter {
+
+StartupReport::ScopedStage::ScopedStage(const char* name,
+                                        StartupReport& report)
+    : name_(name), report_(report) {
+  if (report_.IsEnabled()) {
+    start_ = fml::TimePoint::Now();
+  }
+}
+
+StartupReport::ScopedStage::~ScopedStage() {
+  if (start_ != fml::TimePoint() && report_.IsEnabled()) {
+    report_.RecordStage(name_, start_, fml::TimePoint::Now());
+  }
+}
+
+StartupReport& StartupReport::GetForProcess() {
+  static StartupReport* report = new StartupReport();
+  return *report;
+}
+
+StartupReport::StartupReport() = default;
+
+StartupReport::~StartupReport() = default;
+
+void StartupReport::Enable() {
+  std::scoped_lock lock(mutex_);
+  if (origin_ != fml::TimePoint()) {
+    return;
+  }
+  origin_ = fml::TimePoint::Now();
+  enabled_.store(true, std::memory_order_release);
+}
+
+bool StartupReport::IsEnabled() const {
+  return enabled_.load(std::memory_order_acquire);
+}
+
+void StartupReport::RecordStage(std::string name,
+                                fml::TimePoint start,
+                                fml::TimePoint end) {
+  std::scoped_lock lock(mutex_);
+  if (!IsEnabled()) {
+    return;
+  }
+  stages_.push_back({std::move(name), start, end});
+}
+
+bool StartupReport::Finish(fml::TimePoint end) {
+  std::scoped_lock lock(mutex_);
+  if (!enabled_.exchange(false, std::memory_order_acq_rel)) {
+    return false;
+  }
+  end_ = end;
+  return true;
+}
+
+std::vector<StartupReport::Stage> StartupReport::GetStages() const {
+  std::vector<Stage> stages;
+  {
+    std::scoped_lock lock(mutex_);
+    stages = stages_;
+  }
+  std::stable_sort(stages.begin(), stages.end(),
+                   [](const Stage& a, const Stage& b) {
+                     return a.start < b.start;
+                   });
+  return stages;
+}
+
+std::string StartupReport::ToJSON() const {
+  fml::TimePoint origin;
+  fml::TimePoint end;
+  {
+    std::scoped_lock lock(mutex_);
+    origin = origin_;
+    end = end_;
+  }
+
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  writer.StartObject();
+  if (end != fml::TimePoint()) {
+    writer.Key("timeToFirstFrameMicros");
+    writer.Int64((end - origin).ToMicroseconds());
+  }
+  writer.Key("stages");
+  writer.StartArray();
+  for (const Stage& stage : GetStages()) {
+    writer.StartObject();
+    writer.Key("name");
+    writer.String(stage.name.c_str());
+    writer.Key("startMicros");
+    writer.Int64((stage.start - origin).ToMicroseconds());
+    writer.Key("durationMicros");
+    writer.Int64((stage.end - stage.start).ToMicroseconds());
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.EndObject();
+  return buffer.GetString();
+}
+
+}  // namespace flutter
@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_STARTUP_REPORT_H_
+#define FLUTTER_SHELL_COMMON_STARTUP_REPORT_H_
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+/// Records the wall time of the stages of startup, from the creation of the
+/// first shell in the process until its first frame is rasterized, so that
+/// regressions in the time to the first frame can be tracked.
+///
+/// Recording is disabled until |Enable| is called. Stages may be recorded
+/// from any thread, and stages recorded on different threads may overlap.
+class StartupReport {
+ public:
+  struct Stage {
+    std::string name;
+    fml::TimePoint start;
+    fml::TimePoint end;
+  };
+
+  /// Records the stage |name| from its construction to its destruction.
+  class ScopedStage {
+   public:
+    explicit ScopedStage(const char* name,
+                         StartupReport& report = GetForProcess());
+
+    ~ScopedStage();
+
+   private:
+    const char* name_;
+    StartupReport& report_;
+    fml::TimePoint start_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(ScopedStage);
+  };
+
+  static StartupReport& GetForProcess();
+
+  StartupReport();
+
+  ~StartupReport();
+
+  /// Starts recording. Stages are reported relative to the time of the first
+  /// call.
+  void Enable();
+
+  bool IsEnabled() const;
+
+  void RecordStage(std::string name, fml::TimePoint start, fml::TimePoint end);
+
+  /// Stops recording at |end|, the time of the first frame.
+  ///
+  /// @return Whether the report was recording. Only the first call returns
+  ///         true, so that only the first shell in the process writes the
+  ///         report.
+  bool Finish(fml::TimePoint end);
+
+  /// The recorded stages, in the order they started.
+  std::vector<Stage> GetStages() const;
+
+  /// Returns the report as a JSON object with the time to the first frame
+  /// and the start and duration of every stage, in microseconds since
+  /// |Enable| was first called.
+  std::string ToJSON() const;
+
+ private:
+  std::atomic<bool> enabled_ = false;
+  mutable std::mutex mutex_;
+  fml::TimePoint origin_;
+  fml::TimePoint end_;
+  std::vector<Stage> stages_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(StartupReport);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_STARTUP_REPORT_H_
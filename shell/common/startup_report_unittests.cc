@@ -0,0 +1,80 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/startup_report.h"
+
+#include "gtest/gtest.h"
+#include "rapidjson/document.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(StartupReportTest, DoesNotRecordUntilEnabled) {
+  StartupReport report;
+  { StartupReport::ScopedStage stage("Stage", report); }
+  const fml::TimePoint now = fml::TimePoint::Now();
+  report.RecordStage("RecordedStage", now, now);
+
+  EXPECT_FALSE(report.IsEnabled());
+  EXPECT_TRUE(report.GetStages().empty());
+  EXPECT_FALSE(report.Finish(now));
+}
+
+TEST(StartupReportTest, RecordsStagesInStartOrder) {
+  StartupReport report;
+  report.Enable();
+  const fml::TimePoint now = fml::TimePoint::Now();
+  report.RecordStage("Second", now + fml::TimeDelta::FromMilliseconds(2),
+                     now + fml::TimeDelta::FromMilliseconds(5));
+  report.RecordStage("First", now + fml::TimeDelta::FromMilliseconds(1),
+                     now + fml::TimeDelta::FromMilliseconds(3));
+  { StartupReport::ScopedStage stage("Scoped", report); }
+
+  const auto stages = report.GetStages();
+  ASSERT_EQ(stages.size(), 3u);
+  EXPECT_EQ(stages[0].name, "Scoped");
+  EXPECT_EQ(stages[1].name, "First");
+  EXPECT_EQ(stages[2].name, "Second");
+  EXPECT_EQ(stages[2].end - stages[2].start,
+            fml::TimeDelta::FromMilliseconds(3));
+}
+
+TEST(StartupReportTest, OnlyTheFirstFinishReports) {
+  StartupReport report;
+  report.Enable();
+  const fml::TimePoint now = fml::TimePoint::Now();
+
+  EXPECT_TRUE(report.Finish(now));
+  EXPECT_FALSE(report.IsEnabled());
+  EXPECT_FALSE(report.Finish(now));
+
+  // Enabling again does not restart the report.
+  report.Enable();
+  EXPECT_FALSE(report.IsEnabled());
+}
+
+TEST(StartupReportTest, SerializesToJSON) {
+  StartupReport report;
+  report.Enable();
+  const fml::TimePoint start = fml::TimePoint::Now();
+  report.RecordStage("DartVMInitialization", start,
+                     start + fml::TimeDelta::FromMicroseconds(1500));
+  ASSERT_TRUE(report.Finish(start + fml::TimeDelta::FromMilliseconds(20)));
+
+  rapidjson::Document document;
+  document.Parse(report.ToJSON());
+  ASSERT_FALSE(document.HasParseError());
+  ASSERT_TRUE(document.IsObject());
+  EXPECT_GE(document["timeToFirstFrameMicros"].GetInt64(), 20000);
+
+  const auto& stages = document["stages"];
+  ASSERT_TRUE(stages.IsArray());
+  ASSERT_EQ(stages.Size(), 1u);
+  EXPECT_STREQ(stages[0]["name"].GetString(), "DartVMInitialization");
+  EXPECT_GE(stages[0]["startMicros"].GetInt64(), 0);
+  EXPECT_EQ(stages[0]["durationMicros"].GetInt64(), 1500);
+}
+
+}  // namespace testing
+}  // namespace flutter
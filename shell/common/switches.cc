@@ -8,6 +8,7 @@
 #include <iterator>
 #include <sstream>
 #include <string>
+#include <utility>
 
 #include "flutter/fml/native_library.h"
 #include "flutter/fml/paths.h"
@@ -356,6 +357,30 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   command_line.GetOptionValue(FlagForSwitch(Switch::TraceToFile),
                               &settings.trace_to_file);
 
+  if (command_line.HasOption(FlagForSwitch(Switch::TraceRingBufferSize))) {
+    std::string trace_ring_buffer_size;
+    command_line.GetOptionValue(FlagForSwitch(Switch::TraceRingBufferSize),
+                                &trace_ring_buffer_size);
+    settings.trace_ring_buffer_size =
+        std::max(std::stoi(trace_ring_buffer_size), 0);
+  }
+
+  command_line.GetOptionValue(
+      FlagForSwitch(Switch::TraceRingBufferDumpDirectory),
+      &settings.trace_ring_buffer_dump_directory);
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::TraceRingBufferJankThreshold))) {
+    std::string jank_threshold;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::TraceRingBufferJankThreshold), &jank_threshold);
+    settings.trace_ring_buffer_jank_threshold =
+        std::max(std::stod(jank_threshold), 1.0);
+  }
+
+  command_line.GetOptionValue(FlagForSwitch(Switch::StartupReportDirectory),
+                              &settings.startup_report_directory);
+
   settings.skia_deterministic_rendering_on_cpu =
       command_line.HasOption(FlagForSwitch(Switch::SkiaDeterministicRendering));
 
@@ -413,9 +438,24 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
         {snapshot_asset_path, isolate_snapshot_instr_filename});
   }
 
+  command_line.GetOptionValue(FlagForSwitch(Switch::StartupPageProfile),
+                              &settings.startup_page_profile_path);
+
   command_line.GetOptionValue(FlagForSwitch(Switch::CacheDirPath),
                               &settings.temp_directory_path);
 
+  command_line.GetOptionValue(FlagForSwitch(Switch::ComplexityTablePath),
+                              &settings.complexity_table_path);
+
+  settings.enable_async_raster_cache =
+      command_line.HasOption(FlagForSwitch(Switch::EnableAsyncRasterCache));
+  settings.enable_raster_cache_atlas =
+      command_line.HasOption(FlagForSwitch(Switch::EnableRasterCacheAtlas));
+  settings.enable_concurrent_preroll =
+      command_line.HasOption(FlagForSwitch(Switch::EnableConcurrentPreroll));
+  settings.enable_backdrop_filter_cache =
+      command_line.HasOption(FlagForSwitch(Switch::EnableBackdropFilterCache));
+
   bool leak_vm = "true" == command_line.GetOptionValueWithDefault(
                                FlagForSwitch(Switch::LeakVM), "true");
   settings.leak_vm = leak_vm;
@@ -464,10 +504,77 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
     }
   }
 
+  command_line.GetOptionValue(
+      FlagForSwitch(Switch::ImpellerPipelineArchiveHarvestPath),
+      &settings.impeller_pipeline_archive_harvest_path);
+
+  settings.batch_canvas_commands =
+      command_line.HasOption(FlagForSwitch(Switch::BatchCanvasCommands));
+
   settings.enable_vulkan_validation =
       command_line.HasOption(FlagForSwitch(Switch::EnableVulkanValidation));
+
+  {
+    std::string vulkan_present_mode_value;
+    if (command_line.GetOptionValue(FlagForSwitch(Switch::VulkanPresentMode),
+                                    &vulkan_present_mode_value)) {
+      if (!vulkan_present_mode_value.empty()) {
+        settings.vulkan_present_mode = vulkan_present_mode_value;
+      }
+    }
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::VulkanSwapchainImageCount))) {
+    std::string image_count;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::VulkanSwapchainImageCount), &image_count);
+    settings.vulkan_swapchain_image_count = std::stoi(image_count);
+  }
   settings.enable_opengl_gpu_tracing =
       command_line.HasOption(FlagForSwitch(Switch::EnableOpenGLGPUTracing));
+  settings.async_platform_view_composition = command_line.HasOption(
+      FlagForSwitch(Switch::AsyncPlatformViewComposition));
+
+  if (command_line.HasOption(FlagForSwitch(Switch::FramePipelineDepth))) {
+    std::string pipeline_depth;
+    command_line.GetOptionValue(FlagForSwitch(Switch::FramePipelineDepth),
+                                &pipeline_depth);
+    settings.frame_pipeline_depth = std::max(std::stoi(pipeline_depth), 0);
+  }
+
+  settings.predictive_frame_scheduling =
+      command_line.HasOption(FlagForSwitch(Switch::PredictiveFrameScheduling));
+
+  settings.raster_overload_throttling =
+      command_line.HasOption(FlagForSwitch(Switch::RasterOverloadThrottling));
+
+  settings.coalesce_pointer_events =
+      command_line.HasOption(FlagForSwitch(Switch::CoalescePointerEvents));
+  settings.merge_coalesced_pointer_moves = command_line.HasOption(
+      FlagForSwitch(Switch::MergeCoalescedPointerMoves));
+
+  const std::pair<Switch, fml::ThreadSchedulingPolicy*> thread_policies[] = {
+      {Switch::PlatformThreadPolicy, &settings.platform_thread_policy},
+      {Switch::UIThreadPolicy, &settings.ui_thread_policy},
+      {Switch::RasterThreadPolicy, &settings.raster_thread_policy},
+      {Switch::IOThreadPolicy, &settings.io_thread_policy},
+      {Switch::WorkerThreadPolicy, &settings.worker_thread_policy},
+  };
+  for (const auto& [thread_switch, policy] : thread_policies) {
+    std::string policy_value;
+    if (!command_line.GetOptionValue(FlagForSwitch(thread_switch),
+                                     &policy_value)) {
+      continue;
+    }
+    auto parsed_policy = fml::ParseThreadSchedulingPolicy(policy_value);
+    if (parsed_policy.has_value()) {
+      *policy = std::move(parsed_policy.value());
+    } else {
+      FML_LOG(ERROR) << "Ignoring malformed --" << FlagForSwitch(thread_switch)
+                     << " value: " << policy_value;
+    }
+  }
 
   settings.enable_embedder_api =
       command_line.HasOption(FlagForSwitch(Switch::EnableEmbedderAPI));
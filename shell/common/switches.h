@@ -53,6 +53,11 @@ DEF_SWITCH(IsolateSnapshotInstructions,
            "isolate-snapshot-instr",
            "The isolate instructions snapshot that will be memory mapped as "
            "read and executable. SnapshotAssetPath must be present.")
+DEF_SWITCH(StartupPageProfile,
+           "startup-page-profile",
+           "Path to a profile of the snapshot ranges that the application "
+           "touches while starting. Those ranges are read ahead of their first "
+           "use to speed up cold starts.")
 DEF_SWITCH(CacheDirPath,
            "cache-dir-path",
            "Path to the cache directory. "
@@ -202,6 +207,28 @@ DEF_SWITCH(TraceToFile,
            "Write the timeline trace to a file at the specified path. The file "
            "will be in Perfetto's proto format; it will be possible to load "
            "the file into Perfetto's trace viewer.")
+DEF_SWITCH(TraceRingBufferSize,
+           "trace-ring-buffer-size",
+           "Record the most recent trace events of each thread into an "
+           "in-memory ring buffer of the specified number of events. Unlike "
+           "the timeline, this is cheap enough to leave enabled in release "
+           "builds.")
+DEF_SWITCH(TraceRingBufferDumpDirectory,
+           "trace-ring-buffer-dump-directory",
+           "Write the trace ring buffer to a file in the specified directory "
+           "whenever a frame misses its deadline. The files are in the JSON "
+           "trace event format and can be loaded into Perfetto's trace "
+           "viewer.")
+DEF_SWITCH(TraceRingBufferJankThreshold,
+           "trace-ring-buffer-jank-threshold",
+           "Snapshot the trace ring buffer when a frame takes longer than the "
+           "specified multiple of the frame budget. The default of 1 "
+           "snapshots every frame that misses its deadline.")
+DEF_SWITCH(StartupReportDirectory,
+           "startup-report-directory",
+           "Write a report of the wall time of every startup stage, and of "
+           "the time to the first frame, to startup_report.json in the "
+           "specified directory once the first frame is rasterized.")
 DEF_SWITCH(UseTestFonts,
            "use-test-fonts",
            "Running tests that layout and measure text will not yield "
@@ -270,15 +297,35 @@ DEF_SWITCH(ImpellerBackend,
            "impeller-backend",
            "Requests a particular Impeller backend on platforms that support "
            "multiple backends. (ex `opengles` or `vulkan`)")
+DEF_SWITCH(ImpellerPipelineArchiveHarvestPath,
+           "impeller-pipeline-archive-harvest-path",
+           "Records the pipelines Impeller creates on Metal to a binary archive "
+           "at this path. The archive can then be shipped with the assets of "
+           "the application to skip compiling those pipelines.")
 DEF_SWITCH(EnableVulkanValidation,
            "enable-vulkan-validation",
            "Enable loading Vulkan validation layers. The layers must be "
            "available to the application and loadable. On non-Vulkan backends, "
            "this flag does nothing.")
+DEF_SWITCH(VulkanPresentMode,
+           "vulkan-present-mode",
+           "Requests a presentation mode for Vulkan swapchains (ex `fifo`, "
+           "`fifo-relaxed`, `mailbox` or `immediate`). Modes the surface does "
+           "not support fall back to `fifo`.")
+DEF_SWITCH(VulkanSwapchainImageCount,
+           "vulkan-swapchain-image-count",
+           "The number of images to request for Vulkan swapchains. Clamped to "
+           "the limits of the surface.")
 DEF_SWITCH(EnableOpenGLGPUTracing,
            "enable-opengl-gpu-tracing",
            "Enable tracing of GPU execution time when using the Impeller "
            "OpenGLES backend.")
+DEF_SWITCH(AsyncPlatformViewComposition,
+           "async-platform-view-composition",
+           "Keep rasterizing on the raster thread when platform views are "
+           "displayed, instead of merging the raster thread into the platform "
+           "thread. Only the arrangement of the platform views and their "
+           "overlays is done on the platform thread. Android only.")
 DEF_SWITCH(LeakVM,
            "leak-vm",
            "When the last shell shuts down, the shared VM is leaked by default "
@@ -291,9 +338,92 @@ DEF_SWITCH(
     "Setting this value to 0 or 1 disables MSAA. If it is not 0 or 1, it must "
     "be one of 2, 4, 8, or 16. However, if the GPU does not support the "
     "requested sampling value, MSAA will be disabled.")
+DEF_SWITCH(ComplexityTablePath,
+           "complexity-table-path",
+           "Path to a DisplayList complexity table measured on this device by "
+           "display_list_complexity_calibration. When set, the table decides "
+           "which DisplayLists are worth caching on every GPU backend.")
+DEF_SWITCH(EnableAsyncRasterCache,
+           "enable-async-raster-cache",
+           "Rasterize new raster cache entries for DisplayLists on the IO "
+           "thread instead of during the frame. The frame that first caches a "
+           "DisplayList draws it uncached, the cached image is used from the "
+           "next frame on.")
+DEF_SWITCH(EnableRasterCacheAtlas,
+           "enable-raster-cache-atlas",
+           "Pack small raster cache images into shared atlas pages so that "
+           "they can be drawn with fewer texture binds.")
+DEF_SWITCH(EnableConcurrentPreroll,
+           "enable-concurrent-preroll",
+           "Measure the complexity of the DisplayLists of wide layer subtrees "
+           "on the concurrent worker threads during Preroll instead of on the "
+           "raster thread.")
+DEF_SWITCH(EnableBackdropFilterCache,
+           "enable-backdrop-filter-cache",
+           "Reuse the filtered backdrop of a BackdropFilter from the previous "
+           "frame while the content behind it is unchanged. Only supported "
+           "by the Skia backend on surfaces that support partial repaint.")
+DEF_SWITCH(FramePipelineDepth,
+           "frame-pipeline-depth",
+           "The number of frames the UI thread may produce ahead of the raster "
+           "thread. Deeper pipelines keep the raster thread busy when "
+           "producing frames is cheaper than rasterizing them, at the cost of "
+           "latency. Defaults to 1 or 2 depending on the platform.")
+DEF_SWITCH(PredictiveFrameScheduling,
+           "predictive-frame-scheduling",
+           "Pick when to start building each frame from the build and raster "
+           "durations of recent frames instead of always starting at vsync. "
+           "Frames are delayed when there is slack in the frame interval for "
+           "lower latency, and target a later vsync when rasterization is the "
+           "bottleneck.")
+DEF_SWITCH(RasterOverloadThrottling,
+           "raster-overload-throttling",
+           "Halve the frame rate and only rasterize the most recent frame "
+           "while rasterization is continuously slower than the frame "
+           "budget, for example because the GPU is thermally throttled. The "
+           "frame rate recovers once frames rasterize within the budget "
+           "again.")
+DEF_SWITCH(CoalescePointerEvents,
+           "coalesce-pointer-events",
+           "Batch the pointer events received while a previous batch is "
+           "being handled and dispatch them to the framework once per vsync. "
+           "Events other than moves are still dispatched right away.")
+DEF_SWITCH(MergeCoalescedPointerMoves,
+           "merge-coalesced-pointer-moves",
+           "With `--coalesce-pointer-events`, also merge the consecutive "
+           "moves of each pointer in a batch into the latest one, with their "
+           "deltas summed.")
+DEF_SWITCH(PlatformThreadPolicy,
+           "platform-thread-policy",
+           "OS scheduling settings for the platform thread as comma separated "
+           "`key=value` pairs (ex `nice=-10,affinity=performance`). The keys "
+           "are `affinity`, `cpus` (a hex CPU mask), `nice`, `fifo` (the "
+           "SCHED_FIFO priority), `qos` (the Darwin QoS class) and `mmcss` "
+           "(the Windows MMCSS task). Unsupported keys are ignored.")
+DEF_SWITCH(UIThreadPolicy,
+           "ui-thread-policy",
+           "OS scheduling settings for the UI thread, in the format of "
+           "`--platform-thread-policy`.")
+DEF_SWITCH(RasterThreadPolicy,
+           "raster-thread-policy",
+           "OS scheduling settings for the raster thread, in the format of "
+           "`--platform-thread-policy`.")
+DEF_SWITCH(IOThreadPolicy,
+           "io-thread-policy",
+           "OS scheduling settings for the IO thread, in the format of "
+           "`--platform-thread-policy`.")
+DEF_SWITCH(WorkerThreadPolicy,
+           "worker-thread-policy",
+           "OS scheduling settings for the concurrent worker threads, in the "
+           "format of `--platform-thread-policy`.")
 DEF_SWITCH(EnableEmbedderAPI,
            "enable-embedder-api",
            "Enable the embedder api. Defaults to false. iOS only.")
+DEF_SWITCH(BatchCanvasCommands,
+           "batch-canvas-commands",
+           "Record the common Canvas commands into a buffer in Dart and send "
+           "them to the engine in batches, rather than making a native call "
+           "for every command.")
 DEF_SWITCHES_END
 
 void PrintUsage(const std::string& executable_name);
@@ -123,6 +123,169 @@ TEST(SwitchesTest, NoEnableImpeller) {
   }
 }
 
+TEST(SwitchesTest, TraceRingBuffer) {
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--trace-ring-buffer-size=8192",
+         "--trace-ring-buffer-dump-directory=/tmp/traces"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.trace_ring_buffer_size, 8192u);
+    EXPECT_EQ(settings.trace_ring_buffer_dump_directory, "/tmp/traces");
+  }
+  {
+    // default
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.trace_ring_buffer_size, 0u);
+    EXPECT_TRUE(settings.trace_ring_buffer_dump_directory.empty());
+  }
+}
+
+TEST(SwitchesTest, StartupReportDirectory) {
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--startup-report-directory=/tmp/startup"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.startup_report_directory, "/tmp/startup");
+  }
+  {
+    // default
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_TRUE(settings.startup_report_directory.empty());
+  }
+}
+
+TEST(SwitchesTest, PredictiveFrameScheduling) {
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--predictive-frame-scheduling"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_TRUE(settings.predictive_frame_scheduling);
+  }
+  {
+    // default
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_FALSE(settings.predictive_frame_scheduling);
+  }
+}
+
+TEST(SwitchesTest, TraceRingBufferJankThreshold) {
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--trace-ring-buffer-jank-threshold=2.5"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.trace_ring_buffer_jank_threshold, 2.5);
+  }
+  {
+    // Frames within their budget are never janky.
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--trace-ring-buffer-jank-threshold=0.5"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.trace_ring_buffer_jank_threshold, 1.0);
+  }
+  {
+    // default
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.trace_ring_buffer_jank_threshold, 1.0);
+  }
+}
+
+TEST(SwitchesTest, RasterOverloadThrottling) {
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--raster-overload-throttling"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_TRUE(settings.raster_overload_throttling);
+  }
+  {
+    // default
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_FALSE(settings.raster_overload_throttling);
+  }
+}
+
+TEST(SwitchesTest, FramePipelineDepth) {
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--frame-pipeline-depth=3"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.frame_pipeline_depth, 3u);
+  }
+  {
+    // default
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.frame_pipeline_depth, 0u);
+  }
+}
+
+TEST(SwitchesTest, ThreadPolicies) {
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--ui-thread-policy=nice=-10,affinity=performance",
+         "--worker-thread-policy=qos=utility"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.ui_thread_policy.nice, -10);
+    EXPECT_EQ(settings.ui_thread_policy.affinity,
+              fml::CpuAffinity::kPerformance);
+    EXPECT_EQ(settings.worker_thread_policy.qos_class,
+              fml::ThreadQoSClass::kUtility);
+    EXPECT_TRUE(settings.platform_thread_policy.IsEmpty());
+    EXPECT_TRUE(settings.raster_thread_policy.IsEmpty());
+    EXPECT_TRUE(settings.io_thread_policy.IsEmpty());
+  }
+  {
+    // malformed
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--raster-thread-policy=fifo=high"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_TRUE(settings.raster_thread_policy.IsEmpty());
+  }
+}
+
+TEST(SwitchesTest, ImpellerPipelineArchiveHarvestPath) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--impeller-pipeline-archive-harvest-path=/tmp/a.bin"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.impeller_pipeline_archive_harvest_path, "/tmp/a.bin");
+
+  Settings default_settings = SettingsFromCommandLine(
+      fml::CommandLineFromInitializerList({"command"}));
+  EXPECT_TRUE(default_settings.impeller_pipeline_archive_harvest_path.empty());
+}
+
+TEST(SwitchesTest, BatchCanvasCommands) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--batch-canvas-commands"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.batch_canvas_commands);
+
+  Settings default_settings = SettingsFromCommandLine(
+      fml::CommandLineFromInitializerList({"command"}));
+  EXPECT_FALSE(default_settings.batch_canvas_commands);
+}
+
+TEST(SwitchesTest, AsyncPlatformViewComposition) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--async-platform-view-composition"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.async_platform_view_composition);
+
+  Settings default_settings = SettingsFromCommandLine(
+      fml::CommandLineFromInitializerList({"command"}));
+  EXPECT_FALSE(default_settings.async_platform_view_composition);
+}
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -84,6 +84,34 @@ void VsyncWaiter::ScheduleSecondaryCallback(uintptr_t id,
   AwaitVSyncForSecondaryCallback();
 }
 
+void VsyncWaiter::SetFrameRateRange(const FrameRateRange& range) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+
+  {
+    std::scoped_lock lock(callback_mutex_);
+    frame_rate_range_ = range;
+  }
+  FML_TRACE_COUNTER("flutter", "PreferredFrameRate",
+                    reinterpret_cast<int64_t>(this),  //
+                    "FramesPerSecond", range.preferred);
+  OnFrameRateRangeChanged(range);
+}
+
+bool VsyncWaiter::ShouldSkipVsync(fml::TimePoint frame_start_time,
+                                  fml::TimePoint frame_target_time) const {
+  if (frame_rate_range_.preferred <= 0 ||
+      last_frame_start_time_ == fml::TimePoint()) {
+    return false;
+  }
+  // Vsyncs are fired up to half a vsync interval before the preferred frame
+  // interval elapsed, as the vsync after that would be late.
+  const fml::TimeDelta frame_interval =
+      fml::TimeDelta::FromSecondsF(1.0 / frame_rate_range_.preferred);
+  const fml::TimeDelta vsync_interval = frame_target_time - frame_start_time;
+  return frame_start_time - last_frame_start_time_ + vsync_interval / 2 <
+         frame_interval;
+}
+
 void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
                                fml::TimePoint frame_target_time,
                                bool pause_secondary_tasks) {
@@ -91,14 +119,29 @@ void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
 
   Callback callback;
   std::vector<fml::closure> secondary_callbacks;
+  bool skip_vsync = false;
 
   {
     std::scoped_lock lock(callback_mutex_);
-    callback = std::move(callback_);
-    for (auto& pair : secondary_callbacks_) {
-      secondary_callbacks.push_back(std::move(pair.second));
+    if (callback_ && ShouldSkipVsync(frame_start_time, frame_target_time)) {
+      skip_vsync = true;
+    } else {
+      if (callback_) {
+        last_frame_start_time_ = frame_start_time;
+      }
+      callback = std::move(callback_);
+      for (auto& pair : secondary_callbacks_) {
+        secondary_callbacks.push_back(std::move(pair.second));
+      }
+      secondary_callbacks_.clear();
     }
-    secondary_callbacks_.clear();
+  }
+
+  if (skip_vsync) {
+    // Keep the callbacks for the next vsync.
+    TRACE_EVENT_INSTANT0("flutter", "SkippedVsyncForPreferredFrameRate");
+    AwaitVSync();
+    return;
   }
 
   if (!callback && secondary_callbacks.empty()) {
@@ -25,6 +25,16 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
  public:
   using Callback = std::function<void(std::unique_ptr<FrameTimingsRecorder>)>;
 
+  /// The range of frame rates, in frames per second, that the content on
+  /// screen runs well at. A |preferred| rate of zero means that the content
+  /// has no preference, and frames are produced at the refresh rate of the
+  /// display.
+  struct FrameRateRange {
+    double minimum = 0;
+    double maximum = 0;
+    double preferred = 0;
+  };
+
   virtual ~VsyncWaiter();
 
   void AsyncWaitForVsync(const Callback& callback);
@@ -35,6 +45,16 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
   /// |Animator::ScheduleMaybeClearTraceFlowIds|.
   void ScheduleSecondaryCallback(uintptr_t id, const fml::closure& callback);
 
+  /// Requests that frames are produced at a rate within |range|, for example
+  /// so that ambient animations run at a fraction of the refresh rate of a
+  /// high refresh rate display to save power.
+  ///
+  /// Frames are paced to the preferred rate by skipping vsyncs that arrive
+  /// too early. Implementations that can lower the rate of the display
+  /// itself apply the range in |OnFrameRateRangeChanged|, after which no
+  /// vsyncs need to be skipped.
+  void SetFrameRateRange(const FrameRateRange& range);
+
  protected:
   // On some backends, the |FireCallback| needs to be made from a static C
   // method.
@@ -68,6 +88,10 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
   // as AwaitVSync().
   virtual void AwaitVSyncForSecondaryCallback() { AwaitVSync(); }
 
+  // Invoked on the UI thread when the frame rate range requested by the
+  // content on screen changes. The default implementation does nothing.
+  virtual void OnFrameRateRangeChanged(const FrameRateRange& range) {}
+
   // Schedules the callback on the UI task runner. Needs to be invoked as close
   // to the `frame_start_time` as possible.
   void FireCallback(fml::TimePoint frame_start_time,
@@ -78,6 +102,13 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
   std::mutex callback_mutex_;
   Callback callback_;
   std::unordered_map<uintptr_t, fml::closure> secondary_callbacks_;
+  FrameRateRange frame_rate_range_;
+  fml::TimePoint last_frame_start_time_;
+
+  // Whether the vsync at |frame_start_time| arrives too early for the
+  // preferred frame rate. Must be called with |callback_mutex_| held.
+  bool ShouldSkipVsync(fml::TimePoint frame_start_time,
+                       fml::TimePoint frame_target_time) const;
 
   void PauseDartMicroTasks();
   static void ResumeDartMicroTasks(fml::TaskQueueId ui_task_queue_id);
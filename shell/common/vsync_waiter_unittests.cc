@@ -4,6 +4,7 @@
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/fml/message_loop.h"
 #include "flutter/shell/common/switches.h"
 
 #include "gtest/gtest.h"
@@ -20,6 +21,12 @@ class TestVsyncWaiter : public VsyncWaiter {
 
   int await_vsync_call_count_ = 0;
 
+  void FireVsync(fml::TimePoint frame_start_time,
+                 fml::TimePoint frame_target_time) {
+    FireCallback(frame_start_time, frame_target_time,
+                 /*pause_secondary_tasks=*/false);
+  }
+
  protected:
   void AwaitVSync() override { await_vsync_call_count_++; }
 };
@@ -43,5 +50,68 @@ TEST(VsyncWaiterTest, NoUnneededAwaitVsync) {
   EXPECT_EQ(vsync_waiter.await_vsync_call_count_, 1);
 }
 
+namespace {
+
+// Fires |vsync_count| vsyncs of a 120Hz display from |vsync_time| on,
+// requesting a frame before each, and returns how many of them produced a
+// frame.
+int CountFramesAt120Hz(TestVsyncWaiter& vsync_waiter,
+                       fml::TimePoint& vsync_time,
+                       int vsync_count) {
+  const fml::TimeDelta vsync_interval = fml::TimeDelta::FromMicroseconds(8333);
+  int frame_count = 0;
+  for (int i = 0; i < vsync_count; i++) {
+    vsync_waiter.AsyncWaitForVsync(
+        [&frame_count](std::unique_ptr<FrameTimingsRecorder> recorder) {
+          frame_count++;
+        });
+    vsync_waiter.FireVsync(vsync_time, vsync_time + vsync_interval);
+    fml::MessageLoop::GetCurrent().RunExpiredTasksNow();
+    vsync_time = vsync_time + vsync_interval;
+  }
+  return frame_count;
+}
+
+}  // namespace
+
+TEST(VsyncWaiterTest, PacesFramesToPreferredFrameRate) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  auto task_runner = fml::MessageLoop::GetCurrent().GetTaskRunner();
+
+  const flutter::TaskRunners task_runners("vsync_waiter_test", task_runner,
+                                          task_runner, task_runner,
+                                          task_runner);
+
+  TestVsyncWaiter vsync_waiter(task_runners);
+  fml::TimePoint vsync_time =
+      fml::TimePoint::Now() - fml::TimeDelta::FromSeconds(1);
+  EXPECT_EQ(CountFramesAt120Hz(vsync_waiter, vsync_time, 8), 8);
+  EXPECT_EQ(vsync_waiter.await_vsync_call_count_, 8);
+
+  vsync_waiter.SetFrameRateRange({24, 60, 30});
+  // Every fourth vsync produces a frame. The skipped vsyncs wait for the next
+  // vsync without producing a frame.
+  EXPECT_EQ(CountFramesAt120Hz(vsync_waiter, vsync_time, 8), 2);
+  EXPECT_EQ(vsync_waiter.await_vsync_call_count_, 16);
+
+  vsync_waiter.SetFrameRateRange({});
+  EXPECT_EQ(CountFramesAt120Hz(vsync_waiter, vsync_time, 8), 8);
+}
+
+TEST(VsyncWaiterTest, DoesNotPaceAboveTheRefreshRate) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  auto task_runner = fml::MessageLoop::GetCurrent().GetTaskRunner();
+
+  const flutter::TaskRunners task_runners("vsync_waiter_test", task_runner,
+                                          task_runner, task_runner,
+                                          task_runner);
+
+  TestVsyncWaiter vsync_waiter(task_runners);
+  fml::TimePoint vsync_time =
+      fml::TimePoint::Now() - fml::TimeDelta::FromSeconds(1);
+  vsync_waiter.SetFrameRateRange({60, 240, 240});
+  EXPECT_EQ(CountFramesAt120Hz(vsync_waiter, vsync_time, 8), 8);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -8,6 +8,7 @@
 #include <optional>
 
 #include "flutter/common/graphics/gl_context_switch.h"
+#include "flutter/display_list/geometry/dl_region.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkMatrix.h"
@@ -46,6 +47,11 @@ struct GLPresentInfo {
   // The buffer damage refers to the region that needs to be set as damaged
   // within the frame buffer.
   const std::optional<SkIRect>& buffer_damage;
+
+  // The frame and buffer damage as separate rects, for targets that present
+  // more than one damage rect, see |FramebufferInfo::max_damage_rect_count|.
+  std::optional<DlRegion> frame_damage_region = std::nullopt;
+  std::optional<DlRegion> buffer_damage_region = std::nullopt;
 };
 
 class GPUSurfaceGLDelegate {
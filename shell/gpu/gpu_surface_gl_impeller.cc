@@ -5,6 +5,7 @@
 #include "flutter/shell/gpu/gpu_surface_gl_impeller.h"
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/shell/gpu/gpu_surface_shared_aiks_context.h"
 #include "impeller/display_list/dl_dispatcher.h"
 #include "impeller/renderer/backend/gles/surface_gles.h"
 #include "impeller/renderer/renderer.h"
@@ -29,8 +30,8 @@ GPUSurfaceGLImpeller::GPUSurfaceGLImpeller(
     return;
   }
 
-  auto aiks_context = std::make_shared<impeller::AiksContext>(
-      context, impeller::TypographerContextSkia::Make());
+  auto aiks_context = GetSharedAiksContext(
+      context, [] { return impeller::TypographerContextSkia::Make(); });
 
   if (!aiks_context->IsValid()) {
     return;
@@ -71,6 +71,9 @@ class IMPELLER_CA_METAL_LAYER_AVAILABLE GPUSurfaceMetalImpeller
   // |Surface|
   bool AllowsDrawingWhenGpuDisabled() const override;
 
+  // |Surface|
+  bool AllowsSkippingUnchangedFrames() const override;
+
   // |Surface|
   bool EnableRasterCache() const override;
 
@@ -11,7 +11,9 @@
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/shell/gpu/gpu_surface_shared_aiks_context.h"
 #include "impeller/display_list/dl_dispatcher.h"
+#include "impeller/renderer/backend/metal/context_mtl.h"
 #include "impeller/renderer/backend/metal/surface_mtl.h"
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 
@@ -29,15 +31,39 @@ static std::shared_ptr<impeller::Renderer> CreateImpellerRenderer(
   return renderer;
 }
 
+static std::shared_ptr<impeller::TypographerContext> CreateTypographerContext(
+    const std::shared_ptr<impeller::Context>& context) {
+  // Rasterize glyphs for large atlas updates on the context's workers.
+  return impeller::TypographerContextSkia::Make(
+      context ? impeller::ContextMTL::Cast(*context).GetWorkerTaskRunner() : nullptr);
+}
+
+// Rasterizes the glyphs recorded into the display list on the context's workers
+// while the display list is dispatched, rather than when text is first drawn.
+static void PrepareGlyphAtlases(const impeller::AiksContext& aiks_context,
+                                const DisplayList& display_list) {
+  const auto& text_frames = display_list.text_frames();
+  if (text_frames.empty()) {
+    return;
+  }
+  std::vector<std::pair<std::shared_ptr<impeller::TextFrame>, impeller::Scalar>> frames;
+  frames.reserve(text_frames.size());
+  for (const DlTextFrameUsage& usage : text_frames) {
+    frames.emplace_back(usage.text_frame, usage.scale);
+  }
+  auto context = aiks_context.GetContext();
+  aiks_context.GetContentContext().GetLazyGlyphAtlas()->PrepareTextFrames(
+      context, std::move(frames), impeller::ContextMTL::Cast(*context).GetWorkerTaskRunner());
+}
+
 GPUSurfaceMetalImpeller::GPUSurfaceMetalImpeller(GPUSurfaceMetalDelegate* delegate,
                                                  const std::shared_ptr<impeller::Context>& context,
                                                  bool render_to_surface)
     : delegate_(delegate),
       render_target_type_(delegate->GetRenderTargetType()),
       impeller_renderer_(CreateImpellerRenderer(context)),
-      aiks_context_(
-          std::make_shared<impeller::AiksContext>(impeller_renderer_ ? context : nullptr,
-                                                  impeller::TypographerContextSkia::Make())),
+      aiks_context_(GetSharedAiksContext(impeller_renderer_ ? context : nullptr,
+                                         [&context] { return CreateTypographerContext(context); })),
       render_to_surface_(render_to_surface) {
   // If this preference is explicitly set, we allow for disabling partial repaint.
   NSNumber* disablePartialRepaint =
@@ -123,6 +149,7 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrameFromCAMetalLa
           FML_LOG(ERROR) << "Could not build display list for surface frame.";
           return false;
         }
+        PrepareGlyphAtlases(*aiks_context, *display_list);
 
         if (!disable_partial_repaint_) {
           uintptr_t texture = reinterpret_cast<uintptr_t>(last_texture);
@@ -221,6 +248,7 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrameFromMTLTextur
           FML_LOG(ERROR) << "Could not build display list for surface frame.";
           return false;
         }
+        PrepareGlyphAtlases(*aiks_context, *display_list);
 
         if (!disable_partial_repaint_) {
           uintptr_t texture_ptr = reinterpret_cast<uintptr_t>(mtl_texture);
@@ -316,6 +344,12 @@ bool GPUSurfaceMetalImpeller::AllowsDrawingWhenGpuDisabled() const {
   return delegate_->AllowsDrawingWhenGpuDisabled();
 }
 
+// |Surface|
+bool GPUSurfaceMetalImpeller::AllowsSkippingUnchangedFrames() const {
+  // See |GPUSurfaceMetalSkia::AllowsSkippingUnchangedFrames|.
+  return render_target_type_ == MTLRenderTargetType::kCAMetalLayer;
+}
+
 // |Surface|
 bool GPUSurfaceMetalImpeller::EnableRasterCache() const {
   return false;
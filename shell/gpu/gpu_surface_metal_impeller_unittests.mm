@@ -5,7 +5,10 @@
 #include <Foundation/Foundation.h>
 #include <QuartzCore/QuartzCore.h>
 
+#include <thread>
+
 #include "flutter/shell/gpu/gpu_surface_metal_impeller.h"
+#include "flutter/shell/gpu/gpu_surface_shared_aiks_context.h"
 #include "gtest/gtest.h"
 #include "impeller/entity/mtl/entity_shaders.h"
 #include "impeller/entity/mtl/framebuffer_blend_shaders.h"
@@ -77,5 +80,43 @@ TEST(GPUSurfaceMetalImpeller, AcquireFrameFromCAMetalLayerNullChecksDrawable) {
   ASSERT_EQ(frame, nullptr);
 }
 
+TEST(GPUSurfaceMetalImpeller, SurfacesWithTheSameContextShareAiksContext) {
+  auto delegate = std::make_shared<TestGPUSurfaceMetalDelegate>();
+  auto context = CreateImpellerContext();
+  std::shared_ptr<Surface> surface =
+      std::make_shared<GPUSurfaceMetalImpeller>(delegate.get(), context);
+  std::shared_ptr<Surface> spawned_surface =
+      std::make_shared<GPUSurfaceMetalImpeller>(delegate.get(), context);
+  std::shared_ptr<Surface> unrelated_surface =
+      std::make_shared<GPUSurfaceMetalImpeller>(delegate.get(), CreateImpellerContext());
+
+  ASSERT_TRUE(surface->IsValid());
+  ASSERT_TRUE(spawned_surface->IsValid());
+  ASSERT_TRUE(unrelated_surface->IsValid());
+  auto aiks_context = surface->GetAiksContext();
+  EXPECT_EQ(aiks_context.get(), spawned_surface->GetAiksContext().get());
+  EXPECT_NE(aiks_context.get(), unrelated_surface->GetAiksContext().get());
+  EXPECT_EQ(GetSharedAiksContextSurfaceCount(aiks_context), 2u);
+
+  spawned_surface.reset();
+  EXPECT_EQ(GetSharedAiksContextSurfaceCount(aiks_context), 1u);
+}
+
+TEST(GPUSurfaceMetalImpeller, SurfacesOnDifferentThreadsDoNotShareAiksContext) {
+  auto delegate = std::make_shared<TestGPUSurfaceMetalDelegate>();
+  auto context = CreateImpellerContext();
+  std::shared_ptr<Surface> surface =
+      std::make_shared<GPUSurfaceMetalImpeller>(delegate.get(), context);
+  std::shared_ptr<Surface> other_thread_surface;
+  std::thread thread([&]() {
+    other_thread_surface = std::make_shared<GPUSurfaceMetalImpeller>(delegate.get(), context);
+  });
+  thread.join();
+
+  ASSERT_TRUE(surface->IsValid());
+  ASSERT_TRUE(other_thread_surface->IsValid());
+  EXPECT_NE(surface->GetAiksContext().get(), other_thread_surface->GetAiksContext().get());
+}
+
 }  // namespace testing
 }  // namespace flutter
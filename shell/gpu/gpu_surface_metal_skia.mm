@@ -268,4 +268,11 @@ bool GPUSurfaceMetalSkia::AllowsDrawingWhenGpuDisabled() const {
   return delegate_->AllowsDrawingWhenGpuDisabled();
 }
 
+// |Surface|
+bool GPUSurfaceMetalSkia::AllowsSkippingUnchangedFrames() const {
+  // A CAMetalLayer keeps showing its last drawable. Textures provided by an
+  // embedder are presented by the embedder, which may expect every frame.
+  return render_target_type_ == MTLRenderTargetType::kCAMetalLayer;
+}
+
 }  // namespace flutter
@@ -0,0 +1,139 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/gpu/gpu_surface_shared_aiks_context.h"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+struct SharedAiksContextEntry {
+  const impeller::Context* context;
+  std::thread::id thread;
+  std::weak_ptr<impeller::AiksContext> aiks_context;
+  const impeller::AiksContext* aiks_context_key;
+  size_t surface_count;
+};
+
+std::mutex& GetSharedAiksContextMutex() {
+  static std::mutex* mutex = new std::mutex();
+  return *mutex;
+}
+
+// Guarded by |GetSharedAiksContextMutex|.
+std::vector<SharedAiksContextEntry>& GetSharedAiksContextEntries() {
+  static auto* entries = new std::vector<SharedAiksContextEntry>();
+  return *entries;
+}
+
+void TraceSurfaceCount(const SharedAiksContextEntry& entry) {
+  FML_TRACE_COUNTER("flutter", "SharedAiksContext",
+                    reinterpret_cast<int64_t>(entry.aiks_context_key),  //
+                    "Surfaces", entry.surface_count);
+}
+
+// Held by every surface that uses a shared Aiks context, so that the number of
+// surfaces sharing it is known even if the surfaces hand out references to it.
+class SharedAiksContextLease {
+ public:
+  explicit SharedAiksContextLease(
+      std::shared_ptr<impeller::AiksContext> aiks_context)
+      : aiks_context_(std::move(aiks_context)) {}
+
+  ~SharedAiksContextLease() {
+    std::scoped_lock lock(GetSharedAiksContextMutex());
+    auto& entries = GetSharedAiksContextEntries();
+    auto found = std::find_if(entries.begin(), entries.end(),
+                              [this](const SharedAiksContextEntry& entry) {
+                                return entry.aiks_context_key ==
+                                       aiks_context_.get();
+                              });
+    if (found == entries.end()) {
+      return;
+    }
+    found->surface_count--;
+    TraceSurfaceCount(*found);
+    if (found->surface_count == 0) {
+      entries.erase(found);
+    }
+  }
+
+  impeller::AiksContext* get() const { return aiks_context_.get(); }
+
+ private:
+  std::shared_ptr<impeller::AiksContext> aiks_context_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SharedAiksContextLease);
+};
+
+std::shared_ptr<impeller::AiksContext> Lease(
+    std::shared_ptr<impeller::AiksContext> aiks_context) {
+  auto lease =
+      std::make_shared<SharedAiksContextLease>(std::move(aiks_context));
+  return std::shared_ptr<impeller::AiksContext>(lease, lease->get());
+}
+
+}  // namespace
+
+std::shared_ptr<impeller::AiksContext> GetSharedAiksContext(
+    const std::shared_ptr<impeller::Context>& context,
+    const TypographerContextFactory& make_typographer) {
+  if (!context || !context->IsValid()) {
+    return std::make_shared<impeller::AiksContext>(context, make_typographer());
+  }
+
+  const std::thread::id thread = std::this_thread::get_id();
+  {
+    std::scoped_lock lock(GetSharedAiksContextMutex());
+    for (auto& entry : GetSharedAiksContextEntries()) {
+      if (entry.context != context.get() || entry.thread != thread) {
+        continue;
+      }
+      if (auto aiks_context = entry.aiks_context.lock()) {
+        entry.surface_count++;
+        TraceSurfaceCount(entry);
+        return Lease(std::move(aiks_context));
+      }
+    }
+  }
+
+  auto aiks_context =
+      std::make_shared<impeller::AiksContext>(context, make_typographer());
+  if (!aiks_context->IsValid()) {
+    return aiks_context;
+  }
+
+  std::scoped_lock lock(GetSharedAiksContextMutex());
+  SharedAiksContextEntry entry = {
+      .context = context.get(),
+      .thread = thread,
+      .aiks_context = aiks_context,
+      .aiks_context_key = aiks_context.get(),
+      .surface_count = 1u,
+  };
+  TraceSurfaceCount(entry);
+  GetSharedAiksContextEntries().push_back(std::move(entry));
+  return Lease(std::move(aiks_context));
+}
+
+size_t GetSharedAiksContextSurfaceCount(
+    const std::shared_ptr<impeller::AiksContext>& aiks_context) {
+  std::scoped_lock lock(GetSharedAiksContextMutex());
+  for (const auto& entry : GetSharedAiksContextEntries()) {
+    if (entry.aiks_context_key == aiks_context.get()) {
+      return entry.surface_count;
+    }
+  }
+  return 0u;
+}
+
+}  // namespace flutter
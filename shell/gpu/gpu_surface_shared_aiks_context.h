@@ -0,0 +1,51 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_SHARED_AIKS_CONTEXT_H_
+#define FLUTTER_SHELL_GPU_GPU_SURFACE_SHARED_AIKS_CONTEXT_H_
+
+#include <functional>
+#include <memory>
+
+#include "flutter/impeller/aiks/aiks_context.h"
+#include "flutter/impeller/renderer/context.h"
+#include "flutter/impeller/typographer/typographer_context.h"
+
+namespace flutter {
+
+using TypographerContextFactory =
+    std::function<std::shared_ptr<impeller::TypographerContext>()>;
+
+//------------------------------------------------------------------------------
+/// @brief      Returns the Aiks context used by the Impeller surfaces that
+///             render with |context| on the current thread, creating it with
+///             the typographer context returned by |make_typographer| if there
+///             is none yet.
+///
+///             Shells spawned from another shell render on the raster thread
+///             and with the Impeller context of the shell they were spawned
+///             from. Sharing the Aiks context between their surfaces means
+///             that the pipelines of its content context are only built once,
+///             that text is rendered from a single glyph atlas, and that
+///             offscreen render targets are recycled between the shells.
+///
+///             The Aiks context is destroyed along with the last surface that
+///             uses it. The content context is not thread safe, which is why
+///             surfaces on different threads never share one.
+///
+/// @return     The shared Aiks context, which may be invalid if |context| is.
+///
+std::shared_ptr<impeller::AiksContext> GetSharedAiksContext(
+    const std::shared_ptr<impeller::Context>& context,
+    const TypographerContextFactory& make_typographer);
+
+//------------------------------------------------------------------------------
+/// @brief      The number of surfaces that currently share |aiks_context|.
+///
+size_t GetSharedAiksContextSurfaceCount(
+    const std::shared_ptr<impeller::AiksContext>& aiks_context);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_GPU_GPU_SURFACE_SHARED_AIKS_CONTEXT_H_
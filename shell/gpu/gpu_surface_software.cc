@@ -4,18 +4,55 @@
 
 #include "flutter/shell/gpu/gpu_surface_software.h"
 
+#include <algorithm>
 #include <memory>
 
+#include "flutter/display_list/skia/dl_sk_dispatcher.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
 
+#include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 
+namespace {
+
+// Finds the backdrop filters of a frame. They read back the pixels drawn
+// around them, which the bands next to theirs may still be drawing. Only
+// the top level of the frame is searched, since the pictures drawn from
+// dart:ui can not have backdrop filters.
+class BackdropFilterFinder final : public virtual DlOpReceiver,
+                                   private IgnoreAttributeDispatchHelper,
+                                   private IgnoreClipDispatchHelper,
+                                   private IgnoreDrawDispatchHelper,
+                                   private IgnoreTransformDispatchHelper {
+ public:
+  bool found() const { return found_; }
+
+ private:
+  bool found_ = false;
+
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    found_ = found_ || backdrop != nullptr;
+  }
+};
+
+}  // namespace
+
 GPUSurfaceSoftware::GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
-                                       bool render_to_surface)
+                                       bool render_to_surface,
+                                       size_t tile_raster_thread_count)
     : delegate_(delegate),
       render_to_surface_(render_to_surface),
+      tile_raster_loop_(
+          tile_raster_thread_count > 0u
+              ? fml::ConcurrentMessageLoop::Create(tile_raster_thread_count)
+              : nullptr),
       weak_factory_(this) {}
 
 GPUSurfaceSoftware::~GPUSurfaceSoftware() = default;
@@ -58,6 +95,10 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
     return nullptr;
   }
 
+  if (tile_raster_loop_) {
+    return AcquireTiledFrame(std::move(backing_store), size);
+  }
+
   // If the surface has been scaled, we need to apply the inverse scaling to the
   // underlying canvas so that coordinates are mapped to the same spot
   // irrespective of surface scaling.
@@ -81,6 +122,131 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
                                         on_submit, logical_size);
 }
 
+std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireTiledFrame(
+    sk_sp<SkSurface> backing_store,
+    const SkISize& size) {
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  // The frame is only recorded while the layer tree paints, so there is
+  // nothing to read back from yet.
+  framebuffer_info.supports_readback = false;
+  framebuffer_info.supports_partial_repaint = true;
+  if (backing_store == presented_backing_store_) {
+    framebuffer_info.existing_damage = SkIRect::MakeEmpty();
+  }
+
+  SurfaceFrame::SubmitCallback on_submit =
+      [self = weak_factory_.GetWeakPtr(), backing_store](
+          SurfaceFrame& surface_frame, DlCanvas* canvas) -> bool {
+    if (!self || !self->IsValid()) {
+      return false;
+    }
+
+    auto display_list = surface_frame.BuildDisplayList();
+    if (!display_list) {
+      FML_LOG(ERROR) << "Could not build display list for surface frame.";
+      return false;
+    }
+
+    SkIRect damage = SkIRect::MakeWH(backing_store->width(),  //
+                                     backing_store->height());
+    const auto& buffer_damage = surface_frame.submit_info().buffer_damage;
+    if (buffer_damage.has_value() && !damage.intersect(*buffer_damage)) {
+      damage.setEmpty();
+    }
+    self->RasterizeTiles(*display_list, *backing_store, damage);
+
+    // A backing store that was not presented can not be assumed to hold
+    // this frame.
+    self->presented_backing_store_ = nullptr;
+    if (!self->delegate_->PresentBackingStore(backing_store)) {
+      return false;
+    }
+    self->presented_backing_store_ = backing_store;
+    return true;
+  };
+
+  return std::make_unique<SurfaceFrame>(nullptr,           // surface
+                                        framebuffer_info,  // framebuffer info
+                                        on_submit,         // submit callback
+                                        size,              // frame size
+                                        nullptr,           // context result
+                                        true,  // display list fallback
+                                        true   // display list rtree
+  );
+}
+
+void GPUSurfaceSoftware::RasterizeTiles(const DisplayList& display_list,
+                                        SkSurface& backing_store,
+                                        const SkIRect& damage) {
+  TRACE_EVENT0("flutter", "GPUSurfaceSoftware::RasterizeTiles");
+  if (damage.isEmpty()) {
+    return;
+  }
+  // Makes a copy of the pixels for any snapshot of the backing store before
+  // they are written to behind its back.
+  backing_store.notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+  SkPixmap pixmap;
+  if (!backing_store.peekPixels(&pixmap)) {
+    FML_LOG(ERROR) << "Could not peek the pixels of the backing store.";
+    return;
+  }
+
+  BackdropFilterFinder backdrop_filter_finder;
+  display_list.Dispatch(backdrop_filter_finder);
+  const std::vector<SkIRect> tiles =
+      backdrop_filter_finder.found()
+          ? std::vector<SkIRect>{damage}
+          : ComputeTiles(damage, tile_raster_loop_->GetWorkerCount() + 1u);
+
+  // Every band draws into the whole backing store, clipped to its rows, so
+  // that shaders and dithering see the same device coordinates as they
+  // would with a single canvas.
+  const SkSurfaceProps& props = backing_store.props();
+  auto rasterize_tile = [&display_list, &pixmap, &props](const SkIRect& tile) {
+    TRACE_EVENT0("flutter", "GPUSurfaceSoftware::RasterizeTile");
+    auto canvas = SkCanvas::MakeRasterDirect(
+        pixmap.info(), pixmap.writable_addr(), pixmap.rowBytes(), &props);
+    if (!canvas) {
+      return;
+    }
+    canvas->clipIRect(tile);
+    DlSkCanvasDispatcher dispatcher(canvas.get());
+    display_list.Dispatch(dispatcher, tile);
+  };
+
+  fml::CountDownLatch latch(tiles.size() - 1u);
+  auto task_runner = tile_raster_loop_->GetTaskRunner();
+  for (size_t i = 1u; i < tiles.size(); i++) {
+    task_runner->PostTask([&rasterize_tile, &latch, &tile = tiles[i]]() {
+      rasterize_tile(tile);
+      latch.CountDown();
+    });
+  }
+  rasterize_tile(tiles[0]);
+  latch.Wait();
+}
+
+std::vector<SkIRect> GPUSurfaceSoftware::ComputeTiles(const SkIRect& rect,
+                                                      size_t max_count) {
+  std::vector<SkIRect> tiles;
+  if (rect.isEmpty() || max_count == 0u) {
+    return tiles;
+  }
+  const int count = static_cast<int>(std::clamp<size_t>(
+      rect.height() / kMinTileHeight, 1u, max_count));
+  tiles.reserve(count);
+  // The first bands take the rows that do not divide evenly.
+  const int height = rect.height() / count;
+  const int remainder = rect.height() % count;
+  int top = rect.fTop;
+  for (int i = 0; i < count; i++) {
+    const int bottom = top + height + (i < remainder ? 1 : 0);
+    tiles.push_back(SkIRect::MakeLTRB(rect.fLeft, top, rect.fRight, bottom));
+    top = bottom;
+  }
+  return tiles;
+}
+
 // |Surface|
 SkMatrix GPUSurfaceSoftware::GetRootTransformation() const {
   // This backend does not currently support root surface transformations. Just
@@ -5,7 +5,12 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 
+#include <memory>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
 #include "flutter/flow/surface.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/shell/gpu/gpu_surface_software_delegate.h"
@@ -14,8 +19,20 @@ namespace flutter {
 
 class GPUSurfaceSoftware : public Surface {
  public:
+  /// Bands of the frame are never made shorter than this many pixel rows.
+  static constexpr int kMinTileHeight = 64;
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  tile_raster_thread_count  The number of threads that
+  ///             rasterize bands of each frame along with the raster thread.
+  ///             The layer tree is then recorded into a display list, which
+  ///             the bands cull with its RTree, and only the damaged part of
+  ///             the backing store is redrawn. If 0, the layer tree paints
+  ///             straight into the backing store on the raster thread.
+  ///
   GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
-                     bool render_to_surface);
+                     bool render_to_surface,
+                     size_t tile_raster_thread_count = 0);
 
   ~GPUSurfaceSoftware() override;
 
@@ -31,6 +48,14 @@ class GPUSurfaceSoftware : public Surface {
   // |Surface|
   GrDirectContext* GetContext() override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Splits |rect| into at most |max_count| bands of whole pixel
+  ///             rows, from top to bottom, none of them shorter than
+  ///             |kMinTileHeight| unless |rect| is.
+  ///
+  static std::vector<SkIRect> ComputeTiles(const SkIRect& rect,
+                                           size_t max_count);
+
  private:
   GPUSurfaceSoftwareDelegate* delegate_;
   // TODO(38466): Refactor GPU surface APIs take into account the fact that an
@@ -38,6 +63,19 @@ class GPUSurfaceSoftware : public Surface {
   // hack to make avoid allocating resources for the root surface when an
   // external view embedder is present.
   const bool render_to_surface_;
+  std::shared_ptr<fml::ConcurrentMessageLoop> tile_raster_loop_;
+  // The backing store the last tiled frame was presented from, which still
+  // holds the pixels of that frame.
+  sk_sp<SkSurface> presented_backing_store_;
+
+  std::unique_ptr<SurfaceFrame> AcquireTiledFrame(
+      sk_sp<SkSurface> backing_store,
+      const SkISize& size);
+
+  void RasterizeTiles(const DisplayList& display_list,
+                      SkSurface& backing_store,
+                      const SkIRect& damage);
+
   fml::TaskRunnerAffineWeakPtrFactory<GPUSurfaceSoftware> weak_factory_;
   FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceSoftware);
 };
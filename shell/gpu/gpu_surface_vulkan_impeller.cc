@@ -5,6 +5,7 @@
 #include "flutter/shell/gpu/gpu_surface_vulkan_impeller.h"
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/shell/gpu/gpu_surface_shared_aiks_context.h"
 #include "impeller/display_list/dl_dispatcher.h"
 #include "impeller/renderer/backend/vulkan/surface_context_vk.h"
 #include "impeller/renderer/renderer.h"
@@ -24,8 +25,8 @@ GPUSurfaceVulkanImpeller::GPUSurfaceVulkanImpeller(
     return;
   }
 
-  auto aiks_context = std::make_shared<impeller::AiksContext>(
-      context, impeller::TypographerContextSkia::Make());
+  auto aiks_context = GetSharedAiksContext(
+      context, [] { return impeller::TypographerContextSkia::Make(); });
   if (!aiks_context->IsValid()) {
     return;
   }
@@ -202,6 +202,21 @@ AndroidShellHolder::~AndroidShellHolder() {
   thread_host_.reset();
 }
 
+// static
+void AndroidShellHolder::DestroyAsync(
+    std::unique_ptr<AndroidShellHolder> holder) {
+  if (!holder->shell_) {
+    return;
+  }
+  auto shell = std::move(holder->shell_);
+  // The threads of the holder are idle once the shell is gone, so joining
+  // them from the platform thread doesn't block it for long.
+  Shell::DestroyAsync(std::move(shell),
+                      fml::MakeCopyable([holder = std::move(holder)]() mutable {
+                        holder.reset();
+                      }));
+}
+
 bool AndroidShellHolder::IsValid() const {
   return is_valid_;
 }
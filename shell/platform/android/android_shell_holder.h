@@ -46,6 +46,14 @@ class AndroidShellHolder {
 
   ~AndroidShellHolder();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Destroys the holder without blocking the platform thread on
+  ///             the teardown of the UI, raster and IO threads. The shell is
+  ///             torn down with `Shell::DestroyAsync`, and the holder and its
+  ///             threads are deleted on the platform thread once it is gone.
+  ///
+  static void DestroyAsync(std::unique_ptr<AndroidShellHolder> holder);
+
   bool IsValid() const;
 
   //----------------------------------------------------------------------------
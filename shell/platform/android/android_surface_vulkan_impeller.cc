@@ -17,7 +17,9 @@
 namespace flutter {
 
 AndroidSurfaceVulkanImpeller::AndroidSurfaceVulkanImpeller(
-    const std::shared_ptr<AndroidContextVulkanImpeller>& android_context) {
+    const std::shared_ptr<AndroidContextVulkanImpeller>& android_context,
+    const impeller::SwapchainSettingsVK& swapchain_settings)
+    : swapchain_settings_(swapchain_settings) {
   is_valid_ = android_context->IsValid();
 
   auto& context_vk =
@@ -80,7 +82,8 @@ bool AndroidSurfaceVulkanImpeller::SetNativeWindow(
       return false;
     }
 
-    return surface_context_vk_->SetWindowSurface(std::move(surface));
+    return surface_context_vk_->SetWindowSurface(std::move(surface),
+                                                 swapchain_settings_);
   }
 
   native_window_ = nullptr;
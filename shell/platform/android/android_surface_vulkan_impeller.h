@@ -17,7 +17,8 @@ namespace flutter {
 class AndroidSurfaceVulkanImpeller : public AndroidSurface {
  public:
   explicit AndroidSurfaceVulkanImpeller(
-      const std::shared_ptr<AndroidContextVulkanImpeller>& android_context);
+      const std::shared_ptr<AndroidContextVulkanImpeller>& android_context,
+      const impeller::SwapchainSettingsVK& swapchain_settings = {});
 
   ~AndroidSurfaceVulkanImpeller() override;
 
@@ -48,6 +49,7 @@ class AndroidSurfaceVulkanImpeller : public AndroidSurface {
 
  private:
   std::shared_ptr<impeller::SurfaceContextVK> surface_context_vk_;
+  const impeller::SwapchainSettingsVK swapchain_settings_;
   fml::RefPtr<AndroidNativeWindow> native_window_;
   bool is_valid_ = false;
 
@@ -9,17 +9,25 @@
 
 namespace flutter {
 
+// The maximum ratio between the area of an overlay that contains the Flutter
+// UI drawn above several platform views and the area of that UI.
+static constexpr SkScalar kMaxMergedOverlayAreaRatio = 2;
+
 AndroidExternalViewEmbedder::AndroidExternalViewEmbedder(
     const AndroidContext& android_context,
     std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
     std::shared_ptr<AndroidSurfaceFactory> surface_factory,
-    const TaskRunners& task_runners)
+    const TaskRunners& task_runners,
+    bool async_composition)
     : ExternalViewEmbedder(),
       android_context_(android_context),
       jni_facade_(std::move(jni_facade)),
       surface_factory_(std::move(surface_factory)),
-      surface_pool_(std::make_unique<SurfacePool>()),
-      task_runners_(task_runners) {}
+      surface_pool_(std::make_unique<SurfacePool>(
+          async_composition ? task_runners.GetPlatformTaskRunner()
+                            : nullptr)),
+      task_runners_(task_runners),
+      async_composition_(async_composition) {}
 
 // |ExternalViewEmbedder|
 void AndroidExternalViewEmbedder::PrerollCompositeEmbeddedView(
@@ -29,8 +37,14 @@ void AndroidExternalViewEmbedder::PrerollCompositeEmbeddedView(
                "AndroidExternalViewEmbedder::PrerollCompositeEmbeddedView");
 
   SkRect view_bounds = SkRect::Make(frame_size_);
+  const DisplayListEmbedderViewSlice* previous = nullptr;
+  auto previous_slice = previous_slices_.find(view_id);
+  if (previous_slice != previous_slices_.end()) {
+    previous = static_cast<const DisplayListEmbedderViewSlice*>(
+        previous_slice->second.get());
+  }
   std::unique_ptr<EmbedderViewSlice> view;
-  view = std::make_unique<DisplayListEmbedderViewSlice>(view_bounds);
+  view = std::make_unique<DisplayListEmbedderViewSlice>(view_bounds, previous);
   slices_.insert_or_assign(view_id, std::move(view));
 
   composition_order_.push_back(view_id);
@@ -146,68 +160,118 @@ void AndroidExternalViewEmbedder::SubmitFlutterView(
   //
   // Skip a frame if the embedding is switching surfaces, and indicate in
   // `PostPrerollAction` that this frame must be resubmitted.
-  auto should_submit_current_frame = previous_frame_view_count_ > 0;
+  auto should_submit_current_frame =
+      previous_frame_view_count_ > 0 || async_composition_;
   if (should_submit_current_frame) {
     frame->Submit();
   }
 
-  for (int64_t view_id : composition_order_) {
+  // The overlay that is displayed above the last displayed platform view.
+  //
+  // Instead of adding an overlay above every platform view that has Flutter UI
+  // drawn on top of it, the overlay is moved up for as long as the UI it
+  // contains doesn't intersect the platform views above it. This allows to
+  // render the UI above several platform views into a single overlay.
+  OverlayContents overlay;
+  auto display_overlay = [&](int64_t z_position) {
+    if (overlay.slices.empty()) {
+      return;
+    }
+    std::unique_ptr<SurfaceFrame> frame =
+        CreateSurfaceIfNeeded(context, z_position, overlay);
+    // With asynchronous composition, the overlay is left out of the frames
+    // rendered while its surface is being created.
+    if (frame && should_submit_current_frame) {
+      frame->Submit();
+    }
+    overlay = OverlayContents();
+  };
+
+  for (size_t i = 0; i < current_frame_view_count; i++) {
+    int64_t view_id = composition_order_[i];
     SkRect view_rect = GetViewRect(view_id);
+    for (const auto& [slice, rect] : overlay.slices) {
+      if (rect.intersects(view_rect)) {
+        display_overlay(i - 1);
+        break;
+      }
+    }
     const EmbeddedViewParams& params = view_params_.at(view_id);
     // Display the platform view. If it's already displayed, then it's
     // just positioned and sized.
-    jni_facade_->FlutterViewOnDisplayPlatformView(
-        view_id,             //
-        view_rect.x(),       //
-        view_rect.y(),       //
-        view_rect.width(),   //
-        view_rect.height(),  //
-        params.sizePoints().width() * device_pixel_ratio_,
-        params.sizePoints().height() * device_pixel_ratio_,
-        params.mutatorsStack()  //
-    );
-    std::unordered_map<int64_t, SkRect>::const_iterator overlay =
+    Arrange([jni_facade = jni_facade_, view_id, view_rect,
+             view_width = params.sizePoints().width() * device_pixel_ratio_,
+             view_height = params.sizePoints().height() * device_pixel_ratio_,
+             mutators_stack = params.mutatorsStack()]() {
+      jni_facade->FlutterViewOnDisplayPlatformView(view_id,             //
+                                                   view_rect.x(),       //
+                                                   view_rect.y(),       //
+                                                   view_rect.width(),   //
+                                                   view_rect.height(),  //
+                                                   view_width,          //
+                                                   view_height,         //
+                                                   mutators_stack       //
+      );
+    });
+    std::unordered_map<int64_t, SkRect>::const_iterator overlay_layer =
         overlay_layers.find(view_id);
-    if (overlay == overlay_layers.end()) {
+    if (overlay_layer == overlay_layers.end()) {
       continue;
     }
-    std::unique_ptr<SurfaceFrame> frame =
-        CreateSurfaceIfNeeded(context,                    //
-                              view_id,                    //
-                              slices_.at(view_id).get(),  //
-                              overlay->second             //
-        );
-    if (should_submit_current_frame) {
-      frame->Submit();
+    const SkRect& rect = overlay_layer->second;
+    SkScalar area = rect.width() * rect.height();
+    SkRect merged_rect = overlay.rect;
+    merged_rect.join(rect);
+    // Only merge overlays if most of the merged overlay has Flutter UI on it,
+    // since large transparent overlays are costly to composite.
+    if (merged_rect.width() * merged_rect.height() >
+        kMaxMergedOverlayAreaRatio * (overlay.area + area)) {
+      display_overlay(i);
+      merged_rect = rect;
     }
+    overlay.slices.emplace_back(slices_.at(view_id).get(), rect);
+    overlay.rect = merged_rect;
+    overlay.area += area;
   }
+  display_overlay(current_frame_view_count - 1);
 }
 
 // |ExternalViewEmbedder|
 std::unique_ptr<SurfaceFrame>
-AndroidExternalViewEmbedder::CreateSurfaceIfNeeded(GrDirectContext* context,
-                                                   int64_t view_id,
-                                                   EmbedderViewSlice* slice,
-                                                   const SkRect& rect) {
+AndroidExternalViewEmbedder::CreateSurfaceIfNeeded(
+    GrDirectContext* context,
+    int64_t z_position,
+    const OverlayContents& overlay) {
   std::shared_ptr<OverlayLayer> layer = surface_pool_->GetLayer(
-      context, android_context_, jni_facade_, surface_factory_);
+      context, android_context_, jni_facade_, surface_factory_, z_position);
+  if (!layer) {
+    return nullptr;
+  }
 
   std::unique_ptr<SurfaceFrame> frame =
       layer->surface->AcquireFrame(frame_size_);
+  const SkRect& rect = overlay.rect;
   // Display the overlay surface. If it's already displayed, then it's
   // just positioned and sized.
-  jni_facade_->FlutterViewDisplayOverlaySurface(layer->id,     //
-                                                rect.x(),      //
-                                                rect.y(),      //
-                                                rect.width(),  //
-                                                rect.height()  //
-  );
+  Arrange([jni_facade = jni_facade_, id = layer->id, rect]() {
+    jni_facade->FlutterViewDisplayOverlaySurface(id,            //
+                                                 rect.x(),      //
+                                                 rect.y(),      //
+                                                 rect.width(),  //
+                                                 rect.height()  //
+    );
+  });
   DlCanvas* overlay_canvas = frame->Canvas();
   overlay_canvas->Clear(DlColor::kTransparent());
   // Offset the picture since its absolute position on the scene is determined
   // by the position of the overlay view.
   overlay_canvas->Translate(-rect.x(), -rect.y());
-  slice->render_into(overlay_canvas);
+  for (const auto& [slice, slice_rect] : overlay.slices) {
+    // The rest of the slice is drawn on the background or other overlays.
+    DlAutoCanvasRestore save(overlay_canvas, /*do_save=*/true);
+    overlay_canvas->ClipRect(slice_rect);
+    slice->render_into(overlay_canvas);
+  }
   return frame;
 }
 
@@ -217,6 +281,12 @@ PostPrerollResult AndroidExternalViewEmbedder::PostPrerollAction(
   if (!FrameHasPlatformLayers()) {
     return PostPrerollResult::kSuccess;
   }
+  if (async_composition_) {
+    // The raster thread can't wait for the platform thread to switch
+    // surfaces, so the frame that switches isn't resubmitted. It's drawn to
+    // the current surface, and the next frame to the new one.
+    return PostPrerollResult::kSuccess;
+  }
   if (!raster_thread_merger->IsMerged()) {
     // The raster thread merger may be disabled if the rasterizer is being
     // created or teared down.
@@ -243,6 +313,14 @@ bool AndroidExternalViewEmbedder::FrameHasPlatformLayers() {
   return !composition_order_.empty();
 }
 
+void AndroidExternalViewEmbedder::Arrange(fml::closure task) {
+  if (async_composition_) {
+    pending_arrangement_.push_back(std::move(task));
+  } else {
+    task();
+  }
+}
+
 // |ExternalViewEmbedder|
 DlCanvas* AndroidExternalViewEmbedder::GetRootCanvas() {
   // On Android, the root surface is created from the on-screen render target.
@@ -253,6 +331,7 @@ void AndroidExternalViewEmbedder::Reset() {
   previous_frame_view_count_ = composition_order_.size();
 
   composition_order_.clear();
+  previous_slices_ = std::move(slices_);
   slices_.clear();
 }
 
@@ -260,6 +339,11 @@ void AndroidExternalViewEmbedder::Reset() {
 void AndroidExternalViewEmbedder::BeginFrame(
     GrDirectContext* context,
     const fml::RefPtr<fml::RasterThreadMerger>& raster_thread_merger) {
+  if (async_composition_) {
+    // The frame begins on the platform thread when it is arranged.
+    pending_arrangement_.clear();
+    return;
+  }
   // JNI method must be called on the platform thread.
   if (raster_thread_merger->IsOnPlatformThread()) {
     jni_facade_->FlutterViewBeginFrame();
@@ -297,15 +381,40 @@ void AndroidExternalViewEmbedder::EndFrame(
     bool should_resubmit_frame,
     const fml::RefPtr<fml::RasterThreadMerger>& raster_thread_merger) {
   surface_pool_->RecycleLayers();
+  if (async_composition_) {
+    // The frame is also arranged once after the last platform view is gone,
+    // so that the views and overlays of the previous frame are removed.
+    if (FrameHasPlatformLayers() || previous_frame_view_count_ > 0) {
+      PostArrangement();
+    }
+    return;
+  }
   // JNI method must be called on the platform thread.
   if (raster_thread_merger->IsOnPlatformThread()) {
     jni_facade_->FlutterViewEndFrame();
   }
 }
 
+void AndroidExternalViewEmbedder::PostArrangement() {
+  TRACE_EVENT0("flutter", "AndroidExternalViewEmbedder::PostArrangement");
+  // The platform thread may be waiting for the raster thread, for example
+  // while the surface is switched, so the raster thread never waits here.
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetPlatformTaskRunner(),
+      [jni_facade = jni_facade_,
+       arrangement = std::move(pending_arrangement_)]() {
+        jni_facade->FlutterViewBeginFrame();
+        for (const fml::closure& task : arrangement) {
+          task();
+        }
+        jni_facade->FlutterViewEndFrame();
+      });
+  pending_arrangement_.clear();
+}
+
 // |ExternalViewEmbedder|
 bool AndroidExternalViewEmbedder::SupportsDynamicThreadMerging() {
-  return true;
+  return !async_composition_;
 }
 
 // |ExternalViewEmbedder|
@@ -315,6 +424,11 @@ void AndroidExternalViewEmbedder::Teardown() {
 
 // |ExternalViewEmbedder|
 void AndroidExternalViewEmbedder::DestroySurfaces() {
+  if (async_composition_) {
+    // The pool posts the destruction to the platform thread without waiting.
+    surface_pool_->DestroyLayers(jni_facade_);
+    return;
+  }
   if (!surface_pool_->HasLayers()) {
     return;
   }
@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_PLATFORM_ANDROID_EXTERNAL_VIEW_EMBEDDER_EXTERNAL_VIEW_EMBEDDER_H_
 
 #include <unordered_map>
+#include <utility>
 
 #include "flutter/common/task_runners.h"
 #include "flutter/flow/embedded_views.h"
@@ -26,13 +27,25 @@ namespace flutter {
 /// that render above (by Z order) the Android view corresponding to
 /// |flutter::PlatformViewLayer|.
 ///
+/// By default, the raster thread is merged into the platform thread while
+/// platform views are displayed, since the views must be arranged on the
+/// platform thread. With asynchronous composition, the frames keep being
+/// rasterized on the raster thread, and only the arrangement of the views and
+/// the overlay surfaces is posted to the platform thread at the end of each
+/// frame. The views may then be arranged a frame after the overlays that
+/// draw above them were rendered. The raster thread never waits for the
+/// platform thread in this mode: overlay surfaces are created and destroyed
+/// by posted tasks, and an overlay is left out of the frames rendered before
+/// its surface exists.
+///
 class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
  public:
   AndroidExternalViewEmbedder(
       const AndroidContext& android_context,
       std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
       std::shared_ptr<AndroidSurfaceFactory> surface_factory,
-      const TaskRunners& task_runners);
+      const TaskRunners& task_runners,
+      bool async_composition = false);
 
   // |ExternalViewEmbedder|
   void PrerollCompositeEmbeddedView(
@@ -105,6 +118,15 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
   // The task runners.
   const TaskRunners task_runners_;
 
+  // Whether the raster thread is kept separate from the platform thread when
+  // there are platform views.
+  const bool async_composition_;
+
+  // The JNI calls that arrange the platform views and the overlay surfaces of
+  // the current frame. With asynchronous composition, they are posted to the
+  // platform thread at the end of the frame.
+  std::vector<fml::closure> pending_arrangement_;
+
   // The size of the root canvas.
   SkISize frame_size_;
 
@@ -121,6 +143,12 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
   // the end of the last leaf node in the layer tree.
   std::unordered_map<int64_t, std::unique_ptr<EmbedderViewSlice>> slices_;
 
+  // The slices of the previous frame, kept until the slices for the same
+  // views are recorded again so that they can be used to speed up
+  // building the new slices.
+  std::unordered_map<int64_t, std::unique_ptr<EmbedderViewSlice>>
+      previous_slices_;
+
   // The params for a platform view, which contains the size, position and
   // mutation stack.
   std::unordered_map<int64_t, EmbeddedViewParams> view_params_;
@@ -139,12 +167,36 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
   // Whether the layer tree in the current frame has platform layers.
   bool FrameHasPlatformLayers();
 
+  // Makes the JNI call |task| now, or at the end of the frame with
+  // asynchronous composition.
+  void Arrange(fml::closure task);
+
+  // Posts the JNI calls that arrange the current frame to the platform
+  // thread, without waiting for them to be made.
+  void PostArrangement();
+
+  // The Flutter UI drawn above one or more consecutive platform views, which
+  // is rendered into a single overlay surface.
+  struct OverlayContents {
+    // The slices drawn into the overlay, each with the rect it's clipped to.
+    std::vector<std::pair<EmbedderViewSlice*, SkRect>> slices;
+
+    // The union of the rects of |slices|.
+    SkRect rect = SkRect::MakeEmpty();
+
+    // The sum of the areas of the rects of |slices|.
+    SkScalar area = 0;
+  };
+
   // Creates a Surface when needed or recycles an existing one.
-  // Finally, draws the picture on the frame's canvas.
-  std::unique_ptr<SurfaceFrame> CreateSurfaceIfNeeded(GrDirectContext* context,
-                                                      int64_t view_id,
-                                                      EmbedderViewSlice* slice,
-                                                      const SkRect& rect);
+  // Finally, draws the pictures on the frame's canvas.
+  //
+  // Returns nullptr while the surface is being created on the platform
+  // thread, with asynchronous composition.
+  std::unique_ptr<SurfaceFrame> CreateSurfaceIfNeeded(
+      GrDirectContext* context,
+      int64_t z_position,
+      const OverlayContents& overlay);
 };
 
 }  // namespace flutter
@@ -189,6 +189,33 @@ TEST(AndroidExternalViewEmbedder, RasterizerRunsOnRasterizerThread) {
   ASSERT_FALSE(raster_thread_merger->IsMerged());
 }
 
+TEST(AndroidExternalViewEmbedder, AsyncCompositionDoesNotMergeThreads) {
+  auto jni_mock = std::make_shared<JNIMock>();
+  auto android_context = AndroidContext(AndroidRenderingAPI::kSoftware);
+  auto embedder = std::make_unique<AndroidExternalViewEmbedder>(
+      android_context, jni_mock, nullptr, GetTaskRunnersForFixture(),
+      /*async_composition=*/true);
+  ASSERT_FALSE(embedder->SupportsDynamicThreadMerging());
+
+  // The frame is arranged on the platform thread when it ends.
+  EXPECT_CALL(*jni_mock, FlutterViewBeginFrame()).Times(0);
+  embedder->BeginFrame(nullptr, nullptr);
+  embedder->PrepareFlutterView(kImplicitViewId, SkISize::Make(10, 20), 1.0);
+
+  // Push a platform view.
+  embedder->PrerollCompositeEmbeddedView(
+      0, std::make_unique<EmbeddedViewParams>());
+
+  // The first frame with platform views switches surfaces, without waiting
+  // for the switch.
+  ASSERT_EQ(PostPrerollResult::kSuccess, embedder->PostPrerollAction(nullptr));
+  ::testing::Mock::VerifyAndClearExpectations(jni_mock.get());
+
+  EXPECT_CALL(*jni_mock, FlutterViewBeginFrame());
+  EXPECT_CALL(*jni_mock, FlutterViewEndFrame());
+  embedder->EndFrame(/*should_resubmit_frame=*/false, nullptr);
+}
+
 TEST(AndroidExternalViewEmbedder, PlatformViewRect) {
   auto jni_mock = std::make_shared<JNIMock>();
 
@@ -569,6 +596,111 @@ TEST(AndroidExternalViewEmbedder, OverlayCoverTwoPlatformViews) {
   embedder->EndFrame(/*should_resubmit_frame=*/false, raster_thread_merger);
 }
 
+TEST(AndroidExternalViewEmbedder, MergesOverlaysOfAdjacentPlatformViews) {
+  // In this test we will simulate two Android views side by side, each with
+  // a rect drawn above it. Since neither rect intersects the other Android
+  // view, both rects are drawn into the same overlay.
+
+  auto jni_mock = std::make_shared<JNIMock>();
+  auto android_context =
+      std::make_shared<AndroidContext>(AndroidRenderingAPI::kSoftware);
+
+  auto window = fml::MakeRefCounted<AndroidNativeWindow>(nullptr);
+  auto gr_context = GrDirectContext::MakeMock(nullptr);
+  auto frame_size = SkISize::Make(1000, 1000);
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  auto surface_factory = std::make_shared<TestAndroidSurfaceFactory>(
+      [gr_context, window, frame_size, framebuffer_info]() {
+        auto surface_frame_1 = std::make_unique<SurfaceFrame>(
+            SkSurfaces::Null(1000, 1000), framebuffer_info,
+            [](const SurfaceFrame& surface_frame, DlCanvas* canvas) {
+              return true;
+            },
+            /*frame_size=*/SkISize::Make(800, 600));
+
+        auto surface_mock = std::make_unique<SurfaceMock>();
+        EXPECT_CALL(*surface_mock, AcquireFrame(frame_size))
+            .Times(1 /* frames */)
+            .WillOnce(Return(ByMove(std::move(surface_frame_1))));
+
+        auto android_surface_mock = std::make_unique<AndroidSurfaceMock>();
+        EXPECT_CALL(*android_surface_mock, IsValid()).WillOnce(Return(true));
+
+        EXPECT_CALL(*android_surface_mock, CreateGPUSurface(gr_context.get()))
+            .WillOnce(Return(ByMove(std::move(surface_mock))));
+
+        EXPECT_CALL(*android_surface_mock, SetNativeWindow(window));
+        return android_surface_mock;
+      });
+  auto embedder = std::make_unique<AndroidExternalViewEmbedder>(
+      *android_context, jni_mock, surface_factory, GetTaskRunnersForFixture());
+
+  auto raster_thread_merger = GetThreadMergerFromPlatformThread();
+
+  EXPECT_CALL(*jni_mock, FlutterViewBeginFrame());
+  embedder->BeginFrame(nullptr, raster_thread_merger);
+  embedder->PrepareFlutterView(kImplicitViewId, frame_size, 1.5);
+
+  {
+    // Add first Android view.
+    SkMatrix matrix = SkMatrix::Translate(100, 100);
+    MutatorsStack stack;
+    embedder->PrerollCompositeEmbeddedView(
+        0, std::make_unique<EmbeddedViewParams>(matrix, SkSize::Make(100, 100),
+                                                stack));
+    // The JNI call to display the Android view.
+    EXPECT_CALL(*jni_mock, FlutterViewOnDisplayPlatformView(
+                               0, 100, 100, 100, 100, 150, 150, stack));
+  }
+
+  {
+    // Add second Android view.
+    SkMatrix matrix = SkMatrix::Translate(200, 100);
+    MutatorsStack stack;
+    embedder->PrerollCompositeEmbeddedView(
+        1, std::make_unique<EmbeddedViewParams>(matrix, SkSize::Make(100, 100),
+                                                stack));
+    // The JNI call to display the Android view.
+    EXPECT_CALL(*jni_mock, FlutterViewOnDisplayPlatformView(
+                               1, 200, 100, 100, 100, 150, 150, stack));
+  }
+  auto rect_paint = DlPaint();
+  rect_paint.setColor(DlColor::kCyan());
+  rect_paint.setDrawStyle(DlDrawStyle::kFill);
+
+  // This simulates Flutter UI that intersects with the first Android view.
+  embedder->CompositeEmbeddedView(0)->DrawRect(
+      SkRect::MakeXYWH(150, 150, 100, 100), rect_paint);
+  // This simulates Flutter UI that intersects with the second Android view.
+  embedder->CompositeEmbeddedView(1)->DrawRect(
+      SkRect::MakeXYWH(220, 150, 100, 100), rect_paint);
+
+  EXPECT_CALL(*jni_mock, FlutterViewCreateOverlaySurface())
+      .WillOnce([&]() {
+        return std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
+            1, window);
+      });
+
+  // The JNI call to display the overlay surface that covers the rects above
+  // both Android views.
+  EXPECT_CALL(*jni_mock,
+              FlutterViewDisplayOverlaySurface(1, 150, 150, 150, 50))
+      .Times(1);
+
+  auto surface_frame = std::make_unique<SurfaceFrame>(
+      SkSurfaces::Null(1000, 1000), framebuffer_info,
+      [](const SurfaceFrame& surface_frame, DlCanvas* canvas) mutable {
+        return true;
+      },
+      /*frame_size=*/SkISize::Make(800, 600));
+
+  embedder->SubmitFlutterView(gr_context.get(), nullptr,
+                              std::move(surface_frame));
+
+  EXPECT_CALL(*jni_mock, FlutterViewEndFrame());
+  embedder->EndFrame(/*should_resubmit_frame=*/false, raster_thread_merger);
+}
+
 TEST(AndroidExternalViewEmbedder, SubmitFrameOverlayComposition) {
   auto jni_mock = std::make_shared<JNIMock>();
   auto android_context =
@@ -17,7 +17,9 @@ OverlayLayer::OverlayLayer(int id,
 
 OverlayLayer::~OverlayLayer() = default;
 
-SurfacePool::SurfacePool() = default;
+SurfacePool::SurfacePool(fml::RefPtr<fml::TaskRunner> platform_task_runner)
+    : platform_task_runner_(std::move(platform_task_runner)),
+      surface_requests_(std::make_shared<SurfaceRequests>()) {}
 
 SurfacePool::~SurfacePool() = default;
 
@@ -25,15 +27,24 @@ std::shared_ptr<OverlayLayer> SurfacePool::GetLayer(
     GrDirectContext* gr_context,
     const AndroidContext& android_context,
     const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade,
-    const std::shared_ptr<AndroidSurfaceFactory>& surface_factory) {
+    const std::shared_ptr<AndroidSurfaceFactory>& surface_factory,
+    int64_t z_position) {
   std::lock_guard lock(mutex_);
   // Destroy current layers in the pool if the frame size has changed.
   if (requested_frame_size_ != current_frame_size_) {
     DestroyLayersLocked(jni_facade);
   }
   intptr_t gr_context_key = reinterpret_cast<intptr_t>(gr_context);
+  size_t layer_index = FindAvailableLayerLocked(z_position);
   // Allocate a new surface if there isn't one available.
-  if (available_layer_index_ >= layers_.size()) {
+  if (layer_index >= layers_.size()) {
+    std::unique_ptr<PlatformViewAndroidJNI::OverlayMetadata> java_metadata =
+        CreateOverlaySurfaceLocked(jni_facade);
+    if (!java_metadata) {
+      current_frame_size_ = requested_frame_size_;
+      return nullptr;
+    }
+
     std::unique_ptr<AndroidSurface> android_surface =
         surface_factory->CreateSurface();
 
@@ -41,9 +52,6 @@ std::shared_ptr<OverlayLayer> SurfacePool::GetLayer(
         << "Could not create an OpenGL, Vulkan or Software surface to set up "
            "rendering.";
 
-    std::unique_ptr<PlatformViewAndroidJNI::OverlayMetadata> java_metadata =
-        jni_facade->FlutterViewCreateOverlaySurface();
-
     FML_CHECK(java_metadata->window);
     android_surface->SetNativeWindow(java_metadata->window);
 
@@ -59,7 +67,10 @@ std::shared_ptr<OverlayLayer> SurfacePool::GetLayer(
     layers_.push_back(layer);
   }
 
+  // Move the layer to the end of the used layers.
+  std::swap(layers_[layer_index], layers_[available_layer_index_]);
   std::shared_ptr<OverlayLayer> layer = layers_[available_layer_index_];
+  layer->z_position = z_position;
   // Since the surfaces are recycled, it's possible that the GrContext is
   // different.
   if (gr_context_key != layer->gr_context_key) {
@@ -75,9 +86,32 @@ std::shared_ptr<OverlayLayer> SurfacePool::GetLayer(
   return layer;
 }
 
+size_t SurfacePool::FindAvailableLayerLocked(int64_t z_position) const {
+  size_t unused_layer_index = layers_.size();
+  for (size_t i = available_layer_index_; i < layers_.size(); i++) {
+    if (layers_[i]->z_position == z_position) {
+      return i;
+    }
+    if (layers_[i]->z_position == -1 && unused_layer_index == layers_.size()) {
+      unused_layer_index = i;
+    }
+  }
+  if (unused_layer_index == layers_.size() &&
+      available_layer_index_ < layers_.size()) {
+    // All the available layers were used at other z-positions in the
+    // previous frame.
+    return available_layer_index_;
+  }
+  return unused_layer_index;
+}
+
 void SurfacePool::RecycleLayers() {
   std::lock_guard lock(mutex_);
+  for (size_t i = available_layer_index_; i < layers_.size(); i++) {
+    layers_[i]->z_position = -1;
+  }
   available_layer_index_ = 0;
+  missing_layer_count_ = 0;
 }
 
 bool SurfacePool::HasLayers() {
@@ -93,12 +127,82 @@ void SurfacePool::DestroyLayers(
 
 void SurfacePool::DestroyLayersLocked(
     const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade) {
-  if (layers_.empty()) {
+  if (!platform_task_runner_) {
+    if (layers_.empty()) {
+      return;
+    }
+    jni_facade->FlutterViewDestroyOverlaySurfaces();
+    layers_.clear();
+    available_layer_index_ = 0;
     return;
   }
-  jni_facade->FlutterViewDestroyOverlaySurfaces();
+
+  {
+    std::lock_guard requests_lock(surface_requests_->mutex);
+    if (layers_.empty() && surface_requests_->pending == 0) {
+      return;
+    }
+    // The surfaces that are still being created are destroyed with the
+    // others, since the platform thread runs its tasks in order.
+    surface_requests_->generation++;
+    surface_requests_->pending = 0;
+    surface_requests_->created.clear();
+  }
   layers_.clear();
   available_layer_index_ = 0;
+  fml::TaskRunner::RunNowOrPostTask(
+      platform_task_runner_,
+      [jni_facade]() { jni_facade->FlutterViewDestroyOverlaySurfaces(); });
+}
+
+std::unique_ptr<PlatformViewAndroidJNI::OverlayMetadata>
+SurfacePool::CreateOverlaySurfaceLocked(
+    const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade) {
+  if (!platform_task_runner_) {
+    return jni_facade->FlutterViewCreateOverlaySurface();
+  }
+
+  auto take_created_surface = [this]() {
+    std::lock_guard requests_lock(surface_requests_->mutex);
+    std::unique_ptr<PlatformViewAndroidJNI::OverlayMetadata> java_metadata;
+    if (!surface_requests_->created.empty()) {
+      java_metadata = std::move(surface_requests_->created.back());
+      surface_requests_->created.pop_back();
+      surface_requests_->pending--;
+    }
+    return java_metadata;
+  };
+  if (auto java_metadata = take_created_surface()) {
+    return java_metadata;
+  }
+
+  size_t generation;
+  {
+    std::lock_guard requests_lock(surface_requests_->mutex);
+    // Only ask for the surfaces that aren't already being created.
+    if (++missing_layer_count_ <= surface_requests_->pending) {
+      return nullptr;
+    }
+    surface_requests_->pending++;
+    generation = surface_requests_->generation;
+  }
+  fml::TaskRunner::RunNowOrPostTask(
+      platform_task_runner_,
+      [requests = surface_requests_, jni_facade, generation]() {
+        std::unique_ptr<PlatformViewAndroidJNI::OverlayMetadata>
+            java_metadata = jni_facade->FlutterViewCreateOverlaySurface();
+        std::lock_guard requests_lock(requests->mutex);
+        if (requests->generation != generation) {
+          return;
+        }
+        if (java_metadata && java_metadata->window) {
+          requests->created.push_back(std::move(java_metadata));
+        } else {
+          requests->pending--;
+        }
+      });
+  // The surface is created right away if this is the platform thread.
+  return take_created_surface();
 }
 
 std::vector<std::shared_ptr<OverlayLayer>> SurfacePool::GetUnusedLayers() {
@@ -5,9 +5,12 @@
 #ifndef FLUTTER_SHELL_PLATFORM_ANDROID_EXTERNAL_VIEW_EMBEDDER_SURFACE_POOL_H_
 #define FLUTTER_SHELL_PLATFORM_ANDROID_EXTERNAL_VIEW_EMBEDDER_SURFACE_POOL_H_
 
+#include <memory>
 #include <mutex>
+#include <vector>
 
 #include "flutter/flow/surface.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/shell/platform/android/context/android_context.h"
 #include "flutter/shell/platform/android/surface/android_surface.h"
 
@@ -41,28 +44,51 @@ struct OverlayLayer {
   //
   // This may change when the overlay is recycled.
   intptr_t gr_context_key;
+
+  // The z-position the overlay was displayed at in the current or previous
+  // frame, or -1 if the overlay wasn't used in the previous frame.
+  //
+  // The pool hands out the same overlay for the same z-position in
+  // consecutive frames, so that frames that keep their platform view
+  // interleaving don't move overlays around.
+  int64_t z_position = -1;
 };
 
 class SurfacePool {
  public:
-  SurfacePool();
+  // If |platform_task_runner| is set, the Java methods that create and
+  // destroy the overlay surfaces are posted to it, so that the layers can be
+  // used on another thread. The pool never waits for those tasks.
+  explicit SurfacePool(
+      fml::RefPtr<fml::TaskRunner> platform_task_runner = nullptr);
 
   ~SurfacePool();
 
   // Gets a layer from the pool if available, or allocates a new one.
   // Finally, it marks the layer as used. That is, it increments
   // `available_layer_index_`.
+  //
+  // The layer used at |z_position| in the previous frame is preferred,
+  // followed by layers that weren't used in the previous frame.
+  //
+  // With a platform task runner, a surface that the pool doesn't have yet
+  // is created on the platform thread, and nullptr is returned until a later
+  // call finds it created.
   std::shared_ptr<OverlayLayer> GetLayer(
       GrDirectContext* gr_context,
       const AndroidContext& android_context,
       const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade,
-      const std::shared_ptr<AndroidSurfaceFactory>& surface_factory);
+      const std::shared_ptr<AndroidSurfaceFactory>& surface_factory,
+      int64_t z_position);
 
   // Gets the layers in the pool that aren't currently used.
   // This method doesn't mark the layers as unused.
   std::vector<std::shared_ptr<OverlayLayer>> GetUnusedLayers();
 
   // Marks the layers in the pool as available for reuse.
+  //
+  // The layers that weren't used in the current frame forget their
+  // z-position.
   void RecycleLayers();
 
   // Destroys all the layers in the pool.
@@ -103,8 +129,42 @@ class SurfacePool {
   // Used to guard public methods.
   std::mutex mutex_;
 
+  // The task runner the JNI calls of the pool are posted to, if any.
+  const fml::RefPtr<fml::TaskRunner> platform_task_runner_;
+
+  // The overlay surfaces requested from |platform_task_runner_|. Shared with
+  // the tasks that create them, which may outlive the pool.
+  struct SurfaceRequests {
+    std::mutex mutex;
+
+    // Incremented when the layers are destroyed. Surfaces requested before
+    // then are destroyed along with the layers, and dropped when created.
+    size_t generation = 0;
+
+    // The number of requested surfaces that haven't been used yet.
+    size_t pending = 0;
+
+    // The surfaces created for the requests, ready to be used.
+    std::vector<std::unique_ptr<PlatformViewAndroidJNI::OverlayMetadata>>
+        created;
+  };
+  const std::shared_ptr<SurfaceRequests> surface_requests_;
+
+  // The number of layers |GetLayer| couldn't provide in the current frame.
+  size_t missing_layer_count_ = 0;
+
   void DestroyLayersLocked(
       const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade);
+
+  // Creates a Java overlay surface, or takes one created on
+  // |platform_task_runner_| and requests another one if there is none.
+  std::unique_ptr<PlatformViewAndroidJNI::OverlayMetadata>
+  CreateOverlaySurfaceLocked(
+      const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade);
+
+  // Returns the index of the available layer that should be used at
+  // |z_position|, or `layers_.size()` if there are no available layers.
+  size_t FindAvailableLayerLocked(int64_t z_position) const;
 };
 
 }  // namespace flutter
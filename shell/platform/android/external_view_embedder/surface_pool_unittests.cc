@@ -6,6 +6,8 @@
 #include "flutter/shell/platform/android/external_view_embedder/surface_pool.h"
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
 #include "flutter/shell/platform/android/jni/jni_mock.h"
 #include "flutter/shell/platform/android/surface/android_surface_mock.h"
 #include "gmock/gmock.h"
@@ -59,7 +61,7 @@ TEST(SurfacePool, GetLayerAllocateOneLayer) {
         return android_surface_mock;
       });
   auto layer = pool->GetLayer(gr_context.get(), *android_context, jni_mock,
-                              surface_factory);
+                              surface_factory, /*z_position=*/0);
 
   ASSERT_TRUE(pool->HasLayers());
   ASSERT_NE(nullptr, layer);
@@ -90,7 +92,7 @@ TEST(SurfacePool, GetUnusedLayers) {
         return android_surface_mock;
       });
   auto layer = pool->GetLayer(gr_context.get(), *android_context, jni_mock,
-                              surface_factory);
+                              surface_factory, /*z_position=*/0);
   ASSERT_EQ(0UL, pool->GetUnusedLayers().size());
 
   pool->RecycleLayers();
@@ -129,12 +131,12 @@ TEST(SurfacePool, GetLayerRecycle) {
         return android_surface_mock;
       });
   auto layer_1 = pool->GetLayer(gr_context_1.get(), *android_context, jni_mock,
-                                surface_factory);
+                                surface_factory, /*z_position=*/0);
 
   pool->RecycleLayers();
 
   auto layer_2 = pool->GetLayer(gr_context_2.get(), *android_context, jni_mock,
-                                surface_factory);
+                                surface_factory, /*z_position=*/0);
 
   ASSERT_TRUE(pool->HasLayers());
   ASSERT_NE(nullptr, layer_1);
@@ -172,9 +174,9 @@ TEST(SurfacePool, GetLayerAllocateTwoLayers) {
         return android_surface_mock;
       });
   auto layer_1 = pool->GetLayer(gr_context.get(), *android_context, jni_mock,
-                                surface_factory);
+                                surface_factory, /*z_position=*/0);
   auto layer_2 = pool->GetLayer(gr_context.get(), *android_context, jni_mock,
-                                surface_factory);
+                                surface_factory, /*z_position=*/1);
 
   ASSERT_TRUE(pool->HasLayers());
   ASSERT_NE(nullptr, layer_1);
@@ -184,6 +186,68 @@ TEST(SurfacePool, GetLayerAllocateTwoLayers) {
   ASSERT_EQ(1, layer_2->id);
 }
 
+TEST(SurfacePool, GetLayerReusesLayerAtTheSameZPosition) {
+  auto pool = std::make_unique<SurfacePool>();
+
+  auto gr_context = GrDirectContext::MakeMock(nullptr);
+  auto android_context =
+      std::make_shared<AndroidContext>(AndroidRenderingAPI::kSoftware);
+
+  auto jni_mock = std::make_shared<JNIMock>();
+  auto window = fml::MakeRefCounted<AndroidNativeWindow>(nullptr);
+  EXPECT_CALL(*jni_mock, FlutterViewCreateOverlaySurface())
+      .Times(3)
+      .WillOnce(Return(
+          ByMove(std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
+              0, window))))
+      .WillOnce(Return(
+          ByMove(std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
+              1, window))))
+      .WillOnce(Return(
+          ByMove(std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
+              2, window))));
+
+  auto surface_factory =
+      std::make_shared<TestAndroidSurfaceFactory>([gr_context, window]() {
+        auto android_surface_mock = std::make_unique<AndroidSurfaceMock>();
+        EXPECT_CALL(*android_surface_mock, CreateGPUSurface(gr_context.get()));
+        EXPECT_CALL(*android_surface_mock, SetNativeWindow(window));
+        EXPECT_CALL(*android_surface_mock, IsValid()).WillOnce(Return(true));
+        return android_surface_mock;
+      });
+  auto get_layer = [&](int64_t z_position) {
+    return pool->GetLayer(gr_context.get(), *android_context, jni_mock,
+                          surface_factory, z_position);
+  };
+
+  // Frame 1 has overlays at z-positions 1 and 3.
+  auto layer_1 = get_layer(1);
+  auto layer_3 = get_layer(3);
+  pool->RecycleLayers();
+
+  // Frame 2 only has an overlay at z-position 3.
+  ASSERT_EQ(layer_3, get_layer(3));
+  pool->RecycleLayers();
+  ASSERT_EQ(-1, layer_1->z_position);
+
+  // Frame 3 has overlays at z-positions 0, 3 and 5. The layer that wasn't used
+  // in the previous frame is used before a new layer is allocated.
+  ASSERT_EQ(layer_1, get_layer(0));
+  ASSERT_EQ(layer_3, get_layer(3));
+  auto layer_5 = get_layer(5);
+  ASSERT_NE(layer_1, layer_5);
+  ASSERT_NE(layer_3, layer_5);
+  ASSERT_EQ(2, layer_5->id);
+  pool->RecycleLayers();
+
+  // Frame 4 has overlays at other z-positions, which reuse the layers
+  // nonetheless.
+  get_layer(2);
+  get_layer(4);
+  get_layer(6);
+  ASSERT_TRUE(pool->GetUnusedLayers().empty());
+}
+
 TEST(SurfacePool, DestroyLayers) {
   auto pool = std::make_unique<SurfacePool>();
   auto jni_mock = std::make_shared<JNIMock>();
@@ -210,7 +274,8 @@ TEST(SurfacePool, DestroyLayers) {
         EXPECT_CALL(*android_surface_mock, IsValid()).WillOnce(Return(true));
         return android_surface_mock;
       });
-  pool->GetLayer(gr_context.get(), *android_context, jni_mock, surface_factory);
+  pool->GetLayer(gr_context.get(), *android_context, jni_mock, surface_factory,
+                 /*z_position=*/0);
 
   EXPECT_CALL(*jni_mock, FlutterViewDestroyOverlaySurfaces());
 
@@ -249,7 +314,8 @@ TEST(SurfacePool, DestroyLayersFrameSizeChanged) {
 
   ASSERT_FALSE(pool->HasLayers());
 
-  pool->GetLayer(gr_context.get(), *android_context, jni_mock, surface_factory);
+  pool->GetLayer(gr_context.get(), *android_context, jni_mock, surface_factory,
+                 /*z_position=*/0);
 
   ASSERT_TRUE(pool->HasLayers());
 
@@ -260,11 +326,67 @@ TEST(SurfacePool, DestroyLayersFrameSizeChanged) {
       .WillOnce(Return(
           ByMove(std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
               1, window))));
-  pool->GetLayer(gr_context.get(), *android_context, jni_mock, surface_factory);
+  pool->GetLayer(gr_context.get(), *android_context, jni_mock, surface_factory,
+                 /*z_position=*/0);
 
   ASSERT_TRUE(pool->GetUnusedLayers().empty());
   ASSERT_TRUE(pool->HasLayers());
 }
 
+TEST(SurfacePool, GetLayerDoesNotWaitForThePlatformThread) {
+  fml::Thread platform_thread("platform");
+  auto pool = std::make_unique<SurfacePool>(platform_thread.GetTaskRunner());
+
+  auto gr_context = GrDirectContext::MakeMock(nullptr);
+  auto android_context =
+      std::make_shared<AndroidContext>(AndroidRenderingAPI::kSoftware);
+
+  auto jni_mock = std::make_shared<JNIMock>();
+  auto window = fml::MakeRefCounted<AndroidNativeWindow>(nullptr);
+  EXPECT_CALL(*jni_mock, FlutterViewCreateOverlaySurface())
+      .WillOnce(Return(
+          ByMove(std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
+              0, window))));
+
+  auto surface_factory =
+      std::make_shared<TestAndroidSurfaceFactory>([gr_context, window]() {
+        auto android_surface_mock = std::make_unique<AndroidSurfaceMock>();
+        EXPECT_CALL(*android_surface_mock, CreateGPUSurface(gr_context.get()));
+        EXPECT_CALL(*android_surface_mock, SetNativeWindow(window));
+        EXPECT_CALL(*android_surface_mock, IsValid()).WillOnce(Return(true));
+        return android_surface_mock;
+      });
+  auto get_layer = [&]() {
+    return pool->GetLayer(gr_context.get(), *android_context, jni_mock,
+                          surface_factory, /*z_position=*/0);
+  };
+  auto flush_platform_thread = [&]() {
+    fml::AutoResetWaitableEvent latch;
+    platform_thread.GetTaskRunner()->PostTask([&]() { latch.Signal(); });
+    latch.Wait();
+  };
+
+  // The platform thread may be waiting for the raster thread.
+  fml::AutoResetWaitableEvent platform_thread_blocked;
+  platform_thread.GetTaskRunner()->PostTask(
+      [&]() { platform_thread_blocked.Wait(); });
+  ASSERT_EQ(nullptr, get_layer());
+
+  // The surface is only requested once while it's being created.
+  pool->RecycleLayers();
+  ASSERT_EQ(nullptr, get_layer());
+  platform_thread_blocked.Signal();
+  flush_platform_thread();
+
+  pool->RecycleLayers();
+  ASSERT_NE(nullptr, get_layer());
+  ASSERT_TRUE(pool->HasLayers());
+
+  EXPECT_CALL(*jni_mock, FlutterViewDestroyOverlaySurfaces());
+  pool->DestroyLayers(jni_mock);
+  ASSERT_FALSE(pool->HasLayers());
+  flush_platform_thread();
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -10,6 +10,11 @@
 
 namespace flutter {
 
+// The number of hardware buffers whose imports are kept alive. This covers the
+// rings of the `ImageReader`s created by `FlutterRenderer` and of most video
+// decoders.
+static constexpr size_t kTextureCacheSize = 8;
+
 ImageExternalTextureVK::ImageExternalTextureVK(
     const std::shared_ptr<impeller::ContextVK>& impeller_context,
     int64_t id,
@@ -18,7 +23,9 @@ ImageExternalTextureVK::ImageExternalTextureVK(
     : ImageExternalTexture(id, image_texture_entry, jni_facade),
       impeller_context_(impeller_context) {}
 
-ImageExternalTextureVK::~ImageExternalTextureVK() {}
+ImageExternalTextureVK::~ImageExternalTextureVK() {
+  TrimTextureCache(0);
+}
 
 void ImageExternalTextureVK::Attach(PaintContext& context) {
   if (state_ == AttachmentState::kUninitialized) {
@@ -27,7 +34,9 @@ void ImageExternalTextureVK::Attach(PaintContext& context) {
   }
 }
 
-void ImageExternalTextureVK::Detach() {}
+void ImageExternalTextureVK::Detach() {
+  TrimTextureCache(0);
+}
 
 void ImageExternalTextureVK::ProcessFrame(PaintContext& context,
                                           const SkRect& bounds) {
@@ -40,31 +49,56 @@ void ImageExternalTextureVK::ProcessFrame(PaintContext& context,
   JavaLocalRef hardware_buffer = HardwareBufferFor(android_image_);
   AHardwareBuffer* latest_hardware_buffer = AHardwareBufferFor(hardware_buffer);
 
+  std::shared_ptr<impeller::TextureVK> texture =
+      GetOrImportTexture(latest_hardware_buffer);
+  dl_image_ = texture ? impeller::DlImageImpeller::Make(texture) : nullptr;
+  CloseHardwareBuffer(hardware_buffer);
+  // IMPORTANT: We only close the old image after texture stops referencing
+  // it.
+  CloseImage(old_android_image);
+}
+
+std::shared_ptr<impeller::TextureVK> ImageExternalTextureVK::GetOrImportTexture(
+    AHardwareBuffer* hardware_buffer) {
+  for (auto it = texture_cache_.begin(); it != texture_cache_.end(); ++it) {
+    if (it->hardware_buffer == hardware_buffer) {
+      texture_cache_.splice(texture_cache_.begin(), texture_cache_, it);
+      return it->texture;
+    }
+  }
+
   AHardwareBuffer_Desc hb_desc = {};
-  flutter::NDKHelpers::AHardwareBuffer_describe(latest_hardware_buffer,
-                                                &hb_desc);
+  flutter::NDKHelpers::AHardwareBuffer_describe(hardware_buffer, &hb_desc);
 
   impeller::TextureDescriptor desc;
   desc.storage_mode = impeller::StorageMode::kDevicePrivate;
-  desc.size = {static_cast<int>(bounds.width()),
-               static_cast<int>(bounds.height())};
+  desc.size = {static_cast<int>(hb_desc.width),
+               static_cast<int>(hb_desc.height)};
   // TODO(johnmccutchan): Use hb_desc to compute the correct format at runtime.
   desc.format = impeller::PixelFormat::kR8G8B8A8UNormInt;
   desc.mip_count = 1;
 
   auto texture_source =
       std::make_shared<impeller::AndroidHardwareBufferTextureSourceVK>(
-          desc, impeller_context_->GetDevice(), latest_hardware_buffer,
-          hb_desc);
+          desc, impeller_context_->GetDevice(), hardware_buffer, hb_desc);
+  if (!texture_source->IsValid()) {
+    FML_LOG(ERROR) << "Could not import the hardware buffer into Vulkan.";
+    return nullptr;
+  }
 
   auto texture =
       std::make_shared<impeller::TextureVK>(impeller_context_, texture_source);
+  NDKHelpers::AHardwareBuffer_acquire(hardware_buffer);
+  texture_cache_.push_front({hardware_buffer, texture});
+  TrimTextureCache(kTextureCacheSize);
+  return texture;
+}
 
-  dl_image_ = impeller::DlImageImpeller::Make(texture);
-  CloseHardwareBuffer(hardware_buffer);
-  // IMPORTANT: We only close the old image after texture stops referencing
-  // it.
-  CloseImage(old_android_image);
+void ImageExternalTextureVK::TrimTextureCache(size_t max_count) {
+  while (texture_cache_.size() > max_count) {
+    NDKHelpers::AHardwareBuffer_release(texture_cache_.back().hardware_buffer);
+    texture_cache_.pop_back();
+  }
 }
 
 }  // namespace flutter
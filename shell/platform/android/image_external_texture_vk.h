@@ -5,10 +5,13 @@
 #ifndef FLUTTER_SHELL_PLATFORM_ANDROID_IMAGE_EXTERNAL_TEXTURE_VK_H_
 #define FLUTTER_SHELL_PLATFORM_ANDROID_IMAGE_EXTERNAL_TEXTURE_VK_H_
 
+#include <list>
+
 #include "flutter/shell/platform/android/image_external_texture.h"
 
 #include "flutter/impeller/renderer/backend/vulkan/android_hardware_buffer_texture_source_vk.h"
 #include "flutter/impeller/renderer/backend/vulkan/context_vk.h"
+#include "flutter/impeller/renderer/backend/vulkan/texture_vk.h"
 #include "flutter/impeller/renderer/backend/vulkan/vk.h"
 #include "flutter/shell/platform/android/android_context_vulkan_impeller.h"
 
@@ -30,9 +33,33 @@ class ImageExternalTextureVK : public ImageExternalTexture {
   void ProcessFrame(PaintContext& context, const SkRect& bounds) override;
   void Detach() override;
 
+  // Returns the texture that wraps |hardware_buffer|, and only imports the
+  // buffer into Vulkan if it isn't in |texture_cache_|.
+  std::shared_ptr<impeller::TextureVK> GetOrImportTexture(
+      AHardwareBuffer* hardware_buffer);
+
+  // Releases the least recently used textures of |texture_cache_| until at
+  // most |max_count| remain.
+  void TrimTextureCache(size_t max_count);
+
   const std::shared_ptr<impeller::ContextVK> impeller_context_;
 
   fml::jni::ScopedJavaGlobalRef<jobject> android_image_;
+
+  struct CachedTexture {
+    // The buffer is acquired for as long as it's in the cache, so that its
+    // address can't be reused by another buffer.
+    AHardwareBuffer* hardware_buffer;
+    std::shared_ptr<impeller::TextureVK> texture;
+  };
+
+  // The textures of the buffers that were painted recently, the most recently
+  // used first.
+  //
+  // Producers such as `ImageReader` or `MediaCodec` cycle through a ring of
+  // buffers, so caching the imports avoids creating a `VkImage` and importing
+  // its memory for every frame.
+  std::list<CachedTexture> texture_cache_;
 };
 
 }  // namespace flutter
@@ -0,0 +1,141 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+package io.flutter.embedding.engine;
+
+import android.os.Handler;
+import android.os.Looper;
+import androidx.annotation.NonNull;
+import androidx.annotation.UiThread;
+import androidx.annotation.VisibleForTesting;
+import java.util.ArrayDeque;
+import java.util.Deque;
+
+/**
+ * Keeps a number of {@link io.flutter.embedding.engine.FlutterEngine}s of a {@link
+ * io.flutter.embedding.engine.FlutterEngineGroup} created and running, so that screens opened on
+ * demand can obtain one without waiting for it to start.
+ *
+ * <p>Every engine of the pool is created with the same {@link FlutterEngineGroup.Options}, so it
+ * has already run its Dart entrypoint and loaded its initial route by the time it is acquired.
+ * Screens that need a different route should push it through the engine's {@link
+ * io.flutter.embedding.engine.systemchannels.NavigationChannel} after acquiring the engine.
+ *
+ * <p>When an engine is acquired, the pool creates a replacement on a later main thread message, so
+ * that the cost of creating it is not added to the frame that opens the screen.
+ *
+ * <p>All methods must be called on the main thread.
+ */
+public class FlutterEnginePool {
+  @NonNull private final FlutterEngineGroup engineGroup;
+  @NonNull private final FlutterEngineGroup.Options options;
+  private final int size;
+  @NonNull private final Handler handler;
+
+  /* package */ @VisibleForTesting final Deque<FlutterEngine> idleEngines = new ArrayDeque<>();
+
+  private boolean isRefillScheduled = false;
+  private boolean isClosed = false;
+
+  /**
+   * Creates a pool that keeps {@code size} engines of {@code engineGroup} created with {@code
+   * options} ready. The pool starts creating them on the next main thread message.
+   */
+  @UiThread
+  public FlutterEnginePool(
+      @NonNull FlutterEngineGroup engineGroup,
+      @NonNull FlutterEngineGroup.Options options,
+      int size) {
+    this(engineGroup, options, size, new Handler(Looper.getMainLooper()));
+  }
+
+  @VisibleForTesting
+  /* package */ FlutterEnginePool(
+      @NonNull FlutterEngineGroup engineGroup,
+      @NonNull FlutterEngineGroup.Options options,
+      int size,
+      @NonNull Handler handler) {
+    if (size < 0) {
+      throw new IllegalArgumentException("The size of a FlutterEnginePool must not be negative.");
+    }
+    this.engineGroup = engineGroup;
+    this.options = options;
+    this.size = size;
+    this.handler = handler;
+    scheduleRefill();
+  }
+
+  /**
+   * Returns a running engine, and removes it from the pool.
+   *
+   * <p>If the pool has no idle engine, for example because engines were acquired faster than they
+   * could be replaced, a new engine is created synchronously.
+   *
+   * <p>The caller owns the returned engine and is responsible for destroying it.
+   */
+  @UiThread
+  @NonNull
+  public FlutterEngine acquire() {
+    if (isClosed) {
+      throw new IllegalStateException("Cannot acquire an engine from a closed FlutterEnginePool.");
+    }
+    FlutterEngine engine = idleEngines.pollFirst();
+    if (engine == null) {
+      engine = engineGroup.createAndRunEngine(options);
+    }
+    scheduleRefill();
+    return engine;
+  }
+
+  /** Returns the number of engines that are ready to be acquired. */
+  @UiThread
+  public int getIdleEngineCount() {
+    return idleEngines.size();
+  }
+
+  /**
+   * Destroys the engines that were not acquired, and stops creating new ones.
+   *
+   * <p>Engines that were acquired before are not affected.
+   */
+  @UiThread
+  public void close() {
+    isClosed = true;
+    while (!idleEngines.isEmpty()) {
+      idleEngines.pollFirst().destroy();
+    }
+  }
+
+  private void scheduleRefill() {
+    if (isRefillScheduled || isClosed || idleEngines.size() >= size) {
+      return;
+    }
+    isRefillScheduled = true;
+    handler.post(this::refill);
+  }
+
+  // Creates one engine per main thread message, so that filling a large pool doesn't stall the
+  // main thread.
+  private void refill() {
+    isRefillScheduled = false;
+    if (isClosed || idleEngines.size() >= size) {
+      return;
+    }
+    final FlutterEngine engine = engineGroup.createAndRunEngine(options);
+    engine.addEngineLifecycleListener(
+        new FlutterEngine.EngineLifecycleListener() {
+          @Override
+          public void onPreEngineRestart() {
+            // No-op. Not interested.
+          }
+
+          @Override
+          public void onEngineWillDestroy() {
+            idleEngines.remove(engine);
+          }
+        });
+    idleEngines.addLast(engine);
+    scheduleRefill();
+  }
+}
@@ -483,7 +483,8 @@ public class FlutterJNI {
    *
    * <p>Invoking this method will result in the release of all native-side resources that were set
    * up during {@link #attachToNative()} or {@link #spawn(String, String, String, List)}, or
-   * accumulated thereafter.
+   * accumulated thereafter. Those resources are released in the background, so this method does
+   * not wait for the engine threads to shut down.
    *
    * <p>It is permissible to re-attach this instance to native after detaching it from native.
    */
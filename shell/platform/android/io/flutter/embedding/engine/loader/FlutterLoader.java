@@ -47,6 +47,24 @@ public class FlutterLoader {
       "io.flutter.embedding.android.ImpellerBackend";
   private static final String IMPELLER_OPENGL_GPU_TRACING_DATA_KEY =
       "io.flutter.embedding.android.EnableOpenGLGPUTracing";
+  private static final String ASYNC_PLATFORM_VIEW_COMPOSITION_META_DATA_KEY =
+      "io.flutter.embedding.android.AsyncPlatformViewComposition";
+  private static final String VULKAN_PRESENT_MODE_META_DATA_KEY =
+      "io.flutter.embedding.android.VulkanPresentMode";
+  private static final String VULKAN_SWAPCHAIN_IMAGE_COUNT_META_DATA_KEY =
+      "io.flutter.embedding.android.VulkanSwapchainImageCount";
+
+  /**
+   * Meta-data keys of the OS scheduling settings of the engine threads, and the shell arguments
+   * they map to. See the `--platform-thread-policy` switch for the format of the values.
+   */
+  private static final String[][] THREAD_POLICY_META_DATA_KEYS = {
+    {"io.flutter.embedding.android.PlatformThreadPolicy", "--platform-thread-policy="},
+    {"io.flutter.embedding.android.UIThreadPolicy", "--ui-thread-policy="},
+    {"io.flutter.embedding.android.RasterThreadPolicy", "--raster-thread-policy="},
+    {"io.flutter.embedding.android.IOThreadPolicy", "--io-thread-policy="},
+    {"io.flutter.embedding.android.WorkerThreadPolicy", "--worker-thread-policy="},
+  };
 
   /**
    * Set whether leave or clean up the VM after the last shell shuts down. It can be set from app's
@@ -340,10 +358,27 @@ public class FlutterLoader {
         if (metaData.getBoolean(IMPELLER_OPENGL_GPU_TRACING_DATA_KEY, false)) {
           shellArgs.add("--enable-opengl-gpu-tracing");
         }
+        if (metaData.getBoolean(ASYNC_PLATFORM_VIEW_COMPOSITION_META_DATA_KEY, false)) {
+          shellArgs.add("--async-platform-view-composition");
+        }
         String backend = metaData.getString(IMPELLER_BACKEND_META_DATA_KEY);
         if (backend != null) {
           shellArgs.add("--impeller-backend=" + backend);
         }
+        String presentMode = metaData.getString(VULKAN_PRESENT_MODE_META_DATA_KEY);
+        if (presentMode != null) {
+          shellArgs.add("--vulkan-present-mode=" + presentMode);
+        }
+        int imageCount = metaData.getInt(VULKAN_SWAPCHAIN_IMAGE_COUNT_META_DATA_KEY, 0);
+        if (imageCount > 0) {
+          shellArgs.add("--vulkan-swapchain-image-count=" + imageCount);
+        }
+        for (String[] threadPolicy : THREAD_POLICY_META_DATA_KEYS) {
+          String policy = metaData.getString(threadPolicy[0]);
+          if (policy != null) {
+            shellArgs.add(threadPolicy[1] + policy);
+          }
+        }
       }
 
       final String leakVM = isLeakVM(metaData) ? "true" : "false";
@@ -38,8 +38,11 @@ constexpr int kMinimumAndroidApiLevelForVulkan = 29;
 
 AndroidSurfaceFactoryImpl::AndroidSurfaceFactoryImpl(
     const std::shared_ptr<AndroidContext>& context,
-    bool enable_impeller)
-    : android_context_(context), enable_impeller_(enable_impeller) {}
+    bool enable_impeller,
+    impeller::SwapchainSettingsVK vulkan_swapchain_settings)
+    : android_context_(context),
+      enable_impeller_(enable_impeller),
+      vulkan_swapchain_settings_(vulkan_swapchain_settings) {}
 
 AndroidSurfaceFactoryImpl::~AndroidSurfaceFactoryImpl() = default;
 
@@ -60,13 +63,32 @@ std::unique_ptr<AndroidSurface> AndroidSurfaceFactoryImpl::CreateSurface() {
       FML_DCHECK(enable_impeller_);
       return std::make_unique<AndroidSurfaceVulkanImpeller>(
           std::static_pointer_cast<AndroidContextVulkanImpeller>(
-              android_context_));
+              android_context_),
+          vulkan_swapchain_settings_);
     default:
       FML_DCHECK(false);
       return nullptr;
   }
 }
 
+static impeller::SwapchainSettingsVK GetVulkanSwapchainSettings(
+    const Settings& settings) {
+  impeller::SwapchainSettingsVK swapchain_settings;
+  swapchain_settings.image_count = settings.vulkan_swapchain_image_count;
+  const auto present_mode = settings.vulkan_present_mode.value_or("fifo");
+  if (present_mode == "fifo-relaxed") {
+    swapchain_settings.present_mode = vk::PresentModeKHR::eFifoRelaxed;
+  } else if (present_mode == "mailbox") {
+    swapchain_settings.present_mode = vk::PresentModeKHR::eMailbox;
+  } else if (present_mode == "immediate") {
+    swapchain_settings.present_mode = vk::PresentModeKHR::eImmediate;
+  } else if (present_mode != "fifo") {
+    FML_LOG(WARNING) << "Unknown Vulkan present mode \"" << present_mode
+                     << "\". Falling back to fifo.";
+  }
+  return swapchain_settings;
+}
+
 static std::shared_ptr<flutter::AndroidContext> CreateAndroidContext(
     bool use_software_rendering,
     const flutter::TaskRunners& task_runners,
@@ -175,9 +197,11 @@ PlatformViewAndroid::PlatformViewAndroid(
   if (android_context_) {
     FML_CHECK(android_context_->IsValid())
         << "Could not create surface from invalid Android context.";
+    const auto& settings = delegate.OnPlatformViewGetSettings();
     surface_factory_ = std::make_shared<AndroidSurfaceFactoryImpl>(
-        android_context_,                                     //
-        delegate.OnPlatformViewGetSettings().enable_impeller  //
+        android_context_,                     //
+        settings.enable_impeller,             //
+        GetVulkanSwapchainSettings(settings)  //
     );
     android_surface_ = surface_factory_->CreateSurface();
     FML_CHECK(android_surface_ && android_surface_->IsValid())
@@ -394,7 +418,8 @@ std::unique_ptr<Surface> PlatformViewAndroid::CreateRenderingSurface() {
 std::shared_ptr<ExternalViewEmbedder>
 PlatformViewAndroid::CreateExternalViewEmbedder() {
   return std::make_shared<AndroidExternalViewEmbedder>(
-      *android_context_, jni_facade_, surface_factory_, task_runners_);
+      *android_context_, jni_facade_, surface_factory_, task_runners_,
+      delegate_.OnPlatformViewGetSettings().async_platform_view_composition);
 }
 
 // |PlatformView|
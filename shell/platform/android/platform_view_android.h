@@ -13,6 +13,7 @@
 #include <android/hardware_buffer_jni.h>
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/platform/android/scoped_java_ref.h"
+#include "flutter/impeller/renderer/backend/vulkan/swapchain_vk.h"
 #include "flutter/lib/ui/window/platform_message.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/snapshot_surface_producer.h"
@@ -27,8 +28,10 @@ namespace flutter {
 
 class AndroidSurfaceFactoryImpl : public AndroidSurfaceFactory {
  public:
-  AndroidSurfaceFactoryImpl(const std::shared_ptr<AndroidContext>& context,
-                            bool enable_impeller);
+  AndroidSurfaceFactoryImpl(
+      const std::shared_ptr<AndroidContext>& context,
+      bool enable_impeller,
+      impeller::SwapchainSettingsVK vulkan_swapchain_settings = {});
 
   ~AndroidSurfaceFactoryImpl() override;
 
@@ -37,6 +40,7 @@ class AndroidSurfaceFactoryImpl : public AndroidSurfaceFactory {
  private:
   const std::shared_ptr<AndroidContext>& android_context_;
   const bool enable_impeller_;
+  const impeller::SwapchainSettingsVK vulkan_swapchain_settings_;
 };
 
 class PlatformViewAndroid final : public PlatformView {
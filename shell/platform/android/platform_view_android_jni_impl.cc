@@ -168,7 +168,8 @@ static jlong AttachJNI(JNIEnv* env, jclass clazz, jobject flutterJNI) {
 }
 
 static void DestroyJNI(JNIEnv* env, jobject jcaller, jlong shell_holder) {
-  delete ANDROID_SHELL_HOLDER;
+  AndroidShellHolder::DestroyAsync(
+      std::unique_ptr<AndroidShellHolder>(ANDROID_SHELL_HOLDER));
 }
 
 // Signature is similar to RunBundleAndSnapshotFromLibrary but it can't change
@@ -0,0 +1,93 @@
+package io.flutter.embedding.engine;
+
+import static android.os.Looper.getMainLooper;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertThrows;
+import static org.mockito.ArgumentMatchers.any;
+import static org.mockito.Mockito.mock;
+import static org.mockito.Mockito.never;
+import static org.mockito.Mockito.times;
+import static org.mockito.Mockito.verify;
+import static org.mockito.Mockito.when;
+import static org.robolectric.Shadows.shadowOf;
+
+import android.content.Context;
+import androidx.test.core.app.ApplicationProvider;
+import org.junit.Before;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+import org.robolectric.RobolectricTestRunner;
+import org.robolectric.annotation.Config;
+
+@Config(manifest = Config.NONE)
+@RunWith(RobolectricTestRunner.class)
+public class FlutterEnginePoolTest {
+  private final Context ctx = ApplicationProvider.getApplicationContext();
+  private FlutterEngineGroup engineGroup;
+  private FlutterEngineGroup.Options options;
+
+  @Before
+  public void setUp() {
+    engineGroup = mock(FlutterEngineGroup.class);
+    options = new FlutterEngineGroup.Options(ctx);
+    when(engineGroup.createAndRunEngine(any(FlutterEngineGroup.Options.class)))
+        .thenAnswer(invocation -> mock(FlutterEngine.class));
+  }
+
+  @Test
+  public void itFillsThePoolOnLaterMessages() {
+    FlutterEnginePool pool = new FlutterEnginePool(engineGroup, options, 2);
+    assertEquals(0, pool.getIdleEngineCount());
+
+    shadowOf(getMainLooper()).idle();
+    assertEquals(2, pool.getIdleEngineCount());
+    verify(engineGroup, times(2)).createAndRunEngine(options);
+  }
+
+  @Test
+  public void itReplacesAcquiredEngines() {
+    FlutterEnginePool pool = new FlutterEnginePool(engineGroup, options, 1);
+    shadowOf(getMainLooper()).idle();
+    FlutterEngine idleEngine = pool.idleEngines.peekFirst();
+
+    assertEquals(idleEngine, pool.acquire());
+    assertEquals(0, pool.getIdleEngineCount());
+    verify(engineGroup, times(1)).createAndRunEngine(options);
+
+    shadowOf(getMainLooper()).idle();
+    assertEquals(1, pool.getIdleEngineCount());
+    verify(engineGroup, times(2)).createAndRunEngine(options);
+  }
+
+  @Test
+  public void itCreatesAnEngineWhenThePoolIsEmpty() {
+    FlutterEnginePool pool = new FlutterEnginePool(engineGroup, options, 1);
+
+    assertNotNull(pool.acquire());
+    verify(engineGroup, times(1)).createAndRunEngine(options);
+  }
+
+  @Test
+  public void itDestroysIdleEnginesWhenClosed() {
+    FlutterEnginePool pool = new FlutterEnginePool(engineGroup, options, 1);
+    shadowOf(getMainLooper()).idle();
+    FlutterEngine idleEngine = pool.idleEngines.peekFirst();
+
+    pool.close();
+    verify(idleEngine, times(1)).destroy();
+    assertEquals(0, pool.getIdleEngineCount());
+    assertThrows(IllegalStateException.class, pool::acquire);
+
+    shadowOf(getMainLooper()).idle();
+    verify(engineGroup, times(1)).createAndRunEngine(options);
+  }
+
+  @Test
+  public void itDoesNotCreateEnginesForAnEmptyPool() {
+    new FlutterEnginePool(engineGroup, options, 0);
+    shadowOf(getMainLooper()).idle();
+
+    verify(engineGroup, never()).createAndRunEngine(any(FlutterEngineGroup.Options.class));
+  }
+}
@@ -215,6 +215,30 @@ public class FlutterLoaderTest {
     assertTrue(arguments.contains(enableImpellerArg));
   }
 
+  @Test
+  public void itSetsThreadPoliciesFromMetaData() {
+    FlutterJNI mockFlutterJNI = mock(FlutterJNI.class);
+    FlutterLoader flutterLoader = new FlutterLoader(mockFlutterJNI);
+    Bundle metaData = new Bundle();
+    metaData.putString("io.flutter.embedding.android.UIThreadPolicy", "nice=-10");
+    metaData.putString("io.flutter.embedding.android.RasterThreadPolicy", "affinity=performance");
+    ctx.getApplicationInfo().metaData = metaData;
+
+    FlutterLoader.Settings settings = new FlutterLoader.Settings();
+    assertFalse(flutterLoader.initialized());
+    flutterLoader.startInitialization(ctx, settings);
+    flutterLoader.ensureInitializationComplete(ctx, null);
+    shadowOf(getMainLooper()).idle();
+
+    ArgumentCaptor<String[]> shellArgsCaptor = ArgumentCaptor.forClass(String[].class);
+    verify(mockFlutterJNI, times(1))
+        .init(eq(ctx), shellArgsCaptor.capture(), anyString(), anyString(), anyString(), anyLong());
+    List<String> arguments = Arrays.asList(shellArgsCaptor.getValue());
+    assertTrue(arguments.contains("--ui-thread-policy=nice=-10"));
+    assertTrue(arguments.contains("--raster-thread-policy=affinity=performance"));
+    assertFalse(arguments.contains("--io-thread-policy="));
+  }
+
   @Test
   @TargetApi(23)
   @Config(sdk = 23)
@@ -19,6 +19,28 @@ constexpr int kHasScrollingAction =
     FlutterSemanticsAction::kFlutterSemanticsActionScrollUp |
     FlutterSemanticsAction::kFlutterSemanticsActionScrollDown;
 
+// Whether |data| is identical to the data of the node with the same ID in
+// |tree|, in which case the node needs no update.
+static bool IsNodeDataUnchanged(const ui::AXTree& tree,
+                                const ui::AXNodeData& data) {
+  const ui::AXNode* node = tree.GetFromId(data.id);
+  if (!node) {
+    return false;
+  }
+  const ui::AXNodeData& current = node->data();
+  return current.role == data.role && current.state == data.state &&
+         current.actions == data.actions &&
+         current.child_ids == data.child_ids &&
+         current.relative_bounds == data.relative_bounds &&
+         current.string_attributes == data.string_attributes &&
+         current.int_attributes == data.int_attributes &&
+         current.float_attributes == data.float_attributes &&
+         current.bool_attributes == data.bool_attributes &&
+         current.intlist_attributes == data.intlist_attributes &&
+         current.stringlist_attributes == data.stringlist_attributes &&
+         current.html_attributes == data.html_attributes;
+}
+
 // AccessibilityBridge
 AccessibilityBridge::AccessibilityBridge()
     : tree_(std::make_unique<ui::AXTree>()) {
@@ -81,13 +103,14 @@ void AccessibilityBridge::CommitUpdates() {
   // before child updates. If the root is in the update, it is guaranteed to
   // be the first node of the last list.
   std::vector<std::vector<SemanticsNode>> results;
+  update.nodes.reserve(pending_semantics_node_updates_.size());
   while (!pending_semantics_node_updates_.empty()) {
     auto begin = pending_semantics_node_updates_.begin();
-    SemanticsNode target = begin->second;
-    std::vector<SemanticsNode> sub_tree_list;
-    GetSubTreeList(target, sub_tree_list);
-    results.push_back(sub_tree_list);
+    SemanticsNode target = std::move(begin->second);
     pending_semantics_node_updates_.erase(begin);
+    std::vector<SemanticsNode> sub_tree_list;
+    GetSubTreeList(std::move(target), sub_tree_list);
+    results.push_back(std::move(sub_tree_list));
   }
 
   for (size_t i = results.size(); i > 0; i--) {
@@ -256,15 +279,16 @@ AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
 }
 
 // Private method.
-void AccessibilityBridge::GetSubTreeList(const SemanticsNode& target,
+void AccessibilityBridge::GetSubTreeList(SemanticsNode target,
                                          std::vector<SemanticsNode>& result) {
-  result.push_back(target);
-  for (int32_t child : target.children_in_traversal_order) {
+  const std::vector<int32_t> children = target.children_in_traversal_order;
+  result.push_back(std::move(target));
+  for (int32_t child : children) {
     auto iter = pending_semantics_node_updates_.find(child);
     if (iter != pending_semantics_node_updates_.end()) {
-      SemanticsNode node = iter->second;
-      GetSubTreeList(node, result);
+      SemanticsNode node = std::move(iter->second);
       pending_semantics_node_updates_.erase(iter);
+      GetSubTreeList(std::move(node), result);
     }
   }
 }
@@ -295,7 +319,13 @@ void AccessibilityBridge::ConvertFlutterUpdate(const SemanticsNode& node,
     node_data.child_ids.push_back(child);
   }
   SetTreeData(node, tree_update);
-  tree_update.nodes.push_back(node_data);
+  // The framework sends every node it marked dirty, which includes nodes
+  // whose semantics didn't change in the end. Leaving those out avoids
+  // rebuilding them in the tree and diffing them for events.
+  if (IsNodeDataUnchanged(*tree_, node_data)) {
+    return;
+  }
+  tree_update.nodes.push_back(std::move(node_data));
 }
 
 void AccessibilityBridge::SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
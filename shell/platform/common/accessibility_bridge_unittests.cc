@@ -205,6 +205,59 @@ TEST(AccessibilityBridgeTest, CanFireChildrenChangedCorrectly) {
               Contains(ui::AXEventGenerator::Event::SUBTREE_CREATED));
 }
 
+// Counts the nodes whose data a ui::AXTree update changed.
+class NodeDataChangeCounter : public ui::AXTreeObserver {
+ public:
+  void OnNodeDataChanged(ui::AXTree* tree,
+                         const ui::AXNodeData& old_node_data,
+                         const ui::AXNodeData& new_node_data) override {
+    changed_node_count++;
+  }
+
+  int changed_node_count = 0;
+};
+
+TEST(AccessibilityBridgeTest, SkipsUnchangedNodes) {
+  std::shared_ptr<TestAccessibilityBridge> bridge =
+      std::make_shared<TestAccessibilityBridge>();
+
+  std::vector<int32_t> children{1, 2};
+  FlutterSemanticsNode2 root = CreateSemanticsNode(0, "root", &children);
+  FlutterSemanticsNode2 child1 = CreateSemanticsNode(1, "child 1");
+  FlutterSemanticsNode2 child2 = CreateSemanticsNode(2, "child 2");
+
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+  bridge->accessibility_events.clear();
+
+  NodeDataChangeCounter counter;
+  bridge->GetTree()->AddObserver(&counter);
+
+  // Resend the same nodes, as the framework does for nodes that were marked
+  // dirty without their semantics changing.
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+
+  EXPECT_EQ(counter.changed_node_count, 0);
+  EXPECT_TRUE(bridge->accessibility_events.empty());
+
+  // A changed node is still updated.
+  FlutterSemanticsNode2 new_child1 = CreateSemanticsNode(1, "new child 1");
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(new_child1);
+  bridge->CommitUpdates();
+
+  EXPECT_EQ(counter.changed_node_count, 1);
+  auto child1_node = bridge->GetFlutterPlatformNodeDelegateFromID(1).lock();
+  EXPECT_EQ(child1_node->GetName(), "new child 1");
+
+  bridge->GetTree()->RemoveObserver(&counter);
+}
+
 TEST(AccessibilityBridgeTest, CanHandleSelectionChangeCorrectly) {
   std::shared_ptr<TestAccessibilityBridge> bridge =
       std::make_shared<TestAccessibilityBridge>();
@@ -36,6 +36,8 @@ class BinaryMessengerImpl : public BinaryMessenger {
   void SetMessageHandler(const std::string& channel,
                          BinaryMessageHandler handler) override;
 
+  using BinaryMessenger::SetMessageHandler;
+
  private:
   // Handle for interacting with the C API.
   FlutterDesktopMessengerRef messenger_;
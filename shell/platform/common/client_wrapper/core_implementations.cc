@@ -21,6 +21,7 @@
 #include "include/flutter/engine_method_result.h"
 #include "include/flutter/method_channel.h"
 #include "include/flutter/standard_method_codec.h"
+#include "include/flutter/task_queue.h"
 #include "texture_registrar_impl.h"
 
 namespace flutter {
@@ -129,6 +130,45 @@ void BinaryMessengerImpl::SetMessageHandler(const std::string& channel,
                                      ForwardToHandler, message_handler);
 }
 
+// ========== task_queue.h ==========
+
+BackgroundTaskQueue::BackgroundTaskQueue()
+    : thread_(&BackgroundTaskQueue::Run, this) {}
+
+BackgroundTaskQueue::~BackgroundTaskQueue() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  tasks_available_.notify_one();
+  thread_.join();
+}
+
+void BackgroundTaskQueue::PostTask(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  tasks_available_.notify_one();
+}
+
+void BackgroundTaskQueue::Run() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      tasks_available_.wait(lock,
+                            [this] { return stopping_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
 // ========== engine_method_result.h ==========
 
 namespace internal {
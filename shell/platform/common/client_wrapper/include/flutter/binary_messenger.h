@@ -6,7 +6,12 @@
 #define FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_BINARY_MESSENGER_H_
 
 #include <functional>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
+
+#include "task_queue.h"
 
 namespace flutter {
 
@@ -45,6 +50,35 @@ class BinaryMessenger {
   // existing handler.
   virtual void SetMessageHandler(const std::string& channel,
                                  BinaryMessageHandler handler) = 0;
+
+  // Registers a message handler for incoming binary messages from the Flutter
+  // side on the specified channel, which is run on |task_queue| instead of the
+  // platform thread.
+  //
+  // The handler receives a copy of each message and may reply from the task
+  // queue. If |task_queue| is null, this is the same as the overload above.
+  void SetMessageHandler(const std::string& channel,
+                         BinaryMessageHandler handler,
+                         std::shared_ptr<TaskQueue> task_queue) {
+    if (!handler || !task_queue) {
+      SetMessageHandler(channel, std::move(handler));
+      return;
+    }
+    // Tasks only hold the wrapped handler, so that the queue is never
+    // destroyed by one of its own tasks.
+    SetMessageHandler(
+        channel, [handler = std::move(handler),
+                  task_queue = std::move(task_queue)](
+                     const uint8_t* message, size_t message_size,
+                     BinaryReply reply) {
+          std::vector<uint8_t> message_copy(message, message + message_size);
+          task_queue->PostTask([handler, message_copy = std::move(message_copy),
+                                reply = std::move(reply)]() {
+            handler(message_copy.empty() ? nullptr : message_copy.data(),
+                    message_copy.size(), reply);
+          });
+        });
+  }
 };
 
 }  // namespace flutter
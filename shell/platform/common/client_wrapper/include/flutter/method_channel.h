@@ -6,7 +6,9 @@
 #define FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_METHOD_CHANNEL_H_
 
 #include <iostream>
+#include <memory>
 #include <string>
+#include <utility>
 
 #include "basic_message_channel.h"
 #include "binary_messenger.h"
@@ -40,6 +42,17 @@ class MethodChannel {
                 const MethodCodec<T>* codec)
       : messenger_(messenger), name_(name), codec_(codec) {}
 
+  // Creates an instance like the constructor above, which decodes and handles
+  // incoming method calls on |task_queue| instead of the platform thread.
+  MethodChannel(BinaryMessenger* messenger,
+                const std::string& name,
+                const MethodCodec<T>* codec,
+                std::shared_ptr<TaskQueue> task_queue)
+      : messenger_(messenger),
+        name_(name),
+        codec_(codec),
+        task_queue_(std::move(task_queue)) {}
+
   ~MethodChannel() = default;
 
   // Prevent copying.
@@ -120,7 +133,8 @@ class MethodChannel {
       }
       handler(*method_call, std::move(result));
     };
-    messenger_->SetMessageHandler(name_, std::move(binary_handler));
+    messenger_->SetMessageHandler(name_, std::move(binary_handler),
+                                  task_queue_);
   }
 
   // Adjusts the number of messages that will get buffered when sending messages
@@ -144,6 +158,7 @@ class MethodChannel {
   BinaryMessenger* messenger_;
   std::string name_;
   const MethodCodec<T>* codec_;
+  std::shared_ptr<TaskQueue> task_queue_;
 };
 
 }  // namespace flutter
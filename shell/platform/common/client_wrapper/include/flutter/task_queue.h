@@ -0,0 +1,61 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_TASK_QUEUE_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_TASK_QUEUE_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace flutter {
+
+// A queue of tasks that message handlers can be run on instead of the
+// platform thread.
+//
+// See BinaryMessenger::SetMessageHandler.
+class TaskQueue {
+ public:
+  virtual ~TaskQueue() = default;
+
+  // Schedules |task| to be run. Tasks must be run one at a time, in the order
+  // they were posted.
+  virtual void PostTask(std::function<void()> task) = 0;
+};
+
+// A TaskQueue that runs its tasks on a thread that it owns.
+//
+// Tasks that are still queued when the queue is destroyed are run before its
+// thread exits. The queue must not be destroyed by one of its own tasks.
+class BackgroundTaskQueue : public TaskQueue {
+ public:
+  BackgroundTaskQueue();
+
+  virtual ~BackgroundTaskQueue();
+
+  // Prevent copying.
+  BackgroundTaskQueue(BackgroundTaskQueue const&) = delete;
+  BackgroundTaskQueue& operator=(BackgroundTaskQueue const&) = delete;
+
+  // |flutter::TaskQueue|
+  void PostTask(std::function<void()> task) override;
+
+ private:
+  // Runs tasks on |thread_| until the queue is destroyed.
+  void Run();
+
+  std::mutex mutex_;
+  std::condition_variable tasks_available_;
+  std::deque<std::function<void()>> tasks_;
+  bool stopping_ = false;
+
+  // Declared last so that it starts once the other members are initialized.
+  std::thread thread_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_TASK_QUEUE_H_
@@ -4,8 +4,10 @@
 
 #include "flutter/shell/platform/common/client_wrapper/include/flutter/method_channel.h"
 
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "flutter/shell/platform/common/client_wrapper/include/flutter/binary_messenger.h"
 #include "flutter/shell/platform/common/client_wrapper/include/flutter/method_result_functions.h"
@@ -55,6 +57,19 @@ class TestBinaryMessenger : public BinaryMessenger {
   mutable std::vector<uint8_t> last_message_;
 };
 
+// A task queue that runs tasks when the test asks it to.
+class TestTaskQueue : public TaskQueue {
+ public:
+  void PostTask(std::function<void()> task) override {
+    tasks_.push_back(std::move(task));
+  }
+
+  std::vector<std::function<void()>>& tasks() { return tasks_; }
+
+ private:
+  std::vector<std::function<void()>> tasks_;
+};
+
 }  // namespace
 
 // Tests that SetMethodCallHandler sets a handler that correctly interacts with
@@ -88,6 +103,40 @@ TEST(MethodChannelTest, Registration) {
   EXPECT_TRUE(callback_called);
 }
 
+// Tests that a channel with a task queue handles method calls on that queue.
+TEST(MethodChannelTest, HandlesCallsOnTaskQueue) {
+  TestBinaryMessenger messenger;
+  auto task_queue = std::make_shared<TestTaskQueue>();
+  const std::string channel_name("some_channel");
+  const StandardMethodCodec& codec = StandardMethodCodec::GetInstance();
+  MethodChannel channel(&messenger, channel_name, &codec, task_queue);
+
+  bool callback_called = false;
+  const std::string method_name("hello");
+  channel.SetMethodCallHandler(
+      [&callback_called, method_name](const auto& call, auto result) {
+        callback_called = true;
+        EXPECT_EQ(call.method_name(), method_name);
+        result->Success();
+      });
+  ASSERT_NE(messenger.last_message_handler(), nullptr);
+
+  MethodCall<> call(method_name, nullptr);
+  auto message = codec.EncodeMethodCall(call);
+  bool replied = false;
+  messenger.last_message_handler()(
+      message->data(), message->size(),
+      [&replied](const uint8_t* reply, size_t reply_size) { replied = true; });
+  // The handler gets a copy of the message, so the original may be freed.
+  message.reset();
+  EXPECT_FALSE(callback_called);
+
+  ASSERT_EQ(task_queue->tasks().size(), 1u);
+  task_queue->tasks()[0]();
+  EXPECT_TRUE(callback_called);
+  EXPECT_TRUE(replied);
+}
+
 // Tests that SetMethodCallHandler with a null handler unregisters the handler.
 TEST(MethodChannelTest, Unregistration) {
   TestBinaryMessenger messenger;
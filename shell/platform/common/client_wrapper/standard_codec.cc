@@ -12,6 +12,7 @@
 #include <iostream>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "byte_buffer_streams.h"
@@ -78,6 +79,82 @@ EncodedType EncodedTypeForValue(const EncodableValue& value) {
   return EncodedType::kNull;
 }
 
+// Returns the number of bytes needed to write a size with WriteSize.
+size_t EncodedSizeOfSize(size_t size) {
+  return size < 254 ? 1 : (size <= 0xffff ? 3 : 5);
+}
+
+// Returns the number of bytes needed to write a typed list of |count|
+// elements, counting the most alignment padding that may be needed.
+template <typename T>
+size_t EncodedSizeOfVector(size_t count) {
+  return EncodedSizeOfSize(count) + (sizeof(T) - 1) + count * sizeof(T);
+}
+
+// Returns an upper bound of the number of bytes that WriteValue writes for
+// |value|, used to allocate the output buffer once.
+//
+// Custom values are written by codec extensions, so they are counted as their
+// type byte only and may still cause the buffer to grow.
+size_t EncodedSizeEstimate(const EncodableValue& value) {
+  // The type byte.
+  size_t size = 1;
+  switch (value.index()) {
+    case 2:
+      size += sizeof(int32_t);
+      break;
+    case 3:
+      size += sizeof(int64_t);
+      break;
+    case 4:
+      size += 7 + sizeof(double);
+      break;
+    case 5: {
+      size_t length = std::get<std::string>(value).size();
+      size += EncodedSizeOfSize(length) + length;
+      break;
+    }
+    case 6:
+      size += EncodedSizeOfVector<uint8_t>(
+          std::get<std::vector<uint8_t>>(value).size());
+      break;
+    case 7:
+      size += EncodedSizeOfVector<int32_t>(
+          std::get<std::vector<int32_t>>(value).size());
+      break;
+    case 8:
+      size += EncodedSizeOfVector<int64_t>(
+          std::get<std::vector<int64_t>>(value).size());
+      break;
+    case 9:
+      size += EncodedSizeOfVector<double>(
+          std::get<std::vector<double>>(value).size());
+      break;
+    case 10: {
+      const auto& list = std::get<EncodableList>(value);
+      size += EncodedSizeOfSize(list.size());
+      for (const auto& item : list) {
+        size += EncodedSizeEstimate(item);
+      }
+      break;
+    }
+    case 11: {
+      const auto& map = std::get<EncodableMap>(value);
+      size += EncodedSizeOfSize(map.size());
+      for (const auto& pair : map) {
+        size += EncodedSizeEstimate(pair.first) +
+                EncodedSizeEstimate(pair.second);
+      }
+      break;
+    }
+    case 13:
+      size += EncodedSizeOfVector<float>(
+          std::get<std::vector<float>>(value).size());
+      break;
+  }
+  return size;
+}
+
 }  // namespace
 
 StandardCodecSerializer::StandardCodecSerializer() = default;
@@ -188,7 +265,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
       std::string string_value;
       string_value.resize(size);
       stream->ReadBytes(reinterpret_cast<uint8_t*>(&string_value[0]), size);
-      return EncodableValue(string_value);
+      return EncodableValue(std::move(string_value));
     }
     case EncodedType::kUInt8List:
       return ReadVector<uint8_t>(stream);
@@ -205,7 +282,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
       for (size_t i = 0; i < length; ++i) {
         list_value.push_back(ReadValue(stream));
       }
-      return EncodableValue(list_value);
+      return EncodableValue(std::move(list_value));
     }
     case EncodedType::kMap: {
       size_t length = ReadSize(stream);
@@ -215,7 +292,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
         EncodableValue value = ReadValue(stream);
         map_value.emplace(std::move(key), std::move(value));
       }
-      return EncodableValue(map_value);
+      return EncodableValue(std::move(map_value));
     }
     case EncodedType::kFloat32List: {
       return ReadVector<float>(stream);
@@ -268,11 +345,11 @@ EncodableValue StandardCodecSerializer::ReadVector(
   }
   stream->ReadBytes(reinterpret_cast<uint8_t*>(vector.data()),
                     count * type_size);
-  return EncodableValue(vector);
+  return EncodableValue(std::move(vector));
 }
 
 template <typename T>
-void StandardCodecSerializer::WriteVector(const std::vector<T> vector,
+void StandardCodecSerializer::WriteVector(const std::vector<T>& vector,
                                           ByteStreamWriter* stream) const {
   size_t count = vector.size();
   WriteSize(count, stream);
@@ -329,6 +406,7 @@ std::unique_ptr<std::vector<uint8_t>>
 StandardMessageCodec::EncodeMessageInternal(
     const EncodableValue& message) const {
   auto encoded = std::make_unique<std::vector<uint8_t>>();
+  encoded->reserve(EncodedSizeEstimate(message));
   ByteBufferStreamWriter stream(encoded.get());
   serializer_->WriteValue(message, &stream);
   return encoded;
@@ -382,9 +460,14 @@ StandardMethodCodec::DecodeMethodCallInternal(const uint8_t* message,
 std::unique_ptr<std::vector<uint8_t>>
 StandardMethodCodec::EncodeMethodCallInternal(
     const MethodCall<EncodableValue>& method_call) const {
+  EncodableValue method_name(method_call.method_name());
   auto encoded = std::make_unique<std::vector<uint8_t>>();
+  encoded->reserve(EncodedSizeEstimate(method_name) +
+                   (method_call.arguments()
+                        ? EncodedSizeEstimate(*method_call.arguments())
+                        : 1));
   ByteBufferStreamWriter stream(encoded.get());
-  serializer_->WriteValue(EncodableValue(method_call.method_name()), &stream);
+  serializer_->WriteValue(method_name, &stream);
   if (method_call.arguments()) {
     serializer_->WriteValue(*method_call.arguments(), &stream);
   } else {
@@ -397,6 +480,7 @@ std::unique_ptr<std::vector<uint8_t>>
 StandardMethodCodec::EncodeSuccessEnvelopeInternal(
     const EncodableValue* result) const {
   auto encoded = std::make_unique<std::vector<uint8_t>>();
+  encoded->reserve(1 + (result ? EncodedSizeEstimate(*result) : 1));
   ByteBufferStreamWriter stream(encoded.get());
   stream.WriteByte(0);
   if (result) {
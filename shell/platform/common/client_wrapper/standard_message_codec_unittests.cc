@@ -227,6 +227,23 @@ TEST(StandardMessageCodec, CanEncodeAndDecodeFloat64Array) {
   CheckEncodeDecode(value, bytes);
 }
 
+TEST(StandardMessageCodec, EncodesLargeTypedListsInOneAllocation) {
+  EncodableValue value(EncodableList{
+      EncodableValue(1),
+      EncodableValue(std::vector<double>(100000, 0.5)),
+      EncodableValue(std::vector<int32_t>(100000, 7)),
+  });
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance();
+  auto encoded = codec.EncodeMessage(value);
+  ASSERT_TRUE(encoded);
+  // The buffer is reserved up front, allowing for alignment padding that
+  // turned out not to be needed.
+  EXPECT_LE(encoded->capacity() - encoded->size(), 16u);
+
+  auto decoded = codec.DecodeMessage(*encoded);
+  EXPECT_EQ(value, *decoded);
+}
+
 TEST(StandardMessageCodec, CanEncodeAndDecodeSimpleCustomType) {
   std::vector<uint8_t> bytes = {0x80, 0x09, 0x00, 0x00, 0x00,
                                 0x10, 0x00, 0x00, 0x00};
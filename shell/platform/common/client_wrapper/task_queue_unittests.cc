@@ -0,0 +1,36 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/task_queue.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+// Tests that a background task queue runs its tasks in order on its own thread,
+// including those still queued when it is destroyed.
+TEST(BackgroundTaskQueueTest, RunsTasksInOrderOnItsThread) {
+  std::vector<int> order;
+  std::vector<std::thread::id> thread_ids;
+  {
+    BackgroundTaskQueue task_queue;
+    for (int i = 0; i < 3; i++) {
+      task_queue.PostTask([&order, &thread_ids, i]() {
+        order.push_back(i);
+        thread_ids.push_back(std::this_thread::get_id());
+      });
+    }
+  }
+
+  EXPECT_EQ(order, std::vector<int>({0, 1, 2}));
+  ASSERT_EQ(thread_ids.size(), 3u);
+  EXPECT_NE(thread_ids[0], std::this_thread::get_id());
+  EXPECT_EQ(thread_ids[1], thread_ids[0]);
+  EXPECT_EQ(thread_ids[2], thread_ids[0]);
+}
+
+}  // namespace flutter
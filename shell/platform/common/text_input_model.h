@@ -185,6 +185,12 @@ class TextInputModel {
   // Gets the current text as UTF-8.
   std::string GetText() const;
 
+  // Gets the current text as UTF-16.
+  //
+  // Unlike |GetText|, this neither converts nor copies the text, so prefer it
+  // when the caller needs UTF-16 anyway.
+  const std::u16string& GetUtf16Text() const { return text_; }
+
   // Gets the cursor position as a byte offset in UTF-8 string returned from
   // GetText().
   int GetCursorOffset() const;
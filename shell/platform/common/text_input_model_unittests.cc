@@ -1704,6 +1704,14 @@ TEST(TextInputModel, GetCursorOffset) {
   EXPECT_EQ(model->GetCursorOffset(), 10);
 }
 
+TEST(TextInputModel, GetUtf16Text) {
+  auto model = std::make_unique<TextInputModel>();
+  model->SetText("$¢€𐍈");
+  EXPECT_EQ(model->GetUtf16Text(), u"$¢€𐍈");
+  model->AddText(u"A");
+  EXPECT_EQ(model->GetUtf16Text(), u"A$¢€𐍈");
+}
+
 TEST(TextInputModel, GetCursorOffsetSelection) {
   auto model = std::make_unique<TextInputModel>();
   model->SetText("ABCDE");
@@ -27,6 +27,13 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (instancetype)init:(const std::shared_ptr<const fml::SyncSwitch>&)is_gpu_disabled_sync_switch;
 
+/**
+ * Initializes a FlutterDarwinContextMetalImpeller that looks up and records compiled pipelines in
+ * the given binary archives.
+ */
+- (instancetype)init:(const std::shared_ptr<const fml::SyncSwitch>&)is_gpu_disabled_sync_switch
+    pipelineArchives:(const impeller::PipelineArchivesMTL&)pipelineArchives;
+
 /**
  * Creates an external texture with the specified ID and contents.
  */
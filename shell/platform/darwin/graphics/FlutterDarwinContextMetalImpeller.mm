@@ -20,7 +20,8 @@
 FLUTTER_ASSERT_ARC
 
 static std::shared_ptr<impeller::ContextMTL> CreateImpellerContext(
-    const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch) {
+    const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch,
+    const impeller::PipelineArchivesMTL& pipeline_archives) {
   std::vector<std::shared_ptr<fml::Mapping>> shader_mappings = {
       std::make_shared<fml::NonOwnedMapping>(impeller_entity_shaders_data,
                                              impeller_entity_shaders_length),
@@ -34,7 +35,7 @@ static std::shared_ptr<impeller::ContextMTL> CreateImpellerContext(
                                              impeller_framebuffer_blend_shaders_length),
   };
   auto context = impeller::ContextMTL::Create(shader_mappings, is_gpu_disabled_sync_switch,
-                                              "Impeller Library");
+                                              "Impeller Library", pipeline_archives);
   if (!context) {
     FML_LOG(ERROR) << "Could not create Metal Impeller Context.";
     return nullptr;
@@ -47,9 +48,14 @@ static std::shared_ptr<impeller::ContextMTL> CreateImpellerContext(
 @implementation FlutterDarwinContextMetalImpeller
 
 - (instancetype)init:(const std::shared_ptr<const fml::SyncSwitch>&)is_gpu_disabled_sync_switch {
+  return [self init:is_gpu_disabled_sync_switch pipelineArchives:impeller::PipelineArchivesMTL()];
+}
+
+- (instancetype)init:(const std::shared_ptr<const fml::SyncSwitch>&)is_gpu_disabled_sync_switch
+    pipelineArchives:(const impeller::PipelineArchivesMTL&)pipelineArchives {
   self = [super init];
   if (self != nil) {
-    _context = CreateImpellerContext(is_gpu_disabled_sync_switch);
+    _context = CreateImpellerContext(is_gpu_disabled_sync_switch, pipelineArchives);
     id<MTLDevice> device = _context->GetMTLDevice();
     if (!device) {
       FML_DLOG(ERROR) << "Could not acquire Metal device.";
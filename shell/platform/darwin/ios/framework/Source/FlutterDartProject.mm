@@ -200,6 +200,16 @@ flutter::Settings FLTDefaultSettingsForBundle(NSBundle* bundle, NSProcessInfo* p
     }
   }
 
+  // Binary archives of compiled pipelines that ship with the assets, harvested with
+  // --impeller-pipeline-archive-harvest-path.
+  NSArray* pipelineArchives =
+      [mainBundle objectForInfoDictionaryKey:@"FLTImpellerPipelineArchives"];
+  for (id pipelineArchive in pipelineArchives) {
+    if ([pipelineArchive isKindOfClass:[NSString class]]) {
+      settings.impeller_pipeline_archives.push_back([pipelineArchive UTF8String]);
+    }
+  }
+
   NSNumber* enableTraceSystrace = [mainBundle objectForInfoDictionaryKey:@"FLTTraceSystrace"];
   // Change the default only if the option is present.
   if (enableTraceSystrace != nil) {
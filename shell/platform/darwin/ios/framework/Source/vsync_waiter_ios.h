@@ -60,6 +60,12 @@
 
 - (void)setMaxRefreshRate:(double)refreshRate;
 
+//------------------------------------------------------------------------------
+/// @brief      Lowers the frame rate of the display link to the range requested by the content on
+///             screen. A range with a preferred rate of zero restores the maximum refresh rate.
+///
+- (void)setFrameRateRange:(const flutter::VsyncWaiter::FrameRateRange&)range;
+
 @end
 
 namespace flutter {
@@ -80,6 +86,10 @@ class VsyncWaiterIOS final : public VsyncWaiter, public VariableRefreshRateRepor
   // Made public for testing.
   void AwaitVSync() override;
 
+  // |VsyncWaiter|
+  // Made public for testing.
+  void OnFrameRateRangeChanged(const FrameRateRange& range) override;
+
  private:
   fml::scoped_nsobject<VSyncClient> client_;
   double max_refresh_rate_;
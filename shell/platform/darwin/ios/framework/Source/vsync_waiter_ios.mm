@@ -62,6 +62,11 @@ void VsyncWaiterIOS::AwaitVSync() {
   [client_.get() await];
 }
 
+// |VsyncWaiter|
+void VsyncWaiterIOS::OnFrameRateRangeChanged(const FrameRateRange& range) {
+  [client_.get() setFrameRateRange:range];
+}
+
 // |VariableRefreshRateReporter|
 double VsyncWaiterIOS::GetRefreshRate() const {
   return [client_.get() getRefreshRate];
@@ -77,6 +82,8 @@ fml::scoped_nsobject<VSyncClient> VsyncWaiterIOS::GetVsyncClient() const {
   flutter::VsyncWaiter::Callback callback_;
   fml::scoped_nsobject<CADisplayLink> display_link_;
   double current_refresh_rate_;
+  double max_refresh_rate_;
+  flutter::VsyncWaiter::FrameRateRange frame_rate_range_;
 }
 
 - (instancetype)initWithTaskRunner:(fml::RefPtr<fml::TaskRunner>)task_runner
@@ -105,16 +112,34 @@ fml::scoped_nsobject<VSyncClient> VsyncWaiterIOS::GetVsyncClient() const {
 }
 
 - (void)setMaxRefreshRate:(double)refreshRate {
+  max_refresh_rate_ = refreshRate;
+  [self updatePreferredFrameRateRange];
+}
+
+- (void)setFrameRateRange:(const flutter::VsyncWaiter::FrameRateRange&)range {
+  frame_rate_range_ = range;
+  [self updatePreferredFrameRateRange];
+}
+
+- (void)updatePreferredFrameRateRange {
   if (!DisplayLinkManager.maxRefreshRateEnabledOnIPhone) {
+    // The display link runs at 60Hz. The vsync waiter skips vsyncs for lower preferred rates.
     return;
   }
-  double maxFrameRate = fmax(refreshRate, 60);
+  double maxFrameRate = fmax(max_refresh_rate_, 60);
   double minFrameRate = fmax(maxFrameRate / 2, 60);
+  double preferredFrameRate = maxFrameRate;
+  if (frame_rate_range_.preferred > 0) {
+    // The content asked for a lower rate, which may be below 60Hz for ambient animations.
+    maxFrameRate = fmin(maxFrameRate, frame_rate_range_.maximum);
+    preferredFrameRate = fmin(frame_rate_range_.preferred, maxFrameRate);
+    minFrameRate = fmin(frame_rate_range_.minimum, preferredFrameRate);
+  }
   if (@available(iOS 15.0, *)) {
     display_link_.get().preferredFrameRateRange =
-        CAFrameRateRangeMake(minFrameRate, maxFrameRate, maxFrameRate);
+        CAFrameRateRangeMake(minFrameRate, maxFrameRate, preferredFrameRate);
   } else {
-    display_link_.get().preferredFramesPerSecond = maxFrameRate;
+    display_link_.get().preferredFramesPerSecond = preferredFrameRate;
   }
 }
 
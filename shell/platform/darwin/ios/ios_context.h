@@ -10,6 +10,7 @@
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/common/graphics/msaa_sample_count.h"
 #include "flutter/common/graphics/texture.h"
+#include "flutter/common/settings.h"
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/platform/darwin/scoped_nsobject.h"
@@ -53,6 +54,8 @@ class IOSContext {
   /// @param[in]  msaa_samples
   ///                       The number of MSAA samples to use. Only supplied to
   ///                       Skia, must be either 0, 1, 2, 4, or 8.
+  /// @param[in]  settings  The settings of the engine, for the options of the
+  ///                       Impeller backend.
   ///
   /// @return     A valid context on success. `nullptr` on failure.
   ///
@@ -60,7 +63,8 @@ class IOSContext {
       IOSRenderingAPI api,
       IOSRenderingBackend backend,
       MsaaSampleCount msaa_samples,
-      const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch);
+      const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch,
+      const Settings& settings);
 
   //----------------------------------------------------------------------------
   /// @brief      Collects the context object. This must happen on the thread on
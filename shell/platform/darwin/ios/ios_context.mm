@@ -6,6 +6,7 @@
 #include "flutter/shell/platform/darwin/ios/rendering_api_selection.h"
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/paths.h"
 #include "flutter/shell/platform/darwin/ios/ios_context_software.h"
 
 #if SHELL_ENABLE_METAL
@@ -23,7 +24,8 @@ std::unique_ptr<IOSContext> IOSContext::Create(
     IOSRenderingAPI api,
     IOSRenderingBackend backend,
     MsaaSampleCount msaa_samples,
-    const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch) {
+    const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch,
+    const Settings& settings) {
   switch (api) {
     case IOSRenderingAPI::kSoftware:
       FML_CHECK(backend != IOSRenderingBackend::kImpeller)
@@ -37,8 +39,16 @@ std::unique_ptr<IOSContext> IOSContext::Create(
       switch (backend) {
         case IOSRenderingBackend::kSkia:
           return std::make_unique<IOSContextMetalSkia>(msaa_samples);
-        case IOSRenderingBackend::kImpeller:
-          return std::make_unique<IOSContextMetalImpeller>(is_gpu_disabled_sync_switch);
+        case IOSRenderingBackend::kImpeller: {
+          impeller::PipelineArchivesMTL pipeline_archives;
+          for (const auto& archive : settings.impeller_pipeline_archives) {
+            pipeline_archives.archive_paths.push_back(
+                fml::paths::JoinPaths({settings.assets_path, archive}));
+          }
+          pipeline_archives.harvest_path = settings.impeller_pipeline_archive_harvest_path;
+          return std::make_unique<IOSContextMetalImpeller>(is_gpu_disabled_sync_switch,
+                                                           pipeline_archives);
+        }
       }
 #endif  // SHELL_ENABLE_METAL
     default:
@@ -20,8 +20,9 @@ namespace flutter {
 
 class IOSContextMetalImpeller final : public IOSContext {
  public:
-  explicit IOSContextMetalImpeller(
-      const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch);
+  IOSContextMetalImpeller(
+      const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch,
+      const impeller::PipelineArchivesMTL& pipeline_archives);
 
   ~IOSContextMetalImpeller();
 
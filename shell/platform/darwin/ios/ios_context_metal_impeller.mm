@@ -9,10 +9,12 @@
 namespace flutter {
 
 IOSContextMetalImpeller::IOSContextMetalImpeller(
-    const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch)
+    const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch,
+    const impeller::PipelineArchivesMTL& pipeline_archives)
     : IOSContext(MsaaSampleCount::kFour),
       darwin_context_metal_impeller_(fml::scoped_nsobject<FlutterDarwinContextMetalImpeller>{
-          [[FlutterDarwinContextMetalImpeller alloc] init:is_gpu_disabled_sync_switch]}) {}
+          [[FlutterDarwinContextMetalImpeller alloc] init:is_gpu_disabled_sync_switch
+                                         pipelineArchives:pipeline_archives]}) {}
 
 IOSContextMetalImpeller::~IOSContextMetalImpeller() = default;
 
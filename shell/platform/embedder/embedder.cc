@@ -5,9 +5,12 @@
 #define FML_USED_ON_EMBEDDER
 #define RAPIDJSON_HAS_STDSTRING 1
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -304,18 +307,26 @@ InferOpenGLPlatformViewCreationCallback(
     if (present) {
       return present(user_data);
     } else {
-      // Format the frame and buffer damages accordingly. Note that, since the
-      // current compute damage algorithm only returns one rectangle for damage
-      // we are assuming the number of rectangles provided in frame and buffer
-      // damage are always 1. Once the function that computes damage implements
-      // support for multiple damage rectangles, GLPresentInfo should also
-      // contain the number of damage rectangles.
-      const size_t num_rects = 1;
-
-      std::array<FlutterRect, num_rects> frame_damage_rect = {
-          SkIRectToFlutterRect(*(gl_present_info.frame_damage))};
-      std::array<FlutterRect, num_rects> buffer_damage_rect = {
-          SkIRectToFlutterRect(*(gl_present_info.buffer_damage))};
+      // Format the frame and buffer damages accordingly. Unless the embedder
+      // asked for more through max_damage_rect_count, each damage consists
+      // of a single rectangle.
+      auto to_flutter_rects = [](const std::optional<SkIRect>& damage,
+                                 const std::optional<flutter::DlRegion>&
+                                     damage_region) {
+        std::vector<FlutterRect> rects;
+        if (damage_region.has_value() && !damage_region->isEmpty()) {
+          for (const SkIRect& rect : damage_region->getRects(true)) {
+            rects.push_back(SkIRectToFlutterRect(rect));
+          }
+        } else {
+          rects.push_back(SkIRectToFlutterRect(*damage));
+        }
+        return rects;
+      };
+      std::vector<FlutterRect> frame_damage_rect = to_flutter_rects(
+          gl_present_info.frame_damage, gl_present_info.frame_damage_region);
+      std::vector<FlutterRect> buffer_damage_rect = to_flutter_rects(
+          gl_present_info.buffer_damage, gl_present_info.buffer_damage_region);
 
       FlutterDamage frame_damage{
           .struct_size = sizeof(FlutterDamage),
@@ -440,6 +451,9 @@ InferOpenGLPlatformViewCreationCallback(
   bool fbo_reset_after_present =
       SAFE_ACCESS(open_gl_config, fbo_reset_after_present, false);
 
+  size_t max_damage_rect_count = std::max<size_t>(
+      SAFE_ACCESS(open_gl_config, max_damage_rect_count, 1), 1);
+
   flutter::EmbedderSurfaceGL::GLDispatchTable gl_dispatch_table = {
       gl_make_current,                     // gl_make_current_callback
       gl_clear_current,                    // gl_clear_current_callback
@@ -452,8 +466,8 @@ InferOpenGLPlatformViewCreationCallback(
   };
 
   return fml::MakeCopyable(
-      [gl_dispatch_table, fbo_reset_after_present, platform_dispatch_table,
-       enable_impeller,
+      [gl_dispatch_table, fbo_reset_after_present, max_damage_rect_count,
+       platform_dispatch_table, enable_impeller,
        external_view_embedder =
            std::move(external_view_embedder)](flutter::Shell& shell) mutable {
         std::shared_ptr<flutter::EmbedderExternalViewEmbedder> view_embedder =
@@ -474,6 +488,7 @@ InferOpenGLPlatformViewCreationCallback(
             shell.GetTaskRunners(),  // task runners
             std::make_unique<flutter::EmbedderSurfaceGL>(
                 gl_dispatch_table, fbo_reset_after_present,
+                max_damage_rect_count,
                 view_embedder),       // embedder_surface
             platform_dispatch_table,  // embedder platform dispatch table
             view_embedder             // external view embedder
@@ -682,16 +697,21 @@ InferSoftwarePlatformViewCreationCallback(
           software_present_backing_store,  // required
       };
 
+  size_t tile_raster_thread_count =
+      SAFE_ACCESS(&config->software, tile_raster_thread_count, 0);
+
   return fml::MakeCopyable(
       [software_dispatch_table, platform_dispatch_table,
+       tile_raster_thread_count,
        external_view_embedder =
            std::move(external_view_embedder)](flutter::Shell& shell) mutable {
         return std::make_unique<flutter::PlatformViewEmbedder>(
-            shell,                             // delegate
-            shell.GetTaskRunners(),            // task runners
-            software_dispatch_table,           // software dispatch table
-            platform_dispatch_table,           // platform dispatch table
-            std::move(external_view_embedder)  // external view embedder
+            shell,                              // delegate
+            shell.GetTaskRunners(),             // task runners
+            software_dispatch_table,            // software dispatch table
+            platform_dispatch_table,            // platform dispatch table
+            std::move(external_view_embedder),  // external view embedder
+            tile_raster_thread_count            // tile raster thread count
         );
       });
 }
@@ -1274,6 +1294,10 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor,
       SAFE_ACCESS(compositor, present_layers_callback, nullptr);
   bool avoid_backing_store_cache =
       SAFE_ACCESS(compositor, avoid_backing_store_cache, false);
+  size_t backing_store_size_granularity =
+      SAFE_ACCESS(compositor, backing_store_size_granularity, 0);
+  size_t backing_store_keep_alive_frames =
+      SAFE_ACCESS(compositor, backing_store_keep_alive_frames, 0);
 
   // Make sure the required callbacks are present
   if (!c_create_callback || !c_collect_callback || !c_present_callback) {
@@ -1304,7 +1328,8 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor,
       };
 
   return {std::make_unique<flutter::EmbedderExternalViewEmbedder>(
-              avoid_backing_store_cache, create_render_target_callback,
+              avoid_backing_store_cache, backing_store_size_granularity,
+              backing_store_keep_alive_frames, create_render_target_callback,
               present_callback),
           false};
 }
@@ -1766,6 +1791,7 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
   if (SAFE_ACCESS(args, log_tag, nullptr) != nullptr) {
     settings.log_tag = SAFE_ACCESS(args, log_tag, nullptr);
   }
+  settings.worker_isolate_count = SAFE_ACCESS(args, worker_isolate_count, 0);
 
   bool has_update_semantics_2_callback =
       SAFE_ACCESS(args, update_semantics_callback2, nullptr) != nullptr;
@@ -2108,6 +2134,26 @@ FlutterEngineResult FlutterEngineDeinitialize(FLUTTER_API_SYMBOL(FlutterEngine)
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEngineDeinitializeAsync(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    VoidCallback callback,
+    void* user_data) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  auto embedder_engine = reinterpret_cast<flutter::EmbedderEngine*>(engine);
+  if (!embedder_engine->CollectShellAsync([callback, user_data]() {
+        if (callback) {
+          callback(user_data);
+        }
+      })) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Engine was already de-initialized.");
+  }
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineShutdown(FLUTTER_API_SYMBOL(FlutterEngine)
                                               engine) {
   auto result = FlutterEngineDeinitialize(engine);
@@ -2746,6 +2792,82 @@ FlutterEngineResult FlutterEngineReloadSystemFonts(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEnginePrefetchAssets(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* const* asset_names,
+    size_t asset_names_count) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (asset_names == nullptr && asset_names_count > 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Asset names were null.");
+  }
+
+  std::vector<std::string> names;
+  names.reserve(asset_names_count);
+  for (size_t i = 0; i < asset_names_count; i++) {
+    if (asset_names[i] == nullptr) {
+      return LOG_EMBEDDER_ERROR(kInvalidArguments, "Asset name was null.");
+    }
+    names.emplace_back(asset_names[i]);
+  }
+
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)->PrefetchAssets(
+          std::move(names))) {
+    return LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                              "Could not prefetch assets.");
+  }
+
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineRunInWorkerIsolate(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* function_name,
+    const uint8_t* data,
+    size_t data_size,
+    FlutterDataCallback callback,
+    void* user_data) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (function_name == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Function name was null.");
+  }
+
+  if (data == nullptr && data_size > 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Data was null.");
+  }
+
+  if (callback == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Callback was null.");
+  }
+
+  std::unique_ptr<fml::Mapping> message;
+  if (data != nullptr) {
+    message = std::make_unique<fml::MallocMapping>(
+        fml::MallocMapping::Copy(data, data_size));
+  }
+
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)->RunInWorkerIsolate(
+          function_name, std::move(message),
+          [callback, user_data](std::unique_ptr<fml::Mapping> result) {
+            if (result) {
+              callback(result->GetMapping(), result->GetSize(), user_data);
+            } else {
+              callback(nullptr, 0, user_data);
+            }
+          })) {
+    return LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                              "Could not run the function in a worker "
+                              "isolate.");
+  }
+
+  return kSuccess;
+}
+
 void FlutterEngineTraceEventDurationBegin(const char* name) {
   fml::tracing::TraceEvent0("flutter", name, /*flow_id_count=*/0,
                             /*flow_ids=*/nullptr);
@@ -2799,6 +2921,52 @@ FlutterEngineResult FlutterEngineRunTask(FLUTTER_API_SYMBOL(FlutterEngine)
                                   "Could not run the specified task.");
 }
 
+FlutterEngineResult FlutterEngineRunExpiredTasks(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterTaskRunner task_runner) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  auto runner = reinterpret_cast<flutter::EmbedderEngine*>(engine)
+                    ->GetEmbedderTaskRunner(task_runner);
+  if (!runner || !runner->BatchesTasks()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The task runner does not batch tasks.");
+  }
+
+  runner->RunExpiredTasks();
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineGetNextTaskTargetTime(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterTaskRunner task_runner,
+    uint64_t* target_time_nanos) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (target_time_nanos == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The target time out parameter was null.");
+  }
+
+  auto runner = reinterpret_cast<flutter::EmbedderEngine*>(engine)
+                    ->GetEmbedderTaskRunner(task_runner);
+  if (!runner || !runner->BatchesTasks()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The task runner does not batch tasks.");
+  }
+
+  std::optional<fml::TimePoint> target_time = runner->GetNextTaskTargetTime();
+  *target_time_nanos =
+      target_time.has_value()
+          ? target_time->ToEpochDelta().ToNanoseconds()
+          : std::numeric_limits<uint64_t>::max();
+  return kSuccess;
+}
+
 static bool DispatchJSONPlatformMessage(FLUTTER_API_SYMBOL(FlutterEngine)
                                             engine,
                                         const rapidjson::Document& document,
@@ -3214,6 +3382,11 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(NotifyDisplayUpdate, FlutterEngineNotifyDisplayUpdate);
   SET_PROC(ScheduleFrame, FlutterEngineScheduleFrame);
   SET_PROC(SetNextFrameCallback, FlutterEngineSetNextFrameCallback);
+  SET_PROC(DeinitializeAsync, FlutterEngineDeinitializeAsync);
+  SET_PROC(PrefetchAssets, FlutterEnginePrefetchAssets);
+  SET_PROC(RunExpiredTasks, FlutterEngineRunExpiredTasks);
+  SET_PROC(GetNextTaskTargetTime, FlutterEngineGetNextTaskTargetTime);
+  SET_PROC(RunInWorkerIsolate, FlutterEngineRunInWorkerIsolate);
 #undef SET_PROC
 
   return kSuccess;
@@ -582,6 +582,11 @@ typedef struct {
   /// ID. Not specifying populate_existing_damage will result in full
   /// repaint (i.e. rendering all the pixels on the screen at every frame).
   FlutterFrameBufferWithDamageCallback populate_existing_damage;
+  /// The maximum number of rectangles the frame and buffer damage passed to
+  /// present_with_info may consist of. Separate changes on screen are
+  /// reported as separate rectangles, up to this count. Zero or one, which
+  /// is the default, reports the bounds of all changes as a single rectangle.
+  size_t max_damage_rect_count;
 } FlutterOpenGLRendererConfig;
 
 /// Alias for id<MTLDevice>.
@@ -813,6 +818,12 @@ typedef struct {
   /// format. The buffer is owned by the Flutter engine and must be copied in
   /// this callback if needed.
   SoftwareSurfacePresentCallback surface_present_callback;
+  /// The number of threads that rasterize bands of each frame along with the
+  /// raster thread. The frame is then recorded before it is rasterized, and
+  /// only the part of the buffer that changed since the last presented frame
+  /// is redrawn. If 0, the frame is rasterized on the raster thread alone.
+  /// This has no effect when a custom compositor is set.
+  size_t tile_raster_thread_count;
 } FlutterSoftwareRendererConfig;
 
 typedef struct {
@@ -1476,6 +1487,15 @@ typedef struct {
   /// A unique identifier for the task runner. If multiple task runners service
   /// tasks on the same thread, their identifiers must match.
   size_t identifier;
+  /// If true, the engine queues the tasks of this task runner itself instead
+  /// of passing every task to the `post_task_callback`. The callback is then
+  /// only called when the task runner needs to wake up earlier than any
+  /// wake-up it already requested, and the task it is given is a wake-up:
+  /// running it with `FlutterEngineRunTask` runs all tasks whose target time
+  /// has expired. Embedders that integrate with their own event loop may also
+  /// call `FlutterEngineRunExpiredTasks` whenever the loop wakes and use
+  /// `FlutterEngineGetNextTaskTargetTime` to decide when to wake it next.
+  bool batch_tasks;
 } FlutterTaskRunnerDescription;
 
 typedef struct {
@@ -1626,6 +1646,17 @@ typedef struct {
   /// will be a transformation mutation to make sure subsequent mutations are in
   /// the correct coordinate space.
   const FlutterPlatformViewMutation** mutations;
+  /// Whether the platform view is composited at full opacity with only
+  /// translations, positive scales and rectangular clips applied to it,
+  /// including by the root surface transformation.
+  ///
+  /// Such a platform view maps to an axis-aligned, optionally cropped rectangle
+  /// on screen. Embedders that can present its contents on a hardware overlay
+  /// plane, for example a dmabuf-backed video frame on a DRM/KMS plane, may
+  /// scan them out directly instead of compositing them on the GPU. Layers
+  /// presented after this one are still drawn on top of it, so the embedder
+  /// must keep them above the plane.
+  bool is_scanout_candidate;
 } FlutterPlatformView;
 
 typedef enum {
@@ -1703,6 +1734,19 @@ typedef struct {
   /// outside of this area are transparent and the embedder may choose not
   /// to render them. Coordinates are in physical pixels.
   FlutterRegion* paint_region;
+
+  /// The area of the backing store whose contents changed since the previous
+  /// frame. Outside of this area, the backing store has the same contents as
+  /// the one presented at the same position in the layers of the previous
+  /// frame, so an embedder that composites the layers itself only needs to
+  /// recomposite this area. Coordinates are in physical pixels.
+  ///
+  /// This only accounts for contents rendered by Flutter. The embedder must
+  /// add the areas affected by changes to its platform views itself. When the
+  /// engine can't tell what changed, for example for the first frame or when
+  /// the layers are arranged differently than in the previous frame, this
+  /// covers the entire backing store.
+  FlutterRegion* damage_region;
 } FlutterBackingStorePresentInfo;
 
 typedef struct {
@@ -1767,6 +1811,23 @@ typedef struct {
   FlutterLayersPresentCallback present_layers_callback;
   /// Avoid caching backing stores provided by this compositor.
   bool avoid_backing_store_cache;
+  /// If larger than one, the width and height of the backing stores requested
+  /// through `create_backing_store_callback` are rounded up to a multiple of
+  /// this many physical pixels. A cached backing store can then be reused for
+  /// frames of slightly different sizes, for example while a window is being
+  /// resized, instead of a new one being created for every frame.
+  ///
+  /// The backing store of a layer may then be larger than the layer. Its
+  /// contents occupy the `FlutterLayer.size` area at the top left corner of the
+  /// backing store, and the rest of the backing store is transparent. This is
+  /// ignored if `avoid_backing_store_cache` is set.
+  size_t backing_store_size_granularity;
+  /// The number of frames a cached backing store may go unused before it is
+  /// released through `collect_backing_store_callback`. A non-zero value keeps
+  /// the backing stores of recent frame sizes around, so that a window that is
+  /// resized back and forth can reuse them. If zero, backing stores are
+  /// released as soon as a frame doesn't use them.
+  size_t backing_store_keep_alive_frames;
 } FlutterCompositor;
 
 typedef struct {
@@ -2259,6 +2320,12 @@ typedef struct {
   /// being registered on the framework side. The callback is invoked from
   /// a task posted to the platform thread.
   FlutterChannelUpdateCallback channel_update_callback;
+
+  /// The number of worker isolates to create in the isolate group of the root
+  /// isolate when it is launched, each on its own engine managed thread. They
+  /// are used by `FlutterEngineRunInWorkerIsolate`, and none are created if
+  /// this is zero.
+  size_t worker_isolate_count;
 } FlutterProjectArgs;
 
 #ifndef FLUTTER_ENGINE_NO_PROTOTYPES
@@ -2389,6 +2456,37 @@ FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineDeinitialize(FLUTTER_API_SYMBOL(FlutterEngine)
                                                   engine);
 
+//------------------------------------------------------------------------------
+/// @brief      Stops running the Flutter engine instance like
+///             `FlutterEngineDeinitialize`, but without blocking the calling
+///             thread while the engine threads release their resources. Use
+///             this to avoid stalling the platform thread when tearing down a
+///             large engine.
+///
+///             Once this call returns, all other calls with this handle fail
+///             as they would on a de-initialized engine. Tasks may still be
+///             posted onto custom task runners specified by the embedder
+///             until the callback is invoked, so those task runners must keep
+///             servicing tasks with `FlutterEngineRunTask` until then. The
+///             Flutter engine handle still needs to be collected via a call to
+///             `FlutterEngineShutdown` after the callback has been invoked.
+///             That call must not be made from within the callback itself.
+///
+/// @param[in]  engine     The running engine instance to de-initialize.
+/// @param[in]  callback   Invoked on the platform task runner once the engine
+///                        has been de-initialized.
+/// @param[in]  user_data  The baton passed to the callback.
+///
+/// @return     The result of the call to start de-initializing the engine.
+///             `kInvalidArguments` if the engine is invalid or was already
+///             de-initialized, in which case the callback is never invoked.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineDeinitializeAsync(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    VoidCallback callback,
+    void* user_data);
+
 //------------------------------------------------------------------------------
 /// @brief      Runs an initialized engine instance. An engine can be
 ///             initialized via `FlutterEngineInitialize`. An initialized
@@ -2694,6 +2792,64 @@ FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineReloadSystemFonts(
     FLUTTER_API_SYMBOL(FlutterEngine) engine);
 
+//------------------------------------------------------------------------------
+/// @brief      Loads assets in the background ahead of their use, for example
+///             before showing content that needs them, so that the Dart
+///             application can read them without waiting for storage. Loaded
+///             assets are kept in a memory cache of bounded size. This must be
+///             called on the platform thread.
+///
+/// @param[in]  engine             A running engine instance.
+/// @param[in]  asset_names        The names of the assets to load, relative to
+///                                the assets directory.
+/// @param[in]  asset_names_count  The number of asset names.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEnginePrefetchAssets(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* const* asset_names,
+    size_t asset_names_count);
+
+//------------------------------------------------------------------------------
+/// @brief      Invokes a top-level function of the root library of the Dart
+///             application on one of the worker isolates created for
+///             `FlutterProjectArgs.worker_isolate_count`, with the data as its
+///             `ByteData` argument. The workers are in the isolate group of the
+///             root isolate, so the function starts without waiting for an
+///             isolate to be spawned. Worker isolates are not root isolates,
+///             so the UI operations of `dart:ui`, such as scheduling a frame or
+///             decoding an image, throw on them. In AOT mode the function must
+///             be annotated with `@pragma('vm:entry-point')`. This must be
+///             called on the platform thread.
+///
+///             The callback is invoked on an engine managed thread with the
+///             `ByteData` returned by the function. It is invoked with null
+///             data if the function failed, did not return a `ByteData`, or
+///             there are no worker isolates. The data is only valid for the
+///             duration of the callback. The callback is not invoked if the
+///             engine is shut down before the function runs.
+///
+/// @param[in]  engine         A running engine instance.
+/// @param[in]  function_name  The name of the function in the root library.
+/// @param[in]  data           The data passed to the function. May be null,
+///                            in which case the function is passed null.
+/// @param[in]  data_size      The size of the data.
+/// @param[in]  callback       The callback invoked with the result.
+/// @param[in]  user_data      The user data passed to the callback.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineRunInWorkerIsolate(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* function_name,
+    const uint8_t* data,
+    size_t data_size,
+    FlutterDataCallback callback,
+    void* user_data);
+
 //------------------------------------------------------------------------------
 /// @brief      A profiling utility. Logs a trace duration begin event to the
 ///             timeline. If the timeline is unavailable or disabled, this has
@@ -2777,6 +2933,45 @@ FlutterEngineResult FlutterEngineRunTask(FLUTTER_API_SYMBOL(FlutterEngine)
                                              engine,
                                          const FlutterTask* task);
 
+//------------------------------------------------------------------------------
+/// @brief      Runs all tasks of a task runner that batches tasks (see
+///             `FlutterTaskRunnerDescription.batch_tasks`) whose target time
+///             has expired. Tasks posted while the call runs tasks are left
+///             for a later call. This call must be made on the thread
+///             associated with the task runner.
+///
+/// @param[in]  engine       A running engine instance.
+/// @param[in]  task_runner  The task runner, as given in `FlutterTask.runner`.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineRunExpiredTasks(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterTaskRunner task_runner);
+
+//------------------------------------------------------------------------------
+/// @brief      Gets the target time of the earliest pending task of a task
+///             runner that batches tasks (see
+///             `FlutterTaskRunnerDescription.batch_tasks`). The time is from
+///             the clock `FlutterEngineGetCurrentTime` uses. May be called
+///             from any thread.
+///
+/// @param[in]  engine             A running engine instance.
+/// @param[in]  task_runner        The task runner, as given in
+///                                `FlutterTask.runner`.
+/// @param[out] target_time_nanos  The target time in nanoseconds, or
+///                                `UINT64_MAX` if the task runner has no
+///                                pending tasks.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetNextTaskTargetTime(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterTaskRunner task_runner,
+    uint64_t* target_time_nanos);
+
 //------------------------------------------------------------------------------
 /// @brief      Notify a running engine instance that the locale has been
 ///             updated. The preferred locale must be the first item in the list
@@ -2978,6 +3173,10 @@ typedef FlutterEngineResult (*FlutterEngineInitializeFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) * engine_out);
 typedef FlutterEngineResult (*FlutterEngineDeinitializeFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine);
+typedef FlutterEngineResult (*FlutterEngineDeinitializeAsyncFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    VoidCallback callback,
+    void* user_data);
 typedef FlutterEngineResult (*FlutterEngineRunInitializedFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine);
 typedef FlutterEngineResult (*FlutterEngineSendWindowMetricsEventFnPtr)(
@@ -3076,6 +3275,24 @@ typedef FlutterEngineResult (*FlutterEngineSetNextFrameCallbackFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     VoidCallback callback,
     void* user_data);
+typedef FlutterEngineResult (*FlutterEnginePrefetchAssetsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* const* asset_names,
+    size_t asset_names_count);
+typedef FlutterEngineResult (*FlutterEngineRunInWorkerIsolateFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* function_name,
+    const uint8_t* data,
+    size_t data_size,
+    FlutterDataCallback callback,
+    void* user_data);
+typedef FlutterEngineResult (*FlutterEngineRunExpiredTasksFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterTaskRunner task_runner);
+typedef FlutterEngineResult (*FlutterEngineGetNextTaskTargetTimeFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterTaskRunner task_runner,
+    uint64_t* target_time_nanos);
 
 /// Function-pointer-based versions of the APIs above.
 typedef struct {
@@ -3122,6 +3339,11 @@ typedef struct {
   FlutterEngineNotifyDisplayUpdateFnPtr NotifyDisplayUpdate;
   FlutterEngineScheduleFrameFnPtr ScheduleFrame;
   FlutterEngineSetNextFrameCallbackFnPtr SetNextFrameCallback;
+  FlutterEngineDeinitializeAsyncFnPtr DeinitializeAsync;
+  FlutterEnginePrefetchAssetsFnPtr PrefetchAssets;
+  FlutterEngineRunExpiredTasksFnPtr RunExpiredTasks;
+  FlutterEngineGetNextTaskTargetTimeFnPtr GetNextTaskTargetTime;
+  FlutterEngineRunInWorkerIsolateFnPtr RunInWorkerIsolate;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
@@ -65,6 +65,14 @@ bool EmbedderEngine::CollectShell() {
   return IsValid();
 }
 
+bool EmbedderEngine::CollectShellAsync(const fml::closure& on_collected) {
+  if (!IsValid()) {
+    return false;
+  }
+  Shell::DestroyAsync(std::move(shell_), on_collected);
+  return true;
+}
+
 bool EmbedderEngine::RunRootIsolate() {
   if (!IsValid() || !run_configuration_.IsValid()) {
     return false;
@@ -227,6 +235,28 @@ bool EmbedderEngine::ReloadSystemFonts() {
   return shell_->ReloadSystemFonts();
 }
 
+bool EmbedderEngine::PrefetchAssets(std::vector<std::string> asset_names) {
+  if (!IsValid()) {
+    return false;
+  }
+
+  shell_->PrefetchAssets(std::move(asset_names));
+  return true;
+}
+
+bool EmbedderEngine::RunInWorkerIsolate(
+    std::string function,
+    std::unique_ptr<fml::Mapping> message,
+    WorkerIsolatePool::TaskCallback callback) {
+  if (!IsValid()) {
+    return false;
+  }
+
+  shell_->RunInWorkerIsolate(std::move(function), std::move(message),
+                             std::move(callback));
+  return true;
+}
+
 bool EmbedderEngine::PostRenderThreadTask(const fml::closure& task) {
   if (!IsValid()) {
     return false;
@@ -247,6 +277,13 @@ bool EmbedderEngine::RunTask(const FlutterTask* task) {
                                 task->task);
 }
 
+fml::RefPtr<EmbedderTaskRunner> EmbedderEngine::GetEmbedderTaskRunner(
+    FlutterTaskRunner runner) const {
+  // Like |RunTask|, this doesn't need the shell to be running.
+  return thread_host_->GetEmbedderTaskRunner(
+      reinterpret_cast<int64_t>(runner));
+}
+
 bool EmbedderEngine::PostTaskOnEngineManagedNativeThreads(
     const std::function<void(FlutterNativeThreadType)>& closure) const {
   if (!IsValid() || closure == nullptr) {
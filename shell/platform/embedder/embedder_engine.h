@@ -38,6 +38,11 @@ class EmbedderEngine {
 
   bool CollectShell();
 
+  // Like |CollectShell|, but tears the shell down on its own task runners
+  // instead of blocking the calling thread. |on_collected| is invoked on the
+  // platform task runner once the shell is gone.
+  bool CollectShellAsync(const fml::closure& on_collected);
+
   const TaskRunners& GetTaskRunners() const;
 
   bool NotifyCreated();
@@ -76,10 +81,19 @@ class EmbedderEngine {
 
   bool ReloadSystemFonts();
 
+  bool PrefetchAssets(std::vector<std::string> asset_names);
+
+  bool RunInWorkerIsolate(std::string function,
+                          std::unique_ptr<fml::Mapping> message,
+                          WorkerIsolatePool::TaskCallback callback);
+
   bool PostRenderThreadTask(const fml::closure& task);
 
   bool RunTask(const FlutterTask* task);
 
+  fml::RefPtr<EmbedderTaskRunner> GetEmbedderTaskRunner(
+      FlutterTaskRunner runner) const;
+
   bool PostTaskOnEngineManagedNativeThreads(
       const std::function<void(FlutterNativeThreadType)>& closure) const;
 
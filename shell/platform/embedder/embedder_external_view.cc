@@ -116,7 +116,12 @@ bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target,
     return false;
   }
 
-  FML_DCHECK(render_target.GetRenderTargetSize() == render_surface_size_);
+  // Render targets may be larger than the surface if they were over-allocated
+  // for reuse. The surface then occupies their top left corner.
+  FML_DCHECK(render_target.GetRenderTargetSize().width() >=
+                 render_surface_size_.width() &&
+             render_target.GetRenderTargetSize().height() >=
+                 render_surface_size_.height());
 
   auto canvas = skia_surface->getCanvas();
   if (!canvas) {
@@ -18,11 +18,15 @@ static const auto kRootViewIdentifier = EmbedderExternalView::ViewIdentifier{};
 
 EmbedderExternalViewEmbedder::EmbedderExternalViewEmbedder(
     bool avoid_backing_store_cache,
+    size_t backing_store_size_granularity,
+    size_t backing_store_keep_alive_frames,
     const CreateRenderTargetCallback& create_render_target_callback,
     const PresentCallback& present_callback)
     : avoid_backing_store_cache_(avoid_backing_store_cache),
+      backing_store_size_granularity_(backing_store_size_granularity),
       create_render_target_callback_(create_render_target_callback),
-      present_callback_(present_callback) {
+      present_callback_(present_callback),
+      render_target_cache_(backing_store_keep_alive_frames) {
   FML_DCHECK(create_render_target_callback_);
   FML_DCHECK(present_callback_);
 }
@@ -42,6 +46,21 @@ SkMatrix EmbedderExternalViewEmbedder::GetSurfaceTransformation() const {
   return surface_transformation_callback_();
 }
 
+SkISize EmbedderExternalViewEmbedder::GetBackingStoreSize(
+    SkISize layer_size) const {
+  // Render targets are only reused if they are cached.
+  const int64_t granularity = backing_store_size_granularity_;
+  if (avoid_backing_store_cache_ || granularity <= 1) {
+    return layer_size;
+  }
+  auto round_up = [granularity](int32_t value) {
+    return static_cast<int32_t>((value + granularity - 1) / granularity *
+                                granularity);
+  };
+  return SkISize::Make(round_up(layer_size.width()),
+                       round_up(layer_size.height()));
+}
+
 void EmbedderExternalViewEmbedder::Reset() {
   pending_views_.clear();
   composition_order_.clear();
@@ -50,6 +69,8 @@ void EmbedderExternalViewEmbedder::Reset() {
 // |ExternalViewEmbedder|
 void EmbedderExternalViewEmbedder::CancelFrame() {
   Reset();
+  // The next frame may be diffed against this one, which was never presented.
+  last_presented_layers_.clear();
 }
 
 // |ExternalViewEmbedder|
@@ -118,6 +139,11 @@ DlCanvas* EmbedderExternalViewEmbedder::CompositeEmbeddedView(int64_t view_id) {
   return found->second->GetCanvas();
 }
 
+// |ExternalViewEmbedder|
+bool EmbedderExternalViewEmbedder::SupportsFrameDamage() {
+  return true;
+}
+
 static FlutterBackingStoreConfig MakeBackingStoreConfig(
     const SkISize& backing_store_size) {
   FlutterBackingStoreConfig config = {};
@@ -267,6 +293,16 @@ class Layer {
 
   EmbedderRenderTarget* render_target() { return render_target_.get(); }
 
+  /// Returns the views whose Flutter contents are rendered into this layer.
+  const std::vector<EmbedderExternalView*>& flutter_contents() const {
+    return flutter_contents_;
+  }
+
+  /// Returns the area covered by the Flutter contents of this layer.
+  const DlRegion& flutter_contents_region() const {
+    return flutter_contents_region_;
+  }
+
   std::vector<SkIRect> coverage() {
     return flutter_contents_region_.getRects();
   }
@@ -289,7 +325,8 @@ class Layer {
 /// Implements https://flutter.dev/go/optimized-platform-view-layers
 class LayerBuilder {
  public:
-  explicit LayerBuilder(SkISize frame_size) : frame_size_(frame_size) {
+  explicit LayerBuilder(SkISize backing_store_size)
+      : backing_store_size_(backing_store_size) {
     layers_.push_back(Layer());
   }
 
@@ -312,7 +349,7 @@ class LayerBuilder {
   void PrepareBackingStore(
       const std::function<std::unique_ptr<EmbedderRenderTarget>(
           FlutterBackingStoreConfig)>& target_provider) {
-    auto config = MakeBackingStoreConfig(frame_size_);
+    auto config = MakeBackingStoreConfig(backing_store_size_);
     for (auto& layer : layers_) {
       if (layer.has_flutter_contents()) {
         layer.SetRenderTarget(target_provider(config));
@@ -330,9 +367,16 @@ class LayerBuilder {
     }
   }
 
-  /// Populates EmbedderLayers from layer builder's layers.
-  void PushLayers(EmbedderLayers& layers) {
-    for (auto& layer : layers_) {
+  /// Returns the layers built so far, in Z order.
+  const std::vector<Layer>& layers() const { return layers_; }
+
+  /// Populates EmbedderLayers from layer builder's layers. |damage| holds the
+  /// damage of each of the layers returned by |layers|.
+  void PushLayers(EmbedderLayers& layers,
+                  const std::vector<std::vector<SkIRect>>& damage) {
+    FML_DCHECK(damage.size() == layers_.size());
+    for (size_t i = 0; i < layers_.size(); i++) {
+      auto& layer = layers_[i];
       for (auto& view : layer.platform_views()) {
         auto platform_view_id = view.view_identifier.platform_view_id;
         if (platform_view_id.has_value()) {
@@ -341,7 +385,7 @@ class LayerBuilder {
       }
       if (layer.render_target() != nullptr) {
         layers.PushBackingStoreLayer(layer.render_target()->GetBackingStore(),
-                                     layer.coverage());
+                                     layer.coverage(), damage[i]);
       }
     }
   }
@@ -411,7 +455,7 @@ class LayerBuilder {
   }
 
   std::vector<Layer> layers_;
-  SkISize frame_size_;
+  SkISize backing_store_size_;
 };
 
 };  // namespace
@@ -424,7 +468,8 @@ void EmbedderExternalViewEmbedder::SubmitFlutterView(
                                  pending_frame_size_.height());
   pending_surface_transformation_.mapRect(&_rect);
 
-  LayerBuilder builder(SkISize::Make(_rect.width(), _rect.height()));
+  LayerBuilder builder(
+      GetBackingStoreSize(SkISize::Make(_rect.width(), _rect.height())));
 
   for (auto view_id : composition_order_) {
     auto& view = pending_views_[view_id];
@@ -458,7 +503,7 @@ void EmbedderExternalViewEmbedder::SubmitFlutterView(
   //
   // @warning: Embedder may trample on our OpenGL context here.
   auto deferred_cleanup_render_targets =
-      render_target_cache_.ClearAllRenderTargetsInCache();
+      render_target_cache_.CollectIdleRenderTargets();
 
   // The OpenGL context could have been trampled by the embedder at this point
   // as it attempted to collect old render targets and create new ones. Tell
@@ -478,6 +523,24 @@ void EmbedderExternalViewEmbedder::SubmitFlutterView(
     context->flushAndSubmit();
   }
 
+  std::vector<PresentedLayer> layers;
+  layers.reserve(builder.layers().size());
+  for (const auto& layer : builder.layers()) {
+    PresentedLayer& presented = layers.emplace_back();
+    for (const auto& platform_view : layer.platform_views()) {
+      presented.platform_views.push_back(
+          platform_view.view_identifier.platform_view_id.value_or(-1));
+    }
+    for (const auto* contents : layer.flutter_contents()) {
+      presented.contents.push_back(
+          contents->GetViewIdentifier().platform_view_id);
+    }
+    presented.region = layer.flutter_contents_region();
+  }
+  auto damage =
+      ComputeLayerDamage(layers, frame->submit_info().frame_damage_region);
+  last_presented_layers_ = std::move(layers);
+
   {
     // Submit the scribbled layer to the embedder for presentation.
     //
@@ -486,7 +549,7 @@ void EmbedderExternalViewEmbedder::SubmitFlutterView(
                                     pending_device_pixel_ratio_,
                                     pending_surface_transformation_);
 
-    builder.PushLayers(presented_layers);
+    builder.PushLayers(presented_layers, damage);
 
     presented_layers.InvokePresentCallback(present_callback_);
   }
@@ -507,4 +570,37 @@ void EmbedderExternalViewEmbedder::SubmitFlutterView(
   frame->Submit();
 }
 
+std::vector<std::vector<SkIRect>>
+EmbedderExternalViewEmbedder::ComputeLayerDamage(
+    const std::vector<PresentedLayer>& layers,
+    const std::optional<DlRegion>& frame_damage) const {
+  // The frame damage only describes the layers if every layer presents the
+  // same views as the layer at the same position in the previous frame.
+  // Otherwise, contents may have moved between layers without changing.
+  bool is_arrangement_unchanged =
+      frame_damage.has_value() &&
+      layers.size() == last_presented_layers_.size();
+  for (size_t i = 0; is_arrangement_unchanged && i < layers.size(); i++) {
+    is_arrangement_unchanged =
+        layers[i].platform_views == last_presented_layers_[i].platform_views &&
+        layers[i].contents == last_presented_layers_[i].contents;
+  }
+
+  std::vector<std::vector<SkIRect>> damage;
+  damage.reserve(layers.size());
+  for (size_t i = 0; i < layers.size(); i++) {
+    if (!is_arrangement_unchanged) {
+      damage.push_back({SkIRect::MakeSize(pending_frame_size_)});
+      continue;
+    }
+    // A layer is transparent outside of the area its contents cover, so
+    // changes elsewhere in the frame don't affect it.
+    auto coverage = DlRegion::MakeUnion(layers[i].region,
+                                        last_presented_layers_[i].region);
+    damage.push_back(
+        DlRegion::MakeIntersection(frame_damage.value(), coverage).getRects());
+  }
+  return damage;
+}
+
 }  // namespace flutter
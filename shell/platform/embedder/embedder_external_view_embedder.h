@@ -7,7 +7,9 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/hash_combine.h"
@@ -46,6 +48,16 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   ///                                      will beinvoked every frame for every
   ///                                      engine composited layer. The result
   ///                                      will not cached.
+  /// @param[in]  backing_store_size_granularity
+  ///                                     If larger than one, the sizes of the
+  ///                                     requested render targets are rounded
+  ///                                     up to a multiple of it, so that they
+  ///                                     can be reused for frames of slightly
+  ///                                     different sizes.
+  /// @param[in]  backing_store_keep_alive_frames
+  ///                                     The number of frames an unused render
+  ///                                     target is cached for before it is
+  ///                                     collected.
   ///
   /// @param[in]  create_render_target_callback
   ///                                     The render target callback used to
@@ -57,6 +69,8 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   ///
   EmbedderExternalViewEmbedder(
       bool avoid_backing_store_cache,
+      size_t backing_store_size_granularity,
+      size_t backing_store_keep_alive_frames,
       const CreateRenderTargetCallback& create_render_target_callback,
       const PresentCallback& present_callback);
 
@@ -107,8 +121,22 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   // |ExternalViewEmbedder|
   DlCanvas* GetRootCanvas() override;
 
+  // |ExternalViewEmbedder|
+  bool SupportsFrameDamage() override;
+
  private:
+  // The views presented in a layer, and the area covered by their Flutter
+  // contents.
+  struct PresentedLayer {
+    // The platform views below the Flutter contents of the layer.
+    std::vector<EmbedderExternalView::PlatformViewID> platform_views;
+    // The views whose Flutter contents were rendered into the layer.
+    std::vector<std::optional<EmbedderExternalView::PlatformViewID>> contents;
+    DlRegion region;
+  };
+
   const bool avoid_backing_store_cache_;
+  const size_t backing_store_size_granularity_;
   const CreateRenderTargetCallback create_render_target_callback_;
   const PresentCallback present_callback_;
   SurfaceTransformationCallback surface_transformation_callback_;
@@ -118,11 +146,20 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   EmbedderExternalView::PendingViews pending_views_;
   std::vector<EmbedderExternalView::ViewIdentifier> composition_order_;
   EmbedderRenderTargetCache render_target_cache_;
+  std::vector<PresentedLayer> last_presented_layers_;
 
   void Reset();
 
+  // Computes the damage of each of |layers| from the damage of the frame.
+  std::vector<std::vector<SkIRect>> ComputeLayerDamage(
+      const std::vector<PresentedLayer>& layers,
+      const std::optional<DlRegion>& frame_damage) const;
+
   SkMatrix GetSurfaceTransformation() const;
 
+  // Returns the size of the render targets used for layers of |layer_size|.
+  SkISize GetBackingStoreSize(SkISize layer_size) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderExternalViewEmbedder);
 };
 
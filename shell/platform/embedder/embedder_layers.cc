@@ -19,7 +19,8 @@ EmbedderLayers::~EmbedderLayers() = default;
 
 void EmbedderLayers::PushBackingStoreLayer(
     const FlutterBackingStore* store,
-    const std::vector<SkIRect>& paint_region_vec) {
+    const std::vector<SkIRect>& paint_region_vec,
+    const std::vector<SkIRect>& damage_region_vec) {
   FlutterLayer layer = {};
 
   layer.struct_size = sizeof(FlutterLayer);
@@ -37,13 +38,24 @@ void EmbedderLayers::PushBackingStoreLayer(
   layer.size.width = transformed_layer_bounds.width();
   layer.size.height = transformed_layer_bounds.height();
 
-  auto paint_region_rects = std::make_unique<std::vector<FlutterRect>>();
-  paint_region_rects->reserve(paint_region_vec.size());
+  auto present_info = std::make_unique<FlutterBackingStorePresentInfo>();
+  present_info->struct_size = sizeof(FlutterBackingStorePresentInfo);
+  present_info->paint_region = MakeRegion(paint_region_vec);
+  present_info->damage_region = MakeRegion(damage_region_vec);
+  layer.backing_store_present_info = present_info.get();
 
-  for (const auto& rect : paint_region_vec) {
+  present_info_referenced_.push_back(std::move(present_info));
+  presented_layers_.push_back(layer);
+}
+
+FlutterRegion* EmbedderLayers::MakeRegion(const std::vector<SkIRect>& rects) {
+  auto region_rects = std::make_unique<std::vector<FlutterRect>>();
+  region_rects->reserve(rects.size());
+
+  for (const auto& rect : rects) {
     auto transformed_rect =
         root_surface_transformation_.mapRect(SkRect::Make(rect));
-    paint_region_rects->push_back(FlutterRect{
+    region_rects->push_back(FlutterRect{
         transformed_rect.x(),
         transformed_rect.y(),
         transformed_rect.right(),
@@ -51,20 +63,13 @@ void EmbedderLayers::PushBackingStoreLayer(
     });
   }
 
-  auto paint_region = std::make_unique<FlutterRegion>();
-  paint_region->struct_size = sizeof(FlutterRegion);
-  paint_region->rects = paint_region_rects->data();
-  paint_region->rects_count = paint_region_rects->size();
-  rects_referenced_.push_back(std::move(paint_region_rects));
-
-  auto present_info = std::make_unique<FlutterBackingStorePresentInfo>();
-  present_info->struct_size = sizeof(FlutterBackingStorePresentInfo);
-  present_info->paint_region = paint_region.get();
-  regions_referenced_.push_back(std::move(paint_region));
-  layer.backing_store_present_info = present_info.get();
-
-  present_info_referenced_.push_back(std::move(present_info));
-  presented_layers_.push_back(layer);
+  auto region = std::make_unique<FlutterRegion>();
+  region->struct_size = sizeof(FlutterRegion);
+  region->rects = region_rects->data();
+  region->rects_count = region_rects->size();
+  rects_referenced_.push_back(std::move(region_rects));
+  regions_referenced_.push_back(std::move(region));
+  return regions_referenced_.back().get();
 }
 
 static std::unique_ptr<FlutterPlatformViewMutation> ConvertMutation(
@@ -129,6 +134,13 @@ static std::unique_ptr<FlutterPlatformViewMutation> ConvertMutation(
   return std::make_unique<FlutterPlatformViewMutation>(mutation);
 }
 
+// Whether |matrix| maps axis-aligned rectangles to axis-aligned rectangles
+// without flipping or rotating them.
+static bool IsScanoutCompatible(const SkMatrix& matrix) {
+  return matrix.isScaleTranslate() && matrix.getScaleX() > 0 &&
+         matrix.getScaleY() > 0;
+}
+
 void EmbedderLayers::PushPlatformViewLayer(
     FlutterPlatformViewIdentifier identifier,
     const EmbeddedViewParams& params) {
@@ -140,6 +152,8 @@ void EmbedderLayers::PushPlatformViewLayer(
     const auto& mutators = params.mutatorsStack();
 
     std::vector<const FlutterPlatformViewMutation*> mutations_array;
+    bool is_scanout_candidate =
+        IsScanoutCompatible(root_surface_transformation_);
 
     for (auto i = mutators.Bottom(); i != mutators.Top(); ++i) {
       const auto& mutator = *i;
@@ -155,9 +169,11 @@ void EmbedderLayers::PushPlatformViewLayer(
               mutations_referenced_
                   .emplace_back(ConvertMutation(mutator->GetRRect()))
                   .get());
+          is_scanout_candidate = false;
         } break;
         case MutatorType::kClipPath: {
           // Unsupported mutation.
+          is_scanout_candidate = false;
         } break;
         case MutatorType::kTransform: {
           const auto& matrix = mutator->GetMatrix();
@@ -165,6 +181,7 @@ void EmbedderLayers::PushPlatformViewLayer(
             mutations_array.push_back(
                 mutations_referenced_.emplace_back(ConvertMutation(matrix))
                     .get());
+            is_scanout_candidate &= IsScanoutCompatible(matrix);
           }
         } break;
         case MutatorType::kOpacity: {
@@ -174,12 +191,15 @@ void EmbedderLayers::PushPlatformViewLayer(
             mutations_array.push_back(
                 mutations_referenced_.emplace_back(ConvertMutation(opacity))
                     .get());
+            is_scanout_candidate = false;
           }
         } break;
         case MutatorType::kBackdropFilter:
+          is_scanout_candidate = false;
           break;
       }
     }
+    view.is_scanout_candidate = is_scanout_candidate;
 
     if (!mutations_array.empty()) {
       // If there are going to be any mutations, they must first take into
@@ -0,0 +1,109 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_layers.h"
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+// Presents a single platform view with |mutators| and returns whether the
+// engine marked it as a scanout candidate.
+static bool IsScanoutCandidate(
+    const MutatorsStack& mutators,
+    const SkMatrix& root_surface_transformation = SkMatrix::I()) {
+  EmbedderLayers layers(SkISize::Make(800, 600), 1.0,
+                        root_surface_transformation);
+  EmbeddedViewParams params(SkMatrix::I(), SkSize::Make(100, 100), mutators);
+  layers.PushPlatformViewLayer(1, params);
+
+  bool is_scanout_candidate = false;
+  layers.InvokePresentCallback(
+      [&](const std::vector<const FlutterLayer*>& presented_layers) {
+        EXPECT_EQ(presented_layers.size(), 1u);
+        EXPECT_EQ(presented_layers[0]->type,
+                  kFlutterLayerContentTypePlatformView);
+        is_scanout_candidate =
+            presented_layers[0]->platform_view->is_scanout_candidate;
+        return true;
+      });
+  return is_scanout_candidate;
+}
+
+TEST(EmbedderLayersTest, AxisAlignedPlatformViewsAreScanoutCandidates) {
+  MutatorsStack mutators;
+  EXPECT_TRUE(IsScanoutCandidate(mutators));
+
+  mutators.PushTransform(SkMatrix::Translate(10, 20));
+  mutators.PushTransform(SkMatrix::Scale(2, 3));
+  mutators.PushClipRect(SkRect::MakeWH(50, 50));
+  mutators.PushOpacity(255);
+  EXPECT_TRUE(IsScanoutCandidate(mutators));
+  EXPECT_TRUE(IsScanoutCandidate(mutators, SkMatrix::Scale(2, 2)));
+}
+
+TEST(EmbedderLayersTest, TransformedPlatformViewsAreNotScanoutCandidates) {
+  {
+    MutatorsStack mutators;
+    mutators.PushTransform(SkMatrix::RotateDeg(45));
+    EXPECT_FALSE(IsScanoutCandidate(mutators));
+  }
+  {
+    MutatorsStack mutators;
+    mutators.PushTransform(SkMatrix::Scale(-1, 1));
+    EXPECT_FALSE(IsScanoutCandidate(mutators));
+  }
+  {
+    MutatorsStack mutators;
+    EXPECT_FALSE(IsScanoutCandidate(mutators, SkMatrix::RotateDeg(90)));
+  }
+}
+
+TEST(EmbedderLayersTest, ClippedOrBlendedViewsAreNotScanoutCandidates) {
+  {
+    MutatorsStack mutators;
+    mutators.PushOpacity(128);
+    EXPECT_FALSE(IsScanoutCandidate(mutators));
+  }
+  {
+    MutatorsStack mutators;
+    mutators.PushClipRRect(SkRRect::MakeRectXY(SkRect::MakeWH(50, 50), 5, 5));
+    EXPECT_FALSE(IsScanoutCandidate(mutators));
+  }
+  {
+    MutatorsStack mutators;
+    mutators.PushClipPath(SkPath::Circle(25, 25, 25));
+    EXPECT_FALSE(IsScanoutCandidate(mutators));
+  }
+}
+
+TEST(EmbedderLayersTest, BackingStoreLayersCarryTheirDamage) {
+  EmbedderLayers layers(SkISize::Make(800, 600), 1.0,
+                        SkMatrix::Translate(10, 20));
+  FlutterBackingStore store = {};
+  layers.PushBackingStoreLayer(&store, {SkIRect::MakeWH(800, 600)},
+                               {SkIRect::MakeXYWH(100, 100, 50, 50)});
+
+  layers.InvokePresentCallback(
+      [&](const std::vector<const FlutterLayer*>& presented_layers) {
+        EXPECT_EQ(presented_layers.size(), 1u);
+        const auto* present_info =
+            presented_layers[0]->backing_store_present_info;
+        EXPECT_EQ(present_info->struct_size,
+                  sizeof(FlutterBackingStorePresentInfo));
+        EXPECT_EQ(present_info->paint_region->rects_count, 1u);
+
+        const auto* damage = present_info->damage_region;
+        EXPECT_EQ(damage->rects_count, 1u);
+        EXPECT_EQ(damage->rects[0].left, 110);
+        EXPECT_EQ(damage->rects[0].top, 120);
+        EXPECT_EQ(damage->rects[0].right, 160);
+        EXPECT_EQ(damage->rects[0].bottom, 170);
+        return true;
+      });
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -6,7 +6,8 @@
 
 namespace flutter {
 
-EmbedderRenderTargetCache::EmbedderRenderTargetCache() = default;
+EmbedderRenderTargetCache::EmbedderRenderTargetCache(size_t keep_alive_frames)
+    : keep_alive_frames_(keep_alive_frames) {}
 
 EmbedderRenderTargetCache::~EmbedderRenderTargetCache() = default;
 
@@ -17,19 +18,25 @@ EmbedderRenderTargetCache::GetRenderTarget(
   if (compatible_target == cached_render_targets_.end()) {
     return nullptr;
   }
-  auto target = std::move(compatible_target->second);
+  auto target = std::move(compatible_target->second.target);
   cached_render_targets_.erase(compatible_target);
   return target;
 }
 
 std::set<std::unique_ptr<EmbedderRenderTarget>>
-EmbedderRenderTargetCache::ClearAllRenderTargetsInCache() {
-  std::set<std::unique_ptr<EmbedderRenderTarget>> cleared_targets;
-  for (auto& targets : cached_render_targets_) {
-    cleared_targets.insert(std::move(targets.second));
+EmbedderRenderTargetCache::CollectIdleRenderTargets() {
+  std::set<std::unique_ptr<EmbedderRenderTarget>> idle_targets;
+  for (auto it = cached_render_targets_.begin();
+       it != cached_render_targets_.end();) {
+    if (it->second.idle_frames >= keep_alive_frames_) {
+      idle_targets.insert(std::move(it->second.target));
+      it = cached_render_targets_.erase(it);
+    } else {
+      it->second.idle_frames++;
+      ++it;
+    }
   }
-  cached_render_targets_.clear();
-  return cleared_targets;
+  return idle_targets;
 }
 
 void EmbedderRenderTargetCache::CacheRenderTarget(
@@ -39,7 +46,8 @@ void EmbedderRenderTargetCache::CacheRenderTarget(
   }
   auto desc = EmbedderExternalView::RenderTargetDescriptor{
       target->GetRenderTargetSize()};
-  cached_render_targets_.insert(std::make_pair(desc, std::move(target)));
+  cached_render_targets_.insert(
+      std::make_pair(desc, CachedRenderTarget{.target = std::move(target)}));
 }
 
 size_t EmbedderRenderTargetCache::GetCachedTargetsCount() const {
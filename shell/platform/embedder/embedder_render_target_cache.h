@@ -21,27 +21,50 @@ namespace flutter {
 ///
 class EmbedderRenderTargetCache {
  public:
-  EmbedderRenderTargetCache();
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a render target cache.
+  ///
+  /// @param[in]  keep_alive_frames  The number of frames a cached render
+  ///                                target may go unused before
+  ///                                `CollectIdleRenderTargets` returns it for
+  ///                                collection.
+  ///
+  explicit EmbedderRenderTargetCache(size_t keep_alive_frames = 0);
 
   ~EmbedderRenderTargetCache();
 
   std::unique_ptr<EmbedderRenderTarget> GetRenderTarget(
       const EmbedderExternalView::RenderTargetDescriptor& descriptor);
 
-  std::set<std::unique_ptr<EmbedderRenderTarget>>
-  ClearAllRenderTargetsInCache();
+  //----------------------------------------------------------------------------
+  /// @brief      Removes the render targets that went unused for more than the
+  ///             keep-alive number of frames from the cache. This must be
+  ///             called once per frame, after the render targets of the frame
+  ///             have been obtained from the cache.
+  ///
+  /// @return     The render targets to collect.
+  ///
+  std::set<std::unique_ptr<EmbedderRenderTarget>> CollectIdleRenderTargets();
 
   void CacheRenderTarget(std::unique_ptr<EmbedderRenderTarget> target);
 
   size_t GetCachedTargetsCount() const;
 
  private:
+  struct CachedRenderTarget {
+    std::unique_ptr<EmbedderRenderTarget> target;
+    // The number of frames that did not use the render target since it was
+    // cached.
+    size_t idle_frames = 0;
+  };
+
   using CachedRenderTargets = std::unordered_multimap<
       EmbedderExternalView::RenderTargetDescriptor,
-      std::unique_ptr<EmbedderRenderTarget>,
+      CachedRenderTarget,
       EmbedderExternalView::RenderTargetDescriptor::Hash,
       EmbedderExternalView::RenderTargetDescriptor::Equal>;
 
+  const size_t keep_alive_frames_;
   CachedRenderTargets cached_render_targets_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderRenderTargetCache);
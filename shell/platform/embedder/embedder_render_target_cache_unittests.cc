@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class FakeRenderTarget : public EmbedderRenderTarget {
+ public:
+  explicit FakeRenderTarget(SkISize size)
+      : EmbedderRenderTarget({}, nullptr), size_(size) {}
+
+  sk_sp<SkSurface> GetSkiaSurface() const override { return nullptr; }
+
+  impeller::RenderTarget* GetImpellerRenderTarget() const override {
+    return nullptr;
+  }
+
+  std::shared_ptr<impeller::AiksContext> GetAiksContext() const override {
+    return nullptr;
+  }
+
+  SkISize GetRenderTargetSize() const override { return size_; }
+
+ private:
+  const SkISize size_;
+};
+
+EmbedderExternalView::RenderTargetDescriptor MakeDescriptor(int32_t width,
+                                                            int32_t height) {
+  return EmbedderExternalView::RenderTargetDescriptor(
+      SkISize::Make(width, height));
+}
+
+}  // namespace
+
+TEST(EmbedderRenderTargetCacheTest, ReusesTargetsOfTheSameSize) {
+  EmbedderRenderTargetCache cache;
+  cache.CacheRenderTarget(
+      std::make_unique<FakeRenderTarget>(SkISize::Make(800, 600)));
+
+  EXPECT_EQ(cache.GetRenderTarget(MakeDescriptor(801, 600)), nullptr);
+  auto target = cache.GetRenderTarget(MakeDescriptor(800, 600));
+  ASSERT_NE(target, nullptr);
+  EXPECT_EQ(target->GetRenderTargetSize(), SkISize::Make(800, 600));
+  EXPECT_EQ(cache.GetCachedTargetsCount(), 0u);
+}
+
+TEST(EmbedderRenderTargetCacheTest, CollectsUnusedTargetsEveryFrame) {
+  EmbedderRenderTargetCache cache;
+  cache.CacheRenderTarget(
+      std::make_unique<FakeRenderTarget>(SkISize::Make(800, 600)));
+
+  EXPECT_EQ(cache.CollectIdleRenderTargets().size(), 1u);
+  EXPECT_EQ(cache.GetCachedTargetsCount(), 0u);
+}
+
+TEST(EmbedderRenderTargetCacheTest, KeepsUnusedTargetsAlive) {
+  EmbedderRenderTargetCache cache(/*keep_alive_frames=*/2);
+  cache.CacheRenderTarget(
+      std::make_unique<FakeRenderTarget>(SkISize::Make(800, 600)));
+  cache.CacheRenderTarget(
+      std::make_unique<FakeRenderTarget>(SkISize::Make(1024, 768)));
+
+  EXPECT_TRUE(cache.CollectIdleRenderTargets().empty());
+  EXPECT_TRUE(cache.CollectIdleRenderTargets().empty());
+
+  // Using a target resets the number of frames it has been idle for.
+  auto target = cache.GetRenderTarget(MakeDescriptor(800, 600));
+  ASSERT_NE(target, nullptr);
+  cache.CacheRenderTarget(std::move(target));
+
+  auto collected = cache.CollectIdleRenderTargets();
+  ASSERT_EQ(collected.size(), 1u);
+  EXPECT_EQ((*collected.begin())->GetRenderTargetSize(),
+            SkISize::Make(1024, 768));
+  EXPECT_EQ(cache.GetCachedTargetsCount(), 1u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -17,8 +17,10 @@ namespace flutter {
 
 EmbedderSurfaceSoftware::EmbedderSurfaceSoftware(
     SoftwareDispatchTable software_dispatch_table,
-    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
+    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+    size_t tile_raster_thread_count)
     : software_dispatch_table_(std::move(software_dispatch_table)),
+      tile_raster_thread_count_(tile_raster_thread_count),
       external_view_embedder_(std::move(external_view_embedder)) {
   if (!software_dispatch_table_.software_present_backing_store) {
     return;
@@ -39,7 +41,8 @@ std::unique_ptr<Surface> EmbedderSurfaceSoftware::CreateGPUSurface() {
     return nullptr;
   }
   const bool render_to_surface = !external_view_embedder_;
-  auto surface = std::make_unique<GPUSurfaceSoftware>(this, render_to_surface);
+  auto surface = std::make_unique<GPUSurfaceSoftware>(
+      this, render_to_surface, tile_raster_thread_count_);
 
   if (!surface->IsValid()) {
     return nullptr;
@@ -24,13 +24,15 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
 
   EmbedderSurfaceSoftware(
       SoftwareDispatchTable software_dispatch_table,
-      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
+      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+      size_t tile_raster_thread_count = 0);
 
   ~EmbedderSurfaceSoftware() override;
 
  private:
   bool valid_ = false;
   SoftwareDispatchTable software_dispatch_table_;
+  const size_t tile_raster_thread_count_;
   sk_sp<SkSurface> sk_surface_;
   std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
 
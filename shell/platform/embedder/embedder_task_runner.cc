@@ -4,15 +4,19 @@
 
 #include "flutter/shell/platform/embedder/embedder_task_runner.h"
 
+#include <iterator>
+
 #include "flutter/fml/message_loop_impl.h"
 #include "flutter/fml/message_loop_task_queues.h"
 
 namespace flutter {
 
 EmbedderTaskRunner::EmbedderTaskRunner(DispatchTable table,
-                                       size_t embedder_identifier)
+                                       size_t embedder_identifier,
+                                       bool batch_tasks)
     : TaskRunner(nullptr /* loop implemenation*/),
       embedder_identifier_(embedder_identifier),
+      batch_tasks_(batch_tasks),
       dispatch_table_(std::move(table)),
       placeholder_id_(
           fml::MessageLoopTaskQueues::GetInstance()->CreateTaskQueue()) {
@@ -26,31 +30,39 @@ size_t EmbedderTaskRunner::GetEmbedderIdentifier() const {
   return embedder_identifier_;
 }
 
-void EmbedderTaskRunner::PostTask(const fml::closure& task) {
-  PostTaskForTime(task, fml::TimePoint::Now());
+void EmbedderTaskRunner::PostTask(fml::TaskClosure task) {
+  PostTaskForTime(std::move(task), fml::TimePoint::Now());
 }
 
-void EmbedderTaskRunner::PostTaskForTime(const fml::closure& task,
+void EmbedderTaskRunner::PostTaskForTime(fml::TaskClosure task,
                                          fml::TimePoint target_time) {
   if (!task) {
     return;
   }
 
-  uint64_t baton = 0;
+  std::optional<std::pair<uint64_t, fml::TimePoint>> wake_up;
 
   {
     // Release the lock before the jump via the dispatch table.
     std::scoped_lock lock(tasks_mutex_);
-    baton = ++last_baton_;
-    pending_tasks_[baton] = task;
+    uint64_t baton = ++last_baton_;
+    if (batch_tasks_) {
+      batched_tasks_[{target_time, baton}] = std::move(task);
+      wake_up = RequestWakeUp();
+    } else {
+      pending_tasks_[baton] = std::move(task);
+      wake_up = std::make_pair(baton, target_time);
+    }
   }
 
-  dispatch_table_.post_task_callback(this, baton, target_time);
+  if (wake_up) {
+    dispatch_table_.post_task_callback(this, wake_up->first, wake_up->second);
+  }
 }
 
-void EmbedderTaskRunner::PostDelayedTask(const fml::closure& task,
+void EmbedderTaskRunner::PostDelayedTask(fml::TaskClosure task,
                                          fml::TimeDelta delay) {
-  PostTaskForTime(task, fml::TimePoint::Now() + delay);
+  PostTaskForTime(std::move(task), fml::TimePoint::Now() + delay);
 }
 
 bool EmbedderTaskRunner::RunsTasksOnCurrentThread() {
@@ -58,7 +70,17 @@ bool EmbedderTaskRunner::RunsTasksOnCurrentThread() {
 }
 
 bool EmbedderTaskRunner::PostTask(uint64_t baton) {
-  fml::closure task;
+  if (batch_tasks_) {
+    {
+      std::scoped_lock lock(tasks_mutex_);
+      // The wake-up may already have been handled by a call to
+      // |RunExpiredTasks|, which isn't an error.
+      pending_wake_ups_.erase(baton);
+    }
+    return RunExpiredTasks();
+  }
+
+  fml::TaskClosure task;
 
   {
     std::scoped_lock lock(tasks_mutex_);
@@ -67,7 +89,7 @@ bool EmbedderTaskRunner::PostTask(uint64_t baton) {
       FML_LOG(ERROR) << "Embedder attempted to post an unknown task.";
       return false;
     }
-    task = found->second;
+    task = std::move(found->second);
     pending_tasks_.erase(found);
 
     // Let go of the tasks mutex befor executing the task.
@@ -78,9 +100,84 @@ bool EmbedderTaskRunner::PostTask(uint64_t baton) {
   return true;
 }
 
+bool EmbedderTaskRunner::BatchesTasks() const {
+  return batch_tasks_;
+}
+
+bool EmbedderTaskRunner::RunExpiredTasks() {
+  if (!batch_tasks_) {
+    return false;
+  }
+
+  const fml::TimePoint now = fml::TimePoint::Now();
+  uint64_t last_baton = 0;
+  {
+    std::scoped_lock lock(tasks_mutex_);
+    last_baton = last_baton_;
+    // The wake-ups that are due are served by this call.
+    for (auto it = pending_wake_ups_.begin(); it != pending_wake_ups_.end();) {
+      it = it->second <= now ? pending_wake_ups_.erase(it) : std::next(it);
+    }
+  }
+
+  std::optional<std::pair<uint64_t, fml::TimePoint>> wake_up;
+  while (true) {
+    fml::TaskClosure task;
+    {
+      // Let go of the tasks mutex before executing each task.
+      std::scoped_lock lock(tasks_mutex_);
+      auto next = batched_tasks_.begin();
+      if (next == batched_tasks_.end() || next->first.first > now ||
+          next->first.second > last_baton) {
+        wake_up = RequestWakeUp();
+        break;
+      }
+      task = std::move(next->second);
+      batched_tasks_.erase(next);
+    }
+    task();
+  }
+
+  if (wake_up) {
+    dispatch_table_.post_task_callback(this, wake_up->first, wake_up->second);
+  }
+  return true;
+}
+
+std::optional<fml::TimePoint> EmbedderTaskRunner::GetNextTaskTargetTime() {
+  std::scoped_lock lock(tasks_mutex_);
+  if (batched_tasks_.empty()) {
+    return std::nullopt;
+  }
+  return batched_tasks_.begin()->first.first;
+}
+
 // |fml::TaskRunner|
 fml::TaskQueueId EmbedderTaskRunner::GetTaskQueueId() {
   return placeholder_id_;
 }
 
+bool EmbedderTaskRunner::HasWakeUpBy(fml::TimePoint target_time) const {
+  for (const auto& [baton, wake_up_time] : pending_wake_ups_) {
+    if (wake_up_time <= target_time) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::optional<std::pair<uint64_t, fml::TimePoint>>
+EmbedderTaskRunner::RequestWakeUp() {
+  if (batched_tasks_.empty()) {
+    return std::nullopt;
+  }
+  const fml::TimePoint target_time = batched_tasks_.begin()->first.first;
+  if (HasWakeUpBy(target_time)) {
+    return std::nullopt;
+  }
+  uint64_t baton = ++last_baton_;
+  pending_wake_ups_[baton] = target_time;
+  return std::make_pair(baton, target_time);
+}
+
 }  // namespace flutter
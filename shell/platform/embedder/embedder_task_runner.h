@@ -5,8 +5,11 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_TASK_RUNNER_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_TASK_RUNNER_H_
 
+#include <map>
 #include <mutex>
+#include <optional>
 #include <unordered_map>
+#include <utility>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
@@ -52,8 +55,12 @@ class EmbedderTaskRunner final : public fml::TaskRunner {
   ///
   /// @param[in]  table                The task runner dispatch table.
   /// @param[in]  embedder_identifier  The embedder identifier
+  /// @param[in]  batch_tasks          Whether the task runner batches tasks,
+  ///                                  see `RunExpiredTasks`.
   ///
-  EmbedderTaskRunner(DispatchTable table, size_t embedder_identifier);
+  EmbedderTaskRunner(DispatchTable table,
+                     size_t embedder_identifier,
+                     bool batch_tasks = false);
 
   // |fml::TaskRunner|
   ~EmbedderTaskRunner() override;
@@ -69,25 +76,71 @@ class EmbedderTaskRunner final : public fml::TaskRunner {
   ///
   size_t GetEmbedderIdentifier() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Runs the task the embedder was given for `baton`. For a task
+  ///             runner that batches tasks, the baton is a wake-up instead,
+  ///             and running it runs all expired tasks.
+  ///
+  /// @param[in]  baton  The baton passed to the `post_task_callback`.
+  ///
+  /// @return     Whether the baton was known to the task runner. Wake-ups
+  ///             are always accepted, since `RunExpiredTasks` may already
+  ///             have served them.
+  ///
   bool PostTask(uint64_t baton);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the task runner batches tasks. Instead of handing
+  ///             every task to the embedder, such a task runner queues the
+  ///             tasks itself and only calls the `post_task_callback` when it
+  ///             needs to wake up before any wake-up already requested.
+  ///
+  bool BatchesTasks() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Runs the tasks of a task runner that batches tasks whose
+  ///             target time has expired, in the order of their target times.
+  ///             Tasks posted while this runs are left for the next wake-up,
+  ///             so that a task that posts itself can't starve the embedder.
+  ///             Must be called on the thread of the task runner.
+  ///
+  /// @return     Whether the task runner batches tasks.
+  ///
+  bool RunExpiredTasks();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The target time of the earliest task of a task runner that
+  ///             batches tasks.
+  ///
+  /// @return     The target time, or std::nullopt if there are no tasks.
+  ///
+  std::optional<fml::TimePoint> GetNextTaskTargetTime();
+
  private:
   const size_t embedder_identifier_;
+  const bool batch_tasks_;
   DispatchTable dispatch_table_;
   std::mutex tasks_mutex_;
   uint64_t last_baton_ = 0;
-  std::unordered_map<uint64_t, fml::closure> pending_tasks_;
+  std::unordered_map<uint64_t, fml::TaskClosure> pending_tasks_;
+  // The tasks of a task runner that batches tasks, ordered by their target
+  // time and then by their baton, which orders tasks posted for the same time.
+  std::map<std::pair<fml::TimePoint, uint64_t>, fml::TaskClosure>
+      batched_tasks_;
+  // The wake-ups requested from the embedder that haven't happened yet, by
+  // their baton.
+  std::unordered_map<uint64_t, fml::TimePoint> pending_wake_ups_;
   fml::TaskQueueId placeholder_id_;
 
   // |fml::TaskRunner|
-  void PostTask(const fml::closure& task) override;
+  void PostTask(fml::TaskClosure task) override;
 
   // |fml::TaskRunner|
-  void PostTaskForTime(const fml::closure& task,
+  void PostTaskForTime(fml::TaskClosure task,
                        fml::TimePoint target_time) override;
 
   // |fml::TaskRunner|
-  void PostDelayedTask(const fml::closure& task, fml::TimeDelta delay) override;
+  void PostDelayedTask(fml::TaskClosure task, fml::TimeDelta delay) override;
 
   // |fml::TaskRunner|
   bool RunsTasksOnCurrentThread() override;
@@ -95,6 +148,15 @@ class EmbedderTaskRunner final : public fml::TaskRunner {
   // |fml::TaskRunner|
   fml::TaskQueueId GetTaskQueueId() override;
 
+  // Whether a wake-up at or before |target_time| was requested. Must be called
+  // with |tasks_mutex_| held.
+  bool HasWakeUpBy(fml::TimePoint target_time) const;
+
+  // Requests a wake-up for the earliest batched task, unless one that is early
+  // enough was already requested. Must be called with |tasks_mutex_| held.
+  // Returns the baton and time to pass to the |post_task_callback|, if any.
+  std::optional<std::pair<uint64_t, fml::TimePoint>> RequestWakeUp();
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderTaskRunner);
 };
 
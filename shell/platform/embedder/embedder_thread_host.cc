@@ -76,7 +76,8 @@ CreateEmbedderTaskRunner(const FlutterTaskRunnerDescription* description) {
 
   return {true, fml::MakeRefCounted<EmbedderTaskRunner>(
                     task_runner_dispatch_table,
-                    SAFE_ACCESS(description, identifier, 0u))};
+                    SAFE_ACCESS(description, identifier, 0u),
+                    SAFE_ACCESS(description, batch_tasks, false))};
 }
 
 std::unique_ptr<EmbedderThreadHost>
@@ -295,4 +296,13 @@ bool EmbedderThreadHost::PostTask(int64_t runner, uint64_t task) const {
   return found->second->PostTask(task);
 }
 
+fml::RefPtr<EmbedderTaskRunner> EmbedderThreadHost::GetEmbedderTaskRunner(
+    int64_t runner) const {
+  auto found = runners_map_.find(runner);
+  if (found == runners_map_.end()) {
+    return nullptr;
+  }
+  return found->second;
+}
+
 }  // namespace flutter
@@ -38,6 +38,10 @@ class EmbedderThreadHost {
 
   bool PostTask(int64_t runner, uint64_t task) const;
 
+  // Returns the embedder task runner for the |runner| handle, or nullptr if
+  // the handle doesn't belong to this thread host.
+  fml::RefPtr<EmbedderTaskRunner> GetEmbedderTaskRunner(int64_t runner) const;
+
  private:
   ThreadHost host_;
   flutter::TaskRunners runners_;
@@ -1346,3 +1346,28 @@ void render_gradient_retained() {
   };
   PlatformDispatcher.instance.scheduleFrame();
 }
+
+@pragma('vm:entry-point')
+void platform_channel_benchmark() {
+  // Sends |data| to the platform, and sends each response back until the
+  // platform responds without data.
+  void sendToPlatform(ByteData? data) {
+    if (data == null) {
+      return;
+    }
+    PlatformDispatcher.instance.sendPlatformMessage(
+        'benchmark/dart_to_platform', data, sendToPlatform);
+  }
+
+  PlatformDispatcher.instance.onPlatformMessage =
+      (String name, ByteData? data, PlatformMessageResponseCallback? callback) {
+    switch (name) {
+      case 'benchmark/echo':
+        callback!(data);
+      case 'benchmark/start_sending':
+        callback!(null);
+        sendToPlatform(data);
+    }
+  };
+  signalNativeTest();
+}
@@ -0,0 +1,333 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures round trips of platform messages between an embedder and Dart.
+//
+// The platform side encodes and decodes every message with the codec of the
+// benchmark, so the times include the codec work a plugin would do. The Dart
+// side of the fixture only echoes the bytes it receives, since the codecs of
+// the framework are not available to the fixtures.
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
+#include "flutter/shell/platform/embedder/embedder.h"
+#include "flutter/shell/platform/embedder/tests/embedder_config_builder.h"
+#include "flutter/shell/platform/embedder/tests/embedder_test_context_software.h"
+#include "flutter/testing/testing.h"
+#include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr const char* kEchoChannel = "benchmark/echo";
+constexpr const char* kStartSendingChannel = "benchmark/start_sending";
+constexpr const char* kDartToPlatformChannel = "benchmark/dart_to_platform";
+
+constexpr char kPayloadString[] = "0123456789abcdef";
+
+enum class Codec {
+  kBinary,
+  kStandard,
+  kJson,
+};
+
+// Encodes and decodes the messages of a benchmark, which are about
+// |payload_size| bytes long. The standard and JSON codecs encode lists of
+// short strings, which are typical of the structured values plugins send.
+class BenchmarkMessages {
+ public:
+  BenchmarkMessages(Codec codec, size_t payload_size) : codec_(codec) {
+    // Each string takes about as many bytes in both encodings.
+    const size_t string_count =
+        std::max<size_t>(payload_size / (sizeof(kPayloadString) + 2), 1u);
+    switch (codec_) {
+      case Codec::kBinary:
+        bytes_.resize(payload_size, 0x42);
+        break;
+      case Codec::kStandard:
+        standard_value_ = EncodableValue(EncodableList(
+            string_count, EncodableValue(std::string(kPayloadString))));
+        break;
+      case Codec::kJson:
+        json_value_.SetArray();
+        for (size_t i = 0; i < string_count; i++) {
+          json_value_.PushBack(rapidjson::StringRef(kPayloadString),
+                               json_value_.GetAllocator());
+        }
+        break;
+    }
+  }
+
+  std::vector<uint8_t> Encode() const {
+    switch (codec_) {
+      case Codec::kBinary:
+        return bytes_;
+      case Codec::kStandard:
+        return std::move(*StandardMessageCodec::GetInstance().EncodeMessage(
+            standard_value_));
+      case Codec::kJson: {
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        json_value_.Accept(writer);
+        const auto* data = reinterpret_cast<const uint8_t*>(buffer.GetString());
+        return std::vector<uint8_t>(data, data + buffer.GetSize());
+      }
+    }
+    return {};
+  }
+
+  // Whether |data| decodes to a message of the benchmark.
+  bool Decode(const uint8_t* data, size_t size) const {
+    switch (codec_) {
+      case Codec::kBinary:
+        return size == bytes_.size();
+      case Codec::kStandard:
+        return StandardMessageCodec::GetInstance().DecodeMessage(data, size) !=
+               nullptr;
+      case Codec::kJson: {
+        rapidjson::Document document;
+        document.Parse(reinterpret_cast<const char*>(data), size);
+        return !document.HasParseError() && document.IsArray();
+      }
+    }
+    return false;
+  }
+
+ private:
+  const Codec codec_;
+  std::vector<uint8_t> bytes_;
+  EncodableValue standard_value_;
+  rapidjson::Document json_value_;
+
+  BenchmarkMessages(const BenchmarkMessages&) = delete;
+
+  BenchmarkMessages& operator=(const BenchmarkMessages&) = delete;
+};
+
+// Runs the "platform_channel_benchmark" fixture in an engine that uses the
+// default embedder task runners, with a platform task runner on its own
+// thread.
+class ChannelBenchmarkEngine {
+ public:
+  using MessageCallback = std::function<void(const FlutterPlatformMessage*)>;
+
+  // Launches the engine and waits for Dart to handle messages. The messages
+  // Dart sends are passed to |on_message| on the platform thread.
+  explicit ChannelBenchmarkEngine(const MessageCallback& on_message)
+      : platform_thread_("io.flutter.bench.platform"),
+        context_(GetFixturesPath()) {
+    context_.AddNativeCallback(
+        "SignalNativeTest", CREATE_NATIVE_ENTRY([this](Dart_NativeArguments) {
+          dart_ready_.Signal();
+        }));
+
+    fml::AutoResetWaitableEvent launched;
+    PostPlatformTask([&]() {
+      EmbedderConfigBuilder builder(context_);
+      builder.SetSoftwareRendererConfig();
+      builder.SetDartEntrypoint("platform_channel_benchmark");
+      builder.SetPlatformMessageCallback(on_message);
+      engine_ = builder.LaunchEngine();
+      launched.Signal();
+    });
+    launched.Wait();
+    if (engine_.is_valid()) {
+      dart_ready_.Wait();
+    }
+  }
+
+  ~ChannelBenchmarkEngine() {
+    // The engine must be shut down on the thread it was launched on.
+    fml::AutoResetWaitableEvent shutdown;
+    PostPlatformTask([&]() {
+      engine_.reset();
+      shutdown.Signal();
+    });
+    shutdown.Wait();
+  }
+
+  bool IsValid() const { return engine_.is_valid(); }
+
+  FlutterEngine get() const { return engine_.get(); }
+
+  void PostPlatformTask(const fml::closure& task) {
+    platform_thread_.GetTaskRunner()->PostTask(task);
+  }
+
+ private:
+  fml::Thread platform_thread_;
+  EmbedderTestContextSoftware context_;
+  fml::AutoResetWaitableEvent dart_ready_;
+  UniqueEngine engine_;
+
+  ChannelBenchmarkEngine(const ChannelBenchmarkEngine&) = delete;
+
+  ChannelBenchmarkEngine& operator=(const ChannelBenchmarkEngine&) = delete;
+};
+
+// Sends |message| to |channel| on the platform thread of |engine|. The
+// response, if any, is passed to |response_callback|.
+bool SendPlatformMessage(FlutterEngine engine,
+                         const char* channel,
+                         const std::vector<uint8_t>& message,
+                         FlutterDataCallback response_callback,
+                         void* user_data) {
+  FlutterPlatformMessageResponseHandle* response_handle = nullptr;
+  if (response_callback &&
+      FlutterPlatformMessageCreateResponseHandle(
+          engine, response_callback, user_data, &response_handle) !=
+          kSuccess) {
+    return false;
+  }
+  FlutterPlatformMessage platform_message = {};
+  platform_message.struct_size = sizeof(FlutterPlatformMessage);
+  platform_message.channel = channel;
+  platform_message.message = message.data();
+  platform_message.message_size = message.size();
+  platform_message.response_handle = response_handle;
+  bool sent =
+      FlutterEngineSendPlatformMessage(engine, &platform_message) == kSuccess;
+  if (response_handle) {
+    FlutterPlatformMessageReleaseResponseHandle(engine, response_handle);
+  }
+  return sent;
+}
+
+void SetBytesProcessed(benchmark::State& state) {
+  // Each round trip carries a message in both directions.
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          state.range(0) * 2);
+}
+
+}  // namespace
+
+// Sends a message from the platform to Dart and waits for Dart to respond
+// with the same message.
+static void BM_PlatformToDartRoundTrip(benchmark::State& state, Codec codec) {
+  ChannelBenchmarkEngine engine(nullptr);
+  if (!engine.IsValid()) {
+    state.SkipWithError("Could not launch the engine.");
+    return;
+  }
+  BenchmarkMessages messages(codec, state.range(0));
+
+  struct RoundTrip {
+    const BenchmarkMessages& messages;
+    fml::AutoResetWaitableEvent responded;
+    bool decoded = false;
+  };
+  RoundTrip round_trip = {.messages = messages};
+  auto on_response = [](const uint8_t* data, size_t size, void* user_data) {
+    auto* round_trip = reinterpret_cast<RoundTrip*>(user_data);
+    round_trip->decoded = round_trip->messages.Decode(data, size);
+    round_trip->responded.Signal();
+  };
+
+  for ([[maybe_unused]] auto _ : state) {
+    engine.PostPlatformTask([&]() {
+      FML_CHECK(SendPlatformMessage(engine.get(), kEchoChannel,
+                                    messages.Encode(), on_response,
+                                    &round_trip));
+    });
+    round_trip.responded.Wait();
+    if (!round_trip.decoded) {
+      state.SkipWithError("Could not decode the response.");
+      return;
+    }
+  }
+  SetBytesProcessed(state);
+}
+
+// Responds to a message Dart sent to the platform and waits for Dart to send
+// the response back as its next message.
+static void BM_DartToPlatformRoundTrip(benchmark::State& state, Codec codec) {
+  BenchmarkMessages messages(codec, state.range(0));
+
+  struct RoundTrip {
+    fml::AutoResetWaitableEvent received;
+    const FlutterPlatformMessageResponseHandle* response_handle = nullptr;
+    bool decoded = false;
+  };
+  RoundTrip round_trip;
+  ChannelBenchmarkEngine engine([&](const FlutterPlatformMessage* message) {
+    if (std::strcmp(message->channel, kDartToPlatformChannel) != 0) {
+      return;
+    }
+    round_trip.decoded =
+        messages.Decode(message->message, message->message_size);
+    round_trip.response_handle = message->response_handle;
+    round_trip.received.Signal();
+  });
+  if (!engine.IsValid()) {
+    state.SkipWithError("Could not launch the engine.");
+    return;
+  }
+
+  engine.PostPlatformTask([&]() {
+    FML_CHECK(SendPlatformMessage(engine.get(), kStartSendingChannel,
+                                  messages.Encode(), nullptr, nullptr));
+  });
+  round_trip.received.Wait();
+
+  for ([[maybe_unused]] auto _ : state) {
+    if (!round_trip.decoded) {
+      state.SkipWithError("Could not decode the message.");
+      break;
+    }
+    engine.PostPlatformTask([&]() {
+      auto response = messages.Encode();
+      FlutterEngineSendPlatformMessageResponse(
+          engine.get(), round_trip.response_handle, response.data(),
+          response.size());
+    });
+    round_trip.received.Wait();
+  }
+
+  // Responding without data stops Dart from sending more messages.
+  fml::AutoResetWaitableEvent stopped;
+  engine.PostPlatformTask([&]() {
+    FlutterEngineSendPlatformMessageResponse(
+        engine.get(), round_trip.response_handle, nullptr, 0u);
+    stopped.Signal();
+  });
+  stopped.Wait();
+  SetBytesProcessed(state);
+}
+
+static void ApplyPayloadSizes(benchmark::internal::Benchmark* benchmark) {
+  // 16 B to 16 MB.
+  benchmark->RangeMultiplier(16)
+      ->Range(16, 16 << 20)
+      ->UseRealTime()
+      ->Unit(benchmark::kMicrosecond);
+}
+
+BENCHMARK_CAPTURE(BM_PlatformToDartRoundTrip, Binary, Codec::kBinary)
+    ->Apply(ApplyPayloadSizes);
+BENCHMARK_CAPTURE(BM_PlatformToDartRoundTrip, Standard, Codec::kStandard)
+    ->Apply(ApplyPayloadSizes);
+BENCHMARK_CAPTURE(BM_PlatformToDartRoundTrip, Json, Codec::kJson)
+    ->Apply(ApplyPayloadSizes);
+
+BENCHMARK_CAPTURE(BM_DartToPlatformRoundTrip, Binary, Codec::kBinary)
+    ->Apply(ApplyPayloadSizes);
+BENCHMARK_CAPTURE(BM_DartToPlatformRoundTrip, Standard, Codec::kStandard)
+    ->Apply(ApplyPayloadSizes);
+BENCHMARK_CAPTURE(BM_DartToPlatformRoundTrip, Json, Codec::kJson)
+    ->Apply(ApplyPayloadSizes);
+
+}  // namespace testing
+}  // namespace flutter
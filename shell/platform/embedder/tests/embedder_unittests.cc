@@ -23,6 +23,7 @@
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/shell/platform/embedder/embedder_task_runner.h"
 #include "flutter/shell/platform/embedder/tests/embedder_assertions.h"
 #include "flutter/shell/platform/embedder/tests/embedder_config_builder.h"
 #include "flutter/shell/platform/embedder/tests/embedder_test.h"
@@ -272,6 +273,66 @@ TEST(EmbedderTestNoFixture, CanGetCurrentTimeInNanoseconds) {
   ASSERT_LT((point2 - point1), fml::TimeDelta::FromMilliseconds(1));
 }
 
+TEST(EmbedderTestNoFixture, BatchingTaskRunnerCoalescesWakeUps) {
+  std::vector<std::pair<uint64_t, fml::TimePoint>> wake_ups;
+  EmbedderTaskRunner::DispatchTable table = {
+      .post_task_callback =
+          [&](EmbedderTaskRunner* task_runner, uint64_t baton,
+              fml::TimePoint target_time) {
+            wake_ups.emplace_back(baton, target_time);
+          },
+      .runs_task_on_current_thread_callback = []() { return true; },
+  };
+  auto embedder_task_runner =
+      fml::MakeRefCounted<EmbedderTaskRunner>(table, 0u, true);
+  fml::RefPtr<fml::TaskRunner> task_runner = embedder_task_runner;
+  ASSERT_TRUE(embedder_task_runner->BatchesTasks());
+  ASSERT_FALSE(embedder_task_runner->GetNextTaskTargetTime().has_value());
+
+  std::vector<int> order;
+  task_runner->PostTask([&]() { order.push_back(1); });
+  task_runner->PostTask([&]() {
+    order.push_back(2);
+    // Posted while tasks run, so it is left for the next wake-up.
+    task_runner->PostTask([&]() { order.push_back(4); });
+  });
+  task_runner->PostTask([&]() { order.push_back(3); });
+  const fml::TimePoint later =
+      fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(3600);
+  task_runner->PostTaskForTime([&]() { order.push_back(5); }, later);
+
+  // A single wake-up covers all the tasks.
+  ASSERT_EQ(wake_ups.size(), 1u);
+  ASSERT_LE(embedder_task_runner->GetNextTaskTargetTime().value(),
+            fml::TimePoint::Now());
+
+  ASSERT_TRUE(embedder_task_runner->PostTask(wake_ups[0].first));
+  EXPECT_EQ(order, std::vector<int>({1, 2, 3}));
+  ASSERT_EQ(wake_ups.size(), 2u);
+
+  ASSERT_TRUE(embedder_task_runner->RunExpiredTasks());
+  EXPECT_EQ(order, std::vector<int>({1, 2, 3, 4}));
+  EXPECT_EQ(embedder_task_runner->GetNextTaskTargetTime().value(), later);
+  ASSERT_EQ(wake_ups.size(), 3u);
+  EXPECT_EQ(wake_ups[2].second, later);
+}
+
+TEST(EmbedderTestNoFixture, NonBatchingTaskRunnerCanNotRunExpiredTasks) {
+  EmbedderTaskRunner::DispatchTable table = {
+      .post_task_callback = [](EmbedderTaskRunner* task_runner,
+                               uint64_t baton, fml::TimePoint target_time) {},
+      .runs_task_on_current_thread_callback = []() { return true; },
+  };
+  auto task_runner = fml::MakeRefCounted<EmbedderTaskRunner>(table, 0u);
+  ASSERT_FALSE(task_runner->BatchesTasks());
+  ASSERT_FALSE(task_runner->RunExpiredTasks());
+
+  uint64_t target_time = 0;
+  ASSERT_EQ(FlutterEngineRunExpiredTasks(nullptr, nullptr), kInvalidArguments);
+  ASSERT_EQ(FlutterEngineGetNextTaskTargetTime(nullptr, nullptr, &target_time),
+            kInvalidArguments);
+}
+
 TEST_F(EmbedderTest, CanReloadSystemFonts) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
   EmbedderConfigBuilder builder(context);
@@ -1189,6 +1250,52 @@ TEST_F(EmbedderTest, CanDeinitializeAnEngine) {
   engine.reset();
 }
 
+//------------------------------------------------------------------------------
+/// Test that an engine can be deinitialized without blocking the caller.
+///
+TEST_F(EmbedderTest, CanDeinitializeAnEngineAsynchronously) {
+  EmbedderConfigBuilder builder(
+      GetEmbedderContext(EmbedderTestContextType::kSoftwareContext));
+  builder.SetSoftwareRendererConfig();
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  fml::AutoResetWaitableEvent latch;
+  ASSERT_EQ(FlutterEngineDeinitializeAsync(
+                engine.get(),
+                [](void* user_data) {
+                  reinterpret_cast<fml::AutoResetWaitableEvent*>(user_data)
+                      ->Signal();
+                },
+                &latch),
+            kSuccess);
+  // The engine is de-initialized as soon as the call returns.
+  ASSERT_EQ(FlutterEngineDeinitializeAsync(engine.get(), nullptr, nullptr),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineScheduleFrame(engine.get()), kInvalidArguments);
+
+  latch.Wait();
+  engine.reset();
+}
+
+TEST_F(EmbedderTest, CanPrefetchAssets) {
+  EmbedderConfigBuilder builder(
+      GetEmbedderContext(EmbedderTestContextType::kSoftwareContext));
+  builder.SetSoftwareRendererConfig();
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  const char* asset_names[] = {"kernel_blob.bin", "missing_asset"};
+  ASSERT_EQ(FlutterEnginePrefetchAssets(engine.get(), asset_names, 2),
+            kSuccess);
+  ASSERT_EQ(FlutterEnginePrefetchAssets(engine.get(), nullptr, 0), kSuccess);
+  ASSERT_EQ(FlutterEnginePrefetchAssets(engine.get(), nullptr, 1),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEnginePrefetchAssets(nullptr, asset_names, 2),
+            kInvalidArguments);
+  engine.reset();
+}
+
 TEST_F(EmbedderTest, CanUpdateLocales) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
   EmbedderConfigBuilder builder(context);
@@ -1403,6 +1510,38 @@ TEST_F(EmbedderTest, VerifyB143464703WithSoftwareBackend) {
       ImageMatchesFixture("verifyb143464703_soft_noxform.png", rendered_scene));
 }
 
+TEST_F(EmbedderTest, SoftwareTiledRasterizationMatchesDirectRasterization) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  auto render_gradient = [&](size_t tile_raster_thread_count) {
+    EmbedderConfigBuilder builder(context);
+    builder.SetSoftwareRendererConfig(SkISize::Make(800, 600));
+    builder.GetRendererConfig().software.tile_raster_thread_count =
+        tile_raster_thread_count;
+    builder.SetDartEntrypoint("render_gradient");
+
+    auto rendered_scene = context.GetNextSceneImage();
+
+    auto engine = builder.LaunchEngine();
+    EXPECT_TRUE(engine.is_valid());
+
+    FlutterWindowMetricsEvent event = {};
+    event.struct_size = sizeof(event);
+    event.width = 800;
+    event.height = 600;
+    event.pixel_ratio = 1.0;
+    EXPECT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+              kSuccess);
+    return rendered_scene.get();
+  };
+
+  auto direct_scene = render_gradient(0);
+  auto tiled_scene = render_gradient(3);
+  ASSERT_TRUE(direct_scene);
+  ASSERT_TRUE(tiled_scene);
+  ASSERT_TRUE(RasterImagesAreSame(direct_scene, tiled_scene));
+}
+
 TEST_F(EmbedderTest, CanSendLowMemoryNotification) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
 
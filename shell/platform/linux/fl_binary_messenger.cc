@@ -434,6 +434,117 @@ G_MODULE_EXPORT void fl_binary_messenger_set_message_handler_on_channel(
       self, channel, handler, user_data, destroy_notify);
 }
 
+// A handler that is called from a GMainContext. It is shared by the messages
+// waiting to be handled on the context, so that the user data is only freed
+// once they have all been handled.
+typedef struct {
+  gint ref_count;
+  FlBinaryMessengerMessageHandler handler;
+  gpointer user_data;
+  GDestroyNotify destroy_notify;
+  GMainContext* context;
+} ContextMessageHandler;
+
+static ContextMessageHandler* context_message_handler_ref(
+    ContextMessageHandler* self) {
+  g_atomic_int_inc(&self->ref_count);
+  return self;
+}
+
+static void context_message_handler_unref(gpointer data) {
+  ContextMessageHandler* self = static_cast<ContextMessageHandler*>(data);
+  if (!g_atomic_int_dec_and_test(&self->ref_count)) {
+    return;
+  }
+  if (self->destroy_notify != nullptr) {
+    self->destroy_notify(self->user_data);
+  }
+  g_main_context_unref(self->context);
+  g_free(self);
+}
+
+// A message waiting to be handled on a GMainContext.
+typedef struct {
+  ContextMessageHandler* handler;
+  FlBinaryMessenger* messenger;
+  gchar* channel;
+  GBytes* message;
+  FlBinaryMessengerResponseHandle* response_handle;
+} ContextMessage;
+
+static void context_message_free(gpointer data) {
+  ContextMessage* self = static_cast<ContextMessage*>(data);
+  context_message_handler_unref(self->handler);
+  g_object_unref(self->messenger);
+  g_free(self->channel);
+  g_bytes_unref(self->message);
+  g_object_unref(self->response_handle);
+  g_free(self);
+}
+
+static gboolean context_message_dispatch_cb(gpointer data) {
+  ContextMessage* self = static_cast<ContextMessage*>(data);
+  self->handler->handler(self->messenger, self->channel, self->message,
+                         self->response_handle, self->handler->user_data);
+  return G_SOURCE_REMOVE;
+}
+
+// Called on the platform thread to queue a message on the handler's context.
+static void context_message_cb(FlBinaryMessenger* messenger,
+                               const gchar* channel,
+                               GBytes* message,
+                               FlBinaryMessengerResponseHandle* response_handle,
+                               gpointer user_data) {
+  ContextMessageHandler* handler =
+      static_cast<ContextMessageHandler*>(user_data);
+
+  ContextMessage* context_message = g_new0(ContextMessage, 1);
+  context_message->handler = context_message_handler_ref(handler);
+  context_message->messenger = FL_BINARY_MESSENGER(g_object_ref(messenger));
+  context_message->channel = g_strdup(channel);
+  context_message->message =
+      message != nullptr ? g_bytes_ref(message) : g_bytes_new(nullptr, 0);
+  context_message->response_handle =
+      FL_BINARY_MESSENGER_RESPONSE_HANDLE(g_object_ref(response_handle));
+
+  // An idle source always queues the message, while g_main_context_invoke()
+  // may call the handler right away on this thread.
+  g_autoptr(GSource) source = g_idle_source_new();
+  g_source_set_priority(source, G_PRIORITY_DEFAULT);
+  g_source_set_callback(source, context_message_dispatch_cb, context_message,
+                        context_message_free);
+  g_source_attach(source, handler->context);
+}
+
+G_MODULE_EXPORT void
+fl_binary_messenger_set_message_handler_on_channel_with_context(
+    FlBinaryMessenger* self,
+    const gchar* channel,
+    FlBinaryMessengerMessageHandler handler,
+    gpointer user_data,
+    GDestroyNotify destroy_notify,
+    GMainContext* context) {
+  g_return_if_fail(FL_IS_BINARY_MESSENGER(self));
+  g_return_if_fail(channel != nullptr);
+
+  if (handler == nullptr) {
+    fl_binary_messenger_set_message_handler_on_channel(
+        self, channel, nullptr, user_data, destroy_notify);
+    return;
+  }
+
+  ContextMessageHandler* context_handler = g_new0(ContextMessageHandler, 1);
+  context_handler->ref_count = 1;
+  context_handler->handler = handler;
+  context_handler->user_data = user_data;
+  context_handler->destroy_notify = destroy_notify;
+  context_handler->context = g_main_context_ref(
+      context != nullptr ? context : g_main_context_default());
+  fl_binary_messenger_set_message_handler_on_channel(
+      self, channel, context_message_cb, context_handler,
+      context_message_handler_unref);
+}
+
 // Note: This function can be called from any thread.
 G_MODULE_EXPORT gboolean fl_binary_messenger_send_response(
     FlBinaryMessenger* self,
@@ -628,6 +628,59 @@ TEST(FlBinaryMessengerTest, RespondOnBackgroundThread) {
   g_main_loop_run(loop);
 }
 
+static gpointer context_thread_main(gpointer user_data) {
+  GMainLoop* loop = static_cast<GMainLoop*>(user_data);
+  g_main_context_push_thread_default(g_main_loop_get_context(loop));
+  g_main_loop_run(loop);
+  g_main_context_pop_thread_default(g_main_loop_get_context(loop));
+  return nullptr;
+}
+
+// Called on the background context in the ReceiveMessageOnContext test.
+static void message_on_context_cb(
+    FlBinaryMessenger* messenger,
+    const gchar* channel,
+    GBytes* message,
+    FlBinaryMessengerResponseHandle* response_handle,
+    gpointer user_data) {
+  EXPECT_TRUE(g_main_context_is_owner(static_cast<GMainContext*>(user_data)));
+  EXPECT_FALSE(g_main_context_is_owner(g_main_context_default()));
+  message_cb(messenger, channel, message, response_handle, nullptr);
+}
+
+// Checks handlers can receive and respond to messages on another thread.
+TEST(FlBinaryMessengerTest, ReceiveMessageOnContext) {
+  g_autoptr(GMainLoop) loop = g_main_loop_new(nullptr, 0);
+  g_autoptr(GMainContext) context = g_main_context_new();
+  g_autoptr(GMainLoop) context_loop = g_main_loop_new(context, 0);
+  GThread* thread =
+      g_thread_new("background", context_thread_main, context_loop);
+
+  g_autoptr(FlEngine) engine = make_mock_engine();
+  FlBinaryMessenger* messenger = fl_binary_messenger_new(engine);
+
+  // Listen for messages from the engine on the background context.
+  fl_binary_messenger_set_message_handler_on_channel_with_context(
+      messenger, "test/messages", message_on_context_cb, context, nullptr,
+      context);
+
+  // Listen for response from the engine.
+  fl_binary_messenger_set_message_handler_on_channel(
+      messenger, "test/responses", response_cb, loop, nullptr);
+
+  // Trigger the engine to send a message.
+  const char* text = "Marco!";
+  g_autoptr(GBytes) message = g_bytes_new(text, strlen(text));
+  fl_binary_messenger_send_on_channel(messenger, "test/send-message", message,
+                                      nullptr, nullptr, nullptr);
+
+  // Blocks here until response_cb is called.
+  g_main_loop_run(loop);
+
+  g_main_loop_quit(context_loop);
+  g_thread_join(thread);
+}
+
 static void kill_handler_notify_cb(gpointer was_called) {
   *static_cast<gboolean*>(was_called) = TRUE;
 }
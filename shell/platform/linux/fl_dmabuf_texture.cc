@@ -0,0 +1,253 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_dmabuf_texture.h"
+
+#include <epoxy/egl.h>
+#include <epoxy/gl.h>
+#include <gmodule.h>
+
+#include "flutter/shell/platform/linux/fl_dmabuf_texture_private.h"
+#include "flutter/shell/platform/linux/fl_renderer.h"
+
+typedef struct {
+  int64_t id;
+  GLuint texture_id;
+  GLenum target;
+} FlDmabufTexturePrivate;
+
+// EGL attributes used to describe each plane of a DMA-BUF.
+typedef struct {
+  EGLint fd;
+  EGLint offset;
+  EGLint pitch;
+  EGLint modifier_lo;
+  EGLint modifier_hi;
+} PlaneAttributes;
+
+static const PlaneAttributes kPlaneAttributes[FL_DMABUF_TEXTURE_MAX_PLANES] = {
+    {EGL_DMA_BUF_PLANE0_FD_EXT, EGL_DMA_BUF_PLANE0_OFFSET_EXT,
+     EGL_DMA_BUF_PLANE0_PITCH_EXT, EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT,
+     EGL_DMA_BUF_PLANE0_MODIFIER_HI_EXT},
+    {EGL_DMA_BUF_PLANE1_FD_EXT, EGL_DMA_BUF_PLANE1_OFFSET_EXT,
+     EGL_DMA_BUF_PLANE1_PITCH_EXT, EGL_DMA_BUF_PLANE1_MODIFIER_LO_EXT,
+     EGL_DMA_BUF_PLANE1_MODIFIER_HI_EXT},
+    {EGL_DMA_BUF_PLANE2_FD_EXT, EGL_DMA_BUF_PLANE2_OFFSET_EXT,
+     EGL_DMA_BUF_PLANE2_PITCH_EXT, EGL_DMA_BUF_PLANE2_MODIFIER_LO_EXT,
+     EGL_DMA_BUF_PLANE2_MODIFIER_HI_EXT},
+    {EGL_DMA_BUF_PLANE3_FD_EXT, EGL_DMA_BUF_PLANE3_OFFSET_EXT,
+     EGL_DMA_BUF_PLANE3_PITCH_EXT, EGL_DMA_BUF_PLANE3_MODIFIER_LO_EXT,
+     EGL_DMA_BUF_PLANE3_MODIFIER_HI_EXT},
+};
+
+static void fl_dmabuf_texture_iface_init(FlTextureInterface* iface);
+
+G_DEFINE_TYPE_WITH_CODE(FlDmabufTexture,
+                        fl_dmabuf_texture,
+                        G_TYPE_OBJECT,
+                        G_IMPLEMENT_INTERFACE(fl_texture_get_type(),
+                                              fl_dmabuf_texture_iface_init);
+                        G_ADD_PRIVATE(FlDmabufTexture))
+
+// Implements FlTexture::set_id
+static void fl_dmabuf_texture_set_id(FlTexture* texture, int64_t id) {
+  FlDmabufTexture* self = FL_DMABUF_TEXTURE(texture);
+  FlDmabufTexturePrivate* priv = reinterpret_cast<FlDmabufTexturePrivate*>(
+      fl_dmabuf_texture_get_instance_private(self));
+  priv->id = id;
+}
+
+// Implements FlTexture::get_id
+static int64_t fl_dmabuf_texture_get_id(FlTexture* texture) {
+  FlDmabufTexture* self = FL_DMABUF_TEXTURE(texture);
+  FlDmabufTexturePrivate* priv = reinterpret_cast<FlDmabufTexturePrivate*>(
+      fl_dmabuf_texture_get_instance_private(self));
+  return priv->id;
+}
+
+static void fl_dmabuf_texture_iface_init(FlTextureInterface* iface) {
+  iface->set_id = fl_dmabuf_texture_set_id;
+  iface->get_id = fl_dmabuf_texture_get_id;
+}
+
+static void fl_dmabuf_texture_dispose(GObject* object) {
+  FlDmabufTexture* self = FL_DMABUF_TEXTURE(object);
+  FlDmabufTexturePrivate* priv = reinterpret_cast<FlDmabufTexturePrivate*>(
+      fl_dmabuf_texture_get_instance_private(self));
+
+  if (priv->texture_id) {
+    glDeleteTextures(1, &priv->texture_id);
+    priv->texture_id = 0;
+  }
+
+  G_OBJECT_CLASS(fl_dmabuf_texture_parent_class)->dispose(object);
+}
+
+static void fl_dmabuf_texture_class_init(FlDmabufTextureClass* klass) {
+  G_OBJECT_CLASS(klass)->dispose = fl_dmabuf_texture_dispose;
+}
+
+static void fl_dmabuf_texture_init(FlDmabufTexture* self) {}
+
+static constexpr uint32_t fourcc_code(char a, char b, char c, char d) {
+  return static_cast<uint32_t>(a) | static_cast<uint32_t>(b) << 8 |
+         static_cast<uint32_t>(c) << 16 | static_cast<uint32_t>(d) << 24;
+}
+
+// Returns TRUE if @fourcc is a single plane RGB format, which can be bound
+// to a GL_TEXTURE_2D. Other formats need to be sampled through
+// GL_TEXTURE_EXTERNAL_OES so that the driver converts them to RGB.
+static gboolean is_rgb_format(uint32_t fourcc) {
+  switch (fourcc) {
+    case fourcc_code('A', 'R', '2', '4'):  // DRM_FORMAT_ARGB8888
+    case fourcc_code('X', 'R', '2', '4'):  // DRM_FORMAT_XRGB8888
+    case fourcc_code('A', 'B', '2', '4'):  // DRM_FORMAT_ABGR8888
+    case fourcc_code('X', 'B', '2', '4'):  // DRM_FORMAT_XBGR8888
+    case fourcc_code('R', 'A', '2', '4'):  // DRM_FORMAT_RGBA8888
+    case fourcc_code('R', 'X', '2', '4'):  // DRM_FORMAT_RGBX8888
+    case fourcc_code('B', 'A', '2', '4'):  // DRM_FORMAT_BGRA8888
+    case fourcc_code('B', 'X', '2', '4'):  // DRM_FORMAT_BGRX8888
+      return TRUE;
+    default:
+      return FALSE;
+  }
+}
+
+static EGLImageKHR create_image(EGLDisplay display,
+                                const FlDmabuf* dmabuf,
+                                GError** error) {
+  gboolean has_modifier =
+      dmabuf->modifier != FL_DMABUF_TEXTURE_MODIFIER_INVALID;
+  if ((has_modifier || dmabuf->n_planes > 3) &&
+      !epoxy_has_egl_extension(display,
+                               "EGL_EXT_image_dma_buf_import_modifiers")) {
+    g_set_error(error, fl_renderer_error_quark(), FL_RENDERER_ERROR_FAILED,
+                "EGL_EXT_image_dma_buf_import_modifiers is not supported");
+    return EGL_NO_IMAGE_KHR;
+  }
+
+  // Six attributes for the buffer, ten for each plane and the terminator.
+  EGLint attributes[6 + 10 * FL_DMABUF_TEXTURE_MAX_PLANES + 1];
+  size_t n = 0;
+  attributes[n++] = EGL_WIDTH;
+  attributes[n++] = static_cast<EGLint>(dmabuf->width);
+  attributes[n++] = EGL_HEIGHT;
+  attributes[n++] = static_cast<EGLint>(dmabuf->height);
+  attributes[n++] = EGL_LINUX_DRM_FOURCC_EXT;
+  attributes[n++] = static_cast<EGLint>(dmabuf->fourcc);
+  for (uint32_t i = 0; i < dmabuf->n_planes; i++) {
+    const PlaneAttributes* plane_attributes = &kPlaneAttributes[i];
+    const FlDmabufPlane* plane = &dmabuf->planes[i];
+    attributes[n++] = plane_attributes->fd;
+    attributes[n++] = plane->fd;
+    attributes[n++] = plane_attributes->offset;
+    attributes[n++] = static_cast<EGLint>(plane->offset);
+    attributes[n++] = plane_attributes->pitch;
+    attributes[n++] = static_cast<EGLint>(plane->stride);
+    if (has_modifier) {
+      attributes[n++] = plane_attributes->modifier_lo;
+      attributes[n++] = static_cast<EGLint>(dmabuf->modifier & 0xffffffff);
+      attributes[n++] = plane_attributes->modifier_hi;
+      attributes[n++] = static_cast<EGLint>(dmabuf->modifier >> 32);
+    }
+  }
+  attributes[n++] = EGL_NONE;
+
+  EGLImageKHR image = eglCreateImageKHR(display, EGL_NO_CONTEXT,
+                                        EGL_LINUX_DMA_BUF_EXT, nullptr,
+                                        attributes);
+  if (image == EGL_NO_IMAGE_KHR) {
+    g_set_error(error, fl_renderer_error_quark(), FL_RENDERER_ERROR_FAILED,
+                "Failed to import DMA-BUF: EGL error 0x%x", eglGetError());
+  }
+  return image;
+}
+
+gboolean fl_dmabuf_texture_populate(FlDmabufTexture* texture,
+                                    uint32_t width,
+                                    uint32_t height,
+                                    FlutterOpenGLTexture* opengl_texture,
+                                    GError** error) {
+  FlDmabufTexture* self = FL_DMABUF_TEXTURE(texture);
+  FlDmabufTexturePrivate* priv = reinterpret_cast<FlDmabufTexturePrivate*>(
+      fl_dmabuf_texture_get_instance_private(self));
+
+  FlDmabuf dmabuf = {};
+  dmabuf.width = width;
+  dmabuf.height = height;
+  dmabuf.modifier = FL_DMABUF_TEXTURE_MODIFIER_INVALID;
+  if (!FL_DMABUF_TEXTURE_GET_CLASS(self)->get_dmabuf(self, &dmabuf, error)) {
+    return FALSE;
+  }
+
+  if (dmabuf.n_planes == 0 ||
+      dmabuf.n_planes > FL_DMABUF_TEXTURE_MAX_PLANES) {
+    g_set_error(error, fl_renderer_error_quark(), FL_RENDERER_ERROR_FAILED,
+                "Invalid number of DMA-BUF planes %u", dmabuf.n_planes);
+    return FALSE;
+  }
+
+  EGLDisplay display = eglGetCurrentDisplay();
+  if (display == EGL_NO_DISPLAY ||
+      !epoxy_has_egl_extension(display, "EGL_EXT_image_dma_buf_import")) {
+    g_set_error(error, fl_renderer_error_quark(), FL_RENDERER_ERROR_FAILED,
+                "EGL_EXT_image_dma_buf_import is not supported");
+    return FALSE;
+  }
+
+  GLenum target = dmabuf.n_planes == 1 && is_rgb_format(dmabuf.fourcc)
+                      ? GL_TEXTURE_2D
+                      : GL_TEXTURE_EXTERNAL_OES;
+  if (target == GL_TEXTURE_EXTERNAL_OES &&
+      !epoxy_has_gl_extension("GL_OES_EGL_image_external")) {
+    g_set_error(error, fl_renderer_error_quark(), FL_RENDERER_ERROR_FAILED,
+                "DMA-BUF format 0x%08x requires GL_OES_EGL_image_external",
+                dmabuf.fourcc);
+    return FALSE;
+  }
+
+  EGLImageKHR image = create_image(display, &dmabuf, error);
+  if (image == EGL_NO_IMAGE_KHR) {
+    return FALSE;
+  }
+
+  // A texture can't change its target once it has been bound.
+  if (priv->texture_id != 0 && priv->target != target) {
+    glDeleteTextures(1, &priv->texture_id);
+    priv->texture_id = 0;
+  }
+  if (priv->texture_id == 0) {
+    glGenTextures(1, &priv->texture_id);
+    glBindTexture(target, priv->texture_id);
+    glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    priv->target = target;
+  } else {
+    glBindTexture(target, priv->texture_id);
+  }
+  glEGLImageTargetTexture2DOES(target, image);
+
+  // The texture keeps a reference to the buffer, so the image is no longer
+  // needed.
+  eglDestroyImageKHR(display, image);
+
+  GLenum gl_error = glGetError();
+  if (gl_error != GL_NO_ERROR) {
+    g_set_error(error, fl_renderer_error_quark(), FL_RENDERER_ERROR_FAILED,
+                "Failed to bind DMA-BUF to texture: GL error 0x%x", gl_error);
+    return FALSE;
+  }
+
+  opengl_texture->target = target;
+  opengl_texture->name = priv->texture_id;
+  opengl_texture->format = GL_RGBA8;
+  opengl_texture->destruction_callback = nullptr;
+  opengl_texture->user_data = nullptr;
+  opengl_texture->width = dmabuf.width;
+  opengl_texture->height = dmabuf.height;
+
+  return TRUE;
+}
@@ -0,0 +1,35 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_DMABUF_TEXTURE_PRIVATE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_FL_DMABUF_TEXTURE_PRIVATE_H_
+
+#include "flutter/shell/platform/embedder/embedder.h"
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_dmabuf_texture.h"
+
+G_BEGIN_DECLS
+
+/**
+ * fl_dmabuf_texture_populate:
+ * @texture: an #FlDmabufTexture.
+ * @width: width of the texture.
+ * @height: height of the texture.
+ * @opengl_texture: (out): return an #FlutterOpenGLTexture.
+ * @error: (allow-none): #GError location to store the error occurring, or
+ * %NULL to ignore.
+ *
+ * Imports the current frame of @texture into an OpenGL texture and populates
+ * the specified @opengl_texture with its details.
+ *
+ * Returns: %TRUE on success.
+ */
+gboolean fl_dmabuf_texture_populate(FlDmabufTexture* texture,
+                                    uint32_t width,
+                                    uint32_t height,
+                                    FlutterOpenGLTexture* opengl_texture,
+                                    GError** error);
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_DMABUF_TEXTURE_PRIVATE_H_
@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_dmabuf_texture.h"
+#include "flutter/shell/platform/linux/fl_dmabuf_texture_private.h"
+#include "flutter/shell/platform/linux/fl_texture_private.h"
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_texture.h"
+#include "flutter/shell/platform/linux/testing/fl_test.h"
+#include "gtest/gtest.h"
+
+#include <epoxy/egl.h>
+#include <epoxy/gl.h>
+#include <gio/gio.h>
+
+static constexpr uint32_t kBufferWidth = 4u;
+static constexpr uint32_t kBufferHeight = 4u;
+static constexpr uint32_t kFrameWidth = 2u;
+static constexpr uint32_t kFrameHeight = 2u;
+
+// DRM_FORMAT_XRGB8888.
+static constexpr uint32_t kXrgb8888 = 0x34325258;
+
+G_DECLARE_FINAL_TYPE(FlTestDmabufTexture,
+                     fl_test_dmabuf_texture,
+                     FL,
+                     TEST_DMABUF_TEXTURE,
+                     FlDmabufTexture)
+
+/// A texture that returns a fixed frame, or fails if it has no planes.
+struct _FlTestDmabufTexture {
+  FlDmabufTexture parent_instance;
+
+  uint32_t n_planes;
+};
+
+G_DEFINE_TYPE(FlTestDmabufTexture,
+              fl_test_dmabuf_texture,
+              fl_dmabuf_texture_get_type())
+
+static gboolean fl_test_dmabuf_texture_get_dmabuf(FlDmabufTexture* texture,
+                                                  FlDmabuf* dmabuf,
+                                                  GError** error) {
+  FlTestDmabufTexture* self = FL_TEST_DMABUF_TEXTURE(texture);
+
+  EXPECT_EQ(dmabuf->width, kBufferWidth);
+  EXPECT_EQ(dmabuf->height, kBufferHeight);
+  EXPECT_EQ(dmabuf->modifier, FL_DMABUF_TEXTURE_MODIFIER_INVALID);
+  if (self->n_planes == 0) {
+    g_set_error(error, G_IO_ERROR, G_IO_ERROR_FAILED, "No frame");
+    return FALSE;
+  }
+
+  dmabuf->width = kFrameWidth;
+  dmabuf->height = kFrameHeight;
+  dmabuf->fourcc = kXrgb8888;
+  dmabuf->n_planes = self->n_planes;
+  for (uint32_t i = 0; i < self->n_planes; i++) {
+    dmabuf->planes[i].fd = 1;
+    dmabuf->planes[i].stride = kFrameWidth * 4;
+  }
+
+  return TRUE;
+}
+
+static void fl_test_dmabuf_texture_class_init(
+    FlTestDmabufTextureClass* klass) {
+  FL_DMABUF_TEXTURE_CLASS(klass)->get_dmabuf =
+      fl_test_dmabuf_texture_get_dmabuf;
+}
+
+static void fl_test_dmabuf_texture_init(FlTestDmabufTexture* self) {}
+
+static FlTestDmabufTexture* fl_test_dmabuf_texture_new(uint32_t n_planes) {
+  FlTestDmabufTexture* self = FL_TEST_DMABUF_TEXTURE(
+      g_object_new(fl_test_dmabuf_texture_get_type(), nullptr));
+  self->n_planes = n_planes;
+  return self;
+}
+
+static void initialize_egl() {
+  EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+  EXPECT_TRUE(eglInitialize(display, nullptr, nullptr));
+}
+
+// Test that getting the texture ID works.
+TEST(FlDmabufTextureTest, TextureID) {
+  g_autoptr(FlTexture) texture = FL_TEXTURE(fl_test_dmabuf_texture_new(1));
+  fl_texture_set_id(texture, 42);
+  EXPECT_EQ(fl_texture_get_id(texture), static_cast<int64_t>(42));
+}
+
+// Test that a single plane RGB frame is imported into a 2D texture.
+TEST(FlDmabufTextureTest, PopulateRgbTexture) {
+  initialize_egl();
+
+  g_autoptr(FlDmabufTexture) texture =
+      FL_DMABUF_TEXTURE(fl_test_dmabuf_texture_new(1));
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_dmabuf_texture_populate(texture, kBufferWidth, kBufferHeight,
+                                         &opengl_texture, &error));
+  EXPECT_EQ(error, nullptr);
+  EXPECT_EQ(opengl_texture.target, static_cast<uint32_t>(GL_TEXTURE_2D));
+  EXPECT_EQ(opengl_texture.width, kFrameWidth);
+  EXPECT_EQ(opengl_texture.height, kFrameHeight);
+}
+
+// Test that failures to get a frame are reported.
+TEST(FlDmabufTextureTest, PopulateWithoutFrame) {
+  initialize_egl();
+
+  g_autoptr(FlDmabufTexture) texture =
+      FL_DMABUF_TEXTURE(fl_test_dmabuf_texture_new(0));
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+  EXPECT_FALSE(fl_dmabuf_texture_populate(texture, kBufferWidth, kBufferHeight,
+                                          &opengl_texture, &error));
+  EXPECT_TRUE(g_error_matches(error, G_IO_ERROR, G_IO_ERROR_FAILED));
+}
+
+// Test that multi-planar frames need external texture support.
+TEST(FlDmabufTextureTest, PopulateMultiPlanarTextureWithoutExtension) {
+  initialize_egl();
+
+  g_autoptr(FlDmabufTexture) texture =
+      FL_DMABUF_TEXTURE(fl_test_dmabuf_texture_new(2));
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+  EXPECT_FALSE(fl_dmabuf_texture_populate(texture, kBufferWidth, kBufferHeight,
+                                          &opengl_texture, &error));
+  EXPECT_NE(error, nullptr);
+}
@@ -15,6 +15,7 @@
 #include "flutter/shell/platform/embedder/embedder.h"
 #include "flutter/shell/platform/linux/fl_binary_messenger_private.h"
 #include "flutter/shell/platform/linux/fl_dart_project_private.h"
+#include "flutter/shell/platform/linux/fl_dmabuf_texture_private.h"
 #include "flutter/shell/platform/linux/fl_engine_private.h"
 #include "flutter/shell/platform/linux/fl_pixel_buffer_texture_private.h"
 #include "flutter/shell/platform/linux/fl_plugin_registrar_private.h"
@@ -283,6 +284,9 @@ static bool fl_engine_gl_external_texture_frame_callback(
     result =
         fl_pixel_buffer_texture_populate(FL_PIXEL_BUFFER_TEXTURE(texture),
                                          width, height, opengl_texture, &error);
+  } else if (FL_IS_DMABUF_TEXTURE(texture)) {
+    result = fl_dmabuf_texture_populate(FL_DMABUF_TEXTURE(texture), width,
+                                        height, opengl_texture, &error);
   } else {
     g_warning("Unsupported texture type %" G_GINT64_FORMAT, texture_id);
     return false;
@@ -101,6 +101,29 @@ static gboolean fl_gl_area_draw(GtkWidget* widget, cairo_t* cr) {
   return TRUE;
 }
 
+// Returns TRUE if @a and @b contain textures at the same positions. Textures
+// don't need to be the same objects, as the engine reports damage relative
+// to the contents previously presented at the same position.
+static gboolean same_layout(GPtrArray* a, GPtrArray* b) {
+  if (a == nullptr || b == nullptr || a->len != b->len) {
+    return FALSE;
+  }
+
+  for (guint i = 0; i < a->len; i++) {
+    FlBackingStoreProvider* texture_a =
+        FL_BACKING_STORE_PROVIDER(g_ptr_array_index(a, i));
+    FlBackingStoreProvider* texture_b =
+        FL_BACKING_STORE_PROVIDER(g_ptr_array_index(b, i));
+    GdkRectangle geometry_a = fl_backing_store_provider_get_geometry(texture_a);
+    GdkRectangle geometry_b = fl_backing_store_provider_get_geometry(texture_b);
+    if (!gdk_rectangle_equal(&geometry_a, &geometry_b)) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
 static void fl_gl_area_class_init(FlGLAreaClass* klass) {
   GObjectClass* gobject_class = G_OBJECT_CLASS(klass);
   gobject_class->dispose = fl_gl_area_dispose;
@@ -126,11 +149,32 @@ GtkWidget* fl_gl_area_new(GdkGLContext* context) {
   return GTK_WIDGET(area);
 }
 
-void fl_gl_area_queue_render(FlGLArea* self, GPtrArray* textures) {
+void fl_gl_area_queue_render(FlGLArea* self,
+                             GPtrArray* textures,
+                             const cairo_region_t* damage) {
   g_return_if_fail(FL_IS_GL_AREA(self));
 
+  gboolean redraw_all =
+      damage == nullptr || !same_layout(self->textures, textures);
+
   g_clear_pointer(&self->textures, g_ptr_array_unref);
   self->textures = g_ptr_array_ref(textures);
 
-  gtk_widget_queue_draw(GTK_WIDGET(self));
+  if (redraw_all) {
+    gtk_widget_queue_draw(GTK_WIDGET(self));
+    return;
+  }
+
+  // Damage is in physical pixels, GTK invalidates in logical pixels.
+  gint scale = gtk_widget_get_scale_factor(GTK_WIDGET(self));
+  int n_rects = cairo_region_num_rectangles(damage);
+  for (int i = 0; i < n_rects; i++) {
+    cairo_rectangle_int_t rect;
+    cairo_region_get_rectangle(damage, i, &rect);
+    gint x = rect.x / scale;
+    gint y = rect.y / scale;
+    gint width = (rect.x + rect.width + scale - 1) / scale - x;
+    gint height = (rect.y + rect.height + scale - 1) / scale - y;
+    gtk_widget_queue_draw_area(GTK_WIDGET(self), x, y, width, height);
+  }
 }
@@ -34,10 +34,16 @@ GtkWidget* fl_gl_area_new(GdkGLContext* context);
  * @area: an #FlGLArea.
  * @textures: (transfer none) (element-type FlBackingStoreProvider): a list of
  * #FlBackingStoreProvider.
+ * @damage: (allow-none): the area that changed since the previous textures
+ * were queued, in physical pixels, or %NULL if unknown.
  *
- * Queues textures to be drawn later.
+ * Queues textures to be drawn later. If the textures have the same positions
+ * as the previous ones, only the damaged area is redrawn, so GTK doesn't copy
+ * and composite parts of the window that didn't change.
  */
-void fl_gl_area_queue_render(FlGLArea* area, GPtrArray* textures);
+void fl_gl_area_queue_render(FlGLArea* area,
+                             GPtrArray* textures,
+                             const cairo_region_t* damage);
 
 G_END_DECLS
 
@@ -4,6 +4,8 @@
 
 #include "flutter/shell/platform/linux/fl_renderer_gl.h"
 
+#include <cmath>
+
 #include "flutter/shell/platform/linux/fl_backing_store_provider.h"
 #include "flutter/shell/platform/linux/fl_view_private.h"
 
@@ -89,6 +91,33 @@ static gboolean fl_renderer_gl_collect_backing_store(
   return TRUE;
 }
 
+// Adds the area of @layer that changed since the previous frame to @damage.
+// Clears @damage if the engine didn't report what changed.
+static void add_layer_damage(const FlutterLayer* layer,
+                             cairo_region_t** damage) {
+  if (*damage == nullptr) {
+    return;
+  }
+
+  const FlutterBackingStorePresentInfo* present_info =
+      layer->backing_store_present_info;
+  if (present_info == nullptr || present_info->damage_region == nullptr) {
+    g_clear_pointer(damage, cairo_region_destroy);
+    return;
+  }
+
+  const FlutterRegion* region = present_info->damage_region;
+  for (size_t i = 0; i < region->rects_count; i++) {
+    const FlutterRect* rect = &region->rects[i];
+    int left = static_cast<int>(floor(rect->left));
+    int top = static_cast<int>(floor(rect->top));
+    cairo_rectangle_int_t damage_rect = {
+        left, top, static_cast<int>(ceil(rect->right)) - left,
+        static_cast<int>(ceil(rect->bottom)) - top};
+    cairo_region_union_rectangle(*damage, &damage_rect);
+  }
+}
+
 // Implements FlRenderer::present_layers.
 static gboolean fl_renderer_gl_present_layers(FlRenderer* renderer,
                                               const FlutterLayer** layers,
@@ -100,6 +129,9 @@ static gboolean fl_renderer_gl_present_layers(FlRenderer* renderer,
   }
 
   g_autoptr(GPtrArray) textures = g_ptr_array_new();
+  // Area of the view that changed since the previous frame, in physical
+  // pixels, or %NULL if it is unknown and the whole view must be redrawn.
+  cairo_region_t* damage = cairo_region_create();
   for (size_t i = 0; i < layers_count; ++i) {
     const FlutterLayer* layer = layers[i];
     switch (layer->type) {
@@ -108,6 +140,7 @@ static gboolean fl_renderer_gl_present_layers(FlRenderer* renderer,
         auto framebuffer = &backing_store->open_gl.framebuffer;
         g_ptr_array_add(textures, reinterpret_cast<FlBackingStoreProvider*>(
                                       framebuffer->user_data));
+        add_layer_damage(layer, &damage);
       } break;
       case kFlutterLayerContentTypePlatformView: {
         // Currently unsupported.
@@ -115,7 +148,8 @@ static gboolean fl_renderer_gl_present_layers(FlRenderer* renderer,
     }
   }
 
-  fl_view_set_textures(view, context, textures);
+  fl_view_set_textures(view, context, textures, damage);
+  g_clear_pointer(&damage, cairo_region_destroy);
 
   return TRUE;
 }
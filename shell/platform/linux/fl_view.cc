@@ -774,7 +774,8 @@ G_MODULE_EXPORT FlEngine* fl_view_get_engine(FlView* self) {
 
 void fl_view_set_textures(FlView* self,
                           GdkGLContext* context,
-                          GPtrArray* textures) {
+                          GPtrArray* textures,
+                          const cairo_region_t* damage) {
   g_return_if_fail(FL_IS_VIEW(self));
 
   if (self->gl_area == nullptr) {
@@ -784,7 +785,7 @@ void fl_view_set_textures(FlView* self,
                       GTK_WIDGET(self->gl_area));
   }
 
-  fl_gl_area_queue_render(self->gl_area, textures);
+  fl_gl_area_queue_render(self->gl_area, textures, damage);
 }
 
 GHashTable* fl_view_get_keyboard_state(FlView* self) {
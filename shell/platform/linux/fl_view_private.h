@@ -15,12 +15,15 @@
  * @context: a #GdkGLContext, for #FlGLArea to render.
  * @textures: (transfer none) (element-type FlBackingStoreProvider): a list of
  * #FlBackingStoreProvider.
+ * @damage: (allow-none): the area that changed since the previous textures
+ * were set, in physical pixels, or %NULL to redraw the whole view.
  *
  * Set the textures for this view to render.
  */
 void fl_view_set_textures(FlView* view,
                           GdkGLContext* context,
-                          GPtrArray* textures);
+                          GPtrArray* textures,
+                          const cairo_region_t* damage);
 
 /**
  * fl_view_get_keyboard_state:
@@ -146,6 +146,38 @@ void fl_binary_messenger_set_message_handler_on_channel(
     gpointer user_data,
     GDestroyNotify destroy_notify);
 
+/**
+ * fl_binary_messenger_set_message_handler_on_channel_with_context:
+ * @binary_messenger: an #FlBinaryMessenger.
+ * @channel: channel to listen on.
+ * @handler: (allow-none): function to call when a message is received on this
+ * channel or %NULL to disable a handler
+ * @user_data: (closure): user data to pass to @handler.
+ * @destroy_notify: (allow-none): a function which gets called to free
+ * @user_data, or %NULL.
+ * @context: (allow-none): the #GMainContext to call @handler from, or %NULL
+ * for the global default context.
+ *
+ * Sets the function called when a platform message is received on the given
+ * channel, like fl_binary_messenger_set_message_handler_on_channel(), but calls
+ * @handler from @context instead of the platform thread. Use this with a
+ * context run by another thread for handlers that do slow work, so that they
+ * don't delay input handling. Messages are handled in the order they are
+ * received, and can be responded to from @context as
+ * fl_binary_messenger_send_response() is thread-safe.
+ *
+ * @destroy_notify is called once the handler is removed and all messages
+ * queued on @context have been handled, possibly from the thread running
+ * @context.
+ */
+void fl_binary_messenger_set_message_handler_on_channel_with_context(
+    FlBinaryMessenger* messenger,
+    const gchar* channel,
+    FlBinaryMessengerMessageHandler handler,
+    gpointer user_data,
+    GDestroyNotify destroy_notify,
+    GMainContext* context);
+
 /**
  * fl_binary_messenger_send_response:
  * @binary_messenger: an #FlBinaryMessenger.
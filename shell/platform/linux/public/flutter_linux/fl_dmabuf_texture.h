@@ -0,0 +1,158 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_PUBLIC_FLUTTER_LINUX_FL_DMABUF_TEXTURE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_PUBLIC_FLUTTER_LINUX_FL_DMABUF_TEXTURE_H_
+
+#if !defined(__FLUTTER_LINUX_INSIDE__) && !defined(FLUTTER_LINUX_COMPILATION)
+#error "Only <flutter_linux/flutter_linux.h> can be included directly."
+#endif
+
+#include <glib-object.h>
+#include <gmodule.h>
+#include <stdint.h>
+#include "fl_texture.h"
+
+G_BEGIN_DECLS
+
+/**
+ * FL_DMABUF_TEXTURE_MAX_PLANES:
+ *
+ * The maximum number of planes an #FlDmabuf can have.
+ */
+#define FL_DMABUF_TEXTURE_MAX_PLANES 4
+
+/**
+ * FL_DMABUF_TEXTURE_MODIFIER_INVALID:
+ *
+ * Value of #FlDmabuf.modifier for buffers without an explicit format
+ * modifier, the same value as DRM_FORMAT_MOD_INVALID.
+ */
+#define FL_DMABUF_TEXTURE_MODIFIER_INVALID \
+  G_GUINT64_CONSTANT(0x00ffffffffffffff)
+
+/**
+ * FlDmabufPlane:
+ * @fd: file descriptor of the DMA-BUF that contains the plane.
+ * @offset: offset of the plane in bytes from the start of the DMA-BUF.
+ * @stride: number of bytes between the start of two rows of the plane.
+ *
+ * A plane of an #FlDmabuf.
+ */
+typedef struct {
+  int fd;
+  uint32_t offset;
+  uint32_t stride;
+} FlDmabufPlane;
+
+/**
+ * FlDmabuf:
+ * @width: width of the buffer in pixels.
+ * @height: height of the buffer in pixels.
+ * @fourcc: DRM fourcc code of the pixel format (e.g. DRM_FORMAT_ARGB8888 or
+ * DRM_FORMAT_NV12).
+ * @modifier: DRM format modifier of the buffer, or
+ * %FL_DMABUF_TEXTURE_MODIFIER_INVALID.
+ * @n_planes: number of planes used in @planes.
+ * @planes: planes of the buffer.
+ *
+ * Describes a frame that is stored in one or more DMA-BUFs.
+ */
+typedef struct {
+  uint32_t width;
+  uint32_t height;
+  uint32_t fourcc;
+  uint64_t modifier;
+  uint32_t n_planes;
+  FlDmabufPlane planes[FL_DMABUF_TEXTURE_MAX_PLANES];
+} FlDmabuf;
+
+G_MODULE_EXPORT
+G_DECLARE_DERIVABLE_TYPE(FlDmabufTexture,
+                         fl_dmabuf_texture,
+                         FL,
+                         DMABUF_TEXTURE,
+                         GObject)
+
+/**
+ * FlDmabufTexture:
+ *
+ * #FlDmabufTexture is an abstract class that represents a texture whose
+ * contents are stored in DMA-BUFs, for example frames decoded by a hardware
+ * video decoder or captured by a camera.
+ *
+ * The buffers are imported with EGL_EXT_image_dma_buf_import and sampled by
+ * Flutter without being copied. Multi-planar YUV formats are converted by
+ * the driver and need GL_OES_EGL_image_external. Importing fails if Flutter
+ * does not render with EGL.
+ *
+ * The following example shows how to implement an #FlDmabufTexture.
+ * ![<!-- language="C" -->
+ *   #include <drm_fourcc.h>
+ *
+ *   struct _MyTexture {
+ *     FlDmabufTexture parent_instance;
+ *
+ *     MyDecoder *decoder;
+ *   };
+ *
+ *   G_DEFINE_TYPE(MyTexture,
+ *                 my_texture,
+ *                 fl_dmabuf_texture_get_type ())
+ *
+ *   static gboolean
+ *   my_texture_get_dmabuf (FlDmabufTexture* texture,
+ *                          FlDmabuf* dmabuf,
+ *                          GError** error) {
+ *     // This method is called on the raster thread.
+ *     MyTexture *self = MY_TEXTURE (texture);
+ *     MyFrame *frame = my_decoder_get_last_frame (self->decoder);
+ *
+ *     dmabuf->width = frame->width;
+ *     dmabuf->height = frame->height;
+ *     dmabuf->fourcc = DRM_FORMAT_NV12;
+ *     dmabuf->n_planes = 2;
+ *     for (int i = 0; i < 2; i++) {
+ *       dmabuf->planes[i].fd = frame->fd;
+ *       dmabuf->planes[i].offset = frame->offsets[i];
+ *       dmabuf->planes[i].stride = frame->strides[i];
+ *     }
+ *
+ *     return TRUE;
+ *   }
+ *
+ *   static void my_texture_class_init(MyTextureClass* klass) {
+ *     FL_DMABUF_TEXTURE_CLASS(klass)->get_dmabuf = my_texture_get_dmabuf;
+ *   }
+ *
+ *   static void my_texture_init(MyTexture* self) {}
+ * ]|
+ */
+
+struct _FlDmabufTextureClass {
+  GObjectClass parent_class;
+
+  /**
+   * Virtual method called when Flutter populates this texture. The OpenGL
+   * context used by Flutter has been already set.
+   *
+   * The file descriptors remain owned by the texture and only need to stay
+   * open for the duration of this call. Flutter samples the buffers until
+   * this method is called again or the texture is unregistered, so they must
+   * not be reused for another frame before then.
+   * @texture: an #FlDmabufTexture.
+   * @dmabuf: (out): the frame to show.
+   * @error: (allow-none): #GError location to store the error occurring, or
+   * %NULL to ignore.
+   *
+   * Returns: %TRUE on success.
+   */
+  gboolean (*get_dmabuf)(FlDmabufTexture* texture,
+                         FlDmabuf* dmabuf,
+                         GError** error);
+};
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_PUBLIC_FLUTTER_LINUX_FL_DMABUF_TEXTURE_H_
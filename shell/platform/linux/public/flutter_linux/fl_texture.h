@@ -23,9 +23,10 @@ G_DECLARE_INTERFACE(FlTexture, fl_texture, FL, TEXTURE, GObject)
  *
  * #FlTexture represents a texture.
  *
- * You can derive #FlTextureGL for populating hardware-accelerated textures or
- * instantiate #FlPixelBufferTexture for populating pixel buffers. Do NOT
- * directly implement this interface.
+ * You can derive #FlTextureGL for populating hardware-accelerated textures,
+ * #FlDmabufTexture for showing DMA-BUFs without copying them, or instantiate
+ * #FlPixelBufferTexture for populating pixel buffers. Do NOT directly
+ * implement this interface.
  */
 
 struct _FlTextureInterface {
@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/windows/angle_surface_manager.h"
 
+#include <string_view>
 #include <vector>
 
 #include "flutter/fml/logging.h"
@@ -21,12 +22,20 @@ namespace flutter {
 int AngleSurfaceManager::instance_count_ = 0;
 
 std::unique_ptr<AngleSurfaceManager> AngleSurfaceManager::Create(
-    bool enable_impeller) {
+    bool enable_impeller,
+    bool enable_direct_composition) {
   std::unique_ptr<AngleSurfaceManager> manager;
   manager.reset(new AngleSurfaceManager(enable_impeller));
   if (!manager->initialize_succeeded_) {
     return nullptr;
   }
+  if (enable_direct_composition) {
+    manager->use_direct_composition_ = manager->SupportsDirectComposition();
+    if (!manager->use_direct_composition_) {
+      FML_LOG(WARNING) << "DirectComposition is not supported by ANGLE, "
+                          "falling back to the window's swap chain.";
+    }
+  }
   return std::move(manager);
 }
 
@@ -229,6 +238,27 @@ void AngleSurfaceManager::CleanUp() {
   }
 }
 
+bool AngleSurfaceManager::SupportsDirectComposition() const {
+  const char* extensions = eglQueryString(egl_display_, EGL_EXTENSIONS);
+  if (extensions == nullptr) {
+    return false;
+  }
+  std::string_view extension_list(extensions);
+  std::string_view extension("EGL_ANGLE_direct_composition");
+  size_t position = 0;
+  while ((position = extension_list.find(extension, position)) !=
+         std::string_view::npos) {
+    size_t end = position + extension.size();
+    // Ignore extensions that only start with the same name.
+    if ((position == 0 || extension_list[position - 1] == ' ') &&
+        (end == extension_list.size() || extension_list[end] == ' ')) {
+      return true;
+    }
+    position = end;
+  }
+  return false;
+}
+
 bool AngleSurfaceManager::CreateSurface(WindowsRenderTarget* render_target,
                                         EGLint width,
                                         EGLint height) {
@@ -238,14 +268,20 @@ bool AngleSurfaceManager::CreateSurface(WindowsRenderTarget* render_target,
 
   EGLSurface surface = EGL_NO_SURFACE;
 
-  const EGLint surfaceAttributes[] = {
-      EGL_FIXED_SIZE_ANGLE, EGL_TRUE, EGL_WIDTH, width,
-      EGL_HEIGHT,           height,   EGL_NONE};
+  std::vector<EGLint> surface_attributes = {
+      EGL_FIXED_SIZE_ANGLE, EGL_TRUE, EGL_WIDTH, width, EGL_HEIGHT, height};
+  if (use_direct_composition_) {
+    // ANGLE creates a DirectComposition visual for the window, and presents
+    // it with a flip model swap chain.
+    surface_attributes.push_back(EGL_DIRECT_COMPOSITION_ANGLE);
+    surface_attributes.push_back(EGL_TRUE);
+  }
+  surface_attributes.push_back(EGL_NONE);
 
   surface = eglCreateWindowSurface(
       egl_display_, egl_config_,
       static_cast<EGLNativeWindowType>(std::get<HWND>(*render_target)),
-      surfaceAttributes);
+      surface_attributes.data());
   if (surface == EGL_NO_SURFACE) {
     LogEglError("Surface creation failed.");
     return false;
@@ -27,7 +27,16 @@ namespace flutter {
 // destroy surfaces
 class AngleSurfaceManager {
  public:
-  static std::unique_ptr<AngleSurfaceManager> Create(bool enable_impeller);
+  // Creates a surface manager, or returns nullptr if ANGLE could not be
+  // initialized.
+  //
+  // If |enable_direct_composition| is true and ANGLE supports it, window
+  // surfaces are presented through a DirectComposition visual backed by a
+  // flip model swap chain, which avoids the copy that the system compositor
+  // makes of blt model swap chains.
+  static std::unique_ptr<AngleSurfaceManager> Create(
+      bool enable_impeller,
+      bool enable_direct_composition);
 
   virtual ~AngleSurfaceManager();
 
@@ -111,6 +120,9 @@ class AngleSurfaceManager {
   bool Initialize(bool enable_impeller);
   void CleanUp();
 
+  // Whether the display supports the EGL_ANGLE_direct_composition extension.
+  bool SupportsDirectComposition() const;
+
   // Attempts to initialize EGL using ANGLE.
   bool InitializeEGL(
       PFNEGLGETPLATFORMDISPLAYEXTPROC egl_get_platform_display_EXT,
@@ -134,6 +146,9 @@ class AngleSurfaceManager {
   // creating surfaces.
   bool initialize_succeeded_;
 
+  // Whether window surfaces are presented through DirectComposition.
+  bool use_direct_composition_ = false;
+
   // Current render_surface that engine will draw into.
   EGLSurface render_surface_ = EGL_NO_SURFACE;
 
@@ -4,11 +4,16 @@
 
 #include "flutter/shell/platform/windows/external_texture_d3d.h"
 
+#include <algorithm>
+
 #include "flutter/fml/logging.h"
 #include "flutter/shell/platform/embedder/embedder_struct_macros.h"
 
 namespace flutter {
 
+// The maximum number of surfaces kept for the handles of a texture.
+static constexpr size_t kMaxCachedSurfaceCount = 4;
+
 ExternalTextureD3d::ExternalTextureD3d(
     FlutterDesktopGpuSurfaceType type,
     const FlutterDesktopGpuSurfaceTextureCallback texture_callback,
@@ -22,7 +27,7 @@ ExternalTextureD3d::ExternalTextureD3d(
       gl_(std::move(gl)) {}
 
 ExternalTextureD3d::~ExternalTextureD3d() {
-  ReleaseImage();
+  DestroySurfaces();
 
   if (gl_texture_ != 0) {
     gl_->DeleteTextures(1, &gl_texture_);
@@ -52,19 +57,79 @@ bool ExternalTextureD3d::PopulateTexture(size_t width,
 }
 
 void ExternalTextureD3d::ReleaseImage() {
-  if (egl_surface_ != EGL_NO_SURFACE) {
-    eglReleaseTexImage(surface_manager_->egl_display(), egl_surface_,
+  if (bound_surface_ != EGL_NO_SURFACE) {
+    eglReleaseTexImage(surface_manager_->egl_display(), bound_surface_,
                        EGL_BACK_BUFFER);
-    eglDestroySurface(surface_manager_->egl_display(), egl_surface_);
-    egl_surface_ = EGL_NO_SURFACE;
+    bound_surface_ = EGL_NO_SURFACE;
+  }
+}
+
+void ExternalTextureD3d::DestroySurfaces() {
+  ReleaseImage();
+  for (const CachedSurface& surface : surfaces_) {
+    eglDestroySurface(surface_manager_->egl_display(), surface.egl_surface);
+  }
+  surfaces_.clear();
+}
+
+EGLSurface ExternalTextureD3d::GetOrCreateSurface(void* handle,
+                                                  EGLint width,
+                                                  EGLint height) {
+  auto cached = std::find_if(surfaces_.begin(), surfaces_.end(),
+                             [handle](const CachedSurface& surface) {
+                               return surface.handle == handle;
+                             });
+  if (cached != surfaces_.end()) {
+    std::rotate(surfaces_.begin(), cached, cached + 1);
+    return surfaces_.front().egl_surface;
+  }
+
+  // A handle of a different size means that the producer has reallocated its
+  // textures, so the surfaces of the previous textures won't be used again.
+  auto stale = std::remove_if(
+      surfaces_.begin(), surfaces_.end(),
+      [this, width, height](const CachedSurface& surface) {
+        if (surface.width == width && surface.height == height) {
+          return false;
+        }
+        eglDestroySurface(surface_manager_->egl_display(), surface.egl_surface);
+        return true;
+      });
+  surfaces_.erase(stale, surfaces_.end());
+
+  EGLint attributes[] = {EGL_WIDTH,
+                         width,
+                         EGL_HEIGHT,
+                         height,
+                         EGL_TEXTURE_TARGET,
+                         EGL_TEXTURE_2D,
+                         EGL_TEXTURE_FORMAT,
+                         EGL_TEXTURE_RGBA,  // always EGL_TEXTURE_RGBA
+                         EGL_NONE};
+
+  EGLSurface egl_surface = surface_manager_->CreateSurfaceFromHandle(
+      (type_ == kFlutterDesktopGpuSurfaceTypeD3d11Texture2D)
+          ? EGL_D3D_TEXTURE_ANGLE
+          : EGL_D3D_TEXTURE_2D_SHARE_HANDLE_ANGLE,
+      handle, attributes);
+  if (egl_surface == EGL_NO_SURFACE) {
+    return EGL_NO_SURFACE;
   }
+
+  surfaces_.insert(surfaces_.begin(), {handle, width, height, egl_surface});
+  if (surfaces_.size() > kMaxCachedSurfaceCount) {
+    eglDestroySurface(surface_manager_->egl_display(),
+                      surfaces_.back().egl_surface);
+    surfaces_.pop_back();
+  }
+  return egl_surface;
 }
 
 bool ExternalTextureD3d::CreateOrUpdateTexture(
     const FlutterDesktopGpuSurfaceDescriptor* descriptor) {
   if (descriptor == nullptr ||
       SAFE_ACCESS(descriptor, handle, nullptr) == nullptr) {
-    ReleaseImage();
+    DestroySurfaces();
     return false;
   }
 
@@ -81,39 +146,27 @@ bool ExternalTextureD3d::CreateOrUpdateTexture(
   }
 
   auto handle = SAFE_ACCESS(descriptor, handle, nullptr);
-  if (handle != last_surface_handle_) {
+  if (bound_surface_ == EGL_NO_SURFACE || surfaces_.front().handle != handle) {
     ReleaseImage();
 
-    EGLint attributes[] = {
-        EGL_WIDTH,
-        static_cast<EGLint>(SAFE_ACCESS(descriptor, width, 0)),
-        EGL_HEIGHT,
-        static_cast<EGLint>(SAFE_ACCESS(descriptor, height, 0)),
-        EGL_TEXTURE_TARGET,
-        EGL_TEXTURE_2D,
-        EGL_TEXTURE_FORMAT,
-        EGL_TEXTURE_RGBA,  // always EGL_TEXTURE_RGBA
-        EGL_NONE};
-
-    egl_surface_ = surface_manager_->CreateSurfaceFromHandle(
-        (type_ == kFlutterDesktopGpuSurfaceTypeD3d11Texture2D)
-            ? EGL_D3D_TEXTURE_ANGLE
-            : EGL_D3D_TEXTURE_2D_SHARE_HANDLE_ANGLE,
-        handle, attributes);
-
-    if (egl_surface_ == EGL_NO_SURFACE ||
-        eglBindTexImage(surface_manager_->egl_display(), egl_surface_,
+    EGLSurface egl_surface = GetOrCreateSurface(
+        handle, static_cast<EGLint>(SAFE_ACCESS(descriptor, width, 0)),
+        static_cast<EGLint>(SAFE_ACCESS(descriptor, height, 0)));
+
+    if (egl_surface == EGL_NO_SURFACE ||
+        eglBindTexImage(surface_manager_->egl_display(), egl_surface,
                         EGL_BACK_BUFFER) == EGL_FALSE) {
       FML_LOG(ERROR) << "Binding D3D surface failed.";
+    } else {
+      bound_surface_ = egl_surface;
     }
-    last_surface_handle_ = handle;
   }
 
   auto release_callback = SAFE_ACCESS(descriptor, release_callback, nullptr);
   if (release_callback) {
     release_callback(SAFE_ACCESS(descriptor, release_context, nullptr));
   }
-  return egl_surface_ != EGL_NO_SURFACE;
+  return bound_surface_ != EGL_NO_SURFACE;
 }
 
 }  // namespace flutter
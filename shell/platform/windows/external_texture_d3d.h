@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_PLATFORM_WINDOWS_EXTERNAL_TEXTURE_D3D_H_
 
 #include <memory>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/windows/angle_surface_manager.h"
@@ -31,12 +32,26 @@ class ExternalTextureD3d : public ExternalTexture {
                        FlutterOpenGLTexture* opengl_texture) override;
 
  private:
+  // An EGL surface created from one of the surface handles provided by
+  // |texture_callback_|.
+  struct CachedSurface {
+    void* handle;
+    EGLint width;
+    EGLint height;
+    EGLSurface egl_surface;
+  };
+
   // Creates or updates the backing texture and associates it with the provided
   // surface.
   bool CreateOrUpdateTexture(
       const FlutterDesktopGpuSurfaceDescriptor* descriptor);
+  // Returns the EGL surface of |handle|, and only creates it if it isn't in
+  // |surfaces_|. The returned surface is moved to the front of |surfaces_|.
+  EGLSurface GetOrCreateSurface(void* handle, EGLint width, EGLint height);
   // Detaches the previously attached surface, if any.
   void ReleaseImage();
+  // Detaches the attached surface and destroys all the cached surfaces.
+  void DestroySurfaces();
 
   FlutterDesktopGpuSurfaceType type_;
   const FlutterDesktopGpuSurfaceTextureCallback texture_callback_;
@@ -44,8 +59,17 @@ class ExternalTextureD3d : public ExternalTexture {
   const AngleSurfaceManager* surface_manager_;
   std::shared_ptr<GlProcTable> gl_;
   GLuint gl_texture_ = 0;
-  EGLSurface egl_surface_ = EGL_NO_SURFACE;
-  void* last_surface_handle_ = nullptr;
+
+  // The surfaces of the handles that were provided recently, the most
+  // recently used first.
+  //
+  // Producers such as video decoders cycle through a ring of textures, so
+  // keeping their surfaces avoids opening the shared texture every time the
+  // handle changes.
+  std::vector<CachedSurface> surfaces_;
+
+  // The surface bound to |gl_texture_|, which is the front of |surfaces_|.
+  EGLSurface bound_surface_ = EGL_NO_SURFACE;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ExternalTextureD3d);
 };
@@ -62,9 +62,18 @@ bool ExternalTexturePixelBuffer::CopyPixelBuffer(size_t& width,
   } else {
     gl_->BindTexture(GL_TEXTURE_2D, gl_texture_);
   }
-  gl_->TexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, pixel_buffer->width,
-                  pixel_buffer->height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
-                  pixel_buffer->buffer);
+  if (pixel_buffer->width == texture_width_ &&
+      pixel_buffer->height == texture_height_) {
+    gl_->TexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, pixel_buffer->width,
+                       pixel_buffer->height, GL_RGBA, GL_UNSIGNED_BYTE,
+                       pixel_buffer->buffer);
+  } else {
+    gl_->TexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, pixel_buffer->width,
+                    pixel_buffer->height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                    pixel_buffer->buffer);
+    texture_width_ = pixel_buffer->width;
+    texture_height_ = pixel_buffer->height;
+  }
   if (pixel_buffer->release_callback) {
     pixel_buffer->release_callback(pixel_buffer->release_context);
   }
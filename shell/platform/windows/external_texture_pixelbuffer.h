@@ -41,6 +41,11 @@ class ExternalTexturePixelBuffer : public ExternalTexture {
   std::shared_ptr<GlProcTable> gl_;
   GLuint gl_texture_ = 0;
 
+  // The size of the storage of |gl_texture_|. Pixel buffers of the same size
+  // are copied into the existing storage instead of reallocating it.
+  size_t texture_width_ = 0;
+  size_t texture_height_ = 0;
+
   FML_DISALLOW_COPY_AND_ASSIGN(ExternalTexturePixelBuffer);
 };
 
@@ -214,7 +214,13 @@ FlutterWindowsEngine::FlutterWindowsEngine(
   enable_impeller_ = std::find(switches.begin(), switches.end(),
                                "--enable-impeller=true") != switches.end();
 
-  surface_manager_ = AngleSurfaceManager::Create(enable_impeller_);
+  // Check whether the window should be presented through DirectComposition.
+  bool enable_direct_composition =
+      std::find(switches.begin(), switches.end(),
+                "--enable-direct-composition=true") != switches.end();
+
+  surface_manager_ =
+      AngleSurfaceManager::Create(enable_impeller_, enable_direct_composition);
   window_proc_delegate_manager_ = std::make_unique<WindowProcDelegateManager>();
   window_proc_delegate_manager_->RegisterTopLevelWindowProcDelegate(
       [](HWND hwnd, UINT msg, WPARAM wpar, LPARAM lpar, void* user_data,
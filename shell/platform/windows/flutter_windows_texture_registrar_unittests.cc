@@ -201,6 +201,56 @@ TEST(FlutterWindowsTextureRegistrarTest, PopulatePixelBufferTexture) {
   EXPECT_TRUE(release_callback_called);
 }
 
+TEST(FlutterWindowsTextureRegistrarTest,
+     PopulatePixelBufferTextureReusesStorage) {
+  std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
+  std::shared_ptr<MockGlProcTable> gl = std::make_shared<MockGlProcTable>();
+
+  FlutterWindowsTextureRegistrar registrar(engine.get(), gl);
+
+  size_t width = 100;
+  size_t height = 100;
+  std::unique_ptr<uint8_t[]> pixels =
+      std::make_unique<uint8_t[]>(width * height * 4);
+  FlutterDesktopPixelBuffer pixel_buffer = {};
+  pixel_buffer.width = width;
+  pixel_buffer.height = height;
+  pixel_buffer.buffer = pixels.get();
+
+  FlutterDesktopTextureInfo texture_info = {};
+  texture_info.type = kFlutterDesktopPixelBufferTexture;
+  texture_info.pixel_buffer_config.user_data = &pixel_buffer;
+  texture_info.pixel_buffer_config.callback =
+      [](size_t width, size_t height,
+         void* user_data) -> const FlutterDesktopPixelBuffer* {
+    return reinterpret_cast<const FlutterDesktopPixelBuffer*>(user_data);
+  };
+
+  FlutterOpenGLTexture flutter_texture = {};
+  auto texture_id = registrar.RegisterTexture(&texture_info);
+  EXPECT_NE(texture_id, -1);
+
+  EXPECT_CALL(*gl.get(), GenTextures(1, _))
+      .Times(1)
+      .WillOnce([](GLsizei n, GLuint* textures) { textures[0] = 1; });
+  EXPECT_CALL(*gl.get(), BindTexture).Times(3);
+  EXPECT_CALL(*gl.get(), TexParameteri).Times(AtLeast(1));
+  // The storage is only reallocated when the size of the pixel buffer
+  // changes.
+  EXPECT_CALL(*gl.get(), TexImage2D).Times(2);
+  EXPECT_CALL(*gl.get(), TexSubImage2D).Times(1);
+  EXPECT_CALL(*gl.get(), DeleteTextures(1, _)).Times(1);
+
+  EXPECT_TRUE(
+      registrar.PopulateTexture(texture_id, 640, 480, &flutter_texture));
+  EXPECT_TRUE(
+      registrar.PopulateTexture(texture_id, 640, 480, &flutter_texture));
+  pixel_buffer.width = 50;
+  EXPECT_TRUE(
+      registrar.PopulateTexture(texture_id, 640, 480, &flutter_texture));
+  EXPECT_EQ(flutter_texture.width, 50u);
+}
+
 TEST(FlutterWindowsTextureRegistrarTest, PopulateD3dTextureWithHandle) {
   std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
   std::shared_ptr<MockGlProcTable> gl = std::make_shared<MockGlProcTable>();
@@ -319,6 +369,60 @@ TEST(FlutterWindowsTextureRegistrarTest, PopulateD3dTexture) {
   EXPECT_TRUE(release_callback_called);
 }
 
+TEST(FlutterWindowsTextureRegistrarTest, PopulateD3dTextureRing) {
+  std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
+  std::shared_ptr<MockGlProcTable> gl = std::make_shared<MockGlProcTable>();
+  FlutterWindowsTextureRegistrar registrar(engine.get(), gl);
+
+  UINT width = 100;
+  UINT height = 100;
+  ComPtr<ID3D11Texture2D> d3d_textures[] = {
+      CreateD3dTexture(engine.get(), width, height),
+      CreateD3dTexture(engine.get(), width, height),
+  };
+  EXPECT_TRUE(d3d_textures[0]);
+  EXPECT_TRUE(d3d_textures[1]);
+
+  FlutterDesktopGpuSurfaceDescriptor surface_descriptor = {};
+  surface_descriptor.struct_size = sizeof(FlutterDesktopGpuSurfaceDescriptor);
+  surface_descriptor.width = surface_descriptor.visible_width = width;
+  surface_descriptor.height = surface_descriptor.visible_height = height;
+
+  FlutterDesktopTextureInfo texture_info = {};
+  texture_info.type = kFlutterDesktopGpuSurfaceTexture;
+  texture_info.gpu_surface_config.struct_size =
+      sizeof(FlutterDesktopGpuSurfaceTextureConfig);
+  texture_info.gpu_surface_config.type =
+      kFlutterDesktopGpuSurfaceTypeD3d11Texture2D;
+  texture_info.gpu_surface_config.user_data = &surface_descriptor;
+  texture_info.gpu_surface_config.callback =
+      [](size_t width, size_t height,
+         void* user_data) -> const FlutterDesktopGpuSurfaceDescriptor* {
+    return reinterpret_cast<const FlutterDesktopGpuSurfaceDescriptor*>(
+        user_data);
+  };
+
+  FlutterOpenGLTexture flutter_texture = {};
+  auto texture_id = registrar.RegisterTexture(&texture_info);
+  EXPECT_NE(texture_id, -1);
+
+  EXPECT_CALL(*gl.get(), GenTextures(1, _))
+      .Times(1)
+      .WillOnce([](GLsizei n, GLuint* textures) { textures[0] = 1; });
+  EXPECT_CALL(*gl.get(), BindTexture).Times(4);
+  EXPECT_CALL(*gl.get(), TexParameteri).Times(AtLeast(1));
+  EXPECT_CALL(*gl.get(), DeleteTextures(1, _)).Times(1);
+
+  // Alternate between the textures of the ring, as a double buffered
+  // producer does.
+  for (int frame = 0; frame < 4; frame++) {
+    surface_descriptor.handle = d3d_textures[frame % 2].Get();
+    EXPECT_TRUE(
+        registrar.PopulateTexture(texture_id, 640, 480, &flutter_texture));
+    EXPECT_EQ(flutter_texture.name, 1u);
+  }
+}
+
 TEST(FlutterWindowsTextureRegistrarTest, PopulateInvalidTexture) {
   std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
   std::shared_ptr<MockGlProcTable> gl = std::make_shared<MockGlProcTable>();
@@ -21,9 +21,11 @@ std::shared_ptr<GlProcTable> GlProcTable::Create() {
       ::eglGetProcAddress("glTexParameteri"));
   gl->tex_image_2d_ =
       reinterpret_cast<TexImage2DProc>(::eglGetProcAddress("glTexImage2D"));
+  gl->tex_sub_image_2d_ = reinterpret_cast<TexSubImage2DProc>(
+      ::eglGetProcAddress("glTexSubImage2D"));
 
   if (!gl->gen_textures_ || !gl->delete_textures_ || !gl->bind_texture_ ||
-      !gl->tex_parameteri_ || !gl->tex_image_2d_) {
+      !gl->tex_parameteri_ || !gl->tex_image_2d_ || !gl->tex_sub_image_2d_) {
     return nullptr;
   }
 
@@ -65,4 +67,17 @@ void GlProcTable::TexImage2D(GLenum target,
                 type, data);
 }
 
+void GlProcTable::TexSubImage2D(GLenum target,
+                                GLint level,
+                                GLint xoffset,
+                                GLint yoffset,
+                                GLsizei width,
+                                GLsizei height,
+                                GLenum format,
+                                GLenum type,
+                                const void* data) const {
+  tex_sub_image_2d_(target, level, xoffset, yoffset, width, height, format,
+                    type, data);
+}
+
 }  // namespace flutter
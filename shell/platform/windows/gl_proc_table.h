@@ -34,6 +34,15 @@ class GlProcTable {
                           GLenum format,
                           GLenum type,
                           const void* data) const;
+  virtual void TexSubImage2D(GLenum target,
+                             GLint level,
+                             GLint xoffset,
+                             GLint yoffset,
+                             GLsizei width,
+                             GLsizei height,
+                             GLenum format,
+                             GLenum type,
+                             const void* data) const;
 
  protected:
   GlProcTable();
@@ -55,12 +64,22 @@ class GlProcTable {
                                           GLenum format,
                                           GLenum type,
                                           const void* data);
+  using TexSubImage2DProc = void(__stdcall*)(GLenum target,
+                                             GLint level,
+                                             GLint xoffset,
+                                             GLint yoffset,
+                                             GLsizei width,
+                                             GLsizei height,
+                                             GLenum format,
+                                             GLenum type,
+                                             const void* data);
 
   GenTexturesProc gen_textures_;
   DeleteTexturesProc delete_textures_;
   BindTextureProc bind_texture_;
   TexParameteriProc tex_parameteri_;
   TexImage2DProc tex_image_2d_;
+  TexSubImage2DProc tex_sub_image_2d_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(GlProcTable);
 };
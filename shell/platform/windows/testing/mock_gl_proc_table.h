@@ -46,6 +46,18 @@ class MockGlProcTable : public GlProcTable {
                GLenum type,
                const void* data),
               (const override));
+  MOCK_METHOD(void,
+              TexSubImage2D,
+              (GLenum target,
+               GLint level,
+               GLint xoffset,
+               GLint yoffset,
+               GLsizei width,
+               GLsizei height,
+               GLenum format,
+               GLenum type,
+               const void* data),
+              (const override));
 
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(MockGlProcTable);
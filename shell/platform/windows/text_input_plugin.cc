@@ -8,7 +8,6 @@
 
 #include <cstdint>
 
-#include "flutter/fml/string_conversion.h"
 #include "flutter/shell/platform/common/json_method_codec.h"
 #include "flutter/shell/platform/common/text_editing_delta.h"
 #include "flutter/shell/platform/windows/flutter_windows_engine.h"
@@ -68,8 +67,7 @@ void TextInputPlugin::TextHook(const std::u16string& text) {
   if (active_model_ == nullptr) {
     return;
   }
-  std::u16string text_before_change =
-      fml::Utf8ToUtf16(active_model_->GetText());
+  std::u16string text_before_change = active_model_->GetUtf16Text();
   TextRange selection_before_change = active_model_->selection();
   active_model_->AddText(text);
 
@@ -128,9 +126,7 @@ void TextInputPlugin::ComposeBeginHook() {
   }
   active_model_->BeginComposing();
   if (enable_delta_model) {
-    std::string text = active_model_->GetText();
-    TextRange selection = active_model_->selection();
-    TextEditingDelta delta = TextEditingDelta(text);
+    TextEditingDelta delta = TextEditingDelta(active_model_->GetUtf16Text());
     SendStateUpdateWithDelta(*active_model_, &delta);
   } else {
     SendStateUpdate(*active_model_);
@@ -141,11 +137,6 @@ void TextInputPlugin::ComposeCommitHook() {
   if (active_model_ == nullptr) {
     return;
   }
-  std::string text_before_change = active_model_->GetText();
-  TextRange selection_before_change = active_model_->selection();
-  TextRange composing_before_change = active_model_->composing_range();
-  std::string composing_text_before_change = text_before_change.substr(
-      composing_before_change.start(), composing_before_change.length());
   active_model_->CommitComposing();
 
   // We do not trigger SendStateUpdate here.
@@ -176,13 +167,10 @@ void TextInputPlugin::ComposeEndHook() {
   if (active_model_ == nullptr) {
     return;
   }
-  std::string text_before_change = active_model_->GetText();
-  TextRange selection_before_change = active_model_->selection();
   active_model_->CommitComposing();
   active_model_->EndComposing();
   if (enable_delta_model) {
-    std::string text = active_model_->GetText();
-    TextEditingDelta delta = TextEditingDelta(text);
+    TextEditingDelta delta = TextEditingDelta(active_model_->GetUtf16Text());
     SendStateUpdateWithDelta(*active_model_, &delta);
   } else {
     SendStateUpdate(*active_model_);
@@ -194,16 +182,15 @@ void TextInputPlugin::ComposeChangeHook(const std::u16string& text,
   if (active_model_ == nullptr) {
     return;
   }
-  std::string text_before_change = active_model_->GetText();
+  std::u16string text_before_change = active_model_->GetUtf16Text();
   TextRange composing_before_change = active_model_->composing_range();
   active_model_->AddText(text);
   cursor_pos += active_model_->composing_range().start();
   active_model_->UpdateComposingText(text);
   active_model_->SetSelection(TextRange(cursor_pos, cursor_pos));
-  std::string text_after_change = active_model_->GetText();
   if (enable_delta_model) {
-    TextEditingDelta delta = TextEditingDelta(
-        fml::Utf8ToUtf16(text_before_change), composing_before_change, text);
+    TextEditingDelta delta =
+        TextEditingDelta(text_before_change, composing_before_change, text);
     SendStateUpdateWithDelta(*active_model_, &delta);
   } else {
     SendStateUpdate(*active_model_);
@@ -469,7 +456,7 @@ void TextInputPlugin::SendStateUpdateWithDelta(const TextInputModel& model,
 void TextInputPlugin::EnterPressed(TextInputModel* model) {
   if (input_type_ == kMultilineInputType &&
       input_action_ == kInputActionNewline) {
-    std::u16string text_before_change = fml::Utf8ToUtf16(model->GetText());
+    std::u16string text_before_change = model->GetUtf16Text();
     TextRange selection_before_change = model->selection();
     model->AddText(u"\n");
     if (enable_delta_model) {
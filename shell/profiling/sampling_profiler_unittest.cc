@@ -18,14 +18,14 @@ class MockTaskRunner : public fml::TaskRunner {
   inline static RefPtr<MockTaskRunner> Create() {
     return AdoptRef(new MockTaskRunner());
   }
-  MOCK_METHOD(void, PostTask, (const fml::closure& task), (override));
+  MOCK_METHOD(void, PostTask, (fml::TaskClosure task), (override));
   MOCK_METHOD(void,
               PostTaskForTime,
-              (const fml::closure& task, fml::TimePoint target_time),
+              (fml::TaskClosure task, fml::TimePoint target_time),
               (override));
   MOCK_METHOD(void,
               PostDelayedTask,
-              (const fml::closure& task, fml::TimeDelta delay),
+              (fml::TaskClosure task, fml::TimeDelta delay),
               (override));
   MOCK_METHOD(bool, RunsTasksOnCurrentThread, (), (override));
   MOCK_METHOD(TaskQueueId, GetTaskQueueId, (), (override));
@@ -48,9 +48,9 @@ TEST(SamplingProfilerTest, DeleteAfterStart) {
   // Dart.
   EXPECT_CALL(*task_runner, PostDelayedTask(_, _))
       .WillRepeatedly(
-          Invoke([&](const fml::closure& task, fml::TimeDelta delay) {
+          Invoke([&](fml::TaskClosure task, fml::TimeDelta delay) {
             invoke_count.fetch_add(1);
-            thread->GetTaskRunner()->PostTask(task);
+            thread->GetTaskRunner()->PostTask(std::move(task));
           }));
 
   {
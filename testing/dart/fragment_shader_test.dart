@@ -284,6 +284,23 @@ void main() async {
     shader.dispose();
   });
 
+  test('FragmentShader setFloats sets array uniforms in bulk', () async {
+    if (impellerEnabled) {
+      print('Skipped for Impeller - https://github.com/flutter/flutter/issues/122823');
+      return;
+    }
+    final FragmentProgram program = await FragmentProgram.fromAsset(
+      'uniform_arrays.frag.iplr',
+    );
+
+    final FragmentShader shader = program.fragmentShader()
+      ..setFloat(0, 0.0)
+      ..setFloats(1, <double>[for (int i = 1; i < 20; i++) i.toDouble()]);
+
+    await _expectShaderRendersGreen(shader);
+    shader.dispose();
+  });
+
   test('FragmentShader The ink_sparkle shader is accepted', () async {
     if (impellerEnabled) {
       print('Skipped for Impeller - https://github.com/flutter/flutter/issues/122823');
@@ -70,6 +70,55 @@ void main() {
     expect(codec.frameCount, 1);
   });
 
+  test('image descriptor - encoded - region', () async {
+    final Uint8List bytes = await readFile('square.png');
+    final ImmutableBuffer buffer = await ImmutableBuffer.fromUint8List(bytes);
+    final ImageDescriptor descriptor = await ImageDescriptor.encoded(buffer);
+
+    final Codec codec = await descriptor.instantiateCodec(region: const Rect.fromLTRB(2, 3, 8, 6));
+    expect(codec.frameCount, 1);
+    final FrameInfo frame = await codec.getNextFrame();
+    expect(frame.image.width, 6);
+    expect(frame.image.height, 3);
+
+    final Codec scaledCodec = await descriptor.instantiateCodec(targetWidth: 3, region: const Rect.fromLTRB(2, 3, 8, 6));
+    final FrameInfo scaledFrame = await scaledCodec.getNextFrame();
+    expect(scaledFrame.image.width, 3);
+    expect(scaledFrame.image.height, 1);
+  });
+
+  test('image descriptor - raw - region', () async {
+    final Uint8List bytes = Uint8List.fromList(List<int>.filled(64, 0xFF));
+    final ImmutableBuffer buffer = await ImmutableBuffer.fromUint8List(bytes);
+    final ImageDescriptor descriptor = ImageDescriptor.raw(
+      buffer,
+      width: 4,
+      height: 4,
+      pixelFormat: PixelFormat.rgba8888,
+    );
+
+    final Codec codec = await descriptor.instantiateCodec(region: const Rect.fromLTRB(1, 1, 3, 4));
+    final FrameInfo frame = await codec.getNextFrame();
+    expect(frame.image.width, 2);
+    expect(frame.image.height, 3);
+  });
+
+  test('image descriptor - region must be within the image', () async {
+    final Uint8List bytes = await readFile('square.png');
+    final ImmutableBuffer buffer = await ImmutableBuffer.fromUint8List(bytes);
+    final ImageDescriptor descriptor = await ImageDescriptor.encoded(buffer);
+
+    for (final Rect region in const <Rect>[Rect.fromLTRB(5, 5, 11, 8), Rect.fromLTRB(5, 5, 5, 8)]) {
+      Object? error;
+      try {
+        await descriptor.instantiateCodec(region: region);
+      } catch (e) {
+        error = e;
+      }
+      expect(error, isInstanceOf<ArgumentError>());
+    }
+  });
+
   test('HEIC image', () async {
     final Uint8List bytes = await readFile('grill_chicken.heic');
     final ImmutableBuffer buffer = await ImmutableBuffer.fromUint8List(bytes);
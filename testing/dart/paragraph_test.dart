@@ -381,4 +381,27 @@ void main() {
         expect(metrics, hasLength(1));
     }
   });
+
+  test('lays out paragraphs in the background', () async {
+    final List<Paragraph> paragraphs = <Paragraph>[];
+    final List<ParagraphConstraints> constraints = <ParagraphConstraints>[];
+    for (final double fontSize in <double>[10.0, 20.0, 30.0, 40.0]) {
+      final ParagraphBuilder builder = ParagraphBuilder(ParagraphStyle(
+        fontFamily: 'FlutterTest',
+        fontSize: fontSize,
+      ));
+      builder.addText('Test Test');
+      paragraphs.add(builder.build());
+      constraints.add(ParagraphConstraints(width: fontSize * 5.0));
+    }
+
+    await layoutParagraphs(paragraphs, constraints);
+
+    for (int index = 0; index < paragraphs.length; index += 1) {
+      final double fontSize = 10.0 * (index + 1);
+      expect(paragraphs[index].width, fontSize * 5.0);
+      expect(paragraphs[index].height, fontSize * 2.0);
+      expect(paragraphs[index].computeLineMetrics(), hasLength(2));
+    }
+  });
 }
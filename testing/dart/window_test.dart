@@ -68,6 +68,29 @@ void main() {
             'frameNumber: 29)');
   });
 
+  test('FrameTiming reports the GPU duration', () {
+    final FrameTiming timing = FrameTiming(
+      vsyncStart: 500,
+      buildStart: 1000,
+      buildFinish: 8000,
+      rasterStart: 9000,
+      rasterFinish: 19500,
+      rasterFinishWallTime: 19501,
+      gpuDuration: 6500,
+      frameNumber: 31,
+    );
+    expect(timing.gpuDuration, const Duration(microseconds: 6500));
+    expect(timing.frameNumber, 31);
+    expect(FrameTiming(
+      vsyncStart: 0,
+      buildStart: 0,
+      buildFinish: 0,
+      rasterStart: 0,
+      rasterFinish: 0,
+      rasterFinishWallTime: 0,
+    ).gpuDuration, Duration.zero);
+  });
+
   test('computePlatformResolvedLocale basic', () {
     final List<Locale> supportedLocales = <Locale>[
       const Locale.fromSubtags(languageCode: 'zh', scriptCode: 'Hans', countryCode: 'CN'),
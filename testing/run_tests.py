@@ -392,6 +392,7 @@ def run_cc_tests(build_dir, executable_filter, coverage, capture_core_dump):
     return (name, flags, extra_env)
 
   unittests = [
+      make_test('assets_unittests'),
       make_test('client_wrapper_glfw_unittests'),
       make_test('client_wrapper_unittests'),
       make_test('common_cpp_core_unittests'),
@@ -585,6 +586,11 @@ def run_engine_benchmarks(build_dir, executable_filter):
       build_dir, 'canvas_benchmarks', executable_filter, icu_flags
   )
 
+  run_engine_executable(
+      build_dir, 'embedder_platform_channel_benchmarks', executable_filter,
+      icu_flags
+  )
+
   if is_linux():
     run_engine_executable(
         build_dir, 'txt_benchmarks', executable_filter, icu_flags
@@ -17,6 +17,7 @@
 #include "paragraph_builder_skia.h"
 #include "paragraph_skia.h"
 
+#include "flutter/fml/hash_combine.h"
 #include "third_party/skia/modules/skparagraph/include/ParagraphStyle.h"
 #include "third_party/skia/modules/skparagraph/include/TextStyle.h"
 #include "txt/paragraph_style.h"
@@ -48,9 +49,14 @@ ParagraphBuilderSkia::ParagraphBuilderSkia(
     const ParagraphStyle& style,
     std::shared_ptr<FontCollection> font_collection,
     const bool impeller_enabled)
-    : base_style_(style.GetTextStyle()), impeller_enabled_(impeller_enabled) {
+    : base_style_(style.GetTextStyle()),
+      impeller_enabled_(impeller_enabled),
+      paragraph_cache_(font_collection->GetParagraphCache()),
+      paragraph_cache_generation_(paragraph_cache_->GetGeneration()),
+      content_hash_(fml::HashCombine()) {
   builder_ = skt::ParagraphBuilder::make(
       TxtToSkia(style), font_collection->CreateSktFontCollection());
+  HashParagraphStyle(style);
 }
 
 ParagraphBuilderSkia::~ParagraphBuilderSkia() = default;
@@ -58,11 +64,13 @@ ParagraphBuilderSkia::~ParagraphBuilderSkia() = default;
 void ParagraphBuilderSkia::PushStyle(const TextStyle& style) {
   builder_->pushStyle(TxtToSkia(style));
   txt_style_stack_.push(style);
+  HashTextStyle(style);
 }
 
 void ParagraphBuilderSkia::Pop() {
   builder_->pop();
   txt_style_stack_.pop();
+  fml::HashCombineSeed(content_hash_, 'P');
 }
 
 const TextStyle& ParagraphBuilderSkia::PeekStyle() {
@@ -71,6 +79,7 @@ const TextStyle& ParagraphBuilderSkia::PeekStyle() {
 
 void ParagraphBuilderSkia::AddText(const std::u16string& text) {
   builder_->addText(text);
+  fml::HashCombineSeed(content_hash_, std::hash<std::u16string>{}(text));
 }
 
 void ParagraphBuilderSkia::AddPlaceholder(PlaceholderRun& span) {
@@ -83,11 +92,64 @@ void ParagraphBuilderSkia::AddPlaceholder(PlaceholderRun& span) {
       static_cast<skt::PlaceholderAlignment>(span.alignment);
 
   builder_->addPlaceholder(placeholder_style);
+  fml::HashCombineSeed(content_hash_, span.width, span.height, span.alignment,
+                       span.baseline, span.baseline_offset);
 }
 
 std::unique_ptr<Paragraph> ParagraphBuilderSkia::Build() {
   return std::make_unique<ParagraphSkia>(
-      builder_->Build(), std::move(dl_paints_), impeller_enabled_);
+      builder_->Build(), std::move(dl_paints_), impeller_enabled_,
+      paragraph_cache_, paragraph_cache_generation_, content_hash_);
+}
+
+void ParagraphBuilderSkia::HashParagraphStyle(const ParagraphStyle& style) {
+  fml::HashCombineSeed(content_hash_, style.font_weight, style.font_style,
+                       style.font_size, style.height, style.has_height_override,
+                       style.text_height_behavior, style.strut_enabled,
+                       style.strut_font_weight, style.strut_font_style,
+                       style.strut_font_size, style.strut_height,
+                       style.strut_has_height_override,
+                       style.strut_half_leading, style.strut_leading,
+                       style.force_strut_height, style.text_align,
+                       style.text_direction, style.max_lines,
+                       style.apply_rounding_hack);
+  fml::HashCombineSeed(content_hash_,
+                       std::hash<std::string>{}(style.font_family),
+                       std::hash<std::string>{}(style.locale),
+                       std::hash<std::u16string>{}(style.ellipsis));
+  for (const auto& family : style.strut_font_families) {
+    fml::HashCombineSeed(content_hash_, std::hash<std::string>{}(family));
+  }
+}
+
+void ParagraphBuilderSkia::HashTextStyle(const TextStyle& style) {
+  // Colors are part of the hash because decorations and shadows are painted
+  // with the colors stored in the laid out paragraph.
+  fml::HashCombineSeed(
+      content_hash_, 'S', style.color, style.decoration,
+      style.decoration_color, style.decoration_style,
+      style.decoration_thickness_multiplier, style.font_weight,
+      style.font_style, style.text_baseline, style.half_leading,
+      style.font_size, style.letter_spacing, style.word_spacing, style.height,
+      style.has_height_override, style.background.has_value(),
+      style.foreground.has_value());
+  fml::HashCombineSeed(content_hash_, std::hash<std::string>{}(style.locale));
+  for (const auto& family : style.font_families) {
+    fml::HashCombineSeed(content_hash_, std::hash<std::string>{}(family));
+  }
+  for (const auto& shadow : style.text_shadows) {
+    fml::HashCombineSeed(content_hash_, shadow.color, shadow.offset.fX,
+                         shadow.offset.fY, shadow.blur_sigma);
+  }
+  for (const auto& feature : style.font_features.GetFontFeatures()) {
+    fml::HashCombineSeed(content_hash_,
+                         std::hash<std::string>{}(feature.first),
+                         feature.second);
+  }
+  for (const auto& axis : style.font_variations.GetAxisValues()) {
+    fml::HashCombineSeed(content_hash_, std::hash<std::string>{}(axis.first),
+                         axis.second);
+  }
 }
 
 skt::ParagraphPainter::PaintID ParagraphBuilderSkia::CreatePaintID(
@@ -20,6 +20,7 @@
 #include "txt/paragraph_builder.h"
 
 #include "flutter/display_list/dl_paint.h"
+#include "flutter/third_party/txt/src/skia/paragraph_cache.h"
 #include "third_party/skia/modules/skparagraph/include/ParagraphBuilder.h"
 
 namespace txt {
@@ -49,6 +50,8 @@ class ParagraphBuilderSkia : public ParagraphBuilder {
       const flutter::DlPaint& dl_paint);
   skia::textlayout::ParagraphStyle TxtToSkia(const ParagraphStyle& txt);
   skia::textlayout::TextStyle TxtToSkia(const TextStyle& txt);
+  void HashParagraphStyle(const ParagraphStyle& style);
+  void HashTextStyle(const TextStyle& style);
 
   std::shared_ptr<skia::textlayout::ParagraphBuilder> builder_;
   TextStyle base_style_;
@@ -62,6 +65,20 @@ class ParagraphBuilderSkia : public ParagraphBuilder {
   const bool impeller_enabled_;
   std::stack<TextStyle> txt_style_stack_;
   std::vector<flutter::DlPaint> dl_paints_;
+
+  /// @brief      The cache of laid out paragraphs of the font collection, and
+  ///             its generation when this builder was created.
+  std::shared_ptr<ParagraphCache> paragraph_cache_;
+  const size_t paragraph_cache_generation_;
+
+  /// @brief      A hash of everything that affects the layout of the
+  ///             paragraph, updated as styles, text and placeholders are
+  ///             added.
+  ///
+  /// @note       The contents of foreground and background paints are not
+  ///             part of the hash, since they are applied when the paragraph
+  ///             is painted and do not affect its layout.
+  size_t content_hash_;
 };
 
 }  // namespace txt
@@ -0,0 +1,90 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "paragraph_cache.h"
+
+#include "flutter/fml/hash_combine.h"
+
+namespace txt {
+
+ParagraphCache::ParagraphCache(size_t capacity) : capacity_(capacity) {}
+
+ParagraphCache::~ParagraphCache() = default;
+
+size_t ParagraphCache::KeyHash::operator()(const Key& key) const {
+  return fml::HashCombine(key.content_hash, key.width);
+}
+
+size_t ParagraphCache::GetGeneration() const {
+  std::scoped_lock lock(mutex_);
+  return generation_;
+}
+
+std::unique_ptr<skia::textlayout::Paragraph> ParagraphCache::Take(
+    size_t generation,
+    size_t content_hash,
+    double width) {
+  std::scoped_lock lock(mutex_);
+  if (generation != generation_) {
+    return nullptr;
+  }
+  auto found = index_.find(Key{content_hash, width});
+  if (found == index_.end()) {
+    misses_++;
+    return nullptr;
+  }
+  hits_++;
+  auto paragraph = std::move(found->second->paragraph);
+  entries_.erase(found->second);
+  index_.erase(found);
+  return paragraph;
+}
+
+void ParagraphCache::Put(
+    size_t generation,
+    size_t content_hash,
+    double width,
+    std::unique_ptr<skia::textlayout::Paragraph> paragraph) {
+  if (!paragraph || capacity_ == 0u) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  if (generation != generation_) {
+    return;
+  }
+  Key key{content_hash, width};
+  auto found = index_.find(key);
+  if (found != index_.end()) {
+    // Keep the newer of two identical paragraphs.
+    entries_.erase(found->second);
+    index_.erase(found);
+  } else if (entries_.size() >= capacity_) {
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+  entries_.push_front(Entry{key, std::move(paragraph)});
+  index_[key] = entries_.begin();
+}
+
+void ParagraphCache::Clear() {
+  std::list<Entry> entries;
+  {
+    std::scoped_lock lock(mutex_);
+    generation_++;
+    index_.clear();
+    entries.swap(entries_);
+  }
+  // The paragraphs are destroyed outside of the lock.
+}
+
+ParagraphCache::Stats ParagraphCache::GetStats() const {
+  std::scoped_lock lock(mutex_);
+  Stats stats;
+  stats.hits = hits_;
+  stats.misses = misses_;
+  stats.entries = entries_.size();
+  return stats;
+}
+
+}  // namespace txt
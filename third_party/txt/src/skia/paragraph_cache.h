@@ -0,0 +1,114 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LIB_TXT_SRC_PARAGRAPH_CACHE_H_
+#define LIB_TXT_SRC_PARAGRAPH_CACHE_H_
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/modules/skparagraph/include/Paragraph.h"
+
+namespace txt {
+
+//------------------------------------------------------------------------------
+/// @brief      A least recently used pool of laid out paragraphs, shared by
+///             all paragraphs built from one font collection.
+///
+///             Shaping and line breaking dominate the cost of laying out a
+///             paragraph. When a paragraph is destroyed, its laid out Skia
+///             paragraph is returned to this cache, keyed by a hash of the
+///             text, the styles and the placeholders it was built from and by
+///             the width it was laid out at. A later paragraph built from the
+///             same content and laid out at the same width takes it over
+///             instead of shaping the text again.
+///
+///             Cached paragraphs are owned by exactly one paragraph or by the
+///             cache, so they are never shared.
+///
+class ParagraphCache {
+ public:
+  struct Stats {
+    size_t hits = 0u;
+    size_t misses = 0u;
+    size_t entries = 0u;
+  };
+
+  static constexpr size_t kDefaultCapacity = 128u;
+
+  explicit ParagraphCache(size_t capacity = kDefaultCapacity);
+
+  ~ParagraphCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The generation of the cache, which changes every time the
+  ///             cache is cleared. Paragraphs built in an older generation are
+  ///             not put back into the cache.
+  ///
+  size_t GetGeneration() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes and returns a paragraph built from content with the
+  ///             given hash and laid out at the given width, or nullptr if
+  ///             there is none.
+  ///
+  std::unique_ptr<skia::textlayout::Paragraph> Take(size_t generation,
+                                                    size_t content_hash,
+                                                    double width);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns a laid out paragraph to the cache, evicting the least
+  ///             recently used one if the cache is full.
+  ///
+  void Put(size_t generation,
+           size_t content_hash,
+           double width,
+           std::unique_ptr<skia::textlayout::Paragraph> paragraph);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops all cached paragraphs. This must be called whenever the
+  ///             fonts used to shape paragraphs change.
+  ///
+  void Clear();
+
+  Stats GetStats() const;
+
+ private:
+  struct Key {
+    size_t content_hash;
+    double width;
+
+    bool operator==(const Key& other) const {
+      return content_hash == other.content_hash && width == other.width;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Entry {
+    Key key;
+    std::unique_ptr<skia::textlayout::Paragraph> paragraph;
+  };
+
+  const size_t capacity_;
+  mutable std::mutex mutex_;
+  size_t generation_ = 0u;
+  size_t hits_ = 0u;
+  size_t misses_ = 0u;
+  // Most recently used entries first.
+  std::list<Entry> entries_;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ParagraphCache);
+};
+
+}  // namespace txt
+
+#endif  // LIB_TXT_SRC_PARAGRAPH_CACHE_H_
@@ -245,10 +245,23 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
 
 ParagraphSkia::ParagraphSkia(std::unique_ptr<skt::Paragraph> paragraph,
                              std::vector<flutter::DlPaint>&& dl_paints,
-                             bool impeller_enabled)
+                             bool impeller_enabled,
+                             std::shared_ptr<ParagraphCache> paragraph_cache,
+                             size_t paragraph_cache_generation,
+                             size_t content_hash)
     : paragraph_(std::move(paragraph)),
       dl_paints_(dl_paints),
-      impeller_enabled_(impeller_enabled) {}
+      impeller_enabled_(impeller_enabled),
+      paragraph_cache_(std::move(paragraph_cache)),
+      paragraph_cache_generation_(paragraph_cache_generation),
+      content_hash_(content_hash) {}
+
+ParagraphSkia::~ParagraphSkia() {
+  if (paragraph_cache_ && layout_width_.has_value()) {
+    paragraph_cache_->Put(paragraph_cache_generation_, content_hash_,
+                          layout_width_.value(), std::move(paragraph_));
+  }
+}
 
 double ParagraphSkia::GetMaxWidth() {
   return SkScalarToDouble(paragraph_->getMaxWidth());
@@ -329,7 +342,22 @@ bool ParagraphSkia::DidExceedMaxLines() {
 void ParagraphSkia::Layout(double width) {
   line_metrics_.reset();
   line_metrics_styles_.clear();
+  if (paragraph_cache_ && layout_width_ != width) {
+    auto cached = paragraph_cache_->Take(paragraph_cache_generation_,
+                                         content_hash_, width);
+    if (cached) {
+      // Keep the current layout around for other paragraphs.
+      if (layout_width_.has_value()) {
+        paragraph_cache_->Put(paragraph_cache_generation_, content_hash_,
+                              layout_width_.value(), std::move(paragraph_));
+      }
+      paragraph_ = std::move(cached);
+      layout_width_ = width;
+      return;
+    }
+  }
   paragraph_->layout(width);
+  layout_width_ = width;
 }
 
 bool ParagraphSkia::Paint(DisplayListBuilder* builder, double x, double y) {
@@ -21,6 +21,7 @@
 
 #include "txt/paragraph.h"
 
+#include "flutter/third_party/txt/src/skia/paragraph_cache.h"
 #include "third_party/skia/modules/skparagraph/include/Paragraph.h"
 
 namespace txt {
@@ -30,9 +31,12 @@ class ParagraphSkia : public Paragraph {
  public:
   ParagraphSkia(std::unique_ptr<skia::textlayout::Paragraph> paragraph,
                 std::vector<flutter::DlPaint>&& dl_paints,
-                bool impeller_enabled);
+                bool impeller_enabled,
+                std::shared_ptr<ParagraphCache> paragraph_cache = nullptr,
+                size_t paragraph_cache_generation = 0u,
+                size_t content_hash = 0u);
 
-  virtual ~ParagraphSkia() = default;
+  virtual ~ParagraphSkia();
 
   double GetMaxWidth() override;
 
@@ -94,6 +98,13 @@ class ParagraphSkia : public Paragraph {
   std::optional<std::vector<LineMetrics>> line_metrics_;
   std::vector<TextStyle> line_metrics_styles_;
   const bool impeller_enabled_;
+
+  // Laid out paragraphs with the same content are taken from this cache in
+  // |Layout| and returned to it when this paragraph is destroyed.
+  std::shared_ptr<ParagraphCache> paragraph_cache_;
+  const size_t paragraph_cache_generation_;
+  const size_t content_hash_;
+  std::optional<double> layout_width_;
 };
 
 }  // namespace txt
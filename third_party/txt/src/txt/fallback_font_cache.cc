@@ -0,0 +1,233 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "txt/fallback_font_cache.h"
+
+#include <string_view>
+#include <utility>
+
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/core/SkString.h"
+
+namespace txt {
+
+namespace {
+
+constexpr std::string_view kSnapshotHeader = "flutter-fallback-fonts-v1\n";
+
+// Characters of the same block usually come from the same fallback font.
+constexpr int kCodePointBlockShift = 7;
+
+void AppendField(std::string& out, const char* value) {
+  out.push_back('\t');
+  if (!value) {
+    return;
+  }
+  for (const char* c = value; *c != '\0'; c++) {
+    // Tabs and newlines separate the fields and entries of a snapshot.
+    out.push_back((*c == '\t' || *c == '\n') ? ' ' : *c);
+  }
+}
+
+std::string MakeKey(const char family_name[],
+                    const SkFontStyle& style,
+                    const char* bcp47[],
+                    int bcp47_count,
+                    SkUnichar character) {
+  std::string key = std::to_string(character >> kCodePointBlockShift);
+  AppendField(key, std::to_string(style.weight()).c_str());
+  AppendField(key, std::to_string(style.width()).c_str());
+  AppendField(key, std::to_string(style.slant()).c_str());
+  AppendField(key, family_name);
+  for (int i = 0; i < bcp47_count; i++) {
+    AppendField(key, bcp47[i]);
+  }
+  return key;
+}
+
+}  // namespace
+
+FallbackFontCache& FallbackFontCache::GetForProcess() {
+  static FallbackFontCache cache;
+  return cache;
+}
+
+FallbackFontCache::FallbackFontCache() = default;
+
+FallbackFontCache::~FallbackFontCache() = default;
+
+sk_sp<SkTypeface> FallbackFontCache::MatchFamilyStyleCharacter(
+    const SkFontMgr& font_manager,
+    const char family_name[],
+    const SkFontStyle& style,
+    const char* bcp47[],
+    int bcp47_count,
+    SkUnichar character) {
+  std::string key = MakeKey(family_name, style, bcp47, bcp47_count, character);
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = entries_.find(key);
+    if (found != entries_.end()) {
+      Entry& entry = found->second;
+      if (!entry.typeface && !entry.family_name.empty()) {
+        entry.typeface =
+            font_manager.matchFamilyStyle(entry.family_name.c_str(), style);
+        if (!entry.typeface) {
+          entry.family_name.clear();
+        }
+      }
+      if (entry.typeface && entry.typeface->unicharToGlyph(character) != 0) {
+        return entry.typeface;
+      }
+    }
+  }
+
+  sk_sp<SkTypeface> typeface;
+  {
+    TRACE_EVENT0("flutter", "FallbackFontCache::ResolveFallback");
+    typeface = font_manager.matchFamilyStyleCharacter(
+        family_name, style, bcp47, bcp47_count, character);
+  }
+  if (typeface) {
+    SkString resolved_family_name;
+    typeface->getFamilyName(&resolved_family_name);
+    std::scoped_lock lock(mutex_);
+    entries_[std::move(key)] = {typeface, resolved_family_name.c_str()};
+    changed_ = true;
+    resolved_fallback_count_++;
+  }
+  return typeface;
+}
+
+void FallbackFontCache::LoadSnapshot(const SkData& snapshot) {
+  std::string_view data(static_cast<const char*>(snapshot.data()),
+                        snapshot.size());
+  if (data.substr(0, kSnapshotHeader.size()) != kSnapshotHeader) {
+    return;
+  }
+  data.remove_prefix(kSnapshotHeader.size());
+
+  std::scoped_lock lock(mutex_);
+  while (!data.empty()) {
+    auto line_end = data.find('\n');
+    if (line_end == std::string_view::npos) {
+      // Ignore a truncated last entry.
+      break;
+    }
+    auto line = data.substr(0, line_end);
+    data.remove_prefix(line_end + 1);
+    auto separator = line.rfind('\t');
+    if (separator == std::string_view::npos || separator == 0u) {
+      continue;
+    }
+    std::string key(line.substr(0, separator));
+    std::string family_name(line.substr(separator + 1));
+    // Keep the entries of this run, which are already resolved.
+    entries_.try_emplace(std::move(key), Entry{nullptr, std::move(family_name)});
+  }
+}
+
+sk_sp<SkData> FallbackFontCache::TakeSnapshotIfChanged() {
+  std::scoped_lock lock(mutex_);
+  if (!changed_) {
+    return nullptr;
+  }
+  changed_ = false;
+  std::string snapshot(kSnapshotHeader);
+  for (const auto& [key, entry] : entries_) {
+    if (entry.family_name.empty()) {
+      continue;
+    }
+    snapshot += key;
+    AppendField(snapshot, entry.family_name.c_str());
+    snapshot.push_back('\n');
+  }
+  return SkData::MakeWithCopy(snapshot.data(), snapshot.size());
+}
+
+void FallbackFontCache::Clear() {
+  std::scoped_lock lock(mutex_);
+  entries_.clear();
+  // Do not keep a snapshot of the old fonts around either.
+  changed_ = true;
+}
+
+size_t FallbackFontCache::GetResolvedFallbackCount() const {
+  std::scoped_lock lock(mutex_);
+  return resolved_fallback_count_;
+}
+
+FallbackCachingFontManager::FallbackCachingFontManager(
+    sk_sp<SkFontMgr> font_manager)
+    : font_manager_(std::move(font_manager)) {}
+
+FallbackCachingFontManager::~FallbackCachingFontManager() = default;
+
+int FallbackCachingFontManager::onCountFamilies() const {
+  return font_manager_->countFamilies();
+}
+
+void FallbackCachingFontManager::onGetFamilyName(int index,
+                                                 SkString* familyName) const {
+  font_manager_->getFamilyName(index, familyName);
+}
+
+sk_sp<SkFontStyleSet> FallbackCachingFontManager::onCreateStyleSet(
+    int index) const {
+  return font_manager_->createStyleSet(index);
+}
+
+sk_sp<SkFontStyleSet> FallbackCachingFontManager::onMatchFamily(
+    const char familyName[]) const {
+  return font_manager_->matchFamily(familyName);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMatchFamilyStyle(
+    const char familyName[],
+    const SkFontStyle& style) const {
+  return font_manager_->matchFamilyStyle(familyName, style);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMatchFamilyStyleCharacter(
+    const char familyName[],
+    const SkFontStyle& style,
+    const char* bcp47[],
+    int bcp47Count,
+    SkUnichar character) const {
+  return FallbackFontCache::GetForProcess().MatchFamilyStyleCharacter(
+      *font_manager_, familyName, style, bcp47, bcp47Count, character);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMakeFromData(
+    sk_sp<SkData> data,
+    int ttcIndex) const {
+  return font_manager_->makeFromData(std::move(data), ttcIndex);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMakeFromStreamIndex(
+    std::unique_ptr<SkStreamAsset> stream,
+    int ttcIndex) const {
+  return font_manager_->makeFromStream(std::move(stream), ttcIndex);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMakeFromStreamArgs(
+    std::unique_ptr<SkStreamAsset> stream,
+    const SkFontArguments& args) const {
+  return font_manager_->makeFromStream(std::move(stream), args);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMakeFromFile(
+    const char path[],
+    int ttcIndex) const {
+  return font_manager_->makeFromFile(path, ttcIndex);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onLegacyMakeTypeface(
+    const char familyName[],
+    SkFontStyle style) const {
+  return font_manager_->legacyMakeTypeface(familyName, style);
+}
+
+}  // namespace txt
@@ -0,0 +1,134 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TXT_FALLBACK_FONT_CACHE_H_
+#define TXT_FALLBACK_FONT_CACHE_H_
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkFontMgr.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+namespace txt {
+
+// A process wide cache of the typefaces that the platform font manager picks
+// for characters that the requested fonts do not have.
+//
+// Fallback resolution can be very slow, for example with fontconfig on Linux.
+// Results are cached per block of 128 code points, locale list, style and
+// requested family, and a cached typeface is used for every character of the
+// block that it has a glyph for.
+//
+// The cache can be saved to and restored from a snapshot that records the
+// family name of each resolved typeface, so that a later run of the process
+// looks up fonts by family name instead of resolving fallbacks again.
+class FallbackFontCache {
+ public:
+  static FallbackFontCache& GetForProcess();
+
+  FallbackFontCache();
+
+  ~FallbackFontCache();
+
+  // Returns the typeface |font_manager| picks for |character|, resolving it
+  // only if no cached typeface has the character.
+  sk_sp<SkTypeface> MatchFamilyStyleCharacter(const SkFontMgr& font_manager,
+                                              const char family_name[],
+                                              const SkFontStyle& style,
+                                              const char* bcp47[],
+                                              int bcp47_count,
+                                              SkUnichar character);
+
+  // Adds the entries of a snapshot created by |TakeSnapshotIfChanged|.
+  // Entries that are already cached are kept.
+  void LoadSnapshot(const SkData& snapshot);
+
+  // Returns a snapshot of the cache if fallbacks were resolved since the
+  // last snapshot was taken, or nullptr otherwise.
+  sk_sp<SkData> TakeSnapshotIfChanged();
+
+  // Drops all entries. This must be called when the platform fonts change.
+  void Clear();
+
+  size_t GetResolvedFallbackCount() const;
+
+ private:
+  struct Entry {
+    // Null for entries from a snapshot until they are first used.
+    sk_sp<SkTypeface> typeface;
+    std::string family_name;
+  };
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  bool changed_ = false;
+  size_t resolved_fallback_count_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FallbackFontCache);
+};
+
+// A font manager that forwards to another one and resolves fallback fonts
+// through the process wide |FallbackFontCache|.
+class FallbackCachingFontManager : public SkFontMgr {
+ public:
+  explicit FallbackCachingFontManager(sk_sp<SkFontMgr> font_manager);
+
+  ~FallbackCachingFontManager() override;
+
+ private:
+  sk_sp<SkFontMgr> font_manager_;
+
+  // |SkFontMgr|
+  int onCountFamilies() const override;
+
+  // |SkFontMgr|
+  void onGetFamilyName(int index, SkString* familyName) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkFontStyleSet> onCreateStyleSet(int index) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkFontStyleSet> onMatchFamily(const char familyName[]) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMatchFamilyStyle(const char familyName[],
+                                       const SkFontStyle&) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMatchFamilyStyleCharacter(
+      const char familyName[],
+      const SkFontStyle&,
+      const char* bcp47[],
+      int bcp47Count,
+      SkUnichar character) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromData(sk_sp<SkData>, int ttcIndex) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromStreamIndex(std::unique_ptr<SkStreamAsset>,
+                                          int ttcIndex) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromStreamArgs(std::unique_ptr<SkStreamAsset>,
+                                         const SkFontArguments&) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromFile(const char path[],
+                                   int ttcIndex) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onLegacyMakeTypeface(const char familyName[],
+                                         SkFontStyle) const override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FallbackCachingFontManager);
+};
+
+}  // namespace txt
+
+#endif  // TXT_FALLBACK_FONT_CACHE_H_
@@ -26,12 +26,15 @@
 #include <vector>
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
+#include "txt/fallback_font_cache.h"
 #include "txt/platform.h"
 #include "txt/text_style.h"
 
 namespace txt {
 
-FontCollection::FontCollection() : enable_font_fallback_(true) {}
+FontCollection::FontCollection()
+    : enable_font_fallback_(true),
+      paragraph_cache_(std::make_shared<ParagraphCache>()) {}
 
 FontCollection::~FontCollection() {
   if (skt_collection_) {
@@ -45,28 +48,36 @@ size_t FontCollection::GetFontManagersCount() const {
 
 void FontCollection::SetupDefaultFontManager(
     uint32_t font_initialization_data) {
-  default_font_manager_ = GetDefaultFontManager(font_initialization_data);
+  // The platform font manager resolves fallback fonts through a cache that
+  // is shared by the whole process.
+  default_font_manager_ = sk_make_sp<FallbackCachingFontManager>(
+      GetDefaultFontManager(font_initialization_data));
   skt_collection_.reset();
+  paragraph_cache_->Clear();
 }
 
 void FontCollection::SetDefaultFontManager(sk_sp<SkFontMgr> font_manager) {
   default_font_manager_ = font_manager;
   skt_collection_.reset();
+  paragraph_cache_->Clear();
 }
 
 void FontCollection::SetAssetFontManager(sk_sp<SkFontMgr> font_manager) {
   asset_font_manager_ = font_manager;
   skt_collection_.reset();
+  paragraph_cache_->Clear();
 }
 
 void FontCollection::SetDynamicFontManager(sk_sp<SkFontMgr> font_manager) {
   dynamic_font_manager_ = font_manager;
   skt_collection_.reset();
+  paragraph_cache_->Clear();
 }
 
 void FontCollection::SetTestFontManager(sk_sp<SkFontMgr> font_manager) {
   test_font_manager_ = font_manager;
   skt_collection_.reset();
+  paragraph_cache_->Clear();
 }
 
 // Return the available font managers in the order they should be queried.
@@ -88,12 +99,23 @@ void FontCollection::DisableFontFallback() {
   if (skt_collection_) {
     skt_collection_->disableFontFallback();
   }
+  paragraph_cache_->Clear();
 }
 
 void FontCollection::ClearFontFamilyCache() {
   if (skt_collection_) {
     skt_collection_->clearCaches();
   }
+  paragraph_cache_->Clear();
+}
+
+const std::shared_ptr<ParagraphCache>& FontCollection::GetParagraphCache()
+    const {
+  return paragraph_cache_;
+}
+
+std::mutex& FontCollection::GetLayoutMutex() {
+  return layout_mutex_;
 }
 
 sk_sp<skia::textlayout::FontCollection>
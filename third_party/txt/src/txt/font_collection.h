@@ -18,11 +18,13 @@
 #define LIB_TXT_SRC_FONT_COLLECTION_H_
 
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
 
 #include "flutter/fml/macros.h"
+#include "flutter/third_party/txt/src/skia/paragraph_cache.h"
 #include "third_party/googletest/googletest/include/gtest/gtest_prod.h"  // nogncheck
 #include "third_party/skia/include/core/SkFontMgr.h"
 #include "third_party/skia/include/core/SkRefCnt.h"
@@ -56,6 +58,15 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // Construct a Skia text layout FontCollection based on this collection.
   sk_sp<skia::textlayout::FontCollection> CreateSktFontCollection();
 
+  // The cache of laid out paragraphs shaped with the fonts of this collection.
+  // It is cleared whenever the fonts change.
+  const std::shared_ptr<ParagraphCache>& GetParagraphCache() const;
+
+  // Paragraphs built from this collection may be laid out off the UI thread.
+  // Callers hold this lock while laying out such paragraphs and while changing
+  // the fonts of the collection. The methods of this class do not take it.
+  std::mutex& GetLayoutMutex();
+
  private:
   sk_sp<SkFontMgr> default_font_manager_;
   sk_sp<SkFontMgr> asset_font_manager_;
@@ -66,6 +77,10 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // An equivalent font collection usable by the Skia text shaper library.
   sk_sp<skia::textlayout::FontCollection> skt_collection_;
 
+  std::shared_ptr<ParagraphCache> paragraph_cache_;
+
+  std::mutex layout_mutex_;
+
   std::vector<sk_sp<SkFontMgr>> GetFontManagerOrder() const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(FontCollection);
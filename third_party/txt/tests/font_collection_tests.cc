@@ -18,7 +18,11 @@
 
 #include <sstream>
 
+#include "runtime/test_font_data.h"
+#include "txt/asset_font_manager.h"
+#include "txt/fallback_font_cache.h"
 #include "txt/font_collection.h"
+#include "txt/typeface_font_asset_provider.h"
 
 namespace txt {
 namespace testing {
@@ -39,5 +43,73 @@ TEST_F(FontCollectionTests, SettingUpDefaultFontManagerClearsCache) {
   sk_font_collection = font_collection.CreateSktFontCollection();
   ASSERT_NE(sk_font_collection->getFallbackManager().get(), nullptr);
 }
+
+namespace {
+// Falls back to one of the test fonts for every character.
+class CountingFallbackFontManager : public AssetFontManager {
+ public:
+  explicit CountingFallbackFontManager(sk_sp<SkTypeface> typeface)
+      : AssetFontManager(MakeProvider(typeface)), typeface_(typeface) {}
+
+  mutable int fallback_count = 0;
+
+ private:
+  static std::unique_ptr<FontAssetProvider> MakeProvider(
+      sk_sp<SkTypeface> typeface) {
+    auto provider = std::make_unique<TypefaceFontAssetProvider>();
+    provider->RegisterTypeface(std::move(typeface));
+    return provider;
+  }
+
+  sk_sp<SkTypeface> onMatchFamilyStyleCharacter(
+      const char familyName[],
+      const SkFontStyle&,
+      const char* bcp47[],
+      int bcp47Count,
+      SkUnichar character) const override {
+    fallback_count++;
+    return typeface_;
+  }
+
+  sk_sp<SkTypeface> typeface_;
+};
+}  // namespace
+
+TEST_F(FontCollectionTests, FallbackFontCacheReusesTypefacesPerBlock) {
+  auto typeface = flutter::GetTestFontData()[0];
+  CountingFallbackFontManager font_manager(typeface);
+  FallbackFontCache cache;
+  const char* locales[] = {"en-US"};
+  auto match = [&](FallbackFontCache& target, SkUnichar character) {
+    return target.MatchFamilyStyleCharacter(font_manager, nullptr,
+                                            SkFontStyle(), locales, 1,
+                                            character);
+  };
+
+  EXPECT_EQ(match(cache, 'A'), typeface);
+  EXPECT_EQ(match(cache, 'B'), typeface);
+  EXPECT_EQ(font_manager.fallback_count, 1);
+  EXPECT_EQ(cache.GetResolvedFallbackCount(), 1u);
+
+  auto snapshot = cache.TakeSnapshotIfChanged();
+  ASSERT_NE(snapshot, nullptr);
+  EXPECT_EQ(cache.TakeSnapshotIfChanged(), nullptr);
+
+  // A new run finds the typeface by its family name.
+  FallbackFontCache restored;
+  restored.LoadSnapshot(*snapshot);
+  auto restored_typeface = match(restored, 'A');
+  ASSERT_NE(restored_typeface, nullptr);
+  EXPECT_EQ(font_manager.fallback_count, 1);
+  SkString family_name;
+  SkString restored_family_name;
+  typeface->getFamilyName(&family_name);
+  restored_typeface->getFamilyName(&restored_family_name);
+  EXPECT_EQ(family_name, restored_family_name);
+
+  restored.Clear();
+  match(restored, 'A');
+  EXPECT_EQ(font_manager.fallback_count, 2);
+}
 }  // namespace testing
 }  // namespace txt
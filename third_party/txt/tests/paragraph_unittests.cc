@@ -108,7 +108,6 @@ class PainterTestBase : public CanvasTestBase<T> {
     return builder.Build();
   }
 
- private:
   std::shared_ptr<txt::FontCollection> makeFontCollection() const {
     auto f_collection = std::make_shared<txt::FontCollection>();
     auto font_provider = std::make_unique<txt::TypefaceFontAssetProvider>();
@@ -120,12 +119,17 @@ class PainterTestBase : public CanvasTestBase<T> {
     return f_collection;
   }
 
-  txt::ParagraphBuilderSkia makeParagraphBuilder() const {
+  txt::ParagraphBuilderSkia makeParagraphBuilder(
+      const std::shared_ptr<txt::FontCollection>& f_collection) const {
     auto p_style = txt::ParagraphStyle();
-    auto f_collection = makeFontCollection();
     return txt::ParagraphBuilderSkia(p_style, f_collection, impeller_);
   }
 
+ private:
+  txt::ParagraphBuilderSkia makeParagraphBuilder() const {
+    return makeParagraphBuilder(makeFontCollection());
+  }
+
   bool impeller_ = false;
 };
 
@@ -156,6 +160,40 @@ TEST_F(PainterTest, DrawDashedLineSkia) {
   EXPECT_TRUE(recorder.hasPathEffect());
 }
 
+TEST_F(PainterTest, ReusesLayoutOfIdenticalParagraphs) {
+  auto f_collection = makeFontCollection();
+  auto build = [&](const std::u16string& text) {
+    auto pb_skia = makeParagraphBuilder(f_collection);
+    pb_skia.PushStyle(makeStyle());
+    pb_skia.AddText(text);
+    pb_skia.Pop();
+    return pb_skia.Build();
+  };
+  const auto& cache = f_collection->GetParagraphCache();
+
+  auto paragraph = build(u"Hello World!");
+  paragraph->Layout(100);
+  auto height = paragraph->GetHeight();
+  paragraph.reset();
+  EXPECT_EQ(cache->GetStats().entries, 1u);
+
+  // A different width or text is laid out again.
+  build(u"Hello World!")->Layout(200);
+  build(u"Hello Again!")->Layout(100);
+  EXPECT_EQ(cache->GetStats().hits, 0u);
+
+  paragraph = build(u"Hello World!");
+  paragraph->Layout(100);
+  EXPECT_EQ(cache->GetStats().hits, 1u);
+  EXPECT_EQ(paragraph->GetHeight(), height);
+
+  // Changing the fonts drops the cached layouts.
+  f_collection->ClearFontFamilyCache();
+  EXPECT_EQ(cache->GetStats().entries, 0u);
+  paragraph.reset();
+  EXPECT_EQ(cache->GetStats().entries, 0u);
+}
+
 #ifdef IMPELLER_SUPPORTS_RENDERING
 TEST_F(PainterTest, DrawsSolidLineImpeller) {
   PretendImpellerIsEnabled(true);